@@ -0,0 +1,128 @@
+// -*-c++-*-
+
+/*!
+  \file anytime_search.cpp
+  \brief deadline bounded candidate search Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "anytime_search.h"
+
+#include <deque>
+#include <mutex>
+#include <cstring>
+
+namespace rcsc {
+
+namespace {
+
+std::mutex &
+stats_mutex()
+{
+    static std::mutex s_mutex;
+    return s_mutex;
+}
+
+// std::deque never moves the existing elements.
+std::deque< AnytimeSearchStats::Counter > &
+stats_list()
+{
+    static std::deque< AnytimeSearchStats::Counter > s_list;
+    return s_list;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+AnytimeSearchStats::Counter &
+AnytimeSearchStats::counter( const char * name )
+{
+    std::lock_guard< std::mutex > lock( stats_mutex() );
+
+    for ( Counter & c : stats_list() )
+    {
+        if ( std::strcmp( c.name_, name ) == 0 )
+        {
+            return c;
+        }
+    }
+
+    stats_list().emplace_back( name );
+    return stats_list().back();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+AnytimeSearchStats::clear()
+{
+    std::lock_guard< std::mutex > lock( stats_mutex() );
+
+    for ( Counter & c : stats_list() )
+    {
+        c.runs_ = 0;
+        c.truncated_ = 0;
+        c.evaluated_ = 0;
+        c.skipped_ = 0;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+AnytimeSearchStats::writeJSON( std::ostream & os )
+{
+    std::lock_guard< std::mutex > lock( stats_mutex() );
+
+    os << '{';
+    bool first = true;
+    for ( const Counter & c : stats_list() )
+    {
+        os << ( first ? "\n" : ",\n" )
+           << "  \"" << c.name_ << "\": {"
+           << "\"runs\": " << c.runs_.load()
+           << ", \"truncated\": " << c.truncated_.load()
+           << ", \"evaluated\": " << c.evaluated_.load()
+           << ", \"skipped_generators\": " << c.skipped_.load()
+           << '}';
+        first = false;
+    }
+    os << "\n}\n";
+    return os;
+}
+
+}
@@ -0,0 +1,295 @@
+// -*-c++-*-
+
+/*!
+  \file anytime_search.h
+  \brief deadline bounded candidate search Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_ACTION_ANYTIME_SEARCH_H
+#define RCSC_ACTION_ANYTIME_SEARCH_H
+
+#include <rcsc/time/timer.h>
+
+#include <functional>
+#include <algorithm>
+#include <ostream>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+
+namespace rcsc {
+
+/*!
+  \class AnytimeSearchStats
+  \brief process wide counters of the deadline bounded searches.
+
+  Each search has a named counter. The counter is registered at the first
+  call of counter(), and the returned reference is valid until the program
+  exits. The counter values are updated atomically.
+*/
+class AnytimeSearchStats {
+public:
+
+    /*!
+      \struct Counter
+      \brief statistics of a search
+    */
+    struct Counter {
+        const char * name_; //!< search name
+        std::atomic< std::uint64_t > runs_; //!< number of searches
+        std::atomic< std::uint64_t > truncated_; //!< number of searches stopped by the deadline
+        std::atomic< std::uint64_t > evaluated_; //!< total number of evaluated candidates
+        std::atomic< std::uint64_t > skipped_; //!< total number of candidate generators not completed
+
+        explicit
+        Counter( const char * name )
+            : name_( name ),
+              runs_( 0 ),
+              truncated_( 0 ),
+              evaluated_( 0 ),
+              skipped_( 0 )
+          { }
+
+        /*!
+          \brief record the result of a search
+          \param truncated true if the search was stopped by the deadline
+          \param evaluated number of evaluated candidates
+          \param skipped number of candidate generators not completed
+        */
+        void add( const bool truncated,
+                  const std::uint64_t evaluated,
+                  const std::uint64_t skipped )
+          {
+              runs_.fetch_add( 1, std::memory_order_relaxed );
+              evaluated_.fetch_add( evaluated, std::memory_order_relaxed );
+              if ( truncated )
+              {
+                  truncated_.fetch_add( 1, std::memory_order_relaxed );
+                  skipped_.fetch_add( skipped, std::memory_order_relaxed );
+              }
+          }
+    };
+
+    /*!
+      \brief get the counter of the search.
+      \param name search name. the pointer must be a string literal.
+      \return reference to the counter instance
+
+      The lookup takes a lock. Callers should hold the reference in a
+      function local static variable.
+    */
+    static
+    Counter & counter( const char * name );
+
+    /*!
+      \brief reset all counters
+    */
+    static
+    void clear();
+
+    /*!
+      \brief print all counters as a JSON object
+      \param os reference to the output stream
+      \return reference to the output stream
+    */
+    static
+    std::ostream & writeJSON( std::ostream & os );
+};
+
+/*!
+  \class AnytimeSearch
+  \brief deadline bounded search over the prioritized candidate generators.
+
+  The behaviours submit candidate generators with priorities. run()
+  pulls the candidates from the generators in the order of priority
+  (higher first, then submission order), evaluates them, and keeps the
+  best one found so far. The search stops when all generators are
+  exhausted or the deadline expires, so the best candidate is always
+  the best of the evaluated ones. At least one candidate is evaluated
+  even if the deadline has already expired.
+
+  \tparam Candidate candidate type. must be copy assignable.
+*/
+template < typename Candidate >
+class AnytimeSearch {
+public:
+
+    /*!
+      \brief candidate generator. stores the next candidate into the argument.
+      returns false if no more candidate.
+    */
+    typedef std::function< bool( Candidate * ) > Generator;
+
+    /*!
+      \brief candidate evaluator. fills the evaluation result into the candidate.
+      returns false if the candidate is not valid.
+    */
+    typedef std::function< bool( Candidate & ) > Evaluator;
+
+    /*!
+      \brief comparator. returns true if the first argument is better than the second one.
+    */
+    typedef std::function< bool( const Candidate &, const Candidate & ) > Better;
+
+private:
+
+    struct Entry {
+        int priority_;
+        Generator generator_;
+    };
+
+    AnytimeSearchStats::Counter & M_stats; //!< statistics of this search
+    const Deadline & M_deadline; //!< time limit
+    std::vector< Entry > M_generators; //!< submitted generators
+
+    Candidate M_best; //!< the best candidate so far
+    bool M_has_best; //!< true if M_best is valid
+    bool M_truncated; //!< true if the last run was stopped by the deadline
+    std::uint64_t M_evaluated; //!< number of evaluated candidates in the last run
+
+public:
+
+    /*!
+      \brief construct with the counter and the deadline
+      \param stats statistics of this search. see AnytimeSearchStats::counter().
+      \param deadline time limit. must live longer than this instance.
+    */
+    AnytimeSearch( AnytimeSearchStats::Counter & stats,
+                   const Deadline & deadline )
+        : M_stats( stats ),
+          M_deadline( deadline ),
+          M_best(),
+          M_has_best( false ),
+          M_truncated( false ),
+          M_evaluated( 0 )
+      { }
+
+    /*!
+      \brief submit the candidate generator
+      \param priority priority value. the generator with the larger value is used first.
+      \param generator generator function
+    */
+    void addGenerator( const int priority,
+                       Generator generator )
+      {
+          M_generators.push_back( Entry{ priority, std::move( generator ) } );
+      }
+
+    /*!
+      \brief evaluate the candidates until all generators are exhausted or the deadline expires
+      \param evaluate evaluator function
+      \param better comparator function
+      \return true if any valid candidate was found
+    */
+    bool run( const Evaluator & evaluate,
+              const Better & better )
+      {
+          std::stable_sort( M_generators.begin(), M_generators.end(),
+                            []( const Entry & lhs, const Entry & rhs )
+                              {
+                                  return lhs.priority_ > rhs.priority_;
+                              } );
+
+          M_has_best = false;
+          M_truncated = false;
+          M_evaluated = 0;
+
+          std::uint64_t skipped = 0;
+          Candidate candidate;
+
+          for ( std::size_t i = 0; i < M_generators.size(); ++i )
+          {
+              if ( M_truncated )
+              {
+                  ++skipped;
+                  continue;
+              }
+
+              while ( M_generators[i].generator_( &candidate ) )
+              {
+                  ++M_evaluated;
+                  if ( evaluate( candidate )
+                       && ( ! M_has_best
+                            || better( candidate, M_best ) ) )
+                  {
+                      M_best = candidate;
+                      M_has_best = true;
+                  }
+
+                  if ( M_deadline.expired() )
+                  {
+                      M_truncated = true;
+                      ++skipped;
+                      break;
+                  }
+              }
+          }
+
+          M_stats.add( M_truncated, M_evaluated, skipped );
+          return M_has_best;
+      }
+
+    /*!
+      \brief check if a valid candidate was found
+      \return true if best() is available
+    */
+    bool hasBest() const
+      {
+          return M_has_best;
+      }
+
+    /*!
+      \brief get the best candidate so far
+      \return const reference to the candidate. valid only if hasBest() is true.
+    */
+    const Candidate & best() const
+      {
+          return M_best;
+      }
+
+    /*!
+      \brief check if the last run was stopped by the deadline
+      \return true if truncated
+    */
+    bool truncated() const
+      {
+          return M_truncated;
+      }
+
+    /*!
+      \brief get the number of evaluated candidates in the last run
+      \return evaluation count
+    */
+    std::uint64_t evaluatedCount() const
+      {
+          return M_evaluated;
+      }
+};
+
+}
+
+#endif
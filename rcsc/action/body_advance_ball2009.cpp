@@ -41,18 +41,35 @@
 #include "body_kick_one_step.h"
 
 #include <rcsc/player/player_agent.h>
+#include <rcsc/player/agent_context.h>
 #include <rcsc/player/debug_client.h>
 
 #include <rcsc/common/logger.h>
 #include <rcsc/common/server_param.h>
+#include <rcsc/geom/segment_2d.h>
+#include <rcsc/geom/vector_2d_array.h>
+
+#include <algorithm>
+#include <vector>
+#include <cmath>
 
 namespace rcsc {
 
-GameTime Body_AdvanceBall2009::S_last_calc_time( 0, 0 );
-AngleDeg Body_AdvanceBall2009::S_cached_best_angle = 0.0;
+namespace {
 
+/*!
+  \struct AdvanceBallCache
+  \brief the last result of Body_AdvanceBall2009. stored in each agent's context.
+ */
+struct AdvanceBallCache {
+    GameTime last_calc_time_; //!< last game time when calculation is done.
+    AngleDeg best_angle_; //!< last calculated result
 
-namespace {
+    AdvanceBallCache()
+        : last_calc_time_( 0, 0 ),
+          best_angle_( 0.0 )
+      { }
+};
 
 /*-------------------------------------------------------------------*/
 /*!
@@ -66,24 +83,56 @@ calc_score( const PlayerAgent * agent,
 
     double score = 1000.0;
 
-    const Line2D angle_line( agent->world().self().pos(),
-                             target_angle );
+    const Vector2D self_pos = agent->world().self().pos();
 
     const AngleDeg target_left_angle = target_angle - 30.0;
     const AngleDeg target_right_angle = target_angle + 30.0;
 
-    for ( const PlayerObject * o : agent->world().opponentsFromSelf() )
+    // the opponents within the angle range are taken by the binary search.
+    // the score is multiplied in the distance order as same as the linear check.
+    std::vector< const AngularPlayerProfile::Entry * > candidates;
+    agent->world().opponentProfileFromSelf().forEachWithin( target_left_angle,
+                                                            target_right_angle,
+                                                            [&]( const AngularPlayerProfile::Entry & e )
+                                                              {
+                                                                  if ( e.player_->distFromBall() <= 40.0 )
+                                                                  {
+                                                                      candidates.push_back( &e );
+                                                                  }
+                                                              } );
+    std::sort( candidates.begin(), candidates.end(),
+               []( const AngularPlayerProfile::Entry * lhs,
+                   const AngularPlayerProfile::Entry * rhs )
+                 {
+                     return lhs->order_ < rhs->order_;
+                 } );
+
+    if ( candidates.empty() )
     {
-        if ( o->distFromBall() > 40.0 ) continue;
+        return score;
+    }
 
-        if ( o->angleFromSelf().isWithin( target_left_angle, target_right_angle ) )
-        {
-            Vector2D project_point = angle_line.projection( o->pos() );
-            double width = std::max( 0.0,
-                                     angle_line.dist( o->pos() ) - kickable_area );
-            double dist = agent->world().self().pos().dist( project_point );
-            score *= width / dist;
-        }
+    // all candidates are in front of the player and within 40m from the ball,
+    // so the distance to this segment is the same as the distance to the line.
+    const Segment2D angle_line( self_pos,
+                                self_pos + Vector2D::polar2vector( 100.0, target_angle ) );
+
+    Vector2DArray points;
+    points.reserve( candidates.size() );
+    for ( const AngularPlayerProfile::Entry * e : candidates )
+    {
+        points.push_back( e->player_->pos() );
+    }
+
+    std::vector< double > line_dist2;
+    points.segmentDist2( angle_line, &line_dist2 );
+
+    for ( std::size_t i = 0; i < points.size(); ++i )
+    {
+        double width = std::max( 0.0,
+                                 std::sqrt( line_dist2[i] ) - kickable_area );
+        double dist = std::sqrt( std::max( 0.0, self_pos.dist2( points[i] ) - line_dist2[i] ) );
+        score *= width / dist;
     }
 
     return score;
@@ -165,22 +214,23 @@ Body_AdvanceBall2009::execute( PlayerAgent * agent )
         return false;
     }
 
-    if ( S_last_calc_time != wm.time() )
+    AdvanceBallCache & cache = wm.agentContext().get< AdvanceBallCache >();
+    if ( cache.last_calc_time_ != wm.time() )
     {
         dlog.addText( Logger::CLEAR,
                       __FILE__": update" );
-        S_cached_best_angle = getBestAngle( agent );
-        S_last_calc_time = wm.time();
+        cache.best_angle_ = getBestAngle( agent );
+        cache.last_calc_time_ = wm.time();
     }
 
 
     const Vector2D target_point
         = wm.self().pos()
-        + Vector2D::polar2vector( 30.0, S_cached_best_angle );
+        + Vector2D::polar2vector( 30.0, cache.best_angle_ );
 
     dlog.addText( Logger::CLEAR,
                   __FILE__": target_angle=%.1f",
-                  S_cached_best_angle.degree() );
+                  cache.best_angle_.degree() );
     agent->debugClient().setTarget( target_point );
     agent->debugClient().addLine( wm.ball().pos(), target_point );
 
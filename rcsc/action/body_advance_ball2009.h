@@ -44,12 +44,6 @@ namespace rcsc {
  */
 class Body_AdvanceBall2009
     : public BodyAction {
-private:
-    //! last game time when calcuration is done.
-    static GameTime S_last_calc_time;
-    //! last calculated result
-    static AngleDeg S_cached_best_angle;
-
 public:
     /*!
       \brief accessible from global.
@@ -41,6 +41,7 @@
 #include <rcsc/action/body_kick_one_step.h>
 
 #include <rcsc/player/player_agent.h>
+#include <rcsc/player/agent_context.h>
 #include <rcsc/player/player_predicate.h>
 #include <rcsc/common/logger.h>
 #include <rcsc/common/server_param.h>
@@ -57,6 +58,20 @@ namespace rcsc {
 
 namespace {
 
+/*!
+  \struct ClearCourseCache
+  \brief the last result of get_clear_course(). stored in each agent's context.
+ */
+struct ClearCourseCache {
+    GameTime update_time_; //!< last calculated time
+    AngleDeg angle_; //!< last calculated course
+
+    ClearCourseCache()
+        : update_time_( 0, 0 ),
+          angle_( 0.0 )
+      { }
+};
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -93,17 +108,16 @@ get_free_angle( const WorldModel & wm,
     //                                          new AbsAngleDiffPlayerEvaluator( wm.ball().pos(), angle ) ),
     //                  360.0 );
 
+    // the nearest opponent in direction is found by the binary search.
+    // the unknown players are excluded as same as theirPlayers().
     double min_diff = 360.0;
-    for ( const AbstractPlayerObject * p : wm.theirPlayers() )
-    {
-        if ( p->distFromBall() > 35.0 ) continue;
-
-        double angle_diff = ( angle - p->angleFromBall() ).abs();
-        if ( angle_diff < min_diff )
-        {
-            min_diff = angle_diff;
-        }
-    }
+    wm.opponentProfileFromBall().nearest( angle,
+                                          []( const PlayerObject & p )
+                                            {
+                                                return ( p.side() != NEUTRAL
+                                                         && p.distFromBall() <= 35.0 );
+                                            },
+                                          &min_diff );
 
     return min_diff;
 }
@@ -299,19 +313,18 @@ get_clear_course_recursive( const WorldModel & wm,
 AngleDeg
 get_clear_course( const WorldModel & wm )
 {
-    static GameTime s_update_time( 0, 0 );
-    static AngleDeg s_last_angle = 0.0;
+    ClearCourseCache & cache = wm.agentContext().get< ClearCourseCache >();
 
-    if ( s_update_time == wm.time() )
+    if ( cache.update_time_ == wm.time() )
     {
-        return s_last_angle;
+        return cache.angle_;
     }
-    s_update_time = wm.time();
+    cache.update_time_ = wm.time();
 
 #ifdef DEBUG_PROFILE
     Timer timer;
 #endif
-    s_last_angle = get_clear_course_recursive( wm,
+    cache.angle_ = get_clear_course_recursive( wm,
                                                25.0, /* safe angle */
                                                4 /* recursive count */ );
 #ifdef DEBUG_PROFILE
@@ -320,7 +333,7 @@ get_clear_course( const WorldModel & wm )
                   timer.elapsedReal() );
 #endif
 
-    return s_last_angle;
+    return cache.angle_;
 }
 
 }
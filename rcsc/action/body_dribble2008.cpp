@@ -36,6 +36,7 @@
 
 #include "body_dribble2008.h"
 #include "intention_dribble2008.h"
+#include "anytime_search.h"
 
 #include <rcsc/action/body_intercept.h>
 #include <rcsc/action/body_hold_ball.h>
@@ -60,11 +61,398 @@
 
 #include <list>
 #include <functional>
+#include <limits>
+#include <cmath>
 
 #define USE_CHANGE_VIEW
 
+//#define DEBUG_CHECK_BATCH
+
 namespace rcsc {
 
+namespace {
+
+//! the number of candidates simulated at once
+constexpr std::size_t KICK_DASH_BATCH_SIZE = 32;
+
+/*!
+  \brief get the area where the dribble ball can move
+  \return const reference to the rectangle
+*/
+const Rect2D &
+dribble_pitch_rect()
+{
+    static const Rect2D s_rect( Vector2D( - ServerParam::i().pitchHalfLength() + 0.2,
+                                          - ServerParam::i().pitchHalfWidth() + 0.2 ),
+                                Size2D( ServerParam::i().pitchLength() - 0.4,
+                                        ServerParam::i().pitchWidth() - 0.4 ) );
+    return s_rect;
+}
+
+/*!
+  \struct KickDashOpponents
+  \brief opponents checked by the kick-dashes simulation in the structure-of-arrays layout.
+
+  The players and their order are the same as
+  Body_Dribble2008::existKickableOpponent().
+*/
+struct KickDashOpponents {
+    std::vector< double > x_; //!< position x
+    std::vector< double > y_; //!< position y
+    bool has_goalie_; //!< true if the goalie is included
+
+    void create( const WorldModel & wm );
+
+    bool existKickable( const Vector2D & ball_pos,
+                        double * min_opp_dist ) const;
+
+private:
+    std::vector< char > goalie_; //!< goalie flag
+
+    bool existKickableSequential( const Vector2D & ball_pos,
+                                  double * min_opp_dist ) const;
+};
+
+/*!
+  \brief collect the opponents
+  \param wm world model
+*/
+void
+KickDashOpponents::create( const WorldModel & wm )
+{
+    x_.clear();
+    y_.clear();
+    goalie_.clear();
+    has_goalie_ = false;
+
+    for ( const PlayerObject * o : wm.opponentsFromSelf() )
+    {
+        if ( o->posCount() > 5 )
+        {
+            continue;
+        }
+
+        if ( o->distFromSelf() > 30.0 )
+        {
+            break;
+        }
+
+        x_.push_back( o->pos().x );
+        y_.push_back( o->pos().y );
+        goalie_.push_back( o->goalie() ? 1 : 0 );
+        has_goalie_ = has_goalie_ || o->goalie();
+    }
+}
+
+/*!
+  \brief check if any opponent can kick or catch the ball
+  \param ball_pos ball position
+  \param min_opp_dist the nearest opponent distance. updated by this method.
+  \return true if the ball can be controlled by opponent
+
+  The minimum distance is taken over all opponents without any branch.
+  The sequential scan is used only when the result may be changed by the
+  goalie or by the early return, so the result always equals to
+  existKickableSequential().
+*/
+bool
+KickDashOpponents::existKickable( const Vector2D & ball_pos,
+                                  double * min_opp_dist ) const
+{
+    if ( has_goalie_
+         && ball_pos.x > ServerParam::i().theirPenaltyAreaLineX()
+         && ball_pos.absY() < ServerParam::i().penaltyAreaHalfWidth() )
+    {
+        return existKickableSequential( ball_pos, min_opp_dist );
+    }
+
+    static const double kickable_area = ServerParam::i().defaultKickableArea() + 0.2;
+
+    const std::size_t size = x_.size();
+    if ( size == 0 )
+    {
+        return false;
+    }
+
+    const double * x = x_.data();
+    const double * y = y_.data();
+
+    double min_d2 = std::numeric_limits< double >::max();
+    for ( std::size_t i = 0; i < size; ++i )
+    {
+        const double d2 = Vector2D( x[i], y[i] ).dist2( ball_pos );
+        min_d2 = std::min( min_d2, d2 );
+    }
+
+    // sqrt is monotone. the minimum of the distances is sqrt of the minimum of the squared distances.
+    const double min_d = std::sqrt( min_d2 );
+    if ( min_d < kickable_area )
+    {
+        // reproduce the partial update of min_opp_dist before the early return
+        return existKickableSequential( ball_pos, min_opp_dist );
+    }
+
+    if ( *min_opp_dist > min_d )
+    {
+        *min_opp_dist = min_d;
+    }
+    return false;
+}
+
+/*!
+  \brief the same as Body_Dribble2008::existKickableOpponent()
+*/
+bool
+KickDashOpponents::existKickableSequential( const Vector2D & ball_pos,
+                                            double * min_opp_dist ) const
+{
+    static const double kickable_area = ServerParam::i().defaultKickableArea() + 0.2;
+
+    const ServerParam & SP = ServerParam::i();
+
+    for ( std::size_t i = 0; i < x_.size(); ++i )
+    {
+        const Vector2D opp_pos( x_[i], y_[i] );
+
+        // goalie's catchable check
+        if ( goalie_[i] )
+        {
+            if ( ball_pos.x > SP.theirPenaltyAreaLineX()
+                 && ball_pos.absY() < SP.penaltyAreaHalfWidth() )
+            {
+                double d = opp_pos.dist( ball_pos );
+                if ( d < SP.catchableArea() )
+                {
+                    return true;
+                }
+
+                d -= SP.catchableArea();
+                if ( *min_opp_dist > d )
+                {
+                    *min_opp_dist = d;
+                }
+            }
+        }
+
+        // normal kickable check
+        double d = opp_pos.dist( ball_pos );
+        if ( d < kickable_area )
+        {
+            return true;
+        }
+
+        if ( *min_opp_dist > d )
+        {
+            *min_opp_dist = d;
+        }
+    }
+
+    return false;
+}
+
+/*!
+  \struct KickDashBatch
+  \brief kick-dashes simulation state of the candidates in the structure-of-arrays layout.
+*/
+struct KickDashBatch {
+    std::vector< double > ball_x_; //!< ball position x
+    std::vector< double > ball_y_; //!< ball position y
+    std::vector< double > vel_x_; //!< ball velocity x
+    std::vector< double > vel_y_; //!< ball velocity y
+    std::vector< char > alive_; //!< simulation flag
+
+    std::vector< Vector2D > first_ball_vel_; //!< input. the first ball velocity
+    std::vector< Body_Dribble2008::KeepDribbleInfo > info_; //!< result
+    std::vector< char > valid_; //!< result flag
+
+    void resize( const std::size_t size )
+      {
+          ball_x_.resize( size );
+          ball_y_.resize( size );
+          vel_x_.resize( size );
+          vel_y_.resize( size );
+          alive_.resize( size );
+          first_ball_vel_.resize( size );
+          info_.resize( size );
+          valid_.resize( size );
+      }
+};
+
+/*!
+  \brief simulate the ball and self movement of all candidates at once.
+  \param wm world model
+  \param self_cache self positions. see Body_Dribble2008::createSelfCache().
+  \param dash_count requested dash count
+  \param accel_angle dash direction
+  \param opponents opponents to be checked
+  \param first_ball_pos the first ball position of each candidate
+  \param batch input velocities and output results
+
+  All candidates are advanced by one step in each iteration. The geometric
+  checks are applied to the alive candidates first, then the opponent
+  checks are applied to the survivors. Each candidate is checked by the
+  same rules and in the same order as Body_Dribble2008::simulateKickDashes(),
+  so the results are identical.
+*/
+void
+simulate_kick_dashes_batch( const WorldModel & wm,
+                            const ScratchVector< Vector2D > & self_cache,
+                            const int dash_count,
+                            const AngleDeg & accel_angle,
+                            const KickDashOpponents & opponents,
+                            const std::vector< Vector2D > & first_ball_pos,
+                            KickDashBatch * batch )
+{
+    const ServerParam & param = ServerParam::i();
+    const Rect2D & pitch_rect = dribble_pitch_rect();
+
+    const double collide_dist = ( wm.self().playerType().playerSize()
+                                  + param.ballSize() );
+    const double kickable_area = wm.self().playerType().kickableArea();
+    const double max_kick_accel = wm.self().kickRate() * param.maxPower();
+    const double ball_decay = param.ballDecay();
+    const Vector2D ball_pos0 = wm.ball().pos();
+    const Vector2D ball_vel0 = wm.ball().vel();
+    const Vector2D self_pos0 = wm.self().pos();
+
+    const AngleDeg rotate_angle = - accel_angle;
+    const double rotate_c = std::cos( rotate_angle.degree() * AngleDeg::DEG2RAD );
+    const double rotate_s = std::sin( rotate_angle.degree() * AngleDeg::DEG2RAD );
+
+    const std::size_t size = first_ball_pos.size();
+    std::vector< double > min_opp_dist( size, 1000.0 );
+    std::vector< Vector2D > total_ball_move( size, Vector2D( 0.0, 0.0 ) );
+    std::vector< Vector2D > last_ball_rel( size, Vector2D( 0.0, 0.0 ) );
+    std::vector< Vector2D > ball_rel( size );
+    std::vector< int > tmp_dash_count( size, 0 );
+
+    std::size_t alive_count = 0;
+
+    //
+    // the first kick
+    //
+    for ( std::size_t i = 0; i < size; ++i )
+    {
+        const Vector2D & ball_pos = first_ball_pos[i];
+        const Vector2D & ball_vel = batch->first_ball_vel_[i];
+
+        batch->alive_[i] = 0;
+        batch->valid_[i] = 0;
+
+        if ( ! pitch_rect.contains( ball_pos ) )
+        {
+            continue;
+        }
+
+        const Vector2D first_ball_accel = ball_vel - ball_vel0;
+        const double first_ball_accel_r = first_ball_accel.r();
+
+        if ( ball_vel.r() > param.ballSpeedMax()
+             || first_ball_accel_r > param.ballAccelMax()
+             || first_ball_accel_r > max_kick_accel )
+        {
+            continue;
+        }
+
+        if ( opponents.existKickable( ball_pos, &min_opp_dist[i] ) )
+        {
+            continue;
+        }
+
+        batch->ball_x_[i] = ball_pos.x;
+        batch->ball_y_[i] = ball_pos.y;
+        batch->vel_x_[i] = ball_vel.x * ball_decay;
+        batch->vel_y_[i] = ball_vel.y * ball_decay;
+        batch->alive_[i] = 1;
+        ++alive_count;
+    }
+
+    //
+    // future state loop
+    //
+    std::vector< std::size_t > survivors;
+    survivors.reserve( size );
+
+    for ( ScratchVector< Vector2D >::const_iterator my_pos = self_cache.begin() + 1, end = self_cache.end();
+          my_pos != end && alive_count > 0;
+          ++my_pos )
+    {
+        const double my_travel = my_pos->dist( self_pos0 );
+
+        survivors.clear();
+
+        // geometric checks
+        for ( std::size_t i = 0; i < size; ++i )
+        {
+            if ( ! batch->alive_[i] ) continue;
+
+            batch->ball_x_[i] += batch->vel_x_[i];
+            batch->ball_y_[i] += batch->vel_y_[i];
+
+            const Vector2D ball_pos( batch->ball_x_[i], batch->ball_y_[i] );
+            const Vector2D rel = ball_pos - *my_pos;
+            const Vector2D & r = ball_rel[i].assign( rel.x * rotate_c - rel.y * rotate_s,
+                                                     rel.x * rotate_s + rel.y * rotate_c );
+            const double new_ball_dist = r.r();
+            const double ball_travel = ball_pos.dist( ball_pos0 );
+
+            bool ok = pitch_rect.contains( ball_pos );
+
+            ok = ok && ! ( new_ball_dist < collide_dist - std::min( 0.02 * ball_travel + 0.03 * my_travel, 0.1 ) + 0.2 );
+            ok = ok && ! ( tmp_dash_count[i] == dash_count - 1
+                           && r.x > 0.0
+                           && new_ball_dist > kickable_area - 0.25 );
+            ok = ok && ! ( new_ball_dist > kickable_area - 0.2 );
+            ok = ok && ! ( r.x > kickable_area - std::min( 0.02 * ball_travel + 0.04 * my_travel, 0.2 ) - 0.2 );
+            ok = ok && ! ( r.absY() > kickable_area - std::min( 0.02 * ball_travel + 0.055 + my_travel, 0.35 ) - 0.15 );
+
+            if ( ok )
+            {
+                survivors.push_back( i );
+            }
+            else
+            {
+                batch->alive_[i] = 0;
+                --alive_count;
+            }
+        }
+
+        // opponent checks
+        for ( std::size_t i : survivors )
+        {
+            const Vector2D ball_pos( batch->ball_x_[i], batch->ball_y_[i] );
+            if ( opponents.existKickable( ball_pos, &min_opp_dist[i] ) )
+            {
+                batch->alive_[i] = 0;
+                --alive_count;
+                continue;
+            }
+
+            total_ball_move[i] = ball_pos - ball_pos0;
+            ++tmp_dash_count[i];
+            last_ball_rel[i] = ball_rel[i];
+            batch->vel_x_[i] *= ball_decay;
+            batch->vel_y_[i] *= ball_decay;
+        }
+    }
+
+    for ( std::size_t i = 0; i < size; ++i )
+    {
+        if ( tmp_dash_count[i] > 0 )
+        {
+            Body_Dribble2008::KeepDribbleInfo & info = batch->info_[i];
+            info.first_ball_vel_ = batch->first_ball_vel_[i];
+            info.last_ball_rel_ = last_ball_rel[i];
+            info.ball_forward_travel_ = total_ball_move[i].rotate( - accel_angle ).x;
+            info.dash_count_ = tmp_dash_count[i];
+            info.min_opp_dist_ = min_opp_dist[i];
+            batch->valid_[i] = 1;
+        }
+    }
+}
+
+}
+
 /*-------------------------------------------------------------------*/
 /*!
   execute action
@@ -116,7 +504,7 @@ Body_Dribble2008::say( PlayerAgent * agent,
         dlog.addText( Logger::ACTION,
                       __FILE__":  set dribble target communication." );
         agent->debugClient().addMessage( "Say_D" );
-        agent->addSayMessage( new DribbleMessage( target_point, queue_count ) );
+        agent->emplaceSayMessage< DribbleMessage >( 0, target_point, queue_count );
     }
 }
 
@@ -668,11 +1056,11 @@ Body_Dribble2008::doKickTurnsDashes( PlayerAgent * agent,
                                      const double & dash_power,
                                      const int n_turn )
 {
-    static std::vector< Vector2D > self_cache;
+    const WorldModel & wm = agent->world();
 
-    const int max_dash = 5;
+    ScratchVector< Vector2D > self_cache( wm.scratchResource() );
 
-    const WorldModel & wm = agent->world();
+    const int max_dash = 5;
 
     createSelfCache( agent,
                      target_point, dash_power,
@@ -887,13 +1275,13 @@ Body_Dribble2008::doKickDashes( PlayerAgent * agent,
                                 const double & dash_power,
                                 const int dash_count )
 {
-    static std::vector< Vector2D > self_cache;
-
     // do dribble kick. simulate next action queue.
     // kick -> dash -> dash -> ...
 
     const WorldModel & wm = agent->world();
 
+    ScratchVector< Vector2D > self_cache( wm.scratchResource() );
+
     ////////////////////////////////////////////////////////
     // simulate my pos after one kick & dashes
     createSelfCache( agent,
@@ -1094,7 +1482,7 @@ Body_Dribble2008::doKickDashes( PlayerAgent * agent,
         int r = 255, g = 0, b = 0;
         Vector2D bpos = wm.ball().pos() + required_first_vel;
         Vector2D bvel = required_first_vel;
-        for ( std::vector< Vector2D >::iterator p = self_cache.begin();
+        for ( ScratchVector< Vector2D >::iterator p = self_cache.begin();
               p != self_cache.end();
               ++p, ++count )
         {
@@ -1131,12 +1519,6 @@ Body_Dribble2008::doKickDashesWithBall( PlayerAgent * agent,
                                         const int dash_count,
                                         const bool dodge_mode )
 {
-    static std::vector< Vector2D > my_state;
-    static std::vector< KeepDribbleInfo > dribble_info;
-
-    my_state.clear();
-    dribble_info.clear();
-
     // do dribble kick. simulate next action queue.
     // kick -> dash -> dash -> ...
     dlog.addText( Logger::DRIBBLE,
@@ -1144,6 +1526,8 @@ Body_Dribble2008::doKickDashesWithBall( PlayerAgent * agent,
 
     const WorldModel & wm = agent->world();
 
+    ScratchVector< Vector2D > my_state( wm.scratchResource() );
+
     Timer timer;
 
     // estimate my move positions
@@ -1160,70 +1544,186 @@ Body_Dribble2008::doKickDashesWithBall( PlayerAgent * agent,
     const int DIST_DIVS = 10;
 
     const double max_dist = wm.self().playerType().kickableArea() + 0.2;
-    double first_ball_dist = ( wm.self().playerType().playerSize()
-                               + ServerParam::i().ballSize()
-                               + 0.15 );
-    const double dist_step = ( max_dist - first_ball_dist ) / ( DIST_DIVS - 1 );
+    const double min_dist = ( wm.self().playerType().playerSize()
+                              + ServerParam::i().ballSize()
+                              + 0.15 );
+    const double dist_step = ( max_dist - min_dist ) / ( DIST_DIVS - 1 );
 
     const double angle_range = 240.0;
     const double angle_range_forward = 160.0;
     const double arc_dist_step = 0.1;
 
-    int total_loop_count = 0;
+    struct Candidate {
+        double first_ball_dist_;
+        AngleDeg first_ball_angle_;
+        bool valid_;
+        KeepDribbleInfo info_;
+    };
 
-    for ( int dist_loop = 0;
-          dist_loop < DIST_DIVS;
-          ++dist_loop, first_ball_dist += dist_step )
-    {
-        const double angle_step
-            = ( arc_dist_step * 360.0 )
-            / ( 2.0 * first_ball_dist * M_PI );
-        const int ANGLE_DIVS
-            = ( first_ball_dist < wm.self().playerType().kickableArea() - 0.1
-                ? static_cast< int >( std::ceil( angle_range / angle_step ) ) + 1
-                : static_cast< int >( std::ceil( angle_range_forward / angle_step ) ) + 1 );
+    KickDashOpponents opponents;
+    opponents.create( wm );
 
-        AngleDeg first_ball_angle = accel_angle - angle_step * ( ANGLE_DIVS/2 );
+    //
+    // candidate generator.
+    // the ball positions within the forward arc are tried first, then the rest
+    // of the wide arcs used for the rings close to the body.
+    //
+    const auto create_generator
+        = [&]( const bool forward )
+          {
+              int dist_loop = 0;
+              int angle_loop = -1;
+              return [&, forward, dist_loop, angle_loop]( Candidate * candidate ) mutable
+                {
+                    while ( dist_loop < DIST_DIVS )
+                    {
+                        const double ball_dist = min_dist + dist_step * dist_loop;
+                        const double angle_step = ( arc_dist_step * 360.0 ) / ( 2.0 * ball_dist * M_PI );
+                        const int forward_divs = static_cast< int >( std::ceil( angle_range_forward / angle_step ) ) + 1;
+                        const int angle_divs = ( ball_dist < wm.self().playerType().kickableArea() - 0.1
+                                                 ? static_cast< int >( std::ceil( angle_range / angle_step ) ) + 1
+                                                 : forward_divs );
+
+                        while ( ++angle_loop < angle_divs )
+                        {
+                            const int offset = angle_loop - angle_divs/2;
+                            const bool is_forward = ( std::abs( offset ) <= forward_divs/2 );
+                            if ( is_forward != forward ) continue;
+
+                            candidate->first_ball_dist_ = ball_dist;
+                            candidate->first_ball_angle_ = accel_angle + angle_step * offset;
+                            return true;
+                        }
+
+                        ++dist_loop;
+                        angle_loop = -1;
+                    }
+                    return false;
+                };
+          };
 
-        // angle loop
-        for ( int angle_loop = 0;
-              angle_loop < ANGLE_DIVS;
-              ++angle_loop, first_ball_angle += angle_step )
-        {
-            ++total_loop_count;
-
-            const Vector2D first_ball_pos
-                = my_state.front()
-                + Vector2D::polar2vector( first_ball_dist, first_ball_angle );
-            const Vector2D first_ball_vel = first_ball_pos - wm.ball().pos();
-
-            KeepDribbleInfo info;
-            if ( simulateKickDashes( wm,
-                                     my_state,
-                                     dash_count,
-                                     accel_angle,
-                                     first_ball_pos,
-                                     first_ball_vel,
-                                     &info ) )
-            {
-                dribble_info.push_back( info );
-                dlog.addText( Logger::DRIBBLE,
-                              "_____ add bdist=%.2f bangle=%.1f"
-                              " vel=(%.1f %.1f) dash_step=%d opp_dist=%.1f",
-                              first_ball_dist,
-                              first_ball_angle.degree(),
-                              info.first_ball_vel_.x, info.first_ball_vel_.y,
-                              info.dash_count_,
-                              info.min_opp_dist_ );
-            }
-        }
-    }
+    static AnytimeSearchStats::Counter & s_stats = AnytimeSearchStats::counter( "Body_Dribble2008::doKickDashesWithBall" );
+
+    //
+    // batch generator.
+    // the candidates are pulled from the generator and simulated in a batch,
+    // then returned one by one with the simulation results.
+    //
+    const auto create_batch_generator
+        = [&]( const bool forward )
+          {
+              std::function< bool( Candidate * ) > generator = create_generator( forward );
+              std::vector< Candidate > buffer;
+              std::size_t next = 0;
+              return [&, generator, buffer, next]( Candidate * candidate ) mutable
+                {
+                    if ( next == buffer.size() )
+                    {
+                        buffer.clear();
+                        next = 0;
+
+                        Candidate c;
+                        while ( buffer.size() < KICK_DASH_BATCH_SIZE
+                                && generator( &c ) )
+                        {
+                            buffer.push_back( c );
+                        }
+
+                        if ( buffer.empty() )
+                        {
+                            return false;
+                        }
+
+                        KickDashBatch batch;
+                        std::vector< Vector2D > first_ball_pos;
+                        batch.resize( buffer.size() );
+                        first_ball_pos.reserve( buffer.size() );
+                        for ( std::size_t i = 0; i < buffer.size(); ++i )
+                        {
+                            first_ball_pos.push_back( my_state.front()
+                                                      + Vector2D::polar2vector( buffer[i].first_ball_dist_,
+                                                                                buffer[i].first_ball_angle_ ) );
+                            batch.first_ball_vel_[i] = first_ball_pos.back() - wm.ball().pos();
+                        }
+
+                        simulate_kick_dashes_batch( wm, my_state, dash_count, accel_angle,
+                                                    opponents, first_ball_pos, &batch );
+
+                        for ( std::size_t i = 0; i < buffer.size(); ++i )
+                        {
+                            buffer[i].valid_ = batch.valid_[i];
+                            buffer[i].info_ = batch.info_[i];
+#ifdef DEBUG_CHECK_BATCH
+                            KeepDribbleInfo info;
+                            const bool scalar = simulateKickDashes( wm, my_state, dash_count, accel_angle,
+                                                                    first_ball_pos[i], batch.first_ball_vel_[i],
+                                                                    &info );
+                            if ( scalar != buffer[i].valid_
+                                 || ( scalar
+                                      && ( info.dash_count_ != buffer[i].info_.dash_count_
+                                           || info.min_opp_dist_ != buffer[i].info_.min_opp_dist_
+                                           || info.ball_forward_travel_ != buffer[i].info_.ball_forward_travel_
+                                           || info.last_ball_rel_ != buffer[i].info_.last_ball_rel_ ) ) )
+                            {
+                                dlog.addText( Logger::DRIBBLE,
+                                              "_____ batch mismatch bdist=%.2f bangle=%.1f batch=%d scalar=%d",
+                                              buffer[i].first_ball_dist_,
+                                              buffer[i].first_ball_angle_.degree(),
+                                              (int)buffer[i].valid_, (int)scalar );
+                            }
+#endif
+                        }
+                    }
+
+                    *candidate = buffer[next++];
+                    return true;
+                };
+          };
+
+    AnytimeSearch< Candidate > search( s_stats, wm.decisionDeadline() );
+    search.addGenerator( 1, create_batch_generator( true ) );
+    search.addGenerator( 0, create_batch_generator( false ) );
+
+    search.run( [&]( Candidate & candidate )
+                  {
+                      if ( ! candidate.valid_ )
+                      {
+                          return false;
+                      }
+
+                      dlog.addText( Logger::DRIBBLE,
+                                    "_____ add bdist=%.2f bangle=%.1f"
+                                    " vel=(%.1f %.1f) dash_step=%d opp_dist=%.1f",
+                                    candidate.first_ball_dist_,
+                                    candidate.first_ball_angle_.degree(),
+                                    candidate.info_.first_ball_vel_.x, candidate.info_.first_ball_vel_.y,
+                                    candidate.info_.dash_count_,
+                                    candidate.info_.min_opp_dist_ );
+                      return true;
+                  },
+                []( const Candidate & lhs_candidate, const Candidate & rhs_candidate )
+                  {
+                      const KeepDribbleInfo & lhs = lhs_candidate.info_;
+                      const KeepDribbleInfo & rhs = rhs_candidate.info_;
+                      if ( lhs.dash_count_ > rhs.dash_count_ ) return true;
+                      if ( lhs.dash_count_ == rhs.dash_count_ )
+                      {
+                          if ( lhs.min_opp_dist_ > 5.0
+                               && rhs.min_opp_dist_ > 5.0 )
+                          {
+                              return lhs.ball_forward_travel_ > rhs.ball_forward_travel_;
+                          }
+                          return lhs.min_opp_dist_ > rhs.min_opp_dist_;
+                      }
+                      return false;
+                  } );
 
     dlog.addText( Logger::DRIBBLE,
-                  "___ total loop=%d, solution size=%d, elapsed %.3f [ms]",
-                  total_loop_count, dribble_info.size(), timer.elapsedReal() );
+                  "___ total loop=%d, found=%d truncated=%d, elapsed %.3f [ms]",
+                  (int)search.evaluatedCount(), (int)search.hasBest(), (int)search.truncated(),
+                  timer.elapsedReal() );
 
-    if ( dribble_info.empty() )
+    if ( ! search.hasBest() )
     {
         dlog.addText( Logger::DRIBBLE,
                       __FILE__": doKickDashesWithBall() no solution" );
@@ -1231,25 +1731,7 @@ Body_Dribble2008::doKickDashesWithBall( PlayerAgent * agent,
         return false;
     }
 
-    std::vector< KeepDribbleInfo >::const_iterator dribble
-        = std::min_element( dribble_info.begin(),
-                            dribble_info.end(),
-                            []( const KeepDribbleInfo & lhs, const KeepDribbleInfo & rhs )
-                              {
-                                  if ( lhs.dash_count_ > rhs.dash_count_ ) return true;
-                                  if ( lhs.dash_count_ == rhs.dash_count_ )
-                                  {
-                                       if ( lhs.min_opp_dist_ > 5.0
-                                            && rhs.min_opp_dist_ > 5.0 )
-                                       {
-                                           return lhs.ball_forward_travel_ > rhs.ball_forward_travel_;
-                                           //return lhs.ball_forward_travel_ < rhs.ball_forward_travel_;
-                                           ///return lhs.last_ball_rel_.absX() < rhs.last_ball_rel_.absX();
-                                       }
-                                       return lhs.min_opp_dist_ > rhs.min_opp_dist_;
-                                  }
-                                  return false;
-                              });
+    const KeepDribbleInfo * dribble = &search.best().info_;
 
     if ( dodge_mode
          && dash_count > dribble->dash_count_ )
@@ -1328,7 +1810,7 @@ Body_Dribble2008::createSelfCache( PlayerAgent * agent,
                                    const double & dash_power,
                                    const int turn_count,
                                    const int dash_count,
-                                   std::vector< Vector2D > & self_cache )
+                                   ScratchVector< Vector2D > & self_cache )
 {
     const WorldModel & wm = agent->world();
 
@@ -1414,17 +1896,14 @@ Body_Dribble2008::createSelfCache( PlayerAgent * agent,
  */
 bool
 Body_Dribble2008::simulateKickDashes( const WorldModel & wm,
-                                      const std::vector< Vector2D > & self_cache,
+                                      const ScratchVector< Vector2D > & self_cache,
                                       const int dash_count,
                                       const AngleDeg & accel_angle,
                                       const Vector2D & first_ball_pos,
                                       const Vector2D & first_ball_vel,
                                       KeepDribbleInfo * dribble_info )
 {
-    static const Rect2D pitch_rect( Vector2D( - ServerParam::i().pitchHalfLength() + 0.2,
-                                              - ServerParam::i().pitchHalfWidth() + 0.2 ),
-                                    Size2D( ServerParam::i().pitchLength() - 0.4,
-                                            ServerParam::i().pitchWidth() - 0.4 ) );
+    const Rect2D & pitch_rect = dribble_pitch_rect();
 
     if ( ! pitch_rect.contains( first_ball_pos ) )
     {
@@ -1464,7 +1943,7 @@ Body_Dribble2008::simulateKickDashes( const WorldModel & wm,
     Vector2D last_ball_rel( 0.0, 0.0 );
 
     // future state loop
-    for ( std::vector< Vector2D >::const_iterator my_pos = self_cache.begin() + 1, end = self_cache.end();
+    for ( ScratchVector< Vector2D >::const_iterator my_pos = self_cache.begin() + 1, end = self_cache.end();
           my_pos != end;
           ++my_pos )
     {
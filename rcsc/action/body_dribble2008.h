@@ -34,6 +34,7 @@
 
 #include <rcsc/player/soccer_action.h>
 #include <rcsc/geom/vector_2d.h>
+#include <rcsc/util/cycle_arena.h>
 
 #include <vector>
 
@@ -226,9 +227,9 @@ private:
                           const double & dash_power,
                           const int turn_count,
                           const int dash_count,
-                          std::vector< Vector2D > & self_cache );
+                          ScratchVector< Vector2D > & self_cache );
     bool simulateKickDashes( const WorldModel & wm,
-                             const std::vector< Vector2D > & self_cache,
+                             const ScratchVector< Vector2D > & self_cache,
                              const int dash_count,
                              const AngleDeg & accel_angle,
                              const Vector2D & first_ball_pos,
@@ -38,13 +38,387 @@
 #include <rcsc/action/body_go_to_point.h>
 
 #include <rcsc/player/player_agent.h>
+#include <rcsc/player/agent_context.h>
 #include <rcsc/common/logger.h>
 #include <rcsc/common/server_param.h>
 #include <rcsc/geom/line_2d.h>
+#include <rcsc/time/timer.h>
 #include <rcsc/math_util.h>
 
+#include <algorithm>
+#include <vector>
+#include <limits>
+#include <cmath>
+
 namespace rcsc {
 
+namespace {
+
+//! the number of detour points around each obstacle
+constexpr int DETOUR_DIVS = 8;
+//! the maximum number of obstacles given to the planner
+constexpr std::size_t MAX_OBSTACLES = 8;
+//! the maximum number of node expansions in one search
+constexpr int MAX_EXPANSIONS = 128;
+//! time budget of the planning in one cycle [nsec]
+constexpr std::int64_t PLAN_BUDGET_NSEC = 1000 * 1000;
+//! players farther than this distance from self are ignored
+constexpr double CONSIDER_DIST_MAX = 10.0;
+//! the waypoint is regarded as reached within this distance
+constexpr double WAYPOINT_REACH_DIST = 0.5;
+//! the previous plan is reused if the target has moved less than this distance
+constexpr double TARGET_TOLERANCE = 0.5;
+
+/*!
+  \struct DodgeObstacle
+  \brief player or ball inflated by the player sizes
+ */
+struct DodgeObstacle {
+    Vector2D pos_; //!< center position
+    double radius_; //!< inflated radius
+    double dist2_; //!< squared distance from self
+};
+
+/*!
+  \struct DodgePathCache
+  \brief the last planned path. stored in each agent's context.
+ */
+struct DodgePathCache {
+    GameTime update_time_; //!< last updated time
+    Vector2D target_; //!< target point of the path
+    std::vector< Vector2D > waypoints_; //!< sub targets. the last element is the target point.
+    std::vector< DodgeObstacle > obstacles_; //!< obstacles of the current cycle
+
+    DodgePathCache()
+        : update_time_( 0, 0 ),
+          target_( Vector2D::INVALIDATED )
+      { }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the squared distance from the point to the segment
+ */
+inline
+double
+segment_dist2( const Vector2D & a,
+               const Vector2D & b,
+               const Vector2D & p )
+{
+    const Vector2D ab = b - a;
+    const double len2 = ab.r2();
+    if ( len2 < 1.0e-10 )
+    {
+        return a.dist2( p );
+    }
+
+    const double t = bound( 0.0, ( p - a ).innerProduct( ab ) / len2, 1.0 );
+    return ( a + ab * t ).dist2( p );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief check if the segment overlaps any obstacle
+ */
+bool
+is_blocked( const Vector2D & a,
+            const Vector2D & b,
+            const std::vector< DodgeObstacle > & obstacles )
+{
+    for ( const DodgeObstacle & o : obstacles )
+    {
+        if ( segment_dist2( a, b, o.pos_ ) < o.radius_ * o.radius_ )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create the obstacles around the current path.
+  the obstacles that include self or the target point are ignored,
+  because they cannot be avoided.
+ */
+void
+create_obstacles( const WorldModel & wm,
+                  const Vector2D & target,
+                  std::vector< DodgeObstacle > * obstacles )
+{
+    const ServerParam & SP = ServerParam::i();
+    const Vector2D & self_pos = wm.self().pos();
+    const double self_size = wm.self().playerType().playerSize();
+    const double consider_dist = std::min( CONSIDER_DIST_MAX,
+                                           self_pos.dist( target ) + 2.0 );
+
+    obstacles->clear();
+
+    const auto add = [&]( const Vector2D & pos, const double radius )
+        {
+            const double r2 = radius * radius;
+            const double d2 = self_pos.dist2( pos );
+            if ( d2 < r2
+                 || target.dist2( pos ) < r2 )
+            {
+                return;
+            }
+            obstacles->push_back( DodgeObstacle{ pos, radius, d2 } );
+        };
+
+    for ( const PlayerObject::Cont * players : { &wm.teammatesFromSelf(), &wm.opponentsFromSelf() } )
+    {
+        for ( const PlayerObject * p : *players )
+        {
+            if ( p->distFromSelf() > consider_dist )
+            {
+                break;
+            }
+
+            const double size = ( p->playerTypePtr()
+                                  ? p->playerTypePtr()->playerSize()
+                                  : SP.defaultPlayerSize() );
+            add( p->pos(), self_size + size + 0.1 );
+        }
+    }
+
+    if ( wm.gameMode().type() != GameMode::PlayOn
+         && wm.ball().posValid()
+         && wm.ball().distFromSelf() < consider_dist )
+    {
+        add( wm.ball().pos(), 1.5 );
+    }
+
+    if ( obstacles->size() > MAX_OBSTACLES )
+    {
+        std::nth_element( obstacles->begin(),
+                          obstacles->begin() + MAX_OBSTACLES,
+                          obstacles->end(),
+                          []( const DodgeObstacle & lhs,
+                              const DodgeObstacle & rhs )
+                            {
+                                return lhs.dist2_ < rhs.dist2_;
+                            } );
+        obstacles->resize( MAX_OBSTACLES );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief search the shortest path on the visibility graph of the detour points.
+  \param start start point
+  \param goal goal point
+  \param obstacles obstacles
+  \param budget time limit of the planning
+  \param deadline time limit of the decision
+  \param path the result waypoints are appended to this. the start point is not included.
+  \return true if the path is found within the limits
+ */
+bool
+plan_path( const Vector2D & start,
+           const Vector2D & goal,
+           const std::vector< DodgeObstacle > & obstacles,
+           const Deadline & budget,
+           const Deadline & deadline,
+           std::vector< Vector2D > * path )
+{
+    // node 0 is the start point, node 1 is the goal point
+    std::vector< Vector2D > nodes;
+    nodes.reserve( 2 + obstacles.size() * DETOUR_DIVS );
+    nodes.push_back( start );
+    nodes.push_back( goal );
+
+    // the detour polygon circumscribes the obstacle circle
+    const double polygon_rate = 1.01 / std::cos( M_PI / DETOUR_DIVS );
+    for ( const DodgeObstacle & o : obstacles )
+    {
+        for ( int i = 0; i < DETOUR_DIVS; ++i )
+        {
+            const Vector2D p = o.pos_ + Vector2D::polar2vector( o.radius_ * polygon_rate,
+                                                               360.0 / DETOUR_DIVS * i );
+            bool inside = false;
+            for ( const DodgeObstacle & other : obstacles )
+            {
+                if ( other.pos_.dist2( p ) < other.radius_ * other.radius_ )
+                {
+                    inside = true;
+                    break;
+                }
+            }
+            if ( ! inside )
+            {
+                nodes.push_back( p );
+            }
+        }
+    }
+
+    const std::size_t size = nodes.size();
+    std::vector< double > cost( size, std::numeric_limits< double >::max() );
+    std::vector< int > parent( size, -1 );
+    std::vector< char > closed( size, 0 );
+
+    cost[0] = 0.0;
+
+    for ( int expansion = 0; expansion < MAX_EXPANSIONS; ++expansion )
+    {
+        if ( budget.poll()
+             || deadline.poll() )
+        {
+            return false;
+        }
+
+        // linear scan is enough for this number of nodes
+        int current = -1;
+        double best_f = std::numeric_limits< double >::max();
+        for ( std::size_t i = 0; i < size; ++i )
+        {
+            if ( closed[i]
+                 || cost[i] == std::numeric_limits< double >::max() )
+            {
+                continue;
+            }
+
+            const double f = cost[i] + nodes[i].dist( goal );
+            if ( f < best_f )
+            {
+                best_f = f;
+                current = static_cast< int >( i );
+            }
+        }
+
+        if ( current < 0 )
+        {
+            return false;
+        }
+
+        if ( current == 1 )
+        {
+            std::vector< Vector2D > reversed;
+            for ( int n = 1; n != 0; n = parent[n] )
+            {
+                reversed.push_back( nodes[n] );
+            }
+            path->insert( path->end(), reversed.rbegin(), reversed.rend() );
+            return true;
+        }
+
+        closed[current] = 1;
+
+        for ( std::size_t i = 1; i < size; ++i )
+        {
+            if ( closed[i] )
+            {
+                continue;
+            }
+
+            const double c = cost[current] + nodes[current].dist( nodes[i] );
+            if ( c < cost[i]
+                 && ! is_blocked( nodes[current], nodes[i], obstacles ) )
+            {
+                cost[i] = c;
+                parent[i] = current;
+            }
+        }
+    }
+
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief update the cached path. the previous path is repaired if possible.
+  \return true if the cached path is available
+ */
+bool
+update_dodge_path( const WorldModel & wm,
+                   const Vector2D & target,
+                   DodgePathCache & cache )
+{
+    if ( cache.update_time_ == wm.time()
+         && cache.target_.isValid()
+         && cache.target_.dist2( target ) < square( TARGET_TOLERANCE ) )
+    {
+        return ! cache.waypoints_.empty();
+    }
+
+    cache.update_time_ = wm.time();
+    create_obstacles( wm, target, &cache.obstacles_ );
+
+    const Vector2D & self_pos = wm.self().pos();
+    const Deadline budget( TimeStamp::now(), PLAN_BUDGET_NSEC );
+    std::vector< Vector2D > & waypoints = cache.waypoints_;
+
+    if ( cache.target_.isValid()
+         && cache.target_.dist2( target ) < square( TARGET_TOLERANCE )
+         && ! waypoints.empty() )
+    {
+        waypoints.back() = target;
+        cache.target_ = target;
+
+        // remove the reached waypoints and the waypoints that can be skipped
+        std::size_t first = 0;
+        while ( first + 1 < waypoints.size()
+                && ( self_pos.dist2( waypoints[first] ) < square( WAYPOINT_REACH_DIST )
+                     || ! is_blocked( self_pos, waypoints[first + 1], cache.obstacles_ ) ) )
+        {
+            ++first;
+        }
+        waypoints.erase( waypoints.begin(), waypoints.begin() + first );
+
+        // find the first segment blocked by the moved obstacles
+        std::size_t blocked = waypoints.size();
+        Vector2D from = self_pos;
+        for ( std::size_t i = 0; i < waypoints.size(); ++i )
+        {
+            if ( is_blocked( from, waypoints[i], cache.obstacles_ ) )
+            {
+                blocked = i;
+                break;
+            }
+            from = waypoints[i];
+        }
+
+        if ( blocked == waypoints.size() )
+        {
+            dlog.addText( Logger::ACTION,
+                          __FILE__": reuse the path. size=%d",
+                          static_cast< int >( waypoints.size() ) );
+            return true;
+        }
+
+        // replan only after the last valid waypoint
+        from = ( blocked == 0 ? self_pos : waypoints[blocked - 1] );
+        waypoints.resize( blocked );
+        if ( plan_path( from, target, cache.obstacles_,
+                        budget, wm.decisionDeadline(), &waypoints ) )
+        {
+            dlog.addText( Logger::ACTION,
+                          __FILE__": repair the path from the waypoint %d. size=%d",
+                          static_cast< int >( blocked ), static_cast< int >( waypoints.size() ) );
+            return true;
+        }
+    }
+
+    cache.target_ = target;
+    waypoints.clear();
+    if ( plan_path( self_pos, target, cache.obstacles_,
+                    budget, wm.decisionDeadline(), &waypoints ) )
+    {
+        dlog.addText( Logger::ACTION,
+                      __FILE__": new path. size=%d",
+                      static_cast< int >( waypoints.size() ) );
+        return true;
+    }
+
+    dlog.addText( Logger::ACTION,
+                  __FILE__": no path within the limit." );
+    cache.target_.invalidate();
+    waypoints.clear();
+    return false;
+}
+
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -56,6 +430,37 @@ Body_GoToPointDodge::execute( PlayerAgent * agent )
                   "%s:%d: Body_GoToPointDodge"
                   ,__FILE__, __LINE__ );
 
+    const WorldModel & wm = agent->world();
+
+    if ( wm.self().pos().dist( M_point )
+         >= ServerParam::i().defaultPlayerSize() * 2.0 )
+    {
+        DodgePathCache & cache = wm.agentContext().get< DodgePathCache >();
+        if ( update_dodge_path( wm, M_point, cache ) )
+        {
+            const Vector2D sub_target = cache.waypoints_.front();
+            if ( cache.waypoints_.size() == 1 )
+            {
+                return Body_GoToPoint( M_point,
+                                       0.1,
+                                       M_dash_power,
+                                       -1.0, // dash speed
+                                       3 ).execute( agent );
+            }
+
+            dlog.addText( Logger::ACTION,
+                          "%s:%d: path sub-target(%f, %f) waypoints=%d"
+                          ,__FILE__, __LINE__,
+                          sub_target.x, sub_target.y, static_cast< int >( cache.waypoints_.size() ) );
+            return Body_GoToPoint( sub_target,
+                                   WAYPOINT_REACH_DIST,
+                                   M_dash_power,
+                                   -1.0, // dash speed
+                                   3 ).execute( agent );
+        }
+    }
+
+    // planner failed. avoid only the nearest obstacle.
     Vector2D dodge_pos;
     if ( ! get_dodge_point( agent, M_point, &dodge_pos ) )
     {
@@ -40,6 +40,12 @@ namespace rcsc {
 /*!
   \class Body_GoToPointDodge
   \brief sub behavior for Body_GoToPoint.
+
+  The path around the nearby players is planned on the visibility graph
+  of their detour points. The path is kept in the agent context, and it
+  is reused or repaired from the first blocked segment while the target
+  point does not change. If no path is found within the time budget,
+  only the nearest obstacle is avoided.
 */
 class Body_GoToPointDodge
     : public BodyAction {
@@ -40,6 +40,7 @@
 #include "body_stop_ball.h"
 
 #include <rcsc/player/player_agent.h>
+#include <rcsc/player/agent_context.h>
 #include <rcsc/player/debug_client.h>
 
 #include <rcsc/common/logger.h>
@@ -47,6 +48,9 @@
 #include <rcsc/geom/rect_2d.h>
 #include <rcsc/geom/line_2d.h>
 
+#include <algorithm>
+#include <cmath>
+
 // #define DEBUG_CREATE
 // #define DEBUG_EVAL
 // #define DEBUG_PRINT_RESULTS
@@ -63,6 +67,344 @@ struct KeepPointSorter {
       }
 };
 
+/*!
+  \struct KeepPointTemplate
+  \brief candidate offsets from the next self position.
+
+  The offsets depend only on the player type, so they are rebuilt only
+  when the ring distances are changed.
+ */
+struct KeepPointTemplate {
+    static const int DIR_DIVS = 20; //!< number of directions
+    static const int RINGS = 3; //!< near, middle and far
+
+    double ring_dist_[RINGS]; //!< distance from the player of each ring
+    AngleDeg angle_[DIR_DIVS]; //!< global direction of each offset
+    Vector2D offset_[DIR_DIVS * RINGS]; //!< ordered by direction, then by ring
+
+    KeepPointTemplate()
+      {
+          for ( double & d : ring_dist_ ) d = -1.0;
+      }
+
+    void update( const PlayerType & ptype,
+                 const double ball_size )
+      {
+          static const double ring_rate[RINGS] = { 0.4, 0.6, 0.75 };
+
+          double dist[RINGS];
+          for ( int r = 0; r < RINGS; ++r )
+          {
+              dist[r] = ptype.playerSize() + ball_size + ptype.kickableMargin() * ring_rate[r];
+          }
+
+          if ( std::equal( dist, dist + RINGS, ring_dist_ ) )
+          {
+              return;
+          }
+
+          std::copy( dist, dist + RINGS, ring_dist_ );
+
+          const double dir_step = 360.0 / DIR_DIVS;
+          Vector2D * offset = offset_;
+          for ( int a = 0; a < DIR_DIVS; ++a )
+          {
+              angle_[a] = -180.0 + dir_step * a;
+              const Vector2D unit_pos = Vector2D::polar2vector( 1.0, angle_[a] );
+              for ( int r = 0; r < RINGS; ++r )
+              {
+                  *offset++ = unit_pos.setLengthVector( ring_dist_[r] );
+              }
+          }
+      }
+};
+
+/*!
+  \struct KeepPointCache
+  \brief keep point candidates of the current cycle. stored in each agent's context.
+ */
+struct KeepPointCache {
+    GameTime update_time_; //!< last calculated time
+    std::vector< Body_HoldBall2008::KeepPoint > keep_points_; //!< candidates
+    Body_HoldBall2008::KeepPoint best_keep_point_; //!< the best candidate
+    KeepPointTemplate template_; //!< candidate offsets of the current player type
+
+    KeepPointCache()
+        : update_time_( 0, 0 )
+      { }
+};
+
+/*!
+  \brief get their penalty area
+  \return const reference to the rectangle
+ */
+const Rect2D &
+their_penalty_area()
+{
+    static const Rect2D s_area( Vector2D( ServerParam::i().theirPenaltyAreaLineX(),
+                                          - ServerParam::i().penaltyAreaHalfWidth() ),
+                                Size2D( ServerParam::i().penaltyAreaLength(),
+                                        ServerParam::i().penaltyAreaWidth() ) );
+    return s_area;
+}
+
+/*!
+  \struct OpponentSet
+  \brief opponent values used by the keep point evaluation.
+  computed once for all keep points.
+ */
+struct OpponentSet {
+
+    struct Info {
+        const PlayerObject * player_; //!< opponent
+        Vector2D next_; //!< estimated next position
+        double kickable_area_; //!< kickable area of the opponent
+        bool goalie_in_penalty_area_; //!< true if the goalie can catch the ball in the penalty area
+        double body_cos_; //!< cos( -body )
+        double body_sin_; //!< sin( -body )
+        std::size_t move_begin_; //!< the first index in max_moves_
+#ifdef DEBUG_EVAL
+        AngleDeg body_;
+#endif
+    };
+
+    std::vector< Info > infos_; //!< opponents within the considered distance
+    std::vector< Vector2D > max_moves_; //!< the dash move vectors of each opponent
+    std::size_t move_count_; //!< number of dash directions
+
+    void create( const WorldModel & wm );
+};
+
+/*!
+  \brief collect the opponents around the ball
+  \param wm world model
+ */
+void
+OpponentSet::create( const WorldModel & wm )
+{
+    static const double consider_dist = ( ServerParam::i().tackleDist()
+                                          + ServerParam::i().defaultPlayerSpeedMax()
+                                          + 1.0 );
+    const ServerParam & SP = ServerParam::i();
+    const Rect2D & penalty_area = their_penalty_area();
+
+    const Vector2D my_next = wm.self().pos() + wm.self().vel();
+
+    const double dash_angle_step = std::max( 15.0, SP.dashAngleStep() );
+    const int dash_angle_divs
+        = static_cast< int >( std::floor( ( SP.maxDashAngle() - SP.minDashAngle() )
+                                          / dash_angle_step ) );
+
+    infos_.clear();
+    max_moves_.clear();
+    move_count_ = std::max( 0, dash_angle_divs );
+
+    for ( const PlayerObject * o : wm.opponentsFromBall() )
+    {
+        if ( o->distFromBall() > consider_dist ) break;
+
+        if ( o->posCount() > 10 ) continue;
+        if ( o->isGhost() ) continue;
+        if ( o->isTackling() ) continue;
+
+        const PlayerType * player_type = o->playerTypePtr();
+
+        Info info;
+        info.player_ = o;
+        info.next_ = o->pos() + o->vel();
+        info.kickable_area_ = player_type->kickableArea();
+        info.goalie_in_penalty_area_ = ( o->goalie()
+                                         && penalty_area.contains( info.next_ ) );
+
+        AngleDeg opp_body;
+        if ( o->bodyCount() == 0 )
+        {
+            opp_body = o->body();
+        }
+        else if ( o->velCount() <= 1
+                  && o->vel().r() > 0.2 )
+        {
+            opp_body = o->vel().th();
+        }
+        else
+        {
+            opp_body = ( my_next - info.next_ ).th();
+        }
+
+        const double rotation = -opp_body.degree() * AngleDeg::DEG2RAD;
+        info.body_cos_ = std::cos( rotation );
+        info.body_sin_ = std::sin( rotation );
+#ifdef DEBUG_EVAL
+        info.body_ = opp_body;
+#endif
+
+        info.move_begin_ = max_moves_.size();
+        for ( int d = 0; d < dash_angle_divs; ++d )
+        {
+            const double dir = AngleDeg::normalize_angle( SP.minDashAngle() + ( dash_angle_step * d ) );
+            const AngleDeg dash_angle = SP.discretizeDashAngle( dir );
+            const double max_accel = ( SP.maxDashPower()
+                                       * player_type->dashPowerRate()
+                                       * player_type->effortMax()
+                                       * SP.dashDirRate( dir ) );
+            max_moves_.push_back( Vector2D::from_polar( max_accel, dash_angle ) );
+        }
+
+        infos_.push_back( info );
+    }
+}
+
+/*!
+  \brief evaluate all keep points by the same opponent set.
+  \param wm world model
+  \param opponents opponent values
+  \param points keep points
+  \param scores result scores. the same order as points.
+
+  The opponents are checked in the outer loop, so the values of each
+  opponent are loaded only once. The penalties of each point are added in
+  the same order as the per-point evaluation.
+ */
+void
+evaluate_keep_points( const WorldModel & wm,
+                      const OpponentSet & opponents,
+                      const std::vector< Vector2D > & points,
+                      std::vector< double > * scores )
+{
+    const ServerParam & SP = ServerParam::i();
+    const Rect2D & penalty_area = their_penalty_area();
+
+    const double catchable_area = SP.catchableArea();
+    const double tackle_dist = SP.tackleDist();
+    const double tackle_back_dist = SP.tackleBackDist();
+    const double tackle_width = SP.tackleWidth();
+    const double foul_exponent = SP.foulExponent();
+
+    const std::size_t size = points.size();
+    scores->assign( size, Body_HoldBall2008::DEFAULT_SCORE );
+    double * score = scores->data();
+
+    for ( const OpponentSet::Info & o : opponents.infos_ )
+    {
+        const Vector2D * max_moves = opponents.max_moves_.data() + o.move_begin_;
+
+        for ( std::size_t i = 0; i < size; ++i )
+        {
+            const Vector2D & keep_point = points[i];
+            const double control_area = ( ( o.goalie_in_penalty_area_
+                                            && penalty_area.contains( keep_point ) )
+                                          ? catchable_area
+                                          : o.kickable_area_ );
+            const double opp_dist = o.next_.dist( keep_point );
+
+            if ( opp_dist < control_area * 0.5 )
+            {
+                score[i] -= 200.0;
+            }
+            else if ( opp_dist < control_area + 0.1 )
+            {
+                score[i] -= 150.0;
+            }
+            else if ( opp_dist < tackle_dist - 0.2 )
+            {
+                score[i] -= 25.0;
+            }
+
+            //
+            // check opponent body line
+            //
+            const Vector2D rel = keep_point - o.next_;
+            const Vector2D player_2_pos( rel.x * o.body_cos_ - rel.y * o.body_sin_,
+                                         rel.x * o.body_sin_ + rel.y * o.body_cos_ );
+
+            if ( player_2_pos.absY() < control_area )
+            {
+                score[i] -= ( control_area - player_2_pos.absY() ) * 50.0;
+            }
+
+            //
+            // check tackle probability
+            //
+            {
+                double tackle_len = ( player_2_pos.x > 0.0
+                                      ? tackle_dist
+                                      : tackle_back_dist );
+                if ( tackle_len > 1.0e-5 )
+                {
+                    double tackle_fail_prob = ( std::pow( player_2_pos.absX() / tackle_len,
+                                                          foul_exponent )
+                                                + std::pow( player_2_pos.absY() / tackle_width,
+                                                            foul_exponent ) );
+                    if ( tackle_fail_prob < 1.0 )
+                    {
+                        score[i] -= ( 1.0 - tackle_fail_prob ) * 50.0;
+                    }
+                }
+            }
+
+            //
+            // check kick or tackle possibility after dash
+            //
+            const double next_control_area2 = std::pow( control_area + 0.1, 2 );
+            double next_kick_penalty = 0.0;
+            double next_tackle_penalty = 0.0;
+            for ( std::size_t d = 0; d < opponents.move_count_; ++d )
+            {
+                const Vector2D next_player_2_pos = player_2_pos - max_moves[d];
+
+                if ( next_player_2_pos.r2() < next_control_area2 )
+                {
+                    next_kick_penalty -= 20.0;
+                }
+                else if ( next_player_2_pos.absY() < tackle_width + 0.1
+                          && next_player_2_pos.x > 0.0
+                          && next_player_2_pos.x < tackle_dist + 0.1 )
+                {
+                    next_tackle_penalty -= 10.0;
+                }
+            }
+
+            score[i] += next_kick_penalty;
+            score[i] += next_tackle_penalty;
+
+#ifdef DEBUG_EVAL
+            dlog.addText( Logger::HOLD,
+                          "____ point (%.2f %.2f) opp %d(%.1f %.1f) body=%.1f"
+                          " kick_penalty=%.1f tackle_penalty=%.1f score=%.3f",
+                          keep_point.x, keep_point.y,
+                          o.player_->unum(),
+                          o.player_->pos().x, o.player_->pos().y,
+                          o.body_.degree(),
+                          next_kick_penalty, next_tackle_penalty, score[i] );
+#endif
+        }
+    }
+
+#if 1
+    const Vector2D my_next = wm.self().pos() + wm.self().vel();
+    const double kickable_area = wm.self().playerType().kickableArea();
+    const Vector2D ball_pos = wm.ball().pos();
+    for ( std::size_t i = 0; i < size; ++i )
+    {
+        double ball_move_dist = ( points[i] - ball_pos ).r();
+        if ( ball_move_dist > kickable_area * 1.6 )
+        {
+            double next_ball_dist = my_next.dist( points[i] );
+            double threshold = kickable_area - 0.4;
+            double rate = 1.0 - 0.5 * std::max( 0.0, ( next_ball_dist - threshold ) / 0.4 );
+            score[i] *= rate;
+
+#ifdef DEBUG_EVAL
+            dlog.addText( Logger::HOLD,
+                          "__ point (%.2f %.2f) applied keep distance threshold."
+                          " ball_dist=%.3f thr=%.3f rate=%f",
+                          points[i].x, points[i].y,
+                          next_ball_dist, threshold, rate );
+#endif
+        }
+    }
+#endif
+}
 }
 
 const double Body_HoldBall2008::DEFAULT_SCORE = 100.0;
@@ -162,26 +504,25 @@ Body_HoldBall2008::avoidOpponent( PlayerAgent * agent )
 Vector2D
 Body_HoldBall2008::searchKeepPoint( const WorldModel & wm )
 {
-    static GameTime s_last_update_time( 0, 0 );
-    static std::vector< KeepPoint > s_keep_points;
-    static KeepPoint s_best_keep_point;
+    KeepPointCache & cache = wm.agentContext().get< KeepPointCache >();
 
-    if ( s_last_update_time != wm.time() )
+    if ( cache.update_time_ != wm.time() )
     {
-        s_best_keep_point.reset();
+        cache.update_time_ = wm.time();
+        cache.best_keep_point_.reset();
 
-        createKeepPoints( wm, s_keep_points );
-        evaluateKeepPoints( wm, s_keep_points );
+        createKeepPoints( wm, cache.keep_points_ );
+        evaluateKeepPoints( wm, cache.keep_points_ );
 
-        if ( ! s_keep_points.empty() )
+        if ( ! cache.keep_points_.empty() )
         {
-            s_best_keep_point = *std::max_element( s_keep_points.begin(),
-                                                   s_keep_points.end(),
-                                                   KeepPointSorter() );
+            cache.best_keep_point_ = *std::max_element( cache.keep_points_.begin(),
+                                                        cache.keep_points_.end(),
+                                                        KeepPointSorter() );
         }
     }
 
-    return s_best_keep_point.pos_;
+    return cache.best_keep_point_.pos_;
 }
 
 /*-------------------------------------------------------------------*/
@@ -193,6 +534,7 @@ Body_HoldBall2008::createKeepPoints( const WorldModel & wm,
                                      std::vector< KeepPoint > & candidates )
 {
     const ServerParam & SP = ServerParam::i();
+    const PlayerType & ptype = wm.self().playerType();
 
     const double max_pitch_x = ( SP.keepawayMode()
                                  ? SP.keepawayLength() * 0.5 - 0.2
@@ -201,276 +543,131 @@ Body_HoldBall2008::createKeepPoints( const WorldModel & wm,
                                  ? SP.keepawayWidth() * 0.5 - 0.2
                                  : SP.pitchHalfWidth() - 0.2 );
 
-    const int dir_divs = 20;
-    const double dir_step = 360.0 / dir_divs;
-
-    const double near_dist = wm.self().playerType().playerSize()
-        + SP.ballSize()
-        + wm.self().playerType().kickableMargin() * 0.4;
-    const double mid_dist = wm.self().playerType().playerSize()
-        + SP.ballSize()
-        + wm.self().playerType().kickableMargin() * 0.6;
-    const double far_dist = wm.self().playerType().playerSize()
-        + SP.ballSize()
-        + wm.self().playerType().kickableMargin() * 0.75;
+    KeepPointTemplate & tmpl = wm.agentContext().get< KeepPointCache >().template_;
+    tmpl.update( ptype, SP.ballSize() );
 
     candidates.clear();
-    candidates.reserve( dir_divs * 2 );
+    candidates.reserve( KeepPointTemplate::DIR_DIVS * KeepPointTemplate::RINGS );
 
 #ifdef DEBUG_CREATE
     dlog.addText( Logger::HOLD,
                   __FILE__": createCandidatePoints() dir_divs=%d",
-                  dir_divs );
+                  KeepPointTemplate::DIR_DIVS );
+    static const char * ring_name[] = { "near", "mid", "far" };
 #endif
 
     const Vector2D my_next = wm.self().pos() + wm.self().vel();
+    const Vector2D ball_pos = wm.ball().pos();
+    const Vector2D ball_vel = wm.ball().vel();
+
+    const double max_power = SP.maxPower();
+    const double ball_decay = SP.ballDecay();
+    const double ball_rand = SP.ballRand();
+    const double my_kick_rate = wm.self().kickRate();
+    const double kickable_area = ptype.kickableArea();
+    const double kick_rand = ptype.kickRand();
 
     const double my_noise = wm.self().vel().r() * SP.playerRand();
     const double current_dir_diff_rate
         = ( wm.ball().angleFromSelf() - wm.self().body() ).abs() / 180.0;
     const double current_dist_rate
         = ( wm.ball().distFromSelf()
-            - wm.self().playerType().playerSize()
+            - ptype.playerSize()
             - SP.ballSize() )
-        / wm.self().playerType().kickableMargin();
+        / ptype.kickableMargin();
     const double current_pos_rate
         = 0.5 + 0.25 * ( current_dir_diff_rate + current_dist_rate );
     const double current_speed_rate
-        = 0.5 + 0.5 * ( wm.ball().vel().r()
-                        / ( SP.ballSpeedMax() * SP.ballDecay() ) );
+        = 0.5 + 0.5 * ( ball_vel.r() / ( SP.ballSpeedMax() * ball_decay ) );
+    const double noise_rate = current_pos_rate + current_speed_rate;
 
-    // angle loop
-    for ( double d = -180.0; d < 180.0; d += dir_step )
+    // angle loop. the template offsets are ordered by (direction, ring).
+    const Vector2D * offset = tmpl.offset_;
+    for ( int a = 0; a < KeepPointTemplate::DIR_DIVS; ++a )
     {
-        const AngleDeg angle = d;
-        const double dir_diff = ( angle - wm.self().body() ).abs();
-        const Vector2D unit_pos = Vector2D::polar2vector( 1.0, angle );
+        const double dir_diff = ( tmpl.angle_[a] - wm.self().body() ).abs();
 
-        // near side point
-        {
-        const Vector2D near_pos = my_next + unit_pos.setLengthVector( near_dist );
-        if ( near_pos.absX() < max_pitch_x
-             && near_pos.absY() < max_pitch_y )
+        for ( int r = 0; r < KeepPointTemplate::RINGS; ++r, ++offset )
         {
-            Vector2D ball_move = near_pos - wm.ball().pos();
-            Vector2D kick_accel = ball_move - wm.ball().vel();
-
-            // can kick to the point by 1 step kick
-            if ( kick_accel.r() < SP.maxPower() * wm.self().kickRate() )
+            const double dist = tmpl.ring_dist_[r];
+            const Vector2D pos = my_next + *offset;
+            if ( pos.absX() >= max_pitch_x
+                 || pos.absY() >= max_pitch_y )
             {
-                double near_krate = wm.self().playerType().kickRate( near_dist, dir_diff );
-                // can stop the ball by 1 step kick
-                if ( ball_move.r() * SP.ballDecay() < SP.maxPower() * near_krate )
-                {
-#ifdef DEBUG_CREATE
-                    dlog.addText( Logger::HOLD,
-                                  "__add near point (%.2f %.2f) angle=%.0f dist=%.2f",
-                                  near_pos.x, near_pos.y,
-                                  d, near_dist );
-#endif
-                    candidates.emplace_back( near_pos,
-                                             near_krate,
-                                             DEFAULT_SCORE );
-                }
-#ifdef DEBUG_CREATE
-                else
-                {
-                    dlog.addText( Logger::HOLD,
-                                  "__cancel near point (%.2f %.2f) angle=%.0f dist=%.2f"
-                                  " cannot stop ball"
-                                  " ball_move=(%.3f %.3f)%.3f krate=%f",
-                                  near_pos.x, near_pos.y,
-                                  d, near_dist,
-                                  ball_move.x, ball_move.y, ball_move.r(),
-                                  near_krate );
-                }
-#endif
+                continue;
             }
-#ifdef DEBUG_CREATE
-            else
-            {
-                dlog.addText( Logger::HOLD,
-                              "__cancel near point (%.2f %.2f) angle=%.0f dist=%.2f"
-                              " cannot kick"
-                              " required_accel=(%.3f %.3f)%.3f cur_krate=%f",
-                              near_pos.x, near_pos.y,
-                              d, near_dist,
-                              kick_accel.x, kick_accel.y,
-                              kick_accel.r(),
-                              wm.self().kickRate() );
-            }
-#endif
-        }
-        }
 
-        // middle point
-        {
-        const Vector2D mid_pos = my_next + unit_pos.setLengthVector( mid_dist );
-        if ( mid_pos.absX() < max_pitch_x
-             && mid_pos.absY() < max_pitch_y )
-        {
-            Vector2D ball_move = mid_pos - wm.ball().pos();
-            Vector2D kick_accel = ball_move - wm.ball().vel();
-            double kick_power = kick_accel.r() / wm.self().kickRate();
+            const Vector2D ball_move = pos - ball_pos;
+            const Vector2D kick_accel = ball_move - ball_vel;
+            const double kick_power = kick_accel.r() / my_kick_rate;
 
             // can kick to the point by 1 step kick
-            if ( kick_power < SP.maxPower() )
+            if ( kick_power >= max_power )
             {
-                // check move noise
-                const double move_dist = ball_move.r();
-                const double ball_noise = move_dist * SP.ballRand();
-                const double max_kick_rand
-                    = wm.self().playerType().kickRand()
-                    * ( kick_power / SP.maxPower() )
-                    * ( current_pos_rate + current_speed_rate );
-                // move noise is small
-                if ( ( my_noise + ball_noise + max_kick_rand ) * 0.95
-                     < wm.self().playerType().kickableArea() - mid_dist - 0.1 )
-                {
-                    double mid_krate = wm.self().playerType().kickRate( mid_dist, dir_diff );
-                    // can stop the ball by 1 step kick
-                    if ( move_dist * SP.ballDecay()
-                         < SP.maxPower() * mid_krate )
-                    {
-#ifdef DEBUG_CREATE
-                        dlog.addText( Logger::HOLD,
-                                      "__add mid point (%.2f %.2f) angle=%.0f dist=%.2f",
-                                      mid_pos.x, mid_pos.y,
-                                      d, mid_dist );
-#endif
-                        candidates.emplace_back( mid_pos,
-                                                 mid_krate,
-                                                 DEFAULT_SCORE );
-                    }
-#ifdef DEBUG_CREATE
-                    else
-                    {
-                        dlog.addText( Logger::HOLD,
-                                      "__cancel mid point (%.2f %.2f) angle=%.0f dist=%.2f"
-                                      " cannot stop ball"
-                                      " ball_move=(%.3f %.3f)%.3f krate=%f",
-                                      mid_pos.x, mid_pos.y,
-                                      d, mid_dist,
-                                      ball_move.x, ball_move.y, ball_move.r(),
-                                      mid_krate );
-                    }
-#endif
-                }
-#ifdef DEBUG_CREATE
-                else
-                {
-                    dlog.addText( Logger::HOLD,
-                                  "__cancel mid point (%.2f %.2f) angle=%.0f dist=%.2f"
-                                  " big noise"
-                                  " my=%.3f ball=%.3f kick=%.3f. total=%f > kickable_buf=%f",
-                                  mid_pos.x, mid_pos.y,
-                                  d, mid_dist,
-                                  my_noise, ball_noise, max_kick_rand,
-                                  ( my_noise + ball_noise + max_kick_rand ) * 0.95,
-                                  wm.self().kickableArea() - mid_dist - 0.1 );
-                }
-#endif
-            }
 #ifdef DEBUG_CREATE
-            else
-            {
                 dlog.addText( Logger::HOLD,
-                              "__cancel mid point (%.2f %.2f) angle=%.0f dist=%.2f"
+                              "__cancel %s point (%.2f %.2f) angle=%.0f dist=%.2f"
                               " cannot kick"
                               " required_accel=(%.3f %.3f)%.3f cur_krate=%f",
-                              mid_pos.x, mid_pos.y,
-                              d, mid_dist,
+                              ring_name[r], pos.x, pos.y,
+                              tmpl.angle_[a].degree(), dist,
                               kick_accel.x, kick_accel.y,
                               kick_accel.r(),
-                              wm.self().kickRate() );
-            }
+                              my_kick_rate );
 #endif
-        }
-        }
+                continue;
+            }
 
-        // far side point
-        {
-        const Vector2D far_pos = my_next + unit_pos.setLengthVector( far_dist );
-        if ( far_pos.absX() < max_pitch_x
-             && far_pos.absY() < max_pitch_y )
-        {
-            Vector2D ball_move = far_pos - wm.ball().pos();
-            Vector2D kick_accel = ball_move - wm.ball().vel();
-            double kick_power = kick_accel.r() / wm.self().kickRate();
+            const double move_dist = ball_move.r();
 
-            // can kick to the point by 1 step kick
-            if ( kick_power < SP.maxPower() )
+            // check move noise. the near side point is always safe.
+            if ( r > 0 )
             {
-                // check move noise
-                const double move_dist = ball_move.r();
-                const double ball_noise = move_dist * SP.ballRand();
+                const double ball_noise = move_dist * ball_rand;
                 const double max_kick_rand
-                    = wm.self().playerType().kickRand()
-                    * ( kick_power / SP.maxPower() )
-                    * ( current_pos_rate + current_speed_rate );
-                // move noise is small
+                    = kick_rand * ( kick_power / max_power ) * noise_rate;
                 if ( ( my_noise + ball_noise + max_kick_rand ) * 0.95
-                     < wm.self().playerType().kickableArea() - far_dist - 0.1 )
+                     >= kickable_area - dist - 0.1 )
                 {
-                    double far_krate = wm.self().playerType().kickRate( far_dist, dir_diff );
-                    // can stop the ball by 1 step kick
-                    if ( move_dist * SP.ballDecay()
-                         < SP.maxPower() * far_krate )
-                    {
-#ifdef DEBUG_CREATE
-                        dlog.addText( Logger::HOLD,
-                                      "__add far point (%.2f %.2f) angle=%.0f dist=%.2f",
-                                      far_pos.x, far_pos.y,
-                                      d, far_dist );
-#endif
-                        candidates.emplace_back( far_pos,
-                                                 far_krate,
-                                                 DEFAULT_SCORE );
-                    }
-#ifdef DEBUG_CREATE
-                    else
-                    {
-                        dlog.addText( Logger::HOLD,
-                                  "__cancel far point (%.2f %.2f) angle=%.0f dist=%.2f"
-                                  " cannot stop ball"
-                                  " ball_move=(%.3f %.3f)%.3f krate=%f",
-                                  far_pos.x, far_pos.y,
-                                  d, far_dist,
-                                  ball_move.x, ball_move.y, ball_move.r(),
-                                  far_krate );
-                    }
-#endif
-                }
 #ifdef DEBUG_CREATE
-                else
-                {
                     dlog.addText( Logger::HOLD,
-                                  "__cancel far point (%.2f %.2f) angle=%.0f dist=%.2f"
+                                  "__cancel %s point (%.2f %.2f) angle=%.0f dist=%.2f"
                                   " big noise"
                                   " my=%.3f ball=%.3f kick=%.3f. total=%f > kickable_buf=%f",
-                                  far_pos.x, far_pos.y,
-                                  d, far_dist,
+                                  ring_name[r], pos.x, pos.y,
+                                  tmpl.angle_[a].degree(), dist,
                                   my_noise, ball_noise, max_kick_rand,
                                   ( my_noise + ball_noise + max_kick_rand ) * 0.95,
-                                  wm.self().kickableArea() - far_dist - 0.1 );
-                }
+                                  kickable_area - dist - 0.1 );
 #endif
+                    continue;
+                }
             }
-#ifdef DEBUG_CREATE
-            else
+
+            const double krate = ptype.kickRate( dist, dir_diff );
+            // can stop the ball by 1 step kick
+            if ( move_dist * ball_decay >= max_power * krate )
             {
+#ifdef DEBUG_CREATE
                 dlog.addText( Logger::HOLD,
-                              "__cancel far point (%.2f %.2f) angle=%.0f dist=%.2f"
-                              " cannot kick"
-                              " required_accel=(%.3f %.3f)%.3f cur_krate=%f",
-                              far_pos.x, far_pos.y,
-                              d, far_dist,
-                              kick_accel.x, kick_accel.y,
-                              kick_accel.r(),
-                              wm.self().kickRate() );
+                              "__cancel %s point (%.2f %.2f) angle=%.0f dist=%.2f"
+                              " cannot stop ball"
+                              " ball_move=(%.3f %.3f)%.3f krate=%f",
+                              ring_name[r], pos.x, pos.y,
+                              tmpl.angle_[a].degree(), dist,
+                              ball_move.x, ball_move.y, move_dist,
+                              krate );
+#endif
+                continue;
             }
+
+#ifdef DEBUG_CREATE
+            dlog.addText( Logger::HOLD,
+                          "__add %s point (%.2f %.2f) angle=%.0f dist=%.2f",
+                          ring_name[r], pos.x, pos.y,
+                          tmpl.angle_[a].degree(), dist );
 #endif
-        }
+            candidates.emplace_back( pos, krate, DEFAULT_SCORE );
         }
     }
 
@@ -487,19 +684,23 @@ void
 Body_HoldBall2008::evaluateKeepPoints( const WorldModel & wm,
                                        std::vector< KeepPoint > & keep_points )
 {
-#ifdef DEBUG_EVAL
-    int count = 0;
-    dlog.addText( Logger::HOLD,
-                  __FILE__"(evaluate) =========" );
-#endif
-    for ( KeepPoint & p : keep_points )
+    OpponentSet opponents;
+    opponents.create( wm );
+
+    std::vector< Vector2D > points;
+    std::vector< double > scores;
+    points.reserve( keep_points.size() );
+    for ( const KeepPoint & p : keep_points )
     {
-#ifdef DEBUG_EVAL
-        dlog.addText( Logger::HOLD,
-                      "%d: (evaluate) (%.2f %.2f)",
-                      ++count, p.pos_.x, p.pos_.y );
-#endif
-        p.score_ = evaluateKeepPoint( wm, p.pos_ );
+        points.push_back( p.pos_ );
+    }
+
+    evaluate_keep_points( wm, opponents, points, &scores );
+
+    for ( std::size_t i = 0; i < keep_points.size(); ++i )
+    {
+        KeepPoint & p = keep_points[i];
+        p.score_ = scores[i];
         // if ( p.score_ < DEFAULT_SCORE - 1.0e-5 )
         // {
         //     p.score_ += p.pos_.dist( wm.ball().pos() ) * 0.001;
@@ -520,7 +721,7 @@ Body_HoldBall2008::evaluateKeepPoints( const WorldModel & wm,
 
     dlog.addText( Logger::HOLD,
                   __FILE__"(results) =========" );
-    count = 0;
+    int count = 0;
     for ( const KeepPoint & p : keep_points )
     {
         ++count;
@@ -547,219 +748,15 @@ double
 Body_HoldBall2008::evaluateKeepPoint( const WorldModel & wm,
                                       const Vector2D & keep_point )
 {
-    static const Rect2D penalty_area( Vector2D( ServerParam::i().theirPenaltyAreaLineX(),
-                                                - ServerParam::i().penaltyAreaHalfWidth() ),
-                                      Size2D( ServerParam::i().penaltyAreaLength(),
-                                              ServerParam::i().penaltyAreaWidth() ) );
-    static const double consider_dist = ( ServerParam::i().tackleDist()
-                                          + ServerParam::i().defaultPlayerSpeedMax()
-                                          + 1.0 );
-    const ServerParam & SP = ServerParam::i();
-
-    const Vector2D my_next = wm.self().pos() + wm.self().vel();
+    OpponentSet opponents;
+    opponents.create( wm );
 
-    double score = DEFAULT_SCORE;
+    std::vector< Vector2D > points( 1, keep_point );
+    std::vector< double > scores;
 
-    for ( const PlayerObject * o : wm.opponentsFromBall() )
-    {
-        if ( o->distFromBall() > consider_dist ) break;
-
-        if ( o->posCount() > 10 ) continue;
-        if ( o->isGhost() ) continue;
-        if ( o->isTackling() ) continue;
-
-        const PlayerType * player_type = o->playerTypePtr();
-        const Vector2D opp_next = o->pos() + o->vel();
-        const double control_area = ( ( o->goalie()
-                                        && penalty_area.contains( opp_next )
-                                        && penalty_area.contains( keep_point ) )
-                                      ? SP.catchableArea()
-                                      : player_type->kickableArea() );
-        const double opp_dist = opp_next.dist( keep_point );
-
-        if ( opp_dist < control_area * 0.5 )
-        {
-            score -= 200.0;
-#ifdef DEBUG_EVAL
-            dlog.addText( Logger::HOLD,
-                          "____ opp %d(%.1f %.1f) can control(1). score=%.3f",
-                          o->unum(),
-                          o->pos().x, o->pos().y, score );
-
-#endif
-        }
-        else if ( opp_dist < control_area + 0.1 )
-        {
-            score -= 150.0;
-#ifdef DEBUG_EVAL
-            dlog.addText( Logger::HOLD,
-                          "____ opp %d(%.1f %.1f) can control(2). score=%.3f",
-                          o->unum(),
-                          o->pos().x, o->pos().y, score );
-
-#endif
-        }
-        else if ( opp_dist < SP.tackleDist() - 0.2 )
-        {
-            score -= 25.0;
-#ifdef DEBUG_EVAL
-            dlog.addText( Logger::HOLD,
-                          "____ opp %d(%.1f %.1f) within tackle. score=%.3f",
-                          o->unum(),
-                          o->pos().x, o->pos().y, score );
-
-#endif
-        }
-
-        AngleDeg opp_body;
-        if ( o->bodyCount() == 0 )
-        {
-            opp_body = o->body();
-        }
-        else if ( o->velCount() <= 1
-                  && o->vel().r() > 0.2 )
-        {
-            opp_body = o->vel().th();
-        }
-        else
-        {
-            opp_body = ( my_next - opp_next ).th();
-        }
-
-        //
-        // check opponent body line
-        //
-
-        const Vector2D player_2_pos = ( keep_point - opp_next ).rotatedVector( -opp_body );
-
-        if ( player_2_pos.absY() < control_area )
-        {
-            // if ( player_2_pos.absY() < control_area * 0.8 )
-            // {
-            //     score -= 20.0;
-            // }
-            // else
-            // {
-            //     score -= 10.0;
-            // }
-
-            score -= ( control_area - player_2_pos.absY() ) * 50.0;
-
-#ifdef DEBUG_EVAL
-            dlog.addText( Logger::HOLD,
-                          "____ opp %d(%.1f %.1f) on body line. body=%.1f y=%.3f score=%.3f",
-                          o->unum(),
-                          o->pos().x, o->pos().y, opp_body.degree(),
-                          player_2_pos.absY(),
-                          score );
-
-#endif
-        }
-
-        //
-        // check tackle probability
-        //
-        {
-            double tackle_dist = ( player_2_pos.x > 0.0
-                                   ? SP.tackleDist()
-                                   : SP.tackleBackDist() );
-            if ( tackle_dist > 1.0e-5 )
-            {
-                double tackle_fail_prob = ( std::pow( player_2_pos.absX() / tackle_dist,
-                                                      SP.foulExponent() )
-                                            + std::pow( player_2_pos.absY() / SP.tackleWidth(),
-                                                        SP.foulExponent() ) );
-                if ( tackle_fail_prob < 1.0 )
-                    //&& 1.0 - tackle_fail_prob > 0.7 ) // success probability
-                {
-                    //score -= 30.0;
-                    score -= ( 1.0 - tackle_fail_prob ) * 50.0;
-#ifdef DEBUG_EVAL
-                    dlog.addText( Logger::HOLD,
-                                  "____ tackle_prob=%.3f %d(%.1f %.1f) body=%.1f score=%.3f",
-                                  1.0 - tackle_fail_prob,
-                                  o->unum(),
-                                  o->pos().x, o->pos().y,
-                                  opp_body.degree(), score );
-#endif
-                }
-            }
-        }
-
-        //
-        // check kick or tackle possibility after dash
-        //
-        const double dash_angle_step = std::max( 15.0, SP.dashAngleStep() );
-        const int dash_angle_divs
-            = static_cast< int >( std::floor( ( SP.maxDashAngle() - SP.minDashAngle() )
-                                              / dash_angle_step ) );
-
-        double next_kick_penalty = 0.0;
-        double next_tackle_penalty = 0.0;
-        for ( int d = 0; d < dash_angle_divs; ++d )
-        {
-            const double dir = AngleDeg::normalize_angle( SP.minDashAngle() + ( dash_angle_step * d ) );
-            const AngleDeg dash_angle = SP.discretizeDashAngle( dir );
-            const double max_accel = ( SP.maxDashPower()
-                                       * player_type->dashPowerRate()
-                                       * player_type->effortMax()
-                                       * SP.dashDirRate( dir ) );
-            const Vector2D max_move = Vector2D::from_polar( max_accel, dash_angle );
-
-            const Vector2D next_player_2_pos = player_2_pos - max_move;
-
-            if ( next_player_2_pos.r2() < std::pow( control_area + 0.1, 2 ) )
-            {
-#ifdef DEBUG_EVAL
-                dlog.addText( Logger::HOLD,
-                              "____ next kickable %d opponent_body=%.1f dash_dir=%.0f max_accel=%.3f",
-                              o->unum(), opp_body.degree(), dir, max_accel );
-#endif
-                //next_kick_penalty = -20.0;
-                next_kick_penalty -= 20.0;
-            }
-            else if ( next_player_2_pos.absY() < SP.tackleWidth() + 0.1
-                      && next_player_2_pos.x > 0.0
-                      && next_player_2_pos.x < SP.tackleDist() + 0.1 )
-            {
-#ifdef DEBUG_EVAL
-                dlog.addText( Logger::HOLD,
-                              "____ next tackle %d opponent_body=%.1f dash_dir=%.0f max_accel=%.3f",
-                              o->unum(), opp_body.degree(), dir, max_accel );
-#endif
-                //next_tackle_penalty = -10.0;
-                next_tackle_penalty -= 10.0;
-            }
-        }
-
-        score += next_kick_penalty;
-        score += next_tackle_penalty;
-#ifdef DEBUG_EVAL
-        dlog.addText( Logger::HOLD,
-                      "____ %d kick_penalty=%.1f tackle_penalty=%.1f score=%.3f",
-                      o->unum(), next_kick_penalty, next_tackle_penalty, score );
-#endif
-
-    }
-
-#if 1
-    double ball_move_dist = ( keep_point - wm.ball().pos() ).r();
-    if ( ball_move_dist > wm.self().playerType().kickableArea() * 1.6 )
-    {
-        double next_ball_dist = my_next.dist( keep_point );
-        double threshold = wm.self().playerType().kickableArea() - 0.4;
-        double rate = 1.0 - 0.5 * std::max( 0.0, ( next_ball_dist - threshold ) / 0.4 );
-        score *= rate;
-
-#ifdef DEBUG_EVAL
-        dlog.addText( Logger::HOLD,
-                      "__ applied keep distance threshold. ball_dist=%.3f thr=%.3f rate=%f",
-                      next_ball_dist, threshold, rate );
-#endif
-    }
-#endif
+    evaluate_keep_points( wm, opponents, points, &scores );
 
-    return score;
+    return scores.front();
 }
 
 /*-------------------------------------------------------------------*/
@@ -43,9 +43,13 @@
 #include <rcsc/player/debug_client.h>
 #include <rcsc/common/logger.h>
 #include <rcsc/common/server_param.h>
+#include <rcsc/util/cycle_arena.h>
 #include <rcsc/soccer_math.h>
 #include <rcsc/math_util.h>
 
+#include <algorithm>
+#include <cmath>
+
 // #define DEBUG_PRINT
 // #define DEBUG_PRINT_INTERCEPT_LIST
 
@@ -71,10 +75,10 @@ Body_Intercept2009::execute( PlayerAgent * agent )
         return true;;
     }
 
-    const InterceptTable * table = wm.interceptTable();
+    const InterceptTable & table = wm.interceptTable();
 
     /////////////////////////////////////////////
-    if ( table->selfReachCycle() > 100 )
+    if ( table.selfStep() > 100 )
     {
         Vector2D final_point = wm.ball().inertiaFinalPoint();
         agent->debugClient().setTarget( final_point );
@@ -91,21 +95,21 @@ Body_Intercept2009::execute( PlayerAgent * agent )
     }
 
     /////////////////////////////////////////////
-    InterceptInfo best_intercept = getBestIntercept( wm, table );
-    //InterceptInfo best_intercept_test = getBestIntercept( wm, table );
+    Intercept best_intercept = getBestIntercept( wm, table );
+    //Intercept best_intercept_test = getBestIntercept( wm, table );
 
     dlog.addText( Logger::INTERCEPT,
                   __FILE__": solution size= %d. selected best cycle is %d"
                   " (turn:%d + dash:%d) power=%.1f dir=%.1f",
-                  table->selfCache().size(),
-                  best_intercept.reachCycle(),
-                  best_intercept.turnCycle(), best_intercept.dashCycle(),
+                  table.selfResults().size(),
+                  best_intercept.reachStep(),
+                  best_intercept.turnStep(), best_intercept.dashStep(),
                   best_intercept.dashPower(), best_intercept.dashDir() );
 
-    Vector2D target_point = wm.ball().inertiaPoint( best_intercept.reachCycle() );
+    Vector2D target_point = wm.ballTrajectory().pos( best_intercept.reachStep() );
     agent->debugClient().setTarget( target_point );
 
-    if ( best_intercept.dashCycle() == 0 )
+    if ( best_intercept.dashStep() == 0 )
     {
         dlog.addText( Logger::INTERCEPT,
                       __FILE__": can get the ball only by inertia move. Turn!" );
@@ -118,14 +122,14 @@ Body_Intercept2009::execute( PlayerAgent * agent )
 
         agent->debugClient().addMessage( "InterceptTurnOnly" );
         Body_TurnToPoint( face_point,
-                          best_intercept.reachCycle() ).execute( agent );
+                          best_intercept.reachStep() ).execute( agent );
         return true;
     }
 
     /////////////////////////////////////////////
-    if ( best_intercept.turnCycle() > 0 )
+    if ( best_intercept.turnStep() > 0 )
     {
-        Vector2D my_inertia = wm.self().inertiaPoint( best_intercept.reachCycle() );
+        Vector2D my_inertia = wm.self().inertiaPoint( best_intercept.reachStep() );
         AngleDeg target_angle = ( target_point - my_inertia ).th();
         if ( best_intercept.dashPower() < 0.0 )
         {
@@ -138,9 +142,9 @@ Body_Intercept2009::execute( PlayerAgent * agent )
                       ( best_intercept.dashPower() < 0.0 ? "BackMode" : "" ),
                       target_angle.degree() );
         agent->debugClient().addMessage( "InterceptTurn%d(%d/%d)",
-                                         best_intercept.reachCycle(),
-                                         best_intercept.turnCycle(),
-                                         best_intercept.dashCycle() );
+                                         best_intercept.reachStep(),
+                                         best_intercept.turnStep(),
+                                         best_intercept.dashStep() );
 
         return agent->doTurn( target_angle - wm.self().body() );
     }
@@ -217,20 +221,116 @@ Body_Intercept2009::doKickableOpponentCheck( PlayerAgent * agent )
     return false;
 }
 
+namespace {
+
+/*!
+  \struct InterceptCandidate
+  \brief flattened attributes of a self intercept candidate.
+  All values are computed once before the scoring loop.
+*/
+struct InterceptCandidate {
+    const Intercept * info_; //!< original simulation result
+    int step_; //!< reach step
+    int turn_step_; //!< turn step
+    double ball_dist_; //!< ball distance at the reach point
+    Vector2D self_pos_; //!< self inertia position at the reach step
+    Vector2D ball_pos_; //!< ball position at the reach step
+    Vector2D ball_vel_; //!< ball velocity at the reach step
+    double ball_speed2_; //!< squared ball speed at the reach step
+    bool attacker_; //!< true if the ball can be received as an attacker
+    bool safe_; //!< true if the ball is reached enough before opponents
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create the candidate attributes from the self intercept results.
+  the candidates that waste the recovery or are out of the pitch are removed.
+*/
+void
+create_intercept_candidates( const WorldModel & wm,
+                             const std::vector< Intercept > & cache,
+                             const bool save_recovery,
+                             ScratchVector< InterceptCandidate > * candidates )
+{
+    const ServerParam & SP = ServerParam::i();
+
+    const double max_pitch_x = ( SP.keepawayMode()
+                                 ? SP.keepawayLength() * 0.5 - 1.0
+                                 : SP.pitchHalfLength() - 1.0 );
+    const double max_pitch_y = ( SP.keepawayMode()
+                                 ? SP.keepawayWidth() * 0.5 - 1.0
+                                 : SP.pitchHalfWidth() - 1.0 );
+    const double speed_max = wm.self().playerType().realSpeedMax() * 0.9;
+    const double speed_max2 = std::pow( speed_max, 2 );
+    const double offside_line_x = wm.offsideLineX();
+    const int opp_min = wm.interceptTable().opponentStep();
+    const BallTrajectoryCache & ball_trajectory = wm.ballTrajectory();
+
+    candidates->clear();
+    candidates->reserve( cache.size() );
+
+    for ( const Intercept & info : cache )
+    {
+        if ( save_recovery
+             && info.staminaType() != Intercept::NORMAL )
+        {
+            continue;
+        }
+
+        InterceptCandidate c;
+        c.info_ = &info;
+        c.step_ = info.reachStep();
+        c.turn_step_ = info.turnStep();
+        c.ball_dist_ = info.ballDist();
+        c.ball_pos_ = ball_trajectory.pos( c.step_ );
+        c.ball_vel_ = ball_trajectory.vel( c.step_ );
+
+#ifdef DEBUG_PRINT_INTERCEPT_LIST
+        dlog.addText( Logger::INTERCEPT,
+                      "intercept: cycle=%d t=%d d=%d pos=(%.2f %.2f) vel=(%.2f %.1f) trap_ball_dist=%f",
+                      c.step_, info.turnStep(), info.dashStep(),
+                      c.ball_pos_.x, c.ball_pos_.y,
+                      c.ball_vel_.x, c.ball_vel_.y,
+                      c.ball_dist_ );
+#endif
+
+        if ( c.ball_pos_.absX() > max_pitch_x
+             || c.ball_pos_.absY() > max_pitch_y )
+        {
+            continue;
+        }
+
+        c.self_pos_ = wm.self().inertiaPoint( c.step_ );
+        c.ball_speed2_ = c.ball_vel_.r2();
+        c.attacker_ = ( c.ball_vel_.x > 0.5
+                        && c.ball_speed2_ > speed_max2
+                        && info.dashPower() >= 0.0
+                        && c.ball_pos_.x < 47.0
+                        && ( c.ball_pos_.x > 35.0
+                             || c.ball_pos_.x > offside_line_x ) );
+        const double opp_rate = ( c.attacker_ ? 0.95 : 0.7 );
+        c.safe_ = ( c.step_ < opp_min * opp_rate );
+
+        candidates->push_back( c );
+    }
+}
+
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
 */
-InterceptInfo
+Intercept
 Body_Intercept2009::getBestIntercept( const WorldModel & wm,
-                                      const InterceptTable * table ) const
+                                      const InterceptTable & table ) const
 {
     const ServerParam & SP = ServerParam::i();
-    const std::vector< InterceptInfo > & cache = table->selfCache();
+    const std::vector< Intercept > & cache = table.selfResults();
 
     if ( cache.empty() )
     {
-        return InterceptInfo();
+        return Intercept();
     }
 
 #ifdef DEBUG_PRINT
@@ -238,169 +338,112 @@ Body_Intercept2009::getBestIntercept( const WorldModel & wm,
                   "===== getBestIntercept =====");
 #endif
 
+    ScratchVector< InterceptCandidate > candidates( wm.scratchResource() );
+    create_intercept_candidates( wm, cache, M_save_recovery, &candidates );
+
     const Vector2D goal_pos( 65.0, 0.0 );
     const Vector2D our_goal_pos( -SP.pitchHalfLength(), 0.0 );
-    const double max_pitch_x = ( SP.keepawayMode()
-                                 ? SP.keepawayLength() * 0.5 - 1.0
-                                 : SP.pitchHalfLength() - 1.0 );
-    const double max_pitch_y = ( SP.keepawayMode()
-                                 ? SP.keepawayWidth() * 0.5 - 1.0
-                                 : SP.pitchHalfWidth() - 1.0 );
     const double penalty_x = SP.ourPenaltyAreaLineX();
     const double penalty_y = SP.penaltyAreaHalfWidth();
     const double speed_max = wm.self().playerType().realSpeedMax() * 0.9;
-    const int opp_min = table->opponentReachCycle();
-    const int mate_min = table->teammateReachCycle();
-    //const PlayerObject * fastest_opponent = table->fastestOpponent();
+    const double kickable_area = wm.self().playerType().kickableArea();
+    const double forward_speed2_thr = std::pow( 0.6, 2 );
+    const int opp_min = table.opponentStep();
+#ifdef USE_GOALIE_MODE
+    const int mate_min = table.teammateStep();
+    const bool goalie_mode = ( wm.self().goalie()
+                               && wm.lastKickerSide() != wm.ourSide() );
+    const double goalie_trap_dist = SP.catchableArea() * 0.5;
+    const double goalie_aggressive_trap_dist = kickable_area * 0.5;
+#endif
 
-    const InterceptInfo * attacker_best = nullptr;
+    const InterceptCandidate * attacker_best = nullptr;
     double attacker_score = 0.0;
 
-    const InterceptInfo * forward_best = nullptr;
+    const InterceptCandidate * forward_best = nullptr;
     double forward_score = 0.0;
 
-    const InterceptInfo * noturn_best = nullptr;
+    const InterceptCandidate * noturn_best = nullptr;
     double noturn_score = 10000.0;
 
-    const InterceptInfo * nearest_best = nullptr;
+    const InterceptCandidate * nearest_best = nullptr;
     double nearest_score = 10000.0;
 
 #ifdef USE_GOALIE_MODE
-    const InterceptInfo * goalie_best = nullptr;
+    const InterceptCandidate * goalie_best = nullptr;
     double goalie_score = -10000.0;
 
-    const InterceptInfo * goalie_aggressive_best = nullptr;
+    const InterceptCandidate * goalie_aggressive_best = nullptr;
     double goalie_aggressive_score = -10000.0;
 #endif
 
-    const std::size_t MAX = cache.size();
-    for ( std::size_t i = 0; i < MAX; ++i )
+    for ( const InterceptCandidate & c : candidates )
     {
-        if ( M_save_recovery
-             && cache[i].staminaType() != InterceptInfo::NORMAL )
-        {
-            continue;
-        }
-
-        const int cycle = cache[i].reachCycle();
-        const Vector2D self_pos = wm.self().inertiaPoint( cycle );
-        const Vector2D ball_pos = wm.ball().inertiaPoint( cycle );
-        const Vector2D ball_vel = wm.ball().vel() * std::pow( SP.ballDecay(), cycle );
-
-#ifdef DEBUG_PRINT_INTERCEPT_LIST
-        dlog.addText( Logger::INTERCEPT,
-                      "intercept %d: cycle=%d t=%d d=%d pos=(%.2f %.2f) vel=(%.2f %.1f) trap_ball_dist=%f",
-                      i,  cycle, cache[i].turnCycle(), cache[i].dashCycle(),
-                      ball_pos.x, ball_pos.y,
-                      ball_vel.x, ball_vel.y,
-                      cache[i].ballDist() );
-#endif
-
-        if ( ball_pos.absX() > max_pitch_x
-             || ball_pos.absY() > max_pitch_y )
-        {
-            continue;
-        }
+        const int cycle = c.step_;
+        const Vector2D & ball_pos = c.ball_pos_;
 
 #ifdef USE_GOALIE_MODE
-        if ( wm.self().goalie()
-             && wm.lastKickerSide() != wm.ourSide()
+        if ( goalie_mode
              && ball_pos.x < penalty_x - 1.0
              && ball_pos.absY() < penalty_y - 1.0
              && cycle < opp_min - 1 )
         {
-            if ( ( cache[i].turnCycle() == 0
-                   && cache[i].ballDist() < SP.catchableArea() * 0.5 )
-                 || cache[i].ballDist() < 0.01 )
+            if ( ( c.turn_step_ == 0
+                   && c.ball_dist_ < goalie_trap_dist )
+                 || c.ball_dist_ < 0.01 )
             {
                 double d = ball_pos.dist2( our_goal_pos );
-                if ( d> goalie_score )
+                if ( d > goalie_score )
                 {
                     goalie_score = d;
-                    goalie_best = &cache[i];
+                    goalie_best = &c;
 #ifdef DEBUG_PRINT
                     dlog.addText( Logger::INTERCEPT,
-                                  "___ %d updated goalie_best score=%f  trap_ball_dist=%f",
-                                  i, goalie_score, cache[i].ballDist() );
+                                  "___ cycle=%d updated goalie_best score=%f  trap_ball_dist=%f",
+                                  cycle, goalie_score, c.ball_dist_ );
 #endif
                 }
             }
         }
 
-        if ( wm.self().goalie()
-             && wm.lastKickerSide() != wm.ourSide()
+        if ( goalie_mode
              && cycle < mate_min - 3
              && cycle < opp_min - 5
              && ( ball_pos.x > penalty_x - 1.0
                   || ball_pos.absY() > penalty_y - 1.0 ) )
         {
-            if ( ( cache[i].turnCycle() == 0
-                   && cache[i].ballDist() < wm.self().playerType().kickableArea() * 0.5 )
-                 || cache[i].ballDist() < 0.01 )
+            if ( ( c.turn_step_ == 0
+                   && c.ball_dist_ < goalie_aggressive_trap_dist )
+                 || c.ball_dist_ < 0.01 )
             {
                 if ( ball_pos.x > goalie_aggressive_score )
                 {
                     goalie_aggressive_score = ball_pos.x;
-                    goalie_aggressive_best = &cache[i];
+                    goalie_aggressive_best = &c;
 #ifdef DEBUG_PRINT
                     dlog.addText( Logger::INTERCEPT,
-                                  "___ %d updated goalie_aggressive_best score=%f  trap_ball_dist=%f",
-                                  i, goalie_aggressive_score, cache[i].ballDist() );
+                                  "___ cycle=%d updated goalie_aggressive_best score=%f  trap_ball_dist=%f",
+                                  cycle, goalie_aggressive_score, c.ball_dist_ );
 #endif
                 }
             }
         }
 #endif
 
-        bool attacker = false;
-        if ( ball_vel.x > 0.5
-             && ball_vel.r2() > std::pow( speed_max, 2 )
-             && cache[i].dashPower() >= 0.0
-             && ball_pos.x < 47.0
-             //&& std::fabs( ball_pos.y - wm.self().pos().y ) < 10.0
-             && ( ball_pos.x > 35.0
-                  || ball_pos.x > wm.offsideLineX() )
-             )
-        {
-#ifdef DEBUG_PRINT
-            dlog.addText( Logger::INTERCEPT,
-                          "___ %d attacker", i );
-#endif
-            attacker = true;
-        }
-
-        const double opp_rate = ( attacker ? 0.95 : 0.7 );
-#if 0
-        if ( attacker
-             && opp_min <= cycle - 5
-             && ball_vel.r2() > std::pow( 1.2, 2 ) )
-        {
-#ifdef DEBUG_PRINT
-            dlog.addText( Logger::INTERCEPT,
-                          "___ %d attacker ignores opponent cycle=%d: ball_vel=(%.1f %.1f)",
-                          i,
-                          opp_min,
-                          ball_vel.x, ball_vel.y );
-#endif
-        }
-        else
-#endif
-            if ( cycle >= opp_min * opp_rate )
+        if ( ! c.safe_ )
         {
 #ifdef DEBUG_PRINT
             dlog.addText( Logger::INTERCEPT,
-                          "___ %d failed: cycle=%d pos=(%.1f %.1f) turn=%d dash=%d  opp_min=%d rated=%.2f",
-                          i, cycle,
-                          ball_pos.x, ball_pos.y,
-                          cache[i].turnCycle(), cache[i].dashCycle(),
-                          opp_min, opp_min * opp_rate );
+                          "___ failed: cycle=%d pos=(%.1f %.1f) turn=%d  opp_min=%d attacker=%d",
+                          cycle, ball_pos.x, ball_pos.y, c.turn_step_,
+                          opp_min, (int)c.attacker_ );
 #endif
             continue;
         }
 
         // attacker type
 
-        if ( attacker )
+        if ( c.attacker_ )
         {
             double goal_dist = 100.0 - std::min( 100.0, ball_pos.dist( goal_pos ) );
             double x_diff = 47.0 - ball_pos.x;
@@ -410,21 +453,13 @@ Body_Intercept2009::getBestIntercept( const WorldModel & wm,
                 * std::exp( - ( x_diff * x_diff ) / ( 2.0 * 100.0 ) );
 #ifdef DEBUG_PRINT
             dlog.addText( Logger::INTERCEPT,
-                          "___ %d attacker cycle=%d pos=(%.1f %.1f) turn=%d dash=%d score=%f",
-                          i, cycle,
-                          ball_pos.x, ball_pos.y,
-                          cache[i].turnCycle(), cache[i].dashCycle(),
-                          score );
+                          "___ attacker cycle=%d pos=(%.1f %.1f) turn=%d score=%f",
+                          cycle, ball_pos.x, ball_pos.y, c.turn_step_, score );
 #endif
             if ( score > attacker_score )
             {
-                attacker_best = &cache[i];
+                attacker_best = &c;
                 attacker_score = score;
-#ifdef DEBUG_PRINT
-                dlog.addText( Logger::INTERCEPT,
-                              "___ %d updated attacker_best score=%f",
-                              i, score );
-#endif
             }
 
             continue;
@@ -432,33 +467,18 @@ Body_Intercept2009::getBestIntercept( const WorldModel & wm,
 
         // no turn type
 
-        if ( cache[i].turnCycle() == 0 )
+        if ( c.turn_step_ == 0 )
         {
-            //double score = ball_pos.x;
-            //double score = wm.self().pos().dist2( ball_pos );
             double score = cycle;
-            //if ( ball_vel.x > 0.0 )
-            //{
-            //    score *= std::exp( - std::pow( ball_vel.r() - 1.0, 2.0 )
-            //                       / ( 2.0 * 1.0 ) );
-            //}
 #ifdef DEBUG_PRINT
             dlog.addText( Logger::INTERCEPT,
-                          "___ %d noturn cycle=%d pos=(%.1f %.1f) turn=%d dash=%d score=%f",
-                          i, cycle,
-                          ball_pos.x, ball_pos.y,
-                          cache[i].turnCycle(), cache[i].dashCycle(),
-                          score );
+                          "___ noturn cycle=%d pos=(%.1f %.1f) score=%f",
+                          cycle, ball_pos.x, ball_pos.y, score );
 #endif
             if ( score < noturn_score )
             {
-                noturn_best = &cache[i];
+                noturn_best = &c;
                 noturn_score = score;
-#ifdef DEBUG_PRINT
-                dlog.addText( Logger::INTERCEPT,
-                              "___ %d updated noturn_best score=%f",
-                              i, score );
-#endif
             }
 
             continue;
@@ -466,34 +486,22 @@ Body_Intercept2009::getBestIntercept( const WorldModel & wm,
 
         // forward type
 
-//         if ( ball_vel.x > 0.5
-//              && ball_pos.x > wm.offsideLineX() - 15.0
-//              && ball_vel.r() > speed_max * 0.98
-//              && cycle <= opp_min - 5 )
-        if ( ball_vel.x > 0.1
+        if ( c.ball_vel_.x > 0.1
              && cycle <= opp_min - 5
-             && ball_vel.r2() > std::pow( 0.6, 2 ) )
+             && c.ball_speed2_ > forward_speed2_thr )
         {
             double score
                 = ( 100.0 * 100.0 )
                 - std::min( 100.0 * 100.0, ball_pos.dist2( goal_pos ) );
 #ifdef DEBUG_PRINT
             dlog.addText( Logger::INTERCEPT,
-                          "___ %d forward cycle=%d pos=(%.1f %.1f) turn=%d dash=%d score=%f",
-                          i, cycle,
-                          ball_pos.x, ball_pos.y,
-                          cache[i].turnCycle(), cache[i].dashCycle(),
-                          score );
+                          "___ forward cycle=%d pos=(%.1f %.1f) turn=%d score=%f",
+                          cycle, ball_pos.x, ball_pos.y, c.turn_step_, score );
 #endif
             if ( score > forward_score )
             {
-                forward_best = &cache[i];
+                forward_best = &c;
                 forward_score = score;
-#ifdef DEBUG_PRINT
-                dlog.addText( Logger::INTERCEPT,
-                              "___ %d updated forward_best score=%f",
-                              i, score );
-#endif
             }
 
             continue;
@@ -502,28 +510,18 @@ Body_Intercept2009::getBestIntercept( const WorldModel & wm,
         // other: select nearest one
 
         {
-            //double d = wm.self().pos().dist2( ball_pos );
-            double d = self_pos.dist2( ball_pos );
+            double d = c.self_pos_.dist2( ball_pos );
 #ifdef DEBUG_PRINT
             dlog.addText( Logger::INTERCEPT,
-                          "___ %d other cycle=%d pos=(%.1f %.1f) turn=%d dash=%d dist2=%.2f",
-                          i, cycle,
-                          ball_pos.x, ball_pos.y,
-                          cache[i].turnCycle(), cache[i].dashCycle(),
-                          d );
+                          "___ other cycle=%d pos=(%.1f %.1f) turn=%d dist2=%.2f",
+                          cycle, ball_pos.x, ball_pos.y, c.turn_step_, d );
 #endif
             if ( d < nearest_score )
             {
-                nearest_best = &cache[i];
+                nearest_best = &c;
                 nearest_score = d;
-#ifdef DEBUG_PRINT
-                dlog.addText( Logger::INTERCEPT,
-                              "___ %d updated nearest_best score=%f",
-                              i, nearest_score );
-#endif
             }
         }
-
     }
 
 #ifdef USE_GOALIE_MODE
@@ -531,22 +529,22 @@ Body_Intercept2009::getBestIntercept( const WorldModel & wm,
     {
         dlog.addText( Logger::INTERCEPT,
                       "<--- goalie aggressive_best: cycle=%d(t=%d,d=%d) ball_dist=%.3f score=%f",
-                      goalie_aggressive_best->reachCycle(),
-                      goalie_aggressive_best->turnCycle(), goalie_aggressive_best->dashCycle(),
-                      goalie_aggressive_best->ballDist(),
+                      goalie_aggressive_best->step_,
+                      goalie_aggressive_best->turn_step_, goalie_aggressive_best->info_->dashStep(),
+                      goalie_aggressive_best->ball_dist_,
                       goalie_aggressive_score );
-        return *goalie_aggressive_best;
+        return *goalie_aggressive_best->info_;
     }
 
     if ( goalie_best )
     {
         dlog.addText( Logger::INTERCEPT,
                       "<--- goalie best: cycle=%d(t=%d,d=%d) ball_dist=%.3f score=%f",
-                      goalie_best->reachCycle(),
-                      goalie_best->turnCycle(), goalie_best->dashCycle(),
-                      goalie_best->ballDist(),
+                      goalie_best->step_,
+                      goalie_best->turn_step_, goalie_best->info_->dashStep(),
+                      goalie_best->ball_dist_,
                       goalie_score );
-        return *goalie_best;
+        return *goalie_best->info_;
     }
 #endif
 
@@ -554,44 +552,36 @@ Body_Intercept2009::getBestIntercept( const WorldModel & wm,
     {
         dlog.addText( Logger::INTERCEPT,
                       "<--- attacker best: cycle=%d(t=%d,d=%d) score=%f",
-                      attacker_best->reachCycle(),
-                      attacker_best->turnCycle(), attacker_best->dashCycle(),
+                      attacker_best->step_,
+                      attacker_best->turn_step_, attacker_best->info_->dashStep(),
                       attacker_score );
 
-        return *attacker_best;
+        return *attacker_best->info_;
     }
 
     if ( noturn_best && forward_best )
     {
-        //const Vector2D forward_ball_pos = wm.ball().inertiaPoint( forward_best->reachCycle() );
-        //const Vector2D forward_ball_vel
-        //    = wm.ball().vel()
-        //    * std::pow( SP.ballDecay(), forward_best->reachCycle() );
-
-        if ( forward_best->reachCycle() >= 5 )
+        if ( forward_best->step_ >= 5 )
         {
             dlog.addText( Logger::INTERCEPT,
                           "<--- forward best(1): cycle=%d(t=%d,d=%d) score=%f",
-                          forward_best->reachCycle(),
-                          forward_best->turnCycle(), forward_best->dashCycle(),
+                          forward_best->step_,
+                          forward_best->turn_step_, forward_best->info_->dashStep(),
                           forward_score );
         }
 
-        const Vector2D noturn_ball_vel
-            = wm.ball().vel()
-            * std::pow( SP.ballDecay(), noturn_best->reachCycle() );
-        const double noturn_ball_speed = noturn_ball_vel.r();
-        if ( noturn_ball_vel.x > 0.1
+        const double noturn_ball_speed = std::sqrt( noturn_best->ball_speed2_ );
+        if ( noturn_best->ball_vel_.x > 0.1
              && ( noturn_ball_speed > speed_max
-                  || noturn_best->reachCycle() <= forward_best->reachCycle() + 2 )
+                  || noturn_best->step_ <= forward_best->step_ + 2 )
              )
         {
             dlog.addText( Logger::INTERCEPT,
-                              "<--- noturn best(1): cycle=%d(t=%d,d=%d) score=%f",
-                          noturn_best->reachCycle(),
-                          noturn_best->turnCycle(), noturn_best->dashCycle(),
+                          "<--- noturn best(1): cycle=%d(t=%d,d=%d) score=%f",
+                          noturn_best->step_,
+                          noturn_best->turn_step_, noturn_best->info_->dashStep(),
                           noturn_score );
-            return *noturn_best;
+            return *noturn_best->info_;
         }
     }
 
@@ -599,143 +589,123 @@ Body_Intercept2009::getBestIntercept( const WorldModel & wm,
     {
         dlog.addText( Logger::INTERCEPT,
                       "<--- forward best(2): cycle=%d(t=%d,d=%d) score=%f",
-                      forward_best->reachCycle(),
-                      forward_best->turnCycle(), forward_best->dashCycle(),
+                      forward_best->step_,
+                      forward_best->turn_step_, forward_best->info_->dashStep(),
                       forward_score );
 
-        return *forward_best;
+        return *forward_best->info_;
     }
 
-    const Vector2D fastest_pos = wm.ball().inertiaPoint( cache[0].reachCycle() );
-    const Vector2D fastest_vel = wm.ball().vel() * std::pow( SP.ballDecay(),
-                                                             cache[0].reachCycle() );
+    const Vector2D fastest_pos = wm.ballTrajectory().pos( cache[0].reachStep() );
+    const Vector2D fastest_vel = wm.ballTrajectory().vel( cache[0].reachStep() );
     if ( ( fastest_pos.x > -33.0
            || fastest_pos.absY() > 20.0 )
-         && ( cache[0].reachCycle() >= 10
-             //|| wm.ball().vel().r() < 1.5 ) )
+         && ( cache[0].reachStep() >= 10
              || fastest_vel.r() < 1.2 ) )
     {
         dlog.addText( Logger::INTERCEPT,
                       "<--- fastest best: cycle=%d(t=%d,d=%d)",
-                      cache[0].reachCycle(),
-                      cache[0].turnCycle(), cache[0].dashCycle() );
+                      cache[0].reachStep(),
+                      cache[0].turnStep(), cache[0].dashStep() );
         return cache[0];
     }
 
     if ( noturn_best && nearest_best )
     {
-        const Vector2D noturn_self_pos = wm.self().inertiaPoint( noturn_best->reachCycle() );
-        const Vector2D noturn_ball_pos = wm.ball().inertiaPoint( noturn_best->reachCycle() );
-        const Vector2D nearest_self_pos = wm.self().inertiaPoint( nearest_best->reachCycle() );
-        const Vector2D nearest_ball_pos = wm.ball().inertiaPoint( nearest_best->reachCycle() );
-
-//         if ( wm.self().pos().dist2( noturn_ball_pos )
-//              < wm.self().pos().dist2( nearest_ball_pos ) )
-        if ( noturn_self_pos.dist2( noturn_ball_pos )
-             < nearest_self_pos.dist2( nearest_ball_pos ) )
+        if ( noturn_best->self_pos_.dist2( noturn_best->ball_pos_ )
+             < nearest_best->self_pos_.dist2( nearest_best->ball_pos_ ) )
         {
             dlog.addText( Logger::INTERCEPT,
                           "<--- noturn best(2): cycle=%d(t=%d,d=%d) score=%f",
-                          noturn_best->reachCycle(),
-                          noturn_best->turnCycle(), noturn_best->dashCycle(),
+                          noturn_best->step_,
+                          noturn_best->turn_step_, noturn_best->info_->dashStep(),
                           noturn_score );
 
-            return *noturn_best;
+            return *noturn_best->info_;
         }
 
-        if ( nearest_best->reachCycle() <= noturn_best->reachCycle() + 2 )
+        if ( nearest_best->step_ <= noturn_best->step_ + 2 )
         {
-            const Vector2D nearest_ball_vel
-                = wm.ball().vel()
-                * std::pow( SP.ballDecay(), nearest_best->reachCycle() );
-            const double nearest_ball_speed = nearest_ball_vel.r();
+            const double nearest_ball_speed = std::sqrt( nearest_best->ball_speed2_ );
             if ( nearest_ball_speed < 0.7 )
             {
                 dlog.addText( Logger::INTERCEPT,
                               "<--- nearest best(2): cycle=%d(t=%d,d=%d) score=%f",
-                              nearest_best->reachCycle(),
-                              nearest_best->turnCycle(), nearest_best->dashCycle(),
+                              nearest_best->step_,
+                              nearest_best->turn_step_, nearest_best->info_->dashStep(),
                               nearest_score );
-                return *nearest_best;
+                return *nearest_best->info_;
             }
 
-            const Vector2D noturn_ball_vel
-                = wm.ball().vel()
-                * std::pow( SP.ballDecay(), noturn_best->reachCycle() );
-
-            if ( nearest_best->ballDist() < wm.self().playerType().kickableArea() - 0.4
-                 && nearest_best->ballDist() < noturn_best->ballDist()
-                 && noturn_ball_vel.x < 0.5
-                 && noturn_ball_vel.r2() > std::pow( 1.0, 2 )
-                 && noturn_ball_pos.x > nearest_ball_pos.x )
+            if ( nearest_best->ball_dist_ < kickable_area - 0.4
+                 && nearest_best->ball_dist_ < noturn_best->ball_dist_
+                 && noturn_best->ball_vel_.x < 0.5
+                 && noturn_best->ball_speed2_ > std::pow( 1.0, 2 )
+                 && noturn_best->ball_pos_.x > nearest_best->ball_pos_.x )
             {
                 dlog.addText( Logger::INTERCEPT,
                               "<--- nearest best(3): cycle=%d(t=%d,d=%d) score=%f",
-                              nearest_best->reachCycle(),
-                              nearest_best->turnCycle(), nearest_best->dashCycle(),
+                              nearest_best->step_,
+                              nearest_best->turn_step_, nearest_best->info_->dashStep(),
                               nearest_score );
-                return *nearest_best;
+                return *nearest_best->info_;
             }
 
-            Vector2D nearest_self_pos = wm.self().inertiaPoint( nearest_best->reachCycle() );
             if ( nearest_ball_speed > 0.7
-                //&& wm.self().pos().dist( nearest_ball_pos ) < wm.self().playerType().kickableArea() )
-                 && nearest_self_pos.dist( nearest_ball_pos ) < wm.self().playerType().kickableArea() )
+                 && nearest_best->self_pos_.dist( nearest_best->ball_pos_ ) < kickable_area )
             {
                 dlog.addText( Logger::INTERCEPT,
                               "<--- nearest best(4): cycle=%d(t=%d,d=%d) score=%f",
-                              nearest_best->reachCycle(),
-                              nearest_best->turnCycle(), nearest_best->dashCycle(),
+                              nearest_best->step_,
+                              nearest_best->turn_step_, nearest_best->info_->dashStep(),
                               nearest_score );
-                return *nearest_best;
+                return *nearest_best->info_;
             }
         }
 
         dlog.addText( Logger::INTERCEPT,
-                          "<--- noturn best(3): cycle=%d(t=%d,d=%d) score=%f",
-                      noturn_best->reachCycle(),
-                      noturn_best->turnCycle(), noturn_best->dashCycle(),
+                      "<--- noturn best(3): cycle=%d(t=%d,d=%d) score=%f",
+                      noturn_best->step_,
+                      noturn_best->turn_step_, noturn_best->info_->dashStep(),
                       noturn_score );
 
-        return *noturn_best;
+        return *noturn_best->info_;
     }
 
     if ( noturn_best )
     {
         dlog.addText( Logger::INTERCEPT,
                       "<--- noturn best only: cycle=%d(t=%d,d=%d) score=%f",
-                      noturn_best->reachCycle(),
-                      noturn_best->turnCycle(), noturn_best->dashCycle(),
+                      noturn_best->step_,
+                      noturn_best->turn_step_, noturn_best->info_->dashStep(),
                       noturn_score );
 
-        return *noturn_best;
+        return *noturn_best->info_;
     }
 
     if ( nearest_best )
     {
         dlog.addText( Logger::INTERCEPT,
                       "<--- nearest best only: cycle=%d(t=%d,d=%d) score=%f",
-                      nearest_best->reachCycle(),
-                      nearest_best->turnCycle(), nearest_best->dashCycle(),
+                      nearest_best->step_,
+                      nearest_best->turn_step_, nearest_best->info_->dashStep(),
                       nearest_score );
 
-        return *nearest_best;
+        return *nearest_best->info_;
     }
 
-
-
     if ( wm.self().pos().x > 40.0
          && wm.ball().vel().r() > 1.8
          && wm.ball().vel().th().abs() < 100.0
-         && cache[0].reachCycle() > 1 )
+         && cache[0].reachStep() > 1 )
     {
-        const InterceptInfo * chance_best = nullptr;
-        for ( std::size_t i = 0; i < MAX; ++i )
+        const Intercept * chance_best = nullptr;
+        for ( const Intercept & info : cache )
         {
-            if ( cache[i].reachCycle() <= cache[0].reachCycle() + 3
-                 && cache[i].reachCycle() <= opp_min - 2 )
+            if ( info.reachStep() <= cache[0].reachStep() + 3
+                 && info.reachStep() <= opp_min - 2 )
             {
-                chance_best = &cache[i];
+                chance_best = &info;
             }
         }
 
@@ -743,51 +713,50 @@ Body_Intercept2009::getBestIntercept( const WorldModel & wm,
         {
             dlog.addText( Logger::INTERCEPT,
                           "<--- chance best only: cycle=%d(t=%d,d=%d)",
-                          chance_best->reachCycle(),
-                          chance_best->turnCycle(), chance_best->dashCycle() );
+                          chance_best->reachStep(),
+                          chance_best->turnStep(), chance_best->dashStep() );
             return *chance_best;
         }
     }
 
     return cache[0];
-
 }
 
 /*-------------------------------------------------------------------*/
 /*!
 
 */
-InterceptInfo
+Intercept
 Body_Intercept2009::getBestIntercept_Test( const WorldModel & /*wm*/,
-                                           const InterceptTable * /*table*/ ) const
+                                           const InterceptTable & /*table*/ ) const
 {
 #if 0
-    const std::vector< InterceptInfo > & cache = table->selfCache();
+    const std::vector< Intercept > & cache = table.selfResults();
 
     if ( cache.empty() )
     {
-        return InterceptInfo();
+        return Intercept();
     }
 
     const ServerParam & SP = ServerParam::i();
-    const int our_min = table->teammateReachCycle();
-    const int opp_min = table->opponentReachCycle();
-    const PlayerObject * opponent = table->fastestOpponent();
+    const int our_min = table.teammateStep();
+    const int opp_min = table.opponentStep();
+    const PlayerObject * opponent = table.fastestOpponent();
 
     const std::size_t MAX = cache.size();
 
     for ( std::size_t i = 0; i < MAX; ++i )
     {
-        const InterceptInfo & info = cache[i];
+        const Intercept & info = cache[i];
 
         if ( M_save_recovery
-             && info.mode() != InterceptInfo::NORMAL )
+             && info.mode() != Intercept::NORMAL )
         {
             continue;
         }
 
-        const int reach_cycle = info.reachCycle();
-        const Vector2D ball_pos = wm.ball().inertiaPoint( reach_cycle );
+        const int reach_cycle = info.reachStep();
+        const Vector2D ball_pos = wm.ballTrajectory().pos( reach_cycle );
         const Vector2D ball_vel = wm.ball().vel() * std::pow( SP.ballDecay(), reach_cycle );
 
 
@@ -799,15 +768,15 @@ Body_Intercept2009::getBestIntercept_Test( const WorldModel & /*wm*/,
     dlog.addText( Logger::INTERCEPT,
                   "____ test best cycle=%d"
                   " (turn:%d + dash:%d) power=%.1f dir=%.1f pos=(%.1f %.1f) stamina=%.1f %.1f",
-                  table->selfCache().size(),
-                  best_intercept_test.reachCycle(),
-                  best_intercept_test.turnCycle(), best_intercept_test.dashCycle(),
+                  table.selfResults().size(),
+                  best_intercept_test.reachStep(),
+                  best_intercept_test.turnStep(), best_intercept_test.dashStep(),
                   best_intercept_test.dashPower(), best_intercept_test.dashAngle().degree(),
                   best_intercept_test.selfPos().x, best_intercept_test.selfPos().y,
                   best_intercept_test.stamina() );
 #endif
 #endif
-    return InterceptInfo();
+    return Intercept();
 }
 
 /*-------------------------------------------------------------------*/
@@ -817,7 +786,7 @@ Body_Intercept2009::getBestIntercept_Test( const WorldModel & /*wm*/,
 bool
 Body_Intercept2009::doWaitTurn( PlayerAgent * agent,
                                 const Vector2D & target_point,
-                                const InterceptInfo & info )
+                                const Intercept & info )
 {
     const WorldModel & wm = agent->world();
 
@@ -830,8 +799,8 @@ Body_Intercept2009::doWaitTurn( PlayerAgent * agent,
             return false;
         }
 
-        int opp_min = wm.interceptTable()->opponentReachCycle();
-        if ( info.reachCycle() > opp_min - 5 )
+        int opp_min = wm.interceptTable().opponentStep();
+        if ( info.reachStep() > opp_min - 5 )
         {
             dlog.addText( Logger::INTERCEPT,
                           __FILE__": doWaitTurn. exist opponent intercepter, cancel." );
@@ -839,18 +808,18 @@ Body_Intercept2009::doWaitTurn( PlayerAgent * agent,
         }
     }
 
-    const Vector2D my_inertia = wm.self().inertiaPoint( info.reachCycle() );
+    const Vector2D my_inertia = wm.self().inertiaPoint( info.reachStep() );
     const Vector2D target_rel = ( target_point - my_inertia ).rotatedVector( - wm.self().body() );
     const double target_dist = target_rel.r();
 
     const double ball_travel
         = inertia_n_step_distance( wm.ball().vel().r(),
-                                   info.reachCycle(),
+                                   info.reachStep(),
                                    ServerParam::i().ballDecay() );
     const double ball_noise = ball_travel * ServerParam::i().ballRand();
 
-    if ( info.reachCycle() == 1
-         && info.turnCycle() == 1 )
+    if ( info.reachStep() == 1
+         && info.turnStep() == 1 )
     {
         Vector2D face_point = M_face_point;
         if ( ! face_point.isValid() )
@@ -865,7 +834,7 @@ Body_Intercept2009::doWaitTurn( PlayerAgent * agent,
         return true;
     }
 
-    double extra_buf = 0.1 * bound( 0, info.reachCycle() - 1, 4 );
+    double extra_buf = 0.1 * bound( 0, info.reachStep() - 1, 4 );
     {
         double angle_diff = ( wm.ball().vel().th() - wm.self().body() ).abs();
         if ( angle_diff < 10.0
@@ -889,7 +858,7 @@ Body_Intercept2009::doWaitTurn( PlayerAgent * agent,
     }
 
     Vector2D face_point = M_face_point;
-    if ( info.reachCycle() > 2 )
+    if ( info.reachStep() > 2 )
     {
         face_point = my_inertia
             + ( wm.ball().pos() - my_inertia ).rotatedVector( 90.0 );
@@ -919,7 +888,7 @@ Body_Intercept2009::doWaitTurn( PlayerAgent * agent,
     }
 
     Body_TurnToPoint( face_point ).execute( agent );
-    agent->debugClient().addMessage( "WaitTurn%d", info.reachCycle() );
+    agent->debugClient().addMessage( "WaitTurn%d", info.reachStep() );
 
     return true;
 }
@@ -931,23 +900,23 @@ Body_Intercept2009::doWaitTurn( PlayerAgent * agent,
 bool
 Body_Intercept2009::doInertiaDash( PlayerAgent * agent,
                                    const Vector2D & target_point,
-                                   const InterceptInfo & info )
+                                   const Intercept & info )
 {
     const WorldModel & wm = agent->world();
     const PlayerType & ptype = wm.self().playerType();
 
-    if ( info.reachCycle() == 1 )
+    if ( info.reachStep() == 1 )
     {
         agent->debugClient().addMessage( "Intercept1Dash%.0f|%.0f",
                                          info.dashPower(), info.dashDir() );
         agent->doDash( info.dashPower(), info.dashDir() );
 #ifdef DEBUG_PRINT
-        if ( info.dashAngle().abs() > 1.0 )
+        if ( std::fabs( info.dashDir() ) > 1.0 )
         {
             std::cerr << wm.time()
                       << ' ' << wm.self().unum()
                       << " intercept omnidash "
-                      << info.dashAngle()
+                      << info.dashDir()
                       << std::endl;
         }
 #endif
@@ -961,14 +930,14 @@ Body_Intercept2009::doInertiaDash( PlayerAgent * agent,
     if ( info.dashPower() < 0.0 ) accel_angle += 180.0;
 
     Vector2D ball_vel = wm.ball().vel() * std::pow( ServerParam::i().ballDecay(),
-                                                    info.reachCycle() );
+                                                    info.reachStep() );
 
     if ( ( ! wm.self().goalie()
            || wm.lastKickerSide() == wm.ourSide() )
          && wm.self().body().abs() < 50.0 )
     {
         double buf = 0.3;
-        if ( info.reachCycle() >= 8 )
+        if ( info.reachStep() >= 8 )
         {
             buf = 0.0;
         }
@@ -978,16 +947,16 @@ Body_Intercept2009::doInertiaDash( PlayerAgent * agent,
         }
         else if ( target_rel.x < 0.0 )
         {
-            if ( info.reachCycle() >= 3 ) buf = 0.5;
+            if ( info.reachStep() >= 3 ) buf = 0.5;
         }
         else if ( target_rel.x < 0.3 )
         {
-            if ( info.reachCycle() >= 3 ) buf = 0.5;
+            if ( info.reachStep() >= 3 ) buf = 0.5;
         }
         else if ( target_rel.absY() < 0.5 )
         {
-            if ( info.reachCycle() >= 3 ) buf = 0.5;
-            if ( info.reachCycle() == 2 ) buf = std::min( target_rel.x, 0.5 );
+            if ( info.reachStep() >= 3 ) buf = 0.5;
+            if ( info.reachStep() == 2 ) buf = std::min( target_rel.x, 0.5 );
         }
         else if ( ball_vel.r() < 1.6 )
         {
@@ -995,9 +964,9 @@ Body_Intercept2009::doInertiaDash( PlayerAgent * agent,
         }
         else
         {
-            if ( info.reachCycle() >= 4 ) buf = 0.3;
-            else if ( info.reachCycle() == 3 ) buf = 0.3;
-            else if ( info.reachCycle() == 2 ) buf = std::min( target_rel.x, 0.3 );
+            if ( info.reachStep() >= 4 ) buf = 0.3;
+            else if ( info.reachStep() == 3 ) buf = 0.3;
+            else if ( info.reachStep() == 2 ) buf = std::min( target_rel.x, 0.3 );
         }
 
         target_rel.x -= buf;
@@ -1010,7 +979,7 @@ Body_Intercept2009::doInertiaDash( PlayerAgent * agent,
     double used_power = info.dashPower();
 
     if ( wm.ball().seenPosCount() <= 2
-         && wm.ball().vel().r() * std::pow( ServerParam::i().ballDecay(), info.reachCycle() ) < ptype.kickableArea() * 1.5
+         && wm.ball().vel().r() * std::pow( ServerParam::i().ballDecay(), info.reachStep() ) < ptype.kickableArea() * 1.5
          && std::fabs( info.dashDir() ) < 5.0
          && target_rel.absX() < ( ptype.kickableArea()
                                   + ptype.dashRate( wm.self().effort() )
@@ -1020,7 +989,7 @@ Body_Intercept2009::doInertiaDash( PlayerAgent * agent,
         double first_speed
             = calc_first_term_geom_series( target_rel.x,
                                            wm.self().playerType().playerDecay(),
-                                           info.reachCycle() );
+                                           info.reachStep() );
 
         first_speed = min_max( - wm.self().playerType().playerSpeedMax(),
                                first_speed,
@@ -1039,7 +1008,7 @@ Body_Intercept2009::doInertiaDash( PlayerAgent * agent,
         }
 
         agent->debugClient().addMessage( "InterceptInertiaDash%d:%.0f|%.0f",
-                                         info.reachCycle(), used_power, info.dashDir() );
+                                         info.reachStep(), used_power, info.dashDir() );
         dlog.addText( Logger::INTERCEPT,
                       __FILE__": doInertiaDash. x_diff=%.2f first_speed=%.2f"
                       " accel=%.2f power=%.1f",
@@ -1049,21 +1018,21 @@ Body_Intercept2009::doInertiaDash( PlayerAgent * agent,
     else
     {
         agent->debugClient().addMessage( "InterceptDash%d:%.0f|%.0f",
-                                         info.reachCycle(), used_power, info.dashDir() );
+                                         info.reachStep(), used_power, info.dashDir() );
         dlog.addText( Logger::INTERCEPT,
                       __FILE__": doInertiaDash. normal dash. x_diff=%.2f ",
                       target_rel.x );
     }
 
 
-    if ( info.reachCycle() >= 4
+    if ( info.reachStep() >= 4
          && ( target_rel.absX() < 0.5
               || std::fabs( used_power ) < 5.0 )
          )
     {
         agent->debugClient().addMessage( "LookBall" );
 
-        Vector2D my_inertia = wm.self().inertiaPoint( info.reachCycle() );
+        Vector2D my_inertia = wm.self().inertiaPoint( info.reachStep() );
         Vector2D face_point = M_face_point;
         if ( ! M_face_point.isValid() )
         {
@@ -1103,12 +1072,12 @@ Body_Intercept2009::doInertiaDash( PlayerAgent * agent,
 
     agent->doDash( used_power, info.dashDir() );
 #ifdef DEBUG_PRINT
-        if ( info.dashAngle().abs() > 1.0 )
+        if ( std::fabs( info.dashDir() ) > 1.0 )
         {
             std::cerr << wm.time()
                       << ' ' << wm.self().unum()
                       << " intercept omnidash "
-                      << info.dashAngle()
+                      << info.dashDir()
                       << std::endl;
         }
 #endif
@@ -83,14 +83,14 @@ private:
     /*!
       \brief calculate best interception point using cached table
       \param wm const refefence to the WorldModel
-      \param table const pointer to the cached table
+      \param table const reference to the cached table
       \return interception info object
     */
-    InterceptInfo getBestIntercept( const WorldModel & wm,
-                                    const InterceptTable * table ) const;
+    Intercept getBestIntercept( const WorldModel & wm,
+                                const InterceptTable & table ) const;
 
-    InterceptInfo getBestIntercept_Test( const WorldModel & wm,
-                                         const InterceptTable * table ) const;
+    Intercept getBestIntercept_Test( const WorldModel & wm,
+                                     const InterceptTable & table ) const;
 
     /*!
       \brief try to perform ball wait action
@@ -101,7 +101,7 @@ private:
     */
     bool doWaitTurn( PlayerAgent * agent,
                      const Vector2D & target_point,
-                     const InterceptInfo & info );
+                     const Intercept & info );
 
     /*!
       \brief adjutment dash action. if possible try to perform turn action.
@@ -112,7 +112,7 @@ private:
     */
     bool doInertiaDash( PlayerAgent * agent,
                         const Vector2D & target_point,
-                        const InterceptInfo & info );
+                        const Intercept & info );
 
 };
 
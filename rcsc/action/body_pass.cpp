@@ -42,8 +42,10 @@
 #include "body_smart_kick.h"
 #include "body_stop_ball.h"
 #include "body_hold_ball2008.h"
+#include "anytime_search.h"
 
 #include <rcsc/player/player_agent.h>
+#include <rcsc/player/agent_context.h>
 #include <rcsc/player/debug_client.h>
 #include <rcsc/player/audio_sensor.h>
 #include <rcsc/player/say_message_builder.h>
@@ -52,14 +54,238 @@
 #include <rcsc/common/server_param.h>
 #include <rcsc/geom/rect_2d.h>
 #include <rcsc/geom/sector_2d.h>
+#include <rcsc/util/task_graph.h>
 #include <rcsc/soccer_math.h>
 #include <rcsc/math_util.h>
 
+#include <cmath>
+
 //#define DEBUG
+//#define DEBUG_CHECK_BATCH
 
 namespace rcsc {
 
-std::vector< Body_Pass::PassRoute > Body_Pass::S_cached_pass_route;
+namespace {
+
+//! the minimum number of candidates verified on the worker threads
+constexpr std::size_t PARALLEL_MIN_CANDIDATES = 128;
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \struct Body_Pass::Candidates
+  \brief unverified pass routes in the structure-of-arrays layout.
+*/
+struct Body_Pass::Candidates {
+
+    //! opponent check rule
+    enum Check {
+        CHECK_DIRECT,
+        CHECK_THROUGH,
+    };
+
+    std::vector< PassType > type_; //!< pass type id
+    std::vector< const PlayerObject * > receiver_; //!< receiver player
+    std::vector< int > check_; //!< opponent check rule
+    std::vector< double > target_x_; //!< receive point x
+    std::vector< double > target_y_; //!< receive point y
+    std::vector< double > target_dist_; //!< distance from the ball to the receive point
+    std::vector< double > angle_deg_; //!< direction from the ball to the receive point
+    std::vector< double > angle_cos_; //!< cosine of angle_deg_
+    std::vector< double > angle_sin_; //!< sine of angle_deg_
+    std::vector< double > first_speed_; //!< ball first speed
+    std::vector< double > receiver_x_; //!< receiver position x. through check only.
+    std::vector< double > receiver_y_; //!< receiver position y. through check only.
+    std::vector< double > target_buf_; //!< receiver to target distance with the margin. through check only.
+    std::vector< unsigned char > ignore_goalie_; //!< true if goalie is ignored. through check only.
+    std::vector< unsigned char > ok_; //!< verification result
+
+    std::size_t size() const
+      {
+          return type_.size();
+      }
+
+    void clear()
+      {
+          type_.clear();
+          receiver_.clear();
+          check_.clear();
+          target_x_.clear();
+          target_y_.clear();
+          target_dist_.clear();
+          angle_deg_.clear();
+          angle_cos_.clear();
+          angle_sin_.clear();
+          first_speed_.clear();
+          receiver_x_.clear();
+          receiver_y_.clear();
+          target_buf_.clear();
+          ignore_goalie_.clear();
+          ok_.clear();
+      }
+
+    void add( const PassType type,
+              const PlayerObject * receiver,
+              const int check,
+              const Vector2D & target_point,
+              const double target_dist,
+              const AngleDeg & target_angle,
+              const double first_speed,
+              const Vector2D & receiver_pos,
+              const double target_buf,
+              const bool ignore_goalie )
+      {
+          type_.push_back( type );
+          receiver_.push_back( receiver );
+          check_.push_back( check );
+          target_x_.push_back( target_point.x );
+          target_y_.push_back( target_point.y );
+          target_dist_.push_back( target_dist );
+          angle_deg_.push_back( target_angle.degree() );
+          angle_cos_.push_back( target_angle.cos() );
+          angle_sin_.push_back( target_angle.sin() );
+          first_speed_.push_back( first_speed );
+          receiver_x_.push_back( receiver_pos.x );
+          receiver_y_.push_back( receiver_pos.y );
+          target_buf_.push_back( target_buf );
+          ignore_goalie_.push_back( ignore_goalie ? 1 : 0 );
+          ok_.push_back( 0 );
+      }
+
+    /*!
+      \brief add the route checked by the direct pass rule
+    */
+    void addDirect( const PassType type,
+                    const PlayerObject * receiver,
+                    const Vector2D & target_point,
+                    const double target_dist,
+                    const AngleDeg & target_angle,
+                    const double first_speed )
+      {
+          add( type, receiver, CHECK_DIRECT,
+               target_point, target_dist, target_angle, first_speed,
+               Vector2D( 0.0, 0.0 ), 0.0, false );
+      }
+
+    /*!
+      \brief add the route checked by the through pass rule
+    */
+    void addThrough( const WorldModel & world,
+                     const PassType type,
+                     const PlayerObject * receiver,
+                     const Vector2D & receiver_pos,
+                     const Vector2D & target_point,
+                     const double target_dist,
+                     const AngleDeg & target_angle,
+                     const double first_speed )
+      {
+          const ServerParam & SP = ServerParam::i();
+
+          bool very_aggressive = false;
+          if ( target_point.x > 28.0
+               && target_point.x > world.ball().pos().x + 20.0 )
+          {
+              very_aggressive = true;
+          }
+          else if ( target_point.x > world.offsideLineX() + 15.0
+                    && target_point.x > world.ball().pos().x + 15.0 )
+          {
+              very_aggressive = true;
+          }
+          else if ( target_point.x > 38.0
+                    && target_point.x > world.offsideLineX()
+                    && target_point.absY() < 14.0 )
+          {
+              very_aggressive = true;
+          }
+
+          const double dist_rate = ( very_aggressive ? 0.8 : 1.0 );
+          const double dist_buf = ( very_aggressive ? 0.5 : 2.0 );
+          const bool ignore_goalie = ( target_point.absY() > SP.penaltyAreaWidth() - 3.0
+                                       || target_point.x < SP.theirPenaltyAreaLineX() + 2.0 );
+
+          add( type, receiver, CHECK_THROUGH,
+               target_point, target_dist, target_angle, first_speed,
+               receiver_pos,
+               receiver_pos.dist( target_point ) * dist_rate + dist_buf,
+               ignore_goalie );
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \struct Body_Pass::Opponents
+  \brief opponent states used by the route verification in the structure-of-arrays layout.
+*/
+struct Body_Pass::Opponents {
+    std::vector< double > x_; //!< position x
+    std::vector< double > y_; //!< position y
+    std::vector< double > angle_deg_; //!< direction from self
+    std::vector< double > direct_dash_; //!< virtual dash distance for the direct check
+    std::vector< double > through_dash_; //!< virtual dash distance for the through check
+    std::vector< unsigned char > direct_valid_; //!< true if checked by the direct rule
+    std::vector< unsigned char > through_valid_; //!< true if checked by the through rule
+    std::vector< unsigned char > goalie_; //!< true if goalie
+
+    std::size_t size() const
+      {
+          return x_.size();
+      }
+
+    void update( const WorldModel & world )
+      {
+          static const double player_dash_speed = 1.0;
+
+          x_.clear();
+          y_.clear();
+          angle_deg_.clear();
+          direct_dash_.clear();
+          through_dash_.clear();
+          direct_valid_.clear();
+          through_valid_.clear();
+          goalie_.clear();
+
+          for ( const PlayerObject * o : world.opponentsFromSelf() )
+          {
+              if ( o->posCount() > 10 ) continue;
+
+              x_.push_back( o->pos().x );
+              y_.push_back( o->pos().y );
+              angle_deg_.push_back( o->angleFromSelf().degree() );
+              direct_dash_.push_back( player_dash_speed * 0.8 * std::min( 5, o->posCount() ) );
+              through_dash_.push_back( player_dash_speed * std::min( 2, o->posCount() ) );
+              direct_valid_.push_back( o->isGhost() && o->posCount() >= 4 ? 0 : 1 );
+              through_valid_.push_back( 1 );
+              goalie_.push_back( o->goalie() ? 1 : 0 );
+          }
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \struct Body_Pass::Cache
+  \brief calculation result of an agent
+*/
+struct Body_Pass::Cache {
+    GameTime time_; //!< last calculated time
+    bool valid_; //!< true if a pass route was found
+    Vector2D target_; //!< receive point of the best route
+    double speed_; //!< ball first speed of the best route
+    int receiver_; //!< receiver of the best route
+
+    Candidates candidates_; //!< unverified routes. reused in each calculation.
+    Opponents opponents_; //!< opponent states. reused in each calculation.
+    std::vector< PassRoute > routes_; //!< verified routes
+
+    Cache()
+        : time_( -1, 0 ),
+          valid_( false ),
+          target_( Vector2D::INVALIDATED ),
+          speed_( 0.0 ),
+          receiver_( Unum_Unknown )
+      { }
+};
 
 /*-------------------------------------------------------------------*/
 /*!
@@ -137,10 +363,11 @@ Body_Pass::execute( PlayerAgent * agent )
         Vector2D target_buf = target_point - agent->world().self().pos();
         target_buf.setLength( 1.0 );
 
-        agent->addSayMessage( new PassMessage( receiver,
-                                               target_point + target_buf,
-                                               agent->effector().queuedNextBallPos(),
-                                               agent->effector().queuedNextBallVel() ) );
+        agent->emplaceSayMessage< PassMessage >( 0,
+                                                 receiver,
+                                                 target_point + target_buf,
+                                                 agent->effector().queuedNextBallPos(),
+                                                 agent->effector().queuedNextBallVel() );
     }
 
     return true;
@@ -156,85 +383,92 @@ Body_Pass::get_best_pass( const WorldModel & world,
                           double * first_speed,
                           int * receiver )
 {
-    static GameTime S_last_calc_time( 0, 0 );
-    static bool S_last_calc_valid = false;
-    static Vector2D S_last_calc_target;
-    static double S_last_calc_speed = 0.0;
-    static int S_last_calc_receiver = Unum_Unknown;
+    Cache & cache = get_cache( world );
 
-    if ( S_last_calc_time == world.time() )
+    if ( cache.time_ == world.time() )
     {
-        if ( S_last_calc_valid )
+        if ( cache.valid_ )
         {
             if ( target_point )
             {
-                *target_point = S_last_calc_target;
+                *target_point = cache.target_;
             }
             if ( first_speed )
             {
-                *first_speed = S_last_calc_speed;
+                *first_speed = cache.speed_;
             }
             if ( receiver )
             {
-                *receiver = S_last_calc_receiver;
+                *receiver = cache.receiver_;
             }
             return true;
         }
         return false;
     }
 
-    S_last_calc_time = world.time();
-    S_last_calc_valid = false;
+    cache.time_ = world.time();
+    cache.valid_ = false;
 
     // create route
-    create_routes( world );
+    create_routes( world, &cache );
 
-    if ( ! S_cached_pass_route.empty() )
+    if ( ! cache.routes_.empty() )
     {
-        std::vector< PassRoute >::iterator max_it
-            = std::max_element( S_cached_pass_route.begin(),
-                                S_cached_pass_route.end(),
+        std::vector< PassRoute >::const_iterator max_it
+            = std::max_element( cache.routes_.begin(),
+                                cache.routes_.end(),
                                 []( const PassRoute & lhs, const PassRoute & rhs )
                                   {
                                       return lhs.score_ < rhs.score_;
                                   } );
-        S_last_calc_target = max_it->receive_point_;
-        S_last_calc_speed = max_it->first_speed_;
-        S_last_calc_receiver = max_it->receiver_->unum();
-        S_last_calc_valid = true;
+        cache.target_ = max_it->receive_point_;
+        cache.speed_ = max_it->first_speed_;
+        cache.receiver_ = max_it->receiver_->unum();
+        cache.valid_ = true;
         dlog.addText( Logger::ACTION,
                       "%s:%d: get_best_pass() size=%d. target=(%.1f %.1f)"
                       " speed=%.3f  receiver=%d"
                       ,__FILE__, __LINE__,
-                      S_cached_pass_route.size(),
-                      S_last_calc_target.x, S_last_calc_target.y,
-                      S_last_calc_speed,
-                      S_last_calc_receiver );
+                      cache.routes_.size(),
+                      cache.target_.x, cache.target_.y,
+                      cache.speed_,
+                      cache.receiver_ );
     }
 
-    if ( S_last_calc_valid )
+    if ( cache.valid_ )
     {
         if ( target_point )
         {
-            *target_point = S_last_calc_target;
+            *target_point = cache.target_;
         }
         if ( first_speed )
         {
-            *first_speed = S_last_calc_speed;
+            *first_speed = cache.speed_;
         }
         if ( receiver )
         {
-            *receiver = S_last_calc_receiver;
+            *receiver = cache.receiver_;
         }
 
         dlog.addText( Logger::ACTION,
                       "%s:%d: best pass (%.2f, %.2f). speed=%.2f. receiver=%d"
                       ,__FILE__, __LINE__,
-                      S_last_calc_target.x, S_last_calc_target.y,
-                      S_last_calc_speed, S_last_calc_receiver );
+                      cache.target_.x, cache.target_.y,
+                      cache.speed_, cache.receiver_ );
     }
 
-    return S_last_calc_valid;
+    return cache.valid_;
+}
+
+
+/*-------------------------------------------------------------------*/
+/*!
+  static method
+*/
+Body_Pass::Cache &
+Body_Pass::get_cache( const WorldModel & world )
+{
+    return world.agentContext().get< Cache >();
 }
 
 /*-------------------------------------------------------------------*/
@@ -242,12 +476,17 @@ Body_Pass::get_best_pass( const WorldModel & world,
   static method
 */
 void
-Body_Pass::create_routes( const WorldModel & world )
+Body_Pass::create_routes( const WorldModel & world,
+                          Cache * cache )
 {
     // reset old info
-    S_cached_pass_route.clear();
+    Candidates & candidates = cache->candidates_;
+    candidates.clear();
+    cache->routes_.clear();
 
     // loop candidate teammates
+    std::vector< const PlayerObject * > receivers;
+    receivers.reserve( world.teammatesFromSelf().size() );
     for ( const PlayerObject * t : world.teammatesFromSelf() )
     {
         if ( t->goalie() && t->pos().x < -22.0 )
@@ -271,18 +510,94 @@ Body_Pass::create_routes( const WorldModel & world )
             continue;
         }
 
-        // create & verify each route
-        create_direct_pass( world, t );
-        create_lead_pass( world, t );
-        if ( world.self().pos().x > world.offsideLineX() - 20.0 )
+        receivers.push_back( t );
+    }
+
+    //
+    // create the candidate routes.
+    // the cheaper route types are created first for all receivers,
+    // and the rest are skipped if the decision deadline expires.
+    //
+    static AnytimeSearchStats::Counter & s_stats = AnytimeSearchStats::counter( "Body_Pass::create_routes" );
+    const Deadline & deadline = world.decisionDeadline();
+    const bool through_pass = ( world.self().pos().x > world.offsideLineX() - 20.0 );
+
+    std::uint64_t evaluated = 0;
+    std::uint64_t skipped = 0;
+    for ( int type = DIRECT; type <= THROUGH; ++type )
+    {
+        if ( type == THROUGH && ! through_pass ) break;
+
+        for ( const PlayerObject * t : receivers )
         {
-            create_through_pass( world, t );
+            if ( candidates.size() > 0
+                 && deadline.expired() )
+            {
+                ++skipped;
+                break;
+            }
+
+            ++evaluated;
+            switch ( type ) {
+            case DIRECT:
+                create_direct_pass( world, t, &candidates );
+                break;
+            case LEAD:
+                create_lead_pass( world, t, &candidates );
+                break;
+            case THROUGH:
+                create_through_pass( world, t, &candidates );
+                break;
+            default:
+                break;
+            }
         }
     }
 
+    s_stats.add( skipped > 0, evaluated, skipped );
+
+    ////////////////////////////////////////////////////////////////
+    // verification
+    cache->opponents_.update( world );
+    verify_candidates( world, cache->opponents_, &candidates );
+
+    for ( std::size_t i = 0; i < candidates.size(); ++i )
+    {
+        if ( ! candidates.ok_[i] )
+        {
+#ifdef DEBUG
+            dlog.addText( Logger::PASS,
+                          "Pass Failed type=%d unum=%d pos=(%.1f %.1f) angle=%.1f first_speed=%.1f",
+                          candidates.type_[i],
+                          candidates.receiver_[i]->unum(),
+                          candidates.target_x_[i], candidates.target_y_[i],
+                          candidates.angle_deg_[i],
+                          candidates.first_speed_[i] );
+#endif
+            continue;
+        }
+
+        cache->routes_.emplace_back( candidates.type_[i],
+                                     candidates.receiver_[i],
+                                     Vector2D( candidates.target_x_[i], candidates.target_y_[i] ),
+                                     candidates.first_speed_[i],
+                                     can_kick_by_one_step( world,
+                                                           candidates.first_speed_[i],
+                                                           AngleDeg( candidates.angle_deg_[i] ) ) );
+#ifdef DEBUG
+        dlog.addText( Logger::PASS,
+                      "Pass Success type=%d unum=%d pos=(%.1f %.1f) angle=%.1f first_speed=%.1f",
+                      candidates.type_[i],
+                      candidates.receiver_[i]->unum(),
+                      candidates.target_x_[i], candidates.target_y_[i],
+                      candidates.angle_deg_[i],
+                      candidates.first_speed_[i] );
+#endif
+    }
+
     ////////////////////////////////////////////////////////////////
     // evaluation
-    evaluate_routes( world );
+    evaluate_routes( world, &cache->routes_ );
 }
 
 /*-------------------------------------------------------------------*/
@@ -291,7 +606,8 @@ Body_Pass::create_routes( const WorldModel & world )
 */
 void
 Body_Pass::create_direct_pass( const WorldModel & world,
-                               const PlayerObject * receiver )
+                               const PlayerObject * receiver,
+                               Candidates * candidates )
 {
     static const double MAX_DIRECT_PASS_DIST
         = 0.8 * inertia_final_distance( ServerParam::i().ballSpeedMax(),
@@ -444,21 +760,12 @@ Body_Pass::create_direct_pass( const WorldModel & world,
 
 
     // add strictly direct pass
-    if ( verify_direct_pass( world,
-                             receiver,
-                             base_player_pos,
-                             receiver_dist,
-                             receiver_angle,
-                             first_speed ) )
-    {
-        S_cached_pass_route.emplace_back( DIRECT,
-                                          receiver,
-                                          base_player_pos,
-                                          first_speed,
-                                          can_kick_by_one_step( world,
-                                                                first_speed,
-                                                                receiver_angle ) );
-    }
+    candidates->addDirect( DIRECT,
+                           receiver,
+                           base_player_pos,
+                           receiver_dist,
+                           receiver_angle,
+                           first_speed );
 
     // add kickable edge points
     double kickable_angle_buf = 360.0 * ( ServerParam::i().defaultKickableArea()
@@ -471,59 +778,25 @@ Body_Pass::create_direct_pass( const WorldModel & world,
     angle_new += kickable_angle_buf;
     target_new += Vector2D::polar2vector(receiver_dist, angle_new);
 
-    if ( verify_direct_pass( world,
-                             receiver,
-                             target_new,
-                             receiver_dist,
-                             angle_new,
-                             first_speed ) )
-    {
-        S_cached_pass_route.emplace_back( DIRECT,
-                                          receiver,
-                                          target_new,
-                                          first_speed,
-                                          can_kick_by_one_step( world,
-                                                                first_speed,
-                                                                angle_new ) );
-    }
+    candidates->addDirect( DIRECT,
+                           receiver,
+                           target_new,
+                           receiver_dist,
+                           angle_new,
+                           first_speed );
+
     // left side
     target_new = world.ball().pos();
     angle_new = receiver_angle;
     angle_new -= kickable_angle_buf;
     target_new += Vector2D::polar2vector( receiver_dist, angle_new );
 
-    if ( verify_direct_pass( world,
-                             receiver,
-                             target_new,
-                             receiver_dist,
-                             angle_new,
-                             first_speed ) )
-    {
-        S_cached_pass_route.emplace_back( DIRECT,
-                                          receiver,
-                                          target_new,
-                                          first_speed,
-                                          can_kick_by_one_step( world,
-                                                                first_speed,
-                                                                angle_new ) );
-#ifdef DEBUG
-        dlog.addText( Logger::PASS,
-                      "Pass Success direct unum=%d pos=(%.1f %.1f). first_speed= %.1f",
-                      receiver->unum(),
-                      target_new.x, target_new.y,
-                      first_speed );
-#endif
-    }
-    else
-    {
-#ifdef DEBUG
-        dlog.addText( Logger::PASS,
-                      "Pass Failed direct unum=%d pos=(%.1f %.1f). first_speed= %.1f",
-                      receiver->unum(),
-                      target_new.x, target_new.y,
-                      first_speed );
-#endif
-    }
+    candidates->addDirect( DIRECT,
+                           receiver,
+                           target_new,
+                           receiver_dist,
+                           angle_new,
+                           first_speed );
 }
 
 /*-------------------------------------------------------------------*/
@@ -532,7 +805,8 @@ Body_Pass::create_direct_pass( const WorldModel & world,
 */
 void
 Body_Pass::create_lead_pass( const WorldModel & world,
-                             const PlayerObject * receiver )
+                             const PlayerObject * receiver,
+                             Candidates * candidates )
 {
     static const double MAX_LEAD_PASS_DIST
         = 0.7 * inertia_final_distance( ServerParam::i().ballSpeedMax(),
@@ -737,43 +1011,14 @@ Body_Pass::create_lead_pass( const WorldModel & world,
 #endif
             // add lead pass route
             // this methid is same as through pass verification method.
-            if ( verify_through_pass( world,
-                                      receiver,
-                                      receiver->pos(),
-                                      target_point,
-                                      receiver_dist,
-                                      target_angle,
-                                      first_speed,
-                                      ball_steps_to_target ) )
-            {
-                S_cached_pass_route.emplace_back( LEAD,
-                                                  receiver,
-                                                  target_point,
-                                                  first_speed,
-                                                  can_kick_by_one_step( world,
-                                                                        first_speed,
-                                                                        target_angle ) );
-#ifdef DEBUG
-                dlog.addText( Logger::PASS,
-                              "Pass Success lead unum=%d pos=(%.1f %.1f) angle=%.1f first_speed=%.1f",
-                              receiver->unum(),
-                              target_point.x, target_point.y,
-                              target_angle.degree(),
-                              first_speed );
-#endif
-            }
-#ifdef DEBUG
-            else
-            {
-                dlog.addText( Logger::PASS,
-                              "Pass Failed lead unum=%d pos=(%.1f %.1f) angle=%.1f first_speed=%.1f",
-                              receiver->unum(),
-                              target_point.x, target_point.y,
-                              target_angle.degree(),
-                              first_speed );
-
-            }
-#endif
+            candidates->addThrough( world,
+                                    LEAD,
+                                    receiver,
+                                    receiver->pos(),
+                                    target_point,
+                                    receiver_dist,
+                                    target_angle,
+                                    first_speed );
         }
     }
 }
@@ -783,8 +1028,9 @@ Body_Pass::create_lead_pass( const WorldModel & world,
   static method
 */
 void
-Body_Pass::create_through_pass(const WorldModel & world,
-                               const PlayerObject * receiver)
+Body_Pass::create_through_pass( const WorldModel & world,
+                                const PlayerObject * receiver,
+                                Candidates * candidates )
 {
     static const double MAX_THROUGH_PASS_DIST
         = 0.9 * inertia_final_distance( ServerParam::i().ballSpeedMax(),
@@ -970,46 +1216,223 @@ Body_Pass::create_through_pass(const WorldModel & world,
                           target_point.x, target_point.y,
                           first_speed );
 #endif
-            if ( verify_through_pass( world,
-                                      receiver,
-                                      receiver->pos(),
-                                      target_point, target_dist, target_angle,
-                                      first_speed,
-                                      ball_steps_to_target ) )
-            {
-                S_cached_pass_route.emplace_back( THROUGH,
-                                                  receiver,
-                                                  target_point,
-                                                  first_speed,
-                                                  can_kick_by_one_step( world,
-                                                                        first_speed,
-                                                                        target_angle ) );
-#ifdef DEBUG
+            candidates->addThrough( world,
+                                    THROUGH,
+                                    receiver,
+                                    receiver->pos(),
+                                    target_point,
+                                    target_dist,
+                                    target_angle,
+                                    first_speed );
+        }
+    }
+}
 
-                dlog.addText( Logger::PASS,
-                              "Pass Success through pass unum=%d pos=(%.1f %.1f) angle=%.1f first_speed=%.1f dash_step=%.1f ball_step=%.1f",
-                              receiver->unum(),
-                              target_point.x, target_point.y,
-                              target_angle.degree(),
-                              first_speed,
-                              dash_step,
-                              ball_steps_to_target );
+/*-------------------------------------------------------------------*/
+/*!
+  static method
+*/
+void
+Body_Pass::verify_candidates( const WorldModel & world,
+                              const Opponents & opponents,
+                              Candidates * candidates )
+{
+    const std::size_t size = candidates->size();
+    const std::size_t workers = TaskPool::instance().workerCount();
+
+    if ( workers == 0
+         || size < PARALLEL_MIN_CANDIDATES )
+    {
+        verify_candidate_range( world, opponents, 0, size, candidates );
+    }
+    else
+    {
+        // each task writes only its own range of the results.
+        const std::size_t chunk = ( size + workers ) / ( workers + 1 );
+
+        TaskGraph graph;
+        for ( std::size_t begin = 0; begin < size; begin += chunk )
+        {
+            const std::size_t end = std::min( size, begin + chunk );
+            graph.add( [&, begin, end]()
+                         {
+                             verify_candidate_range( world, opponents, begin, end, candidates );
+                         } );
+        }
+        graph.run();
+    }
+
+#ifdef DEBUG_CHECK_BATCH
+    for ( std::size_t i = 0; i < size; ++i )
+    {
+        const Vector2D target_point( candidates->target_x_[i], candidates->target_y_[i] );
+        const bool scalar
+            = ( candidates->check_[i] == Candidates::CHECK_DIRECT
+                ? verify_direct_pass( world,
+                                      candidates->receiver_[i],
+                                      target_point,
+                                      candidates->target_dist_[i],
+                                      AngleDeg( candidates->angle_deg_[i] ),
+                                      candidates->first_speed_[i] )
+                : verify_through_pass( world,
+                                       candidates->receiver_[i],
+                                       Vector2D( candidates->receiver_x_[i], candidates->receiver_y_[i] ),
+                                       target_point,
+                                       candidates->target_dist_[i],
+                                       AngleDeg( candidates->angle_deg_[i] ),
+                                       candidates->first_speed_[i],
+                                       0.0 ) );
+        if ( scalar != static_cast< bool >( candidates->ok_[i] ) )
+        {
+            dlog.addText( Logger::PASS,
+                          "(Body_Pass) batch mismatch (%.2f %.2f) batch=%d scalar=%d",
+                          target_point.x, target_point.y,
+                          candidates->ok_[i], scalar );
+        }
+    }
 #endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  static method
+*/
+void
+Body_Pass::verify_candidate_range( const WorldModel & world,
+                                   const Opponents & opponents,
+                                   const std::size_t begin,
+                                   const std::size_t end,
+                                   Candidates * candidates )
+{
+    static const double player_dash_speed = 1.0;
+
+    const ServerParam & SP = ServerParam::i();
+    const double line_buf = SP.defaultKickableArea() + 0.1;
+    const double ball_decay = SP.ballDecay();
+    const Vector2D ball_pos = world.ball().pos();
+
+    const std::size_t opponent_size = opponents.size();
+    const double * ox = opponents.x_.data();
+    const double * oy = opponents.y_.data();
+    const double * odir = opponents.angle_deg_.data();
+    const unsigned char * ogoalie = opponents.goalie_.data();
+
+    //
+    // opponents are processed in the fixed size blocks not to allocate the memory.
+    // the first loop has no branch, so that the compiler can vectorize it.
+    // it rejects the route by the distance checks and marks the opponents
+    // that need the ball step check, which is done by the scalar loop.
+    //
+    constexpr std::size_t BLOCK = 32;
+
+    double line_dist[BLOCK];
+    double project_x[BLOCK];
+    unsigned char check_step[BLOCK];
+
+    for ( std::size_t i = begin; i < end; ++i )
+    {
+        const bool direct = ( candidates->check_[i] == Candidates::CHECK_DIRECT );
+        const double tx = candidates->target_x_[i];
+        const double ty = candidates->target_y_[i];
+        const double target_dist = candidates->target_dist_[i];
+        const double target_dir = candidates->angle_deg_[i];
+        const double c = candidates->angle_cos_[i];
+        const double s = candidates->angle_sin_[i];
+        const double first_speed = candidates->first_speed_[i];
+        const double next_speed = first_speed * ball_decay;
+        const double target_buf = candidates->target_buf_[i];
+        const bool ignore_goalie = candidates->ignore_goalie_[i];
+
+        // ball position after the kick
+        const double bx = ball_pos.x + first_speed * c;
+        const double by = ball_pos.y + first_speed * s;
+
+        const double * vdash = ( direct
+                                 ? opponents.direct_dash_.data()
+                                 : opponents.through_dash_.data() );
+        const unsigned char * valid = ( direct
+                                        ? opponents.direct_valid_.data()
+                                        : opponents.through_valid_.data() );
+
+        bool rejected = false;
+        for ( std::size_t j0 = 0; j0 < opponent_size && ! rejected; j0 += BLOCK )
+        {
+            const std::size_t n = std::min( BLOCK, opponent_size - j0 );
+            unsigned char reject = 0;
+
+            if ( direct )
+            {
+                for ( std::size_t k = 0; k < n; ++k )
+                {
+                    const std::size_t j = j0 + k;
+                    double dir_diff = odir[j] - target_dir;
+                    dir_diff -= 360.0 * std::floor( ( dir_diff + 180.0 ) / 360.0 );
+                    const bool active = ( valid[j] && std::fabs( dir_diff ) <= 100.0 );
+
+                    const double tdx = ox[j] - tx;
+                    const double tdy = oy[j] - ty;
+                    const bool on_target = ( tdx * tdx + tdy * tdy < 3.0 * 3.0 );
+
+                    const double dx = ox[j] - bx;
+                    const double dy = oy[j] - by;
+                    const double rx = dx * c + dy * s;
+                    const double ry = dy * c - dx * s;
+                    const double line = std::fabs( ry ) - vdash[j] - line_buf;
+                    const bool in_range = ( 0.0 < rx && rx < target_dist );
+
+                    reject |= ( active && ( on_target || ( in_range && line < 0.0 ) ) );
+                    check_step[k] = ( active && ! on_target && in_range && line >= 0.0 );
+                    line_dist[k] = line;
+                    project_x[k] = rx;
+                }
             }
-#ifdef DEBUG
             else
             {
-                dlog.addText( Logger::PASS,
-                              "Pass Failed through unum=%d pos=(%.1f %.1f) angle=%.1f first_speed=%.1f dash_step-%.1f ball_step=%.1f",
-                              receiver->unum(),
-                              target_point.x, target_point.y,
-                              target_angle.degree(),
-                              first_speed,
-                              dash_step,
-                              ball_steps_to_target );
+                for ( std::size_t k = 0; k < n; ++k )
+                {
+                    const std::size_t j = j0 + k;
+                    const bool active = ( valid[j] && ! ( ogoalie[j] && ignore_goalie ) );
+
+                    const double tdx = ox[j] - tx;
+                    const double tdy = oy[j] - ty;
+                    const bool closer = ( std::sqrt( tdx * tdx + tdy * tdy ) - vdash[j] < target_buf );
+
+                    const double dx = ox[j] - bx;
+                    const double dy = oy[j] - by;
+                    const double rx = dx * c + dy * s;
+                    const double ry = dy * c - dx * s;
+                    const double line = std::fabs( ry ) - vdash[j] - line_buf;
+                    const bool in_range = ( 0.0 < rx && rx < target_dist );
+
+                    reject |= ( active && ( closer || ( in_range && line < 0.0 ) ) );
+                    check_step[k] = ( active && ! closer && in_range && line >= 0.0 );
+                    line_dist[k] = line;
+                    project_x[k] = rx;
+                }
+            }
+
+            if ( reject )
+            {
+                rejected = true;
+                break;
+            }
+
+            for ( std::size_t k = 0; k < n; ++k )
+            {
+                if ( ! check_step[k] ) continue;
+
+                const double ball_steps_to_project
+                    = calc_length_geom_series( next_speed, project_x[k], ball_decay );
+                if ( ball_steps_to_project < 0.0
+                     || line_dist[k] / player_dash_speed < ball_steps_to_project )
+                {
+                    rejected = true;
+                    break;
+                }
             }
-#endif
         }
+
+        candidates->ok_[i] = ( rejected ? 0 : 1 );
     }
 }
 
@@ -1269,12 +1692,13 @@ Body_Pass::verify_through_pass( const WorldModel & world,
   static method
 */
 void
-Body_Pass::evaluate_routes( const WorldModel & world )
+Body_Pass::evaluate_routes( const WorldModel & world,
+                            std::vector< PassRoute > * routes )
 {
     const AngleDeg min_angle = -45.0;
     const AngleDeg max_angle = 45.0;
 
-    for ( std::vector< PassRoute >::iterator it = S_cached_pass_route.begin(), end = S_cached_pass_route.end();
+    for ( std::vector< PassRoute >::iterator it = routes->begin(), end = routes->end();
           it != end;
           ++it )
     {
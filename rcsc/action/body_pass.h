@@ -97,8 +97,9 @@ public:
 
 private:
 
-    //! cached calculated pass data
-    static std::vector< PassRoute > S_cached_pass_route;
+    struct Candidates;
+    struct Opponents;
+    struct Cache;
 
 
 public:
@@ -122,6 +123,10 @@ public:
       \param first_speed ball first speed is stored to this
       \param receiver receiver number
       \return true if pass route is found.
+
+      The result is cached for each WorldModel instance until the game
+      time changes, so several agents in one process never share the
+      result.
     */
     static
     bool get_best_pass( const WorldModel & world,
@@ -131,17 +136,35 @@ public:
 
 private:
     static
-    void create_routes( const WorldModel & world );
+    Cache & get_cache( const WorldModel & world );
+
+    static
+    void create_routes( const WorldModel & world,
+                        Cache * cache );
 
     static
     void create_direct_pass( const WorldModel & world,
-                             const PlayerObject * teammates );
+                             const PlayerObject * teammates,
+                             Candidates * candidates );
     static
     void create_lead_pass( const WorldModel & world,
-                           const PlayerObject * teammates );
+                           const PlayerObject * teammates,
+                           Candidates * candidates );
     static
     void create_through_pass( const WorldModel & world,
-                              const PlayerObject * teammates );
+                              const PlayerObject * teammates,
+                              Candidates * candidates );
+
+    static
+    void verify_candidates( const WorldModel & world,
+                            const Opponents & opponents,
+                            Candidates * candidates );
+    static
+    void verify_candidate_range( const WorldModel & world,
+                                 const Opponents & opponents,
+                                 const std::size_t begin,
+                                 const std::size_t end,
+                                 Candidates * candidates );
 
     static
     bool verify_direct_pass( const WorldModel & world,
@@ -161,7 +184,8 @@ private:
                               const double & reach_step );
 
     static
-    void evaluate_routes( const WorldModel & world );
+    void evaluate_routes( const WorldModel & world,
+                          std::vector< PassRoute > * routes );
 
     static
     bool can_kick_by_one_step( const WorldModel & world,
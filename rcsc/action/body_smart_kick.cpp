@@ -83,12 +83,12 @@ Body_SmartKick::execute( PlayerAgent * agent )
     double first_speed_thr = std::max( 0.0, M_first_speed_thr );
     int max_step = std::max( 1, M_max_step );
 
-    if ( KickTable::instance().simulate( wm,
-                                         M_target_point,
-                                         first_speed,
-                                         first_speed_thr,
-                                         max_step,
-                                         M_sequence )
+    if ( KickTable::instance( wm ).simulate( wm,
+                                             M_target_point,
+                                             first_speed,
+                                             first_speed_thr,
+                                             max_step,
+                                             M_sequence )
          || M_sequence.speed_ >= first_speed_thr )
     {
         agent->debugClient().addMessage( "SmartKick%d", (int)M_sequence.pos_list_.size() );
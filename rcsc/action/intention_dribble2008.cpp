@@ -214,8 +214,9 @@ IntentionDribble2008::execute( PlayerAgent * agent )
         dlog.addText( Logger::ACTION,
                       __FILE__":  set dribble communication." );
         agent->debugClient().addMessage( "Say_D" );
-        agent->addSayMessage( new DribbleMessage( M_target_point,
-                                                  M_turn_step + M_dash_step ) );
+        agent->emplaceSayMessage< DribbleMessage >( 0,
+                                                    M_target_point,
+                                                    M_turn_step + M_dash_step );
     }
 #endif
     return true;
@@ -34,23 +34,42 @@
 #endif
 
 #include "kick_table.h"
+#include "anytime_search.h"
 
 #include <rcsc/player/world_model.h>
+#include <rcsc/player/agent_context.h>
 #include <rcsc/geom/ray_2d.h>
 #include <rcsc/geom/circle_2d.h>
 #include <rcsc/geom/rect_2d.h>
 #include <rcsc/common/logger.h>
 #include <rcsc/common/server_param.h>
+#include <rcsc/common/server_param_profile.h>
 #include <rcsc/common/player_param.h>
 #include <rcsc/common/player_type.h>
 #include <rcsc/game_time.h>
 #include <rcsc/math_util.h>
 #include <rcsc/soccer_math.h>
 #include <rcsc/timer.h>
+#include <rcsc/util/performance_monitor.h>
+#include <rcsc/util/memory_accounting.h>
+#include <rcsc/util/shared_table_segment.h>
+#include <rcsc/util/task_graph.h>
 
 #include <algorithm>
 #include <functional>
 #include <fstream>
+#include <sstream>
+#include <type_traits>
+#include <limits>
+#include <cstdio>
+#include <cstring>
+
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 // #define DEBUG_PROFILE
 // #define DEBUG
@@ -78,6 +97,21 @@ const int NUM_STATE = STATE_DIVS_NEAR + STATE_DIVS_MID + STATE_DIVS_FAR;
 
 const size_t MAX_TABLE_SIZE = 1024;
 
+//! the three step search is cut if the offline max speed is lower than (first_speed - this value)
+const double PRUNE_SPEED_MARGIN = 0.2;
+
+//! the upper bound of the score of the sequence that cannot reach the required speed
+const double FAILED_SCORE_BOUND = -10000.0;
+
+//! default number of the memorized search results in one cycle
+const std::size_t DEFAULT_MEMO_CAPACITY = 16;
+
+//! quantization steps of the memo key
+const double MEMO_POS_STEP = 0.01;
+const double MEMO_DIR_STEP = 0.1;
+const double MEMO_DIST_STEP = 0.1;
+const double MEMO_SPEED_STEP = 0.01;
+
 
 /*!
  \struct TableSorter
@@ -214,6 +248,235 @@ is_risky_flag( const int flag )
              || flag & KickTable::KICK_MISS_POSSIBILITY );
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the score penalty by the opponent flags. used by KickTable::evaluate().
+ */
+double
+flag_penalty( const int n_kick,
+              const int flag )
+{
+    double penalty = 0.0;
+
+    if ( flag & KickTable::TACKLABLE ) penalty += 500.0;
+    if ( flag & KickTable::NEXT_TACKLABLE ) penalty += 300.0;
+    if ( flag & KickTable::NEXT_KICKABLE ) penalty += 600.0;
+    if ( flag & KickTable::MAYBE_RELEASE_INTERFERE )
+    {
+        penalty += ( n_kick == 1 ? 250.0 : 200.0 );
+    }
+    return penalty;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the score penalty by the number of kicks
+ */
+double
+kick_count_penalty( const int n_kick )
+{
+    return ( n_kick == 3 ? 200.0
+             : n_kick == 2 ? 50.0
+             : 0.0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the score upper bound of the sequence that reaches the required speed
+  \param n_kick the number of kicks
+  \param flag known state flags of the sequence
+ */
+double
+score_upper_bound( const int n_kick,
+                   const int flag )
+{
+    return 1000.0 - kick_count_penalty( n_kick ) - flag_penalty( n_kick, flag );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief evaluate the kick sequence
+  \param seq kick sequence
+  \param first_speed required first speed
+  \param allowable_speed required first speed threshold
+  \return score value
+ */
+double
+sequence_score( const KickTable::Sequence & seq,
+                const double first_speed,
+                const double allowable_speed )
+{
+    const double power_thr1 = ServerParam::i().maxPower() * 0.94;
+    const double power_thr2 = ServerParam::i().maxPower() * 0.9;
+
+    const int n_kick = seq.pos_list_.size();
+
+    double score = 1000.0;
+
+    if ( seq.speed_ < first_speed )
+    {
+        if ( n_kick > 1
+             || seq.speed_ < allowable_speed )
+        {
+            score = -10000.0;
+            score -= ( first_speed - seq.speed_ ) * 100000.0;
+        }
+        else
+        {
+            score -= 50.0;
+        }
+    }
+
+    score -= flag_penalty( n_kick, seq.flag_ );
+    score -= kick_count_penalty( n_kick );
+
+    if ( n_kick > 1 )
+    {
+        if ( seq.power_ > power_thr1 )
+        {
+            score -= 75.0;
+        }
+        else if ( seq.power_ > power_thr2 )
+        {
+            score -= 25.0;
+        }
+    }
+
+    score -= seq.power_ * 0.5;
+
+    if ( seq.flag_ & KickTable::KICK_MISS_POSSIBILITY )
+    {
+        score -= 30.0;
+    }
+
+    return score;
+}
+
+//
+// binary table file format.
+// [BinaryHeader][BinaryState x state_size][KickTable::Path x sum(path_size)]
+// all values are stored in the native byte order.
+//
+
+const char BINARY_MAGIC[8] = { 'R', 'C', 'S', 'C', 'K', 'T', 'B', '\0' };
+const std::uint32_t BINARY_VERSION = 1;
+const std::uint32_t BINARY_BYTE_ORDER = 0x01020304;
+
+struct BinaryHeader {
+    char magic_[8];
+    std::uint32_t version_;
+    std::uint32_t byte_order_;
+    std::uint64_t key_;
+    double player_size_;
+    double kickable_margin_;
+    double ball_size_;
+    std::uint32_t state_size_;
+    std::uint32_t dir_divs_;
+    std::uint64_t path_size_[KickTable::DEST_DIR_DIVS];
+};
+
+struct BinaryState {
+    std::int32_t index_;
+    std::int32_t flag_;
+    double dist_;
+    double x_;
+    double y_;
+    double kick_rate_;
+};
+
+static_assert( std::is_trivially_copyable< KickTable::Path >::value
+               && std::is_standard_layout< KickTable::Path >::value,
+               "KickTable::Path must be stored as is in the binary file." );
+static_assert( sizeof( BinaryHeader ) % alignof( double ) == 0
+               && sizeof( BinaryState ) % alignof( double ) == 0,
+               "binary table sections must be aligned." );
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief FNV-1a hash of a double value bit pattern
+ */
+inline
+std::uint64_t
+hash_value( std::uint64_t h,
+            const double value )
+{
+    std::uint64_t bits = 0;
+    std::memcpy( &bits, &value, sizeof( bits ) );
+    for ( int i = 0; i < 8; ++i )
+    {
+        h ^= ( bits >> ( 8 * i ) ) & 0xFF;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief load the whole file as read-only memory
+  \param file_path file path to read
+  \param size pointer to the variable to store the file size
+  \return pointer to the data. NULL if failed.
+ */
+std::shared_ptr< const char >
+load_binary_file( const std::string & file_path,
+                  std::size_t * size )
+{
+#ifdef HAVE_SYS_MMAN_H
+    const int fd = ::open( file_path.c_str(), O_RDONLY );
+    if ( fd < 0 )
+    {
+        return std::shared_ptr< const char >();
+    }
+
+    struct stat st;
+    if ( ::fstat( fd, &st ) != 0
+         || st.st_size <= 0 )
+    {
+        ::close( fd );
+        return std::shared_ptr< const char >();
+    }
+
+    const std::size_t length = static_cast< std::size_t >( st.st_size );
+    void * addr = ::mmap( nullptr, length, PROT_READ, MAP_SHARED, fd, 0 );
+    ::close( fd );
+
+    if ( addr == MAP_FAILED )
+    {
+        return std::shared_ptr< const char >();
+    }
+
+    *size = length;
+    return std::shared_ptr< const char >( static_cast< const char * >( addr ),
+                                          [length]( const char * p )
+                                            {
+                                                ::munmap( const_cast< char * >( p ), length );
+                                            } );
+#else
+    std::ifstream fin( file_path.c_str(), std::ios::binary | std::ios::ate );
+    if ( ! fin.is_open() )
+    {
+        return std::shared_ptr< const char >();
+    }
+
+    const std::streamsize length = fin.tellg();
+    if ( length <= 0 )
+    {
+        return std::shared_ptr< const char >();
+    }
+
+    char * buf = new char[length];
+    fin.seekg( 0 );
+    if ( ! fin.read( buf, length ) )
+    {
+        delete [] buf;
+        return std::shared_ptr< const char >();
+    }
+
+    *size = static_cast< std::size_t >( length );
+    return std::shared_ptr< const char >( buf, std::default_delete< const char[] >() );
+#endif
+}
+
 }
 
 /*-------------------------------------------------------------------*/
@@ -297,9 +560,81 @@ KickTable &
 KickTable::instance()
 {
     static KickTable s_instance;
+    static const bool s_registered = ( MemoryAccounting::instance().addProbe( "kick_table",
+                                                                              []() { return s_instance.memoryUsage(); } ),
+                                       true );
+    (void)s_registered;
     return s_instance;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::size_t
+KickTable::memoryUsage() const
+{
+    std::size_t bytes = vector_memory_usage( M_state_list );
+
+    for ( const std::vector< Path > & t : M_tables )
+    {
+        bytes += vector_memory_usage( t );
+    }
+
+    for ( const std::vector< State > & c : M_state_cache )
+    {
+        bytes += vector_memory_usage( c );
+    }
+
+    bytes += vector_memory_usage( M_candidates );
+    for ( const Sequence & seq : M_candidates )
+    {
+        bytes += vector_memory_usage( seq.pos_list_ );
+    }
+
+    bytes += vector_memory_usage( M_memo );
+    for ( const MemoEntry & m : M_memo )
+    {
+        bytes += vector_memory_usage( m.sequence_.pos_list_ );
+    }
+
+    return bytes;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \struct KickTable::AgentTable
+  \brief holder of the per-agent instance stored in AgentContext
+*/
+struct KickTable::AgentTable {
+    KickTable table_;
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+KickTable &
+KickTable::instance( const WorldModel & world )
+{
+    const KickTable & shared = instance();
+    KickTable & table = world.agentContext().get< AgentTable >().table_;
+
+    if ( table.M_shared_generation != shared.M_table_generation )
+    {
+        table.shareTables( shared );
+    }
+
+    table.M_use_risky_node = shared.M_use_risky_node;
+    table.M_pruning = shared.M_pruning;
+    if ( table.M_memo_capacity != shared.M_memo_capacity )
+    {
+        table.setMemoCapacity( shared.M_memo_capacity );
+    }
+
+    return table;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -308,12 +643,80 @@ KickTable::KickTable()
     : M_player_size( 0.0 ),
       M_kickable_margin( 0.0 ),
       M_ball_size( 0.0 ),
-      M_use_risky_node( false )
+      M_table_generation( 0 ),
+      M_shared_generation( 0 ),
+      M_update_time( -1, 0 ),
+      M_memo_time( -1, 0 ),
+      M_memo_capacity( DEFAULT_MEMO_CAPACITY ),
+      M_memo_stamp( 0 ),
+      M_use_risky_node( false ),
+      M_pruning( false ),
+      M_best_score( -std::numeric_limits< double >::max() ),
+      M_thread_count( 1 )
 {
     for ( int i = 0; i < MAX_DEPTH; ++ i )
     {
         M_state_cache[i].reserve( NUM_STATE );
     }
+
+    M_memo.reserve( M_memo_capacity );
+
+    setTableView();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+KickTable::~KickTable()
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+KickTable::setTableView()
+{
+    for ( int i = 0; i < DEST_DIR_DIVS; ++i )
+    {
+        M_table_data[i] = M_tables[i].data();
+        M_table_size[i] = M_tables[i].size();
+    }
+
+    M_binary_data.reset();
+    ++M_table_generation;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+KickTable::shareTables( const KickTable & shared )
+{
+    M_player_size = shared.M_player_size;
+    M_kickable_margin = shared.M_kickable_margin;
+    M_ball_size = shared.M_ball_size;
+
+    M_state_list = shared.M_state_list;
+
+    for ( int i = 0; i < DEST_DIR_DIVS; ++i )
+    {
+        std::vector< Path >().swap( M_tables[i] );
+        M_table_data[i] = shared.M_table_data[i];
+        M_table_size[i] = shared.M_table_size[i];
+    }
+
+    M_binary_data = shared.M_binary_data;
+    M_shared_generation = shared.M_table_generation;
+
+    // the cached results depend on the tables
+    M_update_time.assign( -1, 0 );
+    M_memo_time.assign( -1, 0 );
+    M_memo.clear();
 }
 
 /*-------------------------------------------------------------------*/
@@ -343,16 +746,29 @@ KickTable::createTables()
     Timer timer;
 
     const double angle_step = 360.0 / DEST_DIR_DIVS;
-    AngleDeg angle = -180.0;
 
-    for ( int i = 0; i < DEST_DIR_DIVS; ++i, angle += angle_step )
+    // each table only refers the static state list. the directions are split
+    // into the tasks executed on the background lane of the shared pool.
+    const int task_count = std::min( M_thread_count, static_cast< int >( DEST_DIR_DIVS ) );
+
+    TaskGraph graph;
+    for ( int t = 0; t < task_count; ++t )
     {
-        createTable( angle, M_tables[i] );
+        graph.add( [this, angle_step, task_count, t]()
+                   {
+                       for ( int i = t; i < DEST_DIR_DIVS; i += task_count )
+                       {
+                           createTable( AngleDeg( -180.0 + angle_step * i ), M_tables[i] );
+                       }
+                   } );
     }
+    graph.run( task_count > 1, TaskPool::BACKGROUND );
+
+    setTableView();
 
-    dlog.addText( Logger::KICK,
-                  "(KickTable::createTables) elapsed %f [ms]",
-                  timer.elapsedReal() );
+    RCSC_DLOG_TEXT( Logger::KICK,
+                    "(KickTable::createTables) elapsed %f [ms]",
+                    timer.elapsedReal() );
 
 #if 0
     const double kprate = ServerParam::i().kickPowerRate();
@@ -408,6 +824,7 @@ KickTable::read( const std::string & file_path )
         M_tables[dir].clear();
         M_tables[dir].reserve( NUM_STATE * NUM_STATE );
     }
+    setTableView();
 
     std::string line_buf;
 
@@ -539,6 +956,8 @@ KickTable::read( const std::string & file_path )
     M_kickable_margin = kickable_margin;
     M_ball_size = ball_size;
 
+    setTableView();
+
     std::cerr << "read kick table ... ok" << std::endl;
 
     return true;
@@ -582,14 +1001,14 @@ KickTable::write( const std::string & file_path )
 
     for ( int dir = 0; dir < DEST_DIR_DIVS; ++dir )
     {
-        fout << M_tables[dir].size() << '\n';
+        fout << M_table_size[dir] << '\n';
 
-        for ( const Path & t : M_tables[dir] )
+        for ( const Path * t = M_table_data[dir], * end = t + M_table_size[dir]; t != end; ++t )
         {
-            fout << t.origin_ << ' '
-                 << t.dest_ << ' '
-                 << t.max_speed_ << ' '
-                 << t.power_ << '\n';
+            fout << t->origin_ << ' '
+                 << t->dest_ << ' '
+                 << t->max_speed_ << ' '
+                 << t->power_ << '\n';
         }
     }
 
@@ -599,6 +1018,303 @@ KickTable::write( const std::string & file_path )
     return true;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::uint64_t
+KickTable::table_key()
+{
+    const ServerParam & SP = ServerParam::i();
+    const PlayerType player_type; // default type
+
+    std::uint64_t h = 14695981039346656037ULL;
+    h = hash_value( h, BINARY_VERSION );
+    h = hash_value( h, NUM_STATE );
+    h = hash_value( h, DEST_DIR_DIVS );
+    h = hash_value( h, static_cast< double >( MAX_TABLE_SIZE ) );
+    h = hash_value( h, player_type.playerSize() );
+    h = hash_value( h, player_type.kickableMargin() );
+    h = hash_value( h, player_type.kickableArea() );
+    h = hash_value( h, player_type.kickPowerRate() );
+    h = hash_value( h, PlayerParam::i().kickableMarginDeltaMin() );
+    h = hash_value( h, SP.ballSize() );
+    h = hash_value( h, SP.ballSpeedMax() );
+    h = hash_value( h, SP.ballAccelMax() );
+    h = hash_value( h, SP.maxPower() );
+    return h;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+KickTable::readBinary( const std::string & file_path )
+{
+    std::size_t size = 0;
+    std::shared_ptr< const char > data = load_binary_file( file_path, &size );
+    if ( ! data )
+    {
+        return false;
+    }
+
+    return readBinary( data, size );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+KickTable::readBinary( const std::shared_ptr< const char > & data,
+                       const std::size_t size )
+{
+    if ( ! data
+         || size < sizeof( BinaryHeader ) )
+    {
+        std::cerr << "read binary kick table ... failed. too short file." << std::endl;
+        return false;
+    }
+
+    const BinaryHeader * header = reinterpret_cast< const BinaryHeader * >( data.get() );
+
+    if ( std::memcmp( header->magic_, BINARY_MAGIC, sizeof( BINARY_MAGIC ) ) != 0
+         || header->version_ != BINARY_VERSION
+         || header->byte_order_ != BINARY_BYTE_ORDER
+         || header->dir_divs_ != DEST_DIR_DIVS )
+    {
+        std::cerr << "read binary kick table ... failed. unsupported format." << std::endl;
+        return false;
+    }
+
+    if ( header->key_ != table_key() )
+    {
+        std::cerr << "read binary kick table ... failed. parameter mismatch." << std::endl;
+        return false;
+    }
+
+    const std::size_t state_size = header->state_size_;
+    std::size_t expected_size = sizeof( BinaryHeader ) + sizeof( BinaryState ) * state_size;
+    for ( int dir = 0; dir < DEST_DIR_DIVS; ++dir )
+    {
+        if ( header->path_size_[dir] > MAX_TABLE_SIZE )
+        {
+            std::cerr << "read binary kick table ... failed. illegal path size." << std::endl;
+            return false;
+        }
+        expected_size += sizeof( Path ) * header->path_size_[dir];
+    }
+
+    if ( size != expected_size )
+    {
+        std::cerr << "read binary kick table ... failed. illegal file size." << std::endl;
+        return false;
+    }
+
+    //
+    // copy the state list, that is small
+    //
+    const BinaryState * states = reinterpret_cast< const BinaryState * >( data.get() + sizeof( BinaryHeader ) );
+
+    std::vector< State > state_list;
+    state_list.reserve( NUM_STATE );
+    for ( std::size_t i = 0; i < state_size; ++i )
+    {
+        if ( states[i].index_ != static_cast< int >( i ) )
+        {
+            std::cerr << "read binary kick table ... failed. illegal state index." << std::endl;
+            return false;
+        }
+
+        state_list.emplace_back( states[i].index_,
+                                 states[i].dist_,
+                                 Vector2D( states[i].x_, states[i].y_ ),
+                                 states[i].kick_rate_ );
+        state_list.back().flag_ = states[i].flag_;
+    }
+
+    //
+    // refer the path tables in the file data
+    //
+    const Path * paths = reinterpret_cast< const Path * >( states + state_size );
+    const Path * table_data[DEST_DIR_DIVS];
+    for ( int dir = 0; dir < DEST_DIR_DIVS; ++dir )
+    {
+        table_data[dir] = paths;
+        for ( const Path * p = paths, * end = paths + header->path_size_[dir]; p != end; ++p )
+        {
+            if ( p->origin_ < 0 || static_cast< int >( state_size ) <= p->origin_
+                 || p->dest_ < 0 || static_cast< int >( state_size ) <= p->dest_ )
+            {
+                std::cerr << "read binary kick table ... failed. illegal path index." << std::endl;
+                return false;
+            }
+        }
+        paths += header->path_size_[dir];
+    }
+
+    M_player_size = header->player_size_;
+    M_kickable_margin = header->kickable_margin_;
+    M_ball_size = header->ball_size_;
+
+    M_state_list.swap( state_list );
+
+    for ( int dir = 0; dir < DEST_DIR_DIVS; ++dir )
+    {
+        std::vector< Path >().swap( M_tables[dir] );
+        M_table_data[dir] = table_data[dir];
+        M_table_size[dir] = header->path_size_[dir];
+    }
+
+    M_binary_data = data;
+    ++M_table_generation;
+
+    std::cerr << "read binary kick table ... ok" << std::endl;
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+KickTable::writeBinary( std::ostream & os ) const
+{
+    if ( M_state_list.empty() )
+    {
+        return false;
+    }
+
+    BinaryHeader header;
+    std::memset( &header, 0, sizeof( header ) );
+    std::memcpy( header.magic_, BINARY_MAGIC, sizeof( BINARY_MAGIC ) );
+    header.version_ = BINARY_VERSION;
+    header.byte_order_ = BINARY_BYTE_ORDER;
+    header.key_ = table_key();
+    header.player_size_ = M_player_size;
+    header.kickable_margin_ = M_kickable_margin;
+    header.ball_size_ = M_ball_size;
+    header.state_size_ = static_cast< std::uint32_t >( M_state_list.size() );
+    header.dir_divs_ = DEST_DIR_DIVS;
+    for ( int dir = 0; dir < DEST_DIR_DIVS; ++dir )
+    {
+        header.path_size_[dir] = M_table_size[dir];
+    }
+
+    os.write( reinterpret_cast< const char * >( &header ), sizeof( header ) );
+
+    for ( const State & s : M_state_list )
+    {
+        BinaryState state;
+        std::memset( &state, 0, sizeof( state ) );
+        state.index_ = s.index_;
+        state.flag_ = s.flag_;
+        state.dist_ = s.dist_;
+        state.x_ = s.pos_.x;
+        state.y_ = s.pos_.y;
+        state.kick_rate_ = s.kick_rate_;
+        os.write( reinterpret_cast< const char * >( &state ), sizeof( state ) );
+    }
+
+    for ( int dir = 0; dir < DEST_DIR_DIVS; ++dir )
+    {
+        os.write( reinterpret_cast< const char * >( M_table_data[dir] ),
+                  sizeof( Path ) * M_table_size[dir] );
+    }
+
+    return static_cast< bool >( os );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+KickTable::writeBinary( const std::string & file_path ) const
+{
+    if ( M_state_list.empty() )
+    {
+        return false;
+    }
+
+    const std::string tmp_path = file_path + ".tmp";
+
+    {
+        std::ofstream fout( tmp_path.c_str(), std::ios::binary | std::ios::trunc );
+        if ( ! fout.is_open() )
+        {
+            return false;
+        }
+
+        if ( ! writeBinary( fout ) )
+        {
+            std::remove( tmp_path.c_str() );
+            return false;
+        }
+
+        fout.flush();
+        if ( ! fout )
+        {
+            std::remove( tmp_path.c_str() );
+            return false;
+        }
+    }
+
+    if ( std::rename( tmp_path.c_str(), file_path.c_str() ) != 0 )
+    {
+        std::remove( tmp_path.c_str() );
+        return false;
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+KickTable::createSharedTables()
+{
+    if ( ! SharedTableSegment::is_supported() )
+    {
+        return createTables();
+    }
+
+    bool built = false;
+    std::size_t size = 0;
+    std::shared_ptr< const char > data
+        = SharedTableSegment::acquire( SharedTableSegment::make_name( "kick_table", table_key() ),
+                                       [this, &built]( std::string & buf )
+                                         {
+                                             // the tables may be already created in this process
+                                             built = createTables();
+                                             if ( M_state_list.empty() )
+                                             {
+                                                 return false;
+                                             }
+                                             std::ostringstream os;
+                                             if ( ! writeBinary( os ) )
+                                             {
+                                                 return false;
+                                             }
+                                             buf = os.str();
+                                             return true;
+                                         },
+                                       &size );
+
+    if ( data
+         && readBinary( data, size ) )
+    {
+        return true;
+    }
+
+    // the segment is not available. use the tables built in this process.
+    return built || createTables();
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -714,14 +1430,12 @@ KickTable::createTable( const AngleDeg & angle,
 void
 KickTable::updateState( const WorldModel & world )
 {
-    static GameTime s_update_time( -1, 0 );
-
-    if ( s_update_time == world.time() )
+    if ( M_update_time == world.time() )
     {
         return;
     }
 
-    s_update_time = world.time();
+    M_update_time = world.time();
 
     //
     // update current state
@@ -733,9 +1447,9 @@ KickTable::updateState( const WorldModel & world )
     createStateCache( world );
 
 #ifdef DEBUG_PROFILE
-    dlog.addText( Logger::KICK,
-                  "(KickTable::updateState) KickTable_elapsed %f [ms]",
-                  timer.elapsedReal() );
+    RCSC_DLOG_TEXT( Logger::KICK,
+                    "(KickTable::updateState) KickTable_elapsed %f [ms]",
+                    timer.elapsedReal() );
 #endif
 }
 
@@ -747,8 +1461,8 @@ void
 KickTable::createStateCache( const WorldModel & world )
 {
 #ifdef DEBUG
-    dlog.addText( Logger::KICK,
-                  "(KickTable::createStateCache)" );
+    RCSC_DLOG_TEXT( Logger::KICK,
+                    "(KickTable::createStateCache)" );
 #endif
 
     const ServerParam & param = ServerParam::i();
@@ -789,10 +1503,10 @@ KickTable::createStateCache( const WorldModel & world )
         M_current_state.pos_ = world.ball().pos();
         M_current_state.kick_rate_ = world.self().kickRate();
 #ifdef DEBUG
-        dlog.addText( Logger::KICK,
-                      "__ current_state pos=(%.2f %.2f) kick_rate=%.3f",
-                      world.ball().pos().x, world.ball().pos().y,
-                      M_current_state.kick_rate_ );
+        RCSC_DLOG_TEXT( Logger::KICK,
+                        "__ current_state pos=(%.2f %.2f) kick_rate=%.3f",
+                        world.ball().pos().x, world.ball().pos().y,
+                        M_current_state.kick_rate_ );
 #endif
         checkInterfereAt( world, 0, M_current_state );
     }
@@ -828,11 +1542,11 @@ KickTable::createStateCache( const WorldModel & world )
                 M_state_cache[i].back().flag_ |= OUT_OF_PITCH;
             }
 #ifdef DEBUG
-            dlog.addText( Logger::KICK,
-                          "__ cache_near_%d index=%d pos=(%.2f %.2f) kick_rate=%f/%f",
-                          i+1, index,
-                          pos.x, pos.y,
-                          krate, M_state_list[index].kick_rate_ );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "__ cache_near_%d index=%d pos=(%.2f %.2f) kick_rate=%f/%f",
+                            i+1, index,
+                            pos.x, pos.y,
+                            krate, M_state_list[index].kick_rate_ );
 #endif
             ++index;
         }
@@ -853,11 +1567,11 @@ KickTable::createStateCache( const WorldModel & world )
                 M_state_cache[i].back().flag_ |= OUT_OF_PITCH;
             }
 #ifdef DEBUG
-            dlog.addText( Logger::KICK,
-                          "__ cache_mid_%d index=%d pos=(%.2f %.2f) kick_rate=%f/%f",
-                          i+1, index,
-                          pos.x, pos.y,
-                          krate,  M_state_list[index].kick_rate_ );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "__ cache_mid_%d index=%d pos=(%.2f %.2f) kick_rate=%f/%f",
+                            i+1, index,
+                            pos.x, pos.y,
+                            krate,  M_state_list[index].kick_rate_ );
 #endif
             ++index;
         }
@@ -878,11 +1592,11 @@ KickTable::createStateCache( const WorldModel & world )
                 M_state_cache[i].back().flag_ |= OUT_OF_PITCH;
             }
 #ifdef DEBUG
-            dlog.addText( Logger::KICK,
-                          "__ cache_far_%d index=%d pos=(%.2f %.2f) kick_rate=%f/%f",
-                          i+1, index,
-                          pos.x, pos.y,
-                          krate, M_state_list[index].kick_rate_ );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "__ cache_far_%d index=%d pos=(%.2f %.2f) kick_rate=%f/%f",
+                            i+1, index,
+                            pos.x, pos.y,
+                            krate, M_state_list[index].kick_rate_ );
 #endif
             ++index;
         }
@@ -900,8 +1614,8 @@ KickTable::checkCollisionAfterRelease( const WorldModel & world,
                                        const double first_speed )
 {
 #ifdef DEBUG
-    dlog.addText( Logger::KICK,
-                  "(KickTable::checkCollisionAfterRelease)" );
+    RCSC_DLOG_TEXT( Logger::KICK,
+                    "(KickTable::checkCollisionAfterRelease)" );
 #endif
 
     const PlayerType & self_type = world.self().playerType();
@@ -923,19 +1637,19 @@ KickTable::checkCollisionAfterRelease( const WorldModel & world,
         if ( self_pos.dist2( release_pos ) < collide_dist2 )
         {
 #ifdef DEBUG
-            dlog.addText( Logger::KICK,
-                          "__ collision current_state self_pos=(%.2f %.2f) release_pos=(%.2f %.2f) dist=%.3f",
-                          self_pos.x, self_pos.y,
-                          release_pos.x, release_pos.y,
-                          self_pos.dist( release_pos ) );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "__ collision current_state self_pos=(%.2f %.2f) release_pos=(%.2f %.2f) dist=%.3f",
+                            self_pos.x, self_pos.y,
+                            release_pos.x, release_pos.y,
+                            self_pos.dist( release_pos ) );
 #endif
             M_current_state.flag_ |= SELF_COLLISION;
         }
         else
         {
 #ifdef DEBUG
-            dlog.addText( Logger::KICK,
-                          "__ no collision with current_state" );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "__ no collision with current_state" );
 #endif
             M_current_state.flag_ &= ~SELF_COLLISION;
         }
@@ -956,25 +1670,25 @@ KickTable::checkCollisionAfterRelease( const WorldModel & world,
             if ( self_pos.dist2( release_pos ) < collide_dist2 )
             {
 #ifdef DEBUG
-                dlog.addText( Logger::KICK,
-                              "__ collision cached_state (%d) index=%d state_pos=(%.2f %.2f)"
-                              " release_pos=(%.2f %.2f) dist=%.3f",
-                              i + 1,
-                              state.index_,
-                              state.pos_.x, state.pos_.y,
-                              release_pos.x, release_pos.y,
-                              self_pos.dist( release_pos ) );
+                RCSC_DLOG_TEXT( Logger::KICK,
+                                "__ collision cached_state (%d) index=%d state_pos=(%.2f %.2f)"
+                                " release_pos=(%.2f %.2f) dist=%.3f",
+                                i + 1,
+                                state.index_,
+                                state.pos_.x, state.pos_.y,
+                                release_pos.x, release_pos.y,
+                                self_pos.dist( release_pos ) );
 #endif
                 state.flag_ |= SELF_COLLISION;
             }
             else
             {
 #ifdef DEBUG
-                dlog.addText( Logger::KICK,
-                              "__ no collision cached_state (%d) index=%d (%.2f %.2f)",
-                              i + 1,
-                              state.index_,
-                              state.pos_.x, state.pos_.y );
+                RCSC_DLOG_TEXT( Logger::KICK,
+                                "__ no collision cached_state (%d) index=%d (%.2f %.2f)",
+                                i + 1,
+                                state.index_,
+                                state.pos_.x, state.pos_.y );
 #endif
                 state.flag_ &= ~SELF_COLLISION;
             }
@@ -1018,12 +1732,12 @@ KickTable::checkInterfereAt( const WorldModel & world,
             {
                 flag |= KICKABLE;
 #ifdef DEBUG_OPPONENT
-                dlog.addText( Logger::KICK,
-                              "%d: state %d (%.2f %.2f) opp=%d(%.2f %.2f) is tackling but may collide",
-                              step, state.index_,
-                              state.pos_.x, state.pos_.y,
-                              o->unum(),
-                              o->pos().x, o->pos().y );
+                RCSC_DLOG_TEXT( Logger::KICK,
+                                "%d: state %d (%.2f %.2f) opp=%d(%.2f %.2f) is tackling but may collide",
+                                step, state.index_,
+                                state.pos_.x, state.pos_.y,
+                                o->unum(),
+                                o->pos().x, o->pos().y );
 #endif
                 break;
             }
@@ -1046,12 +1760,12 @@ KickTable::checkInterfereAt( const WorldModel & world,
         {
             flag |= KICKABLE;
 #ifdef DEBUG_OPPONENT
-            dlog.addText( Logger::KICK,
-                          "%d: state %d (%.2f %.2f) kickable opp %d(%.2f %.2f)",
-                          step, state.index_,
-                          state.pos_.x, state.pos_.y,
-                          o->unum(),
-                          o->pos().x, o->pos().y );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "%d: state %d (%.2f %.2f) kickable opp %d(%.2f %.2f)",
+                            step, state.index_,
+                            state.pos_.x, state.pos_.y,
+                            o->unum(),
+                            o->pos().x, o->pos().y );
 #endif
             break;
         }
@@ -1083,12 +1797,12 @@ KickTable::checkInterfereAt( const WorldModel & world,
                 {
                     flag |= TACKLABLE;
 #ifdef DEBUG_OPPONENT
-                    dlog.addText( Logger::KICK,
-                                  "%d: state %d (%.2f %.2f) tackle opp %d(%.1f %.1f)",
-                                  step, state.index_,
-                                  state.pos_.x, state.pos_.y,
-                                  o->unum(),
-                                  o->pos().x, o->pos().y );
+                    RCSC_DLOG_TEXT( Logger::KICK,
+                                    "%d: state %d (%.2f %.2f) tackle opp %d(%.1f %.1f)",
+                                    step, state.index_,
+                                    state.pos_.x, state.pos_.y,
+                                    o->unum(),
+                                    o->pos().x, o->pos().y );
 #endif
                 }
             }
@@ -1109,12 +1823,12 @@ KickTable::checkInterfereAt( const WorldModel & world,
         {
             flag |= NEXT_KICKABLE;
 #ifdef DEBUG_OPPONENT
-            dlog.addText( Logger::KICK,
-                          "%d: state %d (%.2f %.2f) next kickable opp %d(%.1f %.1f)",
-                          step, state.index_,
-                          state.pos_.x, state.pos_.y,
-                          o->unum(),
-                          o->pos().x, o->pos().y );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "%d: state %d (%.2f %.2f) next kickable opp %d(%.1f %.1f)",
+                            step, state.index_,
+                            state.pos_.x, state.pos_.y,
+                            o->unum(),
+                            o->pos().x, o->pos().y );
 #endif
         }
         else if ( player_2_pos.absY() < ServerParam::i().tackleWidth() * 0.7
@@ -1122,12 +1836,12 @@ KickTable::checkInterfereAt( const WorldModel & world,
                   && player_2_pos.x - max_accel < ServerParam::i().tackleDist() - 0.3 )
         {
 #ifdef DEBUG_OPPONENT
-            dlog.addText( Logger::KICK,
-                          "%d: state %d (%.2f %.2f) next tackle opp %d(%.1f %.1f)",
-                          step, state.index_,
-                          state.pos_.x, state.pos_.y,
-                          o->unum(),
-                          o->pos().x, o->pos().y );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "%d: state %d (%.2f %.2f) next tackle opp %d(%.1f %.1f)",
+                            step, state.index_,
+                            state.pos_.x, state.pos_.y,
+                            o->unum(),
+                            o->pos().x, o->pos().y );
 #endif
             flag |= NEXT_TACKLABLE;
         }
@@ -1180,12 +1894,12 @@ KickTable::checkInterfereAfterRelease( const WorldModel & world,
     ball_pos += state.pos_;
 
 #ifdef DEBUG
-    dlog.addText( Logger::KICK,
-                  "____ state %d-%d (%.2f %.2f) check release interfere. bpos=(%.2f %.2f)",
-                  cycle,
-                  state.index_,
-                  state.pos_.x, state.pos_.y,
-                  ball_pos.x, ball_pos.y );
+    RCSC_DLOG_TEXT( Logger::KICK,
+                    "____ state %d-%d (%.2f %.2f) check release interfere. bpos=(%.2f %.2f)",
+                    cycle,
+                    state.index_,
+                    state.pos_.x, state.pos_.y,
+                    ball_pos.x, ball_pos.y );
 #endif
 
     for ( const PlayerObject * o : world.opponentsFromBall() )
@@ -1208,14 +1922,14 @@ KickTable::checkInterfereAfterRelease( const WorldModel & world,
             {
                 state.flag_ |= RELEASE_INTERFERE;
 #ifdef DEBUG
-                dlog.addText( Logger::KICK,
-                              "____ state %d-%d (%.2f %.2f) opp=%d(%.1f %.1f)"
-                              " is tackling but may be collided",
-                              cycle,
-                              state.index_,
-                              state.pos_.x, state.pos_.y,
-                              o->unum(),
-                              o->pos().x, o->pos().y );
+                RCSC_DLOG_TEXT( Logger::KICK,
+                                "____ state %d-%d (%.2f %.2f) opp=%d(%.1f %.1f)"
+                                " is tackling but may be collided",
+                                cycle,
+                                state.index_,
+                                state.pos_.x, state.pos_.y,
+                                o->unum(),
+                                o->pos().x, o->pos().y );
 #endif
             }
 
@@ -1243,13 +1957,13 @@ KickTable::checkInterfereAfterRelease( const WorldModel & world,
             }
 #ifdef DEBUG
             if ( cycle <= 1 )
-            dlog.addText( Logger::KICK,
-                          "____ state %d-%d (%.2f %.2f) opp %d(%.1f %.1f) maybe interfere after release",
-                          cycle,
-                          state.index_,
-                          state.pos_.x, state.pos_.y,
-                          o->unum(),
-                          o->pos().x, o->pos().y );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "____ state %d-%d (%.2f %.2f) opp %d(%.1f %.1f) maybe interfere after release",
+                            cycle,
+                            state.index_,
+                            state.pos_.x, state.pos_.y,
+                            o->unum(),
+                            o->pos().x, o->pos().y );
 #endif
         }
 #if 1
@@ -1276,14 +1990,14 @@ KickTable::checkInterfereAfterRelease( const WorldModel & world,
                     {
                         state.flag_ |= MAYBE_RELEASE_INTERFERE;
 #ifdef DEBUG
-                        dlog.addText( Logger::KICK,
-                                      "____ state %d-%d (%.2f %.2f) opp %d(%.1f %.1f)"
-                                      "maybe tackle after release",
-                                      cycle,
-                                      state.index_,
-                                      state.pos_.x, state.pos_.y,
-                                      o->unum(),
-                                      o->pos().x, o->pos().y );
+                        RCSC_DLOG_TEXT( Logger::KICK,
+                                        "____ state %d-%d (%.2f %.2f) opp %d(%.1f %.1f)"
+                                        "maybe tackle after release",
+                                        cycle,
+                                        state.index_,
+                                        state.pos_.x, state.pos_.y,
+                                        o->unum(),
+                                        o->pos().x, o->pos().y );
 #endif
                     }
                 }
@@ -1306,14 +2020,14 @@ KickTable::checkInterfereAfterRelease( const WorldModel & world,
                 {
                     state.flag_ |= MAYBE_RELEASE_INTERFERE;
 #ifdef DEBUG
-                    dlog.addText( Logger::KICK,
-                                  "____ state %d-%d (%.2f %.2f) opp %d(%.1f %.1f)"
-                                  "maybe kickable after release, opp dash",
-                                  cycle,
-                                  state.index_,
-                                  state.pos_.x, state.pos_.y,
-                                  o->unum(),
-                                  o->pos().x, o->pos().y );
+                    RCSC_DLOG_TEXT( Logger::KICK,
+                                    "____ state %d-%d (%.2f %.2f) opp %d(%.1f %.1f)"
+                                    "maybe kickable after release, opp dash",
+                                    cycle,
+                                    state.index_,
+                                    state.pos_.x, state.pos_.y,
+                                    o->unum(),
+                                    o->pos().x, o->pos().y );
 #endif
                 }
                 else if ( player_2_pos.absY() < ServerParam::i().tackleWidth() * 0.7
@@ -1321,14 +2035,14 @@ KickTable::checkInterfereAfterRelease( const WorldModel & world,
                 {
                     state.flag_ |= MAYBE_RELEASE_INTERFERE;
 #ifdef DEBUG
-                    dlog.addText( Logger::KICK,
-                                  "____ state %d-%d (%.2f %.2f) opp %d(%.1f %.1f)"
-                                  "maybe tackle after release, opp dash",
-                                  cycle,
-                                  state.index_,
-                                  state.pos_.x, state.pos_.y,
-                                  o->unum(),
-                                  o->pos().x, o->pos().y );
+                    RCSC_DLOG_TEXT( Logger::KICK,
+                                    "____ state %d-%d (%.2f %.2f) opp %d(%.1f %.1f)"
+                                    "maybe tackle after release, opp dash",
+                                    cycle,
+                                    state.index_,
+                                    state.pos_.x, state.pos_.y,
+                                    o->unum(),
+                                    o->pos().x, o->pos().y );
 #endif
                 }
             }
@@ -1349,8 +2063,8 @@ KickTable::simulateOneStep( const WorldModel & world,
     if ( M_current_state.flag_ & SELF_COLLISION )
     {
 #ifdef DEBUG_ONE_STEP
-        dlog.addText( Logger::KICK,
-                      "xx__ 1 step: self collision" );
+        RCSC_DLOG_TEXT( Logger::KICK,
+                        "xx__ 1 step: self collision" );
 #endif
         return false;
     }
@@ -1358,8 +2072,8 @@ KickTable::simulateOneStep( const WorldModel & world,
     if ( M_current_state.flag_ & RELEASE_INTERFERE )
     {
 #ifdef DEBUG_ONE_STEP
-        dlog.addText( Logger::KICK,
-                      "xx__ 1 step: opponent can interfere after release" );
+        RCSC_DLOG_TEXT( Logger::KICK,
+                        "xx__ 1 step: opponent can interfere after release" );
 #endif
         return false;
     }
@@ -1374,9 +2088,9 @@ KickTable::simulateOneStep( const WorldModel & world,
     if ( accel_r > current_max_accel )
     {
 #ifdef DEBUG_ONE_STEP
-        dlog.addText( Logger::KICK,
-                      "xx__ 1 step: failed. max_vel=required_accel=%f > max_accel=%f",
-                      accel_r, current_max_accel );
+        RCSC_DLOG_TEXT( Logger::KICK,
+                        "xx__ 1 step: failed. max_vel=required_accel=%f > max_accel=%f",
+                        accel_r, current_max_accel );
 #endif
         Vector2D max_vel = calc_max_velocity( target_vel.th(),
                                               M_current_state.kick_rate_,
@@ -1398,15 +2112,15 @@ KickTable::simulateOneStep( const WorldModel & world,
     M_candidates.back().speed_ = first_speed;
     M_candidates.back().power_ = accel_r / M_current_state.kick_rate_;
 #ifdef DEBUG_ONE_STEP
-    dlog.addText( Logger::KICK,
-                  "ok__ 1 step: target_vel=(%.2f %.2f)%.3f required_accel=%.3f < max_accel=%.3f"
-                  " kick_rate=%f power=%.1f",
-                  target_vel.x, target_vel.y,
-                  first_speed,
-                  accel_r,
-                  current_max_accel,
-                  M_current_state.kick_rate_,
-                  M_candidates.back().power_ );
+    RCSC_DLOG_TEXT( Logger::KICK,
+                    "ok__ 1 step: target_vel=(%.2f %.2f)%.3f required_accel=%.3f < max_accel=%.3f"
+                    " kick_rate=%f power=%.1f",
+                    target_vel.x, target_vel.y,
+                    first_speed,
+                    accel_r,
+                    current_max_accel,
+                    M_current_state.kick_rate_,
+                    M_candidates.back().power_ );
 #endif
     return true;
 }
@@ -1420,28 +2134,51 @@ KickTable::simulateTwoStep( const WorldModel & world,
                             const Vector2D & target_point,
                             const double first_speed )
 {
-    static const double max_power = ServerParam::i().maxPower();
-    static const double accel_max = ServerParam::i().ballAccelMax();
-    static const double ball_decay = ServerParam::i().ballDecay();
+    if ( ServerParam::i().isStandardProfile() )
+    {
+        return simulateTwoStepImpl< StandardServerParamProfile >( world, target_point, first_speed );
+    }
+
+    return simulateTwoStepImpl< RuntimeServerParamProfile >( world, target_point, first_speed );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+template < typename SP >
+bool
+KickTable::simulateTwoStepImpl( const WorldModel & world,
+                                const Vector2D & target_point,
+                                const double first_speed )
+{
+    const double max_power = SP::maxPower();
+    const double accel_max = SP::ballAccelMax();
+    const double ball_decay = SP::ballDecay();
 
     const PlayerType & self_type = world.self().playerType();
     const double current_max_accel = std::min( M_current_state.kick_rate_ * max_power, accel_max );
 
-    const ServerParam & param = ServerParam::i();
     const double my_kickable_area = self_type.kickableArea();
 
-    const double my_noise = world.self().vel().r() * param.playerRand();
+    const double my_noise = world.self().vel().r() * SP::playerRand();
     const double current_dir_diff_rate
         = ( world.ball().angleFromSelf() - world.self().body() ).abs() / 180.0;
     const double current_dist_rate = ( ( world.ball().distFromSelf()
                                          - self_type.playerSize()
-                                         - param.ballSize() )
+                                         - SP::ballSize() )
                                        / self_type.kickableMargin() );
     const double current_pos_rate
         = 0.5 + 0.25 * ( current_dir_diff_rate + current_dist_rate );
     const double current_speed_rate
         = 0.5 + 0.5 * ( world.ball().vel().r()
-                        / ( param.ballSpeedMax() * param.ballDecay() ) );
+                        / ( SP::ballSpeedMax() * SP::ballDecay() ) );
+
+    if ( M_pruning
+         && score_upper_bound( 2, M_current_state.flag_ & ~RELEASE_INTERFERE ) <= M_best_score )
+    {
+        return false;
+    }
 
     int success_count = 0;
     double max_speed2 = 0.0;
@@ -1454,9 +2191,9 @@ KickTable::simulateTwoStep( const WorldModel & world,
         if ( state.flag_ & OUT_OF_PITCH )
         {
 #ifdef DEBUG_TWO_STEP
-            dlog.addText( Logger::KICK,
-                          "%d: xx__ 2 step: skip. out of pitch. state_pos=(%.2f %.2f)",
-                          count, state.pos_.x, state.pos_.y );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "%d: xx__ 2 step: skip. out of pitch. state_pos=(%.2f %.2f)",
+                            count, state.pos_.x, state.pos_.y );
 #endif
             continue;
         }
@@ -1464,9 +2201,9 @@ KickTable::simulateTwoStep( const WorldModel & world,
         if ( state.flag_ & KICKABLE )
         {
 #ifdef DEBUG_TWO_STEP
-            dlog.addText( Logger::KICK,
-                          "%d: xx__ 2 step: skip. exist kicable opp. state_pos=(%.2f %.2f)",
-                          count, state.pos_.x, state.pos_.y );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "%d: xx__ 2 step: skip. exist kicable opp. state_pos=(%.2f %.2f)",
+                            count, state.pos_.x, state.pos_.y );
 #endif
             continue;
         }
@@ -1474,9 +2211,9 @@ KickTable::simulateTwoStep( const WorldModel & world,
         if ( state.flag_ & SELF_COLLISION )
         {
 #ifdef DEBUG_TWO_STEP
-            dlog.addText( Logger::KICK,
-                          "%d: xx__ 2 step: skip. self collision. state_pos=(%.2f %.2f)",
-                          count, state.pos_.x, state.pos_.y );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "%d: xx__ 2 step: skip. self collision. state_pos=(%.2f %.2f)",
+                            count, state.pos_.x, state.pos_.y );
 #endif
             continue;
         }
@@ -1484,9 +2221,9 @@ KickTable::simulateTwoStep( const WorldModel & world,
         if ( state.flag_ & RELEASE_INTERFERE )
         {
 #ifdef DEBUG_TWO_STEP
-            dlog.addText( Logger::KICK,
-                          "%d: xx__ 2 step: interfere after release. state_pos=(%.2f %.2f)",
-                          count, state.pos_.x, state.pos_.y );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "%d: xx__ 2 step: interfere after release. state_pos=(%.2f %.2f)",
+                            count, state.pos_.x, state.pos_.y );
 #endif
             //return false;
             continue;
@@ -1498,6 +2235,15 @@ KickTable::simulateTwoStep( const WorldModel & world,
             continue;
         }
 
+        // the failed sequence never exceeds the successful one.
+        const bool prune_failure = ( M_pruning && FAILED_SCORE_BOUND <= M_best_score );
+        if ( prune_failure
+             && score_upper_bound( 2, ( ( M_current_state.flag_ & ~RELEASE_INTERFERE )
+                                        | state.flag_ ) ) <= M_best_score )
+        {
+            continue;
+        }
+
         int kick_miss_flag = SAFETY;
         const Vector2D target_vel = ( target_point - state.pos_ ).setLengthVector( first_speed );
 
@@ -1508,31 +2254,31 @@ KickTable::simulateTwoStep( const WorldModel & world,
         if ( accel_r > current_max_accel )
         {
 #ifdef DEBUG_TWO_STEP
-            dlog.addText( Logger::KICK,
-                          "%d: xx__ 2 step: failed(1) required_accel=%.3f > max_accel=%.3f",
-                          count, accel_r, current_max_accel );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "%d: xx__ 2 step: failed(1) required_accel=%.3f > max_accel=%.3f",
+                            count, accel_r, current_max_accel );
 #endif
             continue;
         }
         {
             double kick_power = accel_r / world.self().kickRate();
-            double ball_noise = vel.r() * param.ballRand();
+            double ball_noise = vel.r() * SP::ballRand();
             double max_kick_rand
                 = self_type.kickRand()
-                * ( kick_power / param.maxPower() )
+                * ( kick_power / SP::maxPower() )
                 * ( current_pos_rate + current_speed_rate );
             if ( ( my_noise + ball_noise + max_kick_rand ) //* 0.9
                  > my_kickable_area - state.dist_ - 0.05 ) //0.1 )
             {
 #ifdef DEBUG_TWO_STEP
-                dlog.addText( Logger::KICK,
-                              "%d: xx__ 2 step: failed. buffer is not safety. power=%.3f"
-                              " my_kickable=%.3f state_dist=%.3f,"
-                              " noise=%f(my_noise=%f ball_noise=%f kick_rand=%f)",
-                              count, kick_power,
-                              my_kickable_area, state.dist_,
-                              ( my_noise + ball_noise + max_kick_rand ) * 0.9,
-                              my_noise, ball_noise, max_kick_rand );
+                RCSC_DLOG_TEXT( Logger::KICK,
+                                "%d: xx__ 2 step: failed. buffer is not safety. power=%.3f"
+                                " my_kickable=%.3f state_dist=%.3f,"
+                                " noise=%f(my_noise=%f ball_noise=%f kick_rand=%f)",
+                                count, kick_power,
+                                my_kickable_area, state.dist_,
+                                ( my_noise + ball_noise + max_kick_rand ) * 0.9,
+                                my_noise, ball_noise, max_kick_rand );
 #endif
                 kick_miss_flag |= KICK_MISS_POSSIBILITY;
                 // if ( ! M_use_risky_node )
@@ -1550,11 +2296,12 @@ KickTable::simulateTwoStep( const WorldModel & world,
         if ( accel_r > std::min( state.kick_rate_ * max_power, accel_max ) )
         {
 #ifdef DEBUG_TWO_STEP
-            dlog.addText( Logger::KICK,
-                          "%d: xx__ 2step: failed(2) required_accel=%.3f > max_accel=%.3f",
-                          count, accel_r, std::min( state.kick_rate_ * max_power, accel_max ) );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "%d: xx__ 2step: failed(2) required_accel=%.3f > max_accel=%.3f",
+                            count, accel_r, std::min( state.kick_rate_ * max_power, accel_max ) );
 #endif
-            if ( success_count == 0 )
+            if ( success_count == 0
+                 && ! prune_failure )
             {
                 Vector2D max_vel = calc_max_velocity( target_vel.th(),
                                                       state.kick_rate_,
@@ -1578,10 +2325,10 @@ KickTable::simulateTwoStep( const WorldModel & world,
                     M_candidates.back().speed_ = std::sqrt( max_speed2 );
                     M_candidates.back().power_ = accel.r() / state.kick_rate_;
 #ifdef DEBUG_TWO_STEP
-                    dlog.addText( Logger::KICK,
-                                  "%d: ____ update max vel (%.2f %.2f) %.3f",
-                                  count, max_vel.x, max_vel.y,
-                                  M_candidates.back().speed_ );
+                    RCSC_DLOG_TEXT( Logger::KICK,
+                                    "%d: ____ update max vel (%.2f %.2f) %.3f",
+                                    count, max_vel.x, max_vel.y,
+                                    M_candidates.back().speed_ );
 #endif
                 }
             }
@@ -1597,11 +2344,16 @@ KickTable::simulateTwoStep( const WorldModel & world,
         M_candidates.back().pos_list_.push_back( state.pos_ + target_vel );
         M_candidates.back().speed_ = first_speed;
         M_candidates.back().power_ = accel_r / state.kick_rate_;
+        if ( M_pruning )
+        {
+            M_best_score = std::max( M_best_score,
+                                     sequence_score( M_candidates.back(), first_speed, first_speed ) );
+        }
 #ifdef DEBUG_TWO_STEP
-        dlog.addText( Logger::KICK,
-                      "%d: ok__ 2 step: last_power=%.2f subtarget=(%.2f %.2f)",
-                      count, M_candidates.back().power_,
-                      state.pos_.x, state.pos_.y );
+        RCSC_DLOG_TEXT( Logger::KICK,
+                        "%d: ok__ 2 step: last_power=%.2f subtarget=(%.2f %.2f)",
+                        count, M_candidates.back().power_,
+                        state.pos_.x, state.pos_.y );
 #endif
     }
 
@@ -1617,32 +2369,49 @@ KickTable::simulateThreeStep( const WorldModel & world,
                               const Vector2D & target_point,
                               const double first_speed )
 {
-    static const double max_power = ServerParam::i().maxPower();
-    static const double accel_max = ServerParam::i().ballAccelMax();
-    static const double ball_decay = ServerParam::i().ballDecay();
+    if ( ServerParam::i().isStandardProfile() )
+    {
+        return simulateThreeStepImpl< StandardServerParamProfile >( world, target_point, first_speed );
+    }
+
+    return simulateThreeStepImpl< RuntimeServerParamProfile >( world, target_point, first_speed );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+template < typename SP >
+bool
+KickTable::simulateThreeStepImpl( const WorldModel & world,
+                                  const Vector2D & target_point,
+                                  const double first_speed )
+{
+    const double max_power = SP::maxPower();
+    const double accel_max = SP::ballAccelMax();
+    const double ball_decay = SP::ballDecay();
 
     const double current_max_accel = std::min( M_current_state.kick_rate_ * max_power,
                                                accel_max );
     const double current_max_accel2 = current_max_accel * current_max_accel;
 #if 1
-    const ServerParam & param = ServerParam::i();
     const PlayerType & self_type = world.self().playerType();
 
     const double my_kickable_area = self_type.kickableArea();
 
-    const double my_noise1 = world.self().vel().r() * param.playerRand();
+    const double my_noise1 = world.self().vel().r() * SP::playerRand();
     //const double my_noise2 = my_noise1 * self_type.playerDecay();
     const double current_dir_diff_rate
         = ( world.ball().angleFromSelf() - world.self().body() ).abs() / 180.0;
     const double current_dist_rate = ( ( world.ball().distFromSelf()
                                          - self_type.playerSize()
-                                         - param.ballSize() )
+                                         - SP::ballSize() )
                                        / self_type.kickableMargin() );
     const double current_pos_rate
         = 0.5 + 0.25 * ( current_dir_diff_rate + current_dist_rate );
     const double current_speed_rate
         = 0.5 + 0.5 * ( world.ball().vel().r()
-                        / ( param.ballSpeedMax() * param.ballDecay() ) );
+                        / ( SP::ballSpeedMax() * SP::ballDecay() ) );
 #endif
     AngleDeg target_rel_angle = ( target_point - world.self().pos() ).th() - world.self().body();
     double angle_deg = target_rel_angle.degree() + 180.0;
@@ -1650,30 +2419,46 @@ KickTable::simulateThreeStep( const WorldModel & world,
     if ( target_angle_index >= DEST_DIR_DIVS ) target_angle_index = 0;
 
 #ifdef DEBUG
-    dlog.addText( Logger::KICK,
-                  "(KickTable::simulateThreeStep) target angle index = %d ",
-                  target_angle_index );
+    RCSC_DLOG_TEXT( Logger::KICK,
+                    "(KickTable::simulateThreeStep) target angle index = %d ",
+                    target_angle_index );
 #endif
 
-    const std::vector< Path > & table = M_tables[target_angle_index];
+    if ( M_pruning
+         && score_upper_bound( 3, M_current_state.flag_ & ~RELEASE_INTERFERE ) <= M_best_score )
+    {
+        return false;
+    }
+
+    const Path * const table = M_table_data[target_angle_index];
 
     int success_count = 0;
     double max_speed2 = 0.0;
 
     size_t count = 0;
-    for ( std::vector< Path >::const_iterator it = table.begin(), end = table.end();
+    for ( const Path * it = table, * end = table + M_table_size[target_angle_index];
           it != end && count < MAX_TABLE_SIZE && success_count <= 10;
           ++it, ++count )
     {
+        // the failed sequence never exceeds the successful one.
+        const bool prune_failure = ( M_pruning && FAILED_SCORE_BOUND <= M_best_score );
+        if ( prune_failure
+             && it->max_speed_ < first_speed - PRUNE_SPEED_MARGIN )
+        {
+            // the table is sorted by max_speed_.
+            // the remaining paths are not expected to reach the required speed.
+            break;
+        }
+
         const State & state_1st = M_state_cache[0][it->origin_];
         const State & state_2nd = M_state_cache[1][it->dest_];
 
         if ( state_1st.flag_ & OUT_OF_PITCH )
         {
 #ifdef DEBUG_THREE_STEP_DETAIL
-            dlog.addText( Logger::KICK,
-                          "%zd: xx__ 3 step: skip. out of pitch. state_1st pos=(%.2f %.2f)",
-                          count, state_1st.pos_.x, state_1st.pos_.y );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "%zd: xx__ 3 step: skip. out of pitch. state_1st pos=(%.2f %.2f)",
+                            count, state_1st.pos_.x, state_1st.pos_.y );
 #endif
             continue;
         }
@@ -1681,9 +2466,9 @@ KickTable::simulateThreeStep( const WorldModel & world,
         if ( state_2nd.flag_ & OUT_OF_PITCH )
         {
 #ifdef DEBUG_THREE_STEP_DETAIL
-            dlog.addText( Logger::KICK,
-                          "%zd: xx__ 3 step: skip. out of pitch. state_2nd pos=(%.2f %.2f)",
-                          count, state_2nd.pos_.x, state_2nd.pos_.y );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "%zd: xx__ 3 step: skip. out of pitch. state_2nd pos=(%.2f %.2f)",
+                            count, state_2nd.pos_.x, state_2nd.pos_.y );
 #endif
             continue;
         }
@@ -1691,9 +2476,9 @@ KickTable::simulateThreeStep( const WorldModel & world,
         if ( state_1st.flag_ & KICKABLE )
         {
 #ifdef DEBUG_THREE_STEP_DETAIL
-            dlog.addText( Logger::KICK,
-                          "%zd: xx__ 3 step: skip. exist kicable opp. state_1st pos=(%.2f %.2f)",
-                          count, state_1st.pos_.x, state_1st.pos_.y );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "%zd: xx__ 3 step: skip. exist kicable opp. state_1st pos=(%.2f %.2f)",
+                            count, state_1st.pos_.x, state_1st.pos_.y );
 #endif
             continue;
         }
@@ -1701,9 +2486,9 @@ KickTable::simulateThreeStep( const WorldModel & world,
         if ( state_2nd.flag_ & KICKABLE )
         {
 #ifdef DEBUG_THREE_STEP_DETAIL
-            dlog.addText( Logger::KICK,
-                          "%zd: xx__ 3 step: skip. exist kicable opp. state_2nd pos=(%.2f %.2f)",
-                          count, state_2nd.pos_.x, state_2nd.pos_.y );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "%zd: xx__ 3 step: skip. exist kicable opp. state_2nd pos=(%.2f %.2f)",
+                            count, state_2nd.pos_.x, state_2nd.pos_.y );
 #endif
             continue;
         }
@@ -1711,9 +2496,9 @@ KickTable::simulateThreeStep( const WorldModel & world,
         if ( state_2nd.flag_ & SELF_COLLISION )
         {
 #ifdef DEBUG_THREE_STEP_DETAIL
-            dlog.addText( Logger::KICK,
-                          "%zd: xx__ 3 step: skip. self collision. state_2nd_pos=(%.2f %.2f)",
-                          count, state_2nd.pos_.x, state_2nd.pos_.y );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "%zd: xx__ 3 step: skip. self collision. state_2nd_pos=(%.2f %.2f)",
+                            count, state_2nd.pos_.x, state_2nd.pos_.y );
 #endif
             continue;
         }
@@ -1721,9 +2506,9 @@ KickTable::simulateThreeStep( const WorldModel & world,
         if ( state_2nd.flag_ & RELEASE_INTERFERE )
         {
 #ifdef DEBUG_THREE_STEP_DETAIL
-            dlog.addText( Logger::KICK,
-                          "%zd: xx__ 3 step: interfere after release. state_pos=(%.2f %.2f)",
-                          count, state_2nd.pos_.x, state_2nd.pos_.y );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "%zd: xx__ 3 step: interfere after release. state_pos=(%.2f %.2f)",
+                            count, state_2nd.pos_.x, state_2nd.pos_.y );
 #endif
             //return false;
             continue;
@@ -1737,6 +2522,14 @@ KickTable::simulateThreeStep( const WorldModel & world,
             continue;
         }
 
+        if ( prune_failure
+             && score_upper_bound( 3, ( ( M_current_state.flag_ & ~RELEASE_INTERFERE )
+                                        | ( state_1st.flag_ & ~RELEASE_INTERFERE )
+                                        | state_2nd.flag_ ) ) <= M_best_score )
+        {
+            continue;
+        }
+
         const Vector2D target_vel = ( target_point - state_2nd.pos_ ).setLengthVector( first_speed );
 
         int kick_miss_flag = SAFETY;
@@ -1748,9 +2541,9 @@ KickTable::simulateThreeStep( const WorldModel & world,
         if ( accel_r2 > current_max_accel2 )
         {
 #ifdef DEBUG_THREE_STEP_DETAIL
-            dlog.addText( Logger::KICK,
-                          "%zd: xx__ 3 step: failed(1) required_accel=%.3f > max_accel=%.3f",
-                          count, std::sqrt( accel_r2 ), std::sqrt( current_max_accel2 ) );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "%zd: xx__ 3 step: failed(1) required_accel=%.3f > max_accel=%.3f",
+                            count, std::sqrt( accel_r2 ), std::sqrt( current_max_accel2 ) );
 #endif
             continue;
         }
@@ -1758,24 +2551,24 @@ KickTable::simulateThreeStep( const WorldModel & world,
 #if 1
         {
             double kick_power = std::sqrt( accel_r2 ) / world.self().kickRate();
-            double ball_noise = vel1.r() * param.ballRand();
+            double ball_noise = vel1.r() * SP::ballRand();
             double max_kick_rand
                 = self_type.kickRand()
-                * ( kick_power / param.maxPower() )
+                * ( kick_power / SP::maxPower() )
                 * ( current_pos_rate + current_speed_rate );
             if ( ( my_noise1 + ball_noise + max_kick_rand )
                  > my_kickable_area - state_1st.dist_ - 0.1 )
             {
 #ifdef DEBUG_THREE_STEP
-                dlog.addText( Logger::KICK,
-                              "%zd: xx__ 3 step: 1st kick may cause unkickable. power=%.3f"
-                              " my_kickable=%.3f state_dist=%.3f,"
-                              " noise=%f(my_noise=%f ball_noise=%f kick_rand=%f)",
-                              count,
-                              kick_power,
-                              my_kickable_area, state_1st.dist_,
-                              ( my_noise1 + ball_noise + max_kick_rand ) * 0.9,
-                              my_noise1, ball_noise, max_kick_rand );
+                RCSC_DLOG_TEXT( Logger::KICK,
+                                "%zd: xx__ 3 step: 1st kick may cause unkickable. power=%.3f"
+                                " my_kickable=%.3f state_dist=%.3f,"
+                                " noise=%f(my_noise=%f ball_noise=%f kick_rand=%f)",
+                                count,
+                                kick_power,
+                                my_kickable_area, state_1st.dist_,
+                                ( my_noise1 + ball_noise + max_kick_rand ) * 0.9,
+                                my_noise1, ball_noise, max_kick_rand );
 #endif
                 kick_miss_flag |= KICK_MISS_POSSIBILITY;
                 // if ( ! M_use_risky_node )
@@ -1795,11 +2588,11 @@ KickTable::simulateThreeStep( const WorldModel & world,
         if ( accel_r2 > square( std::min( state_1st.kick_rate_ * max_power * 0.9, accel_max ) ) )
         {
 #ifdef DEBUG_THREE_STEP_DETAIL
-            dlog.addText( Logger::KICK,
-                          "%zd: xx__ 3 step: failed(2) required_accel=%.3f > max_accel=%.3f",
-                          count,
-                          std::sqrt( accel_r2 ),
-                          std::min( state_1st.kick_rate_ * max_power, accel_max ) );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "%zd: xx__ 3 step: failed(2) required_accel=%.3f > max_accel=%.3f",
+                            count,
+                            std::sqrt( accel_r2 ),
+                            std::min( state_1st.kick_rate_ * max_power, accel_max ) );
 #endif
             continue;
         }
@@ -1810,12 +2603,13 @@ KickTable::simulateThreeStep( const WorldModel & world,
         if ( accel_r2 > square( std::min( state_2nd.kick_rate_ * max_power, accel_max ) ) )
         {
 #ifdef DEBUG_THREE_STEP_DETAIL
-            dlog.addText( Logger::KICK,
-                          "xx__ 3 step: failed(3) required_accel=%.3f > max_accel=%.3f",
-                          std::sqrt( accel_r2 ),
-                          std::min( state_2nd.kick_rate_ * max_power, accel_max ) );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "xx__ 3 step: failed(3) required_accel=%.3f > max_accel=%.3f",
+                            std::sqrt( accel_r2 ),
+                            std::min( state_2nd.kick_rate_ * max_power, accel_max ) );
 #endif
-            if ( success_count == 0 )
+            if ( success_count == 0
+                 && ! prune_failure )
             {
                 Vector2D max_vel = calc_max_velocity( target_vel.th(),
                                                       state_2nd.kick_rate_,
@@ -1842,10 +2636,10 @@ KickTable::simulateThreeStep( const WorldModel & world,
                     M_candidates.back().power_ = accel.r() / state_2nd.kick_rate_;
 
 #ifdef DEBUG_THREE_STEP
-                    dlog.addText( Logger::KICK,
-                                  "____ update max vel (%.2f %.2f) %.3f",
-                                  max_vel.x, max_vel.y,
-                                  M_candidates.back().speed_ );
+                    RCSC_DLOG_TEXT( Logger::KICK,
+                                    "____ update max vel (%.2f %.2f) %.3f",
+                                    max_vel.x, max_vel.y,
+                                    M_candidates.back().speed_ );
 #endif
                 }
             }
@@ -1863,27 +2657,32 @@ KickTable::simulateThreeStep( const WorldModel & world,
         M_candidates.back().pos_list_.push_back( state_2nd.pos_ + target_vel );
         M_candidates.back().speed_ = first_speed;
         M_candidates.back().power_ = std::sqrt( accel_r2 ) / state_2nd.kick_rate_;
+        if ( M_pruning )
+        {
+            M_best_score = std::max( M_best_score,
+                                     sequence_score( M_candidates.back(), first_speed, first_speed ) );
+        }
 
 #ifdef DEBUG_THREE_STEP
-        dlog.addText( Logger::KICK,
-                      "%zd: ok__ 3 step: last_power=%.2f sub1=(%.2f %.2f) sub2(%.2f %.2f)",
-                      count,
-                      M_candidates.back().power_,
-                      state_1st.pos_.x, state_1st.pos_.y,
-                      state_2nd.pos_.x, state_2nd.pos_.y );
+        RCSC_DLOG_TEXT( Logger::KICK,
+                        "%zd: ok__ 3 step: last_power=%.2f sub1=(%.2f %.2f) sub2(%.2f %.2f)",
+                        count,
+                        M_candidates.back().power_,
+                        state_1st.pos_.x, state_1st.pos_.y,
+                        state_2nd.pos_.x, state_2nd.pos_.y );
 #endif
         ++success_count;
     }
 
 #ifdef DEBUG_THREE_STEP
-    dlog.addText( Logger::KICK,
-                  "simulateThreeKick() solution_size=%d",
-                  success_count );
+    RCSC_DLOG_TEXT( Logger::KICK,
+                    "simulateThreeKick() solution_size=%d",
+                    success_count );
     if ( success_count == 0 )
     {
-        dlog.addText( Logger::KICK,
-                      "simulateThreeKick() max_speed=%.3f",
-                      std::sqrt( max_speed2 ) );
+        RCSC_DLOG_TEXT( Logger::KICK,
+                        "simulateThreeKick() max_speed=%.3f",
+                        std::sqrt( max_speed2 ) );
     }
 #endif
 
@@ -1899,97 +2698,57 @@ KickTable::evaluate( const WorldModel & wm,
                      const double first_speed,
                      const double allowable_speed )
 {
-    dlog.addText( Logger::KICK,
-                  "(KickTable::evaluate) candidate size=%zd",
-                  M_candidates.size() );
+    RCSC_DLOG_TEXT( Logger::KICK,
+                    "(KickTable::evaluate) candidate size=%zd",
+                    M_candidates.size() );
 
 #ifndef DEBUG_PRINT_EVALUATE
     (void)wm;
 #endif
 
-    const double power_thr1 = ServerParam::i().maxPower() * 0.94;
-    const double power_thr2 = ServerParam::i().maxPower() * 0.9;
-
     int count = 0;
     for ( Sequence & seq : M_candidates )
     {
         ++count;
 
-        const int n_kick = seq.pos_list_.size();
-
-        seq.score_ = 1000.0;
-
-        if ( seq.speed_ < first_speed )
-        {
-            if ( n_kick > 1
-                 || seq.speed_ < allowable_speed )
-            {
-                seq.score_ = -10000.0;
-                seq.score_ -= ( first_speed - seq.speed_ ) * 100000.0;
-            }
-            else
-            {
-                seq.score_ -= 50.0;
-            }
-        }
-
-        if ( seq.flag_ & TACKLABLE ) seq.score_ -= 500.0;
-
-        if ( seq.flag_ & NEXT_TACKLABLE ) seq.score_ -= 300.0;
+        seq.score_ = sequence_score( seq, first_speed, allowable_speed );
 
-        if ( seq.flag_ & NEXT_KICKABLE ) seq.score_ -= 600.0;
-
-        if ( seq.flag_ & MAYBE_RELEASE_INTERFERE )
+#ifdef DEBUG_EVALUATE
+        const int n_kick = seq.pos_list_.size();
+        if ( seq.flag_ & KICK_MISS_POSSIBILITY )
         {
-            if ( n_kick == 1 )
-            {
-                seq.score_ -= 250.0;
-            }
-            else
-            {
-                seq.score_ -= 200.0;
-            }
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "%d: (eval) %d maybe kick failure flag=%x n_kick=%d speed=%.3f last_kick_power=%f",
+                            count, seq.index_, seq.flag_, n_kick, seq.speed_, seq.power_ );
         }
+        RCSC_DLOG_TEXT( Logger::KICK,
+                        "%d: (eval) %d score %.2f flag=%x n_kick=%d speed=%.3f last_kick_power=%f",
+                        count, seq.index_, seq.score_, seq.flag_, n_kick, seq.speed_, seq.power_ );
 
-        if ( n_kick == 3 )
-        {
-            seq.score_ -= 200.0;
-        }
-        else if ( n_kick == 2 )
-        {
-            seq.score_ -= 50.0;
-        }
+        //if ( count == 4 ) debug_print_sequence( wm, *it );
+#endif
+    }
+}
 
-        if ( n_kick > 1 )
-        {
-            if ( seq.power_ > power_thr1 )
-            {
-                seq.score_ -= 75.0;
-            }
-            else if ( seq.power_ > power_thr2 )
-            {
-                seq.score_ -= 25.0;
-            }
-        }
+/*-------------------------------------------------------------------*/
+/*!
 
-        seq.score_ -= seq.power_ * 0.5;
+ */
+void
+KickTable::updateBestScore( const double first_speed,
+                            const double allowable_speed )
+{
+    M_best_score = -std::numeric_limits< double >::max();
 
-        if ( seq.flag_ & KICK_MISS_POSSIBILITY )
-        {
-            seq.score_ -= 30.0;
-#ifdef DEBUG_EVALUATE
-            dlog.addText( Logger::KICK,
-                          "%d: (eval) %d maybe kick failure flag=%x n_kick=%d speed=%.3f last_kick_power=%f",
-                          count, seq.index_, seq.flag_, n_kick, seq.speed_, seq.power_ );
-#endif
-        }
-#ifdef DEBUG_EVALUATE
-        dlog.addText( Logger::KICK,
-                      "%d: (eval) %d score %.2f flag=%x n_kick=%d speed=%.3f last_kick_power=%f",
-                      count, seq.index_, seq.score_, seq.flag_, n_kick, seq.speed_, seq.power_ );
+    if ( ! M_pruning )
+    {
+        return;
+    }
 
-        //if ( count == 4 ) debug_print_sequence( wm, *it );
-#endif
+    for ( const Sequence & seq : M_candidates )
+    {
+        M_best_score = std::max( M_best_score,
+                                 sequence_score( seq, first_speed, allowable_speed ) );
     }
 }
 
@@ -2056,6 +2815,105 @@ KickTable::debugPrintSequence( const WorldModel & wm,
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+KickTable::setMemoCapacity( const std::size_t capacity )
+{
+    M_memo_capacity = capacity;
+    M_memo.clear();
+    M_memo.reserve( capacity );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+KickTable::MemoKey
+KickTable::create_memo_key( const WorldModel & world,
+                            const Vector2D & target_point,
+                            const double first_speed,
+                            const double allowable_speed,
+                            const int max_step )
+{
+    const Vector2D target_rel = target_point - world.ball().pos();
+
+    MemoKey key;
+    key.ball_x_ = static_cast< int >( rint( world.ball().rpos().x / MEMO_POS_STEP ) );
+    key.ball_y_ = static_cast< int >( rint( world.ball().rpos().y / MEMO_POS_STEP ) );
+    key.target_dir_ = static_cast< int >( rint( target_rel.th().degree() / MEMO_DIR_STEP ) );
+    key.target_dist_ = static_cast< int >( rint( std::min( target_rel.r(), 1000.0 ) / MEMO_DIST_STEP ) );
+    key.first_speed_ = static_cast< int >( rint( first_speed / MEMO_SPEED_STEP ) );
+    key.allowable_speed_ = static_cast< int >( rint( allowable_speed / MEMO_SPEED_STEP ) );
+    key.max_step_ = max_step;
+
+    return key;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const KickTable::MemoEntry *
+KickTable::findMemo( const WorldModel & world,
+                     const MemoKey & key )
+{
+    if ( M_memo_time != world.time() )
+    {
+        M_memo_time = world.time();
+        M_memo.clear();
+        return nullptr;
+    }
+
+    for ( MemoEntry & e : M_memo )
+    {
+        if ( e.key_.equals( key ) )
+        {
+            e.stamp_ = ++M_memo_stamp;
+            return &e;
+        }
+    }
+
+    return nullptr;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+KickTable::addMemo( const MemoKey & key,
+                    const bool result,
+                    const Sequence & sequence )
+{
+    if ( M_memo_capacity == 0 )
+    {
+        return;
+    }
+
+    MemoEntry * entry = nullptr;
+    if ( M_memo.size() < M_memo_capacity )
+    {
+        M_memo.emplace_back();
+        entry = &M_memo.back();
+    }
+    else
+    {
+        entry = &*std::min_element( M_memo.begin(), M_memo.end(),
+                                    []( const MemoEntry & lhs, const MemoEntry & rhs )
+                                      {
+                                          return lhs.stamp_ < rhs.stamp_;
+                                      } );
+    }
+
+    entry->key_ = key;
+    entry->stamp_ = ++M_memo_stamp;
+    entry->result_ = result;
+    entry->sequence_ = sequence;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -2072,8 +2930,8 @@ check_candidates_max_speed( const std::vector< KickTable::Sequence > & candidate
             // dlog.addText( Logger::KICK,
             //               "(KickTable::check_candidate) OK %d speed=%.3f  thr=%.3f",
             //               seq.index_, seq.speed_, speed_thr );
-            dlog.addText( Logger::KICK,
-                          "(KickTable::check_candidate) OK found" );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "(KickTable::check_candidate) OK found" );
             return true;
         }
         // dlog.addText( Logger::KICK,
@@ -2081,8 +2939,8 @@ check_candidates_max_speed( const std::vector< KickTable::Sequence > & candidate
         //               seq.index_, seq.speed_, speed_thr );
     }
 
-    dlog.addText( Logger::KICK,
-                  "(KickTable::check_candidate) NG not found" );
+    RCSC_DLOG_TEXT( Logger::KICK,
+                    "(KickTable::check_candidate) NG not found" );
     return false;
 }
 
@@ -2102,8 +2960,8 @@ KickTable::simulate( const WorldModel & world,
 {
     if ( M_state_list.empty() )
     {
-        dlog.addText( Logger::KICK,
-                      "(KickTable::simulate) KickTable is not initialized!." );
+        RCSC_DLOG_TEXT( Logger::KICK,
+                        "(KickTable::simulate) KickTable is not initialized!." );
         std::cerr << "KickTable has not been initialized! "
                   << "KickTable::instance().createTable() has to be called before using KickTable::simulate()."
                   << std::endl;
@@ -2121,10 +2979,24 @@ KickTable::simulate( const WorldModel & world,
                               allowable_speed,
                               target_speed );
 
-    dlog.addText( Logger::KICK,
-                  "(KickTable::simulate) start. target=(%.2f %.2f) speed=%.2f",
-                  target_point.x, target_point.y,
-                  target_speed );
+    RCSC_DLOG_TEXT( Logger::KICK,
+                    "(KickTable::simulate) start. target=(%.2f %.2f) speed=%.2f",
+                    target_point.x, target_point.y,
+                    target_speed );
+
+    const MemoKey memo_key = create_memo_key( world, target_point, target_speed, speed_thr, max_step );
+    if ( const MemoEntry * memo = findMemo( world, memo_key ) )
+    {
+        RCSC_PERF_COUNT( "KickTable::memo_hit", 1 );
+        RCSC_DLOG_TEXT( Logger::KICK,
+                        "(KickTable::simulate) memorized result n_kick=%d speed=%.2f score=%.2f",
+                        (int)memo->sequence_.pos_list_.size(),
+                        memo->sequence_.speed_,
+                        memo->sequence_.score_ );
+        sequence = memo->sequence_;
+        return memo->result_;
+    }
+    RCSC_PERF_COUNT( "KickTable::memo_miss", 1 );
 
     M_candidates.clear();
 
@@ -2146,28 +3018,51 @@ KickTable::simulate( const WorldModel & world,
                              target_point,
                              target_speed ) )
     {
-        dlog.addText( Logger::KICK,
-                      "(KickTable::simulate) found 1 step" );
+        RCSC_DLOG_TEXT( Logger::KICK,
+                        "(KickTable::simulate) found 1 step" );
     }
 
     M_use_risky_node = false;
 
+    updateBestScore( target_speed, speed_thr );
+
+    //
+    // the deeper searches are skipped if the decision deadline has expired
+    // and at least one candidate has been found.
+    //
+    static AnytimeSearchStats::Counter & s_stats = AnytimeSearchStats::counter( "KickTable::simulate" );
+    const Deadline & deadline = world.decisionDeadline();
+    int skipped_stages = 0;
+    const auto out_of_time
+        = [&]()
+          {
+              if ( skipped_stages > 0
+                   || ( ! M_candidates.empty()
+                        && deadline.expired() ) )
+              {
+                  ++skipped_stages;
+                  return true;
+              }
+              return false;
+          };
+
     if ( max_step >= 2
          && simulateTwoStep( world,
                              target_point,
                              target_speed ) )
     {
-        dlog.addText( Logger::KICK,
-                      "(KickTable::simulate) found 2 step" );
+        RCSC_DLOG_TEXT( Logger::KICK,
+                        "(KickTable::simulate) found 2 step" );
     }
 
     if ( max_step >= 3
+         && ! out_of_time()
          && simulateThreeStep( world,
                                target_point,
                                target_speed ) )
     {
-        dlog.addText( Logger::KICK,
-                      "(KickTable::simulate) found 3 step" );
+        RCSC_DLOG_TEXT( Logger::KICK,
+                        "(KickTable::simulate) found 3 step" );
     }
 
     // dlog.addText( Logger::KICK,
@@ -2177,35 +3072,47 @@ KickTable::simulate( const WorldModel & world,
     {
         M_use_risky_node = true;
 
+        updateBestScore( target_speed, speed_thr );
+
         // dlog.addText( Logger::KICK,
         //               "(KickTable::simulate) try risky mode" );
 
         if ( max_step >= 2
+             && ! out_of_time()
              && simulateTwoStep( world,
                                  target_point,
                                  target_speed ) )
         {
-            dlog.addText( Logger::KICK,
-                          "(KickTable::simulate) found 2 step with risky node" );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "(KickTable::simulate) found 2 step with risky node" );
         }
 
         if ( max_step >= 3
+             && ! out_of_time()
              && simulateThreeStep( world,
                                    target_point,
                                    target_speed ) )
         {
-            dlog.addText( Logger::KICK,
-                          "(KickTable::simulate) found 3 step with risky node" );
+            RCSC_DLOG_TEXT( Logger::KICK,
+                            "(KickTable::simulate) found 3 step with risky node" );
         }
     }
 
+    s_stats.add( skipped_stages > 0, M_candidates.size(), skipped_stages );
+    if ( skipped_stages > 0 )
+    {
+        RCSC_DLOG_TEXT( Logger::KICK,
+                        "(KickTable::simulate) deadline expired. skipped %d stages",
+                        skipped_stages );
+    }
+
     // TODO:
     // 4 steps simulation
 
     if ( M_candidates.empty() )
     {
-        dlog.addText( Logger::KICK,
-                      "(KickTable::simulate) No candidate" );
+        RCSC_DLOG_TEXT( Logger::KICK,
+                        "(KickTable::simulate) No candidate" );
         return false;
     }
 
@@ -2217,25 +3124,33 @@ KickTable::simulate( const WorldModel & world,
                                   M_candidates.end(),
                                   SequenceSorter() );
 
-    dlog.addText( Logger::KICK,
-                  "(KickTable::simulate) result next_pos=(%.2f %.2f) flag=%x n_kick=%d speed=%.2f power=%.2f score=%.2f",
-                  sequence.pos_list_.front().x,
-                  sequence.pos_list_.front().y,
-                  sequence.flag_,
-                  (int)sequence.pos_list_.size(),
-                  sequence.speed_,
-                  sequence.power_,
-                  sequence.score_ );
+    RCSC_DLOG_TEXT( Logger::KICK,
+                    "(KickTable::simulate) result next_pos=(%.2f %.2f) flag=%x n_kick=%d speed=%.2f power=%.2f score=%.2f",
+                    sequence.pos_list_.front().x,
+                    sequence.pos_list_.front().y,
+                    sequence.flag_,
+                    (int)sequence.pos_list_.size(),
+                    sequence.speed_,
+                    sequence.power_,
+                    sequence.score_ );
 #ifdef DEBUG_PRINT_SEQUENCE
     debugPrintSequence( world, sequence );
 #endif
 
 #ifdef DEBUG_PROFILE
-    dlog.addText( Logger::KICK,
-                  "(KickTable::simulate) KickTable_elapsed=%f [ms].",
-                  timer.elapsedReal() );
+    RCSC_DLOG_TEXT( Logger::KICK,
+                    "(KickTable::simulate) KickTable_elapsed=%f [ms].",
+                    timer.elapsedReal() );
 #endif
-    return sequence.speed_ >= target_speed - rcsc::EPS;
+
+    const bool result = ( sequence.speed_ >= target_speed - rcsc::EPS );
+    if ( skipped_stages == 0 )
+    {
+        // the truncated result may be improved in the next call
+        addMemo( memo_key, result, sequence );
+    }
+
+    return result;
 }
 
 }
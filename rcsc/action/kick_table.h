@@ -34,13 +34,17 @@
 
 #include <rcsc/geom/vector_2d.h>
 #include <rcsc/geom/angle_deg.h>
+#include <rcsc/game_time.h>
 
 #include <vector>
 #include <algorithm>
+#include <memory>
+#include <string>
+#include <iosfwd>
+#include <cstdint>
 
 namespace rcsc {
 
-class GameTime;
 class PlayerType;
 class WorldModel;
 
@@ -179,6 +183,47 @@ public:
 
 private:
 
+    /*!
+      \struct MemoKey
+      \brief quantized search request used as the key of the sequence memo
+     */
+    struct MemoKey {
+        int ball_x_; //!< ball relative x
+        int ball_y_; //!< ball relative y
+        int target_dir_; //!< target direction from the ball
+        int target_dist_; //!< target distance from the ball
+        int first_speed_; //!< required first speed
+        int allowable_speed_; //!< required first speed threshold
+        int max_step_; //!< maximum size of kick sequence
+
+        /*!
+          \brief compare all values
+          \param other compared key
+          \return true if all values are same
+         */
+        bool equals( const MemoKey & other ) const
+          {
+              return ball_x_ == other.ball_x_
+                  && ball_y_ == other.ball_y_
+                  && target_dir_ == other.target_dir_
+                  && target_dist_ == other.target_dist_
+                  && first_speed_ == other.first_speed_
+                  && allowable_speed_ == other.allowable_speed_
+                  && max_step_ == other.max_step_;
+          }
+    };
+
+    /*!
+      \struct MemoEntry
+      \brief memorized search result
+     */
+    struct MemoEntry {
+        MemoKey key_; //!< search request
+        unsigned long stamp_; //!< last used stamp
+        bool result_; //!< return value of simulate()
+        Sequence sequence_; //!< result sequence
+    };
+
     //
     // offline data
     //
@@ -196,10 +241,27 @@ private:
     //! static heuristic table
     std::vector< Path > M_tables[DEST_DIR_DIVS];
 
+    //! heuristic table referred by the search. points to M_tables or the binary file data.
+    const Path * M_table_data[DEST_DIR_DIVS];
+    //! size of each heuristic table
+    std::size_t M_table_size[DEST_DIR_DIVS];
+
+    //! read-only binary table data (memory mapped if available). NULL if not used.
+    std::shared_ptr< const char > M_binary_data;
+
+    //! incremented when the heuristic tables are replaced
+    unsigned long M_table_generation;
+
+    //! M_table_generation of instance() when its tables were shared. used only by the per-agent instances.
+    unsigned long M_shared_generation;
+
     //
     // online data
     //
 
+    //! the time when the state cache is updated
+    GameTime M_update_time;
+
     //! current state cache
     State M_current_state;
 
@@ -209,6 +271,18 @@ private:
     //! result kick sequences
     std::vector< Sequence > M_candidates;
 
+    //! the time when the sequence memo is created
+    GameTime M_memo_time;
+
+    //! memorized search results in the current cycle
+    std::vector< MemoEntry > M_memo;
+
+    //! the maximum number of the memo entries. 0 means the memo is disabled.
+    std::size_t M_memo_capacity;
+
+    //! the counter to find the least recently used entry
+    unsigned long M_memo_stamp;
+
 
     //
     // other parameters
@@ -216,17 +290,44 @@ private:
 
     bool M_use_risky_node;
 
+    //! if true, the search skips the paths that cannot exceed the best score
+    bool M_pruning;
+
+    //! the best score in the current candidates. used only by the pruning.
+    double M_best_score;
+
+    //! the number of tasks used to create the heuristic tables
+    int M_thread_count;
+
     /*!
       \brief private constructor for singleton
      */
     KickTable();
 
+    /*!
+      \brief destructor. release the binary table data.
+     */
+    ~KickTable();
+
     // not used
     KickTable( const KickTable & ) = delete;
     const KickTable & operator=( const KickTable & ) = delete;
 
 private:
 
+    struct AgentTable;
+
+    /*!
+      \brief refer M_tables from the search, and release the binary table data.
+     */
+    void setTableView();
+
+    /*!
+      \brief refer the offline data of the shared instance without copying the heuristic tables
+      \param shared the instance that owns the tables
+     */
+    void shareTables( const KickTable & shared );
+
     /*!
       \brief create static state list
      */
@@ -316,6 +417,11 @@ private:
                           const Vector2D & target_point,
                           const double first_speed );
 
+    template < typename SP >
+    bool simulateTwoStepImpl( const WorldModel & world,
+                              const Vector2D & target_point,
+                              const double first_speed );
+
     /*!
       \brief simulate three step kicks
       \param world const reference to the WorldModel
@@ -326,6 +432,11 @@ private:
                             const Vector2D & target_point,
                             const double first_speed );
 
+    template < typename SP >
+    bool simulateThreeStepImpl( const WorldModel & world,
+                                const Vector2D & target_point,
+                                const double first_speed );
+
     /*!
       \brief evaluate candidate kick sequences
       \param wm const reference to the WorldModel
@@ -336,11 +447,54 @@ private:
                    const double first_speed,
                    const double allowable_speed );
 
+    /*!
+      \brief recompute the best score of the current candidates (only if the pruning is enabled)
+      \param first_speed required first speed
+      \param allowable_speed required first speed threshold
+     */
+    void updateBestScore( const double first_speed,
+                          const double allowable_speed );
+
     /*!
       \brief output debugging information to Logger
      */
     void debugPrintStateCache();
 
+    /*!
+      \brief create the memo key for the search request
+      \param world const reference to the WorldModel
+      \param target_point kick target point
+      \param first_speed required first speed
+      \param allowable_speed required first speed threshold
+      \param max_step maximum size of kick sequence
+      \return quantized key
+     */
+    static
+    MemoKey create_memo_key( const WorldModel & world,
+                             const Vector2D & target_point,
+                             const double first_speed,
+                             const double allowable_speed,
+                             const int max_step );
+
+    /*!
+      \brief find the memorized result. the memo is cleared if the cycle is changed.
+      \param world const reference to the WorldModel
+      \param key search request
+      \return pointer to the found entry. NULL if not found.
+     */
+    const MemoEntry * findMemo( const WorldModel & world,
+                                const MemoKey & key );
+
+    /*!
+      \brief store the search result. the least recently used entry is replaced if full.
+      \param key search request
+      \param result return value of the search
+      \param sequence result sequence
+     */
+    void addMemo( const MemoKey & key,
+                  const bool result,
+                  const Sequence & sequence );
+
     /*!
       \brief output debugging information to Logger
       \param wm world model instance
@@ -358,12 +512,47 @@ public:
     static
     KickTable & instance();
 
+    /*!
+      \brief get the heap bytes held by this instance. the memory mapped
+      binary table is not included.
+      \return bytes
+     */
+    std::size_t memoryUsage() const;
+
+    /*!
+      \brief get the instance of the agent
+      \param world world model of the agent
+      \return reference to the instance stored in the agent's context
+
+      The returned instance has its own search state (the state cache, the
+      candidates and the memo), so the agents in the same process can
+      call simulate() concurrently. The heuristic tables are not copied
+      but referred from instance(), and the pruning and memo settings of
+      instance() are also applied. The tables of instance() have to be
+      created before the agents start their threads.
+     */
+    static
+    KickTable & instance( const WorldModel & world );
+
     /*!
       \brief create heuristic table
       \return result of table creation
      */
     bool createTables();
 
+    /*!
+      \brief attach the heuristic tables published by the other process on the
+      same host, or create and publish them if no process has done it.
+      \return result of table creation
+
+      The tables are published as a POSIX shared memory segment in the binary
+      table format, and all processes refer one physical copy. The segment name
+      contains table_key(), so the segment is rebuilt if the parameters or the
+      format are changed. If the shared memory is not available, the tables
+      are created in this process by createTables().
+     */
+    bool createSharedTables();
+
     /*!
       \brief read table data from file
       \param file_path file path to read
@@ -378,6 +567,50 @@ public:
      */
     bool write( const std::string & file_path );
 
+    /*!
+      \brief get the hash value of the parameters that affect the table values
+      \return hash value stored in the binary table file
+     */
+    static
+    std::uint64_t table_key();
+
+    /*!
+      \brief read the binary table file.
+      \param file_path file path to read
+      \return read result. false if the format version or the table key does not match.
+
+      The file is memory mapped read-only if the platform supports it, and the
+      heuristic tables are referred directly from the mapped pages. Then, all
+      processes on the same host can share one page cached copy.
+     */
+    bool readBinary( const std::string & file_path );
+
+    /*!
+      \brief read the binary table data.
+      \param data read-only data. the pointer is held while the tables are used.
+      \param size data size
+      \return read result
+     */
+    bool readBinary( const std::shared_ptr< const char > & data,
+                     const std::size_t size );
+
+    /*!
+      \brief write table data to the binary file.
+      \param file_path file path to write
+      \return write result
+
+      The data is written to a temporary file, then renamed to file_path,
+      so that the processes that already map the old file are not affected.
+     */
+    bool writeBinary( const std::string & file_path ) const;
+
+    /*!
+      \brief write table data in the binary format to the stream.
+      \param os reference to the binary output stream
+      \return write result
+     */
+    bool writeBinary( std::ostream & os ) const;
+
     /*!
       \brief simulate kick sequence
       \param world const reference to the WorldModel
@@ -396,7 +629,56 @@ public:
                    Sequence & sequence );
 
     /*!
-      \brief get the candidate kick sequences
+      \brief enable/disable the bound based pruning of the kick search
+      \param on if true, the pruning is enabled
+
+      The paths whose score upper bound is not greater than the best score
+      found so far are skipped. The paths in the three step table are also
+      cut when their offline max speed is clearly lower than the required
+      speed after a successful sequence is found.
+      The selected sequence is never worse than the one without the pruning,
+      but candidates() may not contain all failed paths.
+     */
+    void setPruning( const bool on )
+      {
+          M_pruning = on;
+      }
+
+    /*!
+      \brief check if the bound based pruning is enabled
+      \return the pruning mode
+     */
+    bool pruning() const
+      {
+          return M_pruning;
+      }
+
+    /*!
+      \brief set the size of the per-cycle sequence memo
+      \param capacity the maximum number of memorized results. 0 disables the memo.
+
+      simulate() returns the memorized result if a request with the same
+      quantized ball relative position, target direction/distance and speeds
+      was already searched in the current cycle.
+      The hit/miss counts are recorded to g_performance_monitor as
+      "KickTable::memo_hit" and "KickTable::memo_miss".
+     */
+    void setMemoCapacity( const std::size_t capacity );
+
+    /*!
+      \brief set the number of tasks used by createTables().
+      the tasks run on the background lane of TaskPool. if the pool has no
+      worker, they run in the caller thread.
+      \param count task count. if less than 2, the tables are created in the caller thread.
+     */
+    void setThreadCount( const int count )
+      {
+          M_thread_count = std::max( 1, count );
+      }
+
+    /*!
+      \brief get the candidate kick sequences of the last executed search.
+      the container is not updated if simulate() returns the memorized result.
       \return const reference to the container of Sequence
      */
     const std::vector< Sequence > & candidates() const
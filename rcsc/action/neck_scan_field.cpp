@@ -39,18 +39,37 @@
 #include <rcsc/action/neck_scan_players.h>
 
 #include <rcsc/player/player_agent.h>
+#include <rcsc/player/agent_context.h>
 #include <rcsc/common/logger.h>
 #include <rcsc/common/server_param.h>
 #include <rcsc/geom/rect_2d.h>
 
 #include <algorithm>
-#include <numeric>
-#include <deque>
 
 // #define DEBUG_PRINT
 
 namespace rcsc {
 
+namespace {
+
+/*!
+  \struct ScanFieldCache
+  \brief the last result of Neck_ScanField. stored in each agent's context.
+ */
+struct ScanFieldCache {
+    GameTime last_calc_time_; //!< last calculated time
+    ViewWidth last_calc_view_width_; //!< view width used by the last calculation
+    AngleDeg target_angle_; //!< last calculated neck target
+
+    ScanFieldCache()
+        : last_calc_time_( 0, 0 ),
+          last_calc_view_width_( ViewWidth::NORMAL ),
+          target_angle_( 0.0 )
+      { }
+};
+
+}
+
 const double Neck_ScanField::INVALID_ANGLE = -360.0;
 
 /*-------------------------------------------------------------------*/
@@ -60,27 +79,25 @@ const double Neck_ScanField::INVALID_ANGLE = -360.0;
 bool
 Neck_ScanField::execute( PlayerAgent * agent )
 {
-    static GameTime s_last_calc_time( 0, 0 );
-    static ViewWidth s_last_calc_view_width = ViewWidth::NORMAL;
-    static AngleDeg s_cached_target_angle = 0.0;
-
     const WorldModel & wm = agent->world();
 
-    if ( s_last_calc_time == wm.time()
-         && s_last_calc_view_width != agent->effector().queuedNextViewWidth() )
+    ScanFieldCache & cache = wm.agentContext().get< ScanFieldCache >();
+
+    if ( cache.last_calc_time_ == wm.time()
+         && cache.last_calc_view_width_ != agent->effector().queuedNextViewWidth() )
     {
         dlog.addText( Logger::ACTION,
                       __FILE__": (execute) cached angle=%.1f",
-                      s_cached_target_angle.degree() );
-        return agent->doTurnNeck( s_cached_target_angle
+                      cache.target_angle_.degree() );
+        return agent->doTurnNeck( cache.target_angle_
                                   - agent->effector().queuedNextSelfBody()
                                   - agent->world().self().neck() );
 
 
     }
 
-    s_last_calc_time = agent->world().time();
-    s_last_calc_view_width = agent->effector().queuedNextViewWidth();
+    cache.last_calc_time_ = agent->world().time();
+    cache.last_calc_view_width_ = agent->effector().queuedNextViewWidth();
 
     //
     // for wide mode
@@ -89,13 +106,13 @@ Neck_ScanField::execute( PlayerAgent * agent )
 
     if ( angle != INVALID_ANGLE )
     {
-        s_cached_target_angle = angle;
+        cache.target_angle_ = angle;
 
         dlog.addText( Logger::ACTION,
                       __FILE__": (execute) wide mode scan " );
         agent->debugClient().addMessage( "NeckScan:Wide" );
 
-        agent->doTurnNeck( s_cached_target_angle
+        agent->doTurnNeck( cache.target_angle_
                            - agent->effector().queuedNextSelfBody()
                            - wm.self().neck() );
         return true;
@@ -124,13 +141,13 @@ Neck_ScanField::execute( PlayerAgent * agent )
 
         if ( angle != INVALID_ANGLE )
         {
-            s_cached_target_angle = angle;
+            cache.target_angle_ = angle;
 
             dlog.addText( Logger::ACTION,
                           __FILE__": (execute) scan players. target_angle=%.1f", angle );
             agent->debugClient().addMessage( "NeckScan:Pl" );
 
-            agent->doTurnNeck( s_cached_target_angle
+            agent->doTurnNeck( cache.target_angle_
                                - agent->effector().queuedNextSelfBody()
                                - agent->world().self().neck() );
             return true;
@@ -157,14 +174,14 @@ Neck_ScanField::execute( PlayerAgent * agent )
         angle = calcAngleDefault( agent, false );
     }
 
-    s_cached_target_angle = angle;
+    cache.target_angle_ = angle;
 
     dlog.addText( Logger::ACTION,
                   __FILE__": (execute) target_angle=%.1f",
-                  s_cached_target_angle.degree() );
+                  cache.target_angle_.degree() );
     agent->debugClient().addMessage( "NeckScan" );
 
-    agent->doTurnNeck( s_cached_target_angle
+    agent->doTurnNeck( cache.target_angle_
                        - agent->effector().queuedNextSelfBody()
                        - agent->world().self().neck() );
     return true;
@@ -238,25 +255,12 @@ Neck_ScanField::calcAngleDefault( const PlayerAgent * agent,
     }
 
 
-    AngleDeg tmp_angle = left_start;
+    const int size_of_view_width
+        = static_cast< int >( rint( shrinked_next_view_width / WorldModel::DIR_STEP ) );
 
-    const std::size_t size_of_view_width
-        = static_cast< std::size_t >
-        ( rint( shrinked_next_view_width / WorldModel::DIR_STEP ) );
-
-    std::deque< int > dir_counts( size_of_view_width );
-
-    // generate first visible cone score list
-    {
-
-        for ( std::deque< int >::iterator it = dir_counts.begin(), end = dir_counts.end();
-              it != end;
-              ++it )
-        {
-            *it = wm.dirCount( tmp_angle );
-            tmp_angle += WorldModel::DIR_STEP;
-        }
-    }
+    // the sum of each candidate cone is taken from the prefix sums in WorldModel.
+    AngleDeg left_angle = left_start;
+    AngleDeg tmp_angle = left_start + WorldModel::DIR_STEP * size_of_view_width;
 
     int max_count_sum = 0;
     double add_dir = shrinked_next_view_width;
@@ -272,7 +276,7 @@ Neck_ScanField::calcAngleDefault( const PlayerAgent * agent,
 
     do
     {
-        int tmp_count_sum = std::accumulate( dir_counts.begin(), dir_counts.end(), 0 );
+        const int tmp_count_sum = wm.dirCountSum( left_angle, size_of_view_width );
 
         AngleDeg angle = tmp_angle - shrinked_next_view_width * 0.5;
 #ifdef DEBUG_PRINT
@@ -333,10 +337,9 @@ Neck_ScanField::calcAngleDefault( const PlayerAgent * agent,
             }
         }
 
-        dir_counts.pop_front();
         add_dir += WorldModel::DIR_STEP;
         tmp_angle += WorldModel::DIR_STEP;
-        dir_counts.push_back( wm.dirCount( tmp_angle ) );
+        left_angle += WorldModel::DIR_STEP;
     }
     while ( add_dir <= scan_range );
 
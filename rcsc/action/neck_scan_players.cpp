@@ -39,6 +39,7 @@
 #include <rcsc/action/neck_scan_field.h>
 
 #include <rcsc/player/player_agent.h>
+#include <rcsc/player/agent_context.h>
 #include <rcsc/player/intercept_table.h>
 #include <rcsc/player/view_mode.h>
 #include <rcsc/common/server_param.h>
@@ -57,6 +58,30 @@
 namespace rcsc {
 
 //! invalid angle value
+namespace {
+
+/*!
+  \struct ScanPlayersCache
+  \brief the last result of Neck_ScanPlayers. stored in each agent's context.
+ */
+struct ScanPlayersCache {
+    GameTime last_calc_time_; //!< last calculated time
+    ViewWidth last_calc_view_width_; //!< view width used by the last calculation
+    double last_calc_min_neck_angle_; //!< neck range used by the last calculation
+    double last_calc_max_neck_angle_; //!< neck range used by the last calculation
+    double target_angle_; //!< last calculated neck target
+
+    ScanPlayersCache()
+        : last_calc_time_( 0, 0 ),
+          last_calc_view_width_( ViewWidth::NORMAL ),
+          last_calc_min_neck_angle_( 0.0 ),
+          last_calc_max_neck_angle_( 0.0 ),
+          target_angle_( 0.0 )
+      { }
+};
+
+}
+
 const double Neck_ScanPlayers::INVALID_ANGLE = -360.0;
 
 
@@ -67,43 +92,39 @@ const double Neck_ScanPlayers::INVALID_ANGLE = -360.0;
 bool
 Neck_ScanPlayers::execute( PlayerAgent * agent )
 {
-    static GameTime s_last_calc_time( 0, 0 );
-    static ViewWidth s_last_calc_view_width = ViewWidth::NORMAL;
-    static double s_last_calc_min_neck_angle = 0.0;
-    static double s_last_calc_max_neck_angle = 0.0;
-    static double s_cached_target_angle = 0.0;
-
-    if ( s_last_calc_time != agent->world().time()
-         || s_last_calc_view_width != agent->effector().queuedNextViewWidth()
-         || std::fabs( s_last_calc_min_neck_angle - M_min_neck_angle ) > 1.0e-3
-         || std::fabs( s_last_calc_max_neck_angle - M_max_neck_angle ) > 1.0e-3 )
+    ScanPlayersCache & cache = agent->world().agentContext().get< ScanPlayersCache >();
+
+    if ( cache.last_calc_time_ != agent->world().time()
+         || cache.last_calc_view_width_ != agent->effector().queuedNextViewWidth()
+         || std::fabs( cache.last_calc_min_neck_angle_ - M_min_neck_angle ) > 1.0e-3
+         || std::fabs( cache.last_calc_max_neck_angle_ - M_max_neck_angle ) > 1.0e-3 )
     {
-        s_last_calc_time = agent->world().time();
-        s_last_calc_view_width = agent->effector().queuedNextViewWidth();
-        s_last_calc_min_neck_angle = M_min_neck_angle;
-        s_last_calc_max_neck_angle = M_max_neck_angle;
+        cache.last_calc_time_ = agent->world().time();
+        cache.last_calc_view_width_ = agent->effector().queuedNextViewWidth();
+        cache.last_calc_min_neck_angle_ = M_min_neck_angle;
+        cache.last_calc_max_neck_angle_ = M_max_neck_angle;
 
 #ifdef DEBUG_PRINT
         dlog.addText( Logger::ACTION,
                       __FILE__": (execute) call calcAngle()" );
 #endif
-        s_cached_target_angle = get_best_angle( agent,
+        cache.target_angle_ = get_best_angle( agent,
                                                 M_min_neck_angle,
                                                 M_max_neck_angle );
     }
 
-    if ( s_cached_target_angle == INVALID_ANGLE )
+    if ( cache.target_angle_ == INVALID_ANGLE )
     {
         dlog.addText( Logger::ACTION,
                       __FILE__": (execute) envalid angle" );
         return Neck_ScanField().execute( agent );
     }
 
-    AngleDeg target_angle = s_cached_target_angle;
+    AngleDeg target_angle = cache.target_angle_;
 
     dlog.addText( Logger::ACTION,
                   __FILE__": (execute) target_angle=%.1f cached_value=%.1f",
-                  target_angle.degree(), s_cached_target_angle );
+                  target_angle.degree(), cache.target_angle_ );
     agent->debugClient().addMessage( "NeckScanPl" );
 
     agent->doTurnNeck( target_angle
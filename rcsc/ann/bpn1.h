@@ -33,8 +33,10 @@
 #define RCSC_ANN_BPN1_H
 
 #include <array>
+#include <vector>
 #include <algorithm>
 #include <numeric> // inner_product
+#include <iterator>
 #include <iostream>
 #include <cmath>
 
@@ -160,6 +162,50 @@ public:
     //! typedef of the output array type that uses template parameter.
     typedef std::array< value_type, OUTPUT > output_array;
 
+    //! input type for the generic trainer
+    typedef input_array input_type;
+    //! output type for the generic trainer
+    typedef output_array output_type;
+
+    //! the number of inputs evaluated at once in propagateBatch()
+    static constexpr std::size_t BATCH_BLOCK = 32;
+
+    /*!
+      \struct Gradient
+      \brief accumulated weight update directions of the samples
+     */
+    struct Gradient {
+        //! for the connection between input and hidden layer. bias weight is included.
+        std::array< value_type, INPUT + 1 > i_to_h_[HIDDEN];
+        //! for the connection between hidden and output layer. bias weight is included.
+        std::array< value_type, HIDDEN + 1 > h_to_o_[OUTPUT];
+
+        /*!
+          \brief set all values to 0
+         */
+        void clear()
+          {
+              for ( std::size_t i = 0; i < HIDDEN; ++i ) i_to_h_[i].fill( 0 );
+              for ( std::size_t i = 0; i < OUTPUT; ++i ) h_to_o_[i].fill( 0 );
+          }
+
+        /*!
+          \brief add other gradient
+          \param other added gradient
+         */
+        void add( const Gradient & other )
+          {
+              for ( std::size_t i = 0; i < HIDDEN; ++i )
+              {
+                  for ( std::size_t j = 0; j < INPUT + 1; ++j ) i_to_h_[i][j] += other.i_to_h_[i][j];
+              }
+              for ( std::size_t i = 0; i < OUTPUT; ++i )
+              {
+                  for ( std::size_t j = 0; j < HIDDEN + 1; ++j ) h_to_o_[i][j] += other.h_to_o_[i][j];
+              }
+          }
+    };
+
 private:
 
     //! learning parameter
@@ -231,17 +277,17 @@ public:
      */
     void init()
       {
-          M_hidden_layer.assign( 0 );
+          M_hidden_layer.fill( 0 );
           M_hidden_layer.back() = 1;
           for ( std::size_t i = 0; i < HIDDEN; ++i )
           {
-              M_weight_i_to_h[i].assign( 0 );
-              M_delta_weight_i_to_h[i].assign( 0 );
+              M_weight_i_to_h[i].fill( 0 );
+              M_delta_weight_i_to_h[i].fill( 0 );
           }
           for ( std::size_t i = 0; i < OUTPUT; ++i )
           {
-              M_weight_h_to_o[i].assign( 0 );
-              M_delta_weight_h_to_o[i].assign( 0 );
+              M_weight_h_to_o[i].fill( 0 );
+              M_delta_weight_h_to_o[i].fill( 0 );
           }
       }
 
@@ -299,6 +345,208 @@ public:
           }
       }
 
+    /*!
+      \brief simulate network for many inputs.
+      \param inputs input data
+      \param outputs reference to the data holder variable. resized to inputs.size().
+
+      The result is same as propagate() for each input except the rounding
+      error of the different operation order in the compiled code. The inputs are
+      evaluated by the blocks of BATCH_BLOCK, and each weight is multiplied
+      to the values of the whole block in the innermost loop, so that the
+      compiler can vectorize the matrix product. The rest of the inputs
+      that do not fill the block are evaluated by propagate().
+    */
+    void propagateBatch( const std::vector< input_array > & inputs,
+                         std::vector< output_array > & outputs ) const
+      {
+          outputs.resize( inputs.size() );
+
+          // transposed values of the block. [unit][input index in the block]
+          value_type x[INPUT][BATCH_BLOCK];
+          value_type h[HIDDEN][BATCH_BLOCK];
+          value_type sum[BATCH_BLOCK];
+
+          FuncH func_h;
+          FuncO func_o;
+
+          std::size_t first = 0;
+          for ( ; first + BATCH_BLOCK <= inputs.size(); first += BATCH_BLOCK )
+          {
+              for ( std::size_t k = 0; k < BATCH_BLOCK; ++k )
+              {
+                  for ( std::size_t j = 0; j < INPUT; ++j )
+                  {
+                      x[j][k] = inputs[first + k][j];
+                  }
+              }
+
+              // Input to Hidden
+              for ( std::size_t i = 0; i < HIDDEN; ++i )
+              {
+                  std::fill_n( sum, BATCH_BLOCK, static_cast< value_type >( 0 ) );
+                  for ( std::size_t j = 0; j < INPUT; ++j )
+                  {
+                      const value_type w = M_weight_i_to_h[i][j];
+                      for ( std::size_t k = 0; k < BATCH_BLOCK; ++k )
+                      {
+                          sum[k] += x[j][k] * w;
+                      }
+                  }
+                  // add bias
+                  for ( std::size_t k = 0; k < BATCH_BLOCK; ++k )
+                  {
+                      h[i][k] = func_h( sum[k] + M_weight_i_to_h[i].back() );
+                  }
+              }
+
+              // Hidden to Output
+              for ( std::size_t i = 0; i < OUTPUT; ++i )
+              {
+                  std::fill_n( sum, BATCH_BLOCK, static_cast< value_type >( 0 ) );
+                  for ( std::size_t j = 0; j < HIDDEN; ++j )
+                  {
+                      const value_type w = M_weight_h_to_o[i][j];
+                      for ( std::size_t k = 0; k < BATCH_BLOCK; ++k )
+                      {
+                          sum[k] += h[j][k] * w;
+                      }
+                  }
+                  // add bias
+                  for ( std::size_t k = 0; k < BATCH_BLOCK; ++k )
+                  {
+                      outputs[first + k][i] = func_o( sum[k] + M_weight_h_to_o[i].back() );
+                  }
+              }
+          }
+
+          for ( ; first < inputs.size(); ++first )
+          {
+              propagate( inputs[first], outputs[first] );
+          }
+      }
+
+    /*!
+      \brief prepare the gradient variable for this network
+      \param grad pointer to the gradient variable. all values are set to 0.
+     */
+    void initGradient( Gradient * grad ) const
+      {
+          grad->clear();
+      }
+
+    /*!
+      \brief add the weight update direction for the sample without updating the weights.
+      \param input input data
+      \param teacher teaching signal data
+      \param grad pointer to the gradient variable
+      \return squared error before the update
+
+      This method does not use the internal value holder, so that it can be
+      called from several threads at the same time.
+    */
+    value_type accumulateGradient( const input_array & input,
+                                   const output_array & teacher,
+                                   Gradient * grad ) const
+      {
+          FuncH func_h;
+          FuncO func_o;
+
+          // Input to Hidden
+          std::array< value_type, HIDDEN + 1 > hidden;
+          for ( std::size_t i = 0; i < HIDDEN; ++i )
+          {
+              value_type sum = std::inner_product( input.begin(),
+                                                   input.end(),
+                                                   M_weight_i_to_h[i].begin(),
+                                                   static_cast< value_type >( 0 ) );
+              sum += M_weight_i_to_h[i].back();
+              hidden[i] = func_h( sum );
+          }
+          hidden.back() = 1;
+
+          // Hidden to Output, and output error back
+          value_type total_error = 0;
+          output_array output_back;
+          for ( std::size_t i = 0; i < OUTPUT; ++i )
+          {
+              const value_type output = func_o( std::inner_product( hidden.begin(),
+                                                                    hidden.end(),
+                                                                    M_weight_h_to_o[i].begin(),
+                                                                    static_cast< value_type >( 0 ) ) );
+              const value_type err = teacher[i] - output;
+              total_error += err * err;
+              output_back[i] = err * func_o.diffAtY( output );
+          }
+
+          // hidden layer error back
+          for ( std::size_t i = 0; i < HIDDEN; ++i )
+          {
+              value_type sum = 0;
+              for ( std::size_t j = 0; j < OUTPUT; ++j )
+              {
+                  sum += output_back[j] * M_weight_h_to_o[j][i];
+              }
+              const value_type hidden_back = sum * func_h.diffAtY( hidden[i] );
+
+              for ( std::size_t j = 0; j < INPUT; ++j )
+              {
+                  grad->i_to_h_[i][j] += input[j] * hidden_back;
+              }
+              grad->i_to_h_[i][INPUT] += hidden_back;
+          }
+
+          for ( std::size_t i = 0; i < OUTPUT; ++i )
+          {
+              for ( std::size_t j = 0; j < HIDDEN + 1; ++j )
+              {
+                  grad->h_to_o_[i][j] += hidden[j] * output_back[i];
+              }
+          }
+
+          return total_error;
+      }
+
+    /*!
+      \brief update unit connection weights by the mean of the accumulated gradient
+      \param grad accumulated gradient
+      \param n_samples the number of accumulated samples
+
+      The update rule is same as train() with the mean direction of the samples.
+    */
+    void applyGradient( const Gradient & grad,
+                        const std::size_t n_samples )
+      {
+          if ( n_samples == 0 )
+          {
+              return;
+          }
+
+          const value_type eta = M_eta / n_samples;
+
+          for ( std::size_t i = 0; i < OUTPUT; ++i )
+          {
+              for ( std::size_t j = 0; j < HIDDEN + 1; ++j )
+              {
+                  M_delta_weight_h_to_o[i][j]
+                      = eta * grad.h_to_o_[i][j]
+                      + M_alpha * M_delta_weight_h_to_o[i][j];
+                  M_weight_h_to_o[i][j] += M_delta_weight_h_to_o[i][j];
+              }
+          }
+
+          for ( std::size_t i = 0; i < HIDDEN; ++i )
+          {
+              for ( std::size_t j = 0; j < INPUT + 1; ++j )
+              {
+                  M_delta_weight_i_to_h[i][j]
+                      = eta * grad.i_to_h_[i][j]
+                      + M_alpha * M_delta_weight_i_to_h[i][j];
+                  M_weight_i_to_h[i][j] += M_delta_weight_i_to_h[i][j];
+              }
+          }
+      }
+
     /*!
       \brief update unit connection weights using teacher signal
       \param input input data
@@ -0,0 +1,194 @@
+// -*-c++-*-
+
+/*!
+  \file center_index.cpp
+  \brief k-d tree of the unit centers Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "center_index.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace rcsc {
+
+constexpr std::size_t CenterIndex::LEAF_SIZE;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+CenterIndex::CenterIndex()
+    : M_dim( 0 ),
+      M_max_extent( 0.0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+CenterIndex::clear()
+{
+    M_dim = 0;
+    M_max_extent = 0.0;
+    M_coords.clear();
+    M_ids.clear();
+    M_nodes.clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+CenterIndex::build( const std::size_t dim,
+                    const std::vector< double > & coords )
+{
+    clear();
+
+    if ( dim == 0
+         || coords.size() < dim )
+    {
+        return;
+    }
+
+    M_dim = dim;
+
+    const std::size_t n = coords.size() / dim;
+    M_ids.resize( n );
+    std::iota( M_ids.begin(), M_ids.end(), 0 );
+
+    M_nodes.reserve( 2 * ( n / LEAF_SIZE + 1 ) );
+    buildNode( 0, n, coords );
+
+    // copy the coordinates in the tree order for the contiguous leaf scan
+    M_coords.resize( n * dim );
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        std::copy( coords.begin() + M_ids[i] * dim,
+                   coords.begin() + ( M_ids[i] + 1 ) * dim,
+                   M_coords.begin() + i * dim );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+CenterIndex::buildNode( const std::size_t begin,
+                        const std::size_t end,
+                        const std::vector< double > & coords )
+{
+    const int index = static_cast< int >( M_nodes.size() );
+    M_nodes.push_back( Node{ begin, end, 0, 0.0, -1, -1 } );
+
+    if ( end - begin <= LEAF_SIZE )
+    {
+        return index;
+    }
+
+    //
+    // split by the axis of the largest extent
+    //
+    std::size_t axis = 0;
+    double max_extent = -1.0;
+    for ( std::size_t d = 0; d < M_dim; ++d )
+    {
+        double min_v = coords[M_ids[begin] * M_dim + d];
+        double max_v = min_v;
+        for ( std::size_t i = begin + 1; i < end; ++i )
+        {
+            const double v = coords[M_ids[i] * M_dim + d];
+            min_v = std::min( min_v, v );
+            max_v = std::max( max_v, v );
+        }
+
+        if ( max_v - min_v > max_extent )
+        {
+            max_extent = max_v - min_v;
+            axis = d;
+        }
+    }
+
+    if ( begin == 0
+         && end == M_ids.size() )
+    {
+        M_max_extent = max_extent;
+    }
+
+    const std::size_t mid = begin + ( end - begin ) / 2;
+    std::nth_element( M_ids.begin() + begin,
+                      M_ids.begin() + mid,
+                      M_ids.begin() + end,
+                      [&]( const std::size_t lhs,
+                           const std::size_t rhs )
+                        {
+                            return coords[lhs * M_dim + axis] < coords[rhs * M_dim + axis];
+                        } );
+
+    // all points in the left child is not greater than split,
+    // and all points in the right child is not less than split.
+    const double split = coords[M_ids[mid] * M_dim + axis];
+
+    const int left = buildNode( begin, mid, coords );
+    const int right = buildNode( mid, end, coords );
+
+    Node & node = M_nodes[index];
+    node.axis_ = axis;
+    node.split_ = split;
+    node.left_ = left;
+    node.right_ = right;
+
+    return index;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+CenterIndex::findWithin( const double * point,
+                         const double radius,
+                         std::vector< std::size_t > * result ) const
+{
+    result->clear();
+    forEachWithin( point, radius,
+                   [&]( const std::size_t id )
+                     {
+                         result->push_back( id );
+                     } );
+}
+
+}
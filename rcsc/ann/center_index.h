@@ -0,0 +1,212 @@
+// -*-c++-*-
+
+/*!
+  \file center_index.h
+  \brief k-d tree of the unit centers Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_ANN_CENTER_INDEX_H
+#define RCSC_ANN_CENTER_INDEX_H
+
+#include <vector>
+#include <cstddef>
+
+namespace rcsc {
+
+/*!
+  \class CenterIndex
+  \brief static k-d tree of the points in any dimension.
+
+  The index is used by RBFNetwork and NGNet to find the units whose center
+  is near the input. The tree is rebuilt by build() when the centers are
+  changed. The query methods are const and can be called from several
+  threads at the same time.
+*/
+class CenterIndex {
+public:
+
+    //! the maximum number of points in a leaf node
+    static constexpr std::size_t LEAF_SIZE = 8;
+
+private:
+
+    /*!
+      \struct Node
+      \brief tree node. the points of the node are [begin_, end_) in M_ids.
+     */
+    struct Node {
+        std::size_t begin_; //!< first point
+        std::size_t end_; //!< end of the points
+        std::size_t axis_; //!< split axis
+        double split_; //!< split coordinate
+        int left_; //!< left child index. -1 if leaf.
+        int right_; //!< right child index. -1 if leaf.
+    };
+
+    std::size_t M_dim; //!< point dimension
+    double M_max_extent; //!< the largest extent of the points along the axes
+    std::vector< double > M_coords; //!< coordinates of the points in the tree order
+    std::vector< std::size_t > M_ids; //!< point id in the tree order
+    std::vector< Node > M_nodes; //!< tree nodes. the first one is the root.
+
+public:
+
+    /*!
+      \brief create an empty index
+     */
+    CenterIndex();
+
+    /*!
+      \brief remove all points
+     */
+    void clear();
+
+    /*!
+      \brief check if the index is empty
+      \return true if no point
+     */
+    bool empty() const
+      {
+          return M_ids.empty();
+      }
+
+    /*!
+      \brief get the number of points
+      \return the number of points
+     */
+    std::size_t size() const
+      {
+          return M_ids.size();
+      }
+
+    /*!
+      \brief get the largest extent of the points along the axes
+      \return the largest width of the bounding box. 0 if all points are in one leaf.
+     */
+    double maxExtent() const
+      {
+          return M_max_extent;
+      }
+
+    /*!
+      \brief build the tree
+      \param dim point dimension
+      \param coords coordinates of all points. the size must be dim * (the number of points).
+      the id of the point is the index in this array divided by dim.
+     */
+    void build( const std::size_t dim,
+                const std::vector< double > & coords );
+
+    /*!
+      \brief call the function for each point within the radius
+      \param point query point that has dim coordinates
+      \param radius search radius
+      \param func function called as func( id )
+     */
+    template < typename Func >
+    void forEachWithin( const double * point,
+                        const double radius,
+                        Func func ) const
+      {
+          if ( M_nodes.empty() )
+          {
+              return;
+          }
+
+          visit( 0, point, radius, radius * radius, func );
+      }
+
+    /*!
+      \brief get the ids of the points within the radius
+      \param point query point that has dim coordinates
+      \param radius search radius
+      \param result pointer to the result variable. the ids are in the tree order.
+     */
+    void findWithin( const double * point,
+                     const double radius,
+                     std::vector< std::size_t > * result ) const;
+
+private:
+
+    /*!
+      \brief create the node for the range and its descendants
+      \param begin first point in M_ids
+      \param end end of the points in M_ids
+      \param coords source coordinates
+      \return node index
+     */
+    int buildNode( const std::size_t begin,
+                   const std::size_t end,
+                   const std::vector< double > & coords );
+
+    /*!
+      \brief search the node recursively
+     */
+    template < typename Func >
+    void visit( const int index,
+                const double * point,
+                const double radius,
+                const double radius2,
+                Func & func ) const
+      {
+          const Node & node = M_nodes[index];
+
+          if ( node.left_ < 0 )
+          {
+              for ( std::size_t i = node.begin_; i < node.end_; ++i )
+              {
+                  const double * p = &M_coords[i * M_dim];
+                  double d2 = 0.0;
+                  for ( std::size_t d = 0; d < M_dim; ++d )
+                  {
+                      const double diff = p[d] - point[d];
+                      d2 += diff * diff;
+                  }
+
+                  if ( d2 <= radius2 )
+                  {
+                      func( M_ids[i] );
+                  }
+              }
+              return;
+          }
+
+          const double diff = point[node.axis_] - node.split_;
+          if ( diff <= radius )
+          {
+              visit( node.left_, point, radius, radius2, func );
+          }
+          if ( -diff <= radius )
+          {
+              visit( node.right_, point, radius, radius2, func );
+          }
+      }
+};
+
+}
+
+#endif
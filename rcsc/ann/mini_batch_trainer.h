@@ -0,0 +1,432 @@
+// -*-c++-*-
+
+/*!
+  \file mini_batch_trainer.h
+  \brief data parallel mini-batch trainer for the networks Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_ANN_MINI_BATCH_TRAINER_H
+#define RCSC_ANN_MINI_BATCH_TRAINER_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace rcsc {
+
+/*!
+  \class MiniBatchTrainer
+  \brief mini-batch trainer that accumulates the gradients on several threads.
+
+  Network is BPNetwork1, RBFNetwork or NGNet. It must provide input_type,
+  output_type, Gradient, initGradient(), accumulateGradient() and applyGradient().
+
+  The samples are read from the source function on the calling thread, so
+  the source may be the reader of the files written by rcg::BatchRunner jobs.
+  Each batch is divided into the chunks of CHUNK_SIZE samples, and the
+  gradients of the chunks are summed in the chunk order. The result depends
+  only on the seed, the batch size and the shuffle buffer size, not on the
+  number of threads.
+
+  \code
+  rcsc::MiniBatchTrainer< Net > trainer( 4 );
+  trainer.setBatchSize( 256 );
+  trainer.setShuffleBufferSize( 100000 );
+  trainer.setSeed( 1 );
+  for ( int epoch = 0; epoch < 10; ++epoch )
+  {
+      SampleReader reader( "samples.dat" );
+      trainer.train( net, [&]( Net::input_type * in, Net::output_type * out )
+                            { return reader.read( in, out ); } );
+  }
+  \endcode
+*/
+template < typename Network >
+class MiniBatchTrainer {
+public:
+
+    typedef typename Network::input_type input_type; //!< input data type
+    typedef typename Network::output_type output_type; //!< teacher data type
+    typedef typename Network::Gradient Gradient; //!< gradient type
+
+    /*!
+      \brief sample source. returns false if no more sample exists.
+     */
+    typedef std::function< bool( input_type *, output_type * ) > Source;
+
+    //! the number of samples accumulated by one job
+    static constexpr std::size_t CHUNK_SIZE = 16;
+
+    /*!
+      \struct Result
+      \brief statistics of train()
+     */
+    struct Result {
+        std::size_t samples_; //!< the number of trained samples
+        std::size_t batches_; //!< the number of weight updates
+        double total_error_; //!< summed squared error of the samples before each update
+    };
+
+private:
+
+    typedef std::pair< input_type, output_type > Sample;
+
+    int M_jobs; //!< the number of threads
+    std::size_t M_batch_size; //!< the number of samples for one update
+    std::size_t M_shuffle_size; //!< the size of the shuffle buffer
+    std::mt19937 M_engine; //!< random engine for the shuffle
+
+public:
+
+    /*!
+      \brief create the trainer
+      \param jobs the number of threads. 0 or a negative value means the number of hardware threads.
+     */
+    explicit
+    MiniBatchTrainer( const int jobs = 0 )
+        : M_jobs( jobs ),
+          M_batch_size( 32 ),
+          M_shuffle_size( 0 ),
+          M_engine( 0 )
+      {
+          if ( M_jobs <= 0 )
+          {
+              M_jobs = std::max( 1, static_cast< int >( std::thread::hardware_concurrency() ) );
+          }
+      }
+
+    /*!
+      \brief get the number of threads
+      \return thread count
+     */
+    int jobs() const
+      {
+          return M_jobs;
+      }
+
+    /*!
+      \brief get the batch size
+      \return the number of samples for one update
+     */
+    std::size_t batchSize() const
+      {
+          return M_batch_size;
+      }
+
+    /*!
+      \brief set the batch size
+      \param size the number of samples for one update. 1 means the per sample update.
+     */
+    void setBatchSize( const std::size_t size )
+      {
+          M_batch_size = std::max( static_cast< std::size_t >( 1 ), size );
+      }
+
+    /*!
+      \brief set the shuffle buffer size
+      \param size the number of buffered samples. 0 or 1 means the order of the source.
+
+      The next sample is chosen randomly from the buffer, and the buffer is
+      refilled from the source.
+     */
+    void setShuffleBufferSize( const std::size_t size )
+      {
+          M_shuffle_size = size;
+      }
+
+    /*!
+      \brief reset the random engine for the shuffle
+      \param seed new seed value
+     */
+    void setSeed( const std::uint32_t seed )
+      {
+          M_engine.seed( seed );
+      }
+
+    /*!
+      \brief train the network by all samples of the source
+      \param net trained network
+      \param source sample source
+      \return statistics of the training
+     */
+    Result train( Network & net,
+                  const Source & source );
+
+private:
+
+    /*!
+      \brief get the next sample through the shuffle buffer
+      \param source sample source
+      \param buffer shuffle buffer
+      \param source_end reference to the end flag of the source
+      \param sample pointer to the result variable
+      \return false if no more sample exists
+     */
+    bool nextSample( const Source & source,
+                     std::vector< Sample > & buffer,
+                     bool & source_end,
+                     Sample * sample );
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+template < typename Network >
+constexpr std::size_t MiniBatchTrainer< Network >::CHUNK_SIZE;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+template < typename Network >
+bool
+MiniBatchTrainer< Network >::nextSample( const Source & source,
+                                         std::vector< Sample > & buffer,
+                                         bool & source_end,
+                                         Sample * sample )
+{
+    if ( M_shuffle_size <= 1 )
+    {
+        if ( source_end
+             || ! source( &sample->first, &sample->second ) )
+        {
+            source_end = true;
+            return false;
+        }
+        return true;
+    }
+
+    while ( ! source_end
+            && buffer.size() < M_shuffle_size )
+    {
+        buffer.emplace_back();
+        if ( ! source( &buffer.back().first, &buffer.back().second ) )
+        {
+            buffer.pop_back();
+            source_end = true;
+        }
+    }
+
+    if ( buffer.empty() )
+    {
+        return false;
+    }
+
+    std::uniform_int_distribution< std::size_t > dst( 0, buffer.size() - 1 );
+    const std::size_t i = dst( M_engine );
+    std::swap( buffer[i], buffer.back() );
+    *sample = std::move( buffer.back() );
+    buffer.pop_back();
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+template < typename Network >
+typename MiniBatchTrainer< Network >::Result
+MiniBatchTrainer< Network >::train( Network & net,
+                                    const Source & source )
+{
+    Result result = { 0, 0, 0.0 };
+
+    const std::size_t max_chunks = ( M_batch_size + CHUNK_SIZE - 1 ) / CHUNK_SIZE;
+
+    std::vector< Sample > buffer;
+    std::vector< Sample > batch( M_batch_size );
+    std::vector< Gradient > chunk_grads( max_chunks );
+    std::vector< double > chunk_errors( max_chunks, 0.0 );
+    Gradient total;
+
+    bool source_end = false;
+
+    //
+    // job state. the chunks of the current batch are taken by generation.
+    //
+    std::mutex mtx;
+    std::condition_variable start_cond;
+    std::condition_variable done_cond;
+    std::size_t generation = 0;
+    std::size_t batch_size = 0;
+    std::size_t n_chunks = 0;
+    std::size_t next_chunk = 0;
+    std::size_t done_chunks = 0;
+    bool finished = false;
+
+    const auto run_chunks = [&]( const std::size_t gen )
+        {
+            while ( true )
+            {
+                std::size_t c = 0;
+                {
+                    std::lock_guard< std::mutex > lock( mtx );
+                    if ( gen != generation
+                         || next_chunk >= n_chunks )
+                    {
+                        return;
+                    }
+                    c = next_chunk++;
+                }
+
+                Gradient & grad = chunk_grads[c];
+                grad.clear();
+
+                double error = 0.0;
+                const std::size_t last = std::min( batch_size, ( c + 1 ) * CHUNK_SIZE );
+                for ( std::size_t i = c * CHUNK_SIZE; i < last; ++i )
+                {
+                    error += net.accumulateGradient( batch[i].first, batch[i].second, &grad );
+                }
+                chunk_errors[c] = error;
+
+                {
+                    std::lock_guard< std::mutex > lock( mtx );
+                    ++done_chunks;
+                }
+                done_cond.notify_one();
+            }
+        };
+
+    const auto worker = [&]()
+        {
+            std::size_t seen = 0;
+            while ( true )
+            {
+                {
+                    std::unique_lock< std::mutex > lock( mtx );
+                    start_cond.wait( lock, [&]() { return finished || generation != seen; } );
+                    if ( finished )
+                    {
+                        return;
+                    }
+                    seen = generation;
+                }
+                run_chunks( seen );
+            }
+        };
+
+    const std::size_t n_threads = std::min( max_chunks, static_cast< std::size_t >( M_jobs ) );
+
+    // the calling thread is also used as a worker.
+    std::vector< std::thread > threads;
+    if ( n_threads > 1 )
+    {
+        threads.reserve( n_threads - 1 );
+        for ( std::size_t t = 1; t < n_threads; ++t )
+        {
+            threads.emplace_back( worker );
+        }
+    }
+
+    const auto stop = [&]()
+        {
+            {
+                std::lock_guard< std::mutex > lock( mtx );
+                finished = true;
+            }
+            start_cond.notify_all();
+            for ( std::thread & t : threads )
+            {
+                t.join();
+            }
+        };
+
+    try
+    {
+        for ( Gradient & g : chunk_grads )
+        {
+            net.initGradient( &g );
+        }
+        net.initGradient( &total );
+
+        while ( true )
+        {
+            std::size_t n = 0;
+            while ( n < M_batch_size
+                    && nextSample( source, buffer, source_end, &batch[n] ) )
+            {
+                ++n;
+            }
+
+            if ( n == 0 )
+            {
+                break;
+            }
+
+            std::size_t gen = 0;
+            {
+                std::lock_guard< std::mutex > lock( mtx );
+                batch_size = n;
+                n_chunks = ( n + CHUNK_SIZE - 1 ) / CHUNK_SIZE;
+                next_chunk = 0;
+                done_chunks = 0;
+                gen = ++generation;
+            }
+            start_cond.notify_all();
+
+            run_chunks( gen );
+
+            {
+                std::unique_lock< std::mutex > lock( mtx );
+                done_cond.wait( lock, [&]() { return done_chunks == n_chunks; } );
+            }
+
+            // sum in the chunk order to get the same result for any number of threads.
+            total.clear();
+            for ( std::size_t c = 0; c < n_chunks; ++c )
+            {
+                total.add( chunk_grads[c] );
+                result.total_error_ += chunk_errors[c];
+            }
+
+            net.applyGradient( total, n );
+
+            result.samples_ += n;
+            ++result.batches_;
+        }
+    }
+    catch ( ... )
+    {
+        stop();
+        throw;
+    }
+
+    stop();
+    return result;
+}
+
+}
+
+#endif
@@ -0,0 +1,772 @@
+// -*-c++-*-
+
+/*!
+  \file mlp_network.cpp
+  \brief dense multi-layer perceptron Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "mlp_network.h"
+
+#include <algorithm>
+#include <fstream>
+#include <new>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace rcsc {
+
+constexpr std::size_t MLPNetwork::ALIGNMENT;
+
+namespace {
+
+//
+// binary network file format.
+// [BinaryHeader]
+// [BinaryLayer x layer_size]
+// for each layer, each array starts at the offset aligned to MLPNetwork::ALIGNMENT:
+//   [float x output_size] biases
+//   [float x output_size] scales (INT8 only)
+//   [float or int8 x input_size * output_size] weights in the input major order
+// all values are stored in the native byte order, and the padding bytes are 0.
+//
+
+const char BINARY_MAGIC[8] = { 'R', 'C', 'S', 'C', 'M', 'L', 'P', '\0' };
+const std::uint32_t BINARY_VERSION = 1;
+const std::uint32_t BINARY_BYTE_ORDER = 0x01020304;
+const std::uint32_t MAX_LAYER_SIZE = 64;
+
+struct BinaryHeader {
+    char magic_[8];
+    std::uint32_t version_;
+    std::uint32_t byte_order_;
+    std::uint32_t weight_type_;
+    std::uint32_t layer_size_;
+};
+
+struct BinaryLayer {
+    std::uint32_t input_size_;
+    std::uint32_t output_size_;
+    std::uint32_t activation_;
+    std::uint32_t padding_;
+};
+
+/*!
+  \struct LayerOffset
+  \brief byte offsets of the arrays of a layer in the image
+ */
+struct LayerOffset {
+    std::size_t biases_;
+    std::size_t scales_;
+    std::size_t weights_;
+};
+
+/*-------------------------------------------------------------------*/
+std::size_t
+align_offset( const std::size_t offset )
+{
+    return ( offset + MLPNetwork::ALIGNMENT - 1 ) / MLPNetwork::ALIGNMENT * MLPNetwork::ALIGNMENT;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief compute the offsets of all arrays
+  \param weight_type weight type
+  \param layers layer descriptions
+  \param offsets pointer to the result variable
+  \return the total byte size of the image
+ */
+std::size_t
+compute_layout( const MLPNetwork::WeightType weight_type,
+                const std::vector< BinaryLayer > & layers,
+                std::vector< LayerOffset > * offsets )
+{
+    const std::size_t weight_bytes = ( weight_type == MLPNetwork::INT8
+                                       ? sizeof( std::int8_t )
+                                       : sizeof( float ) );
+
+    offsets->clear();
+
+    std::size_t pos = align_offset( sizeof( BinaryHeader ) + sizeof( BinaryLayer ) * layers.size() );
+    for ( const BinaryLayer & l : layers )
+    {
+        LayerOffset o;
+        o.biases_ = pos;
+        pos = align_offset( pos + sizeof( float ) * l.output_size_ );
+
+        o.scales_ = 0;
+        if ( weight_type == MLPNetwork::INT8 )
+        {
+            o.scales_ = pos;
+            pos = align_offset( pos + sizeof( float ) * l.output_size_ );
+        }
+
+        o.weights_ = pos;
+        pos = align_offset( pos + weight_bytes * l.input_size_ * l.output_size_ );
+
+        offsets->push_back( o );
+    }
+
+    return pos;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief allocate the zero filled memory aligned to MLPNetwork::ALIGNMENT
+  \param size byte size
+  \return pointer to the memory
+ */
+std::shared_ptr< const char >
+allocate_image( const std::size_t size )
+{
+    char * buf = static_cast< char * >( ::operator new( size, std::align_val_t( MLPNetwork::ALIGNMENT ) ) );
+    std::memset( buf, 0, size );
+    return std::shared_ptr< const char >( buf,
+                                          []( const char * p )
+                                            {
+                                                ::operator delete( const_cast< char * >( p ),
+                                                                   std::align_val_t( MLPNetwork::ALIGNMENT ) );
+                                            } );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create the zero filled image with the header
+  \param weight_type weight type
+  \param layers layer descriptions
+  \param size pointer to the variable to store the image size
+  \return image data
+ */
+std::shared_ptr< const char >
+create_image( const MLPNetwork::WeightType weight_type,
+              const std::vector< BinaryLayer > & layers,
+              std::size_t * size )
+{
+    std::vector< LayerOffset > offsets;
+    *size = compute_layout( weight_type, layers, &offsets );
+
+    std::shared_ptr< const char > image = allocate_image( *size );
+    char * buf = const_cast< char * >( image.get() );
+
+    BinaryHeader header;
+    std::memset( &header, 0, sizeof( header ) );
+    std::memcpy( header.magic_, BINARY_MAGIC, sizeof( BINARY_MAGIC ) );
+    header.version_ = BINARY_VERSION;
+    header.byte_order_ = BINARY_BYTE_ORDER;
+    header.weight_type_ = static_cast< std::uint32_t >( weight_type );
+    header.layer_size_ = static_cast< std::uint32_t >( layers.size() );
+
+    std::memcpy( buf, &header, sizeof( header ) );
+    std::memcpy( buf + sizeof( header ), layers.data(), sizeof( BinaryLayer ) * layers.size() );
+
+    return image;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief load the whole file as read-only memory
+  \param filepath file path to read
+  \param size pointer to the variable to store the file size
+  \return pointer to the data. NULL if failed.
+ */
+std::shared_ptr< const char >
+load_binary_file( const std::string & filepath,
+                  std::size_t * size )
+{
+#ifdef HAVE_SYS_MMAN_H
+    const int fd = ::open( filepath.c_str(), O_RDONLY );
+    if ( fd < 0 )
+    {
+        return std::shared_ptr< const char >();
+    }
+
+    struct stat st;
+    if ( ::fstat( fd, &st ) != 0
+         || st.st_size <= 0 )
+    {
+        ::close( fd );
+        return std::shared_ptr< const char >();
+    }
+
+    const std::size_t length = static_cast< std::size_t >( st.st_size );
+    void * addr = ::mmap( nullptr, length, PROT_READ, MAP_SHARED, fd, 0 );
+    ::close( fd );
+
+    if ( addr == MAP_FAILED )
+    {
+        return std::shared_ptr< const char >();
+    }
+
+    *size = length;
+    return std::shared_ptr< const char >( static_cast< const char * >( addr ),
+                                          [length]( const char * p )
+                                            {
+                                                ::munmap( const_cast< char * >( p ), length );
+                                            } );
+#else
+    std::ifstream fin( filepath.c_str(), std::ios::binary | std::ios::ate );
+    if ( ! fin.is_open() )
+    {
+        return std::shared_ptr< const char >();
+    }
+
+    const std::streamsize length = fin.tellg();
+    if ( length <= 0 )
+    {
+        return std::shared_ptr< const char >();
+    }
+
+    // the arrays in the image must be aligned.
+    std::shared_ptr< const char > buf = allocate_image( static_cast< std::size_t >( length ) );
+    fin.seekg( 0 );
+    if ( ! fin.read( const_cast< char * >( buf.get() ), length ) )
+    {
+        return std::shared_ptr< const char >();
+    }
+
+    *size = static_cast< std::size_t >( length );
+    return buf;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief apply the activation function
+  \param activation activation function type
+  \param n the number of values
+  \param v values
+ */
+void
+activate( const MLPNetwork::Activation activation,
+          const std::size_t n,
+          float * v )
+{
+    switch ( activation ) {
+    case MLPNetwork::RELU:
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            v[i] = std::max( v[i], 0.0f );
+        }
+        break;
+    case MLPNetwork::SIGMOID:
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            v[i] = 1.0f / ( 1.0f + std::exp( -v[i] ) );
+        }
+        break;
+    case MLPNetwork::TANH:
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            v[i] = std::tanh( v[i] );
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief calculate the outputs of a float layer
+ */
+void
+propagate_float( const MLPNetwork::Layer & layer,
+                 const float * inputs,
+                 const std::size_t batch,
+                 float * outputs )
+{
+    const std::size_t n_in = layer.input_size_;
+    const std::size_t n_out = layer.output_size_;
+    const float * const bias = layer.biases_;
+    const float * const weights = layer.weights_;
+
+    for ( std::size_t b = 0; b < batch; ++b )
+    {
+        const float * const x = inputs + b * n_in;
+        float * const y = outputs + b * n_out;
+
+        std::copy( bias, bias + n_out, y );
+
+        // the output units are updated by one input value.
+        // this loop has no reduction, so it is vectorized.
+        for ( std::size_t i = 0; i < n_in; ++i )
+        {
+            const float xi = x[i];
+            const float * const w = weights + i * n_out;
+            for ( std::size_t o = 0; o < n_out; ++o )
+            {
+                y[o] += xi * w[o];
+            }
+        }
+
+        activate( layer.activation_, n_out, y );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief calculate the outputs of an int8 layer
+ */
+void
+propagate_int8( const MLPNetwork::Layer & layer,
+                const float * inputs,
+                const std::size_t batch,
+                float * outputs )
+{
+    const std::size_t n_in = layer.input_size_;
+    const std::size_t n_out = layer.output_size_;
+    const float * const bias = layer.biases_;
+    const float * const scale = layer.scales_;
+    const std::int8_t * const weights = layer.qweights_;
+
+    for ( std::size_t b = 0; b < batch; ++b )
+    {
+        const float * const x = inputs + b * n_in;
+        float * const y = outputs + b * n_out;
+
+        std::fill( y, y + n_out, 0.0f );
+
+        for ( std::size_t i = 0; i < n_in; ++i )
+        {
+            const float xi = x[i];
+            const std::int8_t * const w = weights + i * n_out;
+            for ( std::size_t o = 0; o < n_out; ++o )
+            {
+                y[o] += xi * static_cast< float >( w[o] );
+            }
+        }
+
+        for ( std::size_t o = 0; o < n_out; ++o )
+        {
+            y[o] = y[o] * scale[o] + bias[o];
+        }
+
+        activate( layer.activation_, n_out, y );
+    }
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+MLPNetwork::MLPNetwork()
+    : M_weight_type( FLOAT32 ),
+      M_max_width( 0 ),
+      M_image_size( 0 ),
+      M_mutable_image( nullptr )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+MLPNetwork::create( const std::vector< std::size_t > & sizes,
+                    const Activation hidden,
+                    const Activation output )
+{
+    if ( sizes.size() < 2
+         || sizes.size() - 1 > MAX_LAYER_SIZE
+         || std::find( sizes.begin(), sizes.end(), 0 ) != sizes.end() )
+    {
+        std::cerr << "(MLPNetwork::create) ERROR: illegal layer sizes." << std::endl;
+        return false;
+    }
+
+    std::vector< BinaryLayer > layers;
+    for ( std::size_t i = 0; i + 1 < sizes.size(); ++i )
+    {
+        BinaryLayer l;
+        l.input_size_ = static_cast< std::uint32_t >( sizes[i] );
+        l.output_size_ = static_cast< std::uint32_t >( sizes[i + 1] );
+        l.activation_ = static_cast< std::uint32_t >( i + 2 == sizes.size() ? output : hidden );
+        l.padding_ = 0;
+        layers.push_back( l );
+    }
+
+    std::size_t size = 0;
+    std::shared_ptr< const char > image = create_image( FLOAT32, layers, &size );
+
+    if ( ! readBinary( image, size ) )
+    {
+        return false;
+    }
+
+    M_mutable_image = const_cast< char * >( image.get() );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+MLPNetwork::quantize( MLPNetwork * result ) const
+{
+    if ( M_weight_type != FLOAT32
+         || M_layers.empty() )
+    {
+        return false;
+    }
+
+    std::vector< BinaryLayer > layers;
+    for ( const Layer & l : M_layers )
+    {
+        BinaryLayer b;
+        b.input_size_ = static_cast< std::uint32_t >( l.input_size_ );
+        b.output_size_ = static_cast< std::uint32_t >( l.output_size_ );
+        b.activation_ = static_cast< std::uint32_t >( l.activation_ );
+        b.padding_ = 0;
+        layers.push_back( b );
+    }
+
+    std::size_t size = 0;
+    std::shared_ptr< const char > image = create_image( INT8, layers, &size );
+
+    std::vector< LayerOffset > offsets;
+    compute_layout( INT8, layers, &offsets );
+
+    char * const buf = const_cast< char * >( image.get() );
+    for ( std::size_t k = 0; k < M_layers.size(); ++k )
+    {
+        const Layer & src = M_layers[k];
+        const std::size_t n_in = src.input_size_;
+        const std::size_t n_out = src.output_size_;
+
+        float * const bias = reinterpret_cast< float * >( buf + offsets[k].biases_ );
+        float * const scale = reinterpret_cast< float * >( buf + offsets[k].scales_ );
+        std::int8_t * const weights = reinterpret_cast< std::int8_t * >( buf + offsets[k].weights_ );
+
+        std::copy( src.biases_, src.biases_ + n_out, bias );
+
+        // symmetric quantization with the scale of each output unit
+        for ( std::size_t o = 0; o < n_out; ++o )
+        {
+            float max_abs = 0.0f;
+            for ( std::size_t i = 0; i < n_in; ++i )
+            {
+                max_abs = std::max( max_abs, std::fabs( src.weights_[i * n_out + o] ) );
+            }
+
+            scale[o] = ( max_abs > 0.0f ? max_abs / 127.0f : 1.0f );
+            for ( std::size_t i = 0; i < n_in; ++i )
+            {
+                const float q = std::round( src.weights_[i * n_out + o] / scale[o] );
+                weights[i * n_out + o] = static_cast< std::int8_t >( std::min( 127.0f, std::max( -127.0f, q ) ) );
+            }
+        }
+    }
+
+    return result->readBinary( image, size );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+float *
+MLPNetwork::mutableWeights( const std::size_t layer )
+{
+    if ( ! M_mutable_image
+         || M_weight_type != FLOAT32
+         || layer >= M_layers.size() )
+    {
+        return nullptr;
+    }
+
+    return reinterpret_cast< float * >( M_mutable_image
+                                        + ( reinterpret_cast< const char * >( M_layers[layer].weights_ )
+                                            - M_image.get() ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+float *
+MLPNetwork::mutableBiases( const std::size_t layer )
+{
+    if ( ! M_mutable_image
+         || M_weight_type != FLOAT32
+         || layer >= M_layers.size() )
+    {
+        return nullptr;
+    }
+
+    return reinterpret_cast< float * >( M_mutable_image
+                                        + ( reinterpret_cast< const char * >( M_layers[layer].biases_ )
+                                            - M_image.get() ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MLPNetwork::propagateBatch( const float * inputs,
+                            const std::size_t batch,
+                            float * outputs ) const
+{
+    if ( M_layers.empty()
+         || batch == 0 )
+    {
+        return;
+    }
+
+    // the intermediate values are kept in the per thread buffers.
+    thread_local std::vector< float > s_buffers[2];
+
+    const float * in = inputs;
+    for ( std::size_t k = 0; k < M_layers.size(); ++k )
+    {
+        const Layer & layer = M_layers[k];
+
+        float * out = outputs;
+        if ( k + 1 < M_layers.size() )
+        {
+            std::vector< float > & buf = s_buffers[k % 2];
+            buf.resize( batch * M_max_width );
+            out = buf.data();
+        }
+
+        if ( M_weight_type == INT8 )
+        {
+            propagate_int8( layer, in, batch, out );
+        }
+        else
+        {
+            propagate_float( layer, in, batch, out );
+        }
+
+        in = out;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+MLPNetwork::readBinary( const std::string & filepath )
+{
+    std::size_t size = 0;
+    std::shared_ptr< const char > data = load_binary_file( filepath, &size );
+    if ( ! data )
+    {
+        std::cerr << "(MLPNetwork::readBinary) ERROR: could not read the file " << filepath << std::endl;
+        return false;
+    }
+
+    return readBinary( data, size );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+MLPNetwork::readBinary( const std::shared_ptr< const char > & data,
+                        const std::size_t size )
+{
+    if ( ! data
+         || ! setupLayers( data.get(), size ) )
+    {
+        M_layers.clear();
+        M_max_width = 0;
+        M_image.reset();
+        M_image_size = 0;
+        M_mutable_image = nullptr;
+        return false;
+    }
+
+    M_image = data;
+    M_image_size = size;
+    M_mutable_image = nullptr;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+MLPNetwork::setupLayers( const char * data,
+                         const std::size_t size )
+{
+    if ( reinterpret_cast< std::uintptr_t >( data ) % ALIGNMENT != 0 )
+    {
+        std::cerr << "(MLPNetwork::setupLayers) ERROR: the image is not aligned." << std::endl;
+        return false;
+    }
+
+    BinaryHeader header;
+    if ( size < sizeof( header ) )
+    {
+        std::cerr << "(MLPNetwork::setupLayers) ERROR: too small data." << std::endl;
+        return false;
+    }
+    std::memcpy( &header, data, sizeof( header ) );
+
+    if ( std::memcmp( header.magic_, BINARY_MAGIC, sizeof( BINARY_MAGIC ) ) != 0
+         || header.version_ != BINARY_VERSION
+         || header.byte_order_ != BINARY_BYTE_ORDER
+         || ( header.weight_type_ != FLOAT32 && header.weight_type_ != INT8 )
+         || header.layer_size_ == 0
+         || header.layer_size_ > MAX_LAYER_SIZE
+         || size < sizeof( header ) + sizeof( BinaryLayer ) * header.layer_size_ )
+    {
+        std::cerr << "(MLPNetwork::setupLayers) ERROR: illegal header." << std::endl;
+        return false;
+    }
+
+    const WeightType weight_type = static_cast< WeightType >( header.weight_type_ );
+
+    std::vector< BinaryLayer > layers( header.layer_size_ );
+    std::memcpy( layers.data(), data + sizeof( header ), sizeof( BinaryLayer ) * layers.size() );
+
+    for ( std::size_t k = 0; k < layers.size(); ++k )
+    {
+        if ( layers[k].input_size_ == 0
+             || layers[k].output_size_ == 0
+             || layers[k].activation_ > TANH
+             || ( k > 0 && layers[k].input_size_ != layers[k - 1].output_size_ ) )
+        {
+            std::cerr << "(MLPNetwork::setupLayers) ERROR: illegal layer " << k << std::endl;
+            return false;
+        }
+    }
+
+    std::vector< LayerOffset > offsets;
+    if ( compute_layout( weight_type, layers, &offsets ) > size )
+    {
+        std::cerr << "(MLPNetwork::setupLayers) ERROR: too small data." << std::endl;
+        return false;
+    }
+
+    M_weight_type = weight_type;
+    M_layers.clear();
+    M_max_width = 0;
+    for ( std::size_t k = 0; k < layers.size(); ++k )
+    {
+        Layer l;
+        l.input_size_ = layers[k].input_size_;
+        l.output_size_ = layers[k].output_size_;
+        l.activation_ = static_cast< Activation >( layers[k].activation_ );
+        l.biases_ = reinterpret_cast< const float * >( data + offsets[k].biases_ );
+        l.scales_ = nullptr;
+        l.weights_ = nullptr;
+        l.qweights_ = nullptr;
+        if ( weight_type == INT8 )
+        {
+            l.scales_ = reinterpret_cast< const float * >( data + offsets[k].scales_ );
+            l.qweights_ = reinterpret_cast< const std::int8_t * >( data + offsets[k].weights_ );
+        }
+        else
+        {
+            l.weights_ = reinterpret_cast< const float * >( data + offsets[k].weights_ );
+        }
+
+        M_layers.push_back( l );
+        M_max_width = std::max( M_max_width, l.output_size_ );
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+MLPNetwork::writeBinary( std::ostream & os ) const
+{
+    if ( ! M_image )
+    {
+        std::cerr << "(MLPNetwork::writeBinary) ERROR: no network." << std::endl;
+        return false;
+    }
+
+    os.write( M_image.get(), M_image_size );
+    return static_cast< bool >( os );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+MLPNetwork::writeBinary( const std::string & filepath ) const
+{
+    const std::string tmp_path = filepath + ".tmp";
+
+    {
+        std::ofstream fout( tmp_path.c_str(), std::ios::binary | std::ios::trunc );
+        if ( ! fout.is_open() )
+        {
+            return false;
+        }
+
+        if ( ! writeBinary( fout ) )
+        {
+            std::remove( tmp_path.c_str() );
+            return false;
+        }
+
+        fout.flush();
+        if ( ! fout )
+        {
+            std::remove( tmp_path.c_str() );
+            return false;
+        }
+    }
+
+    if ( std::rename( tmp_path.c_str(), filepath.c_str() ) != 0 )
+    {
+        std::remove( tmp_path.c_str() );
+        return false;
+    }
+
+    return true;
+}
+
+}
@@ -0,0 +1,273 @@
+// -*-c++-*-
+
+/*!
+  \file mlp_network.h
+  \brief dense multi-layer perceptron Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_ANN_MLP_NETWORK_H
+#define RCSC_ANN_MLP_NETWORK_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <cstddef>
+#include <cstdint>
+
+namespace rcsc {
+
+/*!
+  \class MLPNetwork
+  \brief dense multi-layer perceptron for the inference of the trained evaluators.
+
+  The number of layers and their sizes are given at runtime. The weights
+  are stored as float or int8 values with the scale of each output unit.
+
+  All parameters are held in one memory image that is the same as the
+  binary file. readBinary() maps the file read-only, so the agent processes
+  on the same host share one physical copy of the weights through the page
+  cache. The image can also be published by SharedTableSegment and given to
+  readBinary( data, size ).
+
+  propagateBatch() evaluates many feature vectors in one call. The weights
+  of each layer are stored in the input major order, so that the innermost
+  loop updates the consecutive output units by one input value. This loop
+  has no reduction, and the compiler can vectorize it without reordering
+  the floating point additions.
+
+  \code
+  rcsc::MLPNetwork net;
+  if ( ! net.readBinary( "evaluator.mlp" ) ) { ... }
+  std::vector< float > features( n_candidates * net.inputSize() );
+  std::vector< float > values( n_candidates * net.outputSize() );
+  net.propagateBatch( features.data(), n_candidates, values.data() );
+  \endcode
+*/
+class MLPNetwork {
+public:
+
+    /*!
+      \enum Activation
+      \brief activation function of the layer
+    */
+    enum Activation {
+        LINEAR = 0,
+        RELU = 1,
+        SIGMOID = 2,
+        TANH = 3,
+    };
+
+    /*!
+      \enum WeightType
+      \brief element type of the weights
+    */
+    enum WeightType {
+        FLOAT32 = 0, //!< float weights
+        INT8 = 1, //!< int8 weights with the float scale of each output unit
+    };
+
+    /*!
+      \struct Layer
+      \brief parameters of the fully connected layer. the pointers refer to the image.
+    */
+    struct Layer {
+        std::size_t input_size_; //!< the number of inputs
+        std::size_t output_size_; //!< the number of outputs
+        Activation activation_; //!< activation function
+        const float * biases_; //!< [output_size]
+        const float * scales_; //!< [output_size] INT8 only. NULL for FLOAT32.
+        const float * weights_; //!< [input_size][output_size] FLOAT32 only
+        const std::int8_t * qweights_; //!< [input_size][output_size] INT8 only
+    };
+
+    //! the byte alignment of the parameter arrays in the image
+    static constexpr std::size_t ALIGNMENT = 32;
+
+private:
+
+    WeightType M_weight_type; //!< element type of the weights
+    std::vector< Layer > M_layers; //!< layers from the input side
+    std::size_t M_max_width; //!< the maximum number of units in a layer
+
+    std::shared_ptr< const char > M_image; //!< mapped file or owned memory
+    std::size_t M_image_size; //!< byte size of the image
+    char * M_mutable_image; //!< writable image created by create(). NULL if mapped.
+
+public:
+
+    /*!
+      \brief create an empty network
+    */
+    MLPNetwork();
+
+    /*!
+      \brief create the float network with zero weights
+      \param sizes the number of units of each layer, including the input and the output layers
+      \param hidden activation function of the hidden layers
+      \param output activation function of the output layer
+      \return false if the size is illegal
+    */
+    bool create( const std::vector< std::size_t > & sizes,
+                 const Activation hidden,
+                 const Activation output );
+
+    /*!
+      \brief create the int8 network from this float network
+      \param result pointer to the result variable
+      \return false if this network is not a float network
+    */
+    bool quantize( MLPNetwork * result ) const;
+
+    /*!
+      \brief check if the network has layers
+      \return true if no layer
+    */
+    bool empty() const
+      {
+          return M_layers.empty();
+      }
+
+    /*!
+      \brief get the weight type
+      \return weight type
+    */
+    WeightType weightType() const
+      {
+          return M_weight_type;
+      }
+
+    /*!
+      \brief get the layers
+      \return const reference to the layer container
+    */
+    const std::vector< Layer > & layers() const
+      {
+          return M_layers;
+      }
+
+    /*!
+      \brief get the number of inputs
+      \return input size. 0 if empty.
+    */
+    std::size_t inputSize() const
+      {
+          return ( M_layers.empty() ? 0 : M_layers.front().input_size_ );
+      }
+
+    /*!
+      \brief get the number of outputs
+      \return output size. 0 if empty.
+    */
+    std::size_t outputSize() const
+      {
+          return ( M_layers.empty() ? 0 : M_layers.back().output_size_ );
+      }
+
+    /*!
+      \brief get the writable weights of the float network created by create()
+      \param layer layer index
+      \return pointer to the [input_size][output_size] array. NULL if not writable.
+    */
+    float * mutableWeights( const std::size_t layer );
+
+    /*!
+      \brief get the writable biases of the float network created by create()
+      \param layer layer index
+      \return pointer to the [output_size] array. NULL if not writable.
+    */
+    float * mutableBiases( const std::size_t layer );
+
+    /*!
+      \brief calculate the output of one input vector
+      \param input [inputSize()] input values
+      \param output [outputSize()] result values
+    */
+    void propagate( const float * input,
+                    float * output ) const
+      {
+          propagateBatch( input, 1, output );
+      }
+
+    /*!
+      \brief calculate the outputs of the input vectors
+      \param inputs [batch][inputSize()] input values
+      \param batch the number of input vectors
+      \param outputs [batch][outputSize()] result values
+
+      This method can be called from several threads at the same time.
+    */
+    void propagateBatch( const float * inputs,
+                         const std::size_t batch,
+                         float * outputs ) const;
+
+    /*!
+      \brief map the binary file
+      \param filepath file path
+      \return true if successfully loaded
+    */
+    bool readBinary( const std::string & filepath );
+
+    /*!
+      \brief use the binary image in memory. the image is referred, not copied.
+      \param data image data aligned to ALIGNMENT at least
+      \param size byte size of the data
+      \return true if the image is valid
+    */
+    bool readBinary( const std::shared_ptr< const char > & data,
+                     const std::size_t size );
+
+    /*!
+      \brief write the binary image
+      \param os reference to the output stream
+      \return true if successfully written
+    */
+    bool writeBinary( std::ostream & os ) const;
+
+    /*!
+      \brief write the binary file. the file is replaced atomically.
+      \param filepath file path
+      \return true if successfully written
+    */
+    bool writeBinary( const std::string & filepath ) const;
+
+private:
+
+    /*!
+      \brief set the layer pointers to the image
+      \param data image data
+      \param size byte size of the image
+      \return false if the image is not valid
+    */
+    bool setupLayers( const char * data,
+                      const std::size_t size );
+};
+
+}
+
+#endif
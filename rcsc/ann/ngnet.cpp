@@ -98,7 +98,9 @@ NGNet::NGNet()
           M_alpha( 0.9 ),
           M_min_weight( -100.0 ),
           M_max_weight( 100.0 ),
-          M_initial_sigma( 100.0 )
+          M_initial_sigma( 100.0 ),
+          M_cutoff_epsilon( 0.0 ),
+          M_cutoff_radius( 0.0 )
 {
 
 }
@@ -106,6 +108,54 @@ NGNet::NGNet()
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+NGNet::setCutoffEpsilon( const double epsilon )
+{
+    M_cutoff_epsilon = std::max( 0.0, std::min( epsilon, 1.0 ) );
+    updateIndex();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+NGNet::updateIndex()
+{
+    M_index.clear();
+    M_cutoff_radius = 0.0;
+
+    if ( M_cutoff_epsilon <= 0.0
+         || M_units.empty() )
+    {
+        return;
+    }
+
+    std::vector< double > coords;
+    coords.reserve( M_units.size() * INPUT );
+
+    double max_sigma = 0.0;
+    for ( const Unit & unit : M_units )
+    {
+        coords.insert( coords.end(), unit.center_.begin(), unit.center_.end() );
+        max_sigma = std::max( max_sigma, std::fabs( unit.sigma_ ) );
+    }
+
+    // exp( -d^2 / ( 2 * sigma^2 ) ) < epsilon  <=>  d > sigma * sqrt( 2 * ln( 1 / epsilon ) )
+    M_cutoff_radius = max_sigma * std::sqrt( 2.0 * std::log( 1.0 / M_cutoff_epsilon ) );
+    M_index.build( INPUT, coords );
+
+    if ( 2.0 * M_cutoff_radius >= M_index.maxExtent() )
+    {
+        // the cutoff circle is wider than the unit distribution. few units can be skipped.
+        M_index.clear();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 NGNet::addCenter( const input_vector & center )
@@ -121,6 +171,7 @@ NGNet::addCenter( const input_vector & center )
 
     if ( MAX <= 1 )
     {
+        updateIndex();
         return;
     }
 
@@ -172,6 +223,8 @@ NGNet::addCenter( const input_vector & center )
         M_units[i].sigma_ = mean_sigma;
     }
 #endif
+
+    updateIndex();
 }
 
 /*-------------------------------------------------------------------*/
@@ -187,13 +240,45 @@ NGNet::propagate( const input_vector & input,
 
     double sum_unit_value = 0.0;
 
-    for ( const Unit & unit : M_units )
+    bool use_all = true;
+    if ( ! M_index.empty()
+         && M_index.size() == M_units.size() )
     {
-        const double unit_value = unit.calc( input );
-        sum_unit_value += unit_value;
-        for ( std::size_t i = 0; i < OUTPUT; ++ i )
+        std::size_t count = 0;
+        M_index.forEachWithin( input.data(), M_cutoff_radius,
+                               [&]( const std::size_t u )
+                                 {
+                                     const Unit & unit = M_units[u];
+                                     const double unit_value = unit.calc( input );
+                                     sum_unit_value += unit_value;
+                                     for ( std::size_t i = 0; i < OUTPUT; ++ i )
+                                     {
+                                         output[i] += unit_value * unit.weights_[i];
+                                     }
+                                     ++count;
+                                 } );
+
+        // the skipped units have less than ( M_units.size() - count ) * epsilon in total.
+        const double skipped_max = ( M_units.size() - count ) * M_cutoff_epsilon;
+        use_all = ( skipped_max > std::sqrt( M_cutoff_epsilon ) * sum_unit_value );
+
+        if ( use_all )
         {
-            output[i] += unit_value * unit.weights_[i];
+            std::fill( output.begin(), output.end(), 0.0 );
+            sum_unit_value = 0.0;
+        }
+    }
+
+    if ( use_all )
+    {
+        for ( const Unit & unit : M_units )
+        {
+            const double unit_value = unit.calc( input );
+            sum_unit_value += unit_value;
+            for ( std::size_t i = 0; i < OUTPUT; ++ i )
+            {
+                output[i] += unit_value * unit.weights_[i];
+            }
         }
     }
 
@@ -271,6 +356,93 @@ NGNet::train( const input_vector & input,
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+NGNet::initGradient( Gradient * grad ) const
+{
+    grad->weights_.resize( M_units.size() );
+    grad->clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+NGNet::accumulateGradient( const input_vector & input,
+                           const output_vector & teacher,
+                           Gradient * grad ) const
+{
+    std::vector< double > unit_values;
+    unit_values.reserve( M_units.size() );
+
+    output_vector output;
+    output.fill( 0.0 );
+
+    double sum_unit_value = 0.0;
+    for ( const Unit & unit : M_units )
+    {
+        const double unit_value = unit.calc( input );
+        unit_values.push_back( unit_value );
+        sum_unit_value += unit_value;
+        for ( std::size_t i = 0; i < OUTPUT; ++i )
+        {
+            output[i] += unit_value * unit.weights_[i];
+        }
+    }
+
+    double total_error = 0.0;
+    output_vector output_back;
+    for ( std::size_t i = 0; i < OUTPUT; ++i )
+    {
+        output_back[i] = teacher[i] - output[i] / sum_unit_value; // d_linear
+        total_error += output_back[i] * output_back[i];
+    }
+
+    for ( std::size_t u = 0; u < unit_values.size(); ++u )
+    {
+        for ( std::size_t i = 0; i < OUTPUT; ++i )
+        {
+            grad->weights_[u][i] += output_back[i] * ( unit_values[u] / sum_unit_value );
+        }
+    }
+
+    return total_error;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+NGNet::applyGradient( const Gradient & grad,
+                      const std::size_t n_samples )
+{
+    if ( n_samples == 0
+         || grad.weights_.size() != M_units.size() )
+    {
+        return;
+    }
+
+    const double eta = M_eta / n_samples;
+
+    for ( std::size_t u = 0; u < M_units.size(); ++u )
+    {
+        Unit & unit = M_units[u];
+        for ( std::size_t i = 0; i < OUTPUT; ++i )
+        {
+            unit.delta_weights_[i]
+                = eta * grad.weights_[u][i]
+                + M_alpha * unit.delta_weights_[i];
+
+            unit.weights_[i] += unit.delta_weights_[i];
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 bool
 NGNet::read( std::istream & is )
@@ -299,6 +471,7 @@ NGNet::read( std::istream & is )
         M_units.push_back( unit );
     }
 
+    updateIndex();
     return true;
 }
 
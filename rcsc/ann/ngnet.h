@@ -32,6 +32,8 @@
 #ifndef RCSC_ANN_NGNET_H
 #define RCSC_ANN_NGNET_H
 
+#include <rcsc/ann/center_index.h>
+
 #include <array>
 #include <vector>
 #include <iostream>
@@ -44,6 +46,13 @@ namespace rcsc {
 /*!
   \class NGNet
   \brief Normalized Gaussian Radial Basis Function Network
+
+  If the cutoff epsilon is set by setCutoffEpsilon(), propagate() uses the
+  k-d tree of the unit centers and skips the units whose activation value is
+  less than the epsilon. When the skipped units may have more than
+  sqrt(epsilon) of the summed activation, all units are used instead. So the
+  error of each output is less than 2 * sqrt(epsilon) * (maximum absolute weight).
+  The training methods always use all units.
 */
 class NGNet {
 public:
@@ -61,6 +70,45 @@ public:
     //! typedef of the output array type that uses fixed size
     typedef std::array< double, OUTPUT > output_vector;
 
+    //! input type for the generic trainer
+    typedef input_vector input_type;
+    //! output type for the generic trainer
+    typedef output_vector output_type;
+
+    /*!
+      \struct Gradient
+      \brief accumulated weight update directions of the samples
+     */
+    struct Gradient {
+        std::vector< output_vector > weights_; //!< for the weights of each unit
+
+        /*!
+          \brief set all values to 0
+         */
+        void clear()
+          {
+              for ( output_vector & w : weights_ )
+              {
+                  w.fill( 0.0 );
+              }
+          }
+
+        /*!
+          \brief add other gradient
+          \param other added gradient. must have the same size.
+         */
+        void add( const Gradient & other )
+          {
+              for ( std::size_t u = 0; u < weights_.size(); ++u )
+              {
+                  for ( std::size_t i = 0; i < OUTPUT; ++i )
+                  {
+                      weights_[u][i] += other.weights_[u][i];
+                  }
+              }
+          }
+    };
+
     /*!
       \struct Unit
       \brief radial basis function unit
@@ -125,6 +173,10 @@ private:
 
     std::vector< Unit > M_units; //!< container of the unit
 
+    double M_cutoff_epsilon; //!< activation threshold of the skipped units. 0 means no cutoff.
+    double M_cutoff_radius; //!< search radius of M_index
+    CenterIndex M_index; //!< k-d tree of the unit centers. empty if no cutoff.
+
 public:
 
     /*!
@@ -165,6 +217,24 @@ public:
           M_initial_sigma = initial_sigma;
       }
 
+    /*!
+      \brief set the activation threshold for propagate()
+      \param epsilon the units whose activation value is less than this value are skipped.
+      0 or a negative value means that all units are always used.
+
+      The cutoff is effective for many units, e.g. thousands of units.
+     */
+    void setCutoffEpsilon( const double epsilon );
+
+    /*!
+      \brief get the activation threshold for propagate()
+      \return epsilon value. 0 means no cutoff.
+     */
+    double cutoffEpsilon() const
+      {
+          return M_cutoff_epsilon;
+      }
+
     /*!
       \brief get the unit container
       \return const reference to the unit container
@@ -189,6 +259,35 @@ public:
     void propagate( const input_vector & input,
                     output_vector & output ) const;
 
+    /*!
+      \brief prepare the gradient variable for this network
+      \param grad pointer to the gradient variable. resized to the units and set to 0.
+     */
+    void initGradient( Gradient * grad ) const;
+
+    /*!
+      \brief add the weight update direction for the sample without updating the weights.
+      \param input input value
+      \param teacher teacher output value
+      \param grad pointer to the gradient variable prepared by initGradient()
+      \return summed squared error value before the update
+
+      This method can be called from several threads at the same time.
+     */
+    double accumulateGradient( const input_vector & input,
+                               const output_vector & teacher,
+                               Gradient * grad ) const;
+
+    /*!
+      \brief update the connection weights by the mean of the accumulated gradient
+      \param grad accumulated gradient
+      \param n_samples the number of accumulated samples
+
+      The update rule is same as train() with the mean direction of the samples.
+     */
+    void applyGradient( const Gradient & grad,
+                        const std::size_t n_samples );
+
     /*!
       \brief train this network with teacher signal
       \param input input value
@@ -219,6 +318,13 @@ public:
      */
     std::ostream & printUnits( std::ostream & os ) const;
 
+private:
+
+    /*!
+      \brief rebuild the center index and the search radius
+     */
+    void updateIndex();
+
 };
 
 }
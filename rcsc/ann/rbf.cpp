@@ -104,7 +104,9 @@ RBFNetwork::RBFNetwork( const std::size_t input_dim,
           M_alpha( 0.5 ),
           M_min_weight( -100.0 ),
           M_max_weight( 100.0 ),
-          M_initial_sigma( 100.0 )
+          M_initial_sigma( 100.0 ),
+          M_cutoff_epsilon( 0.0 ),
+          M_cutoff_radius( 0.0 )
 {
 
 }
@@ -112,6 +114,60 @@ RBFNetwork::RBFNetwork( const std::size_t input_dim,
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+RBFNetwork::setCutoffEpsilon( const double epsilon )
+{
+    M_cutoff_epsilon = std::max( 0.0, std::min( epsilon, 1.0 ) );
+    updateIndex();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+RBFNetwork::updateIndex()
+{
+    M_index.clear();
+    M_cutoff_radius = 0.0;
+
+    if ( M_cutoff_epsilon <= 0.0
+         || M_units.empty() )
+    {
+        return;
+    }
+
+    std::vector< double > coords;
+    coords.reserve( M_units.size() * M_input_dim );
+
+    double max_sigma = 0.0;
+    for ( const Unit & unit : M_units )
+    {
+        if ( unit.center_.size() != M_input_dim )
+        {
+            // Unit::dist2() returns 0 for the illegal center.
+            return;
+        }
+
+        coords.insert( coords.end(), unit.center_.begin(), unit.center_.end() );
+        max_sigma = std::max( max_sigma, std::fabs( unit.sigma_ ) );
+    }
+
+    // exp( -d^2 / ( 2 * sigma^2 ) ) < epsilon  <=>  d > sigma * sqrt( 2 * ln( 1 / epsilon ) )
+    M_cutoff_radius = max_sigma * std::sqrt( 2.0 * std::log( 1.0 / M_cutoff_epsilon ) );
+    M_index.build( M_input_dim, coords );
+
+    if ( 2.0 * M_cutoff_radius >= M_index.maxExtent() )
+    {
+        // the cutoff circle is wider than the unit distribution. few units can be skipped.
+        M_index.clear();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 RBFNetwork::addCenter( const input_vector & center )
@@ -127,6 +183,7 @@ RBFNetwork::addCenter( const input_vector & center )
 
     if ( MAX <= 1 )
     {
+        updateIndex();
         return;
     }
 
@@ -156,6 +213,8 @@ RBFNetwork::addCenter( const input_vector & center )
     {
         M_units[i].sigma_ = mean_sigma;
     }
+
+    updateIndex();
 }
 
 /*-------------------------------------------------------------------*/
@@ -181,6 +240,22 @@ RBFNetwork::propagate( const input_vector & input,
 
     const std::size_t OUTPUT = M_output_dim;
 
+    if ( ! M_index.empty()
+         && M_index.size() == M_units.size() )
+    {
+        M_index.forEachWithin( input.data(), M_cutoff_radius,
+                               [&]( const std::size_t u )
+                                 {
+                                     const Unit & unit = M_units[u];
+                                     const double unit_value = unit.calc( input );
+                                     for ( std::size_t i = 0; i < OUTPUT; ++i )
+                                     {
+                                         output[i] += unit_value * unit.weights_[i];
+                                     }
+                                 } );
+        return;
+    }
+
     for ( const Unit & unit : M_units )
     {
         const double unit_value = unit.calc( input );
@@ -275,6 +350,107 @@ RBFNetwork::train( const input_vector & input,
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+RBFNetwork::initGradient( Gradient * grad ) const
+{
+    grad->weights_.assign( M_units.size() * M_output_dim, 0.0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+RBFNetwork::accumulateGradient( const input_vector & input,
+                                const output_vector & teacher,
+                                Gradient * grad ) const
+{
+    if ( input.size() != M_input_dim )
+    {
+        std::cerr << __FILE__ << ":" << __LINE__
+                  << "  illegal input vector size. " << input.size()
+                  << "(input) != " << M_input_dim << "(required)"
+                  << std::endl;
+        return 0.0;
+    }
+
+    if ( teacher.size() != M_output_dim )
+    {
+        std::cerr << __FILE__ << ":" << __LINE__
+                  << "  illegal output vector size. " << teacher.size()
+                  << "(input) != " << M_output_dim << "(required)"
+                  << std::endl;
+        return 0.0;
+    }
+
+    const std::size_t OUTPUT = M_output_dim;
+
+    std::vector< double > unit_values;
+    unit_values.reserve( M_units.size() );
+
+    output_vector output_back( teacher );
+    for ( const Unit & unit : M_units )
+    {
+        const double unit_value = unit.calc( input );
+        unit_values.push_back( unit_value );
+        for ( std::size_t i = 0; i < OUTPUT; ++i )
+        {
+            output_back[i] -= unit_value * unit.weights_[i];
+        }
+    }
+
+    double total_error = 0.0;
+    for ( std::size_t i = 0; i < OUTPUT; ++i )
+    {
+        total_error += output_back[i] * output_back[i];
+    }
+
+    for ( std::size_t u = 0; u < unit_values.size(); ++u )
+    {
+        for ( std::size_t i = 0; i < OUTPUT; ++i )
+        {
+            grad->weights_[u * OUTPUT + i] += output_back[i] * unit_values[u];
+        }
+    }
+
+    return total_error;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+RBFNetwork::applyGradient( const Gradient & grad,
+                           const std::size_t n_samples )
+{
+    if ( n_samples == 0
+         || grad.weights_.size() != M_units.size() * M_output_dim )
+    {
+        return;
+    }
+
+    const std::size_t OUTPUT = M_output_dim;
+    const double eta = M_eta / n_samples;
+
+    for ( std::size_t u = 0; u < M_units.size(); ++u )
+    {
+        Unit & unit = M_units[u];
+        for ( std::size_t i = 0; i < OUTPUT; ++i )
+        {
+            unit.delta_weights_[i]
+                = eta * grad.weights_[u * OUTPUT + i]
+                + M_alpha * unit.delta_weights_[i];
+
+            unit.weights_[i] += unit.delta_weights_[i];
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 bool
 RBFNetwork::read( std::istream & is )
@@ -304,6 +480,7 @@ RBFNetwork::read( std::istream & is )
         M_units.push_back( unit );
     }
 
+    updateIndex();
     return true;
 }
 
@@ -32,9 +32,12 @@
 #ifndef RCSC_ANN_RBF_H
 #define RCSC_ANN_RBF_H
 
+#include <rcsc/ann/center_index.h>
+
 #include <boost/array.hpp>
 
 #include <vector>
+#include <algorithm>
 #include <iostream>
 #include <cmath>
 
@@ -45,6 +48,12 @@ namespace rcsc {
 /*!
   \class RBFNetwork
   \brief Radial Basis Function Network.
+
+  If the cutoff epsilon is set by setCutoffEpsilon(), propagate() uses the
+  k-d tree of the unit centers and skips the units whose activation value is
+  less than the epsilon. The error of each output is less than
+  epsilon * (sum of the absolute weights of the skipped units).
+  The training methods always use all units.
 */
 class RBFNetwork {
 public:
@@ -54,6 +63,39 @@ public:
     //! typedef of the output value container
     typedef std::vector< double > output_vector;
 
+    //! input type for the generic trainer
+    typedef input_vector input_type;
+    //! output type for the generic trainer
+    typedef output_vector output_type;
+
+    /*!
+      \struct Gradient
+      \brief accumulated weight update directions of the samples
+     */
+    struct Gradient {
+        std::vector< double > weights_; //!< [unit index * output dimension + output index]
+
+        /*!
+          \brief set all values to 0
+         */
+        void clear()
+          {
+              std::fill( weights_.begin(), weights_.end(), 0.0 );
+          }
+
+        /*!
+          \brief add other gradient
+          \param other added gradient. must have the same size.
+         */
+        void add( const Gradient & other )
+          {
+              for ( std::size_t i = 0; i < weights_.size(); ++i )
+              {
+                  weights_[i] += other.weights_[i];
+              }
+          }
+    };
+
     /*!
       \struct Unit
       \brief radial basis function unit
@@ -144,6 +186,10 @@ private:
 
     std::vector< Unit > M_units; //!< all units
 
+    double M_cutoff_epsilon; //!< activation threshold of the skipped units. 0 means no cutoff.
+    double M_cutoff_radius; //!< search radius of M_index
+    CenterIndex M_index; //!< k-d tree of the unit centers. empty if no cutoff.
+
     // not used
     RBFNetwork() = delete;
 
@@ -189,6 +235,24 @@ public:
           M_initial_sigma = initial_sigma;
       }
 
+    /*!
+      \brief set the activation threshold for propagate()
+      \param epsilon the units whose activation value is less than this value are skipped.
+      0 or a negative value means that all units are always used.
+
+      The cutoff is effective for many units, e.g. thousands of units.
+     */
+    void setCutoffEpsilon( const double epsilon );
+
+    /*!
+      \brief get the activation threshold for propagate()
+      \return epsilon value. 0 means no cutoff.
+     */
+    double cutoffEpsilon() const
+      {
+          return M_cutoff_epsilon;
+      }
+
     /*!
       \brief get the unit container
       \return const reference to the unit container
@@ -213,6 +277,35 @@ public:
     void propagate( const input_vector & input,
                     output_vector & output ) const;
 
+    /*!
+      \brief prepare the gradient variable for this network
+      \param grad pointer to the gradient variable. resized to the units and set to 0.
+     */
+    void initGradient( Gradient * grad ) const;
+
+    /*!
+      \brief add the weight update direction for the sample without updating the weights.
+      \param input input value
+      \param teacher teacher output value
+      \param grad pointer to the gradient variable prepared by initGradient()
+      \return summed squared error value before the update
+
+      This method can be called from several threads at the same time.
+     */
+    double accumulateGradient( const input_vector & input,
+                               const output_vector & teacher,
+                               Gradient * grad ) const;
+
+    /*!
+      \brief update the connection weights by the mean of the accumulated gradient
+      \param grad accumulated gradient
+      \param n_samples the number of accumulated samples
+
+      The update rule is same as train() with the mean direction of the samples.
+     */
+    void applyGradient( const Gradient & grad,
+                        const std::size_t n_samples );
+
     /*!
       \brief train the connection weight
       \param input input value
@@ -243,6 +336,13 @@ public:
      */
     std::ostream & printUnits( std::ostream & os ) const;
 
+private:
+
+    /*!
+      \brief rebuild the center index and the search radius
+     */
+    void updateIndex();
+
 };
 
 }
@@ -95,6 +95,30 @@ public:
     void setWeight( const double weight );
 
     double weight();
+
+    //! get the number of fuzzy rules
+    int numPartitions() const
+      {
+          return M_num_partitions;
+      }
+
+    //! get the means of the antecedent fuzzy sets
+    const std::vector< double > & antecedentMeans() const
+      {
+          return M_a;
+      }
+
+    //! get the variances of the antecedent fuzzy sets
+    const std::vector< double > & antecedentVariances() const
+      {
+          return M_b;
+      }
+
+    //! get the consequent outputs
+    const std::vector< double > & consequents() const
+      {
+          return M_c;
+      }
 };
 
 }
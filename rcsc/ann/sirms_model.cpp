@@ -32,10 +32,14 @@
 
 #include "sirm.h"
 
+#include <algorithm>
 #include <iostream>
+#include <cmath>
 
 namespace rcsc {
 
+constexpr std::size_t SIRMsModel::BATCH_BLOCK;
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -45,6 +49,44 @@ SIRMsModel::SIRMsModel( int num_sirms ):
 {
     M_sirm.clear();
     M_sirm.resize( M_num_sirms );
+
+    updateRules();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SIRMsModel::updateRules()
+{
+    M_rule_begin.clear();
+    M_rule_a.clear();
+    M_rule_b.clear();
+    M_rule_c.clear();
+    M_module_weight.clear();
+
+    M_rule_begin.reserve( M_sirm.size() + 1 );
+    M_module_weight.reserve( M_sirm.size() );
+
+    for ( SIRM & sirm : M_sirm )
+    {
+        M_rule_begin.push_back( M_rule_a.size() );
+        M_module_weight.push_back( sirm.weight() );
+
+        const std::size_t n = std::max( 0, sirm.numPartitions() );
+        M_rule_a.insert( M_rule_a.end(),
+                         sirm.antecedentMeans().begin(),
+                         sirm.antecedentMeans().begin() + n );
+        M_rule_b.insert( M_rule_b.end(),
+                         sirm.antecedentVariances().begin(),
+                         sirm.antecedentVariances().begin() + n );
+        M_rule_c.insert( M_rule_c.end(),
+                         sirm.consequents().begin(),
+                         sirm.consequents().begin() + n );
+    }
+
+    M_rule_begin.push_back( M_rule_a.size() );
 }
 
 /*-------------------------------------------------------------------*/
@@ -92,6 +134,139 @@ SIRMsModel::calculateOutput( const std::vector< double > & input )
     return result;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+SIRMsModel::evaluate( const std::vector< double > & input ) const
+{
+    const std::size_t n_modules = M_module_weight.size();
+
+    if ( input.size() < n_modules )
+    {
+        std::cerr << __FILE__ << ' ' << __LINE__
+                  << ": illegal input size " << input.size() << std::endl;
+        return 0.0;
+    }
+
+    double result = 0.0;
+
+    for ( std::size_t m = 0; m < n_modules; ++m )
+    {
+        const double x = input[m];
+
+        double numerator = 0.0;
+        double denominator = 0.0;
+        for ( std::size_t r = M_rule_begin[m]; r < M_rule_begin[m + 1]; ++r )
+        {
+            const double d = x - M_rule_a[r];
+            const double membership = std::exp( - d * d / M_rule_b[r] );
+
+            numerator += membership * M_rule_c[r];
+            denominator += membership;
+        }
+
+        result += M_module_weight[m] * ( numerator / denominator );
+    }
+
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SIRMsModel::calculateOutputs( const std::vector< std::vector< double > > & inputs,
+                              std::vector< double > * outputs ) const
+{
+    const std::size_t n = inputs.size();
+    const std::size_t n_modules = M_module_weight.size();
+
+    outputs->resize( n );
+
+    std::size_t k = 0;
+
+    for ( ; k + BATCH_BLOCK <= n; k += BATCH_BLOCK )
+    {
+        bool valid = true;
+        for ( std::size_t j = 0; j < BATCH_BLOCK; ++j )
+        {
+            if ( inputs[k + j].size() < n_modules )
+            {
+                valid = false;
+                break;
+            }
+        }
+
+        if ( ! valid )
+        {
+            for ( std::size_t j = 0; j < BATCH_BLOCK; ++j )
+            {
+                (*outputs)[k + j] = evaluate( inputs[k + j] );
+            }
+            continue;
+        }
+
+        double result[BATCH_BLOCK];
+        double x[BATCH_BLOCK];
+        double membership[BATCH_BLOCK];
+        double numerator[BATCH_BLOCK];
+        double denominator[BATCH_BLOCK];
+
+        std::fill( result, result + BATCH_BLOCK, 0.0 );
+
+        for ( std::size_t m = 0; m < n_modules; ++m )
+        {
+            for ( std::size_t j = 0; j < BATCH_BLOCK; ++j )
+            {
+                x[j] = inputs[k + j][m];
+            }
+
+            std::fill( numerator, numerator + BATCH_BLOCK, 0.0 );
+            std::fill( denominator, denominator + BATCH_BLOCK, 0.0 );
+
+            for ( std::size_t r = M_rule_begin[m]; r < M_rule_begin[m + 1]; ++r )
+            {
+                const double a = M_rule_a[r];
+                const double b = M_rule_b[r];
+                const double c = M_rule_c[r];
+
+                for ( std::size_t j = 0; j < BATCH_BLOCK; ++j )
+                {
+                    const double d = x[j] - a;
+                    membership[j] = - d * d / b;
+                }
+
+                for ( std::size_t j = 0; j < BATCH_BLOCK; ++j )
+                {
+                    membership[j] = std::exp( membership[j] );
+                }
+
+                for ( std::size_t j = 0; j < BATCH_BLOCK; ++j )
+                {
+                    numerator[j] += membership[j] * c;
+                    denominator[j] += membership[j];
+                }
+            }
+
+            const double w = M_module_weight[m];
+            for ( std::size_t j = 0; j < BATCH_BLOCK; ++j )
+            {
+                result[j] += w * ( numerator[j] / denominator[j] );
+            }
+        }
+
+        std::copy( result, result + BATCH_BLOCK, outputs->begin() + k );
+    }
+
+    for ( ; k < n; ++k )
+    {
+        (*outputs)[k] = evaluate( inputs[k] );
+    }
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -101,6 +276,7 @@ SIRMsModel::specifyNumPartitions( const int index_module,
                                   const int num_partitions )
 {
     M_sirm[index_module].setNumPartitions( num_partitions );
+    updateRules();
 }
 
 /*-------------------------------------------------------------------*/
@@ -121,6 +297,8 @@ SIRMsModel::train( const double target,
 
         it->trainSIRM( target, actual );
     }
+
+    updateRules();
 }
 
 /*-------------------------------------------------------------------*/
@@ -133,6 +311,7 @@ SIRMsModel::specifyDomain( const int index_attribute,
                            const double max_domain )
 {
     M_sirm[index_attribute].setDomain( min_domain, max_domain );
+    updateRules();
 }
 
 /*-------------------------------------------------------------------*/
@@ -168,10 +347,12 @@ SIRMsModel::loadParameters( const std::string & prefix )
     {
         if ( ! it->loadParameters( prefix ) )
         {
+            updateRules();
             return false;
         }
     }
 
+    updateRules();
     return true;
 }
 
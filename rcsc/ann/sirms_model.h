@@ -39,9 +39,28 @@ class SIRM;
   \class SIRMsModel
 */
 class SIRMsModel {
+public:
+
+    //! the number of inputs evaluated together by calculateOutputs()
+    static constexpr std::size_t BATCH_BLOCK = 32;
+
 private:
     int M_num_sirms;
     std::vector< SIRM > M_sirm;
+
+    //
+    // flattened parameters of all modules for the const evaluation.
+    // the rules of the module i are [M_rule_begin[i], M_rule_begin[i+1]).
+    //
+    std::vector< std::size_t > M_rule_begin; //!< first rule index of each module
+    std::vector< double > M_rule_a; //!< means of the antecedent fuzzy sets
+    std::vector< double > M_rule_b; //!< variances of the antecedent fuzzy sets
+    std::vector< double > M_rule_c; //!< consequent outputs
+    std::vector< double > M_module_weight; //!< weight of each module
+
+    //! copy the parameters of the modules to the flattened arrays
+    void updateRules();
+
 public:
 
     explicit
@@ -59,6 +78,26 @@ public:
     /*! calculate an output for an input vector */
     double calculateOutput( const std::vector< double > & input );
 
+    /*!
+      \brief calculate an output by the flattened parameters without changing the training state
+      \param input input vector that has numSIRMs() values
+      \return same value as calculateOutput()
+
+      This method can be called from several threads at the same time.
+     */
+    double evaluate( const std::vector< double > & input ) const;
+
+    /*!
+      \brief calculate the outputs for many input vectors
+      \param inputs input vectors. each one must have numSIRMs() values.
+      \param outputs pointer to the result variable. resized to inputs.size().
+
+      The inputs are evaluated in the blocks of BATCH_BLOCK inputs rule by
+      rule, and the results are same as evaluate().
+     */
+    void calculateOutputs( const std::vector< std::vector< double > > & inputs,
+                           std::vector< double > * outputs ) const;
+
     /*! specify the number of fuzzy partitions of an SIRM */
     void specifyNumPartitions( const int index_module,
                                const int num_partitions );
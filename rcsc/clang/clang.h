@@ -33,6 +33,7 @@
 #define RCSC_CLANG_CLANG_H
 
 #include <rcsc/clang/clang_action.h>
+#include <rcsc/clang/clang_arena.h>
 #include <rcsc/clang/clang_condition.h>
 #include <rcsc/clang/clang_directive.h>
 #include <rcsc/clang/clang_info_message.h>
@@ -36,6 +36,7 @@
 
 #include <memory>
 #include <vector>
+#include <utility>
 #include <iosfwd>
 
 namespace rcsc {
@@ -159,6 +160,15 @@ public:
         : M_target_players( players )
       { }
 
+    /*!
+      \brief create with target players
+      \param players shared target players.
+     */
+    explicit
+    CLangActionMark( CLangUnumSet::Ptr players )
+        : M_target_players( std::move( players ) )
+      { }
+
     // ~CLangActionMark()
     //   {
     //       std::cerr << "delete CLangActionMark " << *M_target_players << std::endl;
@@ -339,6 +349,15 @@ public:
         : M_assigned_players( players )
       { }
 
+    /*!
+      \brief create with the specified assigned player.
+      \param players shared assigned players.
+     */
+    explicit
+    CLangActionBallTo( CLangUnumSet::Ptr players )
+        : M_assigned_players( std::move( players ) )
+      { }
+
     // ~CLangActionBallTo()
     //   {
     //       std::cerr << "delete CLangActionBallTo " << M_player_unum << std::endl;
@@ -0,0 +1,106 @@
+// -*-c++-*-
+
+/*!
+  \file clang_arena.cpp
+  \brief memory arena for clang objects Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "clang_arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace rcsc {
+
+constexpr std::size_t CLangArena::DEFAULT_BLOCK_SIZE;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CLangArena::CLangArena( const std::size_t block_size )
+    : M_block_size( block_size ),
+      M_pos( nullptr ),
+      M_end( nullptr ),
+      M_used( 0 ),
+      M_ref_count( 1 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CLangArena::Ptr
+CLangArena::create( const std::size_t block_size )
+{
+    // the deleter releases the reference of the arena pointer.
+    return Ptr( new CLangArena( block_size ),
+                []( CLangArena * arena )
+                  {
+                      arena->release();
+                  } );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void *
+CLangArena::allocate( const std::size_t size,
+                      const std::size_t align )
+{
+    std::uintptr_t p = reinterpret_cast< std::uintptr_t >( M_pos );
+    p = ( p + align - 1 ) & ~static_cast< std::uintptr_t >( align - 1 );
+
+    if ( ! M_pos
+         || p + size > reinterpret_cast< std::uintptr_t >( M_end ) )
+    {
+        // a large object gets its own block.
+        const std::size_t block_size = std::max( M_block_size, size + align );
+
+        M_blocks.emplace_back( new unsigned char[block_size] );
+        M_pos = M_blocks.back().get();
+        M_end = M_pos + block_size;
+
+        p = reinterpret_cast< std::uintptr_t >( M_pos );
+        p = ( p + align - 1 ) & ~static_cast< std::uintptr_t >( align - 1 );
+    }
+
+    M_pos = reinterpret_cast< unsigned char * >( p + size );
+    M_used += size;
+    M_ref_count.fetch_add( 1, std::memory_order_relaxed );
+
+    return reinterpret_cast< void * >( p );
+}
+
+}
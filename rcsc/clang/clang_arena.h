@@ -0,0 +1,206 @@
+// -*-c++-*-
+
+/*!
+  \file clang_arena.h
+  \brief memory arena for clang objects Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_CLANG_ARENA_H
+#define RCSC_CLANG_ARENA_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+namespace rcsc {
+
+/*!
+  \class CLangArena
+  \brief bump pointer memory arena for the nodes of one clang message.
+
+  The nodes are created by construct() and are held by the ordinary smart
+  pointers of the clang classes. The object and its reference counter are
+  placed in the arena memory, and each allocation keeps the arena alive.
+  The memory of a node is never reused. All blocks are released at once
+  when the last node and the last arena pointer are destroyed.
+
+  Nodes created by one message are placed next to each other in the order
+  of construction.
+
+  This class is not thread safe.
+ */
+class CLangArena {
+public:
+
+    //! smart pointer type
+    typedef std::shared_ptr< CLangArena > Ptr;
+
+    //! default block size
+    static constexpr std::size_t DEFAULT_BLOCK_SIZE = 4096;
+
+    /*!
+      \class Allocator
+      \brief allocator type used by std::allocate_shared.
+     */
+    template < typename T >
+    class Allocator {
+    private:
+        template < typename U > friend class Allocator;
+
+        CLangArena * M_arena; //!< memory owner
+
+    public:
+        typedef T value_type;
+
+        explicit
+        Allocator( CLangArena * arena )
+            : M_arena( arena )
+          { }
+
+        template < typename U >
+        Allocator( const Allocator< U > & other )
+            : M_arena( other.M_arena )
+          { }
+
+        T * allocate( const std::size_t n )
+          {
+              return static_cast< T * >( M_arena->allocate( n * sizeof( T ), alignof( T ) ) );
+          }
+
+        void deallocate( T *,
+                         const std::size_t )
+          {
+              // the memory itself is released with the arena.
+              M_arena->release();
+          }
+
+        template < typename U >
+        bool operator==( const Allocator< U > & other ) const
+          {
+              return M_arena == other.M_arena;
+          }
+
+        template < typename U >
+        bool operator!=( const Allocator< U > & other ) const
+          {
+              return M_arena != other.M_arena;
+          }
+    };
+
+private:
+
+    std::size_t M_block_size; //!< size of the normal block
+    std::vector< std::unique_ptr< unsigned char[] > > M_blocks; //!< allocated blocks
+    unsigned char * M_pos; //!< the first free byte in the current block
+    unsigned char * M_end; //!< end of the current block
+    std::size_t M_used; //!< total allocated bytes
+
+    //! the number of live allocations and arena pointers
+    std::atomic< std::size_t > M_ref_count;
+
+    /*!
+      \brief create an empty arena. use create().
+      \param block_size size of the normal block
+     */
+    explicit
+    CLangArena( const std::size_t block_size );
+
+    /*!
+      \brief destructor. called only by release().
+     */
+    ~CLangArena() = default;
+
+    // not used
+    CLangArena( const CLangArena & ) = delete;
+    CLangArena & operator=( const CLangArena & ) = delete;
+
+    /*!
+      \brief decrement the reference count. the arena is deleted at the last release.
+     */
+    void release()
+      {
+          if ( M_ref_count.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+          {
+              delete this;
+          }
+      }
+
+public:
+
+    /*!
+      \brief create a new arena object
+      \param block_size size of the normal block
+      \return smart pointer to the arena
+     */
+    static
+    Ptr create( const std::size_t block_size = DEFAULT_BLOCK_SIZE );
+
+    /*!
+      \brief allocate raw memory. the arena is alive until the memory is deallocated.
+      \param size byte size
+      \param align alignment of the memory
+      \return pointer to the allocated memory
+     */
+    void * allocate( const std::size_t size,
+                     const std::size_t align );
+
+    /*!
+      \brief create a new object in this arena
+      \param args arguments of the constructor of T
+      \return smart pointer to the created object
+     */
+    template < typename T, typename... Args >
+    std::shared_ptr< T > construct( Args &&... args )
+      {
+          return std::allocate_shared< T >( Allocator< T >( this ),
+                                            std::forward< Args >( args )... );
+      }
+
+    /*!
+      \brief get the total allocated bytes
+      \return byte size
+     */
+    std::size_t usedSize() const
+      {
+          return M_used;
+      }
+
+    /*!
+      \brief get the number of allocated blocks
+      \return block count
+     */
+    std::size_t blockCount() const
+      {
+          return M_blocks.size();
+      }
+};
+
+}
+
+#endif
@@ -36,6 +36,7 @@
 
 #include <memory>
 #include <vector>
+#include <utility>
 #include <iosfwd>
 
 namespace rcsc {
@@ -173,6 +174,15 @@ public:
           M_players = CLangUnumSet::Ptr( players );
       }
 
+    /*!
+      \brief set target players.
+      \param players new target player set
+     */
+    void setPlayers( CLangUnumSet::Ptr players )
+      {
+          M_players = std::move( players );
+      }
+
     /*!
       \brief add target player
       \param unum target player's uniform number
@@ -192,6 +202,15 @@ public:
           M_actions.push_back( CLangAction::ConstPtr( act ) );
       }
 
+    /*!
+      \brief add new action.
+      \param act action object
+     */
+    void addAction( CLangAction::ConstPtr act )
+      {
+          M_actions.push_back( std::move( act ) );
+      }
+
     //
     //
     //
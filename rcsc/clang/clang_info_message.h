@@ -35,6 +35,8 @@
 #include <rcsc/clang/clang_message.h>
 #include <rcsc/clang/clang_token.h>
 
+#include <utility>
+
 namespace rcsc {
 
 /*!
@@ -95,6 +97,15 @@ public:
           M_tokens.push_back( CLangToken::ConstPtr( tok ) );
       }
 
+    /*!
+      \brief add new token.
+      \param tok new token object.
+     */
+    void addToken( CLangToken::ConstPtr tok )
+      {
+          M_tokens.push_back( std::move( tok ) );
+      }
+
     /*!
       \brief print clang message to the output stream
       \param os reference to the output stream
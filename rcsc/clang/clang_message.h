@@ -32,6 +32,7 @@
 #ifndef RCSC_CLANG_MESSAGE_H
 #define RCSC_CLANG_MESSAGE_H
 
+#include <rcsc/clang/clang_arena.h>
 #include <rcsc/clang/types.h>
 
 #include <memory>
@@ -54,6 +55,9 @@ public:
 
 private:
 
+    //! memory arena for the nodes of this message. created on demand.
+    CLangArena::Ptr M_arena;
+
     // not used
     CLangMessage( const CLangMessage & ) = delete;
     CLangMessage & operator=( const CLangMessage & ) = delete;
@@ -97,6 +101,18 @@ public:
     virtual
     std::ostream & print( std::ostream & os ) const = 0;
 
+    /*!
+      \brief get the memory arena for the nodes of this message.
+      \return smart pointer to the arena. created at the first call.
+
+      The nodes created by arena()->construct< T >() are released
+      together with this message.
+     */
+    const CLangArena::Ptr & arena()
+      {
+          if ( ! M_arena ) M_arena = CLangArena::create();
+          return M_arena;
+      }
 };
 
 }
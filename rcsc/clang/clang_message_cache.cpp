@@ -0,0 +1,216 @@
+// -*-c++-*-
+
+/*!
+  \file clang_message_cache.cpp
+  \brief cache of the parsed clang messages Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "clang_message_cache.h"
+
+namespace rcsc {
+
+constexpr std::size_t CLangMessageCache::DEFAULT_CAPACITY;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CLangMessageCache::CLangMessageCache( const std::size_t capacity )
+    : M_capacity( capacity ),
+      M_hit_count( 0 ),
+      M_miss_count( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CLangMessageCache &
+CLangMessageCache::instance()
+{
+    static CLangMessageCache s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::uint64_t
+CLangMessageCache::hash( const std::string_view msg )
+{
+    std::uint64_t h = 14695981039346656037ULL;
+    for ( const char c : msg )
+    {
+        h ^= static_cast< unsigned char >( c );
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+CLangMessageCache::find( const std::string_view msg,
+                         CLangMessage::ConstPtr * message,
+                         bool * full )
+{
+    const std::uint64_t h = hash( msg );
+
+    std::lock_guard< std::mutex > lock( M_mutex );
+
+    std::unordered_map< std::uint64_t, std::list< Node >::iterator >::iterator it = M_index.find( h );
+    if ( it == M_index.end()
+         || it->second->text_ != msg )
+    {
+        ++M_miss_count;
+        return false;
+    }
+
+    ++M_hit_count;
+    M_nodes.splice( M_nodes.begin(), M_nodes, it->second );
+
+    *message = it->second->message_;
+    *full = it->second->full_;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CLangMessageCache::insert( const std::string_view msg,
+                           const CLangMessage::ConstPtr & message,
+                           const bool full )
+{
+    const std::uint64_t h = hash( msg );
+
+    std::lock_guard< std::mutex > lock( M_mutex );
+
+    if ( M_capacity == 0 )
+    {
+        return;
+    }
+
+    std::unordered_map< std::uint64_t, std::list< Node >::iterator >::iterator it = M_index.find( h );
+    if ( it != M_index.end() )
+    {
+        // the same message or a hash collision. the latest one is kept.
+        Node & node = *it->second;
+        node.text_.assign( msg.data(), msg.size() );
+        node.message_ = message;
+        node.full_ = full;
+        M_nodes.splice( M_nodes.begin(), M_nodes, it->second );
+        return;
+    }
+
+    while ( M_nodes.size() >= M_capacity )
+    {
+        M_index.erase( M_nodes.back().hash_ );
+        M_nodes.pop_back();
+    }
+
+    M_nodes.push_front( Node{ h, std::string( msg ), message, full } );
+    M_index.emplace( h, M_nodes.begin() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CLangMessageCache::setCapacity( const std::size_t capacity )
+{
+    std::lock_guard< std::mutex > lock( M_mutex );
+
+    M_capacity = capacity;
+    while ( M_nodes.size() > M_capacity )
+    {
+        M_index.erase( M_nodes.back().hash_ );
+        M_nodes.pop_back();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CLangMessageCache::clear()
+{
+    std::lock_guard< std::mutex > lock( M_mutex );
+
+    M_nodes.clear();
+    M_index.clear();
+    M_hit_count = 0;
+    M_miss_count = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::size_t
+CLangMessageCache::size() const
+{
+    std::lock_guard< std::mutex > lock( M_mutex );
+    return M_nodes.size();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::uint64_t
+CLangMessageCache::hitCount() const
+{
+    std::lock_guard< std::mutex > lock( M_mutex );
+    return M_hit_count;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::uint64_t
+CLangMessageCache::missCount() const
+{
+    std::lock_guard< std::mutex > lock( M_mutex );
+    return M_miss_count;
+}
+
+}
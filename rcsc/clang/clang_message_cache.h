@@ -0,0 +1,169 @@
+// -*-c++-*-
+
+/*!
+  \file clang_message_cache.h
+  \brief cache of the parsed clang messages Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_CLANG_MESSAGE_CACHE_H
+#define RCSC_CLANG_MESSAGE_CACHE_H
+
+#include <rcsc/clang/clang_message.h>
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+
+namespace rcsc {
+
+/*!
+  \class CLangMessageCache
+  \brief bounded cache of the parsed clang messages keyed by the message content.
+
+  The online coach often resends the same define, rule and info messages.
+  CLangParser looks up this cache before parsing, so a repeated message
+  costs a hash and a string comparison instead of a parse. The least
+  recently used entry is dropped when the cache is full.
+
+  The cached messages are immutable and shared by all parsers that use
+  the same cache. instance() is shared by all agents in the process, so
+  the access is serialized by a mutex.
+*/
+class CLangMessageCache {
+public:
+
+    //! the default number of cached messages
+    static constexpr std::size_t DEFAULT_CAPACITY = 64;
+
+private:
+
+    /*!
+      \struct Node
+      \brief cached entry
+    */
+    struct Node {
+        std::uint64_t hash_; //!< hash value of text_
+        std::string text_; //!< raw message
+        CLangMessage::ConstPtr message_; //!< parsed message. null if the message is invalid.
+        bool full_; //!< the result of CLangParser::parse()
+    };
+
+    mutable std::mutex M_mutex; //!< lock for all members
+    std::list< Node > M_nodes; //!< entries. the front is the most recently used one.
+    std::unordered_map< std::uint64_t, std::list< Node >::iterator > M_index; //!< hash to entry
+    std::size_t M_capacity; //!< the maximum number of entries
+
+    std::uint64_t M_hit_count; //!< the number of successful lookups
+    std::uint64_t M_miss_count; //!< the number of failed lookups
+
+    // not used
+    CLangMessageCache( const CLangMessageCache & ) = delete;
+    CLangMessageCache & operator=( const CLangMessageCache & ) = delete;
+
+public:
+
+    /*!
+      \brief create an empty cache
+      \param capacity the maximum number of entries
+    */
+    explicit
+    CLangMessageCache( const std::size_t capacity = DEFAULT_CAPACITY );
+
+    /*!
+      \brief get the process wide instance
+      \return reference to the instance
+    */
+    static
+    CLangMessageCache & instance();
+
+    /*!
+      \brief get the hash value of the message (FNV-1a)
+      \param msg raw message
+      \return hash value
+    */
+    static
+    std::uint64_t hash( const std::string_view msg );
+
+    /*!
+      \brief look up the parsed result of the message
+      \param msg raw message
+      \param message result message pointer. null if the cached message is invalid.
+      \param full result flag returned by CLangParser::parse()
+      \return true if the message is found
+    */
+    bool find( const std::string_view msg,
+               CLangMessage::ConstPtr * message,
+               bool * full );
+
+    /*!
+      \brief register the parsed result of the message
+      \param msg raw message
+      \param message parsed message. null if the message is invalid.
+      \param full result flag returned by CLangParser::parse()
+    */
+    void insert( const std::string_view msg,
+                 const CLangMessage::ConstPtr & message,
+                 const bool full );
+
+    /*!
+      \brief change the maximum number of entries. the old entries are dropped if needed.
+      \param capacity the maximum number of entries. 0 disables the cache.
+    */
+    void setCapacity( const std::size_t capacity );
+
+    /*!
+      \brief remove all entries and reset the counters
+    */
+    void clear();
+
+    /*!
+      \brief get the number of entries
+      \return the number of entries
+    */
+    std::size_t size() const;
+
+    /*!
+      \brief get the number of successful lookups
+      \return hit count
+    */
+    std::uint64_t hitCount() const;
+
+    /*!
+      \brief get the number of failed lookups
+      \return miss count
+    */
+    std::uint64_t missCount() const;
+};
+
+}
+
+#endif
@@ -28,15 +28,15 @@
  */
 
 /////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////
 
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
 
-// #define BOOST_SPIRIT_DEBUG
-
 #include "clang_parser.h"
 
+#include "clang_message_cache.h"
 #include "clang_action.h"
 #include "clang_condition.h"
 #include "clang_directive.h"
@@ -44,171 +44,76 @@
 #include "clang_token.h"
 #include "clang_unum.h"
 
-#include <boost/spirit/include/classic.hpp>
-//#include <boost/bind.hpp>
-
-#include <functional>
-#include <stack>
-#include <utility>
+#include <vector>
 #include <iostream>
+#include <charconv>
+#include <cctype>
 #include <cstring>
-#include <cassert>
-
-namespace bsc = BOOST_SPIRIT_CLASSIC_NS;
 
 namespace rcsc {
 
 namespace {
 
 /*-------------------------------------------------------------------*/
-/*-------------------------------------------------------------------*/
-/*-------------------------------------------------------------------*/
-struct Item {
-
-    enum Type {
-        NONE,
-        TOKEN,
-        DIRECTIVE,
-        CONDITION,
-        ACTION,
-        UNUM_SET,
-        UNUM,
-        TTL,
-        HETERO_TYPE,
-        POSITIVE,
-        TEAM_OUR,
-        STRING,
-        VARIABLE,
-    };
-
-    union Value {
-        CLangToken * token_;
-        CLangDirective * directive_;
-        CLangCondition * condition_;
-        CLangAction * action_;
-        CLangUnumSet * unum_set_;
-        int int_value_;
-        bool bool_value_;
-        std::string * string_value_;
-    };
-
-    Type type_;
-    Value value_;
-
-    Item()
-        : type_( NONE )
-      {
-          std::memset( &value_, 0, sizeof( Value ) );
-      }
-    Item( CLangToken * token )
-        : type_( TOKEN )
-      {
-          value_.token_ = token;
-      }
-    Item( CLangDirective * dir )
-        : type_( DIRECTIVE )
-      {
-          value_.directive_ = dir;
-      }
-    Item( CLangCondition * cond )
-        : type_( CONDITION )
-      {
-          value_.condition_ = cond;
-      }
-    Item( CLangAction * act )
-        : type_( ACTION )
-      {
-          value_.action_ = act;
-      }
-    Item( CLangUnumSet * uset )
-        : type_( UNUM_SET )
-      {
-          value_.unum_set_ = uset;
-      }
-    Item( Type type,
-          int value )
-        : type_( type )
-      {
-          value_.int_value_ = value;
-      }
-    Item( Type type,
-          bool value )
-        : type_( type )
-      {
-          value_.bool_value_ = value;
-      }
-
-    Item( Type type,
-          std::string * str )
-        : type_( type )
-      {
-          value_.string_value_ = str;
-      }
-
-    void clear()
-      {
-          switch ( type_ ) {
-          case TOKEN:
-              delete value_.token_;
-              value_.token_ = nullptr;
-              break;
-          case DIRECTIVE:
-              delete value_.directive_;
-              value_.directive_ = nullptr;
-              break;
-          case CONDITION:
-              delete value_.condition_;
-              value_.condition_ = nullptr;
-              break;
-          case ACTION:
-              delete value_.action_;
-              value_.action_ = nullptr;
-              break;
-          case UNUM_SET:
-              delete value_.unum_set_;
-              value_.unum_set_ = nullptr;
-              break;
-          case UNUM:
-          case TTL:
-          case HETERO_TYPE:
-              value_.int_value_ = 0;
-              break;
-          case POSITIVE:
-          case TEAM_OUR:
-              value_.bool_value_ = false;
-              break;
-          case STRING:
-          case VARIABLE:
-              delete value_.string_value_;
-              value_.string_value_ = nullptr;
-              break;
-          default:
-              std::cerr << __FILE__ << ' ' << __LINE__
-                        << ": unknown item type " << type_ << std::endl;
-              break;
-          }
-
-          type_ = NONE;
-      }
-};
+/*!
+  \brief check if the character is allowed in the clang string
+ */
+inline
+bool
+is_clang_str_char( const char c )
+{
+    return ( std::isalnum( static_cast< unsigned char >( c ) )
+             || std::isspace( static_cast< unsigned char >( c ) )
+             || ( c != '\0' && std::strchr( "().+-*/?<>_", c ) != nullptr ) );
+}
 
 }
 
 /*-------------------------------------------------------------------*/
 /*-------------------------------------------------------------------*/
 /*-------------------------------------------------------------------*/
-class CLangParser::Impl
-    : public bsc::grammar< CLangParser::Impl > {
+
+/*!
+  \class CLangParser::Impl
+  \brief recursive descent parser of the clang message.
+
+  Grammar:
+  <pre>
+  msg       : '(' "info" token* ')'
+  token     : '(' int cond directive* ')' | '(' "clear" ')'
+  cond      : '(' "true" ')' | '(' "false" ')'
+  directive : '(' ( "dont" | "do" ) ( "our" | "opp" ) unum_set act* ')' | '"' str '"'
+  unum_set  : '{' uint* '}'
+  act       : '(' "mark" unum_set ')' | '(' "htype" int ')' | '(' "hold" ')' | '(' "bto" unum_set ')'
+  </pre>
+  Spaces are allowed between the lexical elements. Every alternative is
+  selected by the next character or keyword, so the parser never backtracks.
+  Tokens, directives and actions are added in the reverse order of the message.
+
+  The semantic errors (a directive without action, a rule token without
+  directive) only remove the element from the result.
+
+  All nodes are created in the arena of the new message.
+ */
+class CLangParser::Impl {
 private:
 
-    CLangParser & M_parser;
+    const char * M_pos; //!< current read position
+    const char * M_end; //!< end of the message
 
-    std::stack< Item > M_item_stack;
+    CLangArena * M_arena; //!< arena of the message being parsed
+
+    // buffers reused by all messages. each level uses its own buffer.
+    std::vector< CLangToken::ConstPtr > M_tokens;
+    std::vector< CLangDirective::ConstPtr > M_directives;
+    std::vector< CLangAction::ConstPtr > M_actions;
 
 public:
 
-    Impl( CLangParser & parser )
-        : M_parser( parser )
+    Impl()
+        : M_pos( nullptr ),
+          M_end( nullptr ),
+          M_arena( nullptr )
       { }
 
     ~Impl()
@@ -218,457 +123,89 @@ public:
 
     void clear()
       {
-          while ( ! M_item_stack.empty() )
-          {
-              //std::cerr << "clear stack item" << std::endl;
-              M_item_stack.top().clear();
-              M_item_stack.pop();
-          }
+          M_tokens.clear();
+          M_directives.clear();
+          M_actions.clear();
       }
 
-    bool stackIsEmpty() const
-      {
-          return M_item_stack.empty();
-      }
-
-
-    template < typename S >
-    struct definition {
-
-        bsc::rule< S > lp_p;
-        bsc::rule< S > rp_p;
-
-        bsc::rule< S > lb_p;
-        bsc::rule< S > rb_p;
-
-        bsc::rule< S > clang_true_p;
-        bsc::rule< S > clang_false_p;
-
-        bsc::rule< S > clang_raw_str_p;
-        bsc::rule< S > clang_str_p;
-        bsc::rule< S > clang_var_p;
-
-        bsc::rule< S > clang_unum_p;
-        bsc::rule< S > clang_unum_set_p;
-
-        bsc::rule< S > clang_cond_bool_p;
-        bsc::rule< S > clang_cond_p;
-
-        bsc::rule< S > clang_act_mark_p;
-        bsc::rule< S > clang_act_htype_p;
-        bsc::rule< S > clang_act_hold_p;
-        bsc::rule< S > clang_act_bto_p;
-
-        bsc::rule< S > clang_act_p;
-
-        bsc::rule< S > clang_do_dont_p;
-
-        bsc::rule< S > clang_team_p;
-
-        bsc::rule< S > clang_directive_p;
-        bsc::rule< S > clang_token_p;
-
-        bsc::rule< S > clang_info_msg_p;
-
-        bsc::rule< S > clang_msg_p;
-
-        definition( const Impl & self )
-          {
-              using std::placeholders::_1;
-              using std::placeholders::_2;
-
-              lp_p = bsc::ch_p( '(' );
-              rp_p = bsc::ch_p( ')' );
-
-              lb_p = bsc::ch_p( '{' );
-              rb_p = bsc::ch_p( '}' );
-
-              clang_true_p = bsc::str_p( "true" );
-              clang_false_p = bsc::str_p( "false" );
-
-              // str: \"[0-9A-Za-z\(\)\.\+\-\*\/\?\<\>\_ ]+\"
-              // var: [abe-oqrt-zA-Z_][a-zA-Z0-9_]*
-
-              clang_raw_str_p = *( bsc::alnum_p | bsc::chset_p( "().+-*/?<>_ " ) );
-              clang_str_p = ( bsc::ch_p( '"' )
-                              >> clang_raw_str_p
-                              >> bsc::ch_p( '"' )
-                              )[std::bind( &Impl::handleString, &self, _1, _2 )];
-              clang_var_p = ( ( bsc::chset_p( "abefghijklmnoqrtuvwxyz" )
-                                | bsc::upper_p
-                                | bsc::ch_p( '_' ) )
-                              >> +( bsc::alnum_p | bsc::ch_p( '_' ) )
-                              )[std::bind( &Impl::handleVariable, &self, _1, _2 )];
-
-              clang_unum_p = bsc::uint_p[std::bind( &Impl::handleUnum, &self, _1 )];
-              clang_unum_set_p = ( lb_p >> *clang_unum_p >> rb_p
-                                   )[std::bind( &Impl::handleUnumSet, &self )];
-
-              clang_cond_bool_p
-                  = ( lp_p >> clang_true_p >> rp_p )[std::bind( &Impl::handleConditionBool, &self, true )]
-                  | ( lp_p >> clang_false_p >> rp_p )[std::bind( &Impl::handleConditionBool, &self, false )];
-              clang_cond_p = clang_cond_bool_p;
-
-              clang_act_mark_p = ( lp_p
-                                   >> bsc::str_p( "mark" ) >> clang_unum_set_p
-                                   >> rp_p );
-              clang_act_htype_p = ( lp_p
-                                    >> bsc::str_p( "htype" )
-                                    >> bsc::int_p[std::bind( &Impl::handleActHeteroTypeId, &self, _1 )]
-                                    >> rp_p );
-              clang_act_hold_p = ( lp_p
-                                   >> bsc::str_p( "hold" )
-                                   >> rp_p );
-              clang_act_bto_p = ( lp_p
-                                  >> bsc::str_p( "bto" ) >> clang_unum_set_p
-                                  >> rp_p );
-              clang_act_p = ( clang_act_mark_p[std::bind( &Impl::handleActMark, &self )]
-                              | clang_act_htype_p[std::bind( &Impl::handleActHeteroType, &self )]
-                              | clang_act_hold_p[std::bind( &Impl::handleActHold, &self )]
-                              | clang_act_bto_p[std::bind( &Impl::handleActBallTo, &self )]
-                              );
-
-              clang_do_dont_p
-                  = bsc::str_p( "dont" )[std::bind( &Impl::handlePositive, &self, false )]
-                  | bsc::str_p( "do" )[std::bind( &Impl::handlePositive, &self, true )];
-
-              clang_team_p
-                  = bsc::str_p( "our" )[std::bind( &Impl::handleTeam, &self, true )]
-                  | bsc::str_p( "opp" )[std::bind( &Impl::handleTeam, &self, false )];
-
-              clang_directive_p = ( ( lp_p
-                                      >> clang_do_dont_p
-                                      >> clang_team_p
-                                      >> clang_unum_set_p
-                                      >> *clang_act_p
-                                      >> rp_p )[std::bind( &Impl::handleDirectiveCommon, &self )]
-                                    | clang_str_p[std::bind( &Impl::handleDirectiveNamed, &self )]
-                                    );
-
-              clang_token_p = ( ( lp_p
-                                  >> bsc::int_p[std::bind( &Impl::handleTokenTTL, &self, _1 )]
-                                  >> clang_cond_p //[std::bind( &Impl::handleCondition, &self )]
-                                  >> *clang_directive_p
-                                  >> rp_p
-                                  )[std::bind( &Impl::handleTokenRule, &self )]
-                                | ( lp_p >> bsc::str_p( "clear" ) >> rp_p
-                                    )[std::bind( &Impl::handleTokenClear, &self )]
-                                );
-
-              clang_info_msg_p = ( lp_p
-                                   >> bsc::str_p( "info" )
-                                   >> *clang_token_p
-                                   >> rp_p
-                                   )[std::bind( &Impl::handleInfoMessage, &self )];
-
-              clang_msg_p = clang_info_msg_p;
-
-#ifdef BOOST_SPIRIT_DEBUG
-              std::cerr << "boost spirit debug" << std::endl;
-              BOOST_SPIRIT_DEBUG_RULE( clang_true_p );
-              BOOST_SPIRIT_DEBUG_RULE( clang_false_p );
-              BOOST_SPIRIT_DEBUG_RULE( clang_raw_str_p );
-              BOOST_SPIRIT_DEBUG_RULE( clang_str_p );
-              BOOST_SPIRIT_DEBUG_RULE( clang_var_p );
-              BOOST_SPIRIT_DEBUG_RULE( clang_unum_p );
-              BOOST_SPIRIT_DEBUG_RULE( clang_unum_set_p );
-              BOOST_SPIRIT_DEBUG_RULE( clang_cond_bool_p );
-              BOOST_SPIRIT_DEBUG_RULE( clang_cond_p );
-              BOOST_SPIRIT_DEBUG_RULE( clang_act_mark_p );
-              BOOST_SPIRIT_DEBUG_RULE( clang_act_htype_p );
-              BOOST_SPIRIT_DEBUG_RULE( clang_act_hold_p );
-              BOOST_SPIRIT_DEBUG_RULE( clang_act_bto_p );
-              BOOST_SPIRIT_DEBUG_RULE( clang_act_p );
-              BOOST_SPIRIT_DEBUG_RULE( clang_do_dont_p );
-              BOOST_SPIRIT_DEBUG_RULE( clang_team_p );
-              BOOST_SPIRIT_DEBUG_RULE( clang_directive_p );
-              BOOST_SPIRIT_DEBUG_RULE( clang_token_p );
-              BOOST_SPIRIT_DEBUG_RULE( clang_info_msg_p );
-              BOOST_SPIRIT_DEBUG_RULE( clang_msg_p );
-#endif
-          }
-
-
-        const bsc::rule< S > & start() const
-          {
-              return clang_msg_p;
-          }
-    };
-
-
-    bool handleString( const char * first,
-                       const char * last ) const
-      {
-          return M_parser.handleString( first, last );
-      }
-
-    bool handleVariable( const char * first,
-                         const char * last ) const
-      {
-          return M_parser.handleVariable( first, last );
-      }
-
-    bool handleUnum( unsigned int value ) const
-      {
-          return M_parser.handleUnum( value );
-      }
-
-    bool handleUnumSet() const
-      {
-          return M_parser.handleUnumSet();
-      }
-
-    bool handleConditionBool( bool value ) const
-      {
-          //std::cerr << "handleConditionBool " << value << std::endl;
-          return M_parser.handleConditionBool( value );
-      }
-
-    bool handlePositive( bool on ) const
-      {
-          //std::cerr << "handlePositive " << on << std::endl;
-          return M_parser.handlePositive( on );
-      }
-
-    bool handleTeam( bool our ) const
-      {
-          //std::cerr << "handleTeam " << our << std::endl;
-          return M_parser.handleTeam( our );
-      }
-
-    bool handleActMark() const
-      {
-          return M_parser.handleActMark();
-      }
-
-    bool handleActHeteroType() const
-      {
-          return M_parser.handleActHeteroType();
-      }
-
-    bool handleActHeteroTypeId( int type ) const
-      {
-          return M_parser.handleActHeteroTypeId( type );
-      }
-
-    bool handleActHold() const
-      {
-          return M_parser.handleActHold();
-      }
-
-    bool handleActBallTo() const
-      {
-          return M_parser.handleActBallTo();
-      }
+    CLangMessage * parse( const std::string_view msg,
+                          bool * full );
 
-    bool handleDirectiveCommon() const
-      {
-          return M_parser.handleDirectiveCommon();
-      }
-
-    bool handleDirectiveNamed() const
-      {
-          return M_parser.handleDirectiveNamed();
-      }
-
-    bool handleTokenTTL( int ttl ) const
-      {
-          return M_parser.handleTokenTTL( ttl );
-      }
-
-    bool handleTokenRule() const
-      {
-          return M_parser.handleTokenRule();
-      }
-
-    bool handleTokenClear() const
-      {
-          return M_parser.handleTokenClear();
-      }
-
-    bool handleInfoMessage() const
-      {
-          return M_parser.handleInfoMessage();
-      }
-
-    void pushToken( CLangToken * tok )
-      {
-          M_item_stack.push( Item( tok ) );
-      }
-
-    CLangToken * popToken()
-      {
-          if ( M_item_stack.empty()
-               || M_item_stack.top().type_ != Item::TOKEN )
-          {
-              return nullptr;
-          }
-
-          CLangToken * tok = M_item_stack.top().value_.token_;
-          M_item_stack.pop();
-          return tok;
-      }
-
-    void pushDirective( CLangDirective * dir )
-      {
-          M_item_stack.push( Item( dir ) );
-      }
-
-    CLangDirective * popDirective()
-      {
-          if ( M_item_stack.empty()
-               || M_item_stack.top().type_ != Item::DIRECTIVE )
-          {
-              return nullptr;
-          }
-
-          CLangDirective * dir = M_item_stack.top().value_.directive_;
-          M_item_stack.pop();
-          return dir;
-      }
-
-    void pushCondition( CLangCondition * cond )
-      {
-          M_item_stack.push( Item( cond ) );
-      }
-
-    CLangCondition * popCondition()
-      {
-          if ( M_item_stack.empty()
-               || M_item_stack.top().type_ != Item::CONDITION )
-          {
-              return nullptr;
-          }
-
-          CLangCondition * cond = M_item_stack.top().value_.condition_;
-          M_item_stack.pop();
-          return cond;
-      }
-
-    void pushAction( CLangAction * act )
-      {
-          M_item_stack.push( Item( act ) );
-      }
-
-    CLangAction * popAction()
-      {
-          if ( M_item_stack.empty()
-               || M_item_stack.top().type_ != Item::ACTION )
-          {
-              return nullptr;
-          }
-
-          CLangAction * act = M_item_stack.top().value_.action_;
-          M_item_stack.pop();
-          return act;
-      }
-
-    void pushUnumSet( CLangUnumSet * uset )
-      {
-          M_item_stack.push( Item( uset ) );
-      }
+private:
 
-    CLangUnumSet * popUnumSet()
+    void skipSpace()
       {
-          if ( M_item_stack.empty()
-               || M_item_stack.top().type_ != Item::UNUM_SET )
+          while ( M_pos < M_end
+                  && std::isspace( static_cast< unsigned char >( *M_pos ) ) )
           {
-              return nullptr;
+              ++M_pos;
           }
-
-          CLangUnumSet * uset = M_item_stack.top().value_.unum_set_;
-          M_item_stack.pop();
-          return uset;
       }
 
-    void pushIntValue( Item::Type type,
-                       int value )
+    //! check the next character after spaces. the character is consumed if matched.
+    bool readChar( const char c )
       {
-          M_item_stack.push( Item( type, value ) );
-      }
-
-    bool popIntValue( Item::Type type,
-                      int * rval )
-      {
-          if ( M_item_stack.empty()
-               || M_item_stack.top().type_ != type )
+          skipSpace();
+          if ( M_pos < M_end && *M_pos == c )
           {
-              return false;
+              ++M_pos;
+              return true;
           }
-
-          *rval = M_item_stack.top().value_.int_value_;
-          M_item_stack.pop();
-          return true;
+          return false;
       }
 
-    void pushBoolValue( Item::Type type,
-                        bool value )
+    //! check the next character after spaces without consuming it.
+    bool peekChar( const char c )
       {
-          M_item_stack.push( Item( type, value ) );
+          skipSpace();
+          return M_pos < M_end && *M_pos == c;
       }
 
-    bool popBoolValue( Item::Type type,
-                       bool * rval )
+    //! check the next keyword after spaces. the keyword is consumed if matched.
+    bool readKeyword( const std::string_view word )
       {
-          if ( M_item_stack.empty()
-               || M_item_stack.top().type_ != type )
+          skipSpace();
+          if ( static_cast< std::size_t >( M_end - M_pos ) >= word.size()
+               && std::memcmp( M_pos, word.data(), word.size() ) == 0 )
           {
-              return false;
+              M_pos += word.size();
+              return true;
           }
-
-          *rval = M_item_stack.top().value_.bool_value_;
-          M_item_stack.pop();
-          return true;
-      }
-
-    void pushStringValue( Item::Type type,
-                          std::string * str )
-      {
-          M_item_stack.push( Item( type, str ) );
+          return false;
       }
 
-    std::string * popStringValue( Item::Type type )
-      {
-          if ( M_item_stack.empty()
-               || M_item_stack.top().type_ != type )
-          {
-              return nullptr;
-          }
+    bool readInt( int * value );
+    bool readUnsigned( unsigned int * value );
 
-          std::string * str = M_item_stack.top().value_.string_value_;
-          M_item_stack.pop();
-          return str;
-      }
+    CLangUnumSet::Ptr parseUnumSet();
+    CLangCondition::Ptr parseCondition();
+    bool parseAction();
+    bool parseDirective();
+    bool parseToken();
 };
 
 /*-------------------------------------------------------------------*/
 /*!
 
  */
-CLangParser::CLangParser()
-    : M_impl( new Impl( *this ) )
+bool
+CLangParser::Impl::readInt( int * value )
 {
+    skipSpace();
 
-}
-
-/*-------------------------------------------------------------------*/
-/*!
-
- */
-CLangParser::~CLangParser()
-{
+    const char * first = M_pos;
+    if ( first < M_end && *first == '+' ) ++first; // std::from_chars does not accept '+'
 
-}
+    if ( first < M_end && *first == '-' && first != M_pos ) return false;
 
-/*-------------------------------------------------------------------*/
-/*!
+    const std::from_chars_result r = std::from_chars( first, M_end, *value );
+    if ( r.ec != std::errc() )
+    {
+        return false;
+    }
 
- */
-void
-CLangParser::clear()
-{
-    M_impl->clear();
-    M_message.reset();
+    M_pos = r.ptr;
+    return true;
 }
 
 /*-------------------------------------------------------------------*/
@@ -676,25 +213,23 @@ CLangParser::clear()
 
  */
 bool
-CLangParser::parse( const std::string & msg )
+CLangParser::Impl::readUnsigned( unsigned int * value )
 {
-    clear();
-
-    bsc::parse_info<> info = bsc::parse( msg.c_str(), *M_impl, bsc::space_p );
+    skipSpace();
 
-    return info.full;
-}
+    if ( M_pos >= M_end
+         || ! std::isdigit( static_cast< unsigned char >( *M_pos ) ) )
+    {
+        return false;
+    }
 
-/*-------------------------------------------------------------------*/
-/*!
+    const std::from_chars_result r = std::from_chars( M_pos, M_end, *value );
+    if ( r.ec != std::errc() )
+    {
+        return false;
+    }
 
- */
-bool
-CLangParser::handleString( const char * first,
-                           const char * last )
-{
-    M_impl->pushStringValue( Item::STRING,
-                             new std::string( first + 1, last - 1 ) );
+    M_pos = r.ptr;
     return true;
 }
 
@@ -702,44 +237,58 @@ CLangParser::handleString( const char * first,
 /*!
 
  */
-bool
-CLangParser::handleVariable( const char * first,
-                             const char * last )
+CLangUnumSet::Ptr
+CLangParser::Impl::parseUnumSet()
 {
-    M_impl->pushStringValue( Item::VARIABLE,
-                             new std::string( first, last ) );
-    return true;
-}
+    if ( ! readChar( '{' ) )
+    {
+        return CLangUnumSet::Ptr();
+    }
 
-/*-------------------------------------------------------------------*/
-/*!
+    CLangUnumSet::Ptr uset = M_arena->construct< CLangUnumSet >();
 
- */
-bool
-CLangParser::handleUnum( const int unum )
-{
-    M_impl->pushIntValue( Item::UNUM, unum );
-    return true;
+    unsigned int unum = 0;
+    while ( readUnsigned( &unum ) )
+    {
+        uset->add( static_cast< int >( unum ) );
+    }
+
+    if ( ! readChar( '}' ) )
+    {
+        return CLangUnumSet::Ptr();
+    }
+
+    return uset;
 }
 
 /*-------------------------------------------------------------------*/
 /*!
 
  */
-bool
-CLangParser::handleUnumSet()
+CLangCondition::Ptr
+CLangParser::Impl::parseCondition()
 {
-    CLangUnumSet * uset = new CLangUnumSet();
+    if ( ! readChar( '(' ) )
+    {
+        return CLangCondition::Ptr();
+    }
 
-    int unum = -1;
-    while ( M_impl->popIntValue( Item::UNUM, &unum ) )
+    bool value = false;
+    if ( readKeyword( "true" ) )
     {
-        uset->add( unum );
+        value = true;
+    }
+    else if ( ! readKeyword( "false" ) )
+    {
+        return CLangCondition::Ptr();
     }
 
-    M_impl->pushUnumSet( uset );
+    if ( ! readChar( ')' ) )
+    {
+        return CLangCondition::Ptr();
+    }
 
-    return true;
+    return M_arena->construct< CLangConditionBool >( value );
 }
 
 /*-------------------------------------------------------------------*/
@@ -747,32 +296,48 @@ CLangParser::handleUnumSet()
 
  */
 bool
-CLangParser::handleConditionBool( bool value )
+CLangParser::Impl::parseAction()
 {
-    M_impl->pushCondition( new CLangConditionBool( value ) );
-    return true;
-}
+    if ( ! readChar( '(' ) )
+    {
+        return false;
+    }
 
-/*-------------------------------------------------------------------*/
-/*!
+    CLangAction::ConstPtr act;
 
- */
-bool
-CLangParser::handlePositive( bool on )
-{
-    M_impl->pushBoolValue( Item::POSITIVE, on );
-    return true;
-}
+    if ( readKeyword( "mark" ) )
+    {
+        CLangUnumSet::Ptr uset = parseUnumSet();
+        if ( ! uset ) return false;
+        act = M_arena->construct< CLangActionMark >( std::move( uset ) );
+    }
+    else if ( readKeyword( "htype" ) )
+    {
+        int type = -1000;
+        if ( ! readInt( &type ) ) return false;
+        act = M_arena->construct< CLangActionHeteroType >( type );
+    }
+    else if ( readKeyword( "hold" ) )
+    {
+        act = M_arena->construct< CLangActionHold >();
+    }
+    else if ( readKeyword( "bto" ) )
+    {
+        CLangUnumSet::Ptr uset = parseUnumSet();
+        if ( ! uset ) return false;
+        act = M_arena->construct< CLangActionBallTo >( std::move( uset ) );
+    }
+    else
+    {
+        return false;
+    }
 
-/*-------------------------------------------------------------------*/
-/*!
+    if ( ! readChar( ')' ) )
+    {
+        return false;
+    }
 
- */
-bool
-CLangParser::handleTeam( bool our )
-{
-    //std::cout << "handleTeam " << ( our ? "our" : "opp" ) << std::endl;
-    M_impl->pushBoolValue( Item::TEAM_OUR, our );
+    M_actions.push_back( std::move( act ) );
     return true;
 }
 
@@ -781,63 +346,84 @@ CLangParser::handleTeam( bool our )
 
  */
 bool
-CLangParser::handleActMark()
+CLangParser::Impl::parseDirective()
 {
-    CLangUnumSet * uset = M_impl->popUnumSet();
-    if ( ! uset )
+    if ( readChar( '"' ) )
+    {
+        // named directive is not supported yet. only the syntax is checked.
+        while ( M_pos < M_end && is_clang_str_char( *M_pos ) ) ++M_pos;
+        return readChar( '"' );
+    }
+
+    if ( ! readChar( '(' ) )
     {
-        std::cerr << __FILE__ << ' ' << __LINE__
-                  << ": (handleActMark) could not get unum set from the stack."
-                  << std::endl;
         return false;
     }
 
-    CLangActionMark * act = new CLangActionMark( uset );
-    M_impl->pushAction( act );
-    return true;
-}
+    bool positive = false;
+    if ( readKeyword( "dont" ) )
+    {
+        positive = false;
+    }
+    else if ( readKeyword( "do" ) )
+    {
+        positive = true;
+    }
+    else
+    {
+        return false;
+    }
 
-/*-------------------------------------------------------------------*/
-/*!
+    bool our = false;
+    if ( readKeyword( "our" ) )
+    {
+        our = true;
+    }
+    else if ( ! readKeyword( "opp" ) )
+    {
+        return false;
+    }
 
- */
-bool
-CLangParser::handleActHeteroTypeId( const int type )
-{
-    M_impl->pushIntValue( Item::HETERO_TYPE, type );
-    return true;
-}
+    CLangUnumSet::Ptr uset = parseUnumSet();
+    if ( ! uset )
+    {
+        return false;
+    }
 
-/*-------------------------------------------------------------------*/
-/*!
+    const std::size_t first_action = M_actions.size();
+    while ( peekChar( '(' ) )
+    {
+        if ( ! parseAction() )
+        {
+            return false;
+        }
+    }
 
- */
-bool
-CLangParser::handleActHeteroType()
-{
-    int type = -1000;
-    if ( ! M_impl->popIntValue( Item::HETERO_TYPE, &type ) )
+    if ( ! readChar( ')' ) )
+    {
+        return false;
+    }
+
+    if ( M_actions.size() == first_action )
     {
         std::cerr << __FILE__ << ' ' << __LINE__
-                  << ": (handleActHeteroType) could not get hetero type from the stack."
+                  << ": (parseDirective) empty action."
                   << std::endl;
-        return false;
+        return true;
     }
 
-    CLangActionHeteroType * act = new CLangActionHeteroType( type );
-    M_impl->pushAction( act );
-    return true;
-}
+    std::shared_ptr< CLangDirectiveCommon > dir = M_arena->construct< CLangDirectiveCommon >();
+    while ( M_actions.size() > first_action )
+    {
+        dir->addAction( std::move( M_actions.back() ) );
+        M_actions.pop_back();
+    }
 
-/*-------------------------------------------------------------------*/
-/*!
+    dir->setPlayers( std::move( uset ) );
+    dir->setOur( our );
+    dir->setPositive( positive );
 
- */
-bool
-CLangParser::handleActHold()
-{
-    CLangActionHold * act = new CLangActionHold();
-    M_impl->pushAction( act );
+    M_directives.push_back( std::move( dir ) );
     return true;
 }
 
@@ -846,105 +432,67 @@ CLangParser::handleActHold()
 
  */
 bool
-CLangParser::handleActBallTo()
+CLangParser::Impl::parseToken()
 {
-    CLangUnumSet * uset = M_impl->popUnumSet();
-    if ( ! uset )
+    if ( ! readChar( '(' ) )
     {
-        std::cerr << __FILE__ << ' ' << __LINE__
-                  << ": (handleActMark) could not get unum set from the stack."
-                  << std::endl;
         return false;
     }
 
-    CLangActionBallTo * act = new CLangActionBallTo( uset );
-    M_impl->pushAction( act );
-    return true;
-}
-
-/*-------------------------------------------------------------------*/
-/*!
+    if ( readKeyword( "clear" ) )
+    {
+        if ( ! readChar( ')' ) )
+        {
+            return false;
+        }
 
- */
-bool
-CLangParser::handleDirectiveCommon()
-{
-    CLangDirectiveCommon * dir = new CLangDirectiveCommon();
+        M_tokens.push_back( M_arena->construct< CLangTokenClear >() );
+        return true;
+    }
 
-    // actions
-    while ( CLangAction * act = M_impl->popAction() )
+    int ttl = -1;
+    if ( ! readInt( &ttl ) )
     {
-        dir->addAction( act );
+        return false;
     }
 
-    if ( dir->actions().empty() )
+    CLangCondition::Ptr cond = parseCondition();
+    if ( ! cond )
     {
-        std::cerr << __FILE__ << ' ' << __LINE__
-                  << ": (handleDirectiveCommon) empty action."
-                  << std::endl;
-        delete dir;
         return false;
     }
 
-    // unum_set
-    CLangUnumSet * uset = M_impl->popUnumSet();
-    if ( ! uset )
+    const std::size_t first_directive = M_directives.size();
+    while ( peekChar( '(' ) || peekChar( '"' ) )
     {
-        std::cerr << __FILE__ << ' ' << __LINE__
-                  << ": (handleDirectiveCommon) could not get unum set."
-                  << std::endl;
-        delete dir;
-        return false;
+        if ( ! parseDirective() )
+        {
+            return false;
+        }
     }
-    dir->setPlayers( uset );
 
-    // team
-    bool our = false;
-    if ( ! M_impl->popBoolValue( Item::TEAM_OUR, &our ) )
+    if ( ! readChar( ')' ) )
     {
-        std::cerr << __FILE__ << ' ' << __LINE__
-                  << ": (handleDirectiveCommon) could not get team."
-                  << std::endl;
-        delete dir;
         return false;
     }
-    dir->setOur( our );
 
-    // do,dont
-    bool positive = false;
-    if ( ! M_impl->popBoolValue( Item::POSITIVE, &positive ) )
+    if ( M_directives.size() == first_directive )
     {
         std::cerr << __FILE__ << ' ' << __LINE__
-                  << ": (handleDirectiveCommon) could not get do_dont."
-                  << std::endl;
-        delete dir;
-        return false;
+                  << ": (parseToken) empty directive." << std::endl;
+        return true;
     }
-    dir->setPositive( positive );
 
-    M_impl->pushDirective( dir );
-    return true;
-}
-
-/*-------------------------------------------------------------------*/
-/*!
-
- */
-bool
-CLangParser::handleDirectiveNamed()
-{
-    std::cout << "handleDirectiveNamed " << std::endl;
-    return true;
-}
+    std::shared_ptr< CLangTokenRule > tok = M_arena->construct< CLangTokenRule >( ttl );
+    while ( M_directives.size() > first_directive )
+    {
+        tok->addDirective( std::move( M_directives.back() ) );
+        M_directives.pop_back();
+    }
 
-/*-------------------------------------------------------------------*/
-/*!
+    tok->setCondition( std::move( cond ) );
 
- */
-bool
-CLangParser::handleTokenTTL( int ttl )
-{
-    M_impl->pushIntValue( Item::TTL, ttl );
+    M_tokens.push_back( std::move( tok ) );
     return true;
 }
 
@@ -952,61 +500,82 @@ CLangParser::handleTokenTTL( int ttl )
 /*!
 
  */
-bool
-CLangParser::handleTokenRule()
+CLangMessage *
+CLangParser::Impl::parse( const std::string_view msg,
+                          bool * full )
 {
-    CLangTokenRule * tok = new CLangTokenRule();
+    M_pos = msg.data();
+    M_end = msg.data() + msg.size();
+    *full = false;
 
-    // directives
-    while ( CLangDirective * dir = M_impl->popDirective() )
+    if ( ! readChar( '(' )
+         || ! readKeyword( "info" ) )
     {
-        tok->addDirective( dir );
+        return nullptr;
     }
 
-    if ( tok->directives().empty() )
+    std::unique_ptr< CLangInfoMessage > info( new CLangInfoMessage() );
+    M_arena = info->arena().get();
+
+    bool result = true;
+    while ( result && peekChar( '(' ) )
     {
-        std::cerr << __FILE__ << ' ' << __LINE__
-                  << ": (handleTokenRule) empty directive." << std::endl;
-        delete tok;
-        return false;
+        result = parseToken();
     }
 
-    // condition
-    CLangCondition * cond = M_impl->popCondition();
-    if ( ! cond )
+    if ( ! result
+         || ! readChar( ')' ) )
     {
-        std::cerr << __FILE__ << ' ' << __LINE__
-                  << ": (handleTokenRule) could not get the condition."
-                  << std::endl;
-        delete tok;
-        return false;
+        clear();
+        M_arena = nullptr;
+        return nullptr;
     }
-    tok->setCondition( cond );
 
-    // ttl
-    int ttl = -1;
-    if ( ! M_impl->popIntValue( Item::TTL, &ttl ) )
+    while ( ! M_tokens.empty() )
     {
-        delete tok;
-        return false;
+        info->addToken( std::move( M_tokens.back() ) );
+        M_tokens.pop_back();
     }
-    tok->setTTL( ttl );
+    M_arena = nullptr;
 
-    M_impl->pushToken( tok );
-    return true;
+    // trailing characters, including spaces, are not allowed.
+    *full = ( M_pos == M_end );
+    return info.release();
 }
 
+/*-------------------------------------------------------------------*/
+/*-------------------------------------------------------------------*/
+/*-------------------------------------------------------------------*/
+
 /*-------------------------------------------------------------------*/
 /*!
 
  */
-bool
-CLangParser::handleTokenClear()
+CLangParser::CLangParser()
+    : M_impl( new Impl() ),
+      M_cache( &CLangMessageCache::instance() )
 {
-    CLangTokenClear * tok = new CLangTokenClear();
 
-    M_impl->pushToken( tok );
-    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CLangParser::~CLangParser()
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CLangParser::clear()
+{
+    M_impl->clear();
+    M_message.reset();
 }
 
 /*-------------------------------------------------------------------*/
@@ -1014,27 +583,29 @@ CLangParser::handleTokenClear()
 
  */
 bool
-CLangParser::handleInfoMessage()
+CLangParser::parse( const std::string_view msg )
 {
-    CLangInfoMessage * info = new CLangInfoMessage();
+    clear();
 
-    //std::cerr << "handleInfoMessage" << std::endl;
-    while ( CLangToken * tok = M_impl->popToken() )
+    bool full = false;
+    if ( M_cache
+         && M_cache->find( msg, &M_message, &full ) )
     {
-        info->addToken( tok );
+        return full;
     }
 
-    M_message = CLangMessage::ConstPtr( info );
+    CLangMessage * message = M_impl->parse( msg, &full );
+    if ( message )
+    {
+        M_message = CLangMessage::ConstPtr( message );
+    }
 
-    if ( ! M_impl->stackIsEmpty() )
+    if ( M_cache )
     {
-        std::cerr << __FILE__ << ' ' << __LINE__
-                  << ": (handleInfoMessage) ERROR stack is not empty."
-                  << std::endl;
-        return false;
+        M_cache->insert( msg, M_message, full );
     }
 
-    return true;
+    return full;
 }
 
 }
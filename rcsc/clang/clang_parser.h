@@ -35,13 +35,19 @@
 #include <rcsc/clang/clang_message.h>
 
 #include <memory>
-#include <string>
+#include <string_view>
 
 namespace rcsc {
 
+class CLangMessageCache;
+
 /*!
   \class CLangParser
   \brief clang message parser
+
+  The info message is analyzed by a hand-written recursive descent parser.
+  The parsed results are registered to CLangMessageCache::instance() by
+  default, and a repeated message is not parsed again.
  */
 class CLangParser {
 private:
@@ -53,6 +59,8 @@ private:
 
     CLangMessage::ConstPtr M_message; //!< analyzed message object
 
+    CLangMessageCache * M_cache; //!< parsed message cache. null if not used.
+
     // not used
     CLangParser( const CLangParser & ) = delete;
     CLangParser & operator=( const CLangParser & ) = delete;
@@ -72,145 +80,42 @@ public:
     /*!
       \brief parser interface
       \param msg target string
-      \return parsing result
+      \return true if the whole string is a clang message.
+
+      The message object is available even if the message has trailing characters.
      */
-    bool parse( const std::string & msg );
+    bool parse( const std::string_view msg );
 
     /*!
       \brief clear all analyzed result.
      */
     void clear();
 
-    /*
-      \brief get analyzed message object.
+    /*!
+      \brief set the parsed message cache
+      \param cache pointer to the cache. nullptr disables the cache.
      */
-    const CLangMessage::ConstPtr & message() const
+    void setCache( CLangMessageCache * cache )
       {
-          return M_message;
+          M_cache = cache;
       }
 
-private:
-
-    /*!
-      \brief semantic action for clang string.
-      \param first the first point of parsed string
-      \param last the last point of parsed string
-      \return action result.
-     */
-    bool handleString( const char * first,
-                       const char * last );
-
     /*!
-      \brief semantic action for clang variable.
-      \param first the first point of parsed string
-      \param last the last point of parsed string
-      \return action result.
+      \brief get the parsed message cache
+      \return pointer to the cache, or nullptr.
      */
-    bool handleVariable( const char * first,
-                         const char * last );
-
-    /*!
-      \brief semantic action for uniform number.
-      \param unum parsed uniform number.
-      \return action result.
-     */
-    bool handleUnum( const int unum );
-
-    /*!
-      \brief semantic action for unum_set
-      \return action result.
-     */
-    bool handleUnumSet();
-
-
-    /*!
-      \brief semantic action for boolean condition.
-      \param value parsed value.
-      \return action result.
-     */
-    bool handleConditionBool( bool value );
-
-    /*!
-      \brief semantic action for do/dont
-      \param on do/dont flag
-      \return action result.
-     */
-    bool handlePositive( bool on );
-
-    /*!
-      \brief semantic action for our/opp
-      \param our our/opp flag
-      \return action result.
-     */
-    bool handleTeam( bool our );
-
-    /*!
-      \brief semantic action for mark action
-      \return action result.
-     */
-    bool handleActMark();
-
-    /*!
-      \brief semantic action for hetero type
-      \param type player type id
-      \return action result.
-     */
-    bool handleActHeteroTypeId( const int type );
-
-    /*!
-      \brief semantic action for htype action
-      \return action result.
-     */
-    bool handleActHeteroType();
-
-    /*!
-      \brief semantic action for hold action
-      \return action result.
-     */
-    bool handleActHold();
-
-    /*!
-      \brief semantic action for bto action
-      \return action result.
-     */
-    bool handleActBallTo();
-
-    /*!
-      \brief semantic action for normal directive.
-      \return action result.
-     */
-    bool handleDirectiveCommon();
-
-    /*!
-      \brief semantic action for named directive.
-      \return action result.
-     */
-    bool handleDirectiveNamed();
-
-    /*!
-      \brief semantic action for token's ttl value.
-      \param ttl time to live value.
-      \return action result.
-     */
-    bool handleTokenTTL( int ttl );
-
-    /*!
-      \brief semantic action for rule token.
-      \return action result.
-     */
-    bool handleTokenRule();
-
-    /*!
-      \brief semantic action for clear token.
-      \return action result.
-     */
-    bool handleTokenClear();
+    CLangMessageCache * cache() const
+      {
+          return M_cache;
+      }
 
-    /*!
-      \brief semantic action for info message.
-      \return action result.
+    /*
+      \brief get analyzed message object.
      */
-    bool handleInfoMessage();
+    const CLangMessage::ConstPtr & message() const
+      {
+          return M_message;
+      }
 };
 
 }
@@ -37,6 +37,7 @@
 
 #include <memory>
 #include <vector>
+#include <utility>
 #include <iostream>
 
 namespace rcsc {
@@ -180,6 +181,15 @@ public:
           M_condition = CLangCondition::Ptr( cond );
       }
 
+    /*!
+      \brief set rule condition
+      \param cond new condition object
+     */
+    void setCondition( CLangCondition::Ptr cond )
+      {
+          M_condition = std::move( cond );
+      }
+
     /*!
       \brief add directive to this rule
       \param dir new directive object pointer
@@ -189,6 +199,15 @@ public:
           M_directives.push_back( CLangDirective::ConstPtr( dir ) );
       }
 
+    /*!
+      \brief add directive to this rule
+      \param dir new directive object
+     */
+    void addDirective( CLangDirective::ConstPtr dir )
+      {
+          M_directives.push_back( std::move( dir ) );
+      }
+
     /*!
       \brief get TTL value
       \return TTL value
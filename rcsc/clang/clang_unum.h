@@ -33,7 +33,8 @@
 #define RCSC_CLANG_UNUM_H
 
 #include <memory>
-#include <set>
+#include <vector>
+#include <algorithm>
 #include <iostream>
 
 namespace rcsc {
@@ -41,6 +42,9 @@ namespace rcsc {
 /*!
   \class CLangUnumSet
   \brief set of uniform number
+
+  The entries are kept in a sorted vector. The set is very small, so the
+  contiguous storage is faster than a tree for all operations.
  */
 class CLangUnumSet {
 public:
@@ -48,8 +52,8 @@ public:
     //! smart pointer type
     typedef std::shared_ptr< CLangUnumSet > Ptr;
 
-    //! set container type
-    typedef std::set< int > Set;
+    //! set container type. sorted and unique.
+    typedef std::vector< int > Set;
 
     static const int All;
 
@@ -73,7 +77,11 @@ public:
     explicit
     CLangUnumSet( const Set & unum_set )
         : M_entries( unum_set )
-      { }
+      {
+          std::sort( M_entries.begin(), M_entries.end() );
+          M_entries.erase( std::unique( M_entries.begin(), M_entries.end() ),
+                           M_entries.end() );
+      }
 
     /*!
       \brief create with an uniform number.
@@ -81,9 +89,8 @@ public:
      */
     explicit
     CLangUnumSet( const int unum )
-      {
-          M_entries.insert( unum );
-      }
+        : M_entries( 1, unum )
+      { }
 
     // ~CLangUnumSet()
     //   {
@@ -105,7 +112,12 @@ public:
      */
     void add( const int unum )
       {
-          M_entries.insert( unum );
+          Set::iterator it = std::lower_bound( M_entries.begin(), M_entries.end(), unum );
+          if ( it == M_entries.end()
+               || *it != unum )
+          {
+              M_entries.insert( it, unum );
+          }
       }
 
     /*!
@@ -114,7 +126,7 @@ public:
      */
     bool isAll() const
       {
-          return M_entries.find( All ) != M_entries.end();
+          return contains( All );
       }
 
     /*!
@@ -124,7 +136,7 @@ public:
      */
     bool contains( const int unum ) const
       {
-          return M_entries.find( unum ) != M_entries.end();
+          return std::binary_search( M_entries.begin(), M_entries.end(), unum );
       }
 
     /*!
@@ -35,6 +35,7 @@
 #include "clang_parser.h"
 
 #include "clang_info_message.h"
+#include "clang_message_cache.h"
 
 #include <rcsc/time/timer.h>
 #include <rcsc/game_time.h>
@@ -42,6 +43,7 @@
 #include <cppunit/extensions/HelperMacros.h>
 
 #include <iostream>
+#include <algorithm>
 #include <cmath>
 
 /*!
@@ -52,6 +54,9 @@ class CLangParserTest
 
     CPPUNIT_TEST_SUITE( CLangParserTest );
     CPPUNIT_TEST( testInfoMessage );
+    CPPUNIT_TEST( testInvalidMessage );
+    CPPUNIT_TEST( testThroughput );
+    CPPUNIT_TEST( testCache );
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -62,6 +67,9 @@ public:
 protected:
 
     void testInfoMessage();
+    void testInvalidMessage();
+    void testThroughput();
+    void testCache();
 };
 
 
@@ -130,7 +138,10 @@ CLangParserTest::testInfoMessage()
         }
 
         std::cout << "parsed tokens:\n";
-        for ( const rcsc::CLangToken & tok = info->tokens() )
+        CPPUNIT_ASSERT( info );
+        CPPUNIT_ASSERT_EQUAL( std::size_t( 1 ), info->tokens().size() );
+
+        for ( const rcsc::CLangToken::ConstPtr & tok : info->tokens() )
         {
             std::cout << "    " << *tok << std::endl;
         }
@@ -141,6 +152,112 @@ CLangParserTest::testInfoMessage()
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CLangParserTest::testInvalidMessage()
+{
+    rcsc::CLangParser parser;
+
+    CPPUNIT_ASSERT( ! parser.parse( "" ) );
+    CPPUNIT_ASSERT( ! parser.message() );
+
+    CPPUNIT_ASSERT( ! parser.parse( "(info (10 (maybe) (do our {1} (hold))))" ) );
+    CPPUNIT_ASSERT( ! parser.parse( "(info (10 (true) (do our {1} (pass))))" ) );
+    CPPUNIT_ASSERT( ! parser.parse( "(info (10 (true) (do our {1} (hold)))" ) );
+    CPPUNIT_ASSERT( ! parser.parse( "(info (10 (true) (do our {+1} (hold))))" ) );
+    CPPUNIT_ASSERT( ! parser.message() );
+
+    // the message object is created, but the trailing characters are not allowed.
+    CPPUNIT_ASSERT( ! parser.parse( "(info (10 (true) (do our {1} (hold)))) extra" ) );
+    CPPUNIT_ASSERT( parser.message() );
+
+    CPPUNIT_ASSERT( parser.parse( "(info (clear))" ) );
+    CPPUNIT_ASSERT( parser.message() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CLangParserTest::testThroughput()
+{
+    const std::string messages[] = {
+        "(info (6000 (true) (do our {1} (mark {2 3}))))",
+        "(info (6000 (true) (do opp {1} (htype 1)))(0 (true) (do opp {2} (htype 2))))",
+        "(info (6000 (true) (do opp {1} (htype 1)) (do opp {2} (htype 2)) (do our {1} (mark {2 3}))))",
+        "(info (6000 (true) (do opp {1} (htype -1)) (do opp {2} (htype -1)) (do opp {3} (htype -1)) (do opp {4} (htype -1)) (do opp {5} (htype -1)) (do opp {6} (htype -1)) (do opp {7} (htype -1)) (do opp {8} (htype -1)) (do opp {9} (htype 10)) (do opp {10} (htype -1)) (do opp {11} (htype -1))))",
+        "(info (6000 (true) (dont our {1} (mark {0})) (dont our {2} (mark {0})) (dont our {3} (mark {0})) (dont our {4} (mark {0})) (dont our {5} (mark {0})) (dont our {6} (mark {0})) (dont our {7} (mark {0})) (dont our {8} (mark {0})) (dont our {9} (mark {0})) (dont our {10} (mark {0})) (dont our {11} (mark {0}))))",
+    };
+
+    const int loop = 10000;
+
+    rcsc::CLangParser parser;
+    parser.setCache( nullptr ); // measure the parser itself
+    std::size_t total_bytes = 0;
+
+    rcsc::Timer timer;
+    for ( int i = 0; i < loop; ++i )
+    {
+        for ( const std::string & msg : messages )
+        {
+            CPPUNIT_ASSERT( parser.parse( msg ) );
+            total_bytes += msg.length();
+        }
+    }
+    const double elapsed = timer.elapsedReal();
+
+    const int n_messages = loop * static_cast< int >( sizeof( messages ) / sizeof( messages[0] ) );
+    std::cout << '\n'
+              << n_messages << " messages, " << total_bytes << " bytes, elapsed " << elapsed << " [ms]\n"
+              << "  " << ( elapsed * 1000.0 / n_messages ) << " [us/message], "
+              << ( total_bytes / 1000.0 / std::max( elapsed, 1.0e-3 ) ) << " [MB/s]" << std::endl;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CLangParserTest::testCache()
+{
+    rcsc::CLangMessageCache cache( 2 );
+
+    rcsc::CLangParser parser;
+    parser.setCache( &cache );
+
+    const std::string msg1 = "(info (6000 (true) (do our {1} (mark {2 3}))))";
+    const std::string msg2 = "(info (6000 (true) (do opp {1} (htype 1))))";
+    const std::string msg3 = "(info (clear))";
+
+    CPPUNIT_ASSERT( parser.parse( msg1 ) );
+    const rcsc::CLangMessage::ConstPtr first = parser.message();
+    CPPUNIT_ASSERT( first );
+    CPPUNIT_ASSERT_EQUAL( std::uint64_t( 0 ), cache.hitCount() );
+
+    // the same message object is returned without parsing.
+    CPPUNIT_ASSERT( parser.parse( msg1 ) );
+    CPPUNIT_ASSERT( parser.message() == first );
+    CPPUNIT_ASSERT_EQUAL( std::uint64_t( 1 ), cache.hitCount() );
+
+    // the invalid result is also cached.
+    CPPUNIT_ASSERT( ! parser.parse( "(info (10 (maybe) (do our {1} (hold))))" ) );
+    CPPUNIT_ASSERT( ! parser.parse( "(info (10 (maybe) (do our {1} (hold))))" ) );
+    CPPUNIT_ASSERT( ! parser.message() );
+    CPPUNIT_ASSERT_EQUAL( std::uint64_t( 2 ), cache.hitCount() );
+
+    // the least recently used entry (msg1) is dropped.
+    CPPUNIT_ASSERT( parser.parse( msg2 ) );
+    CPPUNIT_ASSERT( parser.parse( msg3 ) );
+    CPPUNIT_ASSERT_EQUAL( std::size_t( 2 ), cache.size() );
+    CPPUNIT_ASSERT( parser.parse( msg1 ) );
+    CPPUNIT_ASSERT( parser.message() != first );
+    CPPUNIT_ASSERT_EQUAL( std::uint64_t( 2 ), cache.hitCount() );
+}
+
 
 /*-------------------------------------------------------------------*/
 /*-------------------------------------------------------------------*/
@@ -45,21 +45,30 @@
 #include <rcsc/common/abstract_client.h>
 #include <rcsc/common/audio_codec.h>
 #include <rcsc/common/online_client.h>
+#include <rcsc/common/shm_client.h>
 #include <rcsc/common/offline_client.h>
 #include <rcsc/common/logger.h>
 #include <rcsc/common/server_param.h>
 #include <rcsc/common/player_param.h>
 #include <rcsc/common/player_type.h>
+#include <rcsc/common/shared_param.h>
 #include <rcsc/common/team_graphic.h>
+#include <rcsc/common/trace_recorder.h>
 #include <rcsc/common/audio_memory.h>
 #include <rcsc/common/say_message_parser.h>
 
+#include <rcsc/net/host_address.h>
+#include <rcsc/util/memory_accounting.h>
+#include <rcsc/util/runtime_tuning.h>
+#include <rcsc/util/playmode_decoder.h>
+
 #include <rcsc/param/param_map.h>
 #include <rcsc/param/conf_file_parser.h>
 #include <rcsc/param/cmd_line_parser.h>
 #include <rcsc/timer.h>
 #include <rcsc/version.h>
 
+#include <algorithm>
 #include <sstream>
 #include <cstring>
 
@@ -109,6 +118,12 @@ struct CoachAgent::Impl {
     //! clang message to be sent
     CLangMessage::ConstPtr clang_message_;
 
+    //! time span recorder of the cycle phases
+    TraceRecorder trace_;
+
+    //! name prefix of the memory probes of this agent. empty if not registered.
+    std::string memory_label_;
+
     /*!
       \brief initialize all members
     */
@@ -135,6 +150,28 @@ struct CoachAgent::Impl {
     */
     bool openDebugLog();
 
+    /*!
+      \brief write the trace event file.
+     */
+    void writeTrace();
+
+    /*!
+      \brief apply the cpu affinity, the scheduling priority and the memory
+      locking to the calling thread. called on the agent thread.
+     */
+    void applyRuntimeTuning();
+
+    /*!
+      \brief register the memory probes of this agent to MemoryAccounting.
+     */
+    void registerMemoryProbes();
+
+    /*!
+      \brief detach the memory probes of this agent, and write the memory
+      report file if enabled.
+     */
+    void writeMemoryReport();
+
     /*!
       \brief set debug output flags to logger
      */
@@ -429,6 +466,10 @@ CoachAgent::createConsoleClient()
     {
         ptr = std::shared_ptr< AbstractClient >( new OfflineClient() );
     }
+    else if ( config().shmTransport() )
+    {
+        ptr = std::shared_ptr< AbstractClient >( new ShmClient() );
+    }
     else
     {
         ptr = std::shared_ptr< AbstractClient >( new OnlineClient() );
@@ -517,6 +558,18 @@ CoachAgent::initImpl( CmdLineParser & cmd_parser )
 
     AudioCodec::instance().createMap( config().audioShift() );
 
+    // resolve the server host while the rest of the initialization runs.
+    if ( ! config().offlineClientMode()
+         && ! config().host().empty() )
+    {
+        HostAddress::resolve_async( config().host() );
+    }
+
+    if ( config().hugePages() )
+    {
+        RuntimeTuning::set_huge_pages( true );
+    }
+
     return true;
 }
 
@@ -554,6 +607,8 @@ CoachAgent::handleStart()
 
     M_client->setIntervalMSec( config().intervalMSec() );
 
+    M_impl->applyRuntimeTuning();
+
     M_impl->sendInitCommand();
 
     return true;
@@ -598,10 +653,14 @@ CoachAgent::handleMessage()
     GameTime start_time = M_impl->current_time_;
 
     // receive and analyze message
-    while ( M_client->receiveMessage() > 0 )
     {
-        ++counter;
-        parse( M_client->message() );
+        TraceRecorder::Scope trace_receive( M_impl->trace_, "receive" );
+        while ( M_client->receiveMessage() > 0 )
+        {
+            TraceRecorder::Scope trace( M_impl->trace_, "parse" );
+            ++counter;
+            parse( M_client->message() );
+        }
     }
 
     if ( M_impl->current_time_.cycle() > start_time.cycle() + 1
@@ -783,6 +842,8 @@ CoachAgent::finalize()
     {
         M_impl->sendByeCommand();
     }
+    M_impl->writeTrace();
+    M_impl->writeMemoryReport();
     std::cout << config().teamName() << " coach: finished."
               << std::endl;
 }
@@ -794,6 +855,9 @@ CoachAgent::finalize()
 void
 CoachAgent::Impl::initDebug()
 {
+    trace_.setEnabled( agent_.config().trace(),
+                       static_cast< std::size_t >( std::max( 0, agent_.config().traceSize() ) ) );
+
     if ( ! agent_.config().offlineClientMode() )
     {
         if ( agent_.config().debugServerConnect() )
@@ -860,6 +924,12 @@ CoachAgent::Impl::openOfflineLog()
 bool
 CoachAgent::Impl::openDebugLog()
 {
+    if ( dlog.isDisabled() )
+    {
+        // several agents share the process. see TeamRunner.
+        return true;
+    }
+
     std::string filepath = agent_.config().logDir();
 
     if ( ! filepath.empty() )
@@ -870,11 +940,19 @@ CoachAgent::Impl::openDebugLog()
         }
     }
 
-    filepath += agent_.config().teamName();
-    filepath += "-coach";
-    filepath += agent_.config().debugLogExt();
+    if ( ! agent_.config().debugLogContainer().empty() )
+    {
+        filepath += agent_.config().debugLogContainer();
+        dlog.openContainer( filepath, agent_.config().teamName() + "-coach" );
+    }
+    else
+    {
+        filepath += agent_.config().teamName();
+        filepath += "-coach";
+        filepath += agent_.config().debugLogExt();
 
-    dlog.open( filepath );
+        dlog.open( filepath );
+    }
 
     if ( ! dlog.isOpen() )
     {
@@ -888,6 +966,156 @@ CoachAgent::Impl::openDebugLog()
     return true;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CoachAgent::Impl::writeTrace()
+{
+    if ( ! trace_.isEnabled() )
+    {
+        return;
+    }
+
+    trace_.setLabel( "coach", agent_.config().teamName(), "coach", 12 );
+
+    std::string filepath = agent_.config().logDir();
+
+    if ( ! filepath.empty() )
+    {
+        if ( *filepath.rbegin() != '/' )
+        {
+            filepath += '/';
+        }
+    }
+
+    filepath += agent_.config().teamName();
+    filepath += "-coach";
+    filepath += agent_.config().traceExt();
+
+    if ( ! trace_.writeJSON( filepath ) )
+    {
+        std::cerr << agent_.config().teamName() << " coach: "
+                  << " Failed to write the trace file [" << filepath << "]"
+                  << std::endl;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CoachAgent::Impl::registerMemoryProbes()
+{
+    if ( ! memory_label_.empty() )
+    {
+        return;
+    }
+
+    memory_label_ = agent_.config().teamName() + "-coach/";
+
+    MemoryAccounting & accounting = MemoryAccounting::instance();
+
+    accounting.addProbe( "logger",
+                         []() { return dlog.memoryUsage(); } );
+    accounting.addProbe( memory_label_ + "world_model",
+                         [this]() { return agent_.world().memoryUsage(); } );
+    accounting.addProbe( memory_label_ + "audio_memory",
+                         [this]() { return agent_.world().audioMemory().memoryUsage(); } );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CoachAgent::Impl::applyRuntimeTuning()
+{
+    const CoachConfig & config = agent_.config();
+
+    if ( ! config.cpuAffinity().empty() )
+    {
+        std::vector< int > cpus;
+        if ( ! RuntimeTuning::parse_cpu_list( config.cpuAffinity(), &cpus )
+             || ! RuntimeTuning::set_cpu_affinity( cpus ) )
+        {
+            std::cerr << config.teamName() << " coach"
+                      << ": ***WARNING*** failed to set the cpu affinity ["
+                      << config.cpuAffinity() << "]" << std::endl;
+        }
+    }
+
+    if ( config.realtimePriority() > 0
+         && ! RuntimeTuning::set_fifo_priority( config.realtimePriority() ) )
+    {
+        std::cerr << config.teamName() << " coach"
+                  << ": ***WARNING*** failed to set the real-time priority "
+                  << config.realtimePriority() << std::endl;
+    }
+
+    if ( config.niceValue() != 0
+         && ! RuntimeTuning::set_nice( config.niceValue() ) )
+    {
+        std::cerr << config.teamName() << " coach"
+                  << ": ***WARNING*** failed to set the nice value "
+                  << config.niceValue() << std::endl;
+    }
+
+    if ( config.lockMemory()
+         && ! RuntimeTuning::lock_memory() )
+    {
+        std::cerr << config.teamName() << " coach"
+                  << ": ***WARNING*** failed to lock the memory" << std::endl;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CoachAgent::Impl::writeMemoryReport()
+{
+    if ( memory_label_.empty() )
+    {
+        return;
+    }
+
+    MemoryAccounting & accounting = MemoryAccounting::instance();
+
+    if ( agent_.config().memoryReport() )
+    {
+        accounting.sample();
+
+        std::string filepath = agent_.config().logDir();
+
+        if ( ! filepath.empty() )
+        {
+            if ( *filepath.rbegin() != '/' )
+            {
+                filepath += '/';
+            }
+        }
+
+        filepath += agent_.config().teamName();
+        filepath += "-coach";
+        filepath += agent_.config().memoryReportExt();
+
+        if ( ! accounting.writeJSON( filepath ) )
+        {
+            std::cerr << agent_.config().teamName() << " coach: "
+                      << " Failed to write the memory report [" << filepath << "]"
+                      << std::endl;
+        }
+    }
+
+    // the probes refer to this agent.
+    accounting.removeProbe( memory_label_ + "world_model" );
+    accounting.removeProbe( memory_label_ + "audio_memory" );
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -938,27 +1166,39 @@ CoachAgent::action()
         M_client->printOfflineThink();
     }
 
+    TraceRecorder::Scope trace_action( M_impl->trace_, "action" );
     Timer timer;
     dlog.addText( Logger::SYSTEM,
                   __FILE__" (action) start" );
 
     if ( M_impl->last_decision_time_ != M_impl->current_time_ )
     {
-        M_worldmodel.updateJustBeforeDecision( M_impl->current_time_ );
+        {
+            TraceRecorder::Scope trace( M_impl->trace_, "update_before_decision" );
+            M_worldmodel.updateJustBeforeDecision( M_impl->current_time_ );
+        }
+
+        {
+            TraceRecorder::Scope trace( M_impl->trace_, "action_impl" );
+            //
+            // handle action start event
+            //
+            handleActionStart();
 
-        //
-        // handle action start event
-        //
-        handleActionStart();
+            actionImpl();
+        }
 
-        actionImpl();
-        M_impl->sendCLang();
-        M_impl->sendFreeformMessage();
+        {
+            TraceRecorder::Scope trace( M_impl->trace_, "send" );
+            M_impl->sendCLang();
+            M_impl->sendFreeformMessage();
+        }
         M_impl->last_decision_time_ = M_impl->current_time_;
     }
 
     if ( M_impl->think_received_ )
     {
+        TraceRecorder::Scope trace( M_impl->trace_, "send" );
         CoachDoneCommand com;
         sendCommand( com );
         M_impl->think_received_ = false;
@@ -978,6 +1218,15 @@ CoachAgent::action()
     //
     M_impl->printDebug();
 
+    //
+    // memory accounting
+    //
+    M_impl->registerMemoryProbes();
+    if ( config().memoryReport() )
+    {
+        MemoryAccounting::instance().sample();
+    }
+
     //
     // delete all messages
     //
@@ -1096,6 +1345,7 @@ CoachAgent::Impl::analyzeInit( const char * msg )
                        ? LEFT
                        : RIGHT );
     agent_.M_worldmodel.init( agent_.config().teamName(), side_id, agent_.config().version() );
+    agent_.M_worldmodel.setStateHistorySize( agent_.config().stateHistorySize() );
 
     if ( agent_.config().hearSay() )
     {
@@ -1141,6 +1391,7 @@ CoachAgent::Impl::analyzeCycle( const char * msg,
     }
 
     updateCurrentTime( cycle, by_see_global );
+    trace_.setCycle( current_time_.cycle() );
     return true;
 }
 
@@ -1151,6 +1402,7 @@ CoachAgent::Impl::analyzeCycle( const char * msg,
 void
 CoachAgent::Impl::analyzeSeeGlobal( const char * msg )
 {
+    TraceRecorder::Scope trace( trace_, "parse_see_global" );
     see_time_stamp_.setNow();
 
     if ( ! analyzeCycle( msg, true ) )
@@ -1169,6 +1421,7 @@ CoachAgent::Impl::analyzeSeeGlobal( const char * msg )
     // update world model
     if ( visual_.time() == current_time_ )
     {
+        TraceRecorder::Scope trace( trace_, "update_after_see_global" );
         agent_.M_worldmodel.updateAfterSeeGlobal( visual_,
                                                   current_time_ );
     }
@@ -1181,6 +1434,7 @@ CoachAgent::Impl::analyzeSeeGlobal( const char * msg )
 void
 CoachAgent::Impl::analyzeHear( const char * msg )
 {
+    TraceRecorder::Scope trace( trace_, "parse_hear" );
     if ( ! analyzeCycle( msg, false ) )
     {
         return;
@@ -1237,43 +1491,28 @@ CoachAgent::Impl::analyzeHearReferee( const char * msg )
         return;
     }
 
-    if ( ! game_mode_.update( mode, current_time_ ) )
-    {
-        if ( ! std::strncmp( mode, "yellow_card", std::strlen( "yellow_card" ) ) )
-        {
-            char side = '?';
-            int unum = Unum_Unknown;
-            if ( std::sscanf( mode, "yellow_card_%c_%d", &side, &unum ) != 2 )
-            {
-                std::cerr << c.teamName()
-                          << " coach: "
-                          << wm.time()
-                          << " could not parse the yellow card message [" << msg << ']'
-                          << std::endl;
-            }
+    PlayModeInfo info;
+    PlayModeDecoder::decode( mode, &info );
 
-            agent_.M_worldmodel.setCard( ( side == 'l' ? LEFT : side == 'r' ? RIGHT : NEUTRAL ),
-                                         unum,
-                                         YELLOW );
-        }
-        else if ( ! std::strncmp( mode, "red_card", std::strlen( "red_card" ) ) )
+    if ( ! game_mode_.update( info, current_time_ ) )
+    {
+        if ( info.kind_ == PlayModeInfo::YELLOW_CARD
+             || info.kind_ == PlayModeInfo::RED_CARD )
         {
-            char side = '?';
-            int unum = Unum_Unknown;
-            if ( std::sscanf( mode, "red_card_%c_%d", &side, &unum ) != 2 )
+            if ( info.value_ < 0 )
             {
                 std::cerr << c.teamName()
                           << " coach: "
                           << wm.time()
-                          << " could not parse the red card message [" << msg << ']'
+                          << " could not parse the card message [" << msg << ']'
                           << std::endl;
             }
 
-            agent_.M_worldmodel.setCard( ( side == 'l' ? LEFT : side == 'r' ? RIGHT : NEUTRAL ),
-                                         unum,
-                                         RED );
+            agent_.M_worldmodel.setCard( info.side_,
+                                         ( info.value_ < 0 ? Unum_Unknown : info.value_ ),
+                                         ( info.kind_ == PlayModeInfo::YELLOW_CARD ? YELLOW : RED ) );
         }
-        else if ( ! std::strncmp( mode, "training", std::strlen( "training" ) ) )
+        else if ( info.kind_ == PlayModeInfo::TRAINING )
         {
             // end keepaway (or some training) episode
             agent_.M_worldmodel.setTrainingTime( current_time_ );
@@ -1366,8 +1605,13 @@ CoachAgent::Impl::analyzeChangePlayerType( const char * msg )
 void
 CoachAgent::Impl::analyzePlayerType( const char * msg )
 {
-    PlayerType player_type( msg, agent_.config().version() );
-    PlayerTypeSet::instance().insert( player_type );
+    const double version = agent_.config().version();
+    SharedParam::apply( msg, version,
+                        [&]()
+                          {
+                              PlayerType player_type( msg, version );
+                              PlayerTypeSet::instance().insert( player_type );
+                          } );
 
     agent_.handlePlayerType();
 }
@@ -1379,7 +1623,12 @@ CoachAgent::Impl::analyzePlayerType( const char * msg )
 void
 CoachAgent::Impl::analyzePlayerParam( const char * msg )
 {
-    PlayerParam::instance().parse( msg, agent_.config().version() );
+    const double version = agent_.config().version();
+    SharedParam::apply( msg, version,
+                        [&]()
+                          {
+                              PlayerParam::instance().parse( msg, version );
+                          } );
     //PlayerParam::i().print( std::cout );
 
     agent_.M_worldmodel.setPlayerParam();
@@ -1393,8 +1642,13 @@ CoachAgent::Impl::analyzePlayerParam( const char * msg )
 void
 CoachAgent::Impl::analyzeServerParam( const char * msg )
 {
-    ServerParam::instance().parse( msg, agent_.config().version() );
-    PlayerTypeSet::instance().resetDefaultType();
+    const double version = agent_.config().version();
+    SharedParam::apply( msg, version,
+                        [&]()
+                          {
+                              ServerParam::instance().parse( msg, version );
+                              PlayerTypeSet::instance().resetDefaultType();
+                          } );
 
     if ( ! ServerParam::i().synchMode()
          && ServerParam::i().slowDownFactor() > 1 )
@@ -48,7 +48,6 @@ namespace rcsc {
 class CLangMessage;
 class CoachAudioSensor;
 class CoachCommand;
-class GlobalVisualSensor;
 class SayMessageParser;
 
 /*!
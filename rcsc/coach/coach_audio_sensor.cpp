@@ -38,6 +38,8 @@
 #include <rcsc/common/say_message_parser.h>
 #include <rcsc/common/logger.h>
 
+#include <algorithm>
+#include <string_view>
 #include <cstdio>
 #include <cstring>
 
@@ -52,7 +54,8 @@ CoachAudioSensor::CoachAudioSensor()
       M_opponent_message_time( -1, 0 ),
       M_trainer_message_time( -1, 0 )
 {
-
+    std::fill( M_say_message_parser_table, M_say_message_parser_table + 256,
+               static_cast< SayMessageParser * >( nullptr ) );
 }
 
 /*-------------------------------------------------------------------*/
@@ -96,6 +99,7 @@ CoachAudioSensor::addParser( SayMessageParser::Ptr parser )
 
     M_say_message_parsers.insert( ParserMap::value_type( parser->header(),
                                                          parser ) );
+    M_say_message_parser_table[static_cast< unsigned char >( parser->header() )] = parser.get();
 }
 
 /*-------------------------------------------------------------------*/
@@ -116,6 +120,7 @@ CoachAudioSensor::removeParser( const char header )
     }
 
     M_say_message_parsers.erase( it );
+    M_say_message_parser_table[static_cast< unsigned char >( header )] = nullptr;
 }
 
 /*-------------------------------------------------------------------*/
@@ -291,37 +296,27 @@ CoachAudioSensor::parseTeammateMessage( const HearMessage & message )
         return;
     }
 
-    const ParserMap::iterator end = M_say_message_parsers.end();
-
-    const char * msg = message.str_.c_str();
+    std::string_view cursor( message.str_ );
 
-    int n_parsed = 0;
-    while ( *msg != '\0' )
+    while ( ! cursor.empty() )
     {
-        int len = 0;
-
-        ParserMap::iterator it = M_say_message_parsers.find( *msg );
+        SayMessageParser * parser
+            = M_say_message_parser_table[static_cast< unsigned char >( cursor.front() )];
 
-        if ( it == end )
+        if ( ! parser )
         {
             dlog.addText( Logger::SENSOR,
                           "CoachAudioSensor: unsupported message [%s] in [%s]",
-                          msg, message.str_.c_str() );
+                          cursor.data(), message.str_.c_str() );
             return;
         }
 
-        len = it->second->parse( message.unum_, message.dir_, msg,
-                                 M_teammate_message_time );
-
-        if ( len < 0 )
+        if ( parser->consume( message.unum_, message.dir_, cursor,
+                              M_teammate_message_time ) <= 0 )
         {
             return;
         }
-
-        ++n_parsed;
-        msg += len;
     }
-
 }
 
 }
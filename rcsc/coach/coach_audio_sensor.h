@@ -62,6 +62,9 @@ private:
     //! teammate message parsers
     ParserMap M_say_message_parsers;
 
+    //! dispatch table indexed by the header character. refers to the parsers in M_say_message_parsers.
+    SayMessageParser * M_say_message_parser_table[256];
+
     //! last time that teammate message is heard
     GameTime M_teammate_message_time;
 
@@ -0,0 +1,337 @@
+// -*-c++-*-
+
+/*!
+  \file coach_ball_event_log.cpp
+  \brief bounded log of the kick, tackle and catch events Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "coach_ball_event_log.h"
+
+#include "coach_world_state.h"
+
+#include <rcsc/common/server_param.h>
+#include <rcsc/common/player_type.h>
+#include <rcsc/game_mode.h>
+
+#include <cmath>
+
+namespace rcsc {
+
+constexpr std::size_t CoachBallEventLog::CAPACITY;
+
+namespace {
+
+/*!
+  \struct TouchCandidate
+  \brief the nearest touching player of one group
+ */
+struct TouchCandidate {
+    const CoachPlayerObject * player_;
+    CoachBallEvent::Type type_;
+    double prev_dist_;
+    bool left_; //!< a left team player is found
+    bool right_; //!< a right team player is found
+
+    TouchCandidate()
+        : player_( nullptr ),
+          type_( CoachBallEvent::KICK ),
+          prev_dist_( 1000000.0 ),
+          left_( false ),
+          right_( false )
+      { }
+
+    void add( const CoachPlayerObject * p,
+              const CoachBallEvent::Type type,
+              const double prev_dist )
+      {
+          ( p->side() == LEFT ? left_ : right_ ) = true;
+          if ( prev_dist < prev_dist_ )
+          {
+              player_ = p;
+              type_ = type;
+              prev_dist_ = prev_dist;
+          }
+      }
+};
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CoachBallEventLog::CoachBallEventLog()
+    : M_last_update_time( -1, 0 ),
+      M_current_found( false ),
+      M_flags_observed( false )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CoachBallEventLog::clear()
+{
+    M_events.clear();
+    M_kicks.clear();
+    M_last_update_time.assign( -1, 0 );
+    M_current_found = false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const CoachBallEvent *
+CoachBallEventLog::update( const CoachWorldState & current,
+                           const CoachWorldState * prev,
+                           const PlayerGrid & grid )
+{
+    if ( current.time() == M_last_update_time )
+    {
+        return this->current();
+    }
+
+    M_last_update_time = current.time();
+    M_current_found = false;
+
+    if ( ! prev )
+    {
+        return nullptr;
+    }
+
+    CoachBallEvent event;
+    if ( extractCatch( current, *prev, grid, &event )
+         || extractTouch( current, *prev, grid, &event ) )
+    {
+        push( event );
+        M_current_found = true;
+    }
+
+    return this->current();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+CoachBallEventLog::extractTouch( const CoachWorldState & current,
+                                 const CoachWorldState & prev,
+                                 const PlayerGrid & grid,
+                                 CoachBallEvent * event )
+{
+    const ServerParam & SP = ServerParam::i();
+
+    const Vector2D & ball_pos = current.ball().pos();
+    const Vector2D & ball_vel = current.ball().vel();
+    const Vector2D & prev_ball_pos = prev.ball().pos();
+    const Vector2D & prev_ball_vel = prev.ball().vel();
+
+    //
+    // check the ball acceleration.
+    // the ball noise is added to each axis before the decay.
+    //
+    const double noise = std::sqrt( 2.0 ) * SP.ballRand() * prev_ball_vel.r() * SP.ballDecay()
+        + 0.01;
+    const bool accelerated = ( ball_vel - prev_ball_vel * SP.ballDecay() ).r() > noise;
+
+    const double tacklable = std::sqrt( std::pow( SP.tackleDist(), 2 )
+                                        + std::pow( SP.tackleWidth(), 2 ) )
+        + 0.001;
+    const double tackle_thr = tacklable + SP.ballSpeedMax();
+
+    //
+    // the touching player must be within the ball move distance from the current ball.
+    // the tackle area covers the kickable area of all player types.
+    //
+    grid.withinCircle( ball_pos,
+                       tackle_thr,
+                       []( const CoachPlayerObject * ) { return true; },
+                       &M_near_players );
+
+    TouchCandidate flagged;
+    TouchCandidate unflagged;
+
+    for ( const PlayerGrid::Result::value_type & v : M_near_players )
+    {
+        const CoachPlayerObject * p = v.second;
+        const bool kick_flag = p->isKicking();
+        const bool tackle_flag = ( p->tackleCycle() == 1 );
+        const bool has_flag = kick_flag || tackle_flag;
+
+        if ( ! has_flag
+             && ( ! accelerated || M_flags_observed ) )
+        {
+            continue;
+        }
+
+        const CoachPlayerObject * prev_p = prev.getPlayer( p->side(), p->unum() );
+        if ( ! prev_p )
+        {
+            // no previous observation.
+            continue;
+        }
+
+        const double kickable = ( ( p->type() != Hetero_Unknown
+                                    && p->playerTypePtr() )
+                                  ? p->playerTypePtr()->kickableArea()
+                                  : SP.defaultKickableArea() )
+            + 0.001;
+        const double kick_thr = kickable + SP.ballSpeedMax();
+
+        const double current_dist = std::sqrt( v.first );
+        const double prev_dist = prev_p->pos().dist( prev_ball_pos );
+
+        TouchCandidate & group = ( has_flag ? flagged : unflagged );
+        if ( ( kick_flag || ! has_flag )
+             && prev_dist < kickable
+             && current_dist < kick_thr )
+        {
+            group.add( p, CoachBallEvent::KICK, prev_dist );
+        }
+        else if ( ( tackle_flag || ! has_flag )
+                  && prev_dist <= tacklable
+                  && current_dist <= tackle_thr )
+        {
+            group.add( p, CoachBallEvent::TACKLE, prev_dist );
+        }
+    }
+
+    if ( flagged.player_ )
+    {
+        M_flags_observed = true;
+    }
+
+    const TouchCandidate & result = ( flagged.player_ ? flagged : unflagged );
+    if ( ! result.player_ )
+    {
+        return false;
+    }
+
+    event->type_ = result.type_;
+    event->time_ = current.time();
+    if ( result.left_ && result.right_ )
+    {
+        event->side_ = NEUTRAL;
+        event->unum_ = Unum_Unknown;
+    }
+    else
+    {
+        event->side_ = result.player_->side();
+        event->unum_ = result.player_->unum();
+    }
+    event->ball_pos_ = prev_ball_pos;
+    event->ball_vel_ = ball_vel;
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+CoachBallEventLog::extractCatch( const CoachWorldState & current,
+                                 const CoachWorldState & prev,
+                                 const PlayerGrid & grid,
+                                 CoachBallEvent * event ) const
+{
+    //
+    // the live referee announces goalie_catch_ball, but the game log only
+    // records the following free kick. in that case, the goalie must hold
+    // the ball.
+    //
+    const GameMode::Type type = current.gameMode().type();
+    const GameMode::Type prev_type = prev.gameMode().type();
+
+    const bool announced = ( type == GameMode::GoalieCatch_
+                             && prev_type != GameMode::GoalieCatch_ );
+    if ( ! announced
+         && ( type != GameMode::FreeKick_
+              || prev_type != GameMode::PlayOn ) )
+    {
+        return false;
+    }
+
+    const SideID side = current.gameMode().side();
+
+    const CoachPlayerObject * goalie = nullptr;
+    double dist2 = 0.0;
+    grid.nearest( current.ball().pos(),
+                  [side]( const CoachPlayerObject * p )
+                  {
+                      return p->side() == side && p->goalie();
+                  },
+                  &goalie,
+                  &dist2 );
+
+    if ( ! announced )
+    {
+        const double catchable = ( goalie && goalie->playerTypePtr()
+                                   ? goalie->playerTypePtr()->maxCatchableDist()
+                                   : ServerParam::i().catchableArea() );
+        if ( ! goalie
+             || dist2 > catchable * catchable )
+        {
+            return false;
+        }
+    }
+
+    event->type_ = CoachBallEvent::CATCH;
+    event->time_ = current.time();
+    event->side_ = side;
+    event->unum_ = ( goalie ? goalie->unum() : Unum_Unknown );
+    event->ball_pos_ = prev.ball().pos();
+    event->ball_vel_ = current.ball().vel();
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CoachBallEventLog::push( const CoachBallEvent & event )
+{
+    M_events.push_front( event );
+    if ( event.type_ == CoachBallEvent::KICK )
+    {
+        M_kicks.push_front( event );
+    }
+}
+
+}
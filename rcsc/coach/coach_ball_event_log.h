@@ -0,0 +1,221 @@
+// -*-c++-*-
+
+/*!
+  \file coach_ball_event_log.h
+  \brief bounded log of the kick, tackle and catch events Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_COACH_COACH_BALL_EVENT_LOG_H
+#define RCSC_COACH_COACH_BALL_EVENT_LOG_H
+
+#include <rcsc/coach/coach_player_object.h>
+#include <rcsc/geom/uniform_grid_2d.h>
+#include <rcsc/geom/vector_2d.h>
+#include <rcsc/util/ring_buffer.h>
+#include <rcsc/game_time.h>
+#include <rcsc/types.h>
+
+#include <cstddef>
+
+namespace rcsc {
+
+class CoachWorldState;
+
+/*!
+  \struct CoachBallEvent
+  \brief one ball touch event extracted from two consecutive states
+ */
+struct CoachBallEvent {
+    /*!
+      \brief event type
+     */
+    enum Type {
+        KICK,
+        TACKLE,
+        CATCH,
+    };
+
+    Type type_; //!< event type
+    GameTime time_; //!< the time of the state in which the event is observed
+    SideID side_; //!< the touching player's side. NEUTRAL if both teams touched the ball.
+    int unum_; //!< the touching player's uniform number. Unum_Unknown if NEUTRAL.
+    Vector2D ball_pos_; //!< ball position before the event
+    Vector2D ball_vel_; //!< ball velocity after the event
+};
+
+/*!
+  \class CoachBallEventLog
+  \brief extract the ball touch events and keep the recent ones.
+
+  Each new state is processed once against the previous state. A touch is
+  assumed if a player has the kick or tackle flag, or if the ball velocity
+  differs from the decayed previous velocity beyond the ball noise. The
+  touching players are searched with the spatial index of the current
+  players around the previous ball position, so the cost does not depend
+  on the number of players far from the ball. Old visual information
+  without the flags is classified by the kickable and tackle areas.
+  The goalie catch is detected by the goalie_catch_ball playmode, or by
+  the free kick just after play_on with the goalie holding the ball.
+
+  The recent events are kept in fixed capacity rings. Every query is O(1).
+ */
+class CoachBallEventLog {
+public:
+
+    //! the maximum number of recorded events
+    static constexpr std::size_t CAPACITY = 128;
+
+    //! event container. index 0 is the newest event.
+    typedef RingBuffer< CoachBallEvent, CAPACITY > Cont;
+
+    //! spatial index type of the players in the current state
+    typedef UniformGrid2D< const CoachPlayerObject * > PlayerGrid;
+
+private:
+
+    Cont M_events; //!< all recent events
+    Cont M_kicks; //!< recent kick events only
+
+    GameTime M_last_update_time; //!< the time of the last processed state
+
+    //! true if the last processed state has an event. it is the newest one in M_events.
+    bool M_current_found;
+
+    //! true if the kick or tackle flag has been observed. the unflagged touches are ignored after that.
+    bool M_flags_observed;
+
+    //! work area for the spatial query
+    PlayerGrid::Result M_near_players;
+
+public:
+
+    /*!
+      \brief create an empty log
+     */
+    CoachBallEventLog();
+
+    /*!
+      \brief remove all events
+     */
+    void clear();
+
+    /*!
+      \brief extract the event in the new state. the same state is processed only once.
+      \param current the new state
+      \param prev the previous state. NULL if not exist.
+      \param grid spatial index of the players in the current state
+      \return the extracted event. NULL if no event.
+     */
+    const CoachBallEvent * update( const CoachWorldState & current,
+                                   const CoachWorldState * prev,
+                                   const PlayerGrid & grid );
+
+    /*!
+      \brief get the event extracted from the last processed state
+      \return pointer to the event. NULL if no event.
+     */
+    const CoachBallEvent * current() const
+      {
+          return M_current_found ? &M_events.front() : nullptr;
+      }
+
+    /*!
+      \brief get all recent events
+      \return const reference to the event container
+     */
+    const Cont & events() const
+      {
+          return M_events;
+      }
+
+    /*!
+      \brief get the recent kick events
+      \return const reference to the event container
+     */
+    const Cont & kicks() const
+      {
+          return M_kicks;
+      }
+
+    /*!
+      \brief get the last event
+      \return pointer to the event. NULL if no event.
+     */
+    const CoachBallEvent * lastEvent() const
+      {
+          return M_events.empty() ? nullptr : &M_events.front();
+      }
+
+    /*!
+      \brief get the i-th newest kick event
+      \param i index from the newest kick
+      \return pointer to the event. NULL if not recorded.
+     */
+    const CoachBallEvent * kick( const std::size_t i ) const
+      {
+          return i < M_kicks.size() ? &M_kicks[i] : nullptr;
+      }
+
+private:
+
+    /*!
+      \brief find the touching players and the event type
+      \param current the new state
+      \param prev the previous state
+      \param grid spatial index of the players in the current state
+      \param event pointer to the result event
+      \return true if the event is found
+     */
+    bool extractTouch( const CoachWorldState & current,
+                       const CoachWorldState & prev,
+                       const PlayerGrid & grid,
+                       CoachBallEvent * event );
+
+    /*!
+      \brief find the catching goalie
+      \param current the new state
+      \param prev the previous state
+      \param grid spatial index of the players in the current state
+      \param event pointer to the result event
+      \return true if the event is found
+     */
+    bool extractCatch( const CoachWorldState & current,
+                       const CoachWorldState & prev,
+                       const PlayerGrid & grid,
+                       CoachBallEvent * event ) const;
+
+    /*!
+      \brief record the event
+      \param event new event
+     */
+    void push( const CoachBallEvent & event );
+};
+
+}
+
+#endif
@@ -80,6 +80,13 @@ CoachConfig::setDefaultParam()
 
     M_rcssserver_host = "localhost";
     M_rcssserver_port = 6002;
+    M_shm_transport = false;
+
+    M_cpu_affinity.clear();
+    M_realtime_priority = 0;
+    M_nice = 0;
+    M_lock_memory = false;
+    M_huge_pages = false;
 
     M_compression = -1;
 
@@ -99,6 +106,8 @@ CoachConfig::setDefaultParam()
 
     M_max_team_graphic_per_cycle = 32;
 
+    M_state_history_size = 300;
+
     //
     // debug
     //
@@ -127,6 +136,7 @@ CoachConfig::setDefaultParam()
     //
 
     M_debug_log_ext = ".log";
+    M_debug_log_container.clear();
 
     M_debug_system = false;
     M_debug_sensor = false;
@@ -149,6 +159,13 @@ CoachConfig::setDefaultParam()
     M_debug_communication = false;
     M_debug_analyzer = false;
     M_debug_action_chain = false;
+
+    M_trace = false;
+    M_trace_ext = ".trace.json";
+    M_trace_size = 65536;
+
+    M_memory_report = false;
+    M_memory_report_ext = ".memory.json";
 }
 
 /*-------------------------------------------------------------------*/
@@ -170,6 +187,19 @@ CoachConfig::createParamMap()
 
         ( "host", "h",  &M_rcssserver_host )
         ( "port", "p", &M_rcssserver_port )
+        ( "shm_transport", "", BoolSwitch( &M_shm_transport ),
+          "exchange the messages with the co-located server (or proxy) through the shared memory. host:port receives only the handshake." )
+
+        ( "cpu_affinity", "", &M_cpu_affinity,
+          "pin the agent thread to the cpus. e.g. \"2\" or \"0,2-3\"" )
+        ( "realtime_priority", "", &M_realtime_priority,
+          "run the agent thread with the SCHED_FIFO real-time priority (1-99). 0 keeps the default scheduler." )
+        ( "nice", "", &M_nice,
+          "the nice value of the agent thread. 0 keeps the current value." )
+        ( "lock_memory", "", BoolSwitch( &M_lock_memory ),
+          "lock all pages of the process into memory by mlockall." )
+        ( "huge_pages", "", BoolSwitch( &M_huge_pages ),
+          "back the large arenas by the huge pages." )
 
         ( "compression", "", &M_compression )
 
@@ -188,6 +218,8 @@ CoachConfig::createParamMap()
         ( "team_graphic_file", "", &M_team_graphic_file )
         ( "max_team_graphic_per_cycle", "", &M_max_team_graphic_per_cycle )
 
+        ( "state_history_size", "", &M_state_history_size )
+
         ( "debug", "", BoolSwitch( &M_debug ) )
         ( "log_dir", "", &M_log_dir )
 
@@ -201,6 +233,7 @@ CoachConfig::createParamMap()
         ( "offline_client_mode", "", BoolSwitch( &M_offline_client_mode ) )
 
         ( "debug_log_ext", "", &M_debug_log_ext )
+        ( "debug_log_container", "", &M_debug_log_container )
 
         ( "debug_system", "", BoolSwitch( &M_debug_system ) )
         ( "debug_sensor", "", BoolSwitch( &M_debug_sensor ) )
@@ -223,6 +256,16 @@ CoachConfig::createParamMap()
         ( "debug_communication", "", BoolSwitch( &M_debug_communication ) )
         ( "debug_analyzer", "", BoolSwitch( &M_debug_analyzer ) )
         ( "debug_action_chain", "", BoolSwitch( &M_debug_action_chain ) )
+
+        ( "trace", "", BoolSwitch( &M_trace ),
+          "record the time spans of each cycle phase and write them in the Chrome trace format at the end of the match." )
+        ( "trace_ext", "", &M_trace_ext )
+        ( "trace_size", "", &M_trace_size,
+          "the number of the latest trace events kept in memory." )
+
+        ( "memory_report", "", BoolSwitch( &M_memory_report ),
+          "sample the memory usage of the library subsystems every cycle and write the peak and steady state values at the end of the match." )
+        ( "memory_report_ext", "", &M_memory_report_ext )
         ;
 }
 
@@ -68,6 +68,19 @@ private:
     std::string M_rcssserver_host;
     //! server port number
     int M_rcssserver_port;
+    //! if true, the shared memory transport is used instead of UDP
+    bool M_shm_transport;
+
+    //! cpu list of the agent thread
+    std::string M_cpu_affinity;
+    //! SCHED_FIFO priority of the agent thread. 0 means no change.
+    int M_realtime_priority;
+    //! nice value of the agent thread. 0 means no change.
+    int M_nice;
+    //! if true, mlockall is called
+    bool M_lock_memory;
+    //! if true, the large arenas are backed by the huge pages
+    bool M_huge_pages;
 
     //! zlib compression level for the compression command
     int M_compression;
@@ -101,6 +114,9 @@ private:
     //! maximum number of team_graphic command per cycle
     int M_max_team_graphic_per_cycle;
 
+    //! the number of recent world states kept by the world model
+    int M_state_history_size;
+
     //
     // debug
     //
@@ -136,6 +152,9 @@ private:
     //! the extension string of debug log file
     std::string M_debug_log_ext;
 
+    //! the container file name shared by all agents. empty means one file per agent.
+    std::string M_debug_log_container;
+
     // debug output switches
     bool M_debug_system; //!< debug level flag
     bool M_debug_sensor; //!< debug level flag
@@ -159,6 +178,21 @@ private:
     bool M_debug_analyzer; //!< debug level flag
     bool M_debug_action_chain; //!< debug level flag
 
+    //
+    // trace
+    //
+
+    bool M_trace; //!< if true, the time spans of each cycle phase are recorded.
+    std::string M_trace_ext; //!< the extension string of trace file
+    int M_trace_size; //!< the number of the latest trace events kept in memory
+
+    //
+    // memory report
+    //
+
+    bool M_memory_report; //!< if true, the memory usage of the subsystems is sampled and written.
+    std::string M_memory_report_ext; //!< the extension string of memory report file
+
 public:
 
     /*!
@@ -247,6 +281,42 @@ public:
      */
     int port() const { return M_rcssserver_port; }
 
+    /*!
+      \brief check if the shared memory transport is used
+      \return true if ShmClient is used instead of UDP
+     */
+    bool shmTransport() const { return M_shm_transport; }
+
+    /*!
+      \brief get the cpu list string for the affinity of the agent thread
+      \return cpu list string. empty if not pinned.
+     */
+    const std::string & cpuAffinity() const { return M_cpu_affinity; }
+
+    /*!
+      \brief get the SCHED_FIFO priority of the agent thread
+      \return real-time priority. 0 means the default scheduler.
+     */
+    int realtimePriority() const { return M_realtime_priority; }
+
+    /*!
+      \brief get the nice value of the agent thread
+      \return nice value. 0 means no change.
+     */
+    int niceValue() const { return M_nice; }
+
+    /*!
+      \brief check if the process memory is locked
+      \return true if mlockall is used
+     */
+    bool lockMemory() const { return M_lock_memory; }
+
+    /*!
+      \brief check if the large arenas are backed by the huge pages
+      \return true if huge pages are used
+     */
+    bool hugePages() const { return M_huge_pages; }
+
     /*!
       \brief get the message compression level
       \return message compression level
@@ -313,6 +383,12 @@ public:
      */
     int maxTeamGraphicPerCycle() const { return M_max_team_graphic_per_cycle; }
 
+    /*!
+      \brief get the number of recent world states kept by the world model.
+      \return the maximum number of recorded states. 0 means no state is recorded.
+     */
+    int stateHistorySize() const { return M_state_history_size; }
+
     //
     // debug
     //
@@ -390,6 +466,12 @@ public:
      */
     const std::string & debugLogExt() const { return M_debug_log_ext; }
 
+    /*!
+      \brief get the debug log container file name.
+      \return the container file name. empty if each agent writes its own file.
+     */
+    const std::string & debugLogContainer() const { return M_debug_log_container; }
+
     /*!
       \brief get the debug flag
       \return debug flag
@@ -516,6 +598,44 @@ public:
      */
     bool debugActionChain() const { return M_debug_action_chain; }
 
+    //
+    // trace
+    //
+
+    /*!
+      \brief get the switch for the trace recorder
+      \return switch value for the trace recorder
+     */
+    bool trace() const { return M_trace; }
+
+    /*!
+      \brief get the trace file extention string.
+      \return the trace file extention string.
+     */
+    const std::string & traceExt() const { return M_trace_ext; }
+
+    /*!
+      \brief get the number of the trace events kept in memory.
+      \return the ring buffer size of the trace recorder.
+     */
+    int traceSize() const { return M_trace_size; }
+
+    //
+    // memory report
+    //
+
+    /*!
+      \brief get the switch for the memory report
+      \return switch value for the memory report
+     */
+    bool memoryReport() const { return M_memory_report; }
+
+    /*!
+      \brief get the memory report file extention string.
+      \return the memory report file extention string.
+     */
+    const std::string & memoryReportExt() const { return M_memory_report_ext; }
+
 };
 
 }
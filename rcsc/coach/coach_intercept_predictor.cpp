@@ -50,44 +50,15 @@ namespace rcsc {
 
 */
 CoachInterceptPredictor::CoachInterceptPredictor( const CoachBallObject & ball )
+    : M_ball( ball.pos(), ball.vel() ),
+      M_ball_length( M_ball.length( 0, 100 ) ),
+      M_ball_move_angle( ( ballLastPos() - M_ball.pos( 0 ) ).th() )
 {
-    const ServerParam & SP = ServerParam::i();
-    const double max_x = ( SP.keepawayMode()
-                           ? SP.keepawayLength() * 0.5
-                           : SP.pitchHalfLength() + 5.0 );
-    const double max_y = ( SP.keepawayMode()
-                           ? SP.keepawayWidth() * 0.5
-                           : SP.pitchHalfWidth() + 5.0 );
-    const double bdecay = SP.ballDecay();
-
-    Vector2D bpos = ball.pos();
-    Vector2D bvel = ball.vel();
-    double bspeed = bvel.r();
-
-    for ( int i = 0; i < 100; ++i )
-    {
-        M_ball_cache.push_back( bpos );
-
-        if ( bspeed < 0.005 )
-        {
-            break;
-        }
-
-        bpos += bvel;
-        bvel *= bdecay;
-        bspeed *= bdecay;
-
-        if ( max_x < bpos.absX()
-             || max_y < bpos.absY() )
-        {
-            break;
-        }
-    }
 #ifdef DEBUG_PRINT
     dlog.addText( Logger::INTERCEPT,
                   "CoachInterceptPredict ball cache size=%d last pos=(%.2f %.2f)",
-                  M_ball_cache.size(),
-                  M_ball_cache.back().x, M_ball_cache.back().y );
+                  M_ball_length,
+                  ballLastPos().x, ballLastPos().y );
 #endif
 }
 
@@ -118,6 +89,47 @@ CoachInterceptPredictor::predict( const CoachPlayerObject & player ) const
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+std::vector< int >
+CoachInterceptPredictor::predict( const std::vector< const CoachPlayerObject * > & players ) const
+{
+    std::vector< int > result;
+    result.reserve( players.size() );
+
+    for ( const CoachPlayerObject * p : players )
+    {
+        result.push_back( predict( *p ) );
+    }
+
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::vector< int >
+CoachInterceptPredictor::predict( const std::vector< CoachBallObject > & balls,
+                                  const std::vector< const CoachPlayerObject * > & players )
+{
+    std::vector< int > result;
+    result.reserve( balls.size() * players.size() );
+
+    for ( const CoachBallObject & ball : balls )
+    {
+        const CoachInterceptPredictor predictor( ball );
+        for ( const CoachPlayerObject * p : players )
+        {
+            result.push_back( predictor.predict( *p ) );
+        }
+    }
+
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 int
 CoachInterceptPredictor::predictReachStep( const CoachPlayerObject & player,
@@ -140,14 +152,14 @@ CoachInterceptPredictor::predictReachStep( const CoachPlayerObject & player,
                                : 0 );
 
     const int min_step = predictMinStep( player, *ptype, control_area );
-    const int max_step = M_ball_cache.size() - 1;
+    const int max_step = M_ball_length - 1;
 
     //
     // cycle loop
     //
     for ( int total_step = min_step; total_step < max_step; ++total_step )
     {
-        const Vector2D & ball_pos = M_ball_cache[total_step];
+        const Vector2D ball_pos = M_ball.pos( total_step );
 
         if ( control_area + ptype->realSpeedMax() * ( total_step - penalty_step )
              < player.pos().dist( ball_pos ) )
@@ -179,13 +191,13 @@ CoachInterceptPredictor::predictReachStep( const CoachPlayerObject & player,
     }
 
     if ( goalie
-         && ( pen_area_y < M_ball_cache.back().absY()
-              || M_ball_cache.back().absX() < pen_area_x ) )
+         && ( pen_area_y < ballLastPos().absY()
+              || ballLastPos().absX() < pen_area_x ) )
     {
 #ifdef DEBUG_PRINT
         dlog.addText( Logger::INTERCEPT,
                       "FAILURE goalie. over the bounding area. final. bpos=(%.2f %.2f)",
-                      M_ball_cache.back().x, M_ball_cache.back().y );
+                      ballLastPos().x, ballLastPos().y );
 #endif
         return -1;
     }
@@ -202,9 +214,8 @@ CoachInterceptPredictor::predictMinStep( const CoachPlayerObject & player,
                                          const PlayerType & ptype,
                                          const double control_area ) const
 {
-    Vector2D rel = player.pos() - M_ball_cache.front();
-    AngleDeg move_angle = ( M_ball_cache.back() - M_ball_cache.front() ).th();
-    rel.rotate( -move_angle );
+    Vector2D rel = player.pos() - M_ball.pos( 0 );
+    rel.rotate( -M_ball_move_angle );
 
     double move_dist = rel.absY() - control_area;
     return static_cast< int >( std::floor( move_dist / ptype.realSpeedMax() ) );
@@ -362,14 +373,14 @@ CoachInterceptPredictor::predictFinal( const int penalty_step,
     Vector2D inertia_pos = ptype.inertiaPoint( player.pos(),
                                                player.vel(),
                                                100 );
-    double dash_dist = inertia_pos.dist( M_ball_cache.back() ) - control_area;
+    double dash_dist = inertia_pos.dist( ballLastPos() ) - control_area;
 
     int n_turn = predictTurnCycle( 100,
                                    penalty_step,
                                    player,
                                    ptype,
                                    control_area,
-                                   M_ball_cache.back() );
+                                   ballLastPos() );
 
     int n_dash = ptype.cyclesToReachDistance( dash_dist );
 
@@ -377,7 +388,7 @@ CoachInterceptPredictor::predictFinal( const int penalty_step,
 #ifdef DEBUG_PRINT
     dlog.addText( Logger::INTERCEPT,
                   "SUCCESS final. bpos=(%.2f %.2f) step=%d (penalty=%d turn=%d dash=%d)",
-                  M_ball_cache.back().x, M_ball_cache.back().y,
+                  ballLastPos().x, ballLastPos().y,
                   final_step, penalty_step, n_turn, n_dash );
 #endif
     return final_step;
@@ -32,6 +32,9 @@
 #ifndef RCSC_COACH_PLAYER_INTERCEPT_H
 #define RCSC_COACH_PLAYER_INTERCEPT_H
 
+#include <rcsc/common/ball_trajectory_cache.h>
+#include <rcsc/geom/angle_deg.h>
+
 #include <vector>
 
 namespace rcsc {
@@ -39,7 +42,6 @@ namespace rcsc {
 class CoachBallObject;
 class CoachPlayerObject;
 class PlayerType;
-class Vector2D;
 
 /*!
   \class CoachInterceptPredictor
@@ -48,7 +50,12 @@ class Vector2D;
 class CoachInterceptPredictor {
 private:
 
-    std::vector< Vector2D > M_ball_cache;
+    //! predicted ball positions
+    const BallTrajectoryCache M_ball;
+    //! the number of ball positions to be checked
+    const int M_ball_length;
+    //! direction from the first ball position to the last one
+    const AngleDeg M_ball_move_angle;
 
     // not used
     CoachInterceptPredictor() = delete;
@@ -64,10 +71,41 @@ public:
     explicit
     CoachInterceptPredictor( const CoachBallObject & ball );
 
+    /*!
+      \brief predict the ball reach step of the player
+      \param player target player
+      \return estimated step. -1 if the player is invalid.
+     */
     int predict( const CoachPlayerObject & player ) const;
 
+    /*!
+      \brief predict the ball reach steps of all players
+      \param players target players
+      \return estimated steps in the order of players. -1 for the invalid players.
+     */
+    std::vector< int > predict( const std::vector< const CoachPlayerObject * > & players ) const;
+
+    /*!
+      \brief predict the ball reach steps of all players for several ball states
+      \param balls initial ball states, e.g. the current ball and hypothetical kicks
+      \param players target players
+      \return reach step matrix in row major order.
+      the element [b * players.size() + p] is the step of players[p] for balls[b].
+
+      The ball trajectory of each ball state is created only once and
+      shared by all players.
+     */
+    static
+    std::vector< int > predict( const std::vector< CoachBallObject > & balls,
+                                const std::vector< const CoachPlayerObject * > & players );
+
 private:
 
+    Vector2D ballLastPos() const
+      {
+          return M_ball.pos( M_ball_length - 1 );
+      }
+
     int predictReachStep( const CoachPlayerObject & player,
                           const bool goalie ) const;
     int predictMinStep( const CoachPlayerObject & player,
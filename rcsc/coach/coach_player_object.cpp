@@ -41,16 +41,30 @@
 
 namespace rcsc {
 
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the profile shared by all unknown players
+ */
+const std::shared_ptr< CoachPlayerObject::Profile > &
+unknown_profile()
+{
+    static const std::shared_ptr< CoachPlayerObject::Profile > s_profile
+        = std::make_shared< CoachPlayerObject::Profile >
+        ( CoachPlayerObject::Profile{ NEUTRAL, Unum_Unknown, false,
+                                      Hetero_Unknown, nullptr, NO_CARD } );
+    return s_profile;
+}
+
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
 */
 CoachPlayerObject::CoachPlayerObject()
-    : M_side( NEUTRAL ),
-      M_unum( Unum_Unknown ),
-      M_goalie( false ),
-      M_type( Hetero_Unknown ),
-      M_player_type( nullptr ),
+    : M_profile( unknown_profile() ),
       M_pos( Vector2D::INVALIDATED ),
       M_vel( 0.0, 0.0 ),
       M_body( 0.0 ),
@@ -62,7 +76,6 @@ CoachPlayerObject::CoachPlayerObject()
       M_kicking( false ),
       M_tackle_cycle( 0 ),
       M_charged_cycle( 0 ),
-      M_card( NO_CARD ),
       M_ball_reach_step( 1000 )
 {
     M_stamina.init( PlayerTypeSet::i().defaultType() );
@@ -83,33 +96,99 @@ CoachPlayerObject::clone() const
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+CoachPlayerObject::Profile &
+CoachPlayerObject::mutableProfile()
+{
+    if ( M_profile.use_count() != 1 )
+    {
+        M_profile = std::make_shared< Profile >( *M_profile );
+    }
+
+    return *M_profile;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+CoachPlayerObject::setTeam( const SideID side,
+                            const int unum,
+                            const bool goalie )
+{
+    if ( M_profile->side_ == side
+         && M_profile->unum_ == unum
+         && M_profile->goalie_ == goalie )
+    {
+        return;
+    }
+
+    Profile & profile = mutableProfile();
+    profile.side_ = side;
+    profile.unum_ = unum;
+    profile.goalie_ = goalie;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+CoachPlayerObject::setCard( const Card card )
+{
+    if ( M_profile->card_ != card )
+    {
+        mutableProfile().card_ = card;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+CoachPlayerObject::clearSeenStatus()
+{
+    M_pointto_cycle = 0;
+    M_pointto_angle = 0.0;
+    M_kicking = false;
+    M_tackle_cycle = 0;
+    M_charged_cycle = 0;
+    setCard( NO_CARD );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 CoachPlayerObject::setPlayerType( const int type )
 {
-    if ( M_type == type
-         && M_player_type )
+    if ( M_profile->type_ == type
+         && M_profile->player_type_ )
     {
         return;
     }
 
     dlog.addText( Logger::WORLD,
                   __FILE__":(setPlayerType) player %c %d, change_player_type %d -> %d",
-                  side_char( M_side ), M_unum,
-                  M_type, type );
+                  side_char( side() ), unum(),
+                  M_profile->type_, type );
 
-    if ( M_type != Hetero_Unknown )
+    if ( M_profile->type_ != Hetero_Unknown )
     {
         changePlayerType( type );
     }
     else
     {
-        M_type = type;
-        M_player_type = PlayerTypeSet::i().get( type );
+        Profile & profile = mutableProfile();
+        profile.type_ = type;
+        profile.player_type_ = PlayerTypeSet::i().get( type );
 
-        if ( M_player_type )
+        if ( profile.player_type_ )
         {
-            M_stamina.setEffort( M_player_type->effortMax() );
+            M_stamina.setEffort( profile.player_type_->effortMax() );
         }
     }
 }
@@ -121,13 +200,14 @@ CoachPlayerObject::setPlayerType( const int type )
 void
 CoachPlayerObject::changePlayerType( const int type )
 {
-    M_type = type;
-    M_player_type = PlayerTypeSet::i().get( type );
-    M_card = NO_CARD;
+    Profile & profile = mutableProfile();
+    profile.type_ = type;
+    profile.player_type_ = PlayerTypeSet::i().get( type );
+    profile.card_ = NO_CARD;
 
-    if ( M_player_type )
+    if ( profile.player_type_ )
     {
-        M_stamina.init( *M_player_type );
+        M_stamina.init( *profile.player_type_ );
     }
 }
 
@@ -138,13 +218,11 @@ CoachPlayerObject::changePlayerType( const int type )
 void
 CoachPlayerObject::update( const CoachPlayerObject & p )
 {
-    M_side = p.side();
-    M_unum = p.unum();
-    M_goalie = p.goalie();
+    setTeam( p.side(), p.unum(), p.goalie() );
 
     // *** Do NOT set player type here! ***
-    // M_type = p.type();
-    // M_player_type = p.playerTypePtr();
+    // M_profile->type_ = p.type();
+    // M_profile->player_type_ = p.playerTypePtr();
 
     M_pos = p.pos();
     M_vel = p.vel();
@@ -190,7 +268,7 @@ CoachPlayerObject::update( const CoachPlayerObject & p )
         M_charged_cycle = 0;
     }
 
-    M_card = p.card();
+    setCard( p.card() );
 }
 
 /*-------------------------------------------------------------------*/
@@ -205,9 +283,7 @@ CoachPlayerObject::update( const rcg::PlayerT & p )
         return;
     }
 
-    M_side = p.side();
-    M_unum = p.unum_;
-    M_goalie = p.isGoalie();
+    setTeam( p.side(), p.unum_, p.isGoalie() );
 
     // setPlayerType() must be called before updating stamina information
     setPlayerType( p.type_ );
@@ -279,11 +355,11 @@ CoachPlayerObject::update( const rcg::PlayerT & p )
 
     if ( p.hasYellowCard() )
     {
-        M_card = YELLOW;
+        setCard( YELLOW );
     }
     else if ( p.hasRedCard() )
     {
-        M_card = RED;
+        setCard( RED );
     }
 
 }
@@ -295,8 +371,8 @@ CoachPlayerObject::update( const rcg::PlayerT & p )
 void
 CoachPlayerObject::recoverStamina()
 {
-    const double effort = ( M_player_type
-                            ? M_player_type->effortMax()
+    const double effort = ( M_profile->player_type_
+                            ? M_profile->player_type_->effortMax()
                             : ServerParam::i().defaultEffortMax() );
 
     M_stamina.setValues( ServerParam::i().staminaMax(),
@@ -313,8 +389,8 @@ CoachPlayerObject::recoverStamina()
 std::ostream &
 CoachPlayerObject::print( std::ostream & os ) const
 {
-    os << "Player (" << ( M_side == LEFT ? "l " : "r " )
-       << M_unum << ( M_goalie ? " g) " : ") " )
+    os << "Player (" << ( side() == LEFT ? "l " : "r " )
+       << unum() << ( goalie() ? " g) " : ") " )
        << pos() << ' ' << vel() << ' '
        << body() << ' ' << face();
 
@@ -37,6 +37,7 @@
 #include <rcsc/geom/vector_2d.h>
 #include <rcsc/types.h>
 
+#include <memory>
 #include <vector>
 #include <iostream>
 
@@ -58,13 +59,26 @@ public:
     //! container type of const CoachPlayerObject*
     typedef std::vector< const CoachPlayerObject * > Cont;
 
+    /*!
+      \struct Profile
+      \brief rarely changed player attributes.
+
+      A profile is shared by the copies of the player object in the
+      consecutive world states and is copied only when it is modified.
+     */
+    struct Profile {
+        SideID side_; //!< LEFT or RIGHT
+        int unum_; //!< uniform number
+        bool goalie_; //!< goalie or not
+        int type_; //!< plaeyr type id
+        const PlayerType * player_type_; //!< const point to the player type instance
+        Card card_; //!< player's card status
+    };
+
 private:
 
-    SideID M_side; //!< LEFT or RIGHT
-    int M_unum; //!< uniform number
-    bool M_goalie; //!< goalie or not
-    int M_type; //!< plaeyr type id
-    const PlayerType * M_player_type; //!< const point to the player type instance
+    //! shared profile data. never modified while shared by other objects.
+    std::shared_ptr< Profile > M_profile;
 
     Vector2D M_pos; //!< global position
     Vector2D M_vel; //!< velocity
@@ -83,12 +97,16 @@ private:
     int M_tackle_cycle; //!< if player is tackling, this value is incremented
     int M_charged_cycle; //!< if player is charged, this value is incremented
 
-    Card M_card; //!< player's card status
-
     //
 
     int M_ball_reach_step; //!< estimated ball interception step
 
+    /*!
+      \brief get the profile that can be modified by this object
+      \return reference to the profile not shared by other objects
+     */
+    Profile & mutableProfile();
+
 public:
 
     /*!
@@ -108,7 +126,7 @@ public:
      */
     bool isValid() const
       {
-          return M_side != NEUTRAL;
+          return M_profile->side_ != NEUTRAL;
       }
 
     /*!
@@ -117,7 +135,7 @@ public:
      */
     SideID side() const
       {
-          return M_side;
+          return M_profile->side_;
       }
 
     /*!
@@ -126,7 +144,7 @@ public:
      */
     int unum() const
       {
-          return M_unum;
+          return M_profile->unum_;
       }
 
     /*!
@@ -135,7 +153,7 @@ public:
      */
     bool goalie() const
       {
-          return M_goalie;
+          return M_profile->goalie_;
       }
 
     /*!
@@ -144,7 +162,7 @@ public:
      */
     int type() const
       {
-          return M_type;
+          return M_profile->type_;
       }
 
     /*!
@@ -153,7 +171,7 @@ public:
      */
     const PlayerType * playerTypePtr() const
       {
-          return M_player_type;
+          return M_profile->player_type_;
       }
 
     /*!
@@ -324,7 +342,7 @@ public:
      */
     Card card() const
       {
-          return M_card;
+          return M_profile->card_;
       }
 
     /*!
@@ -346,12 +364,7 @@ public:
      */
     void setTeam( const SideID side,
                   const int unum,
-                  const bool goalie )
-      {
-          M_side = side;
-          M_unum = unum;
-          M_goalie = goalie;
-      }
+                  const bool goalie );
 
     /*!
       \brief set player type id
@@ -471,10 +484,13 @@ public:
     /*!
       \brief set card status
      */
-    void setCard( const Card card )
-      {
-          M_card = card;
-      }
+    void setCard( const Card card );
+
+    /*!
+      \brief clear the arm, kick, tackle, charged and card status.
+      The profile is kept, so that the object can be reused for the next seen data.
+     */
+    void clearSeenStatus();
 
 
     void setBallReachStep( const int step )
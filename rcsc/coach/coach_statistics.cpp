@@ -0,0 +1,419 @@
+// -*-c++-*-
+
+/*!
+  \file coach_statistics.cpp
+  \brief incremental statistics of the observed players Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "coach_statistics.h"
+
+#include "coach_world_state.h"
+
+#include <cmath>
+
+namespace rcsc {
+
+constexpr double CoachStatistics::GRID_CELL_SIZE;
+constexpr int CoachStatistics::GRID_X_SIZE;
+constexpr int CoachStatistics::GRID_Y_SIZE;
+constexpr int CoachStatistics::MODE_OWNER_SIZE;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CoachStatistics::PlayerStat::PlayerStat()
+    : kick_count_( 0 ),
+      lost_count_( 0 )
+{
+    occupancy_.fill( 0 );
+    pass_count_.fill( 0 );
+    announced_pass_count_.fill( 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CoachStatistics::CoachStatistics()
+    : M_sample_count( 0 ),
+      M_last_sample_time( -1, 0 ),
+      M_last_kicker_side( NEUTRAL ),
+      M_last_kicker_unum( Unum_Unknown ),
+      M_last_kick_time( -1, 0 ),
+      M_last_pass_time( -1, 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CoachStatistics::clear()
+{
+    M_players.fill( PlayerStat() );
+
+    M_sample_count = 0;
+    M_last_sample_time.assign( -1, 0 );
+
+    M_last_kicker_side = NEUTRAL;
+    M_last_kicker_unum = Unum_Unknown;
+    M_last_kick_time.assign( -1, 0 );
+    M_last_pass_time.assign( -1, 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CoachStatistics::addState( const CoachWorldState & state,
+                           const GameMode & mode )
+{
+    if ( state.time() == M_last_sample_time )
+    {
+        return;
+    }
+    M_last_sample_time = state.time();
+    ++M_sample_count;
+
+    for ( const CoachPlayerObject * p : state.allPlayers() )
+    {
+        const int idx = player_index( p->side(), p->unum() );
+        if ( idx < 0 )
+        {
+            continue;
+        }
+        PlayerStat * stat = &M_players[idx];
+
+        int ix = 0, iy = 0;
+        if ( cell_index( p->pos(), &ix, &iy ) )
+        {
+            ++stat->occupancy_[iy * GRID_X_SIZE + ix];
+        }
+
+        stat->moments_.add( p->pos() );
+        stat->mode_moments_[mode_index( p->side(), mode )].add( p->pos() );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CoachStatistics::addKick( const SideID side,
+                          const int unum,
+                          const GameTime & time )
+{
+    const int idx = player_index( side, unum );
+    if ( idx < 0
+         || time == M_last_kick_time )
+    {
+        return;
+    }
+    M_last_kick_time = time;
+
+    ++M_players[idx].kick_count_;
+
+    const int last = player_index( M_last_kicker_side, M_last_kicker_unum );
+    if ( last >= 0 )
+    {
+        if ( M_last_kicker_side != side )
+        {
+            ++M_players[last].lost_count_;
+        }
+        else if ( M_last_kicker_unum != unum )
+        {
+            ++M_players[last].pass_count_[unum - 1];
+        }
+    }
+
+    M_last_kicker_side = side;
+    M_last_kicker_unum = unum;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CoachStatistics::setLastKicker( const SideID side,
+                                const int unum )
+{
+    M_last_kicker_side = side;
+    M_last_kicker_unum = unum;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CoachStatistics::addAnnouncedPass( const SideID side,
+                                   const int passer,
+                                   const int receiver,
+                                   const GameTime & time )
+{
+    const int idx = player_index( side, passer );
+    if ( idx < 0
+         || receiver < 1 || 11 < receiver
+         || time == M_last_pass_time )
+    {
+        return;
+    }
+    M_last_pass_time = time;
+
+    ++M_players[idx].announced_pass_count_[receiver - 1];
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+CoachStatistics::cell_index( const Vector2D & pos,
+                             int * ix,
+                             int * iy )
+{
+    const int x = static_cast< int >( std::floor( pos.x / GRID_CELL_SIZE ) ) + GRID_X_SIZE / 2;
+    const int y = static_cast< int >( std::floor( pos.y / GRID_CELL_SIZE ) ) + GRID_Y_SIZE / 2;
+
+    if ( x < 0 || GRID_X_SIZE <= x
+         || y < 0 || GRID_Y_SIZE <= y )
+    {
+        return false;
+    }
+
+    *ix = x;
+    *iy = y;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+Vector2D
+CoachStatistics::cell_center( const int ix,
+                              const int iy )
+{
+    return Vector2D( ( ix - GRID_X_SIZE / 2 + 0.5 ) * GRID_CELL_SIZE,
+                     ( iy - GRID_Y_SIZE / 2 + 0.5 ) * GRID_CELL_SIZE );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::uint32_t
+CoachStatistics::occupancy( const SideID side,
+                            const int unum,
+                            const int ix,
+                            const int iy ) const
+{
+    const PlayerStat * stat = getPlayer( side, unum );
+    if ( ! stat
+         || ix < 0 || GRID_X_SIZE <= ix
+         || iy < 0 || GRID_Y_SIZE <= iy )
+    {
+        return 0;
+    }
+
+    return stat->occupancy_[iy * GRID_X_SIZE + ix];
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+CoachStatistics::occupancyRate( const SideID side,
+                                const int unum,
+                                const int ix,
+                                const int iy ) const
+{
+    const PlayerStat * stat = getPlayer( side, unum );
+    if ( ! stat
+         || stat->moments_.count_ == 0 )
+    {
+        return 0.0;
+    }
+
+    return static_cast< double >( occupancy( side, unum, ix, iy ) ) / stat->moments_.count_;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const CoachStatistics::Moments &
+CoachStatistics::positionMoments( const SideID side,
+                                  const int unum ) const
+{
+    static const Moments s_empty;
+
+    const PlayerStat * stat = getPlayer( side, unum );
+    return ( stat ? stat->moments_ : s_empty );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const CoachStatistics::Moments &
+CoachStatistics::positionMoments( const SideID side,
+                                  const int unum,
+                                  const GameMode & mode ) const
+{
+    static const Moments s_empty;
+
+    const PlayerStat * stat = getPlayer( side, unum );
+    return ( stat ? stat->mode_moments_[mode_index( side, mode )] : s_empty );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::uint32_t
+CoachStatistics::kickCount( const SideID side,
+                            const int unum ) const
+{
+    const PlayerStat * stat = getPlayer( side, unum );
+    return ( stat ? stat->kick_count_ : 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::uint32_t
+CoachStatistics::lostCount( const SideID side,
+                            const int unum ) const
+{
+    const PlayerStat * stat = getPlayer( side, unum );
+    return ( stat ? stat->lost_count_ : 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::uint32_t
+CoachStatistics::passCount( const SideID side,
+                            const int passer,
+                            const int receiver ) const
+{
+    const PlayerStat * stat = getPlayer( side, passer );
+    if ( ! stat
+         || receiver < 1 || 11 < receiver )
+    {
+        return 0;
+    }
+
+    return stat->pass_count_[receiver - 1];
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::uint32_t
+CoachStatistics::announcedPassCount( const SideID side,
+                                     const int passer,
+                                     const int receiver ) const
+{
+    const PlayerStat * stat = getPlayer( side, passer );
+    if ( ! stat
+         || receiver < 1 || 11 < receiver )
+    {
+        return 0;
+    }
+
+    return stat->announced_pass_count_[receiver - 1];
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const CoachStatistics::PlayerStat *
+CoachStatistics::getPlayer( const SideID side,
+                            const int unum ) const
+{
+    const int idx = player_index( side, unum );
+    return ( idx >= 0 ? &M_players[idx] : nullptr );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+CoachStatistics::player_index( const SideID side,
+                               const int unum )
+{
+    if ( unum < 1 || 11 < unum )
+    {
+        return -1;
+    }
+
+    return ( side == LEFT
+             ? unum - 1
+             : side == RIGHT
+             ? 11 + unum - 1
+             : -1 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+CoachStatistics::mode_index( const SideID side,
+                             const GameMode & mode )
+{
+    const int owner = ( mode.side() == NEUTRAL
+                        ? 0
+                        : mode.side() == side
+                        ? 1
+                        : 2 );
+    const int type = ( 0 <= mode.type() && mode.type() < GameMode::MODE_MAX
+                       ? static_cast< int >( mode.type() )
+                       : 0 );
+    return type * MODE_OWNER_SIZE + owner;
+}
+
+}
@@ -0,0 +1,386 @@
+// -*-c++-*-
+
+/*!
+  \file coach_statistics.h
+  \brief incremental statistics of the observed players Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_COACH_COACH_STATISTICS_H
+#define RCSC_COACH_COACH_STATISTICS_H
+
+#include <rcsc/geom/vector_2d.h>
+#include <rcsc/game_mode.h>
+#include <rcsc/game_time.h>
+#include <rcsc/types.h>
+
+#include <array>
+#include <cstdint>
+
+namespace rcsc {
+
+class CoachWorldState;
+
+/*!
+  \class CoachStatistics
+  \brief streaming statistics of the observed players for the opponent modelling.
+
+  All statistics are updated in constant time for each observed cycle, and
+  all queries are answered in constant time, so they do not depend on the
+  length of the state history. The following data are recorded for each
+  player of both sides:
+  - the occupancy count of each grid cell.
+  - the running mean and covariance of the position for each playmode.
+  - the kick count, and the pass graph estimated by the kicker transitions.
+  The passes announced by our players are counted separately.
+
+  The side arguments are absolute team sides (LEFT or RIGHT), and the
+  positions are in the coordinate system of CoachWorldState.
+*/
+class CoachStatistics {
+public:
+
+    //! the size of the occupancy grid cell
+    static constexpr double GRID_CELL_SIZE = 5.0;
+    //! the number of the grid columns. the grid covers the pitch and its margin.
+    static constexpr int GRID_X_SIZE = 24;
+    //! the number of the grid rows
+    static constexpr int GRID_Y_SIZE = 16;
+
+    /*!
+      \struct Moments
+      \brief running mean and covariance of the positions (Welford's method)
+    */
+    struct Moments {
+        std::uint32_t count_; //!< the number of samples
+        double mean_x_; //!< mean of x
+        double mean_y_; //!< mean of y
+        double m2_xx_; //!< sum of squared deviations of x
+        double m2_yy_; //!< sum of squared deviations of y
+        double m2_xy_; //!< sum of the products of the deviations
+
+        /*!
+          \brief initialize all values by 0
+        */
+        Moments()
+            : count_( 0 ),
+              mean_x_( 0.0 ),
+              mean_y_( 0.0 ),
+              m2_xx_( 0.0 ),
+              m2_yy_( 0.0 ),
+              m2_xy_( 0.0 )
+          { }
+
+        /*!
+          \brief add a sample
+          \param pos sampled position
+        */
+        void add( const Vector2D & pos )
+          {
+              ++count_;
+              const double dx = pos.x - mean_x_;
+              const double dy = pos.y - mean_y_;
+              mean_x_ += dx / count_;
+              mean_y_ += dy / count_;
+              m2_xx_ += dx * ( pos.x - mean_x_ );
+              m2_yy_ += dy * ( pos.y - mean_y_ );
+              m2_xy_ += dx * ( pos.y - mean_y_ );
+          }
+
+        /*!
+          \brief get the mean position
+          \return mean position. invalid vector if no sample.
+        */
+        Vector2D mean() const
+          {
+              return ( count_ == 0
+                       ? Vector2D::INVALIDATED
+                       : Vector2D( mean_x_, mean_y_ ) );
+          }
+
+        /*!
+          \brief get the variance of x
+          \return sample variance
+        */
+        double varianceX() const
+          {
+              return ( count_ < 2 ? 0.0 : m2_xx_ / ( count_ - 1 ) );
+          }
+
+        /*!
+          \brief get the variance of y
+          \return sample variance
+        */
+        double varianceY() const
+          {
+              return ( count_ < 2 ? 0.0 : m2_yy_ / ( count_ - 1 ) );
+          }
+
+        /*!
+          \brief get the covariance of x and y
+          \return sample covariance
+        */
+        double covarianceXY() const
+          {
+              return ( count_ < 2 ? 0.0 : m2_xy_ / ( count_ - 1 ) );
+          }
+    };
+
+private:
+
+    //! the owner of the playmode seen from the player: neutral, own team or opponent team
+    static constexpr int MODE_OWNER_SIZE = 3;
+
+    /*!
+      \struct PlayerStat
+      \brief statistics of one player
+    */
+    struct PlayerStat {
+        std::array< std::uint32_t, GRID_X_SIZE * GRID_Y_SIZE > occupancy_; //!< cell visit counts
+        std::array< Moments, GameMode::MODE_MAX * MODE_OWNER_SIZE > mode_moments_; //!< moments for each playmode
+        Moments moments_; //!< moments for all playmodes
+        std::uint32_t kick_count_; //!< the number of kicks
+        std::uint32_t lost_count_; //!< the number of kicks followed by the opponent kick
+        std::array< std::uint32_t, 11 > pass_count_; //!< kicker transition counts to the teammates
+        std::array< std::uint32_t, 11 > announced_pass_count_; //!< heard pass counts to the teammates
+
+        PlayerStat();
+    };
+
+    std::array< PlayerStat, 22 > M_players; //!< left players, then right players
+
+    std::uint32_t M_sample_count; //!< the number of the recorded states
+    GameTime M_last_sample_time; //!< the time of the last recorded state
+
+    SideID M_last_kicker_side; //!< the side of the last kicker
+    int M_last_kicker_unum; //!< the uniform number of the last kicker
+    GameTime M_last_kick_time; //!< the time of the last recorded kick
+    GameTime M_last_pass_time; //!< the time of the last recorded announced pass
+
+public:
+
+    /*!
+      \brief initialize all statistics
+    */
+    CoachStatistics();
+
+    /*!
+      \brief clear all statistics
+    */
+    void clear();
+
+    /*!
+      \brief record the player positions of the state. the same time is recorded only once.
+      \param state observed state
+      \param mode current playmode
+    */
+    void addState( const CoachWorldState & state,
+                   const GameMode & mode );
+
+    /*!
+      \brief record the kick. a kick by the teammate of the last kicker is
+      counted as a pass, and a kick by the opponent is counted as a lost ball.
+      \param side kicker's side
+      \param unum kicker's uniform number
+      \param time kick time. the same time is recorded only once.
+    */
+    void addKick( const SideID side,
+                  const int unum,
+                  const GameTime & time );
+
+    /*!
+      \brief set the last kicker without counting the kick (e.g. the set play kicker)
+      \param side kicker's side. NEUTRAL if unknown.
+      \param unum kicker's uniform number. Unum_Unknown if unknown.
+    */
+    void setLastKicker( const SideID side,
+                        const int unum );
+
+    /*!
+      \brief record the pass announced by our player
+      \param side our side
+      \param passer passer's uniform number
+      \param receiver receiver's uniform number
+      \param time pass time. the same time is recorded only once.
+    */
+    void addAnnouncedPass( const SideID side,
+                           const int passer,
+                           const int receiver,
+                           const GameTime & time );
+
+    /*!
+      \brief get the number of the recorded states
+      \return sample count
+    */
+    std::uint32_t sampleCount() const
+      {
+          return M_sample_count;
+      }
+
+    /*!
+      \brief get the grid cell index of the position
+      \param pos position
+      \param ix result column index
+      \param iy result row index
+      \return false if the position is out of the grid
+    */
+    static
+    bool cell_index( const Vector2D & pos,
+                     int * ix,
+                     int * iy );
+
+    /*!
+      \brief get the center of the grid cell
+      \param ix column index
+      \param iy row index
+      \return center position
+    */
+    static
+    Vector2D cell_center( const int ix,
+                          const int iy );
+
+    /*!
+      \brief get the occupancy count of the grid cell
+      \param side player's side
+      \param unum player's uniform number
+      \param ix column index
+      \param iy row index
+      \return the number of samples in the cell
+    */
+    std::uint32_t occupancy( const SideID side,
+                             const int unum,
+                             const int ix,
+                             const int iy ) const;
+
+    /*!
+      \brief get the occupancy rate of the grid cell
+      \param side player's side
+      \param unum player's uniform number
+      \param ix column index
+      \param iy row index
+      \return the rate of samples in the cell [0, 1]
+    */
+    double occupancyRate( const SideID side,
+                          const int unum,
+                          const int ix,
+                          const int iy ) const;
+
+    /*!
+      \brief get the position moments for all playmodes
+      \param side player's side
+      \param unum player's uniform number
+      \return const reference to the moments. empty moments if illegal player.
+    */
+    const Moments & positionMoments( const SideID side,
+                                     const int unum ) const;
+
+    /*!
+      \brief get the position moments for the playmode
+      \param side player's side
+      \param unum player's uniform number
+      \param mode playmode. the set plays are distinguished by the owner side.
+      \return const reference to the moments. empty moments if illegal player.
+    */
+    const Moments & positionMoments( const SideID side,
+                                     const int unum,
+                                     const GameMode & mode ) const;
+
+    /*!
+      \brief get the kick count
+      \param side player's side
+      \param unum player's uniform number
+      \return the number of kicks
+    */
+    std::uint32_t kickCount( const SideID side,
+                             const int unum ) const;
+
+    /*!
+      \brief get the number of kicks followed by the opponent kick
+      \param side player's side
+      \param unum player's uniform number
+      \return the number of lost balls
+    */
+    std::uint32_t lostCount( const SideID side,
+                             const int unum ) const;
+
+    /*!
+      \brief get the number of the kicker transitions between the teammates
+      \param side players' side
+      \param passer passer's uniform number
+      \param receiver receiver's uniform number
+      \return the number of passes
+    */
+    std::uint32_t passCount( const SideID side,
+                             const int passer,
+                             const int receiver ) const;
+
+    /*!
+      \brief get the number of the announced passes
+      \param side players' side
+      \param passer passer's uniform number
+      \param receiver receiver's uniform number
+      \return the number of passes
+    */
+    std::uint32_t announcedPassCount( const SideID side,
+                                      const int passer,
+                                      const int receiver ) const;
+
+private:
+
+    /*!
+      \brief get the player statistics
+      \param side player's side
+      \param unum player's uniform number
+      \return pointer to the statistics, or nullptr if illegal player.
+    */
+    const PlayerStat * getPlayer( const SideID side,
+                                  const int unum ) const;
+
+    /*!
+      \brief get the index of the player statistics
+      \param side player's side
+      \param unum player's uniform number
+      \return index of M_players, or -1 if illegal player.
+    */
+    static
+    int player_index( const SideID side,
+                      const int unum );
+
+    /*!
+      \brief get the index of the playmode moments
+      \param side player's side
+      \param mode playmode
+      \return moments index
+    */
+    static
+    int mode_index( const SideID side,
+                    const GameMode & mode );
+};
+
+}
+
+#endif
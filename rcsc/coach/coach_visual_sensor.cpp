@@ -35,10 +35,9 @@
 
 #include "coach_visual_sensor.h"
 
-#include <string>
+#include <charconv>
 #include <cstring>
-#include <cstdio>
-#include <cstdlib>
+#include <string_view>
 
 namespace rcsc {
 
@@ -79,8 +78,6 @@ CoachVisualSensor::parse( const char * msg,
 
     M_time = current;
 
-    M_players.clear();
-
     if ( version >= 7.0 )
     {
         parseV7( msg );
@@ -91,6 +88,267 @@ CoachVisualSensor::parse( const char * msg,
     }
 }
 
+namespace {
+
+/*-------------------------------------------------------------------*/
+inline
+const char *
+skip_space( const char * buf,
+            const char * end )
+{
+    while ( buf < end && *buf == ' ' ) ++buf;
+    return buf;
+}
+
+/*-------------------------------------------------------------------*/
+inline
+const char *
+skip_until( const char * buf,
+            const char * end,
+            const char c )
+{
+    while ( buf < end && *buf != c ) ++buf;
+    return buf;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief skip the white spaces and the prefix string
+  \return pointer to the next character of the prefix. NULL if not matched.
+ */
+inline
+const char *
+skip_prefix( const char * buf,
+             const char * end,
+             const std::string_view prefix )
+{
+    buf = skip_space( buf, end );
+    if ( static_cast< std::size_t >( end - buf ) < prefix.size()
+         || std::memcmp( buf, prefix.data(), prefix.size() ) != 0 )
+    {
+        return nullptr;
+    }
+    return buf + prefix.size();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read an integer value after the white spaces like scanf("%d").
+  \return true if a value is read. *buf is moved to the next character.
+ */
+inline
+bool
+read_int( const char ** buf,
+          const char * end,
+          int * value )
+{
+    const char * first = skip_space( *buf, end );
+    if ( first < end && *first == '+' ) ++first;
+
+    const std::from_chars_result r = std::from_chars( first, end, *value );
+    if ( r.ec != std::errc() )
+    {
+        return false;
+    }
+
+    *buf = r.ptr;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read a floating point value after the white spaces like strtod().
+  \return true if a value is read. *buf is moved to the next character.
+ */
+inline
+bool
+read_double( const char ** buf,
+             const char * end,
+             double * value )
+{
+    const char * first = skip_space( *buf, end );
+    if ( first < end && *first == '+' ) ++first;
+
+    const std::from_chars_result r = std::from_chars( first, end, *value );
+    if ( r.ec != std::errc() )
+    {
+        return false;
+    }
+
+    *buf = r.ptr;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read the floating point values.
+  \return true if all values are read. *buf is moved to the next character.
+ */
+inline
+bool
+read_doubles( const char ** buf,
+              const char * end,
+              double * values,
+              const int n )
+{
+    for ( int i = 0; i < n; ++i )
+    {
+        if ( ! read_double( buf, end, &values[i] ) )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief skip the message header, the time and the two goals.
+  \return pointer to the next character of the goals. NULL if the header is not matched.
+ */
+const char *
+skip_header( const char * buf,
+             const char * end,
+             const std::string_view see_header )
+{
+    const char * p = skip_prefix( buf, end, see_header );
+    if ( ! p )
+    {
+        p = skip_prefix( buf, end, "(ok look " );
+    }
+
+    if ( ! p )
+    {
+        return nullptr;
+    }
+
+    p = skip_until( p, end, ' ' ); // skip TIME
+
+    // skip ((g l) -52.5 0) ((g r) 52.5 0)
+    for ( int i = 0; i < 4; ++i )
+    {
+        p = skip_until( p, end, ')' );
+        if ( p < end ) ++p;
+    }
+
+    return p;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read the ball values "((b) <x> <y> <vx> <vy>)"
+  \return pointer to the next character of the ball object. NULL if failed.
+ */
+const char *
+read_ball( const char * buf,
+           const char * end,
+           const std::string_view ball_tag,
+           CoachBallObject * ball )
+{
+    double v[4];
+    const char * p = skip_prefix( buf, end, ball_tag );
+    if ( ! p
+         || ! read_doubles( &p, end, v, 4 )
+         || p == end
+         || *p != ')' )
+    {
+        return nullptr;
+    }
+
+    ball->setValue( v[0], v[1], v[2], v[3] );
+    return p + 1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read the player name "TEAM UNUM[ goalie])".
+  \return pointer to the next character of the name. NULL if failed.
+ */
+const char *
+read_player_name( const char * buf,
+                  const char * end,
+                  std::string_view * team_name,
+                  int * unum,
+                  bool * goalie )
+{
+    const char * p = skip_space( buf, end );
+    const char * name_end = skip_until( p, end, ' ' );
+    if ( p == name_end )
+    {
+        return nullptr;
+    }
+
+    *team_name = std::string_view( p, name_end - p );
+
+    p = name_end;
+    if ( ! read_int( &p, end, unum ) )
+    {
+        return nullptr;
+    }
+
+    p = skip_space( p, end );
+    *goalie = ( p < end && *p == 'g' );
+
+    p = skip_until( p, end, ')' );
+    return ( p < end ? p + 1 : p );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the side of the team name. a new name is registered to the empty side.
+  \return side id. NEUTRAL if both sides have other names.
+ */
+SideID
+team_side( const std::string_view name,
+           std::string_view * left,
+           std::string_view * right )
+{
+    if ( *left == name )
+    {
+        return LEFT;
+    }
+
+    if ( *right == name )
+    {
+        return RIGHT;
+    }
+
+    if ( left->empty() )
+    {
+        *left = name;
+        return LEFT;
+    }
+
+    if ( right->empty() )
+    {
+        *right = name;
+        return RIGHT;
+    }
+
+    return NEUTRAL;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CoachPlayerObject &
+CoachVisualSensor::nextPlayer( const std::size_t count )
+{
+    // reuse the objects of the previous message to keep their profile storage.
+    if ( count < M_players.size() )
+    {
+        CoachPlayerObject & p = M_players[count];
+        p.clearSeenStatus();
+        return p;
+    }
+
+    M_players.emplace_back();
+    return M_players.back();
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -115,188 +373,131 @@ CoachVisualSensor::parseV7( const char * msg )
        ....)
    */
 
-    // temporal variables
-    double x, y, vx, vy, body, neck;
+    const char * const end = msg + std::strlen( msg );
 
-    if ( std::strncmp( msg, "(see_global ", 12 ) )
-    {
-        msg += 12;
-    }
-    else if ( std::strncmp( msg, "(ok look ", 9 ) )
-    {
-        msg += 9;
-    }
-    else
+    const char * p = skip_header( msg, end, "(see_global " );
+    if ( ! p )
     {
         std::cerr << __FILE__ << ' ' << __LINE__
                   << "***ERROR*** invalide message(1) " << msg << std::endl;
+        M_players.clear();
         return;
     }
 
-    while ( *msg != ' ' ) ++msg;
-    ++msg; // skip TIME
-
-    // skip goals
-    while ( *msg != ')' ) ++msg;
-    ++msg;
-    while ( *msg != ')' ) ++msg;
-    ++msg; // skip ((g l) -52.5 0)
-    while ( *msg != ')' ) ++msg;
-    ++msg;
-    while ( *msg != ')' ) ++msg;
-    ++msg; // ((g r) 52.5 0)
-
-    int n_read = 0;
-
-    // ((b) <x> <y> <vx> <vy>)
-    if ( std::sscanf( msg,
-                      " ((b) %lf %lf %lf %lf) %n ",
-                      &x, &y, &vx, &vy,
-                      &n_read ) != 4 )
+    p = read_ball( p, end, "((b)", &M_ball );
+    if ( ! p )
     {
         std::cerr << __FILE__ << ' ' << __LINE__
                   << "***ERROR*** invalide message(2) " << msg << ']'
                   << std::endl;
+        M_players.clear();
         return;
     }
 
-    M_ball.setValue( x, y, vx, vy );
-
-    msg += n_read;
-
-    std::string team_name_left;
-    std::string team_name_right;
+    std::string_view team_name_left;
+    std::string_view team_name_right;
+    std::size_t count = 0;
 
     // ((p "TEAM" UNUM[ goalie]) <x> <y> <vx> <vy> <body> <neck>[ <arm>][ {k|t}][ {y|r}])
-    while ( *msg != '\0' )
+    while ( p < end )
     {
-        while ( *msg != '\0' && *msg != '(' ) ++msg;
-        if ( *msg == '\0' )
+        p = skip_until( p, end, '(' );
+        if ( p == end )
         {
             break;
         }
 
-        CoachPlayerObject player;
-
-        char teamname[32];
+        std::string_view teamname;
         int unum = Unum_Unknown;
         bool goalie = false;
 
-        if ( std::sscanf( msg,
-                          " ((p %31[^ ] %d %n ",
-                          teamname, &unum,
-                          &n_read ) != 2 )
+        const char * const player_begin = p;
+        p = skip_prefix( p, end, "((p " );
+        if ( p )
         {
-            std::cerr << __FILE__ << ' ' << __LINE__
-                      << "***ERROR*** invalide message(3) [" << msg << ']'
-                      << std::endl;
-            break;
+            p = read_player_name( p, end, &teamname, &unum, &goalie );
         }
 
-        SideID side = NEUTRAL;
-        if ( team_name_left == teamname )
-        {
-            side = LEFT;
-        }
-        else if ( team_name_right == teamname )
-        {
-            side = RIGHT;
-        }
-        else if ( team_name_left.empty() )
-        {
-            team_name_left = teamname;
-            side = LEFT;
-        }
-        else if ( team_name_right.empty() )
-        {
-            team_name_right = teamname;
-            side = RIGHT;
-        }
-        else
+        if ( ! p )
         {
             std::cerr << __FILE__ << ' ' << __LINE__
-                      << "***ERROR*** invalide message(4) [" << msg << ']'
+                      << "***ERROR*** invalide message(3) [" << player_begin << ']'
                       << std::endl;
             break;
         }
 
-        msg += n_read;
-
-        if ( *msg == 'g' )
+        const SideID side = team_side( teamname, &team_name_left, &team_name_right );
+        if ( side == NEUTRAL )
         {
-            goalie = true;
+            std::cerr << __FILE__ << ' ' << __LINE__
+                      << "***ERROR*** invalide message(4) [" << player_begin << ']'
+                      << std::endl;
+            break;
         }
 
-        // skip to last of the player name
-        while ( *msg != '\0' && *msg != ')' ) ++msg;
-        ++msg; // skip ')'
-
-        if ( std::sscanf( msg,
-                          " %lf %lf %lf %lf %lf %lf %n ",
-                          &x, &y, &vx, &vy, &body, &neck, &n_read ) != 6 )
+        // x, y, vx, vy, body, neck
+        double v[6];
+        if ( ! read_doubles( &p, end, v, 6 ) )
         {
             std::cerr << __FILE__ << ' ' << __LINE__
-                      << "***ERROR*** invalide message(5) [" << msg << ']'
+                      << "***ERROR*** invalide message(5) [" << p << ']'
                       << std::endl;
             break;
         }
 
-        player.setTeam( side, unum, goalie );
-        player.setPos( x, y );
-        player.setVel( vx, vy );
-        player.setAngle( body, neck );
+        CoachPlayerObject & player = nextPlayer( count );
+        ++count;
 
-        msg += n_read;
+        player.setTeam( side, unum, goalie );
+        player.setPos( v[0], v[1] );
+        player.setVel( v[2], v[3] );
+        player.setAngle( v[4], v[5] );
 
-        while ( *msg != '\0' && *msg != ')' )
+        while ( p < end && *p != ')' )
         {
-            while ( *msg == ' ' ) ++msg;
-            if ( *msg == ')' ) break;
+            p = skip_space( p, end );
+            if ( p == end || *p == ')' ) break;
 
-            if ( *msg == 'k' ) // kick
+            if ( *p == 'k' ) // kick
             {
                 player.setKicking( true );
             }
-            else if ( *msg == 't' ) // tackle
+            else if ( *p == 't' ) // tackle
             {
                 player.setTackle();
             }
-            else if ( *msg == 'f' ) // foul charged
+            else if ( *p == 'f' ) // foul charged
             {
                 player.setCharged();
             }
-            else if ( *msg == 'y' ) // yellow card
+            else if ( *p == 'y' ) // yellow card
             {
                 player.setCard( YELLOW );
             }
-            else if ( *msg == 'r' ) // red card
+            else if ( *p == 'r' ) // red card
             {
                 player.setCard( RED );
             }
             else // point_dir
             {
-                char *next;
-                double point_dir = std::strtod( msg, &next );
-                if ( point_dir == HUGE_VAL
-                     || point_dir == -HUGE_VAL
-                     || msg == next )
+                double point_dir = 0.0;
+                if ( ! read_double( &p, end, &point_dir ) )
                 {
                     break;
                 }
                 player.setArm( point_dir );
-                msg = next;
             }
 
-            while ( *msg != '\0' && *msg != ')' && *msg != ' ' ) ++msg;
+            while ( p < end && *p != ')' && *p != ' ' ) ++p;
         }
 
-        M_players.push_back( player );
-
         // skip to the last paren of the player info
-        while ( *msg != '\0' && *msg != ')' ) ++msg;
-        while ( *msg == ')' ) ++msg;
+        p = skip_until( p, end, ')' );
+        while ( p < end && *p == ')' ) ++p;
     }
 
+    M_players.resize( count );
+
     if ( M_team_name_left.empty()
          && team_name_left.length() > 2 )
     {
@@ -327,145 +528,94 @@ CoachVisualSensor::parseV6( const char * msg )
       ....)
     */
 
-    double x, y, vx, vy, body, neck;
+    const char * const end = msg + std::strlen( msg );
 
-    if ( std::strncmp( msg, "(see ", 5 ) )
-    {
-        msg += 5;
-    }
-    else if ( std::strncmp( msg, "(ok look ", 9 ) )
-    {
-        msg += 9;
-    }
-    else
+    const char * p = skip_header( msg, end, "(see " );
+    if ( ! p )
     {
         std::cerr << __FILE__ << ' ' << __LINE__
                   << "***ERROR*** invalide message(1) " << msg << ']'
                   << std::endl;
+        M_players.clear();
         return;
     }
 
-    while ( *msg != ' ' ) ++msg;
-    ++msg; // skip TIME
-
-    // skip goals
-    while ( *msg != ')' ) ++msg;
-    ++msg;
-    while ( *msg != ')' ) ++msg;
-    ++msg; // skip ((g l) -52.5 0)
-    while ( *msg != ')' ) ++msg;
-    ++msg;
-    while ( *msg != ')' ) ++msg;
-    ++msg; // ((g r) 52.5 0)
-
-    int n_read = 0;
-
-    // ((b) <x> <y> <vx> <vy>)
-    if ( std::sscanf( msg,
-                      " ((ball) %lf %lf %lf %lf) %n ",
-                      &x, &y, &vx, &vy,
-                      &n_read ) != 4 )
+    p = read_ball( p, end, "((ball)", &M_ball );
+    if ( ! p )
     {
         std::cerr << __FILE__ << ' ' << __LINE__
                   << "***ERROR*** invalide message(2) " << msg << ']'
                   << std::endl;
+        M_players.clear();
         return;
     }
 
-    M_ball.setValue( x, y, vx, vy );
-
-    msg += n_read;
-
-    std::string team_name_left;
-    std::string team_name_right;
+    std::string_view team_name_left;
+    std::string_view team_name_right;
+    std::size_t count = 0;
 
     // ((player "TEAM" UNUM[ goalie]) <x> <y> <body> <neck> <vx> <vy>)
-    while ( *msg != '\0' )
+    while ( p < end )
     {
-        while ( *msg != '\0' && *msg != '(' ) ++msg;
-        if ( *msg == '\0' )
+        p = skip_until( p, end, '(' );
+        if ( p == end )
         {
             break;
         }
 
-        CoachPlayerObject player;
-
-        char teamname[32];
+        std::string_view teamname;
         int unum = 0;
         bool goalie = false;
 
-        if ( std::sscanf( msg,
-                          " ((player %31[^ ] %d %n ",
-                          teamname, &unum ,
-                          &n_read ) != 2 )
+        const char * const player_begin = p;
+        p = skip_prefix( p, end, "((player " );
+        if ( p )
         {
-            std::cerr << __FILE__ << ' ' << __LINE__
-                      << "***ERROR*** invalide message(3) [" << msg << ']'
-                      << std::endl;
-            break;
+            p = read_player_name( p, end, &teamname, &unum, &goalie );
         }
 
-        SideID side = NEUTRAL;
-        if ( team_name_left == teamname )
-        {
-            side = LEFT;
-        }
-        else if ( team_name_right == teamname )
-        {
-            side = RIGHT;
-        }
-        else if ( team_name_left.empty() )
-        {
-            team_name_left = teamname;
-            side = LEFT;
-        }
-        else if ( team_name_right.empty() )
-        {
-            team_name_right = teamname;
-            side = RIGHT;
-        }
-        else
+        if ( ! p )
         {
             std::cerr << __FILE__ << ' ' << __LINE__
-                      << "***ERROR*** invalide message(4) [" << msg << ']'
+                      << "***ERROR*** invalide message(3) [" << player_begin << ']'
                       << std::endl;
             break;
         }
 
-        msg += n_read;
-
-        if ( *msg == 'g' )
+        const SideID side = team_side( teamname, &team_name_left, &team_name_right );
+        if ( side == NEUTRAL )
         {
-            goalie = true;
+            std::cerr << __FILE__ << ' ' << __LINE__
+                      << "***ERROR*** invalide message(4) [" << player_begin << ']'
+                      << std::endl;
+            break;
         }
 
-        while ( *msg != ')' ) ++msg; // skip to last of the player name
-        ++msg; // skip ')'
-
-        if ( std::sscanf( msg,
-                          " %lf %lf %lf %lf %lf %lf %n ",
-                          &x, &y, &vx, &vy, &body, &neck, &n_read ) != 6 )
+        // x, y, vx, vy, body, neck
+        double v[6];
+        if ( ! read_doubles( &p, end, v, 6 ) )
         {
             std::cerr << __FILE__ << ' ' << __LINE__
-                      << "***ERROR*** invalide message(5) [" << msg << ']'
+                      << "***ERROR*** invalide message(5) [" << p << ']'
                       << std::endl;
             break;
         }
-        msg += n_read;
-
-        player.setTeam( side, unum, goalie );
-        player.setPos( x, y );
-        player.setVel( vx, vy );
-        player.setAngle( body, neck );
 
-        M_players.push_back( player );
+        CoachPlayerObject & player = nextPlayer( count );
+        ++count;
 
+        player.setTeam( side, unum, goalie );
+        player.setPos( v[0], v[1] );
+        player.setVel( v[2], v[3] );
+        player.setAngle( v[4], v[5] );
 
         // skip to the last paren of the player info
-        while ( *msg != '\0' && *msg != ')' ) ++msg;
-        while ( *msg == ')' ) ++msg;
+        p = skip_until( p, end, ')' );
+        while ( p < end && *p == ')' ) ++p;
     }
 
+    M_players.resize( count );
+
     if ( ! team_name_left.empty() )
     {
         M_team_name_left = team_name_left;
@@ -124,6 +124,13 @@ public:
                 const GameTime & current );
 
 private:
+    /*!
+      \brief get the player object to be filled with the next seen data
+      \param count the number of players already read from the current message
+      \return reference to the reused or the new player object
+     */
+    CoachPlayerObject & nextPlayer( const std::size_t count );
+
     /*!
       \brief analyze see message. v6-
       \param msg server raw message
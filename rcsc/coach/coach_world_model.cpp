@@ -45,6 +45,9 @@
 #include <rcsc/common/audio_memory.h>
 #include <rcsc/geom/rect_2d.h>
 
+#include <algorithm>
+#include <iterator>
+#include <memory>
 #include <iostream>
 #include <cstdio>
 
@@ -69,6 +72,8 @@ CoachWorldModel::CoachWorldModel()
       M_training_time( -1, 0 ),
       M_audio_memory( new AudioMemory() ),
       M_current_state( new CoachWorldState() ),
+      M_state_history( 300 ),
+      M_player_grid( Rect2D( Vector2D( -60.0, -40.0 ), Size2D( 120.0, 80.0 ) ), 5.0 ),
       M_last_kicker_side( NEUTRAL ),
       M_last_kicker_unum( Unum_Unknown ),
       M_pass_time( -1, 0 ),
@@ -126,6 +131,44 @@ CoachWorldModel::setAudioMemory( std::shared_ptr< AudioMemory > memory )
     M_audio_memory = memory;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CoachWorldModel::setStateHistorySize( const int size )
+{
+    M_state_history.setCapacity( static_cast< std::size_t >( std::max( 0, size ) ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::size_t
+CoachWorldModel::memoryUsage() const
+{
+    std::size_t bytes = M_state_history.capacity() * sizeof( CoachWorldState::ConstPtr );
+
+    for ( std::size_t i = 0; i < M_state_history.size(); ++i )
+    {
+        if ( M_state_history[i] != M_current_state )
+        {
+            bytes += M_state_history[i]->memoryUsage();
+        }
+    }
+
+    if ( M_current_state ) bytes += M_current_state->memoryUsage();
+    if ( M_previous_state
+         && M_state_history.find( M_previous_state->time() ) != M_previous_state )
+    {
+        bytes += M_previous_state->memoryUsage();
+    }
+    if ( M_spare_state ) bytes += M_spare_state->memoryUsage();
+
+    return bytes;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -437,9 +480,24 @@ CoachWorldModel::updateAfterSeeGlobal( const CoachVisualSensor & see_global,
                                                                  current,
                                                                  M_game_mode,
                                                                  M_previous_state ) );
+    updatePlayerGrid();
     updatePlayerType();
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CoachWorldModel::updatePlayerGrid()
+{
+    M_player_grid.clear();
+    for ( const CoachPlayerObject * p : M_current_state->allPlayers() )
+    {
+        M_player_grid.insert( p->pos(), p );
+    }
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -453,47 +511,22 @@ CoachWorldModel::updateJustBeforeDecision( const GameTime & current )
 
     updateCLangCapacity();
 
+    M_ball_events.update( *M_current_state, M_previous_state.get(), M_player_grid );
+
     updateLastKicker();
     updateLastPasser();
 
     M_current_state->updatePlayerStamina( *M_audio_memory );
 
     //
-    // store the latest state data
+    // store the latest state data.
+    // the oldest state is dropped if the history is full.
     //
-    if ( gameMode().type() == GameMode::BeforeKickOff
-         || gameMode().type() == GameMode::TimeOver )
-    {
-        // if ( ! M_state_list.empty()
-        //      && M_state_list.back()->gameMode().type() == gameMode().type() )
-        // {
-        //     M_state_map.erase( M_state_list.back()->time() );
-        //     M_state_list.pop_back();
-        // }
-        // M_state_map[ current ] = M_current_state;
-        // M_state_list.push_back( M_current_state );
-    }
-    else
+    if ( gameMode().type() != GameMode::BeforeKickOff
+         && gameMode().type() != GameMode::TimeOver )
     {
-        M_state_list.push_back( M_current_state );
-        M_state_map[ current ] = M_current_state;
-    }
-
-    //
-    // erase the oldest state data
-    //
-    if ( M_state_list.size() > 60000 )
-    {
-        GameMode::Type mode = M_state_list.front()->gameMode().type();
-        GameTime t = M_state_list.front()->time();
-        if ( mode == GameMode::BeforeKickOff
-             || mode == GameMode::TimeOver )
-        {
-            t.setStopped( 0 );
-        }
-
-        M_state_map.erase( t );
-        M_state_list.pop_front();
+        M_statistics.addState( *M_current_state, gameMode() );
+        recycleState( M_state_history.push( M_current_state ) );
     }
 }
 
@@ -650,7 +683,7 @@ CoachWorldModel::updatePlayerType()
 
 /*-------------------------------------------------------------------*/
 /*!
-  TODO: support old visual information that has no kick/tackle/foul information.
+
  */
 void
 CoachWorldModel::updateLastKicker()
@@ -684,28 +717,29 @@ CoachWorldModel::updateLastKicker()
             M_last_kicker_unum = p->unum();
         }
 
+        M_statistics.setLastKicker( M_last_kicker_side, M_last_kicker_unum );
+
         dlog.addText( Logger::WORLD,
                       __FILE__":(updateLastKicker) non-playon side=%d unum=%d",
                       M_last_kicker_side, M_last_kicker_unum );
         return;
     }
 
-    if ( ! M_previous_state )
-    {
-        return;
-    }
-
-    const CoachPlayerObject * kicker = M_current_state->kicker();
+    const CoachBallEvent * event = M_ball_events.current();
 
-    if ( M_current_state->kickerCandidates().size() > 1 )
+    if ( event )
     {
-        M_last_kicker_side = NEUTRAL;
-        M_last_kicker_unum = Unum_Unknown;
-    }
-    else if ( kicker )
-    {
-        M_last_kicker_side = kicker->side();
-        M_last_kicker_unum = kicker->unum();
+        M_last_kicker_side = event->side_;
+        M_last_kicker_unum = event->unum_;
+
+        if ( event->side_ == NEUTRAL )
+        {
+            M_statistics.setLastKicker( NEUTRAL, Unum_Unknown );
+        }
+        else
+        {
+            M_statistics.addKick( event->side_, event->unum_, event->time_ );
+        }
     }
 
     dlog.addText( Logger::WORLD,
@@ -792,6 +826,8 @@ CoachWorldModel::updateLastPasser()
     M_pass_start_pos = ball->pos();
     M_pass_receive_pos = pass.receive_pos_;
 
+    M_statistics.addAnnouncedPass( ourSide(), M_passer_unum, M_receiver_unum, M_pass_time );
+
     dlog.addText( Logger::WORLD,
                   __FILE__":(updateLastPasser) time=%ld passer=%d receiver=%d start=(%.2f %.2f) end=(%.2f %.2f)",
                   M_pass_time.cycle(),
@@ -807,40 +843,53 @@ CoachWorldModel::updateLastPasser()
  */
 void
 CoachWorldModel::updateAll( const rcg::DispInfoT & disp )
+{
+    updateAll( disp.show_, disp.pmode_, disp.team_[0], disp.team_[1] );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CoachWorldModel::updateAll( const rcg::ShowInfoT & show,
+                            const PlayMode pmode,
+                            const rcg::TeamT & team_l,
+                            const rcg::TeamT & team_r )
 {
     GameTime new_time = M_time;
 
     //
     // update current time
     //
-    if ( new_time.cycle() == static_cast< long >( disp.show_.time_ ) )
+    if ( new_time.cycle() == static_cast< long >( show.time_ ) )
     {
         if ( M_previous_state
              && M_previous_state->gameMode().isServerCycleStoppedMode()
-             && M_previous_state->gameMode().getServerPlayMode() == disp.pmode_ )
+             && M_previous_state->gameMode().getServerPlayMode() == pmode )
         {
             new_time.setStopped( M_previous_state->time().stopped() + 1 );
         }
         else
         {
-            new_time.assign( static_cast< long >( disp.show_.time_ ), new_time.stopped() + 1 );
+            new_time.assign( static_cast< long >( show.time_ ), new_time.stopped() + 1 );
         }
     }
     else
     {
-        new_time.assign( static_cast< long >( disp.show_.time_ ), 0 );
+        new_time.assign( static_cast< long >( show.time_ ), 0 );
     }
     M_time = new_time;
 
     //
     // update playmode
     //
-    updateGameMode( disp );
+    updateGameMode( pmode, team_l, team_r );
 
     //
     // update object information
     //
-    updateState( disp, new_time );
+    updateState( show, team_l, team_r, new_time );
 
     //
     // finalize
@@ -853,38 +902,40 @@ CoachWorldModel::updateAll( const rcg::DispInfoT & disp )
 
  */
 void
-CoachWorldModel::updateGameMode( const rcg::DispInfoT & disp )
+CoachWorldModel::updateGameMode( const PlayMode pmode,
+                                 const rcg::TeamT & team_l,
+                                 const rcg::TeamT & team_r )
 {
-    static const char * s_playmode_strings[] = PLAYMODE_STRINGS;
+    static const char * s_playmode_cstrings[] = PLAYMODE_STRINGS;
+    // converted once, because the long playmode names do not fit in the small string buffer.
+    static const std::vector< std::string > s_playmode_strings( std::begin( s_playmode_cstrings ),
+                                                                std::end( s_playmode_cstrings ) );
 
-    if ( disp.pmode_ >= PM_MAX )
+    if ( pmode >= PM_MAX )
     {
         std::cerr << __FILE__ << ' ' << __LINE__
-                  << ": illegal playmode id " << disp.pmode_ << std::endl;
+                  << ": illegal playmode id " << pmode << std::endl;
         return;
     }
 
-    std::string mode_str;
-    if ( disp.pmode_ == PM_AfterGoal_Left )
+    GameMode new_mode = M_game_mode;
+    if ( pmode == PM_AfterGoal_Left )
     {
         char score[32];
-        snprintf( score, 32, "goal_l_%d", disp.team_[0].score() );
-        mode_str = score;
+        snprintf( score, 32, "goal_l_%d", team_l.score() );
+        new_mode.update( score, M_time );
     }
-    else if ( disp.pmode_ == PM_AfterGoal_Right )
+    else if ( pmode == PM_AfterGoal_Right )
     {
         char score[32];
-        snprintf( score, 32, "goal_r_%d", disp.team_[1].score() );
-        mode_str = score;
+        snprintf( score, 32, "goal_r_%d", team_r.score() );
+        new_mode.update( score, M_time );
     }
     else
     {
-        mode_str = s_playmode_strings[disp.pmode_];
+        new_mode.update( s_playmode_strings[pmode], M_time );
     }
 
-    GameMode new_mode = M_game_mode;
-    new_mode.update( mode_str, M_time );
-
     updateGameMode( new_mode, M_time );
 }
 
@@ -893,7 +944,9 @@ CoachWorldModel::updateGameMode( const rcg::DispInfoT & disp )
 
  */
 void
-CoachWorldModel::updateState( const rcg::DispInfoT & disp,
+CoachWorldModel::updateState( const rcg::ShowInfoT & show,
+                              const rcg::TeamT & team_l,
+                              const rcg::TeamT & team_r,
                               const GameTime & current )
 {
     dlog.addText( Logger::WORLD,
@@ -905,15 +958,30 @@ CoachWorldModel::updateState( const rcg::DispInfoT & disp,
     }
     M_see_time = current;
 
-    updateTeamNames( disp );
+    updateTeamNames( team_l, team_r );
 
+    const CoachWorldState::ConstPtr released = M_previous_state;
     M_previous_state = M_current_state;
-    M_current_state = CoachWorldState::Ptr( new CoachWorldState( disp,
-                                                                 M_time,
-                                                                 M_game_mode,
-                                                                 M_previous_state ) );
 
-    updatePlayerType( disp );
+    if ( M_spare_state )
+    {
+        M_spare_state->assign( show, M_time, M_game_mode, M_previous_state );
+        M_current_state.swap( M_spare_state );
+        M_spare_state.reset();
+    }
+    else
+    {
+        M_current_state = std::make_shared< CoachWorldState >( show,
+                                                               M_time,
+                                                               M_game_mode,
+                                                               M_previous_state );
+    }
+
+    recycleState( released );
+
+    updatePlayerGrid();
+
+    updatePlayerType( show );
 }
 
 /*-------------------------------------------------------------------*/
@@ -921,18 +989,19 @@ CoachWorldModel::updateState( const rcg::DispInfoT & disp,
 
  */
 void
-CoachWorldModel::updateTeamNames( const rcg::DispInfoT & disp )
+CoachWorldModel::updateTeamNames( const rcg::TeamT & team_l,
+                                  const rcg::TeamT & team_r )
 {
     if ( M_our_team_name.empty()
-         && ! disp.team_[0].name().empty() )
+         && ! team_l.name().empty() )
     {
-        M_our_team_name = disp.team_[0].name();
+        M_our_team_name = team_l.name();
     }
 
     if ( M_their_team_name.empty()
-         && ! disp.team_[1].name().empty() )
+         && ! team_r.name().empty() )
     {
-        M_their_team_name = disp.team_[1].name();
+        M_their_team_name = team_r.name();
     }
 }
 
@@ -941,12 +1010,12 @@ CoachWorldModel::updateTeamNames( const rcg::DispInfoT & disp )
 
  */
 void
-CoachWorldModel::updatePlayerType( const rcg::DispInfoT & disp )
+CoachWorldModel::updatePlayerType( const rcg::ShowInfoT & show )
 {
     //
     // no player type information
     //
-    if ( disp.show_.player_[0].type_ < 0 )
+    if ( show.player_[0].type_ < 0 )
     {
         for ( int i = 0; i < 11; ++i )
         {
@@ -962,10 +1031,10 @@ CoachWorldModel::updatePlayerType( const rcg::DispInfoT & disp )
     //
     for ( int i = 0; i < 11; ++i )
     {
-        int t = static_cast< int >( disp.show_.player_[i].type_ );
-        int o = static_cast< int >( disp.show_.player_[11+i].type_ );
+        int t = static_cast< int >( show.player_[i].type_ );
+        int o = static_cast< int >( show.player_[11+i].type_ );
 
-        if ( disp.show_.time_ > 1 )
+        if ( show.time_ > 1 )
         {
             if ( M_our_player_type_id[i] != t )
             {
@@ -1008,6 +1077,24 @@ CoachWorldModel::updatePlayerType( const rcg::DispInfoT & disp )
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CoachWorldModel::recycleState( const CoachWorldState::ConstPtr & state )
+{
+    // the states are created by this model. if no one else refers to the state,
+    // its memory can be reused by the next cycle.
+    if ( ! M_spare_state
+         && state
+         && state.use_count() == 1
+         && state->ourSide() == NEUTRAL )
+    {
+        M_spare_state = std::const_pointer_cast< CoachWorldState >( state );
+    }
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -1331,18 +1418,9 @@ CoachPlayerObject *
 CoachWorldModel::getPlayerNearestTo( const Vector2D & point ) const
 {
     const CoachPlayerObject * ptr = nullptr;
-    double max_dist2 = 200000.0;
-
-    for ( const CoachPlayerObject * p : allPlayers() )
-    {
-        double d2 = p->pos().dist2( point );
-        if ( d2 < max_dist2 )
-        {
-            max_dist2 = d2;
-            ptr = p;
-        }
-    }
-
+    M_player_grid.nearest( point,
+                           []( const CoachPlayerObject * ) { return true; },
+                           &ptr );
     return ptr;
 }
 
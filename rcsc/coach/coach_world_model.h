@@ -32,11 +32,15 @@
 #ifndef RCSC_COACH_COACH_WORLD_MODEL_H
 #define RCSC_COACH_COACH_WORLD_MODEL_H
 
+#include <rcsc/coach/coach_ball_event_log.h>
 #include <rcsc/coach/coach_world_state.h>
+#include <rcsc/coach/coach_world_state_history.h>
+#include <rcsc/coach/coach_statistics.h>
 #include <rcsc/coach/coach_ball_object.h>
 #include <rcsc/coach/coach_player_object.h>
 #include <rcsc/coach/player_type_analyzer.h>
 #include <rcsc/clang/types.h>
+#include <rcsc/geom/uniform_grid_2d.h>
 #include <rcsc/game_mode.h>
 #include <rcsc/game_time.h>
 #include <rcsc/types.h>
@@ -94,8 +98,16 @@ private:
     CoachWorldState::Ptr M_current_state; //!< current world state. always exist instance.
     CoachWorldState::Ptr M_previous_state; //!< previous world state.
 
-    CoachWorldState::List M_state_list; //!< the record of world state.
-    CoachWorldState::Map M_state_map; //!< the map of world state;
+    CoachWorldStateHistory M_state_history; //!< the record of the recent world states.
+
+    CoachStatistics M_statistics; //!< streaming statistics of all recorded states
+
+    //! released state that is overwritten by the next game log data instead of allocating a new one.
+    CoachWorldState::Ptr M_spare_state;
+
+    UniformGrid2D< const CoachPlayerObject * > M_player_grid; //!< spatial index of the players in the current state
+
+    CoachBallEventLog M_ball_events; //!< recent kick, tackle and catch events
 
     SideID M_last_kicker_side; //!< last ball kicker's team side
     int M_last_kicker_unum; //!< last ball kicker's uniform number
@@ -173,6 +185,19 @@ public:
      */
     void setAudioMemory( std::shared_ptr< AudioMemory > memory );
 
+    /*!
+      \brief set the number of recorded world states
+      \param size the maximum number of states. 0 disables the recording.
+     */
+    void setStateHistorySize( const int size );
+
+    /*!
+      \brief get the heap bytes held by the world states, including the
+      recorded history
+      \return bytes
+     */
+    std::size_t memoryUsage() const;
+
     /*!
       \brief get audio memory
       \return co
@@ -252,6 +277,20 @@ public:
      */
     void updateAll( const rcg::DispInfoT & disp );
 
+    /*!
+      \brief update all information by using the game log data passed to rcg::Handler.
+      no intermediate DispInfoT is needed, and the released world states are reused,
+      so no memory is allocated per cycle once the state history is full.
+      \param show positional data
+      \param pmode the last playmode
+      \param team_l the last left team data
+      \param team_r the last right team data
+     */
+    void updateAll( const rcg::ShowInfoT & show,
+                    const PlayMode pmode,
+                    const rcg::TeamT & team_l,
+                    const rcg::TeamT & team_r );
+
 private:
 
     /*!
@@ -271,7 +310,12 @@ private:
     void updatePlayerType();
 
     /*!
-      \brief estimate last ball kicker.
+      \brief rebuild the spatial index of the players in the current state
+     */
+    void updatePlayerGrid();
+
+    /*!
+      \brief set last ball kicker by the event extracted from the current state.
      */
     void updateLastKicker();
 
@@ -285,29 +329,46 @@ private:
     //
 
     /*!
-      \brief update game mode by using display data
-      \param disp display data
+      \brief update game mode by using game log data
+      \param pmode playmode id
+      \param team_l left team data
+      \param team_r right team data
      */
-    void updateGameMode( const rcg::DispInfoT & disp );
+    void updateGameMode( const PlayMode pmode,
+                         const rcg::TeamT & team_l,
+                         const rcg::TeamT & team_r );
 
     /*!
-      \brief update positional information by using display data
-      \param disp display data
+      \brief update positional information by using game log data
+      \param show positional data
+      \param team_l left team data
+      \param team_r right team data
+      \param current current game time
      */
-    void updateState( const rcg::DispInfoT & disp,
+    void updateState( const rcg::ShowInfoT & show,
+                      const rcg::TeamT & team_l,
+                      const rcg::TeamT & team_r,
                       const GameTime & current );
 
     /*!
-      \brief update team names using display data
-      \param disp display data
+      \brief update team names using game log data
+      \param team_l left team data
+      \param team_r right team data
      */
-    void updateTeamNames( const rcg::DispInfoT & disp );
+    void updateTeamNames( const rcg::TeamT & team_l,
+                          const rcg::TeamT & team_r );
 
     /*!
       \brief update heterogeneous player types
-      \param disp display data
+      \param show positional data
      */
-    void updatePlayerType( const rcg::DispInfoT & disp );
+    void updatePlayerType( const rcg::ShowInfoT & show );
+
+    /*!
+      \brief keep the released state for reuse if nobody refers to it.
+      \param state released state
+     */
+    void recycleState( const CoachWorldState::ConstPtr & state );
 
     /*!
       \brief update card status
@@ -471,21 +532,22 @@ public:
       }
 
     /*!
-      \brief get the state list.
-      \return the world state list.
+      \brief get the recorded world states.
+      \return const reference to the history. index 0 is the current state.
      */
-    const CoachWorldState::List & stateList() const
+    const CoachWorldStateHistory & stateHistory() const
       {
-          return M_state_list;
+          return M_state_history;
       }
 
     /*!
-      \brief get the state map. key: GameTime, value: CoachWorldState::ConstPtr
-      \return the world state list.
+      \brief get the statistics of all recorded states.
+      The statistics are not limited by the state history size.
+      \return const reference to the statistics
      */
-    const CoachWorldState::Map & stateMap() const
+    const CoachStatistics & statistics() const
       {
-          return M_state_map;
+          return M_statistics;
       }
 
     /*!
@@ -500,12 +562,7 @@ public:
               return M_current_state;
           }
 
-          CoachWorldState::Map::const_iterator it = M_state_map.find( GameTime( time, 0 ) );
-          if ( it == M_state_map.end() )
-          {
-              return CoachWorldState::ConstPtr();
-          }
-          return it->second;
+          return M_state_history.find( GameTime( time, 0 ) );
       }
 
     /*!
@@ -520,12 +577,7 @@ public:
               return M_current_state;
           }
 
-          CoachWorldState::Map::const_iterator it = M_state_map.find( time );
-          if ( it == M_state_map.end() )
-          {
-              return CoachWorldState::ConstPtr();
-          }
-          return it->second;
+          return M_state_history.find( time );
       }
 
     /*!
@@ -615,6 +667,15 @@ public:
           return M_current_state->opponent( unum );
       }
 
+    /*!
+      \brief get the recent kick, tackle and catch events
+      \return const reference to the event log
+     */
+    const CoachBallEventLog & ballEvents() const
+      {
+          return M_ball_events;
+      }
+
     /*!
       \brief get the estimated last ball kicker's team side
       \return side id
@@ -37,6 +37,7 @@
 #include <rcsc/common/server_param.h>
 #include <rcsc/common/logger.h>
 #include <rcsc/time/timer.h>
+#include <rcsc/util/memory_accounting.h>
 #include <rcsc/rcg/types.h>
 
 // #define DEBUG_PRINT
@@ -74,7 +75,8 @@ CoachWorldState::CoachWorldState()
       M_fastest_intercept_teammate( nullptr ),
       M_fastest_intercept_opponent( nullptr )
 {
-    M_all_players.reserve( 22 );
+    M_player_storage.reserve( MAX_PLAYER * 2 );
+    M_all_players.reserve( MAX_PLAYER * 2 );
     M_teammates.reserve( 11 );
     M_opponents.reserve( 11 );
     std::fill( M_teammate_array, M_teammate_array + 11, nullptr );
@@ -102,7 +104,8 @@ CoachWorldState::CoachWorldState( const CoachVisualSensor & see_global,
       M_fastest_intercept_teammate( nullptr ),
       M_fastest_intercept_opponent( nullptr )
 {
-    M_all_players.reserve( 22 );
+    M_player_storage.reserve( MAX_PLAYER * 2 );
+    M_all_players.reserve( MAX_PLAYER * 2 );
     M_teammates.reserve( 11 );
     M_opponents.reserve( 11 );
     std::fill( M_teammate_array, M_teammate_array + 11, nullptr );
@@ -118,83 +121,14 @@ CoachWorldState::CoachWorldState( const CoachVisualSensor & see_global,
     //
     for ( const CoachPlayerObject & vp : see_global.players() )
     {
-        CoachPlayerObject * p = nullptr;
-
-        if ( prev_state )
-        {
-            const CoachPlayerObject * pp = prev_state->getPlayer( vp.side(), vp.unum() );
-
-            if ( pp )
-            {
-                p = pp->clone();
-                p->update( vp );
-            }
-        }
-
+        CoachPlayerObject * p = createPlayer( vp.side(), vp.unum(), prev_state );
         if ( ! p )
         {
-            p = new CoachPlayerObject();
-            p->update( vp );
+            break;
         }
 
-        if ( p )
-        {
-            M_all_players.push_back( p );
-
-            if ( p->unum() < 1 || 11 < p->unum() )
-            {
-                std::cerr << __FILE__ << ' ' << __LINE__
-                          << ": illegal uniform number: "
-                          << p->side() << ' ' << p->unum() << std::endl;
-                dlog.addText( Logger::WORLD,
-                              __FILE__":(CoachWorldState) illegal unum (%c %d) type=%d",
-                              side_char( p->side() ), p->unum(), p->type() );
-                continue;
-            }
-
-            if ( p->side() == NEUTRAL )
-            {
-                std::cerr << __FILE__ << ' ' << __LINE__
-                          << ": illegal team side id: "
-                          << p->side() << ' ' << p->unum() << std::endl;
-                dlog.addText( Logger::WORLD,
-                              __FILE__":(CoachWorldState) illegal side (%c %d) type=%d",
-                              side_char( p->side() ), p->unum(), p->type() );
-                continue;
-            }
-
-            if ( our_side == NEUTRAL ) // trainer or analyzer
-            {
-                if ( p->side() == LEFT )
-                {
-                    M_teammates.push_back( p );
-                    M_teammate_array[p->unum() - 1] = p;
-                }
-                else
-                {
-                    M_opponents.push_back( p );
-                    M_opponent_array[p->unum() - 1] = p;
-                }
-            }
-            else // coach
-            {
-                if ( p->side() != our_side )
-                {
-                    M_opponents.push_back( p );
-                    M_opponent_array[p->unum() - 1] = p;
-                }
-                else
-                {
-                    M_teammates.push_back( p );
-                    M_teammate_array[p->unum() - 1] = p;
-                }
-            }
-#ifdef DEBUG_PRINT
-            dlog.addText( Logger::WORLD,
-                          __FILE__":(CoachWorldState) created player (%c %d) type=%d",
-                          side_char( p->side() ), p->unum(), p->type() );
-#endif
-        }
+        p->update( vp );
+        addPlayer( p );
     }
 
     if ( our_side == RIGHT )
@@ -220,86 +154,76 @@ CoachWorldState::CoachWorldState( const rcg::DispInfoT & disp,
                                   const GameTime & current_time,
                                   const GameMode & current_mode,
                                   const CoachWorldState::Ptr & prev_state )
-    : M_our_side( NEUTRAL ),
-      M_time( current_time ),
-      M_game_mode( current_mode ),
-      M_our_offside_line_x( 0.0 ),
-      M_their_offside_line_x( 0.0 ),
-      M_kicker( nullptr ),
-      M_ball_owner_side( NEUTRAL ),
-      M_ball_owner( nullptr ),
-      M_fastest_intercept_player( nullptr ),
-      M_fastest_intercept_teammate( nullptr ),
-      M_fastest_intercept_opponent( nullptr )
+    : CoachWorldState( disp.show_, current_time, current_mode, prev_state )
 {
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CoachWorldState::CoachWorldState( const rcg::ShowInfoT & show,
+                                  const GameTime & current_time,
+                                  const GameMode & current_mode,
+                                  const CoachWorldState::Ptr & prev_state )
+    : CoachWorldState()
+{
+    assign( show, current_time, current_mode, prev_state );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CoachWorldState::assign( const rcg::ShowInfoT & show,
+                         const GameTime & current_time,
+                         const GameMode & current_mode,
+                         const CoachWorldState::Ptr & prev_state )
+{
+    M_time = current_time;
+    M_game_mode = current_mode;
+
     //
     // ball
     //
-    M_ball.setValue( disp.show_.ball_.x_,
-                     disp.show_.ball_.y_,
-                     disp.show_.ball_.vx_,
-                     disp.show_.ball_.vy_ );
+    M_ball.setValue( show.ball_.x_,
+                     show.ball_.y_,
+                     show.ball_.vx_,
+                     show.ball_.vy_ );
 
     //
     // players
     //
-    M_all_players.reserve( 22 );
-    M_teammates.reserve( 11 );
-    M_opponents.reserve( 11 );
+    // clear() keeps the capacity reserved by the constructor.
+    M_player_storage.clear();
+    M_all_players.clear();
+    M_teammates.clear();
+    M_opponents.clear();
+    M_kicker_candidates.clear();
     std::fill( M_teammate_array, M_teammate_array + 11, nullptr );
     std::fill( M_opponent_array, M_opponent_array + 11, nullptr );
 
-    for ( size_t i = 0; i < 22; ++i )
-    {
-        CoachPlayerObject * p = nullptr;
-
-        if ( prev_state )
-        {
-            const CoachPlayerObject * pp = prev_state->getPlayer( disp.show_.player_[i].side(),
-                                                                  disp.show_.player_[i].unum_ );
-            if ( pp )
-            {
-                p = pp->clone();
-                p->update( disp.show_.player_[i] );
-            }
-        }
+    M_our_offside_line_x = 0.0;
+    M_their_offside_line_x = 0.0;
+    M_kicker = nullptr;
+    M_ball_owner_side = NEUTRAL;
+    M_ball_owner = nullptr;
+    M_fastest_intercept_player = nullptr;
+    M_fastest_intercept_teammate = nullptr;
+    M_fastest_intercept_opponent = nullptr;
 
+    for ( const rcg::PlayerT & dp : show.player_ )
+    {
+        CoachPlayerObject * p = createPlayer( dp.side(), dp.unum_, prev_state );
         if ( ! p )
         {
-            p = new CoachPlayerObject();
-            p->update( disp.show_.player_[i] );
+            break;
         }
 
-        if ( p )
-        {
-            M_all_players.push_back( p );
-
-            if ( p->unum() < 1 || 11 < p->unum() )
-            {
-                std::cerr << __FILE__ << ' ' << __LINE__
-                          << ": illegal uniform number: " << i << ' '
-                          << p->side() << ' ' << p->unum() << std::endl;
-                continue;
-            }
-
-            if ( p->side() == LEFT )
-            {
-                M_teammates.push_back( p );
-                M_teammate_array[p->unum() - 1] = p;
-            }
-            else if ( p->side() == RIGHT )
-            {
-                M_opponents.push_back( p );
-                M_opponent_array[p->unum() - 1] = p;
-            }
-            else
-            {
-                std::cerr << __FILE__ << ' ' << __LINE__
-                          << ": illegal side id: " << i << ' '
-                          << p->side() << ' ' << p->unum() << std::endl;
-            }
-
-        }
+        p->update( dp );
+        addPlayer( p );
     }
 
     updateOffsideLines();
@@ -307,6 +231,91 @@ CoachWorldState::CoachWorldState( const rcg::DispInfoT & disp,
     updateInterceptTable();
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CoachPlayerObject *
+CoachWorldState::createPlayer( const SideID side,
+                               const int unum,
+                               const CoachWorldState::Ptr & prev_state )
+{
+    if ( M_player_storage.size() == M_player_storage.capacity() )
+    {
+        std::cerr << __FILE__ << ' ' << __LINE__
+                  << ": too many players." << std::endl;
+        return nullptr;
+    }
+
+    // the copy of the previous player shares its profile data.
+    const CoachPlayerObject * pp = ( prev_state
+                                     ? prev_state->getPlayer( side, unum )
+                                     : nullptr );
+    if ( pp )
+    {
+        M_player_storage.push_back( *pp );
+    }
+    else
+    {
+        M_player_storage.emplace_back();
+    }
+
+    return &M_player_storage.back();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CoachWorldState::addPlayer( CoachPlayerObject * p )
+{
+    M_all_players.push_back( p );
+
+    if ( p->unum() < 1 || 11 < p->unum() )
+    {
+        std::cerr << __FILE__ << ' ' << __LINE__
+                  << ": illegal uniform number: "
+                  << p->side() << ' ' << p->unum() << std::endl;
+        dlog.addText( Logger::WORLD,
+                      __FILE__":(CoachWorldState) illegal unum (%c %d) type=%d",
+                      side_char( p->side() ), p->unum(), p->type() );
+        return;
+    }
+
+    if ( p->side() == NEUTRAL )
+    {
+        std::cerr << __FILE__ << ' ' << __LINE__
+                  << ": illegal team side id: "
+                  << p->side() << ' ' << p->unum() << std::endl;
+        dlog.addText( Logger::WORLD,
+                      __FILE__":(CoachWorldState) illegal side (%c %d) type=%d",
+                      side_char( p->side() ), p->unum(), p->type() );
+        return;
+    }
+
+    // if trainer or analyzer, the left side players are regarded as teammates.
+    const bool teammate = ( M_our_side == NEUTRAL
+                            ? p->side() == LEFT
+                            : p->side() == M_our_side );
+    if ( teammate )
+    {
+        M_teammates.push_back( p );
+        M_teammate_array[p->unum() - 1] = p;
+    }
+    else
+    {
+        M_opponents.push_back( p );
+        M_opponent_array[p->unum() - 1] = p;
+    }
+
+#ifdef DEBUG_PRINT
+    dlog.addText( Logger::WORLD,
+                  __FILE__":(CoachWorldState) created player (%c %d) type=%d",
+                  side_char( p->side() ), p->unum(), p->type() );
+#endif
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -319,15 +328,23 @@ CoachWorldState::~CoachWorldState()
     std::fill( M_teammate_array, M_teammate_array + 11, nullptr );
     std::fill( M_opponent_array, M_opponent_array + 11, nullptr );
 
-    for ( CoachPlayerObject::Cont::iterator p = M_all_players.begin(), end = M_all_players.end();
-          p != end;
-          ++p )
-    {
-        delete *p;
-        *p = nullptr;
-    }
-
     M_all_players.clear();
+    M_player_storage.clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::size_t
+CoachWorldState::memoryUsage() const
+{
+    return sizeof( CoachWorldState )
+        + vector_memory_usage( M_player_storage )
+        + vector_memory_usage( M_all_players )
+        + vector_memory_usage( M_teammates )
+        + vector_memory_usage( M_opponents )
+        + vector_memory_usage( M_kicker_candidates );
 }
 
 /*-------------------------------------------------------------------*/
@@ -480,6 +497,14 @@ CoachWorldState::updatePlayerStamina( const AudioMemory & audio )
         return;
     }
 
+    if ( ! audio.heardAny( AudioMemory::mask( AudioMemory::HEARD_STAMINA )
+                           | AudioMemory::mask( AudioMemory::HEARD_RECOVERY )
+                           | AudioMemory::mask( AudioMemory::HEARD_STAMINA_CAPACITY ),
+                           this->time() ) )
+    {
+        return;
+    }
+
     //
     // stamina
     //
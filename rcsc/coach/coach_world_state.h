@@ -41,6 +41,7 @@
 #include <iostream>
 #include <list>
 #include <map>
+#include <vector>
 
 namespace rcsc {
 
@@ -49,6 +50,8 @@ class CoachVisualSensor;
 
 namespace rcg {
 struct DispInfoT;
+struct ShowInfoT;
+struct TeamT;
 }
 
 /*!
@@ -72,7 +75,11 @@ private:
     GameMode M_game_mode; //!< playmode of this state
 
     CoachBallObject M_ball; //!< ball instance
-    CoachPlayerObject::Cont M_all_players; //!< all players (instance)
+
+    //! player instances. the capacity is reserved in advance so that the pointers are never invalidated.
+    std::vector< CoachPlayerObject > M_player_storage;
+
+    CoachPlayerObject::Cont M_all_players; //!< all players (reference to M_player_storage)
     CoachPlayerObject::Cont M_teammates; //!< teammate players (reference). if trainer, this container holds left side players.
     CoachPlayerObject::Cont M_opponents; //!< opponent players (reference). if trainer, this container holds right side players.
 
@@ -133,11 +140,43 @@ public:
                      const GameMode & current_mode,
                      const CoachWorldState::Ptr & prev_state );
 
+    /*!
+      \brief construct from game log data.
+      \param show one cycle positional data.
+      \param current_time current game time
+      \param current_mode current play mode
+      \param prev_state previous cycle's state
+     */
+    CoachWorldState( const rcg::ShowInfoT & show,
+                     const GameTime & current_time,
+                     const GameMode & current_mode,
+                     const CoachWorldState::Ptr & prev_state );
+
     /*!
       \brief nothing to do
     */
     ~CoachWorldState();
 
+    /*!
+      \brief get the bytes held by this state, including the instance itself
+      \return bytes
+    */
+    std::size_t memoryUsage() const;
+
+    /*!
+      \brief overwrite this state by the next game log data.
+      the allocated memory is reused, so no memory is allocated.
+      this state must not be referred by others, and must not be prev_state.
+      \param show one cycle positional data.
+      \param current_time current game time
+      \param current_mode current play mode
+      \param prev_state previous cycle's state
+     */
+    void assign( const rcg::ShowInfoT & show,
+                 const GameTime & current_time,
+                 const GameMode & current_mode,
+                 const CoachWorldState::Ptr & prev_state );
+
     /*!
       \brief set player type
       \param side player's side
@@ -181,6 +220,23 @@ public:
 
 private:
 
+    /*!
+      \brief create a new player object in the storage.
+      \param side seen player's side
+      \param unum seen player's uniform number
+      \param prev_state previous cycle's state
+      \return pointer to the copy of the previous player or the new player. NULL if the storage is full.
+     */
+    CoachPlayerObject * createPlayer( const SideID side,
+                                      const int unum,
+                                      const CoachWorldState::Ptr & prev_state );
+
+    /*!
+      \brief register the updated player to the player containers
+      \param p pointer to the player in the storage
+     */
+    void addPlayer( CoachPlayerObject * p );
+
     /*!
       \brief calculate offside lines for both team
      */
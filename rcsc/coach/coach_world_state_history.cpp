@@ -0,0 +1,170 @@
+// -*-c++-*-
+
+/*!
+  \file coach_world_state_history.cpp
+  \brief bounded history of the coach world states Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "coach_world_state_history.h"
+
+#include <algorithm>
+
+namespace rcsc {
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CoachWorldStateHistory::CoachWorldStateHistory( const std::size_t capacity )
+    : M_states( capacity ),
+      M_head( 0 ),
+      M_size( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CoachWorldStateHistory::setCapacity( const std::size_t capacity )
+{
+    if ( capacity == M_states.size() )
+    {
+        return;
+    }
+
+    const std::size_t n = std::min( capacity, M_size );
+    std::vector< CoachWorldState::ConstPtr > states( capacity );
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        states[i] = ( *this )[i];
+    }
+
+    M_states.swap( states );
+    M_head = 0;
+    M_size = n;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CoachWorldStateHistory::clear()
+{
+    std::fill( M_states.begin(), M_states.end(), CoachWorldState::ConstPtr() );
+    M_head = 0;
+    M_size = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CoachWorldState::ConstPtr
+CoachWorldStateHistory::push( const CoachWorldState::ConstPtr & state )
+{
+    if ( M_states.empty() )
+    {
+        return CoachWorldState::ConstPtr();
+    }
+
+    M_head = ( M_head == 0 ? M_states.size() - 1 : M_head - 1 );
+
+    // the slot of the new head holds the oldest state if full, otherwise NULL.
+    CoachWorldState::ConstPtr released;
+    released.swap( M_states[M_head] );
+    M_states[M_head] = state;
+    if ( M_size < M_states.size() )
+    {
+        ++M_size;
+    }
+
+    return released;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CoachWorldState::ConstPtr
+CoachWorldStateHistory::find( const GameTime & time ) const
+{
+    if ( M_size == 0 )
+    {
+        return CoachWorldState::ConstPtr();
+    }
+
+    const GameTime & newest = ( *this )[0]->time();
+    if ( newest < time )
+    {
+        return CoachWorldState::ConstPtr();
+    }
+
+    // the slot when no cycle is skipped after the target time
+    const long estimated = ( newest.cycle() - time.cycle() ) + ( newest.stopped() - time.stopped() );
+    if ( 0 <= estimated
+         && estimated < static_cast< long >( M_size )
+         && ( *this )[estimated]->time() == time )
+    {
+        return ( *this )[estimated];
+    }
+
+    // the times decrease with the index.
+    std::size_t first = 0;
+    std::size_t count = M_size;
+    while ( count > 0 )
+    {
+        const std::size_t step = count / 2;
+        const std::size_t i = first + step;
+        if ( time < ( *this )[i]->time() )
+        {
+            first = i + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+
+    if ( first < M_size
+         && ( *this )[first]->time() == time )
+    {
+        return ( *this )[first];
+    }
+
+    return CoachWorldState::ConstPtr();
+}
+
+}
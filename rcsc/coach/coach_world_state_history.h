@@ -0,0 +1,136 @@
+// -*-c++-*-
+
+/*!
+  \file coach_world_state_history.h
+  \brief bounded history of the coach world states Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_COACH_WORLD_STATE_HISTORY_H
+#define RCSC_COACH_WORLD_STATE_HISTORY_H
+
+#include <rcsc/coach/coach_world_state.h>
+#include <rcsc/game_time.h>
+
+#include <vector>
+#include <cstddef>
+
+namespace rcsc {
+
+/*!
+  \class CoachWorldStateHistory
+  \brief fixed capacity ring of the recorded world states.
+
+  States are pushed in the time order. If the ring is full, the oldest state
+  is released. Index 0 refers to the newest state as RingBuffer does.
+  The storage is one contiguous array allocated by setCapacity(), so recording
+  a state never allocates except for the state itself.
+  find() first checks the slot estimated by the cycle difference from the
+  newest state, which hits directly unless cycles were skipped or stopped,
+  and falls back to the binary search in the ring.
+*/
+class CoachWorldStateHistory {
+private:
+
+    std::vector< CoachWorldState::ConstPtr > M_states; //!< ring storage
+    std::size_t M_head; //!< physical index of the newest state
+    std::size_t M_size; //!< the number of recorded states
+
+public:
+
+    /*!
+      \brief create a history with the given capacity
+      \param capacity the maximum number of recorded states
+     */
+    explicit
+    CoachWorldStateHistory( const std::size_t capacity = 0 );
+
+    /*!
+      \brief change the capacity. the newest states are kept.
+      \param capacity the maximum number of recorded states. 0 disables the recording.
+     */
+    void setCapacity( const std::size_t capacity );
+
+    /*!
+      \brief get the maximum number of recorded states
+      \return capacity
+     */
+    std::size_t capacity() const
+      {
+          return M_states.size();
+      }
+
+    /*!
+      \brief get the number of recorded states
+      \return state count
+     */
+    std::size_t size() const
+      {
+          return M_size;
+      }
+
+    /*!
+      \brief check if no state is recorded
+      \return checked result
+     */
+    bool empty() const
+      {
+          return M_size == 0;
+      }
+
+    /*!
+      \brief release all states. the capacity is not changed.
+     */
+    void clear();
+
+    /*!
+      \brief record the new state. if full, the oldest state is released.
+      \param state new state. it must be newer than every recorded state.
+      \return the released oldest state. NULL if not full.
+     */
+    CoachWorldState::ConstPtr push( const CoachWorldState::ConstPtr & state );
+
+    /*!
+      \brief get the recorded state
+      \param i index from the newest state. must be less than size().
+      \return const reference to the state pointer
+     */
+    const CoachWorldState::ConstPtr & operator[]( const std::size_t i ) const
+      {
+          return M_states[( M_head + i ) % M_states.size()];
+      }
+
+    /*!
+      \brief get the state at the specified game time
+      \param time game time
+      \return const pointer. if not recorded, NULL is returned.
+     */
+    CoachWorldState::ConstPtr find( const GameTime & time ) const;
+};
+
+}
+
+#endif
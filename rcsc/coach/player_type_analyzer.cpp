@@ -44,6 +44,7 @@
 #include <rcsc/common/logger.h>
 #include <rcsc/game_mode.h>
 
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
 
@@ -70,6 +71,7 @@ PlayerTypeAnalyzer::Data::Data()
       vel_( 0.0, 0.0 ),
       body_( -360 ),
       invalid_flags_( PlayerParam::i().playerTypes(), 0 ),
+      candidate_count_( PlayerParam::i().playerTypes() ),
       type_( Hetero_Default )
 {
 
@@ -83,6 +85,7 @@ void
 PlayerTypeAnalyzer::Data::setDefaultType()
 {
     invalid_flags_.assign( PlayerParam::i().playerTypes(), 0 );
+    candidate_count_ = PlayerParam::i().playerTypes();
 
     type_ = Hetero_Default;
 }
@@ -95,6 +98,7 @@ void
 PlayerTypeAnalyzer::Data::setUnknownType()
 {
     invalid_flags_.assign( PlayerParam::i().playerTypes(), 0 );
+    candidate_count_ = PlayerParam::i().playerTypes();
 
     type_ = Hetero_Unknown;
 }
@@ -102,6 +106,19 @@ PlayerTypeAnalyzer::Data::setUnknownType()
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+PlayerTypeAnalyzer::Data::resizeFlags( const std::size_t size )
+{
+    invalid_flags_.resize( size, 0 );
+    candidate_count_ = static_cast< int >( std::count( invalid_flags_.begin(),
+                                                       invalid_flags_.end(),
+                                                       0 ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 PlayerTypeAnalyzer::PlayerTypeAnalyzer( const CoachWorldModel & world )
     : M_world( world ),
@@ -128,12 +145,12 @@ PlayerTypeAnalyzer::update()
     {
         if ( M_teammate_data[i].invalid_flags_.size() != max_types )
         {
-            M_teammate_data[i].invalid_flags_.resize( max_types, 0 );
+            M_teammate_data[i].resizeFlags( max_types );
         }
 
         if ( M_opponent_data[i].invalid_flags_.size() != max_types )
         {
-            M_opponent_data[i].invalid_flags_.resize( max_types, 0 );
+            M_opponent_data[i].resizeFlags( max_types );
         }
 
 #if 0
@@ -275,14 +292,28 @@ PlayerTypeAnalyzer::updateLastData()
 void
 PlayerTypeAnalyzer::analyze()
 {
+    // the types of all opponents are determined or not changed.
+    if ( std::none_of( M_opponent_data, M_opponent_data + 11,
+                       []( const Data & data )
+                         {
+                             return data.type_ == Hetero_Unknown;
+                         } ) )
+    {
+        return;
+    }
+
+    // update the action flags used by the following checks
     checkTurn();
     checkTackle();
     checkReferee();
     checkCollisions();
-    checkKick();
+
+    // the checks that reduce the candidates.
+    // the players that have only one candidate are skipped by the later checks.
+    checkKick(); // this also updates the kick flags.
     checkPlayerDecay();
-    checkPlayerSpeedMax();
     checkTurnMoment();
+    checkPlayerSpeedMax();
 
 #ifdef DEBUG_PRINT_MATRIX
     debugPrintIllegalMatrix();
@@ -319,14 +350,7 @@ PlayerTypeAnalyzer::analyze()
         // if player might be moved by referee, we must not analyze
         if ( data.maybe_referee_ ) continue;
 
-        int invalid_count = 0;
-        for ( int t = 0; t < max_types; ++t )
-        {
-            if ( data.invalid_flags_[t] != 0 )
-            {
-                ++invalid_count;
-            }
-        }
+        const int invalid_count = max_types - data.candidate_count_;
 
 #ifdef DEBUG_PRINT_RESULT
         dlog.addText( Logger::ANALYZER,
@@ -372,7 +396,7 @@ PlayerTypeAnalyzer::analyze()
                         {
                             if ( M_opponent_data[i].type_ == Hetero_Unknown )
                             {
-                                M_opponent_data[i].invalid_flags_[t] = 1;
+                                M_opponent_data[i].invalidate( t );
                             }
                         }
                     }
@@ -535,6 +559,8 @@ PlayerTypeAnalyzer::checkReferee()
 
         Data & data = M_opponent_data[p->unum() - 1];
 
+        if ( ! data.needsCheck() ) continue;
+
         // player may be moved by referee
         if ( our_set_play )
         {
@@ -606,6 +632,8 @@ PlayerTypeAnalyzer::checkCollisions()
 
         Data & data = M_opponent_data[p->unum() - 1];
 
+        if ( ! data.needsCheck() ) continue;
+
         if ( p->pos().dist2( M_world.ball().pos() ) < ball_collide_dist2 )
         {
             data.maybe_collide_ = true;
@@ -631,6 +659,12 @@ PlayerTypeAnalyzer::checkCollisions()
               ++pp )
         {
             if ( (*pp)->unum() == (*p)->unum() ) continue;
+            if ( ! data.needsCheck()
+                 && ( (*pp)->unum() < 1 || 11 < (*pp)->unum()
+                      || ! M_opponent_data[(*pp)->unum() - 1].needsCheck() ) )
+            {
+                continue;
+            }
 
             if ( (*pp)->pos().dist2( (*p)->pos() ) < player_collide_dist2 )
             {
@@ -659,6 +693,7 @@ PlayerTypeAnalyzer::checkCollisions()
         Data & data = M_opponent_data[ o->unum() - 1 ];
 
         if ( data.maybe_collide_ ) continue;
+        if ( ! data.needsCheck() ) continue;
 
         for ( const CoachPlayerObject * t : teammates )
         {
@@ -683,6 +718,7 @@ PlayerTypeAnalyzer::checkCollisions()
         Data & data = M_opponent_data[o->unum() - 1];
 
         if ( data.maybe_collide_ ) continue;
+        if ( ! data.needsCheck() ) continue;
 
         Vector2D abs_pos( o->pos().absX(), o->pos().absY() );
         if ( abs_pos.dist2( pole_pos ) < pole_collide_dist2 )
@@ -858,7 +894,11 @@ PlayerTypeAnalyzer::checkKick()
     {
         Data & data = M_opponent_data[kicker_idx];
 
-        if ( data.maybe_collide_ )
+        if ( ! data.needsCheck() )
+        {
+            // no need to reduce the candidates.
+        }
+        else if ( data.maybe_collide_ )
         {
             // cannot determine kick or collide.
 #ifdef DEBUG_PRINT
@@ -871,7 +911,7 @@ PlayerTypeAnalyzer::checkKick()
         {
             const double ball_dist = M_prev_ball.pos().dist( data.pos_ );
 
-            for ( int t = 0; t < max_types; ++t )
+            for ( int t = 0; t < max_types && data.candidate_count_ > 1; ++t )
             {
                 if ( data.invalid_flags_[t] != 0 ) continue;
 
@@ -881,7 +921,7 @@ PlayerTypeAnalyzer::checkKick()
 
                 if ( ball_dist > player_type->kickableArea() + 0.001 )
                 {
-                    data.invalid_flags_[t] = 1;
+                    data.invalidate( t );
 #ifdef DEBUG_PRINT_DETECT_INVALID
                     // std::cout << M_world.ourTeamName() << " coach: " << M_world.time()
                     //           << " opponent " << kicker_idx + 1
@@ -924,6 +964,8 @@ PlayerTypeAnalyzer::checkPlayerDecay()
 
         Data & data = M_opponent_data[p->unum() - 1];
 
+        if ( ! data.needsCheck() ) continue;
+
         // If the player rotates by the two legs dash model,
         // turn and acceleration occur simultaneously.
         // In that case, it is impossible to determine the player type based on the player decay noise
@@ -950,7 +992,7 @@ PlayerTypeAnalyzer::checkPlayerDecay()
         double rand_max = data.vel_.r() * ServerParam::i().playerRand();
         if ( rand_max < 0.00001 ) continue;
 
-        for ( int t = 0; t < max_types; ++t )
+        for ( int t = 0; t < max_types && data.candidate_count_ > 1; ++t )
         {
             if ( data.invalid_flags_[t] != 0 ) continue;
 
@@ -972,7 +1014,7 @@ PlayerTypeAnalyzer::checkPlayerDecay()
             if ( rand_x > rand_max + 0.0000001
                  || rand_y > rand_max + 0.0000001 )
             {
-                data.invalid_flags_[t] = 1;
+                data.invalidate( t );
                 //std::cout << M_world.ourTeamName() << " coach: " << M_world.time()
                 //          << "opponent " << p->unum()
                 //          << "  detect invalid decay. type = "
@@ -987,7 +1029,7 @@ PlayerTypeAnalyzer::checkPlayerDecay()
             const double noise_magnitude = noise_vec.r();
             if ( noise_magnitude > rand_max + 1.0e-10 )
             {
-                data.invalid_flags_[t] = 1;
+                data.invalidate( t );
 #ifdef DEBUG_PRINT_DETECT_INVALID
                 dlog.addText( Logger::ANALYZER,
                               __FILE__" (checkPlayerDecay) opponent=%d type=%d"
@@ -1016,6 +1058,7 @@ PlayerTypeAnalyzer::checkPlayerSpeedMax()
 
         Data & data = M_opponent_data[p->unum() - 1];
 
+        if ( ! data.needsCheck() ) continue;
         if ( data.turned_ ) continue;
         if ( data.kicked_ ) continue;
         if ( data.maybe_referee_ ) continue;
@@ -1030,7 +1073,7 @@ PlayerTypeAnalyzer::checkPlayerSpeedMax()
         const double last_accel_r = last_accel.r();
         const double current_speed = p->vel().r();
 
-        for ( int t = 0; t < max_types; ++t )
+        for ( int t = 0; t < max_types && data.candidate_count_ > 1; ++t )
         {
             if ( data.invalid_flags_[t] != 0 ) continue;
 
@@ -1047,7 +1090,7 @@ PlayerTypeAnalyzer::checkPlayerSpeedMax()
 
             if ( last_accel_r > max_accel + last_max_noise + 1.0e-10 )
             {
-                data.invalid_flags_[t] = 1;
+                data.invalidate( t );
 #ifdef DEBUG_PRINT_DETECT_INVALID
                 std::cout << M_world.ourTeamName() << " coach: " << M_world.time()
                           << " opponent " << p->unum()
@@ -1086,7 +1129,7 @@ PlayerTypeAnalyzer::checkPlayerSpeedMax()
 
             if ( last_move_dist > max_move )
             {
-                data.invalid_flags_[t] = 1;
+                data.invalidate( t );
 #ifdef DEBUG_PRINT_DETECT_INVALID
                 std::cout << M_world.ourTeamName() << " coach: " << M_world.time()
                           << " opponent " << p->unum()
@@ -1122,12 +1165,13 @@ PlayerTypeAnalyzer::checkTurnMoment()
 
         Data & data = M_opponent_data[p->unum() - 1];
 
+        if ( ! data.needsCheck() ) continue;
         if ( ! data.turned_ ) continue;
 
         const double player_speed = data.vel_.r();
         const double turn_angle = ( p->body() - data.body_ ).abs();
 
-        for ( int t = 0; t < max_types; ++t )
+        for ( int t = 0; t < max_types && data.candidate_count_ > 1; ++t )
         {
             if ( data.invalid_flags_[t] != 0 ) continue;
 
@@ -1138,7 +1182,7 @@ PlayerTypeAnalyzer::checkTurnMoment()
 
             if ( turn_angle > max_turn * ( 1.0 + ServerParam::i().playerRand() ) + 1.0001 )
             {
-                data.invalid_flags_[t] = 1;
+                data.invalidate( t );
 #ifdef DEBUG_PRINT_DETECT_INVALID
                 std::cout << M_world.ourTeamName() << " coach: " << M_world.time()
                           << " opponent " << p->unum()
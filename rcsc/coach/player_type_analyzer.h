@@ -65,12 +65,36 @@ private:
 
         //! if invalid data is detected, positive value is set
         std::vector< int > invalid_flags_;
+        int candidate_count_; //!< the number of zero entries in invalid_flags_
 
         int type_; //!< estimated type Id
 
         Data();
         void setDefaultType();
         void setUnknownType();
+        void resizeFlags( const std::size_t size );
+
+        /*!
+          \brief remove the player type from the candidates
+          \param t player type id
+         */
+        void invalidate( const int t )
+          {
+              if ( invalid_flags_[t] == 0 )
+              {
+                  invalid_flags_[t] = 1;
+                  --candidate_count_;
+              }
+          }
+
+        /*!
+          \brief check if the type candidates of this player can be still reduced
+          \return true if the type is unknown and several candidates remain
+         */
+        bool needsCheck() const
+          {
+              return type_ == Hetero_Unknown && candidate_count_ > 1;
+          }
     };
 
     const CoachWorldModel & M_world;
@@ -45,6 +45,43 @@ void
 GradationColorProvider::addColor( const RGBColor & color )
 {
     M_colors.push_back( color );
+
+    if ( ! M_table.empty() )
+    {
+        updateTable();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+GradationColorProvider::setLookupTableSize( const std::size_t size )
+{
+    M_table.clear();
+
+    if ( size >= 2 )
+    {
+        M_table.resize( size );
+        updateTable();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+GradationColorProvider::updateTable()
+{
+    const std::size_t size = M_table.size();
+    const double step = 1.0 / ( size - 1 );
+
+    for ( std::size_t i = 0; i < size; ++i )
+    {
+        M_table[i] = interpolate( step * i );
+    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -53,6 +90,54 @@ GradationColorProvider::addColor( const RGBColor & color )
 */
 RGBColor
 GradationColorProvider::convertToColor( const double value ) const
+{
+    if ( ! M_table.empty() )
+    {
+        const double max_index = M_table.size() - 1;
+        const double index = bound( 0.0, value * max_index + 0.5, max_index );
+        return M_table[ static_cast< std::size_t >( index ) ];
+    }
+
+    return interpolate( value );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+GradationColorProvider::convert( const float * values,
+                                 RGBColor * colors,
+                                 const std::size_t n ) const
+{
+    if ( M_table.empty() )
+    {
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            colors[i] = interpolate( values[i] );
+        }
+        return;
+    }
+
+    const RGBColor * table = M_table.data();
+    const float max_index = static_cast< float >( M_table.size() - 1 );
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        // NaN is mapped to the first color
+        float index = values[i] * max_index + 0.5f;
+        index = ( index > 0.0f ? index : 0.0f );
+        index = ( index < max_index ? index : max_index );
+        colors[i] = table[ static_cast< std::size_t >( index ) ];
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+RGBColor
+GradationColorProvider::interpolate( const double value ) const
 {
     const int n_colors = M_colors.size();
 
@@ -76,7 +161,7 @@ GradationColorProvider::convertToColor( const double value ) const
     //
     const int n_color_range = n_colors - 1;
     const double rate_split_width = 1.0 / n_color_range;
-    const int n = bound( 0, static_cast< int >( value / rate_split_width ), n_color_range );
+    const int n = bound( 0, static_cast< int >( value / rate_split_width ), n_color_range - 1 );
     const double rate = bound( 0.0, ( value - rate_split_width * n ) * n_color_range, 1.0 );
 
     //
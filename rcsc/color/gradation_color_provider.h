@@ -30,6 +30,7 @@
 #include <rcsc/color/rgb_color.h>
 
 #include <vector>
+#include <cstddef>
 
 namespace rcsc {
 
@@ -43,6 +44,9 @@ private:
     //! color set for gradation
     std::vector< RGBColor > M_colors;
 
+    //! precomputed colors of the quantized values. empty if not used.
+    std::vector< RGBColor > M_table;
+
     // not used
     GradationColorProvider( const GradationColorProvider & ) = delete;
     GradationColorProvider & operator=( const GradationColorProvider & ) = delete;
@@ -60,6 +64,20 @@ protected:
      */
     void addColor( const RGBColor & color );
 
+private:
+
+    /*!
+      \brief interpolate the color set without the lookup table
+      \param value value to convert
+      \return blended color
+     */
+    RGBColor interpolate( const double value ) const;
+
+    /*!
+      \brief recompute the lookup table for the current color set
+     */
+    void updateTable();
+
 public:
 
     /*!
@@ -74,6 +92,35 @@ public:
       \return converted color
      */
     RGBColor convertToColor( const double value ) const;
+
+    /*!
+      \brief convert many [0.0, 1.0] values to colors
+      \param values values to convert
+      \param colors pointer to the result array that has n elements
+      \param n the number of values
+     */
+    void convert( const float * values,
+                  RGBColor * colors,
+                  const std::size_t n ) const;
+
+    /*!
+      \brief set the lookup table mode
+      \param size the number of precomputed colors, e.g. 256 or 4096.
+      0 or 1 disables the table, and the colors are interpolated for each value.
+
+      In the table mode, the value is rounded to the nearest multiple of
+      1 / ( size - 1 ), so that the color error is within the half step.
+     */
+    void setLookupTableSize( const std::size_t size );
+
+    /*!
+      \brief get the size of the lookup table
+      \return the number of precomputed colors. 0 if the table is not used.
+     */
+    std::size_t lookupTableSize() const
+      {
+          return M_table.size();
+      }
 };
 
 }
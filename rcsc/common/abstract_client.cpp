@@ -51,7 +51,9 @@ namespace rcsc {
 AbstractClient::AbstractClient()
     : M_server_alive( false ),
       M_interval_msec( 10 ),
-      M_compression_level( 0 )
+      M_compression_level( 0 ),
+      M_received_nsec( 0 ),
+      M_sent_nsec( 0 )
 {
     M_sent_message.reserve( MAX_MESG );
     M_received_message.reserve( MAX_MESG );
@@ -120,9 +122,25 @@ AbstractClient::setCompressionLevel( const int level )
         return old_level;
     }
 
-    M_compressor = std::shared_ptr< GZCompressor >( new GZCompressor( level ) );
+    // keep the allocated z_stream state if the compressor already exists.
+    if ( M_compressor )
+    {
+        M_compressor->setLevel( level );
+        M_compressor->reset();
+    }
+    else
+    {
+        M_compressor = std::shared_ptr< GZCompressor >( new GZCompressor( level ) );
+    }
 
-    M_decompressor = std::shared_ptr< GZDecompressor >( new GZDecompressor() );
+    if ( M_decompressor )
+    {
+        M_decompressor->reset();
+    }
+    else
+    {
+        M_decompressor = std::shared_ptr< GZDecompressor >( new GZDecompressor() );
+    }
 
     return old_level;
 #else
@@ -34,6 +34,7 @@
 
 #include <memory>
 #include <string>
+#include <cstdint>
 
 namespace rcsc {
 
@@ -77,6 +78,12 @@ protected:
     //! received (decompressed) message buffer
     std::string M_received_message;
 
+    //! receive time of the last message [nsec since epoch]. 0 means unknown.
+    std::int64_t M_received_nsec;
+
+    //! send time of the last message [nsec since epoch]. 0 means unknown.
+    std::int64_t M_sent_nsec;
+
 private:
 
     // nocopyable
@@ -146,6 +153,16 @@ public:
     virtual
     void printOfflineThink() = 0;
 
+    /*!
+      \brief check if the client is fast-forwarding the offline log.
+      \return true if the agent may skip its decision.
+     */
+    virtual
+    bool isFastForwarding() const
+      {
+          return false;
+      }
+
     /*!
       \brief set new interval time for select()
       \param interval_msec new interval by milli second
@@ -204,6 +221,25 @@ public:
           return M_received_message.c_str();
       }
 
+    /*!
+      \brief get the receive time of the last message. the kernel timestamp is
+      used if available.
+      \return nanoseconds since the epoch, or 0 if the time is unknown.
+     */
+    std::int64_t receivedNSec() const
+      {
+          return M_received_nsec;
+      }
+
+    /*!
+      \brief get the time when the last message was sent.
+      \return nanoseconds since the epoch, or 0 if the time is unknown.
+     */
+    std::int64_t sentNSec() const
+      {
+          return M_sent_nsec;
+      }
+
 protected:
 
     /*!
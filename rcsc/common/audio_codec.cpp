@@ -104,6 +104,7 @@ const double AudioCodec::ERROR_VALUE = std::numeric_limits< double >::max();
 
 */
 AudioCodec::AudioCodec()
+    : M_char_size( 0 )
 {
     createMap( 0 );
 }
@@ -146,7 +147,10 @@ AudioCodec::createMap( const int shift )
         "0123456789";
 
     const int char_size = static_cast< int >( M_char_set.size() );
+    M_char_size = char_size;
+    M_char_to_int_map.clear();
     M_int_to_char_map.resize( char_size, '0' );
+    std::fill( M_char_to_int_table, M_char_to_int_table + 256, -1 );
 
     int shift_val = shift;
     if ( shift_val < 0 ) shift_val = -shift_val;
@@ -159,6 +163,7 @@ AudioCodec::createMap( const int shift )
         //M_char_to_int_map.insert( std::make_pair( M_char_set[ch_i], i ) );
         M_char_to_int_map[ ch ] = i;
         M_int_to_char_map[i] = ch;
+        M_char_to_int_table[static_cast< unsigned char >( ch )] = static_cast< std::int8_t >( i );
     }
 }
 
@@ -171,48 +176,55 @@ AudioCodec::encodeInt64ToStr( const std::int64_t & ival,
                               const int len,
                               std::string & to ) const
 {
-    std::vector< int > remainder_values;
-    remainder_values.reserve( len );
-
-    std::int64_t divided = ival;
-
-    const int char_size = static_cast< int >( M_char_set.size() );
-
-    for ( int i = 0; i < len - 1; ++i )
+    char buf[32];
+    if ( len <= 0
+         || static_cast< int >( sizeof( buf ) ) < len
+         || ! encodeInt64( ival, len, buf ) )
     {
-        remainder_values.push_back( divided % char_size );
-        divided /= char_size;
+        return false;
     }
 
-    if ( divided >= char_size )
+    to.append( buf, len );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+AudioCodec::encodeInt64( const std::int64_t ival,
+                         const int len,
+                         char * to ) const
+{
+    if ( ival < 0 || len <= 0 )
     {
         std::cerr << __FILE__ << ':' << __LINE__
-                  << " ***ERROR*** AudioCodec::encodeInt64ToStr."
+                  << " ***ERROR*** AudioCodec::encodeInt64."
                   << " Illegal value. "
                   << std::endl;
         return false;
     }
 
-    remainder_values.push_back( divided );
+    std::int64_t divided = ival;
 
-    try
+    for ( int i = len - 1; i > 0; --i )
     {
-        for ( std::vector< int >::reverse_iterator it = remainder_values.rbegin(), end = remainder_values.rend();
-              it != end;
-              ++it )
-        {
-            to += M_int_to_char_map.at( *it );
-        }
+        const std::int64_t q = divided / M_char_size;
+        to[i] = M_int_to_char_map[divided - q * M_char_size];
+        divided = q;
     }
-    catch ( std::exception & e )
+
+    if ( divided >= M_char_size )
     {
         std::cerr << __FILE__ << ':' << __LINE__
-                  << " ***ERROR*** AudioCodec::encodeInt64ToStr."
-                  << " Exception caught: " << e.what()
+                  << " ***ERROR*** AudioCodec::encodeInt64."
+                  << " Illegal value. "
                   << std::endl;
         return false;
     }
 
+    to[0] = M_int_to_char_map[divided];
     return true;
 }
 
@@ -224,35 +236,42 @@ bool
 AudioCodec::decodeStrToInt64( const std::string & from,
                               std::int64_t * to ) const
 {
-    if ( from.empty() )
+    return decodeInt64( from.data(), static_cast< int >( from.length() ), to );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+AudioCodec::decodeInt64( const char * from,
+                         const int len,
+                         std::int64_t * to ) const
+{
+    if ( len <= 0 )
     {
         return false;
     }
 
     std::int64_t rval = 0;
-    int digit_count = from.length() - 1;
-
-    const int char_size = static_cast< int >( M_char_set.length() );
+    int error = 0;
 
-    for ( std::string::const_iterator ch = from.begin(), end = from.end();
-          ch != end;
-          ++ch, --digit_count )
+    // unsupported characters are detected after the loop by the sign bit of the table values.
+    for ( int i = 0; i < len; ++i )
     {
-        CharToIntCont::const_iterator it = M_char_to_int_map.find( *ch );
-        if ( it == M_char_to_int_map.end() )
-        {
-            std::cerr << __FILE__ << ": " << __LINE__
-                      << " ***ERROR*** AudioCodec::decodeStrToInt64."
-                      << " Unexpected communication message. ["
-                      << from << "]"
-                      << std::endl;
-            return false;
-        }
+        const int val = charToInt( from[i] );
+        error |= val;
+        rval = rval * M_char_size + val;
+    }
 
-        rval
-            += static_cast< std::int64_t >( it->second )
-            * static_cast< std::int64_t >
-            ( std::pow( static_cast< double >( char_size ), digit_count ) );
+    if ( error < 0 )
+    {
+        std::cerr << __FILE__ << ": " << __LINE__
+                  << " ***ERROR*** AudioCodec::decodeInt64."
+                  << " Unexpected communication message. ["
+                  << std::string( from, len ) << "]"
+                  << std::endl;
+        return false;
     }
 
     if ( to )
@@ -266,6 +285,51 @@ AudioCodec::decodeStrToInt64( const std::string & from,
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+int
+AudioCodec::encodeFields( const std::int64_t * values,
+                          const int * widths,
+                          const int n,
+                          char * to ) const
+{
+    int len = 0;
+    for ( int i = 0; i < n; ++i )
+    {
+        if ( ! encodeInt64( values[i], widths[i], to + len ) )
+        {
+            return -1;
+        }
+        len += widths[i];
+    }
+
+    return len;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+AudioCodec::decodeFields( const char * from,
+                          const int * widths,
+                          const int n,
+                          std::int64_t * values ) const
+{
+    for ( int i = 0; i < n; ++i )
+    {
+        if ( ! decodeInt64( from, widths[i], values + i ) )
+        {
+            return false;
+        }
+        from += widths[i];
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 char
 AudioCodec::encodePercentageToChar( const double & value ) const
@@ -278,11 +342,9 @@ AudioCodec::encodePercentageToChar( const double & value ) const
         return '\0';
     }
 
-    const int char_size = static_cast< int >( M_char_set.length() );
-
-    int ival = static_cast< int >( rint( value * ( char_size - 1 ) ) * 10000.0 );
+    int ival = static_cast< int >( rint( value * ( M_char_size - 1 ) ) * 10000.0 );
     ival /= 10000;
-    if ( ival >= char_size )
+    if ( ival >= M_char_size )
     {
         std::cerr << __FILE__ << ':' << __LINE__
                   << " ***ERROR*** generated illegal index = "
@@ -290,18 +352,7 @@ AudioCodec::encodePercentageToChar( const double & value ) const
         return '\0';
     }
 
-    try
-    {
-        return  intToCharMap().at( ival );
-    }
-    catch ( ... )
-    {
-        std::cerr << __FILE__ << ": " << __LINE__
-                  << " ***ERROR*** AudioCodec::encodePercentageToChar."
-                  << " Exception caught! Failed to encode"
-                  << std::endl;
-        return '\0';
-    }
+    return intToChar( ival );
 }
 
 /*-------------------------------------------------------------------*/
@@ -311,8 +362,8 @@ AudioCodec::encodePercentageToChar( const double & value ) const
 double
 AudioCodec::decodeCharToPercentage( const char ch ) const
 {
-    CharToIntCont::const_iterator it = charToIntMap().find( ch );
-    if ( it == charToIntMap().end() )
+    const int val = charToInt( ch );
+    if ( val < 0 )
     {
         std::cerr << __FILE__ << ": " << __LINE__
                   << " ***ERROR*** AudioCodec::decodeCharToPercentage."
@@ -321,10 +372,8 @@ AudioCodec::decodeCharToPercentage( const char ch ) const
         return ERROR_VALUE;
     }
 
-    const int char_size = static_cast< int >( M_char_set.length() );
-
-    return ( static_cast< double >( it->second )
-             / static_cast< double >( char_size - 1 ) );
+    return ( static_cast< double >( val )
+             / static_cast< double >( M_char_size - 1 ) );
 }
 
 /*-------------------------------------------------------------------*/
@@ -538,12 +587,28 @@ AudioCodec::encodePosVelToStr5( const Vector2D & pos,
                                 const Vector2D & vel,
                                 std::string & to ) const
 {
-    std::int64_t ival = posVelToBit31( pos, vel );
+    char buf[5];
+    if ( ! encodePosVelToStr5( pos, vel, buf ) )
+    {
+        return false;
+    }
+
+    to.append( buf, 5 );
+    return true;
+}
 
-    //std::cout << " ival dec = "<< std::dec << ival << std::endl;
-    //std::cout << " ival hex = "<< std::hex << ival << std::endl;
+/*-------------------------------------------------------------------*/
+/*!
 
-    return encodeInt64ToStr( ival, 5, to );
+*/
+bool
+AudioCodec::encodePosVelToStr5( const Vector2D & pos,
+                                const Vector2D & vel,
+                                char * to ) const
+{
+    std::int64_t ival = posVelToBit31( pos, vel );
+
+    return encodeInt64( ival, 5, to );
 }
 
 /*-------------------------------------------------------------------*/
@@ -560,9 +625,21 @@ AudioCodec::decodeStr5ToPosVel( const std::string & from,
         return false;
     }
 
+    return decodeStr5ToPosVel( from.data(), pos, vel );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+AudioCodec::decodeStr5ToPosVel( const char * from,
+                                Vector2D * pos,
+                                Vector2D * vel ) const
+{
     std::int64_t read_val = 0;
 
-    if ( ! decodeStrToInt64( from, &read_val ) )
+    if ( ! decodeInt64( from, 5, &read_val ) )
     {
         return false;
     }
@@ -580,11 +657,29 @@ AudioCodec::decodeStr5ToPosVel( const std::string & from,
 bool
 AudioCodec::encodePosToStr3( const Vector2D & pos,
                              std::string & to ) const
+{
+    char buf[3];
+    if ( ! encodePosToStr3( pos, buf ) )
+    {
+        return false;
+    }
+
+    to.append( buf, 3 );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+AudioCodec::encodePosToStr3( const Vector2D & pos,
+                             char * to ) const
 {
     std::int32_t ival = posToBit18( pos );
 
-    return encodeInt64ToStr( static_cast< std::int64_t >( ival ),
-                             3, to );
+    return encodeInt64( static_cast< std::int64_t >( ival ),
+                        3, to );
 }
 
 /*-------------------------------------------------------------------*/
@@ -600,9 +695,20 @@ AudioCodec::decodeStr3ToPos( const std::string & from,
         return false;
     }
 
+    return decodeStr3ToPos( from.data(), pos );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+AudioCodec::decodeStr3ToPos( const char * from,
+                             Vector2D * pos ) const
+{
     std::int64_t read_val = 0;
 
-    if ( ! decodeStrToInt64( from, &read_val ) )
+    if ( ! decodeInt64( from, 3, &read_val ) )
     {
         return false;
     }
@@ -623,6 +729,25 @@ bool
 AudioCodec::encodeUnumPosToStr4( const int unum,
                                  const Vector2D & pos,
                                  std::string & to ) const
+{
+    char buf[4];
+    if ( ! encodeUnumPosToStr4( unum, pos, buf ) )
+    {
+        return false;
+    }
+
+    to.append( buf, 4 );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+AudioCodec::encodeUnumPosToStr4( const int unum,
+                                 const Vector2D & pos,
+                                 char * to ) const
 {
     if ( unum < 1 || 11 < unum )
     {
@@ -634,7 +759,7 @@ AudioCodec::encodeUnumPosToStr4( const int unum,
     ival <<= 4;
     ival |= static_cast< std::int64_t >( unum ); // 4 bits
 
-    return encodeInt64ToStr( ival, 4, to );
+    return encodeInt64( ival, 4, to );
 }
 
 /*-------------------------------------------------------------------*/
@@ -651,9 +776,21 @@ AudioCodec::decodeStr4ToUnumPos( const std::string & from,
         return false;
     }
 
+    return decodeStr4ToUnumPos( from.data(), unum, pos );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+AudioCodec::decodeStr4ToUnumPos( const char * from,
+                                 int * unum,
+                                 Vector2D * pos ) const
+{
     std::int64_t read_val = 0;
 
-    if ( ! decodeStrToInt64( from, &read_val ) )
+    if ( ! decodeInt64( from, 4, &read_val ) )
     {
         return false;
     }
@@ -681,7 +818,7 @@ std::string
 AudioCodec::encodeCoordToStr2( const double & xy,
                                const double & norm_factor ) const
 {
-    const int char_size = static_cast< int >( M_char_set.length() );
+    const int char_size = M_char_size;
 
     // normalize value
     double tmp = min_max( -norm_factor, xy , norm_factor );
@@ -707,24 +844,9 @@ AudioCodec::encodeCoordToStr2( const double & xy,
         return std::string();
     }
 
-    std::string msg;
-    msg.reserve( 2 );
-
-    try
-    {
-        msg += intToCharMap().at( i1 );
-        msg += intToCharMap().at( i2 );
-    }
-    catch ( ... )
-    {
-        std::cerr << __FILE__ << ": " << __LINE__
-                  << " ***ERROR*** AudioCodec::encodeCoordToStr2."
-                  << " Exception caught! "
-                  << std::endl;
-        return std::string();
-    }
+    const char msg[2] = { M_int_to_char_map[i1], M_int_to_char_map[i2] };
 
-    return msg;
+    return std::string( msg, 2 );
 }
 
 /*-------------------------------------------------------------------*/
@@ -736,10 +858,8 @@ AudioCodec::decodeStr2ToCoord( const char ch1,
                                const char ch2,
                                const double & norm_factor ) const
 {
-    const CharToIntCont::const_iterator end = charToIntMap().end();
-
-    CharToIntCont::const_iterator it = charToIntMap().find( ch1 );
-    if ( it == end )
+    const int i1 = charToInt( ch1 );
+    if ( i1 < 0 )
     {
         std::cerr << __FILE__ << ": " << __LINE__
                   << " ***ERROR*** AudioCodec::decodeStr2ToCoord()."
@@ -747,10 +867,9 @@ AudioCodec::decodeStr2ToCoord( const char ch1,
                   << std::endl;
         return ERROR_VALUE;
     }
-    int i1 = it->second;
 
-    it = charToIntMap().find( ch2 );
-    if ( it == end )
+    const int i2 = charToInt( ch2 );
+    if ( i2 < 0 )
     {
         std::cerr << __FILE__ << ": " << __LINE__
                   << " ***ERROR*** AudioCodec::decodeStr2ToCoord()."
@@ -758,13 +877,10 @@ AudioCodec::decodeStr2ToCoord( const char ch1,
                   << std::endl;
         return ERROR_VALUE;
     }
-    int i2 = it->second;
-
-    const int char_size = static_cast< int >( M_char_set.length() );
 
     return
         (
-         static_cast< double >( i1 + i2 * char_size ) * COORD_STEP_L2
+         static_cast< double >( i1 + i2 * M_char_size ) * COORD_STEP_L2
          - norm_factor
          );
 }
@@ -847,20 +963,16 @@ AudioCodec::encodeSpeedToChar( const double & val ) const
 
     int ival = static_cast< int >( rint( tmp ) );
 
-    try
-    {
-        return  intToCharMap().at( ival );
-    }
-    catch ( ... )
+    const char ch = intToChar( ival );
+    if ( ch == '\0' )
     {
         std::cerr << __FILE__ << ": " << __LINE__
                   << " ***ERROR*** AudioCodec::encodeSpeedL1."
-                  << " Exception caught! Failed to encode"
+                  << " Failed to encode"
                   << std::endl;
-        return '\0';
     }
 
-    return '\0';
+    return ch;
 }
 
 /*-------------------------------------------------------------------*/
@@ -870,8 +982,8 @@ AudioCodec::encodeSpeedToChar( const double & val ) const
 double
 AudioCodec::decodeCharToSpeed( const char ch ) const
 {
-    CharToIntCont::const_iterator it = charToIntMap().find( ch );
-    if ( it == charToIntMap().end() )
+    const int val = charToInt( ch );
+    if ( val < 0 )
     {
         std::cerr << __FILE__ << ": " << __LINE__
                   << " ***ERROR*** AudioCodec::decodeSpeedL1."
@@ -881,7 +993,7 @@ AudioCodec::decodeCharToSpeed( const char ch ) const
     }
 
     return
-        ( static_cast< double >( it->second ) * SPEED_STEP_L1
+        ( static_cast< double >( val ) * SPEED_STEP_L1
           - SPEED_NORM_FACTOR
           );
 }
@@ -58,12 +58,18 @@ private:
 
     std::string M_char_set;
 
+    //! the number of characters in the character set
+    int M_char_size;
+
     //! map to cnvert character to integer. key: char, value int
     CharToIntCont M_char_to_int_map;
 
     //! map to cnvert integer to character. vector of char
     IntToCharCont M_int_to_char_map;
 
+    //! table to convert character to integer. indexed by unsigned char, -1 if not supported.
+    std::int8_t M_char_to_int_table[256];
+
     /*!
       \brief private for singleton. create convert map.
     */
@@ -156,6 +162,87 @@ public:
           return M_int_to_char_map;
       }
 
+    /*!
+      \brief get the number of characters used as the digits of the encoded value
+      \return the base number of the encoded value
+    */
+    int charSize() const
+      {
+          return M_char_size;
+      }
+
+    /*!
+      \brief convert character to integer by the decode table
+      \param ch character to be converted
+      \return converted integer. if ch is not supported, -1 is returned.
+    */
+    int charToInt( const char ch ) const
+      {
+          return M_char_to_int_table[static_cast< unsigned char >( ch )];
+      }
+
+    /*!
+      \brief convert integer to character
+      \param val integer value to be converted
+      \return converted character. if val is out of range, the null character is returned.
+    */
+    char intToChar( const int val ) const
+      {
+          return ( 0 <= val && val < M_char_size
+                   ? M_int_to_char_map[val]
+                   : '\0' );
+      }
+
+    /*!
+      \brief encode decimal (64bit) integer to the fixed width characters
+      \param ival input value
+      \param len number of characters to be written
+      \param to pointer to the caller supplied buffer. at least len characters.
+      \return true if ival is representable by len characters.
+
+      The buffer is not null terminated. If this method fails, the buffer content is undefined.
+     */
+    bool encodeInt64( const std::int64_t ival,
+                      const int len,
+                      char * to ) const;
+
+    /*!
+      \brief decode the fixed width characters to the decimal (64bit) integer
+      \param from pointer to the first character
+      \param len number of characters to be decoded
+      \param to pointer to the result variable. NULL is allowed.
+      \return true if all characters are supported.
+     */
+    bool decodeInt64( const char * from,
+                      const int len,
+                      std::int64_t * to ) const;
+
+    /*!
+      \brief encode several values into the fixed width fields at once
+      \param values array of values
+      \param widths array of the field widths
+      \param n number of fields
+      \param to pointer to the caller supplied buffer. at least the sum of widths.
+      \return total number of written characters, or -1 if some value is out of range.
+     */
+    int encodeFields( const std::int64_t * values,
+                      const int * widths,
+                      const int n,
+                      char * to ) const;
+
+    /*!
+      \brief decode several fixed width fields at once
+      \param from pointer to the first character
+      \param widths array of the field widths
+      \param n number of fields
+      \param values array to store the decoded values. at least n elements.
+      \return true if all characters are supported.
+     */
+    bool decodeFields( const char * from,
+                       const int * widths,
+                       const int n,
+                       std::int64_t * values ) const;
+
     /*!
       \brief encode decimal (64bit) integer to the encoded string.
       \param ival input value
@@ -206,6 +293,17 @@ public:
                              const Vector2D & vel,
                              std::string & to ) const;
 
+    /*!
+      \brief encode position and velocity to 5 characters in the caller supplied buffer.
+      \param pos position value to be encoded
+      \param vel velocity value to be encoded
+      \param to pointer to the buffer. at least 5 characters. not null terminated.
+      \return encode status
+    */
+    bool encodePosVelToStr5( const Vector2D & pos,
+                             const Vector2D & vel,
+                             char * to ) const;
+
     /*!
       \brief decode 5 characters to position and velocity
       \param from string to be decoded
@@ -219,6 +317,17 @@ public:
                              Vector2D * pos,
                              Vector2D * vel ) const;
 
+    /*!
+      \brief decode 5 characters to position and velocity
+      \param from pointer to the first character. at least 5 characters must be readable.
+      \param pos variable pointer to store the decoded position value
+      \param vel variable pointer to store the decoded velocity value
+      \return true if successfully decoded
+    */
+    bool decodeStr5ToPosVel( const char * from,
+                             Vector2D * pos,
+                             Vector2D * vel ) const;
+
     /*!
       \brief encode position to 3 characters.
       \param pos position value to be encoded
@@ -230,6 +339,15 @@ public:
     bool encodePosToStr3( const Vector2D & pos,
                           std::string & to ) const;
 
+    /*!
+      \brief encode position to 3 characters in the caller supplied buffer.
+      \param pos position value to be encoded
+      \param to pointer to the buffer. at least 3 characters. not null terminated.
+      \return encode status
+    */
+    bool encodePosToStr3( const Vector2D & pos,
+                          char * to ) const;
+
     /*!
       \brief decode 3 characters to and position
       \param from string to be decoded
@@ -241,6 +359,15 @@ public:
     bool decodeStr3ToPos( const std::string & from,
                           Vector2D * pos ) const;
 
+    /*!
+      \brief decode 3 characters to position
+      \param from pointer to the first character. at least 3 characters must be readable.
+      \param pos pointer to the result variable
+      \return true if successfully decoded
+    */
+    bool decodeStr3ToPos( const char * from,
+                          Vector2D * pos ) const;
+
 
     /*!
       \brief encode uniform number and position to 4 characters.
@@ -255,6 +382,17 @@ public:
                               const Vector2D & pos,
                               std::string & to ) const;
 
+    /*!
+      \brief encode uniform number and position to 4 characters in the caller supplied buffer.
+      \param unum uniform number
+      \param pos position value to be encoded
+      \param to pointer to the buffer. at least 4 characters. not null terminated.
+      \return encode status
+    */
+    bool encodeUnumPosToStr4( const int unum,
+                              const Vector2D & pos,
+                              char * to ) const;
+
     /*!
       \brief decode 4 characters to uniform number and position
       \param from string to be decoded
@@ -268,6 +406,17 @@ public:
                               int * unum,
                               Vector2D * pos ) const;
 
+    /*!
+      \brief decode 4 characters to uniform number and position
+      \param from pointer to the first character. at least 4 characters must be readable.
+      \param unum pointer to the result variable
+      \param pos pointer to the result variable
+      \return true if successfully decoded
+    */
+    bool decodeStr4ToUnumPos( const char * from,
+                              int * unum,
+                              Vector2D * pos ) const;
+
     /*!
       \brief encode coordinate value( x or y ) to 2 characters.
       \param xy coordinate value to be encoded, X or Y.
@@ -37,14 +37,19 @@
 
 #include <rcsc/common/logger.h>
 #include <rcsc/types.h>
+#include <rcsc/util/memory_accounting.h>
+
+#include <algorithm>
 
 namespace rcsc {
 
+constexpr std::size_t AudioMemory::DEFAULT_HISTORY_SIZE;
+
 /*-------------------------------------------------------------------*/
 /*!
 
 */
-AudioMemory::AudioMemory()
+AudioMemory::AudioMemory( const std::size_t history_size )
     : M_time( -1, 0 ),
       M_ball_time( -1, 0 ),
       M_pass_time( -1, 0 ),
@@ -61,9 +66,102 @@ AudioMemory::AudioMemory()
       M_stamina_time( -1, 0 ),
       M_recovery_time( -1, 0 ),
       M_dribble_time( -1, 0 ),
-      M_free_message_time( -1, 0 )
+      M_free_message_time( -1, 0 ),
+      M_history( std::max( history_size, std::size_t( 1 ) ) ),
+      M_history_head( 0 ),
+      M_history_count( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::size_t
+AudioMemory::memoryUsage() const
+{
+    std::size_t bytes = vector_memory_usage( M_ball )
+        + vector_memory_usage( M_pass )
+        + vector_memory_usage( M_our_intercept )
+        + vector_memory_usage( M_opp_intercept )
+        + vector_memory_usage( M_goalie )
+        + vector_memory_usage( M_player )
+        + vector_memory_usage( M_offside_line )
+        + vector_memory_usage( M_defense_line )
+        + vector_memory_usage( M_wait_request )
+        + vector_memory_usage( M_setplay )
+        + vector_memory_usage( M_pass_request )
+        + vector_memory_usage( M_run_request )
+        + vector_memory_usage( M_stamina )
+        + vector_memory_usage( M_recovery )
+        + vector_memory_usage( M_stamina_capacity )
+        + vector_memory_usage( M_dribble )
+        + vector_memory_usage( M_free_message )
+        + M_player_record.size() * sizeof( PlayerRecord::value_type )
+        + vector_memory_usage( M_history );
+
+    for ( const FreeMessage & m : M_free_message )
+    {
+        bytes += m.message_.capacity();
+    }
+
+    return bytes;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const AudioMemory::CycleRecord *
+AudioMemory::findRecord( const GameTime & t ) const
+{
+    for ( std::size_t i = 0; i < M_history_count; ++i )
+    {
+        const CycleRecord & r = history( i );
+        if ( r.time_ == t )
+        {
+            return &r;
+        }
+
+        if ( r.time_ < t )
+        {
+            break;
+        }
+    }
+
+    return nullptr;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+AudioMemory::updateRecord( const HeardType type,
+                           const int sender,
+                           const GameTime & current )
 {
+    if ( M_history_count == 0
+         || M_history[M_history_head].time_ != current )
+    {
+        M_history_head = ( M_history_head + 1 ) % M_history.size();
+        if ( M_history_count < M_history.size() )
+        {
+            ++M_history_count;
+        }
 
+        CycleRecord & r = M_history[M_history_head];
+        r.time_ = current;
+        r.types_ = 0;
+        r.senders_ = 0;
+    }
+
+    CycleRecord & r = M_history[M_history_head];
+    r.types_ |= mask( type );
+    r.senders_ |= ( 1 <= sender && sender <= 31
+                    ? std::uint32_t( 1 ) << sender
+                    : std::uint32_t( 1 ) );
 }
 
 /*-------------------------------------------------------------------*/
@@ -89,6 +187,7 @@ AudioMemory::setBall( const int sender,
 
     M_ball.emplace_back( sender, pos, vel );
     M_ball_time = current;
+    updateRecord( HEARD_BALL, sender, current );
 
     M_time = current;
 }
@@ -117,6 +216,7 @@ AudioMemory::setPass( const int sender,
 
     M_pass.emplace_back( sender, receiver, pos );
     M_pass_time = current;
+    updateRecord( HEARD_PASS, sender, current );
 
     M_time = current;
 }
@@ -147,6 +247,7 @@ AudioMemory::setIntercept( const int sender,
         // -1 because the heard value was estimated in the previous cycle
         M_our_intercept.emplace_back( sender, interceptor, std::max( 0, cycle - 1 ) );
         M_our_intercept_time = current;
+        updateRecord( HEARD_OUR_INTERCEPT, sender, current );
     }
     else
     {
@@ -164,6 +265,7 @@ AudioMemory::setIntercept( const int sender,
         // -1 because the heard value was estimated in the previous cycle
         M_opp_intercept.emplace_back( sender, interceptor - MAX_PLAYER, std::max( 0, cycle - 1 ) );
         M_opp_intercept_time = current;
+        updateRecord( HEARD_OPP_INTERCEPT, sender, current );
     }
 
     M_time = current;
@@ -192,6 +294,7 @@ AudioMemory::setOpponentGoalie( const int sender,
 
     M_goalie.emplace_back( sender, pos, body );
     M_goalie_time = current;
+    updateRecord( HEARD_GOALIE, sender, current );
 
     M_time = current;
 }
@@ -218,6 +321,7 @@ AudioMemory::setPlayer( const int sender,
 
     M_player.emplace_back( sender, unum, pos );
     M_player_time = current;
+    updateRecord( HEARD_PLAYER, sender, current );
 
     M_time = current;
 
@@ -252,6 +356,7 @@ AudioMemory::setPlayer( const int sender,
 
     M_player.emplace_back( sender, unum, pos, body, stamina );
     M_player_time = current;
+    updateRecord( HEARD_PLAYER, sender, current );
 
     M_time = current;
 
@@ -283,6 +388,7 @@ AudioMemory::setOffsideLine( const int sender,
 
     M_offside_line.emplace_back( sender, offside_line_x );
     M_offside_line_time = current;
+    updateRecord( HEARD_OFFSIDE_LINE, sender, current );
 
     M_time = current;
 }
@@ -307,6 +413,7 @@ AudioMemory::setDefenseLine( const int sender,
 
     M_defense_line.emplace_back( sender, defense_line_x );
     M_defense_line_time = current;
+    updateRecord( HEARD_DEFENSE_LINE, sender, current );
 
     M_time = current;
 }
@@ -330,6 +437,7 @@ AudioMemory::setWaitRequest( const int sender,
 
     M_wait_request.emplace_back( sender );
     M_wait_request_time = current;
+    updateRecord( HEARD_WAIT_REQUEST, sender, current );
 
     M_time = current;
 }
@@ -356,6 +464,7 @@ AudioMemory::setSetplay( const int sender,
 
     M_setplay.emplace_back( sender, wait_step );
     M_setplay_time = current;
+    updateRecord( HEARD_SETPLAY, sender, current );
 
     M_time = current;
 }
@@ -380,6 +489,7 @@ AudioMemory::setPassRequest( const int sender,
 
     M_pass_request.emplace_back( sender, request_pos );
     M_pass_request_time = current;
+    updateRecord( HEARD_PASS_REQUEST, sender, current );
 
     M_time = current;
 }
@@ -406,6 +516,7 @@ AudioMemory::setRunRequest( const int sender,
 
     M_run_request.emplace_back( sender, runner, request_pos );
     M_run_request_time = current;
+    updateRecord( HEARD_RUN_REQUEST, sender, current );
 
     M_time = current;
 }
@@ -430,6 +541,7 @@ AudioMemory::setStamina( const int sender,
 
     M_stamina.emplace_back( sender, rate );
     M_stamina_time = current;
+    updateRecord( HEARD_STAMINA, sender, current );
 
     M_time = current;
 }
@@ -454,6 +566,7 @@ AudioMemory::setRecovery( const int sender,
 
     M_recovery.emplace_back( sender, rate );
     M_recovery_time = current;
+    updateRecord( HEARD_RECOVERY, sender, current );
 
     M_time = current;
 }
@@ -478,6 +591,7 @@ AudioMemory::setStaminaCapacity( const int sender,
 
     M_stamina_capacity.emplace_back( sender, rate );
     M_stamina_capacity_time = current;
+    updateRecord( HEARD_STAMINA_CAPACITY, sender, current );
 
     M_time = current;
 }
@@ -506,6 +620,7 @@ AudioMemory::setDribbleTarget( const int sender,
 
     M_dribble.emplace_back( sender, pos, queue_count );
     M_dribble_time = current;
+    updateRecord( HEARD_DRIBBLE, sender, current );
 
     M_time = current;
 }
@@ -534,6 +649,7 @@ AudioMemory::setFreeMessage( const int sender,
 
     M_free_message.emplace_back( sender, msg );
     M_free_message_time = current;
+    updateRecord( HEARD_FREE_MESSAGE, sender, current );
 
     M_time = current;
 }
@@ -549,6 +665,11 @@ AudioMemory::printDebug( std::ostream & os ) const
     // TODO: reimplemented using virtual method.
     //
 
+    if ( heardMask() == 0 )
+    {
+        return os;
+    }
+
     if ( time() == ballTime() )
     {
         for ( const Ball & b : ball() )
@@ -39,6 +39,7 @@
 #include <string>
 #include <vector>
 #include <deque>
+#include <cstdint>
 
 namespace rcsc {
 
@@ -49,6 +50,67 @@ namespace rcsc {
 class AudioMemory {
 public:
 
+    /*!
+      \enum HeardType
+      \brief bit index of each heard info type
+     */
+    enum HeardType {
+        HEARD_BALL = 0,
+        HEARD_PASS,
+        HEARD_OUR_INTERCEPT,
+        HEARD_OPP_INTERCEPT,
+        HEARD_GOALIE,
+        HEARD_PLAYER,
+        HEARD_OFFSIDE_LINE,
+        HEARD_DEFENSE_LINE,
+        HEARD_WAIT_REQUEST,
+        HEARD_SETPLAY,
+        HEARD_PASS_REQUEST,
+        HEARD_RUN_REQUEST,
+        HEARD_STAMINA,
+        HEARD_RECOVERY,
+        HEARD_STAMINA_CAPACITY,
+        HEARD_DRIBBLE,
+        HEARD_FREE_MESSAGE,
+        HEARD_TYPE_SIZE
+    };
+
+    //! bit set of HeardType values
+    typedef std::uint32_t HeardMask;
+
+    //! default number of cycles kept in the heard history
+    static constexpr std::size_t DEFAULT_HISTORY_SIZE = 32;
+
+    /*!
+      \struct CycleRecord
+      \brief summary of the messages heard in one cycle
+     */
+    struct CycleRecord {
+        GameTime time_; //!< heard time
+        HeardMask types_; //!< bit set of the heard types
+        std::uint32_t senders_; //!< bit set of the sender numbers. bit 0 means unknown sender.
+
+        /*!
+          \brief initialize all member
+         */
+        CycleRecord()
+            : time_( -1, 0 ),
+              types_( 0 ),
+              senders_( 0 )
+          { }
+    };
+
+    /*!
+      \brief get the mask bit of the heard type
+      \param type heard type
+      \return mask value
+     */
+    static constexpr
+    HeardMask mask( const HeardType type )
+      {
+          return HeardMask( 1 ) << type;
+      }
+
     /*!
       \struct Ball
       \brief heard ball info
@@ -446,6 +508,11 @@ protected:
     //! memory of heared players
     PlayerRecord M_player_record;
 
+    //! per cycle heard summary. the storage is allocated only in the constructor.
+    std::vector< CycleRecord > M_history;
+    std::size_t M_history_head; //!< index of the newest record
+    std::size_t M_history_count; //!< number of valid records
+
 
 private:
     // not used
@@ -456,8 +523,10 @@ public:
 
     /*!
       \brief initialize member variables
+      \param history_size number of cycles kept in the heard history
     */
-    AudioMemory();
+    explicit
+    AudioMemory( const std::size_t history_size = DEFAULT_HISTORY_SIZE );
 
     /*!
       \brief virtual destructor
@@ -465,6 +534,12 @@ public:
     virtual
     ~AudioMemory() = default;
 
+    /*!
+      \brief get the heap bytes held by the heard info and the history
+      \return bytes
+    */
+    std::size_t memoryUsage() const;
+
     // accessor methods
 
     const GameTime & time() const
@@ -472,6 +547,87 @@ public:
           return M_time;
       }
 
+    /*!
+      \brief get the heard types in the last heard cycle
+      \return bit set of HeardType. use with time() to check the cycle.
+     */
+    HeardMask heardMask() const
+      {
+          return ( M_history_count == 0
+                   ? HeardMask( 0 )
+                   : M_history[M_history_head].types_ );
+      }
+
+    /*!
+      \brief get the heard types at the given cycle
+      \param t target time
+      \return bit set of HeardType. 0 if nothing was heard or the cycle is out of the history.
+     */
+    HeardMask heardMask( const GameTime & t ) const
+      {
+          const CycleRecord * r = findRecord( t );
+          return r ? r->types_ : HeardMask( 0 );
+      }
+
+    /*!
+      \brief check if any of the given types was heard at the given cycle
+      \param types bit set of HeardType
+      \param t target time
+      \return checked result
+     */
+    bool heardAny( const HeardMask types,
+                   const GameTime & t ) const
+      {
+          return ( heardMask( t ) & types ) != 0;
+      }
+
+    /*!
+      \brief check if the given type was heard at the given cycle
+      \param type heard type
+      \param t target time
+      \return checked result
+     */
+    bool heard( const HeardType type,
+                const GameTime & t ) const
+      {
+          return heardAny( mask( type ), t );
+      }
+
+    /*!
+      \brief get the capacity of the heard history
+      \return the number of cycles that can be kept
+     */
+    std::size_t historyCapacity() const
+      {
+          return M_history.size();
+      }
+
+    /*!
+      \brief get the number of valid records in the heard history
+      \return the number of records
+     */
+    std::size_t historySize() const
+      {
+          return M_history_count;
+      }
+
+    /*!
+      \brief get the record in the heard history
+      \param i index from the newest record. must be less than historySize().
+      \return const reference to the record
+     */
+    const CycleRecord & history( const std::size_t i ) const
+      {
+          return M_history[( M_history_head + M_history.size() - i ) % M_history.size()];
+      }
+
+    /*!
+      \brief find the record of the given cycle
+      \param t target time
+      \return const pointer to the record. nullptr if not found.
+     */
+    const CycleRecord * findRecord( const GameTime & t ) const;
+
     /*!
       \brief get heard ball info
       \return ball info container
@@ -994,6 +1150,18 @@ public:
 
     virtual
     std::ostream & printDebug( std::ostream & os ) const;
+
+protected:
+
+    /*!
+      \brief register the heard type to the record of the current cycle
+      \param type heard type
+      \param sender message sender's uniform number
+      \param current current game time
+     */
+    void updateRecord( const HeardType type,
+                       const int sender,
+                       const GameTime & current );
 };
 
 }
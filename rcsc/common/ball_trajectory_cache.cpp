@@ -0,0 +1,230 @@
+// -*-c++-*-
+
+/*!
+  \file ball_trajectory_cache.cpp
+  \brief predicted ball trajectory shared by the intercept predictors Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "ball_trajectory_cache.h"
+
+#include <rcsc/common/server_param.h>
+#include <rcsc/soccer_math.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace rcsc {
+
+constexpr int BallTrajectoryCache::MAX_STEP;
+constexpr double BallTrajectoryCache::STOP_SPEED;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+BallTrajectoryCache::BallTrajectoryCache()
+    : M_time( -1, 0 ),
+      M_vel( 0.0, 0.0 ),
+      M_speed( 0.0 ),
+      M_decay( -1.0 ),
+      M_stop_step( 0 ),
+      M_out_step( MAX_STEP + 1 )
+{
+    std::fill( M_x, M_x + MAX_STEP + 1, 0.0 );
+    std::fill( M_y, M_y + MAX_STEP + 1, 0.0 );
+    std::fill( M_decay_pow, M_decay_pow + MAX_STEP + 1, 0.0 );
+    std::fill( M_travel_rate, M_travel_rate + MAX_STEP + 1, 0.0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+BallTrajectoryCache::BallTrajectoryCache( const Vector2D & pos,
+                                          const Vector2D & vel )
+    : M_time( -1, 0 ),
+      M_decay( -1.0 )
+{
+    update( M_time, pos, vel );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+BallTrajectoryCache::updateTable( const double decay )
+{
+    if ( decay == M_decay )
+    {
+        return;
+    }
+
+    M_decay = decay;
+
+    // use std::pow() for each step to get the same value as inertia_n_step_point().
+    for ( int i = 0; i <= MAX_STEP; ++i )
+    {
+        M_decay_pow[i] = std::pow( decay, i );
+        M_travel_rate[i] = ( 1.0 - M_decay_pow[i] ) / ( 1.0 - decay );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+BallTrajectoryCache::update( const GameTime & current,
+                             const Vector2D & pos,
+                             const Vector2D & vel )
+{
+    const ServerParam & SP = ServerParam::i();
+
+    updateTable( SP.ballDecay() );
+
+    M_time = current;
+    M_vel = vel;
+    M_speed = vel.r();
+
+    const double px = pos.x;
+    const double py = pos.y;
+    const double vx = vel.x;
+    const double vy = vel.y;
+
+    for ( int i = 0; i <= MAX_STEP; ++i )
+    {
+        M_x[i] = px + vx * M_travel_rate[i];
+        M_y[i] = py + vy * M_travel_rate[i];
+    }
+
+    M_stop_step = MAX_STEP + 1;
+    for ( int i = 0; i <= MAX_STEP; ++i )
+    {
+        if ( M_speed * M_decay_pow[i] < STOP_SPEED )
+        {
+            M_stop_step = i;
+            break;
+        }
+    }
+
+    const double max_x = ( SP.keepawayMode()
+                           ? SP.keepawayLength() * 0.5
+                           : SP.pitchHalfLength() + 5.0 );
+    const double max_y = ( SP.keepawayMode()
+                           ? SP.keepawayWidth() * 0.5
+                           : SP.pitchHalfWidth() + 5.0 );
+
+    M_out_step = MAX_STEP + 1;
+    for ( int i = 1; i <= MAX_STEP; ++i )
+    {
+        if ( max_x < std::fabs( M_x[i] )
+             || max_y < std::fabs( M_y[i] ) )
+        {
+            M_out_step = i;
+            break;
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+Vector2D
+BallTrajectoryCache::pos( const int step ) const
+{
+    if ( step <= 0 )
+    {
+        return Vector2D( M_x[0], M_y[0] );
+    }
+
+    if ( step <= MAX_STEP )
+    {
+        return Vector2D( M_x[step], M_y[step] );
+    }
+
+    return inertia_n_step_point( Vector2D( M_x[0], M_y[0] ), M_vel, step, M_decay );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+Vector2D
+BallTrajectoryCache::vel( const int step ) const
+{
+    if ( step <= 0 )
+    {
+        return M_vel;
+    }
+
+    if ( step <= MAX_STEP )
+    {
+        return M_vel * M_decay_pow[step];
+    }
+
+    return M_vel * std::pow( M_decay, step );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+BallTrajectoryCache::speed( const int step ) const
+{
+    if ( step <= 0 )
+    {
+        return M_speed;
+    }
+
+    if ( step <= MAX_STEP )
+    {
+        return M_speed * M_decay_pow[step];
+    }
+
+    return M_speed * std::pow( M_decay, step );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+BallTrajectoryCache::length( const int min_stop_step,
+                             const int max_length ) const
+{
+    const int stop_length = std::max( M_stop_step, min_stop_step ) + 1;
+    return std::max( 1, std::min( { max_length, stop_length, M_out_step, MAX_STEP + 1 } ) );
+}
+
+}
@@ -0,0 +1,189 @@
+// -*-c++-*-
+
+/*!
+  \file ball_trajectory_cache.h
+  \brief predicted ball trajectory shared by the intercept predictors Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_COMMON_BALL_TRAJECTORY_CACHE_H
+#define RCSC_COMMON_BALL_TRAJECTORY_CACHE_H
+
+#include <rcsc/geom/vector_2d.h>
+#include <rcsc/game_time.h>
+
+namespace rcsc {
+
+/*!
+  \class BallTrajectoryCache
+  \brief ball positions predicted only by inertia, stored as contiguous x/y arrays.
+
+  Each position is computed by the closed form of the inertia movement,
+  so the values are identical to inertia_n_step_point().
+  The geometric series table is recomputed only when the ball decay is changed,
+  and the per cycle update is a flat loop that the compiler can vectorize.
+  WorldModel updates one instance in every decision, and the intercept
+  simulators and actions refer to it instead of recomputing the ball movement.
+*/
+class BallTrajectoryCache {
+public:
+
+    //! the number of predicted steps. positions from 0 to MAX_STEP are stored.
+    static constexpr int MAX_STEP = 100;
+
+    //! the ball is regarded as stopped if its speed is less than this value.
+    static constexpr double STOP_SPEED = 0.005;
+
+private:
+
+    GameTime M_time; //!< updated time
+    Vector2D M_vel; //!< initial velocity
+    double M_speed; //!< initial speed
+
+    double M_decay; //!< ball decay used to create the tables
+    int M_stop_step; //!< the first step that the ball speed becomes less than STOP_SPEED
+    int M_out_step; //!< the first step that the ball goes out of the field margin
+
+    alignas( 32 ) double M_x[MAX_STEP + 1]; //!< predicted x coordinates
+    alignas( 32 ) double M_y[MAX_STEP + 1]; //!< predicted y coordinates
+    alignas( 32 ) double M_decay_pow[MAX_STEP + 1]; //!< decay^step
+    alignas( 32 ) double M_travel_rate[MAX_STEP + 1]; //!< (1 - decay^step) / (1 - decay)
+
+public:
+
+    /*!
+      \brief create an empty cache. the ball is regarded as staying at (0,0).
+    */
+    BallTrajectoryCache();
+
+    /*!
+      \brief create the cache for the given ball state.
+      \param pos initial ball position
+      \param vel initial ball velocity
+    */
+    BallTrajectoryCache( const Vector2D & pos,
+                         const Vector2D & vel );
+
+    /*!
+      \brief recompute the trajectory using the current server parameters.
+      \param current current game time
+      \param pos initial ball position
+      \param vel initial ball velocity
+    */
+    void update( const GameTime & current,
+                 const Vector2D & pos,
+                 const Vector2D & vel );
+
+    /*!
+      \brief get the updated time
+      \return game time
+    */
+    const GameTime & time() const
+      {
+          return M_time;
+      }
+
+    /*!
+      \brief get the ball position after the given steps
+      \param step the number of steps from the current state
+      \return predicted position
+    */
+    Vector2D pos( const int step ) const;
+
+    /*!
+      \brief get the ball velocity after the given steps
+      \param step the number of steps from the current state
+      \return predicted velocity
+    */
+    Vector2D vel( const int step ) const;
+
+    /*!
+      \brief get the ball speed after the given steps
+      \param step the number of steps from the current state
+      \return predicted speed
+    */
+    double speed( const int step ) const;
+
+    /*!
+      \brief get the first step that the ball speed becomes less than STOP_SPEED.
+      \return step value. if the ball does not stop within MAX_STEP, MAX_STEP + 1.
+    */
+    int stopStep() const
+      {
+          return M_stop_step;
+      }
+
+    /*!
+      \brief get the first step that the ball goes out of the field margin.
+      \return step value. if the ball stays within MAX_STEP, MAX_STEP + 1.
+    */
+    int outStep() const
+      {
+          return M_out_step;
+      }
+
+    /*!
+      \brief get the number of positions that should be checked by the predictors.
+      \param min_stop_step the ball is not regarded as stopped before this step.
+      \param max_length upper bound of the result.
+      \return the number of positions from step 0. never greater than MAX_STEP + 1.
+
+      The length ends at the position where the ball stops (this position is included)
+      or just before the position where the ball goes out of the field margin.
+    */
+    int length( const int min_stop_step,
+                const int max_length ) const;
+
+    /*!
+      \brief get the x coordinate array
+      \return const pointer to the array of MAX_STEP + 1 values
+    */
+    const double * x() const
+      {
+          return M_x;
+      }
+
+    /*!
+      \brief get the y coordinate array
+      \return const pointer to the array of MAX_STEP + 1 values
+    */
+    const double * y() const
+      {
+          return M_y;
+      }
+
+private:
+
+    /*!
+      \brief recreate the decay tables if the decay is changed.
+      \param decay ball decay
+    */
+    void updateTable( const double decay );
+};
+
+}
+
+#endif
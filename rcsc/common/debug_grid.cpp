@@ -0,0 +1,332 @@
+// -*-c++-*-
+
+/*!
+  \file debug_grid.cpp
+  \brief quantized value grid for the debug output Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "debug_grid.h"
+
+#include <rcsc/color/gradation_color_provider.h>
+#include <rcsc/gz/gzcompressor.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace rcsc {
+
+namespace {
+
+const char BASE64_CHARS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief append the base64 text of the bytes
+ */
+void
+append_base64( const std::uint8_t * data,
+               const std::size_t size,
+               std::string * out )
+{
+    out->reserve( out->size() + ( size + 2 ) / 3 * 4 );
+
+    std::size_t i = 0;
+    for ( ; i + 3 <= size; i += 3 )
+    {
+        const std::uint32_t v = ( data[i] << 16 ) | ( data[i + 1] << 8 ) | data[i + 2];
+        out->push_back( BASE64_CHARS[( v >> 18 ) & 0x3f] );
+        out->push_back( BASE64_CHARS[( v >> 12 ) & 0x3f] );
+        out->push_back( BASE64_CHARS[( v >> 6 ) & 0x3f] );
+        out->push_back( BASE64_CHARS[v & 0x3f] );
+    }
+
+    if ( i < size )
+    {
+        const bool two = ( i + 1 < size );
+        const std::uint32_t v = ( data[i] << 16 ) | ( two ? data[i + 1] << 8 : 0 );
+        out->push_back( BASE64_CHARS[( v >> 18 ) & 0x3f] );
+        out->push_back( BASE64_CHARS[( v >> 12 ) & 0x3f] );
+        out->push_back( two ? BASE64_CHARS[( v >> 6 ) & 0x3f] : '=' );
+        out->push_back( '=' );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the 6 bit value of the base64 character
+  \return the value. -1 if illegal character.
+ */
+inline
+int
+base64_value( const char c )
+{
+    if ( 'A' <= c && c <= 'Z' ) return c - 'A';
+    if ( 'a' <= c && c <= 'z' ) return c - 'a' + 26;
+    if ( '0' <= c && c <= '9' ) return c - '0' + 52;
+    if ( c == '+' ) return 62;
+    if ( c == '/' ) return 63;
+    return -1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief decode the base64 text
+  \return false if the text has the illegal character
+ */
+bool
+decode_base64( const char * text,
+               const std::size_t size,
+               std::string * out )
+{
+    out->clear();
+    out->reserve( size / 4 * 3 );
+
+    std::uint32_t v = 0;
+    int bits = 0;
+    for ( std::size_t i = 0; i < size; ++i )
+    {
+        if ( text[i] == '=' )
+        {
+            break;
+        }
+
+        const int c = base64_value( text[i] );
+        if ( c < 0 )
+        {
+            return false;
+        }
+
+        v = ( v << 6 ) | static_cast< std::uint32_t >( c );
+        bits += 6;
+        if ( bits >= 8 )
+        {
+            bits -= 8;
+            out->push_back( static_cast< char >( ( v >> bits ) & 0xff ) );
+        }
+    }
+
+    return true;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+DebugGrid::DebugGrid()
+    : M_cols( 0 ),
+      M_rows( 0 ),
+      M_min_value( 0.0 ),
+      M_max_value( 1.0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+DebugGrid::DebugGrid( const int cols,
+                      const int rows,
+                      const float * values,
+                      const double min_value,
+                      const double max_value )
+    : M_cols( 0 ),
+      M_rows( 0 ),
+      M_min_value( 0.0 ),
+      M_max_value( 1.0 )
+{
+    assign( cols, rows, values, min_value, max_value );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+DebugGrid::assign( const int cols,
+                   const int rows,
+                   const float * values,
+                   const double min_value,
+                   const double max_value )
+{
+    M_cols = std::max( 0, cols );
+    M_rows = std::max( 0, rows );
+    M_min_value = min_value;
+    M_max_value = max_value;
+
+    const std::size_t n = static_cast< std::size_t >( M_cols ) * M_rows;
+    M_levels.resize( n );
+
+    const float range = static_cast< float >( max_value - min_value );
+    const float scale = ( range > 0.0f ? 255.0f / range : 0.0f );
+    const float offset = static_cast< float >( min_value );
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        // NaN is mapped to 0
+        float level = ( values[i] - offset ) * scale + 0.5f;
+        level = ( level > 0.0f ? level : 0.0f );
+        level = ( level < 255.0f ? level : 255.0f );
+        M_levels[i] = static_cast< std::uint8_t >( level );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+DebugGrid::encode( const int compression_level,
+                   std::string * out ) const
+{
+    char buf[128];
+    const int n = std::snprintf( buf, sizeof( buf ), "%d %d %.9g %.9g ",
+                                 M_cols, M_rows, M_min_value, M_max_value );
+    out->append( buf, std::min( n, static_cast< int >( sizeof( buf ) ) - 1 ) );
+
+#ifdef HAVE_LIBZ
+    if ( compression_level > 0
+         && ! M_levels.empty() )
+    {
+        GZCompressor compressor( compression_level );
+        std::string compressed;
+        if ( compressor.compress( reinterpret_cast< const char * >( M_levels.data() ),
+                                  static_cast< int >( M_levels.size() ),
+                                  compressed ) >= 0
+             && ! compressed.empty()
+             && compressed.size() < M_levels.size() )
+        {
+            out->append( "z " );
+            append_base64( reinterpret_cast< const std::uint8_t * >( compressed.data() ),
+                           compressed.size(),
+                           out );
+            return;
+        }
+    }
+#else
+    (void)compression_level;
+#endif
+
+    out->append( "b " );
+    append_base64( M_levels.data(), M_levels.size(), out );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+DebugGrid::decode( const char * text,
+                   const std::size_t size )
+{
+    M_cols = M_rows = 0;
+    M_levels.clear();
+
+    const std::string str( text, size );
+
+    int cols = 0, rows = 0;
+    double min_value = 0.0, max_value = 0.0;
+    char encoding = 0;
+    int n_read = 0;
+    if ( std::sscanf( str.c_str(), " %d %d %lf %lf %c %n",
+                      &cols, &rows, &min_value, &max_value, &encoding, &n_read ) != 5
+         || cols < 0
+         || rows < 0 )
+    {
+        return false;
+    }
+
+    const char * data = str.c_str() + n_read;
+    std::size_t data_size = str.size() - n_read;
+    while ( data_size > 0
+            && ( data[data_size - 1] == ' '
+                 || data[data_size - 1] == '\n' ) )
+    {
+        --data_size;
+    }
+
+    std::string bytes;
+    if ( ! decode_base64( data, data_size, &bytes ) )
+    {
+        return false;
+    }
+
+    if ( encoding == 'z' )
+    {
+        std::string inflated;
+        GZDecompressor decompressor;
+        if ( decompressor.decompress( bytes.data(), static_cast< int >( bytes.size() ), inflated ) < 0 )
+        {
+            return false;
+        }
+        bytes.swap( inflated );
+    }
+    else if ( encoding != 'b' )
+    {
+        return false;
+    }
+
+    if ( bytes.size() != static_cast< std::size_t >( cols ) * rows )
+    {
+        return false;
+    }
+
+    M_cols = cols;
+    M_rows = rows;
+    M_min_value = min_value;
+    M_max_value = max_value;
+    M_levels.assign( bytes.begin(), bytes.end() );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+DebugGrid::toColors( const GradationColorProvider & provider,
+                     std::vector< RGBColor > * colors ) const
+{
+    std::vector< float > values( M_levels.size() );
+    for ( std::size_t i = 0; i < M_levels.size(); ++i )
+    {
+        values[i] = M_levels[i] / 255.0f;
+    }
+
+    colors->resize( M_levels.size() );
+    provider.convert( values.data(), colors->data(), values.size() );
+}
+
+}
@@ -0,0 +1,193 @@
+// -*-c++-*-
+
+/*!
+  \file debug_grid.h
+  \brief quantized value grid for the debug output Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_COMMON_DEBUG_GRID_H
+#define RCSC_COMMON_DEBUG_GRID_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace rcsc {
+
+class GradationColorProvider;
+class RGBColor;
+
+/*!
+  \class DebugGrid
+  \brief grid of the evaluation values quantized to 8 bits.
+
+  The grid is used by Logger::addGrid() and DebugClient::addGrid() to write
+  a value map as one record instead of the records of each cell.
+  The cells are stored row by row. The first row is the top (the smallest y)
+  of the area, and the first cell of the row is the left of the area.
+
+  Payload := <cols:Int> <rows:Int> <min:Real> <max:Real> <Encoding> <Data>
+  Encoding := b | z
+    b : Data is the base64 encoded levels
+    z : Data is the base64 encoded zlib stream of the levels
+  The level L [0,255] means the value min + ( max - min ) * L / 255.
+*/
+class DebugGrid {
+private:
+
+    int M_cols; //!< the number of columns
+    int M_rows; //!< the number of rows
+    double M_min_value; //!< the value of level 0
+    double M_max_value; //!< the value of level 255
+    std::vector< std::uint8_t > M_levels; //!< quantized values
+
+public:
+
+    /*!
+      \brief create an empty grid
+     */
+    DebugGrid();
+
+    /*!
+      \brief create the grid with values
+      \param cols the number of columns
+      \param rows the number of rows
+      \param values cols * rows values in the row major order
+      \param min_value the value mapped to level 0. the smaller values are clamped.
+      \param max_value the value mapped to level 255. the greater values are clamped.
+     */
+    DebugGrid( const int cols,
+               const int rows,
+               const float * values,
+               const double min_value,
+               const double max_value );
+
+    /*!
+      \brief set the values
+      \param cols the number of columns
+      \param rows the number of rows
+      \param values cols * rows values in the row major order. NaN is stored as level 0.
+      \param min_value the value mapped to level 0. the smaller values are clamped.
+      \param max_value the value mapped to level 255. the greater values are clamped.
+     */
+    void assign( const int cols,
+                 const int rows,
+                 const float * values,
+                 const double min_value,
+                 const double max_value );
+
+    /*!
+      \brief get the number of columns
+      \return the number of columns
+     */
+    int cols() const
+      {
+          return M_cols;
+      }
+
+    /*!
+      \brief get the number of rows
+      \return the number of rows
+     */
+    int rows() const
+      {
+          return M_rows;
+      }
+
+    /*!
+      \brief get the value of level 0
+      \return minimum value
+     */
+    double minValue() const
+      {
+          return M_min_value;
+      }
+
+    /*!
+      \brief get the value of level 255
+      \return maximum value
+     */
+    double maxValue() const
+      {
+          return M_max_value;
+      }
+
+    /*!
+      \brief get the quantized values
+      \return const reference to the level container
+     */
+    const std::vector< std::uint8_t > & levels() const
+      {
+          return M_levels;
+      }
+
+    /*!
+      \brief get the dequantized value of the cell
+      \param col column index
+      \param row row index
+      \return the value of the level
+     */
+    double value( const int col,
+                  const int row ) const
+      {
+          return M_min_value
+              + ( M_max_value - M_min_value ) * M_levels[row * M_cols + col] / 255.0;
+      }
+
+    /*!
+      \brief append the payload text
+      \param compression_level zlib compression level [1,9]. 0 means no compression.
+      \param out pointer to the output string
+     */
+    void encode( const int compression_level,
+                 std::string * out ) const;
+
+    /*!
+      \brief restore the grid from the payload text
+      \param text payload text written by encode()
+      \param size the length of text
+      \return false if the payload is broken. the grid becomes empty.
+     */
+    bool decode( const char * text,
+                 const std::size_t size );
+
+    /*!
+      \brief convert the levels to colors
+      \param provider color provider. the level L is converted as the value L / 255.
+      \param colors pointer to the result variable. resized to cols * rows.
+
+      If the provider has the lookup table of 256 entries, each level is
+      converted to its table entry.
+     */
+    void toColors( const GradationColorProvider & provider,
+                   std::vector< RGBColor > * colors ) const;
+};
+
+}
+
+#endif
@@ -0,0 +1,479 @@
+// -*-c++-*-
+
+/*!
+  \file log_container.cpp
+  \brief multiplexed debug log container Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "log_container.h"
+
+#include <rcsc/gz/gzcompressor.h>
+
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#include <sys/file.h>
+#include <sys/stat.h>
+
+namespace rcsc {
+
+const char LogContainer::MAGIC[8] = { 'R', 'C', 'S', 'C', 'L', 'G', 'C', '1' };
+constexpr std::uint32_t LogContainer::BYTE_ORDER_MARK;
+constexpr std::size_t LogContainer::MAX_NAME_SIZE;
+constexpr std::uint8_t LogContainer::FLAG_COMPRESSED;
+
+static_assert( sizeof( LogContainer::ChunkHeader ) == 24, "unexpected ChunkHeader size." );
+
+namespace {
+
+//! the tag at the beginning of each chunk
+constexpr char CHUNK_TAG[4] = { 'L', 'C', 'H', 'K' };
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief write all bytes to the file descriptor
+ */
+bool
+write_all( const int fd,
+           const char * data,
+           std::size_t size )
+{
+    while ( size > 0 )
+    {
+        const ssize_t n = ::write( fd, data, size );
+        if ( n < 0 )
+        {
+            if ( errno == EINTR ) continue;
+            return false;
+        }
+        data += n;
+        size -= static_cast< std::size_t >( n );
+    }
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief RAII helper of the exclusive file lock
+ */
+class FileLock {
+private:
+    const int M_fd;
+public:
+    explicit
+    FileLock( const int fd )
+        : M_fd( fd )
+      {
+          while ( ::flock( M_fd, LOCK_EX ) != 0 && errno == EINTR )
+          {
+          }
+      }
+
+    ~FileLock()
+      {
+          ::flock( M_fd, LOCK_UN );
+      }
+};
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+LogContainerWriter::LogContainerWriter()
+    : M_fd( -1 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+LogContainerWriter::~LogContainerWriter()
+{
+    close();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+LogContainerWriter::open( const std::string & filepath,
+                          const std::string & agent_name,
+                          const int compression_level )
+{
+    close();
+
+    const int fd = ::open( filepath.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644 );
+    if ( fd < 0 )
+    {
+        return false;
+    }
+
+    {
+        // the first agent writes the file header.
+        // the other agents check it to avoid appending to an unrelated file.
+        FileLock lock( fd );
+
+        struct stat st;
+        if ( ::fstat( fd, &st ) != 0 )
+        {
+            ::close( fd );
+            return false;
+        }
+
+        if ( st.st_size == 0 )
+        {
+            char header[sizeof( LogContainer::MAGIC ) + sizeof( std::uint32_t )];
+            const std::uint32_t bom = LogContainer::BYTE_ORDER_MARK;
+            std::memcpy( header, LogContainer::MAGIC, sizeof( LogContainer::MAGIC ) );
+            std::memcpy( header + sizeof( LogContainer::MAGIC ), &bom, sizeof( bom ) );
+            if ( ! write_all( fd, header, sizeof( header ) ) )
+            {
+                ::close( fd );
+                return false;
+            }
+        }
+        else
+        {
+            char magic[sizeof( LogContainer::MAGIC )];
+            if ( ::pread( fd, magic, sizeof( magic ), 0 ) != static_cast< ssize_t >( sizeof( magic ) )
+                 || std::memcmp( magic, LogContainer::MAGIC, sizeof( magic ) ) != 0 )
+            {
+                ::close( fd );
+                return false;
+            }
+        }
+    }
+
+    M_fd = fd;
+    M_agent_name = agent_name.substr( 0, LogContainer::MAX_NAME_SIZE );
+
+#ifdef HAVE_LIBZ
+    if ( compression_level > 0 )
+    {
+        M_compressor.reset( new GZCompressor( std::min( 9, compression_level ) ) );
+    }
+#else
+    (void)compression_level;
+#endif
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+LogContainerWriter::close()
+{
+    if ( M_fd >= 0 )
+    {
+        ::close( M_fd );
+        M_fd = -1;
+    }
+
+    M_compressor.reset();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+LogContainerWriter::append( const long cycle,
+                            const long stopped,
+                            const char * text,
+                            const std::size_t size )
+{
+    if ( M_fd < 0
+         || size > 0xffffffff )
+    {
+        return false;
+    }
+
+    if ( size == 0 )
+    {
+        return true;
+    }
+
+    LogContainer::ChunkHeader header;
+    std::memcpy( header.tag_, CHUNK_TAG, sizeof( CHUNK_TAG ) );
+    header.flags_ = 0;
+    header.name_size_ = static_cast< std::uint8_t >( M_agent_name.size() );
+    header.reserved_ = 0;
+    header.cycle_ = static_cast< std::int32_t >( cycle );
+    header.stopped_ = static_cast< std::int32_t >( stopped );
+    header.raw_size_ = static_cast< std::uint32_t >( size );
+
+    const char * payload = text;
+    std::size_t payload_size = size;
+
+    if ( M_compressor
+         && size <= 0x7fffffff
+         && M_compressor->compress( text, static_cast< int >( size ), M_payload ) >= 0
+         && ! M_payload.empty()
+         && M_payload.size() < size )
+    {
+        header.flags_ |= LogContainer::FLAG_COMPRESSED;
+        payload = M_payload.data();
+        payload_size = M_payload.size();
+    }
+
+    header.stored_size_ = static_cast< std::uint32_t >( payload_size );
+
+    // the whole chunk is written by one call under the lock,
+    // so the chunks of other agents are never interleaved.
+    M_chunk.clear();
+    M_chunk.append( reinterpret_cast< const char * >( &header ), sizeof( header ) );
+    M_chunk.append( M_agent_name );
+    M_chunk.append( payload, payload_size );
+
+    FileLock lock( M_fd );
+    return write_all( M_fd, M_chunk.data(), M_chunk.size() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+LogContainerReader::LogContainerReader()
+    : M_fin( nullptr )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+LogContainerReader::~LogContainerReader()
+{
+    close();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+LogContainerReader::open( const std::string & filepath )
+{
+    close();
+
+    M_fin = std::fopen( filepath.c_str(), "rb" );
+    if ( ! M_fin )
+    {
+        return false;
+    }
+
+    char magic[sizeof( LogContainer::MAGIC )];
+    std::uint32_t bom = 0;
+    if ( std::fread( magic, 1, sizeof( magic ), M_fin ) != sizeof( magic )
+         || std::memcmp( magic, LogContainer::MAGIC, sizeof( magic ) ) != 0
+         || std::fread( &bom, 1, sizeof( bom ), M_fin ) != sizeof( bom )
+         || bom != LogContainer::BYTE_ORDER_MARK )
+    {
+        close();
+        return false;
+    }
+
+    std::string name;
+    LogContainer::ChunkHeader header;
+    while ( std::fread( &header, 1, sizeof( header ), M_fin ) == sizeof( header ) )
+    {
+        if ( std::memcmp( header.tag_, CHUNK_TAG, sizeof( CHUNK_TAG ) ) != 0 )
+        {
+            close();
+            return false;
+        }
+
+        name.resize( header.name_size_ );
+        if ( header.name_size_ > 0
+             && std::fread( &name[0], 1, header.name_size_, M_fin ) != header.name_size_ )
+        {
+            break;
+        }
+
+        const long offset = std::ftell( M_fin );
+        if ( std::fseek( M_fin, static_cast< long >( header.stored_size_ ), SEEK_CUR ) != 0 )
+        {
+            break;
+        }
+
+        int agent = findAgent( name );
+        if ( agent < 0 )
+        {
+            agent = static_cast< int >( M_agents.size() );
+            M_agents.push_back( name );
+        }
+
+        Chunk chunk;
+        chunk.agent_ = agent;
+        chunk.cycle_ = header.cycle_;
+        chunk.stopped_ = header.stopped_;
+        chunk.offset_ = offset;
+        chunk.raw_size_ = header.raw_size_;
+        chunk.stored_size_ = header.stored_size_;
+        chunk.compressed_ = ( header.flags_ & LogContainer::FLAG_COMPRESSED );
+        M_chunks.push_back( chunk );
+    }
+
+    // fseek never fails past the end of file. drop the truncated last chunk.
+    std::fseek( M_fin, 0, SEEK_END );
+    const long file_size = std::ftell( M_fin );
+    while ( ! M_chunks.empty()
+            && M_chunks.back().offset_ + static_cast< long >( M_chunks.back().stored_size_ ) > file_size )
+    {
+        M_chunks.pop_back();
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+LogContainerReader::close()
+{
+    if ( M_fin )
+    {
+        std::fclose( M_fin );
+        M_fin = nullptr;
+    }
+
+    M_agents.clear();
+    M_chunks.clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+LogContainerReader::findAgent( const std::string & agent_name ) const
+{
+    std::vector< std::string >::const_iterator it = std::find( M_agents.begin(), M_agents.end(), agent_name );
+    return ( it == M_agents.end()
+             ? -1
+             : static_cast< int >( it - M_agents.begin() ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+LogContainerReader::read( const Chunk & chunk,
+                          std::string * text )
+{
+    if ( ! M_fin
+         || std::fseek( M_fin, chunk.offset_, SEEK_SET ) != 0 )
+    {
+        return false;
+    }
+
+    std::string & buf = ( chunk.compressed_ ? M_payload : *text );
+    buf.resize( chunk.stored_size_ );
+    if ( chunk.stored_size_ > 0
+         && std::fread( &buf[0], 1, chunk.stored_size_, M_fin ) != chunk.stored_size_ )
+    {
+        return false;
+    }
+
+    if ( chunk.compressed_ )
+    {
+#ifdef HAVE_LIBZ
+        GZDecompressor decompressor;
+        if ( decompressor.decompress( M_payload.data(), static_cast< int >( M_payload.size() ), *text ) < 0 )
+        {
+            return false;
+        }
+#else
+        return false;
+#endif
+    }
+
+    return text->size() == chunk.raw_size_;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+LogContainerReader::extract( const std::string & agent_name,
+                             const long start_cycle,
+                             const long end_cycle,
+                             std::ostream & os )
+{
+    const int agent = findAgent( agent_name );
+    if ( agent < 0 )
+    {
+        return false;
+    }
+
+    std::string text;
+    for ( const Chunk & chunk : M_chunks )
+    {
+        if ( chunk.agent_ != agent
+             || chunk.cycle_ < start_cycle
+             || end_cycle < chunk.cycle_ )
+        {
+            continue;
+        }
+
+        if ( ! read( chunk, &text ) )
+        {
+            return false;
+        }
+
+        os.write( text.data(), text.size() );
+    }
+
+    return static_cast< bool >( os );
+}
+
+}
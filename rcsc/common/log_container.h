@@ -0,0 +1,302 @@
+// -*-c++-*-
+
+/*!
+  \file log_container.h
+  \brief multiplexed debug log container Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_COMMON_LOG_CONTAINER_H
+#define RCSC_COMMON_LOG_CONTAINER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+#include <cstdio>
+
+namespace rcsc {
+
+class GZCompressor;
+
+/*!
+  \class LogContainer
+  \brief common definitions of the multiplexed debug log container.
+
+  The container is one file shared by all agents of a match. Each agent
+  appends its text log as independent chunks. A chunk holds the records of
+  one agent in one cycle, and its payload is compressed separately, so
+  a reader can skip the other agents' chunks without decompressing them.
+
+  File format (native byte order):
+  \verbatim
+  File := <Header> <Chunk>*
+  Header := "RCSCLGC1" <ByteOrderMark:uint32>
+  Chunk := <ChunkHeader> <AgentName> <Payload>
+  ChunkHeader := "LCHK" <flags:uint8> <name_size:uint8> <reserved:uint16>
+                 <cycle:int32> <stopped:int32> <raw_size:uint32> <stored_size:uint32>
+  \endverbatim
+  Bit 0 of flags means that the payload is a zlib stream. Otherwise, the
+  payload is the raw text. The text is the same as the usual text debug log.
+
+  The chunks are appended under an exclusive file lock, so several
+  processes can write to the same container at the same time.
+*/
+class LogContainer {
+public:
+
+    //! the magic bytes at the beginning of the file
+    static const char MAGIC[8];
+
+    //! the value to detect the byte order of the writer
+    static constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    //! the maximum length of the agent name
+    static constexpr std::size_t MAX_NAME_SIZE = 255;
+
+    /*!
+      \struct ChunkHeader
+      \brief fixed size part of one chunk.
+     */
+    struct ChunkHeader {
+        char tag_[4]; //!< "LCHK"
+        std::uint8_t flags_; //!< chunk flags
+        std::uint8_t name_size_; //!< the length of the agent name
+        std::uint16_t reserved_; //!< padding
+        std::int32_t cycle_; //!< game time cycle
+        std::int32_t stopped_; //!< game time stopped cycle
+        std::uint32_t raw_size_; //!< the length of the text
+        std::uint32_t stored_size_; //!< the length of the payload
+    };
+
+    //! chunk flag: the payload is compressed
+    static constexpr std::uint8_t FLAG_COMPRESSED = 0x01;
+};
+
+/*!
+  \class LogContainerWriter
+  \brief appends the chunks of one agent to the container file.
+*/
+class LogContainerWriter {
+private:
+
+    //! file descriptor opened in the append mode. -1 if not opened.
+    int M_fd;
+
+    //! agent name written to each chunk
+    std::string M_agent_name;
+
+    //! zlib compressor. nullptr if the compression is disabled.
+    std::unique_ptr< GZCompressor > M_compressor;
+
+    //! reusable chunk buffer
+    std::string M_chunk;
+
+    //! reusable compressed payload buffer
+    std::string M_payload;
+
+    // not used
+    LogContainerWriter( const LogContainerWriter & ) = delete;
+    LogContainerWriter & operator=( const LogContainerWriter & ) = delete;
+
+public:
+
+    /*!
+      \brief construct an empty writer
+     */
+    LogContainerWriter();
+
+    /*!
+      \brief close the file
+     */
+    ~LogContainerWriter();
+
+    /*!
+      \brief open the container file. the file is created if it does not exist.
+      \param filepath container file path
+      \param agent_name the name that identifies this agent in the container
+      \param compression_level zlib compression level [1,9]. 0 disables the compression.
+      \return false if the file cannot be opened or is not a container.
+     */
+    bool open( const std::string & filepath,
+               const std::string & agent_name,
+               const int compression_level = 6 );
+
+    /*!
+      \brief close the file
+     */
+    void close();
+
+    /*!
+      \brief check if the file is opened
+      \return true if the file is opened
+     */
+    bool isOpen() const
+      {
+          return M_fd >= 0;
+      }
+
+    /*!
+      \brief get the agent name
+      \return agent name
+     */
+    const std::string & agentName() const
+      {
+          return M_agent_name;
+      }
+
+    /*!
+      \brief append one chunk
+      \param cycle game time cycle
+      \param stopped game time stopped cycle
+      \param text text log data
+      \param size the length of text
+      \return false if the chunk cannot be written
+     */
+    bool append( const long cycle,
+                 const long stopped,
+                 const char * text,
+                 const std::size_t size );
+};
+
+/*!
+  \class LogContainerReader
+  \brief reads the chunks of the selected agents from the container file.
+*/
+class LogContainerReader {
+public:
+
+    /*!
+      \struct Chunk
+      \brief index entry of one chunk
+     */
+    struct Chunk {
+        int agent_; //!< index of the agent name
+        long cycle_; //!< game time cycle
+        long stopped_; //!< game time stopped cycle
+        long offset_; //!< file offset of the payload
+        std::uint32_t raw_size_; //!< the length of the text
+        std::uint32_t stored_size_; //!< the length of the payload
+        bool compressed_; //!< true if the payload is compressed
+    };
+
+private:
+
+    //! input file
+    FILE * M_fin;
+
+    //! agent names in the order of appearance
+    std::vector< std::string > M_agents;
+
+    //! chunk index in the file order
+    std::vector< Chunk > M_chunks;
+
+    //! reusable payload buffer
+    std::string M_payload;
+
+    // not used
+    LogContainerReader( const LogContainerReader & ) = delete;
+    LogContainerReader & operator=( const LogContainerReader & ) = delete;
+
+public:
+
+    /*!
+      \brief construct an empty reader
+     */
+    LogContainerReader();
+
+    /*!
+      \brief close the file
+     */
+    ~LogContainerReader();
+
+    /*!
+      \brief open the container file and build the chunk index.
+      Only the chunk headers are read.
+      \param filepath container file path
+      \return false if the file is not a container. A truncated last chunk is ignored.
+     */
+    bool open( const std::string & filepath );
+
+    /*!
+      \brief close the file
+     */
+    void close();
+
+    /*!
+      \brief get the agent names
+      \return agent name container
+     */
+    const std::vector< std::string > & agents() const
+      {
+          return M_agents;
+      }
+
+    /*!
+      \brief get the chunk index
+      \return chunk container
+     */
+    const std::vector< Chunk > & chunks() const
+      {
+          return M_chunks;
+      }
+
+    /*!
+      \brief get the index of the agent name
+      \param agent_name agent name
+      \return index value, or -1 if not found
+     */
+    int findAgent( const std::string & agent_name ) const;
+
+    /*!
+      \brief read the text of one chunk
+      \param chunk index entry
+      \param text pointer to the variable to store the text
+      \return false if the chunk is broken
+     */
+    bool read( const Chunk & chunk,
+               std::string * text );
+
+    /*!
+      \brief write the text log of one agent in the cycle range.
+      The output can be read by soccerwindow2 as an ordinary debug log.
+      \param agent_name agent name
+      \param start_cycle first cycle of the range
+      \param end_cycle last cycle of the range
+      \param os output stream
+      \return false if the agent is not found or a chunk is broken
+     */
+    bool extract( const std::string & agent_name,
+                  const long start_cycle,
+                  const long end_cycle,
+                  std::ostream & os );
+};
+
+}
+
+#endif
@@ -35,7 +35,11 @@
 
 #include "logger.h"
 
+#include "debug_grid.h"
+#include "log_container.h"
+
 #include <rcsc/game_time.h>
+#include <rcsc/gz/compressed_fstream.h>
 
 #include <string>
 #include <iostream>
@@ -45,6 +49,11 @@
 #include <mutex>
 #include <memory>
 #include <atomic>
+#include <vector>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
 
 namespace rcsc {
 
@@ -56,7 +65,7 @@ constexpr size_t G_BUFFER_SIZE = 2048;
 //! main buffer - now thread-safe with mutex protection
 struct ThreadSafeBuffer {
     std::string buffer;
-    std::mutex mutex;
+    mutable std::mutex mutex;
     
     ThreadSafeBuffer() {
         buffer.reserve(8192 * 4);
@@ -83,6 +92,11 @@ struct ThreadSafeBuffer {
         std::lock_guard<std::mutex> lock(mutex);
         return buffer.size();
     }
+
+    size_t capacity() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return buffer.capacity();
+    }
 };
 
 //! thread-safe global buffer
@@ -91,6 +105,252 @@ static ThreadSafeBuffer g_thread_safe_buffer;
 //! temporary buffer - thread-local for better performance
 thread_local char g_buffer[G_BUFFER_SIZE];
 
+
+//! magic bytes at the beginning of the binary log file
+constexpr char BINARY_LOG_MAGIC[8] = { 'R', 'C', 'S', 'C', 'L', 'O', 'G', '1' };
+
+//! the number of bytes in each thread ring. must be a power of 2.
+constexpr std::size_t RING_CAPACITY = 1 << 22;
+
+/*!
+  \struct LogRecord
+  \brief fixed size part of one log record.
+  The color name and the text follow the record as the payload bytes.
+ */
+struct LogRecord {
+    std::int64_t cycle_; //!< game time cycle
+    std::int64_t stopped_; //!< game time stopped cycle
+    std::int32_t level_; //!< log level
+    std::int32_t rgb_[3]; //!< RGB color values if color_mode_ is '#'
+    char type_; //!< record tag character
+    char color_mode_; //!< 0: no color, 'n': named color in the payload, '#': RGB
+    std::uint8_t n_values_; //!< the number of values
+    std::uint8_t text_size_high_; //!< the upper 8 bits of the text length
+    std::uint16_t color_size_; //!< the byte length of the color name in the payload
+    std::uint16_t text_size_; //!< the lower 16 bits of the byte length of the text in the payload
+    double values_[6]; //!< coordinate values
+};
+
+static_assert( sizeof( LogRecord ) == 88, "unexpected LogRecord size." );
+
+//! the maximum text length of one record. the record must fit in the ring.
+constexpr std::size_t MAX_TEXT_SIZE = RING_CAPACITY / 4;
+
+/*-------------------------------------------------------------------*/
+/*!
+  rief get the byte length of the text in the payload
+ */
+inline
+std::size_t
+text_size( const LogRecord & rec )
+{
+    return ( static_cast< std::size_t >( rec.text_size_high_ ) << 16 ) | rec.text_size_;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  rief set the byte length of the text in the payload
+  
+eturn the stored length
+ */
+inline
+std::size_t
+set_text_size( const std::size_t size,
+               LogRecord * rec )
+{
+    const std::size_t n = std::min( size, MAX_TEXT_SIZE );
+    rec->text_size_ = static_cast< std::uint16_t >( n & 0xffff );
+    rec->text_size_high_ = static_cast< std::uint8_t >( n >> 16 );
+    return n;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief append the text representation of the record
+  \param rec record
+  \param color color name. used only if rec.color_mode_ is 'n'.
+  \param text message text
+  \param out output buffer
+ */
+void
+format_record( const LogRecord & rec,
+               const char * color,
+               const char * text,
+               std::string & out )
+{
+    char buf[256];
+
+    int n = std::snprintf( buf, sizeof( buf ), "%ld,%ld %d %c",
+                           static_cast< long >( rec.cycle_ ),
+                           static_cast< long >( rec.stopped_ ),
+                           rec.level_,
+                           rec.type_ );
+    for ( int i = 0; i < rec.n_values_ && n < static_cast< int >( sizeof( buf ) ); ++i )
+    {
+        n += std::snprintf( buf + n, sizeof( buf ) - n, " %.4f", rec.values_[i] );
+    }
+    out.append( buf, std::min( n, static_cast< int >( sizeof( buf ) ) - 1 ) );
+    out += ' ';
+
+    char col[32];
+    if ( rec.color_mode_ == '#' )
+    {
+        std::snprintf( col, sizeof( col ), "#%02x%02x%02x",
+                       rec.rgb_[0], rec.rgb_[1], rec.rgb_[2] );
+        color = col;
+    }
+
+    if ( rec.type_ == 'm' )
+    {
+        // the message is painted with the optional color
+        if ( rec.color_mode_ != 0 )
+        {
+            out += "(c ";
+            out.append( color, rec.color_mode_ == '#' ? std::strlen( col ) : rec.color_size_ );
+            out += ") ";
+        }
+        out.append( text, text_size( rec ) );
+    }
+    else if ( rec.type_ == 'M'
+              || rec.type_ == 'G' )
+    {
+        out.append( text, text_size( rec ) );
+    }
+    else if ( rec.color_mode_ != 0 )
+    {
+        out.append( color, rec.color_mode_ == '#' ? std::strlen( col ) : rec.color_size_ );
+    }
+
+    out += '\n';
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \class ByteRing
+  \brief lock free single producer single consumer byte queue.
+  Each push copies the whole record or nothing, so that the consumer
+  never observes a partial record.
+ */
+class ByteRing {
+private:
+    std::vector< char > M_data;
+    alignas( 64 ) std::atomic< std::size_t > M_head; //!< consumer position
+    alignas( 64 ) std::atomic< std::size_t > M_tail; //!< producer position
+
+public:
+
+    ByteRing()
+        : M_data( RING_CAPACITY ),
+          M_head( 0 ),
+          M_tail( 0 )
+      { }
+
+    bool push( const LogRecord & rec,
+               const char * color,
+               const char * text )
+      {
+          const std::size_t total = sizeof( LogRecord ) + rec.color_size_ + text_size( rec );
+          const std::size_t tail = M_tail.load( std::memory_order_relaxed );
+          const std::size_t head = M_head.load( std::memory_order_acquire );
+          if ( RING_CAPACITY - ( tail - head ) < total )
+          {
+              return false;
+          }
+
+          std::size_t pos = tail;
+          copyIn( pos, reinterpret_cast< const char * >( &rec ), sizeof( LogRecord ) );
+          pos += sizeof( LogRecord );
+          if ( rec.color_size_ > 0 )
+          {
+              copyIn( pos, color, rec.color_size_ );
+              pos += rec.color_size_;
+          }
+          if ( text_size( rec ) > 0 )
+          {
+              copyIn( pos, text, text_size( rec ) );
+          }
+
+          M_tail.store( tail + total, std::memory_order_release );
+          return true;
+      }
+
+    /*!
+      \brief call the function for every queued records and release them.
+      \return the number of processed records
+     */
+    template < typename Func >
+    std::size_t consume( std::vector< char > & payload,
+                         Func func )
+      {
+          const std::size_t tail = M_tail.load( std::memory_order_acquire );
+          std::size_t head = M_head.load( std::memory_order_relaxed );
+          std::size_t count = 0;
+
+          while ( tail - head >= sizeof( LogRecord ) )
+          {
+              LogRecord rec;
+              copyOut( head, reinterpret_cast< char * >( &rec ), sizeof( LogRecord ) );
+
+              const std::size_t size = rec.color_size_ + text_size( rec );
+              payload.resize( size + 1 );
+              copyOut( head + sizeof( LogRecord ), payload.data(), size );
+              payload[size] = '\0';
+
+              func( rec, payload.data(), payload.data() + rec.color_size_ );
+
+              head += sizeof( LogRecord ) + size;
+              ++count;
+          }
+
+          M_head.store( head, std::memory_order_release );
+          return count;
+      }
+
+private:
+
+    void copyIn( const std::size_t pos,
+                 const char * src,
+                 const std::size_t len )
+      {
+          const std::size_t i = pos & ( RING_CAPACITY - 1 );
+          const std::size_t first = std::min( len, RING_CAPACITY - i );
+          std::memcpy( M_data.data() + i, src, first );
+          std::memcpy( M_data.data(), src + first, len - first );
+      }
+
+    void copyOut( const std::size_t pos,
+                  char * dst,
+                  const std::size_t len ) const
+      {
+          const std::size_t i = pos & ( RING_CAPACITY - 1 );
+          const std::size_t first = std::min( len, RING_CAPACITY - i );
+          std::memcpy( dst, M_data.data() + i, first );
+          std::memcpy( dst + first, M_data.data(), len - first );
+      }
+};
+
+//! set by requestFlightRecorderDump(). must be lock free to be used in a signal handler.
+std::atomic< bool > g_flight_dump_requested( false );
+
+static_assert( ATOMIC_BOOL_LOCK_FREE == 2, "std::atomic< bool > is not lock free." );
+
+//! identifier of the last started writer
+std::atomic< std::uint64_t > g_writer_id( 0 );
+
+//! the ring of this thread and the writer id that owns it
+struct ThreadChannel {
+    std::uint64_t writer_id_;
+    ByteRing * ring_;
+};
+
+thread_local ThreadChannel g_thread_channel = { 0, nullptr };
+
+//! reusable text buffer for the synchronous formatting
+thread_local std::string g_format_buffer;
+
+//! reusable payload buffer for the grid records
+thread_local std::string g_grid_buffer;
+
 }
 
 //! global variable - now thread-safe
@@ -99,6 +359,272 @@ static std::atomic<Logger*> g_global_logger{nullptr};
 //! global logger instance
 Logger dlog;
 
+/*-------------------------------------------------------------------*/
+/*!
+  \struct Logger::AsyncWriter
+  \brief per thread rings and the background writer thread
+ */
+struct Logger::AsyncWriter {
+    const std::uint64_t id_; //!< unique writer id
+    FILE * fout_; //!< output file
+    const bool binary_; //!< if true, the records are dumped without formatting
+
+    std::mutex channels_mutex_; //!< guards channels_
+    std::vector< std::pair< std::thread::id, std::unique_ptr< ByteRing > > > channels_; //!< producer rings
+
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    std::atomic< bool > stop_;
+
+    std::thread thread_;
+
+    AsyncWriter( FILE * fout,
+                 const bool binary )
+        : id_( ++g_writer_id ),
+          fout_( fout ),
+          binary_( binary ),
+          stop_( false )
+      {
+          if ( binary_ )
+          {
+              std::fwrite( BINARY_LOG_MAGIC, 1, sizeof( BINARY_LOG_MAGIC ), fout_ );
+          }
+          thread_ = std::thread( &AsyncWriter::run, this );
+      }
+
+    ~AsyncWriter()
+      {
+          stop_ = true;
+          wake_.notify_one();
+          if ( thread_.joinable() )
+          {
+              thread_.join();
+          }
+      }
+
+    /*!
+      \brief get the ring of the caller thread. the ring is created at the first call.
+     */
+    ByteRing * channel()
+      {
+          if ( g_thread_channel.writer_id_ == id_ )
+          {
+              return g_thread_channel.ring_;
+          }
+
+          // the cache holds only one writer. search the registered ring of this thread.
+          const std::thread::id tid = std::this_thread::get_id();
+          std::lock_guard< std::mutex > lock( channels_mutex_ );
+
+          ByteRing * ring = nullptr;
+          for ( std::pair< std::thread::id, std::unique_ptr< ByteRing > > & c : channels_ )
+          {
+              if ( c.first == tid )
+              {
+                  ring = c.second.get();
+                  break;
+              }
+          }
+
+          if ( ! ring )
+          {
+              channels_.emplace_back( tid, std::unique_ptr< ByteRing >( new ByteRing() ) );
+              ring = channels_.back().second.get();
+          }
+
+          g_thread_channel.writer_id_ = id_;
+          g_thread_channel.ring_ = ring;
+          return ring;
+      }
+
+    void push( const LogRecord & rec,
+               const char * color,
+               const char * text )
+      {
+          ByteRing * ring = channel();
+          if ( ! color ) color = "";
+          if ( ! text ) text = "";
+          while ( ! ring->push( rec, color, text ) )
+          {
+              // the writer is behind. never drop the record.
+              wake_.notify_one();
+              std::this_thread::yield();
+          }
+      }
+
+    void notify()
+      {
+          wake_.notify_one();
+      }
+
+    std::size_t drain( std::vector< char > & payload,
+                       std::string & text )
+      {
+          std::size_t count = 0;
+          std::lock_guard< std::mutex > lock( channels_mutex_ );
+          for ( std::pair< std::thread::id, std::unique_ptr< ByteRing > > & c : channels_ )
+          {
+              text.clear();
+              count += c.second->consume( payload,
+                                      [&]( const LogRecord & rec,
+                                           const char * color,
+                                           const char * msg )
+                                        {
+                                            if ( binary_ )
+                                            {
+                                                text.append( reinterpret_cast< const char * >( &rec ),
+                                                             sizeof( LogRecord ) );
+                                                text.append( color, rec.color_size_ );
+                                                text.append( msg, text_size( rec ) );
+                                            }
+                                            else
+                                            {
+                                                format_record( rec, color, msg, text );
+                                            }
+                                        } );
+              if ( ! text.empty() )
+              {
+                  std::fwrite( text.data(), 1, text.size(), fout_ );
+              }
+          }
+          return count;
+      }
+
+    void run()
+      {
+          std::vector< char > payload;
+          std::string text;
+          text.reserve( 8192 * 4 );
+
+          bool written = false;
+          while ( ! stop_ )
+          {
+              if ( drain( payload, text ) > 0 )
+              {
+                  written = true;
+                  continue;
+              }
+
+              if ( written )
+              {
+                  std::fflush( fout_ );
+                  written = false;
+              }
+
+              std::unique_lock< std::mutex > lock( wake_mutex_ );
+              wake_.wait_for( lock, std::chrono::milliseconds( 10 ) );
+          }
+
+          while ( drain( payload, text ) > 0 )
+          {
+          }
+          std::fflush( fout_ );
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \struct Logger::FlightRecorder
+  \brief ring of the binary records of the latest game steps.
+  The buffer of each step is reused, so no memory is allocated after
+  the buffers grow to the usual step size.
+ */
+struct Logger::FlightRecorder {
+
+    /*!
+      \struct Step
+      \brief binary records of one game step
+     */
+    struct Step {
+        long cycle_; //!< game time cycle. negative if not used.
+        long stopped_; //!< game time stopped cycle
+        std::string data_; //!< LogRecord and its payload
+    };
+
+    const std::string path_prefix_; //!< path prefix of the dumped files
+
+    mutable std::mutex mutex_; //!< guards the steps
+    std::vector< Step > steps_; //!< step ring
+    std::size_t head_; //!< index of the latest step
+
+    FlightRecorder( const int steps,
+                    const std::string & path_prefix )
+        : path_prefix_( path_prefix ),
+          steps_( static_cast< std::size_t >( steps ) ),
+          head_( 0 )
+      {
+          for ( Step & s : steps_ )
+          {
+              s.cycle_ = s.stopped_ = -1;
+          }
+      }
+
+    void push( const LogRecord & rec,
+               const char * color,
+               const char * text )
+      {
+          std::lock_guard< std::mutex > lock( mutex_ );
+
+          Step * s = &steps_[head_];
+          if ( s->cycle_ != rec.cycle_
+               || s->stopped_ != rec.stopped_ )
+          {
+              if ( s->cycle_ >= 0 )
+              {
+                  head_ = ( head_ + 1 ) % steps_.size();
+                  s = &steps_[head_];
+              }
+              s->cycle_ = rec.cycle_;
+              s->stopped_ = rec.stopped_;
+              s->data_.clear();
+          }
+
+          s->data_.append( reinterpret_cast< const char * >( &rec ), sizeof( LogRecord ) );
+          if ( color ) s->data_.append( color, rec.color_size_ );
+          if ( text ) s->data_.append( text, text_size( rec ) );
+      }
+
+    bool dump( FILE * fout ) const
+      {
+          std::lock_guard< std::mutex > lock( mutex_ );
+
+          if ( std::fwrite( BINARY_LOG_MAGIC, 1, sizeof( BINARY_LOG_MAGIC ), fout ) != sizeof( BINARY_LOG_MAGIC ) )
+          {
+              return false;
+          }
+
+          // from the oldest step
+          for ( std::size_t i = 1; i <= steps_.size(); ++i )
+          {
+              const Step & s = steps_[( head_ + i ) % steps_.size()];
+              if ( s.cycle_ < 0
+                   || s.data_.empty() )
+              {
+                  continue;
+              }
+
+              if ( std::fwrite( s.data_.data(), 1, s.data_.size(), fout ) != s.data_.size() )
+              {
+                  return false;
+              }
+          }
+
+          return true;
+      }
+
+    std::size_t memoryUsage() const
+      {
+          std::lock_guard< std::mutex > lock( mutex_ );
+
+          std::size_t bytes = steps_.capacity() * sizeof( Step );
+          for ( const Step & s : steps_ )
+          {
+              bytes += s.data_.capacity();
+          }
+          return bytes;
+      }
+};
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -108,7 +634,10 @@ Logger::Logger()
       M_fout( nullptr ),
       M_flags( 0 ),
       M_start_time( -1 ),
-      M_end_time( 99999999 )
+      M_end_time( 99999999 ),
+      M_write_mode( SYNC_TEXT ),
+      M_grid_compression_level( 0 ),
+      M_disabled( false )
 {
     // Initialize thread-local buffer
     std::memset(g_buffer, 0, G_BUFFER_SIZE);
@@ -140,6 +669,11 @@ Logger::setLogFlag( const GameTime * time,
                     const std::int32_t level,
                     const bool on )
 {
+    if ( M_disabled )
+    {
+        return;
+    }
+
     M_time = time;
 
     if ( on )
@@ -157,10 +691,105 @@ void
 Logger::setTimeRange( const int start_time,
                       const int end_time )
 {
+    if ( M_disabled )
+    {
+        return;
+    }
+
     M_start_time = start_time;
     M_end_time = end_time;
 }
 
+/*-------------------------------------------------------------------*/
+void
+Logger::disable()
+{
+    close();
+
+    M_disabled = true;
+    M_time = nullptr;
+    M_flags = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Logger::setWriteMode( const WriteMode mode )
+{
+    if ( mode == M_write_mode )
+    {
+        return;
+    }
+
+    stopAsyncWriter();
+    flush();
+
+    M_write_mode = mode;
+
+    startAsyncWriter();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Logger::setGridCompressionLevel( const int level )
+{
+    M_grid_compression_level = std::min( 9, std::max( 0, level ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Logger::startAsyncWriter()
+{
+    if ( M_fout
+         && ! M_async_writer
+         && M_write_mode != SYNC_TEXT )
+    {
+        M_async_writer.reset( new AsyncWriter( M_fout, M_write_mode == ASYNC_BINARY ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Logger::stopAsyncWriter()
+{
+    // the destructor joins the writer thread after writing all records.
+    M_async_writer.reset();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::size_t
+Logger::memoryUsage() const
+{
+    std::size_t bytes = g_thread_safe_buffer.capacity();
+
+    if ( M_async_writer )
+    {
+        std::lock_guard< std::mutex > lock( M_async_writer->channels_mutex_ );
+        bytes += M_async_writer->channels_.size() * ( sizeof( ByteRing ) + RING_CAPACITY );
+    }
+
+    if ( M_flight_recorder )
+    {
+        bytes += M_flight_recorder->memoryUsage();
+    }
+
+    return bytes;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -168,8 +797,17 @@ Logger::setTimeRange( const int start_time,
 void
 Logger::close()
 {
+    M_flight_recorder.reset();
+
+    if ( M_container )
+    {
+        flush();
+        M_container.reset();
+    }
+
     if ( M_fout )
     {
+        stopAsyncWriter();
         flush();
         if ( M_fout != stdout
              && M_fout != stderr )
@@ -187,9 +825,97 @@ Logger::close()
 void
 Logger::open( const std::string & filepath )
 {
+    if ( M_disabled )
+    {
+        return;
+    }
+
+    close();
+
+    // a .gz, .zst or .lz4 file path enables the compressed output.
+    M_fout = compressed_fopen( filepath.c_str() );
+    startAsyncWriter();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Logger::openContainer( const std::string & filepath,
+                       const std::string & agent_name )
+{
+    if ( M_disabled )
+    {
+        return;
+    }
+
     close();
 
-    M_fout = std::fopen( filepath.c_str(), "w" );
+    std::unique_ptr< LogContainerWriter > container( new LogContainerWriter() );
+    if ( container->open( filepath, agent_name ) )
+    {
+        M_container = std::move( container );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Logger::enableFlightRecorder( const int steps,
+                              const std::string & path_prefix )
+{
+    if ( M_disabled )
+    {
+        return;
+    }
+
+    close();
+
+    if ( steps > 0 )
+    {
+        M_flight_recorder.reset( new FlightRecorder( steps, path_prefix ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+Logger::triggerFlightRecorder( const char * reason )
+{
+    if ( ! M_flight_recorder )
+    {
+        return false;
+    }
+
+    char filepath[1024];
+    std::snprintf( filepath, sizeof( filepath ), "%s-%ld-%s.dlog",
+                   M_flight_recorder->path_prefix_.c_str(),
+                   ( M_time ? M_time->cycle() : -1L ),
+                   reason );
+
+    FILE * fout = std::fopen( filepath, "wb" );
+    if ( ! fout )
+    {
+        return false;
+    }
+
+    const bool result = M_flight_recorder->dump( fout );
+    return ( std::fclose( fout ) == 0 && result );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Logger::requestFlightRecorderDump()
+{
+    g_flight_dump_requested.store( true );
 }
 
 /*-------------------------------------------------------------------*/
@@ -199,9 +925,15 @@ Logger::open( const std::string & filepath )
 void
 Logger::openStandardOutput()
 {
+    if ( M_disabled )
+    {
+        return;
+    }
+
     close();
 
     M_fout = stdout;
+    startAsyncWriter();
 }
 
 /*-------------------------------------------------------------------*/
@@ -211,9 +943,15 @@ Logger::openStandardOutput()
 void
 Logger::openStandardError()
 {
+    if ( M_disabled )
+    {
+        return;
+    }
+
     close();
 
     M_fout = stderr;
+    startAsyncWriter();
 }
 
 /*-------------------------------------------------------------------*/
@@ -223,6 +961,31 @@ Logger::openStandardError()
 void
 Logger::flush()
 {
+    if ( M_flight_recorder )
+    {
+        if ( g_flight_dump_requested.exchange( false ) )
+        {
+            triggerFlightRecorder( "signal" );
+        }
+        return;
+    }
+
+    if ( M_async_writer )
+    {
+        M_async_writer->notify();
+        return;
+    }
+
+    if ( M_container && g_thread_safe_buffer.size() > 0 )
+    {
+        // one chunk per flush, that is usually called once per cycle.
+        std::string data = g_thread_safe_buffer.extract();
+        M_container->append( M_time ? M_time->cycle() : 0,
+                             M_time ? M_time->stopped() : 0,
+                             data.data(), data.size() );
+        return;
+    }
+
     if ( M_fout && g_thread_safe_buffer.size() > 0 )
     {
         std::string data = g_thread_safe_buffer.extract();
@@ -243,6 +1006,163 @@ Logger::clear()
     g_thread_safe_buffer.clear();
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+Logger::isRecorded( const std::int32_t level ) const
+{
+    return ( ( M_fout || M_container || M_flight_recorder )
+             && M_time
+             && isCompiled( level )
+             && ( level & M_flags )
+             && M_start_time <= M_time->cycle()
+             && M_time->cycle() <= M_end_time );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Logger::write( const std::int32_t level,
+               const char type,
+               const double * values,
+               const int n_values,
+               const char * color,
+               const char * text,
+               const std::size_t text_size )
+{
+    LogRecord rec;
+    rec.cycle_ = M_time->cycle();
+    rec.stopped_ = M_time->stopped();
+    rec.level_ = level;
+    rec.rgb_[0] = rec.rgb_[1] = rec.rgb_[2] = 0;
+    rec.type_ = type;
+    rec.color_mode_ = ( color ? 'n' : 0 );
+    rec.n_values_ = static_cast< std::uint8_t >( n_values );
+    rec.color_size_ = static_cast< std::uint16_t >( color ? std::min< std::size_t >( std::strlen( color ), 0xffff ) : 0 );
+    set_text_size( text_size, &rec );
+    std::fill( rec.values_, rec.values_ + 6, 0.0 );
+    std::copy( values, values + n_values, rec.values_ );
+
+    if ( M_flight_recorder )
+    {
+        M_flight_recorder->push( rec, color, text );
+        return;
+    }
+
+    if ( M_async_writer )
+    {
+        M_async_writer->push( rec, color, text );
+        return;
+    }
+
+    g_format_buffer.clear();
+    format_record( rec, color, text, g_format_buffer );
+    g_thread_safe_buffer.append( g_format_buffer );
+
+    // Flush if buffer gets too large
+    if ( g_thread_safe_buffer.size() > 8192 * 3 )
+    {
+        flush();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Logger::write( const std::int32_t level,
+               const char type,
+               const double * values,
+               const int n_values,
+               const int r, const int g, const int b,
+               const char * text,
+               const std::size_t text_size )
+{
+    LogRecord rec;
+    rec.cycle_ = M_time->cycle();
+    rec.stopped_ = M_time->stopped();
+    rec.level_ = level;
+    rec.rgb_[0] = r;
+    rec.rgb_[1] = g;
+    rec.rgb_[2] = b;
+    rec.type_ = type;
+    rec.color_mode_ = '#';
+    rec.n_values_ = static_cast< std::uint8_t >( n_values );
+    rec.color_size_ = 0;
+    set_text_size( text_size, &rec );
+    std::fill( rec.values_, rec.values_ + 6, 0.0 );
+    std::copy( values, values + n_values, rec.values_ );
+
+    if ( M_flight_recorder )
+    {
+        M_flight_recorder->push( rec, nullptr, text );
+        return;
+    }
+
+    if ( M_async_writer )
+    {
+        M_async_writer->push( rec, nullptr, text );
+        return;
+    }
+
+    g_format_buffer.clear();
+    format_record( rec, nullptr, text, g_format_buffer );
+    g_thread_safe_buffer.append( g_format_buffer );
+
+    if ( g_thread_safe_buffer.size() > 8192 * 3 )
+    {
+        flush();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+Logger::convertBinaryLog( FILE * in,
+                          FILE * out )
+{
+    char magic[sizeof( BINARY_LOG_MAGIC )];
+    if ( std::fread( magic, 1, sizeof( magic ), in ) != sizeof( magic )
+         || std::memcmp( magic, BINARY_LOG_MAGIC, sizeof( magic ) ) != 0 )
+    {
+        return false;
+    }
+
+    std::vector< char > payload;
+    std::string text;
+
+    LogRecord rec;
+    std::size_t n = 0;
+    while ( ( n = std::fread( &rec, 1, sizeof( LogRecord ), in ) ) == sizeof( LogRecord ) )
+    {
+        if ( rec.n_values_ > 6 )
+        {
+            return false;
+        }
+
+        const std::size_t size = rec.color_size_ + text_size( rec );
+        payload.resize( size + 1 );
+        if ( std::fread( payload.data(), 1, size, in ) != size )
+        {
+            return false;
+        }
+        payload[size] = '\0';
+
+        text.clear();
+        format_record( rec, payload.data(), payload.data() + rec.color_size_, text );
+        std::fwrite( text.data(), 1, text.size(), out );
+    }
+
+    return n == 0;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -252,11 +1172,7 @@ Logger::addText( const std::int32_t level,
                  const char * msg,
                  ... )
 {
-    if ( M_fout
-         && M_time
-         && ( level & M_flags )
-         && M_start_time <= M_time->cycle()
-         && M_time->cycle() <= M_end_time )
+    if ( isRecorded( level ) )
     {
         va_list argp;
         va_start( argp, msg );
@@ -270,20 +1186,7 @@ Logger::addText( const std::int32_t level,
             g_buffer[G_BUFFER_SIZE - 1] = '\0';
         }
 
-        char header[64];
-        snprintf( header, sizeof(header), "%ld,%ld %d M ",
-                  M_time->cycle(),
-                  M_time->stopped(),
-                  level );
-
-        std::string log_entry = header + std::string(g_buffer) + '\n';
-        g_thread_safe_buffer.append(log_entry);
-        
-        // Flush if buffer gets too large
-        if ( g_thread_safe_buffer.size() > 8192 * 3 )
-        {
-            flush();
-        }
+        write( level, 'M', nullptr, 0, nullptr, g_buffer, std::strlen( g_buffer ) );
     }
 }
 
@@ -297,24 +1200,10 @@ Logger::addPoint( const std::int32_t level,
                   const double y,
                   const char * color )
 {
-    if ( M_fout
-         && M_time
-         && ( level & M_flags )
-         && M_start_time <= M_time->cycle()
-         && M_time->cycle() <= M_end_time )
-    {
-        char msg[128];
-        snprintf( msg, 128, "%ld,%ld %d p %.4f %.4f ",
-                  M_time->cycle(),
-                  M_time->stopped(),
-                  level,
-                  x, y );
-        g_thread_safe_buffer.append(msg);
-        if ( color )
-        {
-            g_thread_safe_buffer.append(color);
-        }
-        g_thread_safe_buffer.append("\n");
+    if ( isRecorded( level ) )
+    {
+        const double v[2] = { x, y };
+        write( level, 'p', v, 2, color, nullptr, 0 );
     }
 }
 
@@ -328,21 +1217,10 @@ Logger::addPoint( const std::int32_t level,
                   const double y,
                   const int r, const int g, const int b )
 {
-    if ( M_fout
-         && M_time
-         && ( level & M_flags )
-         && M_start_time <= M_time->cycle()
-         && M_time->cycle() <= M_end_time )
+    if ( isRecorded( level ) )
     {
-        char msg[128];
-        snprintf( msg, 128, "%ld,%ld %d p %.4f %.4f #%02x%02x%02x",
-                  M_time->cycle(),
-                  M_time->stopped(),
-                  level,
-                  x, y,
-                  r, g, b );
-        g_thread_safe_buffer.append(msg);
-        g_thread_safe_buffer.append("\n");
+        const double v[2] = { x, y };
+        write( level, 'p', v, 2, r, g, b, nullptr, 0 );
     }
 }
 
@@ -358,24 +1236,10 @@ Logger::addLine( const std::int32_t level,
                  const double y2,
                  const char * color )
 {
-    if ( M_fout
-         && M_time
-         && ( level & M_flags )
-         && M_start_time <= M_time->cycle()
-         && M_time->cycle() <= M_end_time )
-    {
-        char msg[128];
-        snprintf( msg, 128, "%ld,%ld %d l %.4f %.4f %.4f %.4f ",
-                  M_time->cycle(),
-                  M_time->stopped(),
-                  level,
-                  x1, y1, x2, y2 );
-        g_thread_safe_buffer.append(msg);
-        if ( color )
-        {
-            g_thread_safe_buffer.append(color);
-        }
-        g_thread_safe_buffer.append("\n");
+    if ( isRecorded( level ) )
+    {
+        const double v[4] = { x1, y1, x2, y2 };
+        write( level, 'l', v, 4, color, nullptr, 0 );
     }
 }
 
@@ -391,21 +1255,10 @@ Logger::addLine( const std::int32_t level,
                  const double y2,
                  const int r, const int g, const int b )
 {
-    if ( M_fout
-         && M_time
-         && ( level & M_flags )
-         && M_start_time <= M_time->cycle()
-         && M_time->cycle() <= M_end_time )
+    if ( isRecorded( level ) )
     {
-        char msg[128];
-        snprintf( msg, 128, "%ld,%ld %d l %.4f %.4f %.4f %.4f #%02x%02x%02x",
-                  M_time->cycle(),
-                  M_time->stopped(),
-                  level,
-                  x1, y1, x2, y2,
-                  r, g, b );
-        g_thread_safe_buffer.append(msg);
-        g_thread_safe_buffer.append("\n");
+        const double v[4] = { x1, y1, x2, y2 };
+        write( level, 'l', v, 4, r, g, b, nullptr, 0 );
     }
 }
 
@@ -422,26 +1275,10 @@ Logger::addArc( const std::int32_t level,
                 const double span_angle,
                 const char * color )
 {
-    if ( M_fout
-         && M_time
-         && ( level & M_flags )
-         && M_start_time <= M_time->cycle()
-         && M_time->cycle() <= M_end_time )
-    {
-        char msg[128];
-        snprintf( msg, 128, "%ld,%ld %d a %.4f %.4f %.4f %.4f %.4f ",
-                  M_time->cycle(),
-                  M_time->stopped(),
-                  level,
-                  x, y, radius, start_angle.degree(), span_angle );
-        g_thread_safe_buffer.append(msg);
-
-        if ( color )
-        {
-            g_thread_safe_buffer.append(color);
-        }
-
-        g_thread_safe_buffer.append("\n");
+    if ( isRecorded( level ) )
+    {
+        const double v[5] = { x, y, radius, start_angle.degree(), span_angle };
+        write( level, 'a', v, 5, color, nullptr, 0 );
     }
 }
 
@@ -459,21 +1296,10 @@ Logger::addArc( const std::int32_t level,
                 const double span_angle,
                 const int r, const int g, const int b )
 {
-    if ( M_fout
-         && M_time
-         && ( level & M_flags )
-         && M_start_time <= M_time->cycle()
-         && M_time->cycle() <= M_end_time )
+    if ( isRecorded( level ) )
     {
-        char msg[128];
-        snprintf( msg, 128, "%ld,%ld %d a %.4f %.4f %.4f %.4f %.4f #%02x%02x%02x",
-                  M_time->cycle(),
-                  M_time->stopped(),
-                  level,
-                  x, y, radius, start_angle.degree(), span_angle,
-                  r, g, b );
-        g_thread_safe_buffer.append(msg);
-        g_thread_safe_buffer.append("\n");
+        const double v[5] = { x, y, radius, start_angle.degree(), span_angle };
+        write( level, 'a', v, 5, r, g, b, nullptr, 0 );
     }
 }
 
@@ -489,25 +1315,10 @@ Logger::addCircle( const std::int32_t level,
                    const char * color,
                    const bool fill )
 {
-    if ( M_fout
-         && M_time
-         && ( level & M_flags )
-         && M_start_time <= M_time->cycle()
-         && M_time->cycle() <= M_end_time )
-    {
-        char msg[128];
-        snprintf( msg, 128, "%ld,%ld %d %c %.4f %.4f %.4f ",
-                  M_time->cycle(),
-                  M_time->stopped(),
-                  level,
-                  ( fill ? 'C' : 'c' ),
-                  x, y, radius );
-        g_thread_safe_buffer.append(msg);
-        if ( color )
-        {
-            g_thread_safe_buffer.append(color);
-        }
-        g_thread_safe_buffer.append("\n");
+    if ( isRecorded( level ) )
+    {
+        const double v[3] = { x, y, radius };
+        write( level, ( fill ? 'C' : 'c' ), v, 3, color, nullptr, 0 );
     }
 }
 
@@ -523,22 +1334,10 @@ Logger::addCircle( const std::int32_t level,
                    const int r, const int g, const int b,
                    const bool fill )
 {
-    if ( M_fout
-         && M_time
-         && ( level & M_flags )
-         && M_start_time <= M_time->cycle()
-         && M_time->cycle() <= M_end_time )
+    if ( isRecorded( level ) )
     {
-        char msg[128];
-        snprintf( msg, 128, "%ld,%ld %d %c %.4f %.4f %.4f #%02x%02x%02x",
-                  M_time->cycle(),
-                  M_time->stopped(),
-                  level,
-                  ( fill ? 'C' : 'c' ),
-                  x, y, radius,
-                  r, g, b );
-        g_thread_safe_buffer.append(msg);
-        g_thread_safe_buffer.append("\n");
+        const double v[3] = { x, y, radius };
+        write( level, ( fill ? 'C' : 'c' ), v, 3, r, g, b, nullptr, 0 );
     }
 }
 
@@ -557,25 +1356,10 @@ Logger::addTriangle( const std::int32_t level,
                      const char * color,
                      const bool fill )
 {
-    if ( M_fout
-         && M_time
-         && ( level & M_flags )
-         && M_start_time <= M_time->cycle()
-         && M_time->cycle() <= M_end_time )
-    {
-        char msg[128];
-        snprintf( msg, 128, "%ld,%ld %d %c %.4f %.4f %.4f %.4f %.4f %.4f ",
-                  M_time->cycle(),
-                  M_time->stopped(),
-                  level,
-                  ( fill ? 'T' : 't' ),
-                  x1, y1, x2, y2, x3, y3 );
-        g_thread_safe_buffer.append(msg);
-        if ( color )
-        {
-            g_thread_safe_buffer.append(color);
-        }
-        g_thread_safe_buffer.append("\n");
+    if ( isRecorded( level ) )
+    {
+        const double v[6] = { x1, y1, x2, y2, x3, y3 };
+        write( level, ( fill ? 'T' : 't' ), v, 6, color, nullptr, 0 );
     }
 }
 
@@ -594,22 +1378,10 @@ Logger::addTriangle( const std::int32_t level,
                      const int r, const int g, const int b,
                      const bool fill )
 {
-    if ( M_fout
-         && M_time
-         && ( level & M_flags )
-         && M_start_time <= M_time->cycle()
-         && M_time->cycle() <= M_end_time )
+    if ( isRecorded( level ) )
     {
-        char msg[128];
-        snprintf( msg, 128, "%ld,%ld %d %c %.4f %.4f %.4f %.4f %.4f %.4f #%02x%02x%02x",
-                  M_time->cycle(),
-                  M_time->stopped(),
-                  level,
-                  ( fill ? 'T' : 't' ),
-                  x1, y1, x2, y2, x3, y3,
-                  r, g, b );
-        g_thread_safe_buffer.append(msg);
-        g_thread_safe_buffer.append("\n");
+        const double v[6] = { x1, y1, x2, y2, x3, y3 };
+        write( level, ( fill ? 'T' : 't' ), v, 6, r, g, b, nullptr, 0 );
     }
 }
 
@@ -626,25 +1398,10 @@ Logger::addRect( const std::int32_t level,
                  const char * color,
                  const bool fill )
 {
-    if ( M_fout
-         && M_time
-         && ( level & M_flags )
-         && M_start_time <= M_time->cycle()
-         && M_time->cycle() <= M_end_time )
-    {
-        char msg[128];
-        snprintf( msg, 128, "%ld,%ld %d %c %.4f %.4f %.4f %.4f ",
-                  M_time->cycle(),
-                  M_time->stopped(),
-                  level,
-                  ( fill ? 'R' : 'r' ),
-                  left, top, length, width );
-        g_thread_safe_buffer.append(msg);
-        if ( color )
-        {
-            g_thread_safe_buffer.append(color);
-        }
-        g_thread_safe_buffer.append("\n");
+    if ( isRecorded( level ) )
+    {
+        const double v[4] = { left, top, length, width };
+        write( level, ( fill ? 'R' : 'r' ), v, 4, color, nullptr, 0 );
     }
 }
 
@@ -661,22 +1418,10 @@ Logger::addRect( const std::int32_t level,
                  const int r, const int g, const int b,
                  const bool fill )
 {
-    if ( M_fout
-         && M_time
-         && ( level & M_flags )
-         && M_start_time <= M_time->cycle()
-         && M_time->cycle() <= M_end_time )
+    if ( isRecorded( level ) )
     {
-        char msg[128];
-        snprintf( msg, 128, "%ld,%ld %d %c %.4f %.4f %.4f %.4f #%02x%02x%02x",
-                  M_time->cycle(),
-                  M_time->stopped(),
-                  level,
-                  ( fill ? 'R' : 'r' ),
-                  left, top, length, width,
-                  r, g, b );
-        g_thread_safe_buffer.append(msg);
-        g_thread_safe_buffer.append("\n");
+        const double v[4] = { left, top, length, width };
+        write( level, ( fill ? 'R' : 'r' ), v, 4, r, g, b, nullptr, 0 );
     }
 }
 
@@ -695,26 +1440,11 @@ Logger::addSector( const std::int32_t level,
                    const char * color,
                    const bool fill )
 {
-    if ( M_fout
-         && M_time
-         && ( level & M_flags )
-         && M_start_time <= M_time->cycle()
-         && M_time->cycle() <= M_end_time )
-    {
-        char msg[128];
-        snprintf( msg, 128, "%ld,%ld %d %c %.4f %.4f %.4f %.4f %.4f %.4f ",
-                  M_time->cycle(),
-                  M_time->stopped(),
-                  level,
-                  ( fill ? 'S' : 's' ),
-                  x, y, min_radius, max_radius,
-                  start_angle.degree(), span_angle );
-        g_thread_safe_buffer.append(msg);
-        if ( color )
-        {
-            g_thread_safe_buffer.append(color);
-        }
-        g_thread_safe_buffer.append("\n");
+    if ( isRecorded( level ) )
+    {
+        const double v[6] = { x, y, min_radius, max_radius,
+                              start_angle.degree(), span_angle };
+        write( level, ( fill ? 'S' : 's' ), v, 6, color, nullptr, 0 );
     }
 }
 
@@ -733,23 +1463,11 @@ Logger::addSector( const std::int32_t level,
                    const int r, const int g, const int b,
                    const bool fill )
 {
-    if ( M_fout
-         && M_time
-         && ( level & M_flags )
-         && M_start_time <= M_time->cycle()
-         && M_time->cycle() <= M_end_time )
+    if ( isRecorded( level ) )
     {
-        char msg[128];
-        snprintf( msg, 128, "%ld,%ld %d %c %.4f %.4f %.4f %.4f %.4f %.4f #%02x%02x%02x",
-                  M_time->cycle(),
-                  M_time->stopped(),
-                  level,
-                  ( fill ? 'S' : 's' ),
-                  x, y, min_radius, max_radius,
-                  start_angle.degree(), span_angle,
-                  r, g, b );
-        g_thread_safe_buffer.append(msg);
-        g_thread_safe_buffer.append("\n");
+        const double v[6] = { x, y, min_radius, max_radius,
+                              start_angle.degree(), span_angle };
+        write( level, ( fill ? 'S' : 's' ), v, 6, r, g, b, nullptr, 0 );
     }
 }
 
@@ -763,30 +1481,15 @@ Logger::addSector( const std::int32_t level,
                    const char * color,
                    const bool fill )
 {
-    if ( M_fout
-         && M_time
-         && ( level & M_flags )
-         && M_start_time <= M_time->cycle()
-         && M_time->cycle() <= M_end_time )
+    if ( isRecorded( level ) )
     {
-        char msg[128];
         double span_angle = ( sector.angleLeftStart().isLeftOf( sector.angleRightEnd() )
                               ? ( sector.angleLeftStart() - sector.angleRightEnd() ).abs()
                               : 360.0 - ( sector.angleLeftStart() - sector.angleRightEnd() ).abs() );
-        snprintf( msg, 128, "%ld,%ld %d %c %.4f %.4f %.4f %.4f %.4f %.4f ",
-                  M_time->cycle(),
-                  M_time->stopped(),
-                  level,
-                  ( fill ? 'S' : 's' ),
-                  sector.center().x, sector.center().y,
-                  sector.radiusMin(), sector.radiusMax(),
-                  sector.angleLeftStart().degree(), span_angle );
-        g_thread_safe_buffer.append(msg);
-        if ( color )
-        {
-            g_thread_safe_buffer.append(color);
-        }
-        g_thread_safe_buffer.append("\n");
+        const double v[6] = { sector.center().x, sector.center().y,
+                              sector.radiusMin(), sector.radiusMax(),
+                              sector.angleLeftStart().degree(), span_angle };
+        write( level, ( fill ? 'S' : 's' ), v, 6, color, nullptr, 0 );
     }
 }
 
@@ -800,27 +1503,15 @@ Logger::addSector( const std::int32_t level,
                    const int r, const int g, const int b,
                    const bool fill )
 {
-    if ( M_fout
-         && M_time
-         && ( level & M_flags )
-         && M_start_time <= M_time->cycle()
-         && M_time->cycle() <= M_end_time )
+    if ( isRecorded( level ) )
     {
-        char msg[128];
         double span_angle = ( sector.angleLeftStart().isLeftOf( sector.angleRightEnd() )
                               ? ( sector.angleLeftStart() - sector.angleRightEnd() ).abs()
                               : 360.0 - ( sector.angleLeftStart() - sector.angleRightEnd() ).abs() );
-        snprintf( msg, 128, "%ld,%ld %d %c %.4f %.4f %.4f %.4f %.4f %.4f #%02x%02x%02x",
-                  M_time->cycle(),
-                  M_time->stopped(),
-                  level,
-                  ( fill ? 'S' : 's' ),
-                  sector.center().x, sector.center().y,
-                  sector.radiusMin(), sector.radiusMax(),
-                  sector.angleLeftStart().degree(), span_angle,
-                  r, g, b );
-        g_thread_safe_buffer.append(msg);
-        g_thread_safe_buffer.append("\n");
+        const double v[6] = { sector.center().x, sector.center().y,
+                              sector.radiusMin(), sector.radiusMax(),
+                              sector.angleLeftStart().degree(), span_angle };
+        write( level, ( fill ? 'S' : 's' ), v, 6, r, g, b, nullptr, 0 );
     }
 }
 
@@ -835,29 +1526,10 @@ Logger::addMessage( const std::int32_t level,
                     const char * msg,
                     const char * color )
 {
-    if ( M_fout
-         && M_time
-         && ( level & M_flags )
-         && M_start_time <= M_time->cycle()
-         && M_time->cycle() <= M_end_time )
-    {
-        char header[128];
-        snprintf( header, 128, "%ld,%ld %d m %.4f %.4f ",
-                  M_time->cycle(),
-                  M_time->stopped(),
-                  level,
-                  x, y );
-        g_thread_safe_buffer.append(header);
-
-        if ( color )
-        {
-            g_thread_safe_buffer.append("(c ");
-            g_thread_safe_buffer.append(color);
-            g_thread_safe_buffer.append(") ");
-        }
-
-        g_thread_safe_buffer.append(msg);
-        g_thread_safe_buffer.append("\n");
+    if ( isRecorded( level ) )
+    {
+        const double v[2] = { x, y };
+        write( level, 'm', v, 2, color, msg, std::strlen( msg ) );
     }
 }
 
@@ -872,28 +1544,48 @@ Logger::addMessage( const std::int32_t level,
                     const char * msg,
                     const int r, const int g, const int b )
 {
-    if ( M_fout
-         && M_time
-         && ( level & M_flags )
-         && M_start_time <= M_time->cycle()
-         && M_time->cycle() <= M_end_time )
-    {
-        char header[128];
-        snprintf( header, 128, "%ld,%ld %d m %.4f %.4f ",
-                  M_time->cycle(),
-                  M_time->stopped(),
-                  level,
-                  x, y );
-        g_thread_safe_buffer.append(header);
-
-        char col[8];
-        snprintf( col, 8, "#%02x%02x%02x", r, g, b );
-        g_thread_safe_buffer.append("(c ");
-        g_thread_safe_buffer.append(col);
-        g_thread_safe_buffer.append(") ");
-
-        g_thread_safe_buffer.append(msg);
-        g_thread_safe_buffer.append("\n");
+    if ( isRecorded( level ) )
+    {
+        const double v[2] = { x, y };
+        write( level, 'm', v, 2, r, g, b, msg, std::strlen( msg ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Logger::addGrid( const std::int32_t level,
+                 const Rect2D & area,
+                 const int cols,
+                 const int rows,
+                 const float * values,
+                 const double min_value,
+                 const double max_value )
+{
+    if ( isRecorded( level ) )
+    {
+        addGrid( level, area, DebugGrid( cols, rows, values, min_value, max_value ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Logger::addGrid( const std::int32_t level,
+                 const Rect2D & area,
+                 const DebugGrid & grid )
+{
+    if ( isRecorded( level ) )
+    {
+        g_grid_buffer.clear();
+        grid.encode( M_grid_compression_level, &g_grid_buffer );
+
+        const double v[4] = { area.left(), area.top(), area.size().length(), area.size().width() };
+        write( level, 'G', v, 4, nullptr, g_grid_buffer.data(), g_grid_buffer.size() );
     }
 }
 
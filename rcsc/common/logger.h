@@ -38,17 +38,65 @@
 #include <rcsc/geom/sector_2d.h>
 #include <rcsc/geom/triangle_2d.h>
 
+#include <memory>
 #include <string>
 #include <cstdio>
 #include <cstdint>
 
+/*!
+  \def RCSC_DLOG_STRIPPED_LEVELS
+  \brief bit set of the log levels removed at compile time.
+
+  The records whose level has no bit other than these levels are never written,
+  and the RCSC_DLOG_TEXT() call sites with such a constant level are removed
+  by the compiler. The value is given by the build option
+  (CMake: LIBRCSC_DLOG_STRIPPED_LEVELS, configure: --with-dlog-stripped-levels).
+  The same value should be defined when the agent programs are built.
+*/
+#ifndef RCSC_DLOG_STRIPPED_LEVELS
+#define RCSC_DLOG_STRIPPED_LEVELS 0
+#endif
+
+/*!
+  \def RCSC_DLOG_TEXT
+  \brief call dlog.addText() only if the level is enabled.
+  The message arguments are not evaluated if the level is disabled or stripped.
+*/
+#define RCSC_DLOG_TEXT( level, ... )                                  \
+    do {                                                              \
+        if ( rcsc::dlog.isEnabled( level ) )                          \
+        {                                                             \
+            rcsc::dlog.addText( level, __VA_ARGS__ );                 \
+        }                                                             \
+    } while ( 0 )
+
 namespace rcsc {
 
+class DebugGrid;
 class GameTime;
+class LogContainerWriter;
 
 /*!
   \class Logger
   \brief log output manager
+
+  In the default synchronous mode, each record is formatted to text in the
+  caller thread and written to the file by flush().
+  In the asynchronous mode, the caller thread only copies a fixed size binary
+  record into its own single producer single consumer ring, and a background
+  writer thread formats the records to text or dumps them as a binary log.
+  The binary log can be expanded to the text format by convertBinaryLog()
+  (see the dlog2txt tool).
+
+  openContainer() makes the agents of a match share one container file
+  instead of writing one text file per agent (see LogContainer). Each
+  flush() appends the buffered text as one compressed chunk. The write mode
+  is ignored in this case and the records are formatted in the caller thread.
+
+  In the flight recorder mode (enableFlightRecorder()), the records of the
+  last N game steps are kept in memory as binary records and nothing is
+  written until triggerFlightRecorder() is called. The dumped file has the
+  same format as the ASYNC_BINARY log.
 */
 class Logger {
 public:
@@ -92,7 +140,7 @@ public:
     Line := <Time> <Level> <Type> <Content>
     Time := integer value
     Level := integer value
-    Type :=  M | p | l | a | c | C | t | T | r | R | s | m
+    Type :=  M | p | l | a | c | C | t | T | r | R | s | m | G
         M : log message for text viewer
         p : point
         l: line
@@ -106,6 +154,7 @@ public:
         s: sector
         S: filled sector
         m: message painted on the field
+        G: value grid painted on the field
     Text := <Str>
     Point := <x:Real> <y:Real>[ <Color>]
     Line := <x1:Real> <y1:Real> <x2:Real> <y2:Real>[ <Color>]
@@ -115,6 +164,8 @@ public:
     Rectangle := <leftX:Real> <topY:Real> <width:Real> <height:Real>[ <Color>]
     Sector := <x:Real> <y:Real> <minR:Real> <maxR:Real> <startAngle:Real> <spanAngle:Real>[ <Color>]
     Message := <x:Real> <y:Real>[ (c <Color>)] <Str>
+    Grid := <leftX:Real> <topY:Real> <width:Real> <height:Real> <Payload>
+    Payload := the payload text of DebugGrid
     **************************************************/
 
     static const std::int32_t SYSTEM    = LEVEL_01; //!< log level definition alias
@@ -144,8 +195,21 @@ public:
 
     static const std::int32_t LEVEL_ANY = 0xffffffff; //!< log level definition variable
 
+    /*!
+      \enum WriteMode
+      \brief output mode of the log records
+     */
+    enum WriteMode {
+        SYNC_TEXT, //!< format in the caller thread, write by flush()
+        ASYNC_TEXT, //!< format and write in the writer thread
+        ASYNC_BINARY, //!< write the binary records in the writer thread
+    };
+
 private:
 
+    struct AsyncWriter;
+    struct FlightRecorder;
+
     //! const pointer to GameTime instance
     const GameTime * M_time;
 
@@ -158,6 +222,24 @@ private:
     int M_start_time;
     int M_end_time;
 
+    //! output mode
+    WriteMode M_write_mode;
+
+    //! zlib compression level of the grid payload. 0 means no compression.
+    int M_grid_compression_level;
+
+    //! background writer. nullptr in the synchronous mode.
+    std::unique_ptr< AsyncWriter > M_async_writer;
+
+    //! shared container output. nullptr if the ordinary file is used.
+    std::unique_ptr< LogContainerWriter > M_container;
+
+    //! in-memory ring of the latest records. nullptr if disabled.
+    std::unique_ptr< FlightRecorder > M_flight_recorder;
+
+    //! true if the output and the log flags are locked off. see disable().
+    bool M_disabled;
+
 public:
     /*!
       \brief allocate message buffer memory
@@ -187,6 +269,61 @@ public:
     void setTimeRange( const int start_time,
                        const int end_time );
 
+    /*!
+      \brief close the output and clear the log flags. After this call, the
+      methods that open the output or change the log flags are ignored.
+
+      The records are formatted into the buffers shared in the process, so
+      one logger instance cannot serve the agents running in the same process
+      (see TeamRunner). This method must be called before the agent threads
+      are started.
+     */
+    void disable();
+
+    /*!
+      \brief check if the logger is disabled by disable()
+      \return true if disabled
+     */
+    bool isDisabled() const
+      {
+          return M_disabled;
+      }
+
+    /*!
+      \brief set the output mode.
+      \param mode new mode
+
+      This method should be called before open().
+      If the file is already opened, the stored records are flushed and
+      the writer thread is restarted for the new mode.
+      ASYNC_BINARY writes the file header only when the writer thread is started.
+     */
+    void setWriteMode( const WriteMode mode );
+
+    /*!
+      \brief get the output mode
+      \return output mode
+     */
+    WriteMode writeMode() const
+      {
+          return M_write_mode;
+      }
+
+    /*!
+      \brief set the compression level of the grid records
+      \param level zlib compression level [1,9]. 0 disables the compression.
+     */
+    void setGridCompressionLevel( const int level );
+
+    /*!
+      \brief get the compression level of the grid records
+      \return zlib compression level. 0 means no compression.
+     */
+    int gridCompressionLevel() const
+      {
+          return M_grid_compression_level;
+      }
+
     /*!
       \brief check if the level is enabled
       \param level checked log level
@@ -194,7 +331,18 @@ public:
      */
     bool isEnabled( const std::int32_t level ) const
       {
-          return ( level & M_flags );
+          return isCompiled( level ) && ( level & M_flags );
+      }
+
+    /*!
+      \brief check if the level is not stripped by RCSC_DLOG_STRIPPED_LEVELS
+      \param level checked log level
+      \return false if the level is stripped at compile time
+     */
+    static constexpr
+    bool isCompiled( const std::int32_t level )
+      {
+          return ( level & ~static_cast< std::int32_t >( RCSC_DLOG_STRIPPED_LEVELS ) ) != 0;
       }
 
     /*!
@@ -203,6 +351,47 @@ public:
      */
     void open( const std::string & filepath );
 
+    /*!
+      \brief open the container file shared by several agents
+      \param filepath container file path
+      \param agent_name the name that identifies this agent in the container
+     */
+    void openContainer( const std::string & filepath,
+                        const std::string & agent_name );
+
+    /*!
+      \brief keep the records of the latest game steps in memory instead of
+      writing them to the file. The opened file is closed.
+      \param steps the number of game steps kept in memory. 0 disables the recorder.
+      \param path_prefix path prefix of the dumped files
+     */
+    void enableFlightRecorder( const int steps,
+                               const std::string & path_prefix );
+
+    /*!
+      \brief check if the flight recorder mode is enabled
+      \return true if the flight recorder mode is enabled
+     */
+    bool isFlightRecorderEnabled() const
+      {
+          return static_cast< bool >( M_flight_recorder );
+      }
+
+    /*!
+      \brief write the records kept by the flight recorder to
+      "<path_prefix>-<cycle>-<reason>.dlog". The records are kept after the dump.
+      \param reason short tag used in the file name
+      \return false if the recorder is disabled or the file cannot be written
+     */
+    bool triggerFlightRecorder( const char * reason );
+
+    /*!
+      \brief request the dump of the flight recorder at the next flush().
+      This method is async-signal-safe, so it can be called from a signal handler.
+     */
+    static
+    void requestFlightRecorderDump();
+
     /*!
       \brief use standard output to record
      */
@@ -224,11 +413,19 @@ public:
      */
     bool isOpen()
       {
-          return ( M_fout != NULL );
+          return ( M_fout != NULL || M_container || M_flight_recorder );
       }
 
     /*!
-      \brief flush stored message
+      \brief get the heap bytes held by the message buffer and the
+      asynchronous writer rings
+      \return bytes
+     */
+    std::size_t memoryUsage() const;
+
+    /*!
+      \brief flush stored message.
+      In the asynchronous mode, this method only wakes up the writer thread.
     */
     void flush();
 
@@ -959,6 +1156,102 @@ public:
                       r, g, b );
       }
 
+    /*!
+      \brief add the quantized value grid to the buffer. message tag 'G'
+      \param level log level variable
+      \param area the area covered by the grid
+      \param cols the number of columns
+      \param rows the number of rows
+      \param values cols * rows values in the row major order. the first row is the top of the area.
+      \param min_value the value painted as the lowest color
+      \param max_value the value painted as the highest color
+
+      The values are quantized to 8 bits and written as one record.
+     */
+    void addGrid( const std::int32_t level,
+                  const Rect2D & area,
+                  const int cols,
+                  const int rows,
+                  const float * values,
+                  const double min_value,
+                  const double max_value );
+
+    /*!
+      \brief add the quantized value grid to the buffer. message tag 'G'
+      \param level log level variable
+      \param area the area covered by the grid
+      \param grid quantized values
+     */
+    void addGrid( const std::int32_t level,
+                  const Rect2D & area,
+                  const DebugGrid & grid );
+
+    /*!
+      \brief expand the binary log written in ASYNC_BINARY mode to the text format.
+      \param in input binary log stream
+      \param out output text stream
+      \return false if the input is not a binary log or is broken
+     */
+    static
+    bool convertBinaryLog( FILE * in,
+                           FILE * out );
+
+private:
+
+    /*!
+      \brief check if the record with the given level should be written now
+      \param level log level
+      \return checked result
+     */
+    bool isRecorded( const std::int32_t level ) const;
+
+    /*!
+      \brief write or enqueue one record
+      \param level log level
+      \param type record tag character
+      \param values record coordinate values
+      \param n_values the number of values
+      \param color color name string. may be NULL.
+      \param text message string. may be NULL.
+      \param text_size the length of text
+     */
+    void write( const std::int32_t level,
+                const char type,
+                const double * values,
+                const int n_values,
+                const char * color,
+                const char * text,
+                const std::size_t text_size );
+
+    /*!
+      \brief write or enqueue one record with the RGB color
+      \param level log level
+      \param type record tag character
+      \param values record coordinate values
+      \param n_values the number of values
+      \param r red value
+      \param g green value
+      \param b blue value
+      \param text message string. may be NULL.
+      \param text_size the length of text
+     */
+    void write( const std::int32_t level,
+                const char type,
+                const double * values,
+                const int n_values,
+                const int r, const int g, const int b,
+                const char * text,
+                const std::size_t text_size );
+
+    /*!
+      \brief start the writer thread for the current mode if needed
+     */
+    void startAsyncWriter();
+
+    /*!
+      \brief stop the writer thread after writing all queued records
+     */
+    void stopAsyncWriter();
 };
 
 //! global variable
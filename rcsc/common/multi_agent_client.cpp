@@ -0,0 +1,320 @@
+// -*-c++-*-
+
+/*!
+  \file multi_agent_client.cpp
+  \brief event driven client that runs several agents in one process Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "multi_agent_client.h"
+
+#include "online_client.h"
+#include "soccer_agent.h"
+
+#include <rcsc/net/udp_socket.h>
+
+#include <iostream>
+#include <cstdint>
+#include <cstdio>
+#include <cerrno>
+#include <cassert>
+
+#if defined(HAVE_SYS_EPOLL_H) && defined(HAVE_SYS_TIMERFD_H)
+#define RCSC_USE_EPOLL
+#include <unistd.h> // close(), read()
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#endif
+
+namespace rcsc {
+
+#ifdef RCSC_USE_EPOLL
+namespace {
+
+//! the number of events read by one epoll_wait() call
+constexpr int MAX_EVENTS = 64;
+
+/*!
+  \brief encode the entry index and the fd type into the epoll user data.
+ */
+inline
+std::uint64_t
+event_key( const std::size_t index,
+           const bool timer )
+{
+    return ( static_cast< std::uint64_t >( index ) << 1 ) | ( timer ? 1 : 0 );
+}
+
+}
+#endif
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+MultiAgentClient::MultiAgentClient()
+    : M_epoll_fd( -1 )
+{
+#ifdef RCSC_USE_EPOLL
+    M_epoll_fd = ::epoll_create1( EPOLL_CLOEXEC );
+    if ( M_epoll_fd == -1 )
+    {
+        perror( "epoll_create1" );
+    }
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+MultiAgentClient::~MultiAgentClient()
+{
+#ifdef RCSC_USE_EPOLL
+    for ( Entry & e : M_entries )
+    {
+        if ( e.timer_fd_ != -1 )
+        {
+            ::close( e.timer_fd_ );
+        }
+    }
+
+    if ( M_epoll_fd != -1 )
+    {
+        ::close( M_epoll_fd );
+    }
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+MultiAgentClient::add( SoccerAgent * agent,
+                       std::shared_ptr< OnlineClient > client )
+{
+#ifdef RCSC_USE_EPOLL
+    if ( M_epoll_fd == -1
+         || ! agent
+         || ! client )
+    {
+        std::cerr << "(MultiAgentClient::add) ***ERROR*** illegal agent or client."
+                  << std::endl;
+        return false;
+    }
+
+    const int timer_fd = ::timerfd_create( CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC );
+    if ( timer_fd == -1 )
+    {
+        perror( "timerfd_create" );
+        return false;
+    }
+
+    const std::size_t index = M_entries.size();
+
+    // the socket is registered in run(), because it is created by handleStart().
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.u64 = event_key( index, true );
+    if ( ::epoll_ctl( M_epoll_fd, EPOLL_CTL_ADD, timer_fd, &ev ) == -1 )
+    {
+        perror( "epoll_ctl" );
+        ::close( timer_fd );
+        return false;
+    }
+
+    M_entries.push_back( Entry{ agent, client, timer_fd, 0, 0, false } );
+    return true;
+#else
+    (void)agent;
+    (void)client;
+    std::cerr << "(MultiAgentClient::add) ***ERROR*** epoll is not supported."
+              << std::endl;
+    return false;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MultiAgentClient::run()
+{
+#ifdef RCSC_USE_EPOLL
+    std::size_t running_count = 0;
+
+    for ( std::size_t i = 0; i < M_entries.size(); ++i )
+    {
+        Entry & e = M_entries[i];
+        if ( ! e.client_->handleStart( e.agent_ )
+             || ! e.client_->isServerAlive()
+             || ! e.client_->M_socket
+             || e.client_->M_socket->fd() == -1 )
+        {
+            e.running_ = true;
+            exitAgent( e );
+            continue;
+        }
+
+        struct epoll_event ev;
+        ev.events = EPOLLIN;
+        ev.data.u64 = event_key( i, false );
+        if ( ::epoll_ctl( M_epoll_fd, EPOLL_CTL_ADD, e.client_->M_socket->fd(), &ev ) == -1 )
+        {
+            perror( "epoll_ctl" );
+            e.running_ = true;
+            exitAgent( e );
+            continue;
+        }
+
+        e.running_ = true;
+        e.timeout_count_ = 0;
+        e.waited_msec_ = 0;
+        armTimer( e );
+        ++running_count;
+    }
+
+    struct epoll_event events[MAX_EVENTS];
+
+    while ( running_count > 0 )
+    {
+        const int n = ::epoll_wait( M_epoll_fd, events, MAX_EVENTS, -1 );
+        if ( n < 0 )
+        {
+            if ( errno == EINTR )
+            {
+                continue;
+            }
+            perror( "epoll_wait" );
+            break;
+        }
+
+        for ( int i = 0; i < n; ++i )
+        {
+            Entry & e = M_entries[events[i].data.u64 >> 1];
+            const bool timer = ( events[i].data.u64 & 1 );
+
+            if ( ! e.running_ )
+            {
+                continue;
+            }
+
+            if ( timer )
+            {
+                std::uint64_t expirations = 0;
+                if ( ::read( e.timer_fd_, &expirations, sizeof( expirations ) ) != sizeof( expirations )
+                     || expirations == 0 )
+                {
+                    // the timer has been rearmed after this event was queued.
+                    continue;
+                }
+
+                // no meesage. timeout.
+                e.waited_msec_ += e.client_->intervalMSec() * static_cast< int >( expirations );
+                e.timeout_count_ += static_cast< int >( expirations );
+                e.client_->handleTimeout( e.agent_, e.timeout_count_, e.waited_msec_ );
+            }
+            else
+            {
+                // received message, reset wait time
+                e.waited_msec_ = 0;
+                e.timeout_count_ = 0;
+                armTimer( e );
+                e.client_->handleMessage( e.agent_ );
+            }
+
+            if ( ! e.client_->isServerAlive() )
+            {
+                exitAgent( e );
+                --running_count;
+            }
+        }
+    }
+
+    for ( Entry & e : M_entries )
+    {
+        exitAgent( e );
+    }
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MultiAgentClient::armTimer( Entry & entry )
+{
+#ifdef RCSC_USE_EPOLL
+    const int msec = entry.client_->intervalMSec();
+
+    struct itimerspec spec;
+    spec.it_interval.tv_sec = msec / 1000;
+    spec.it_interval.tv_nsec = ( msec % 1000 ) * 1000 * 1000;
+    spec.it_value = spec.it_interval;
+
+    if ( ::timerfd_settime( entry.timer_fd_, 0, &spec, nullptr ) == -1 )
+    {
+        perror( "timerfd_settime" );
+    }
+#else
+    (void)entry;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MultiAgentClient::exitAgent( Entry & entry )
+{
+#ifdef RCSC_USE_EPOLL
+    if ( ! entry.running_ )
+    {
+        return;
+    }
+    entry.running_ = false;
+
+    if ( entry.client_->M_socket )
+    {
+        ::epoll_ctl( M_epoll_fd, EPOLL_CTL_DEL, entry.client_->M_socket->fd(), nullptr );
+    }
+    ::epoll_ctl( M_epoll_fd, EPOLL_CTL_DEL, entry.timer_fd_, nullptr );
+
+    entry.client_->handleExit( entry.agent_ );
+#else
+    (void)entry;
+#endif
+}
+
+}
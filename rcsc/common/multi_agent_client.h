@@ -0,0 +1,141 @@
+// -*-c++-*-
+
+/*!
+  \file multi_agent_client.h
+  \brief event driven client that runs several agents in one process Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_COMMON_MULTI_AGENT_CLIENT_H
+#define RCSC_COMMON_MULTI_AGENT_CLIENT_H
+
+#include <memory>
+#include <vector>
+
+namespace rcsc {
+
+class OnlineClient;
+class SoccerAgent;
+
+/*!
+  \class MultiAgentClient
+  \brief event loop that multiplexes several agents over their own sockets.
+
+  Each agent keeps its own OnlineClient (and its own UDP socket).
+  All sockets and one timer fd for each agent are registered to one epoll
+  instance, so the process sleeps in one epoll_wait() regardless of the
+  number of agents.
+  The timer of each agent is rearmed by every received message, so the
+  timeout events are same as OnlineClient::run().
+
+  All agents are processed by the calling thread, because ServerParam,
+  PlayerParam and the debug logger are process-wide instances shared by
+  the agents.
+
+  This class is available only if sys/epoll.h and sys/timerfd.h are found.
+ */
+class MultiAgentClient {
+private:
+
+    //! registered agent
+    struct Entry {
+        SoccerAgent * agent_; //!< agent instance
+        std::shared_ptr< OnlineClient > client_; //!< connection of the agent
+        int timer_fd_; //!< timeout timer
+        int timeout_count_; //!< the number of timeouts since the last message
+        int waited_msec_; //!< elapsed time since the last message
+        bool running_; //!< true while the agent is in the loop
+    };
+
+    //! epoll instance
+    int M_epoll_fd;
+
+    //! registered agents
+    std::vector< Entry > M_entries;
+
+    // nocopyable
+    MultiAgentClient( const MultiAgentClient & ) = delete;
+    MultiAgentClient & operator=( const MultiAgentClient & ) = delete;
+
+public:
+
+    /*!
+      \brief create an epoll instance.
+     */
+    MultiAgentClient();
+
+    /*!
+      \brief close all timer fds and the epoll instance.
+     */
+    ~MultiAgentClient();
+
+    /*!
+      \brief register the agent and its client.
+      \param agent pointer to the agent initialized with the client.
+      \param client client used by the agent. the connection is created by
+      the agent's handleStart() in run().
+      \return true if successfully registered.
+     */
+    bool add( SoccerAgent * agent,
+              std::shared_ptr< OnlineClient > client );
+
+    /*!
+      \brief get the number of registered agents
+      \return the number of agents
+     */
+    std::size_t size() const
+      {
+          return M_entries.size();
+      }
+
+    /*!
+      \brief program mainloop.
+
+      handleStart() is called for all agents, then the loop continues
+      while at least one server connection is alive.
+      When the server of an agent is not alive, handleExit() is called for
+      the agent and its fds are removed from the epoll instance.
+     */
+    void run();
+
+private:
+
+    /*!
+      \brief restart the timeout timer of the entry.
+      \param entry target entry
+     */
+    void armTimer( Entry & entry );
+
+    /*!
+      \brief call handleExit() and unregister the fds of the entry.
+      \param entry target entry
+     */
+    void exitAgent( Entry & entry );
+};
+
+}
+
+#endif
@@ -37,18 +37,103 @@
 
 #include "soccer_agent.h"
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <cstring>
+#include <cstdlib>
 #include <cassert>
 
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 namespace rcsc {
 
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief load the whole file as read-only memory
+  \param file_path file path to read
+  \param size pointer to the variable to store the file size
+  \return pointer to the data. NULL if failed.
+ */
+std::shared_ptr< const char >
+load_binary_file( const std::string & file_path,
+                  std::size_t * size )
+{
+#ifdef HAVE_SYS_MMAN_H
+    const int fd = ::open( file_path.c_str(), O_RDONLY );
+    if ( fd < 0 )
+    {
+        return std::shared_ptr< const char >();
+    }
+
+    struct stat st;
+    if ( ::fstat( fd, &st ) != 0
+         || st.st_size <= 0 )
+    {
+        ::close( fd );
+        return std::shared_ptr< const char >();
+    }
+
+    const std::size_t length = static_cast< std::size_t >( st.st_size );
+    void * addr = ::mmap( nullptr, length, PROT_READ, MAP_SHARED, fd, 0 );
+    ::close( fd );
+
+    if ( addr == MAP_FAILED )
+    {
+        return std::shared_ptr< const char >();
+    }
+
+    *size = length;
+    return std::shared_ptr< const char >( static_cast< const char * >( addr ),
+                                          [length]( const char * p )
+                                            {
+                                                ::munmap( const_cast< char * >( p ), length );
+                                            } );
+#else
+    std::ifstream fin( file_path.c_str(), std::ios::binary | std::ios::ate );
+    if ( ! fin.is_open() )
+    {
+        return std::shared_ptr< const char >();
+    }
+
+    const std::streamsize length = fin.tellg();
+    if ( length <= 0 )
+    {
+        return std::shared_ptr< const char >();
+    }
+
+    char * buf = new char[length];
+    fin.seekg( 0 );
+    if ( ! fin.read( buf, length ) )
+    {
+        delete [] buf;
+        return std::shared_ptr< const char >();
+    }
+
+    *size = static_cast< std::size_t >( length );
+    return std::shared_ptr< const char >( buf, std::default_delete< const char[] >() );
+#endif
+}
+
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
 */
 OfflineClient::OfflineClient()
-    : AbstractClient()
+    : AbstractClient(),
+      M_size( 0 ),
+      M_pos( 0 ),
+      M_fast_forward_cycle( -1 ),
+      M_fast_forward_offset( 0 )
 {
 
 }
@@ -113,13 +198,25 @@ OfflineClient::sendMessage( const char * /*msg*/ )
 int
 OfflineClient::receiveMessage()
 {
-    while ( std::getline( M_offline_in, M_received_message ) )
+    const char * data = M_data.get();
+
+    while ( M_pos < M_size )
     {
-        if ( M_received_message.empty() )
+        const char * begin = data + M_pos;
+        const char * end = static_cast< const char * >( std::memchr( begin, '\n', M_size - M_pos ) );
+        if ( ! end )
+        {
+            end = data + M_size;
+        }
+
+        M_pos = ( end - data ) + 1;
+
+        if ( begin == end )
         {
             continue;
         }
 
+        M_received_message.assign( begin, end );
         return M_received_message.size();
     }
 
@@ -134,10 +231,18 @@ OfflineClient::receiveMessage()
 bool
 OfflineClient::openOfflineLog( const std::string & filepath )
 {
-    M_offline_in.close();
-    M_offline_in.open( filepath.c_str() );
+    M_size = 0;
+    M_pos = 0;
+    M_data = load_binary_file( filepath, &M_size );
+    if ( ! M_data )
+    {
+        M_size = 0;
+    }
 
-    return M_offline_in.is_open();
+    createCycleIndex();
+    updateFastForwardOffset();
+
+    return static_cast< bool >( M_data );
 }
 
 /*-------------------------------------------------------------------*/
@@ -150,4 +255,90 @@ OfflineClient::printOfflineThink()
 
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+OfflineClient::setFastForwardCycle( const long cycle )
+{
+    M_fast_forward_cycle = cycle;
+    updateFastForwardOffset();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+OfflineClient::isFastForwarding() const
+{
+    return M_pos < M_fast_forward_offset;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+OfflineClient::createCycleIndex()
+{
+    static const char prefix[] = "(sense_body ";
+    const std::size_t prefix_size = sizeof( prefix ) - 1;
+
+    M_cycle_index.clear();
+
+    const char * data = M_data.get();
+    std::size_t pos = 0;
+    while ( pos < M_size )
+    {
+        const char * begin = data + pos;
+        const char * end = static_cast< const char * >( std::memchr( begin, '\n', M_size - pos ) );
+        if ( ! end )
+        {
+            end = data + M_size;
+        }
+
+        if ( static_cast< std::size_t >( end - begin ) > prefix_size
+             && std::memcmp( begin, prefix, prefix_size ) == 0 )
+        {
+            const long cycle = std::strtol( begin + prefix_size, nullptr, 10 );
+            if ( M_cycle_index.empty()
+                 || M_cycle_index.back().first != cycle )
+            {
+                M_cycle_index.emplace_back( cycle, pos );
+            }
+        }
+
+        pos = ( end - data ) + 1;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+OfflineClient::updateFastForwardOffset()
+{
+    M_fast_forward_offset = 0;
+
+    if ( M_fast_forward_cycle < 0 )
+    {
+        return;
+    }
+
+    // the first indexed cycle that is not less than the target
+    std::vector< CycleOffset >::const_iterator it
+        = std::find_if( M_cycle_index.begin(), M_cycle_index.end(),
+                        [&]( const CycleOffset & v )
+                          {
+                              return v.first >= M_fast_forward_cycle;
+                          } );
+
+    M_fast_forward_offset = ( it == M_cycle_index.end()
+                              ? M_size
+                              : it->second );
+}
+
 }
@@ -34,20 +34,48 @@
 
 #include <rcsc/common/abstract_client.h>
 
-#include <fstream>
+#include <memory>
+#include <vector>
+#include <utility>
 
 namespace rcsc {
 
 /*!
   \class OfflineClient
   \brief offline clientt class for debugging purpose.
+
+  The whole log file is mapped to the memory, and the offsets of the first
+  sense_body message of each cycle are indexed when the file is opened.
+  If the fast-forward cycle is set, isFastForwarding() returns true until
+  the client reaches the first message of that cycle, so the agent can skip
+  its decision and only update the world model.
  */
 class OfflineClient
     : public AbstractClient {
+public:
+
+    //! the pair of the game cycle and the offset of its first message
+    typedef std::pair< long, std::size_t > CycleOffset;
+
 private:
 
-    //! input log file for offline client
-    std::ifstream M_offline_in;
+    //! mapped log data
+    std::shared_ptr< const char > M_data;
+
+    //! the byte length of the log data
+    std::size_t M_size;
+
+    //! read position in the log data
+    std::size_t M_pos;
+
+    //! the first message offset of each cycle, in the file order
+    std::vector< CycleOffset > M_cycle_index;
+
+    //! the cycle to be reached by the fast-forward. negative value means no fast-forward.
+    long M_fast_forward_cycle;
+
+    //! the offset of the first message of the fast-forward cycle
+    std::size_t M_fast_forward_offset;
 
 public:
 
@@ -106,6 +134,40 @@ public:
      */
     virtual
     void printOfflineThink();
+
+    /*!
+      \brief set the game cycle to be reached by the fast-forward.
+      \param cycle target game cycle. negative value disables the fast-forward.
+     */
+    void setFastForwardCycle( const long cycle );
+
+    /*!
+      \brief check if the client is reading the messages before the fast-forward cycle.
+      \return true if the agent may skip its decision.
+     */
+    virtual
+    bool isFastForwarding() const;
+
+    /*!
+      \brief get the cycle index of the opened log
+      \return the first message offset of each cycle
+     */
+    const std::vector< CycleOffset > & cycleIndex() const
+      {
+          return M_cycle_index;
+      }
+
+private:
+
+    /*!
+      \brief build the cycle index from the sense_body messages.
+     */
+    void createCycleIndex();
+
+    /*!
+      \brief update the offset of the fast-forward cycle
+     */
+    void updateFastForwardOffset();
 };
 
 }
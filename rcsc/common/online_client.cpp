@@ -49,12 +49,24 @@
 
 namespace rcsc {
 
+namespace {
+
+//! the number of datagrams read by one system call
+constexpr int RECEIVE_BATCH_SIZE = 8;
+
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
  */
 OnlineClient::OnlineClient()
-    : AbstractClient()
+    : AbstractClient(),
+      M_receive_buffer( RECEIVE_BATCH_SIZE * MAX_MESG ),
+      M_receive_sizes( RECEIVE_BATCH_SIZE, 0 ),
+      M_receive_stamps( RECEIVE_BATCH_SIZE, 0 ),
+      M_received_count( 0 ),
+      M_received_index( 0 )
 {
 
 }
@@ -155,6 +167,9 @@ OnlineClient::connectTo( const char * hostname,
         return false;
     }
 
+    // the kernel receive time is optional. the time after recvmmsg is used otherwise.
+    M_socket->enableReceiveTimestamp();
+
     setServerAlive( true );
     return true;
 }
@@ -175,8 +190,10 @@ OnlineClient::sendMessage( const char * msg )
 
     if ( ! M_sent_message.empty() )
     {
-        return M_socket->writeDatagram( M_sent_message.data(),
-                                        M_sent_message.length() );
+        const int n = M_socket->writeDatagram( M_sent_message.data(),
+                                               M_sent_message.length() );
+        M_sent_nsec = UDPSocket::now_nsec();
+        return n;
     }
 
     return 0;
@@ -194,14 +211,30 @@ OnlineClient::sendMessage( const char * msg )
 int
 OnlineClient::receiveMessage()
 {
-    static char msg[MAX_MESG];
-
     if ( ! M_socket )
     {
         return 0;
     }
 
-    int n = M_socket->readDatagram( msg, MAX_MESG );
+    if ( M_received_index >= M_received_count )
+    {
+        M_received_index = 0;
+        M_received_count = M_socket->readDatagrams( M_receive_buffer.data(), MAX_MESG,
+                                                    RECEIVE_BATCH_SIZE,
+                                                    M_receive_sizes.data(),
+                                                    M_receive_stamps.data() );
+        if ( M_received_count <= 0 )
+        {
+            const int result = M_received_count;
+            M_received_count = 0;
+            return result;
+        }
+    }
+
+    const char * msg = M_receive_buffer.data() + M_received_index * MAX_MESG;
+    const int n = M_receive_sizes[M_received_index];
+    M_received_nsec = M_receive_stamps[M_received_index];
+    ++M_received_index;
 
     if ( n > 0 )
     {
@@ -35,6 +35,7 @@
 #include <rcsc/common/abstract_client.h>
 
 #include <fstream>
+#include <vector>
 
 namespace rcsc {
 
@@ -53,12 +54,25 @@ class OnlineClient
     : public AbstractClient {
 private:
 
+    friend class MultiAgentClient;
+
     //! udp connection
     std::shared_ptr< UDPSocket > M_socket;
 
     //! output file for offline logging
     std::ofstream M_offline_out;
 
+    //! datagrams received by one batched system call. each slot has MAX_MESG bytes.
+    std::vector< char > M_receive_buffer;
+    //! the length of each received datagram
+    std::vector< int > M_receive_sizes;
+    //! the receive time of each received datagram [nsec since epoch]
+    std::vector< std::int64_t > M_receive_stamps;
+    //! the number of datagrams in M_receive_buffer
+    int M_received_count;
+    //! the index of the datagram returned by the next receiveMessage()
+    int M_received_index;
+
 public:
 
     /*!
@@ -107,6 +121,11 @@ public:
     /*!
       \brief receive server message in the socket queue.
       If an offline log file is opened, all received messages are recoreded to the file.
+      All pending datagrams are read by one system call and returned one by one
+      by the following calls, so the loop in the agent drains a burst of messages
+      with one system call.
+      The receive time of the message (see receivedNSec()) is taken from the
+      kernel timestamp (SO_TIMESTAMPNS) where available.
       \return length of received message
      */
     virtual
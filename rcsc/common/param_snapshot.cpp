@@ -0,0 +1,656 @@
+// -*-c++-*-
+
+/*!
+  \file param_snapshot.cpp
+  \brief binary snapshot of the server/player parameters Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "param_snapshot.h"
+
+#include "server_param.h"
+#include "player_param.h"
+#include "player_type.h"
+
+#include <rcsc/param/param_map.h>
+
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+
+namespace rcsc {
+
+const std::uint32_t ParamSnapshot::FORMAT_VERSION = 1;
+const std::uint64_t ParamSnapshot::INITIAL_KEY = 14695981039346656037ULL;
+
+namespace {
+
+//
+// snapshot file format.
+// [SnapshotHeader][server params][player params][player types]
+// all values are stored in the native byte order with 8 byte alignment.
+//
+// param section: [u64 count]{[u64 variant index][8 byte value] | [u64 variant index][u64 length][chars padded to 8]}
+// player type section: [u64 count][PlayerType default][PlayerType dummy][PlayerType x count]
+//
+
+const char SNAPSHOT_MAGIC[8] = { 'R', 'C', 'S', 'C', 'P', 'R', 'M', '\0' };
+const std::uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+
+struct SnapshotHeader {
+    char magic_[8];
+    std::uint32_t version_;
+    std::uint32_t byte_order_;
+    std::uint64_t schema_key_;
+    std::uint64_t input_key_;
+    std::uint64_t body_size_;
+};
+
+/*-------------------------------------------------------------------*/
+inline
+std::uint64_t
+hash_bytes( std::uint64_t h,
+            const void * data,
+            const std::size_t size )
+{
+    const unsigned char * p = static_cast< const unsigned char * >( data );
+    for ( std::size_t i = 0; i < size; ++i )
+    {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+/*-------------------------------------------------------------------*/
+inline
+std::uint64_t
+hash_u64( const std::uint64_t h,
+          const std::uint64_t v )
+{
+    return hash_bytes( h, &v, sizeof( v ) );
+}
+
+/*-------------------------------------------------------------------*/
+template < typename T >
+void
+put_value( std::string & out,
+           const T & v )
+{
+    static_assert( sizeof( T ) == 8, "all scalar values are stored as 8 bytes." );
+    out.append( reinterpret_cast< const char * >( &v ), sizeof( T ) );
+}
+
+/*-------------------------------------------------------------------*/
+template < typename T >
+bool
+get_value( const char ** data,
+           const char * end,
+           T * v )
+{
+    static_assert( sizeof( T ) == 8, "all scalar values are stored as 8 bytes." );
+    if ( end - *data < static_cast< std::ptrdiff_t >( sizeof( T ) ) )
+    {
+        return false;
+    }
+    std::memcpy( v, *data, sizeof( T ) );
+    *data += sizeof( T );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+void
+put_bytes( std::string & out,
+           const void * data,
+           const std::size_t size )
+{
+    put_value( out, static_cast< std::uint64_t >( size ) );
+    out.append( static_cast< const char * >( data ), size );
+    out.append( ( 8 - size % 8 ) % 8, '\0' );
+}
+
+/*-------------------------------------------------------------------*/
+bool
+get_bytes( const char ** data,
+           const char * end,
+           const char ** bytes,
+           std::uint64_t * size )
+{
+    if ( ! get_value( data, end, size ) )
+    {
+        return false;
+    }
+
+    const std::uint64_t padded = ( *size + 7 ) / 8 * 8;
+    if ( static_cast< std::uint64_t >( end - *data ) < padded )
+    {
+        return false;
+    }
+
+    *bytes = *data;
+    *data += padded;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+template < typename T >
+void
+put_vector( std::string & out,
+            const std::vector< T > & v )
+{
+    put_bytes( out, v.data(), v.size() * sizeof( T ) );
+}
+
+/*-------------------------------------------------------------------*/
+template < typename T >
+bool
+get_vector( const char ** data,
+            const char * end,
+            std::vector< T > * v )
+{
+    const char * bytes = nullptr;
+    std::uint64_t size = 0;
+    if ( ! get_bytes( data, end, &bytes, &size )
+         || size % sizeof( T ) != 0 )
+    {
+        return false;
+    }
+
+    v->resize( size / sizeof( T ) );
+    if ( size > 0 )
+    {
+        std::memcpy( v->data(), bytes, size );
+    }
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the bool variable referred by the switch type parameters
+*/
+struct BoolTarget {
+    bool * operator()( int * ) { return nullptr; }
+    bool * operator()( size_t * ) { return nullptr; }
+    bool * operator()( double * ) { return nullptr; }
+    bool * operator()( bool * ptr ) { return ptr; }
+    bool * operator()( NegateBool ptr ) { return ptr.ptr_; }
+    bool * operator()( BoolSwitch ptr ) { return ptr.ptr_; }
+    bool * operator()( NegateSwitch ptr ) { return ptr.ptr_; }
+    bool * operator()( std::string * ) { return nullptr; }
+};
+
+/*-------------------------------------------------------------------*/
+void
+put_params( std::string & out,
+            const ParamMap & param_map )
+{
+    put_value( out, static_cast< std::uint64_t >( param_map.parameters().size() ) );
+
+    for ( const ParamEntity::Ptr & p : param_map.parameters() )
+    {
+        const ParamEntity::ValuePtr & v = p->valuePtr();
+        put_value( out, static_cast< std::uint64_t >( v.index() ) );
+
+        if ( const std::string * const * s = std::get_if< std::string * >( &v ) )
+        {
+            put_bytes( out, (*s)->data(), (*s)->size() );
+        }
+        else if ( int * const * i = std::get_if< int * >( &v ) )
+        {
+            put_value( out, static_cast< std::int64_t >( **i ) );
+        }
+        else if ( size_t * const * u = std::get_if< size_t * >( &v ) )
+        {
+            put_value( out, static_cast< std::uint64_t >( **u ) );
+        }
+        else if ( double * const * d = std::get_if< double * >( &v ) )
+        {
+            put_value( out, **d );
+        }
+        else
+        {
+            const bool * b = std::visit( BoolTarget(), v );
+            put_value( out, static_cast< std::uint64_t >( b && *b ? 1 : 0 ) );
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read the param section
+  \param apply if false, only the format is validated.
+*/
+bool
+get_params( const char ** data,
+            const char * end,
+            const ParamMap & param_map,
+            const bool apply )
+{
+    std::uint64_t count = 0;
+    if ( ! get_value( data, end, &count )
+         || count != param_map.parameters().size() )
+    {
+        return false;
+    }
+
+    for ( const ParamEntity::Ptr & p : param_map.parameters() )
+    {
+        const ParamEntity::ValuePtr & v = p->valuePtr();
+
+        std::uint64_t index = 0;
+        if ( ! get_value( data, end, &index )
+             || index != v.index() )
+        {
+            return false;
+        }
+
+        if ( std::string * const * s = std::get_if< std::string * >( &v ) )
+        {
+            const char * bytes = nullptr;
+            std::uint64_t size = 0;
+            if ( ! get_bytes( data, end, &bytes, &size ) ) return false;
+            if ( apply ) (*s)->assign( bytes, size );
+            continue;
+        }
+
+        std::uint64_t raw = 0;
+        if ( ! get_value( data, end, &raw ) ) return false;
+        if ( ! apply ) continue;
+
+        if ( int * const * i = std::get_if< int * >( &v ) )
+        {
+            std::int64_t value;
+            std::memcpy( &value, &raw, sizeof( value ) );
+            **i = static_cast< int >( value );
+        }
+        else if ( size_t * const * u = std::get_if< size_t * >( &v ) )
+        {
+            **u = static_cast< size_t >( raw );
+        }
+        else if ( double * const * d = std::get_if< double * >( &v ) )
+        {
+            std::memcpy( *d, &raw, sizeof( double ) );
+        }
+        else if ( bool * b = std::visit( BoolTarget(), v ) )
+        {
+            *b = ( raw != 0 );
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+std::uint64_t
+params_schema( std::uint64_t h,
+               const ParamMap & param_map )
+{
+    h = hash_u64( h, param_map.parameters().size() );
+    for ( const ParamEntity::Ptr & p : param_map.parameters() )
+    {
+        h = hash_bytes( h, p->longName().data(), p->longName().size() );
+        h = hash_u64( h, p->valuePtr().index() );
+    }
+    return h;
+}
+
+}
+
+//
+// PlayerType fields stored in the snapshot. the order is a part of the format.
+//
+
+#define RCSC_SNAPSHOT_PLAYER_TYPE_DOUBLES               \
+    &PlayerType::M_player_speed_max,                    \
+        &PlayerType::M_stamina_inc_max,                 \
+        &PlayerType::M_player_decay,                    \
+        &PlayerType::M_inertia_moment,                  \
+        &PlayerType::M_dash_power_rate,                 \
+        &PlayerType::M_player_size,                     \
+        &PlayerType::M_kickable_margin,                 \
+        &PlayerType::M_kick_rand,                       \
+        &PlayerType::M_extra_stamina,                   \
+        &PlayerType::M_effort_max,                      \
+        &PlayerType::M_effort_min,                      \
+        &PlayerType::M_kick_power_rate,                 \
+        &PlayerType::M_foul_detect_probability,         \
+        &PlayerType::M_catchable_area_l_stretch,        \
+        &PlayerType::M_unum_far_length,                 \
+        &PlayerType::M_unum_too_far_length,             \
+        &PlayerType::M_team_far_length,                 \
+        &PlayerType::M_team_too_far_length,             \
+        &PlayerType::M_player_max_observation_length,   \
+        &PlayerType::M_ball_vel_far_length,             \
+        &PlayerType::M_ball_vel_too_far_length,         \
+        &PlayerType::M_ball_max_observation_length,     \
+        &PlayerType::M_flag_chg_far_length,             \
+        &PlayerType::M_flag_chg_too_far_length,         \
+        &PlayerType::M_flag_max_observation_length,     \
+        &PlayerType::M_dist_noise_rate,                 \
+        &PlayerType::M_focus_dist_noise_rate,           \
+        &PlayerType::M_land_dist_noise_rate,            \
+        &PlayerType::M_land_focus_dist_noise_rate,      \
+        &PlayerType::M_kickable_area,                   \
+        &PlayerType::M_reliable_catchable_dist,         \
+        &PlayerType::M_max_catchable_dist,              \
+        &PlayerType::M_real_speed_max,                  \
+        &PlayerType::M_player_speed_max2,               \
+        &PlayerType::M_real_speed_max2
+
+#define RCSC_SNAPSHOT_PLAYER_TYPE_INTS                  \
+    &PlayerType::M_id,                                  \
+        &PlayerType::M_cycles_to_reach_max_speed,       \
+        &PlayerType::M_dash_speed_bucket_size
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::uint64_t
+ParamSnapshot::player_type_schema( std::uint64_t h )
+{
+    static double PlayerType::* const doubles[] = { RCSC_SNAPSHOT_PLAYER_TYPE_DOUBLES };
+    static int PlayerType::* const ints[] = { RCSC_SNAPSHOT_PLAYER_TYPE_INTS };
+
+    h = hash_u64( h, sizeof( doubles ) / sizeof( doubles[0] ) );
+    h = hash_u64( h, sizeof( ints ) / sizeof( ints[0] ) );
+    h = hash_u64( h, PlayerType::DASH_TABLE_SIZE );
+    return h;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ParamSnapshot::put_player_type( std::string & out,
+                                const PlayerType & type )
+{
+    static double PlayerType::* const doubles[] = { RCSC_SNAPSHOT_PLAYER_TYPE_DOUBLES };
+    static int PlayerType::* const ints[] = { RCSC_SNAPSHOT_PLAYER_TYPE_INTS };
+
+    for ( double PlayerType::* m : doubles )
+    {
+        put_value( out, type.*m );
+    }
+
+    for ( int PlayerType::* m : ints )
+    {
+        put_value( out, static_cast< std::int64_t >( type.*m ) );
+    }
+
+    put_vector( out, type.M_dash_distance_table );
+    put_vector( out, type.M_dash_distance_index );
+    put_vector( out, type.M_speed_dash_distance_table );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParamSnapshot::get_player_type( const char ** data,
+                                const char * end,
+                                PlayerType * type )
+{
+    static double PlayerType::* const doubles[] = { RCSC_SNAPSHOT_PLAYER_TYPE_DOUBLES };
+    static int PlayerType::* const ints[] = { RCSC_SNAPSHOT_PLAYER_TYPE_INTS };
+
+    for ( double PlayerType::* m : doubles )
+    {
+        if ( ! get_value( data, end, &( type->*m ) ) ) return false;
+    }
+
+    for ( int PlayerType::* m : ints )
+    {
+        std::int64_t v = 0;
+        if ( ! get_value( data, end, &v ) ) return false;
+        type->*m = static_cast< int >( v );
+    }
+
+    return ( get_vector( data, end, &type->M_dash_distance_table )
+             && get_vector( data, end, &type->M_dash_distance_index )
+             && get_vector( data, end, &type->M_speed_dash_distance_table ) );
+}
+
+#undef RCSC_SNAPSHOT_PLAYER_TYPE_DOUBLES
+#undef RCSC_SNAPSHOT_PLAYER_TYPE_INTS
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::uint64_t
+ParamSnapshot::hash_input( const std::uint64_t key,
+                           std::string_view input )
+{
+    return hash_u64( hash_bytes( key, input.data(), input.size() ), input.size() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::uint64_t
+ParamSnapshot::schema_key()
+{
+    std::uint64_t h = INITIAL_KEY;
+    h = hash_u64( h, FORMAT_VERSION );
+    h = params_schema( h, *ServerParam::instance().M_param_map );
+    h = params_schema( h, *PlayerParam::instance().M_param_map );
+    h = player_type_schema( h );
+    return h;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParamSnapshot::write( const std::string & file_path,
+                      const std::uint64_t input_key )
+{
+    const PlayerTypeSet & types = PlayerTypeSet::instance();
+
+    std::string body;
+    body.reserve( 64 * 1024 );
+
+    put_params( body, *ServerParam::instance().M_param_map );
+    put_params( body, *PlayerParam::instance().M_param_map );
+
+    put_value( body, static_cast< std::uint64_t >( types.M_player_type_map.size() ) );
+    put_player_type( body, types.M_default_type );
+    put_player_type( body, types.M_dummy_type );
+    for ( int id = 0, n = 0; n < static_cast< int >( types.M_player_type_map.size() ); ++id )
+    {
+        // written in id order to make the file deterministic
+        PlayerTypeSet::Map::const_iterator it = types.M_player_type_map.find( id );
+        if ( it != types.M_player_type_map.end() )
+        {
+            put_player_type( body, it->second );
+            ++n;
+        }
+        else if ( id > 1000 )
+        {
+            return false;
+        }
+    }
+
+    SnapshotHeader header;
+    std::memset( &header, 0, sizeof( header ) );
+    std::memcpy( header.magic_, SNAPSHOT_MAGIC, sizeof( SNAPSHOT_MAGIC ) );
+    header.version_ = FORMAT_VERSION;
+    header.byte_order_ = SNAPSHOT_BYTE_ORDER;
+    header.schema_key_ = schema_key();
+    header.input_key_ = input_key;
+    header.body_size_ = body.size();
+
+    const std::string tmp_path = file_path + ".tmp";
+
+    {
+        std::ofstream fout( tmp_path.c_str(), std::ios::binary | std::ios::trunc );
+        if ( ! fout.is_open() )
+        {
+            return false;
+        }
+
+        fout.write( reinterpret_cast< const char * >( &header ), sizeof( header ) );
+        fout.write( body.data(), body.size() );
+        fout.flush();
+        if ( ! fout )
+        {
+            std::remove( tmp_path.c_str() );
+            return false;
+        }
+    }
+
+    if ( std::rename( tmp_path.c_str(), file_path.c_str() ) != 0 )
+    {
+        std::remove( tmp_path.c_str() );
+        return false;
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParamSnapshot::read( const std::string & file_path,
+                     const std::uint64_t input_key )
+{
+    std::ifstream fin( file_path.c_str(), std::ios::binary | std::ios::ate );
+    if ( ! fin.is_open() )
+    {
+        return false;
+    }
+
+    const std::streamsize length = fin.tellg();
+    if ( length < static_cast< std::streamsize >( sizeof( SnapshotHeader ) ) )
+    {
+        return false;
+    }
+
+    // single read of the whole file. std::uint64_t keeps the 8 byte alignment.
+    std::vector< std::uint64_t > buf( ( length + 7 ) / 8 );
+    fin.seekg( 0 );
+    if ( ! fin.read( reinterpret_cast< char * >( buf.data() ), length ) )
+    {
+        return false;
+    }
+
+    const char * data = reinterpret_cast< const char * >( buf.data() );
+    const char * const end = data + length;
+
+    SnapshotHeader header;
+    std::memcpy( &header, data, sizeof( header ) );
+    data += sizeof( header );
+
+    if ( std::memcmp( header.magic_, SNAPSHOT_MAGIC, sizeof( SNAPSHOT_MAGIC ) ) != 0
+         || header.version_ != FORMAT_VERSION
+         || header.byte_order_ != SNAPSHOT_BYTE_ORDER
+         || header.body_size_ != static_cast< std::uint64_t >( end - data ) )
+    {
+        std::cerr << "(ParamSnapshot::read) unsupported format. " << file_path << std::endl;
+        return false;
+    }
+
+    if ( header.schema_key_ != schema_key()
+         || header.input_key_ != input_key )
+    {
+        // stale snapshot. the caller should fall back to the text parameters.
+        return false;
+    }
+
+    ParamMap & server_map = *ServerParam::instance().M_param_map;
+    ParamMap & player_map = *PlayerParam::instance().M_param_map;
+
+    //
+    // validate and decode everything before any parameter is modified
+    //
+    const char * body = data;
+    if ( ! get_params( &data, end, server_map, false )
+         || ! get_params( &data, end, player_map, false ) )
+    {
+        std::cerr << "(ParamSnapshot::read) broken param section. " << file_path << std::endl;
+        return false;
+    }
+
+    std::uint64_t count = 0;
+    PlayerType default_type;
+    PlayerType dummy_type;
+    PlayerTypeSet::Map type_map;
+    if ( ! get_value( &data, end, &count )
+         || count > 1000
+         || ! get_player_type( &data, end, &default_type )
+         || ! get_player_type( &data, end, &dummy_type ) )
+    {
+        std::cerr << "(ParamSnapshot::read) broken player type section. " << file_path << std::endl;
+        return false;
+    }
+
+    for ( std::uint64_t i = 0; i < count; ++i )
+    {
+        PlayerType t = default_type;
+        if ( ! get_player_type( &data, end, &t ) )
+        {
+            std::cerr << "(ParamSnapshot::read) broken player type. " << file_path << std::endl;
+            return false;
+        }
+        type_map.insert( std::make_pair( t.id(), t ) );
+    }
+
+    if ( data != end )
+    {
+        std::cerr << "(ParamSnapshot::read) illegal file size. " << file_path << std::endl;
+        return false;
+    }
+
+    //
+    // apply
+    //
+    data = body;
+    get_params( &data, end, server_map, true );
+    get_params( &data, end, player_map, true );
+    ServerParam::instance().setAdditionalParam();
+
+    PlayerTypeSet & types = PlayerTypeSet::instance();
+    types.M_player_type_map.swap( type_map );
+    types.M_default_type = default_type;
+    types.M_dummy_type = dummy_type;
+
+    return true;
+}
+
+}
@@ -0,0 +1,123 @@
+// -*-c++-*-
+
+/*!
+  \file param_snapshot.h
+  \brief binary snapshot of the server/player parameters Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_COMMON_PARAM_SNAPSHOT_H
+#define RCSC_COMMON_PARAM_SNAPSHOT_H
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+namespace rcsc {
+
+class PlayerType;
+
+/*!
+  \class ParamSnapshot
+  \brief versioned binary snapshot of ServerParam, PlayerParam and PlayerTypeSet.
+
+  The snapshot contains all registered parameter values and all PlayerType
+  instances including the derived values (kickable area, dash distance
+  tables, ...), so restoring it needs neither the text parsing nor
+  PlayerType::initAdditionalParams().
+
+  The header has two keys. The schema key is computed from the parameter
+  names and types of this build, and the input key is given by the caller,
+  usually the hash of the parameter messages from which the values were
+  derived (see hash_input()). read() fails if either key does not match.
+*/
+class ParamSnapshot {
+public:
+
+    //! format version
+    static const std::uint32_t FORMAT_VERSION;
+
+    //! initial value of the input key
+    static const std::uint64_t INITIAL_KEY;
+
+    /*!
+      \brief accumulate the input string into the key
+      \param key current key value. INITIAL_KEY for the first input.
+      \param input input string (server_param message, rcg header, ...)
+      \return updated key value
+    */
+    static
+    std::uint64_t hash_input( const std::uint64_t key,
+                              std::string_view input );
+
+    /*!
+      \brief get the key of the parameter layout of this build
+      \return schema key
+    */
+    static
+    std::uint64_t schema_key();
+
+    /*!
+      \brief write the current parameters to the file
+      \param file_path output file path
+      \param input_key key of the parameter source
+      \return true if successfully written
+
+      The data is written to a temporary file, then renamed to file_path.
+    */
+    static
+    bool write( const std::string & file_path,
+                const std::uint64_t input_key );
+
+    /*!
+      \brief restore the parameters from the file by a single read
+      \param file_path input file path
+      \param input_key key of the expected parameter source
+      \return true if the keys matched and all values were restored.
+      If false, the parameters are not modified.
+    */
+    static
+    bool read( const std::string & file_path,
+               const std::uint64_t input_key );
+
+private:
+
+    static
+    void put_player_type( std::string & out,
+                          const PlayerType & type );
+
+    static
+    bool get_player_type( const char ** data,
+                          const char * end,
+                          PlayerType * type );
+
+    static
+    std::uint64_t player_type_schema( std::uint64_t h );
+};
+
+}
+
+#endif
@@ -51,6 +51,8 @@ class ParamMap;
 class PlayerParam {
 private:
 
+    friend class ParamSnapshot;
+
     //! parameter map implementation
     std::unique_ptr< ParamMap > M_param_map;
 
@@ -101,6 +101,10 @@ public:
 
 namespace rcsc {
 
+constexpr int PlayerType::DASH_TABLE_SIZE;
+constexpr double PlayerType::DASH_DISTANCE_INDEX_STEP;
+constexpr double PlayerType::DASH_SPEED_STEP;
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -748,9 +752,9 @@ PlayerType::initAdditionalParams()
     M_cycles_to_reach_max_speed = -1;
 
     M_dash_distance_table.clear();
-    M_dash_distance_table.reserve( 50 );
+    M_dash_distance_table.reserve( DASH_TABLE_SIZE );
 
-    for ( int counter = 1; counter <= 50; ++counter )
+    for ( int counter = 1; counter <= DASH_TABLE_SIZE; ++counter )
     {
         if ( speed + accel > playerSpeedMax() )
         {
@@ -780,6 +784,94 @@ PlayerType::initAdditionalParams()
             break;
         }
     }
+
+    initDashDistanceTables();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PlayerType::initDashDistanceTables()
+{
+    const ServerParam & SP = ServerParam::i();
+
+    //
+    // direct index for M_dash_distance_table
+    //
+    {
+        const int index_size
+            = static_cast< int >( M_dash_distance_table.back() / DASH_DISTANCE_INDEX_STEP ) + 1;
+        const int table_size = M_dash_distance_table.size();
+
+        M_dash_distance_index.resize( index_size );
+
+        int count = 0;
+        for ( int i = 0; i < index_size; ++i )
+        {
+            const double dist = i * DASH_DISTANCE_INDEX_STEP;
+            while ( count < table_size
+                    && M_dash_distance_table[count] < dist )
+            {
+                ++count;
+            }
+            M_dash_distance_index[i] = count;
+        }
+    }
+
+    //
+    // distance tables for each initial speed bucket.
+    // the same simulation as M_dash_distance_table, but every table has DASH_TABLE_SIZE values.
+    //
+    M_dash_speed_bucket_size
+        = std::max( 2, static_cast< int >( std::ceil( playerSpeedMax() / DASH_SPEED_STEP ) ) + 1 );
+
+    M_speed_dash_distance_table.resize( M_dash_speed_bucket_size * DASH_TABLE_SIZE );
+
+    for ( int b = 0; b < M_dash_speed_bucket_size; ++b )
+    {
+        double * table = M_speed_dash_distance_table.data() + b * DASH_TABLE_SIZE;
+
+        double speed = std::min( b * DASH_SPEED_STEP, playerSpeedMax() );
+        double reach_dist = 0.0;
+
+        StaminaModel stamina_model;
+        stamina_model.init( *this );
+
+        int counter = 0;
+        for ( ; counter < DASH_TABLE_SIZE; ++counter )
+        {
+            double accel = SP.maxDashPower() * dashPowerRate() * stamina_model.effort();
+            double dash_power = SP.maxDashPower();
+            if ( speed + accel > playerSpeedMax() )
+            {
+                accel = playerSpeedMax() - speed;
+                dash_power = std::min( SP.maxDashPower(),
+                                       accel / ( dashPowerRate() * stamina_model.effort() ) );
+            }
+
+            speed += accel;
+            reach_dist += speed;
+            table[counter] = reach_dist;
+
+            speed *= playerDecay();
+
+            stamina_model.simulateDash( *this, dash_power );
+
+            if ( stamina_model.stamina() <= 0.0 )
+            {
+                ++counter;
+                break;
+            }
+        }
+
+        for ( ; counter < DASH_TABLE_SIZE; ++counter )
+        {
+            reach_dist += realSpeedMax();
+            table[counter] = reach_dist;
+        }
+    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -1114,16 +1206,18 @@ PlayerType::cyclesToReachDistance( const double & dash_dist ) const
         return 0;
     }
 
-    std::vector< double >::const_iterator
-        it = std::lower_bound( M_dash_distance_table.begin(),
-                               M_dash_distance_table.end(),
-                               dash_dist - 0.001 );
+    const double dist = dash_dist - 0.001;
 
-    if ( it != M_dash_distance_table.end() )
+    if ( dist <= M_dash_distance_table.back() )
     {
-        return ( static_cast< int >
-                 ( std::distance( M_dash_distance_table.begin(), it ) )
-                 + 1 ); // is it necessary?
+        // the index step is usually shorter than the distance of one dash,
+        // so the loop checks only one or two values.
+        int i = M_dash_distance_index[static_cast< int >( dist / DASH_DISTANCE_INDEX_STEP )];
+        while ( M_dash_distance_table[i] < dist )
+        {
+            ++i;
+        }
+        return i + 1; // is it necessary?
     }
 
     double rest_dist = dash_dist - M_dash_distance_table.back();
@@ -1134,6 +1228,33 @@ PlayerType::cyclesToReachDistance( const double & dash_dist ) const
     return cycle;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+PlayerType::cyclesToReachDistance( const double & dash_dist,
+                                   const double first_speed ) const
+{
+    int cycle = cyclesToReachDistance( dash_dist );
+
+    if ( first_speed <= 0.0 )
+    {
+        return cycle;
+    }
+
+    // the result from the speed 0 is the upper bound.
+    // the initial speed saves only a few dashes.
+    const double dist = dash_dist - 0.001;
+    while ( cycle > 1
+            && getMovableDistance( cycle - 1, first_speed ) >= dist )
+    {
+        --cycle;
+    }
+
+    return cycle;
+}
+
 /*-------------------------------------------------------------------*/
 double
 PlayerType::getMovableDistance( const size_t step ) const
@@ -1153,6 +1274,38 @@ PlayerType::getMovableDistance( const size_t step ) const
     return M_dash_distance_table[index];
 }
 
+/*-------------------------------------------------------------------*/
+double
+PlayerType::getMovableDistance( const size_t step,
+                                const double first_speed ) const
+{
+    if ( step == 0 )
+    {
+        return 0.0;
+    }
+
+    if ( first_speed <= 0.0 )
+    {
+        return getMovableDistance( step );
+    }
+
+    const double rate = first_speed / DASH_SPEED_STEP;
+    const int bucket = std::min( static_cast< int >( rate ), M_dash_speed_bucket_size - 2 );
+    const double t = std::min( 1.0, rate - bucket );
+
+    const double * table = M_speed_dash_distance_table.data() + bucket * DASH_TABLE_SIZE;
+
+    const size_t index = std::min( step, static_cast< size_t >( DASH_TABLE_SIZE ) ) - 1;
+    const double dist = table[index] + ( table[index + DASH_TABLE_SIZE] - table[index] ) * t;
+
+    if ( step > static_cast< size_t >( DASH_TABLE_SIZE ) )
+    {
+        return dist + realSpeedMax() * ( step - DASH_TABLE_SIZE );
+    }
+
+    return dist;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
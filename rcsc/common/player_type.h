@@ -52,7 +52,21 @@ struct PlayerTypeT;
   \brief heterogeneous player parametor class
  */
 class PlayerType {
+public:
+
+    //! the number of steps in the dash distance tables
+    static constexpr int DASH_TABLE_SIZE = 50;
+
+    //! distance resolution of the direct index for the dash distance table
+    static constexpr double DASH_DISTANCE_INDEX_STEP = 0.1;
+
+    //! initial speed resolution of the dash distance tables
+    static constexpr double DASH_SPEED_STEP = 0.1;
+
 private:
+
+    friend class ParamSnapshot;
+
     int M_id; //!< player type id
     double M_player_speed_max; //!< maximum speed
     double M_stamina_inc_max; //!< stamina inc max
@@ -109,6 +123,15 @@ private:
     //! distance table by continuous dashes from the velocity 0.
     std::vector< double > M_dash_distance_table;
 
+    //! direct index for M_dash_distance_table. the i-th value is the number of distances less than i * DASH_DISTANCE_INDEX_STEP.
+    std::vector< int > M_dash_distance_index;
+
+    //! distance tables by continuous dashes. the i-th table starts from the speed i * DASH_SPEED_STEP.
+    std::vector< double > M_speed_dash_distance_table;
+
+    //! the number of speed buckets in M_speed_dash_distance_table
+    int M_dash_speed_bucket_size;
+
     // stamina cconsumption table by continuous dashes
     //std::vector< double > M_stamina_table;
 
@@ -199,6 +222,11 @@ private:
      */
     void initAdditionalParams();
 
+    /*!
+      \brief create the direct index and the initial speed tables for the dash distance.
+     */
+    void initDashDistanceTables();
+
 public:
 
     /*!
@@ -625,7 +653,32 @@ public:
     */
     int cyclesToReachDistance( const double & dash_dist ) const;
 
+    /*!
+      \brief estimate cycles to reach the specific distance with the initial speed.
+      \param dash_dist distance to reach
+      \param first_speed initial speed along the dash direction
+      \return estimated cycles to reach
+
+      The distance tables are interpolated between the initial speed buckets.
+     */
+    int cyclesToReachDistance( const double & dash_dist,
+                               const double first_speed ) const;
+
+    /*!
+      \brief get the distance moved by continuous dashes with start speed 0.
+      \param step the number of dashes
+      \return moved distance
+     */
     double getMovableDistance( const size_t step ) const;
+
+    /*!
+      \brief get the distance moved by continuous dashes with the initial speed.
+      \param step the number of dashes
+      \param first_speed initial speed along the dash direction
+      \return moved distance interpolated between the initial speed buckets
+     */
+    double getMovableDistance( const size_t step,
+                               const double first_speed ) const;
     ////////////////////////////////////////////////
     /*!
       \brief check if this type player can over player_speed_max
@@ -866,6 +919,8 @@ public:
     typedef std::unordered_map< int, PlayerType > Map;
 private:
 
+    friend class ParamSnapshot;
+
     //! heterogeneous player type container
     Map M_player_type_map;
 
@@ -44,11 +44,59 @@
 
 #include <cstring>
 
+namespace {
+
+/*!
+  \brief check if the message has at least len characters.
+  only the first len characters are scanned, not the rest of the message.
+*/
+inline
+bool
+has_length( const char * msg,
+            const int len )
+{
+    return std::memchr( msg, '\0', len ) == nullptr;
+}
+
+}
+
 namespace rcsc {
 
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+int
+SayMessageParser::consume( const int sender,
+                           const double & dir,
+                           std::string_view & cursor,
+                           const GameTime & current )
+{
+    if ( cursor.empty()
+         || cursor.front() != header() )
+    {
+        return 0;
+    }
+
+    const int len = parse( sender, dir, cursor.data(), current );
+
+    if ( len <= 0 )
+    {
+        return len;
+    }
+
+    if ( cursor.size() < static_cast< std::size_t >( len ) )
+    {
+        return -1;
+    }
+
+    cursor.remove_prefix( len );
+    return len;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 BallMessageParser::BallMessageParser( std::shared_ptr< AudioMemory > memory )
     : M_memory( memory )
@@ -76,7 +124,7 @@ BallMessageParser::parse( const int sender ,
         return 0;
     }
 
-    if ( (int)std::strlen( msg ) < slength() )
+    if ( ! has_length( msg, slength() ) )
     {
         std::cerr << "***ERROR*** BallMessageParser::parse()"
                   << " Illegal ball message [" << msg << "]"
@@ -91,7 +139,7 @@ BallMessageParser::parse( const int sender ,
     Vector2D ball_pos;
     Vector2D ball_vel;
 
-    if ( ! AudioCodec::i().decodeStr5ToPosVel( std::string( msg, slength() - 1 ),
+    if ( ! AudioCodec::i().decodeStr5ToPosVel( msg,
                                                &ball_pos, &ball_vel ) )
     {
         std::cerr << "***ERROR*** BallMessageParser::parse()"
@@ -142,7 +190,7 @@ PassMessageParser::parse( const int sender,
         return 0;
     }
 
-    if ( (int)std::strlen( msg ) < slength() )
+    if ( ! has_length( msg, slength() ) )
     {
         std::cerr << "PassMessageParser::parse()"
                   << " Illegal pass pass message ["
@@ -159,7 +207,7 @@ PassMessageParser::parse( const int sender,
     int receiver_number = 0;
     Vector2D receive_pos;
 
-    if ( ! AudioCodec::i().decodeStr4ToUnumPos( std::string( msg, 4 ),
+    if ( ! AudioCodec::i().decodeStr4ToUnumPos( msg,
                                                 &receiver_number,
                                                 &receive_pos ) )
     {
@@ -176,7 +224,7 @@ PassMessageParser::parse( const int sender,
     Vector2D ball_pos;
     Vector2D ball_vel;
 
-    if ( ! AudioCodec::i().decodeStr5ToPosVel( std::string( msg, 5 ),
+    if ( ! AudioCodec::i().decodeStr5ToPosVel( msg,
                                                &ball_pos, &ball_vel ) )
     {
         std::cerr << "***ERROR*** PassMessageParser::parse()"
@@ -234,7 +282,7 @@ InterceptMessageParser::parse( const int sender,
         return 0;
     }
 
-    if ( (int)std::strlen( msg ) < slength() )
+    if ( ! has_length( msg, slength() ) )
     {
         std::cerr << "InterceptMessageParser::parse()"
                   << " Illegal message = [" << msg << "]"
@@ -246,10 +294,9 @@ InterceptMessageParser::parse( const int sender,
     }
     ++msg;
 
-    AudioCodec::CharToIntCont::const_iterator unum_it = AudioCodec::i().charToIntMap().find( *msg );
-    if ( unum_it == AudioCodec::i().charToIntMap().end()
-         || unum_it->second <= 0
-         || MAX_PLAYER*2 < unum_it->second )
+    const int unum = AudioCodec::i().charToInt( *msg );
+    if ( unum <= 0
+         || MAX_PLAYER*2 < unum )
     {
         std::cerr << "InterceptMessageParser::parse() "
                   << " Illegal player number. message = [" << msg << "]"
@@ -261,8 +308,8 @@ InterceptMessageParser::parse( const int sender,
     }
     ++msg;
 
-    AudioCodec::CharToIntCont::const_iterator cycle = AudioCodec::i().charToIntMap().find( *msg );
-    if ( cycle == AudioCodec::i().charToIntMap().end() )
+    const int cycle = AudioCodec::i().charToInt( *msg );
+    if ( cycle < 0 )
     {
         std::cerr << "InterceptMessageParser::parse() "
                   << " Illegal cycle. message = [" << msg << "]"
@@ -275,9 +322,9 @@ InterceptMessageParser::parse( const int sender,
 
     dlog.addText( Logger::SENSOR,
                   "InterceptMessageParser: success! number=%d cycle=%d",
-                  unum_it->second, cycle->second );
+                  unum, cycle );
 
-    M_memory->setIntercept( sender, unum_it->second, cycle->second, current );
+    M_memory->setIntercept( sender, unum, cycle, current );
 
     return slength();
 }
@@ -311,7 +358,7 @@ GoalieMessageParser::parse( const int sender,
         return 0;
     }
 
-    if ( (int)std::strlen( msg ) < slength() )
+    if ( ! has_length( msg, slength() ) )
     {
         std::cerr << "GoalieMessageParser::parse()."
                   << " Illegal message [" << msg
@@ -325,8 +372,8 @@ GoalieMessageParser::parse( const int sender,
     ++msg;
 
     std::int64_t ival = 0;
-    if ( ! AudioCodec::i().decodeStrToInt64( std::string( msg, slength() - 1 ),
-                                             &ival ) )
+    if ( ! AudioCodec::i().decodeInt64( msg, slength() - 1,
+                                        &ival ) )
     {
         std::cerr << "GoalieMessageParser::parse()"
                   << " Failed to parse [" << msg << "]"
@@ -406,7 +453,7 @@ GoalieAndPlayerMessageParser::parse( const int sender,
         return 0;
     }
 
-    if ( (int)std::strlen( msg ) < slength() )
+    if ( ! has_length( msg, slength() ) )
     {
         std::cerr << "Goalie1PlayerMessageParser::parse()."
                   << " Illegal message [" << msg
@@ -420,8 +467,8 @@ GoalieAndPlayerMessageParser::parse( const int sender,
     ++msg;
 
     std::int64_t ival = 0;
-    if ( ! AudioCodec::i().decodeStrToInt64( std::string( msg, slength() - 1 ),
-                                             &ival ) )
+    if ( ! AudioCodec::i().decodeInt64( msg, slength() - 1,
+                                        &ival ) )
     {
         std::cerr << "Goalie1PlayerMessageParser::parse()"
                   << " Failed to parse [" << msg << "]"
@@ -502,7 +549,7 @@ OffsideLineMessageParser::parse( const int sender,
         return 0;
     }
 
-    if ( (int)std::strlen( msg ) < slength() )
+    if ( ! has_length( msg, slength() ) )
     {
         std::cerr << "OffsideLineMessageParser::parse()"
                   << " Illegal message [" << msg << "]"
@@ -568,7 +615,7 @@ DefenseLineMessageParser::parse( const int sender,
         return 0;
     }
 
-    if ( (int)std::strlen( msg ) < slength() )
+    if ( ! has_length( msg, slength() ) )
     {
         std::cerr << "DefenseLineMessageParser::parse()"
                   << " Illegal message [" << msg << "]"
@@ -662,7 +709,7 @@ SetplayMessageParser::parse( const int sender,
         return 0;
     }
 
-    if ( (int)std::strlen( msg ) < slength() )
+    if ( ! has_length( msg, slength() ) )
     {
         std::cerr << "(SetplayMessageParser::parse) illegal message [" << msg
                   << ']' << std::endl;
@@ -672,9 +719,8 @@ SetplayMessageParser::parse( const int sender,
     }
     ++msg;
 
-    AudioCodec::CharToIntCont::const_iterator it = AudioCodec::i().charToIntMap().find( *msg );
-    if ( it == AudioCodec::i().charToIntMap().end()
-         || it->second <= 0 )
+    const int wait_step = AudioCodec::i().charToInt( *msg );
+    if ( wait_step <= 0 )
     {
         std::cerr << "(SetplayMessageParser::parse) illegal value [" << msg
                   << ']' << std::endl;
@@ -683,7 +729,7 @@ SetplayMessageParser::parse( const int sender,
         return -1;
     }
 
-    M_memory->setSetplay( sender, it->second, current );
+    M_memory->setSetplay( sender, wait_step, current );
     return slength();
 }
 
@@ -716,7 +762,7 @@ PassRequestMessageParser::parse( const int sender,
         return 0;
     }
 
-    if ( (int)std::strlen( msg ) < slength() )
+    if ( ! has_length( msg, slength() ) )
     {
         std::cerr << "PassRequestMessageParser::parse()"
                   << " Illegal pass request message ["
@@ -728,7 +774,7 @@ PassRequestMessageParser::parse( const int sender,
 
     Vector2D pos;
 
-    if ( ! AudioCodec::i().decodeStr3ToPos( std::string( msg, slength() - 1 ),
+    if ( ! AudioCodec::i().decodeStr3ToPos( msg,
                                             &pos ) )
     {
         std::cerr << "PassRequestMessage::parse()"
@@ -779,7 +825,7 @@ StaminaMessageParser::parse( const int sender,
         return 0;
     }
 
-    if ( (int)std::strlen( msg ) < slength() )
+    if ( ! has_length( msg, slength() ) )
     {
         std::cerr << "StaminaMessageParser::parse()"
                   << " Illegal message [" << msg << "]"
@@ -843,7 +889,7 @@ RecoveryMessageParser::parse( const int sender,
         return 0;
     }
 
-    if ( (int)std::strlen( msg ) < slength() )
+    if ( ! has_length( msg, slength() ) )
     {
         std::cerr << "RecoveryMessageParser::parse()"
                   << " Illegal message [" << msg << "]"
@@ -909,7 +955,7 @@ StaminaCapacityMessageParser::parse( const int sender,
         return 0;
     }
 
-    if ( static_cast< int >( std::strlen( msg ) ) < slength() )
+    if ( ! has_length( msg, slength() ) )
     {
         std::cerr << "(StaminaCapacityMessageParser::parse)"
                   << " Illegal message [" << msg << "]"
@@ -973,7 +1019,7 @@ DribbleMessageParser::parse( const int sender,
         return 0;
     }
 
-    if ( (int)std::strlen( msg ) < slength() )
+    if ( ! has_length( msg, slength() ) )
     {
         std::cerr << "DribbleMessageParser::parse()"
                   << " Illegal message ["
@@ -985,8 +1031,8 @@ DribbleMessageParser::parse( const int sender,
 
     std::int64_t ival = 0;
 
-    if ( ! AudioCodec::i().decodeStrToInt64( std::string( msg, slength() - 1 ),
-                                             &ival ) )
+    if ( ! AudioCodec::i().decodeInt64( msg, slength() - 1,
+                                        &ival ) )
     {
         std::cerr << "DribbleMessageParser::parse()"
                   << " Failed to parse [" << msg << "]"
@@ -1051,7 +1097,7 @@ BallGoalieMessageParser::parse( const int sender,
         return 0;
     }
 
-    if ( (int)std::strlen( msg ) < slength() )
+    if ( ! has_length( msg, slength() ) )
     {
         std::cerr << "BallGoalieMessageParser::parse()"
                   << " Illegal message ["
@@ -1062,8 +1108,8 @@ BallGoalieMessageParser::parse( const int sender,
     ++msg;
 
     std::int64_t ival = 0;
-    if ( ! AudioCodec::i().decodeStrToInt64( std::string( msg, slength() - 1 ),
-                                             &ival ) )
+    if ( ! AudioCodec::i().decodeInt64( msg, slength() - 1,
+                                        &ival ) )
     {
         std::cerr << "BallGoalieMessageParser::parse()"
                   << " Failed to parse [" << msg << "]"
@@ -1157,7 +1203,7 @@ OnePlayerMessageParser::parse( const int sender,
         return 0;
     }
 
-    if ( (int)std::strlen( msg ) < slength() )
+    if ( ! has_length( msg, slength() ) )
     {
         std::cerr << "OnePlayerMessageParser::parse()"
                   << " Illegal message ["
@@ -1168,8 +1214,8 @@ OnePlayerMessageParser::parse( const int sender,
     ++msg;
 
     std::int64_t ival = 0;
-    if ( ! AudioCodec::i().decodeStrToInt64( std::string( msg, slength() - 1 ),
-                                             &ival ) )
+    if ( ! AudioCodec::i().decodeInt64( msg, slength() - 1,
+                                        &ival ) )
     {
         std::cerr << "OnePlayerMessageParser::parse()"
                   << " Failed to parse [" << msg << "]"
@@ -1244,7 +1290,7 @@ TwoPlayerMessageParser::parse( const int sender,
         return 0;
     }
 
-    if ( (int)std::strlen( msg ) < slength() )
+    if ( ! has_length( msg, slength() ) )
     {
         std::cerr << "TwoPlayerMessageParser::parse()"
                   << " Illegal message ["
@@ -1255,8 +1301,8 @@ TwoPlayerMessageParser::parse( const int sender,
     ++msg;
 
     std::int64_t ival = 0;
-    if ( ! AudioCodec::i().decodeStrToInt64( std::string( msg, slength() - 1 ),
-                                             &ival ) )
+    if ( ! AudioCodec::i().decodeInt64( msg, slength() - 1,
+                                        &ival ) )
     {
         std::cerr << "TwoPlayerMessageParser::parse()"
                   << " Failed to parse [" << msg << "]"
@@ -1353,7 +1399,7 @@ ThreePlayerMessageParser::parse( const int sender,
         return 0;
     }
 
-    if ( (int)std::strlen( msg ) < slength() )
+    if ( ! has_length( msg, slength() ) )
     {
         std::cerr << "ThreePlayerMessageParser::parse()"
                   << " Illegal message ["
@@ -1364,8 +1410,8 @@ ThreePlayerMessageParser::parse( const int sender,
     ++msg;
 
     std::int64_t ival = 0;
-    if ( ! AudioCodec::i().decodeStrToInt64( std::string( msg, slength() - 1 ),
-                                             &ival ) )
+    if ( ! AudioCodec::i().decodeInt64( msg, slength() - 1,
+                                        &ival ) )
     {
         std::cerr << "ThreePlayerMessageParser::parse()"
                   << " Failed to parse [" << msg << "]"
@@ -1475,7 +1521,7 @@ SelfMessageParser::parse( const int sender,
         return 0;
     }
 
-    if ( (int)std::strlen( msg ) < slength() )
+    if ( ! has_length( msg, slength() ) )
     {
         std::cerr << "SelfMessageParser::parse()"
                   << " Illegal message ["
@@ -1486,8 +1532,8 @@ SelfMessageParser::parse( const int sender,
     ++msg;
 
     std::int64_t ival = 0;
-    if ( ! AudioCodec::i().decodeStrToInt64( std::string( msg, slength() - 1 ),
-                                             &ival ) )
+    if ( ! AudioCodec::i().decodeInt64( msg, slength() - 1,
+                                        &ival ) )
     {
         std::cerr << "SelfMessageParser::parse()"
                   << " Failed to parse [" << msg << "]"
@@ -1571,7 +1617,7 @@ TeammateMessageParser::parse( const int sender,
         return 0;
     }
 
-    if ( (int)std::strlen( msg ) < slength() )
+    if ( ! has_length( msg, slength() ) )
     {
         std::cerr << "TeammateMessageParser::parse()"
                   << " Illegal message ["
@@ -1582,8 +1628,8 @@ TeammateMessageParser::parse( const int sender,
     ++msg;
 
     std::int64_t ival = 0;
-    if ( ! AudioCodec::i().decodeStrToInt64( std::string( msg, slength() - 1 ),
-                                             &ival ) )
+    if ( ! AudioCodec::i().decodeInt64( msg, slength() - 1,
+                                        &ival ) )
     {
         std::cerr << "TeammateMessageParser::parse()"
                   << " Failed to parse [" << msg << "]"
@@ -1665,7 +1711,7 @@ OpponentMessageParser::parse( const int sender,
         return 0;
     }
 
-    if ( (int)std::strlen( msg ) < slength() )
+    if ( ! has_length( msg, slength() ) )
     {
         std::cerr << "OpponentMessageParser::parse()"
                   << " Illegal message ["
@@ -1676,8 +1722,8 @@ OpponentMessageParser::parse( const int sender,
     ++msg;
 
     std::int64_t ival = 0;
-    if ( ! AudioCodec::i().decodeStrToInt64( std::string( msg, slength() - 1 ),
-                                             &ival ) )
+    if ( ! AudioCodec::i().decodeInt64( msg, slength() - 1,
+                                        &ival ) )
     {
         std::cerr << "OpponentMessageParser::parse()"
                   << " Failed to parse [" << msg << "]"
@@ -1754,7 +1800,7 @@ BallPlayerMessageParser::parse( const int sender,
         return 0;
     }
 
-    if ( (int)std::strlen( msg ) < slength() )
+    if ( ! has_length( msg, slength() ) )
     {
         std::cerr << "OnePlayerMessageParser::parse()"
                   << " Illegal message ["
@@ -1767,7 +1813,7 @@ BallPlayerMessageParser::parse( const int sender,
     Vector2D ball_pos;
     Vector2D ball_vel;
 
-    if ( ! AudioCodec::i().decodeStr5ToPosVel( std::string( msg, 5 ),
+    if ( ! AudioCodec::i().decodeStr5ToPosVel( msg,
                                                &ball_pos, &ball_vel ) )
     {
         std::cerr << "***ERROR*** BallPlayerMessageParser::parse()"
@@ -1781,8 +1827,8 @@ BallPlayerMessageParser::parse( const int sender,
     msg += 5;
 
     std::int64_t ival = 0;
-    if ( ! AudioCodec::i().decodeStrToInt64( std::string( msg, 4 ),
-                                             &ival ) )
+    if ( ! AudioCodec::i().decodeInt64( msg, 4,
+                                        &ival ) )
     {
         std::cerr << "BallPlayerMessageParser::parse()"
                   << " Failed to parse [" << msg << "]"
@@ -36,6 +36,7 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 
 namespace rcsc {
 
@@ -97,6 +98,21 @@ public:
                const char * msg,
                const GameTime & current ) = 0;
 
+    /*!
+      \brief parse the message at the cursor, and advance the cursor by the read bytes.
+      \param sender sender's uniform number
+      \param dir sender's direction
+      \param cursor remaining audio message. the viewed string must be null terminated.
+      \param current current game time
+      \retval bytes read if success. the cursor is advanced.
+      \retval 0 message ID is not match. the cursor is not changed.
+      \retval -1 failed to parse. the cursor is not changed.
+    */
+    int consume( const int sender,
+                 const double & dir,
+                 std::string_view & cursor,
+                 const GameTime & current );
+
 };
 
 /*-------------------------------------------------------------------*/
@@ -34,6 +34,7 @@
 #endif
 
 #include "server_param.h"
+#include "server_param_profile.h"
 
 #include <rcsc/param/param_map.h>
 #include <rcsc/param/rcss_param_parser.h>
@@ -710,6 +711,8 @@ ServerParam::setAdditionalParam()
     {
         M_real_speed_max = defaultPlayerSpeedMax();
     }
+
+    M_standard_profile = StandardServerParamProfile::matches( *this );
 }
 
 /*-------------------------------------------------------------------*/
@@ -55,6 +55,8 @@ class ParamMap;
 class ServerParam {
 private:
 
+    friend class ParamSnapshot;
+
     //! parameter map implementation
     std::unique_ptr< ParamMap > M_param_map;
 
@@ -660,6 +662,7 @@ private:
     // additional params
     double M_catchable_area; //!< real catchable length (diagonal line length)
     double M_real_speed_max; //!< default player's real max speed
+    bool M_standard_profile; //!< true if the parameters match StandardServerParamProfile
 
 private:
     /*!
@@ -1257,6 +1260,15 @@ public:
           return M_real_speed_max;
       }
 
+    /*!
+      \brief check if the current parameters match the standard competition settings
+      \return true if the kernels can use StandardServerParamProfile
+     */
+    bool isStandardProfile() const
+      {
+          return M_standard_profile;
+      }
+
     double recoverDecThrValue() const
       {
           return recoverDecThr() * staminaMax();
@@ -0,0 +1,142 @@
+// -*-c++-*-
+
+/*!
+  \file server_param_profile.h
+  \brief compile-time server parameter profile Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_COMMON_SERVER_PARAM_PROFILE_H
+#define RCSC_COMMON_SERVER_PARAM_PROFILE_H
+
+#include <rcsc/common/server_param.h>
+
+namespace rcsc {
+
+/*!
+  \struct StandardServerParamProfile
+  \brief constexpr server parameters of the standard competition settings
+  (the default values of rcssserver).
+
+  The hot kernels are written as templates on the profile type. When the live
+  parameters match this profile (ServerParam::isStandardProfile()), the
+  instantiation with this class is used, so that the compiler can fold the
+  constants. Otherwise, RuntimeServerParamProfile is used.
+*/
+struct StandardServerParamProfile {
+
+    static constexpr double ballSize() { return 0.085; }
+    static constexpr double ballDecay() { return 0.94; }
+    static constexpr double ballRand() { return 0.05; }
+    static constexpr double ballSpeedMax() { return 3.0; }
+    static constexpr double ballAccelMax() { return 2.7; }
+
+    static constexpr double playerRand() { return 0.1; }
+
+    static constexpr double maxPower() { return 100.0; }
+    static constexpr double maxDashPower() { return 100.0; }
+    static constexpr double minDashPower() { return 0.0; }
+
+    static constexpr double staminaMax() { return 8000.0; }
+    static constexpr double staminaCapacity() { return 130600.0; }
+    static constexpr double recoverDecThr() { return 0.3; }
+    static constexpr double recoverDec() { return 0.002; }
+    static constexpr double recoverMin() { return 0.5; }
+    static constexpr double effortDecThr() { return 0.3; }
+    static constexpr double effortDec() { return 0.005; }
+    static constexpr double effortIncThr() { return 0.6; }
+    static constexpr double effortInc() { return 0.01; }
+
+    static constexpr double recoverDecThrValue() { return recoverDecThr() * staminaMax(); }
+    static constexpr double effortDecThrValue() { return effortDecThr() * staminaMax(); }
+    static constexpr double effortIncThrValue() { return effortIncThr() * staminaMax(); }
+
+    /*!
+      \brief check if the parameters are same as this profile
+      \param param checked parameters
+      \return true if all values of this profile are equal
+     */
+    static
+    bool matches( const ServerParam & param )
+      {
+          return ( param.ballSize() == ballSize()
+                   && param.ballDecay() == ballDecay()
+                   && param.ballRand() == ballRand()
+                   && param.ballSpeedMax() == ballSpeedMax()
+                   && param.ballAccelMax() == ballAccelMax()
+                   && param.playerRand() == playerRand()
+                   && param.maxPower() == maxPower()
+                   && param.maxDashPower() == maxDashPower()
+                   && param.minDashPower() == minDashPower()
+                   && param.staminaMax() == staminaMax()
+                   && param.staminaCapacity() == staminaCapacity()
+                   && param.recoverDecThr() == recoverDecThr()
+                   && param.recoverDec() == recoverDec()
+                   && param.recoverMin() == recoverMin()
+                   && param.effortDecThr() == effortDecThr()
+                   && param.effortDec() == effortDec()
+                   && param.effortIncThr() == effortIncThr()
+                   && param.effortInc() == effortInc() );
+      }
+};
+
+/*!
+  \struct RuntimeServerParamProfile
+  \brief generic profile that reads the live parameters from ServerParam
+*/
+struct RuntimeServerParamProfile {
+
+    static double ballSize() { return ServerParam::i().ballSize(); }
+    static double ballDecay() { return ServerParam::i().ballDecay(); }
+    static double ballRand() { return ServerParam::i().ballRand(); }
+    static double ballSpeedMax() { return ServerParam::i().ballSpeedMax(); }
+    static double ballAccelMax() { return ServerParam::i().ballAccelMax(); }
+
+    static double playerRand() { return ServerParam::i().playerRand(); }
+
+    static double maxPower() { return ServerParam::i().maxPower(); }
+    static double maxDashPower() { return ServerParam::i().maxDashPower(); }
+    static double minDashPower() { return ServerParam::i().minDashPower(); }
+
+    static double staminaMax() { return ServerParam::i().staminaMax(); }
+    static double staminaCapacity() { return ServerParam::i().staminaCapacity(); }
+    static double recoverDecThr() { return ServerParam::i().recoverDecThr(); }
+    static double recoverDec() { return ServerParam::i().recoverDec(); }
+    static double recoverMin() { return ServerParam::i().recoverMin(); }
+    static double effortDecThr() { return ServerParam::i().effortDecThr(); }
+    static double effortDec() { return ServerParam::i().effortDec(); }
+    static double effortIncThr() { return ServerParam::i().effortIncThr(); }
+    static double effortInc() { return ServerParam::i().effortInc(); }
+
+    static double recoverDecThrValue() { return ServerParam::i().recoverDecThrValue(); }
+    static double effortDecThrValue() { return ServerParam::i().effortDecThrValue(); }
+    static double effortIncThrValue() { return ServerParam::i().effortIncThrValue(); }
+};
+
+}
+
+#endif
@@ -0,0 +1,100 @@
+// -*-c++-*-
+
+/*!
+  \file shared_param.cpp
+  \brief process wide update of the shared parameter instances Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "shared_param.h"
+
+#include <unordered_set>
+#include <string>
+#include <mutex>
+
+namespace rcsc {
+
+namespace {
+
+std::mutex &
+applied_mutex()
+{
+    static std::mutex s_mutex;
+    return s_mutex;
+}
+
+std::unordered_set< std::string > &
+applied_messages()
+{
+    static std::unordered_set< std::string > s_messages;
+    return s_messages;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+SharedParam::apply( const char * msg,
+                    const double version,
+                    const std::function< void() > & update )
+{
+    std::string key = std::to_string( version );
+    key += ' ';
+    key += msg;
+
+    // the lock is held during the update, so the agents that receive the
+    // same message wait until the instances are completely updated.
+    std::lock_guard< std::mutex > lock( applied_mutex() );
+
+    if ( applied_messages().count( key ) )
+    {
+        return false;
+    }
+
+    update();
+    applied_messages().insert( std::move( key ) );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SharedParam::clear()
+{
+    std::lock_guard< std::mutex > lock( applied_mutex() );
+    applied_messages().clear();
+}
+
+}
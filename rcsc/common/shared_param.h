@@ -0,0 +1,74 @@
+// -*-c++-*-
+
+/*!
+  \file shared_param.h
+  \brief process wide update of the shared parameter instances Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_COMMON_SHARED_PARAM_H
+#define RCSC_COMMON_SHARED_PARAM_H
+
+#include <functional>
+
+namespace rcsc {
+
+/*!
+  \class SharedParam
+  \brief serializes the updates of ServerParam, PlayerParam and PlayerTypeSet.
+
+  These instances are process wide singletons. When several agents run
+  as threads in one process (see TeamRunner), every agent receives the
+  same server_param, player_param and player_type messages. apply()
+  executes the update only for the first arrival of each message, so the
+  other agents never write to the instances while they are being read.
+*/
+class SharedParam {
+public:
+
+    /*!
+      \brief execute the update if the same message has not been applied yet
+      \param msg raw parameter message
+      \param version client protocol version used to parse the message
+      \param update function that writes the process wide instances
+      \return true if update was executed
+    */
+    static
+    bool apply( const char * msg,
+                const double version,
+                const std::function< void() > & update );
+
+    /*!
+      \brief forget all applied messages.
+      the next message is always applied.
+    */
+    static
+    void clear();
+};
+
+}
+
+#endif
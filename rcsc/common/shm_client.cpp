@@ -0,0 +1,271 @@
+// -*-c++-*-
+
+/*!
+  \file shm_client.cpp
+  \brief shared memory transport soccer client Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "shm_client.h"
+
+#include "soccer_agent.h"
+
+#include <rcsc/net/udp_socket.h>
+
+#include <chrono>
+#include <iostream>
+#include <cassert>
+
+namespace rcsc {
+
+constexpr int ShmClient::CONNECT_TIMEOUT_MSEC;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ShmClient::ShmClient()
+    : AbstractClient(),
+      M_receive_buffer( MAX_MESG )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ShmClient::~ShmClient()
+{
+    if ( M_offline_out.is_open() )
+    {
+        M_offline_out.flush();
+        M_offline_out.close();
+    }
+
+    M_transport.close();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ShmClient::run( SoccerAgent * agent )
+{
+    assert( agent );
+
+    if ( ! handleStart( agent )
+         || ! isServerAlive() )
+    {
+        handleExit( agent );
+        return;
+    }
+
+    int timeout_count = 0;
+    int waited_msec = 0;
+
+    while ( isServerAlive() )
+    {
+        if ( M_transport.wait( intervalMSec() ) )
+        {
+            // received message, reset wait time
+            waited_msec = 0;
+            timeout_count = 0;
+            handleMessage( agent );
+        }
+        else if ( M_transport.isPeerClosed() )
+        {
+            std::cerr << "(ShmClient::run) the server side has closed the transport."
+                      << std::endl;
+            setServerAlive( false );
+        }
+        else
+        {
+            // no meesage. timeout.
+            waited_msec += intervalMSec();
+            ++timeout_count;
+            handleTimeout( agent, timeout_count, waited_msec );
+        }
+    }
+
+    handleExit( agent );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ShmClient::connectTo( const char * hostname,
+                      const int port )
+{
+    if ( ! ShmTransport::is_supported()
+         || ! M_transport.create( ShmTransport::make_name() ) )
+    {
+        std::cerr << "(ShmClient::connectTo) Failed to create the transport."
+                  << std::endl;
+        setServerAlive( false );
+        return false;
+    }
+
+    UDPSocket socket( hostname, port );
+    if ( socket.fd() == -1 )
+    {
+        std::cerr << "(ShmClient::connectTo) Failed to create the handshake socket."
+                  << std::endl;
+        M_transport.close();
+        setServerAlive( false );
+        return false;
+    }
+
+    const std::string request = "(shm_connect " + M_transport.name() + ")";
+
+    // the datagram may be lost. it is resent until the server side attaches.
+    const std::chrono::steady_clock::time_point end
+        = std::chrono::steady_clock::now() + std::chrono::milliseconds( CONNECT_TIMEOUT_MSEC );
+    std::chrono::steady_clock::time_point resend_time = std::chrono::steady_clock::now();
+
+    while ( ! M_transport.isPeerAttached() )
+    {
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if ( now > end )
+        {
+            std::cerr << "(ShmClient::connectTo) the server side did not attach the transport "
+                      << M_transport.name() << std::endl;
+            M_transport.close();
+            setServerAlive( false );
+            return false;
+        }
+
+        if ( now >= resend_time )
+        {
+            socket.writeDatagram( request.c_str(), request.length() + 1 );
+            resend_time = now + std::chrono::milliseconds( 500 );
+        }
+
+        M_transport.wait( 10 );
+    }
+
+    setServerAlive( true );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+ShmClient::sendMessage( const char * msg )
+{
+    if ( ! M_transport.isOpen() )
+    {
+        return 0;
+    }
+
+    compress( msg );
+
+    if ( ! M_sent_message.empty() )
+    {
+        const int n = M_transport.send( M_sent_message.data(),
+                                        M_sent_message.length() );
+        M_sent_nsec = UDPSocket::now_nsec();
+        return n;
+    }
+
+    return 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+ShmClient::receiveMessage()
+{
+    if ( ! M_transport.isOpen() )
+    {
+        return 0;
+    }
+
+    const int n = M_transport.receive( M_receive_buffer.data(), M_receive_buffer.size() );
+
+    if ( n > 0 )
+    {
+        M_received_nsec = UDPSocket::now_nsec();
+        decompress( M_receive_buffer.data(), n );
+
+        if ( M_offline_out.is_open() )
+        {
+            M_offline_out << M_received_message << '\n';
+        }
+    }
+
+    return n;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ShmClient::openOfflineLog( const std::string & filepath )
+{
+    M_offline_out.close();
+    M_offline_out.open( filepath.c_str() );
+
+    if ( ! M_offline_out.is_open() )
+    {
+        return false;
+    }
+
+    if ( ! M_received_message.empty() )
+    {
+        M_offline_out << M_received_message << std::endl;
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ShmClient::printOfflineThink()
+{
+    if ( M_offline_out.is_open() )
+    {
+        M_offline_out << "(think)" << std::endl;
+    }
+}
+
+}
@@ -0,0 +1,139 @@
+// -*-c++-*-
+
+/*!
+  \file shm_client.h
+  \brief shared memory transport soccer client Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_COMMON_SHM_CLIENT_H
+#define RCSC_COMMON_SHM_CLIENT_H
+
+#include <rcsc/common/abstract_client.h>
+#include <rcsc/net/shm_transport.h>
+
+#include <fstream>
+#include <vector>
+
+namespace rcsc {
+
+/*!
+  \class ShmClient
+  \brief soccer client that exchanges the text protocol with the co-located
+  server through the shared memory rings (ShmTransport).
+
+  The server is expected to be patched, or to be relayed by a proxy on the
+  same host. The handshake is:
+   - the client creates the transport segment, and sends one UDP datagram
+     "(shm_connect <segment name>)" to the given host and port.
+   - the server side attaches the segment by ShmTransport::attach().
+   - after that, all messages including the init command are exchanged
+     through the segment. each ring record is one datagram of the text protocol.
+ */
+class ShmClient
+    : public AbstractClient {
+public:
+
+    //! the maximum wait time for the server side to attach
+    static constexpr int CONNECT_TIMEOUT_MSEC = 5000;
+
+private:
+
+    //! shared memory channel
+    ShmTransport M_transport;
+
+    //! output file for offline logging
+    std::ofstream M_offline_out;
+
+    //! receive buffer
+    std::vector< char > M_receive_buffer;
+
+public:
+    /*!
+      \brief default constructor.
+     */
+    ShmClient();
+
+    /*!
+      \brief destructor. the transport is closed.
+     */
+    ~ShmClient();
+
+    /*!
+      \brief program mainloop
+      \param agent pointer to the soccer agent instance.
+
+      The same as OnlineClient::run(), but the client sleeps on the futex of
+      the receive ring instead of select().
+     */
+    virtual
+    void run( SoccerAgent * agent );
+
+    /*!
+      \brief create the transport, and request the server side to attach it
+      \param hostname server (or proxy) host name
+      \param port server (or proxy) port number to receive the handshake datagram
+      \return true if the server side has attached the transport.
+     */
+    virtual
+    bool connectTo( const char * hostname,
+                    const int port );
+
+    /*!
+      \brief send raw string to the server
+      \param msg message to be sent
+      \return the length of sent data, 0 if the ring is full, or -1 if an error occured.
+     */
+    virtual
+    int sendMessage( const char * msg );
+
+    /*!
+      \brief receive one server message in the ring.
+      If an offline log file is opened, all received messages are recoreded to the file.
+      \return length of received message
+     */
+    virtual
+    int receiveMessage();
+
+    /*!
+      \brief open the offline client log file.
+      \param filepath file path string to be opened.
+      \return result status.
+     */
+    virtual
+    bool openOfflineLog( const std::string & filepath ) ;
+
+    /*!
+      \brief write "(think)" message to the offline log file.
+     */
+    virtual
+    void printOfflineThink();
+};
+
+}
+
+#endif
@@ -0,0 +1,643 @@
+// -*-c++-*-
+
+/*!
+  \file space_control.cpp
+  \brief voronoi space control of the players Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "space_control.h"
+
+#include <rcsc/common/server_param.h>
+
+#include <unordered_map>
+
+namespace rcsc {
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get twice the signed area of the triangle (a, b, c)
+  \return positive value if (a, b, c) is counter clockwise
+ */
+inline
+double
+signed_area2( const Vector2D & a,
+              const Vector2D & b,
+              const Vector2D & c )
+{
+    return ( b.x - a.x ) * ( c.y - a.y ) - ( b.y - a.y ) * ( c.x - a.x );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief in-circle test
+  \param a, b, c counter clockwise triangle
+  \param d checked point
+  \return positive value if d is inside of the circumcircle of (a, b, c)
+ */
+inline
+double
+in_circle( const Vector2D & a,
+           const Vector2D & b,
+           const Vector2D & c,
+           const Vector2D & d )
+{
+    const double adx = a.x - d.x, ady = a.y - d.y;
+    const double bdx = b.x - d.x, bdy = b.y - d.y;
+    const double cdx = c.x - d.x, cdy = c.y - d.y;
+
+    return ( ( adx * adx + ady * ady ) * ( bdx * cdy - cdx * bdy )
+             + ( bdx * bdx + bdy * bdy ) * ( cdx * ady - adx * cdy )
+             + ( cdx * cdx + cdy * cdy ) * ( adx * bdy - bdx * ady ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief clip the convex polygon by the half plane { u | dot(a, u) <= c }
+  \param poly clipped polygon
+  \param a normal vector of the boundary line
+  \param c offset value
+  \param buf working buffer
+ */
+void
+clip_half_plane( std::vector< Vector2D > & poly,
+                 const Vector2D & a,
+                 const double c,
+                 std::vector< Vector2D > & buf )
+{
+    buf.clear();
+
+    const std::size_t size = poly.size();
+    for ( std::size_t i = 0; i < size; ++i )
+    {
+        const Vector2D & p = poly[i];
+        const Vector2D & q = poly[( i + 1 ) % size];
+        const double dp = a.x * p.x + a.y * p.y - c;
+        const double dq = a.x * q.x + a.y * q.y - c;
+
+        if ( dp <= 0.0 )
+        {
+            buf.push_back( p );
+        }
+
+        if ( ( dp < 0.0 && dq > 0.0 )
+             || ( dp > 0.0 && dq < 0.0 ) )
+        {
+            const double t = dp / ( dp - dq );
+            buf.emplace_back( p.x + ( q.x - p.x ) * t,
+                              p.y + ( q.y - p.y ) * t );
+        }
+    }
+
+    poly.swap( buf );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+SpaceControl::SpaceControl()
+    : M_pitch( Rect2D::from_center( 0.0, 0.0,
+                                    ServerParam::DEFAULT_PITCH_LENGTH + ServerParam::DEFAULT_PITCH_MARGIN * 2.0,
+                                    ServerParam::DEFAULT_PITCH_WIDTH + ServerParam::DEFAULT_PITCH_MARGIN * 2.0 ) ),
+      M_time_horizon( 10.0 ),
+      M_reused( false )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+SpaceControl::SpaceControl( const Rect2D & pitch )
+    : M_pitch( pitch ),
+      M_time_horizon( 10.0 ),
+      M_reused( false )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+SpaceControl::addSite( const Vector2D & pos,
+                       const double speed )
+{
+    M_cells.emplace_back();
+
+    Cell & cell = M_cells.back();
+    cell.site_ = pos;
+    cell.speed_ = speed;
+    cell.area_ = 0.0;
+    cell.centroid_ = Vector2D::INVALIDATED;
+
+    return static_cast< int >( M_cells.size() ) - 1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SpaceControl::compute( const Metric metric )
+{
+    M_reused = false;
+
+    std::vector< int > all_sites;
+    bool use_all_sites = ( metric == TIME );
+
+    if ( metric == DISTANCE )
+    {
+        if ( ! M_edges.empty()
+             && M_neighbours.size() == M_cells.size()
+             && isEmbedded()
+             && convexifyHull()
+             && legalizeEdges() )
+        {
+            M_reused = true;
+        }
+        else if ( ! updateTopology() )
+        {
+            use_all_sites = true;
+        }
+    }
+
+    if ( use_all_sites )
+    {
+        all_sites.reserve( M_cells.size() );
+        for ( std::size_t i = 0; i < M_cells.size(); ++i )
+        {
+            all_sites.push_back( static_cast< int >( i ) );
+        }
+    }
+
+    for ( std::size_t i = 0; i < M_cells.size(); ++i )
+    {
+        computeCell( i,
+                     ( use_all_sites ? all_sites : M_neighbours[i] ),
+                     metric );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+SpaceControl::isEmbedded() const
+{
+    for ( const std::array< int, 4 > & e : M_edges )
+    {
+        const Vector2D & v0 = M_cells[e[0]].site_;
+        const Vector2D & v1 = M_cells[e[1]].site_;
+
+        if ( signed_area2( v0, v1, M_cells[e[2]].site_ ) <= 0.0 )
+        {
+            return false;
+        }
+
+        if ( e[3] >= 0
+             && signed_area2( v1, v0, M_cells[e[3]].site_ ) <= 0.0 )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+SpaceControl::convexifyHull()
+{
+    const int n = static_cast< int >( M_cells.size() );
+    bool changed = false;
+
+    std::size_t i = 0;
+    while ( i < M_hull.size() )
+    {
+        if ( M_hull.size() <= 3 )
+        {
+            return false;
+        }
+
+        const std::size_t size = M_hull.size();
+        const int u = M_hull[i];
+        const int v = M_hull[( i + 1 ) % size];
+        const int w = M_hull[( i + 2 ) % size];
+
+        if ( signed_area2( M_cells[u].site_, M_cells[v].site_, M_cells[w].site_ ) >= 0.0 )
+        {
+            ++i;
+            continue;
+        }
+
+        if ( M_edge_index[u * n + w] >= 0 )
+        {
+            return false;
+        }
+
+        // add the triangle (u, w, v) out of the hull edges (u, v) and (v, w)
+        M_edges[M_edge_index[u * n + v]][3] = w;
+        M_edges[M_edge_index[v * n + w]][3] = u;
+
+        M_edge_index[u * n + w] = M_edge_index[w * n + u] = static_cast< int >( M_edges.size() );
+        M_edges.push_back( { u, w, v, -1 } );
+
+        const std::size_t erased = ( i + 1 ) % size;
+        M_hull.erase( M_hull.begin() + erased );
+        changed = true;
+
+        if ( erased < i ) --i;
+        // the previous vertex may become a dent.
+        if ( i > 0 ) --i;
+    }
+
+    if ( changed )
+    {
+        updateNeighbours();
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+SpaceControl::legalizeEdges()
+{
+    // the flips never loop in the exact arithmetic. the limit is for the rounding errors.
+    const std::size_t max_flip = M_edges.size() * 4;
+    std::size_t flip_count = 0;
+
+    std::vector< int > & stack = M_flip_stack;
+    stack.clear();
+    for ( std::size_t i = 0; i < M_edges.size(); ++i )
+    {
+        stack.push_back( static_cast< int >( i ) );
+    }
+
+    while ( ! stack.empty() )
+    {
+        const int index = stack.back();
+        stack.pop_back();
+
+        const std::array< int, 4 > e = M_edges[index];
+        if ( e[3] < 0
+             || in_circle( M_cells[e[0]].site_,
+                           M_cells[e[1]].site_,
+                           M_cells[e[2]].site_,
+                           M_cells[e[3]].site_ ) <= 0.0 )
+        {
+            continue;
+        }
+
+        if ( ++flip_count > max_flip )
+        {
+            return false;
+        }
+
+        flipEdge( index );
+
+        const int n = static_cast< int >( M_cells.size() );
+        stack.push_back( M_edge_index[e[0] * n + e[2]] );
+        stack.push_back( M_edge_index[e[1] * n + e[2]] );
+        stack.push_back( M_edge_index[e[0] * n + e[3]] );
+        stack.push_back( M_edge_index[e[1] * n + e[3]] );
+    }
+
+    if ( flip_count > 0 )
+    {
+        updateNeighbours();
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SpaceControl::flipEdge( const int index )
+{
+    // the edge (v0, v1) in the quadrilateral (v0, o1, v1, o0) is replaced by (o1, o0).
+    const std::array< int, 4 > e = M_edges[index];
+    const int n = static_cast< int >( M_cells.size() );
+
+    replaceOpposite( e[0], e[2], e[1], e[3] );
+    replaceOpposite( e[1], e[2], e[0], e[3] );
+    replaceOpposite( e[0], e[3], e[1], e[2] );
+    replaceOpposite( e[1], e[3], e[0], e[2] );
+
+    M_edge_index[e[0] * n + e[1]] = M_edge_index[e[1] * n + e[0]] = -1;
+    M_edge_index[e[2] * n + e[3]] = M_edge_index[e[3] * n + e[2]] = index;
+
+    // (o1, o0, v0) and (o0, o1, v1) are counter clockwise.
+    M_edges[index] = { e[3], e[2], e[0], e[1] };
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SpaceControl::replaceOpposite( const int site0,
+                               const int site1,
+                               const int old_site,
+                               const int new_site )
+{
+    std::array< int, 4 > & e = M_edges[M_edge_index[site0 * static_cast< int >( M_cells.size() ) + site1]];
+    if ( e[2] == old_site )
+    {
+        e[2] = new_site;
+    }
+    else
+    {
+        e[3] = new_site;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SpaceControl::updateNeighbours()
+{
+    M_neighbours.resize( M_cells.size() );
+    for ( std::vector< int > & n : M_neighbours )
+    {
+        n.clear();
+    }
+
+    for ( const std::array< int, 4 > & e : M_edges )
+    {
+        M_neighbours[e[0]].push_back( e[1] );
+        M_neighbours[e[1]].push_back( e[0] );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+SpaceControl::updateTopology()
+{
+    const int n = static_cast< int >( M_cells.size() );
+
+    M_edges.clear();
+    M_edge_index.assign( n * n, -1 );
+    M_hull.clear();
+    M_neighbours.assign( n, std::vector< int >() );
+
+    if ( n < 3 )
+    {
+        return false;
+    }
+
+    // the sites at the same position cannot be the vertices of the triangulation.
+    for ( int i = 0; i < n; ++i )
+    {
+        for ( int j = i + 1; j < n; ++j )
+        {
+            if ( M_cells[i].site_.equals( M_cells[j].site_ ) )
+            {
+                return false;
+            }
+        }
+    }
+
+    M_triangulation.clear();
+    for ( const Cell & cell : M_cells )
+    {
+        M_triangulation.addVertex( cell.site_ );
+    }
+    M_triangulation.compute();
+
+    bool result = ! M_triangulation.triangles().empty();
+
+    // key: hull site, value: next hull site in counter clockwise order
+    std::unordered_map< int, int > hull_next;
+
+    for ( const DelaunayTriangulation::EdgeCont::value_type & v : M_triangulation.edges() )
+    {
+        const DelaunayTriangulation::Edge * edge = v.second;
+        std::array< int, 4 > e = { edge->vertex( 0 )->id(), edge->vertex( 1 )->id(), -1, -1 };
+
+        for ( std::size_t i = 0; i < 2; ++i )
+        {
+            if ( edge->triangle( i ) )
+            {
+                e[2 + i] = edge->triangle( i )->getVertexExclude( edge )->id();
+            }
+        }
+
+        if ( e[2] < 0 )
+        {
+            std::swap( e[2], e[3] );
+        }
+
+        if ( e[2] < 0 )
+        {
+            // isolated edge
+            result = false;
+            break;
+        }
+
+        if ( signed_area2( M_cells[e[0]].site_, M_cells[e[1]].site_, M_cells[e[2]].site_ ) < 0.0 )
+        {
+            std::swap( e[0], e[1] );
+        }
+
+        if ( e[3] < 0 )
+        {
+            hull_next[e[0]] = e[1];
+        }
+
+        M_edge_index[e[0] * n + e[1]] = M_edge_index[e[1] * n + e[0]] = static_cast< int >( M_edges.size() );
+        M_edges.push_back( e );
+    }
+
+    updateNeighbours();
+
+    for ( const std::vector< int > & v : M_neighbours )
+    {
+        if ( v.empty() )
+        {
+            result = false;
+        }
+    }
+
+    //
+    // create the hull cycle
+    //
+    if ( result )
+    {
+        int site = hull_next.begin()->first;
+        do
+        {
+            M_hull.push_back( site );
+            std::unordered_map< int, int >::const_iterator it = hull_next.find( site );
+            if ( it == hull_next.end()
+                 || M_hull.size() > hull_next.size() )
+            {
+                result = false;
+                break;
+            }
+            site = it->second;
+        }
+        while ( site != M_hull.front() );
+
+        result = ( result && M_hull.size() == hull_next.size() );
+    }
+
+    // the triangulation may lack the thin triangles on the convex hull.
+    if ( ! result
+         || ! isEmbedded()
+         || ! convexifyHull()
+         || ! legalizeEdges() )
+    {
+        M_edges.clear();
+        M_hull.clear();
+        M_neighbours.assign( n, std::vector< int >() );
+        return false;
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SpaceControl::computeCell( const std::size_t index,
+                           const std::vector< int > & others,
+                           const Metric metric )
+{
+    Cell & cell = M_cells[index];
+
+    // the polygon is created relative to the site position.
+    const Vector2D & site = cell.site_;
+    const double radius = ( metric == TIME
+                            ? cell.speed_ * M_time_horizon
+                            : 0.0 );
+
+    std::vector< Vector2D > & poly = M_clip_buf[0];
+    std::vector< Vector2D > & buf = M_clip_buf[1];
+
+    poly.clear();
+    poly.emplace_back( M_pitch.minX() - site.x, M_pitch.minY() - site.y );
+    poly.emplace_back( M_pitch.maxX() - site.x, M_pitch.minY() - site.y );
+    poly.emplace_back( M_pitch.maxX() - site.x, M_pitch.maxY() - site.y );
+    poly.emplace_back( M_pitch.minX() - site.x, M_pitch.maxY() - site.y );
+
+    for ( const int j : others )
+    {
+        if ( j == static_cast< int >( index ) )
+        {
+            continue;
+        }
+
+        const Cell & other = M_cells[j];
+
+        // |u|^2 - r_i^2 <= |u - a|^2 - r_j^2  <=>  dot(a, u) <= ( |a|^2 + r_i^2 - r_j^2 ) / 2
+        const Vector2D a = other.site_ - site;
+        const double other_radius = ( metric == TIME
+                                      ? other.speed_ * M_time_horizon
+                                      : 0.0 );
+        const double c = ( a.r2() + radius * radius - other_radius * other_radius ) * 0.5;
+
+        if ( a.x == 0.0 && a.y == 0.0 )
+        {
+            if ( c < 0.0 )
+            {
+                poly.clear();
+                break;
+            }
+            continue;
+        }
+
+        clip_half_plane( poly, a, c, buf );
+        if ( poly.empty() )
+        {
+            break;
+        }
+    }
+
+    double area2 = 0.0;
+    double cx = 0.0;
+    double cy = 0.0;
+    const std::size_t size = poly.size();
+    for ( std::size_t i = 0; i < size; ++i )
+    {
+        const Vector2D & p = poly[i];
+        const Vector2D & q = poly[( i + 1 ) % size];
+        const double cross = p.x * q.y - q.x * p.y;
+        area2 += cross;
+        cx += ( p.x + q.x ) * cross;
+        cy += ( p.y + q.y ) * cross;
+    }
+
+    if ( size < 3
+         || area2 <= 0.0 )
+    {
+        cell.polygon_.clear();
+        cell.area_ = 0.0;
+        cell.centroid_ = Vector2D::INVALIDATED;
+        return;
+    }
+
+    for ( Vector2D & p : poly )
+    {
+        p += site;
+    }
+
+    cell.polygon_.assign( poly );
+    cell.area_ = area2 * 0.5;
+    cell.centroid_.assign( site.x + cx / ( 3.0 * area2 ),
+                           site.y + cy / ( 3.0 * area2 ) );
+}
+
+}
@@ -0,0 +1,283 @@
+// -*-c++-*-
+
+/*!
+  \file space_control.h
+  \brief voronoi space control of the players Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_COMMON_SPACE_CONTROL_H
+#define RCSC_COMMON_SPACE_CONTROL_H
+
+#include <rcsc/common/player_type.h>
+#include <rcsc/geom/delaunay_triangulation.h>
+#include <rcsc/geom/polygon_2d.h>
+#include <rcsc/geom/rect_2d.h>
+#include <rcsc/geom/vector_2d.h>
+
+#include <array>
+#include <vector>
+
+namespace rcsc {
+
+/*!
+  \class SpaceControl
+  \brief voronoi cells of the players clipped by the pitch rectangle.
+
+  The sites are registered in every cycle, and compute() creates one cell
+  polygon with its area and centroid for each site.
+
+  DISTANCE metric creates the ordinary voronoi cells. Each cell is clipped only
+  by the Delaunay neighbours of the site. The topology of the last
+  triangulation is kept and repaired for the moved sites: the dents of the
+  convex hull are filled by new triangles, and the illegal edges are flipped.
+  The sites are triangulated again only if a triangle is inverted, that is
+  rare because the players move little in one cycle.
+
+  TIME metric weights the sites by the reachable distance within the time
+  horizon (speed * horizon). The cells are the power diagram of the reachable
+  circles, so the cell edges are still straight lines and the cells fill the
+  pitch without gaps. A faster player gets a larger cell. These cells are
+  clipped by all other sites.
+
+  The sites at the same position share the same cell.
+*/
+class SpaceControl {
+public:
+
+    /*!
+      \brief distance metric of the cells
+     */
+    enum Metric {
+        DISTANCE, //!< euclidean distance
+        TIME, //!< reach time estimated by the site speed
+    };
+
+    /*!
+      \struct Cell
+      \brief the region controlled by one site
+     */
+    struct Cell {
+        Vector2D site_; //!< site position
+        double speed_; //!< site speed [m/cycle]
+        Polygon2D polygon_; //!< counter clockwise cell polygon. empty if the site controls no region.
+        double area_; //!< cell area
+        Vector2D centroid_; //!< cell centroid. invalidated if the cell is empty.
+    };
+
+private:
+
+    Rect2D M_pitch; //!< clipping rectangle
+    double M_time_horizon; //!< time horizon [cycle] for TIME metric
+
+    std::vector< Cell > M_cells; //!< site and cell container
+
+    DelaunayTriangulation M_triangulation; //!< triangulation instance
+    std::vector< std::array< int, 4 > > M_edges; //!< two sites and their left and right opposite sites (-1 for the hull)
+    std::vector< int > M_edge_index; //!< edge index for each site pair. key: site0 * size + site1
+    std::vector< int > M_hull; //!< counter clockwise convex hull sites
+    std::vector< std::vector< int > > M_neighbours; //!< Delaunay neighbours of each site
+    bool M_reused; //!< true if the last compute() reused the topology
+
+    std::vector< int > M_flip_stack; //!< working buffer for the edge flips
+    std::vector< Vector2D > M_clip_buf[2]; //!< working buffers for the polygon clipping
+
+public:
+
+    /*!
+      \brief create the engine for the default pitch including the margin.
+     */
+    SpaceControl();
+
+    /*!
+      \brief create the engine with the clipping rectangle
+      \param pitch clipping rectangle
+     */
+    explicit
+    SpaceControl( const Rect2D & pitch );
+
+    /*!
+      \brief set the clipping rectangle
+      \param pitch new rectangle
+     */
+    void setPitch( const Rect2D & pitch )
+      {
+          M_pitch = pitch;
+      }
+
+    /*!
+      \brief get the clipping rectangle
+      \return const reference to the rectangle
+     */
+    const Rect2D & pitch() const
+      {
+          return M_pitch;
+      }
+
+    /*!
+      \brief set the time horizon for TIME metric
+      \param cycles time horizon [cycle]
+     */
+    void setTimeHorizon( const double cycles )
+      {
+          M_time_horizon = cycles;
+      }
+
+    /*!
+      \brief get the time horizon for TIME metric
+      \return time horizon [cycle]
+     */
+    double timeHorizon() const
+      {
+          return M_time_horizon;
+      }
+
+    /*!
+      \brief remove all sites. the kept topology is not cleared.
+     */
+    void clearSites()
+      {
+          M_cells.clear();
+      }
+
+    /*!
+      \brief add the site
+      \param pos site position
+      \param speed site speed [m/cycle] used by TIME metric
+      \return index of the added site
+     */
+    int addSite( const Vector2D & pos,
+                 const double speed = 1.0 );
+
+    /*!
+      \brief add the player site.
+      \param pos player position
+      \param type player type. the reachable max speed is used by TIME metric.
+      \return index of the added site
+     */
+    int addSite( const Vector2D & pos,
+                 const PlayerType & type )
+      {
+          return addSite( pos, type.realSpeedMax() );
+      }
+
+    /*!
+      \brief compute the cell of each site.
+      \param metric distance metric
+     */
+    void compute( const Metric metric = DISTANCE );
+
+    /*!
+      \brief get the site and cell container
+      \return const reference to the container. the order is the same as addSite().
+     */
+    const std::vector< Cell > & cells() const
+      {
+          return M_cells;
+      }
+
+    /*!
+      \brief get the Delaunay neighbours of each site. updated by compute() with DISTANCE metric.
+      \return const reference to the container of site indices.
+     */
+    const std::vector< std::vector< int > > & neighbours() const
+      {
+          return M_neighbours;
+      }
+
+    /*!
+      \brief check if the last compute() reused the triangulation of the previous cycle.
+      The reused triangulation may be repaired by edge flips.
+      \return checked result
+     */
+    bool reused() const
+      {
+          return M_reused;
+      }
+
+private:
+
+    /*!
+      \brief check if the kept topology is still a triangulation of the current sites.
+      \return true if no triangle is inverted.
+     */
+    bool isEmbedded() const;
+
+    /*!
+      \brief fill the dents of the hull by new triangles.
+      \return false if the hull cannot be convex.
+     */
+    bool convexifyHull();
+
+    /*!
+      \brief flip the edges that do not satisfy the Delaunay condition.
+      \return false if the flips do not converge.
+     */
+    bool legalizeEdges();
+
+    /*!
+      \brief flip the edge in the quadrilateral of its two triangles.
+      \param index index of the flipped edge
+     */
+    void flipEdge( const int index );
+
+    /*!
+      \brief replace the opposite site of the edge.
+      \param site0 site of the edge
+      \param site1 another site of the edge
+      \param old_site replaced opposite site
+      \param new_site new opposite site
+     */
+    void replaceOpposite( const int site0,
+                          const int site1,
+                          const int old_site,
+                          const int new_site );
+
+    /*!
+      \brief create the Delaunay neighbours from the edges.
+     */
+    void updateNeighbours();
+
+    /*!
+      \brief triangulate the current sites and keep the topology.
+      \return true if the topology is created for all sites.
+     */
+    bool updateTopology();
+
+    /*!
+      \brief clip the pitch rectangle by the half planes of the sites.
+      \param index index of the target site
+      \param others indices of the other sites
+      \param metric distance metric
+     */
+    void computeCell( const std::size_t index,
+                      const std::vector< int > & others,
+                      const Metric metric );
+};
+
+}
+
+#endif
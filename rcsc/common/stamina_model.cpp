@@ -36,12 +36,14 @@
 #include "stamina_model.h"
 
 #include "server_param.h"
+#include "server_param_profile.h"
 #include "player_type.h"
 // #include "logger.h"
 
 #include <rcsc/game_time.h>
 
 #include <algorithm>
+#include <cmath>
 
 namespace rcsc {
 
@@ -193,39 +195,55 @@ StaminaModel::setValues( const double new_stamina,
 void
 StaminaModel::simulateWait( const PlayerType & player_type )
 {
-    const ServerParam & SP = ServerParam::i();
+    if ( ServerParam::i().isStandardProfile() )
+    {
+        simulateWaitImpl< StandardServerParamProfile >( player_type );
+    }
+    else
+    {
+        simulateWaitImpl< RuntimeServerParamProfile >( player_type );
+    }
+}
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+template < typename SP >
+void
+StaminaModel::simulateWaitImpl( const PlayerType & player_type )
+{
     // check recovery
-    if ( M_stamina <= SP.recoverDecThrValue() )
+    if ( M_stamina <= SP::recoverDecThrValue() )
     {
-        if ( M_recovery > SP.recoverMin() )
+        if ( M_recovery > SP::recoverMin() )
         {
-            M_recovery -= SP.recoverDec();
-            M_recovery = std::max( M_recovery, SP.recoverMin() );
+            M_recovery -= SP::recoverDec();
+            M_recovery = std::max( M_recovery, SP::recoverMin() );
         }
     }
 
     // check effort
-    if ( M_stamina <= SP.effortDecThrValue() )
+    if ( M_stamina <= SP::effortDecThrValue() )
     {
         if ( M_effort > player_type.effortMin() )
         {
-            M_effort -= SP.effortDec();
+            M_effort -= SP::effortDec();
             M_effort = std::max( M_effort, player_type.effortMin() );
         }
     }
-    else if ( M_stamina >= SP.effortIncThrValue() )
+    else if ( M_stamina >= SP::effortIncThrValue() )
     {
         if ( M_effort < player_type.effortMax() )
         {
-            M_effort += SP.effortInc();
+            M_effort += SP::effortInc();
             M_effort = std::min( M_effort, player_type.effortMax() );
         }
     }
 
     double stamina_inc = std::min( player_type.staminaIncMax() * M_recovery,
-                                   SP.staminaMax() - M_stamina );
-    if ( SP.staminaCapacity() >= 0.0 )
+                                   SP::staminaMax() - M_stamina );
+    if ( SP::staminaCapacity() >= 0.0 )
     {
         M_stamina += std::min( stamina_inc, M_capacity );
         M_capacity -= stamina_inc;
@@ -235,7 +253,7 @@ StaminaModel::simulateWait( const PlayerType & player_type )
     {
         M_stamina += stamina_inc;
     }
-    M_stamina = std::min( M_stamina, SP.staminaMax() );
+    M_stamina = std::min( M_stamina, SP::staminaMax() );
 }
 
 /*-------------------------------------------------------------------*/
@@ -246,9 +264,34 @@ void
 StaminaModel::simulateWaits( const PlayerType & player_type,
                              const int n_wait )
 {
-    for ( int i = 0; i < n_wait; ++i )
+    if ( ServerParam::i().isStandardProfile() )
     {
-        simulateWait( player_type );
+        simulateWaitsImpl< StandardServerParamProfile >( player_type, n_wait );
+    }
+    else
+    {
+        simulateWaitsImpl< RuntimeServerParamProfile >( player_type, n_wait );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+template < typename SP >
+void
+StaminaModel::simulateWaitsImpl( const PlayerType & player_type,
+                                 const int n_wait )
+{
+    int i = 0;
+    while ( i < n_wait )
+    {
+        i += simulateSteadyCycles< SP >( player_type, 0.0, n_wait - i );
+        if ( i < n_wait )
+        {
+            simulateWaitImpl< SP >( player_type );
+            ++i;
+        }
     }
 }
 
@@ -290,17 +333,43 @@ void
 StaminaModel::simulateDashes( const PlayerType & player_type,
                               const int n_dash,
                               const double & dash_power )
+{
+    if ( ServerParam::i().isStandardProfile() )
+    {
+        simulateDashesImpl< StandardServerParamProfile >( player_type, n_dash, dash_power );
+    }
+    else
+    {
+        simulateDashesImpl< RuntimeServerParamProfile >( player_type, n_dash, dash_power );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+template < typename SP >
+void
+StaminaModel::simulateDashesImpl( const PlayerType & player_type,
+                                  const int n_dash,
+                                  const double & dash_power )
 {
     const double consumption = ( dash_power >= 0.0
                                  ? dash_power
                                  : dash_power * -2.0 );
 
-    for ( int i = 0; i < n_dash; ++i )
+    int i = 0;
+    while ( i < n_dash )
     {
-        M_stamina -= consumption;
-        M_stamina = std::max( 0.0, M_stamina );
+        i += simulateSteadyCycles< SP >( player_type, consumption, n_dash - i );
+        if ( i < n_dash )
+        {
+            M_stamina -= consumption;
+            M_stamina = std::max( 0.0, M_stamina );
 
-        simulateWait( player_type );
+            simulateWaitImpl< SP >( player_type );
+            ++i;
+        }
     }
 }
 
@@ -321,6 +390,107 @@ StaminaModel::simulate( const PlayerType & player_type,
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+StaminaModel::simulateDashes( const PlayerType & player_type,
+                              const std::vector< std::pair< int, double > > & dashes,
+                              std::vector< StaminaModel > * result ) const
+{
+    result->clear();
+    result->reserve( dashes.size() );
+
+    for ( const std::pair< int, double > & d : dashes )
+    {
+        result->push_back( *this );
+        result->back().simulateDashes( player_type, d.first, d.second );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+template < typename SP >
+int
+StaminaModel::simulateSteadyCycles( const PlayerType & player_type,
+                                    const double consumption,
+                                    const int n_cycle )
+{
+    const double inc = player_type.staminaIncMax() * M_recovery;
+    const double delta = inc - consumption;
+    const bool use_capacity = ( SP::staminaCapacity() >= 0.0 );
+
+    // the stamina after the consumption must stay within ( lower, upper ).
+    double lower = 0.0;
+    if ( M_recovery > SP::recoverMin() )
+    {
+        lower = std::max( lower, SP::recoverDecThrValue() );
+    }
+    if ( M_effort > player_type.effortMin() )
+    {
+        lower = std::max( lower, SP::effortDecThrValue() );
+    }
+
+    const bool check_upper = ( M_effort < player_type.effortMax() );
+    const double upper = SP::effortIncThrValue();
+
+    const double first = M_stamina - consumption;
+    if ( first <= lower
+         || ( check_upper && first >= upper ) )
+    {
+        return 0;
+    }
+
+    // the number of cycles that surely keep the steady state.
+    // the last cycle before the bound is left to the step by step simulation,
+    // so that the threshold checks are evaluated with the same values.
+    double n = n_cycle;
+    const auto clip = [&n]( const double bound )
+        {
+            if ( bound <= n )
+            {
+                n = std::max( 0.0, std::ceil( bound ) - 1.0 );
+            }
+        };
+
+    if ( delta < 0.0 )
+    {
+        clip( ( first - lower ) / -delta );
+    }
+    else if ( delta > 0.0
+              && check_upper
+              && SP::staminaMax() - consumption >= upper )
+    {
+        clip( ( upper - first ) / delta );
+    }
+
+    if ( use_capacity
+         && inc > 0.0 )
+    {
+        // the total stamina increment never exceeds n * inc.
+        clip( std::floor( M_capacity / inc ) + 1.0 );
+    }
+
+    const int n_steady = static_cast< int >( n );
+    if ( n_steady <= 0 )
+    {
+        return 0;
+    }
+
+    const double new_stamina = std::min( M_stamina + n_steady * delta, SP::staminaMax() );
+    if ( use_capacity )
+    {
+        M_capacity -= new_stamina - M_stamina + n_steady * consumption;
+        M_capacity = std::max( 0.0, M_capacity );
+    }
+    M_stamina = new_stamina;
+
+    return n_steady;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 double
 StaminaModel::getSafetyDashPower( const PlayerType & player_type,
@@ -351,25 +521,23 @@ StaminaModel::getSafetyDashPower( const PlayerType & player_type,
     }
 
 
+    return safety_dash_power( normalized_power,
+                              getSafetyStamina( player_type, stamina_buffer ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+StaminaModel::getSafetyStamina( const PlayerType & player_type,
+                                const double stamina_buffer ) const
+{
     double threshold = ( capacityIsEmpty()
                          ? -player_type.extraStamina()
                          : ServerParam::i().recoverDecThrValue() + std::max( stamina_buffer, 1.0 ) );
     double safety_stamina = stamina() - threshold;
-    double available_stamina = std::max( 0.0, safety_stamina );
-    double result_power = std::min( required_stamina, available_stamina );
-
-    // backward dash case
-    if ( normalized_power < 0.0 )
-    {
-        result_power *= -0.5;
-    }
-
-    if ( std::fabs( result_power ) > std::fabs( normalized_power ) )
-    {
-        return normalized_power;
-    }
-
-    return result_power;
+    return std::max( 0.0, safety_stamina );
 }
 
 }
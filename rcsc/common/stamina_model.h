@@ -32,6 +32,9 @@
 #ifndef RCSC_PLAYER_STAMINA_MODEL_H
 #define RCSC_PLAYER_STAMINA_MODEL_H
 
+#include <vector>
+#include <utility>
+
 namespace rcsc {
 
 class PlayerType;
@@ -245,6 +248,16 @@ public:
                    const int n_dash,
                    const double & dash_power );
 
+    /*!
+      \brief simulate stamina variables for several dash plans at once.
+      \param player_type heterogeneous player type
+      \param dashes pairs of the number of dash cycles and the dash power
+      \param result pointer to the result container. each result starts from this state.
+     */
+    void simulateDashes( const PlayerType & player_type,
+                         const std::vector< std::pair< int, double > > & dashes,
+                         std::vector< StaminaModel > * result ) const;
+
     /*!
       \brief get dash power to save recovery
       \param player_type heterogeneous player type
@@ -255,6 +268,74 @@ public:
     double getSafetyDashPower( const PlayerType & player_type,
                                const double dash_power,
                                const double stamina_buffer = 1.0 ) const;
+
+    /*!
+      \brief get the stamina that can be consumed without decreasing the recovery
+      \param player_type heterogeneous player type
+      \param stamina_buffer try to remain this value of stamina
+      \return available stamina value. never negative.
+    */
+    double getSafetyStamina( const PlayerType & player_type,
+                             const double stamina_buffer = 1.0 ) const;
+
+    /*!
+      \brief get dash power to save recovery by the precomputed available stamina.
+      the result is the same as getSafetyDashPower() for the same state.
+      This function has no branch, so the loops over many dash powers can be vectorized.
+      \param normalized_power dash power normalized by ServerParam::normalizeDashPower()
+      \param available_stamina the value of getSafetyStamina()
+      \return result dash power
+    */
+    static
+    double safety_dash_power( const double normalized_power,
+                              const double available_stamina )
+      {
+          const double required_stamina = ( normalized_power > 0.0
+                                            ? normalized_power
+                                            : normalized_power * -2.0 );
+          double result_power = ( available_stamina < required_stamina
+                                  ? available_stamina
+                                  : required_stamina );
+          result_power = ( normalized_power < 0.0
+                           ? result_power * -0.5
+                           : result_power );
+          const double abs_result = ( result_power < 0.0 ? -result_power : result_power );
+          const double abs_normalized = ( normalized_power < 0.0 ? -normalized_power : normalized_power );
+          return ( abs_result > abs_normalized
+                   ? normalized_power
+                   : result_power );
+      }
+
+private:
+
+    /*
+      the simulation kernels are templates on the server parameter profile
+      (see server_param_profile.h). the public functions select the instance.
+     */
+
+    template < typename SP >
+    void simulateWaitImpl( const PlayerType & player_type );
+
+    template < typename SP >
+    void simulateWaitsImpl( const PlayerType & player_type,
+                            const int n_wait );
+
+    template < typename SP >
+    void simulateDashesImpl( const PlayerType & player_type,
+                             const int n_dash,
+                             const double & dash_power );
+
+    /*!
+      \brief advance the cycles in which neither effort nor recovery changes by the closed form.
+      \param player_type heterogeneous player type
+      \param consumption stamina consumption in each cycle
+      \param n_cycle the maximum number of cycles
+      \return the number of simulated cycles
+     */
+    template < typename SP >
+    int simulateSteadyCycles( const PlayerType & player_type,
+                              const double consumption,
+                              const int n_cycle );
 };
 
 }
@@ -39,6 +39,9 @@
 #include <string>
 #include <fstream>
 #include <iostream>
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
 #include <cstring>
 #include <cctype> // isspace
 
@@ -526,11 +529,99 @@ TeamGraphic::fromRawXpm( const char * const * xpm_data )
     return true;
 }
 
+namespace {
+
+//! the maximum number of the cached tiles. the cache is cleared if full.
+constexpr std::size_t MAX_CACHED_TILES = 4096;
+
+/*!
+  \struct TileCache
+  \brief decoded tiles keyed by the content hash
+*/
+struct TileCache {
+    std::mutex mutex_;
+    std::unordered_multimap< std::uint64_t, TeamGraphic::XpmTile::Ptr > tiles_;
+};
+
+/*-------------------------------------------------------------------*/
+TileCache &
+tile_cache()
+{
+    static TileCache s_cache;
+    return s_cache;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief FNV-1a hash of the xpm lines
+*/
+std::uint64_t
+tile_hash( const std::vector< std::string_view > & xpm_tile )
+{
+    std::uint64_t h = 14695981039346656037ull;
+    for ( const std::string_view & line : xpm_tile )
+    {
+        for ( const char c : line )
+        {
+            h ^= static_cast< unsigned char >( c );
+            h *= 1099511628211ull;
+        }
+        h ^= 0xff; // line separator
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief check if the decoded tile has the same colors and pixels as the xpm lines
+*/
+bool
+same_tile( const TeamGraphic::XpmTile & tile,
+           const std::vector< std::string_view > & xpm_tile )
+{
+    const std::size_t n_color = tile.colors().size();
+    if ( xpm_tile.size() != 1 + n_color + tile.pixelLines().size() )
+    {
+        return false;
+    }
+
+    for ( std::size_t i = 0; i < n_color; ++i )
+    {
+        if ( *tile.colors()[i] != xpm_tile[1 + i] )
+        {
+            return false;
+        }
+    }
+
+    for ( std::size_t i = 0; i < tile.pixelLines().size(); ++i )
+    {
+        if ( tile.pixelLines()[i] != xpm_tile[1 + n_color + i] )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
+
 /*-------------------------------------------------------------------*/
 bool
 TeamGraphic::addXpmTile( const int x,
                          const int y,
                          const std::vector< std::string > & xpm_tile )
+{
+    const std::vector< std::string_view > lines( xpm_tile.begin(), xpm_tile.end() );
+    return addXpmTile( x, y, lines );
+}
+
+/*-------------------------------------------------------------------*/
+bool
+TeamGraphic::addXpmTile( const int x,
+                         const int y,
+                         const std::vector< std::string_view > & xpm_tile )
 {
     if ( x < 0
         || y < 0
@@ -547,12 +638,61 @@ TeamGraphic::addXpmTile( const int x,
         return false;
     }
 
+    const std::uint64_t hash = tile_hash( xpm_tile );
+    TileCache & cache = tile_cache();
+
+    {
+        std::lock_guard< std::mutex > lock( cache.mutex_ );
+        const auto range = cache.tiles_.equal_range( hash );
+        for ( auto it = range.first; it != range.second; ++it )
+        {
+            if ( same_tile( *it->second, xpm_tile ) )
+            {
+                insertTile( x, y, it->second );
+                return true;
+            }
+        }
+    }
+
+    const XpmTile::Ptr tile = decodeXpmTile( xpm_tile );
+    if ( ! tile )
+    {
+        return false;
+    }
+
+    {
+        std::lock_guard< std::mutex > lock( cache.mutex_ );
+        if ( cache.tiles_.size() >= MAX_CACHED_TILES )
+        {
+            cache.tiles_.clear();
+        }
+        cache.tiles_.emplace( hash, tile );
+    }
+
+    insertTile( x, y, tile );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+void
+TeamGraphic::clear_tile_cache()
+{
+    TileCache & cache = tile_cache();
+    std::lock_guard< std::mutex > lock( cache.mutex_ );
+    cache.tiles_.clear();
+}
+
+/*-------------------------------------------------------------------*/
+TeamGraphic::XpmTile::Ptr
+TeamGraphic::decodeXpmTile( const std::vector< std::string_view > & xpm_tile )
+{
     //
     // header
     //
+    const std::string header( xpm_tile[0] );
     int n_read = 0;
     int xpm_width = 0, xpm_height = 0, xpm_n_color = 0, xpm_cpp = 0;
-    if ( std::sscanf( xpm_tile[0].c_str(),
+    if ( std::sscanf( header.c_str(),
                       "  %d %d %d %d %n ",
                       &xpm_width, &xpm_height, &xpm_n_color, &xpm_cpp,
                       &n_read ) != 4
@@ -562,17 +702,16 @@ TeamGraphic::addXpmTile( const int x,
          || xpm_cpp != 1
          || n_read == 0 )
     {
-        std::cerr << "(TeamGraphic::addXpmTile) Illegal xpm header [" << xpm_tile[0] << "]" << std::endl;
-        return false;
+        std::cerr << "(TeamGraphic::addXpmTile) Illegal xpm header [" << header << "]" << std::endl;
+        return XpmTile::Ptr();
     }
 
     if ( xpm_tile.size() != size_t( 1 + xpm_n_color + xpm_height ) )
     {
-        std::cerr << "(TeamGraphic::addXpmTile) Illegal xpm size. defined=" << xpm_tile[0] << " size=" << xpm_tile.size() << std::endl;
-        return false;
+        std::cerr << "(TeamGraphic::addXpmTile) Illegal xpm size. defined=" << header << " size=" << xpm_tile.size() << std::endl;
+        return XpmTile::Ptr();
     }
 
-    const Index index( x, y );
     XpmTile::Ptr tile( new XpmTile( xpm_width, xpm_height, xpm_cpp ) );
 
     //
@@ -581,17 +720,13 @@ TeamGraphic::addXpmTile( const int x,
     const size_t color_max( 1 + xpm_n_color );
     for ( size_t i = 1; i < color_max; ++i )
     {
-        std::shared_ptr< std::string > new_col( new std::string( xpm_tile[i] ) );
-        std::shared_ptr< std::string > col = findColor( *new_col );
-        if ( col )
-        {
-            tile->addColor( col );
-        }
-        else
+        std::shared_ptr< std::string > col = findColor( xpm_tile[i] );
+        if ( ! col )
         {
-            M_colors.push_back( new_col );
-            tile->addColor( new_col );
+            col = std::make_shared< std::string >( xpm_tile[i] );
+            M_colors.push_back( col );
         }
+        tile->addColor( col );
     }
 
     //
@@ -604,14 +739,32 @@ TeamGraphic::addXpmTile( const int x,
     {
         if ( xpm_tile[i].length() != line_width )
         {
-            return false;
+            return XpmTile::Ptr();
         }
 
-        tile->addPixelLine( xpm_tile[i] );
+        tile->addPixelLine( std::string( xpm_tile[i] ) );
+    }
+
+    return tile;
+}
+
+/*-------------------------------------------------------------------*/
+void
+TeamGraphic::insertTile( const int x,
+                         const int y,
+                         const XpmTile::Ptr & tile )
+{
+    // the colors of the cached tile may not be in the pool of this instance yet.
+    for ( const std::shared_ptr< std::string > & col : tile->colors() )
+    {
+        if ( ! findColor( *col ) )
+        {
+            M_colors.push_back( col );
+        }
     }
 
     // insert new tile
-    M_tiles.insert( std::pair< Index, XpmTile::Ptr >( index, tile ) );
+    M_tiles.insert( std::pair< Index, XpmTile::Ptr >( Index( x, y ), tile ) );
 
     if ( M_width < ( x + 1 ) * TILE_SIZE )
     {
@@ -622,13 +775,11 @@ TeamGraphic::addXpmTile( const int x,
     {
         M_height = ( y + 1 ) * TILE_SIZE;
     }
-
-    return true;
 }
 
 /*-------------------------------------------------------------------*/
 std::shared_ptr< std::string >
-TeamGraphic::findColor( const std::string & str )
+TeamGraphic::findColor( std::string_view str )
 {
     for ( std::shared_ptr< std::string > color : M_colors )
     {
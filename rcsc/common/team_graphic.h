@@ -36,12 +36,17 @@
 #include <vector>
 #include <map>
 #include <string>
+#include <string_view>
 
 namespace rcsc {
 
 /*!
   \class TeamGraphic
   \brief team graphic data management class
+
+  The decoded xpm tiles are shared by all instances through a process wide
+  cache keyed by the content hash of the xpm lines. The same tiles received
+  again, e.g. in every game log of the same team, are not decoded twice.
 */
 class TeamGraphic {
 public:
@@ -256,14 +261,48 @@ public:
                      const int y,
                      const std::vector< std::string > & xpm_tile );
 
+    /*!
+      \brief create tiled xpm from the raw xpm data given as the slices of the parser buffer
+      \param x xpm tile index
+      \param y xpm tile index
+      \param xpm_tile raw xpm string array
+      \return true if successfully parsed
+    */
+    bool addXpmTile( const int x,
+                     const int y,
+                     const std::vector< std::string_view > & xpm_tile );
+
+    /*!
+      \brief release all cached tiles shared by the instances
+    */
+    static
+    void clear_tile_cache();
+
 private:
 
+    /*!
+      \brief decode the xpm tile
+      \param xpm_tile raw xpm string array
+      \return decoded tile. null pointer if illegal data.
+    */
+    XpmTile::Ptr decodeXpmTile( const std::vector< std::string_view > & xpm_tile );
+
+    /*!
+      \brief register the tile to this graphic
+      \param x xpm tile index
+      \param y xpm tile index
+      \param tile decoded tile
+    */
+    void insertTile( const int x,
+                     const int y,
+                     const XpmTile::Ptr & tile );
+
     /*!
       \brief find string from the color string pool
       \param str searched string
       \return string pointer. if not found null pointer is returned.
     */
-    std::shared_ptr< std::string > findColor( const std::string & str );
+    std::shared_ptr< std::string > findColor( std::string_view str );
 
 };
 
@@ -0,0 +1,220 @@
+// -*-c++-*-
+
+/*!
+  \file team_runner.cpp
+  \brief in-process runner of the several agents Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "team_runner.h"
+
+#include "soccer_agent.h"
+#include "abstract_client.h"
+#include "logger.h"
+
+#include <rcsc/util/runtime_tuning.h>
+#include <rcsc/util/task_graph.h>
+
+#include <algorithm>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <exception>
+#include <iostream>
+
+namespace rcsc {
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+TeamRunner::TeamRunner()
+    : M_affinity( NO_AFFINITY ),
+      M_first_cpu( 0 ),
+      M_start_interval_msec( 100 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TeamRunner::add( std::shared_ptr< SoccerAgent > agent )
+{
+    if ( agent )
+    {
+        M_agents.push_back( agent );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TeamRunner::setAffinity( const AffinityPolicy policy,
+                         const int first_cpu )
+{
+    M_affinity = policy;
+    M_first_cpu = std::max( 0, first_cpu );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TeamRunner::setCpuList( const std::vector< int > & cpus )
+{
+    M_cpu_list = cpus;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TeamRunner::setStartInterval( const int msec )
+{
+    M_start_interval_msec = std::max( 0, msec );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+TeamRunner::assignedCpu( const std::size_t index,
+                         const int cpu_count ) const
+{
+    if ( cpu_count <= 0 )
+    {
+        return -1;
+    }
+
+    if ( ! M_cpu_list.empty() )
+    {
+        return M_cpu_list[index % M_cpu_list.size()] % cpu_count;
+    }
+
+    switch ( M_affinity ) {
+    case COMPACT:
+        return static_cast< int >( ( M_first_cpu + index ) % cpu_count );
+    case SCATTER:
+        {
+            const int available = std::max( 1, cpu_count - M_first_cpu % cpu_count );
+            const int n = std::max( 1, static_cast< int >( M_agents.size() ) );
+            const int stride = std::max( 1, available / n );
+            return static_cast< int >( ( M_first_cpu + index * stride ) % cpu_count );
+        }
+    case NO_AFFINITY:
+    default:
+        break;
+    }
+
+    return -1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::size_t
+TeamRunner::run()
+{
+    const int cpu_count = static_cast< int >( std::thread::hardware_concurrency() );
+
+    // every agent thread also executes its own tasks. the shared pool
+    // workers are limited to the remaining cpus.
+    TaskPool::instance().reserveCallers( M_agents.size() );
+
+    // the debug logger formats the records into the process wide buffers,
+    // so the agent threads cannot share it.
+    if ( M_agents.size() > 1
+         && ! dlog.isDisabled() )
+    {
+        std::cerr << "TeamRunner: the debug log is disabled while "
+                  << M_agents.size() << " agents run in one process."
+                  << std::endl;
+        dlog.disable();
+    }
+
+    std::atomic< std::size_t > succeeded( 0 );
+    std::vector< std::thread > threads;
+    threads.reserve( M_agents.size() );
+
+    for ( std::size_t i = 0; i < M_agents.size(); ++i )
+    {
+        if ( i > 0
+             && M_start_interval_msec > 0 )
+        {
+            std::this_thread::sleep_for( std::chrono::milliseconds( M_start_interval_msec ) );
+        }
+
+        const int cpu = assignedCpu( i, cpu_count );
+        std::shared_ptr< SoccerAgent > agent = M_agents[i];
+
+        threads.emplace_back( [agent, cpu, i, &succeeded]()
+                              {
+                                  if ( cpu >= 0
+                                       && ! RuntimeTuning::set_cpu_affinity( std::vector< int >( 1, cpu ) ) )
+                                  {
+                                      std::cerr << "TeamRunner: agent " << i
+                                                << " could not be pinned to cpu " << cpu
+                                                << std::endl;
+                                  }
+
+                                  try
+                                  {
+                                      std::shared_ptr< AbstractClient > client = agent->createConsoleClient();
+                                      agent->setClient( client );
+                                      client->run( agent.get() );
+                                      succeeded.fetch_add( 1 );
+                                  }
+                                  catch ( std::exception & e )
+                                  {
+                                      std::cerr << "TeamRunner: agent " << i
+                                                << " exited with an exception: " << e.what()
+                                                << std::endl;
+                                  }
+                              } );
+    }
+
+    for ( std::thread & t : threads )
+    {
+        t.join();
+    }
+
+    return succeeded.load();
+}
+
+}
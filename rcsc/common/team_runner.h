@@ -0,0 +1,162 @@
+// -*-c++-*-
+
+/*!
+  \file team_runner.h
+  \brief in-process runner of the several agents Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_COMMON_TEAM_RUNNER_H
+#define RCSC_COMMON_TEAM_RUNNER_H
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+namespace rcsc {
+
+class SoccerAgent;
+
+/*!
+  \class TeamRunner
+  \brief runs the several agents as threads in one process.
+
+  A typical usage is to launch 11 players and a coach of a team:
+
+  \code
+  rcsc::TeamRunner runner;
+  for ( int i = 0; i < 11; ++i )
+  {
+      std::shared_ptr< SamplePlayer > p( new SamplePlayer() );
+      if ( ! p->init( cmd_parser ) ) return 1;
+      runner.add( p );
+  }
+  runner.add( coach ); // initialized in the same way
+  runner.setAffinity( rcsc::TeamRunner::COMPACT, 0 );
+  runner.run();
+  \endcode
+
+  Each agent owns its world model, its debug client and its action
+  caches (see AgentContext). The following data are process wide and
+  shared by all agents:
+  - ServerParam, PlayerParam and PlayerTypeSet. They are written only
+    once for each received message (see SharedParam).
+  - the kick tables of KickTable::instance() and ObjectTable. They are
+    read only after the first agent has created them.
+  - the debug logger dlog. It cannot separate the records of several
+    threads, so run() disables it when two or more agents are registered.
+    The debug log options of the agents are ignored in that case. Use
+    separate processes to record the debug logs.
+*/
+class TeamRunner {
+public:
+
+    /*!
+      \enum AffinityPolicy
+      \brief cpu assignment policy
+    */
+    enum AffinityPolicy {
+        NO_AFFINITY, //!< threads are scheduled by the operating system
+        COMPACT, //!< agent i is pinned to cpu (first + i)
+        SCATTER, //!< agents are spread over the available cpus with the same stride
+    };
+
+private:
+
+    std::vector< std::shared_ptr< SoccerAgent > > M_agents; //!< registered agents
+
+    AffinityPolicy M_affinity; //!< cpu assignment policy
+    int M_first_cpu; //!< the first cpu used by the policy
+    std::vector< int > M_cpu_list; //!< explicit cpu list. has priority over the policy.
+
+    int M_start_interval_msec; //!< wait time between the agent start
+
+    // not used
+    TeamRunner( const TeamRunner & ) = delete;
+    TeamRunner & operator=( const TeamRunner & ) = delete;
+
+public:
+
+    /*!
+      \brief construct an empty runner
+    */
+    TeamRunner();
+
+    /*!
+      \brief register the initialized agent
+      \param agent agent instance. SoccerAgent::init() must have been called.
+    */
+    void add( std::shared_ptr< SoccerAgent > agent );
+
+    /*!
+      \brief get the number of registered agents
+      \return agent count
+    */
+    std::size_t size() const
+      {
+          return M_agents.size();
+      }
+
+    /*!
+      \brief set the cpu assignment policy
+      \param policy policy type
+      \param first_cpu the first cpu index used by the policy
+    */
+    void setAffinity( const AffinityPolicy policy,
+                      const int first_cpu = 0 );
+
+    /*!
+      \brief set the explicit cpu list. agent i is pinned to cpus[i % cpus.size()].
+      \param cpus cpu indices. the empty list restores the policy.
+    */
+    void setCpuList( const std::vector< int > & cpus );
+
+    /*!
+      \brief set the wait time between the agent start.
+      the server requires the goalie and the players to connect in order.
+      \param msec wait time in milliseconds
+    */
+    void setStartInterval( const int msec );
+
+    /*!
+      \brief get the cpu assigned to the agent
+      \param index agent index
+      \param cpu_count the number of available cpus
+      \return cpu index, or -1 if not pinned
+    */
+    int assignedCpu( const std::size_t index,
+                     const int cpu_count ) const;
+
+    /*!
+      \brief start all agents in the registered order and wait until all of them exit.
+      \return the number of agents that exited normally
+    */
+    std::size_t run();
+};
+
+}
+
+#endif
@@ -0,0 +1,265 @@
+// -*-c++-*-
+
+/*!
+  \file trace_recorder.cpp
+  \brief agent phase trace recorder Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "trace_recorder.h"
+
+#include <fstream>
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+namespace rcsc {
+
+constexpr std::size_t TraceRecorder::DEFAULT_CAPACITY;
+
+namespace {
+
+//! the first characters of the event line
+const std::string EVENT_PREFIX = "{\"name\":";
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief write the JSON string with the escape sequences
+ */
+void
+write_string( std::ostream & os,
+              const std::string & str )
+{
+    os << '"';
+    for ( const char c : str )
+    {
+        if ( c == '"' || c == '\\' ) os << '\\' << c;
+        else if ( static_cast< unsigned char >( c ) < 0x20 ) os << ' ';
+        else os << c;
+    }
+    os << '"';
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the process id written to the trace
+ */
+long
+process_id()
+{
+#ifdef HAVE_UNISTD_H
+    return static_cast< long >( ::getpid() );
+#else
+    return 0;
+#endif
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+TraceRecorder::TraceRecorder()
+    : M_enabled( false ),
+      M_category( "agent" ),
+      M_thread_id( 0 ),
+      M_cycle( 0 ),
+      M_next( 0 ),
+      M_total_count( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TraceRecorder::setEnabled( const bool on,
+                           const std::size_t capacity )
+{
+    M_enabled = ( on && capacity > 0 );
+
+    if ( M_enabled )
+    {
+        if ( M_events.size() != capacity )
+        {
+            M_events.assign( capacity, Event() );
+            M_next = 0;
+            M_total_count = 0;
+        }
+    }
+    else
+    {
+        std::vector< Event >().swap( M_events );
+        M_next = 0;
+        M_total_count = 0;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TraceRecorder::setLabel( const std::string & category,
+                         const std::string & process_name,
+                         const std::string & thread_name,
+                         const int thread_id )
+{
+    M_category = category;
+    M_process_name = process_name;
+    M_thread_name = thread_name;
+    M_thread_id = thread_id;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TraceRecorder::clear()
+{
+    M_next = 0;
+    M_total_count = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+TraceRecorder::writeJSON( std::ostream & os ) const
+{
+    const long pid = process_id();
+
+    // one event per line. merge() depends on this layout.
+    os << "{\"traceEvents\":[\n";
+
+    os << EVENT_PREFIX << "\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+       << ",\"tid\":" << M_thread_id << ",\"args\":{\"name\":";
+    write_string( os, M_process_name );
+    os << "}},\n";
+
+    os << EVENT_PREFIX << "\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+       << ",\"tid\":" << M_thread_id << ",\"args\":{\"name\":";
+    write_string( os, M_thread_name );
+    os << "}}";
+
+    const std::size_t n = size();
+    std::size_t index = ( M_total_count < M_events.size() ? 0 : M_next );
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        const Event & e = M_events[index];
+        if ( ++index == M_events.size() ) index = 0;
+
+        os << ",\n"
+           << EVENT_PREFIX << '"' << e.name_ << "\",\"cat\":";
+        write_string( os, M_category );
+        os << ",\"ph\":\"X\",\"ts\":" << e.begin_usec_
+           << ",\"dur\":" << ( e.end_usec_ > e.begin_usec_ ? e.end_usec_ - e.begin_usec_ : 0 )
+           << ",\"pid\":" << pid
+           << ",\"tid\":" << M_thread_id
+           << ",\"args\":{\"cycle\":" << e.cycle_ << "}}";
+    }
+
+    os << "\n],\n"
+       << "\"displayTimeUnit\":\"ms\",\n"
+       << "\"otherData\":{\"dropped_events\":" << droppedCount() << "}}\n";
+    return os;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+TraceRecorder::writeJSON( const std::string & filepath ) const
+{
+    std::ofstream fout( filepath.c_str() );
+    if ( ! fout.is_open() )
+    {
+        return false;
+    }
+
+    writeJSON( fout );
+    fout.flush();
+    return fout.good();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+TraceRecorder::merge( const std::vector< std::string > & inputs,
+                      std::ostream & os )
+{
+    bool result = true;
+    bool first = true;
+
+    os << "{\"traceEvents\":[";
+
+    for ( const std::string & filepath : inputs )
+    {
+        std::ifstream fin( filepath.c_str() );
+        if ( ! fin.is_open() )
+        {
+            result = false;
+            continue;
+        }
+
+        std::string line;
+        while ( std::getline( fin, line ) )
+        {
+            if ( line.compare( 0, EVENT_PREFIX.size(), EVENT_PREFIX ) != 0 )
+            {
+                continue;
+            }
+
+            if ( ! line.empty() && *line.rbegin() == ',' )
+            {
+                line.erase( line.size() - 1 );
+            }
+
+            os << ( first ? "\n" : ",\n" ) << line;
+            first = false;
+        }
+    }
+
+    os << "\n],\n"
+       << "\"displayTimeUnit\":\"ms\"}\n";
+    return result;
+}
+
+}
@@ -0,0 +1,264 @@
+// -*-c++-*-
+
+/*!
+  \file trace_recorder.h
+  \brief agent phase trace recorder Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_COMMON_TRACE_RECORDER_H
+#define RCSC_COMMON_TRACE_RECORDER_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+
+namespace rcsc {
+
+/*!
+  \class TraceRecorder
+  \brief records the time spans of the agent's cycle phases and writes them
+  in the Chrome trace event format (readable by chrome://tracing and Perfetto).
+
+  The events are stored in a fixed size ring buffer allocated when the
+  recorder is enabled, so recording an event allocates nothing. If the buffer
+  is full, the oldest events are overwritten. The event name must be a string
+  literal, because only its pointer is stored.
+
+  The time stamps are taken from std::chrono::steady_clock, that is the
+  monotonic clock shared by all processes on the same host. Each agent uses
+  its process id and its own thread id in the trace, so the files written by
+  all agents can be merged into one timeline by merge().
+*/
+class TraceRecorder {
+public:
+
+    //! default number of events kept in the buffer
+    static constexpr std::size_t DEFAULT_CAPACITY = 65536;
+
+    /*!
+      \struct Event
+      \brief one complete time span
+    */
+    struct Event {
+        const char * name_; //!< phase name. must be a string literal.
+        std::int64_t begin_usec_; //!< begin time stamp
+        std::int64_t end_usec_; //!< end time stamp
+        long cycle_; //!< game cycle when the span ended
+    };
+
+    /*!
+      \class Scope
+      \brief RAII helper to record a span. does nothing if the recorder is disabled.
+    */
+    class Scope {
+    private:
+        TraceRecorder & M_recorder;
+        const char * const M_name;
+        const bool M_active;
+        const std::int64_t M_begin;
+    public:
+        Scope( TraceRecorder & recorder,
+               const char * name )
+            : M_recorder( recorder ),
+              M_name( name ),
+              M_active( recorder.isEnabled() ),
+              M_begin( M_active ? now_usec() : 0 )
+          { }
+
+        ~Scope()
+          {
+              if ( M_active )
+              {
+                  M_recorder.add( M_name, M_begin, now_usec() );
+              }
+          }
+
+        Scope( const Scope & ) = delete;
+        Scope & operator=( const Scope & ) = delete;
+    };
+
+private:
+
+    bool M_enabled; //!< recording switch
+
+    std::string M_category; //!< event category, e.g. "player"
+    std::string M_process_name; //!< process label in the timeline
+    std::string M_thread_name; //!< thread label in the timeline
+    int M_thread_id; //!< thread id in the timeline
+
+    long M_cycle; //!< current game cycle
+
+    std::vector< Event > M_events; //!< ring buffer
+    std::size_t M_next; //!< index of the next event
+    std::uint64_t M_total_count; //!< the number of recorded events including the overwritten ones
+
+    // not used
+    TraceRecorder( const TraceRecorder & ) = delete;
+    TraceRecorder & operator=( const TraceRecorder & ) = delete;
+
+public:
+
+    /*!
+      \brief create a disabled recorder
+    */
+    TraceRecorder();
+
+    /*!
+      \brief enable or disable the recorder. the buffer is allocated when enabled.
+      \param on switch value
+      \param capacity the number of events kept in the buffer
+    */
+    void setEnabled( const bool on,
+                     const std::size_t capacity = DEFAULT_CAPACITY );
+
+    /*!
+      \brief check if the recorder is enabled
+      \return switch value
+    */
+    bool isEnabled() const
+      {
+          return M_enabled;
+      }
+
+    /*!
+      \brief set the labels used in the timeline
+      \param category event category
+      \param process_name process label
+      \param thread_name thread label
+      \param thread_id thread id. must be unique in the process.
+    */
+    void setLabel( const std::string & category,
+                   const std::string & process_name,
+                   const std::string & thread_name,
+                   const int thread_id );
+
+    /*!
+      \brief set the current game cycle attached to the following events
+      \param cycle game cycle
+    */
+    void setCycle( const long cycle )
+      {
+          M_cycle = cycle;
+      }
+
+    /*!
+      \brief get the current time stamp
+      \return microseconds of the steady clock
+    */
+    static
+    std::int64_t now_usec()
+      {
+          return std::chrono::duration_cast< std::chrono::microseconds >
+              ( std::chrono::steady_clock::now().time_since_epoch() ).count();
+      }
+
+    /*!
+      \brief record a span
+      \param name phase name. must be a string literal.
+      \param begin_usec begin time stamp
+      \param end_usec end time stamp
+    */
+    void add( const char * name,
+              const std::int64_t begin_usec,
+              const std::int64_t end_usec )
+      {
+          if ( M_events.empty() )
+          {
+              return;
+          }
+
+          Event & e = M_events[M_next];
+          e.name_ = name;
+          e.begin_usec_ = begin_usec;
+          e.end_usec_ = end_usec;
+          e.cycle_ = M_cycle;
+
+          if ( ++M_next == M_events.size() )
+          {
+              M_next = 0;
+          }
+          ++M_total_count;
+      }
+
+    /*!
+      \brief get the number of kept events
+      \return the number of events in the buffer
+    */
+    std::size_t size() const
+      {
+          return ( M_total_count < M_events.size()
+                   ? static_cast< std::size_t >( M_total_count )
+                   : M_events.size() );
+      }
+
+    /*!
+      \brief get the number of overwritten events
+      \return the number of dropped events
+    */
+    std::uint64_t droppedCount() const
+      {
+          return M_total_count - size();
+      }
+
+    /*!
+      \brief remove all events
+    */
+    void clear();
+
+    /*!
+      \brief write the kept events in the Chrome trace event format
+      \param os reference to the output stream
+      \return reference to the output stream
+    */
+    std::ostream & writeJSON( std::ostream & os ) const;
+
+    /*!
+      \brief write the kept events to the file
+      \param filepath output file path
+      \return true if successfully written
+    */
+    bool writeJSON( const std::string & filepath ) const;
+
+    /*!
+      \brief merge the trace files written by writeJSON() into one trace
+      \param inputs input file paths
+      \param os reference to the output stream
+      \return false if some input could not be read
+    */
+    static
+    bool merge( const std::vector< std::string > & inputs,
+                std::ostream & os );
+
+};
+
+}
+
+#endif
@@ -160,6 +160,18 @@ Formation::setRole( const int num,
     return true;
 }
 
+/*-------------------------------------------------------------------*/
+std::size_t
+Formation::memoryUsage() const
+{
+    std::size_t bytes = M_version.capacity();
+    for ( const std::string & name : M_role_names )
+    {
+        bytes += name.capacity();
+    }
+    return bytes;
+}
+
 /*-------------------------------------------------------------------*/
 bool
 Formation::print( std::ostream & os ) const
@@ -50,6 +50,11 @@ namespace rcsc {
   \brief abstarct formation class
 */
 class Formation {
+private:
+
+    //! the decorator prints the data of the wrapped formation
+    friend class FormationCached;
+
 public:
 
     typedef std::shared_ptr< Formation > Ptr; //<! pointer type
@@ -246,6 +251,13 @@ public:
     virtual
     FormationData::Ptr toData() const = 0;
 
+    /*!
+      \brief get the heap bytes held by this formation
+      \return bytes
+     */
+    virtual
+    std::size_t memoryUsage() const;
+
     /*!
       \brief print formation model to the output stream
       \param os output stream
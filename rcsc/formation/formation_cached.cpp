@@ -0,0 +1,391 @@
+// -*-c++-*-
+
+/*!
+  \file formation_cached.cpp
+  \brief formation decorator that samples the positions from a precomputed grid Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "formation_cached.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace rcsc {
+
+constexpr double FormationCached::DEFAULT_RESOLUTION;
+constexpr double FormationCached::MAX_X;
+constexpr double FormationCached::MAX_Y;
+
+namespace {
+
+//! the number of values for each grid node
+constexpr int NODE_SIZE = 22;
+
+//! the first bytes of the cache file
+const char CACHE_MAGIC[8] = { 'R', 'C', 'S', 'C', 'F', 'M', 'C', 'G' };
+
+//! cache file format version
+constexpr std::int32_t CACHE_FORMAT_VERSION = 1;
+
+/*!
+  \struct CacheHeader
+  \brief header block of the cache file
+ */
+struct CacheHeader {
+    char magic_[8]; //!< CACHE_MAGIC
+    std::int32_t version_; //!< CACHE_FORMAT_VERSION
+    std::int32_t width_; //!< the number of nodes in x direction
+    std::int32_t height_; //!< the number of nodes in y direction
+    std::int32_t padding_; //!< always 0
+    double resolution_; //!< grid interval
+};
+
+//! the maximum difference between the read grid and the base formation
+constexpr double CONSISTENCY_THRESHOLD = 1.0e-3;
+
+}
+
+/*-------------------------------------------------------------------*/
+FormationCached::FormationCached( const Formation::ConstPtr & base,
+                                  const double resolution )
+    : Formation(),
+      M_base( base ),
+      M_resolution( resolution ),
+      M_width( 0 ),
+      M_height( 0 )
+{
+    if ( resolution < 0.01 || MAX_Y < resolution )
+    {
+        std::cerr << "(FormationCached) ERROR: illegal resolution " << resolution
+                  << ". use the default value " << DEFAULT_RESOLUTION << std::endl;
+        M_resolution = DEFAULT_RESOLUTION;
+    }
+
+    M_width = static_cast< int >( std::ceil( MAX_X * 2.0 / M_resolution - 1.0e-9 ) ) + 1;
+    M_height = static_cast< int >( std::ceil( MAX_Y * 2.0 / M_resolution - 1.0e-9 ) ) + 1;
+
+    if ( M_base )
+    {
+        M_version = M_base->version();
+        M_role_names = M_base->roleNames();
+        M_role_types = M_base->roleTypes();
+        M_position_pairs = M_base->positionPairs();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+Formation::Ptr
+FormationCached::create( const Formation::ConstPtr & base,
+                         const double resolution )
+{
+    std::shared_ptr< FormationCached > ptr( new FormationCached( base, resolution ) );
+    if ( ! ptr->rasterize() )
+    {
+        return Formation::Ptr();
+    }
+
+    return ptr;
+}
+
+/*-------------------------------------------------------------------*/
+bool
+FormationCached::rasterize()
+{
+    M_table.clear();
+
+    if ( ! M_base )
+    {
+        std::cerr << "(FormationCached::rasterize) ERROR: no base formation." << std::endl;
+        return false;
+    }
+
+    std::vector< float > table;
+    table.reserve( static_cast< size_t >( M_width ) * M_height * NODE_SIZE );
+
+    std::vector< Vector2D > positions;
+    for ( int iy = 0; iy < M_height; ++iy )
+    {
+        for ( int ix = 0; ix < M_width; ++ix )
+        {
+            const Vector2D focus_point( -MAX_X + ix * M_resolution,
+                                        -MAX_Y + iy * M_resolution );
+            M_base->getPositions( focus_point, positions );
+
+            if ( positions.size() != 11 )
+            {
+                std::cerr << "(FormationCached::rasterize) ERROR: illegal position size "
+                          << positions.size() << " at " << focus_point << std::endl;
+                return false;
+            }
+
+            for ( const Vector2D & p : positions )
+            {
+                table.push_back( static_cast< float >( p.x ) );
+                table.push_back( static_cast< float >( p.y ) );
+            }
+        }
+    }
+
+    M_table.swap( table );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+bool
+FormationCached::read( const std::string & filepath )
+{
+    std::ifstream fin( filepath.c_str(), std::ios_base::in | std::ios_base::binary );
+    if ( ! fin.is_open() )
+    {
+        return false;
+    }
+
+    CacheHeader header;
+    if ( ! fin.read( reinterpret_cast< char * >( &header ), sizeof( header ) )
+         || std::memcmp( header.magic_, CACHE_MAGIC, sizeof( CACHE_MAGIC ) ) != 0
+         || header.version_ != CACHE_FORMAT_VERSION )
+    {
+        std::cerr << "(FormationCached::read) illegal cache file [" << filepath << "]" << std::endl;
+        return false;
+    }
+
+    if ( header.width_ != M_width
+         || header.height_ != M_height
+         || header.resolution_ != M_resolution )
+    {
+        std::cerr << "(FormationCached::read) resolution mismatch [" << filepath << "]" << std::endl;
+        return false;
+    }
+
+    std::vector< float > table( static_cast< size_t >( M_width ) * M_height * NODE_SIZE );
+    if ( ! fin.read( reinterpret_cast< char * >( table.data() ), table.size() * sizeof( float ) ) )
+    {
+        std::cerr << "(FormationCached::read) broken cache file [" << filepath << "]" << std::endl;
+        return false;
+    }
+
+    //
+    // check that the file was created from the same formation
+    //
+    if ( M_base )
+    {
+        const int check_nodes[3] = { 0, ( M_height / 2 ) * M_width + M_width / 2, M_width * M_height - 1 };
+        std::vector< Vector2D > positions;
+        for ( const int node : check_nodes )
+        {
+            const Vector2D focus_point( -MAX_X + ( node % M_width ) * M_resolution,
+                                        -MAX_Y + ( node / M_width ) * M_resolution );
+            M_base->getPositions( focus_point, positions );
+
+            const float * values = &table[static_cast< size_t >( node ) * NODE_SIZE];
+            for ( size_t i = 0; i < positions.size() && i < 11; ++i )
+            {
+                if ( std::fabs( positions[i].x - values[i * 2] ) > CONSISTENCY_THRESHOLD
+                     || std::fabs( positions[i].y - values[i * 2 + 1] ) > CONSISTENCY_THRESHOLD )
+                {
+                    std::cerr << "(FormationCached::read) the cache file does not match the base formation ["
+                              << filepath << "]" << std::endl;
+                    return false;
+                }
+            }
+        }
+    }
+
+    M_table.swap( table );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+bool
+FormationCached::write( const std::string & filepath ) const
+{
+    if ( M_table.empty() )
+    {
+        std::cerr << "(FormationCached::write) ERROR: no grid." << std::endl;
+        return false;
+    }
+
+    std::ofstream fout( filepath.c_str(), std::ios_base::out | std::ios_base::binary );
+    if ( ! fout.is_open() )
+    {
+        std::cerr << "(FormationCached::write) could not open [" << filepath << "]" << std::endl;
+        return false;
+    }
+
+    CacheHeader header;
+    std::memcpy( header.magic_, CACHE_MAGIC, sizeof( CACHE_MAGIC ) );
+    header.version_ = CACHE_FORMAT_VERSION;
+    header.width_ = M_width;
+    header.height_ = M_height;
+    header.padding_ = 0;
+    header.resolution_ = M_resolution;
+
+    fout.write( reinterpret_cast< const char * >( &header ), sizeof( header ) );
+    fout.write( reinterpret_cast< const char * >( M_table.data() ), M_table.size() * sizeof( float ) );
+    fout.flush();
+
+    return static_cast< bool >( fout );
+}
+
+/*-------------------------------------------------------------------*/
+std::string
+FormationCached::methodName() const
+{
+    return ( M_base
+             ? M_base->methodName()
+             : std::string() );
+}
+
+/*-------------------------------------------------------------------*/
+int
+FormationCached::getCell( const Vector2D & focus_point,
+                          double * ratio_x,
+                          double * ratio_y ) const
+{
+    const double gx = ( std::min( std::max( focus_point.x, -MAX_X ), MAX_X ) + MAX_X ) / M_resolution;
+    const double gy = ( std::min( std::max( focus_point.y, -MAX_Y ), MAX_Y ) + MAX_Y ) / M_resolution;
+
+    const int ix = std::min( static_cast< int >( gx ), M_width - 2 );
+    const int iy = std::min( static_cast< int >( gy ), M_height - 2 );
+
+    *ratio_x = gx - ix;
+    *ratio_y = gy - iy;
+
+    return iy * M_width + ix;
+}
+
+/*-------------------------------------------------------------------*/
+Vector2D
+FormationCached::getPosition( const int num,
+                              const Vector2D & focus_point ) const
+{
+    if ( num < 1 || 11 < num )
+    {
+        std::cerr << "(FormationCached::getPosition) ERROR: invalid number " << num << std::endl;
+        return Vector2D::INVALIDATED;
+    }
+
+    if ( M_table.empty() )
+    {
+        return ( M_base
+                 ? M_base->getPosition( num, focus_point )
+                 : Vector2D::INVALIDATED );
+    }
+
+    double rx, ry;
+    const int node = getCell( focus_point, &rx, &ry );
+
+    const float * v00 = &M_table[static_cast< size_t >( node ) * NODE_SIZE + ( num - 1 ) * 2];
+    const float * v10 = v00 + NODE_SIZE;
+    const float * v01 = v00 + static_cast< size_t >( M_width ) * NODE_SIZE;
+    const float * v11 = v01 + NODE_SIZE;
+
+    const double w00 = ( 1.0 - rx ) * ( 1.0 - ry );
+    const double w10 = rx * ( 1.0 - ry );
+    const double w01 = ( 1.0 - rx ) * ry;
+    const double w11 = rx * ry;
+
+    return Vector2D( w00 * v00[0] + w10 * v10[0] + w01 * v01[0] + w11 * v11[0],
+                     w00 * v00[1] + w10 * v10[1] + w01 * v01[1] + w11 * v11[1] );
+}
+
+/*-------------------------------------------------------------------*/
+void
+FormationCached::getPositions( const Vector2D & focus_point,
+                               std::vector< Vector2D > & positions ) const
+{
+    if ( M_table.empty() )
+    {
+        positions.clear();
+        if ( M_base )
+        {
+            M_base->getPositions( focus_point, positions );
+        }
+        return;
+    }
+
+    double rx, ry;
+    const int node = getCell( focus_point, &rx, &ry );
+
+    const float * v00 = &M_table[static_cast< size_t >( node ) * NODE_SIZE];
+    const float * v10 = v00 + NODE_SIZE;
+    const float * v01 = v00 + static_cast< size_t >( M_width ) * NODE_SIZE;
+    const float * v11 = v01 + NODE_SIZE;
+
+    const double w00 = ( 1.0 - rx ) * ( 1.0 - ry );
+    const double w10 = rx * ( 1.0 - ry );
+    const double w01 = ( 1.0 - rx ) * ry;
+    const double w11 = rx * ry;
+
+    double values[NODE_SIZE];
+    for ( int i = 0; i < NODE_SIZE; ++i )
+    {
+        values[i] = w00 * v00[i] + w10 * v10[i] + w01 * v01[i] + w11 * v11[i];
+    }
+
+    positions.resize( 11 );
+    for ( int i = 0; i < 11; ++i )
+    {
+        positions[i].assign( values[i * 2], values[i * 2 + 1] );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+bool
+FormationCached::train( const FormationData & )
+{
+    std::cerr << "(FormationCached::train) ERROR: the cached formation cannot be trained."
+              << " train the base formation and create the cache again." << std::endl;
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+FormationData::Ptr
+FormationCached::toData() const
+{
+    return ( M_base
+             ? M_base->toData()
+             : FormationData::Ptr() );
+}
+
+/*-------------------------------------------------------------------*/
+bool
+FormationCached::printData( std::ostream & os ) const
+{
+    return ( M_base
+             && M_base->printData( os ) );
+}
+
+}
@@ -0,0 +1,211 @@
+// -*-c++-*-
+
+/*!
+  \file formation_cached.h
+  \brief formation decorator that samples the positions from a precomputed grid Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_FORMATION_FORMATION_CACHED_H
+#define RCSC_FORMATION_FORMATION_CACHED_H
+
+#include <rcsc/formation/formation.h>
+#include <rcsc/geom/vector_2d.h>
+
+#include <string>
+#include <vector>
+
+namespace rcsc {
+
+/*!
+  \class FormationCached
+  \brief formation decorator that samples the positions from a precomputed grid.
+
+  The positions of the base formation are rasterized at the grid nodes
+  that cover [-MAX_X, MAX_X] x [-MAX_Y, MAX_Y]. A query is answered by
+  one bilinear interpolation of the four nodes around the focus point.
+  The focus point out of the grid is clamped to the grid area.
+
+  The grid is created by rasterize() or read from the file written by write().
+  Before that, all queries are forwarded to the base formation.
+  The base formation must not be modified after the grid is created.
+ */
+class FormationCached
+    : public Formation {
+public:
+
+    static constexpr double DEFAULT_RESOLUTION = 0.5; //!< default grid interval
+    static constexpr double MAX_X = 60.0; //!< grid area half length
+    static constexpr double MAX_Y = 45.0; //!< grid area half width
+
+private:
+
+    //! the formation to be rasterized
+    Formation::ConstPtr M_base;
+
+    //! grid interval
+    double M_resolution;
+
+    int M_width; //!< the number of grid nodes in x direction
+    int M_height; //!< the number of grid nodes in y direction
+
+    //! 11 positions (x, y) for each grid node. the nodes are ordered by rows.
+    std::vector< float > M_table;
+
+public:
+
+    /*!
+      \brief copy the role data of the base formation. the grid is not created yet.
+      \param base the formation to be rasterized
+      \param resolution grid interval
+     */
+    FormationCached( const Formation::ConstPtr & base,
+                     const double resolution = DEFAULT_RESOLUTION );
+
+    /*!
+      \brief create the decorator and rasterize the base formation.
+      \param base the formation to be rasterized
+      \param resolution grid interval
+      \return pointer to the new instance
+     */
+    static
+    Formation::Ptr create( const Formation::ConstPtr & base,
+                           const double resolution = DEFAULT_RESOLUTION );
+
+    /*!
+      \brief get the base formation
+      \return const pointer to the base formation
+     */
+    const Formation::ConstPtr & base() const
+    {
+        return M_base;
+    }
+
+    /*!
+      \brief get the grid interval
+      \return grid interval
+     */
+    double resolution() const
+    {
+        return M_resolution;
+    }
+
+    /*!
+      \brief check if the grid is available
+      \return true if the grid is created
+     */
+    bool isCached() const
+    {
+        return ! M_table.empty();
+    }
+
+    /*!
+      \brief create the grid by evaluating the base formation at all nodes
+      \return true if success
+     */
+    bool rasterize();
+
+    /*!
+      \brief read the grid from the binary file.
+      \param filepath the path of the input file
+      \return true if the file is read and consistent with the base formation.
+     */
+    bool read( const std::string & filepath );
+
+    /*!
+      \brief write the grid to the binary file. the byte order is the native one.
+      \param filepath the path of the output file
+      \return true if success
+     */
+    bool write( const std::string & filepath ) const;
+
+    /*!
+      \brief get the method name of the base formation
+      \return name string
+    */
+    virtual
+    std::string methodName() const override;
+
+    /*!
+      \brief get position for the current focus point
+      \param num position number
+      \param focus_point current focus point, usually ball position.
+    */
+    virtual
+    Vector2D getPosition( const int num,
+                          const Vector2D & focus_point ) const override;
+
+    /*!
+      \brief get all positions for the current focus point
+      \param focus_point current focus point, usually ball position
+      \param positions contaner to store the result
+    */
+    virtual
+    void getPositions( const Vector2D & focus_point,
+                       std::vector< Vector2D > & positions ) const override;
+
+    /*!
+      \brief the decorator cannot be trained. train the base formation and create a new decorator.
+      \param data training data
+      \return always false
+    */
+    virtual
+    bool train( const FormationData & data ) override;
+
+    /*!
+      \brief create data of the base formation
+      \return formation data
+     */
+    virtual
+    FormationData::Ptr toData() const override;
+
+protected:
+
+    /*!
+      \brief print model data of the base formation
+      \param os output stream
+      \return true if success
+     */
+    virtual
+    bool printData( std::ostream & os ) const override;
+
+private:
+
+    /*!
+      \brief get the grid cell and the interpolation ratio for the focus point
+      \param focus_point current focus point
+      \param ratio_x pointer to the variable to store the ratio in x direction
+      \param ratio_y pointer to the variable to store the ratio in y direction
+      \return the node index of the minimum corner of the cell
+     */
+    int getCell( const Vector2D & focus_point,
+                 double * ratio_x,
+                 double * ratio_y ) const;
+};
+
+}
+
+#endif
@@ -46,6 +46,8 @@
 
 namespace rcsc {
 
+constexpr size_t FormationData::Positions::CAPACITY;
+
 const double FormationData::PRECISION = 0.01;
 const size_t FormationData::MAX_DATA_SIZE = 128;
 const double FormationData::NEAR_DIST_THR = 0.5;
@@ -67,6 +69,7 @@ FormationData::rounded_vector( const double x,
 
 /*-------------------------------------------------------------------*/
 FormationData::FormationData()
+    : M_next_id( 0 )
 {
 
 }
@@ -76,6 +79,7 @@ void
 FormationData::clear()
 {
     M_data_cont.clear();
+    M_next_id = 0;
 }
 
 /*-------------------------------------------------------------------*/
@@ -83,16 +87,28 @@ const
 FormationData::Data *
 FormationData::data( const size_t idx ) const
 {
-    if ( M_data_cont.empty()
-         || M_data_cont.size() < idx )
+    if ( M_data_cont.size() <= idx )
     {
         return nullptr;
     }
 
-    FormationData::DataCont::const_iterator it = M_data_cont.begin();
-    std::advance( it, idx );
+    return &M_data_cont[idx];
+}
+
+/*-------------------------------------------------------------------*/
+const
+FormationData::Data *
+FormationData::findData( const int id ) const
+{
+    for ( const FormationData::Data & d : M_data_cont )
+    {
+        if ( d.id_ == id )
+        {
+            return &d;
+        }
+    }
 
-    return &(*it);
+    return nullptr;
 }
 
 /*-------------------------------------------------------------------*/
@@ -169,6 +185,7 @@ FormationData::addData( const FormationData::Data & data )
     // add data
     //
     M_data_cont.push_back( data );
+    M_data_cont.back().id_ = M_next_id++;
 
     // std::cerr << "Added data. current data size = " << M_data_cont.size()
     //           << std::endl;
@@ -202,12 +219,10 @@ FormationData::insertData( const size_t idx,
     //
     // insert data
     //
-    DataCont::iterator it = M_data_cont.begin();
-    std::advance( it, idx );
+    DataCont::iterator it = M_data_cont.insert( M_data_cont.begin() + idx, data );
+    it->id_ = M_next_id++;
 
-    M_data_cont.insert( it, data );
-
-    std::cerr << "Inserted data at index=" << std::distance( M_data_cont.begin(), it ) + 1
+    std::cerr << "Inserted data at index=" << idx + 1
               << ". current data size = " << M_data_cont.size()
               << std::endl;
 
@@ -221,13 +236,12 @@ std::string
 FormationData::replaceData( const size_t idx,
                             const FormationData::Data & data )
 {
-    if ( M_data_cont.size() < idx )
+    if ( M_data_cont.size() <= idx )
     {
         return std::string( "Invalid index" );
     }
 
-    DataCont::iterator replaced = M_data_cont.begin();
-    std::advance( replaced, idx );
+    DataCont::iterator replaced = M_data_cont.begin() + idx;
 
     //
     // check near data
@@ -246,8 +260,9 @@ FormationData::replaceData( const size_t idx,
         }
     }
 
-    FormationData::Data original_data = *replaced;
+    const int id = replaced->id_;
     *replaced = data;
+    replaced->id_ = id;
 
     std::cerr << "Replaced data at index=" << idx << std::endl;
 
@@ -263,18 +278,15 @@ FormationData::replaceData( const size_t idx,
 std::string
 FormationData::removeData( const size_t idx )
 {
-    if ( M_data_cont.size() < idx )
+    if ( M_data_cont.size() <= idx )
     {
         return std::string( "Invalid index" );
     }
 
-    DataCont::iterator it = M_data_cont.begin();
-    std::advance( it, idx );
-
     //
     // remove the data
     //
-    M_data_cont.erase( it );
+    M_data_cont.erase( M_data_cont.begin() + idx );
 
     //
     updateDataIndex();
@@ -288,21 +300,26 @@ FormationData::changeDataIndex( const size_t old_idx,
                                 const size_t new_idx )
 {
     if ( old_idx == new_idx
-         || M_data_cont.size() < old_idx
+         || M_data_cont.size() <= old_idx
          || M_data_cont.size() < new_idx )
     {
         return std::string( "Invalid index" );
     }
 
-    DataCont::iterator oit = M_data_cont.begin();
-    std::advance( oit, old_idx );
-
-    DataCont::iterator nit = M_data_cont.begin();
-    std::advance( nit, new_idx );
+    //
+    // move the data just before the data at new_idx
+    //
+    const DataCont::iterator oit = M_data_cont.begin() + old_idx;
+    const DataCont::iterator nit = M_data_cont.begin() + new_idx;
 
-    DataCont tmp_list;
-    tmp_list.splice( tmp_list.end(), M_data_cont, oit );
-    M_data_cont.splice( nit, tmp_list );
+    if ( old_idx < new_idx )
+    {
+        std::rotate( oit, oit + 1, nit );
+    }
+    else
+    {
+        std::rotate( nit, oit, oit + 1 );
+    }
 
     updateDataIndex();
 
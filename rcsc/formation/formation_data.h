@@ -37,9 +37,9 @@
 #include <memory>
 #include <array>
 #include <vector>
-#include <list>
 #include <utility>
 #include <string>
+#include <stdexcept>
 #include <iostream>
 
 namespace rcsc {
@@ -51,23 +51,103 @@ namespace rcsc {
 class FormationData {
 public:
 
+    /*!
+      \class Positions
+      \brief players' positions stored inline in the data element.
+      The interface is a subset of std::vector. The capacity is fixed to 11.
+    */
+    class Positions {
+    public:
+        typedef Vector2D value_type;
+        typedef Vector2D * iterator;
+        typedef const Vector2D * const_iterator;
+
+        static constexpr size_t CAPACITY = 11; //!< the number of field players
+
+    private:
+        Vector2D M_values[CAPACITY]; //!< position values
+        size_t M_size; //!< the number of stored positions
+
+    public:
+        /*!
+          \brief create an empty container
+        */
+        Positions()
+            : M_size( 0 )
+        { }
+
+        /*!
+          \brief create with the position values
+          \param values position values. the size must not exceed the capacity.
+        */
+        Positions( const std::vector< Vector2D > & values )
+            : M_size( 0 )
+        {
+            for ( const Vector2D & v : values ) push_back( v );
+        }
+
+        // std::vector compatible interface
+
+        size_t size() const { return M_size; }
+        bool empty() const { return M_size == 0; }
+        static constexpr size_t capacity() { return CAPACITY; }
+        void reserve( const size_t ) { }
+        void clear() { M_size = 0; }
+
+        void resize( const size_t n )
+        {
+            if ( n > CAPACITY ) throw std::length_error( "FormationData::Positions::resize" );
+            for ( size_t i = M_size; i < n; ++i ) M_values[i].assign( 0.0, 0.0 );
+            M_size = n;
+        }
+
+        void push_back( const Vector2D & v )
+        {
+            if ( M_size >= CAPACITY ) throw std::length_error( "FormationData::Positions::push_back" );
+            M_values[M_size++] = v;
+        }
+
+        void emplace_back( const double x,
+                           const double y )
+        {
+            push_back( Vector2D( x, y ) );
+        }
+
+        Vector2D & operator[]( const size_t i ) { return M_values[i]; }
+        const Vector2D & operator[]( const size_t i ) const { return M_values[i]; }
+
+        const Vector2D & at( const size_t i ) const
+        {
+            if ( i >= M_size ) throw std::out_of_range( "FormationData::Positions::at" );
+            return M_values[i];
+        }
+
+        Vector2D * data() { return M_values; }
+        const Vector2D * data() const { return M_values; }
+
+        iterator begin() { return M_values; }
+        iterator end() { return M_values + M_size; }
+        const_iterator begin() const { return M_values; }
+        const_iterator end() const { return M_values + M_size; }
+    };
+
     /*!
       \struct Data
       \brief training data element.
     */
     struct Data {
-        int index_;
+        int index_; //!< index in the data container
+        int id_; //!< id assigned when added to the container. never changed by the other operations.
         Vector2D ball_; //!< ball position
-        std::vector< Vector2D > players_; //!< players' position
+        Positions players_; //!< players' position
 
         /*!
           \brief default constructor
         */
         Data()
-            : index_( -1 )
-        {
-            players_.reserve( 11 );
-        }
+            : index_( -1 ),
+              id_( -1 )
+        { }
 
         /*!
           \brief construct with all data
@@ -77,6 +157,7 @@ public:
         Data( const Vector2D & ball,
               const std::vector< Vector2D > & players )
             : index_( -1 ),
+              id_( -1 ),
               ball_( ball ),
               players_( players )
         { }
@@ -94,7 +175,7 @@ public:
 
     typedef std::shared_ptr< FormationData > Ptr;
     typedef std::shared_ptr< const FormationData > ConstPtr;
-    typedef std::list< Data > DataCont; //!< data container type.
+    typedef std::vector< Data > DataCont; //!< data container type.
 
     static const double PRECISION; //!< coordinates value precision
     static const size_t MAX_DATA_SIZE; //!< max data size
@@ -107,6 +188,7 @@ public:
 private:
 
     DataCont M_data_cont; //!< data container.
+    int M_next_id; //!< id of the next added data
 
     // not used
     FormationData( const FormationData & other ) = delete;
@@ -152,6 +234,13 @@ public:
     */
     const Data * data( const size_t idx ) const;
 
+    /*!
+      \brief get the data that has the specified id.
+      \param id data id.
+      \return const pointer to the data. if no matched data, NULL is returned.
+    */
+    const Data * findData( const int id ) const;
+
     /*!
       \brief get the data index nearest to the input point.
       \param pos input point.
@@ -194,6 +283,7 @@ public:
 
     /*!
       \brief replace exsiting data at input index with input data.
+      The new data takes over the id of the replaced data.
       \param idx target index.
       \param data new data.
       \return error message if error occurd. otherwise, empty string.
@@ -37,14 +37,49 @@
 
 #include <rcsc/geom/segment_2d.h>
 #include <rcsc/geom/line_2d.h>
+#include <rcsc/util/memory_accounting.h>
+
+#include <algorithm>
+#include <fstream>
+#include <type_traits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace rcsc {
 
 const std::string FormationDT::NAME( "DelaunayTriangulation" );
+constexpr double FormationDT::GRID_CELL_SIZE;
+
+namespace {
+
+//! the number of players in each sample
+constexpr int PLAYER_SIZE = 11;
+
+//! tolerance of the barycentric weights to accept the point on the triangle edge
+constexpr double WEIGHT_TOLERANCE = 1.0e-9;
+
+}
 
 /*-------------------------------------------------------------------*/
 FormationDT::FormationDT()
-    : Formation()
+    : Formation(),
+      M_grid_origin( 0.0, 0.0 ),
+      M_grid_width( 0 ),
+      M_grid_height( 0 ),
+      M_position_data( nullptr ),
+      M_lookup_data( nullptr ),
+      M_lookup_size( 0 ),
+      M_grid_offset_data( nullptr ),
+      M_grid_triangle_data( nullptr )
 {
 
 }
@@ -56,6 +91,20 @@ FormationDT::methodName() const
     return NAME;
 }
 
+/*-------------------------------------------------------------------*/
+std::size_t
+FormationDT::memoryUsage() const
+{
+    // the player positions are stored inline in each data element.
+    return Formation::memoryUsage()
+        + vector_memory_usage( M_points )
+        + M_triangulation.memoryUsage()
+        + vector_memory_usage( M_position_table )
+        + vector_memory_usage( M_lookup_triangles )
+        + vector_memory_usage( M_grid_offsets )
+        + vector_memory_usage( M_grid_triangles );
+}
+
 /*-------------------------------------------------------------------*/
 Vector2D
 FormationDT::getPosition( const int num,
@@ -67,10 +116,35 @@ FormationDT::getPosition( const int num,
         return Vector2D::INVALIDATED;
     }
 
-    const DelaunayTriangulation::Triangle * tri = M_triangulation.findTriangleContains( focus_point );
+    if ( ! M_position_data )
+    {
+        const DelaunayTriangulation::Triangle * tri = M_triangulation.findTriangleContains( focus_point );
 
-    // linear interpolation
-    return interpolate( num, focus_point, tri );
+        // linear interpolation
+        return interpolate( num, focus_point, tri );
+    }
+
+    int index[3];
+    double weight[3];
+    const int n = findSamples( focus_point, index, weight );
+
+    if ( n == 0 )
+    {
+        std::cerr << "(FormationDT::getPosition) ERROR: No vertex." << std::endl;
+        return Vector2D::INVALIDATED;
+    }
+
+    if ( n == 1 )
+    {
+        return M_position_data[index[0] * PLAYER_SIZE + num - 1];
+    }
+
+    const Vector2D & p0 = M_position_data[index[0] * PLAYER_SIZE + num - 1];
+    const Vector2D & p1 = M_position_data[index[1] * PLAYER_SIZE + num - 1];
+    const Vector2D & p2 = M_position_data[index[2] * PLAYER_SIZE + num - 1];
+
+    return Vector2D( weight[0] * p0.x + weight[1] * p1.x + weight[2] * p2.x,
+                     weight[0] * p0.y + weight[1] * p1.y + weight[2] * p2.y );
 }
 
 /*-------------------------------------------------------------------*/
@@ -78,14 +152,113 @@ void
 FormationDT::getPositions( const Vector2D & focus_point,
                            std::vector< Vector2D > & positions ) const
 {
-    positions.clear();
+    positions.resize( PLAYER_SIZE );
+
+    if ( interpolatePositions( focus_point, positions.data() ) == 0 )
+    {
+        std::cerr << "(FormationDT::getPositions) ERROR: No vertex." << std::endl;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+int
+FormationDT::interpolatePositions( const Vector2D & focus_point,
+                                   Vector2D * positions ) const
+{
+    if ( ! M_position_data )
+    {
+        const DelaunayTriangulation::Triangle * tri = M_triangulation.findTriangleContains( focus_point );
+
+        for ( int num = 1; num <= PLAYER_SIZE; ++num )
+        {
+            positions[num - 1] = interpolate( num, focus_point, tri );
+        }
+        return ( tri ? 3 : 1 );
+    }
+
+    int index[3];
+    double weight[3];
+    const int n = findSamples( focus_point, index, weight );
+
+    if ( n == 0 )
+    {
+        std::fill( positions, positions + PLAYER_SIZE, Vector2D::INVALIDATED );
+        return 0;
+    }
+
+    const Vector2D * p0 = M_position_data + index[0] * PLAYER_SIZE;
+
+    if ( n == 1 )
+    {
+        std::copy( p0, p0 + PLAYER_SIZE, positions );
+        return 1;
+    }
+
+    const Vector2D * p1 = M_position_data + index[1] * PLAYER_SIZE;
+    const Vector2D * p2 = M_position_data + index[2] * PLAYER_SIZE;
+    const double w0 = weight[0];
+    const double w1 = weight[1];
+    const double w2 = weight[2];
+
+    // all players are interpolated by the same weights. this loop can be vectorized.
+    for ( int i = 0; i < PLAYER_SIZE; ++i )
+    {
+        positions[i].assign( w0 * p0[i].x + w1 * p1[i].x + w2 * p2[i].x,
+                             w0 * p0[i].y + w1 * p1[i].y + w2 * p2[i].y );
+    }
+    return 3;
+}
+
+/*-------------------------------------------------------------------*/
+int
+FormationDT::findSamples( const Vector2D & focus_point,
+                          int index[3],
+                          double weight[3] ) const
+{
+    if ( M_grid_offset_data )
+    {
+        const double cx = std::floor( ( focus_point.x - M_grid_origin.x ) / GRID_CELL_SIZE );
+        const double cy = std::floor( ( focus_point.y - M_grid_origin.y ) / GRID_CELL_SIZE );
 
-    const DelaunayTriangulation::Triangle * tri = M_triangulation.findTriangleContains( focus_point );
+        if ( 0.0 <= cx && cx < M_grid_width
+             && 0.0 <= cy && cy < M_grid_height )
+        {
+            const int cell = static_cast< int >( cy ) * M_grid_width + static_cast< int >( cx );
+            for ( int i = M_grid_offset_data[cell]; i < M_grid_offset_data[cell + 1]; ++i )
+            {
+                const LookupTriangle & t = M_lookup_data[M_grid_triangle_data[i]];
+                const double w1 = t.coef_[0][0] * focus_point.x + t.coef_[0][1] * focus_point.y + t.coef_[0][2];
+                const double w2 = t.coef_[1][0] * focus_point.x + t.coef_[1][1] * focus_point.y + t.coef_[1][2];
+                const double w0 = 1.0 - w1 - w2;
 
-    for ( int num = 1; num <= 11; ++num )
+                if ( w0 >= -WEIGHT_TOLERANCE
+                     && w1 >= -WEIGHT_TOLERANCE
+                     && w2 >= -WEIGHT_TOLERANCE )
+                {
+                    index[0] = t.vertex_[0];
+                    index[1] = t.vertex_[1];
+                    index[2] = t.vertex_[2];
+                    weight[0] = w0;
+                    weight[1] = w1;
+                    weight[2] = w2;
+                    return 3;
+                }
+            }
+        }
+    }
+
+    // the focus point is out of the triangulation.
+    const DelaunayTriangulation::Vertex * v = M_triangulation.findNearestVertex( focus_point );
+    if ( ! v
+         || v->id() < 0
+         || static_cast< int >( M_points.size() ) <= v->id() )
     {
-        positions.push_back( interpolate( num, focus_point, tri ) );
+        return 0;
     }
+
+    index[0] = v->id();
+    weight[0] = 1.0;
+    return 1;
 }
 
 /*-------------------------------------------------------------------*/
@@ -183,21 +356,197 @@ FormationDT::interpolate( const int num,
 bool
 FormationDT::train( const FormationData & data )
 {
+    const FormationData::DataCont & samples = data.dataCont();
+
+    //
+    // if the ball positions are not changed, the current triangulation can be reused.
+    // the binary data does not have the triangles, so the triangulation is always computed.
+    //
+    bool same_vertices = ( samples.size() == M_points.size()
+                           && ! M_points.empty()
+                           && ! M_binary_data );
+    for ( size_t i = 0; same_vertices && i < samples.size(); ++i )
+    {
+        same_vertices = samples[i].ball_.equals( M_points[i].ball_ );
+    }
+
+    if ( same_vertices )
+    {
+        M_points = samples;
+        if ( buildPositionTable()
+             && M_lookup_triangles.empty() )
+        {
+            buildLookupGrid();
+        }
+        referTables();
+        return true;
+    }
+
     Rect2D pitch( Vector2D( -60.0, -45.0 ),
                   Size2D( 120.0, 90.0 ) );
     M_triangulation.init( pitch );
-    M_points.clear();
+    M_points = samples;
 
-    for ( const FormationData::Data & d : data.dataCont() )
+    for ( const FormationData::Data & d : M_points )
     {
         M_triangulation.addVertex( d.ball_ );
-        M_points.push_back( d );
     }
 
     M_triangulation.compute();
+    buildLookupGrid();
+    M_binary_data.reset();
+    referTables();
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+bool
+FormationDT::buildPositionTable()
+{
+    M_position_table.clear();
+    M_position_table.reserve( M_points.size() * PLAYER_SIZE );
+
+    for ( const FormationData::Data & d : M_points )
+    {
+        if ( d.players_.size() != static_cast< size_t >( PLAYER_SIZE ) )
+        {
+            // the positions are interpolated by the triangulation directly.
+            M_position_table.clear();
+            return false;
+        }
+        M_position_table.insert( M_position_table.end(), d.players_.begin(), d.players_.end() );
+    }
+
     return true;
 }
 
+/*-------------------------------------------------------------------*/
+void
+FormationDT::referTables()
+{
+    M_position_data = ( M_position_table.empty() ? nullptr : M_position_table.data() );
+    M_lookup_data = M_lookup_triangles.data();
+    M_lookup_size = M_lookup_triangles.size();
+    M_grid_offset_data = ( M_grid_offsets.empty() ? nullptr : M_grid_offsets.data() );
+    M_grid_triangle_data = M_grid_triangles.data();
+}
+
+/*-------------------------------------------------------------------*/
+void
+FormationDT::buildLookupGrid()
+{
+    M_lookup_triangles.clear();
+    M_grid_origin.assign( 0.0, 0.0 );
+    M_grid_width = 0;
+    M_grid_height = 0;
+    M_grid_offsets.clear();
+    M_grid_triangles.clear();
+
+    if ( ! buildPositionTable() )
+    {
+        return;
+    }
+
+    //
+    // precompute the barycentric coefficients
+    //
+    Vector2D min_pos( +1.0e10, +1.0e10 );
+    Vector2D max_pos( -1.0e10, -1.0e10 );
+    std::vector< Vector2D > tri_min;
+    std::vector< Vector2D > tri_max;
+
+    for ( const DelaunayTriangulation::TriangleCont::value_type & v : M_triangulation.triangles() )
+    {
+        const DelaunayTriangulation::Triangle & tri = *v.second;
+        const Vector2D & a = tri.vertex( 0 )->pos();
+        const Vector2D & b = tri.vertex( 1 )->pos();
+        const Vector2D & c = tri.vertex( 2 )->pos();
+
+        const double det = ( b.x - a.x ) * ( c.y - a.y ) - ( c.x - a.x ) * ( b.y - a.y );
+        if ( std::fabs( det ) < DelaunayTriangulation::EPSILON )
+        {
+            continue;
+        }
+
+        LookupTriangle t;
+        t.vertex_[0] = tri.vertex( 0 )->id();
+        t.vertex_[1] = tri.vertex( 1 )->id();
+        t.vertex_[2] = tri.vertex( 2 )->id();
+        // (p - a) = w1 * (b - a) + w2 * (c - a)
+        t.coef_[0][0] = ( c.y - a.y ) / det;
+        t.coef_[0][1] = -( c.x - a.x ) / det;
+        t.coef_[0][2] = ( a.y * ( c.x - a.x ) - a.x * ( c.y - a.y ) ) / det;
+        t.coef_[1][0] = -( b.y - a.y ) / det;
+        t.coef_[1][1] = ( b.x - a.x ) / det;
+        t.coef_[1][2] = ( a.x * ( b.y - a.y ) - a.y * ( b.x - a.x ) ) / det;
+        M_lookup_triangles.push_back( t );
+
+        tri_min.emplace_back( std::min( { a.x, b.x, c.x } ), std::min( { a.y, b.y, c.y } ) );
+        tri_max.emplace_back( std::max( { a.x, b.x, c.x } ), std::max( { a.y, b.y, c.y } ) );
+        min_pos.assign( std::min( min_pos.x, tri_min.back().x ), std::min( min_pos.y, tri_min.back().y ) );
+        max_pos.assign( std::max( max_pos.x, tri_max.back().x ), std::max( max_pos.y, tri_max.back().y ) );
+    }
+
+    if ( M_lookup_triangles.empty() )
+    {
+        return;
+    }
+
+    //
+    // register the triangles to all cells that overlap with their bounding box
+    //
+    M_grid_origin = min_pos;
+    M_grid_width = static_cast< int >( std::floor( ( max_pos.x - min_pos.x ) / GRID_CELL_SIZE ) ) + 1;
+    M_grid_height = static_cast< int >( std::floor( ( max_pos.y - min_pos.y ) / GRID_CELL_SIZE ) ) + 1;
+
+    const auto cell_x = [this]( const double x )
+                          {
+                              return std::min( M_grid_width - 1,
+                                               static_cast< int >( ( x - M_grid_origin.x ) / GRID_CELL_SIZE ) );
+                          };
+    const auto cell_y = [this]( const double y )
+                          {
+                              return std::min( M_grid_height - 1,
+                                               static_cast< int >( ( y - M_grid_origin.y ) / GRID_CELL_SIZE ) );
+                          };
+
+    M_grid_offsets.assign( M_grid_width * M_grid_height + 1, 0 );
+
+    for ( int loop = 0; loop < 2; ++loop )
+    {
+        // the first loop counts the triangles in each cell. the second loop stores them.
+        std::vector< int > pos( M_grid_offsets.begin(), M_grid_offsets.end() - 1 );
+
+        for ( size_t i = 0; i < M_lookup_triangles.size(); ++i )
+        {
+            for ( int iy = cell_y( tri_min[i].y ), max_y = cell_y( tri_max[i].y ); iy <= max_y; ++iy )
+            {
+                for ( int ix = cell_x( tri_min[i].x ), max_x = cell_x( tri_max[i].x ); ix <= max_x; ++ix )
+                {
+                    const int cell = iy * M_grid_width + ix;
+                    if ( loop == 0 )
+                    {
+                        ++M_grid_offsets[cell + 1];
+                    }
+                    else
+                    {
+                        M_grid_triangles[pos[cell]++] = static_cast< int >( i );
+                    }
+                }
+            }
+        }
+
+        if ( loop == 0 )
+        {
+            for ( size_t c = 1; c < M_grid_offsets.size(); ++c )
+            {
+                M_grid_offsets[c] += M_grid_offsets[c - 1];
+            }
+            M_grid_triangles.resize( M_grid_offsets.back() );
+        }
+    }
+}
+
 /*-------------------------------------------------------------------*/
 FormationData::Ptr
 FormationDT::toData() const
@@ -212,6 +561,447 @@ FormationDT::toData() const
     return ptr;
 }
 
+/*-------------------------------------------------------------------*/
+namespace {
+
+//
+// binary formation file format.
+// [BinaryHeader]
+// [Vector2D x point_size] ball positions
+// [Vector2D x point_size * 11] position table
+// [LookupTriangle x lookup_size]
+// [int32 x (grid_width * grid_height + 1)] grid offsets
+// [int32 x grid_triangle_size] grid triangles
+// [char x string_size] version string and role names. each string is terminated by '\0'.
+// all values are stored in the native byte order.
+//
+
+const char BINARY_MAGIC[8] = { 'R', 'C', 'S', 'C', 'F', 'D', 'T', '\0' };
+const std::uint32_t BINARY_VERSION = 1;
+const std::uint32_t BINARY_BYTE_ORDER = 0x01020304;
+
+struct BinaryHeader {
+    char magic_[8];
+    std::uint32_t version_;
+    std::uint32_t byte_order_;
+    double grid_cell_size_;
+    double grid_origin_x_;
+    double grid_origin_y_;
+    std::int32_t grid_width_;
+    std::int32_t grid_height_;
+    std::uint32_t point_size_;
+    std::uint32_t lookup_size_;
+    std::uint32_t grid_triangle_size_;
+    std::uint32_t string_size_;
+    std::int32_t role_type_[11];
+    std::int32_t role_side_[11];
+    std::int32_t position_pair_[11];
+    std::int32_t padding_;
+};
+
+static_assert( sizeof( BinaryHeader ) % alignof( double ) == 0,
+               "binary formation sections must be aligned." );
+static_assert( sizeof( int ) == sizeof( std::int32_t ),
+               "grid indices must be stored as is in the binary file." );
+static_assert( std::is_trivially_copyable< Vector2D >::value
+               && sizeof( Vector2D ) == sizeof( double ) * 2,
+               "Vector2D must be stored as is in the binary file." );
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief load the whole file as read-only memory
+  \param filepath file path to read
+  \param size pointer to the variable to store the file size
+  \return pointer to the data. NULL if failed.
+ */
+std::shared_ptr< const char >
+load_binary_file( const std::string & filepath,
+                  std::size_t * size )
+{
+#ifdef HAVE_SYS_MMAN_H
+    const int fd = ::open( filepath.c_str(), O_RDONLY );
+    if ( fd < 0 )
+    {
+        return std::shared_ptr< const char >();
+    }
+
+    struct stat st;
+    if ( ::fstat( fd, &st ) != 0
+         || st.st_size <= 0 )
+    {
+        ::close( fd );
+        return std::shared_ptr< const char >();
+    }
+
+    const std::size_t length = static_cast< std::size_t >( st.st_size );
+    void * addr = ::mmap( nullptr, length, PROT_READ, MAP_SHARED, fd, 0 );
+    ::close( fd );
+
+    if ( addr == MAP_FAILED )
+    {
+        return std::shared_ptr< const char >();
+    }
+
+    *size = length;
+    return std::shared_ptr< const char >( static_cast< const char * >( addr ),
+                                          [length]( const char * p )
+                                            {
+                                                ::munmap( const_cast< char * >( p ), length );
+                                            } );
+#else
+    std::ifstream fin( filepath.c_str(), std::ios::binary | std::ios::ate );
+    if ( ! fin.is_open() )
+    {
+        return std::shared_ptr< const char >();
+    }
+
+    const std::streamsize length = fin.tellg();
+    if ( length <= 0 )
+    {
+        return std::shared_ptr< const char >();
+    }
+
+    char * buf = new char[length];
+    fin.seekg( 0 );
+    if ( ! fin.read( buf, length ) )
+    {
+        delete [] buf;
+        return std::shared_ptr< const char >();
+    }
+
+    *size = static_cast< std::size_t >( length );
+    return std::shared_ptr< const char >( buf, std::default_delete< const char[] >() );
+#endif
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+bool
+FormationDT::is_binary( const char * data,
+                        const std::size_t size )
+{
+    return ( size >= sizeof( BINARY_MAGIC )
+             && std::memcmp( data, BINARY_MAGIC, sizeof( BINARY_MAGIC ) ) == 0 );
+}
+
+/*-------------------------------------------------------------------*/
+bool
+FormationDT::readBinary( const std::string & filepath )
+{
+    std::size_t size = 0;
+    std::shared_ptr< const char > data = load_binary_file( filepath, &size );
+    if ( ! data )
+    {
+        std::cerr << "(FormationDT::readBinary) ERROR: could not read the file " << filepath << std::endl;
+        return false;
+    }
+
+    return readBinary( data, size );
+}
+
+/*-------------------------------------------------------------------*/
+bool
+FormationDT::readBinary( const std::shared_ptr< const char > & data,
+                         const std::size_t size )
+{
+    static_assert( std::is_trivially_copyable< LookupTriangle >::value
+                   && sizeof( LookupTriangle ) % alignof( double ) == 0,
+                   "LookupTriangle must be stored as is in the binary file." );
+
+    if ( ! data
+         || size < sizeof( BinaryHeader ) )
+    {
+        std::cerr << "(FormationDT::readBinary) ERROR: too short data." << std::endl;
+        return false;
+    }
+
+    const BinaryHeader * header = reinterpret_cast< const BinaryHeader * >( data.get() );
+
+    if ( ! is_binary( data.get(), size )
+         || header->version_ != BINARY_VERSION
+         || header->byte_order_ != BINARY_BYTE_ORDER
+         || header->grid_cell_size_ != GRID_CELL_SIZE )
+    {
+        std::cerr << "(FormationDT::readBinary) ERROR: unsupported format." << std::endl;
+        return false;
+    }
+
+    if ( header->point_size_ == 0
+         || header->lookup_size_ == 0
+         || header->grid_width_ <= 0
+         || header->grid_height_ <= 0 )
+    {
+        std::cerr << "(FormationDT::readBinary) ERROR: no lookup table." << std::endl;
+        return false;
+    }
+
+    const std::uint64_t point_size = header->point_size_;
+    const std::uint64_t grid_size = static_cast< std::uint64_t >( header->grid_width_ ) * header->grid_height_;
+    const std::uint64_t expected_size = sizeof( BinaryHeader )
+        + sizeof( Vector2D ) * point_size * ( 1 + PLAYER_SIZE )
+        + sizeof( LookupTriangle ) * header->lookup_size_
+        + sizeof( std::int32_t ) * ( grid_size + 1 )
+        + sizeof( std::int32_t ) * header->grid_triangle_size_
+        + header->string_size_;
+
+    if ( size != expected_size )
+    {
+        std::cerr << "(FormationDT::readBinary) ERROR: illegal data size." << std::endl;
+        return false;
+    }
+
+    const Vector2D * balls = reinterpret_cast< const Vector2D * >( data.get() + sizeof( BinaryHeader ) );
+    const Vector2D * positions = balls + point_size;
+    const LookupTriangle * triangles = reinterpret_cast< const LookupTriangle * >( positions + point_size * PLAYER_SIZE );
+    const int * grid_offsets = reinterpret_cast< const int * >( triangles + header->lookup_size_ );
+    const int * grid_triangles = grid_offsets + grid_size + 1;
+    const char * strings = reinterpret_cast< const char * >( grid_triangles + header->grid_triangle_size_ );
+
+    //
+    // validate the indices
+    //
+    for ( const LookupTriangle * t = triangles, * end = triangles + header->lookup_size_; t != end; ++t )
+    {
+        for ( int i = 0; i < 3; ++i )
+        {
+            if ( t->vertex_[i] < 0 || point_size <= static_cast< std::uint64_t >( t->vertex_[i] ) )
+            {
+                std::cerr << "(FormationDT::readBinary) ERROR: illegal vertex index." << std::endl;
+                return false;
+            }
+        }
+    }
+
+    if ( grid_offsets[0] != 0
+         || static_cast< std::uint32_t >( grid_offsets[grid_size] ) != header->grid_triangle_size_ )
+    {
+        std::cerr << "(FormationDT::readBinary) ERROR: illegal grid offset." << std::endl;
+        return false;
+    }
+
+    for ( std::uint64_t c = 0; c < grid_size; ++c )
+    {
+        if ( grid_offsets[c] > grid_offsets[c + 1] )
+        {
+            std::cerr << "(FormationDT::readBinary) ERROR: illegal grid offset." << std::endl;
+            return false;
+        }
+    }
+
+    for ( std::uint32_t i = 0; i < header->grid_triangle_size_; ++i )
+    {
+        if ( grid_triangles[i] < 0
+             || header->lookup_size_ <= static_cast< std::uint32_t >( grid_triangles[i] ) )
+        {
+            std::cerr << "(FormationDT::readBinary) ERROR: illegal triangle index." << std::endl;
+            return false;
+        }
+    }
+
+    //
+    // version string and role names
+    //
+    std::vector< std::string > names;
+    for ( const char * p = strings, * end = strings + header->string_size_; p != end; )
+    {
+        const char * term = static_cast< const char * >( std::memchr( p, '\0', end - p ) );
+        if ( ! term )
+        {
+            break;
+        }
+        names.emplace_back( p, term );
+        p = term + 1;
+    }
+
+    if ( names.size() != 1 + 11 )
+    {
+        std::cerr << "(FormationDT::readBinary) ERROR: illegal role names." << std::endl;
+        return false;
+    }
+
+    for ( int i = 0; i < 11; ++i )
+    {
+        if ( header->role_type_[i] < RoleType::Goalie || RoleType::Unknown < header->role_type_[i]
+             || header->role_side_[i] < RoleType::Left || RoleType::Right < header->role_side_[i] )
+        {
+            std::cerr << "(FormationDT::readBinary) ERROR: illegal role type." << std::endl;
+            return false;
+        }
+    }
+
+    //
+    // restore the samples. only the vertices are registered to the triangulation
+    // to find the nearest sample.
+    //
+    Rect2D pitch( Vector2D( -60.0, -45.0 ),
+                  Size2D( 120.0, 90.0 ) );
+    M_triangulation.init( pitch );
+    M_points.clear();
+    M_points.reserve( point_size );
+
+    for ( std::uint64_t i = 0; i < point_size; ++i )
+    {
+        if ( M_triangulation.addVertex( balls[i] ) != static_cast< int >( i ) )
+        {
+            std::cerr << "(FormationDT::readBinary) ERROR: duplicated sample." << std::endl;
+            M_triangulation.clear();
+            M_points.clear();
+            return false;
+        }
+
+        M_points.emplace_back();
+        FormationData::Data & d = M_points.back();
+        d.index_ = static_cast< int >( i );
+        d.id_ = static_cast< int >( i );
+        d.ball_ = balls[i];
+        for ( int unum = 0; unum < PLAYER_SIZE; ++unum )
+        {
+            d.players_.push_back( positions[i * PLAYER_SIZE + unum] );
+        }
+    }
+
+    setVersion( names[0] );
+    for ( int i = 0; i < 11; ++i )
+    {
+        setRole( i + 1,
+                 names[i + 1],
+                 RoleType( static_cast< RoleType::Type >( header->role_type_[i] ),
+                           static_cast< RoleType::Side >( header->role_side_[i] ) ),
+                 header->position_pair_[i] );
+    }
+
+    //
+    // refer the lookup tables in the binary data
+    //
+    std::vector< Vector2D >().swap( M_position_table );
+    std::vector< LookupTriangle >().swap( M_lookup_triangles );
+    std::vector< int >().swap( M_grid_offsets );
+    std::vector< int >().swap( M_grid_triangles );
+
+    M_grid_origin.assign( header->grid_origin_x_, header->grid_origin_y_ );
+    M_grid_width = header->grid_width_;
+    M_grid_height = header->grid_height_;
+
+    M_position_data = positions;
+    M_lookup_data = triangles;
+    M_lookup_size = header->lookup_size_;
+    M_grid_offset_data = grid_offsets;
+    M_grid_triangle_data = grid_triangles;
+
+    M_binary_data = data;
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+bool
+FormationDT::writeBinary( std::ostream & os ) const
+{
+    if ( ! M_position_data
+         || ! M_grid_offset_data
+         || M_lookup_size == 0 )
+    {
+        std::cerr << "(FormationDT::writeBinary) ERROR: no lookup table." << std::endl;
+        return false;
+    }
+
+    std::string strings = M_version;
+    strings += '\0';
+    for ( const std::string & name : M_role_names )
+    {
+        strings += name;
+        strings += '\0';
+    }
+
+    const std::size_t grid_size = static_cast< std::size_t >( M_grid_width ) * M_grid_height;
+
+    BinaryHeader header;
+    std::memset( &header, 0, sizeof( header ) );
+    std::memcpy( header.magic_, BINARY_MAGIC, sizeof( BINARY_MAGIC ) );
+    header.version_ = BINARY_VERSION;
+    header.byte_order_ = BINARY_BYTE_ORDER;
+    header.grid_cell_size_ = GRID_CELL_SIZE;
+    header.grid_origin_x_ = M_grid_origin.x;
+    header.grid_origin_y_ = M_grid_origin.y;
+    header.grid_width_ = M_grid_width;
+    header.grid_height_ = M_grid_height;
+    header.point_size_ = static_cast< std::uint32_t >( M_points.size() );
+    header.lookup_size_ = static_cast< std::uint32_t >( M_lookup_size );
+    header.grid_triangle_size_ = static_cast< std::uint32_t >( M_grid_offset_data[grid_size] );
+    header.string_size_ = static_cast< std::uint32_t >( strings.size() );
+    for ( int i = 0; i < 11; ++i )
+    {
+        header.role_type_[i] = M_role_types[i].type();
+        header.role_side_[i] = M_role_types[i].side();
+        header.position_pair_[i] = M_position_pairs[i];
+    }
+
+    os.write( reinterpret_cast< const char * >( &header ), sizeof( header ) );
+
+    for ( const FormationData::Data & d : M_points )
+    {
+        os.write( reinterpret_cast< const char * >( &d.ball_ ), sizeof( Vector2D ) );
+    }
+
+    os.write( reinterpret_cast< const char * >( M_position_data ),
+              sizeof( Vector2D ) * M_points.size() * PLAYER_SIZE );
+
+    for ( std::size_t i = 0; i < M_lookup_size; ++i )
+    {
+        // the padding bytes are cleared to make the same file from the same data.
+        LookupTriangle t;
+        std::memset( &t, 0, sizeof( t ) );
+        std::copy( M_lookup_data[i].vertex_, M_lookup_data[i].vertex_ + 3, t.vertex_ );
+        std::copy( &M_lookup_data[i].coef_[0][0], &M_lookup_data[i].coef_[0][0] + 6, &t.coef_[0][0] );
+        os.write( reinterpret_cast< const char * >( &t ), sizeof( t ) );
+    }
+
+    os.write( reinterpret_cast< const char * >( M_grid_offset_data ),
+              sizeof( int ) * ( grid_size + 1 ) );
+    os.write( reinterpret_cast< const char * >( M_grid_triangle_data ),
+              sizeof( int ) * header.grid_triangle_size_ );
+    os.write( strings.data(), strings.size() );
+
+    return static_cast< bool >( os );
+}
+
+/*-------------------------------------------------------------------*/
+bool
+FormationDT::writeBinary( const std::string & filepath ) const
+{
+    const std::string tmp_path = filepath + ".tmp";
+
+    {
+        std::ofstream fout( tmp_path.c_str(), std::ios::binary | std::ios::trunc );
+        if ( ! fout.is_open() )
+        {
+            return false;
+        }
+
+        if ( ! writeBinary( fout ) )
+        {
+            std::remove( tmp_path.c_str() );
+            return false;
+        }
+
+        fout.flush();
+        if ( ! fout )
+        {
+            std::remove( tmp_path.c_str() );
+            return false;
+        }
+    }
+
+    if ( std::rename( tmp_path.c_str(), filepath.c_str() ) != 0 )
+    {
+        std::remove( tmp_path.c_str() );
+        return false;
+    }
+
+    return true;
+}
+
 /*-------------------------------------------------------------------*/
 namespace {
 const std::string tab = "  ";
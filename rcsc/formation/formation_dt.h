@@ -35,6 +35,7 @@
 #include <rcsc/formation/formation.h>
 #include <rcsc/geom/delaunay_triangulation.h>
 #include <iostream>
+#include <memory>
 
 namespace rcsc {
 
@@ -48,13 +49,55 @@ public:
 
     static const std::string NAME; //!< type name
 
+    //! the size of a lookup grid cell
+    static constexpr double GRID_CELL_SIZE = 2.0;
+
 private:
+
+    /*!
+      \struct LookupTriangle
+      \brief triangle with the precomputed barycentric coefficients.
+      The weight of vertex i (i = 1, 2) is coef_[i-1][0] * x + coef_[i-1][1] * y + coef_[i-1][2].
+     */
+    struct LookupTriangle {
+        int vertex_[3]; //!< sample data index of each vertex
+        double coef_[2][3]; //!< barycentric coefficients for vertex 1 and vertex 2
+    };
+
     //! desired positins used by delaunay triangulation & linear interpolation
     std::vector< FormationData::Data > M_points;
 
     //! delaunay triangulation
     DelaunayTriangulation M_triangulation;
 
+    //! all players' positions of all samples. 11 consecutive positions for each sample.
+    std::vector< Vector2D > M_position_table;
+
+    //! triangles used by the position lookup
+    std::vector< LookupTriangle > M_lookup_triangles;
+
+    Vector2D M_grid_origin; //!< the minimum corner of the lookup grid
+    int M_grid_width; //!< the number of grid columns
+    int M_grid_height; //!< the number of grid rows
+    //! offset of the each cell in M_grid_triangles. the size is width * height + 1.
+    std::vector< int > M_grid_offsets;
+    //! candidate triangle indices of all cells
+    std::vector< int > M_grid_triangles;
+
+    //
+    // lookup data referred by the position search.
+    // these point to the above containers or the binary file data.
+    //
+
+    const Vector2D * M_position_data; //!< position table. NULL if not available.
+    const LookupTriangle * M_lookup_data; //!< lookup triangles
+    std::size_t M_lookup_size; //!< the number of lookup triangles
+    const int * M_grid_offset_data; //!< grid offsets. NULL if no grid.
+    const int * M_grid_triangle_data; //!< candidate triangle indices
+
+    //! read-only binary formation data (memory mapped if available). NULL if not used.
+    std::shared_ptr< const char > M_binary_data;
+
 public:
 
     /*!
@@ -115,16 +158,55 @@ public:
     void getPositions( const Vector2D & focus_point,
                        std::vector< Vector2D > & positions ) const override;
 
+    /*!
+      \brief get all positions for the current focus point without the container allocation
+      \param focus_point current focus point, usually ball position
+      \param positions array to store the positions of 11 players
+      \return the number of used samples. 3 if the focus point is covered by
+      the triangulation, 1 if the nearest sample is used, 0 if no sample.
+    */
+    int interpolatePositions( const Vector2D & focus_point,
+                              Vector2D * positions ) const;
+
 private:
 
     Vector2D interpolate( const int num,
                           const Vector2D & focus_point,
                           const DelaunayTriangulation::Triangle * tri ) const;
 
+    /*!
+      \brief create the position table from the current samples
+      \return false if some samples do not have all players' positions
+     */
+    bool buildPositionTable();
+
+    /*!
+      \brief create the position table and the lookup grid from the current triangulation
+     */
+    void buildLookupGrid();
+
+    /*!
+      \brief find the sample data and the weights to interpolate the positions
+      \param focus_point current focus point
+      \param index array to store the sample data index
+      \param weight array to store the weight of each sample
+      \return the number of used samples (3: in a triangle, 1: the nearest sample, 0: no sample)
+     */
+    int findSamples( const Vector2D & focus_point,
+                     int index[3],
+                     double weight[3] ) const;
+
+    /*!
+      \brief let the lookup data refer the owned containers
+     */
+    void referTables();
+
 public:
 
     /*!
-      \brief update formation paramter using training data set
+      \brief update formation paramter using training data set.
+      If the ball positions of all samples are not changed, e.g. only players are moved
+      in the editor, the current triangulation is reused and only the position table is updated.
       \param data training data
       \return true if success
     */
@@ -138,6 +220,65 @@ public:
     virtual
     FormationData::Ptr toData() const override;
 
+    /*!
+      \brief get the heap bytes held by this formation. the memory mapped
+      binary data is not included.
+      \return bytes
+     */
+    virtual
+    std::size_t memoryUsage() const override;
+
+    /*!
+      \brief read the binary formation file.
+      \param filepath file path to read
+      \return read result. false if the format version does not match.
+
+      The file is memory mapped read-only if the platform supports it, and the
+      trained lookup tables are referred directly from the mapped pages. Then,
+      all processes on the same host can share one page cached copy, and train()
+      is not needed. The triangulation only has the vertices, not the triangles.
+     */
+    bool readBinary( const std::string & filepath );
+
+    /*!
+      \brief read the binary formation data.
+      \param data read-only data. the pointer is held while the tables are used.
+      \param size data size
+      \return read result
+     */
+    bool readBinary( const std::shared_ptr< const char > & data,
+                     const std::size_t size );
+
+    /*!
+      \brief write the trained formation to the binary file.
+      \param filepath file path to write
+      \return write result. false if the lookup tables have not been created.
+
+      The data is written to a temporary file, then renamed to filepath,
+      so that the processes that already map the old file are not affected.
+     */
+    bool writeBinary( const std::string & filepath ) const;
+
+    /*!
+      \brief write the trained formation in the binary format to the stream.
+      \param os reference to the binary output stream
+      \return write result. false if the lookup tables have not been created.
+
+      The written data can be published by SharedTableSegment, and read by
+      readBinary( data, size ) in the other processes.
+     */
+    bool writeBinary( std::ostream & os ) const;
+
+    /*!
+      \brief check if the data begins with the magic bytes of the binary formation file
+      \param data data to check
+      \param size data size
+      \return true if the binary formation data
+     */
+    static
+    bool is_binary( const char * data,
+                    const std::size_t size );
+
 protected:
 
     /*!
@@ -0,0 +1,218 @@
+// -*-c++-*-
+
+/*!
+  \file formation_evaluator.cpp
+  \brief batch evaluation of formation variants Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "formation_evaluator.h"
+
+#include "formation_dt.h"
+
+#include <rcsc/rcg/column_block.h>
+#include <rcsc/rcg/parser_v7.h>
+#include <rcsc/util/task_graph.h>
+
+#include <algorithm>
+#include <iostream>
+#include <cmath>
+#include <limits>
+
+namespace rcsc {
+
+namespace {
+
+//! the number of players in each formation
+constexpr int PLAYER_SIZE = 11;
+
+}
+
+/*-------------------------------------------------------------------*/
+bool
+FormationEvaluator::readBallTrajectory( const std::string & filepath )
+{
+    std::vector< float > xs;
+    std::vector< float > ys;
+
+    if ( ! rcg::ParserV7::readColumn( filepath, rcg::ColumnBlock::BALL_X, &xs )
+         || ! rcg::ParserV7::readColumn( filepath, rcg::ColumnBlock::BALL_Y, &ys ) )
+    {
+        std::cerr << "(FormationEvaluator::readBallTrajectory) ERROR: could not read the ball columns from "
+                  << filepath << std::endl;
+        return false;
+    }
+
+    if ( xs.size() != ys.size() )
+    {
+        std::cerr << "(FormationEvaluator::readBallTrajectory) ERROR: column size mismatch in "
+                  << filepath << std::endl;
+        return false;
+    }
+
+    M_ball_trajectory.reserve( M_ball_trajectory.size() + xs.size() );
+    for ( std::size_t i = 0; i < xs.size(); ++i )
+    {
+        M_ball_trajectory.emplace_back( xs[i], ys[i] );
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+FormationEvaluator::Result
+FormationEvaluator::evaluate( const FormationDT & formation ) const
+{
+    Result result;
+
+    if ( formation.points().empty() )
+    {
+        return result;
+    }
+
+    result.trained_ = true;
+
+    const std::size_t size = M_ball_trajectory.size();
+    if ( size == 0 )
+    {
+        return result;
+    }
+
+    // the positions of the current and the previous ball position
+    Vector2D positions[2][PLAYER_SIZE];
+    double nearest_dist_sum = 0.0;
+    double move_dist_sum = 0.0;
+
+    for ( std::size_t i = 0; i < size; ++i )
+    {
+        const Vector2D & ball = M_ball_trajectory[i];
+        Vector2D * current = positions[i & 1];
+        const Vector2D * previous = positions[( i + 1 ) & 1];
+
+        if ( formation.interpolatePositions( ball, current ) == 3 )
+        {
+            ++result.covered_count_;
+        }
+
+        double nearest_dist2 = std::numeric_limits< double >::max();
+        for ( int p = 0; p < PLAYER_SIZE; ++p )
+        {
+            nearest_dist2 = std::min( nearest_dist2, current[p].dist2( ball ) );
+        }
+
+        const double nearest_dist = std::sqrt( nearest_dist2 );
+        nearest_dist_sum += nearest_dist;
+        result.max_nearest_dist_ = std::max( result.max_nearest_dist_, nearest_dist );
+
+        if ( i > 0 )
+        {
+            for ( int p = 0; p < PLAYER_SIZE; ++p )
+            {
+                move_dist_sum += current[p].dist( previous[p] );
+            }
+        }
+    }
+
+    result.coverage_ = static_cast< double >( result.covered_count_ ) / size;
+    result.mean_nearest_dist_ = nearest_dist_sum / size;
+    if ( size > 1 )
+    {
+        result.mean_move_dist_ = move_dist_sum / ( ( size - 1 ) * PLAYER_SIZE );
+    }
+
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+std::vector< FormationEvaluator::Result >
+FormationEvaluator::evaluate( const std::vector< FormationData::ConstPtr > & variants,
+                              const bool parallel ) const
+{
+    const std::size_t size = variants.size();
+    std::vector< Result > results( size );
+
+    if ( size == 0 )
+    {
+        return results;
+    }
+
+    // each task evaluates a contiguous range and writes only its own results.
+    // the variants generated from the same base data usually have the same ball
+    // positions, so the triangulation is reused within the range.
+    const auto evaluate_range = [this, &variants, &results]( const std::size_t begin,
+                                                             const std::size_t end )
+        {
+            FormationDT formation;
+            for ( std::size_t i = begin; i < end; ++i )
+            {
+                if ( ! variants[i]
+                     || variants[i]->dataCont().empty()
+                     || ! formation.train( *variants[i] ) )
+                {
+                    continue;
+                }
+
+                results[i] = evaluate( formation );
+            }
+        };
+
+    std::size_t workers = 0;
+    if ( parallel )
+    {
+        TaskPool & pool = TaskPool::instance();
+        pool.requestWorkerCount( pool.workerLimit() );
+        workers = pool.workerCount();
+    }
+
+    if ( workers == 0
+         || size == 1 )
+    {
+        evaluate_range( 0, size );
+        return results;
+    }
+
+    const std::size_t chunk = ( size + workers ) / ( workers + 1 );
+
+    TaskGraph graph;
+    for ( std::size_t begin = 0; begin < size; begin += chunk )
+    {
+        const std::size_t end = std::min( size, begin + chunk );
+        graph.add( [&evaluate_range, begin, end]()
+                   {
+                       evaluate_range( begin, end );
+                   } );
+    }
+    graph.run( true, TaskPool::BACKGROUND );
+
+    return results;
+}
+
+}
@@ -0,0 +1,146 @@
+// -*-c++-*-
+
+/*!
+  \file formation_evaluator.h
+  \brief batch evaluation of formation variants Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_FORMATION_FORMATION_EVALUATOR_H
+#define RCSC_FORMATION_FORMATION_EVALUATOR_H
+
+#include <rcsc/formation/formation_data.h>
+#include <rcsc/geom/vector_2d.h>
+
+#include <string>
+#include <vector>
+
+namespace rcsc {
+
+class FormationDT;
+
+/*!
+  \class FormationEvaluator
+  \brief scores many formation data variants over the same ball trajectory.
+
+  Each variant is trained as FormationDT, and the positions for all ball
+  positions in the trajectory are taken from the lookup grid of the trained
+  formation. The variants are split into the tasks executed on the background
+  lane of TaskPool. Each task reuses one FormationDT instance, so the
+  triangulation is computed only when the ball positions of the samples differ
+  from the previous variant in the same task. Only the metrics are kept, and
+  the trained formations are released after the evaluation.
+*/
+class FormationEvaluator {
+public:
+
+    /*!
+      \struct Result
+      \brief metrics of one variant
+     */
+    struct Result {
+        bool trained_; //!< false if the variant could not be trained
+        std::size_t covered_count_; //!< the number of ball positions inside the triangulation
+        double coverage_; //!< the rate of ball positions inside the triangulation
+        double mean_nearest_dist_; //!< average distance from the ball to the nearest player
+        double max_nearest_dist_; //!< maximum distance from the ball to the nearest player
+        double mean_move_dist_; //!< average movement of each player between the consecutive ball positions
+
+        /*!
+          \brief initialize all metrics with 0
+         */
+        Result()
+            : trained_( false ),
+              covered_count_( 0 ),
+              coverage_( 0.0 ),
+              mean_nearest_dist_( 0.0 ),
+              max_nearest_dist_( 0.0 ),
+              mean_move_dist_( 0.0 )
+        { }
+    };
+
+private:
+
+    //! ball positions shared by all variants
+    std::vector< Vector2D > M_ball_trajectory;
+
+public:
+
+    /*!
+      \brief create an evaluator with an empty trajectory
+     */
+    FormationEvaluator() = default;
+
+    /*!
+      \brief set the ball trajectory
+      \param trajectory ball positions in the time order
+     */
+    void setBallTrajectory( const std::vector< Vector2D > & trajectory )
+    {
+        M_ball_trajectory = trajectory;
+    }
+
+    /*!
+      \brief append the ball positions recorded in the rcg file.
+      \param filepath path to the v7 rcg file
+      \return true if successfully read
+
+      The ball columns are read by rcg::ParserV7::readColumn() without parsing
+      the player data. The positions of all shows are appended in the file order.
+     */
+    bool readBallTrajectory( const std::string & filepath );
+
+    /*!
+      \brief get the ball trajectory
+      \return const reference to the ball positions
+     */
+    const std::vector< Vector2D > & ballTrajectory() const
+    {
+        return M_ball_trajectory;
+    }
+
+    /*!
+      \brief evaluate the trained formation over the ball trajectory
+      \param formation trained formation
+      \return metrics. trained_ is false if the formation has no sample.
+     */
+    Result evaluate( const FormationDT & formation ) const;
+
+    /*!
+      \brief train and evaluate all variants
+      \param variants formation data variants
+      \param parallel if true, TaskPool is requested to start the workers up to
+      TaskPool::workerLimit(). if false, all variants are evaluated on the caller thread.
+      \return metrics in the same order as variants
+     */
+    std::vector< Result > evaluate( const std::vector< FormationData::ConstPtr > & variants,
+                                    const bool parallel = true ) const;
+};
+
+}
+
+#endif
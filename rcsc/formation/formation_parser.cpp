@@ -53,8 +53,15 @@ FormationParser::parse( const std::string & filepath )
         return Formation::Ptr();
     }
 
+    return parser->parseFile( filepath );
+}
+
+/*-------------------------------------------------------------------*/
+Formation::Ptr
+FormationParser::parseFile( const std::string & filepath )
+{
     std::ifstream fin( filepath );
-    return parser->parseImpl( fin );
+    return parseImpl( fin );
 }
 
 /*-------------------------------------------------------------------*/
@@ -120,6 +127,8 @@ FormationParser::checkPositionPair( const Formation::ConstPtr ptr )
 #include "formation_parser_static.h"
 #include "formation_parser_csv.h"
 #include "formation_parser_json.h"
+#include "formation_parser_binary.h"
+#include "formation_dt.h"
 
 namespace rcsc {
 
@@ -129,7 +138,19 @@ FormationParser::create( const std::string & filepath )
 {
     FormationParser::Ptr ptr;
 
-    std::ifstream fin( filepath.c_str() );
+    std::ifstream fin( filepath.c_str(), std::ios::binary );
+
+    char magic[8];
+    fin.read( magic, sizeof( magic ) );
+    if ( FormationDT::is_binary( magic, static_cast< std::size_t >( fin.gcount() ) ) )
+    {
+        ptr = FormationParser::Ptr( new FormationParserBinary() );
+        return ptr;
+    }
+
+    fin.clear();
+    fin.seekg( 0 );
+
     std::string line;
     while ( std::getline( fin, line ) )
     {
@@ -86,6 +86,15 @@ protected:
     virtual
     Formation::Ptr parseImpl( std::istream & is ) = 0;
 
+    /*!
+      \brief parse the given file. the default implementation opens the file
+      stream and calls parseImpl().
+      \param filepath the file path to be parsed
+      \return formation instance
+     */
+    virtual
+    Formation::Ptr parseFile( const std::string & filepath );
+
     /*!
       \brief check the consistency of role names
       \return true if success
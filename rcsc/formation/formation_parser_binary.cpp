@@ -0,0 +1,81 @@
+// -*-c++-*-
+
+/*!
+  \file formation_parser_binary.cpp
+  \brief binary formation data parser Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "formation_parser_binary.h"
+
+#include "formation_dt.h"
+
+#include <iterator>
+
+namespace rcsc {
+
+/*-------------------------------------------------------------------*/
+Formation::Ptr
+FormationParserBinary::parseImpl( std::istream & is )
+{
+    std::string buf( ( std::istreambuf_iterator< char >( is ) ),
+                     std::istreambuf_iterator< char >() );
+
+    const std::size_t size = buf.size();
+    char * data = new char[size > 0 ? size : 1];
+    std::copy( buf.begin(), buf.end(), data );
+
+    std::shared_ptr< FormationDT > ptr( new FormationDT() );
+    if ( ! ptr->readBinary( std::shared_ptr< const char >( data, std::default_delete< const char[] >() ),
+                            size ) )
+    {
+        std::cerr << "(FormationParserBinary::parseImpl) ERROR: illegal binary data." << std::endl;
+        return Formation::Ptr();
+    }
+
+    return ptr;
+}
+
+/*-------------------------------------------------------------------*/
+Formation::Ptr
+FormationParserBinary::parseFile( const std::string & filepath )
+{
+    std::shared_ptr< FormationDT > ptr( new FormationDT() );
+    if ( ! ptr->readBinary( filepath ) )
+    {
+        std::cerr << "(FormationParserBinary::parseFile) ERROR: illegal binary file " << filepath << std::endl;
+        return Formation::Ptr();
+    }
+
+    return ptr;
+}
+
+}
@@ -37,98 +37,250 @@
 
 #include "formation_static.h"
 
-#include <boost/property_tree/ptree.hpp>
-#include <boost/property_tree/json_parser.hpp>
+#include <rcsc/rcg/simdjson/simdjson.h>
 
-using namespace boost::property_tree;
+#include <charconv>
+#include <string_view>
+#include <type_traits>
 
 namespace rcsc {
 
 namespace {
 
+//! player number keys in the data element
+const char * const PLAYER_KEYS[11] = { "1", "2", "3", "4", "5", "6", "7", "8", "9", "10", "11" };
+
 /*-------------------------------------------------------------------*/
-std::string
-get_version( const ptree & doc )
+/*!
+  \struct JSONBuffer
+  \brief the parser and the padded input buffer reused by all parse calls in the thread
+ */
+struct JSONBuffer {
+    simdjson::ondemand::parser parser_; //!< parser instance
+    std::string data_; //!< input data followed by the padding
+};
+
+/*-------------------------------------------------------------------*/
+JSONBuffer &
+json_buffer()
+{
+    thread_local JSONBuffer s_buffer;
+    return s_buffer;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read the whole input stream into the buffer
+  \return input data size without the padding
+ */
+size_t
+read_all( std::istream & is,
+          std::string & data )
+{
+    constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+    size_t size = 0;
+    data.clear();
+    while ( is )
+    {
+        data.resize( size + CHUNK_SIZE );
+        is.read( &data[size], CHUNK_SIZE );
+        size += static_cast< size_t >( is.gcount() );
+    }
+
+    data.resize( size + simdjson::SIMDJSON_PADDING );
+    return size;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the string value. a number value is also accepted as its raw text.
+ */
+bool
+get_string( simdjson::ondemand::object & obj,
+            const char * key,
+            std::string_view * result )
 {
-    boost::optional< std::string > v = doc.get_optional< std::string >( "version" );
+    simdjson::ondemand::value val;
+    if ( obj[key].get( val ) != simdjson::SUCCESS )
+    {
+        return false;
+    }
 
-    if ( ! v )
+    if ( val.get_string().get( *result ) == simdjson::SUCCESS )
+    {
+        return true;
+    }
+
+    std::string_view raw = val.raw_json_token();
+    while ( ! raw.empty() && ( raw.back() == ' ' || raw.back() == '\t' || raw.back() == '\n' || raw.back() == '\r' ) )
+    {
+        raw.remove_suffix( 1 );
+    }
+    *result = raw;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the number value.
+  a quoted number written by the property tree writer is also accepted.
+ */
+template < typename T >
+bool
+get_number( simdjson::ondemand::object & obj,
+            const char * key,
+            T * result )
+{
+    simdjson::ondemand::value val;
+    if ( obj[key].get( val ) != simdjson::SUCCESS )
+    {
+        return false;
+    }
+
+    simdjson::ondemand::json_type type;
+    if ( val.type().get( type ) != simdjson::SUCCESS )
+    {
+        return false;
+    }
+
+    if ( type == simdjson::ondemand::json_type::number )
+    {
+        if constexpr ( std::is_integral< T >::value )
+        {
+            int64_t v = 0;
+            if ( val.get_int64().get( v ) != simdjson::SUCCESS ) return false;
+            *result = static_cast< T >( v );
+        }
+        else
+        {
+            double v = 0.0;
+            if ( val.get_double().get( v ) != simdjson::SUCCESS ) return false;
+            *result = static_cast< T >( v );
+        }
+        return true;
+    }
+
+    std::string_view str;
+    if ( type != simdjson::ondemand::json_type::string
+         || val.get_string().get( str ) != simdjson::SUCCESS )
+    {
+        return false;
+    }
+
+    const char * first = str.data();
+    const char * last = str.data() + str.size();
+    if ( first < last && *first == '+' ) ++first;
+
+    const std::from_chars_result r = std::from_chars( first, last, *result );
+    return r.ec == std::errc() && r.ptr == last;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the point value { "x" : <x>, "y" : <y> }
+ */
+bool
+get_point( simdjson::ondemand::object & obj,
+           const char * key,
+           Vector2D * result )
+{
+    simdjson::ondemand::object point;
+    double x = 0.0, y = 0.0;
+    if ( obj[key].get_object().get( point ) != simdjson::SUCCESS
+         || ! get_number( point, "x", &x )
+         || ! get_number( point, "y", &y ) )
+    {
+        return false;
+    }
+
+    result->assign( FormationData::round_xy( x ),
+                    FormationData::round_xy( y ) );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+std::string
+get_version( simdjson::ondemand::object & doc )
+{
+    std::string_view v;
+    if ( ! get_string( doc, "version", &v ) )
     {
         std::cerr << "(FormationParserJSON::get_version) No version" << std::endl;
         return std::string();
     }
 
-    return *v;
+    return std::string( v );
 }
 
 /*-------------------------------------------------------------------*/
 std::string
-get_method_name( const ptree & doc )
+get_method_name( simdjson::ondemand::object & doc )
 {
-    boost::optional< std::string > v = doc.get_optional< std::string >( "method" );
-
-    if ( ! v )
+    std::string_view v;
+    if ( ! get_string( doc, "method", &v ) )
     {
         std::cerr << "(FormationParserJSON::get_method_name) No method name" << std::endl;
         return std::string();
     }
 
-    return *v;
+    return std::string( v );
 }
 
 /*-------------------------------------------------------------------*/
 bool
-parse_role( const ptree & doc,
+parse_role( simdjson::ondemand::object & doc,
             Formation::Ptr result )
 {
     if ( ! result ) return false;
 
-    boost::optional< const ptree & > role_array = doc.get_child_optional( "role" );
-    if ( ! role_array )
+    simdjson::ondemand::array role_array;
+    if ( doc["role"].get_array().get( role_array ) != simdjson::SUCCESS )
     {
         std::cerr << "(FormationParserJSON..parse_role) No role array" << std::endl;
         return false;
     }
 
-    for ( const ptree::value_type & child : *role_array )
+    for ( simdjson::ondemand::value child : role_array )
     {
-        const ptree & role = child.second;
-
-        boost::optional< int > number = role.get_optional< int >( "number" );
-        boost::optional< std::string > name = role.get_optional< std::string >( "name" );
-        boost::optional< std::string > type = role.get_optional< std::string >( "type" );
-        boost::optional< std::string > side = role.get_optional< std::string >( "side" );
-        boost::optional< int > pair = role.get_optional< int >( "pair" );
-
-        if ( ! number
-             || *number < 1 || 11 < *number
-             || ! name
-             || ! type
-             || ! side
-             || ! pair
-             || *pair < -1 || 11 < *pair )
+        simdjson::ondemand::object role;
+        int number = 0;
+        std::string_view name_view;
+        std::string_view type;
+        std::string_view side;
+        int pair = 0;
+
+        if ( child.get_object().get( role ) != simdjson::SUCCESS
+             || ! get_number( role, "number", &number )
+             || number < 1 || 11 < number
+             || ! get_string( role, "name", &name_view )
+             || ! get_string( role, "type", &type )
+             || ! get_string( role, "side", &side )
+             || ! get_number( role, "pair", &pair )
+             || pair < -1 || 11 < pair )
         {
             std::cerr << "(FormationParserJSON..parse_role) Illegal role data" << std::endl;
             return false;
         }
 
-        if ( ! result->setRoleName( *number, *name ) )
+        const std::string name( name_view );
+        if ( ! result->setRoleName( number, name ) )
         {
-            std::cerr << "(FormationParserJSON..parse_role) Could not set the role name. number=" << *number << " name=" << *name << std::endl;
+            std::cerr << "(FormationParserJSON..parse_role) Could not set the role name. number=" << number << " name=" << name << std::endl;
             return false;
         }
 
-        const RoleType role_type( RoleType::to_type( *type ),
-                                  RoleType::to_side( *side ) );
+        const RoleType role_type( RoleType::to_type( std::string( type ) ),
+                                  RoleType::to_side( std::string( side ) ) );
         if ( ( role_type.type() == RoleType::Unknown
                && result->methodName() != FormationStatic::NAME )
-             || ! result->setRoleType( *number, role_type ) )
+             || ! result->setRoleType( number, role_type ) )
         {
-            std::cerr << "(FormationParserJSON..parse_role) Could not set the role type. number=" << *number << *name << std::endl;
+            std::cerr << "(FormationParserJSON..parse_role) Could not set the role type. number=" << number << name << std::endl;
             return false;
         }
 
-        if ( ! result->setPositionPair( *number, *pair ) )
+        if ( ! result->setPositionPair( number, pair ) )
         {
             return false;
         }
@@ -139,41 +291,36 @@ parse_role( const ptree & doc,
 
 /*-------------------------------------------------------------------*/
 bool
-parse_data( const ptree & doc,
+parse_data( simdjson::ondemand::object & doc,
             Formation::Ptr result )
 {
     if ( ! result ) return false;
 
-    boost::optional< const ptree & > data_array = doc.get_child_optional( "data" );
-    if ( ! data_array )
+    simdjson::ondemand::array data_array;
+    if ( doc["data"].get_array().get( data_array ) != simdjson::SUCCESS )
     {
         std::cerr << "(FormationParserJSON..parse_data) No data array" << std::endl;
         return false;
     }
 
     FormationData formation_data;
+    FormationData::Data data;
 
-    for ( const ptree::value_type & child : *data_array )
+    for ( simdjson::ondemand::value child : data_array )
     {
-        const ptree & elem = child.second;
-
-        FormationData::Data data;
+        simdjson::ondemand::object elem;
+        data.players_.resize( 11 );
 
-        try
+        bool success = ( child.get_object().get( elem ) == simdjson::SUCCESS
+                         && get_point( elem, "ball", &data.ball_ ) );
+        for ( int i = 0; success && i < 11; ++i )
         {
-            data.ball_.assign( FormationData::round_xy( elem.get< double >( "ball.x" ) ),
-                               FormationData::round_xy( elem.get< double >( "ball.y" ) ) );
-
-            for ( int i = 0; i < 11; ++i )
-            {
-                const std::string unum = std::to_string( i + 1 );
-                data.players_.emplace_back( FormationData::round_xy( elem.get< double >( unum + ".x" ) ),
-                                            FormationData::round_xy( elem.get< double >( unum + ".y" ) ) );
-            }
+            success = get_point( elem, PLAYER_KEYS[i], &data.players_[i] );
         }
-        catch ( std::exception & e )
+
+        if ( ! success )
         {
-            std::cerr << "(FormationParserJSON..parse_data) " << e.what() << std::endl;
+            std::cerr << "(FormationParserJSON..parse_data) Illegal data element" << std::endl;
             return false;
         }
 
@@ -194,18 +341,24 @@ parse_data( const ptree & doc,
 Formation::Ptr
 FormationParserJSON::parseImpl( std::istream & is )
 {
-    ptree doc;
-    try
+    JSONBuffer & buffer = json_buffer();
+    const size_t size = read_all( is, buffer.data_ );
+
+    simdjson::ondemand::document doc;
+    simdjson::ondemand::object root;
+    simdjson::error_code err = buffer.parser_.iterate( buffer.data_.data(), size, buffer.data_.size() ).get( doc );
+    if ( err == simdjson::SUCCESS )
     {
-        boost::property_tree::read_json( is, doc );
+        err = doc.get_object().get( root );
     }
-    catch ( std::exception & e )
+
+    if ( err != simdjson::SUCCESS )
     {
-        std::cerr << "(FormationParserJSON::parse) ERROR: read_json. " << e.what() << std::endl;
+        std::cerr << "(FormationParserJSON::parse) ERROR: read_json. " << simdjson::error_message( err ) << std::endl;
         return Formation::Ptr();
     }
 
-    const std::string method = get_method_name( doc );
+    const std::string method = get_method_name( root );
 
     Formation::Ptr ptr = Formation::create( method );
     if ( ! ptr )
@@ -214,10 +367,10 @@ FormationParserJSON::parseImpl( std::istream & is )
         return Formation::Ptr();
     }
 
-    ptr->setVersion( get_version( doc ) );
+    ptr->setVersion( get_version( root ) );
 
-    if ( ! parse_role( doc, ptr ) ) return Formation::Ptr();
-    if ( ! parse_data( doc, ptr ) ) return Formation::Ptr();
+    if ( ! parse_role( root, ptr ) ) return Formation::Ptr();
+    if ( ! parse_data( root, ptr ) ) return Formation::Ptr();
 
     return ptr;
 }
@@ -40,6 +40,8 @@
 
 namespace rcsc {
 
+struct PlayModeInfo;
+
 /*!
   \class GameMode
   \brief playmode(referee info) wrapper class
@@ -217,6 +219,17 @@ public:
     bool update( const std::string & mode_str,
                  const GameTime & current );
 
+    /*!
+      \brief update internal status by the decoded referee message.
+      if mode is goal_?_?, score is also updated.
+      \param info decoded referee message (see PlayModeDecoder)
+      \param current current game time
+      \retval true successfully updated.
+      \retval false the message is not a playmode
+    */
+    bool update( const PlayModeInfo & info,
+                 const GameTime & current );
+
     /*!
       \brief set scores directly.
       \param score_l left team score
@@ -225,14 +238,6 @@ public:
     void setScore( const int score_l,
                    const int score_r );
 
-private:
-    /*!
-      \brief analyze playmode string. if mode is goal_?_?, score is updated
-      \param mode_str playmode string
-      \return the pair of playmode type and playmode side
-    */
-    Pair parse( const std::string & mode_str );
-
 public:
 
     /*!
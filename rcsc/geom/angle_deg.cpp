@@ -36,6 +36,7 @@
 #include "angle_deg.h"
 
 #include <algorithm>
+#include <cfloat>
 #include <vector>
 
 #ifndef M_PI
@@ -169,6 +170,103 @@ AngleDeg::cosMinMax( const double angle_err,
 }
 
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+AngleDeg::sin_cos_deg( const double * deg,
+                       const std::size_t n,
+                       double * sin_out,
+                       double * cos_out )
+{
+    //
+    // deg = 90 * quadrant + r, |r| <= 45.
+    // sin(r) and cos(r) are the Taylor series. the error of the last term is less than 1.0e-14.
+    // the quadrant selects and negates the values by the multiplication with 0/1 and +-1.
+    //
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        const double d = deg[i];
+        const double x = d * ( 1.0 / 90.0 );
+        const int quadrant = static_cast< int >( x + ( 0.5 - double( x < 0.0 ) ) );
+        const double r = ( d - 90.0 * quadrant ) * DEG2RAD;
+        const double z = r * r;
+
+        const double s = r * ( 1.0
+                               + z * ( -1.0 / 6.0
+                                       + z * ( 1.0 / 120.0
+                                               + z * ( -1.0 / 5040.0
+                                                       + z * ( 1.0 / 362880.0
+                                                               + z * ( -1.0 / 39916800.0
+                                                                       + z * ( 1.0 / 6227020800.0 ) ) ) ) ) ) );
+        const double c = ( 1.0
+                           + z * ( -1.0 / 2.0
+                                   + z * ( 1.0 / 24.0
+                                           + z * ( -1.0 / 720.0
+                                                   + z * ( 1.0 / 40320.0
+                                                           + z * ( -1.0 / 3628800.0
+                                                                   + z * ( 1.0 / 479001600.0
+                                                                           + z * ( -1.0 / 87178291200.0 ) ) ) ) ) ) ) );
+
+        const double swap = double( quadrant & 1 );
+        const double sin_sign = 1.0 - 2.0 * double( ( quadrant >> 1 ) & 1 );
+        const double cos_sign = 1.0 - 2.0 * double( ( ( quadrant + 1 ) >> 1 ) & 1 );
+
+        sin_out[i] = sin_sign * ( ( 1.0 - swap ) * s + swap * c );
+        cos_out[i] = cos_sign * ( ( 1.0 - swap ) * c + swap * s );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+AngleDeg::atan2_deg( const double * y,
+                     const double * x,
+                     const std::size_t n,
+                     double * deg_out )
+{
+    //
+    // atan(t), 0 <= t <= 1, is the rational approximation of Cephes (atan.c).
+    // t > 0.66 is reduced by atan(t) = pi/4 + atan((t-1)/(t+1)).
+    // the octant is restored by std::copysign instead of the comparison,
+    // because the comparison results are converted to the branches by the compiler.
+    //
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        const double ax = std::fabs( x[i] );
+        const double ay = std::fabs( y[i] );
+        const double max_v = std::max( ax, ay );
+        const double min_v = std::min( ax, ay );
+        const double denom = std::max( max_v, DBL_MIN );
+        const double t = min_v / denom;
+
+        const double reduced = 0.5 + 0.5 * std::copysign( 1.0, t - 0.66 ); // 1 if reduced
+        const double u = ( t - reduced ) / ( 1.0 + reduced * t );
+        const double z = u * u;
+        const double p = ( ( ( ( -8.750608600031904122785e-1 * z
+                                 - 1.615753718733365076637e+1 ) * z
+                               - 7.500855792314704667340e+1 ) * z
+                             - 1.228866684490136173410e+2 ) * z
+                           - 6.485021904942025371773e+1 );
+        const double q = ( ( ( ( ( z
+                                   + 2.485846490142306297962e+1 ) * z
+                                 + 1.650270098316988542046e+2 ) * z
+                               + 4.328810604912902668951e+2 ) * z
+                             + 4.853903996359136964868e+2 ) * z
+                           + 1.945506571482613964425e+2 );
+
+        double a = reduced * ( PI * 0.25 ) + u + u * z * p / q;
+        a = PI * 0.25 - std::copysign( 1.0, ax - ay ) * ( PI * 0.25 - a ); // atan2(|y|,|x|)
+        a = PI * 0.5 - std::copysign( 1.0, x[i] ) * ( PI * 0.5 - a ); // atan2(|y|,x)
+
+        // ( max_v / denom ) is 0 only if x == y == 0.
+        deg_out[i] = std::copysign( a, y[i] ) * RAD2DEG * ( max_v / denom );
+    }
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
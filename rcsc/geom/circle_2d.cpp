@@ -38,6 +38,7 @@
 #include "segment_2d.h"
 #include "ray_2d.h"
 #include "line_2d.h"
+#include "vector_2d_array.h"
 
 #include <iostream>
 #include <cmath>
@@ -358,4 +359,15 @@ Circle2D::contains( const Vector2D & point,
     return center.dist2( point ) < center.dist2( p0 ) - EPSILON*EPSILON;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::size_t
+Circle2D::containsMany( const Vector2DArray & points,
+                        std::vector< char > * result ) const
+{
+    return points.contains( *this, result );
+}
+
 }
@@ -128,6 +128,16 @@ public:
           return M_center.dist2( point ) < M_radius * M_radius;
       }
 
+    /*!
+      \brief check if this circle contains each point.
+      \param points considered points
+      \param result pointer to the result variable. may be NULL. 1 if contained, otherwise 0.
+      \return the number of contained points
+    */
+    virtual
+    std::size_t containsMany( const Vector2DArray & points,
+                              std::vector< char > * result ) const;
+
     /*!
       \brief get the center point
       \return center point coordinate value
@@ -36,6 +36,9 @@
 #include "composite_region_2d.h"
 
 #include "vector_2d.h"
+#include "vector_2d_array.h"
+
+#include <algorithm>
 
 namespace rcsc {
 
@@ -67,6 +70,37 @@ UnitedRegion2D::contains( const Vector2D & point ) const
     return false;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::size_t
+UnitedRegion2D::containsMany( const Vector2DArray & points,
+                              std::vector< char > * result ) const
+{
+    const std::size_t n = points.size();
+
+    std::vector< char > flags( n, 0 );
+    std::vector< char > child;
+
+    for ( const std::shared_ptr< const Region2D > & r : M_regions )
+    {
+        r->containsMany( points, &child );
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            flags[i] |= child[i];
+        }
+    }
+
+    const std::size_t count = std::count( flags.begin(), flags.end(), 1 );
+    if ( result )
+    {
+        result->swap( flags );
+    }
+
+    return count;
+}
+
 
 /*-------------------------------------------------------------------*/
 /*!
@@ -96,4 +130,35 @@ IntersectedRegion2D::contains( const Vector2D & point ) const
     return true;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::size_t
+IntersectedRegion2D::containsMany( const Vector2DArray & points,
+                                   std::vector< char > * result ) const
+{
+    const std::size_t n = points.size();
+
+    std::vector< char > flags( n, 1 );
+    std::vector< char > child;
+
+    for ( const std::shared_ptr< const Region2D > & r : M_regions )
+    {
+        r->containsMany( points, &child );
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            flags[i] &= child[i];
+        }
+    }
+
+    const std::size_t count = std::count( flags.begin(), flags.end(), 1 );
+    if ( result )
+    {
+        result->swap( flags );
+    }
+
+    return count;
+}
+
 }
@@ -228,6 +228,18 @@ public:
     */
     virtual
     bool contains( const Vector2D & point ) const;
+
+    /*!
+      \brief check if this union region contains each point.
+      \param points considered points
+      \param result pointer to the result variable. may be NULL. 1 if contained, otherwise 0.
+      \return the number of contained points
+
+      All child regions are evaluated in bulk.
+    */
+    virtual
+    std::size_t containsMany( const Vector2DArray & points,
+                              std::vector< char > * result ) const;
 };
 
 
@@ -416,6 +428,18 @@ public:
     virtual
     bool contains( const Vector2D & point ) const;
 
+    /*!
+      \brief check if this intersected region contains each point.
+      \param points considered points
+      \param result pointer to the result variable. may be NULL. 1 if contained, otherwise 0.
+      \return the number of contained points
+
+      All child regions are evaluated in bulk.
+    */
+    virtual
+    std::size_t containsMany( const Vector2DArray & points,
+                              std::vector< char > * result ) const;
+
 };
 
 }
@@ -36,10 +36,14 @@
 #include "delaunay_triangulation.h"
 
 #include <rcsc/geom/triangle_2d.h>
+#include <rcsc/util/memory_accounting.h>
+
+#include <unordered_set>
 
 namespace rcsc {
 
 const double DelaunayTriangulation::EPSILON = 1.0e-10;
+constexpr std::size_t DelaunayTriangulation::POOL_CHUNK_SIZE;
 
 namespace {
 
@@ -49,6 +53,78 @@ edge_pairs[3] = { std::pair< std::size_t, std::size_t >( 0, 1 ),
                   std::pair< std::size_t, std::size_t >( 2, 0 ),
 };
 
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get twice the signed area of the triangle (a, b, c)
+  \return positive value if (a, b, c) is counter clockwise
+ */
+inline
+double
+signed_area2( const Vector2D & a,
+              const Vector2D & b,
+              const Vector2D & c )
+{
+    return ( b - a ).outerProduct( c - a );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief check how the point is contained by the triangle
+ */
+DelaunayTriangulation::ContainedType
+contained_type( const DelaunayTriangulation::Triangle & tri,
+                const Vector2D & pos )
+{
+    Vector2D rel0( tri.vertex( 0 )->pos() - pos );
+    Vector2D rel1( tri.vertex( 1 )->pos() - pos );
+    Vector2D rel2( tri.vertex( 2 )->pos() - pos );
+
+    double outer0 = rel0.outerProduct( rel1 );
+    double outer1 = rel1.outerProduct( rel2 );
+    double outer2 = rel2.outerProduct( rel0 );
+
+    if ( std::fabs( outer0 ) <= DelaunayTriangulation::EPSILON )
+    {
+        if ( rel0.x * rel1.x > DelaunayTriangulation::EPSILON
+             || rel0.y * rel1.y > DelaunayTriangulation::EPSILON )
+        {
+            // not online
+            return DelaunayTriangulation::NOT_CONTAINED;
+        }
+        return DelaunayTriangulation::ONLINE;
+    }
+
+    if ( std::fabs( outer1 ) <= DelaunayTriangulation::EPSILON )
+    {
+        if ( rel1.x * rel2.x > DelaunayTriangulation::EPSILON
+             || rel1.y * rel2.y > DelaunayTriangulation::EPSILON )
+        {
+            // not online
+            return DelaunayTriangulation::NOT_CONTAINED;
+        }
+        return DelaunayTriangulation::ONLINE;
+    }
+
+    if ( std::fabs( outer2 ) <= DelaunayTriangulation::EPSILON )
+    {
+        if ( rel2.x * rel0.x > DelaunayTriangulation::EPSILON
+             || rel2.y * rel0.y > DelaunayTriangulation::EPSILON )
+        {
+            // not online
+            return DelaunayTriangulation::NOT_CONTAINED;
+        }
+        return DelaunayTriangulation::ONLINE;
+    }
+
+    if ( ( outer0 >= 0.0 && outer1 >= 0.0 && outer2 >= 0.0 )
+         || ( outer0 <= 0.0 && outer1 <= 0.0 && outer2 <= 0.0 ) )
+    {
+        return DelaunayTriangulation::CONTAINED;
+    }
+
+    return DelaunayTriangulation::NOT_CONTAINED;
+}
+
 }
 
 //#define DEBUG
@@ -58,13 +134,15 @@ edge_pairs[3] = { std::pair< std::size_t, std::size_t >( 0, 1 ),
 /*!
 
 */
-DelaunayTriangulation::Triangle::Triangle( const int id,
-                                           EdgePtr e0,
-                                           EdgePtr e1,
-                                           EdgePtr e2 )
-    : M_id( id ),
-      M_voronoi_vertex( Vector2D::INVALIDATED )
+void
+DelaunayTriangulation::Triangle::assign( const int id,
+                                         EdgePtr e0,
+                                         EdgePtr e1,
+                                         EdgePtr e2 )
 {
+    M_id = id;
+    M_voronoi_vertex = Vector2D::INVALIDATED;
+
     //std::cout << "Triangle() start id = " << id << std::endl;
 
     //std::cout << "Triangle() edge0 "
@@ -177,6 +255,25 @@ DelaunayTriangulation::clear()
 {
     clearResults();
     M_vertices.clear();
+    M_vertex_index.clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::size_t
+DelaunayTriangulation::memoryUsage() const
+{
+    return vector_memory_usage( M_vertices )
+        + vector_memory_usage( M_edges )
+        + vector_memory_usage( M_triangles )
+        + vector_memory_usage( M_edge_pool )
+        + M_edge_pool.size() * POOL_CHUNK_SIZE * sizeof( Edge )
+        + vector_memory_usage( M_free_edges )
+        + vector_memory_usage( M_triangle_pool )
+        + M_triangle_pool.size() * POOL_CHUNK_SIZE * sizeof( Triangle )
+        + vector_memory_usage( M_free_triangles );
 }
 
 /*-------------------------------------------------------------------*/
@@ -187,23 +284,95 @@ void
 DelaunayTriangulation::clearResults()
 {
     M_edge_count = M_tri_count = 0;
+    M_last_triangle = nullptr;
 
-    for ( TriangleCont::iterator it = M_triangles.begin();
-          it != M_triangles.end();
-          ++it )
+    M_triangles.clear();
+    M_edges.clear();
+
+    // push the instances in reverse order to pop them in the allocated order.
+    M_free_triangles.clear();
+    for ( std::vector< std::unique_ptr< Triangle[] > >::reverse_iterator p = M_triangle_pool.rbegin();
+          p != M_triangle_pool.rend();
+          ++p )
     {
-        delete it->second;
+        for ( std::size_t i = POOL_CHUNK_SIZE; i > 0; --i )
+        {
+            (*p)[i - 1].M_index = -1;
+            M_free_triangles.push_back( &(*p)[i - 1] );
+        }
     }
 
-    for ( EdgeCont::iterator it = M_edges.begin();
-          it != M_edges.end();
-          ++it )
+    M_free_edges.clear();
+    for ( std::vector< std::unique_ptr< Edge[] > >::reverse_iterator p = M_edge_pool.rbegin();
+          p != M_edge_pool.rend();
+          ++p )
     {
-        delete it->second;
+        for ( std::size_t i = POOL_CHUNK_SIZE; i > 0; --i )
+        {
+            (*p)[i - 1].M_index = -1;
+            M_free_edges.push_back( &(*p)[i - 1] );
+        }
     }
+}
 
-    M_triangles.clear();
-    M_edges.clear();
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+DelaunayTriangulation::EdgePtr
+DelaunayTriangulation::createEdge( const Vertex * v0,
+                                   const Vertex * v1 )
+{
+    if ( M_free_edges.empty() )
+    {
+        M_edge_pool.emplace_back( new Edge[POOL_CHUNK_SIZE] );
+        Edge * chunk = M_edge_pool.back().get();
+        for ( std::size_t i = POOL_CHUNK_SIZE; i > 0; --i )
+        {
+            M_free_edges.push_back( chunk + i - 1 );
+        }
+    }
+
+    EdgePtr e = M_free_edges.back();
+    M_free_edges.pop_back();
+
+    e->assign( M_edge_count, v0, v1 );
+    e->M_index = static_cast< int >( M_edges.size() );
+    M_edges.emplace_back( M_edge_count, e );
+    ++M_edge_count;
+
+    return e;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+DelaunayTriangulation::TrianglePtr
+DelaunayTriangulation::createTriangle( Edge * e0,
+                                       Edge * e1,
+                                       Edge * e2 )
+{
+    if ( M_free_triangles.empty() )
+    {
+        M_triangle_pool.emplace_back( new Triangle[POOL_CHUNK_SIZE] );
+        Triangle * chunk = M_triangle_pool.back().get();
+        for ( std::size_t i = POOL_CHUNK_SIZE; i > 0; --i )
+        {
+            M_free_triangles.push_back( chunk + i - 1 );
+        }
+    }
+
+    TrianglePtr t = M_free_triangles.back();
+    M_free_triangles.pop_back();
+
+    t->assign( M_tri_count, e0, e1, e2 );
+    t->M_index = static_cast< int >( M_triangles.size() );
+    M_triangles.emplace_back( M_tri_count, t );
+    ++M_tri_count;
+
+    M_last_triangle = t;
+    return t;
 }
 
 /*-------------------------------------------------------------------*/
@@ -225,8 +394,23 @@ DelaunayTriangulation::addVertex( const double x,
         }
     }
 
+    // edges and triangles must follow the reallocation of the vertices.
+    std::vector< int > ids;
+    const bool relocated = ( M_vertices.size() == M_vertices.capacity()
+                             && ! M_edges.empty() );
+    if ( relocated )
+    {
+        getVertexIds( &ids );
+    }
+
     int id = M_vertices.size();
     M_vertices.emplace_back( id, x, y );
+    M_vertex_index.clear();
+
+    if ( relocated )
+    {
+        setVertexIds( ids );
+    }
     return id;
 }
 
@@ -237,7 +421,21 @@ DelaunayTriangulation::addVertex( const double x,
 void
 DelaunayTriangulation::addVertices( const std::vector< Vector2D > & v )
 {
+    std::vector< int > ids;
+    const bool relocated = ( M_vertices.size() + v.size() > M_vertices.capacity()
+                             && ! M_edges.empty() );
+    if ( relocated )
+    {
+        getVertexIds( &ids );
+    }
+
     M_vertices.reserve( M_vertices.size() + v.size() );
+    M_vertex_index.clear();
+
+    if ( relocated )
+    {
+        setVertexIds( ids );
+    }
 
     int id = M_vertices.size();
 
@@ -371,7 +569,7 @@ DelaunayTriangulation::removeInitialVertices()
         removeTriangle( (*it)->triangle( 0 ) );
         removeTriangle( (*it)->triangle( 1 ) );
 
-        removeEdge( (*it)->id() );
+        removeEdge( *it );
     }
 }
 
@@ -401,7 +599,7 @@ DelaunayTriangulation::Triangle *
 DelaunayTriangulation::findTriangleContains( const Vector2D & pos ) const
 {
     Triangle * tri = nullptr;
-    findTriangleContains( pos, &tri );
+    locateTriangle( pos, &tri );
     return tri;
 }
 
@@ -413,6 +611,17 @@ const
 DelaunayTriangulation::Vertex *
 DelaunayTriangulation::findNearestVertex( const Vector2D & pos ) const
 {
+    if ( ! M_vertex_index.empty()
+         && M_vertex_index.size() == M_vertices.size() )
+    {
+        int id = -1;
+        if ( M_vertex_index.nearest( pos, []( const int ) { return true; }, &id ) )
+        {
+            return &M_vertices[id];
+        }
+        return nullptr;
+    }
+
     const Vertex * candidate = nullptr;
 
     double min_dist2 = 10000000.0;
@@ -439,6 +648,13 @@ void
 DelaunayTriangulation::compute()
 {
     //std::cout << "compute() start " << std::endl;
+    M_vertex_index.clear();
+    for ( const Vertex & v : M_vertices )
+    {
+        M_vertex_index.insert( v.pos(), v.id() );
+    }
+    M_vertex_index.build();
+
     if ( M_vertices.size() < 3 )
     {
         //std::cout << __FILE__ << ": compute() too few vertices" << std::endl;
@@ -467,7 +683,7 @@ DelaunayTriangulation::compute()
         //          << vit->pos() << std::endl;
         // find triangle that contains 'vertex'
         TrianglePtr tri = nullptr;
-        ContainedType type = findTriangleContains( vit->pos(), &tri );
+        ContainedType type = locateTriangle( vit->pos(), &tri );
 
         ////////////////////////////////////////////////////
         if ( ! tri
@@ -553,6 +769,631 @@ DelaunayTriangulation::compute()
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+int
+DelaunayTriangulation::insertVertex( const Vector2D & p )
+{
+    const bool computed = isComputed();
+
+    const int id = addVertex( p );
+    if ( id < 0 )
+    {
+        return -1;
+    }
+
+    if ( ! computed )
+    {
+        recompute();
+    }
+    else if ( ! linkVertex( &M_vertices[id] ) )
+    {
+        std::cerr << __FILE__ << ':' << __LINE__
+                  << " insertVertex() failed to update the triangulation locally. "
+                  << p << std::endl;
+        recompute();
+    }
+
+    return id;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+DelaunayTriangulation::removeVertex( const int id )
+{
+    if ( id < 0
+         || static_cast< int >( M_vertices.size() ) <= id )
+    {
+        return false;
+    }
+
+    M_vertex_index.clear();
+
+    const bool computed = isComputed();
+
+    if ( computed
+         && ! unlinkVertex( &M_vertices[id] ) )
+    {
+        std::cerr << __FILE__ << ':' << __LINE__
+                  << " removeVertex() failed to update the triangulation locally. "
+                  << M_vertices[id].pos() << std::endl;
+        clearResults();
+    }
+
+    //
+    // remove the vertex and renumber the following vertices
+    //
+    std::vector< int > ids;
+    getVertexIds( &ids );
+    for ( int & i : ids )
+    {
+        if ( i > id ) --i;
+    }
+
+    M_vertices.erase( M_vertices.begin() + id );
+    for ( int i = id, size = M_vertices.size(); i < size; ++i )
+    {
+        M_vertices[i].assign( i, M_vertices[i].pos() );
+    }
+
+    setVertexIds( ids );
+
+    if ( computed
+         && M_triangles.empty() )
+    {
+        recompute();
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+DelaunayTriangulation::moveVertex( const int id,
+                                   const Vector2D & p )
+{
+    if ( id < 0
+         || static_cast< int >( M_vertices.size() ) <= id )
+    {
+        return false;
+    }
+
+    for ( const Vertex & v : M_vertices )
+    {
+        if ( v.id() != id
+             && v.pos().dist2( p ) < 1.0e-6 )
+        {
+            // detect same coordinate vertex
+            return false;
+        }
+    }
+
+    M_vertex_index.clear();
+
+    Vertex * vertex = &M_vertices[id];
+
+    if ( ! isComputed() )
+    {
+        vertex->assign( id, p );
+        return true;
+    }
+
+    const bool unlinked = unlinkVertex( vertex );
+
+    vertex->assign( id, p );
+
+    if ( ! unlinked
+         || M_triangles.empty()
+         || ! linkVertex( vertex ) )
+    {
+        std::cerr << __FILE__ << ':' << __LINE__
+                  << " moveVertex() failed to update the triangulation locally. "
+                  << p << std::endl;
+        recompute();
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+DelaunayTriangulation::isComputed() const
+{
+    if ( M_triangles.empty() )
+    {
+        return false;
+    }
+
+    if ( M_triangles.size() > 3 )
+    {
+        return true;
+    }
+
+    for ( const TriangleCont::value_type & t : M_triangles )
+    {
+        for ( std::size_t i = 0; i < 3; ++i )
+        {
+            if ( t.second->vertex( i )->id() < 0 )
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+DelaunayTriangulation::getVertexIds( std::vector< int > * ids ) const
+{
+    ids->clear();
+    ids->reserve( M_edges.size() * 2 + M_triangles.size() * 3 );
+
+    for ( const EdgeCont::value_type & e : M_edges )
+    {
+        ids->push_back( e.second->vertex( 0 )->id() );
+        ids->push_back( e.second->vertex( 1 )->id() );
+    }
+
+    for ( const TriangleCont::value_type & t : M_triangles )
+    {
+        for ( std::size_t i = 0; i < 3; ++i )
+        {
+            ids->push_back( t.second->vertex( i )->id() );
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+DelaunayTriangulation::setVertexIds( const std::vector< int > & ids )
+{
+    std::vector< int >::const_iterator id = ids.begin();
+    const auto vertex = [this]( const int i ) -> const Vertex *
+                          {
+                              return ( i < 0
+                                       ? &M_initial_vertex[-i - 1]
+                                       : &M_vertices[i] );
+                          };
+
+    for ( EdgeCont::value_type & e : M_edges )
+    {
+        e.second->M_vertices[0] = vertex( *id++ );
+        e.second->M_vertices[1] = vertex( *id++ );
+    }
+
+    for ( TriangleCont::value_type & t : M_triangles )
+    {
+        for ( std::size_t i = 0; i < 3; ++i )
+        {
+            t.second->M_vertices[i] = vertex( *id++ );
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+DelaunayTriangulation::linkVertex( const Vertex * vertex )
+{
+    TrianglePtr tri = nullptr;
+    const ContainedType type = locateTriangle( vertex->pos(), &tri );
+
+    bool result = false;
+    if ( type == CONTAINED )
+    {
+        result = updateContainedVertex( vertex, tri );
+    }
+    else if ( type == ONLINE )
+    {
+        result = updateOnlineVertex( vertex, tri );
+    }
+    else
+    {
+        result = updateOutsideVertex( vertex );
+    }
+
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+DelaunayTriangulation::updateOutsideVertex( const Vertex * new_vertex )
+{
+    //
+    // collect the convex hull edges visible from the new vertex
+    //
+    std::vector< EdgePtr > visible_edges;
+    std::unordered_map< const Vertex *, int > endpoint_count;
+
+    for ( const EdgeCont::value_type & v : M_edges )
+    {
+        EdgePtr e = v.second;
+        TrianglePtr tri = ( e->triangle( 0 ) ? e->triangle( 0 ) : e->triangle( 1 ) );
+        if ( ! tri
+             || ( e->triangle( 0 ) && e->triangle( 1 ) ) )
+        {
+            continue;
+        }
+
+        const Vector2D & p0 = e->vertex( 0 )->pos();
+        const Vector2D & p1 = e->vertex( 1 )->pos();
+        const double inner = signed_area2( p0, p1, tri->getVertexExclude( e )->pos() );
+        const double outer = signed_area2( p0, p1, new_vertex->pos() );
+
+        if ( inner * outer < 0.0
+             && std::fabs( outer ) > EPSILON )
+        {
+            visible_edges.push_back( e );
+            ++endpoint_count[e->vertex( 0 )];
+            ++endpoint_count[e->vertex( 1 )];
+        }
+    }
+
+    if ( visible_edges.empty() )
+    {
+        return false;
+    }
+
+    // the visible edges must be a chain.
+    int end_count = 0;
+    for ( const std::unordered_map< const Vertex *, int >::value_type & v : endpoint_count )
+    {
+        if ( v.second == 1 ) ++end_count;
+        else if ( v.second != 2 ) return false;
+    }
+
+    if ( end_count != 2 )
+    {
+        return false;
+    }
+
+    //
+    // connect the new vertex to the visible edges
+    //
+    std::unordered_map< const Vertex *, EdgePtr > new_edges;
+    for ( const std::unordered_map< const Vertex *, int >::value_type & v : endpoint_count )
+    {
+        // *** the hull vertex must be the second argument
+        new_edges[v.first] = createEdge( new_vertex, v.first );
+    }
+
+    std::vector< TrianglePtr > new_triangles;
+    for ( EdgePtr e : visible_edges )
+    {
+        TrianglePtr tri = createTriangle( e,
+                                          new_edges[e->vertex( 0 )],
+                                          new_edges[e->vertex( 1 )] );
+        if ( ! tri->circumcenter().isValid() )
+        {
+            std::cerr << __FILE__ << ':' << __LINE__
+                      << " updateOutsideVertex() detect illegal vertex "
+                      << new_vertex->pos() << std::endl;
+            return false;
+        }
+        new_triangles.push_back( tri );
+    }
+
+    // legalize new triangles
+    for ( std::size_t i = 0; i < visible_edges.size(); ++i )
+    {
+        if ( ! legalizeEdge( new_triangles[i],
+                             new_vertex,
+                             visible_edges[i] ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+DelaunayTriangulation::unlinkVertex( const Vertex * vertex )
+{
+    //
+    // collect the edges and triangles that have the vertex
+    //
+    std::vector< EdgePtr > removed_edges;
+    std::vector< TrianglePtr > removed_triangles;
+    bool closed = true;
+
+    for ( const EdgeCont::value_type & v : M_edges )
+    {
+        EdgePtr e = v.second;
+        if ( ! e->hasVertex( vertex ) )
+        {
+            continue;
+        }
+
+        removed_edges.push_back( e );
+        for ( std::size_t i = 0; i < 2; ++i )
+        {
+            if ( ! e->triangle( i ) )
+            {
+                closed = false;
+            }
+            else if ( std::find( removed_triangles.begin(), removed_triangles.end(), e->triangle( i ) )
+                      == removed_triangles.end() )
+            {
+                removed_triangles.push_back( e->triangle( i ) );
+            }
+        }
+    }
+
+    if ( removed_triangles.empty() )
+    {
+        for ( EdgePtr e : removed_edges )
+        {
+            removeEdge( e );
+        }
+        return true;
+    }
+
+    //
+    // create the polygon around the vertex in counter clockwise order
+    //
+    std::unordered_map< const Vertex *, std::pair< const Vertex *, EdgePtr > > next_vertex;
+    std::unordered_set< const Vertex * > end_vertices;
+
+    for ( TrianglePtr tri : removed_triangles )
+    {
+        EdgePtr e = tri->getEdgeExclude( vertex );
+        if ( ! e )
+        {
+            return false;
+        }
+
+        const Vertex * v0 = e->vertex( 0 );
+        const Vertex * v1 = e->vertex( 1 );
+        const double area = signed_area2( vertex->pos(), v0->pos(), v1->pos() );
+        if ( std::fabs( area ) <= EPSILON )
+        {
+            return false;
+        }
+        if ( area < 0.0 )
+        {
+            std::swap( v0, v1 );
+        }
+
+        next_vertex[v0] = std::make_pair( v1, e );
+        end_vertices.insert( v1 );
+    }
+
+    const Vertex * first = next_vertex.begin()->first;
+    if ( ! closed )
+    {
+        first = nullptr;
+        for ( const auto & v : next_vertex )
+        {
+            if ( end_vertices.count( v.first ) == 0 )
+            {
+                first = v.first;
+                break;
+            }
+        }
+
+        if ( ! first )
+        {
+            return false;
+        }
+    }
+
+    std::vector< const Vertex * > polygon;
+    std::vector< EdgePtr > polygon_edges;
+    const Vertex * v = first;
+    while ( v
+            && polygon.size() <= removed_triangles.size() )
+    {
+        polygon.push_back( v );
+
+        std::unordered_map< const Vertex *, std::pair< const Vertex *, EdgePtr > >::const_iterator it = next_vertex.find( v );
+        if ( it == next_vertex.end() )
+        {
+            break;
+        }
+
+        polygon_edges.push_back( it->second.second );
+        v = it->second.first;
+        if ( v == first )
+        {
+            break;
+        }
+    }
+
+    if ( polygon_edges.size() != removed_triangles.size()
+         || polygon.size() != removed_triangles.size() + ( closed ? 0 : 1 ) )
+    {
+        return false;
+    }
+
+    //
+    // remove the old triangles and edges
+    //
+    for ( TrianglePtr tri : removed_triangles )
+    {
+        removeTriangle( tri );
+    }
+
+    for ( EdgePtr e : removed_edges )
+    {
+        removeEdge( e );
+    }
+
+    return fillPolygon( polygon, polygon_edges, closed );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+DelaunayTriangulation::fillPolygon( std::vector< const Vertex * > & vertices,
+                                    std::vector< EdgePtr > & edges,
+                                    const bool closed )
+{
+    std::vector< std::pair< EdgePtr, int > > checked_edges;
+    for ( EdgePtr e : edges )
+    {
+        checked_edges.emplace_back( e, e->id() );
+    }
+
+    //
+    // cut the ears one by one.
+    // the ear whose circumcircle contains no other polygon vertex is selected if exists.
+    //
+    while ( vertices.size() >= 3 )
+    {
+        const std::size_t size = vertices.size();
+
+        if ( closed
+             && size == 3 )
+        {
+            TrianglePtr tri = createTriangle( edges[0], edges[1], edges[2] );
+            if ( ! tri->circumcenter().isValid() )
+            {
+                return false;
+            }
+            break;
+        }
+
+        int ear = -1;
+        int empty_ear = -1;
+        for ( std::size_t i = ( closed ? 0 : 1 ), end = ( closed ? size : size - 1 ); i < end; ++i )
+        {
+            const Vertex * v0 = vertices[( i + size - 1 ) % size];
+            const Vertex * v1 = vertices[i];
+            const Vertex * v2 = vertices[( i + 1 ) % size];
+
+            if ( signed_area2( v0->pos(), v1->pos(), v2->pos() ) <= EPSILON )
+            {
+                // not convex
+                continue;
+            }
+
+            const Vector2D center = Triangle2D::circumcenter( v0->pos(), v1->pos(), v2->pos() );
+            const double radius2 = center.dist2( v1->pos() );
+
+            bool contains_vertex = false;
+            bool empty_circle = center.isValid();
+            for ( const Vertex * p : vertices )
+            {
+                if ( p == v0 || p == v1 || p == v2 ) continue;
+
+                if ( Triangle2D::contains( v0->pos(), v1->pos(), v2->pos(), p->pos() ) )
+                {
+                    contains_vertex = true;
+                    break;
+                }
+
+                if ( center.dist2( p->pos() ) < radius2 )
+                {
+                    empty_circle = false;
+                }
+            }
+
+            if ( contains_vertex )
+            {
+                continue;
+            }
+
+            if ( ear < 0 ) ear = i;
+            if ( empty_circle )
+            {
+                empty_ear = i;
+                break;
+            }
+        }
+
+        if ( empty_ear >= 0 )
+        {
+            ear = empty_ear;
+        }
+
+        if ( ear < 0 )
+        {
+            if ( closed )
+            {
+                return false;
+            }
+            // the rest of the open polygon is a part of the convex hull.
+            break;
+        }
+
+        const std::size_t prev = ( ear + size - 1 ) % size;
+        const std::size_t next = ( ear + 1 ) % size;
+
+        EdgePtr new_edge = createEdge( vertices[prev], vertices[next] );
+        TrianglePtr tri = createTriangle( edges[prev], edges[ear], new_edge );
+        if ( ! tri->circumcenter().isValid() )
+        {
+            return false;
+        }
+
+        checked_edges.emplace_back( new_edge, new_edge->id() );
+
+        edges[prev] = new_edge;
+        edges.erase( edges.begin() + ear );
+        vertices.erase( vertices.begin() + ear );
+    }
+
+    //
+    // legalize the edges of the filled region
+    //
+    for ( const std::pair< EdgePtr, int > & checked : checked_edges )
+    {
+        // the edge may be already removed by the legalization.
+        EdgePtr e = checked.first;
+        if ( e->M_index < 0
+             || e->id() != checked.second )
+        {
+            continue;
+        }
+
+        if ( ! e->triangle( 0 )
+             && ! e->triangle( 1 ) )
+        {
+            removeEdge( e );
+            continue;
+        }
+
+        TrianglePtr tri = ( e->triangle( 0 ) ? e->triangle( 0 ) : e->triangle( 1 ) );
+        if ( ! legalizeEdge( tri, tri->getVertexExclude( e ), e ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 DelaunayTriangulation::updateVoronoiVertex()
@@ -1059,82 +1900,97 @@ DelaunayTriangulation::findTriangleContains( const Vector2D & pos,
             continue;
         }
 
-        Vector2D rel0( tri->vertex( 0 )->pos() - pos );
-        Vector2D rel1( tri->vertex( 1 )->pos() - pos );
-        Vector2D rel2( tri->vertex( 2 )->pos() - pos );
-
-        double outer0 = rel0.outerProduct( rel1 );
-        double outer1 = rel1.outerProduct( rel2 );
-        double outer2 = rel2.outerProduct( rel0 );
-
-        //std::cout << "findTriangleContains() found online\n"
-        //          << " tri0 = " << tri->vertex( 0 )->pos()
-        //          << " tri0 = " << tri->vertex( 1 )->pos()
-        //          << " tri0 = " << tri->vertex( 2 )->pos()
-        //          << "\n  outer0 = " << outer0
-        //          << "  outer1 = " << outer1
-        //          << "  outer2 = " << outer2
-        //          << std::endl;
-
-        if ( std::fabs( outer0 ) <= EPSILON )
+        const ContainedType type = contained_type( *tri, pos );
+        if ( type != NOT_CONTAINED )
         {
-            if ( rel0.x * rel1.x > EPSILON
-                 || rel0.y * rel1.y > EPSILON )
-            {
-                // not online
-                continue;
-            }
-            //std::cout << "findTriangleContains() found online on 0-1 " << std::endl;
+#ifdef DEBUG
+            std::cout << __FILE__ << ':' << __LINE__
+                      << " findTriangleContains() found " << ( type == ONLINE ? "online " : "contained " )
+                      << " pos" << pos
+                      << " triangle"
+                      << tri->vertex( 0 )->pos()
+                      << tri->vertex( 1 )->pos()
+                      << tri->vertex( 2 )->pos()
+                      << std::endl;
+#endif
             *sol = tri;
-            return ONLINE;
+            return type;
         }
+    }
+
+    //std::cout << "findTriangleContains() end not found " << std::endl;
+    return NOT_CONTAINED;
+}
 
-        if ( std::fabs( outer1 ) <= EPSILON )
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+DelaunayTriangulation::ContainedType
+DelaunayTriangulation::locateTriangle( const Vector2D & pos,
+                                       TrianglePtr * sol ) const
+{
+    if ( M_triangles.empty() )
+    {
+        return NOT_CONTAINED;
+    }
+
+    // start from the latest created triangle
+    TrianglePtr tri = ( M_last_triangle
+                        ? M_last_triangle
+                        : M_triangles.front().second );
+
+    //
+    // walk to the direction of the target point.
+    // the walk on the Delaunay triangulation never loops.
+    //
+    for ( std::size_t step = 0, max_step = M_triangles.size(); step <= max_step; ++step )
+    {
+        const ContainedType type = contained_type( *tri, pos );
+        if ( type != NOT_CONTAINED )
         {
-            if ( rel1.x * rel2.x > EPSILON
-                 || rel1.y * rel2.y > EPSILON )
-            {
-                // not online
-                continue;
-            }
-            //std::cout << "findTriangleContains() found online on 1-2 " << std::endl;
             *sol = tri;
-            return ONLINE;
+            return type;
         }
 
-        if ( std::fabs( outer2 ) <= EPSILON )
+        // find the edge that separates the target point from this triangle
+        EdgePtr exit_edge = nullptr;
+        double max_area = 0.0;
+        for ( std::size_t i = 0; i < 3; ++i )
         {
-            if ( rel2.x * rel0.x > EPSILON
-                 || rel2.y * rel0.y > EPSILON )
+            EdgePtr e = tri->edge( i );
+            const Vector2D & p0 = e->vertex( 0 )->pos();
+            const Vector2D & p1 = e->vertex( 1 )->pos();
+            const double inner = signed_area2( p0, p1, tri->getVertexExclude( e )->pos() );
+            const double outer = signed_area2( p0, p1, pos );
+
+            if ( inner * outer < 0.0
+                 && std::fabs( outer ) > max_area )
             {
-                // not online
-                continue;
+                exit_edge = e;
+                max_area = std::fabs( outer );
             }
-            //std::cout << "findTriangleContains() found online on 2-0 " << std::endl;
-            *sol = tri;
-            return ONLINE;
         }
 
-        if ( ( outer0 >= 0.0 && outer1 >= 0.0 && outer2 >= 0.0 )
-             || ( outer0 <= 0.0 && outer1 <= 0.0 && outer2 <= 0.0 ) )
+        if ( ! exit_edge
+             || max_area <= EPSILON )
         {
-#ifdef DEBUG
-            std::cout << __FILE__ << ':' << __LINE__
-                      << " findTriangleContains() found contained "
-                      << " pos" << pos
-                      << " triangle"
-                      << tri->vertex( 0 )->pos()
-                      << tri->vertex( 1 )->pos()
-                      << tri->vertex( 2 )->pos()
-                      << std::endl;
-#endif
-            *sol = tri;
-            return CONTAINED;
+            break;
+        }
+
+        TrianglePtr next = ( exit_edge->triangle( 0 ) == tri
+                             ? exit_edge->triangle( 1 )
+                             : exit_edge->triangle( 0 ) );
+        if ( ! next )
+        {
+            // reached the boundary. the point may be out of the triangulation.
+            break;
         }
+
+        tri = next;
     }
 
-    //std::cout << "findTriangleContains() end not found " << std::endl;
-    return NOT_CONTAINED;
+    return findTriangleContains( pos, sol );
 }
 
 }
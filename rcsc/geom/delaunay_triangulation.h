@@ -32,11 +32,12 @@
 #ifndef RCSC_GEOM_DELAUNAY_TRIANGULATION_H
 #define RCSC_GEOM_DELAUNAY_TRIANGULATION_H
 
+#include <rcsc/geom/kd_tree_2d.h>
 #include <rcsc/geom/rect_2d.h>
 #include <rcsc/geom/vector_2d.h>
 
 #include <algorithm>
-#include <unordered_map>
+#include <memory>
 #include <vector>
 #include <array>
 
@@ -183,29 +184,58 @@ public:
      */
     class Edge {
     private:
-        const int M_id; //!< Id number of this edge
+        friend class DelaunayTriangulation;
+
+        int M_id; //!< Id number of this edge
         const Vertex * M_vertices[2]; //!< reference to the vertex of this edge
         TrianglePtr M_triangles[2]; //!< triangles whitch this edge belongs to
-    public:
+        int M_index; //!< index in the edge container. -1 if this instance is not used.
 
         /*!
-          \brief create edge with two vertices. vertices must not be NULL.
+          \brief create an unused instance for the instance pool.
+         */
+        Edge()
+            : M_id( -1 ),
+              M_index( -1 )
+          {
+              std::fill_n( M_vertices, 2, nullptr );
+              std::fill_n( M_triangles, 2, nullptr );
+          }
+
+        /*!
+          \brief set the Id number and vertices.
           \param id Id number of this edge.
           \param v0 raw pointer to the first vertex
           \param v1 raw pointer to the second vertex
          */
-        Edge( const int id,
-              const Vertex * v0,
-              const Vertex * v1 )
-            : M_id( id )
+        void assign( const int id,
+                     const Vertex * v0,
+                     const Vertex * v1 )
           {
               //std::cout << "Edge() id_" << id << " v0 " << v0 << " v1 " << v1
               //          << std::endl;
+              M_id = id;
               M_vertices[0] = v0;
               M_vertices[1] = v1;
               std::fill_n( M_triangles, 2, nullptr );
           }
 
+    public:
+
+        /*!
+          \brief create edge with two vertices. vertices must not be NULL.
+          \param id Id number of this edge.
+          \param v0 raw pointer to the first vertex
+          \param v1 raw pointer to the second vertex
+         */
+        Edge( const int id,
+              const Vertex * v0,
+              const Vertex * v1 )
+            : M_index( -1 )
+          {
+              assign( id, v0, v1 );
+          }
+
         /*!
           \brief nothing to do
          */
@@ -314,6 +344,8 @@ public:
      */
     class Triangle {
     private:
+        friend class DelaunayTriangulation;
+
         int M_id; //!< Id number of this triangle
 
         //! vertices of this triangle, but these are pointers to the vertex instance
@@ -326,34 +358,63 @@ public:
 
         Vector2D M_voronoi_vertex; //!< candidate of the voronoi vertex
 
-        // not used
-        Triangle() = delete;
-    public:
+        int M_index; //!< index in the triangle container. -1 if this instance is not used.
 
         /*!
-          \brief create triangle with index and edges
+          \brief create an unused instance for the instance pool.
+         */
+        Triangle()
+            : M_id( -1 ),
+              M_circumradius( 0.0 ),
+              M_voronoi_vertex( Vector2D::INVALIDATED ),
+              M_index( -1 )
+          {
+              M_vertices.fill( nullptr );
+              M_edges.fill( nullptr );
+          }
+
+        /*!
+          \brief set the Id number and edges, and update the circumcircle.
           \param id Id number of this triangle
           \param e0 raw pointer to the first edge instance
           \param e1 raw pointer to the second edge instance
           \param e2 raw pointer to the third edge instance
-
-          pointers to the vertices are automatically set from edges.
          */
-        Triangle( const int id,
-                  EdgePtr e0,
-                  EdgePtr e1,
-                  EdgePtr e2 );
+        void assign( const int id,
+                     EdgePtr e0,
+                     EdgePtr e1,
+                     EdgePtr e2 );
 
         /*!
           \brief remove this triangle from all edges.
          */
-        ~Triangle()
+        void detach()
           {
               M_edges[0]->removeTriangle( this );
               M_edges[1]->removeTriangle( this );
               M_edges[2]->removeTriangle( this );
           }
 
+    public:
+
+        /*!
+          \brief create triangle with index and edges
+          \param id Id number of this triangle
+          \param e0 raw pointer to the first edge instance
+          \param e1 raw pointer to the second edge instance
+          \param e2 raw pointer to the third edge instance
+
+          pointers to the vertices are automatically set from edges.
+         */
+        Triangle( const int id,
+                  EdgePtr e0,
+                  EdgePtr e1,
+                  EdgePtr e2 )
+            : M_index( -1 )
+          {
+              assign( id, e0, e1, e2 );
+          }
+
         /*!
           \brief update the voronoi vertex point (intersection of perpendicular bisectors)
          */
@@ -526,8 +587,11 @@ public:
     ////////////////////////////////////////////////////////////////
 
     typedef std::vector< Vertex > VertexCont; //!< vertex container type
-    typedef std::unordered_map< int, EdgePtr > EdgeCont; //!< edge pointer container type
-    typedef std::unordered_map< int, TrianglePtr > TriangleCont; //!< triangle pointer container type
+    typedef std::vector< std::pair< int, EdgePtr > > EdgeCont; //!< edge pointer container type. first: id
+    typedef std::vector< std::pair< int, TrianglePtr > > TriangleCont; //!< triangle pointer container type. first: id
+
+    //! the number of edges or triangles allocated at once
+    static constexpr std::size_t POOL_CHUNK_SIZE = 256;
 
 private:
 
@@ -542,15 +606,31 @@ private:
     //! edge reference of inital super triangle
     EdgePtr M_initial_edge[3];
 
+    //! triangle where the next point location starts
+    TrianglePtr M_last_triangle;
+
     //! instance of vertices. these are refered by edge and triangle.
     VertexCont M_vertices;
 
-    //! edge instance holder. key: id
+    //! nearest vertex index built by compute(). the value is the vertex id. emptied when vertices are changed.
+    KDTree2D< int > M_vertex_index;
+
+    //! used edges. the instances are owned by the pool.
     EdgeCont M_edges;
 
-    //! triangle instance holder. key: id
+    //! used triangles. the instances are owned by the pool.
     TriangleCont M_triangles;
 
+    //! edge instance pool. the instances are reused after clear().
+    std::vector< std::unique_ptr< Edge[] > > M_edge_pool;
+    //! unused edge instances in the pool
+    std::vector< EdgePtr > M_free_edges;
+
+    //! triangle instance pool. the instances are reused after clear().
+    std::vector< std::unique_ptr< Triangle[] > > M_triangle_pool;
+    //! unused triangle instances in the pool
+    std::vector< TrianglePtr > M_free_triangles;
+
     // not used
     DelaunayTriangulation & operator=( const DelaunayTriangulation & ) = delete;
 
@@ -559,7 +639,11 @@ public:
     /*!
       \brief nothing to do
     */
-    DelaunayTriangulation() = default;
+    DelaunayTriangulation()
+        : M_edge_count( 0 ),
+          M_tri_count( 0 ),
+          M_last_triangle( nullptr )
+      { }
 
     /*!
       \brief construct with considerable rectangle region
@@ -569,6 +653,9 @@ public:
     */
     explicit
     DelaunayTriangulation( const Rect2D & region )
+        : M_edge_count( 0 ),
+          M_tri_count( 0 ),
+          M_last_triangle( nullptr )
       {
           //std::cout << "create with rect" << std::endl;
           createInitialTriangle( region );
@@ -600,6 +687,13 @@ public:
      */
     void clearResults();
 
+    /*!
+      \brief get the heap bytes held by this triangulation, including the
+      unused instances in the pools.
+      \return bytes
+     */
+    std::size_t memoryUsage() const;
+
     /*!
       \brief get vertices
       \return const reference to the vertices container
@@ -612,7 +706,7 @@ public:
 
     /*!
       \brief get edge set
-      \return const referenct to the map container. key=id, value=raw pointer
+      \return const referenct to the container. first=id, second=raw pointer
      */
     const
     EdgeCont & edges() const
@@ -622,7 +716,7 @@ public:
 
     /*!
       \brief get triangle set
-      \return const referenct to the map container. key=id, value=raw pointer
+      \return const referenct to the container. first=id, second=raw pointer
      */
     const
     TriangleCont & triangles() const
@@ -668,6 +762,31 @@ public:
     */
     void compute();
 
+    /*!
+      \brief add new vertex and update the computed triangulation locally.
+      If the triangulation has not been computed, the whole triangulation is computed.
+      \param p added point
+      \return assigned id value. -1 if the same vertex already exists.
+     */
+    int insertVertex( const Vector2D & p );
+
+    /*!
+      \brief remove the vertex and retriangulate the hole locally.
+      Ids of the following vertices are decremented.
+      \param id Id number of the removed vertex
+      \return false if no vertex has the id.
+     */
+    bool removeVertex( const int id );
+
+    /*!
+      \brief move the vertex to the new point and update the triangulation locally.
+      \param id Id number of the moved vertex
+      \param p new point
+      \return false if no vertex has the id or another vertex already exists at the point.
+     */
+    bool moveVertex( const int id,
+                     const Vector2D & p );
+
     /*!
       \brief calculate voronoi vertex point for each triangle
     */
@@ -675,6 +794,7 @@ public:
 
     /*!
       \brief find triangle that contains pos from the computed triangle set.
+      The search walks from the triangle found or created last.
       \param pos coordinates of the target point
       \return const pointer to the found triangle. if no triangle, NULL is returned.
      */
@@ -682,7 +802,8 @@ public:
     Triangle * findTriangleContains( const Vector2D & pos ) const;
 
     /*!
-      \brief find the vertex nearest to the specified point
+      \brief find the vertex nearest to the specified point.
+      The k-d tree built by compute() is used if no vertex has been changed after that.
       \param pos coordinates of the target point
       \return const pointer to the found vertex, if no vertex, NULL is returned.
      */
@@ -707,6 +828,67 @@ private:
      */
     void removeInitialVertices();
 
+    /*!
+      \brief check if the triangulation has been computed and contains no initial vertex.
+      \return checked result.
+     */
+    bool isComputed() const;
+
+    /*!
+      \brief compute the whole triangulation again from the stored vertices.
+     */
+    void recompute()
+      {
+          clearResults();
+          compute();
+      }
+
+    /*!
+      \brief collect the Id numbers of the vertices referred by all edges and triangles.
+      \param ids container to store the result. initial vertices have negative Id numbers.
+     */
+    void getVertexIds( std::vector< int > * ids ) const;
+
+    /*!
+      \brief set the vertex pointers of all edges and triangles by the Id numbers.
+      This is used to follow the reallocation of the vertex container.
+      \param ids Id numbers in the same order as getVertexIds().
+     */
+    void setVertexIds( const std::vector< int > & ids );
+
+    /*!
+      \brief insert the vertex into the computed triangulation.
+      \param vertex const pointer to the vertex that is not used by any edge.
+      \return operation result. if error occurs, false is returned.
+     */
+    bool linkVertex( const Vertex * vertex );
+
+    /*!
+      \brief remove all edges and triangles that have the vertex, and fill the hole.
+      \param vertex const pointer to the vertex.
+      \return operation result. if error occurs, false is returned.
+     */
+    bool unlinkVertex( const Vertex * vertex );
+
+    /*!
+      \brief update triangles by new vertex out of the convex hull.
+      \param vertex const pointer to the new vertex
+      \return operation result. if error occurs, false is returned.
+     */
+    bool updateOutsideVertex( const Vertex * vertex );
+
+    /*!
+      \brief triangulate the polygon by the empty circumcircle ears.
+      \param vertices polygon vertices in counter clockwise order
+      \param edges polygon edges. edges[i] connects vertices[i] and vertices[i+1].
+      \param closed if false, the last vertex is not connected to the first vertex.
+      The open polygon is triangulated until it becomes convex.
+      \return operation result. if error occurs, false is returned.
+     */
+    bool fillPolygon( std::vector< const Vertex * > & vertices,
+                      std::vector< EdgePtr > & edges,
+                      const bool closed );
+
     /*!
       \brief update triangles by new vertex.
       \param vertex const pointer to the new vertex
@@ -746,18 +928,14 @@ private:
                                         TrianglePtr * sol ) const;
 
     /*!
-      \brief remove the specified edge from edge set
-      \param id Id number of the removed edge.
+      \brief find triangle that contains pos by walking from the last triangle.
+      If the walk fails, the linear search is used.
+      \param pos coordinates of the target point
+      \param sol pointer to the solution variable.
+      \return how the vertex is contained.
      */
-    void removeEdge( int id )
-      {
-          EdgeCont::iterator it = M_edges.find( id );
-          if ( it != M_edges.end() )
-          {
-              delete it->second;
-              M_edges.erase( it );
-          }
-      }
+    ContainedType locateTriangle( const Vector2D & pos,
+                                  TrianglePtr * sol ) const;
 
     /*!
       \brief remove the specified edge from edge set
@@ -765,28 +943,14 @@ private:
      */
     void removeEdge( Edge * edge )
       {
-          if ( edge )
+          if ( edge
+               && edge->M_index >= 0 )
           {
-              removeEdge( edge->id() );
-          }
-      }
-
-    /*!
-      \brief remove the specified triangle from triangle set
-      \param id Id number of the removed triangle.
-     */
-    void removeTriangle( int id )
-      {
-          TriangleCont::iterator it = M_triangles.find( id );
-          if ( it != M_triangles.end() )
-          {
-              //std::cout << "remove triangle " << id
-              //          << it->second->vertex( 0 )->pos()
-              //          << it->second->vertex( 1 )->pos()
-              //          << it->second->vertex( 2 )->pos()
-              //          << std::endl;
-              delete it->second;
-              M_triangles.erase( it );
+              M_edges.back().second->M_index = edge->M_index;
+              M_edges[edge->M_index] = M_edges.back();
+              M_edges.pop_back();
+              edge->M_index = -1;
+              M_free_edges.push_back( edge );
           }
       }
 
@@ -796,9 +960,24 @@ private:
      */
     void removeTriangle( TrianglePtr tri )
       {
-          if ( tri )
+          if ( tri
+               && tri->M_index >= 0 )
           {
-              removeTriangle( tri->id() );
+              //std::cout << "remove triangle " << tri->id()
+              //          << tri->vertex( 0 )->pos()
+              //          << tri->vertex( 1 )->pos()
+              //          << tri->vertex( 2 )->pos()
+              //          << std::endl;
+              tri->detach();
+              M_triangles.back().second->M_index = tri->M_index;
+              M_triangles[tri->M_index] = M_triangles.back();
+              M_triangles.pop_back();
+              tri->M_index = -1;
+              M_free_triangles.push_back( tri );
+              if ( M_last_triangle == tri )
+              {
+                  M_last_triangle = nullptr;
+              }
           }
       }
 
@@ -809,12 +988,7 @@ private:
       \return pointer to the new edge instance.
      */
     EdgePtr createEdge( const Vertex * v0,
-                        const Vertex * v1 )
-      {
-          EdgePtr ptr = new Edge( M_edge_count++, v0, v1 );
-          M_edges.insert( EdgeCont::value_type( ptr->id(), ptr ) );
-          return ptr;
-      }
+                        const Vertex * v1 );
 
     /*!
       \brief create new triangle from three edges, and register it to the triangle set.
@@ -825,13 +999,7 @@ private:
      */
     TrianglePtr createTriangle( Edge * e0,
                                 Edge * e1,
-                                Edge * e2 )
-      {
-          // triangle is set to edges in the constructor of Triangle
-          TrianglePtr ptr = new Triangle( M_tri_count++, e0, e1, e2 );
-          M_triangles.insert( TriangleCont::value_type( ptr->id(), ptr ) );
-          return ptr;
-      }
+                                Edge * e2 );
 
 };
 
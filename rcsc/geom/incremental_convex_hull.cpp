@@ -0,0 +1,387 @@
+// -*-c++-*-
+
+/*!
+  \file incremental_convex_hull.cpp
+  \brief online 2D convex hull Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+#ifdef HAVE_CONFIG
+#include <config.h>
+#endif
+
+#include "incremental_convex_hull.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace rcsc {
+
+namespace {
+
+/*!
+  \brief get the turn direction
+  \return positive if a-b-c turns counter clockwise
+*/
+template < typename K >
+inline
+double
+turn( const K & a,
+      const K & b,
+      const K & c )
+{
+    return ( b.x - a.x ) * ( c.y - b.y ) - ( b.y - a.y ) * ( c.x - b.x );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+IncrementalConvexHull::IncrementalConvexHull()
+    : M_size( 0 ),
+      M_vertices_updated( true )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+IncrementalConvexHull::clear()
+{
+    M_points.clear();
+    M_valid.clear();
+    M_free_ids.clear();
+    M_size = 0;
+    M_upper.clear();
+    M_lower.clear();
+    M_vertices.clear();
+    M_vertices_updated = true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+IncrementalConvexHull::insert( const Vector2D & p )
+{
+    int id = 0;
+    if ( M_free_ids.empty() )
+    {
+        id = static_cast< int >( M_points.size() );
+        M_points.push_back( p );
+        M_valid.push_back( 1 );
+    }
+    else
+    {
+        id = M_free_ids.back();
+        M_free_ids.pop_back();
+        M_points[id] = p;
+        M_valid[id] = 1;
+    }
+
+    const Key k = key( id );
+    ++M_size;
+    insertToChain( M_upper, -1.0, k );
+    insertToChain( M_lower, +1.0, k );
+    M_vertices_updated = false;
+
+    return id;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+IncrementalConvexHull::remove( const int id )
+{
+    if ( id < 0
+         || static_cast< int >( M_points.size() ) <= id
+         || ! M_valid[id] )
+    {
+        return false;
+    }
+
+    const Key k = key( id );
+    M_valid[id] = 0;
+    --M_size;
+    removeFromChain( M_upper, -1.0, k );
+    removeFromChain( M_lower, +1.0, k );
+    M_vertices_updated = false;
+
+    M_free_ids.push_back( id );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+IncrementalConvexHull::move( const int id,
+                             const Vector2D & p )
+{
+    if ( id < 0
+         || static_cast< int >( M_points.size() ) <= id
+         || ! M_valid[id] )
+    {
+        return false;
+    }
+
+    const Key old_key = key( id );
+    const Key new_key = { p.x, p.y, id };
+
+    //
+    // the inner point that is moved inside of the hull does not change the hull.
+    // this is the usual case of the players in the defensive line.
+    //
+    if ( isStrictlyInside( M_upper, -1.0, old_key )
+         && isStrictlyInside( M_lower, +1.0, old_key )
+         && isStrictlyInside( M_upper, -1.0, new_key )
+         && isStrictlyInside( M_lower, +1.0, new_key ) )
+    {
+        M_points[id] = p;
+        return true;
+    }
+
+    // the point is excluded while the chains are rebuilt.
+    M_valid[id] = 0;
+    removeFromChain( M_upper, -1.0, old_key );
+    removeFromChain( M_lower, +1.0, old_key );
+    M_valid[id] = 1;
+
+    M_points[id] = p;
+    insertToChain( M_upper, -1.0, new_key );
+    insertToChain( M_lower, +1.0, new_key );
+    M_vertices_updated = false;
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const IncrementalConvexHull::VertexCont &
+IncrementalConvexHull::vertices() const
+{
+    if ( M_vertices_updated )
+    {
+        return M_vertices;
+    }
+
+    M_vertices_updated = true;
+    M_vertices.clear();
+
+    if ( M_lower.size() + M_upper.size() < 5 )
+    {
+        // both chains share the end points.
+        return M_vertices;
+    }
+
+    // the lower chain from the left, and the upper chain from the right.
+    for ( const Key & k : M_lower )
+    {
+        M_vertices.push_back( M_points[k.id] );
+    }
+
+    KeySet::const_reverse_iterator it = M_upper.rbegin();
+    ++it;
+    for ( KeySet::const_reverse_iterator end = std::prev( M_upper.rend() ); it != end; ++it )
+    {
+        M_vertices.push_back( M_points[it->id] );
+    }
+
+    return M_vertices;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+IncrementalConvexHull::isStrictlyInside( const KeySet & chain,
+                                         const double sign,
+                                         const Key & k )
+{
+    const KeySet::const_iterator next = chain.lower_bound( k );
+    if ( next == chain.end()
+         || next == chain.begin() )
+    {
+        return false;
+    }
+
+    const KeySet::const_iterator prev = std::prev( next );
+    return ( prev->x < k.x
+             && k.x < next->x
+             && sign * turn( *prev, k, *next ) < 0.0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+IncrementalConvexHull::insertToChain( KeySet & chain,
+                                      const double sign,
+                                      const Key & k )
+{
+    KeySet::iterator next = chain.lower_bound( k );
+
+    // check if the point is below the upper chain (above the lower chain).
+    if ( next != chain.end()
+         && next != chain.begin() )
+    {
+        if ( sign * turn( *std::prev( next ), k, *next ) <= 0.0 )
+        {
+            return;
+        }
+    }
+
+    const KeySet::iterator it = chain.insert( next, k );
+
+    // remove the following points that are not convex
+    while ( true )
+    {
+        next = std::next( it );
+        if ( next == chain.end()
+             || std::next( next ) == chain.end()
+             || sign * turn( k, *next, *std::next( next ) ) > 0.0 )
+        {
+            break;
+        }
+        chain.erase( next );
+    }
+
+    // remove the preceding points that are not convex
+    while ( it != chain.begin() )
+    {
+        const KeySet::iterator prev = std::prev( it );
+        if ( prev == chain.begin()
+             || sign * turn( *std::prev( prev ), *prev, k ) > 0.0 )
+        {
+            break;
+        }
+        chain.erase( prev );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+IncrementalConvexHull::removeFromChain( KeySet & chain,
+                                        const double sign,
+                                        const Key & k )
+{
+    const KeySet::iterator it = chain.find( k );
+    if ( it == chain.end() )
+    {
+        // an inner point
+        return;
+    }
+
+    //
+    // the neighbours of the removed vertex are still the vertices.
+    // the new chain between them consists of the points in that range.
+    // if the removed vertex is the end point, the range starts from
+    // the new end point.
+    //
+    const bool has_prev = ( it != chain.begin() );
+    const bool has_next = ( std::next( it ) != chain.end() );
+    const Key prev = ( has_prev ? *std::prev( it ) : Key() );
+    const Key next = ( has_next ? *std::next( it ) : Key() );
+
+    chain.erase( it );
+
+    //
+    // collect the points in the range. the linear scan is cheaper than
+    // keeping all points sorted, because the hull vertices are removed
+    // much less often than the points are moved.
+    //
+    std::vector< Key > range;
+    for ( size_t i = 0; i < M_points.size(); ++i )
+    {
+        if ( ! M_valid[i] )
+        {
+            continue;
+        }
+
+        const Key p = key( static_cast< int >( i ) );
+        if ( ( ! has_prev || ! ( p < prev ) )
+             && ( ! has_next || ! ( next < p ) ) )
+        {
+            range.push_back( p );
+        }
+    }
+
+    std::sort( range.begin(), range.end() );
+
+    // monotone chain on the range
+    std::vector< Key > hull;
+    for ( const Key & p : range )
+    {
+        while ( hull.size() >= 2
+                && sign * turn( hull[hull.size() - 2], hull.back(), p ) <= 0.0 )
+        {
+            hull.pop_back();
+        }
+        hull.push_back( p );
+    }
+
+    for ( const Key & h : hull )
+    {
+        chain.insert( h );
+    }
+
+    //
+    // the neighbours may not be the vertices any more with the collinear or
+    // the duplicated points, e.g. when the end point has been removed.
+    //
+    for ( int i = 0; i < 2; ++i )
+    {
+        if ( ! ( i == 0 ? has_prev : has_next ) )
+        {
+            continue;
+        }
+
+        const KeySet::iterator n = chain.find( i == 0 ? prev : next );
+        if ( n != chain.begin()
+             && std::next( n ) != chain.end()
+             && sign * turn( *std::prev( n ), *n, *std::next( n ) ) <= 0.0 )
+        {
+            chain.erase( n );
+        }
+    }
+}
+
+}
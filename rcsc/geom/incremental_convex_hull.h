@@ -0,0 +1,219 @@
+// -*-c++-*-
+
+/*!
+  \file incremental_convex_hull.h
+  \brief online 2D convex hull Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+#ifndef RCSC_GEOM_INCREMENTAL_CONVEX_HULL_H
+#define RCSC_GEOM_INCREMENTAL_CONVEX_HULL_H
+
+#include <rcsc/geom/polygon_2d.h>
+#include <rcsc/geom/vector_2d.h>
+
+#include <vector>
+#include <set>
+
+namespace rcsc {
+
+/*!
+  \class IncrementalConvexHull
+  \brief convex hull of the point set that is updated by insertion, removal and move.
+
+  The upper and lower hulls are stored as the monotone chains sorted by the
+  coordinates. The insertion and the removal of an inner point take
+  O(log n) amortized time. The removal of a hull vertex scans the points
+  and rebuilds only the chain between its neighbours, O(n + m log m) for
+  the m points in that range.
+  The collinear points on the hull edges are not the vertices.
+
+  \code
+  rcsc::IncrementalConvexHull hull;
+  int id[11];
+  for ( int i = 0; i < 11; ++i ) id[i] = hull.insert( opponent_pos[i] );
+  // every cycle
+  for ( int i = 0; i < 11; ++i ) hull.move( id[i], opponent_pos[i] );
+  rcsc::Polygon2D polygon = hull.toPolygon();
+  \endcode
+*/
+class IncrementalConvexHull {
+public:
+    typedef std::vector< Vector2D > VertexCont; //!< result vertex container
+
+private:
+
+    /*!
+      \brief key of the point in the chains. sorted by x, y and id.
+    */
+    struct Key {
+        double x; //!< x coordinate
+        double y; //!< y coordinate
+        int id; //!< point id
+
+        bool operator<( const Key & other ) const
+          {
+              return ( x < other.x
+                       || ( x == other.x
+                            && ( y < other.y
+                                 || ( y == other.y && id < other.id ) ) ) );
+          }
+    };
+
+    typedef std::set< Key > KeySet; //!< sorted key container
+
+    std::vector< Vector2D > M_points; //!< point coordinates indexed by id
+    std::vector< char > M_valid; //!< validity of each id
+    std::vector< int > M_free_ids; //!< removed ids to be reused
+
+    size_t M_size; //!< the number of points
+    KeySet M_upper; //!< upper hull from the left to the right
+    KeySet M_lower; //!< lower hull from the left to the right
+
+    mutable VertexCont M_vertices; //!< cached vertices
+    mutable bool M_vertices_updated; //!< true if M_vertices is up to date
+
+public:
+
+    /*!
+      \brief create empty convex hull
+    */
+    IncrementalConvexHull();
+
+    /*!
+      \brief remove all points
+    */
+    void clear();
+
+    /*!
+      \brief add a new point
+      \param p new point
+      \return the id of the point
+    */
+    int insert( const Vector2D & p );
+
+    /*!
+      \brief remove the point
+      \param id the id returned by insert()
+      \return false if the id is not valid
+    */
+    bool remove( const int id );
+
+    /*!
+      \brief move the point
+      \param id the id returned by insert()
+      \param p new position
+      \return false if the id is not valid
+    */
+    bool move( const int id,
+               const Vector2D & p );
+
+    /*!
+      \brief get the number of points
+      \return the number of points
+    */
+    size_t size() const
+      {
+          return M_size;
+      }
+
+    /*!
+      \brief get the point position
+      \param id the point id
+      \return const reference to the position
+    */
+    const Vector2D & point( const int id ) const
+      {
+          return M_points[id];
+      }
+
+    /*!
+      \brief get the hull vertices in counter clockwise order from the minimum
+      coordinate point, in the same way as ConvexHull::vertices().
+      \return const reference to the vertex container. it is built only when
+      the hull has been changed.
+
+      The vertices are empty if the number of the hull vertices is less than 3.
+    */
+    const VertexCont & vertices() const;
+
+    /*!
+      \brief get the convex hull polygon
+      \return new 2d polygon object
+    */
+    Polygon2D toPolygon() const
+      {
+          return Polygon2D( vertices() );
+      }
+
+private:
+
+    /*!
+      \brief create the key of the point
+      \param id the point id
+      \return key object
+    */
+    Key key( const int id ) const
+      {
+          return Key{ M_points[id].x, M_points[id].y, id };
+      }
+
+    /*!
+      \brief check if the point is strictly inside of the chain
+      \param chain the upper or the lower chain
+      \param sign -1 for the upper chain, +1 for the lower chain
+      \param k checked key
+      \return true if the point is strictly below the upper chain (above the lower chain)
+    */
+    static
+    bool isStrictlyInside( const KeySet & chain,
+                           const double sign,
+                           const Key & k );
+
+    /*!
+      \brief add the point to the chain if it is the vertex
+      \param chain the upper or the lower chain
+      \param sign -1 for the upper chain, +1 for the lower chain
+      \param k new key
+    */
+    static
+    void insertToChain( KeySet & chain,
+                       const double sign,
+                       const Key & k );
+
+    /*!
+      \brief remove the point from the chain, and rebuild the chain between its neighbours.
+      \param chain the upper or the lower chain
+      \param sign -1 for the upper chain, +1 for the lower chain
+      \param k removed key. already invalidated in M_valid.
+    */
+    void removeFromChain( KeySet & chain,
+                         const double sign,
+                         const Key & k );
+
+};
+
+}
+
+#endif
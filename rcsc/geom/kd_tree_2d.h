@@ -0,0 +1,445 @@
+// -*-c++-*-
+
+/*!
+  \file kd_tree_2d.h
+  \brief static 2D k-d tree for point sets Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_GEOM_KD_TREE_2D_H
+#define RCSC_GEOM_KD_TREE_2D_H
+
+#include <rcsc/geom/rect_2d.h>
+#include <rcsc/geom/vector_2d.h>
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <limits>
+#include <cstddef>
+
+namespace rcsc {
+
+/*!
+  \class KDTree2D
+  \brief static k-d tree over a fixed point set for proximity queries.
+
+  Each element is a pair of a position and a user value, as UniformGrid2D.
+  All elements are kept in one contiguous array that is ordered as an
+  implicit balanced tree: the node of the index range [lo,hi) is the median
+  element at (lo+hi)/2, and its children are the ranges on both sides.
+  The tree is built in O(n log n), and no memory is allocated by the queries
+  except the result container.
+  Unlike UniformGrid2D, no area is needed and the query cost does not depend
+  on the density of the points.
+*/
+template < typename T >
+class KDTree2D {
+public:
+
+    //! element type
+    typedef std::pair< Vector2D, T > Entry;
+
+    //! query result type. the first element is the squared distance.
+    typedef std::vector< std::pair< double, T > > Result;
+
+private:
+
+    std::vector< Entry > M_entries; //!< elements in the tree order
+    std::vector< unsigned char > M_axis; //!< split axis of each node. 0: x, 1: y
+
+public:
+
+    /*!
+      \brief create an empty tree
+    */
+    KDTree2D()
+      { }
+
+    /*!
+      \brief create a tree from the element range
+      \param first first iterator of Entry range
+      \param last last iterator of Entry range
+    */
+    template < typename InputIterator >
+    KDTree2D( InputIterator first,
+              InputIterator last )
+      {
+          build( first, last );
+      }
+
+    /*!
+      \brief remove all elements. allocated memory is kept.
+    */
+    void clear()
+      {
+          M_entries.clear();
+          M_axis.clear();
+      }
+
+    /*!
+      \brief rebuild the tree from the element range
+      \param first first iterator of Entry range
+      \param last last iterator of Entry range
+    */
+    template < typename InputIterator >
+    void build( InputIterator first,
+                InputIterator last )
+      {
+          M_entries.assign( first, last );
+          build();
+      }
+
+    /*!
+      \brief add an element. build() must be called before the next query.
+      \param pos element position
+      \param value user value
+    */
+    void insert( const Vector2D & pos,
+                 const T & value )
+      {
+          M_entries.emplace_back( pos, value );
+      }
+
+    /*!
+      \brief rebuild the tree from the current elements
+    */
+    void build()
+      {
+          M_axis.assign( M_entries.size(), 0 );
+          buildRange( 0, M_entries.size() );
+      }
+
+    /*!
+      \brief get the number of elements
+      \return element count
+    */
+    std::size_t size() const
+      {
+          return M_entries.size();
+      }
+
+    /*!
+      \brief check if the tree has no element
+      \return true if empty
+    */
+    bool empty() const
+      {
+          return M_entries.empty();
+      }
+
+    /*!
+      \brief get the elements in the tree order
+      \return const reference to the element container
+    */
+    const std::vector< Entry > & entries() const
+      {
+          return M_entries;
+      }
+
+    /*!
+      \brief find the nearest element that satisfies the predicate
+      \param point query point
+      \param pred predicate called as pred( const T & )
+      \param result pointer to the variable to store the found value
+      \param dist2 pointer to the variable to store the squared distance. may be NULL.
+      \return true if found
+    */
+    template < typename Predicate >
+    bool nearest( const Vector2D & point,
+                  Predicate pred,
+                  T * result,
+                  double * dist2 = nullptr ) const
+      {
+          const Entry * best = nullptr;
+          double best_d2 = std::numeric_limits< double >::max();
+
+          searchNearest( 0, M_entries.size(), point, pred, &best, &best_d2 );
+
+          if ( ! best )
+          {
+              return false;
+          }
+
+          *result = best->second;
+          if ( dist2 ) *dist2 = best_d2;
+          return true;
+      }
+
+    /*!
+      \brief find k nearest elements that satisfy the predicate
+      \param point query point
+      \param k number of wanted elements
+      \param pred predicate called as pred( const T & )
+      \param result pointer to the result container, sorted by the distance
+      \return true if at least one element is found
+    */
+    template < typename Predicate >
+    bool kNearest( const Vector2D & point,
+                   const std::size_t k,
+                   Predicate pred,
+                   Result * result ) const
+      {
+          result->clear();
+          if ( k == 0 )
+          {
+              return false;
+          }
+
+          // result is used as the max heap of the current candidates.
+          searchKNearest( 0, M_entries.size(), point, k, pred, result );
+          std::sort_heap( result->begin(), result->end(), less );
+          return ! result->empty();
+      }
+
+    /*!
+      \brief find all elements within the circle that satisfy the predicate
+      \param center center of the circle
+      \param r radius of the circle
+      \param pred predicate called as pred( const T & )
+      \param result pointer to the result container. the order is undefined.
+      \return number of found elements
+    */
+    template < typename Predicate >
+    std::size_t withinCircle( const Vector2D & center,
+                              const double r,
+                              Predicate pred,
+                              Result * result ) const
+      {
+          result->clear();
+          searchCircle( 0, M_entries.size(), center, r, r * r, pred, result );
+          return result->size();
+      }
+
+    /*!
+      \brief find all elements within the rectangle that satisfy the predicate
+      \param rect query rectangle
+      \param pred predicate called as pred( const T & )
+      \param result pointer to the result container. the order is undefined.
+      \return number of found elements. the first value of each result is 0.
+    */
+    template < typename Predicate >
+    std::size_t withinRect( const Rect2D & rect,
+                            Predicate pred,
+                            Result * result ) const
+      {
+          result->clear();
+          searchRect( 0, M_entries.size(), rect, pred, result );
+          return result->size();
+      }
+
+private:
+
+    static
+    double coord( const Vector2D & p,
+                  const int axis )
+      {
+          return ( axis == 0 ? p.x : p.y );
+      }
+
+    static
+    bool less( const std::pair< double, T > & lhs,
+               const std::pair< double, T > & rhs )
+      {
+          return lhs.first < rhs.first;
+      }
+
+    /*!
+      \brief split the range by the median along the longer side of its bounding box.
+     */
+    void buildRange( const std::size_t lo,
+                     const std::size_t hi )
+      {
+          if ( hi - lo <= 1 )
+          {
+              return;
+          }
+
+          double min_x = M_entries[lo].first.x, max_x = min_x;
+          double min_y = M_entries[lo].first.y, max_y = min_y;
+          for ( std::size_t i = lo + 1; i < hi; ++i )
+          {
+              const Vector2D & p = M_entries[i].first;
+              min_x = std::min( min_x, p.x ); max_x = std::max( max_x, p.x );
+              min_y = std::min( min_y, p.y ); max_y = std::max( max_y, p.y );
+          }
+
+          const int axis = ( max_x - min_x >= max_y - min_y ? 0 : 1 );
+          const std::size_t mid = lo + ( hi - lo ) / 2;
+
+          std::nth_element( M_entries.begin() + lo,
+                            M_entries.begin() + mid,
+                            M_entries.begin() + hi,
+                            [axis]( const Entry & lhs, const Entry & rhs )
+                              {
+                                  return coord( lhs.first, axis ) < coord( rhs.first, axis );
+                              } );
+          M_axis[mid] = static_cast< unsigned char >( axis );
+
+          buildRange( lo, mid );
+          buildRange( mid + 1, hi );
+      }
+
+    template < typename Predicate >
+    void searchNearest( const std::size_t lo,
+                        const std::size_t hi,
+                        const Vector2D & point,
+                        Predicate & pred,
+                        const Entry ** best,
+                        double * best_d2 ) const
+      {
+          if ( lo >= hi )
+          {
+              return;
+          }
+
+          const std::size_t mid = lo + ( hi - lo ) / 2;
+          const Entry & e = M_entries[mid];
+
+          const double d2 = e.first.dist2( point );
+          if ( d2 < *best_d2 && pred( e.second ) )
+          {
+              *best = &e;
+              *best_d2 = d2;
+          }
+
+          const double diff = coord( point, M_axis[mid] ) - coord( e.first, M_axis[mid] );
+          if ( diff < 0.0 )
+          {
+              searchNearest( lo, mid, point, pred, best, best_d2 );
+              if ( diff * diff < *best_d2 ) searchNearest( mid + 1, hi, point, pred, best, best_d2 );
+          }
+          else
+          {
+              searchNearest( mid + 1, hi, point, pred, best, best_d2 );
+              if ( diff * diff < *best_d2 ) searchNearest( lo, mid, point, pred, best, best_d2 );
+          }
+      }
+
+    template < typename Predicate >
+    void searchKNearest( const std::size_t lo,
+                         const std::size_t hi,
+                         const Vector2D & point,
+                         const std::size_t k,
+                         Predicate & pred,
+                         Result * heap ) const
+      {
+          if ( lo >= hi )
+          {
+              return;
+          }
+
+          const std::size_t mid = lo + ( hi - lo ) / 2;
+          const Entry & e = M_entries[mid];
+
+          const double d2 = e.first.dist2( point );
+          if ( ( heap->size() < k || d2 < heap->front().first )
+               && pred( e.second ) )
+          {
+              if ( heap->size() == k )
+              {
+                  std::pop_heap( heap->begin(), heap->end(), less );
+                  heap->pop_back();
+              }
+              heap->emplace_back( d2, e.second );
+              std::push_heap( heap->begin(), heap->end(), less );
+          }
+
+          const double diff = coord( point, M_axis[mid] ) - coord( e.first, M_axis[mid] );
+          const std::size_t near_lo = ( diff < 0.0 ? lo : mid + 1 );
+          const std::size_t near_hi = ( diff < 0.0 ? mid : hi );
+          const std::size_t far_lo = ( diff < 0.0 ? mid + 1 : lo );
+          const std::size_t far_hi = ( diff < 0.0 ? hi : mid );
+
+          searchKNearest( near_lo, near_hi, point, k, pred, heap );
+          if ( heap->size() < k
+               || diff * diff < heap->front().first )
+          {
+              searchKNearest( far_lo, far_hi, point, k, pred, heap );
+          }
+      }
+
+    template < typename Predicate >
+    void searchCircle( const std::size_t lo,
+                       const std::size_t hi,
+                       const Vector2D & center,
+                       const double r,
+                       const double r2,
+                       Predicate & pred,
+                       Result * result ) const
+      {
+          if ( lo >= hi )
+          {
+              return;
+          }
+
+          const std::size_t mid = lo + ( hi - lo ) / 2;
+          const Entry & e = M_entries[mid];
+
+          const double d2 = e.first.dist2( center );
+          if ( d2 <= r2 && pred( e.second ) )
+          {
+              result->emplace_back( d2, e.second );
+          }
+
+          const double diff = coord( center, M_axis[mid] ) - coord( e.first, M_axis[mid] );
+          if ( diff <= r ) searchCircle( lo, mid, center, r, r2, pred, result );
+          if ( diff >= -r ) searchCircle( mid + 1, hi, center, r, r2, pred, result );
+      }
+
+    template < typename Predicate >
+    void searchRect( const std::size_t lo,
+                     const std::size_t hi,
+                     const Rect2D & rect,
+                     Predicate & pred,
+                     Result * result ) const
+      {
+          if ( lo >= hi )
+          {
+              return;
+          }
+
+          const std::size_t mid = lo + ( hi - lo ) / 2;
+          const Entry & e = M_entries[mid];
+
+          if ( rect.minX() <= e.first.x && e.first.x <= rect.maxX()
+               && rect.minY() <= e.first.y && e.first.y <= rect.maxY()
+               && pred( e.second ) )
+          {
+              result->emplace_back( 0.0, e.second );
+          }
+
+          const int axis = M_axis[mid];
+          const double split = coord( e.first, axis );
+          if ( ( axis == 0 ? rect.minX() : rect.minY() ) <= split ) searchRect( lo, mid, rect, pred, result );
+          if ( ( axis == 0 ? rect.maxX() : rect.maxY() ) >= split ) searchRect( mid + 1, hi, rect, pred, result );
+      }
+};
+
+}
+
+#endif
@@ -35,6 +35,8 @@
 
 #include "matrix_2d.h"
 
+#include "vector_2d_array.h"
+
 namespace rcsc {
 
 /*-------------------------------------------------------------------*/
@@ -87,5 +89,35 @@ Matrix2D::rotate( const AngleDeg & angle )
     return *this;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Matrix2D::transform( const Vector2DArray & src,
+                     Vector2DArray * dst ) const
+{
+    const std::size_t n = src.size();
+    if ( dst != &src )
+    {
+        dst->resize( n );
+    }
+
+    const double * const sx = src.xData();
+    const double * const sy = src.yData();
+    double * const tx = dst->xData();
+    double * const ty = dst->yData();
+
+    const double m11 = M_11, m12 = M_12, m21 = M_21, m22 = M_22;
+    const double dx = M_dx, dy = M_dy;
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        const double x = sx[i];
+        const double y = sy[i];
+        tx[i] = m11 * x + m12 * y + dx;
+        ty[i] = m21 * x + m22 * y + dy;
+    }
+}
 
 }
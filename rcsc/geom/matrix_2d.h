@@ -40,6 +40,8 @@
 
 namespace rcsc {
 
+class Vector2DArray;
+
 /*!
   \class Matrix2D
   \brief 2D translation matrix class
@@ -386,6 +388,15 @@ public:
           v->assign( tx, ty );
       }
 
+    /*!
+      \brief transform all vectors in the array with this matrix.
+      The loop has no branch, so that the compiler can vectorize it.
+      \param src input vectors
+      \param dst pointer to the result array. resized to src.size(). may be &src.
+     */
+    void transform( const Vector2DArray & src,
+                    Vector2DArray * dst ) const;
+
 #if 0
     Segment2D transform( const Segment2D & s ) const
       {
@@ -37,6 +37,7 @@
 #include <rcsc/geom/segment_2d.h>
 #include <rcsc/geom/rect_2d.h>
 #include <rcsc/geom/line_2d.h>
+#include <rcsc/geom/vector_2d_array.h>
 
 #include <cmath>
 #include <cfloat>
@@ -556,4 +557,19 @@ Polygon2D::getScissoredConnectedPolygon( const Rect2D & r ) const
     return Polygon2D( clipped_p_4 );
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::size_t
+Polygon2D::containsMany( const Vector2DArray & points,
+                         std::vector< char > * result ) const
+{
+    if ( M_vertices.size() < 3 )
+    {
+        return Region2D::containsMany( points, result );
+    }
+
+    return points.contains( *this, result );
+}
 }
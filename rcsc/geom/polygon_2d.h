@@ -109,6 +109,21 @@ public:
           return contains( p, true );
       }
 
+    /*!
+      \brief check if this polygon contains each point.
+      \param points considered points
+      \param result pointer to the result variable. may be NULL. 1 if contained, otherwise 0.
+      \return the number of contained points
+
+      The convex polygon is checked by the edge functions, and the point on the
+      edges is always contained, while contains() accepts only the vertices
+      and some edges. The other polygon is checked by the even-odd rule, and
+      the result of the point on the edges may be different.
+    */
+    virtual
+    std::size_t containsMany( const Vector2DArray & points,
+                              std::vector< char > * result ) const;
+
     /*!
       \brief check point is in this polygon or not
       \param p point for checking
@@ -37,6 +37,7 @@
 
 #include "segment_2d.h"
 #include "ray_2d.h"
+#include "vector_2d_array.h"
 
 #include <iostream>
 
@@ -351,4 +352,15 @@ Rect2D::operator|=( const Rect2D & other )
     return *this;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::size_t
+Rect2D::containsMany( const Vector2DArray & points,
+                      std::vector< char > * result ) const
+{
+    return points.contains( *this, result );
+}
+
 }
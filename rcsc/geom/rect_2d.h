@@ -580,6 +580,16 @@ public:
                    && point.y <= bottom() );
       }
 
+    /*!
+      \brief check if this rectangle contains each point.
+      \param points considered points
+      \param result pointer to the result variable. may be NULL. 1 if contained, otherwise 0.
+      \return the number of contained points
+    */
+    virtual
+    std::size_t containsMany( const Vector2DArray & points,
+                              std::vector< char > * result ) const;
+
     /*!
       \brief check if point is within this region with error threshold.
       \param point considered point
@@ -0,0 +1,70 @@
+// -*-c++-*-
+
+/*!
+  \file region_2d.cpp
+  \brief abstract 2D region class Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "region_2d.h"
+
+#include "vector_2d_array.h"
+
+namespace rcsc {
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::size_t
+Region2D::containsMany( const Vector2DArray & points,
+                        std::vector< char > * result ) const
+{
+    const std::size_t n = points.size();
+    if ( result )
+    {
+        result->resize( n );
+    }
+
+    std::size_t count = 0;
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        const char f = ( contains( points[i] ) ? 1 : 0 );
+        count += f;
+        if ( result )
+        {
+            ( *result )[i] = f;
+        }
+    }
+
+    return count;
+}
+
+}
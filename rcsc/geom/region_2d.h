@@ -32,9 +32,13 @@
 #ifndef RCSC_GEOM_REGION2D_H
 #define RCSC_GEOM_REGION2D_H
 
+#include <vector>
+#include <cstddef>
+
 namespace rcsc {
 
 class Vector2D;
+class Vector2DArray;
 
 /*!
   \class Region2D
@@ -73,6 +77,20 @@ public:
     virtual
     bool contains( const Vector2D & point ) const = 0;
 
+    /*!
+      \brief check if this region contains each point.
+      \param points considered points
+      \param result pointer to the result variable. may be NULL. 1 if contained, otherwise 0.
+      \return the number of contained points
+
+      The default implementation calls contains() for each point. The derived
+      classes override this method by the batch kernels of Vector2DArray, and
+      the composite regions evaluate their children in bulk.
+    */
+    virtual
+    std::size_t containsMany( const Vector2DArray & points,
+                              std::vector< char > * result ) const;
+
 };
 
 }
@@ -35,6 +35,8 @@
 
 #include "sector_2d.h"
 
+#include "vector_2d_array.h"
+
 namespace rcsc {
 
 /*-------------------------------------------------------------------*/
@@ -120,4 +122,15 @@ Sector2D::area() const
     return circle_area;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::size_t
+Sector2D::containsMany( const Vector2DArray & points,
+                        std::vector< char > * result ) const
+{
+    return points.contains( *this, result );
+}
+
 }
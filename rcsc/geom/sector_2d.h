@@ -157,6 +157,19 @@ public:
                                          M_angle_right_end ) );
       }
 
+    /*!
+      \brief check if this sector contains each point.
+      \param points considered points
+      \param result pointer to the result variable. may be NULL. 1 if contained, otherwise 0.
+      \return the number of contained points
+
+      The result of the point on the angle boundaries may be different from
+      contains(), because the directions are calculated for the arrays.
+    */
+    virtual
+    std::size_t containsMany( const Vector2DArray & points,
+                              std::vector< char > * result ) const;
+
     /*!
       \brief get smaller side circumference(ENSYUU NO NAGASA)
       \return the length of circumference
@@ -0,0 +1,513 @@
+// -*-c++-*-
+
+/*!
+  \file segment_bvh_2d.h
+  \brief static bounding volume hierarchy for segment sets Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_GEOM_SEGMENT_BVH_2D_H
+#define RCSC_GEOM_SEGMENT_BVH_2D_H
+
+#include <rcsc/geom/ray_2d.h>
+#include <rcsc/geom/segment_2d.h>
+#include <rcsc/geom/vector_2d.h>
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <cstddef>
+
+namespace rcsc {
+
+/*!
+  \class SegmentBVH2D
+  \brief static bounding volume hierarchy over a fixed segment set.
+
+  Each element is a pair of a segment and a user value. The nodes are
+  axis-aligned bounding boxes stored in one contiguous array in the depth
+  first order, so the left child of a node always follows the node itself.
+  The hierarchy is built in O(n log n) by the median split of the segment
+  centers along the longer side of the node box.
+*/
+template < typename T >
+class SegmentBVH2D {
+public:
+
+    //! element type
+    typedef std::pair< Segment2D, T > Entry;
+
+    //! query result type. the first element is the squared distance.
+    typedef std::vector< std::pair< double, T > > Result;
+
+    //! the maximum number of segments in a leaf node
+    static constexpr std::size_t LEAF_SIZE = 4;
+
+private:
+
+    /*!
+      \struct Node
+      \brief bounding box node
+    */
+    struct Node {
+        double min_x_; //!< box left
+        double min_y_; //!< box top
+        double max_x_; //!< box right
+        double max_y_; //!< box bottom
+        std::size_t first_; //!< leaf: index of the first entry. internal: index of the right child
+        std::size_t count_; //!< leaf: the number of entries. internal: 0
+    };
+
+    std::vector< Entry > M_entries; //!< elements in the leaf order
+    std::vector< Node > M_nodes; //!< nodes in the depth first order
+
+public:
+
+    /*!
+      \brief create an empty hierarchy
+    */
+    SegmentBVH2D()
+      { }
+
+    /*!
+      \brief create a hierarchy from the element range
+      \param first first iterator of Entry range
+      \param last last iterator of Entry range
+    */
+    template < typename InputIterator >
+    SegmentBVH2D( InputIterator first,
+                  InputIterator last )
+      {
+          build( first, last );
+      }
+
+    /*!
+      \brief remove all elements. allocated memory is kept.
+    */
+    void clear()
+      {
+          M_entries.clear();
+          M_nodes.clear();
+      }
+
+    /*!
+      \brief rebuild the hierarchy from the element range
+      \param first first iterator of Entry range
+      \param last last iterator of Entry range
+    */
+    template < typename InputIterator >
+    void build( InputIterator first,
+                InputIterator last )
+      {
+          M_entries.assign( first, last );
+          M_nodes.clear();
+          if ( ! M_entries.empty() )
+          {
+              M_nodes.reserve( 2 * ( M_entries.size() / LEAF_SIZE + 1 ) );
+              buildNode( 0, M_entries.size() );
+          }
+      }
+
+    /*!
+      \brief get the number of elements
+      \return element count
+    */
+    std::size_t size() const
+      {
+          return M_entries.size();
+      }
+
+    /*!
+      \brief check if the hierarchy has no element
+      \return true if empty
+    */
+    bool empty() const
+      {
+          return M_entries.empty();
+      }
+
+    /*!
+      \brief find the element nearest to the point that satisfies the predicate
+      \param point query point
+      \param pred predicate called as pred( const T & )
+      \param result pointer to the variable to store the found value
+      \param dist2 pointer to the variable to store the squared distance. may be NULL.
+      \return true if found
+    */
+    template < typename Predicate >
+    bool nearest( const Vector2D & point,
+                  Predicate pred,
+                  T * result,
+                  double * dist2 = nullptr ) const
+      {
+          if ( M_nodes.empty() )
+          {
+              return false;
+          }
+
+          const Entry * best = nullptr;
+          double best_d2 = std::numeric_limits< double >::max();
+
+          searchNearest( 0, point, pred, &best, &best_d2 );
+
+          if ( ! best )
+          {
+              return false;
+          }
+
+          *result = best->second;
+          if ( dist2 ) *dist2 = best_d2;
+          return true;
+      }
+
+    /*!
+      \brief find all elements within the circle that satisfy the predicate
+      \param center center of the circle
+      \param r radius of the circle
+      \param pred predicate called as pred( const T & )
+      \param result pointer to the result container. the order is undefined.
+      \return number of found elements
+    */
+    template < typename Predicate >
+    std::size_t withinCircle( const Vector2D & center,
+                              const double r,
+                              Predicate pred,
+                              Result * result ) const
+      {
+          result->clear();
+          if ( ! M_nodes.empty() )
+          {
+              searchCircle( 0, center, r * r, pred, result );
+          }
+          return result->size();
+      }
+
+    /*!
+      \brief find the first element hit by the ray that satisfies the predicate
+      \param ray query ray
+      \param max_length the maximum distance from the ray origin
+      \param pred predicate called as pred( const T & )
+      \param result pointer to the variable to store the found value
+      \param length pointer to the variable to store the distance to the hit point. may be NULL.
+      \return true if found
+    */
+    template < typename Predicate >
+    bool rayCast( const Ray2D & ray,
+                  const double max_length,
+                  Predicate pred,
+                  T * result,
+                  double * length = nullptr ) const
+      {
+          if ( M_nodes.empty() )
+          {
+              return false;
+          }
+
+          const Vector2D dir( ray.dir().cos(), ray.dir().sin() );
+          const Vector2D inv( dir.x != 0.0 ? 1.0 / dir.x : std::numeric_limits< double >::infinity(),
+                              dir.y != 0.0 ? 1.0 / dir.y : std::numeric_limits< double >::infinity() );
+
+          const Entry * best = nullptr;
+          double best_t = max_length;
+
+          searchRay( 0, ray.origin(), dir, inv, pred, &best, &best_t );
+
+          if ( ! best )
+          {
+              return false;
+          }
+
+          *result = best->second;
+          if ( length ) *length = best_t;
+          return true;
+      }
+
+private:
+
+    std::size_t buildNode( const std::size_t lo,
+                           const std::size_t hi )
+      {
+          const std::size_t index = M_nodes.size();
+          M_nodes.push_back( Node{ std::numeric_limits< double >::max(),
+                                   std::numeric_limits< double >::max(),
+                                   -std::numeric_limits< double >::max(),
+                                   -std::numeric_limits< double >::max(),
+                                   lo, hi - lo } );
+
+          double c_min_x = std::numeric_limits< double >::max(), c_max_x = -c_min_x;
+          double c_min_y = c_min_x, c_max_y = c_max_x;
+          {
+              Node & n = M_nodes[index];
+              for ( std::size_t i = lo; i < hi; ++i )
+              {
+                  const Vector2D & a = M_entries[i].first.origin();
+                  const Vector2D & b = M_entries[i].first.terminal();
+                  n.min_x_ = std::min( n.min_x_, std::min( a.x, b.x ) );
+                  n.min_y_ = std::min( n.min_y_, std::min( a.y, b.y ) );
+                  n.max_x_ = std::max( n.max_x_, std::max( a.x, b.x ) );
+                  n.max_y_ = std::max( n.max_y_, std::max( a.y, b.y ) );
+
+                  const double cx = a.x + b.x, cy = a.y + b.y;
+                  c_min_x = std::min( c_min_x, cx ); c_max_x = std::max( c_max_x, cx );
+                  c_min_y = std::min( c_min_y, cy ); c_max_y = std::max( c_max_y, cy );
+              }
+          }
+
+          if ( hi - lo <= LEAF_SIZE )
+          {
+              return index;
+          }
+
+          // split by the center (doubled to avoid the division) along the longer side.
+          const bool x_axis = ( c_max_x - c_min_x >= c_max_y - c_min_y );
+          const std::size_t mid = lo + ( hi - lo ) / 2;
+          std::nth_element( M_entries.begin() + lo,
+                            M_entries.begin() + mid,
+                            M_entries.begin() + hi,
+                            [x_axis]( const Entry & lhs, const Entry & rhs )
+                              {
+                                  return ( x_axis
+                                           ? lhs.first.origin().x + lhs.first.terminal().x
+                                           < rhs.first.origin().x + rhs.first.terminal().x
+                                           : lhs.first.origin().y + lhs.first.terminal().y
+                                           < rhs.first.origin().y + rhs.first.terminal().y );
+                              } );
+
+          buildNode( lo, mid );
+          const std::size_t right = buildNode( mid, hi );
+
+          M_nodes[index].first_ = right;
+          M_nodes[index].count_ = 0;
+          return index;
+      }
+
+    static
+    double boxDist2( const Node & n,
+                     const Vector2D & p )
+      {
+          const double dx = std::max( 0.0, std::max( n.min_x_ - p.x, p.x - n.max_x_ ) );
+          const double dy = std::max( 0.0, std::max( n.min_y_ - p.y, p.y - n.max_y_ ) );
+          return dx * dx + dy * dy;
+      }
+
+    template < typename Predicate >
+    void searchNearest( const std::size_t index,
+                        const Vector2D & point,
+                        Predicate & pred,
+                        const Entry ** best,
+                        double * best_d2 ) const
+      {
+          const Node & n = M_nodes[index];
+          if ( n.count_ > 0 )
+          {
+              for ( std::size_t i = n.first_, end = n.first_ + n.count_; i < end; ++i )
+              {
+                  const Entry & e = M_entries[i];
+                  const double d = e.first.dist( point );
+                  if ( d * d < *best_d2 && pred( e.second ) )
+                  {
+                      *best = &e;
+                      *best_d2 = d * d;
+                  }
+              }
+              return;
+          }
+
+          // visit the nearer child first
+          std::size_t first = index + 1, second = n.first_;
+          double first_d2 = boxDist2( M_nodes[first], point );
+          double second_d2 = boxDist2( M_nodes[second], point );
+          if ( second_d2 < first_d2 )
+          {
+              std::swap( first, second );
+              std::swap( first_d2, second_d2 );
+          }
+
+          if ( first_d2 < *best_d2 ) searchNearest( first, point, pred, best, best_d2 );
+          if ( second_d2 < *best_d2 ) searchNearest( second, point, pred, best, best_d2 );
+      }
+
+    template < typename Predicate >
+    void searchCircle( const std::size_t index,
+                       const Vector2D & center,
+                       const double r2,
+                       Predicate & pred,
+                       Result * result ) const
+      {
+          const Node & n = M_nodes[index];
+          if ( boxDist2( n, center ) > r2 )
+          {
+              return;
+          }
+
+          if ( n.count_ > 0 )
+          {
+              for ( std::size_t i = n.first_, end = n.first_ + n.count_; i < end; ++i )
+              {
+                  const Entry & e = M_entries[i];
+                  const double d = e.first.dist( center );
+                  if ( d * d <= r2 && pred( e.second ) )
+                  {
+                      result->emplace_back( d * d, e.second );
+                  }
+              }
+              return;
+          }
+
+          searchCircle( index + 1, center, r2, pred, result );
+          searchCircle( n.first_, center, r2, pred, result );
+      }
+
+    /*!
+      \brief get the entry distance of the ray to the box (slab method).
+      \return the distance, or a negative value if the ray does not hit within max_t.
+     */
+    static
+    double boxRayEntry( const Node & n,
+                        const Vector2D & origin,
+                        const Vector2D & dir,
+                        const Vector2D & inv,
+                        const double max_t )
+      {
+          double t_min = 0.0;
+          double t_max = max_t;
+
+          if ( dir.x == 0.0 )
+          {
+              if ( origin.x < n.min_x_ || n.max_x_ < origin.x ) return -1.0;
+          }
+          else
+          {
+              double t0 = ( n.min_x_ - origin.x ) * inv.x;
+              double t1 = ( n.max_x_ - origin.x ) * inv.x;
+              if ( t0 > t1 ) std::swap( t0, t1 );
+              t_min = std::max( t_min, t0 );
+              t_max = std::min( t_max, t1 );
+          }
+
+          if ( dir.y == 0.0 )
+          {
+              if ( origin.y < n.min_y_ || n.max_y_ < origin.y ) return -1.0;
+          }
+          else
+          {
+              double t0 = ( n.min_y_ - origin.y ) * inv.y;
+              double t1 = ( n.max_y_ - origin.y ) * inv.y;
+              if ( t0 > t1 ) std::swap( t0, t1 );
+              t_min = std::max( t_min, t0 );
+              t_max = std::min( t_max, t1 );
+          }
+
+          return ( t_min <= t_max ? t_min : -1.0 );
+      }
+
+    /*!
+      \brief get the distance from the ray origin to the segment along the ray.
+      \return the distance, or a negative value if the ray does not hit.
+     */
+    static
+    double segmentRayHit( const Segment2D & seg,
+                          const Vector2D & origin,
+                          const Vector2D & dir )
+      {
+          const Vector2D s = seg.terminal() - seg.origin();
+          const Vector2D q = seg.origin() - origin;
+          const double denom = dir.outerProduct( s );
+
+          if ( std::fabs( denom ) < 1.0e-12 )
+          {
+              if ( std::fabs( q.outerProduct( dir ) ) > 1.0e-9 )
+              {
+                  return -1.0; // parallel
+              }
+
+              // collinear. the nearer end point on the ray is hit.
+              const double t0 = q.innerProduct( dir );
+              const double t1 = ( seg.terminal() - origin ).innerProduct( dir );
+              if ( t0 < 0.0 && t1 < 0.0 ) return -1.0;
+              if ( t0 < 0.0 || t1 < 0.0 ) return 0.0;
+              return std::min( t0, t1 );
+          }
+
+          const double t = q.outerProduct( s ) / denom;
+          const double u = q.outerProduct( dir ) / denom;
+          if ( t < 0.0 || u < 0.0 || 1.0 < u )
+          {
+              return -1.0;
+          }
+          return t;
+      }
+
+    template < typename Predicate >
+    void searchRay( const std::size_t index,
+                    const Vector2D & origin,
+                    const Vector2D & dir,
+                    const Vector2D & inv,
+                    Predicate & pred,
+                    const Entry ** best,
+                    double * best_t ) const
+      {
+          const Node & n = M_nodes[index];
+          if ( n.count_ > 0 )
+          {
+              for ( std::size_t i = n.first_, end = n.first_ + n.count_; i < end; ++i )
+              {
+                  const Entry & e = M_entries[i];
+                  const double t = segmentRayHit( e.first, origin, dir );
+                  if ( 0.0 <= t && t <= *best_t && pred( e.second ) )
+                  {
+                      *best = &e;
+                      *best_t = t;
+                  }
+              }
+              return;
+          }
+
+          // visit the child entered first
+          std::size_t first = index + 1, second = n.first_;
+          double first_t = boxRayEntry( M_nodes[first], origin, dir, inv, *best_t );
+          double second_t = boxRayEntry( M_nodes[second], origin, dir, inv, *best_t );
+          if ( second_t >= 0.0
+               && ( first_t < 0.0 || second_t < first_t ) )
+          {
+              std::swap( first, second );
+              std::swap( first_t, second_t );
+          }
+
+          if ( first_t >= 0.0 ) searchRay( first, origin, dir, inv, pred, best, best_t );
+          if ( second_t >= 0.0 && second_t <= *best_t ) searchRay( second, origin, dir, inv, pred, best, best_t );
+      }
+};
+
+template < typename T >
+constexpr std::size_t SegmentBVH2D< T >::LEAF_SIZE;
+
+}
+
+#endif
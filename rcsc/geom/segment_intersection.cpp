@@ -36,10 +36,26 @@
 #include "segment_intersection.h"
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 
 namespace rcsc {
 
+namespace {
+
+/*!
+  \brief bounding intervals of the segment
+*/
+struct Interval {
+    double sweep_min; //!< minimum coordinate along the sweep axis
+    double sweep_max; //!< maximum coordinate along the sweep axis
+    double other_min; //!< minimum coordinate along the other axis
+    double other_max; //!< maximum coordinate along the other axis
+    size_t index; //!< index of the segment
+};
+
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -50,7 +66,7 @@ BruteForceSegmentIntersectionDetector::execute( const std::vector< Segment2D > &
 {
     const size_t size = segments.size();
 
-    for ( size_t i = 0; i < size - 1; ++i )
+    for ( size_t i = 0; i + 1 < size; ++i )
     {
         const Segment2D & s_i = segments[i];
 
@@ -64,4 +80,92 @@ BruteForceSegmentIntersectionDetector::execute( const std::vector< Segment2D > &
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SweepSegmentIntersectionDetector::execute( const std::vector< Segment2D > & segments,
+                                           std::vector< SegmentIntersection > * intersections ) const
+{
+    const size_t size = segments.size();
+    if ( size < 2 )
+    {
+        return;
+    }
+
+    //
+    // select the sweep axis.
+    // the overlapping pairs are fewer along the axis on which
+    // the total length of the intervals is smaller relative to the spread.
+    //
+    double min_x = segments.front().origin().x, max_x = min_x;
+    double min_y = segments.front().origin().y, max_y = min_y;
+    double length_x = 0.0, length_y = 0.0;
+    for ( const Segment2D & s : segments )
+    {
+        const Vector2D & a = s.origin();
+        const Vector2D & b = s.terminal();
+        min_x = std::min( min_x, std::min( a.x, b.x ) );
+        max_x = std::max( max_x, std::max( a.x, b.x ) );
+        min_y = std::min( min_y, std::min( a.y, b.y ) );
+        max_y = std::max( max_y, std::max( a.y, b.y ) );
+        length_x += std::fabs( a.x - b.x );
+        length_y += std::fabs( a.y - b.y );
+    }
+
+    // length_x / span_x < length_y / span_y
+    const bool sweep_x = ( length_x * ( max_y - min_y ) <= length_y * ( max_x - min_x ) );
+
+    std::vector< Interval > intervals;
+    intervals.reserve( size );
+    for ( size_t i = 0; i < size; ++i )
+    {
+        const Vector2D & a = segments[i].origin();
+        const Vector2D & b = segments[i].terminal();
+        const double min_u = ( sweep_x ? std::min( a.x, b.x ) : std::min( a.y, b.y ) );
+        const double max_u = ( sweep_x ? std::max( a.x, b.x ) : std::max( a.y, b.y ) );
+        const double min_v = ( sweep_x ? std::min( a.y, b.y ) : std::min( a.x, b.x ) );
+        const double max_v = ( sweep_x ? std::max( a.y, b.y ) : std::max( a.x, b.x ) );
+        intervals.push_back( Interval{ min_u, max_u, min_v, max_v, i } );
+    }
+
+    std::sort( intervals.begin(), intervals.end(),
+               []( const Interval & lhs, const Interval & rhs )
+                 {
+                     return lhs.sweep_min < rhs.sweep_min;
+                 } );
+
+    //
+    // the intersecting segments always have the overlapping closed intervals,
+    // so that the other pairs are not checked.
+    //
+    for ( size_t i = 0; i < size; ++i )
+    {
+        const Interval & s_i = intervals[i];
+
+        for ( size_t j = i + 1; j < size; ++j )
+        {
+            const Interval & s_j = intervals[j];
+            if ( s_j.sweep_min > s_i.sweep_max )
+            {
+                break;
+            }
+
+            if ( s_j.other_min > s_i.other_max
+                 || s_i.other_min > s_j.other_max )
+            {
+                continue;
+            }
+
+            const size_t first = std::min( s_i.index, s_j.index );
+            const size_t second = std::max( s_i.index, s_j.index );
+            if ( segments[first].intersects( segments[second] ) )
+            {
+                intersections->emplace_back( segments[first], segments[second] );
+            }
+        }
+    }
+}
+
 }
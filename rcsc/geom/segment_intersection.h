@@ -63,6 +63,23 @@ public:
           M_segment1( s1 )
       { }
 
+    /*!
+      \brief get the first line segment
+      \return const reference to the line segment
+    */
+    const Segment2D & segment0() const
+      {
+          return M_segment0;
+      }
+
+    /*!
+      \brief get the second line segment
+      \return const reference to the line segment
+    */
+    const Segment2D & segment1() const
+      {
+          return M_segment1;
+      }
 
     /*!
       \brief get intersection point between line segments.
@@ -127,6 +144,37 @@ public:
 
 };
 
+
+/*!
+  \class SweepSegmentIntersectionDetector
+  \brief intersection detector using the sorted interval sweep
+
+  The bounding intervals of the segments are sorted along the sweep axis,
+  and only the pairs whose intervals overlap on both axes are checked by
+  Segment2D::intersects(). The sweep axis is the one along which the
+  segments are shorter relative to their spread, so that both the vertical
+  pass lanes and the horizontal movement paths are efficient.
+
+  The cost is O(n log n + m), where m is the number of the overlapping
+  interval pairs. The detected pairs are the same as those of
+  BruteForceSegmentIntersectionDetector, and the first segment of each pair
+  precedes the second one in the input, but the order of the pairs is
+  different.
+*/
+class SweepSegmentIntersectionDetector
+    : public SegmentIntersectionDetector {
+public:
+
+    /*!
+      \brief execute sweep algorithm
+      \param segments input line segments
+      \param intersections result intersections
+    */
+    void execute( const std::vector< Segment2D > & segments,
+                  std::vector< SegmentIntersection > * intersections ) const;
+
+};
+
 }
 
 #endif
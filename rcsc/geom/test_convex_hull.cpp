@@ -32,13 +32,82 @@
 #endif
 
 #include "convex_hull.h"
+#include "incremental_convex_hull.h"
 
 #include <rcsc/time/timer.h>
 
 #include <cppunit/extensions/HelperMacros.h>
 
+#include <algorithm>
+#include <random>
+
 #define DEBUG_PRINT
 
+namespace {
+
+/*!
+  \brief monotone chain algorithm as the reference of IncrementalConvexHull
+  \param points input points
+  \return hull vertices in counter clockwise order from the minimum point
+ */
+std::vector< rcsc::Vector2D >
+monotone_chain( std::vector< rcsc::Vector2D > points )
+{
+    std::sort( points.begin(), points.end(),
+               []( const rcsc::Vector2D & lhs,
+                   const rcsc::Vector2D & rhs )
+                 {
+                     return lhs.x < rhs.x || ( lhs.x == rhs.x && lhs.y < rhs.y );
+                 } );
+
+    std::vector< rcsc::Vector2D > hull;
+    for ( int pass = 0; pass < 2; ++pass )
+    {
+        const size_t start = hull.size();
+        for ( const rcsc::Vector2D & p : points )
+        {
+            while ( hull.size() >= start + 2
+                    && ( hull.back() - hull[hull.size() - 2] ).outerProduct( p - hull.back() ) <= 0.0 )
+            {
+                hull.pop_back();
+            }
+            hull.push_back( p );
+        }
+        hull.pop_back();
+        std::reverse( points.begin(), points.end() );
+    }
+
+    if ( hull.size() < 3 )
+    {
+        hull.clear();
+    }
+    return hull;
+}
+
+/*!
+  \brief check if the vertices are the same
+ */
+bool
+same_vertices( const std::vector< rcsc::Vector2D > & lhs,
+               const std::vector< rcsc::Vector2D > & rhs )
+{
+    if ( lhs.size() != rhs.size() )
+    {
+        return false;
+    }
+
+    for ( size_t i = 0; i < lhs.size(); ++i )
+    {
+        if ( lhs[i].x != rhs[i].x || lhs[i].y != rhs[i].y )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
 class ConvexHullTest
     : public CPPUNIT_NS::TestFixture {
 
@@ -46,6 +115,7 @@ class ConvexHullTest
     CPPUNIT_TEST( testEmpty );
     CPPUNIT_TEST( testPoints );
     CPPUNIT_TEST( testCircle );
+    CPPUNIT_TEST( testIncremental );
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -53,6 +123,7 @@ public:
     void testEmpty();
     void testPoints();
     void testCircle();
+    void testIncremental();
 };
 
 
@@ -258,6 +329,78 @@ ConvexHullTest::testCircle()
     CPPUNIT_ASSERT_EQUAL( 1000, n_edges );
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ConvexHullTest::testIncremental()
+{
+    std::mt19937 engine( 1 );
+    std::uniform_real_distribution<> x_dst( -52.5, 52.5 );
+    std::uniform_real_distribution<> y_dst( -34.0, 34.0 );
+    std::uniform_int_distribution<> grid_dst( -3, 3 );
+    std::uniform_int_distribution<> op_dst( 0, 3 );
+
+    rcsc::IncrementalConvexHull hull;
+    CPPUNIT_ASSERT( hull.vertices().empty() );
+
+    for ( int grid = 0; grid < 2; ++grid )
+    {
+        // the grid points have many collinear and duplicated points
+        auto random_point = [&]()
+          {
+              return ( grid
+                       ? rcsc::Vector2D( grid_dst( engine ), grid_dst( engine ) )
+                       : rcsc::Vector2D( x_dst( engine ), y_dst( engine ) ) );
+          };
+
+        hull.clear();
+        std::vector< int > ids;
+
+        for ( int loop = 0; loop < 2000; ++loop )
+        {
+            const int op = ( ids.size() < 3 ? 0 : op_dst( engine ) );
+            if ( op == 0 )
+            {
+                ids.push_back( hull.insert( random_point() ) );
+            }
+            else if ( op == 1 )
+            {
+                const size_t i = engine() % ids.size();
+                CPPUNIT_ASSERT( hull.remove( ids[i] ) );
+                CPPUNIT_ASSERT( ! hull.remove( ids[i] ) );
+                ids.erase( ids.begin() + i );
+            }
+            else
+            {
+                CPPUNIT_ASSERT( hull.move( ids[engine() % ids.size()], random_point() ) );
+            }
+
+            std::vector< rcsc::Vector2D > points;
+            for ( const int id : ids )
+            {
+                points.push_back( hull.point( id ) );
+            }
+
+            CPPUNIT_ASSERT_EQUAL( ids.size(), hull.size() );
+
+            CPPUNIT_ASSERT( same_vertices( monotone_chain( points ), hull.vertices() ) );
+
+            if ( ! grid
+                 && points.size() >= 3 )
+            {
+                rcsc::ConvexHull graham( points );
+                graham.compute( rcsc::ConvexHull::GrahamScan );
+                CPPUNIT_ASSERT( same_vertices( graham.vertices(), hull.vertices() ) );
+            }
+        }
+    }
+
+    const rcsc::Polygon2D polygon = hull.toPolygon();
+    CPPUNIT_ASSERT( same_vertices( polygon.vertices(), hull.vertices() ) );
+}
+
 /*-------------------------------------------------------------------*/
 /*-------------------------------------------------------------------*/
 /*-------------------------------------------------------------------*/
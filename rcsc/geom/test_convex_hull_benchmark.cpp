@@ -0,0 +1,143 @@
+// -*-c++-*-
+
+/*!
+  \file test_convex_hull_benchmark.cpp
+  \brief benchmark of rcsc::ConvexHull and rcsc::IncrementalConvexHull
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+#ifdef HAVE_CONFIG
+#include <config.h>
+#endif
+
+#include "convex_hull.h"
+#include "incremental_convex_hull.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief execute the function repeatedly
+  \return average elapsed time [us]
+ */
+template < typename Func >
+double
+measure( const int repeat,
+         Func func )
+{
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for ( int i = 0; i < repeat; ++i )
+    {
+        func( i );
+    }
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration< double, std::micro >( end - start ).count() / repeat;
+}
+
+}
+
+int
+main()
+{
+    std::mt19937 engine( 1 );
+    std::uniform_real_distribution<> x_dst( -52.5, 52.5 );
+    std::uniform_real_distribution<> y_dst( -34.0, 34.0 );
+    std::uniform_real_distribution<> move_dst( -0.5, 0.5 );
+
+    std::cout << "points  Direct[us]  Wrapping[us]  GrahamScan[us]  Incremental[us]  vertices" << std::endl;
+
+    for ( const int size : { 11, 22, 100, 1000 } )
+    {
+        // the positions of all cycles are created in advance.
+        // each point moves as the player does in a cycle.
+        const int cycles = 100;
+        std::vector< std::vector< rcsc::Vector2D > > positions( cycles );
+        for ( int i = 0; i < size; ++i )
+        {
+            positions[0].emplace_back( x_dst( engine ), y_dst( engine ) );
+        }
+        for ( int c = 1; c < cycles; ++c )
+        {
+            for ( const rcsc::Vector2D & p : positions[c - 1] )
+            {
+                positions[c].push_back( p + rcsc::Vector2D( move_dst( engine ), move_dst( engine ) ) );
+            }
+        }
+
+        const int repeat = std::max( cycles, 20000 / size );
+
+        size_t n_vertices = 0;
+        auto rebuild = [&]( const rcsc::ConvexHull::MethodType type )
+          {
+              return measure( repeat,
+                              [&]( const int i )
+                                {
+                                    rcsc::ConvexHull hull( positions[i % cycles] );
+                                    hull.compute( type );
+                                    n_vertices += hull.toPolygon().vertices().size();
+                                } );
+          };
+
+        const double direct_time = ( size <= 100 ? rebuild( rcsc::ConvexHull::DirectMethod ) : -1.0 );
+        const double wrapping_time = rebuild( rcsc::ConvexHull::WrappingMethod );
+        const double graham_time = rebuild( rcsc::ConvexHull::GrahamScan );
+
+        // the object is reused over cycles in the agent.
+        rcsc::IncrementalConvexHull incremental;
+        std::vector< int > ids;
+        for ( const rcsc::Vector2D & p : positions[0] )
+        {
+            ids.push_back( incremental.insert( p ) );
+        }
+
+        size_t incremental_vertices = 0;
+        const double incremental_time
+            = measure( repeat,
+                       [&]( const int i )
+                         {
+                             const std::vector< rcsc::Vector2D > & pos = positions[i % cycles];
+                             for ( size_t j = 0; j < ids.size(); ++j )
+                             {
+                                 incremental.move( ids[j], pos[j] );
+                             }
+                             incremental_vertices = incremental.toPolygon().vertices().size();
+                         } );
+
+        std::cout << size
+                  << "  " << direct_time
+                  << "  " << wrapping_time
+                  << "  " << graham_time
+                  << "  " << incremental_time
+                  << "  " << incremental_vertices
+                  << std::endl;
+    }
+
+    return 0;
+}
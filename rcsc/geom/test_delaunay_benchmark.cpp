@@ -0,0 +1,119 @@
+// -*-c++-*-
+
+/*!
+  \file test_delaunay_benchmark.cpp
+  \brief benchmark of rcsc::DelaunayTriangulation and rcsc::Triangulation
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+#ifdef HAVE_CONFIG
+#include <config.h>
+#endif
+
+#include "delaunay_triangulation.h"
+#include "triangulation.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief compute the triangulation of the same points repeatedly
+  \return average elapsed time [us]
+ */
+template < typename Func >
+double
+measure( const int repeat,
+         Func func )
+{
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for ( int i = 0; i < repeat; ++i )
+    {
+        func();
+    }
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration< double, std::micro >( end - start ).count() / repeat;
+}
+
+}
+
+int
+main()
+{
+    std::mt19937 engine( 1 );
+    std::uniform_real_distribution<> x_dst( -52.5, 52.5 );
+    std::uniform_real_distribution<> y_dst( -34.0, 34.0 );
+
+    const rcsc::Rect2D pitch( rcsc::Vector2D( -60.0, -45.0 ),
+                              rcsc::Size2D( 120.0, 90.0 ) );
+
+    // the object is reused as the per-cycle computation in the agent.
+    rcsc::DelaunayTriangulation delaunay;
+    rcsc::Triangulation triangulation;
+
+    std::cout << "points  DelaunayTriangulation[us]  Triangulation[us]  triangles" << std::endl;
+
+    for ( const int size : { 22, 100, 300, 1000 } )
+    {
+        std::vector< rcsc::Vector2D > points;
+        for ( int i = 0; i < size; ++i )
+        {
+            points.emplace_back( x_dst( engine ), y_dst( engine ) );
+        }
+
+        const int repeat = 200000 / size;
+
+        const double delaunay_time
+            = measure( repeat,
+                       [&]()
+                         {
+                             delaunay.init( pitch );
+                             delaunay.addVertices( points );
+                             delaunay.compute();
+                         } );
+
+        const double triangulation_time
+            = measure( repeat,
+                       [&]()
+                         {
+                             triangulation.clear();
+                             triangulation.addPoints( points );
+                             triangulation.compute();
+                         } );
+
+        std::cout << size
+                  << "  " << delaunay_time
+                  << "  " << triangulation_time
+                  << "  " << delaunay.triangles().size()
+                  << '/' << triangulation.triangles().size()
+                  << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,254 @@
+// -*-c++-*-
+
+/*!
+  \file test_kd_tree_2d_benchmark.cpp
+  \brief benchmark of rcsc::KDTree2D and rcsc::SegmentBVH2D against the linear search
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+#ifdef HAVE_CONFIG
+#include <config.h>
+#endif
+
+#include "kd_tree_2d.h"
+#include "segment_bvh_2d.h"
+#include "delaunay_triangulation.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief call the function for all queries repeatedly
+  \return average elapsed time per query [ns]
+ */
+template < typename Func >
+double
+measure( const int repeat,
+         const std::size_t n_queries,
+         Func func )
+{
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for ( int i = 0; i < repeat; ++i )
+    {
+        for ( std::size_t q = 0; q < n_queries; ++q )
+        {
+            func( q );
+        }
+    }
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration< double, std::nano >( end - start ).count() / ( repeat * n_queries );
+}
+
+bool
+accept_all( const int )
+{
+    return true;
+}
+
+int
+linear_nearest( const std::vector< rcsc::Vector2D > & points,
+                const rcsc::Vector2D & p )
+{
+    int best = -1;
+    double best_d2 = 1.0e100;
+    for ( std::size_t i = 0; i < points.size(); ++i )
+    {
+        const double d2 = points[i].dist2( p );
+        if ( d2 < best_d2 )
+        {
+            best = static_cast< int >( i );
+            best_d2 = d2;
+        }
+    }
+    return best;
+}
+
+int
+linear_segment_nearest( const std::vector< rcsc::Segment2D > & segments,
+                        const rcsc::Vector2D & p )
+{
+    int best = -1;
+    double best_d = 1.0e100;
+    for ( std::size_t i = 0; i < segments.size(); ++i )
+    {
+        const double d = segments[i].dist( p );
+        if ( d < best_d )
+        {
+            best = static_cast< int >( i );
+            best_d = d;
+        }
+    }
+    return best;
+}
+
+}
+
+int
+main()
+{
+    std::mt19937 engine( 1 );
+    std::uniform_real_distribution<> x_dst( -52.5, 52.5 );
+    std::uniform_real_distribution<> y_dst( -34.0, 34.0 );
+    std::uniform_real_distribution<> len_dst( -5.0, 5.0 );
+
+    const rcsc::Rect2D pitch( rcsc::Vector2D( -60.0, -45.0 ),
+                              rcsc::Size2D( 120.0, 90.0 ) );
+
+    std::vector< rcsc::Vector2D > queries;
+    for ( int i = 0; i < 1000; ++i )
+    {
+        queries.emplace_back( x_dst( engine ), y_dst( engine ) );
+    }
+
+    int mismatch = 0;
+
+    std::cout << "points  linear[ns]  KDTree2D[ns]  findNearestVertex[ns]  build[us]" << std::endl;
+
+    for ( const int size : { 22, 100, 300, 1000, 5000 } )
+    {
+        std::vector< rcsc::Vector2D > points;
+        std::vector< rcsc::KDTree2D< int >::Entry > entries;
+        for ( int i = 0; i < size; ++i )
+        {
+            points.emplace_back( x_dst( engine ), y_dst( engine ) );
+            entries.emplace_back( points.back(), i );
+        }
+
+        rcsc::KDTree2D< int > tree;
+        const std::chrono::steady_clock::time_point build_start = std::chrono::steady_clock::now();
+        tree.build( entries.begin(), entries.end() );
+        const double build_time
+            = std::chrono::duration< double, std::micro >( std::chrono::steady_clock::now() - build_start ).count();
+
+        rcsc::DelaunayTriangulation delaunay( pitch );
+        delaunay.addVertices( points );
+        delaunay.compute();
+
+        for ( const rcsc::Vector2D & q : queries )
+        {
+            int id = -1;
+            tree.nearest( q, accept_all, &id );
+            if ( points[id].dist2( q ) != points[linear_nearest( points, q )].dist2( q )
+                 || delaunay.findNearestVertex( q )->pos().dist2( q ) != points[id].dist2( q ) )
+            {
+                ++mismatch;
+            }
+        }
+
+        const int repeat = std::max( 1, 20000 / size );
+        volatile int sink = 0;
+
+        const double linear_time
+            = measure( repeat, queries.size(),
+                       [&]( const std::size_t q )
+                         {
+                             sink = linear_nearest( points, queries[q] );
+                         } );
+        const double tree_time
+            = measure( repeat, queries.size(),
+                       [&]( const std::size_t q )
+                         {
+                             int id = -1;
+                             tree.nearest( queries[q], accept_all, &id );
+                             sink = id;
+                         } );
+        const double delaunay_time
+            = measure( repeat, queries.size(),
+                       [&]( const std::size_t q )
+                         {
+                             sink = delaunay.findNearestVertex( queries[q] )->id();
+                         } );
+
+        std::cout << size
+                  << "  " << linear_time
+                  << "  " << tree_time
+                  << "  " << delaunay_time
+                  << "  " << build_time
+                  << std::endl;
+    }
+
+    std::cout << "segments  linear[ns]  SegmentBVH2D[ns]" << std::endl;
+
+    for ( const int size : { 22, 100, 300, 1000 } )
+    {
+        std::vector< rcsc::Segment2D > segments;
+        std::vector< rcsc::SegmentBVH2D< int >::Entry > entries;
+        for ( int i = 0; i < size; ++i )
+        {
+            const rcsc::Vector2D a( x_dst( engine ), y_dst( engine ) );
+            segments.emplace_back( a, a + rcsc::Vector2D( len_dst( engine ), len_dst( engine ) ) );
+            entries.emplace_back( segments.back(), i );
+        }
+
+        const rcsc::SegmentBVH2D< int > bvh( entries.begin(), entries.end() );
+
+        for ( const rcsc::Vector2D & q : queries )
+        {
+            int id = -1;
+            bvh.nearest( q, accept_all, &id );
+            if ( segments[id].dist( q ) != segments[linear_segment_nearest( segments, q )].dist( q ) )
+            {
+                ++mismatch;
+            }
+        }
+
+        const int repeat = std::max( 1, 20000 / size );
+        volatile int sink = 0;
+
+        const double linear_time
+            = measure( repeat, queries.size(),
+                       [&]( const std::size_t q )
+                         {
+                             sink = linear_segment_nearest( segments, queries[q] );
+                         } );
+        const double bvh_time
+            = measure( repeat, queries.size(),
+                       [&]( const std::size_t q )
+                         {
+                             int id = -1;
+                             bvh.nearest( queries[q], accept_all, &id );
+                             sink = id;
+                         } );
+
+        std::cout << size
+                  << "  " << linear_time
+                  << "  " << bvh_time
+                  << std::endl;
+    }
+
+    if ( mismatch > 0 )
+    {
+        std::cerr << "mismatch " << mismatch << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
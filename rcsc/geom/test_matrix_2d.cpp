@@ -32,6 +32,7 @@
 #endif
 
 #include "matrix_2d.h"
+#include "vector_2d_array.h"
 
 #include <rcsc/math_util.h>
 
@@ -48,6 +49,7 @@ class Matrix2DTest
     CPPUNIT_TEST( testScale );
     CPPUNIT_TEST( testRotate );
     CPPUNIT_TEST( testMultiplication );
+    CPPUNIT_TEST( testTransformArray );
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -56,6 +58,7 @@ public:
     void testScale();
     void testRotate();
     void testMultiplication();
+    void testTransformArray();
 };
 
 
@@ -193,6 +196,40 @@ Matrix2DTest::testMultiplication()
     CPPUNIT_ASSERT_DOUBLES_EQUAL( m1.transform( v ).dist( m2.transform( v ) ), 0.0, EPS );
 }
 
+/*-------------------------------------------------------------------*/
+void
+Matrix2DTest::testTransformArray()
+{
+    const rcsc::Matrix2D m
+        = rcsc::Matrix2D::make_translation( 3.0, -2.0 )
+        * rcsc::Matrix2D::make_rotation( 30.0 )
+        * rcsc::Matrix2D::make_scaling( 2.0, 0.5 );
+
+    std::vector< rcsc::Vector2D > points;
+    for ( int i = 0; i < 11; ++i )
+    {
+        points.emplace_back( i * 1.5 - 7.0, 4.0 - i * 0.7 );
+    }
+
+    const rcsc::Vector2DArray src( points );
+    rcsc::Vector2DArray dst;
+    m.transform( src, &dst );
+
+    CPPUNIT_ASSERT_EQUAL( points.size(), dst.size() );
+    for ( std::size_t i = 0; i < points.size(); ++i )
+    {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL( m.transform( points[i] ).dist( dst[i] ), 0.0, EPS );
+    }
+
+    // in place
+    rcsc::Vector2DArray in_place( points );
+    m.transform( in_place, &in_place );
+    for ( std::size_t i = 0; i < points.size(); ++i )
+    {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL( dst[i].dist( in_place[i] ), 0.0, EPS );
+    }
+}
+
 
 /*-------------------------------------------------------------------*/
 /*-------------------------------------------------------------------*/
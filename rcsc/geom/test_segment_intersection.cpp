@@ -0,0 +1,238 @@
+// -*-c++-*-
+
+/*!
+  \file test_segment_intersection.cpp
+  \brief test code for rcsc::SegmentIntersectionDetector
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+#ifdef HAVE_CONFIG
+#include <config.h>
+#endif
+
+#include "segment_intersection.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <algorithm>
+#include <array>
+#include <random>
+
+using rcsc::Vector2D;
+using rcsc::Segment2D;
+using rcsc::SegmentIntersection;
+using rcsc::BruteForceSegmentIntersectionDetector;
+using rcsc::SweepSegmentIntersectionDetector;
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the sorted coordinates of the detected pairs
+ */
+std::vector< std::array< double, 8 > >
+sorted_pairs( const std::vector< SegmentIntersection > & intersections )
+{
+    std::vector< std::array< double, 8 > > result;
+    for ( const SegmentIntersection & i : intersections )
+    {
+        result.push_back( { i.segment0().origin().x, i.segment0().origin().y,
+                            i.segment0().terminal().x, i.segment0().terminal().y,
+                            i.segment1().origin().x, i.segment1().origin().y,
+                            i.segment1().terminal().x, i.segment1().terminal().y } );
+    }
+    std::sort( result.begin(), result.end() );
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief check if both detectors give the same pairs
+ */
+void
+check_same_result( const std::vector< Segment2D > & segments )
+{
+    std::vector< SegmentIntersection > brute_force;
+    std::vector< SegmentIntersection > sweep;
+
+    BruteForceSegmentIntersectionDetector().execute( segments, &brute_force );
+    SweepSegmentIntersectionDetector().execute( segments, &sweep );
+
+    CPPUNIT_ASSERT_EQUAL( brute_force.size(), sweep.size() );
+    CPPUNIT_ASSERT( sorted_pairs( brute_force ) == sorted_pairs( sweep ) );
+}
+
+}
+
+/*!
+  \class SegmentIntersectionTest
+ */
+class SegmentIntersectionTest
+    : public CPPUNIT_NS::TestFixture {
+
+    CPPUNIT_TEST_SUITE( SegmentIntersectionTest );
+    CPPUNIT_TEST( testEmpty );
+    CPPUNIT_TEST( testDegenerate );
+    CPPUNIT_TEST( testRandom );
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testEmpty();
+    void testDegenerate();
+    void testRandom();
+};
+
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION( SegmentIntersectionTest );
+
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SegmentIntersectionTest::testEmpty()
+{
+    std::vector< Segment2D > segments;
+    std::vector< SegmentIntersection > result;
+
+    BruteForceSegmentIntersectionDetector().execute( segments, &result );
+    SweepSegmentIntersectionDetector().execute( segments, &result );
+    CPPUNIT_ASSERT( result.empty() );
+
+    segments.emplace_back( Vector2D( 0.0, 0.0 ), Vector2D( 1.0, 1.0 ) );
+
+    BruteForceSegmentIntersectionDetector().execute( segments, &result );
+    SweepSegmentIntersectionDetector().execute( segments, &result );
+    CPPUNIT_ASSERT( result.empty() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SegmentIntersectionTest::testDegenerate()
+{
+    std::vector< Segment2D > segments;
+
+    // shared terminal points
+    segments.emplace_back( Vector2D( 0.0, 0.0 ), Vector2D( 10.0, 0.0 ) );
+    segments.emplace_back( Vector2D( 10.0, 0.0 ), Vector2D( 10.0, 10.0 ) );
+    segments.emplace_back( Vector2D( 10.0, 10.0 ), Vector2D( 0.0, 0.0 ) );
+
+    // vertical segments on the same line
+    segments.emplace_back( Vector2D( 5.0, -5.0 ), Vector2D( 5.0, 5.0 ) );
+    segments.emplace_back( Vector2D( 5.0, 5.0 ), Vector2D( 5.0, 8.0 ) );
+    segments.emplace_back( Vector2D( 5.0, 9.0 ), Vector2D( 5.0, 12.0 ) );
+
+    // point segments
+    segments.emplace_back( Vector2D( 2.0, 0.0 ), Vector2D( 2.0, 0.0 ) );
+    segments.emplace_back( Vector2D( 2.0, 0.0 ), Vector2D( 2.0, 0.0 ) );
+    segments.emplace_back( Vector2D( 3.0, 1.0 ), Vector2D( 3.0, 1.0 ) );
+
+    // horizontal segment touching the bounding box only
+    segments.emplace_back( Vector2D( 11.0, 10.0 ), Vector2D( 20.0, 10.0 ) );
+
+    check_same_result( segments );
+
+    std::vector< SegmentIntersection > result;
+    SweepSegmentIntersectionDetector().execute( segments, &result );
+    CPPUNIT_ASSERT( ! result.empty() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SegmentIntersectionTest::testRandom()
+{
+    std::mt19937 engine( 1 );
+    std::uniform_real_distribution<> x_dst( -52.5, 52.5 );
+    std::uniform_real_distribution<> y_dst( -34.0, 34.0 );
+    std::uniform_real_distribution<> d_dst( -10.0, 10.0 );
+
+    for ( const int size : { 2, 10, 50, 200 } )
+    {
+        std::vector< Segment2D > segments;
+        std::vector< Segment2D > horizontal;
+        for ( int i = 0; i < size; ++i )
+        {
+            const Vector2D origin( x_dst( engine ), y_dst( engine ) );
+            segments.emplace_back( origin, origin + Vector2D( d_dst( engine ), d_dst( engine ) ) );
+            horizontal.emplace_back( origin, origin + Vector2D( d_dst( engine ) * 5.0, 0.0 ) );
+        }
+
+        check_same_result( segments );
+        check_same_result( horizontal );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*-------------------------------------------------------------------*/
+/*-------------------------------------------------------------------*/
+
+#include <cppunit/BriefTestProgressListener.h>
+//#include <cppunit/TextTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+//#include <cppunit/TextOutputter.h>
+//#include <cppunit/XmlOutputter.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+int
+main( int, char ** )
+{
+    // create the event manager and test controller
+    CPPUNIT_NS::TestResult controller;
+
+    // add a listner that collects test results
+    CPPUNIT_NS::TestResultCollector result;
+    controller.addListener( &result );
+
+    // add a listener that prints dots as test run.
+    CPPUNIT_NS::BriefTestProgressListener progress;
+    controller.addListener( &progress );
+
+    //CPPUNIT_NS::TextTestProgressListener textprog;
+    //controller.addListener( &textprog );
+
+    // add the top suite to the test runner.
+    CPPUNIT_NS::TestRunner runner;
+    runner.addTest( CPPUNIT_NS::TestFactoryRegistry::getRegistry().makeTest() );
+    runner.run( controller );
+
+    // output results in a compiler compatible format
+    CPPUNIT_NS::CompilerOutputter outputter( &result, CPPUNIT_NS::stdCOut() );
+    //CPPUNIT_NS::TextOutputter outputter( &result, CPPUNIT_NS::stdCOut() );
+    //CPPUNIT_NS::XmlOutputter outputter( &result, CPPUNIT_NS::stdCOut() );
+    outputter.write();
+
+    return result.wasSuccessful() ? 0 : 1;
+}
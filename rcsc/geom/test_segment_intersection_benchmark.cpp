@@ -0,0 +1,167 @@
+// -*-c++-*-
+
+/*!
+  \file test_segment_intersection_benchmark.cpp
+  \brief benchmark of rcsc::SegmentIntersectionDetector
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+#ifdef HAVE_CONFIG
+#include <config.h>
+#endif
+
+#include "segment_intersection.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief execute the detector for the same segments repeatedly
+  \return average elapsed time [us]
+ */
+double
+measure( const int repeat,
+         const rcsc::SegmentIntersectionDetector & detector,
+         const std::vector< rcsc::Segment2D > & segments,
+         size_t * count )
+{
+    std::vector< rcsc::SegmentIntersection > intersections;
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for ( int i = 0; i < repeat; ++i )
+    {
+        intersections.clear();
+        detector.execute( segments, &intersections );
+    }
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    *count = intersections.size();
+    return std::chrono::duration< double, std::micro >( end - start ).count() / repeat;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create the random short segments on the pitch
+ */
+std::vector< rcsc::Segment2D >
+create_random( std::mt19937 & engine,
+               const int size )
+{
+    std::uniform_real_distribution<> x_dst( -52.5, 52.5 );
+    std::uniform_real_distribution<> y_dst( -34.0, 34.0 );
+    std::uniform_real_distribution<> d_dst( -5.0, 5.0 );
+
+    std::vector< rcsc::Segment2D > segments;
+    for ( int i = 0; i < size; ++i )
+    {
+        const rcsc::Vector2D origin( x_dst( engine ), y_dst( engine ) );
+        segments.emplace_back( origin, origin + rcsc::Vector2D( d_dst( engine ), d_dst( engine ) ) );
+    }
+    return segments;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create the pass lanes from the ball holder and the movement paths of the players
+ */
+std::vector< rcsc::Segment2D >
+create_pitch( std::mt19937 & engine,
+              const int size )
+{
+    std::uniform_real_distribution<> x_dst( -40.0, 40.0 );
+    std::uniform_real_distribution<> y_dst( -30.0, 30.0 );
+    std::uniform_real_distribution<> dir_dst( -180.0, 180.0 );
+    std::uniform_real_distribution<> pass_dst( 5.0, 30.0 );
+    std::uniform_real_distribution<> move_dst( 1.0, 8.0 );
+
+    std::vector< rcsc::Vector2D > players;
+    for ( int i = 0; i < 22; ++i )
+    {
+        players.emplace_back( x_dst( engine ), y_dst( engine ) );
+    }
+
+    // a half of the segments are the pass lanes from the ball holder,
+    // and the others are the movement paths of all players.
+    const rcsc::Vector2D ball = players.front();
+    std::vector< rcsc::Segment2D > segments;
+    for ( int i = 0; i < size; ++i )
+    {
+        if ( i % 2 == 0 )
+        {
+            segments.emplace_back( ball, ball + rcsc::Vector2D::polar2vector( pass_dst( engine ), dir_dst( engine ) ) );
+        }
+        else
+        {
+            const rcsc::Vector2D & p = players[i % players.size()];
+            segments.emplace_back( p, p + rcsc::Vector2D::polar2vector( move_dst( engine ), dir_dst( engine ) ) );
+        }
+    }
+    return segments;
+}
+
+}
+
+int
+main()
+{
+    std::mt19937 engine( 1 );
+
+    const rcsc::BruteForceSegmentIntersectionDetector brute_force;
+    const rcsc::SweepSegmentIntersectionDetector sweep;
+
+    std::cout << "input  segments  BruteForce[us]  Sweep[us]  intersections" << std::endl;
+
+    for ( const char * input : { "random", "pitch" } )
+    {
+        for ( const int size : { 50, 100, 300, 1000 } )
+        {
+            const std::vector< rcsc::Segment2D > segments
+                = ( input[0] == 'r'
+                    ? create_random( engine, size )
+                    : create_pitch( engine, size ) );
+
+            const int repeat = 2000000 / ( size * size ) + 1;
+
+            size_t brute_force_count = 0;
+            size_t sweep_count = 0;
+            const double brute_force_time = measure( repeat, brute_force, segments, &brute_force_count );
+            const double sweep_time = measure( repeat, sweep, segments, &sweep_count );
+
+            std::cout << input
+                      << "  " << size
+                      << "  " << brute_force_time
+                      << "  " << sweep_time
+                      << "  " << brute_force_count
+                      << '/' << sweep_count
+                      << std::endl;
+        }
+    }
+
+    return 0;
+}
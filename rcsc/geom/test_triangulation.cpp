@@ -0,0 +1,292 @@
+// -*-c++-*-
+
+/*!
+  \file test_triangulation.cpp
+  \brief test code for rcsc::Triangulation
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+#ifdef HAVE_CONFIG
+#include <config.h>
+#endif
+
+#include "triangulation.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace rcsc;
+
+class TriangulationTest
+    : public CPPUNIT_NS::TestFixture {
+
+    CPPUNIT_TEST_SUITE( TriangulationTest );
+    CPPUNIT_TEST( testBackend );
+    CPPUNIT_TEST( testReuse );
+    CPPUNIT_TEST( testConstraint );
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testBackend();
+    void testReuse();
+    void testConstraint();
+};
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION( TriangulationTest );
+
+namespace {
+
+typedef std::set< std::array< size_t, 3 > > TriangleSet;
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the triangles as the sorted index triples
+ */
+TriangleSet
+triangle_set( const Triangulation & t )
+{
+    TriangleSet result;
+    for ( const Triangulation::Triangle & tri : t.triangles() )
+    {
+        std::array< size_t, 3 > v = { { tri.v0_, tri.v1_, tri.v2_ } };
+        std::sort( v.begin(), v.end() );
+        result.insert( v );
+    }
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the edges as the sorted index pairs
+ */
+std::set< Triangulation::Segment >
+edge_set( const Triangulation & t )
+{
+    std::set< Triangulation::Segment > result;
+    for ( const Triangulation::Segment & e : t.edges() )
+    {
+        result.insert( Triangulation::Segment( std::min( e.first, e.second ),
+                                               std::max( e.first, e.second ) ) );
+    }
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create random points in the pitch
+ */
+std::vector< Vector2D >
+random_points( std::mt19937 & engine,
+               const int size )
+{
+    std::uniform_real_distribution<> x_dst( -52.5, 52.5 );
+    std::uniform_real_distribution<> y_dst( -34.0, 34.0 );
+
+    std::vector< Vector2D > points;
+    for ( int i = 0; i < size; ++i )
+    {
+        points.emplace_back( x_dst( engine ), y_dst( engine ) );
+    }
+    return points;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TriangulationTest::testBackend()
+{
+    std::mt19937 engine( 1 );
+
+    Triangulation triangle;
+    Triangulation delaunay;
+    delaunay.setBackend( Triangulation::DELAUNAY );
+
+    CPPUNIT_ASSERT( triangle.backend() == Triangulation::TRIANGLE );
+    CPPUNIT_ASSERT( delaunay.backend() == Triangulation::DELAUNAY );
+
+    for ( const int size : { 3, 4, 20, 100, 1000 } )
+    {
+        const std::vector< Vector2D > points = random_points( engine, size );
+
+        triangle.clear();
+        triangle.addPoints( points );
+        triangle.compute();
+
+        delaunay.clear();
+        delaunay.addPoints( points );
+        delaunay.compute();
+
+        CPPUNIT_ASSERT( ! triangle.triangles().empty() );
+
+        // the Delaunay triangulation is unique for the random points,
+        // but DELAUNAY may lose the thin triangles on the convex hull.
+        const TriangleSet triangle_result = triangle_set( triangle );
+        const TriangleSet delaunay_result = triangle_set( delaunay );
+        CPPUNIT_ASSERT( std::includes( triangle_result.begin(), triangle_result.end(),
+                                       delaunay_result.begin(), delaunay_result.end() ) );
+        CPPUNIT_ASSERT( triangle_result.size() <= delaunay_result.size() + 1 );
+
+        if ( size <= 100 )
+        {
+            CPPUNIT_ASSERT( triangle_result == delaunay_result );
+            CPPUNIT_ASSERT( edge_set( triangle ) == edge_set( delaunay ) );
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TriangulationTest::testReuse()
+{
+    std::mt19937 engine( 2 );
+
+    for ( const Triangulation::Backend backend : { Triangulation::TRIANGLE, Triangulation::DELAUNAY } )
+    {
+        Triangulation reused;
+        reused.setBackend( backend );
+
+        // the buffers allocated for the large input are reused for the small input.
+        for ( const int size : { 1000, 22, 100, 22, 3 } )
+        {
+            const std::vector< Vector2D > points = random_points( engine, size );
+
+            reused.clear();
+            reused.addPoints( points );
+            reused.compute();
+
+            Triangulation fresh;
+            fresh.setBackend( backend );
+            fresh.addPoints( points );
+            fresh.compute();
+
+            CPPUNIT_ASSERT( triangle_set( reused ) == triangle_set( fresh ) );
+            CPPUNIT_ASSERT( edge_set( reused ) == edge_set( fresh ) );
+        }
+
+        reused.clear();
+        reused.addPoint( Vector2D( 0.0, 0.0 ) );
+        reused.addPoint( Vector2D( 1.0, 0.0 ) );
+        reused.compute();
+
+        CPPUNIT_ASSERT( reused.triangles().empty() );
+        CPPUNIT_ASSERT( reused.edges().empty() );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TriangulationTest::testConstraint()
+{
+    //
+    //  3       2
+    //  +-------+
+    //  |  4    |
+    //  |     5 |
+    //  +-------+
+    //  0       1
+    //
+    const std::vector< Vector2D > points = { Vector2D( 0.0, 0.0 ),
+                                             Vector2D( 10.0, 0.0 ),
+                                             Vector2D( 10.0, 10.0 ),
+                                             Vector2D( 0.0, 10.0 ),
+                                             Vector2D( 3.0, 6.0 ),
+                                             Vector2D( 7.0, 4.0 ) };
+
+    Triangulation triangle;
+    triangle.addPoints( points );
+    CPPUNIT_ASSERT( triangle.addConstraint( 0, 2 ) );
+    triangle.compute();
+
+    // DELAUNAY does not support the constraints, and TRIANGLE is used.
+    Triangulation delaunay;
+    delaunay.setBackend( Triangulation::DELAUNAY );
+    delaunay.addPoints( points );
+    CPPUNIT_ASSERT( delaunay.addConstraint( 0, 2 ) );
+    delaunay.compute();
+
+    CPPUNIT_ASSERT( edge_set( triangle ).count( Triangulation::Segment( 0, 2 ) ) == 1 );
+    CPPUNIT_ASSERT( triangle_set( triangle ) == triangle_set( delaunay ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*-------------------------------------------------------------------*/
+/*-------------------------------------------------------------------*/
+
+#include <cppunit/BriefTestProgressListener.h>
+//#include <cppunit/TextTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+//#include <cppunit/TextOutputter.h>
+//#include <cppunit/XmlOutputter.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+int
+main( int, char ** )
+{
+    // create the event manager and test controller
+    CPPUNIT_NS::TestResult controller;
+
+    // add a listner that collects test results
+    CPPUNIT_NS::TestResultCollector result;
+    controller.addListener( &result );
+
+    // add a listener that prints dots as test run.
+    CPPUNIT_NS::BriefTestProgressListener progress;
+    controller.addListener( &progress );
+
+    //CPPUNIT_NS::TextTestProgressListener textprog;
+    //controller.addListener( &textprog );
+
+    // add the top suite to the test runner.
+    CPPUNIT_NS::TestRunner runner;
+    runner.addTest( CPPUNIT_NS::TestFactoryRegistry::getRegistry().makeTest() );
+    runner.run( controller );
+
+    // output results in a compiler compatible format
+    CPPUNIT_NS::CompilerOutputter outputter( &result, CPPUNIT_NS::stdCOut() );
+    //CPPUNIT_NS::TextOutputter outputter( &result, CPPUNIT_NS::stdCOut() );
+    //CPPUNIT_NS::XmlOutputter outputter( &result, CPPUNIT_NS::stdCOut() );
+    outputter.write();
+
+    return result.wasSuccessful() ? 0 : 1;
+}
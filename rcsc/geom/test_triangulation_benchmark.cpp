@@ -0,0 +1,127 @@
+// -*-c++-*-
+
+/*!
+  \file test_triangulation_benchmark.cpp
+  \brief benchmark of the rcsc::Triangulation backends
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+#ifdef HAVE_CONFIG
+#include <config.h>
+#endif
+
+#include "triangulation.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief compute the triangulation of the same points repeatedly
+  \return average elapsed time [us]
+ */
+template < typename Func >
+double
+measure( const int repeat,
+         Func func )
+{
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for ( int i = 0; i < repeat; ++i )
+    {
+        func();
+    }
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration< double, std::micro >( end - start ).count() / repeat;
+}
+
+}
+
+int
+main()
+{
+    std::mt19937 engine( 1 );
+    std::uniform_real_distribution<> x_dst( -52.5, 52.5 );
+    std::uniform_real_distribution<> y_dst( -34.0, 34.0 );
+
+    // the objects are reused as the per-cycle computation in the agent.
+    rcsc::Triangulation triangle;
+    rcsc::Triangulation delaunay;
+    delaunay.setBackend( rcsc::Triangulation::DELAUNAY );
+
+    std::cout << "points  TRIANGLE(new object)[us]  TRIANGLE[us]  DELAUNAY[us]  triangles" << std::endl;
+
+    for ( const int size : { 20, 100, 1000 } )
+    {
+        std::vector< rcsc::Vector2D > points;
+        for ( int i = 0; i < size; ++i )
+        {
+            points.emplace_back( x_dst( engine ), y_dst( engine ) );
+        }
+
+        const int repeat = 200000 / size;
+
+        const double new_object_time
+            = measure( repeat,
+                       [&]()
+                         {
+                             rcsc::Triangulation t;
+                             t.addPoints( points );
+                             t.compute();
+                         } );
+
+        const double triangle_time
+            = measure( repeat,
+                       [&]()
+                         {
+                             triangle.clear();
+                             triangle.addPoints( points );
+                             triangle.compute();
+                         } );
+
+        const double delaunay_time
+            = measure( repeat,
+                       [&]()
+                         {
+                             delaunay.clear();
+                             delaunay.addPoints( points );
+                             delaunay.compute();
+                         } );
+
+        std::cout << size
+                  << "  " << new_object_time
+                  << "  " << triangle_time
+                  << "  " << delaunay_time
+                  << "  " << triangle.triangles().size()
+                  << '/' << delaunay.triangles().size()
+                  << std::endl;
+    }
+
+    return 0;
+}
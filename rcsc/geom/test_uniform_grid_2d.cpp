@@ -0,0 +1,269 @@
+// -*-c++-*-
+
+/*!
+  \file test_uniform_grid_2d.cpp
+  \brief test code for rcsc::UniformGrid2D
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+#ifdef HAVE_CONFIG
+#include <config.h>
+#endif
+
+#include "uniform_grid_2d.h"
+
+#include <rcsc/math_util.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <vector>
+#include <cstdlib>
+
+using rcsc::EPS;
+
+class UniformGrid2DTest
+    : public CPPUNIT_NS::TestFixture {
+
+    CPPUNIT_TEST_SUITE( UniformGrid2DTest );
+    CPPUNIT_TEST( testNearest );
+    CPPUNIT_TEST( testKNearest );
+    CPPUNIT_TEST( testWithinCircle );
+    CPPUNIT_TEST( testWithinRect );
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+
+    std::vector< rcsc::Vector2D > M_points;
+    rcsc::UniformGrid2D< int > * M_grid;
+
+public:
+
+    void setUp();
+    void tearDown();
+
+    void testNearest();
+    void testKNearest();
+    void testWithinCircle();
+    void testWithinRect();
+};
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION( UniformGrid2DTest );
+
+namespace {
+
+bool
+accept_all( const int )
+{
+    return true;
+}
+
+bool
+accept_even( const int i )
+{
+    return i % 2 == 0;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+UniformGrid2DTest::setUp()
+{
+    M_grid = new rcsc::UniformGrid2D< int >( rcsc::Rect2D( rcsc::Vector2D( -60.0, -40.0 ),
+                                                           rcsc::Size2D( 120.0, 80.0 ) ),
+                                             5.0 );
+    std::srand( 12345 );
+    for ( int i = 0; i < 200; ++i )
+    {
+        // include points outside of the grid area
+        M_points.emplace_back( ( std::rand() / double( RAND_MAX ) ) * 140.0 - 70.0,
+                               ( std::rand() / double( RAND_MAX ) ) * 100.0 - 50.0 );
+        M_grid->insert( M_points.back(), i );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+UniformGrid2DTest::tearDown()
+{
+    delete M_grid;
+    M_points.clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+UniformGrid2DTest::testNearest()
+{
+    CPPUNIT_ASSERT_EQUAL( std::size_t( 200 ), M_grid->size() );
+
+    const rcsc::Vector2D queries[] = { rcsc::Vector2D( 0.0, 0.0 ),
+                                       rcsc::Vector2D( 52.0, 33.0 ),
+                                       rcsc::Vector2D( -80.0, 10.0 ),
+                                       rcsc::Vector2D( 10.0, -60.0 ) };
+    for ( const rcsc::Vector2D & q : queries )
+    {
+        int expected = -1;
+        double min_d2 = 1.0e10;
+        for ( std::size_t i = 0; i < M_points.size(); ++i )
+        {
+            if ( i % 2 != 0 ) continue;
+            const double d2 = M_points[i].dist2( q );
+            if ( d2 < min_d2 )
+            {
+                min_d2 = d2;
+                expected = static_cast< int >( i );
+            }
+        }
+
+        int result = -1;
+        double d2 = 0.0;
+        CPPUNIT_ASSERT( M_grid->nearest( q, accept_even, &result, &d2 ) );
+        CPPUNIT_ASSERT_EQUAL( expected, result );
+        CPPUNIT_ASSERT_DOUBLES_EQUAL( min_d2, d2, EPS );
+    }
+
+    int result = -1;
+    CPPUNIT_ASSERT( ! M_grid->nearest( rcsc::Vector2D( 0.0, 0.0 ),
+                                       []( const int ) { return false; },
+                                       &result ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+UniformGrid2DTest::testKNearest()
+{
+    const rcsc::Vector2D q( 20.0, -5.0 );
+
+    std::vector< double > dists;
+    for ( const rcsc::Vector2D & p : M_points )
+    {
+        dists.push_back( p.dist2( q ) );
+    }
+    std::sort( dists.begin(), dists.end() );
+
+    rcsc::UniformGrid2D< int >::Result result;
+    CPPUNIT_ASSERT( M_grid->kNearest( q, 5, accept_all, &result ) );
+    CPPUNIT_ASSERT_EQUAL( std::size_t( 5 ), result.size() );
+    for ( std::size_t i = 0; i < result.size(); ++i )
+    {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL( dists[i], result[i].first, EPS );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+UniformGrid2DTest::testWithinCircle()
+{
+    const rcsc::Vector2D c( -10.0, 10.0 );
+    const double r = 12.0;
+
+    std::size_t expected = 0;
+    for ( const rcsc::Vector2D & p : M_points )
+    {
+        if ( p.dist2( c ) <= r * r ) ++expected;
+    }
+
+    rcsc::UniformGrid2D< int >::Result result;
+    CPPUNIT_ASSERT_EQUAL( expected, M_grid->withinCircle( c, r, accept_all, &result ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+UniformGrid2DTest::testWithinRect()
+{
+    const rcsc::Rect2D rect( rcsc::Vector2D( -70.0, -20.0 ), rcsc::Size2D( 40.0, 30.0 ) );
+
+    std::size_t expected = 0;
+    for ( const rcsc::Vector2D & p : M_points )
+    {
+        if ( rect.contains( p ) ) ++expected;
+    }
+
+    rcsc::UniformGrid2D< int >::Result result;
+    CPPUNIT_ASSERT_EQUAL( expected, M_grid->withinRect( rect, accept_all, &result ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*-------------------------------------------------------------------*/
+/*-------------------------------------------------------------------*/
+
+#include <cppunit/BriefTestProgressListener.h>
+//#include <cppunit/TextTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+//#include <cppunit/TextOutputter.h>
+//#include <cppunit/XmlOutputter.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+int
+main( int, char ** )
+{
+    // create the event manager and test controller
+    CPPUNIT_NS::TestResult controller;
+
+    // add a listner that collects test results
+    CPPUNIT_NS::TestResultCollector result;
+    controller.addListener( &result );
+
+    // add a listener that prints dots as test run.
+    CPPUNIT_NS::BriefTestProgressListener progress;
+    controller.addListener( &progress );
+
+    //CPPUNIT_NS::TextTestProgressListener textprog;
+    //controller.addListener( &textprog );
+
+    // add the top suite to the test runner.
+    CPPUNIT_NS::TestRunner runner;
+    runner.addTest( CPPUNIT_NS::TestFactoryRegistry::getRegistry().makeTest() );
+    runner.run( controller );
+
+    // output results in a compiler compatible format
+    CPPUNIT_NS::CompilerOutputter outputter( &result, CPPUNIT_NS::stdCOut() );
+    //CPPUNIT_NS::TextOutputter outputter( &result, CPPUNIT_NS::stdCOut() );
+    //CPPUNIT_NS::XmlOutputter outputter( &result, CPPUNIT_NS::stdCOut() );
+    outputter.write();
+
+    return result.wasSuccessful() ? 0 : 1;
+}
@@ -41,6 +41,8 @@
 
 using rcsc::Vector2D;
 using rcsc::AngleDeg;
+using rcsc::ExactTrig;
+using rcsc::FastTrig;
 
 namespace {
 
@@ -79,6 +81,7 @@ class Vector2DTest
     CPPUNIT_TEST( testDistance );
     CPPUNIT_TEST( testEquals );
     CPPUNIT_TEST( testRotate );
+    CPPUNIT_TEST( testFastTrig );
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -92,6 +95,7 @@ protected:
     void testDistance();
     void testEquals();
     void testRotate();
+    void testFastTrig();
 };
 
 
@@ -213,6 +217,40 @@ Vector2DTest::testRotate()
     CPPUNIT_ASSERT_DOUBLES_EQUAL( ( v.th() + rot ).degree(), v2.th().degree(), 1.0e-5 );
 }
 
+/*-------------------------------------------------------------------*/
+void
+Vector2DTest::testFastTrig()
+{
+    for ( int i = -3600; i <= 3600; ++i )
+    {
+        const AngleDeg a = i * 0.37;
+        CPPUNIT_ASSERT_DOUBLES_EQUAL( a.sin(), a.sin< FastTrig >(), 4.0e-7 );
+        CPPUNIT_ASSERT_DOUBLES_EQUAL( a.cos(), a.cos< FastTrig >(), 4.0e-7 );
+        CPPUNIT_ASSERT_EQUAL( a.sin(), a.sin< ExactTrig >() );
+        CPPUNIT_ASSERT_EQUAL( a.cos(), a.cos< ExactTrig >() );
+
+        const double deg = i * 0.37 * 100.0;
+        double s, c;
+        FastTrig::sin_cos_deg( deg, &s, &c );
+        CPPUNIT_ASSERT_DOUBLES_EQUAL( AngleDeg::sin_deg( deg ), s, 4.0e-7 );
+        CPPUNIT_ASSERT_DOUBLES_EQUAL( AngleDeg::cos_deg( deg ), c, 4.0e-7 );
+
+        const Vector2D v = Vector2D::polar2vector( 1.0 + ( i & 15 ), a );
+        CPPUNIT_ASSERT_DOUBLES_EQUAL( v.th().degree(), v.th< FastTrig >().degree(), 1.0e-6 );
+
+        const Vector2D fv = Vector2D::polar2vector< FastTrig >( 1.0 + ( i & 15 ), a );
+        CPPUNIT_ASSERT( v.dist( fv ) < 1.0e-5 );
+
+        const Vector2D rv = v.rotatedVector< FastTrig >( a );
+        CPPUNIT_ASSERT( v.rotatedVector( a ).dist( rv ) < 1.0e-5 );
+    }
+
+    CPPUNIT_ASSERT_EQUAL( 0.0, Vector2D( 0.0, 0.0 ).th< FastTrig >().degree() );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL( 90.0, Vector2D( 0.0, 2.0 ).th< FastTrig >().degree(), 1.0e-6 );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL( 180.0, Vector2D( -2.0, 0.0 ).th< FastTrig >().degree(), 1.0e-6 );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL( -135.0, Vector2D( -2.0, -2.0 ).th< FastTrig >().degree(), 1.0e-6 );
+}
+
 /*-------------------------------------------------------------------*/
 /*-------------------------------------------------------------------*/
 /*-------------------------------------------------------------------*/
@@ -0,0 +1,572 @@
+// -*-c++-*-
+
+/*!
+  \file test_vector_2d_array.cpp
+  \brief test code for rcsc::Vector2DArray
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "vector_2d_array.h"
+
+#include <rcsc/geom/circle_2d.h>
+#include <rcsc/geom/composite_region_2d.h>
+#include <rcsc/geom/polygon_2d.h>
+#include <rcsc/geom/rect_2d.h>
+#include <rcsc/geom/sector_2d.h>
+#include <rcsc/geom/segment_2d.h>
+#include <rcsc/geom/triangle_2d.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <vector>
+#include <random>
+#include <cstdint>
+#include <cmath>
+
+using rcsc::Vector2D;
+using rcsc::Vector2DArray;
+using rcsc::AngleDeg;
+
+namespace {
+
+/*!
+  \brief create the random points
+  \param n the number of points
+  \return point container
+ */
+std::vector< Vector2D >
+create_points( const std::size_t n )
+{
+    std::mt19937 engine( 1 );
+    std::uniform_real_distribution<> dst( -60.0, 60.0 );
+
+    std::vector< Vector2D > points;
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        points.emplace_back( dst( engine ), dst( engine ) );
+    }
+
+    // the values on the borders of the test regions
+    points.emplace_back( 0.0, 0.0 );
+    points.emplace_back( -10.0, 20.0 );
+    points.emplace_back( 30.0, -5.0 );
+    points.emplace_back( 10.0, 0.0 );
+    return points;
+}
+
+/*!
+  \brief check if the batch result is the same as the result for each point
+  \param region target region
+  \param points checked points
+ */
+void
+check_contains_many( const rcsc::Region2D & region,
+                     const std::vector< Vector2D > & points )
+{
+    const Vector2DArray array( points );
+
+    std::vector< char > result;
+    const std::size_t count = region.containsMany( array, &result );
+    CPPUNIT_ASSERT_EQUAL( count, region.containsMany( array, nullptr ) );
+    CPPUNIT_ASSERT_EQUAL( points.size(), result.size() );
+
+    std::size_t expected = 0;
+    for ( std::size_t i = 0; i < points.size(); ++i )
+    {
+        CPPUNIT_ASSERT_EQUAL( region.contains( points[i] ), result[i] != 0 );
+        expected += result[i];
+    }
+    CPPUNIT_ASSERT_EQUAL( expected, count );
+}
+
+}
+
+
+/*!
+  \class Vector2DArrayTest
+ */
+class Vector2DArrayTest
+    : public CPPUNIT_NS::TestFixture {
+
+    CPPUNIT_TEST_SUITE( Vector2DArrayTest );
+    CPPUNIT_TEST( testAssign );
+    CPPUNIT_TEST( testTransform );
+    CPPUNIT_TEST( testDistance );
+    CPPUNIT_TEST( testReduction );
+    CPPUNIT_TEST( testSegment );
+    CPPUNIT_TEST( testContains );
+    CPPUNIT_TEST( testContainsMany );
+    CPPUNIT_TEST( testSinCos );
+    CPPUNIT_TEST( testAtan2 );
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void setUp();
+    void tearDown();
+
+protected:
+
+    void testAssign();
+    void testTransform();
+    void testDistance();
+    void testReduction();
+    void testSegment();
+    void testContains();
+    void testContainsMany();
+    void testSinCos();
+    void testAtan2();
+};
+
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Vector2DArrayTest );
+
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Vector2DArrayTest::setUp()
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Vector2DArrayTest::tearDown()
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Vector2DArrayTest::testAssign()
+{
+    const std::vector< Vector2D > points = create_points( 101 );
+    const Vector2DArray array( points );
+
+    CPPUNIT_ASSERT_EQUAL( points.size(), array.size() );
+    CPPUNIT_ASSERT_EQUAL( std::uintptr_t( 0 ),
+                          reinterpret_cast< std::uintptr_t >( array.xData() ) % Vector2DArray::ALIGNMENT );
+    CPPUNIT_ASSERT_EQUAL( std::uintptr_t( 0 ),
+                          reinterpret_cast< std::uintptr_t >( array.yData() ) % Vector2DArray::ALIGNMENT );
+
+    std::vector< Vector2D > copied;
+    array.toVector( &copied );
+    CPPUNIT_ASSERT_EQUAL( points.size(), copied.size() );
+    for ( std::size_t i = 0; i < points.size(); ++i )
+    {
+        CPPUNIT_ASSERT( copied[i] == points[i] );
+        CPPUNIT_ASSERT( array[i] == points[i] );
+    }
+
+    const Vector2DArray range( points.begin() + 1, points.begin() + 4 );
+    CPPUNIT_ASSERT_EQUAL( std::size_t( 3 ), range.size() );
+    CPPUNIT_ASSERT( range[0] == points[1] );
+    CPPUNIT_ASSERT( range[2] == points[3] );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Vector2DArrayTest::testTransform()
+{
+    const std::vector< Vector2D > points = create_points( 101 );
+    const AngleDeg angle( 37.0 );
+
+    Vector2DArray array( points );
+    array.translate( 1.5, -2.5 ).rotate( angle ).scale( 0.5 );
+
+    for ( std::size_t i = 0; i < points.size(); ++i )
+    {
+        Vector2D v = points[i] + Vector2D( 1.5, -2.5 );
+        v.rotate( angle );
+        v *= 0.5;
+        CPPUNIT_ASSERT_DOUBLES_EQUAL( v.x, array[i].x, 1.0e-12 );
+        CPPUNIT_ASSERT_DOUBLES_EQUAL( v.y, array[i].y, 1.0e-12 );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Vector2DArrayTest::testDistance()
+{
+    const std::vector< Vector2D > points = create_points( 101 );
+    const Vector2DArray array( points );
+    const Vector2D p( 3.0, -4.0 );
+
+    std::vector< double > d2, d, th;
+    array.dist2( p, &d2 );
+    array.dist( p, &d );
+    array.th( &th );
+
+    CPPUNIT_ASSERT_EQUAL( points.size(), d2.size() );
+    CPPUNIT_ASSERT_EQUAL( points.size(), d.size() );
+    CPPUNIT_ASSERT_EQUAL( points.size(), th.size() );
+
+    for ( std::size_t i = 0; i < points.size(); ++i )
+    {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL( points[i].dist2( p ), d2[i], 1.0e-9 );
+        CPPUNIT_ASSERT_DOUBLES_EQUAL( points[i].dist( p ), d[i], 1.0e-12 );
+        CPPUNIT_ASSERT_DOUBLES_EQUAL( points[i].th().degree(), th[i], 1.0e-10 );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Vector2DArrayTest::testReduction()
+{
+    const Vector2DArray empty;
+    CPPUNIT_ASSERT_EQUAL( -1, empty.nearest( Vector2D( 0.0, 0.0 ) ) );
+
+    const std::vector< Vector2D > points = create_points( 101 );
+    const Vector2DArray array( points );
+    const Vector2D p( 12.0, 7.0 );
+
+    int index = 0;
+    for ( std::size_t i = 1; i < points.size(); ++i )
+    {
+        if ( points[i].dist2( p ) < points[index].dist2( p ) )
+        {
+            index = static_cast< int >( i );
+        }
+    }
+
+    double d2 = 0.0;
+    CPPUNIT_ASSERT_EQUAL( index, array.nearest( p, &d2 ) );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL( points[index].dist2( p ), d2, 1.0e-9 );
+
+    const rcsc::Rect2D expected = rcsc::Polygon2D( points ).getBoundingBox();
+    const rcsc::Rect2D rect = array.getBoundingBox();
+    CPPUNIT_ASSERT_DOUBLES_EQUAL( expected.left(), rect.left(), 1.0e-12 );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL( expected.right(), rect.right(), 1.0e-12 );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL( expected.top(), rect.top(), 1.0e-12 );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL( expected.bottom(), rect.bottom(), 1.0e-12 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Vector2DArrayTest::testSegment()
+{
+    const std::vector< Vector2D > points = create_points( 41 );
+    const Vector2DArray array( points );
+
+    std::vector< double > radius;
+    for ( std::size_t i = 0; i < points.size(); ++i )
+    {
+        radius.push_back( 1.0 + ( i % 7 ) );
+    }
+
+    const std::vector< rcsc::Segment2D > segments = {
+        rcsc::Segment2D( Vector2D( -20.0, -10.0 ), Vector2D( 30.0, 15.0 ) ),
+        rcsc::Segment2D( Vector2D( 40.0, 40.0 ), Vector2D( -40.0, 35.0 ) ),
+        rcsc::Segment2D( Vector2D( 5.0, 5.0 ), Vector2D( 5.0, 5.0 ) ), // degenerated
+    };
+
+    Vector2DArray origins, terminals;
+    std::vector< std::uint64_t > masks;
+
+    for ( const rcsc::Segment2D & s : segments )
+    {
+        origins.push_back( s.origin() );
+        terminals.push_back( s.terminal() );
+
+        std::vector< double > d2;
+        array.segmentDist2( s, &d2 );
+        CPPUNIT_ASSERT_EQUAL( points.size(), d2.size() );
+
+        int index = 0;
+        for ( std::size_t i = 0; i < points.size(); ++i )
+        {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL( s.dist( points[i] ), std::sqrt( d2[i] ), 1.0e-9 );
+            if ( d2[i] < d2[index] ) index = static_cast< int >( i );
+        }
+
+        double min_d2 = 0.0;
+        CPPUNIT_ASSERT_EQUAL( index, array.nearestToSegment( s, &min_d2 ) );
+        CPPUNIT_ASSERT_DOUBLES_EQUAL( d2[index], min_d2, 1.0e-12 );
+
+        std::vector< char > hit;
+        const std::size_t count = array.intersects( s, radius.data(), &hit );
+        std::size_t expected = 0;
+        for ( std::size_t i = 0; i < points.size(); ++i )
+        {
+            CPPUNIT_ASSERT_EQUAL( d2[i] <= radius[i] * radius[i], hit[i] != 0 );
+            expected += hit[i];
+        }
+        CPPUNIT_ASSERT_EQUAL( expected, count );
+    }
+
+    CPPUNIT_ASSERT( array.intersects( origins, terminals, radius.data(), &masks ) );
+    CPPUNIT_ASSERT_EQUAL( segments.size(), masks.size() );
+    for ( std::size_t s = 0; s < segments.size(); ++s )
+    {
+        std::vector< char > hit;
+        array.intersects( segments[s], radius.data(), &hit );
+        for ( std::size_t i = 0; i < points.size(); ++i )
+        {
+            CPPUNIT_ASSERT_EQUAL( hit[i] != 0, ( ( masks[s] >> i ) & 1 ) != 0 );
+        }
+    }
+
+    const Vector2DArray many( create_points( 70 ) );
+    std::vector< double > many_radius( many.size(), 1.0 );
+    CPPUNIT_ASSERT( ! many.intersects( origins, terminals, many_radius.data(), &masks ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Vector2DArrayTest::testContains()
+{
+    const std::vector< Vector2D > points = create_points( 1001 );
+    const Vector2DArray array( points );
+
+    const rcsc::Rect2D rect( Vector2D( -10.0, -5.0 ), rcsc::Size2D( 40.0, 25.0 ) );
+    const rcsc::Circle2D circle( Vector2D( 5.0, 5.0 ), 20.0 );
+
+    std::vector< Vector2D > vertices;
+    vertices.emplace_back( -30.0, -20.0 );
+    vertices.emplace_back( 40.0, -25.0 );
+    vertices.emplace_back( 10.0, 0.5 );
+    vertices.emplace_back( 35.0, 30.0 );
+    vertices.emplace_back( -20.0, 25.0 );
+    const rcsc::Polygon2D polygon( vertices );
+
+    std::vector< char > in_rect, in_circle, in_polygon;
+    const std::size_t n_rect = array.contains( rect, &in_rect );
+    const std::size_t n_circle = array.contains( circle, &in_circle );
+    const std::size_t n_polygon = array.contains( polygon, &in_polygon );
+    CPPUNIT_ASSERT_EQUAL( n_polygon, array.contains( polygon, nullptr ) );
+
+    std::size_t count_rect = 0, count_circle = 0, count_polygon = 0;
+    for ( std::size_t i = 0; i < points.size(); ++i )
+    {
+        CPPUNIT_ASSERT_EQUAL( rect.contains( points[i] ), in_rect[i] != 0 );
+        CPPUNIT_ASSERT_EQUAL( circle.contains( points[i] ), in_circle[i] != 0 );
+        CPPUNIT_ASSERT_EQUAL( polygon.contains( points[i] ), in_polygon[i] != 0 );
+        count_rect += in_rect[i];
+        count_circle += in_circle[i];
+        count_polygon += in_polygon[i];
+    }
+
+    CPPUNIT_ASSERT_EQUAL( count_rect, n_rect );
+    CPPUNIT_ASSERT_EQUAL( count_circle, n_circle );
+    CPPUNIT_ASSERT_EQUAL( count_polygon, n_polygon );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Vector2DArrayTest::testContainsMany()
+{
+    std::vector< Vector2D > points = create_points( 1001 );
+
+    const rcsc::Rect2D rect( Vector2D( -10.0, -5.0 ), rcsc::Size2D( 40.0, 25.0 ) );
+    const rcsc::Circle2D circle( Vector2D( 5.0, 5.0 ), 20.0 );
+    const rcsc::Sector2D narrow( Vector2D( 0.0, 10.0 ), 5.0, 40.0, -60.0, 30.0 );
+    const rcsc::Sector2D wide( Vector2D( 0.0, 10.0 ), 0.0, 40.0, 150.0, -120.0 );
+    const rcsc::Triangle2D triangle( Vector2D( -30.0, -20.0 ), Vector2D( 40.0, -25.0 ), Vector2D( 10.0, 30.0 ) );
+    const rcsc::Triangle2D reversed( Vector2D( 10.0, 30.0 ), Vector2D( 40.0, -25.0 ), Vector2D( -30.0, -20.0 ) );
+
+    std::vector< Vector2D > vertices;
+    vertices.emplace_back( -30.0, -20.0 );
+    vertices.emplace_back( 40.0, -20.0 );
+    vertices.emplace_back( 40.0, 10.0 );
+    vertices.emplace_back( 20.0, 30.0 );
+    vertices.emplace_back( -30.0, 30.0 );
+    const rcsc::Polygon2D convex( vertices );
+    const rcsc::Polygon2D convex_reversed( std::vector< Vector2D >( vertices.rbegin(), vertices.rend() ) );
+
+    // the vertices of the convex polygon
+    points.insert( points.end(), vertices.begin(), vertices.end() );
+
+    // Polygon2D::contains() may not contain the points on the edges
+    std::vector< Vector2D > on_edges = vertices;
+    on_edges.emplace_back( 0.0, -20.0 );
+    on_edges.emplace_back( 40.0, 0.0 );
+    on_edges.emplace_back( 30.0, 20.0 );
+    on_edges.emplace_back( -30.0, 0.0 );
+
+    vertices[2].assign( 10.0, 0.5 );
+    const rcsc::Polygon2D concave( vertices );
+
+    std::vector< Vector2D > star;
+    for ( int i = 0; i < 5; ++i )
+    {
+        star.push_back( Vector2D::polar2vector( 30.0, 90.0 + i * 144.0 ) );
+    }
+    const rcsc::Polygon2D pentagram( star );
+
+    check_contains_many( rect, points );
+    check_contains_many( circle, points );
+    check_contains_many( narrow, points );
+    check_contains_many( wide, points );
+    check_contains_many( triangle, points );
+    check_contains_many( reversed, points );
+    check_contains_many( convex, points );
+    check_contains_many( convex_reversed, points );
+    CPPUNIT_ASSERT_EQUAL( on_edges.size(), convex.containsMany( Vector2DArray( on_edges ), nullptr ) );
+    CPPUNIT_ASSERT_EQUAL( on_edges.size(), convex_reversed.containsMany( Vector2DArray( on_edges ), nullptr ) );
+    check_contains_many( concave, std::vector< Vector2D >( points.begin(), points.begin() + 1005 ) );
+    check_contains_many( pentagram, std::vector< Vector2D >( points.begin(), points.begin() + 1005 ) );
+
+    const rcsc::UnitedRegion2D united( new rcsc::Rect2D( rect ),
+                                       new rcsc::Sector2D( narrow ),
+                                       new rcsc::IntersectedRegion2D( new rcsc::Circle2D( circle ),
+                                                                      new rcsc::Polygon2D( concave ) ) );
+    const rcsc::IntersectedRegion2D intersected( new rcsc::Polygon2D( convex ),
+                                                 new rcsc::Sector2D( wide ) );
+    check_contains_many( united, std::vector< Vector2D >( points.begin(), points.begin() + 1005 ) );
+    check_contains_many( intersected, points );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Vector2DArrayTest::testSinCos()
+{
+    std::vector< double > deg;
+    for ( double d = -1000.0; d <= 1000.0; d += 0.37 )
+    {
+        deg.push_back( d );
+    }
+    for ( double d = -720.0; d <= 720.0; d += 45.0 )
+    {
+        deg.push_back( d );
+    }
+
+    std::vector< double > s( deg.size() ), c( deg.size() );
+    AngleDeg::sin_cos_deg( deg.data(), deg.size(), s.data(), c.data() );
+
+    for ( std::size_t i = 0; i < deg.size(); ++i )
+    {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL( AngleDeg::sin_deg( deg[i] ), s[i], 1.0e-13 );
+        CPPUNIT_ASSERT_DOUBLES_EQUAL( AngleDeg::cos_deg( deg[i] ), c[i], 1.0e-13 );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Vector2DArrayTest::testAtan2()
+{
+    std::vector< double > x, y;
+    for ( int i = -20; i <= 20; ++i )
+    {
+        for ( int j = -20; j <= 20; ++j )
+        {
+            x.push_back( i * 0.731 );
+            y.push_back( j * 1.093 );
+        }
+    }
+    x.push_back( 1.0e-300 ); y.push_back( 1.0e-300 );
+    x.push_back( -5.0 ); y.push_back( 0.0 );
+    x.push_back( 0.0 ); y.push_back( -3.0 );
+
+    std::vector< double > deg( x.size() );
+    AngleDeg::atan2_deg( y.data(), x.data(), x.size(), deg.data() );
+
+    for ( std::size_t i = 0; i < x.size(); ++i )
+    {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL( AngleDeg::atan2_deg( y[i], x[i] ), deg[i], 1.0e-12 );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*-------------------------------------------------------------------*/
+/*-------------------------------------------------------------------*/
+
+#include <cppunit/BriefTestProgressListener.h>
+//#include <cppunit/TextTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+//#include <cppunit/TextOutputter.h>
+//#include <cppunit/XmlOutputter.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+int
+main( int, char ** )
+{
+    // create the event manager and test controller
+    CPPUNIT_NS::TestResult controller;
+
+    // add a listner that collects test results
+    CPPUNIT_NS::TestResultCollector result;
+    controller.addListener( &result );
+
+    // add a listener that prints dots as test run.
+    CPPUNIT_NS::BriefTestProgressListener progress;
+    controller.addListener( &progress );
+
+    //CPPUNIT_NS::TextTestProgressListener textprog;
+    //controller.addListener( &textprog );
+
+    // add the top suite to the test runner.
+    CPPUNIT_NS::TestRunner runner;
+    runner.addTest( CPPUNIT_NS::TestFactoryRegistry::getRegistry().makeTest() );
+    runner.run( controller );
+
+    // output results in a compiler compatible format
+    CPPUNIT_NS::CompilerOutputter outputter( &result, CPPUNIT_NS::stdCOut() );
+    //CPPUNIT_NS::TextOutputter outputter( &result, CPPUNIT_NS::stdCOut() );
+    //CPPUNIT_NS::XmlOutputter outputter( &result, CPPUNIT_NS::stdCOut() );
+    outputter.write();
+
+    return result.wasSuccessful() ? 0 : 1;
+}
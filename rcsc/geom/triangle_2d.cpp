@@ -38,6 +38,7 @@
 #include "line_2d.h"
 #include "ray_2d.h"
 #include "segment_2d.h"
+#include "vector_2d_array.h"
 
 #include <cmath>
 
@@ -358,4 +359,15 @@ Triangle2D::contains( const Vector2D & a,
     return false;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::size_t
+Triangle2D::containsMany( const Vector2DArray & points,
+                          std::vector< char > * result ) const
+{
+    return points.contains( *this, result );
+}
+
 }
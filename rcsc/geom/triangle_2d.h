@@ -210,6 +210,16 @@ public:
     virtual
     bool contains( const Vector2D & point ) const;
 
+    /*!
+      \brief check if this triangle contains each point.
+      \param points considered points
+      \param result pointer to the result variable. may be NULL. 1 if contained, otherwise 0.
+      \return the number of contained points
+    */
+    virtual
+    std::size_t containsMany( const Vector2DArray & points,
+                              std::vector< char > * result ) const;
+
     /*!
       \brief get the center of gravity(centroid, JUU-SIN)
       \return coordinates of gravity center
@@ -36,6 +36,7 @@
 
 #include "triangulation.h"
 
+#include "delaunay_triangulation.h"
 #include "triangle/triangle.h"
 
 #include <vector>
@@ -57,6 +58,27 @@ namespace rcsc {
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+Triangulation::Triangulation()
+    : M_backend( TRIANGLE )
+    , M_use_triangles( true )
+    , M_use_edges( true )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+Triangulation::~Triangulation()
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 Triangulation::clear()
@@ -166,20 +188,38 @@ Triangulation::compute()
     M_triangles.clear();
     M_edges.clear();
 
-    const PointCont & points = M_points;
-    const size_t points_size = points.size();
-
-    const SegmentSet & constraints = M_constraints;
-    const size_t constraints_size = constraints.size();
-
     //
     // check enough points exist or not
     //
-    if ( points_size < 3 )
+    if ( M_points.size() < 3 )
     {
         return;
     }
 
+    if ( M_backend == DELAUNAY
+         && M_constraints.empty() )
+    {
+        computeByDelaunay();
+    }
+    else
+    {
+        computeByTriangle();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+Triangulation::computeByTriangle()
+{
+    const PointCont & points = M_points;
+    const size_t points_size = points.size();
+
+    const SegmentSet & constraints = M_constraints;
+    const size_t constraints_size = constraints.size();
+
     //
     // make input data
     //
@@ -189,15 +229,17 @@ Triangulation::compute()
     //
     // set point list
     //
-    in.numberofpoints = points_size;
-    in.pointlist = static_cast< REAL * >( std::malloc( in.numberofpoints * 2 * sizeof( REAL ) ) );
+    M_point_buffer.resize( points_size * 2 );
 
     for ( size_t i = 0; i < points_size; ++i )
     {
-        in.pointlist[i * 2    ] = static_cast< REAL >( points[i].x );
-        in.pointlist[i * 2 + 1] = static_cast< REAL >( points[i].y );
+        M_point_buffer[i * 2    ] = static_cast< REAL >( points[i].x );
+        M_point_buffer[i * 2 + 1] = static_cast< REAL >( points[i].y );
     }
 
+    in.numberofpoints = points_size;
+    in.pointlist = M_point_buffer.data();
+
     //
     // set attribute
     //
@@ -217,18 +259,18 @@ Triangulation::compute()
     in.numberofsegments = constraints_size;
     if ( constraints_size > 0 )
     {
-        in.segmentlist = static_cast< int * >( std::malloc( in.numberofsegments * 2 * sizeof( int ) ) );
+        M_segment_buffer.resize( constraints_size * 2 );
 
         size_t i = 0;
         for ( SegmentSet::const_iterator c = constraints.begin(), end = constraints.end();
               c != end;
               ++c, ++i )
         {
-            in.segmentlist[i * 2]     = static_cast< int >( c->first );
-            in.segmentlist[i * 2 + 1] = static_cast< int >( c->second );
-
-            //std::cerr << "set constraints " << c->first << ' ' << c->second << std::endl;
+            M_segment_buffer[i * 2]     = static_cast< int >( c->first );
+            M_segment_buffer[i * 2 + 1] = static_cast< int >( c->second );
         }
+
+        in.segmentlist = M_segment_buffer.data();
     }
 
 
@@ -246,6 +288,23 @@ Triangulation::compute()
     struct triangulateio out;
     std::memset( &out, 0, sizeof( out ) );
 
+    //
+    // Triangle allocates the output lists only if they are NULL.
+    // the buffers are given with the upper bound size, 2n triangles and 3n edges.
+    // the intersection of the constraints may become a new vertex.
+    //
+    const size_t max_vertices = points_size + constraints_size * ( constraints_size - 1 ) / 2;
+    if ( M_use_triangles )
+    {
+        M_triangle_buffer.resize( max_vertices * 2 * 3 );
+        out.trianglelist = M_triangle_buffer.data();
+    }
+    if ( M_use_edges )
+    {
+        M_edge_buffer.resize( max_vertices * 3 * 2 );
+        out.edgelist = M_edge_buffer.data();
+    }
+
 
     //
     // create triangulation
@@ -284,18 +343,6 @@ Triangulation::compute()
         }
     }
 
-//     if ( constraints_size > 0 )
-//     {
-//         const int number_of_segments = out.numberofsegments;
-//         M_result_segments.reserve( number_of_segments );
-
-//         for ( int i = 0; i < number_of_segments; ++i )
-//         {
-//             M_result_segments.emplace_back( static_cast< size_t >( out.segmentlist[i * 2] ),
-//                                             static_cast< size_t >( out.segmentlist[i * 2 + 1] ) );
-//         }
-//     }
-
     //
     // set result edges
     //
@@ -315,24 +362,55 @@ Triangulation::compute()
     //
     // finalize
     //
-    std::free( in.pointlist );
     if ( constraints_size > 0 )
     {
-        std::free( in.segmentlist );
+        std::free( out.segmentlist );
     }
+}
 
-    //std::free( out.pointlist );
-    if ( M_use_triangles )
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+Triangulation::computeByDelaunay()
+{
+    if ( ! M_delaunay )
     {
-        std::free( out.trianglelist );
+        M_delaunay.reset( new DelaunayTriangulation() );
     }
-    if ( constraints_size > 0 )
+
+    // the edge and triangle instances are reused after clear().
+    DelaunayTriangulation & delaunay = *M_delaunay;
+    delaunay.clear();
+    delaunay.addVertices( M_points );
+    delaunay.compute();
+
+    //
+    // the vertex id is the index in M_points.
+    //
+
+    if ( M_use_triangles )
     {
-        std::free( out.segmentlist );
+        M_triangles.reserve( delaunay.triangles().size() );
+
+        for ( const DelaunayTriangulation::TriangleCont::value_type & t : delaunay.triangles() )
+        {
+            M_triangles.emplace_back( static_cast< size_t >( t.second->vertex( 0 )->id() ),
+                                      static_cast< size_t >( t.second->vertex( 1 )->id() ),
+                                      static_cast< size_t >( t.second->vertex( 2 )->id() ) );
+        }
     }
+
     if ( M_use_edges )
     {
-        std::free( out.edgelist );
+        M_edges.reserve( delaunay.edges().size() );
+
+        for ( const DelaunayTriangulation::EdgeCont::value_type & e : delaunay.edges() )
+        {
+            M_edges.emplace_back( static_cast< size_t >( e.second->vertex( 0 )->id() ),
+                                  static_cast< size_t >( e.second->vertex( 1 )->id() ) );
+        }
     }
 }
 
@@ -32,17 +32,34 @@
 
 #include <rcsc/geom/vector_2d.h>
 
+#include <memory>
 #include <vector>
 #include <set>
 
 namespace rcsc {
 
+class DelaunayTriangulation;
+
 /*!
   \class Triangulation
   \brief (Constrained Delaunay) triangulation class
+
+  The triangulation is computed by the backend selected by setBackend().
+  The object keeps the work buffers between compute() calls, so that the
+  per-cycle computation should reuse the same object.
  */
 class Triangulation {
 public:
+
+    /*!
+      \enum Backend
+      \brief triangulation implementation
+     */
+    enum Backend {
+        TRIANGLE, //!< bundled Triangle library (default). supports the constraints.
+        DELAUNAY, //!< rcsc::DelaunayTriangulation. no constraint.
+    };
+
     /*!
       \struct Triangle
       \brief triangle object type for Triangulation.
@@ -75,6 +92,7 @@ public:
 
 private:
 
+    Backend M_backend; //!< selected backend
     bool M_use_triangles; //!< switch to determine whether result triangules are stored or not (default: true).
     bool M_use_edges; //!< switch to determine whether result edges are stored or not (default: true).
 
@@ -88,14 +106,31 @@ private:
     TriangleCont M_triangles; //!< result triangles
     SegmentCont M_edges; //!< result triangle edges
 
+    //
+    // work buffers reused between compute() calls
+    //
+
+    std::vector< double > M_point_buffer; //!< input point list for TRIANGLE
+    std::vector< int > M_segment_buffer; //!< input segment list for TRIANGLE
+    std::vector< int > M_triangle_buffer; //!< output triangle list for TRIANGLE
+    std::vector< int > M_edge_buffer; //!< output edge list for TRIANGLE
+
+    std::unique_ptr< DelaunayTriangulation > M_delaunay; //!< DELAUNAY backend instance
+
+    // not used
+    Triangulation( const Triangulation & ) = delete;
+    Triangulation & operator=( const Triangulation & ) = delete;
+
 public:
     /*!
       \brief create null triangulation object.
     */
-    Triangulation()
-        : M_use_triangles( true )
-        , M_use_edges( true )
-      { }
+    Triangulation();
+
+    /*!
+      \brief destruct the backend instance
+     */
+    ~Triangulation();
 
     /*!
       \brief clear all data.
@@ -143,6 +178,29 @@ public:
           return M_edges;
       }
 
+    /*!
+      \brief get the selected backend
+      \return backend type
+     */
+    Backend backend() const
+      {
+          return M_backend;
+      }
+
+    /*!
+      \brief select the backend used by compute().
+      \param backend backend type
+
+      DELAUNAY does not support the constraints. If any constraint is added,
+      compute() uses TRIANGLE regardless of this setting.
+      DELAUNAY may lose the thin triangles on the convex hull, because
+      its initial super triangle is finite.
+     */
+    void setBackend( const Backend backend )
+      {
+          M_backend = backend;
+      }
+
     /*!
       \brief set use_triangles property.
       \param on property value.
@@ -201,6 +259,18 @@ public:
       \return index of the nearest point. if not found, returns -1.
      */
     int findNearestPoint( const Vector2D & point ) const;
+
+private:
+
+    /*!
+      \brief generates triangulation by the Triangle library.
+    */
+    void computeByTriangle();
+
+    /*!
+      \brief generates triangulation by DelaunayTriangulation.
+    */
+    void computeByDelaunay();
 };
 
 }
@@ -0,0 +1,419 @@
+// -*-c++-*-
+
+/*!
+  \file uniform_grid_2d.h
+  \brief uniform grid spatial index Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_GEOM_UNIFORM_GRID_2D_H
+#define RCSC_GEOM_UNIFORM_GRID_2D_H
+
+#include <rcsc/geom/rect_2d.h>
+#include <rcsc/geom/vector_2d.h>
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace rcsc {
+
+/*!
+  \class UniformGrid2D
+  \brief bucket grid over a rectangle area for point proximity queries.
+
+  Each element is a pair of a position and a user value (e.g. a player pointer).
+  Points outside of the area are stored in the nearest border cell, so that
+  every query still returns the exact result.
+  clear() keeps the allocated memory, so rebuilding the grid in every cycle
+  does not allocate after the first few cycles.
+*/
+template < typename T >
+class UniformGrid2D {
+public:
+
+    //! element type
+    typedef std::pair< Vector2D, T > Entry;
+
+    //! query result type. the first element is the squared distance.
+    typedef std::vector< std::pair< double, T > > Result;
+
+private:
+
+    double M_min_x; //!< left x of the area
+    double M_min_y; //!< top y of the area
+    double M_cell_size; //!< length of each cell side
+    int M_cols; //!< number of cells along x
+    int M_rows; //!< number of cells along y
+
+    std::vector< std::vector< Entry > > M_cells; //!< element buckets
+    std::size_t M_size; //!< number of elements
+
+public:
+
+    /*!
+      \brief create a grid
+      \param area covered area
+      \param cell_size length of each cell side
+    */
+    UniformGrid2D( const Rect2D & area,
+                   const double cell_size )
+        : M_min_x( area.minX() ),
+          M_min_y( area.minY() ),
+          M_cell_size( std::max( 0.01, cell_size ) ),
+          M_cols( std::max( 1, static_cast< int >( std::ceil( area.size().length() / M_cell_size ) ) ) ),
+          M_rows( std::max( 1, static_cast< int >( std::ceil( area.size().width() / M_cell_size ) ) ) ),
+          M_cells( M_cols * M_rows ),
+          M_size( 0 )
+      { }
+
+    /*!
+      \brief remove all elements. allocated memory is kept.
+    */
+    void clear()
+      {
+          for ( std::vector< Entry > & c : M_cells )
+          {
+              c.clear();
+          }
+          M_size = 0;
+      }
+
+    /*!
+      \brief add an element
+      \param pos element position
+      \param value user value
+    */
+    void insert( const Vector2D & pos,
+                 const T & value )
+      {
+          M_cells[cellIndex( col( pos.x ), row( pos.y ) )].emplace_back( pos, value );
+          ++M_size;
+      }
+
+    /*!
+      \brief get the number of elements
+      \return element count
+    */
+    std::size_t size() const
+      {
+          return M_size;
+      }
+
+    /*!
+      \brief get the length of each cell side
+      \return cell size
+    */
+    double cellSize() const
+      {
+          return M_cell_size;
+      }
+
+    /*!
+      \brief find the nearest element that satisfies the predicate
+      \param point query point
+      \param pred predicate called as pred( const T & )
+      \param result pointer to the variable to store the found value
+      \param dist2 pointer to the variable to store the squared distance. may be NULL.
+      \return true if found
+    */
+    template < typename Predicate >
+    bool nearest( const Vector2D & point,
+                  Predicate pred,
+                  T * result,
+                  double * dist2 = nullptr ) const
+      {
+          if ( M_size == 0 )
+          {
+              return false;
+          }
+
+          const int c0 = col( point.x );
+          const int r0 = row( point.y );
+          const int max_ring = maxRing( c0, r0 );
+
+          const Entry * best = nullptr;
+          double best_d2 = std::numeric_limits< double >::max();
+
+          for ( int ring = 0; ring <= max_ring; ++ring )
+          {
+              forEachRingCell( c0, r0, ring,
+                               [&]( const std::vector< Entry > & cell )
+                                 {
+                                     for ( const Entry & e : cell )
+                                     {
+                                         const double d2 = e.first.dist2( point );
+                                         if ( d2 < best_d2 && pred( e.second ) )
+                                         {
+                                             best = &e;
+                                             best_d2 = d2;
+                                         }
+                                     }
+                                 } );
+
+              if ( best )
+              {
+                  const double bound = ringBound( point, c0, r0, ring );
+                  if ( best_d2 <= bound * bound )
+                  {
+                      break;
+                  }
+              }
+          }
+
+          if ( ! best )
+          {
+              return false;
+          }
+
+          *result = best->second;
+          if ( dist2 ) *dist2 = best_d2;
+          return true;
+      }
+
+    /*!
+      \brief find k nearest elements that satisfy the predicate
+      \param point query point
+      \param k number of wanted elements
+      \param pred predicate called as pred( const T & )
+      \param result pointer to the result container, sorted by the distance
+      \return true if at least one element is found
+    */
+    template < typename Predicate >
+    bool kNearest( const Vector2D & point,
+                   const std::size_t k,
+                   Predicate pred,
+                   Result * result ) const
+      {
+          result->clear();
+          if ( k == 0 || M_size == 0 )
+          {
+              return false;
+          }
+
+          const int c0 = col( point.x );
+          const int r0 = row( point.y );
+          const int max_ring = maxRing( c0, r0 );
+
+          for ( int ring = 0; ring <= max_ring; ++ring )
+          {
+              forEachRingCell( c0, r0, ring,
+                               [&]( const std::vector< Entry > & cell )
+                                 {
+                                     collect( cell, point, pred, result );
+                                 } );
+
+              if ( result->size() >= k )
+              {
+                  // every element outside of the searched rings is farther than this bound.
+                  std::partial_sort( result->begin(), result->begin() + k, result->end(), less );
+                  const double bound = ringBound( point, c0, r0, ring );
+                  if ( ( *result )[k-1].first <= bound * bound )
+                  {
+                      result->resize( k );
+                      return true;
+                  }
+              }
+          }
+
+          std::sort( result->begin(), result->end(), less );
+          if ( result->size() > k )
+          {
+              result->resize( k );
+          }
+          return ! result->empty();
+      }
+
+    /*!
+      \brief find all elements within the circle that satisfy the predicate
+      \param center center of the circle
+      \param r radius of the circle
+      \param pred predicate called as pred( const T & )
+      \param result pointer to the result container. the order is undefined.
+      \return number of found elements
+    */
+    template < typename Predicate >
+    std::size_t withinCircle( const Vector2D & center,
+                              const double r,
+                              Predicate pred,
+                              Result * result ) const
+      {
+          result->clear();
+          const double r2 = r * r;
+          const int c_min = col( center.x - r ), c_max = col( center.x + r );
+          const int r_min = row( center.y - r ), r_max = row( center.y + r );
+          for ( int rr = r_min; rr <= r_max; ++rr )
+          {
+              for ( int cc = c_min; cc <= c_max; ++cc )
+              {
+                  for ( const Entry & e : M_cells[cellIndex( cc, rr )] )
+                  {
+                      const double d2 = e.first.dist2( center );
+                      if ( d2 <= r2 && pred( e.second ) )
+                      {
+                          result->emplace_back( d2, e.second );
+                      }
+                  }
+              }
+          }
+          return result->size();
+      }
+
+    /*!
+      \brief find all elements within the rectangle that satisfy the predicate
+      \param rect query rectangle
+      \param pred predicate called as pred( const T & )
+      \param result pointer to the result container. the order is undefined.
+      \return number of found elements. the first value of each result is 0.
+    */
+    template < typename Predicate >
+    std::size_t withinRect( const Rect2D & rect,
+                            Predicate pred,
+                            Result * result ) const
+      {
+          result->clear();
+          const int c_min = col( rect.minX() ), c_max = col( rect.maxX() );
+          const int r_min = row( rect.minY() ), r_max = row( rect.maxY() );
+          for ( int rr = r_min; rr <= r_max; ++rr )
+          {
+              for ( int cc = c_min; cc <= c_max; ++cc )
+              {
+                  for ( const Entry & e : M_cells[cellIndex( cc, rr )] )
+                  {
+                      if ( rect.minX() <= e.first.x && e.first.x <= rect.maxX()
+                           && rect.minY() <= e.first.y && e.first.y <= rect.maxY()
+                           && pred( e.second ) )
+                      {
+                          result->emplace_back( 0.0, e.second );
+                      }
+                  }
+              }
+          }
+          return result->size();
+      }
+
+private:
+
+    int col( const double x ) const
+      {
+          const int c = static_cast< int >( std::floor( ( x - M_min_x ) / M_cell_size ) );
+          return std::min( std::max( c, 0 ), M_cols - 1 );
+      }
+
+    int row( const double y ) const
+      {
+          const int r = static_cast< int >( std::floor( ( y - M_min_y ) / M_cell_size ) );
+          return std::min( std::max( r, 0 ), M_rows - 1 );
+      }
+
+    int cellIndex( const int c,
+                   const int r ) const
+      {
+          return r * M_cols + c;
+      }
+
+    int maxRing( const int c0,
+                 const int r0 ) const
+      {
+          return std::max( std::max( c0, M_cols - 1 - c0 ),
+                           std::max( r0, M_rows - 1 - r0 ) );
+      }
+
+    /*!
+      \brief call the function for each cell on the square ring around (c0,r0).
+     */
+    template < typename Func >
+    void forEachRingCell( const int c0,
+                          const int r0,
+                          const int ring,
+                          Func func ) const
+      {
+          if ( ring == 0 )
+          {
+              func( M_cells[cellIndex( c0, r0 )] );
+              return;
+          }
+
+          for ( int r = r0 - ring; r <= r0 + ring; ++r )
+          {
+              if ( r < 0 || M_rows <= r ) continue;
+              const bool edge_row = ( r == r0 - ring || r == r0 + ring );
+              for ( int c = c0 - ring; c <= c0 + ring; c += ( edge_row ? 1 : 2 * ring ) )
+              {
+                  if ( 0 <= c && c < M_cols )
+                  {
+                      func( M_cells[cellIndex( c, r )] );
+                  }
+              }
+          }
+      }
+
+    static
+    bool less( const std::pair< double, T > & lhs,
+               const std::pair< double, T > & rhs )
+      {
+          return lhs.first < rhs.first;
+      }
+
+    /*!
+      \brief get the minimum distance from the point to the outside of the searched rings.
+     */
+    double ringBound( const Vector2D & point,
+                      const int c0,
+                      const int r0,
+                      const int ring ) const
+      {
+          double bound = std::numeric_limits< double >::max();
+          // border cells hold the clamped outside points, so only inner sides give a bound.
+          if ( c0 - ring > 0 ) bound = std::min( bound, point.x - ( M_min_x + ( c0 - ring ) * M_cell_size ) );
+          if ( c0 + ring < M_cols - 1 ) bound = std::min( bound, ( M_min_x + ( c0 + ring + 1 ) * M_cell_size ) - point.x );
+          if ( r0 - ring > 0 ) bound = std::min( bound, point.y - ( M_min_y + ( r0 - ring ) * M_cell_size ) );
+          if ( r0 + ring < M_rows - 1 ) bound = std::min( bound, ( M_min_y + ( r0 + ring + 1 ) * M_cell_size ) - point.y );
+          return std::max( 0.0, bound );
+      }
+
+    template < typename Predicate >
+    static
+    void collect( const std::vector< Entry > & cell,
+                  const Vector2D & point,
+                  Predicate & pred,
+                  Result * result )
+      {
+          for ( const Entry & e : cell )
+          {
+              if ( pred( e.second ) )
+              {
+                  result->emplace_back( e.first.dist2( point ), e.second );
+              }
+          }
+      }
+};
+
+}
+
+#endif
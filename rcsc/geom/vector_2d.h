@@ -119,6 +119,24 @@ public:
           return *this;
       }
 
+    /*!
+      \brief assign XY value from POLAR value by the trigonometric policy.
+      \tparam Trig ExactTrig or FastTrig
+      \param radius vector's radius
+      \param dir vector's angle
+      \return reference to itself
+    */
+    template < typename Trig >
+    Vector2D & setPolar( const double radius,
+                         const AngleDeg & dir )
+      {
+          double s, c;
+          Trig::sin_cos_deg( dir.degree(), &s, &c );
+          x = radius * c;
+          y = radius * s;
+          return *this;
+      }
+
     /*!
       \brief invalidate this object
       \return this
@@ -194,6 +212,17 @@ public:
           return AngleDeg( AngleDeg::atan2_deg( y, x ) );
       }
 
+    /*!
+      \brief get the angle of vector by the trigonometric policy.
+      \tparam Trig ExactTrig or FastTrig
+      \return angle
+    */
+    template < typename Trig >
+    AngleDeg th() const
+      {
+          return AngleDeg( Trig::atan2_deg( y, x ) );
+      }
+
     /*!
       \brief get the angle of vector. this method is equivalent to th().
       \return angle
@@ -499,6 +528,45 @@ public:
           return Vector2D( *this ).rotate( angle.degree() );
       }
 
+    /*!
+      \brief rotate this vector with 'deg' by the trigonometric policy.
+      \tparam Trig ExactTrig or FastTrig
+      \param deg rotated angle by double type
+      \return reference to itself
+    */
+    template < typename Trig >
+    Vector2D & rotate( const double deg )
+      {
+          double s, c;
+          Trig::sin_cos_deg( deg, &s, &c );
+          return assign( this->x * c - this->y * s,
+                         this->x * s + this->y * c );
+      }
+
+    /*!
+      \brief rotate this vector with 'angle' by the trigonometric policy.
+      \tparam Trig ExactTrig or FastTrig
+      \param angle rotated angle
+      \return reference to itself
+    */
+    template < typename Trig >
+    Vector2D & rotate( const AngleDeg & angle )
+      {
+          return rotate< Trig >( angle.degree() );
+      }
+
+    /*!
+      \brief get new vector that is rotated by 'angle' by the trigonometric policy.
+      \tparam Trig ExactTrig or FastTrig
+      \param angle rotated angle.
+      \return new vector rotated by 'angle'
+    */
+    template < typename Trig >
+    Vector2D rotatedVector( const AngleDeg & angle ) const
+      {
+          return Vector2D( *this ).rotate< Trig >( angle.degree() );
+      }
+
     /*!
       \brief set vector's angle to 'angle'
       \param dir new angle to be set
@@ -583,6 +651,23 @@ public:
           return Vector2D( mag * theta.cos(), mag * theta.sin() );
       }
 
+    /*!
+      \brief get new Vector created by POLAR value by the trigonometric policy.
+      \tparam Trig ExactTrig or FastTrig
+      \param mag length of vector
+      \param theta angle of vector
+      \return new vector object
+    */
+    template < typename Trig >
+    static
+    Vector2D polar2vector( const double mag,
+                           const AngleDeg & theta )
+      {
+          double s, c;
+          Trig::sin_cos_deg( theta.degree(), &s, &c );
+          return Vector2D( mag * c, mag * s );
+      }
+
     /*!
       \brief get new Vector created by POLAR value.
       \param mag length of vector
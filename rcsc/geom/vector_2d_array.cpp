@@ -0,0 +1,751 @@
+// -*-c++-*-
+
+/*!
+  \file vector_2d_array.cpp
+  \brief structure of arrays of 2D vectors Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "vector_2d_array.h"
+
+#include <rcsc/geom/circle_2d.h>
+#include <rcsc/geom/polygon_2d.h>
+#include <rcsc/geom/rect_2d.h>
+#include <rcsc/geom/sector_2d.h>
+#include <rcsc/geom/segment_2d.h>
+#include <rcsc/geom/triangle_2d.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace rcsc {
+
+constexpr std::size_t Vector2DArray::ALIGNMENT;
+
+namespace {
+
+/*!
+  \brief convert the flags to the result
+  \param flags the flags. 1.0 or 0.0.
+  \param n the number of flags
+  \param result pointer to the result variable. may be NULL.
+  \return the number of true flags
+
+  The containment kernels write the flags as double, because the loop
+  that mixes double and char is not vectorized.
+*/
+std::size_t
+store_flags( const double * flags,
+             const std::size_t n,
+             std::vector< char > * result )
+{
+    if ( result )
+    {
+        result->resize( n );
+    }
+
+    std::size_t count = 0;
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        const char f = static_cast< char >( flags[i] );
+        count += f;
+        if ( result )
+        {
+            ( *result )[i] = f;
+        }
+    }
+
+    return count;
+}
+
+/*!
+  \brief check if the polygon is convex
+  \param vertices the vertices of the polygon
+  \return 1 if counterclockwise, -1 if clockwise, 0 if not convex.
+
+  The polygon is convex if all vertices turn to the same side and
+  the vertices go round only once, i.e. not a pentagram.
+  The collinear and the duplicated vertices are allowed.
+*/
+int
+convex_orientation( const std::vector< Vector2D > & vertices )
+{
+    const std::size_t size = vertices.size();
+
+    int sign = 0;
+    double turn = 0.0;
+    for ( std::size_t i = 0; i < size; ++i )
+    {
+        const Vector2D d0 = vertices[( i + 1 ) % size] - vertices[i];
+        const Vector2D d1 = vertices[( i + 2 ) % size] - vertices[( i + 1 ) % size];
+
+        const double cross = d0.outerProduct( d1 );
+        const int s = ( cross > 0.0 ? 1 : cross < 0.0 ? -1 : 0 );
+        if ( s != 0 )
+        {
+            if ( sign != 0 && s != sign )
+            {
+                return 0;
+            }
+            sign = s;
+        }
+
+        if ( d0.r2() > 0.0 && d1.r2() > 0.0 )
+        {
+            turn += std::fabs( ( d1.th() - d0.th() ).degree() );
+        }
+    }
+
+    return ( turn < 360.0 + 1.0e-6 ? sign : 0 );
+}
+
+/*!
+  \brief compute the squared distances from the points to the segment
+  \param x X coordinates of the points
+  \param y Y coordinates of the points
+  \param n the number of points
+  \param ax X coordinate of the segment origin
+  \param ay Y coordinate of the segment origin
+  \param bx X coordinate of the segment terminal
+  \param by Y coordinate of the segment terminal
+  \param out result array
+
+  The projection parameter is clamped by min/max instead of the branches,
+  so that the compiler can vectorize the loop.
+*/
+void
+segment_dist2( const double * x,
+               const double * y,
+               const std::size_t n,
+               const double ax,
+               const double ay,
+               const double bx,
+               const double by,
+               double * out )
+{
+    const double vx = bx - ax;
+    const double vy = by - ay;
+    const double len2 = vx * vx + vy * vy;
+    const double inv_len2 = ( len2 > 0.0 ? 1.0 / len2 : 0.0 );
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        const double px = x[i] - ax;
+        const double py = y[i] - ay;
+        const double t = std::min( std::max( ( px * vx + py * vy ) * inv_len2, 0.0 ), 1.0 );
+        const double dx = px - t * vx;
+        const double dy = py - t * vy;
+        out[i] = dx * dx + dy * dy;
+    }
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+Vector2DArray::Vector2DArray()
+    : M_x(),
+      M_y()
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+Vector2DArray::Vector2DArray( const std::vector< Vector2D > & v )
+    : M_x(),
+      M_y()
+{
+    assign( v );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Vector2DArray::toVector( std::vector< Vector2D > * result ) const
+{
+    result->clear();
+    result->reserve( size() );
+    for ( std::size_t i = 0; i < size(); ++i )
+    {
+        result->emplace_back( M_x[i], M_y[i] );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+Vector2DArray &
+Vector2DArray::translate( const double dx,
+                          const double dy )
+{
+    const std::size_t n = size();
+    double * const x = M_x.data();
+    double * const y = M_y.data();
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        x[i] += dx;
+        y[i] += dy;
+    }
+
+    return *this;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+Vector2DArray &
+Vector2DArray::rotate( const AngleDeg & angle )
+{
+    const std::size_t n = size();
+    double * const x = M_x.data();
+    double * const y = M_y.data();
+    const double c = std::cos( angle.degree() * AngleDeg::DEG2RAD );
+    const double s = std::sin( angle.degree() * AngleDeg::DEG2RAD );
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        const double old_x = x[i];
+        x[i] = old_x * c - y[i] * s;
+        y[i] = old_x * s + y[i] * c;
+    }
+
+    return *this;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+Vector2DArray &
+Vector2DArray::scale( const double rate )
+{
+    const std::size_t n = size();
+    double * const x = M_x.data();
+    double * const y = M_y.data();
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        x[i] *= rate;
+        y[i] *= rate;
+    }
+
+    return *this;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Vector2DArray::dist2( const Vector2D & p,
+                      std::vector< double > * result ) const
+{
+    const std::size_t n = size();
+    const double * const x = M_x.data();
+    const double * const y = M_y.data();
+    const double px = p.x;
+    const double py = p.y;
+
+    result->resize( n );
+    double * const out = result->data();
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        const double dx = x[i] - px;
+        const double dy = y[i] - py;
+        out[i] = dx * dx + dy * dy;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Vector2DArray::dist( const Vector2D & p,
+                     std::vector< double > * result ) const
+{
+    dist2( p, result );
+
+    // std::sqrt may set errno, so this loop is not vectorized.
+    // it is separated from the vectorized loop in dist2().
+    for ( double & v : *result )
+    {
+        v = std::sqrt( v );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Vector2DArray::th( std::vector< double > * result ) const
+{
+    result->resize( size() );
+    AngleDeg::atan2_deg( M_y.data(), M_x.data(), size(), result->data() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+Vector2DArray::nearest( const Vector2D & p,
+                        double * dist2 ) const
+{
+    const std::size_t n = size();
+    if ( n == 0 )
+    {
+        return -1;
+    }
+
+    const double * const x = M_x.data();
+    const double * const y = M_y.data();
+    const double px = p.x;
+    const double py = p.y;
+
+    // the floating point minimum is not vectorized without -ffast-math,
+    // because the vectorizer cannot reorder the comparisons.
+    double min_d2 = DBL_MAX;
+    int min_index = 0;
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        const double dx = x[i] - px;
+        const double dy = y[i] - py;
+        const double d2 = dx * dx + dy * dy;
+        if ( d2 < min_d2 )
+        {
+            min_d2 = d2;
+            min_index = static_cast< int >( i );
+        }
+    }
+
+    if ( dist2 )
+    {
+        *dist2 = Vector2D( x[min_index], y[min_index] ).dist2( p );
+    }
+
+    return min_index;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+Rect2D
+Vector2DArray::getBoundingBox() const
+{
+    const std::size_t n = size();
+    if ( n == 0 )
+    {
+        return Rect2D();
+    }
+
+    const double * const x = M_x.data();
+    const double * const y = M_y.data();
+
+    double min_x = x[0];
+    double max_x = x[0];
+    double min_y = y[0];
+    double max_y = y[0];
+
+    for ( std::size_t i = 1; i < n; ++i )
+    {
+        min_x = std::min( min_x, x[i] );
+        max_x = std::max( max_x, x[i] );
+        min_y = std::min( min_y, y[i] );
+        max_y = std::max( max_y, y[i] );
+    }
+
+    return Rect2D::from_corners( min_x, min_y, max_x, max_y );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Vector2DArray::segmentDist2( const Segment2D & segment,
+                             std::vector< double > * result ) const
+{
+    result->resize( size() );
+    segment_dist2( M_x.data(), M_y.data(), size(),
+                   segment.origin().x, segment.origin().y,
+                   segment.terminal().x, segment.terminal().y,
+                   result->data() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+Vector2DArray::nearestToSegment( const Segment2D & segment,
+                                 double * dist2 ) const
+{
+    const std::size_t n = size();
+    if ( n == 0 )
+    {
+        return -1;
+    }
+
+    Cont d2( n );
+    segment_dist2( M_x.data(), M_y.data(), n,
+                   segment.origin().x, segment.origin().y,
+                   segment.terminal().x, segment.terminal().y,
+                   d2.data() );
+
+    const int min_index = static_cast< int >( std::min_element( d2.begin(), d2.end() ) - d2.begin() );
+
+    if ( dist2 )
+    {
+        *dist2 = d2[min_index];
+    }
+
+    return min_index;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::size_t
+Vector2DArray::intersects( const Segment2D & segment,
+                           const double * radius,
+                           std::vector< char > * result ) const
+{
+    const std::size_t n = size();
+
+    Cont flags( n );
+    double * const f = flags.data();
+
+    segment_dist2( M_x.data(), M_y.data(), n,
+                   segment.origin().x, segment.origin().y,
+                   segment.terminal().x, segment.terminal().y,
+                   f );
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        f[i] = double( f[i] <= radius[i] * radius[i] );
+    }
+
+    return store_flags( f, n, result );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+Vector2DArray::intersects( const Vector2DArray & origins,
+                           const Vector2DArray & terminals,
+                           const double * radius,
+                           std::vector< std::uint64_t > * result ) const
+{
+    constexpr std::size_t MAX_CIRCLES = 64;
+
+    const std::size_t n = size();
+    if ( n > MAX_CIRCLES )
+    {
+        return false;
+    }
+
+    const std::size_t segment_size = std::min( origins.size(), terminals.size() );
+    result->resize( segment_size );
+
+    double r2[MAX_CIRCLES];
+    for ( std::size_t j = 0; j < n; ++j )
+    {
+        r2[j] = radius[j] * radius[j];
+    }
+
+    double d2[MAX_CIRCLES];
+    for ( std::size_t i = 0; i < segment_size; ++i )
+    {
+        segment_dist2( M_x.data(), M_y.data(), n,
+                       origins.M_x[i], origins.M_y[i],
+                       terminals.M_x[i], terminals.M_y[i],
+                       d2 );
+
+        std::uint64_t mask = 0;
+        for ( std::size_t j = 0; j < n; ++j )
+        {
+            mask |= std::uint64_t( d2[j] <= r2[j] ) << j;
+        }
+        ( *result )[i] = mask;
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::size_t
+Vector2DArray::contains( const Rect2D & rect,
+                         std::vector< char > * result ) const
+{
+    const std::size_t n = size();
+    const double * const x = M_x.data();
+    const double * const y = M_y.data();
+    const double left = rect.left();
+    const double right = rect.right();
+    const double top = rect.top();
+    const double bottom = rect.bottom();
+
+    Cont flags( n );
+    double * const f = flags.data();
+
+    // the sign of the difference is exact, so that this is the same as four comparisons.
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        f[i] = double( std::max( std::max( left - x[i], x[i] - right ),
+                                 std::max( top - y[i], y[i] - bottom ) ) <= 0.0 );
+    }
+
+    return store_flags( f, n, result );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::size_t
+Vector2DArray::contains( const Circle2D & circle,
+                         std::vector< char > * result ) const
+{
+    const std::size_t n = size();
+    const double * const x = M_x.data();
+    const double * const y = M_y.data();
+    const double cx = circle.center().x;
+    const double cy = circle.center().y;
+    const double r2 = circle.radius() * circle.radius();
+
+    Cont flags( n );
+    double * const f = flags.data();
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        const double dx = x[i] - cx;
+        const double dy = y[i] - cy;
+        f[i] = double( dx * dx + dy * dy < r2 );
+    }
+
+    return store_flags( f, n, result );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::size_t
+Vector2DArray::contains( const Sector2D & sector,
+                         std::vector< char > * result ) const
+{
+    const std::size_t n = size();
+    const double * const x = M_x.data();
+    const double * const y = M_y.data();
+    const double cx = sector.center().x;
+    const double cy = sector.center().y;
+    const double min_r2 = sector.radiusMin() * sector.radiusMin();
+    const double max_r2 = sector.radiusMax() * sector.radiusMax();
+    const double left = sector.angleLeftStart().degree();
+    const double right = sector.angleRightEnd().degree();
+
+    Cont rel_x( n );
+    Cont rel_y( n );
+    Cont dir( n );
+    Cont flags( n );
+    double * const rx = rel_x.data();
+    double * const ry = rel_y.data();
+    double * const th = dir.data();
+    double * const f = flags.data();
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        rx[i] = x[i] - cx;
+        ry[i] = y[i] - cy;
+    }
+
+    AngleDeg::atan2_deg( ry, rx, n, th );
+
+    //
+    // AngleDeg::isWithin() without branch.
+    // a.isLeftEqualOf( b ) == ( 0 <= b - a < 180 || b - a < -180 ), and the two
+    // conditions are exclusive, so that the sum of the flags is the logical or.
+    //
+    const bool narrow = sector.angleLeftStart().isLeftEqualOf( sector.angleRightEnd() );
+    const double or_weight = ( narrow ? 0.0 : 1.0 );
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        const double d2 = rx[i] * rx[i] + ry[i] * ry[i];
+        const double left_diff = th[i] - left;
+        const double right_diff = right - th[i];
+        const double after_left = ( double( left_diff >= 0.0 ) * double( left_diff < 180.0 )
+                                    + double( left_diff < -180.0 ) );
+        const double before_right = ( double( right_diff >= 0.0 ) * double( right_diff < 180.0 )
+                                      + double( right_diff < -180.0 ) );
+        // narrow: and, otherwise: or
+        const double within = std::min( 1.0, after_left * before_right
+                                        + or_weight * ( after_left + before_right ) );
+        f[i] = double( min_r2 <= d2 ) * double( d2 <= max_r2 ) * within;
+    }
+
+    return store_flags( f, n, result );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::size_t
+Vector2DArray::contains( const Triangle2D & triangle,
+                         std::vector< char > * result ) const
+{
+    const std::size_t n = size();
+    const double * const x = M_x.data();
+    const double * const y = M_y.data();
+    const double ax = triangle.a().x, ay = triangle.a().y;
+    const double bx = triangle.b().x, by = triangle.b().y;
+    const double cx = triangle.c().x, cy = triangle.c().y;
+
+    Cont flags( n );
+    double * const f = flags.data();
+
+    // the same outer products as Triangle2D::contains()
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        const double ax_i = ax - x[i], ay_i = ay - y[i];
+        const double bx_i = bx - x[i], by_i = by - y[i];
+        const double cx_i = cx - x[i], cy_i = cy - y[i];
+        const double outer1 = ax_i * by_i - ay_i * bx_i;
+        const double outer2 = bx_i * cy_i - by_i * cx_i;
+        const double outer3 = cx_i * ay_i - cy_i * ax_i;
+        const double min_outer = std::min( std::min( outer1, outer2 ), outer3 );
+        const double max_outer = std::max( std::max( outer1, outer2 ), outer3 );
+        f[i] = std::max( double( min_outer >= 0.0 ), double( max_outer <= 0.0 ) );
+    }
+
+    return store_flags( f, n, result );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::size_t
+Vector2DArray::contains( const Polygon2D & polygon,
+                         std::vector< char > * result ) const
+{
+    const std::size_t n = size();
+    const double * const x = M_x.data();
+    const double * const y = M_y.data();
+    const std::vector< Vector2D > & vertices = polygon.vertices();
+
+    Cont flags( n, 0.0 );
+    double * const f = flags.data();
+
+    const int orientation = ( vertices.size() >= 3
+                              ? convex_orientation( vertices )
+                              : 0 );
+    if ( orientation != 0 )
+    {
+        //
+        // the edge function of the convex polygon.
+        // the vector is contained if all edge functions are not negative.
+        //
+        Cont min_edge( n, DBL_MAX );
+        double * const m = min_edge.data();
+
+        for ( std::size_t j = 0, k = vertices.size() - 1; j < vertices.size(); k = j++ )
+        {
+            const double x0 = vertices[k].x;
+            const double y0 = vertices[k].y;
+            const double ex = ( vertices[j].x - x0 ) * orientation;
+            const double ey = ( vertices[j].y - y0 ) * orientation;
+
+            for ( std::size_t i = 0; i < n; ++i )
+            {
+                m[i] = std::min( m[i], ex * ( y[i] - y0 ) - ey * ( x[i] - x0 ) );
+            }
+        }
+
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            f[i] = double( m[i] >= 0.0 );
+        }
+    }
+    else if ( vertices.size() >= 3 )
+    {
+        //
+        // the edge loop is outside, so that the inner loop over the vectors
+        // toggles the flags by the crossing test without branch.
+        //
+        for ( std::size_t j = 0, k = vertices.size() - 1; j < vertices.size(); k = j++ )
+        {
+            const double x0 = vertices[k].x;
+            const double y0 = vertices[k].y;
+            const double x1 = vertices[j].x;
+            const double y1 = vertices[j].y;
+            if ( y0 == y1 )
+            {
+                // a horizontal edge does not cross the half line
+                continue;
+            }
+
+            const double slope = ( x1 - x0 ) / ( y1 - y0 );
+
+            for ( std::size_t i = 0; i < n; ++i )
+            {
+                const double straddle = double( ( y0 <= y[i] ) != ( y1 <= y[i] ) );
+                const double left = double( x[i] < x0 + ( y[i] - y0 ) * slope );
+                f[i] = std::fabs( f[i] - straddle * left ); // exclusive or
+            }
+        }
+    }
+
+    return store_flags( f, n, result );
+}
+
+}
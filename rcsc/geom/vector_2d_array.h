@@ -0,0 +1,451 @@
+// -*-c++-*-
+
+/*!
+  \file vector_2d_array.h
+  \brief structure of arrays of 2D vectors Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_GEOM_VECTOR_2D_ARRAY_H
+#define RCSC_GEOM_VECTOR_2D_ARRAY_H
+
+#include <rcsc/geom/vector_2d.h>
+#include <rcsc/util/aligned_allocator.h>
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace rcsc {
+
+class Circle2D;
+class Polygon2D;
+class Rect2D;
+class Sector2D;
+class Segment2D;
+class Triangle2D;
+
+/*!
+  \class Vector2DArray
+  \brief 2D vectors stored as the separated arrays of X and Y.
+
+  The coordinates are stored in the aligned arrays, and the batch operations
+  are the plain loops without branch, so that the compiler can vectorize them.
+  The reductions, nearest() and getBoundingBox(), are the scalar loops,
+  because the compiler does not reorder the floating point comparisons.
+  The container is used for the geometry loops over many points, e.g. the
+  distances from all players or the region check of the candidate points.
+
+  \code
+  rcsc::Vector2DArray points( candidates ); // std::vector< Vector2D >
+  std::vector< char > in_area;
+  points.contains( polygon, &in_area );
+  \endcode
+*/
+class Vector2DArray {
+public:
+
+    //! the byte alignment of the coordinate arrays
+    static constexpr std::size_t ALIGNMENT = 32;
+
+    //! coordinate array type
+    typedef std::vector< double, AlignedAllocator< double, ALIGNMENT > > Cont;
+
+private:
+
+    Cont M_x; //!< X coordinates
+    Cont M_y; //!< Y coordinates
+
+public:
+
+    /*!
+      \brief create an empty array
+     */
+    Vector2DArray();
+
+    /*!
+      \brief create the array with the vectors
+      \param v source vectors
+     */
+    explicit
+    Vector2DArray( const std::vector< Vector2D > & v );
+
+    /*!
+      \brief create the array with the range of the vectors
+      \param first iterator of the first vector
+      \param last iterator of the end of the vectors
+     */
+    template < typename InputIterator >
+    Vector2DArray( InputIterator first,
+                   InputIterator last )
+      {
+          assign( first, last );
+      }
+
+    /*!
+      \brief set the vectors
+      \param v source vectors
+     */
+    void assign( const std::vector< Vector2D > & v )
+      {
+          assign( v.begin(), v.end() );
+      }
+
+    /*!
+      \brief set the range of the vectors
+      \param first iterator of the first vector
+      \param last iterator of the end of the vectors
+     */
+    template < typename InputIterator >
+    void assign( InputIterator first,
+                 InputIterator last )
+      {
+          clear();
+          for ( ; first != last; ++first )
+          {
+              push_back( *first );
+          }
+      }
+
+    /*!
+      \brief copy the vectors to the array of Vector2D
+      \param result pointer to the result variable
+     */
+    void toVector( std::vector< Vector2D > * result ) const;
+
+    /*!
+      \brief get the number of vectors
+      \return the number of vectors
+     */
+    std::size_t size() const
+      {
+          return M_x.size();
+      }
+
+    /*!
+      \brief check if the array is empty
+      \return checked result
+     */
+    bool empty() const
+      {
+          return M_x.empty();
+      }
+
+    /*!
+      \brief remove all vectors
+     */
+    void clear()
+      {
+          M_x.clear();
+          M_y.clear();
+      }
+
+    /*!
+      \brief reserve the capacity
+      \param n new capacity
+     */
+    void reserve( const std::size_t n )
+      {
+          M_x.reserve( n );
+          M_y.reserve( n );
+      }
+
+    /*!
+      \brief change the number of vectors. new vectors are (0,0).
+      \param n new size
+     */
+    void resize( const std::size_t n )
+      {
+          M_x.resize( n, 0.0 );
+          M_y.resize( n, 0.0 );
+      }
+
+    /*!
+      \brief append the vector
+      \param v new vector
+     */
+    void push_back( const Vector2D & v )
+      {
+          M_x.push_back( v.x );
+          M_y.push_back( v.y );
+      }
+
+    /*!
+      \brief get the vector
+      \param i index of the vector
+      \return copy of the vector
+     */
+    Vector2D operator[]( const std::size_t i ) const
+      {
+          return Vector2D( M_x[i], M_y[i] );
+      }
+
+    /*!
+      \brief set the vector
+      \param i index of the vector
+      \param v new value
+     */
+    void set( const std::size_t i,
+              const Vector2D & v )
+      {
+          M_x[i] = v.x;
+          M_y[i] = v.y;
+      }
+
+    /*!
+      \brief get the X coordinate array
+      \return const pointer to the first X coordinate
+     */
+    const double * xData() const
+      {
+          return M_x.data();
+      }
+
+    /*!
+      \brief get the Y coordinate array
+      \return const pointer to the first Y coordinate
+     */
+    const double * yData() const
+      {
+          return M_y.data();
+      }
+
+    /*!
+      \brief get the X coordinate array
+      \return pointer to the first X coordinate
+     */
+    double * xData()
+      {
+          return M_x.data();
+      }
+
+    /*!
+      \brief get the Y coordinate array
+      \return pointer to the first Y coordinate
+     */
+    double * yData()
+      {
+          return M_y.data();
+      }
+
+    //
+    // transformation
+    //
+
+    /*!
+      \brief move all vectors
+      \param dx moved distance along the X axis
+      \param dy moved distance along the Y axis
+      \return reference to itself
+     */
+    Vector2DArray & translate( const double dx,
+                               const double dy );
+
+    /*!
+      \brief move all vectors
+      \param d moved vector
+      \return reference to itself
+     */
+    Vector2DArray & translate( const Vector2D & d )
+      {
+          return translate( d.x, d.y );
+      }
+
+    /*!
+      \brief rotate all vectors around the origin as Vector2D::rotate() does
+      \param angle rotated angle
+      \return reference to itself
+     */
+    Vector2DArray & rotate( const AngleDeg & angle );
+
+    /*!
+      \brief scale all vectors
+      \param rate scaling factor
+      \return reference to itself
+     */
+    Vector2DArray & scale( const double rate );
+
+    //
+    // batch values
+    //
+
+    /*!
+      \brief get the squared distance from the point to each vector
+      \param p target point
+      \param result pointer to the result variable. resized to size().
+     */
+    void dist2( const Vector2D & p,
+                std::vector< double > * result ) const;
+
+    /*!
+      \brief get the distance from the point to each vector
+      \param p target point
+      \param result pointer to the result variable. resized to size().
+     */
+    void dist( const Vector2D & p,
+               std::vector< double > * result ) const;
+
+    /*!
+      \brief get the direction of each vector by AngleDeg::atan2_deg()
+      \param result pointer to the result variable. resized to size(). degree values.
+     */
+    void th( std::vector< double > * result ) const;
+
+    //
+    // reduction
+    //
+
+    /*!
+      \brief get the index of the nearest vector from the point
+      \param p target point
+      \param dist2 pointer to the variable to store the squared distance. may be NULL.
+      \return index of the nearest vector. the first one if several vectors have the same distance.
+      -1 if the array is empty.
+     */
+    int nearest( const Vector2D & p,
+                 double * dist2 = nullptr ) const;
+
+    /*!
+      \brief get the bounding box of the vectors
+      \return the smallest rectangle that contains all vectors. empty rectangle if no vector.
+     */
+    Rect2D getBoundingBox() const;
+
+    //
+    // segment
+    //
+
+    /*!
+      \brief get the squared distance from each vector to the segment
+      \param segment target segment
+      \param result pointer to the result variable. resized to size().
+
+      The distance is measured to the nearest point on the segment as
+      Segment2D::nearestPoint() does.
+     */
+    void segmentDist2( const Segment2D & segment,
+                       std::vector< double > * result ) const;
+
+    /*!
+      \brief get the index of the nearest vector from the segment
+      \param segment target segment
+      \param dist2 pointer to the variable to store the squared distance. may be NULL.
+      \return index of the nearest vector. -1 if the array is empty.
+     */
+    int nearestToSegment( const Segment2D & segment,
+                          double * dist2 = nullptr ) const;
+
+    /*!
+      \brief check if the circle around each vector intersects the segment.
+      \param segment target segment
+      \param radius the radius of each circle. the array size must be size().
+      \param result pointer to the result variable. may be NULL. 1 if intersected, otherwise 0.
+      \return the number of intersected circles
+
+      The circle intersects the segment if the distance from its center is
+      the radius or less.
+     */
+    std::size_t intersects( const Segment2D & segment,
+                            const double * radius,
+                            std::vector< char > * result ) const;
+
+    /*!
+      \brief check the circles around the vectors against many segments.
+      \param origins origin points of the segments
+      \param terminals terminal points of the segments. the size must be origins.size().
+      \param radius the radius of each circle. the array size must be size().
+      \param result pointer to the result variable. resized to origins.size().
+      bit j of each mask is set if the circle j intersects the segment.
+      \return false if size() is greater than 64.
+
+      e.g. the vectors are the opponent positions, the radii are their
+      reachable distances and the segments are the candidate ball paths.
+     */
+    bool intersects( const Vector2DArray & origins,
+                     const Vector2DArray & terminals,
+                     const double * radius,
+                     std::vector< std::uint64_t > * result ) const;
+
+    //
+    // containment
+    //
+
+    /*!
+      \brief check if each vector is within the rectangle as Rect2D::contains() does.
+      \param rect target rectangle
+      \param result pointer to the result variable. may be NULL. 1 if contained, otherwise 0.
+      \return the number of contained vectors
+     */
+    std::size_t contains( const Rect2D & rect,
+                          std::vector< char > * result ) const;
+
+    /*!
+      \brief check if each vector is within the circle as Circle2D::contains() does.
+      \param circle target circle
+      \param result pointer to the result variable. may be NULL. 1 if contained, otherwise 0.
+      \return the number of contained vectors
+     */
+    std::size_t contains( const Circle2D & circle,
+                          std::vector< char > * result ) const;
+
+    /*!
+      \brief check if each vector is within the sector as Sector2D::contains() does.
+      \param sector target sector
+      \param result pointer to the result variable. may be NULL. 1 if contained, otherwise 0.
+      \return the number of contained vectors
+
+      The directions are calculated by AngleDeg::atan2_deg() for the arrays,
+      so that the result of the vector on the angle boundaries may be different.
+     */
+    std::size_t contains( const Sector2D & sector,
+                          std::vector< char > * result ) const;
+
+    /*!
+      \brief check if each vector is within the triangle as Triangle2D::contains() does.
+      \param triangle target triangle
+      \param result pointer to the result variable. may be NULL. 1 if contained, otherwise 0.
+      \return the number of contained vectors
+     */
+    std::size_t contains( const Triangle2D & triangle,
+                          std::vector< char > * result ) const;
+
+    /*!
+      \brief check if each vector is within the polygon.
+      \param polygon target polygon
+      \param result pointer to the result variable. may be NULL. 1 if contained, otherwise 0.
+      \return the number of contained vectors
+
+      The convex polygon is checked by the edge functions, and the vector on the
+      edges is contained. The other polygon is checked by the even-odd rule,
+      and the result of the vector on the edges is not defined.
+     */
+    std::size_t contains( const Polygon2D & polygon,
+                          std::vector< char > * result ) const;
+};
+
+}
+
+#endif
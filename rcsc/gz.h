@@ -32,8 +32,10 @@
 #ifndef RCSC_GZ_H
 #define RCSC_GZ_H
 
+#include <rcsc/gz/compressed_fstream.h>
 #include <rcsc/gz/gzcompressor.h>
 #include <rcsc/gz/gzfilterstream.h>
 #include <rcsc/gz/gzfstream.h>
+#include <rcsc/gz/gzindex.h>
 
 #endif
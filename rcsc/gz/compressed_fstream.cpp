@@ -0,0 +1,1020 @@
+// -*-c++-*-
+
+/*!
+  \file compressed_fstream.cpp
+  \brief codec independent compressed file stream Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "compressed_fstream.h"
+#include "gzfstream.h"
+
+#ifdef HAVE_LIBZSTD
+#include <zstd.h>
+#endif
+
+#ifdef HAVE_LIBLZ4
+#include <lz4frame.h>
+#endif
+
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+namespace rcsc {
+
+namespace {
+
+//! size of the uncompressed stream buffer
+const std::size_t CODEC_BUFFER_SIZE = 64 * 1024;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ends_with( const char * str,
+           const char * suffix )
+{
+    const std::size_t len = std::strlen( str );
+    const std::size_t suffix_len = std::strlen( suffix );
+    return len >= suffix_len
+        && std::strcmp( str + len - suffix_len, suffix ) == 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+
+/*!
+  \class codec_filebuf
+  \brief base class of the stream buffers for the frame based codecs.
+
+  The derived class implements the codec by encode() and decode().
+  Seeking is supported only for input, by decoding again from the
+  beginning or skipping forward.
+*/
+class codec_filebuf
+    : public std::streambuf {
+protected:
+
+    //! flush mode of encode()
+    enum EncodeMode {
+        ENCODE_CONTINUE, //!< the codec may keep the input internally
+        ENCODE_FLUSH, //!< all input has to be written
+        ENCODE_FINISH, //!< the frame has to be finished
+    };
+
+    std::FILE * M_fp; //!< compressed file
+    bool M_output; //!< true if opened for output
+    bool M_eof; //!< true if the end of file is read
+    bool M_error; //!< true if the codec failed
+
+    std::vector< char > M_buf; //!< uncompressed get/put area
+    std::vector< char > M_raw; //!< compressed data buffer
+    std::size_t M_raw_begin; //!< unread position in M_raw
+    std::size_t M_raw_end; //!< end of the data in M_raw
+
+    std::uint64_t M_pos; //!< uncompressed offset of the end of the get area
+
+public:
+
+    codec_filebuf()
+        : M_fp( nullptr ),
+          M_output( false ),
+          M_eof( false ),
+          M_error( false ),
+          M_raw_begin( 0 ),
+          M_raw_end( 0 ),
+          M_pos( 0 )
+      { }
+
+    /*!
+      \brief the derived class has to call closeFile() in its destructor.
+     */
+    virtual
+    ~codec_filebuf()
+      { }
+
+    bool openFile( const char * path,
+                   const bool output )
+      {
+          M_fp = std::fopen( path, output ? "wb" : "rb" );
+          if ( ! M_fp )
+          {
+              return false;
+          }
+
+          M_output = output;
+          M_buf.resize( CODEC_BUFFER_SIZE );
+          if ( output )
+          {
+              this->setp( M_buf.data(), M_buf.data() + M_buf.size() );
+          }
+          else
+          {
+              this->setg( M_buf.data(), M_buf.data(), M_buf.data() );
+          }
+
+          if ( ! initCodec( output ) )
+          {
+              std::fclose( M_fp );
+              M_fp = nullptr;
+              return false;
+          }
+
+          return true;
+      }
+
+    bool closeFile()
+      {
+          if ( ! M_fp )
+          {
+              return true;
+          }
+
+          bool ok = true;
+          if ( M_output )
+          {
+              ok = encodeBuffer( ENCODE_FINISH );
+          }
+
+          if ( std::fclose( M_fp ) != 0 )
+          {
+              ok = false;
+          }
+          M_fp = nullptr;
+
+          this->setg( nullptr, nullptr, nullptr );
+          this->setp( nullptr, nullptr );
+          return ok && ! M_error;
+      }
+
+protected:
+
+    /*!
+      \brief create the codec context. M_raw has to be allocated.
+     */
+    virtual
+    bool initCodec( const bool output ) = 0;
+
+    /*!
+      \brief restart the decoder from the beginning of the file
+     */
+    virtual
+    bool resetDecoder() = 0;
+
+    /*!
+      \brief compress the data and write them by writeRaw().
+     */
+    virtual
+    bool encode( const char * src,
+                 const std::size_t size,
+                 const EncodeMode mode ) = 0;
+
+    /*!
+      \brief decompress the data
+      \param src compressed data
+      \param src_size in: available size, out: consumed size
+      \param dst destination buffer
+      \param dst_size in: buffer size, out: produced size
+      \return false if the data is broken
+     */
+    virtual
+    bool decode( const char * src,
+                 std::size_t * src_size,
+                 char * dst,
+                 std::size_t * dst_size ) = 0;
+
+    bool writeRaw( const char * data,
+                   const std::size_t size )
+      {
+          return size == 0
+              || std::fwrite( data, 1, size, M_fp ) == size;
+      }
+
+    bool encodeBuffer( const EncodeMode mode )
+      {
+          if ( M_error )
+          {
+              return false;
+          }
+
+          const std::size_t size = this->pptr() - this->pbase();
+          if ( ! encode( this->pbase(), size, mode ) )
+          {
+              M_error = true;
+          }
+          this->setp( M_buf.data(), M_buf.data() + M_buf.size() );
+          return ! M_error;
+      }
+
+    virtual
+    int_type overflow( int_type c ) override
+      {
+          if ( ! M_fp
+               || ! M_output
+               || ! encodeBuffer( ENCODE_CONTINUE ) )
+          {
+              return traits_type::eof();
+          }
+
+          if ( ! traits_type::eq_int_type( c, traits_type::eof() ) )
+          {
+              *this->pptr() = traits_type::to_char_type( c );
+              this->pbump( 1 );
+          }
+          return traits_type::not_eof( c );
+      }
+
+    virtual
+    int sync() override
+      {
+          if ( M_fp
+               && M_output )
+          {
+              return encodeBuffer( ENCODE_FLUSH ) ? 0 : -1;
+          }
+          return 0;
+      }
+
+    virtual
+    int_type underflow() override
+      {
+          if ( ! M_fp
+               || M_output
+               || M_error )
+          {
+              return traits_type::eof();
+          }
+
+          if ( this->gptr() < this->egptr() )
+          {
+              return traits_type::to_int_type( *this->gptr() );
+          }
+
+          while ( true )
+          {
+              if ( M_raw_begin == M_raw_end
+                   && ! M_eof )
+              {
+                  M_raw_begin = 0;
+                  M_raw_end = std::fread( M_raw.data(), 1, M_raw.size(), M_fp );
+                  if ( M_raw_end == 0 )
+                  {
+                      M_eof = true;
+                  }
+              }
+
+              std::size_t src_size = M_raw_end - M_raw_begin;
+              std::size_t dst_size = M_buf.size();
+              if ( ! decode( M_raw.data() + M_raw_begin, &src_size, M_buf.data(), &dst_size ) )
+              {
+                  M_error = true;
+                  return traits_type::eof();
+              }
+              M_raw_begin += src_size;
+
+              if ( dst_size > 0 )
+              {
+                  M_pos += dst_size;
+                  this->setg( M_buf.data(), M_buf.data(), M_buf.data() + dst_size );
+                  return traits_type::to_int_type( *this->gptr() );
+              }
+
+              if ( M_eof
+                   && M_raw_begin == M_raw_end )
+              {
+                  return traits_type::eof();
+              }
+
+              if ( src_size == 0
+                   && M_raw_begin != M_raw_end )
+              {
+                  // no progress
+                  M_error = true;
+                  return traits_type::eof();
+              }
+          }
+      }
+
+    virtual
+    pos_type seekoff( off_type off,
+                      std::ios_base::seekdir way,
+                      std::ios_base::openmode mode ) override
+      {
+          if ( ! M_fp
+               || M_output
+               || ! ( mode & std::ios_base::in ) )
+          {
+              return pos_type( off_type( -1 ) );
+          }
+
+          const off_type cur = static_cast< off_type >( M_pos ) - ( this->egptr() - this->gptr() );
+          if ( way == std::ios_base::cur )
+          {
+              off += cur;
+          }
+          else if ( way != std::ios_base::beg )
+          {
+              return pos_type( off_type( -1 ) );
+          }
+
+          return seekTo( off );
+      }
+
+    virtual
+    pos_type seekpos( pos_type pos,
+                      std::ios_base::openmode mode ) override
+      {
+          if ( ! M_fp
+               || M_output
+               || ! ( mode & std::ios_base::in ) )
+          {
+              return pos_type( off_type( -1 ) );
+          }
+
+          return seekTo( off_type( pos ) );
+      }
+
+private:
+
+    pos_type seekTo( const off_type target )
+      {
+          if ( target < 0 )
+          {
+              return pos_type( off_type( -1 ) );
+          }
+
+          const off_type buf_begin = static_cast< off_type >( M_pos ) - ( this->egptr() - this->eback() );
+          if ( target < buf_begin )
+          {
+              // decode again from the beginning.
+              if ( std::fseek( M_fp, 0, SEEK_SET ) != 0
+                   || ! resetDecoder() )
+              {
+                  M_error = true;
+                  return pos_type( off_type( -1 ) );
+              }
+              M_eof = false;
+              M_error = false;
+              M_raw_begin = M_raw_end = 0;
+              M_pos = 0;
+              this->setg( M_buf.data(), M_buf.data(), M_buf.data() );
+          }
+
+          while ( static_cast< off_type >( M_pos ) < target )
+          {
+              this->setg( this->eback(), this->egptr(), this->egptr() );
+              if ( traits_type::eq_int_type( underflow(), traits_type::eof() ) )
+              {
+                  return pos_type( off_type( -1 ) );
+              }
+          }
+
+          const off_type begin = static_cast< off_type >( M_pos ) - ( this->egptr() - this->eback() );
+          this->setg( this->eback(), this->eback() + ( target - begin ), this->egptr() );
+          return pos_type( target );
+      }
+};
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_LIBZSTD
+/*!
+  \class zstd_filebuf
+  \brief zstd backend
+*/
+class zstd_filebuf
+    : public codec_filebuf {
+private:
+    ZSTD_CCtx * M_cctx;
+    ZSTD_DCtx * M_dctx;
+    int M_level;
+
+public:
+
+    explicit
+    zstd_filebuf( const int level )
+        : M_cctx( nullptr ),
+          M_dctx( nullptr ),
+          M_level( level < 0 ? ZSTD_CLEVEL_DEFAULT : std::min( level, ZSTD_maxCLevel() ) )
+      { }
+
+    ~zstd_filebuf()
+      {
+          closeFile();
+          if ( M_cctx ) ZSTD_freeCCtx( M_cctx );
+          if ( M_dctx ) ZSTD_freeDCtx( M_dctx );
+      }
+
+protected:
+
+    bool initCodec( const bool output ) override
+      {
+          if ( output )
+          {
+              M_cctx = ZSTD_createCCtx();
+              M_raw.resize( ZSTD_CStreamOutSize() );
+              return M_cctx
+                  && ! ZSTD_isError( ZSTD_CCtx_setParameter( M_cctx, ZSTD_c_compressionLevel, M_level ) );
+          }
+
+          M_dctx = ZSTD_createDCtx();
+          M_raw.resize( ZSTD_DStreamInSize() );
+          return M_dctx != nullptr;
+      }
+
+    bool resetDecoder() override
+      {
+          return ! ZSTD_isError( ZSTD_DCtx_reset( M_dctx, ZSTD_reset_session_only ) );
+      }
+
+    bool encode( const char * src,
+                 const std::size_t size,
+                 const EncodeMode mode ) override
+      {
+          const ZSTD_EndDirective directive = ( mode == ENCODE_FINISH ? ZSTD_e_end
+                                                : mode == ENCODE_FLUSH ? ZSTD_e_flush
+                                                : ZSTD_e_continue );
+          ZSTD_inBuffer in = { src, size, 0 };
+          while ( true )
+          {
+              ZSTD_outBuffer out = { M_raw.data(), M_raw.size(), 0 };
+              const std::size_t remaining = ZSTD_compressStream2( M_cctx, &out, &in, directive );
+              if ( ZSTD_isError( remaining )
+                   || ! writeRaw( M_raw.data(), out.pos ) )
+              {
+                  return false;
+              }
+
+              if ( directive == ZSTD_e_continue
+                   ? in.pos == in.size
+                   : remaining == 0 )
+              {
+                  return true;
+              }
+          }
+      }
+
+    bool decode( const char * src,
+                 std::size_t * src_size,
+                 char * dst,
+                 std::size_t * dst_size ) override
+      {
+          ZSTD_inBuffer in = { src, *src_size, 0 };
+          ZSTD_outBuffer out = { dst, *dst_size, 0 };
+          // concatenated frames are decoded continuously.
+          const std::size_t ret = ZSTD_decompressStream( M_dctx, &out, &in );
+          *src_size = in.pos;
+          *dst_size = out.pos;
+          return ! ZSTD_isError( ret );
+      }
+};
+#endif
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_LIBLZ4
+/*!
+  \class lz4_filebuf
+  \brief lz4 frame backend
+*/
+class lz4_filebuf
+    : public codec_filebuf {
+private:
+    LZ4F_cctx * M_cctx;
+    LZ4F_dctx * M_dctx;
+    LZ4F_preferences_t M_prefs;
+    bool M_frame_started;
+
+public:
+
+    explicit
+    lz4_filebuf( const int level )
+        : M_cctx( nullptr ),
+          M_dctx( nullptr ),
+          M_frame_started( false )
+      {
+          std::memset( &M_prefs, 0, sizeof( M_prefs ) );
+          M_prefs.compressionLevel = std::max( 0, level );
+      }
+
+    ~lz4_filebuf()
+      {
+          closeFile();
+          if ( M_cctx ) LZ4F_freeCompressionContext( M_cctx );
+          if ( M_dctx ) LZ4F_freeDecompressionContext( M_dctx );
+      }
+
+protected:
+
+    bool initCodec( const bool output ) override
+      {
+          if ( output )
+          {
+              M_raw.resize( LZ4F_compressBound( CODEC_BUFFER_SIZE, &M_prefs ) );
+              return ! LZ4F_isError( LZ4F_createCompressionContext( &M_cctx, LZ4F_VERSION ) );
+          }
+
+          M_raw.resize( CODEC_BUFFER_SIZE );
+          return ! LZ4F_isError( LZ4F_createDecompressionContext( &M_dctx, LZ4F_VERSION ) );
+      }
+
+    bool resetDecoder() override
+      {
+          LZ4F_resetDecompressionContext( M_dctx );
+          return true;
+      }
+
+    bool encode( const char * src,
+                 const std::size_t size,
+                 const EncodeMode mode ) override
+      {
+          std::size_t n = 0;
+          if ( ! M_frame_started )
+          {
+              n = LZ4F_compressBegin( M_cctx, M_raw.data(), M_raw.size(), &M_prefs );
+              if ( LZ4F_isError( n )
+                   || ! writeRaw( M_raw.data(), n ) )
+              {
+                  return false;
+              }
+              M_frame_started = true;
+          }
+
+          // size never exceeds CODEC_BUFFER_SIZE that is used for compressBound.
+          if ( size > 0 )
+          {
+              n = LZ4F_compressUpdate( M_cctx, M_raw.data(), M_raw.size(), src, size, nullptr );
+              if ( LZ4F_isError( n )
+                   || ! writeRaw( M_raw.data(), n ) )
+              {
+                  return false;
+              }
+          }
+
+          if ( mode == ENCODE_FLUSH )
+          {
+              n = LZ4F_flush( M_cctx, M_raw.data(), M_raw.size(), nullptr );
+          }
+          else if ( mode == ENCODE_FINISH )
+          {
+              n = LZ4F_compressEnd( M_cctx, M_raw.data(), M_raw.size(), nullptr );
+              M_frame_started = false;
+          }
+          else
+          {
+              n = 0;
+          }
+
+          return ! LZ4F_isError( n )
+              && writeRaw( M_raw.data(), n );
+      }
+
+    bool decode( const char * src,
+                 std::size_t * src_size,
+                 char * dst,
+                 std::size_t * dst_size ) override
+      {
+          // a new frame is started automatically after the end of the previous frame.
+          const std::size_t ret = LZ4F_decompress( M_dctx, dst, dst_size, src, src_size, nullptr );
+          return ! LZ4F_isError( ret );
+      }
+};
+#endif
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::streambuf *
+create_input_buf( const char * path,
+                  const CompressionFormat format )
+{
+    switch ( format ) {
+#ifdef HAVE_LIBZSTD
+    case COMPRESSION_ZSTD:
+        {
+            std::unique_ptr< zstd_filebuf > buf( new zstd_filebuf( -1 ) );
+            return ( buf->openFile( path, false ) ? buf.release() : nullptr );
+        }
+#endif
+#ifdef HAVE_LIBLZ4
+    case COMPRESSION_LZ4:
+        {
+            std::unique_ptr< lz4_filebuf > buf( new lz4_filebuf( -1 ) );
+            return ( buf->openFile( path, false ) ? buf.release() : nullptr );
+        }
+#endif
+    case COMPRESSION_GZIP:
+    case COMPRESSION_NONE:
+        {
+            // gzread reads a plain file transparently.
+            std::unique_ptr< gzfilebuf > buf( new gzfilebuf() );
+            if ( buf->open( path, std::ios_base::in ) )
+            {
+                return buf.release();
+            }
+        }
+        if ( format == COMPRESSION_NONE )
+        {
+            std::unique_ptr< std::filebuf > buf( new std::filebuf() );
+            return ( buf->open( path, std::ios_base::in | std::ios_base::binary ) ? buf.release() : nullptr );
+        }
+        break;
+    default:
+        break;
+    }
+
+    return nullptr;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::streambuf *
+create_output_buf( const char * path,
+                   const CompressionFormat format,
+                   const int level )
+{
+    switch ( format ) {
+    case COMPRESSION_NONE:
+        {
+            std::unique_ptr< std::filebuf > buf( new std::filebuf() );
+            return ( buf->open( path, std::ios_base::out | std::ios_base::binary ) ? buf.release() : nullptr );
+        }
+    case COMPRESSION_GZIP:
+        {
+            std::unique_ptr< gzfilebuf > buf( new gzfilebuf() );
+            return ( buf->open( path, std::ios_base::out,
+                                ( level < 0 ? gzfilebuf::DEFAULT_COMPRESSION : std::min( level, 9 ) ) )
+                     ? buf.release()
+                     : nullptr );
+        }
+#ifdef HAVE_LIBZSTD
+    case COMPRESSION_ZSTD:
+        {
+            std::unique_ptr< zstd_filebuf > buf( new zstd_filebuf( level ) );
+            return ( buf->openFile( path, true ) ? buf.release() : nullptr );
+        }
+#endif
+#ifdef HAVE_LIBLZ4
+    case COMPRESSION_LZ4:
+        {
+            std::unique_ptr< lz4_filebuf > buf( new lz4_filebuf( level ) );
+            return ( buf->openFile( path, true ) ? buf.release() : nullptr );
+        }
+#endif
+    default:
+        break;
+    }
+
+    return nullptr;
+}
+
+#ifdef __GLIBC__
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ssize_t
+cookie_write( void * cookie,
+              const char * buf,
+              size_t size )
+{
+    compressed_ofstream * os = static_cast< compressed_ofstream * >( cookie );
+    os->write( buf, size );
+    return ( os->good() ? static_cast< ssize_t >( size ) : 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+cookie_close( void * cookie )
+{
+    compressed_ofstream * os = static_cast< compressed_ofstream * >( cookie );
+    os->flush();
+    const bool ok = os->good();
+    delete os;
+    return ( ok ? 0 : EOF );
+}
+#endif
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+is_compression_supported( const CompressionFormat format )
+{
+    switch ( format ) {
+    case COMPRESSION_NONE:
+    case COMPRESSION_AUTO:
+        return true;
+    case COMPRESSION_GZIP:
+#ifdef HAVE_LIBZ
+        return true;
+#else
+        return false;
+#endif
+    case COMPRESSION_ZSTD:
+#ifdef HAVE_LIBZSTD
+        return true;
+#else
+        return false;
+#endif
+    case COMPRESSION_LZ4:
+#ifdef HAVE_LIBLZ4
+        return true;
+#else
+        return false;
+#endif
+    default:
+        break;
+    }
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CompressionFormat
+detect_compression_format( const char * path )
+{
+    unsigned char magic[4] = { 0, 0, 0, 0 };
+
+    std::FILE * fp = std::fopen( path, "rb" );
+    if ( ! fp )
+    {
+        return COMPRESSION_NONE;
+    }
+    const std::size_t n = std::fread( magic, 1, sizeof( magic ), fp );
+    std::fclose( fp );
+
+    if ( n >= 2
+         && magic[0] == 0x1f && magic[1] == 0x8b )
+    {
+        return COMPRESSION_GZIP;
+    }
+
+    if ( n == 4
+         && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd )
+    {
+        return COMPRESSION_ZSTD;
+    }
+
+    if ( n == 4
+         && magic[0] == 0x04 && magic[1] == 0x22 && magic[2] == 0x4d && magic[3] == 0x18 )
+    {
+        return COMPRESSION_LZ4;
+    }
+
+    return COMPRESSION_NONE;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CompressionFormat
+compression_format_from_path( const char * path )
+{
+    if ( ends_with( path, ".gz" ) )
+    {
+        return COMPRESSION_GZIP;
+    }
+
+    if ( ends_with( path, ".zst" )
+         || ends_with( path, ".zstd" ) )
+    {
+        return COMPRESSION_ZSTD;
+    }
+
+    if ( ends_with( path, ".lz4" ) )
+    {
+        return COMPRESSION_LZ4;
+    }
+
+    return COMPRESSION_NONE;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::FILE *
+compressed_fopen( const char * path,
+                  const CompressionFormat format,
+                  const int level )
+{
+    const CompressionFormat fmt = ( format == COMPRESSION_AUTO
+                                    ? compression_format_from_path( path )
+                                    : format );
+    if ( fmt == COMPRESSION_NONE )
+    {
+        return std::fopen( path, "w" );
+    }
+
+#ifdef __GLIBC__
+    compressed_ofstream * os = new compressed_ofstream( path, fmt, level );
+    if ( ! os->is_open() )
+    {
+        delete os;
+        return nullptr;
+    }
+
+    cookie_io_functions_t funcs;
+    funcs.read = nullptr;
+    funcs.write = cookie_write;
+    funcs.seek = nullptr;
+    funcs.close = cookie_close;
+
+    std::FILE * fp = fopencookie( os, "w", funcs );
+    if ( ! fp )
+    {
+        delete os;
+    }
+    return fp;
+#else
+    (void)level;
+    return nullptr;
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+compressed_ifstream::compressed_ifstream()
+    : std::istream( nullptr ),
+      M_format( COMPRESSION_NONE )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+compressed_ifstream::compressed_ifstream( const char * path )
+    : std::istream( nullptr ),
+      M_format( COMPRESSION_NONE )
+{
+    this->open( path );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+compressed_ifstream::~compressed_ifstream()
+{
+    close();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+compressed_ifstream::open( const char * path )
+{
+    close();
+
+    M_format = detect_compression_format( path );
+    M_file_buf.reset( create_input_buf( path, M_format ) );
+
+    this->rdbuf( M_file_buf.get() );
+    if ( ! M_file_buf )
+    {
+        this->setstate( std::ios_base::failbit );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+compressed_ifstream::close()
+{
+    if ( M_file_buf )
+    {
+        this->rdbuf( nullptr );
+        M_file_buf.reset();
+        M_format = COMPRESSION_NONE;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+compressed_ofstream::compressed_ofstream()
+    : std::ostream( nullptr ),
+      M_format( COMPRESSION_NONE )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+compressed_ofstream::compressed_ofstream( const char * path,
+                                          const CompressionFormat format,
+                                          const int level )
+    : std::ostream( nullptr ),
+      M_format( COMPRESSION_NONE )
+{
+    this->open( path, format, level );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+compressed_ofstream::~compressed_ofstream()
+{
+    close();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+compressed_ofstream::open( const char * path,
+                           const CompressionFormat format,
+                           const int level )
+{
+    close();
+
+    M_format = ( format == COMPRESSION_AUTO
+                 ? compression_format_from_path( path )
+                 : format );
+    M_file_buf.reset( create_output_buf( path, M_format, level ) );
+
+    this->rdbuf( M_file_buf.get() );
+    if ( ! M_file_buf )
+    {
+        this->setstate( std::ios_base::failbit );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+compressed_ofstream::close()
+{
+    if ( M_file_buf )
+    {
+        // each backend finishes the frame and closes the file in its destructor.
+        M_file_buf->pubsync();
+        this->rdbuf( nullptr );
+        M_file_buf.reset();
+        M_format = COMPRESSION_NONE;
+    }
+}
+
+}
@@ -0,0 +1,235 @@
+// -*-c++-*-
+
+/*!
+  \file compressed_fstream.h
+  \brief codec independent compressed file stream Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_GZ_COMPRESSED_FSTREAM_H
+#define RCSC_GZ_COMPRESSED_FSTREAM_H
+
+#include <memory>
+#include <iostream>
+#include <cstdio>
+
+namespace rcsc {
+
+/*!
+  \enum CompressionFormat
+  \brief file compression format
+*/
+enum CompressionFormat {
+    COMPRESSION_NONE, //!< plain file
+    COMPRESSION_GZIP, //!< gzip. needs zlib.
+    COMPRESSION_ZSTD, //!< zstd frame format. needs libzstd.
+    COMPRESSION_LZ4, //!< lz4 frame format. needs liblz4.
+    COMPRESSION_AUTO, //!< detected by the magic bytes (input) or the file extension (output)
+};
+
+/*!
+  \brief check if the format can be used in this build
+  \param format compression format
+  \return true if the codec library is available
+*/
+bool is_compression_supported( const CompressionFormat format );
+
+/*!
+  \brief detect the compression format by the magic bytes of the file
+  \param path file path
+  \return detected format. COMPRESSION_NONE if unknown or the file cannot be opened.
+*/
+CompressionFormat detect_compression_format( const char * path );
+
+/*!
+  \brief get the compression format from the file extension (.gz, .zst, .lz4)
+  \param path file path
+  \return format for the extension. COMPRESSION_NONE for other extensions.
+*/
+CompressionFormat compression_format_from_path( const char * path );
+
+/*!
+  \brief open a compressed file for writing as a stdio stream.
+  \param path file path
+  \param format compression format. COMPRESSION_AUTO selects it by the file extension.
+  \param level compression level of the codec. a negative value means the default level.
+  \return file pointer closed by fclose(), or NULL.
+
+  The compressing stream is available only with glibc (fopencookie).
+  On other platforms, a compressed format makes this function fail.
+*/
+std::FILE * compressed_fopen( const char * path,
+                              const CompressionFormat format = COMPRESSION_AUTO,
+                              const int level = -1 );
+
+/////////////////////////////////////////////////////////////////////
+
+/*!
+  \class compressed_ifstream
+  \brief input file stream that reads plain, gzip, zstd and lz4 files.
+
+  The format is detected by the magic bytes. gzip and plain files are read by
+  gzfilebuf (zlib backend).
+*/
+class compressed_ifstream
+    : public std::istream {
+private:
+    //! underlying stream buffer.
+    std::unique_ptr< std::streambuf > M_file_buf;
+
+    //! format of the opened file
+    CompressionFormat M_format;
+
+public:
+
+    /*!
+      \brief default constructor
+    */
+    compressed_ifstream();
+
+    /*!
+      \brief init stream buffer and open file.
+      \param path file path to be opened.
+     */
+    explicit
+    compressed_ifstream( const char * path );
+
+    /*!
+      \brief close the file
+     */
+    ~compressed_ifstream();
+
+    /*!
+      \brief open the file. the format is detected automatically.
+      \param path file path.
+
+      Stream will be in state good() if file opens successfully;
+      otherwise in state fail().
+     */
+    void open( const char * path );
+
+    /*!
+      \brief close the file.
+     */
+    void close();
+
+    /*!
+      \brief check if file is open.
+      \return true if file opened.
+    */
+    bool is_open() const
+      {
+          return M_file_buf != nullptr;
+      }
+
+    /*!
+      \brief get the format of the opened file
+      \return compression format
+     */
+    CompressionFormat format() const
+      {
+          return M_format;
+      }
+};
+
+/////////////////////////////////////////////////////////////////////
+
+/*!
+  \class compressed_ofstream
+  \brief output file stream that writes plain, gzip, zstd or lz4 files.
+*/
+class compressed_ofstream
+    : public std::ostream {
+private:
+    //! underlying stream buffer.
+    std::unique_ptr< std::streambuf > M_file_buf;
+
+    //! format of the opened file
+    CompressionFormat M_format;
+
+public:
+
+    /*!
+      \brief default constructor
+    */
+    compressed_ofstream();
+
+    /*!
+      \brief init stream buffer and open file.
+      \param path file path.
+      \param format compression format. COMPRESSION_AUTO selects it by the file extension.
+      \param level compression level of the codec. a negative value means the default level.
+     */
+    explicit
+    compressed_ofstream( const char * path,
+                         const CompressionFormat format = COMPRESSION_AUTO,
+                         const int level = -1 );
+
+    /*!
+      \brief flush and close the file
+     */
+    ~compressed_ofstream();
+
+    /*!
+      \brief open the file.
+      \param path file path.
+      \param format compression format. COMPRESSION_AUTO selects it by the file extension.
+      \param level compression level of the codec. a negative value means the default level.
+
+      Stream will be in state good() if file opens successfully;
+      otherwise in state fail().
+     */
+    void open( const char * path,
+               const CompressionFormat format = COMPRESSION_AUTO,
+               const int level = -1 );
+
+    /*!
+      \brief flush and close the file. the last frame is written.
+     */
+    void close();
+
+    /*!
+      \brief check if file is open.
+      \return true if file opened.
+    */
+    bool is_open() const
+      {
+          return M_file_buf != nullptr;
+      }
+
+    /*!
+      \brief get the format of the opened file
+      \return compression format
+     */
+    CompressionFormat format() const
+      {
+          return M_format;
+      }
+};
+
+}
+
+#endif
@@ -40,12 +40,48 @@
 #include "gzcompressor.h"
 
 #include <cstdlib>
+#include <cstring>
 #include <memory>
 #include <algorithm>
 #include <stdexcept>
 
+#ifndef HAVE_LIBZ
+// status values returned without zlib
+#define Z_OK 0
+#define Z_STREAM_ERROR (-2)
+#define Z_BUF_ERROR (-5)
+#endif
+
 namespace rcsc {
 
+namespace {
+
+//! initial output size of the string interface
+const std::size_t MIN_STRING_OUTPUT = 1024;
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief reserve the free space at the end of the string output
+  \param dest destination string
+  \param used the number of bytes already written
+  \param hint expected size of the whole output
+ */
+inline
+void
+grow_output( std::string & dest,
+             const std::size_t used,
+             const std::size_t hint )
+{
+    std::size_t new_size = std::max( dest.capacity(), std::max( hint, MIN_STRING_OUTPUT ) );
+    while ( new_size <= used )
+    {
+        new_size += new_size / 2;
+    }
+    dest.resize( new_size );
+}
+
+}
+
 /////////////////////////////////////////////////////////////////////
 
 /*!
@@ -56,13 +92,9 @@ class GZCompressor::Impl {
 private:
 #ifdef HAVE_LIBZ
     z_stream M_stream;
-    
-    // Use smart pointer for automatic memory management
-    std::unique_ptr<char[]> M_out_buffer;
-    size_t M_out_size;
-    size_t M_out_avail;
     bool M_initialized;
 #endif
+    bool M_streaming;
 public:
 
     /*!
@@ -72,16 +104,18 @@ public:
     explicit
     Impl( const int level )
 #ifdef HAVE_LIBZ
-        : M_out_buffer( nullptr )
-        , M_out_size( 0 )
-        , M_out_avail( 0 )
-        , M_initialized( false )
+        : M_initialized( false ),
+          M_streaming( false )
+#else
+        : M_streaming( false )
 #endif
       {
 #ifdef HAVE_LIBZ
           M_stream.zalloc = Z_NULL;
           M_stream.zfree = Z_NULL;
           M_stream.opaque = nullptr;
+          M_stream.next_in = Z_NULL;
+          M_stream.avail_in = 0;
 
           int lv = std::clamp(level, Z_BEST_SPEED, Z_BEST_COMPRESSION);
 
@@ -89,14 +123,10 @@ public:
           if (result != Z_OK) {
               throw std::runtime_error("Failed to initialize deflate");
           }
-          
-          result = deflateParams( &M_stream, lv, Z_DEFAULT_STRATEGY );
-          if (result != Z_OK) {
-              deflateEnd(&M_stream);
-              throw std::runtime_error("Failed to set deflate parameters");
-          }
-          
+
           M_initialized = true;
+#else
+          (void)level;
 #endif
       }
 
@@ -109,7 +139,6 @@ public:
           if (M_initialized) {
               deflateEnd( &M_stream );
           }
-          // M_out_buffer will be automatically freed by unique_ptr
 #endif
       }
 
@@ -122,107 +151,151 @@ public:
           if (!M_initialized) {
               return Z_STREAM_ERROR;
           }
-          
+
           int lv = std::clamp(level, Z_BEST_SPEED, Z_BEST_COMPRESSION);
           return deflateParams( &M_stream, lv, Z_DEFAULT_STRATEGY );
 #else
+          (void)level;
           return 0;
 #endif
       }
 
-    /*!
-      \return the return value of deflate
+    void setStreaming( const bool on )
+      {
+          M_streaming = on;
+          reset();
+      }
 
-      Z_OK, Z_STREAM_END, Z_STREAM_ERROR, Z_BUF_ERROR
+    bool isStreaming() const
+      {
+          return M_streaming;
+      }
+
+    int reset()
+      {
+#ifdef HAVE_LIBZ
+          if (!M_initialized) {
+              return Z_STREAM_ERROR;
+          }
+          M_stream.next_in = Z_NULL;
+          M_stream.avail_in = 0;
+          return deflateReset( &M_stream );
+#else
+          return 0;
+#endif
+      }
+
+    /*!
+      \brief compress the given message into the caller's buffer.
+      \return Z_OK, Z_BUF_ERROR (dest is full and output remains), Z_STREAM_ERROR
      */
     int compress( const char * src_buf,
                   const int src_size,
-                  std::string & dest )
+                  char * dest_buf,
+                  const int dest_size,
+                  int * written )
       {
-          dest.clear();
-          
-          if (!src_buf || src_size <= 0) {
+          *written = 0;
+
+          if ( ! dest_buf || dest_size <= 0 )
+          {
               return Z_STREAM_ERROR;
           }
-          
+
 #ifdef HAVE_LIBZ
           if (!M_initialized) {
               return Z_STREAM_ERROR;
           }
-          
-          // allocate output buffer with better size estimation
-          if ( !M_out_buffer )
+
+          if ( src_buf && src_size > 0 )
           {
-              // Better size estimation: worst case is ~1% + 12 bytes for small data
-              // For larger data, compression ratio is typically better
-              M_out_avail = std::max(static_cast<size_t>(src_size * 1.01 + 12), 
-                                   static_cast<size_t>(1024));
-              
-              try {
-                  M_out_buffer = std::make_unique<char[]>(M_out_avail);
-              } catch (const std::bad_alloc&) {
-                  return Z_MEM_ERROR;
-              }
-
-              M_stream.next_out = reinterpret_cast<Bytef*>(M_out_buffer.get());
-              M_stream.avail_out = static_cast<uInt>(M_out_avail);
+              M_stream.next_in = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(src_buf));
+              M_stream.avail_in = static_cast<uInt>(src_size);
           }
 
-          M_stream.next_in = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(src_buf));
-          M_stream.avail_in = static_cast<uInt>(src_size);
+          M_stream.next_out = reinterpret_cast<Bytef*>(dest_buf);
+          M_stream.avail_out = static_cast<uInt>(dest_size);
 
-          const uLong bytes_out = M_stream.total_out;
-          int err = Z_OK;
-          
-          // Process all input data
-          while ( M_stream.avail_in > 0 )
-          {
-              if ( M_stream.avail_out == 0 )
-              {
-                  // Expand buffer by 50%
-                  const size_t extra = M_out_avail / 2;
-                  const size_t new_size = M_out_avail + extra;
-                  
-                  try {
-                      auto new_buffer = std::make_unique<char[]>(new_size);
-                      std::copy_n(M_out_buffer.get(), M_out_avail, new_buffer.get());
-                      M_out_buffer = std::move(new_buffer);
-                      M_out_avail = new_size;
-                  } catch (const std::bad_alloc&) {
-                      err = Z_MEM_ERROR;
-                      break;
-                  }
-
-                  M_stream.next_out = reinterpret_cast<Bytef*>(M_out_buffer.get() + (M_out_avail - extra));
-                  M_stream.avail_out = static_cast<uInt>(extra);
-              }
-
-              err = deflate( &M_stream, Z_SYNC_FLUSH );
-
-              if ( err != Z_OK )
-              {
-                  break;
-              }
-          }
+          // Z_SYNC_FLUSH puts all pending output on a byte boundary,
+          // so the receiver can decode each message immediately.
+          int err = deflate( &M_stream, Z_SYNC_FLUSH );
 
-          M_out_size = M_stream.total_out - bytes_out;
+          *written = dest_size - static_cast<int>(M_stream.avail_out);
 
-          // copy to the destination buffer
-          if (M_out_size > 0) {
-              dest.assign( M_out_buffer.get(), M_out_size );
+          if ( err == Z_BUF_ERROR
+               && M_stream.avail_in == 0
+               && *written == 0 )
+          {
+              // nothing was pending. the last message has already been flushed.
+              err = Z_OK;
+          }
+          else if ( err == Z_OK
+                    && M_stream.avail_out == 0 )
+          {
+              // the rest of output remains in the stream.
+              return Z_BUF_ERROR;
           }
 
-          M_out_size = 0;
-          deflateReset( &M_stream );
-          M_stream.next_out = reinterpret_cast<Bytef*>(M_out_buffer.get());
-          M_stream.avail_out = static_cast<uInt>(M_out_avail);
+          if ( err == Z_OK
+               && ! M_streaming )
+          {
+              // each message is an independent zlib stream.
+              // deflateReset keeps the allocated state and the compression level.
+              deflateReset( &M_stream );
+          }
 
           return err;
 #else
-          dest.assign( src_buf, src_size );
+          if ( ! src_buf || src_size <= 0 )
+          {
+              return 0;
+          }
+          if ( dest_size < src_size )
+          {
+              return Z_BUF_ERROR;
+          }
+          std::memcpy( dest_buf, src_buf, src_size );
+          *written = src_size;
           return 0;
 #endif
       }
+
+    /*!
+      \return the return value of deflate
+
+      Z_OK, Z_STREAM_END, Z_STREAM_ERROR, Z_BUF_ERROR
+     */
+    int compress( const char * src_buf,
+                  const int src_size,
+                  std::string & dest )
+      {
+          dest.clear();
+
+          if (!src_buf || src_size <= 0) {
+              return Z_STREAM_ERROR;
+          }
+
+          // worst case is ~1% + 12 bytes for small data
+          const std::size_t hint = static_cast<std::size_t>(src_size * 1.01 + 12);
+
+          std::size_t used = 0;
+          grow_output( dest, used, hint );
+
+          int n = 0;
+          int err = compress( src_buf, src_size,
+                              &dest[0], static_cast<int>(dest.size()), &n );
+          used += n;
+          while ( err == Z_BUF_ERROR )
+          {
+              grow_output( dest, used, hint );
+              err = compress( nullptr, 0,
+                              &dest[used], static_cast<int>(dest.size() - used), &n );
+              used += n;
+          }
+
+          dest.resize( used );
+          return err;
+      }
 };
 
 /////////////////////////////////////////////////////////////////////
@@ -235,26 +308,24 @@ class GZDecompressor::Impl {
 private:
 #ifdef HAVE_LIBZ
     z_stream M_stream;
-
-    // Use smart pointer for automatic memory management
-    std::unique_ptr<char[]> M_out_buffer;
-    size_t M_out_size;
-    size_t M_out_avail;
     bool M_initialized;
 #endif
+    bool M_streaming;
 public:
     Impl()
 #ifdef HAVE_LIBZ
-        : M_out_buffer( nullptr )
-        , M_out_size( 0 )
-        , M_out_avail( 0 )
-        , M_initialized( false )
+        : M_initialized( false ),
+          M_streaming( false )
+#else
+        : M_streaming( false )
 #endif
       {
 #ifdef HAVE_LIBZ
           M_stream.zalloc = Z_NULL;
           M_stream.zfree = Z_NULL;
           M_stream.opaque = nullptr;
+          M_stream.next_in = Z_NULL;
+          M_stream.avail_in = 0;
 
           int result = inflateInit( &M_stream );
           if (result != Z_OK) {
@@ -270,103 +341,143 @@ public:
           if (M_initialized) {
               inflateEnd( &M_stream );
           }
-          // M_out_buffer will be automatically freed by unique_ptr
+#endif
+      }
+
+    void setStreaming( const bool on )
+      {
+          M_streaming = on;
+          reset();
+      }
+
+    bool isStreaming() const
+      {
+          return M_streaming;
+      }
+
+    int reset()
+      {
+#ifdef HAVE_LIBZ
+          if (!M_initialized) {
+              return Z_STREAM_ERROR;
+          }
+          M_stream.next_in = Z_NULL;
+          M_stream.avail_in = 0;
+          return inflateReset( &M_stream );
+#else
+          return 0;
 #endif
       }
 
     /*!
-      \brief decompress the message
-      \param src_buf source message
-      \param src_size the length of source message
-      \param dest reference to the destination variable.
+      \brief decompress the given message into the caller's buffer.
+      \return Z_OK, Z_STREAM_END, Z_BUF_ERROR (dest is full and output remains),
+      Z_DATA_ERROR, Z_STREAM_ERROR
      */
     int decompress( const char * src_buf,
                     const int src_size,
-                    std::string & dest )
+                    char * dest_buf,
+                    const int dest_size,
+                    int * written )
       {
-          dest.clear();
-          
-          if (!src_buf || src_size <= 0) {
+          *written = 0;
+
+          if ( ! dest_buf || dest_size <= 0 )
+          {
               return Z_STREAM_ERROR;
           }
-          
+
 #ifdef HAVE_LIBZ
           if (!M_initialized) {
               return Z_STREAM_ERROR;
           }
-          
-          // allocate output buffer
-          if ( !M_out_buffer )
+
+          if ( src_buf && src_size > 0 )
           {
-              // Start with 2x the input size for decompression
-              M_out_avail = std::max(static_cast<size_t>(src_size * 2), 
-                                   static_cast<size_t>(1024));
-              
-              try {
-                  M_out_buffer = std::make_unique<char[]>(M_out_avail);
-              } catch (const std::bad_alloc&) {
-                  return Z_MEM_ERROR;
-              }
-
-              M_stream.next_out = reinterpret_cast<Bytef*>(M_out_buffer.get());
-              M_stream.avail_out = static_cast<uInt>(M_out_avail);
+              M_stream.next_in = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(src_buf));
+              M_stream.avail_in = static_cast<uInt>(src_size);
           }
 
-          M_stream.next_in = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(src_buf));
-          M_stream.avail_in = static_cast<uInt>(src_size);
+          M_stream.next_out = reinterpret_cast<Bytef*>(dest_buf);
+          M_stream.avail_out = static_cast<uInt>(dest_size);
 
-          const uLong bytes_out = M_stream.total_out;
-          int err = Z_OK;
-          
-          // Process all input data
-          while ( M_stream.avail_in > 0 )
-          {
-              if ( M_stream.avail_out == 0 )
-              {
-                  // Expand buffer by 50%
-                  const size_t extra = M_out_avail / 2;
-                  const size_t new_size = M_out_avail + extra;
-                  
-                  try {
-                      auto new_buffer = std::make_unique<char[]>(new_size);
-                      std::copy_n(M_out_buffer.get(), M_out_avail, new_buffer.get());
-                      M_out_buffer = std::move(new_buffer);
-                      M_out_avail = new_size;
-                  } catch (const std::bad_alloc&) {
-                      err = Z_MEM_ERROR;
-                      break;
-                  }
-
-                  M_stream.next_out = reinterpret_cast<Bytef*>(M_out_buffer.get() + (M_out_avail - extra));
-                  M_stream.avail_out = static_cast<uInt>(extra);
-              }
-
-              err = inflate( &M_stream, Z_SYNC_FLUSH );
-
-              if ( err != Z_OK )
-              {
-                  break;
-              }
-          }
+          int err = inflate( &M_stream, Z_SYNC_FLUSH );
 
-          M_out_size = M_stream.total_out - bytes_out;
+          *written = dest_size - static_cast<int>(M_stream.avail_out);
 
-          // copy to the destination buffer
-          if (M_out_size > 0) {
-              dest.assign( M_out_buffer.get(), M_out_size );
+          if ( err == Z_BUF_ERROR
+               && M_stream.avail_in == 0
+               && *written == 0 )
+          {
+              // no more input and no pending output.
+              err = Z_OK;
+          }
+          else if ( err == Z_OK
+                    && M_stream.avail_out == 0 )
+          {
+              // the rest of output remains in the stream.
+              return Z_BUF_ERROR;
           }
 
-          M_out_size = 0;
-          inflateReset( &M_stream );
-          M_stream.next_out = reinterpret_cast<Bytef*>(M_out_buffer.get());
-          M_stream.avail_out = static_cast<uInt>(M_out_avail);
+          if ( err == Z_STREAM_END
+               || ( err == Z_OK && ! M_streaming ) )
+          {
+              reset();
+          }
 
           return err;
 #else
-          dest.assign( src_buf, src_size );
+          if ( ! src_buf || src_size <= 0 )
+          {
+              return 0;
+          }
+          if ( dest_size < src_size )
+          {
+              return Z_BUF_ERROR;
+          }
+          std::memcpy( dest_buf, src_buf, src_size );
+          *written = src_size;
           return 0;
 #endif
       }
+
+    /*!
+      \brief decompress the message
+      \param src_buf source message
+      \param src_size the length of source message
+      \param dest reference to the destination variable.
+     */
+    int decompress( const char * src_buf,
+                    const int src_size,
+                    std::string & dest )
+      {
+          dest.clear();
+
+          if (!src_buf || src_size <= 0) {
+              return Z_STREAM_ERROR;
+          }
+
+          // start with 2x the input size for decompression
+          const std::size_t hint = static_cast<std::size_t>(src_size) * 2;
+
+          std::size_t used = 0;
+          grow_output( dest, used, hint );
+
+          int n = 0;
+          int err = decompress( src_buf, src_size,
+                                &dest[0], static_cast<int>(dest.size()), &n );
+          used += n;
+          while ( err == Z_BUF_ERROR )
+          {
+              grow_output( dest, used, hint );
+              err = decompress( nullptr, 0,
+                                &dest[used], static_cast<int>(dest.size() - used), &n );
+              used += n;
+          }
+
+          dest.resize( used );
+          return err;
+      }
 };
 
 
@@ -414,6 +525,50 @@ GZCompressor::compress( const char * src_buf,
     return M_impl->compress( src_buf, src_size, dest );
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+GZCompressor::setStreaming( const bool on )
+{
+    M_impl->setStreaming( on );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+GZCompressor::isStreaming() const
+{
+    return M_impl->isStreaming();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+GZCompressor::reset()
+{
+    return M_impl->reset();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+GZCompressor::compress( const char * src_buf,
+                        const int src_size,
+                        char * dest_buf,
+                        const int dest_size,
+                        int * written )
+{
+    return M_impl->compress( src_buf, src_size, dest_buf, dest_size, written );
+}
+
 /////////////////////////////////////////////////////////////////////
 
 /*-------------------------------------------------------------------*/
@@ -447,4 +602,49 @@ GZDecompressor::decompress( const char * src_buf,
     return M_impl->decompress( src_buf, src_size, dest );
 }
 
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+GZDecompressor::setStreaming( const bool on )
+{
+    M_impl->setStreaming( on );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+GZDecompressor::isStreaming() const
+{
+    return M_impl->isStreaming();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+GZDecompressor::reset()
+{
+    return M_impl->reset();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+GZDecompressor::decompress( const char * src_buf,
+                            const int src_size,
+                            char * dest_buf,
+                            const int dest_size,
+                            int * written )
+{
+    return M_impl->decompress( src_buf, src_size, dest_buf, dest_size, written );
+}
+
 }
@@ -40,6 +40,12 @@ namespace rcsc {
 /*!
   \class GZCompressor
   \brief compress message string
+
+  Every message is compressed with Z_SYNC_FLUSH by the same z_stream.
+  In the default message mode the stream is reset after each message,
+  so each output is an independent zlib stream as rcssserver expects.
+  In the streaming mode the dictionary is kept across messages and the
+  peer has to decompress them in order with a streaming GZDecompressor.
  */
 class GZCompressor {
 private:
@@ -81,6 +87,40 @@ public:
                   const int src_size,
                   std::string & dest );
 
+    /*!
+      \brief compress the src_buf into the caller's buffer.
+      \param src_buf pointer to the source buffer. nullptr to continue the previous output.
+      \param src_size size of source buffer
+      \param dest_buf pointer to the destination buffer
+      \param dest_size size of destination buffer
+      \param written pointer to the variable to store the number of written bytes
+      \return status of compression. Z_BUF_ERROR if dest_buf is full and output remains.
+      In that case, call again with nullptr source to receive the rest, or call reset().
+     */
+    int compress( const char * src_buf,
+                  const int src_size,
+                  char * dest_buf,
+                  const int dest_size,
+                  int * written );
+
+    /*!
+      \brief set the streaming mode. the stream is reset.
+      \param on if true, the compression state is kept across messages.
+     */
+    void setStreaming( const bool on );
+
+    /*!
+      \brief check the streaming mode
+      \return true if the compression state is kept across messages.
+     */
+    bool isStreaming() const;
+
+    /*!
+      \brief discard the current stream state without releasing the memory
+      \return result status of deflateReset
+     */
+    int reset();
+
 };
 
 
@@ -89,6 +129,8 @@ public:
 /*!
   \class GZDecompressor
   \brief decompress message string
+
+  The counterpart of GZCompressor. The streaming mode has to match the sender.
  */
 class GZDecompressor {
 private:
@@ -121,6 +163,40 @@ public:
                     const int src_size,
                     std::string & dest );
 
+    /*!
+      \brief decompress the src_buf into the caller's buffer.
+      \param src_buf source buffer. nullptr to continue the previous output.
+      \param src_size size of source buffer
+      \param dest_buf pointer to the destination buffer
+      \param dest_size size of destination buffer
+      \param written pointer to the variable to store the number of written bytes
+      \return status of decompression. Z_BUF_ERROR if dest_buf is full and output remains.
+      In that case, call again with nullptr source to receive the rest, or call reset().
+     */
+    int decompress( const char * src_buf,
+                    const int src_size,
+                    char * dest_buf,
+                    const int dest_size,
+                    int * written );
+
+    /*!
+      \brief set the streaming mode. the stream is reset.
+      \param on if true, the decompression state is kept across messages.
+     */
+    void setStreaming( const bool on );
+
+    /*!
+      \brief check the streaming mode
+      \return true if the decompression state is kept across messages.
+     */
+    bool isStreaming() const;
+
+    /*!
+      \brief discard the current stream state without releasing the memory
+      \return result status of inflateReset
+     */
+    int reset();
+
 };
 
 }
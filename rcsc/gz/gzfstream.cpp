@@ -34,8 +34,15 @@
 #endif
 
 #include "gzfstream.h"
+#include "gzindex.h"
 
 #include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
 #include <cstdio>
 
 #ifdef HAVE_LIBZ
@@ -46,6 +53,351 @@ namespace rcsc {
 
 /////////////////////////////////////////////////////////////////////
 
+#ifdef HAVE_LIBZ
+namespace {
+
+//! uncompressed size of each independently compressed block
+const std::size_t PARALLEL_BLOCK_SIZE = 128 * 1024;
+
+//! the size of the preset dictionary taken from the previous block
+const std::size_t PARALLEL_DICT_SIZE = 32 * 1024;
+
+/*!
+  \struct ParallelGZBlock
+  \brief a block compressed by a worker thread
+*/
+struct ParallelGZBlock {
+    std::string in_; //!< uncompressed data
+    std::string dict_; //!< the last bytes of the previous block
+    std::string out_; //!< raw deflate data
+    uLong crc_; //!< crc32 of in_
+    bool last_; //!< true if this is the final block
+    bool done_; //!< set by the worker thread
+    bool error_; //!< set if deflate failed
+
+    ParallelGZBlock()
+        : crc_( 0 ),
+          last_( false ),
+          done_( false ),
+          error_( false )
+      {
+          in_.reserve( PARALLEL_BLOCK_SIZE );
+      }
+};
+
+typedef std::shared_ptr< ParallelGZBlock > ParallelGZBlockPtr;
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief compress the block as a part of one raw deflate stream.
+
+  Each block is compressed by its own z_stream. The previous input is set as
+  the preset dictionary to keep the compression ratio. The non-final block is
+  terminated by Z_SYNC_FLUSH, so the blocks can be simply concatenated.
+*/
+void
+compress_block( ParallelGZBlock & block,
+                const int level,
+                const int strategy )
+{
+    block.crc_ = crc32( 0L, Z_NULL, 0 );
+    if ( ! block.in_.empty() )
+    {
+        block.crc_ = crc32( block.crc_,
+                            reinterpret_cast< const Bytef * >( block.in_.data() ),
+                            static_cast< uInt >( block.in_.size() ) );
+    }
+
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+
+    if ( deflateInit2( &strm, level, Z_DEFLATED, -MAX_WBITS, 8, strategy ) != Z_OK )
+    {
+        block.error_ = true;
+        return;
+    }
+
+    if ( ! block.dict_.empty() )
+    {
+        deflateSetDictionary( &strm,
+                              reinterpret_cast< const Bytef * >( block.dict_.data() ),
+                              static_cast< uInt >( block.dict_.size() ) );
+    }
+
+    // the sync marker and the final empty block need a few extra bytes.
+    block.out_.resize( deflateBound( &strm, static_cast< uLong >( block.in_.size() ) ) + 16 );
+
+    strm.next_in = reinterpret_cast< Bytef * >( const_cast< char * >( block.in_.data() ) );
+    strm.avail_in = static_cast< uInt >( block.in_.size() );
+
+    const int flush = ( block.last_ ? Z_FINISH : Z_SYNC_FLUSH );
+    std::size_t used = 0;
+    int err = Z_OK;
+    while ( true )
+    {
+        strm.next_out = reinterpret_cast< Bytef * >( &block.out_[used] );
+        strm.avail_out = static_cast< uInt >( block.out_.size() - used );
+
+        err = deflate( &strm, flush );
+        used = block.out_.size() - strm.avail_out;
+
+        if ( err == Z_STREAM_ERROR )
+        {
+            block.error_ = true;
+            break;
+        }
+
+        if ( strm.avail_out != 0
+             || err == Z_STREAM_END )
+        {
+            break;
+        }
+
+        block.out_.resize( block.out_.size() * 3 / 2 );
+    }
+
+    block.out_.resize( used );
+    deflateEnd( &strm );
+}
+
+}
+
+/////////////////////////////////////////////////////////////////////
+
+/*!
+  \class ParallelGZWriter
+  \brief pigz style gzip writer
+
+  The input is split into blocks that are compressed by worker threads.
+  The compressed blocks are written in order as one gzip member,
+  so the output can be read by gzread (and gzifstream) as usual.
+*/
+class ParallelGZWriter {
+private:
+    std::FILE * M_fp;
+    int M_level;
+    int M_strategy;
+    std::size_t M_max_pending;
+
+    std::vector< std::thread > M_workers;
+    std::mutex M_mutex;
+    std::condition_variable M_job_cond;
+    std::condition_variable M_done_cond;
+    bool M_stop;
+
+    std::deque< ParallelGZBlockPtr > M_jobs; //!< blocks not taken by any worker
+    std::deque< ParallelGZBlockPtr > M_pending; //!< blocks not written yet, in input order
+
+    ParallelGZBlockPtr M_fill; //!< block being filled
+    uLong M_crc; //!< crc32 of the written data
+    uLong M_total_size; //!< uncompressed size of the submitted data
+    bool M_error;
+
+public:
+
+    ParallelGZWriter()
+        : M_fp( nullptr ),
+          M_level( Z_DEFAULT_COMPRESSION ),
+          M_strategy( Z_DEFAULT_STRATEGY ),
+          M_max_pending( 0 ),
+          M_stop( false ),
+          M_crc( crc32( 0L, Z_NULL, 0 ) ),
+          M_total_size( 0 ),
+          M_error( false )
+      { }
+
+    ~ParallelGZWriter()
+      {
+          close();
+      }
+
+    bool open( const char * path,
+               const int level,
+               const int strategy,
+               const int threads )
+      {
+          M_fp = std::fopen( path, "wb" );
+          if ( ! M_fp )
+          {
+              return false;
+          }
+
+          M_level = level;
+          M_strategy = strategy;
+          M_max_pending = static_cast< std::size_t >( threads ) * 2;
+
+          // gzip header: no file name, no mtime, unix
+          const unsigned char header[10] = { 0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 3 };
+          if ( std::fwrite( header, 1, sizeof( header ), M_fp ) != sizeof( header ) )
+          {
+              M_error = true;
+          }
+
+          M_fill = std::make_shared< ParallelGZBlock >();
+
+          for ( int i = 0; i < threads; ++i )
+          {
+              M_workers.emplace_back( &ParallelGZWriter::workerMain, this );
+          }
+
+          return true;
+      }
+
+    bool write( const char * buf,
+                std::size_t size )
+      {
+          while ( size > 0 )
+          {
+              const std::size_t n = std::min( size, PARALLEL_BLOCK_SIZE - M_fill->in_.size() );
+              M_fill->in_.append( buf, n );
+              buf += n;
+              size -= n;
+
+              if ( M_fill->in_.size() == PARALLEL_BLOCK_SIZE )
+              {
+                  submit( false );
+              }
+          }
+
+          return ! M_error;
+      }
+
+    bool close()
+      {
+          if ( ! M_fp )
+          {
+              return false;
+          }
+
+          submit( true );
+          writeBlocks( true );
+
+          {
+              std::lock_guard< std::mutex > lock( M_mutex );
+              M_stop = true;
+          }
+          M_job_cond.notify_all();
+          for ( std::thread & t : M_workers )
+          {
+              t.join();
+          }
+          M_workers.clear();
+
+          unsigned char trailer[8];
+          for ( int i = 0; i < 4; ++i )
+          {
+              trailer[i] = static_cast< unsigned char >( ( M_crc >> ( 8 * i ) ) & 0xff );
+              trailer[4 + i] = static_cast< unsigned char >( ( M_total_size >> ( 8 * i ) ) & 0xff );
+          }
+          if ( std::fwrite( trailer, 1, sizeof( trailer ), M_fp ) != sizeof( trailer ) )
+          {
+              M_error = true;
+          }
+
+          if ( std::fclose( M_fp ) != 0 )
+          {
+              M_error = true;
+          }
+          M_fp = nullptr;
+
+          return ! M_error;
+      }
+
+private:
+
+    void submit( const bool last )
+      {
+          ParallelGZBlockPtr block = M_fill;
+          block->last_ = last;
+
+          M_fill = std::make_shared< ParallelGZBlock >();
+          if ( ! last )
+          {
+              const std::size_t dict_size = std::min( PARALLEL_DICT_SIZE, block->in_.size() );
+              M_fill->dict_.assign( block->in_, block->in_.size() - dict_size, dict_size );
+          }
+
+          {
+              std::lock_guard< std::mutex > lock( M_mutex );
+              M_jobs.push_back( block );
+              M_pending.push_back( block );
+          }
+          M_job_cond.notify_one();
+
+          writeBlocks( false );
+      }
+
+    /*!
+      \brief write the finished blocks in order.
+      \param all if true, wait until all pending blocks are written.
+      otherwise, wait only while too many blocks are pending.
+    */
+    void writeBlocks( const bool all )
+      {
+          std::unique_lock< std::mutex > lock( M_mutex );
+          while ( ! M_pending.empty() )
+          {
+              ParallelGZBlockPtr block = M_pending.front();
+              if ( ! block->done_ )
+              {
+                  if ( ! all && M_pending.size() <= M_max_pending )
+                  {
+                      break;
+                  }
+                  M_done_cond.wait( lock, [&]() { return block->done_; } );
+              }
+              M_pending.pop_front();
+
+              lock.unlock();
+              writeBlock( *block );
+              lock.lock();
+          }
+      }
+
+    void writeBlock( const ParallelGZBlock & block )
+      {
+          if ( block.error_
+               || std::fwrite( block.out_.data(), 1, block.out_.size(), M_fp ) != block.out_.size() )
+          {
+              M_error = true;
+          }
+
+          M_crc = crc32_combine( M_crc, block.crc_, static_cast< z_off_t >( block.in_.size() ) );
+          M_total_size += static_cast< uLong >( block.in_.size() );
+      }
+
+    void workerMain()
+      {
+          while ( true )
+          {
+              ParallelGZBlockPtr block;
+              {
+                  std::unique_lock< std::mutex > lock( M_mutex );
+                  M_job_cond.wait( lock, [this]() { return M_stop || ! M_jobs.empty(); } );
+                  if ( M_jobs.empty() )
+                  {
+                      return;
+                  }
+                  block = M_jobs.front();
+                  M_jobs.pop_front();
+              }
+
+              compress_block( *block, M_level, M_strategy );
+
+              {
+                  std::lock_guard< std::mutex > lock( M_mutex );
+                  block->done_ = true;
+              }
+              M_done_cond.notify_all();
+          }
+      }
+};
+#endif
+
+/////////////////////////////////////////////////////////////////////
+
 //! the implementation of file stream buffer
 struct gzfilebuf::Impl {
 
@@ -55,15 +407,44 @@ struct gzfilebuf::Impl {
 #ifdef HAVE_LIBZ
     //! gzip file
     gzFile file_;
+
+    //! parallel writer used instead of file_
+    std::unique_ptr< ParallelGZWriter > writer_;
 #endif
 
+    //! random access index used by reader_
+    std::unique_ptr< GZIndex > index_;
+
+    //! indexed reader used instead of file_
+    std::unique_ptr< GZIndexedReader > reader_;
+
+    //! index file path
+    std::string index_path_;
+
+    //! true if the index has been read from or written to index_path_
+    bool index_saved_;
+
     //! constructor
     Impl()
         : open_mode_( static_cast< std::ios_base::openmode >( 0 ) )
 #ifdef HAVE_LIBZ
         , file_( nullptr )
 #endif
+        , index_saved_( false )
       { }
+
+    //! write the index file when the lazy build is finished.
+    void saveIndex()
+      {
+          if ( index_
+               && ! index_saved_
+               && index_->isComplete() )
+          {
+              // failure is not fatal. the index is built again next time.
+              index_->write( index_path_ );
+              index_saved_ = true;
+          }
+      }
 };
 
 /////////////////////////////////////////////////////////////////////
@@ -109,7 +490,9 @@ gzfilebuf::is_open()
 {
 #ifdef HAVE_LIBZ
     if ( M_impl
-         && M_impl->file_ != nullptr  )
+         && ( M_impl->file_ != nullptr
+              || M_impl->writer_
+              || M_impl->reader_ ) )
     {
         //std::cerr << "gzfilebuf is open" << std::endl;
         return true;
@@ -125,7 +508,8 @@ gzfilebuf::is_open()
 gzfilebuf *
 gzfilebuf::open( const char * path,
                  std::ios_base::openmode mode,
-                 int level, int strategy )
+                 int level, int strategy,
+                 int threads )
 {
     gzfilebuf * ret = nullptr;
 #ifdef HAVE_LIBZ
@@ -154,12 +538,26 @@ gzfilebuf::open( const char * path,
             return ret;
         }
 
-        //std::cerr << "gzfilebuf::open call gzopen" << std::endl;
-        M_impl->file_ = gzopen( path, mode_str.c_str() );
-
-        if ( M_impl->file_ == nullptr )
+        if ( testo
+             && threads > 1 )
         {
-            return ret;
+            M_impl->writer_ = std::unique_ptr< ParallelGZWriter >( new ParallelGZWriter() );
+            if ( ! M_impl->writer_->open( path,
+                                          level, strategy, threads ) )
+            {
+                M_impl->writer_.reset();
+                return ret;
+            }
+        }
+        else
+        {
+            //std::cerr << "gzfilebuf::open call gzopen" << std::endl;
+            M_impl->file_ = gzopen( path, mode_str.c_str() );
+
+            if ( M_impl->file_ == nullptr )
+            {
+                return ret;
+            }
         }
 
         if ( M_buf )
@@ -196,6 +594,119 @@ gzfilebuf::open( const char * path,
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+gzfilebuf *
+gzfilebuf::openIndexed( const char * path,
+                        const char * index_path )
+{
+    gzfilebuf * ret = nullptr;
+#ifdef HAVE_LIBZ
+    if ( ! M_impl
+         || this->is_open() )
+    {
+        return ret;
+    }
+
+    unsigned char magic[2] = { 0, 0 };
+    std::FILE * fp = std::fopen( path, "rb" );
+    if ( ! fp )
+    {
+        return ret;
+    }
+    const std::size_t n = std::fread( magic, 1, 2, fp );
+    std::fclose( fp );
+
+    if ( n != 2
+         || magic[0] != 0x1f
+         || magic[1] != 0x8b )
+    {
+        // not gzipped. gzread reads the plain file transparently.
+        return open( path, std::ios_base::in );
+    }
+
+    M_impl->index_ = std::unique_ptr< GZIndex >( new GZIndex() );
+    M_impl->index_path_ = ( index_path
+                            ? std::string( index_path )
+                            : GZIndex::default_path( path ) );
+    // if the index file is not available, the index is built by the first full read.
+    M_impl->index_saved_ = M_impl->index_->read( M_impl->index_path_, path );
+
+    M_impl->reader_ = std::unique_ptr< GZIndexedReader >( new GZIndexedReader( *M_impl->index_ ) );
+    if ( ! M_impl->reader_->open( path ) )
+    {
+        M_impl->reader_.reset();
+        M_impl->index_.reset();
+        return ret;
+    }
+
+    if ( M_buf )
+    {
+        destroyInternalBuffer();
+    }
+
+    M_buf = new char_type[M_buf_size];
+    M_remained_size = 0;
+    this->setg( M_buf, M_buf, M_buf );
+    M_impl->open_mode_ = std::ios_base::in;
+
+    ret = this;
+#else
+    (void)path;
+    (void)index_path;
+#endif
+    return ret;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const GZIndex *
+gzfilebuf::index() const
+{
+    return ( M_impl
+             ? M_impl->index_.get()
+             : nullptr );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+gzfilebuf::buildIndex()
+{
+    if ( ! M_impl
+         || ! M_impl->reader_ )
+    {
+        return false;
+    }
+
+    if ( M_impl->index_->isComplete() )
+    {
+        return true;
+    }
+
+    const std::streampos pos = seekIndexed( 0, std::ios_base::cur );
+    M_remained_size = 0;
+    this->setg( M_buf, M_buf, M_buf );
+
+    // reading until the end of file completes the index.
+    char buf[8192];
+    while ( M_impl->reader_->read( buf, sizeof( buf ) ) > 0 )
+    {
+
+    }
+    M_impl->saveIndex();
+
+    seekIndexed( pos, std::ios_base::beg );
+
+    return M_impl->index_->isComplete();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 gzfilebuf *
 gzfilebuf::close() throw()
@@ -212,6 +723,21 @@ gzfilebuf::close() throw()
             return nullptr;
         }
         //std::cerr << "impl exist" << std::endl;
+        if ( M_impl->reader_ )
+        {
+            M_impl->saveIndex();
+            M_impl->reader_.reset();
+            M_impl->index_.reset();
+            M_impl->open_mode_ = static_cast< std::ios_base::openmode >( 0 );
+            return nullptr;
+        }
+        if ( M_impl->writer_ )
+        {
+            M_impl->writer_->close();
+            M_impl->writer_.reset();
+            M_impl->open_mode_ = static_cast< std::ios_base::openmode >( 0 );
+            return nullptr;
+        }
         if ( M_impl->file_ == nullptr )
         {
             //std::cerr << "file pointer is null" << std::endl;
@@ -250,7 +776,11 @@ gzfilebuf::flushBuf()
 
         if ( size > 0 )
         {
-            if ( gzwrite( M_impl->file_, M_buf, size ) != 0 )
+            if ( M_impl->writer_ )
+            {
+                ret = M_impl->writer_->write( M_buf, size );
+            }
+            else if ( gzwrite( M_impl->file_, M_buf, size ) != 0 )
             {
                 // gzflush( M_impl->file_, Z_SYNC_FLUSH );
                 ret = true;
@@ -405,6 +935,11 @@ gzfilebuf::seekoff( std::streamoff off,
 #ifdef HAVE_LIBZ
     if ( M_impl->open_mode_ & std::ios_base::in )
     {
+        if ( M_impl->reader_ )
+        {
+            return seekIndexed( off, way );
+        }
+
         if ( way & std::ios_base::beg )
         {
             ret = gzseek( M_impl->file_, off, SEEK_SET );
@@ -436,6 +971,11 @@ gzfilebuf::seekoff( std::streamoff off,
     if ( M_impl->open_mode_ & std::ios_base::out )
     {
         this->sync();
+        if ( M_impl->writer_ )
+        {
+            // the parallel writer cannot seek.
+            return -1;
+        }
         if ( way & std::ios_base::beg )
         {
             std::streampos cur = gztell( M_impl->file_ );
@@ -462,6 +1002,53 @@ gzfilebuf::seekoff( std::streamoff off,
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+std::streampos
+gzfilebuf::seekIndexed( std::streamoff off,
+                        std::ios_base::seekdir way )
+{
+    // the reader is ahead of the stream position by the buffered data.
+    const std::streamoff read_pos = static_cast< std::streamoff >( M_impl->reader_->tell() );
+    const std::streamoff buf_begin = read_pos - ( this->egptr() - this->eback() );
+    const std::streamoff cur = read_pos - ( this->egptr() - this->gptr() );
+
+    std::streamoff target = off;
+    if ( way == std::ios_base::cur )
+    {
+        target = cur + off;
+    }
+    else if ( way != std::ios_base::beg )
+    {
+        return -1;
+    }
+
+    if ( target < 0 )
+    {
+        return -1;
+    }
+
+    if ( buf_begin <= target
+         && target <= read_pos )
+    {
+        // the target is in the current buffer.
+        this->setg( this->eback(), this->eback() + ( target - buf_begin ), this->egptr() );
+        return target;
+    }
+
+    M_remained_size = 0;
+    this->setg( M_buf, M_buf, M_buf );
+
+    const std::int64_t ret = M_impl->reader_->seek( static_cast< std::uint64_t >( target ) );
+    M_impl->saveIndex();
+
+    return ( ret < 0
+             ? std::streampos( -1 )
+             : std::streampos( ret ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 std::streampos
 gzfilebuf::seekpos( std::streampos pos,
@@ -479,6 +1066,10 @@ gzfilebuf::seekpos( std::streampos pos,
          && ( mode & std::ios_base::in ) )
     {
         //std::cerr << "seekpos in " << pos << std::endl;
+        if ( M_impl->reader_ )
+        {
+            return seekIndexed( pos, std::ios_base::beg );
+        }
         ret = gzseek( M_impl->file_, pos, SEEK_SET );
         // and reset buffer pointer to initial position
         M_remained_size = 0;
@@ -489,6 +1080,11 @@ gzfilebuf::seekpos( std::streampos pos,
          && ( mode & std::ios_base::out ) )
     {
         //std::cerr << "seekpos out " << pos << std::endl;
+        if ( M_impl->writer_ )
+        {
+            // the parallel writer cannot seek.
+            return -1;
+        }
         std::streampos cur = gztell( M_impl->file_ );
         if ( pos <= cur )
         {
@@ -581,9 +1177,22 @@ gzfilebuf::underflow()
         M_buf[0] = M_remained_char;
     }
 
-    int read_size = gzread( M_impl->file_,
+    int read_size = 0;
+    if ( M_impl->reader_ )
+    {
+        read_size = M_impl->reader_->read( M_buf + M_remained_size,
+                                           M_buf_size * sizeof( char_type ) - M_remained_size );
+        if ( read_size == 0 )
+        {
+            M_impl->saveIndex();
+        }
+    }
+    else
+    {
+        read_size = gzread( M_impl->file_,
                             ( void* )( M_buf + M_remained_size ),
                             M_buf_size * sizeof( char_type ) - M_remained_size );
+    }
     if ( read_size <= 0 )
     {
         return traits_type::eof();
@@ -719,6 +1328,47 @@ gzifstream::open( const char * path )
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+gzifstream::openIndexed( const char * path,
+                         const char * index_path )
+{
+    if ( ! M_file_buf.openIndexed( path, index_path ) )
+    {
+        this->setstate( std::ios_base::failbit );
+    }
+    else
+    {
+        this->clear();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+gzifstream::seekMark( const int key )
+{
+    if ( ! M_file_buf.buildIndex() )
+    {
+        return false;
+    }
+
+    std::uint64_t offset = 0;
+    if ( ! M_file_buf.index()->findMark( key, &offset ) )
+    {
+        return false;
+    }
+
+    this->clear();
+    this->seekg( static_cast< std::streamoff >( offset ) );
+    return ! this->fail();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 gzifstream::close()
@@ -748,12 +1398,13 @@ gzofstream::gzofstream()
 */
 gzofstream::gzofstream( const char * path,
                         int level,
-                        int strategy )
+                        int strategy,
+                        int threads )
     : std::ostream( nullptr ),
       M_file_buf()
 {
     this->init( &M_file_buf );
-    this->open( path, level, strategy );
+    this->open( path, level, strategy, threads );
 }
 
 /*-------------------------------------------------------------------*/
@@ -763,9 +1414,10 @@ gzofstream::gzofstream( const char * path,
 void
 gzofstream::open( const char * path,
                   int level,
-                  int strategy )
+                  int strategy,
+                  int threads )
 {
-    if ( ! M_file_buf.open( path, std::ios_base::out, level, strategy ) )
+    if ( ! M_file_buf.open( path, std::ios_base::out, level, strategy, threads ) )
     {
         this->setstate( std::ios_base::failbit );
     }
@@ -38,6 +38,8 @@
 
 namespace rcsc {
 
+class GZIndex;
+
 /*!
   \class gzfilebuf
   \brief gzip file stream buffer class.
@@ -141,6 +143,9 @@ public:
       \param strategy compression strategy.
       Z_DEFAULT_COMPRESSION, Z_FILTERD, Z_HUFFMAN_ONLY or Z_RLE.
       For more details, see deflateInit2 in zlib.h.
+      \param threads the number of compression threads used in output mode.
+      If greater than 1, the data is split into blocks compressed in parallel
+      and written as one gzip member. Seeking is not supported in this case.
 
       If file is already opened, this method has no effect.
       If file is opened successfully, buffer is also allocated.
@@ -149,7 +154,34 @@ public:
     gzfilebuf * open( const char * path,
                       std::ios_base::openmode mode,
                       int level = DEFAULT_COMPRESSION,
-                      int strategy = DEFAULT_STRATEGY );
+                      int strategy = DEFAULT_STRATEGY,
+                      int threads = 1 );
+
+    /*!
+      \brief open the gzip file for random access input.
+      \param path file path
+      \param index_path index file path. if NULL, GZIndex::default_path( path ) is used.
+      \return this if opened, otherwise NULL.
+
+      If the index file is available, seeking starts from the nearest access point.
+      Otherwise, the index is built by the first full sequential read and is written
+      to the index file. A plain (not gzipped) file is opened by open().
+     */
+    gzfilebuf * openIndexed( const char * path,
+                             const char * index_path = nullptr );
+
+    /*!
+      \brief get the random access index
+      \return pointer to the index, or NULL if the file is not opened by openIndexed.
+     */
+    const GZIndex * index() const;
+
+    /*!
+      \brief complete the index by reading until the end of file if necessary.
+      The current position is restored.
+      \return true if the index is complete.
+     */
+    bool buildIndex();
 
     /*!
       \brief closes the file if opened.
@@ -190,6 +222,15 @@ private:
      */
     void destroyInternalBuffer() throw();
 
+    /*!
+      \brief seek the input opened by openIndexed.
+      \param off offset value
+      \param way std::ios_base::beg or std::ios_base::cur
+      \return new position, or -1.
+     */
+    std::streampos seekIndexed( std::streamoff off,
+                                std::ios_base::seekdir way );
+
 protected:
     //virtual
     //void imbue( const locale& loc );
@@ -349,6 +390,25 @@ public:
      */
     void open( const char * path );
 
+    /*!
+      \brief open gzipped file with the random access index.
+      \param path file path.
+      \param index_path index file path. if NULL, path + ".idx" is used.
+      See gzfilebuf::openIndexed().
+     */
+    void openIndexed( const char * path,
+                      const char * index_path = nullptr );
+
+    /*!
+      \brief move the read position to the line marked with the key.
+      \param key mark key. for rcg files, the game cycle of "(show <cycle>" lines.
+      \return true if the mark is found.
+
+      The file has to be opened by openIndexed(). If the index is not complete,
+      the rest of the file is read to build it.
+     */
+    bool seekMark( const int key );
+
     /*!
       \brief close gzipped file.
 
@@ -385,13 +445,15 @@ public:
       \param path file path.
       \param level compression level
       \param strategy compression strategy
+      \param threads the number of compression threads
 
       initialize stream buffer and open file
      */
     explicit
     gzofstream( const char* path,
                 int level = gzfilebuf::DEFAULT_COMPRESSION,
-                int strategy = gzfilebuf::DEFAULT_STRATEGY );
+                int strategy = gzfilebuf::DEFAULT_STRATEGY,
+                int threads = 1 );
 
     /*!
       \brief get const_cast<> pointer to the underlying stream buffer.
@@ -417,6 +479,8 @@ public:
       \param path file path.
       \param level compression level
       \param strategy compression strategy
+      \param threads the number of compression threads.
+      If greater than 1, blocks are compressed in parallel.
 
       Stream will be in state good() if file opens successfully;
       otherwise in state fail().
@@ -427,7 +491,8 @@ public:
     */
     void  open( const char * path,
                 int level = gzfilebuf::DEFAULT_COMPRESSION,
-                int strategy = gzfilebuf::DEFAULT_STRATEGY );
+                int strategy = gzfilebuf::DEFAULT_STRATEGY,
+                int threads = 1 );
 
     /*!
       \brief close gzipped file.
@@ -0,0 +1,1126 @@
+// -*-c++-*-
+
+/*!
+  \file gzindex.cpp
+  \brief random access index for gzip files Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "gzindex.h"
+
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace rcsc {
+
+const std::size_t GZIndex::DEFAULT_SPAN = 1024 * 1024;
+const std::size_t GZIndex::WINDOW_SIZE = 32 * 1024;
+
+namespace {
+
+//! index file magic
+const char INDEX_MAGIC[8] = { 'R', 'C', 'S', 'C', 'G', 'Z', 'I', '1' };
+
+//! input buffer size of the reader
+const std::size_t READ_BUFFER_SIZE = 16 * 1024;
+
+//! the number of characters checked to find a mark key
+const std::size_t MARK_KEY_LENGTH = 12;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::int64_t
+file_size( const std::string & path )
+{
+    std::FILE * fp = std::fopen( path.c_str(), "rb" );
+    if ( ! fp )
+    {
+        return -1;
+    }
+
+    std::int64_t size = -1;
+    if ( std::fseek( fp, 0, SEEK_END ) == 0 )
+    {
+        size = std::ftell( fp );
+    }
+    std::fclose( fp );
+    return size;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+template < typename T >
+bool
+write_value( std::FILE * fp,
+             const T & value )
+{
+    return std::fwrite( &value, sizeof( T ), 1, fp ) == 1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+template < typename T >
+bool
+read_value( std::FILE * fp,
+            T * value )
+{
+    return std::fread( value, sizeof( T ), 1, fp ) == 1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+write_string( std::FILE * fp,
+              const std::string & str )
+{
+    const std::uint32_t size = static_cast< std::uint32_t >( str.size() );
+    return write_value( fp, size )
+        && ( size == 0
+             || std::fwrite( str.data(), 1, size, fp ) == size );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+read_string( std::FILE * fp,
+             std::string * str )
+{
+    std::uint32_t size = 0;
+    if ( ! read_value( fp, &size )
+         || size > ( 1u << 24 ) )
+    {
+        return false;
+    }
+
+    str->resize( size );
+    return size == 0
+        || std::fread( &(*str)[0], 1, size, fp ) == size;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+append_varint( std::string & buf,
+               std::uint64_t value )
+{
+    while ( value >= 0x80 )
+    {
+        buf += static_cast< char >( ( value & 0x7f ) | 0x80 );
+        value >>= 7;
+    }
+    buf += static_cast< char >( value );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+parse_varint( const std::string & buf,
+              std::size_t * pos,
+              std::uint64_t * value )
+{
+    *value = 0;
+    for ( int shift = 0; shift < 64 && *pos < buf.size(); shift += 7 )
+    {
+        const unsigned char c = static_cast< unsigned char >( buf[(*pos)++] );
+        *value |= static_cast< std::uint64_t >( c & 0x7f ) << shift;
+        if ( ! ( c & 0x80 ) )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+inline
+std::uint64_t
+zigzag( const std::int64_t value )
+{
+    return ( static_cast< std::uint64_t >( value ) << 1 ) ^ static_cast< std::uint64_t >( value >> 63 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+inline
+std::int64_t
+unzigzag( const std::uint64_t value )
+{
+    return static_cast< std::int64_t >( value >> 1 ) ^ -static_cast< std::int64_t >( value & 1 );
+}
+
+}
+
+/////////////////////////////////////////////////////////////////////
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+GZIndex::GZIndex( const std::size_t span )
+    : M_span( std::max( span, WINDOW_SIZE ) ),
+      M_mark_prefix( "(show " ),
+      M_compressed_size( 0 ),
+      M_uncompressed_size( 0 ),
+      M_complete( false )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+GZIndex::clear()
+{
+    M_points.clear();
+    M_marks.clear();
+    M_compressed_size = 0;
+    M_uncompressed_size = 0;
+    M_complete = false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const GZIndex::Point *
+GZIndex::findPoint( const std::uint64_t offset ) const
+{
+    std::vector< Point >::const_iterator it
+        = std::upper_bound( M_points.begin(), M_points.end(), offset,
+                            []( const std::uint64_t lhs, const Point & rhs )
+                              {
+                                  return lhs < rhs.out_;
+                              } );
+    if ( it == M_points.begin() )
+    {
+        return nullptr;
+    }
+
+    return &( *( it - 1 ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+GZIndex::findMark( const int key,
+                   std::uint64_t * offset ) const
+{
+    if ( M_complete )
+    {
+        // sorted by the key in setComplete()
+        std::vector< std::pair< int, std::uint64_t > >::const_iterator it
+            = std::lower_bound( M_marks.begin(), M_marks.end(),
+                                std::make_pair( key, std::uint64_t( 0 ) ) );
+        if ( it == M_marks.end()
+             || it->first != key )
+        {
+            return false;
+        }
+        *offset = it->second;
+        return true;
+    }
+
+    for ( const std::pair< int, std::uint64_t > & m : M_marks )
+    {
+        if ( m.first == key )
+        {
+            *offset = m.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+GZIndex::addPoint( const std::uint64_t out,
+                   const std::uint64_t in,
+                   const int bits,
+                   const char * window,
+                   const std::size_t window_size )
+{
+    M_points.emplace_back();
+    Point & p = M_points.back();
+    p.out_ = out;
+    p.in_ = in;
+    p.bits_ = bits;
+    p.window_.assign( window, window_size );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+GZIndex::addMark( const int key,
+                  const std::uint64_t offset )
+{
+    M_marks.emplace_back( key, offset );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+GZIndex::setComplete( const std::uint64_t compressed_size,
+                      const std::uint64_t uncompressed_size )
+{
+    M_compressed_size = compressed_size;
+    M_uncompressed_size = uncompressed_size;
+
+    // the first line of each key is used.
+    std::sort( M_marks.begin(), M_marks.end() );
+    M_marks.erase( std::unique( M_marks.begin(), M_marks.end(),
+                                []( const std::pair< int, std::uint64_t > & lhs,
+                                    const std::pair< int, std::uint64_t > & rhs )
+                                  {
+                                      return lhs.first == rhs.first;
+                                  } ),
+                   M_marks.end() );
+
+    M_complete = true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+GZIndex::build( const std::string & gz_path )
+{
+    clear();
+
+    GZIndexedReader reader( *this );
+    if ( ! reader.open( gz_path ) )
+    {
+        return false;
+    }
+
+    std::string buf( READ_BUFFER_SIZE * 4, '\0' );
+    int n = 0;
+    while ( ( n = reader.read( &buf[0], buf.size() ) ) > 0 )
+    {
+
+    }
+
+    return n == 0
+        && M_complete;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+GZIndex::read( const std::string & index_path,
+               const std::string & gz_path )
+{
+    clear();
+
+#ifdef HAVE_LIBZ
+    const std::int64_t gz_size = file_size( gz_path );
+    if ( gz_size < 0 )
+    {
+        return false;
+    }
+
+    std::FILE * fp = std::fopen( index_path.c_str(), "rb" );
+    if ( ! fp )
+    {
+        return false;
+    }
+
+    char magic[8];
+    std::uint64_t compressed_size = 0, uncompressed_size = 0, span = 0;
+    std::uint32_t n_points = 0, n_marks = 0;
+    std::string prefix;
+
+    bool ok = ( std::fread( magic, 1, sizeof( magic ), fp ) == sizeof( magic )
+                && std::memcmp( magic, INDEX_MAGIC, sizeof( magic ) ) == 0
+                && read_value( fp, &compressed_size )
+                && read_value( fp, &uncompressed_size )
+                && read_value( fp, &span )
+                && read_string( fp, &prefix )
+                && read_value( fp, &n_points )
+                && read_value( fp, &n_marks )
+                && compressed_size == static_cast< std::uint64_t >( gz_size )
+                && prefix == M_mark_prefix );
+
+    std::string compressed;
+    for ( std::uint32_t i = 0; ok && i < n_points; ++i )
+    {
+        Point p;
+        std::int32_t bits = 0;
+        uLongf window_size = WINDOW_SIZE;
+        ok = ( read_value( fp, &p.out_ )
+               && read_value( fp, &p.in_ )
+               && read_value( fp, &bits )
+               && read_string( fp, &compressed ) );
+        if ( ok )
+        {
+            p.bits_ = bits;
+            p.window_.resize( WINDOW_SIZE );
+            ok = ( compressed.empty()
+                   ? ( window_size = 0, true )
+                   : uncompress( reinterpret_cast< Bytef * >( &p.window_[0] ), &window_size,
+                                 reinterpret_cast< const Bytef * >( compressed.data() ),
+                                 static_cast< uLong >( compressed.size() ) ) == Z_OK );
+            p.window_.resize( window_size );
+            M_points.push_back( std::move( p ) );
+        }
+    }
+
+    // marks are delta encoded varints, compressed as one block.
+    std::uint64_t marks_size = 0;
+    std::string marks;
+    ok = ( ok
+           && read_value( fp, &marks_size )
+           && read_string( fp, &compressed )
+           && marks_size <= ( 1u << 28 ) );
+    if ( ok
+         && n_marks > 0 )
+    {
+        uLongf size = static_cast< uLongf >( marks_size );
+        marks.resize( marks_size );
+        ok = ( uncompress( reinterpret_cast< Bytef * >( &marks[0] ), &size,
+                           reinterpret_cast< const Bytef * >( compressed.data() ),
+                           static_cast< uLong >( compressed.size() ) ) == Z_OK
+               && size == marks_size );
+    }
+
+    std::size_t pos = 0;
+    std::int64_t key = 0, offset = 0;
+    for ( std::uint32_t i = 0; ok && i < n_marks; ++i )
+    {
+        std::uint64_t dkey = 0, doffset = 0;
+        ok = ( parse_varint( marks, &pos, &dkey )
+               && parse_varint( marks, &pos, &doffset ) );
+        key += unzigzag( dkey );
+        offset += unzigzag( doffset );
+        if ( ok )
+        {
+            M_marks.emplace_back( static_cast< int >( key ), static_cast< std::uint64_t >( offset ) );
+        }
+    }
+
+    std::fclose( fp );
+
+    if ( ! ok )
+    {
+        clear();
+        return false;
+    }
+
+    M_span = static_cast< std::size_t >( span );
+    setComplete( compressed_size, uncompressed_size );
+    return true;
+#else
+    (void)index_path;
+    (void)gz_path;
+    return false;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+GZIndex::write( const std::string & index_path ) const
+{
+#ifdef HAVE_LIBZ
+    if ( ! M_complete )
+    {
+        return false;
+    }
+
+    std::FILE * fp = std::fopen( index_path.c_str(), "wb" );
+    if ( ! fp )
+    {
+        return false;
+    }
+
+    bool ok = ( std::fwrite( INDEX_MAGIC, 1, sizeof( INDEX_MAGIC ), fp ) == sizeof( INDEX_MAGIC )
+                && write_value( fp, M_compressed_size )
+                && write_value( fp, M_uncompressed_size )
+                && write_value( fp, static_cast< std::uint64_t >( M_span ) )
+                && write_string( fp, M_mark_prefix )
+                && write_value( fp, static_cast< std::uint32_t >( M_points.size() ) )
+                && write_value( fp, static_cast< std::uint32_t >( M_marks.size() ) ) );
+
+    // windows are text in most cases, so they are stored compressed.
+    std::string compressed;
+    for ( std::vector< Point >::const_iterator p = M_points.begin();
+          ok && p != M_points.end();
+          ++p )
+    {
+        uLongf size = 0;
+        if ( ! p->window_.empty() )
+        {
+            size = compressBound( static_cast< uLong >( p->window_.size() ) );
+            compressed.resize( size );
+            ok = ( compress2( reinterpret_cast< Bytef * >( &compressed[0] ), &size,
+                              reinterpret_cast< const Bytef * >( p->window_.data() ),
+                              static_cast< uLong >( p->window_.size() ),
+                              Z_BEST_SPEED ) == Z_OK );
+        }
+        compressed.resize( size );
+
+        ok = ( ok
+               && write_value( fp, p->out_ )
+               && write_value( fp, p->in_ )
+               && write_value( fp, static_cast< std::int32_t >( p->bits_ ) )
+               && write_string( fp, compressed ) );
+    }
+
+    std::string marks;
+    std::int64_t key = 0, offset = 0;
+    for ( const std::pair< int, std::uint64_t > & m : M_marks )
+    {
+        append_varint( marks, zigzag( m.first - key ) );
+        append_varint( marks, zigzag( static_cast< std::int64_t >( m.second ) - offset ) );
+        key = m.first;
+        offset = static_cast< std::int64_t >( m.second );
+    }
+
+    uLongf size = 0;
+    if ( ! marks.empty() )
+    {
+        size = compressBound( static_cast< uLong >( marks.size() ) );
+        compressed.resize( size );
+        ok = ( ok
+               && compress2( reinterpret_cast< Bytef * >( &compressed[0] ), &size,
+                             reinterpret_cast< const Bytef * >( marks.data() ),
+                             static_cast< uLong >( marks.size() ),
+                             Z_BEST_SPEED ) == Z_OK );
+    }
+    compressed.resize( size );
+
+    ok = ( ok
+           && write_value( fp, static_cast< std::uint64_t >( marks.size() ) )
+           && write_string( fp, compressed ) );
+
+    if ( std::fclose( fp ) != 0 )
+    {
+        ok = false;
+    }
+
+    if ( ! ok )
+    {
+        std::remove( index_path.c_str() );
+    }
+
+    return ok;
+#else
+    (void)index_path;
+    return false;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::string
+GZIndex::default_path( const std::string & gz_path )
+{
+    return gz_path + ".idx";
+}
+
+/////////////////////////////////////////////////////////////////////
+
+/*!
+  \struct GZIndexedReader::Impl
+  \brief the implementation of the indexed reader
+*/
+struct GZIndexedReader::Impl {
+
+    GZIndex & index_; //!< access points
+    std::FILE * fp_; //!< gzip file
+
+#ifdef HAVE_LIBZ
+    z_stream strm_; //!< inflate state
+    bool initialized_; //!< true if inflateInit2 succeeded
+#endif
+    std::string in_buf_; //!< compressed input buffer
+
+    std::uint64_t file_pos_; //!< file offset of the end of in_buf_ data
+    std::uint64_t out_; //!< current uncompressed offset
+    bool raw_; //!< true if the inflater was restarted from an access point
+    bool eof_; //!< true if the end of file is reached
+    bool error_; //!< true if the data is broken
+
+    bool building_; //!< true if the index is being built by the sequential read
+    std::uint64_t last_point_; //!< uncompressed offset of the last access point
+    std::string window_; //!< ring buffer of the last uncompressed data
+    std::size_t window_pos_; //!< next write position in window_
+    std::size_t window_filled_; //!< the number of valid bytes in window_
+
+    bool line_start_; //!< true if the next byte starts a line
+    bool line_checking_; //!< true if the current line may have a mark
+    std::uint64_t line_offset_; //!< offset of the current line
+    std::string line_head_; //!< the first characters of the current line
+
+    explicit
+    Impl( GZIndex & index )
+        : index_( index ),
+          fp_( nullptr ),
+#ifdef HAVE_LIBZ
+          initialized_( false ),
+#endif
+          in_buf_( READ_BUFFER_SIZE, '\0' ),
+          file_pos_( 0 ),
+          out_( 0 ),
+          raw_( false ),
+          eof_( false ),
+          error_( false ),
+          building_( false ),
+          last_point_( 0 ),
+          window_pos_( 0 ),
+          window_filled_( 0 ),
+          line_start_( true ),
+          line_checking_( false ),
+          line_offset_( 0 )
+      {
+#ifdef HAVE_LIBZ
+          strm_.zalloc = Z_NULL;
+          strm_.zfree = Z_NULL;
+          strm_.opaque = Z_NULL;
+          strm_.next_in = Z_NULL;
+          strm_.avail_in = 0;
+          // 15 + 32: detect the zlib or gzip header
+          initialized_ = ( inflateInit2( &strm_, 15 + 32 ) == Z_OK );
+#endif
+      }
+
+    ~Impl()
+      {
+          close();
+#ifdef HAVE_LIBZ
+          if ( initialized_ )
+          {
+              inflateEnd( &strm_ );
+          }
+#endif
+      }
+
+    void close()
+      {
+          if ( fp_ )
+          {
+              std::fclose( fp_ );
+              fp_ = nullptr;
+          }
+      }
+
+#ifdef HAVE_LIBZ
+    bool fillInput()
+      {
+          if ( strm_.avail_in > 0 )
+          {
+              return true;
+          }
+
+          const std::size_t n = std::fread( &in_buf_[0], 1, in_buf_.size(), fp_ );
+          if ( n == 0 )
+          {
+              return false;
+          }
+
+          file_pos_ += n;
+          strm_.next_in = reinterpret_cast< Bytef * >( &in_buf_[0] );
+          strm_.avail_in = static_cast< uInt >( n );
+          return true;
+      }
+
+    /*!
+      \brief restart decompression from the beginning of the file
+     */
+    bool rewind()
+      {
+          if ( std::fseek( fp_, 0, SEEK_SET ) != 0
+               || inflateReset2( &strm_, 15 + 32 ) != Z_OK )
+          {
+              return false;
+          }
+
+          file_pos_ = 0;
+          strm_.avail_in = 0;
+          out_ = 0;
+          raw_ = false;
+          eof_ = false;
+          error_ = false;
+
+          if ( building_ )
+          {
+              index_.clear();
+              last_point_ = 0;
+              window_.assign( GZIndex::WINDOW_SIZE, '\0' );
+              window_pos_ = 0;
+              window_filled_ = 0;
+              line_start_ = true;
+              line_checking_ = false;
+          }
+          return true;
+      }
+
+    /*!
+      \brief restart decompression from the access point
+     */
+    bool restart( const GZIndex::Point & p )
+      {
+          const std::uint64_t pos = p.in_ - ( p.bits_ ? 1 : 0 );
+          if ( std::fseek( fp_, static_cast< long >( pos ), SEEK_SET ) != 0
+               || inflateReset2( &strm_, -15 ) != Z_OK )
+          {
+              return false;
+          }
+
+          file_pos_ = pos;
+          strm_.avail_in = 0;
+
+          if ( p.bits_ )
+          {
+              const int c = std::fgetc( fp_ );
+              if ( c == EOF )
+              {
+                  return false;
+              }
+              ++file_pos_;
+              inflatePrime( &strm_, p.bits_, c >> ( 8 - p.bits_ ) );
+          }
+
+          if ( ! p.window_.empty() )
+          {
+              inflateSetDictionary( &strm_,
+                                    reinterpret_cast< const Bytef * >( p.window_.data() ),
+                                    static_cast< uInt >( p.window_.size() ) );
+          }
+
+          out_ = p.out_;
+          raw_ = true;
+          eof_ = false;
+          error_ = false;
+          return true;
+      }
+
+    /*!
+      \brief consume the gzip trailer after the raw deflate data
+     */
+    bool skipTrailer()
+      {
+          int rest = 8;
+          while ( rest > 0 )
+          {
+              if ( ! fillInput() )
+              {
+                  return false;
+              }
+              const int n = std::min( rest, static_cast< int >( strm_.avail_in ) );
+              strm_.next_in += n;
+              strm_.avail_in -= n;
+              rest -= n;
+          }
+          return true;
+      }
+#endif
+
+    /*!
+      \brief update the window and the marks by the new uncompressed data
+     */
+    void record( const char * data,
+                 const std::size_t size )
+      {
+          // window
+          const std::size_t wsize = window_.size();
+          std::size_t n = std::min( size, wsize );
+          const char * src = data + size - n;
+          window_filled_ = std::min( wsize, window_filled_ + n );
+          while ( n > 0 )
+          {
+              const std::size_t len = std::min( n, wsize - window_pos_ );
+              std::memcpy( &window_[window_pos_], src, len );
+              window_pos_ = ( window_pos_ + len ) % wsize;
+              src += len;
+              n -= len;
+          }
+
+          // marks
+          const std::string & prefix = index_.markPrefix();
+          if ( prefix.empty() )
+          {
+              return;
+          }
+
+          for ( std::size_t i = 0; i < size; ++i )
+          {
+              if ( line_start_ )
+              {
+                  line_start_ = false;
+                  line_checking_ = true;
+                  line_offset_ = out_ + i;
+                  line_head_.clear();
+              }
+
+              if ( data[i] == '\n' )
+              {
+                  if ( line_checking_ ) checkMark();
+                  line_start_ = true;
+                  continue;
+              }
+
+              if ( line_checking_ )
+              {
+                  line_head_ += data[i];
+                  if ( line_head_.size() >= prefix.size() + MARK_KEY_LENGTH )
+                  {
+                      checkMark();
+                  }
+              }
+          }
+      }
+
+    void checkMark()
+      {
+          line_checking_ = false;
+
+          const std::string & prefix = index_.markPrefix();
+          if ( line_head_.compare( 0, prefix.size(), prefix ) != 0 )
+          {
+              return;
+          }
+
+          const char * begin = line_head_.c_str() + prefix.size();
+          char * end = nullptr;
+          const long key = std::strtol( begin, &end, 10 );
+          if ( end != begin )
+          {
+              index_.addMark( static_cast< int >( key ), line_offset_ );
+          }
+      }
+
+    /*!
+      \brief store the window linearized in the access point
+     */
+    void addPoint( const std::uint64_t in,
+                   const int bits )
+      {
+          std::string linear;
+          linear.reserve( window_filled_ );
+          if ( window_filled_ == window_.size() )
+          {
+              linear.append( window_, window_pos_, std::string::npos );
+          }
+          linear.append( window_, 0, window_pos_ );
+          if ( linear.size() > window_filled_ )
+          {
+              linear.erase( 0, linear.size() - window_filled_ );
+          }
+
+          index_.addPoint( out_, in, bits, linear.data(), linear.size() );
+          last_point_ = out_;
+      }
+
+    int read( char * buf,
+              const std::size_t size )
+      {
+#ifdef HAVE_LIBZ
+          if ( ! fp_ || error_ )
+          {
+              return -1;
+          }
+
+          std::size_t produced = 0;
+          while ( produced < size
+                  && ! eof_ )
+          {
+              if ( ! fillInput() )
+              {
+                  // the stream is truncated
+                  error_ = true;
+                  eof_ = true;
+                  break;
+              }
+
+              strm_.next_out = reinterpret_cast< Bytef * >( buf + produced );
+              strm_.avail_out = static_cast< uInt >( size - produced );
+
+              const int ret = inflate( &strm_, building_ ? Z_BLOCK : Z_NO_FLUSH );
+              const std::size_t got = size - produced - strm_.avail_out;
+
+              if ( building_ && got > 0 )
+              {
+                  record( buf + produced, got );
+              }
+              produced += got;
+              out_ += got;
+
+              if ( ret == Z_NEED_DICT
+                   || ret == Z_DATA_ERROR
+                   || ret == Z_MEM_ERROR
+                   || ret == Z_STREAM_ERROR )
+              {
+                  error_ = true;
+                  building_ = false;
+                  return -1;
+              }
+
+              if ( ret == Z_STREAM_END )
+              {
+                  // the end of one gzip member. the file may have the following members.
+                  if ( ( raw_ && ! skipTrailer() )
+                       || ! fillInput() )
+                  {
+                      eof_ = true;
+                      break;
+                  }
+                  inflateReset2( &strm_, 15 + 32 );
+                  raw_ = false;
+                  continue;
+              }
+
+              if ( building_
+                   && ( strm_.data_type & 128 )
+                   && ! ( strm_.data_type & 64 )
+                   && ( out_ == 0 || out_ - last_point_ >= index_.span() ) )
+              {
+                  addPoint( file_pos_ - strm_.avail_in, strm_.data_type & 7 );
+              }
+          }
+
+          if ( eof_
+               && building_
+               && ! error_ )
+          {
+              index_.setComplete( file_pos_, out_ );
+              building_ = false;
+          }
+
+          return static_cast< int >( produced );
+#else
+          (void)buf;
+          (void)size;
+          return -1;
+#endif
+      }
+
+    std::int64_t seek( const std::uint64_t offset )
+      {
+#ifdef HAVE_LIBZ
+          if ( ! fp_ )
+          {
+              return -1;
+          }
+
+          if ( offset < out_
+               || error_ )
+          {
+              const GZIndex::Point * p = ( building_ ? nullptr : index_.findPoint( offset ) );
+              if ( p )
+              {
+                  if ( ! restart( *p ) ) return -1;
+              }
+              else
+              {
+                  // the index is being built: decompress again from the beginning.
+                  if ( ! rewind() ) return -1;
+              }
+          }
+          else if ( ! building_ )
+          {
+              // jump forward if the access point is closer than the current position.
+              const GZIndex::Point * p = index_.findPoint( offset );
+              if ( p
+                   && p->out_ > out_
+                   && ! restart( *p ) )
+              {
+                  return -1;
+              }
+          }
+
+          char buf[READ_BUFFER_SIZE];
+          while ( out_ < offset )
+          {
+              const std::size_t n = static_cast< std::size_t >( std::min< std::uint64_t >( sizeof( buf ), offset - out_ ) );
+              if ( read( buf, n ) <= 0 )
+              {
+                  return -1;
+              }
+          }
+
+          return static_cast< std::int64_t >( out_ );
+#else
+          (void)offset;
+          return -1;
+#endif
+      }
+};
+
+/////////////////////////////////////////////////////////////////////
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+GZIndexedReader::GZIndexedReader( GZIndex & index )
+    : M_impl( new Impl( index ) )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+GZIndexedReader::~GZIndexedReader()
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+GZIndexedReader::open( const std::string & gz_path )
+{
+#ifdef HAVE_LIBZ
+    if ( M_impl->fp_
+         || ! M_impl->initialized_ )
+    {
+        return false;
+    }
+
+    M_impl->fp_ = std::fopen( gz_path.c_str(), "rb" );
+    if ( ! M_impl->fp_ )
+    {
+        return false;
+    }
+
+    // an incomplete index is rebuilt by the sequential read.
+    M_impl->building_ = ! M_impl->index_.isComplete();
+    if ( ! M_impl->rewind() )
+    {
+        M_impl->close();
+        return false;
+    }
+
+    return true;
+#else
+    (void)gz_path;
+    return false;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+GZIndexedReader::close()
+{
+    M_impl->close();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+GZIndexedReader::isOpen() const
+{
+    return M_impl->fp_ != nullptr;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+GZIndexedReader::read( char * buf,
+                       const std::size_t size )
+{
+    return M_impl->read( buf, size );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::int64_t
+GZIndexedReader::seek( const std::uint64_t offset )
+{
+    return M_impl->seek( offset );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::uint64_t
+GZIndexedReader::tell() const
+{
+    return M_impl->out_;
+}
+
+}
@@ -0,0 +1,300 @@
+// -*-c++-*-
+
+/*!
+  \file gzindex.h
+  \brief random access index for gzip files Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_GZ_GZINDEX_H
+#define RCSC_GZ_GZINDEX_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+namespace rcsc {
+
+/*!
+  \class GZIndex
+  \brief zran style access points for a gzip file.
+
+  Each access point holds the uncompressed offset, the compressed offset
+  (with the bit position in the deflate stream) and the last 32KiB of the
+  uncompressed data before it. Decompression can be restarted from any
+  access point, so a seek costs at most one span of decompression.
+
+  The index also holds marks that map an integer key to the uncompressed
+  offset of a line. By default, "(show <cycle>" lines in rcg files are marked,
+  so that the reader can jump to a game cycle.
+*/
+class GZIndex {
+public:
+
+    //! default distance between access points in the uncompressed data
+    static const std::size_t DEFAULT_SPAN;
+
+    //! size of the saved window
+    static const std::size_t WINDOW_SIZE;
+
+    /*!
+      \struct Point
+      \brief an access point
+    */
+    struct Point {
+        std::uint64_t out_; //!< uncompressed offset
+        std::uint64_t in_; //!< compressed offset of the first full byte
+        int bits_; //!< the number of bits of the previous byte to be used, [0,7]
+        std::string window_; //!< preceding uncompressed data
+    };
+
+private:
+
+    std::size_t M_span; //!< distance between access points
+    std::string M_mark_prefix; //!< line prefix followed by the mark key
+
+    std::vector< Point > M_points; //!< access points sorted by the offset
+    std::vector< std::pair< int, std::uint64_t > > M_marks; //!< (key, line offset) sorted by the offset
+
+    std::uint64_t M_compressed_size; //!< size of the indexed file
+    std::uint64_t M_uncompressed_size; //!< total size of the uncompressed data
+    bool M_complete; //!< true if the whole file has been indexed
+
+public:
+
+    /*!
+      \brief create an empty index
+      \param span distance between access points
+    */
+    explicit
+    GZIndex( const std::size_t span = DEFAULT_SPAN );
+
+    /*!
+      \brief remove all access points and marks
+    */
+    void clear();
+
+    /*!
+      \brief set the line prefix recognized as a mark. empty string disables marks.
+      \param prefix line prefix followed by an integer key
+    */
+    void setMarkPrefix( const std::string & prefix )
+      {
+          M_mark_prefix = prefix;
+      }
+
+    /*!
+      \brief get the mark prefix
+      \return line prefix string
+    */
+    const std::string & markPrefix() const
+      {
+          return M_mark_prefix;
+      }
+
+    /*!
+      \brief get the distance between access points
+      \return span size
+    */
+    std::size_t span() const
+      {
+          return M_span;
+      }
+
+    /*!
+      \brief check if the whole file has been indexed
+      \return true if the index is complete
+    */
+    bool isComplete() const
+      {
+          return M_complete;
+      }
+
+    /*!
+      \brief get the access points
+      \return const reference to the container
+    */
+    const std::vector< Point > & points() const
+      {
+          return M_points;
+      }
+
+    /*!
+      \brief get the total uncompressed size. valid only if the index is complete.
+      \return size in bytes
+    */
+    std::uint64_t uncompressedSize() const
+      {
+          return M_uncompressed_size;
+      }
+
+    /*!
+      \brief get the nearest access point before the offset
+      \param offset uncompressed offset
+      \return pointer to the point, or nullptr
+    */
+    const Point * findPoint( const std::uint64_t offset ) const;
+
+    /*!
+      \brief get the offset of the line marked with the key
+      \param key mark key (e.g. game cycle)
+      \param offset pointer to the variable to store the uncompressed offset
+      \return true if found
+    */
+    bool findMark( const int key,
+                   std::uint64_t * offset ) const;
+
+    /*!
+      \brief scan the whole file and create the index
+      \param gz_path path to the gzip file
+      \return true if successfully indexed
+    */
+    bool build( const std::string & gz_path );
+
+    /*!
+      \brief read the index file
+      \param index_path path to the index file
+      \param gz_path path to the indexed gzip file. used to check the file size.
+      \return true if successfully read and the index matches the gzip file
+    */
+    bool read( const std::string & index_path,
+               const std::string & gz_path );
+
+    /*!
+      \brief write the index file. the index has to be complete.
+      \param index_path path to the index file
+      \return true if successfully written
+    */
+    bool write( const std::string & index_path ) const;
+
+    /*!
+      \brief get the default index file path
+      \param gz_path path to the gzip file
+      \return gz_path + ".idx"
+    */
+    static
+    std::string default_path( const std::string & gz_path );
+
+private:
+
+    friend class GZIndexedReader;
+
+    void addPoint( const std::uint64_t out,
+                   const std::uint64_t in,
+                   const int bits,
+                   const char * window,
+                   const std::size_t window_size );
+
+    void addMark( const int key,
+                  const std::uint64_t offset );
+
+    void setComplete( const std::uint64_t compressed_size,
+                      const std::uint64_t uncompressed_size );
+};
+
+/////////////////////////////////////////////////////////////////////
+
+/*!
+  \class GZIndexedReader
+  \brief gzip reader that seeks by the access points of GZIndex.
+
+  If the given index is not complete, the access points and the marks are
+  recorded while the file is read sequentially from the beginning.
+  The index becomes complete when the reader reaches the end of the file.
+*/
+class GZIndexedReader {
+private:
+    //! pimpl
+    struct Impl;
+
+    //! implementation object
+    std::unique_ptr< Impl > M_impl;
+
+    //! not used
+    GZIndexedReader( const GZIndexedReader & ) = delete;
+    //! not used
+    GZIndexedReader & operator=( const GZIndexedReader & ) = delete;
+
+public:
+
+    /*!
+      \brief create a reader that uses the index
+      \param index reference to the index. has to be alive while the reader is used.
+    */
+    explicit
+    GZIndexedReader( GZIndex & index );
+
+    /*!
+      \brief close the file
+    */
+    ~GZIndexedReader();
+
+    /*!
+      \brief open the gzip file
+      \param gz_path file path
+      \return true if opened
+    */
+    bool open( const std::string & gz_path );
+
+    /*!
+      \brief close the file
+    */
+    void close();
+
+    /*!
+      \brief check if the file is opened
+      \return true if opened
+    */
+    bool isOpen() const;
+
+    /*!
+      \brief read the uncompressed data
+      \param buf destination buffer
+      \param size buffer size
+      \return the number of read bytes, 0 at the end of file, -1 on error
+    */
+    int read( char * buf,
+              const std::size_t size );
+
+    /*!
+      \brief move the read position
+      \param offset uncompressed offset
+      \return new position, or -1 on error
+    */
+    std::int64_t seek( const std::uint64_t offset );
+
+    /*!
+      \brief get the current read position
+      \return uncompressed offset
+    */
+    std::uint64_t tell() const;
+};
+
+}
+
+#endif
@@ -0,0 +1,548 @@
+// -*-c++-*-
+
+/*!
+  \file monitor_client.cpp
+  \brief monitor client Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "monitor_client.h"
+
+#include "monitor_command.h"
+
+#include <rcsc/rcg/handler.h>
+#include <rcsc/rcg/parser_v4.h>
+#include <rcsc/rcg/parser_simdjson.h>
+#include <rcsc/net/udp_socket.h>
+
+#include <sstream>
+#include <iostream>
+#include <cstring>
+
+namespace rcsc {
+
+namespace {
+
+//! bits of all players
+constexpr std::uint32_t ALL_PLAYERS = ( 1u << ( MAX_PLAYER * 2 ) ) - 1;
+
+/*-------------------------------------------------------------------*/
+inline
+bool
+equals( const rcg::BallT & lhs,
+        const rcg::BallT & rhs )
+{
+    return ( lhs.x_ == rhs.x_
+             && lhs.y_ == rhs.y_
+             && lhs.vx_ == rhs.vx_
+             && lhs.vy_ == rhs.vy_ );
+}
+
+/*-------------------------------------------------------------------*/
+inline
+bool
+equals( const rcg::PlayerT & lhs,
+        const rcg::PlayerT & rhs )
+{
+    return ( lhs.x_ == rhs.x_
+             && lhs.y_ == rhs.y_
+             && lhs.vx_ == rhs.vx_
+             && lhs.vy_ == rhs.vy_
+             && lhs.body_ == rhs.body_
+             && lhs.neck_ == rhs.neck_
+             && lhs.state_ == rhs.state_
+             && lhs.side_ == rhs.side_
+             && lhs.unum_ == rhs.unum_
+             && lhs.type_ == rhs.type_
+             && lhs.view_quality_ == rhs.view_quality_
+             && lhs.view_width_ == rhs.view_width_
+             && lhs.focus_side_ == rhs.focus_side_
+             && lhs.focus_unum_ == rhs.focus_unum_
+             && lhs.focus_dist_ == rhs.focus_dist_
+             && lhs.focus_dir_ == rhs.focus_dir_
+             && lhs.point_x_ == rhs.point_x_
+             && lhs.point_y_ == rhs.point_y_
+             && lhs.stamina_ == rhs.stamina_
+             && lhs.effort_ == rhs.effort_
+             && lhs.recovery_ == rhs.recovery_
+             && lhs.stamina_capacity_ == rhs.stamina_capacity_
+             && lhs.kick_count_ == rhs.kick_count_
+             && lhs.dash_count_ == rhs.dash_count_
+             && lhs.turn_count_ == rhs.turn_count_
+             && lhs.catch_count_ == rhs.catch_count_
+             && lhs.move_count_ == rhs.move_count_
+             && lhs.turn_neck_count_ == rhs.turn_neck_count_
+             && lhs.change_view_count_ == rhs.change_view_count_
+             && lhs.say_count_ == rhs.say_count_
+             && lhs.tackle_count_ == rhs.tackle_count_
+             && lhs.pointto_count_ == rhs.pointto_count_
+             && lhs.attentionto_count_ == rhs.attentionto_count_
+             && lhs.change_focus_count_ == rhs.change_focus_count_ );
+}
+
+/*-------------------------------------------------------------------*/
+inline
+bool
+equals( const rcg::TeamT & lhs,
+        const rcg::TeamT & rhs )
+{
+    return ( lhs.score_ == rhs.score_
+             && lhs.pen_score_ == rhs.pen_score_
+             && lhs.pen_miss_ == rhs.pen_miss_
+             && lhs.name_ == rhs.name_ );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \class MonitorClient::Receiver
+  \brief parser callback that updates the client.
+*/
+class MonitorClient::Receiver
+    : public rcg::Handler {
+private:
+    MonitorClient & M_client;
+
+public:
+
+    explicit
+    Receiver( MonitorClient & client )
+        : M_client( client )
+      { }
+
+    bool handleEOF() override
+      {
+          return true;
+      }
+
+    bool handleShow( const rcg::ShowInfoT & show ) override
+      {
+          M_client.setShow( show );
+          return true;
+      }
+
+    bool handleMsg( const int time,
+                    const int board,
+                    const std::string & msg ) override
+      {
+          return ( ! M_client.M_event_handler
+                   || M_client.M_event_handler->handleMsg( time, board, msg ) );
+      }
+
+    bool handleDraw( const int time,
+                     const rcg::drawinfo_t & draw ) override
+      {
+          return ( ! M_client.M_event_handler
+                   || M_client.M_event_handler->handleDraw( time, draw ) );
+      }
+
+    bool handlePlayMode( const int time,
+                         const PlayMode pm ) override
+      {
+          M_client.setPlayMode( pm );
+          return ( ! M_client.M_event_handler
+                   || M_client.M_event_handler->handlePlayMode( time, pm ) );
+      }
+
+    bool handleTeam( const int time,
+                     const rcg::TeamT & team_l,
+                     const rcg::TeamT & team_r ) override
+      {
+          M_client.setTeam( team_l, team_r );
+          return ( ! M_client.M_event_handler
+                   || M_client.M_event_handler->handleTeam( time, team_l, team_r ) );
+      }
+
+    bool handleServerParam( const rcg::ServerParamT & param ) override
+      {
+          return ( ! M_client.M_event_handler
+                   || M_client.M_event_handler->handleServerParam( param ) );
+      }
+
+    bool handlePlayerParam( const rcg::PlayerParamT & param ) override
+      {
+          return ( ! M_client.M_event_handler
+                   || M_client.M_event_handler->handlePlayerParam( param ) );
+      }
+
+    bool handlePlayerType( const rcg::PlayerTypeT & param ) override
+      {
+          return ( ! M_client.M_event_handler
+                   || M_client.M_event_handler->handlePlayerType( param ) );
+      }
+
+    bool handleTeamGraphic( const char side,
+                            const int x,
+                            const int y,
+                            const std::vector< std::string > & xpm_data ) override
+      {
+          return ( ! M_client.M_event_handler
+                   || M_client.M_event_handler->handleTeamGraphic( side, x, y, xpm_data ) );
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+MonitorClient::MonitorClient()
+    : M_version( 0 ),
+      M_receiver( new Receiver( *this ) ),
+      M_parser( new rcg::ParserV4() ),
+      M_json_parser( new rcg::ParserSimdJSON() ),
+      M_event_handler( nullptr ),
+      M_receive_buffer( UDPSocket::MAX_BATCH_SIZE * MAX_PACKET_SIZE ),
+      M_receive_sizes( UDPSocket::MAX_BATCH_SIZE, 0 ),
+      M_front( 0 ),
+      M_show_count( 0 ),
+      M_playmode( PM_Null ),
+      M_ball_changed( false ),
+      M_player_changed( 0 ),
+      M_playmode_changed( false ),
+      M_team_changed( false ),
+      M_command_count( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+MonitorClient::~MonitorClient()
+{
+    disconnect();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+MonitorClient::connect( const char * hostname,
+                        const int port,
+                        const int version )
+{
+    disconnect();
+
+    M_socket.reset( new UDPSocket( hostname, port ) );
+    if ( M_socket->fd() == -1 )
+    {
+        std::cerr << "(MonitorClient::connect) Failed to create connection."
+                  << std::endl;
+        M_socket.reset();
+        return false;
+    }
+
+    M_version = version;
+    M_show_count = 0;
+    M_command_count = 0;
+
+    return sendCommand( MonitorInitCommand( version ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MonitorClient::disconnect()
+{
+    if ( M_socket )
+    {
+        sendCommand( MonitorByeCommand() );
+        M_socket.reset();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+MonitorClient::isConnected() const
+{
+    return ( M_socket
+             && M_socket->fd() != -1 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+MonitorClient::fd() const
+{
+    return ( M_socket
+             ? M_socket->fd()
+             : -1 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+MonitorClient::receive()
+{
+    if ( ! M_socket )
+    {
+        return -1;
+    }
+
+    clearChanges();
+
+    int total = 0;
+    while ( true )
+    {
+        const int n = M_socket->readDatagrams( M_receive_buffer.data(), MAX_PACKET_SIZE,
+                                               UDPSocket::MAX_BATCH_SIZE,
+                                               M_receive_sizes.data() );
+        if ( n < 0 )
+        {
+            return -1;
+        }
+
+        for ( int i = 0; i < n; ++i )
+        {
+            parsePacket( M_receive_buffer.data() + i * MAX_PACKET_SIZE,
+                         static_cast< std::size_t >( M_receive_sizes[i] ) );
+        }
+
+        total += n;
+
+        if ( n < UDPSocket::MAX_BATCH_SIZE )
+        {
+            break;
+        }
+    }
+
+    return total;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+MonitorClient::parsePacket( const char * data,
+                            std::size_t size )
+{
+    // the server sends null terminated strings.
+    while ( size > 0
+            && ( data[size - 1] == '\0' || data[size - 1] == '\n' ) )
+    {
+        --size;
+    }
+
+    if ( size == 0 )
+    {
+        return false;
+    }
+
+    if ( data[0] == '{' )
+    {
+        M_json_buffer.assign( data, size );
+        return M_json_parser->parseData( M_json_buffer, *M_receiver );
+    }
+
+    // team graphic packets are not supported by the rcg parser.
+    if ( size > 13
+         && ! std::strncmp( data, "(team_graphic", 13 ) )
+    {
+        return true;
+    }
+
+    return M_parser->parseLine( M_show_count, std::string_view( data, size ), *M_receiver );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MonitorClient::queueCommand( const MonitorCommand & com )
+{
+    if ( M_command_count == M_commands.size() )
+    {
+        M_commands.emplace_back();
+    }
+
+    std::ostringstream os;
+    com.toCommandString( os );
+    M_commands[M_command_count] = os.str();
+    ++M_command_count;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+MonitorClient::flush()
+{
+    if ( ! M_socket )
+    {
+        M_command_count = 0;
+        return -1;
+    }
+
+    const char * data[UDPSocket::MAX_BATCH_SIZE];
+    std::size_t len[UDPSocket::MAX_BATCH_SIZE];
+
+    int sent = 0;
+    std::size_t i = 0;
+    while ( i < M_command_count )
+    {
+        int count = 0;
+        while ( i < M_command_count
+                && count < UDPSocket::MAX_BATCH_SIZE )
+        {
+            // the terminating null character is sent together.
+            data[count] = M_commands[i].c_str();
+            len[count] = M_commands[i].length() + 1;
+            ++count;
+            ++i;
+        }
+
+        const int n = M_socket->writeDatagrams( data, len, count );
+        if ( n < 0 )
+        {
+            M_command_count = 0;
+            return ( sent > 0 ? sent : -1 );
+        }
+
+        sent += n;
+    }
+
+    M_command_count = 0;
+    return sent;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+MonitorClient::sendCommand( const MonitorCommand & com )
+{
+    const int count = static_cast< int >( M_command_count ) + 1;
+    queueCommand( com );
+    return flush() == count;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MonitorClient::clearChanges()
+{
+    M_ball_changed = false;
+    M_player_changed = 0;
+    M_playmode_changed = false;
+    M_team_changed = false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MonitorClient::setShow( const rcg::ShowInfoT & show )
+{
+    const int back = 1 - M_front;
+    M_show[back] = show;
+
+    const rcg::ShowInfoT & prev = M_show[M_front];
+    const rcg::ShowInfoT & cur = M_show[back];
+
+    if ( M_show_count == 0 )
+    {
+        M_ball_changed = true;
+        M_player_changed = ALL_PLAYERS;
+    }
+    else
+    {
+        if ( ! equals( cur.ball_, prev.ball_ ) )
+        {
+            M_ball_changed = true;
+        }
+
+        for ( int i = 0; i < MAX_PLAYER * 2; ++i )
+        {
+            if ( ! equals( cur.player_[i], prev.player_[i] ) )
+            {
+                M_player_changed |= ( 1u << i );
+            }
+        }
+    }
+
+    M_front = back;
+    ++M_show_count;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MonitorClient::setPlayMode( const PlayMode pm )
+{
+    if ( M_playmode != pm )
+    {
+        M_playmode = pm;
+        M_playmode_changed = true;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MonitorClient::setTeam( const rcg::TeamT & team_l,
+                        const rcg::TeamT & team_r )
+{
+    if ( ! equals( M_team[0], team_l ) )
+    {
+        M_team[0] = team_l;
+        M_team_changed = true;
+    }
+
+    if ( ! equals( M_team[1], team_r ) )
+    {
+        M_team[1] = team_r;
+        M_team_changed = true;
+    }
+}
+
+}
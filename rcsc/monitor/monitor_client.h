@@ -0,0 +1,336 @@
+// -*-c++-*-
+
+/*!
+  \file monitor_client.h
+  \brief monitor client Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_MONITOR_MONITOR_CLIENT_H
+#define RCSC_MONITOR_MONITOR_CLIENT_H
+
+#include <rcsc/rcg/types.h>
+#include <rcsc/types.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace rcsc {
+
+class MonitorCommand;
+class UDPSocket;
+
+namespace rcg {
+class Handler;
+class ParserV4;
+class ParserSimdJSON;
+}
+
+/*!
+  \class MonitorClient
+  \brief monitor protocol client that keeps the latest show data.
+
+  The client keeps one UDP connection to the server. receive() reads all
+  pending packets by batched system calls. The show packets are scanned in
+  place by the rcg parsers into the back buffer, compared with the front
+  buffer and swapped, so the caller can check what changed since the
+  previous receive() and skip the unchanged objects.
+
+  The commands are queued by queueCommand() and sent together by flush().
+*/
+class MonitorClient {
+public:
+
+    //! the maximum length of one monitor packet
+    static constexpr std::size_t MAX_PACKET_SIZE = 8192;
+
+private:
+
+    class Receiver;
+
+    std::unique_ptr< UDPSocket > M_socket; //!< connection to the server
+    int M_version; //!< monitor protocol version
+
+    std::unique_ptr< Receiver > M_receiver; //!< parser callback
+    std::unique_ptr< rcg::ParserV4 > M_parser; //!< parser for the s-expression packets
+    std::unique_ptr< rcg::ParserSimdJSON > M_json_parser; //!< parser for the JSON packets
+    rcg::Handler * M_event_handler; //!< receiver of the other records. may be NULL.
+
+    std::vector< char > M_receive_buffer; //!< datagrams received by one system call
+    std::vector< int > M_receive_sizes; //!< the length of each received datagram
+    std::string M_json_buffer; //!< reused copy of the JSON packet
+
+    rcg::ShowInfoT M_show[2]; //!< double buffered show data
+    int M_front; //!< index of the latest show in M_show
+    int M_show_count; //!< the number of received show packets
+
+    PlayMode M_playmode; //!< the latest playmode
+    rcg::TeamT M_team[2]; //!< the latest team data
+
+    bool M_ball_changed; //!< true if the ball is changed by the last receive()
+    std::uint32_t M_player_changed; //!< changed player bits by the last receive()
+    bool M_playmode_changed; //!< true if the playmode is changed by the last receive()
+    bool M_team_changed; //!< true if the team data is changed by the last receive()
+
+    std::vector< std::string > M_commands; //!< queued command strings. the memory is reused.
+    std::size_t M_command_count; //!< the number of queued commands
+
+    // not used
+    MonitorClient( const MonitorClient & ) = delete;
+    MonitorClient & operator=( const MonitorClient & ) = delete;
+
+public:
+
+    /*!
+      \brief create parsers and buffers
+     */
+    MonitorClient();
+
+    /*!
+      \brief close the connection
+     */
+    ~MonitorClient();
+
+    /*!
+      \brief connect to the server and send the init command
+      \param hostname server host name
+      \param port server monitor port number
+      \param version monitor protocol version
+      \return true if the init command is sent
+     */
+    bool connect( const char * hostname,
+                  const int port,
+                  const int version );
+
+    /*!
+      \brief send the bye command and close the connection
+     */
+    void disconnect();
+
+    /*!
+      \brief check if the connection is opened
+      \return checked result
+     */
+    bool isConnected() const;
+
+    /*!
+      \brief get the socket file descriptor for select() or poll()
+      \return file descriptor. -1 if not connected.
+     */
+    int fd() const;
+
+    /*!
+      \brief get the monitor protocol version
+      \return protocol version
+     */
+    int version() const
+      {
+          return M_version;
+      }
+
+    /*!
+      \brief set the receiver of the records other than show, playmode and team,
+      such as server_param, player_type and msg.
+      \param handler pointer to the handler. NULL disables the forwarding.
+     */
+    void setEventHandler( rcg::Handler * handler )
+      {
+          M_event_handler = handler;
+      }
+
+    /*!
+      \brief read and parse all pending packets without blocking.
+      the change flags are reset, then set by the received data.
+      \return the number of received packets, or -1 if an error occured.
+     */
+    int receive();
+
+    /*!
+      \brief parse one packet as if it was received from the server.
+      the change flags are not reset.
+      \param data packet data
+      \param size packet length
+      \return true if successfully parsed
+     */
+    bool parsePacket( const char * data,
+                      std::size_t size );
+
+    /*!
+      \brief add the command to the send queue
+      \param com command object
+     */
+    void queueCommand( const MonitorCommand & com );
+
+    /*!
+      \brief send all queued commands by one system call if possible
+      \return the number of sent commands, or -1 if an error occured.
+     */
+    int flush();
+
+    /*!
+      \brief send the command immediately together with the queued commands
+      \param com command object
+      \return true if all commands are sent
+     */
+    bool sendCommand( const MonitorCommand & com );
+
+    /*!
+      \brief get the number of received show packets
+      \return show count
+     */
+    int showCount() const
+      {
+          return M_show_count;
+      }
+
+    /*!
+      \brief get the latest show data
+      \return const reference to the show data
+     */
+    const rcg::ShowInfoT & show() const
+      {
+          return M_show[M_front];
+      }
+
+    /*!
+      \brief get the show data just before the latest one
+      \return const reference to the show data
+     */
+    const rcg::ShowInfoT & previousShow() const
+      {
+          return M_show[1 - M_front];
+      }
+
+    /*!
+      \brief get the latest playmode
+      \return playmode id
+     */
+    PlayMode playMode() const
+      {
+          return M_playmode;
+      }
+
+    /*!
+      \brief get the latest team data
+      \param side team side
+      \return const reference to the team data
+     */
+    const rcg::TeamT & team( const SideID side ) const
+      {
+          return M_team[side == RIGHT ? 1 : 0];
+      }
+
+    /*!
+      \brief check if the ball is changed by the last receive()
+      \return checked result
+     */
+    bool ballChanged() const
+      {
+          return M_ball_changed;
+      }
+
+    /*!
+      \brief check if the player is changed by the last receive()
+      \param index player index in ShowInfoT::player_
+      \return checked result
+     */
+    bool playerChanged( const int index ) const
+      {
+          return ( M_player_changed >> index ) & 1u;
+      }
+
+    /*!
+      \brief get the changed player bits. bit i is set if ShowInfoT::player_[i] is changed.
+      \return bit set
+     */
+    std::uint32_t changedPlayers() const
+      {
+          return M_player_changed;
+      }
+
+    /*!
+      \brief check if the playmode is changed by the last receive()
+      \return checked result
+     */
+    bool playModeChanged() const
+      {
+          return M_playmode_changed;
+      }
+
+    /*!
+      \brief check if the team data is changed by the last receive()
+      \return checked result
+     */
+    bool teamChanged() const
+      {
+          return M_team_changed;
+      }
+
+    /*!
+      \brief check if anything is changed by the last receive()
+      \return checked result
+     */
+    bool changed() const
+      {
+          return ( M_ball_changed
+                   || M_player_changed != 0
+                   || M_playmode_changed
+                   || M_team_changed );
+      }
+
+    /*!
+      \brief reset all change flags
+     */
+    void clearChanges();
+
+private:
+
+    /*!
+      \brief update the show data by the parsed data
+      \param show parsed show data
+     */
+    void setShow( const rcg::ShowInfoT & show );
+
+    /*!
+      \brief update the playmode by the parsed data
+      \param pm parsed playmode
+     */
+    void setPlayMode( const PlayMode pm );
+
+    /*!
+      \brief update the team data by the parsed data
+      \param team_l parsed left team data
+      \param team_r parsed right team data
+     */
+    void setTeam( const rcg::TeamT & team_l,
+                  const rcg::TeamT & team_r );
+};
+
+}
+
+#endif
@@ -169,72 +169,25 @@ bool
 AbstractSocket::setPeerAddress( const char * hostname,
                                 const HostAddress::PortNumber port )
 {
-    HostAddress::AddrType dest_addr;
-
-#ifdef HAVE_GETADDRINFO
-    struct addrinfo hints;
-    std::memset( &hints, 0, sizeof( hints ) );
-    hints.ai_family = AF_INET;
-    hints.ai_socktype = M_socket_type;
-    hints.ai_protocol = 0;
-
-    struct addrinfo * res;
-    int err = ::getaddrinfo( hostname, NULL, &hints, &res );
-    if ( err != 0 )
+    // the address is shared by all sockets in this process that connect to the same host.
+    HostAddress::IPV4Address address = 0;
+    if ( ! HostAddress::resolve( hostname, &address ) )
     {
         std::cerr << "(AbstractSocket::setAddr) ***ERROR*** failed to resolve the host ["
                   << hostname << "]" << std::endl;
-        std::cerr << "(AbstractSocket::setAddr) error=" << err << ' '
-                  << gai_strerror( err ) << std::endl;
         this->close();
         return false;
-
-    }
-
-    dest_addr.sin_addr.s_addr = (reinterpret_cast< struct sockaddr_in * >(res->ai_addr))->sin_addr.s_addr;
-    dest_addr.sin_family = AF_INET;
-    dest_addr.sin_port = htons( port );
-
-    M_peer_address.setAddress( dest_addr );
-
-    ::freeaddrinfo( res );
-    return true;
-
-#endif
-
-#ifdef HAVE_GETHOSTBYNAME
-#ifdef HAVE_INET_ADDR
-    dest_addr.sin_addr.s_addr = ::inet_addr( hostname );
-    if ( dest_addr.sin_addr.s_addr == 0xffffffff )
-#endif
-    {
-        struct hostent * host_entry = ::gethostbyname( hostname );
-        if ( ! host_entry )
-        {
-            std::cerr << hstrerror( h_errno ) << std::endl;
-            std::cerr << "(AbstractSocket::setAddr) host not found ["
-                      << hostname << "]" << std::endl;
-            this->close();
-            return false;
-        }
-
-        std::memcpy( &(dest_addr.sin_addr.s_addr),
-                     host_entry->h_addr_list[0],
-                     host_entry->h_length );
     }
 
+    HostAddress::AddrType dest_addr;
+    std::memset( &dest_addr, 0, sizeof( dest_addr ) );
+    dest_addr.sin_addr.s_addr = address;
     dest_addr.sin_family = AF_INET;
     dest_addr.sin_port = htons( port );
 
     M_peer_address.setAddress( dest_addr );
 
     return true;
-#endif
-
-    std::cerr << "(AbstractSocket::setAddr) ***ERROR*** no getaddrinfo or gethostbyname."
-              << "failed to resolve the host [" << hostname << "]" << std::endl;
-    this->close();
-    return false;
 }
 
 /*-------------------------------------------------------------------*/
@@ -36,8 +36,13 @@
 #include "host_address.h"
 
 #include <iostream>
+#include <mutex>
+#include <unordered_map>
 #include <cstring>
 
+#ifdef HAVE_NETDB_H
+#include <netdb.h> // gethostbyname(), getaddrinfo(), freeaddrinfo()
+#endif
 #ifdef HAVE_SYS_SOCKET_H
 #include <sys/socket.h>
 #endif
@@ -50,6 +55,97 @@
 
 namespace rcsc {
 
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief process wide cache of the resolved addresses
+ */
+struct ResolveCache {
+    std::mutex mutex_;
+    std::unordered_map< std::string, std::shared_future< HostAddress::Resolved > > entries_;
+
+    static
+    ResolveCache & instance()
+      {
+          static ResolveCache s_instance;
+          return s_instance;
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief resolve the host name by the system resolver
+  \param hostname host name or IP address string
+  \return result
+ */
+HostAddress::Resolved
+lookup_host( const std::string & hostname )
+{
+    HostAddress::Resolved result;
+    result.found_ = false;
+    result.address_ = 0;
+
+#if defined(HAVE_GETADDRINFO)
+    struct addrinfo hints;
+    std::memset( &hints, 0, sizeof( hints ) );
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = 0;
+    hints.ai_protocol = 0;
+
+    struct addrinfo * res;
+    int err = ::getaddrinfo( hostname.c_str(), NULL, &hints, &res );
+    if ( err != 0 )
+    {
+        std::cerr << "(HostAddress::resolve) ***ERROR*** failed to resolve the host ["
+                  << hostname << "]" << std::endl;
+        std::cerr << "(HostAddress::resolve) error=" << err << ' '
+                  << gai_strerror( err ) << std::endl;
+        return result;
+    }
+
+    result.found_ = true;
+    result.address_ = (reinterpret_cast< struct sockaddr_in * >(res->ai_addr))->sin_addr.s_addr;
+
+    ::freeaddrinfo( res );
+
+#elif defined(HAVE_GETHOSTBYNAME)
+# ifdef HAVE_INET_ADDR
+    result.address_ = ::inet_addr( hostname.c_str() );
+    if ( result.address_ != 0xffffffff )
+    {
+        result.found_ = true;
+        return result;
+    }
+# endif
+
+    // gethostbyname() is not reentrant
+    static std::mutex s_mutex;
+    std::lock_guard< std::mutex > lock( s_mutex );
+
+    struct hostent * host_entry = ::gethostbyname( hostname.c_str() );
+    if ( ! host_entry )
+    {
+        std::cerr << hstrerror( h_errno ) << std::endl;
+        std::cerr << "(HostAddress::resolve) host not found ["
+                  << hostname << "]" << std::endl;
+        return result;
+    }
+
+    result.found_ = true;
+    std::memcpy( &result.address_,
+                 host_entry->h_addr_list[0],
+                 sizeof( result.address_ ) );
+#else
+    std::cerr << "(HostAddress::resolve) ***ERROR*** no getaddrinfo or gethostbyname."
+              << "failed to resolve the host [" << hostname << "]" << std::endl;
+#endif
+
+    return result;
+}
+
+}
+
 class HostAddress::Impl {
 public:
     struct sockaddr_in addr_;
@@ -224,4 +320,70 @@ HostAddress::toAddress() const
     return M_impl->addr_;
 }
 
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::shared_future< HostAddress::Resolved >
+HostAddress::resolve_async( const std::string & hostname )
+{
+    ResolveCache & cache = ResolveCache::instance();
+
+    std::lock_guard< std::mutex > lock( cache.mutex_ );
+
+    std::unordered_map< std::string, std::shared_future< Resolved > >::iterator it = cache.entries_.find( hostname );
+    if ( it != cache.entries_.end() )
+    {
+        return it->second;
+    }
+
+    std::shared_future< Resolved > result
+        = std::async( std::launch::async,
+                      [hostname]()
+                        {
+                            const Resolved r = lookup_host( hostname );
+                            if ( ! r.found_ )
+                            {
+                                // do not keep the failure. the next request tries again.
+                                ResolveCache & c = ResolveCache::instance();
+                                std::lock_guard< std::mutex > l( c.mutex_ );
+                                c.entries_.erase( hostname );
+                            }
+                            return r;
+                        } ).share();
+
+    cache.entries_.emplace( hostname, result );
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+HostAddress::resolve( const std::string & hostname,
+                      IPV4Address * address )
+{
+    const Resolved r = resolve_async( hostname ).get();
+    if ( r.found_ )
+    {
+        *address = r.address_;
+    }
+    return r.found_;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+HostAddress::clear_cache()
+{
+    ResolveCache & cache = ResolveCache::instance();
+
+    std::lock_guard< std::mutex > lock( cache.mutex_ );
+    cache.entries_.clear();
+}
+
 }
@@ -32,6 +32,7 @@
 #ifndef RCSC_NET_HOST_ADDRESS_H
 #define RCSC_NET_HOST_ADDRESS_H
 
+#include <future>
 #include <memory>
 #include <string>
 #include <cstdint>
@@ -46,6 +47,15 @@ public:
     typedef std::uint32_t IPV4Address; //!< binary ipv4 host address type
     typedef struct sockaddr_in AddrType; //!< binary ipv4 host address type
 
+    /*!
+      \struct Resolved
+      \brief result of the host name resolution
+     */
+    struct Resolved {
+        bool found_; //!< true if the host name is resolved
+        IPV4Address address_; //!< resolved address in the network byte order
+    };
+
 private:
 
     class Impl; //!< pimpl idiom
@@ -141,6 +151,34 @@ public:
       \return const reference to the raw address object.
     */
     const AddrType & toAddress() const;
+
+    /*!
+      \brief start resolving the host name in the background.
+      \param hostname host name or IP address string
+      \return future of the result
+
+      The result is cached in the process. All sockets that refer the same
+      host name share one lookup, even if they request it concurrently.
+      A failed lookup is not cached, so that it can be retried.
+     */
+    static
+    std::shared_future< Resolved > resolve_async( const std::string & hostname );
+
+    /*!
+      \brief resolve the host name using the process wide cache.
+      \param hostname host name or IP address string
+      \param address pointer to the variable to store the address in the network byte order
+      \return true if resolved
+     */
+    static
+    bool resolve( const std::string & hostname,
+                  IPV4Address * address );
+
+    /*!
+      \brief clear the resolved address cache
+     */
+    static
+    void clear_cache();
 };
 
 }
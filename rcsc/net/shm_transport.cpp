@@ -0,0 +1,598 @@
+// -*-c++-*-
+
+/*!
+  \file shm_transport.cpp
+  \brief shared memory message transport Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA, Hiroki SHIMORA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "shm_transport.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <sstream>
+#include <iostream>
+#include <cerrno>
+#include <cstring>
+
+#ifdef HAVE_SHM_OPEN
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+#ifdef HAVE_LINUX_FUTEX_H
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#endif
+
+namespace rcsc {
+
+constexpr std::size_t ShmTransport::DEFAULT_RING_CAPACITY;
+
+/*-------------------------------------------------------------------*/
+/*!
+  \struct ShmTransport::Header
+  \brief segment header
+*/
+struct ShmTransport::Header {
+    char magic_[8];
+    std::uint32_t version_;
+    std::uint32_t ring_capacity_; //!< data size of each ring
+    std::int32_t client_pid_;
+    std::atomic< std::int32_t > server_pid_; //!< 0 until the server side attaches
+    std::atomic< std::uint32_t > client_closed_;
+    std::atomic< std::uint32_t > server_closed_;
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \struct ShmTransport::Ring
+  \brief control block of the single producer single consumer ring.
+  the positions are free running byte counters.
+*/
+struct ShmTransport::Ring {
+    alignas( 64 ) std::atomic< std::uint32_t > head_; //!< consumer position
+    alignas( 64 ) std::atomic< std::uint32_t > tail_; //!< producer position
+    alignas( 64 ) std::atomic< std::uint32_t > seq_; //!< futex word. incremented by every push.
+    std::atomic< std::uint32_t > waiters_; //!< the number of the sleeping consumers
+};
+
+namespace {
+
+const char TRANSPORT_MAGIC[8] = { 'R', 'C', 'S', 'C', 'T', 'R', 'P', '\0' };
+const std::uint32_t TRANSPORT_VERSION = 1;
+
+//! the size of the header area. the rings start at the cache line boundary.
+const std::size_t HEADER_SIZE = 64;
+//! the size of the ring control block
+const std::size_t RING_SIZE = 192;
+
+//! the size of the length field of each record
+const std::uint32_t LENGTH_SIZE = sizeof( std::uint32_t );
+
+//! the maximum ring capacity. the free running counters must not overflow the capacity.
+const std::size_t MAX_RING_CAPACITY = std::size_t( 1 ) << 30;
+
+static_assert( std::atomic< std::uint32_t >::is_always_lock_free
+               && std::atomic< std::int32_t >::is_always_lock_free,
+               "the transport atomics must be lock free to be shared among processes." );
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief round up the value to the multiple of 4
+ */
+inline
+std::uint32_t
+align4( const std::uint32_t value )
+{
+    return ( value + 3u ) & ~3u;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief check if the process has died
+ */
+inline
+bool
+is_dead_process( const std::int32_t pid )
+{
+#ifdef HAVE_SHM_OPEN
+    return ( pid > 0
+             && ::kill( pid, 0 ) != 0
+             && errno == ESRCH );
+#else
+    (void)pid;
+    return false;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief sleep while the futex word has the expected value
+ */
+void
+futex_wait( std::atomic< std::uint32_t > * word,
+            const std::uint32_t expected,
+            const int timeout_msec )
+{
+#ifdef HAVE_LINUX_FUTEX_H
+    struct timespec ts;
+    ts.tv_sec = timeout_msec / 1000;
+    ts.tv_nsec = static_cast< long >( timeout_msec % 1000 ) * 1000000L;
+    // the segment is shared among processes, so FUTEX_PRIVATE_FLAG is not used.
+    ::syscall( SYS_futex, reinterpret_cast< std::uint32_t * >( word ),
+               FUTEX_WAIT, expected, &ts, nullptr, 0 );
+#else
+    const std::chrono::steady_clock::time_point end
+        = std::chrono::steady_clock::now() + std::chrono::milliseconds( timeout_msec );
+    while ( word->load() == expected
+            && std::chrono::steady_clock::now() < end )
+    {
+        std::this_thread::sleep_for( std::chrono::microseconds( 200 ) );
+    }
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief wake up the sleeping consumers
+ */
+void
+futex_wake( std::atomic< std::uint32_t > * word )
+{
+#ifdef HAVE_LINUX_FUTEX_H
+    ::syscall( SYS_futex, reinterpret_cast< std::uint32_t * >( word ),
+               FUTEX_WAKE, 1, nullptr, nullptr, 0 );
+#else
+    (void)word;
+#endif
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ShmTransport::ShmTransport()
+    : M_side( CLIENT_SIDE ),
+      M_segment( nullptr ),
+      M_segment_size( 0 ),
+      M_send_ring( nullptr ),
+      M_send_data( nullptr ),
+      M_recv_ring( nullptr ),
+      M_recv_data( nullptr ),
+      M_ring_capacity( 0 )
+{
+    static_assert( sizeof( Header ) <= HEADER_SIZE,
+                   "transport header must fit in HEADER_SIZE." );
+    static_assert( sizeof( Ring ) == RING_SIZE,
+                   "unexpected ring control block size." );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ShmTransport::~ShmTransport()
+{
+    close();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ShmTransport::is_supported()
+{
+#ifdef HAVE_SHM_OPEN
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::string
+ShmTransport::make_name()
+{
+    static std::atomic< int > s_count( 0 );
+
+    std::ostringstream os;
+    os << "/rcsc.transport";
+#ifdef HAVE_SHM_OPEN
+    os << '.' << ::getuid() << '.' << ::getpid();
+#endif
+    os << '.' << s_count.fetch_add( 1 );
+    return os.str();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ShmTransport::create( const std::string & name,
+                      const std::size_t ring_capacity )
+{
+    close();
+
+#ifdef HAVE_SHM_OPEN
+    std::size_t capacity = 64;
+    while ( capacity < ring_capacity
+            && capacity < MAX_RING_CAPACITY )
+    {
+        capacity *= 2;
+    }
+
+    const std::size_t size = HEADER_SIZE + RING_SIZE * 2 + capacity * 2;
+
+    const int fd = ::shm_open( name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600 );
+    if ( fd < 0 )
+    {
+        std::cerr << "(ShmTransport::create) could not create the segment "
+                  << name << ": " << std::strerror( errno ) << std::endl;
+        return false;
+    }
+
+    void * addr = MAP_FAILED;
+    if ( ::ftruncate( fd, size ) == 0 )
+    {
+        addr = ::mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    }
+    ::close( fd );
+
+    if ( addr == MAP_FAILED )
+    {
+        ::shm_unlink( name.c_str() );
+        return false;
+    }
+
+    // the new segment is zero filled. then, the rings are empty.
+    M_segment = static_cast< char * >( addr );
+    M_segment_size = size;
+    M_name = name;
+    M_side = CLIENT_SIDE;
+    M_ring_capacity = static_cast< std::uint32_t >( capacity );
+
+    Header * header = reinterpret_cast< Header * >( M_segment );
+    header->version_ = TRANSPORT_VERSION;
+    header->ring_capacity_ = M_ring_capacity;
+    header->client_pid_ = static_cast< std::int32_t >( ::getpid() );
+    std::memcpy( header->magic_, TRANSPORT_MAGIC, sizeof( TRANSPORT_MAGIC ) );
+
+    char * to_server = M_segment + HEADER_SIZE;
+    char * to_client = to_server + RING_SIZE;
+    M_send_ring = reinterpret_cast< Ring * >( to_server );
+    M_recv_ring = reinterpret_cast< Ring * >( to_client );
+    M_send_data = M_segment + HEADER_SIZE + RING_SIZE * 2;
+    M_recv_data = M_send_data + capacity;
+
+    return true;
+#else
+    (void)name;
+    (void)ring_capacity;
+    return false;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ShmTransport::attach( const std::string & name )
+{
+    close();
+
+#ifdef HAVE_SHM_OPEN
+    const int fd = ::shm_open( name.c_str(), O_RDWR, 0 );
+    if ( fd < 0 )
+    {
+        std::cerr << "(ShmTransport::attach) could not open the segment "
+                  << name << ": " << std::strerror( errno ) << std::endl;
+        return false;
+    }
+
+    struct stat st;
+    if ( ::fstat( fd, &st ) != 0
+         || static_cast< std::size_t >( st.st_size ) < HEADER_SIZE + RING_SIZE * 2 )
+    {
+        ::close( fd );
+        return false;
+    }
+
+    const std::size_t size = static_cast< std::size_t >( st.st_size );
+    void * addr = ::mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    ::close( fd );
+
+    if ( addr == MAP_FAILED )
+    {
+        return false;
+    }
+
+    Header * header = static_cast< Header * >( addr );
+    const std::size_t capacity = header->ring_capacity_;
+    if ( std::memcmp( header->magic_, TRANSPORT_MAGIC, sizeof( TRANSPORT_MAGIC ) ) != 0
+         || header->version_ != TRANSPORT_VERSION
+         || capacity == 0
+         || ( capacity & ( capacity - 1 ) ) != 0
+         || size != HEADER_SIZE + RING_SIZE * 2 + capacity * 2 )
+    {
+        std::cerr << "(ShmTransport::attach) unsupported segment " << name << std::endl;
+        ::munmap( addr, size );
+        return false;
+    }
+
+    M_segment = static_cast< char * >( addr );
+    M_segment_size = size;
+    M_name = name;
+    M_side = SERVER_SIDE;
+    M_ring_capacity = static_cast< std::uint32_t >( capacity );
+
+    char * to_server = M_segment + HEADER_SIZE;
+    char * to_client = to_server + RING_SIZE;
+    M_send_ring = reinterpret_cast< Ring * >( to_client );
+    M_recv_ring = reinterpret_cast< Ring * >( to_server );
+    M_recv_data = M_segment + HEADER_SIZE + RING_SIZE * 2;
+    M_send_data = M_recv_data + capacity;
+
+    header->server_pid_.store( static_cast< std::int32_t >( ::getpid() ) );
+
+    return true;
+#else
+    (void)name;
+    return false;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ShmTransport::close()
+{
+    if ( ! M_segment )
+    {
+        return;
+    }
+
+#ifdef HAVE_SHM_OPEN
+    Header * header = reinterpret_cast< Header * >( M_segment );
+    if ( M_side == CLIENT_SIDE )
+    {
+        header->client_closed_.store( 1 );
+        ::shm_unlink( M_name.c_str() );
+    }
+    else
+    {
+        header->server_closed_.store( 1 );
+    }
+
+    // wake up the peer waiting for the message
+    M_send_ring->seq_.fetch_add( 1 );
+    futex_wake( &M_send_ring->seq_ );
+
+    ::munmap( M_segment, M_segment_size );
+#endif
+
+    M_segment = nullptr;
+    M_segment_size = 0;
+    M_send_ring = nullptr;
+    M_send_data = nullptr;
+    M_recv_ring = nullptr;
+    M_recv_data = nullptr;
+    M_ring_capacity = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ShmTransport::isPeerAttached() const
+{
+    if ( ! M_segment )
+    {
+        return false;
+    }
+
+    const Header * header = reinterpret_cast< const Header * >( M_segment );
+    return ( M_side == SERVER_SIDE
+             || header->server_pid_.load() != 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ShmTransport::isPeerClosed() const
+{
+    if ( ! M_segment )
+    {
+        return true;
+    }
+
+    const Header * header = reinterpret_cast< const Header * >( M_segment );
+    if ( M_side == CLIENT_SIDE )
+    {
+        return ( header->server_closed_.load() != 0
+                 || is_dead_process( header->server_pid_.load() ) );
+    }
+
+    return ( header->client_closed_.load() != 0
+             || is_dead_process( header->client_pid_ ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+ShmTransport::send( const char * data,
+                    const std::size_t len )
+{
+    if ( ! M_segment
+         || len + LENGTH_SIZE > M_ring_capacity )
+    {
+        return -1;
+    }
+
+    const std::uint32_t mask = M_ring_capacity - 1;
+    const std::uint32_t total = LENGTH_SIZE + align4( static_cast< std::uint32_t >( len ) );
+    const std::uint32_t tail = M_send_ring->tail_.load( std::memory_order_relaxed );
+    const std::uint32_t head = M_send_ring->head_.load( std::memory_order_acquire );
+    if ( M_ring_capacity - ( tail - head ) < total )
+    {
+        return 0;
+    }
+
+    // the length field never wraps, because all records are aligned to 4 bytes.
+    const std::uint32_t length = static_cast< std::uint32_t >( len );
+    std::memcpy( M_send_data + ( tail & mask ), &length, LENGTH_SIZE );
+
+    const std::uint32_t pos = ( tail + LENGTH_SIZE ) & mask;
+    const std::size_t first = std::min< std::size_t >( len, M_ring_capacity - pos );
+    std::memcpy( M_send_data + pos, data, first );
+    std::memcpy( M_send_data, data + first, len - first );
+
+    // publish the record, then wake up the consumer only if it is sleeping.
+    // the sequentially consistent order pairs with wait().
+    M_send_ring->tail_.store( tail + total );
+    M_send_ring->seq_.fetch_add( 1 );
+    if ( M_send_ring->waiters_.load() != 0 )
+    {
+        futex_wake( &M_send_ring->seq_ );
+    }
+
+    return static_cast< int >( len );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+ShmTransport::receive( char * buf,
+                       const std::size_t len )
+{
+    if ( ! M_segment )
+    {
+        return -1;
+    }
+
+    const std::uint32_t mask = M_ring_capacity - 1;
+    const std::uint32_t head = M_recv_ring->head_.load( std::memory_order_relaxed );
+    const std::uint32_t tail = M_recv_ring->tail_.load( std::memory_order_acquire );
+    if ( head == tail )
+    {
+        return 0;
+    }
+
+    std::uint32_t length = 0;
+    std::memcpy( &length, M_recv_data + ( head & mask ), LENGTH_SIZE );
+
+    const std::uint32_t total = LENGTH_SIZE + align4( length );
+    if ( length + LENGTH_SIZE > M_ring_capacity
+         || tail - head < total )
+    {
+        // broken record. drop all data.
+        M_recv_ring->head_.store( tail, std::memory_order_release );
+        return -1;
+    }
+
+    int result = -1;
+    if ( length <= len )
+    {
+        const std::uint32_t pos = ( head + LENGTH_SIZE ) & mask;
+        const std::size_t first = std::min< std::size_t >( length, M_ring_capacity - pos );
+        std::memcpy( buf, M_recv_data + pos, first );
+        std::memcpy( buf + first, M_recv_data, length - first );
+        result = static_cast< int >( length );
+    }
+
+    M_recv_ring->head_.store( head + total, std::memory_order_release );
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ShmTransport::hasMessage() const
+{
+    return ( M_segment
+             && M_recv_ring->head_.load( std::memory_order_relaxed )
+             != M_recv_ring->tail_.load() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ShmTransport::wait( const int timeout_msec )
+{
+    if ( ! M_segment )
+    {
+        return false;
+    }
+
+    // register as a waiter before checking the ring, so that the producer
+    // never misses the sleeping consumer. the futex returns immediately if
+    // the sequence has been changed after it is read.
+    M_recv_ring->waiters_.fetch_add( 1 );
+    const std::uint32_t seq = M_recv_ring->seq_.load();
+    if ( ! hasMessage()
+         && ! isPeerClosed() )
+    {
+        futex_wait( &M_recv_ring->seq_, seq, timeout_msec );
+    }
+    M_recv_ring->waiters_.fetch_sub( 1 );
+
+    return hasMessage();
+}
+
+}
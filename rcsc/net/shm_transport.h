@@ -0,0 +1,203 @@
+// -*-c++-*-
+
+/*!
+  \file shm_transport.h
+  \brief shared memory message transport Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA, Hiroki SHIMORA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_NET_SHM_TRANSPORT_H
+#define RCSC_NET_SHM_TRANSPORT_H
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+namespace rcsc {
+
+/*!
+  \class ShmTransport
+  \brief bidirectional message channel over a POSIX shared memory segment.
+
+  The segment has two lock free single producer single consumer rings, one
+  for each direction. Each message is copied once into the ring, and the
+  receiver is woken up by a futex only when it is sleeping. Then, the
+  co-located processes exchange the text protocol messages without socket
+  system calls and loopback copies.
+
+  The client side creates the segment by create(), and the server side (the
+  patched server or the proxy) maps it by attach(). The segment layout is:
+  [Header][Ring to the server][Ring to the client][data to the server][data to the client].
+  Each ring record is a 4 byte length followed by the message bytes, padded
+  to 4 bytes. All values are in the native byte order.
+*/
+class ShmTransport {
+public:
+
+    //! the side of the segment
+    enum Side {
+        CLIENT_SIDE, //!< creates the segment
+        SERVER_SIDE, //!< attaches to the segment
+    };
+
+    //! the default data size of each ring
+    static constexpr std::size_t DEFAULT_RING_CAPACITY = 64 * 1024;
+
+private:
+
+    struct Header;
+    struct Ring;
+
+    Side M_side; //!< this side
+    std::string M_name; //!< segment name
+    char * M_segment; //!< mapped segment. NULL if not opened.
+    std::size_t M_segment_size; //!< mapped size
+
+    Ring * M_send_ring; //!< ring written by this side
+    char * M_send_data; //!< data area of M_send_ring
+    Ring * M_recv_ring; //!< ring read by this side
+    char * M_recv_data; //!< data area of M_recv_ring
+    std::uint32_t M_ring_capacity; //!< data size of each ring
+
+    // not used
+    ShmTransport( const ShmTransport & ) = delete;
+    ShmTransport & operator=( const ShmTransport & ) = delete;
+
+public:
+
+    /*!
+      \brief construct an unopened transport
+     */
+    ShmTransport();
+
+    /*!
+      \brief close the transport
+     */
+    ~ShmTransport();
+
+    /*!
+      \brief check if the platform supports the shared memory transport
+      \return true if supported
+     */
+    static
+    bool is_supported();
+
+    /*!
+      \brief create a unique segment name for this process
+      \return segment name
+     */
+    static
+    std::string make_name();
+
+    /*!
+      \brief create the segment as the client side
+      \param name segment name
+      \param ring_capacity data size of each ring. rounded up to the power of 2.
+      \return true if created
+     */
+    bool create( const std::string & name,
+                 const std::size_t ring_capacity = DEFAULT_RING_CAPACITY );
+
+    /*!
+      \brief map the segment created by the client as the server side
+      \param name segment name
+      \return true if attached
+     */
+    bool attach( const std::string & name );
+
+    /*!
+      \brief notify the peer, unmap the segment, and remove the segment name
+      if this side has created it.
+     */
+    void close();
+
+    /*!
+      \brief check if the segment is opened
+      \return true if opened
+     */
+    bool isOpen() const
+      {
+          return M_segment != nullptr;
+      }
+
+    /*!
+      \brief get the segment name
+      \return segment name
+     */
+    const std::string & name() const
+      {
+          return M_name;
+      }
+
+    /*!
+      \brief check if the server side has attached to the segment
+      \return true if attached
+     */
+    bool isPeerAttached() const;
+
+    /*!
+      \brief check if the peer has closed the transport
+      \return true if closed, or the peer process has died.
+     */
+    bool isPeerClosed() const;
+
+    /*!
+      \brief send one message to the peer
+      \param data message data
+      \param len message length
+      \return len if sent, 0 if the ring is full, -1 if the message is too long or not opened.
+     */
+    int send( const char * data,
+              const std::size_t len );
+
+    /*!
+      \brief receive one message from the peer without blocking
+      \param buf buffer to receive data
+      \param len the size of buf
+      \return the length of received data, 0 if no message, -1 if the message
+      is longer than the buffer. the message is dropped in that case.
+     */
+    int receive( char * buf,
+                 const std::size_t len );
+
+    /*!
+      \brief check if there is any received message
+      \return true if the receive ring is not empty
+     */
+    bool hasMessage() const;
+
+    /*!
+      \brief wait for a message from the peer
+      \param timeout_msec the maximum wait time
+      \return true if there is a message
+     */
+    bool wait( const int timeout_msec );
+};
+
+}
+
+#endif
@@ -35,6 +35,7 @@
 
 #include "tcp_socket.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cerrno>
 
@@ -54,9 +55,24 @@
 #ifdef HAVE_NETINET_IN_H
 #include <netinet/in.h> // struct sockaddr_in, struct in_addr, htons
 #endif
+#ifdef HAVE_NETINET_TCP_H
+#include <netinet/tcp.h> // TCP_NODELAY, TCP_CORK
+#endif
+#ifdef HAVE_SYS_UIO_H
+#include <sys/uio.h> // writev()
+#endif
 
 namespace rcsc {
 
+constexpr std::size_t TCPSocket::MAX_PENDING_SIZE;
+
+namespace {
+
+//! the maximum number of buffers handled by one writev()
+constexpr int MAX_IOV_SIZE = 64;
+
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -82,7 +98,10 @@ TCPSocket::TCPSocket( const char * hostname,
 */
 TCPSocket::~TCPSocket()
 {
-
+    if ( isOpen() )
+    {
+        flush();
+    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -114,6 +133,148 @@ TCPSocket::writeToStream( const char * msg,
     return n;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+TCPSocket::writeToStream( const char * const * data,
+                          const std::size_t * len,
+                          const int count )
+{
+    int total = 0;
+
+#ifdef HAVE_SYS_UIO_H
+    struct iovec iovs[MAX_IOV_SIZE];
+
+    int first = 0;
+    std::size_t offset = 0; // already sent bytes of data[first]
+
+    while ( first < count )
+    {
+        const int batch = std::min( count - first, MAX_IOV_SIZE );
+        for ( int i = 0; i < batch; ++i )
+        {
+            const std::size_t skip = ( i == 0 ? offset : 0 );
+            iovs[i].iov_base = const_cast< char * >( data[first + i] + skip );
+            iovs[i].iov_len = len[first + i] - skip;
+        }
+
+        const ssize_t n = ::writev( fd(), iovs, batch );
+        if ( n == -1 )
+        {
+            if ( errno == EINTR )
+            {
+                continue;
+            }
+
+            std::perror( "writev" );
+            return -1;
+        }
+
+        total += static_cast< int >( n );
+
+        // skip the sent buffers. a partial write continues from the middle of the buffer.
+        std::size_t sent = static_cast< std::size_t >( n ) + offset;
+        offset = 0;
+        while ( first < count
+                && sent >= len[first] )
+        {
+            sent -= len[first];
+            ++first;
+        }
+        offset = sent;
+    }
+#else
+    for ( int i = 0; i < count; ++i )
+    {
+        std::size_t sent = 0;
+        while ( sent < len[i] )
+        {
+            const int n = writeToStream( data[i] + sent, len[i] - sent );
+            if ( n == -1 )
+            {
+                return -1;
+            }
+            sent += n;
+        }
+        total += static_cast< int >( len[i] );
+    }
+#endif
+
+    return total;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TCPSocket::enqueue( const char * data,
+                    const std::size_t len )
+{
+    if ( ! M_pending.empty()
+         && M_pending.size() + len > MAX_PENDING_SIZE )
+    {
+        flush();
+    }
+
+    M_pending.append( data, len );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+TCPSocket::flush()
+{
+    if ( M_pending.empty() )
+    {
+        return 0;
+    }
+
+    const char * data = M_pending.data();
+    const std::size_t len = M_pending.size();
+    const int n = writeToStream( &data, &len, 1 );
+
+    // the stream is broken if the write failed. the data is not kept.
+    M_pending.clear();
+    return n;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+TCPSocket::setNoDelay( const bool on )
+{
+#if defined(HAVE_NETINET_TCP_H) && defined(TCP_NODELAY)
+    const int value = ( on ? 1 : 0 );
+    return ::setsockopt( fd(), IPPROTO_TCP, TCP_NODELAY, &value, sizeof( value ) );
+#else
+    (void)on;
+    return -1;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+TCPSocket::setCork( const bool on )
+{
+#if defined(HAVE_NETINET_TCP_H) && defined(TCP_CORK)
+    const int value = ( on ? 1 : 0 );
+    return ::setsockopt( fd(), IPPROTO_TCP, TCP_CORK, &value, sizeof( value ) );
+#else
+    (void)on;
+    return -1;
+#endif
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -34,6 +34,7 @@
 
 #include <rcsc/net/abstract_socket.h>
 
+#include <string>
 #include <cstddef>
 
 namespace rcsc {
@@ -44,7 +45,16 @@ namespace rcsc {
 */
 class TCPSocket
     : public AbstractSocket {
+public:
+
+    //! the pending size that makes enqueue() flush the buffer
+    static constexpr std::size_t MAX_PENDING_SIZE = 64 * 1024;
+
 private:
+
+    //! outgoing data queued by enqueue()
+    std::string M_pending;
+
     //! not used
     TCPSocket() = delete;
 
@@ -58,7 +68,7 @@ public:
                const int port );
 
     /*!
-      \brief destructor. close socket automatically
+      \brief destructor. flush the pending data and close socket automatically
      */
     ~TCPSocket();
 
@@ -77,6 +87,57 @@ public:
     int writeToStream( const char * data,
                        const std::size_t len );
 
+    /*!
+      \brief send several buffers to the connected host by one gathered write if possible.
+      \param data the array of pointers to the data to be sent.
+      \param len the array of the data length.
+      \param count the number of buffers.
+      \return the total length of sent data if successfuly sent, otherwise -1.
+     */
+    int writeToStream( const char * const * data,
+                       const std::size_t * len,
+                       const int count );
+
+    /*!
+      \brief append data to the outgoing buffer without any system call.
+      the buffer is flushed if its size exceeds MAX_PENDING_SIZE.
+      \param data the pointer to the data to be sent.
+      \param len the length of data.
+     */
+    void enqueue( const char * data,
+                  const std::size_t len );
+
+    /*!
+      \brief send the data queued by enqueue(). this is expected to be called
+      once at the end of each cycle.
+      \return the length of sent data, or -1 if an error occured.
+     */
+    int flush();
+
+    /*!
+      \brief get the size of the queued data
+      \return byte size of the outgoing buffer
+     */
+    std::size_t pendingSize() const
+      {
+          return M_pending.size();
+      }
+
+    /*!
+      \brief enable/disable Nagle's algorithm (TCP_NODELAY).
+      \param on if true, small segments are sent immediately.
+      \return returned value of setsockopt(), or -1 if not supported.
+     */
+    int setNoDelay( const bool on );
+
+    /*!
+      \brief enable/disable TCP_CORK. while corked, only full segments are
+      sent, and uncorking sends the remaining data. this is available only on Linux.
+      \param on if true, the partial segments are held.
+      \return returned value of setsockopt(), or -1 if not supported.
+     */
+    int setCork( const bool on );
+
     /*!
       \brief receive stream data from the connected remote host.
       \param buf buffer to receive data
@@ -35,8 +35,11 @@
 
 #include "udp_socket.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <cerrno>
+#include <cstring>
 
 #ifdef HAVE_SYS_TYPES_H
 #include <sys/types.h>
@@ -50,12 +53,15 @@
 
 namespace rcsc {
 
+constexpr int UDPSocket::MAX_BATCH_SIZE;
+
 /*-------------------------------------------------------------------*/
 /*!
 
 */
 UDPSocket::UDPSocket( const int port )
-    : AbstractSocket()
+    : AbstractSocket(),
+      M_receive_timestamp( false )
 {
     if ( open( AbstractSocket::DATAGRAM_TYPE )
          && bind( port )
@@ -73,7 +79,8 @@ UDPSocket::UDPSocket( const int port )
 */
 UDPSocket::UDPSocket( const char * hostname,
                       const int port )
-    : AbstractSocket()
+    : AbstractSocket(),
+      M_receive_timestamp( false )
 {
     if ( open( AbstractSocket::DATAGRAM_TYPE )
          && bind( 0 )
@@ -171,4 +178,231 @@ UDPSocket::readDatagram( char * buf,
     return n;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+UDPSocket::readDatagrams( char * buf,
+                          const size_t len,
+                          const int max_count,
+                          int * sizes )
+{
+    return readDatagrams( buf, len, max_count, sizes, nullptr );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+UDPSocket::readDatagrams( char * buf,
+                          const size_t len,
+                          const int max_count,
+                          int * sizes,
+                          std::int64_t * stamps )
+{
+    const int count = std::min( max_count, MAX_BATCH_SIZE );
+    if ( count <= 0 )
+    {
+        return 0;
+    }
+
+#ifdef HAVE_RECVMMSG
+    struct mmsghdr msgs[MAX_BATCH_SIZE];
+    struct iovec iovs[MAX_BATCH_SIZE];
+    HostAddress::AddrType addrs[MAX_BATCH_SIZE];
+#ifdef SO_TIMESTAMPNS
+    const bool use_control = ( stamps && M_receive_timestamp );
+    union {
+        char buf_[CMSG_SPACE( sizeof( struct timespec ) )];
+        struct cmsghdr align_;
+    } controls[MAX_BATCH_SIZE];
+#endif
+
+    for ( int i = 0; i < count; ++i )
+    {
+        iovs[i].iov_base = buf + i * len;
+        iovs[i].iov_len = len;
+
+        msgs[i].msg_hdr.msg_name = &addrs[i];
+        msgs[i].msg_hdr.msg_namelen = sizeof( HostAddress::AddrType );
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_control = nullptr;
+        msgs[i].msg_hdr.msg_controllen = 0;
+#ifdef SO_TIMESTAMPNS
+        if ( use_control )
+        {
+            msgs[i].msg_hdr.msg_control = controls[i].buf_;
+            msgs[i].msg_hdr.msg_controllen = sizeof( controls[i].buf_ );
+        }
+#endif
+        msgs[i].msg_hdr.msg_flags = 0;
+        msgs[i].msg_len = 0;
+    }
+
+    const int n = ::recvmmsg( fd(), msgs, count, MSG_DONTWAIT, nullptr );
+
+    if ( n == -1 )
+    {
+        if ( errno == EWOULDBLOCK )
+        {
+            return 0;
+        }
+
+        std::perror( "recvmmsg" );
+        return -1;
+    }
+
+    for ( int i = 0; i < n; ++i )
+    {
+        sizes[i] = static_cast< int >( msgs[i].msg_len );
+    }
+
+    if ( stamps )
+    {
+        const std::int64_t now = now_nsec();
+        for ( int i = 0; i < n; ++i )
+        {
+            stamps[i] = now;
+#ifdef SO_TIMESTAMPNS
+            if ( ! use_control ) continue;
+
+            for ( struct cmsghdr * c = CMSG_FIRSTHDR( &msgs[i].msg_hdr );
+                  c;
+                  c = CMSG_NXTHDR( &msgs[i].msg_hdr, c ) )
+            {
+                if ( c->cmsg_level == SOL_SOCKET
+                     && c->cmsg_type == SCM_TIMESTAMPNS )
+                {
+                    struct timespec ts;
+                    std::memcpy( &ts, CMSG_DATA( c ), sizeof( ts ) );
+                    stamps[i] = static_cast< std::int64_t >( ts.tv_sec ) * 1000000000
+                        + ts.tv_nsec;
+                    break;
+                }
+            }
+#endif
+        }
+    }
+
+    if ( n > 0 )
+    {
+        M_peer_address.setAddress( addrs[n - 1] );
+    }
+
+    return n;
+#else
+    int n = 0;
+    while ( n < count )
+    {
+        const int size = readDatagram( buf + n * len, len );
+        if ( size <= 0 )
+        {
+            if ( size < 0 && n == 0 )
+            {
+                return -1;
+            }
+            break;
+        }
+        sizes[n] = size;
+        if ( stamps )
+        {
+            stamps[n] = now_nsec();
+        }
+        ++n;
+    }
+
+    return n;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+UDPSocket::enableReceiveTimestamp()
+{
+    M_receive_timestamp = false;
+
+#ifdef SO_TIMESTAMPNS
+    int on = 1;
+    if ( fd() != -1
+         && ::setsockopt( fd(), SOL_SOCKET, SO_TIMESTAMPNS,
+                          &on, sizeof( on ) ) == 0 )
+    {
+        M_receive_timestamp = true;
+    }
+#endif
+
+    return M_receive_timestamp;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::int64_t
+UDPSocket::now_nsec()
+{
+    return std::chrono::duration_cast< std::chrono::nanoseconds >
+        ( std::chrono::system_clock::now().time_since_epoch() ).count();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+UDPSocket::writeDatagrams( const char * const * data,
+                           const size_t * len,
+                           const int count )
+{
+    int sent = 0;
+
+#ifdef HAVE_SENDMMSG
+    struct mmsghdr msgs[MAX_BATCH_SIZE];
+    struct iovec iovs[MAX_BATCH_SIZE];
+
+    while ( sent < count )
+    {
+        const int batch = std::min( count - sent, MAX_BATCH_SIZE );
+        for ( int i = 0; i < batch; ++i )
+        {
+            iovs[i].iov_base = const_cast< char * >( data[sent + i] );
+            iovs[i].iov_len = len[sent + i];
+
+            msgs[i].msg_hdr.msg_name = const_cast< HostAddress::AddrType * >( &M_peer_address.toAddress() );
+            msgs[i].msg_hdr.msg_namelen = sizeof( HostAddress::AddrType );
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_control = nullptr;
+            msgs[i].msg_hdr.msg_controllen = 0;
+            msgs[i].msg_hdr.msg_flags = 0;
+            msgs[i].msg_len = 0;
+        }
+
+        const int n = ::sendmmsg( fd(), msgs, batch, 0 );
+        if ( n <= 0 )
+        {
+            std::perror( "sendmmsg" );
+            break;
+        }
+        sent += n;
+    }
+#else
+    for ( ; sent < count; ++sent )
+    {
+        if ( writeDatagram( data[sent], len[sent] ) < 0 )
+        {
+            break;
+        }
+    }
+#endif
+
+    return ( sent > 0 ? sent : -1 );
+}
+
 } // end namespace
@@ -37,6 +37,7 @@
 #include <boost/scoped_ptr.hpp>
 
 #include <cstddef>
+#include <cstdint>
 
 namespace rcsc {
 
@@ -46,7 +47,16 @@ namespace rcsc {
 */
 class UDPSocket
     : public AbstractSocket {
+public:
+
+    //! the maximum number of datagrams handled by one batched system call
+    static constexpr int MAX_BATCH_SIZE = 16;
+
 private:
+
+    //! if true, the kernel receive time is attached to each datagram
+    bool M_receive_timestamp;
+
     //! not used
     UDPSocket() = delete;
 public:
@@ -115,6 +125,75 @@ public:
                       const size_t len,
                       HostAddress * from );
 
+    /*!
+      \brief receive all pending datagram packets by one system call if possible.
+      The source address of the last packet becomes the new peer address.
+      \param buf buffer array that has max_count slots of len bytes.
+      \param len the length of each slot
+      \param max_count the number of slots. at most MAX_BATCH_SIZE packets are read.
+      \param sizes the length of each received packet is set to this array.
+      \retval 0 no packet
+      \retval -1 error occured
+      \return the number of received packets.
+     */
+    int readDatagrams( char * buf,
+                       const size_t len,
+                       const int max_count,
+                       int * sizes );
+
+    /*!
+      \brief receive all pending datagram packets with their receive time.
+      If enableReceiveTimestamp() succeeded, the time when the kernel received
+      each packet is used. Otherwise, the time just after the system call is used.
+      \param buf buffer array that has max_count slots of len bytes.
+      \param len the length of each slot
+      \param max_count the number of slots. at most MAX_BATCH_SIZE packets are read.
+      \param sizes the length of each received packet is set to this array.
+      \param stamps the receive time of each packet is set to this array. (see now_nsec())
+      \retval 0 no packet
+      \retval -1 error occured
+      \return the number of received packets.
+     */
+    int readDatagrams( char * buf,
+                       const size_t len,
+                       const int max_count,
+                       int * sizes,
+                       std::int64_t * stamps );
+
+    /*!
+      \brief request the kernel receive time of each datagram (SO_TIMESTAMPNS).
+      \return true if the socket option is supported and set.
+     */
+    bool enableReceiveTimestamp();
+
+    /*!
+      \brief check if the kernel receive time is enabled.
+      \return true if enableReceiveTimestamp() succeeded.
+     */
+    bool isReceiveTimestampEnabled() const
+      {
+          return M_receive_timestamp;
+      }
+
+    /*!
+      \brief get the current wall clock time that has the same origin as the
+      kernel receive time.
+      \return nanoseconds since the epoch
+     */
+    static
+    std::int64_t now_nsec();
+
+    /*!
+      \brief send several datagram packets to the connected host by one system call if possible.
+      \param data the array of pointers to the data to be sent.
+      \param len the array of the data length.
+      \param count the number of packets.
+      \return the number of sent packets, or -1 if no packet is sent.
+     */
+    int writeDatagrams( const char * const * data,
+                        const size_t * len,
+                        const int count );
+
 };
 
 } // end namespace
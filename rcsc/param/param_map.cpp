@@ -37,6 +37,9 @@
 
 #include <sstream>
 #include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
 
 namespace rcsc {
 
@@ -45,7 +48,7 @@ namespace {
 /*-------------------------------------------------------------------*/
 inline
 bool
-is_true( const std::string & value_str )
+is_true( std::string_view value_str )
 {
     return ( value_str == "true"
              || value_str == "on"
@@ -56,7 +59,7 @@ is_true( const std::string & value_str )
 /*-------------------------------------------------------------------*/
 inline
 bool
-is_false( const std::string & value_str )
+is_false( std::string_view value_str )
 {
     return ( value_str == "false"
              || value_str == "off"
@@ -109,27 +112,115 @@ struct IsSwitch {
 
 };
 
+/*-------------------------------------------------------------------*/
+/*!
+  \brief convert the leading number in the string like std::stoi/std::stod.
+  leading white spaces and '+' are skipped, and trailing characters are ignored.
+*/
+template < typename T >
+T
+parse_number( std::string_view str )
+{
+    const char * first = str.data();
+    const char * last = str.data() + str.size();
+    while ( first != last
+            && ( *first == ' ' || *first == '\t' || *first == '\n' || *first == '\r' ) )
+    {
+        ++first;
+    }
+    if ( first != last
+         && *first == '+' )
+    {
+        ++first;
+    }
+
+    T value = T();
+    const std::from_chars_result result = std::from_chars( first, last, value );
+    if ( result.ec == std::errc::invalid_argument )
+    {
+        throw std::invalid_argument( "no conversion" );
+    }
+    if ( result.ec == std::errc::result_out_of_range )
+    {
+        throw std::out_of_range( "out of range" );
+    }
+    return value;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief mix the string hash and the seed (splitmix64 finalizer)
+*/
+inline
+std::uint64_t
+hash_mix( std::uint64_t h,
+          const std::uint64_t seed )
+{
+    h += seed * 0x9e3779b97f4a7c15ULL;
+    h = ( h ^ ( h >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+    h = ( h ^ ( h >> 27 ) ) * 0x94d049bb133111ebULL;
+    return h ^ ( h >> 31 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief hash of the name string. 8 characters are processed at once.
+*/
+inline
+std::uint64_t
+hash_name( std::string_view str )
+{
+    const char * p = str.data();
+    std::size_t len = str.size();
+    std::uint64_t h = 0xcbf29ce484222325ULL ^ len;
+
+    while ( len >= 8 )
+    {
+        std::uint64_t w;
+        std::memcpy( &w, p, 8 );
+        h = ( h ^ w ) * 0x100000001b3ULL;
+        h ^= h >> 29;
+        p += 8;
+        len -= 8;
+    }
+
+    std::uint64_t w = 0;
+    std::memcpy( &w, p, len );
+    h = ( h ^ w ) * 0x100000001b3ULL;
+    return h ^ ( h >> 32 );
+}
+
+/*-------------------------------------------------------------------*/
+inline
+std::size_t
+ceil_pow2( const std::size_t n )
+{
+    std::size_t v = 1;
+    while ( v < n ) v <<= 1;
+    return v;
+}
+
 /*-------------------------------------------------------------------*/
 struct ValueParser {
-    const std::string & value_str;
+    std::string_view value_str;
 
-    ValueParser( const std::string & str )
+    ValueParser( std::string_view str )
         : value_str( str )
       { }
 
     void operator()( int * ptr )
       {
-          *ptr = std::stoi( value_str );
+          *ptr = parse_number< int >( value_str );
       }
 
     void operator()( size_t * ptr )
       {
-          *ptr = std::stoul( value_str );
+          *ptr = parse_number< size_t >( value_str );
       }
 
     void operator()( double * ptr )
       {
-          *ptr = std::stod( value_str );
+          *ptr = parse_number< double >( value_str );
       }
 
     void operator()( bool * ptr )
@@ -176,7 +267,7 @@ struct ValueParser {
 
     void operator()( std::string * ptr )
       {
-          *ptr = value_str;
+          ptr->assign( value_str.data(), value_str.size() );
       }
 
 };
@@ -294,7 +385,7 @@ ParamEntity::isSwitch() const
 
 /*-------------------------------------------------------------------*/
 bool
-ParamEntity::analyze( const std::string & value_str )
+ParamEntity::analyze( std::string_view value_str )
 {
     try
     {
@@ -459,6 +550,7 @@ ParamMap::add( ParamEntity::Ptr param )
     }
 
     M_parameters.push_back( param );
+    M_hash_dirty = true;
 
     M_long_name_map[ param->longName() ] = param;
 
@@ -481,6 +573,7 @@ ParamMap::remove( const std::string & long_name )
                                               return v->longName() == long_name;
                                           } ),
                         M_parameters.end() );
+    M_hash_dirty = true;
 
     Map::iterator it_long = M_long_name_map.find( long_name );
     if ( it_long != M_long_name_map.end() )
@@ -509,6 +602,119 @@ ParamMap::findLongName( const std::string & long_name )
     return ParamEntity::Ptr();
 }
 
+/*-------------------------------------------------------------------*/
+ParamEntity *
+ParamMap::lookupLongName( std::string_view long_name )
+{
+    if ( M_hash_dirty )
+    {
+        buildHashIndex();
+    }
+
+    if ( M_hash_table.empty() )
+    {
+        // no perfect hash. fall back to the dynamic map.
+        Map::iterator it = M_long_name_map.find( std::string( long_name ) );
+        return ( it != M_long_name_map.end()
+                 ? it->second.get()
+                 : nullptr );
+    }
+
+    const std::uint64_t h = hash_name( long_name );
+    const std::size_t bucket = h & ( M_hash_seeds.size() - 1 );
+    ParamEntity * p = M_hash_table[hash_mix( h, M_hash_seeds[bucket] ) & ( M_hash_table.size() - 1 )];
+
+    return ( p && p->longName() == long_name
+             ? p
+             : nullptr );
+}
+
+/*-------------------------------------------------------------------*/
+void
+ParamMap::buildHashIndex()
+{
+    // hash and displace: the names are distributed to the first level buckets,
+    // then a seed is searched for each bucket, from the largest bucket,
+    // so that all names in the bucket go to the empty slots.
+
+    M_hash_dirty = false;
+    M_hash_table.clear();
+    M_hash_seeds.clear();
+
+    const std::size_t n = M_parameters.size();
+    if ( n == 0 )
+    {
+        return;
+    }
+
+    const std::size_t n_buckets = ceil_pow2( std::max( std::size_t( 1 ), n / 2 ) );
+    const std::size_t table_size = ceil_pow2( n * 2 );
+
+    std::vector< std::vector< std::pair< std::uint64_t, ParamEntity * > > > buckets( n_buckets );
+    for ( const ParamEntity::Ptr & p : M_parameters )
+    {
+        const std::uint64_t h = hash_name( p->longName() );
+        buckets[h & ( n_buckets - 1 )].emplace_back( h, p.get() );
+    }
+
+    std::vector< std::size_t > order( n_buckets );
+    for ( std::size_t i = 0; i < n_buckets; ++i ) order[i] = i;
+    std::stable_sort( order.begin(), order.end(),
+                      [&]( const std::size_t lhs, const std::size_t rhs )
+                        {
+                            return buckets[lhs].size() > buckets[rhs].size();
+                        } );
+
+    std::vector< ParamEntity * > table( table_size, nullptr );
+    std::vector< std::uint32_t > seeds( n_buckets, 0 );
+    std::vector< std::size_t > slots;
+
+    const std::uint32_t MAX_SEED = 1u << 16;
+
+    for ( const std::size_t b : order )
+    {
+        if ( buckets[b].empty() )
+        {
+            break;
+        }
+
+        bool found = false;
+        for ( std::uint32_t seed = 0; seed < MAX_SEED && ! found; ++seed )
+        {
+            slots.clear();
+            found = true;
+            for ( const auto & e : buckets[b] )
+            {
+                const std::size_t s = hash_mix( e.first, seed ) & ( table_size - 1 );
+                if ( table[s]
+                     || std::find( slots.begin(), slots.end(), s ) != slots.end() )
+                {
+                    found = false;
+                    break;
+                }
+                slots.push_back( s );
+            }
+
+            if ( found )
+            {
+                seeds[b] = seed;
+                for ( std::size_t i = 0; i < slots.size(); ++i )
+                {
+                    table[slots[i]] = buckets[b][i].second;
+                }
+            }
+        }
+
+        if ( ! found )
+        {
+            return;
+        }
+    }
+
+    M_hash_table.swap( table );
+    M_hash_seeds.swap( seeds );
+}
+
 /*-------------------------------------------------------------------*/
 ParamEntity::Ptr
 ParamMap::findShortName( const std::string & short_name )
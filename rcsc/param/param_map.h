@@ -36,9 +36,11 @@
 #include <vector>
 #include <unordered_map>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <iostream>
 #include <cassert>
+#include <cstdint>
 
 namespace rcsc {
 
@@ -194,6 +196,15 @@ public:
       {
           return M_short_name;
       }
+    /*!
+      \brief get the pointer to the parameter variable
+      \return const reference to the variant of the value pointer
+    */
+    const ValuePtr & valuePtr() const
+      {
+          return M_value_ptr;
+      }
+
     /*!
       \brief get description message
       \return const reference to the descriptin message
@@ -210,10 +221,12 @@ public:
     bool isSwitch() const;
 
     /*!
-      \brief pure virtual method. analyze value string.
+      \brief analyze value string and write the value directly to the variable.
+      numbers are converted by std::from_chars without allocation.
+      \param value_str value string
       \return boolean status of analysis result
     */
-    bool analyze( const std::string & value_str );
+    bool analyze( std::string_view value_str );
 
     /*!
       \brief print help name strings
@@ -303,6 +316,13 @@ private:
     //! short name option map
     Map M_short_name_map;
 
+    //! perfect hash index of the long names. rebuilt at the first lookup after the registration.
+    std::vector< ParamEntity * > M_hash_table;
+    //! second level seed of each first level bucket
+    std::vector< std::uint32_t > M_hash_seeds;
+    //! true if M_hash_table has to be rebuilt
+    bool M_hash_dirty;
+
 
     // no copyable
     ParamMap( const ParamMap & );
@@ -315,7 +335,8 @@ public:
      */
     ParamMap()
         : M_valid( true ),
-          M_registrar( *this )
+          M_registrar( *this ),
+          M_hash_dirty( true )
       { }
 
     /*!
@@ -326,7 +347,8 @@ public:
     ParamMap( const std::string & group_name )
         : M_valid( true ),
           M_registrar( *this ),
-          M_group_name( group_name )
+          M_group_name( group_name ),
+          M_hash_dirty( true )
       { }
 
     /*!
@@ -408,6 +430,13 @@ public:
      */
     ParamEntity::Ptr findLongName( const std::string & long_name );
 
+    /*!
+      \brief get parameter entry by the perfect hash index without any allocation.
+      \param long_name long version parameter name string
+      \return raw pointer to the parameter entry. if not found, NULL is returned.
+     */
+    ParamEntity * lookupLongName( std::string_view long_name );
+
     /*!
       \brief get parameter entry that has the argument name
       \param short_name set of the parameter name character
@@ -430,6 +459,14 @@ public:
       \return reference to output stream
      */
     std::ostream & printValues( std::ostream & os ) const;
+
+private:
+
+    /*!
+      \brief build the perfect hash index of the long names.
+      if no seed is found, the index is left empty and the map is used instead.
+     */
+    void buildHashIndex();
 };
 
 }
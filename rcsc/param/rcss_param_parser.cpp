@@ -37,6 +37,7 @@
 
 #include "param_map.h"
 
+#include <algorithm>
 #include <iostream>
 #include <cstdio>
 
@@ -74,12 +75,12 @@ RCSSParamParser::parse( ParamMap & param_map )
     }
 
     int n_params = 0;
-    for ( StrPairVec::iterator it = M_str_pairs.begin();
+    for ( StrPairVec::const_iterator it = M_str_pairs.begin();
           it != M_str_pairs.end();
           ++it )
     {
-        // get parameter entry from map
-        ParamEntity::Ptr param_ptr = param_map.findLongName( it->first );
+        // get parameter entry from the perfect hash index
+        ParamEntity * param_ptr = param_map.lookupLongName( it->first );
 
         // analyze value string
         if ( param_ptr
@@ -107,56 +108,39 @@ RCSSParamParser::parse( ParamMap & param_map )
 /*!
 
  */
-std::string
-RCSSParamParser::cleanString( std::string str )
+std::string_view
+RCSSParamParser::cleanString( char * first,
+                              std::size_t len )
 {
-    if( str.empty() )
+    if ( len == 0 )
     {
-        return str;
+        return std::string_view( first, 0 );
     }
 
-    if ( *str.begin() == '\'' )
+    const char quote = first[0];
+    if ( ( quote != '\'' && quote != '"' )
+         || len < 2
+         || first[len - 1] != quote )
     {
-        if( *str.rbegin() == '\''  )
-        {
-            str = str.substr( 1, str.length() - 2 );
-        }
-        else
-        {
-            return str;
-        }
-
-        // replace escape character
-        for ( std::string::size_type escape_pos = str.find( "\\'" );
-              escape_pos != std::string::npos;
-              escape_pos = str.find( "\\'" ) )
-        {
-            // replace "\'" with "'"
-            str.replace( escape_pos, 2, "'" );
-        }
+        return std::string_view( first, len );
     }
-    else if ( *str.begin() == '"' )
-    {
-        if ( *str.rbegin() == '"'  )
-        {
-            str = str.substr( 1, str.length() - 2 );
-        }
-        else
-        {
-            return str;
-        }
 
-        // replace escape character
-        for ( std::string::size_type escape_pos = str.find( "\\\"" );
-              escape_pos != std::string::npos;
-              escape_pos = str.find( "\\\"" ) )
+    // remove the quatation, and replace "\'" with "'" (or "\"" with """)
+    const char * src = first + 1;
+    const char * const src_end = first + len - 1;
+    char * dst = first;
+    while ( src != src_end )
+    {
+        if ( *src == '\\'
+             && src + 1 != src_end
+             && *( src + 1 ) == quote )
         {
-            // replace "\"" with """
-            str.replace( escape_pos, 2, "\"" );
+            ++src;
         }
+        *dst++ = *src++;
     }
 
-    return str;
+    return std::string_view( first, dst - first );
 }
 
 
@@ -178,14 +162,17 @@ RCSSParamParser::init( const char * msg )
 
     M_param_name = buf;
 
-    const std::string msg_str( msg );
+    M_buffer.assign( msg );
+    M_str_pairs.reserve( 256 );
 
-    for ( std::string::size_type pos = msg_str.find_first_of( '(', n_read );
-          pos != std::string::npos;
-          pos = msg_str.find_first_of( '(', pos ) )
+    char * const begin = &M_buffer[0];
+    char * const end = begin + M_buffer.size();
+
+    char * pos = std::find( begin + n_read, end, '(' );
+    while ( pos != end )
     {
-        std::string::size_type end_pos = msg_str.find_first_of( ' ', pos );
-        if ( end_pos == std::string::npos )
+        char * end_pos = std::find( pos, end, ' ' );
+        if ( end_pos == end )
         {
             std::cerr << __FILE__ << ": ***ERROR*** "
                       << "Failed to parse parameter name. " << msg << std::endl;
@@ -193,12 +180,17 @@ RCSSParamParser::init( const char * msg )
         }
 
         pos += 1;
-        const std::string name_str( msg_str, pos, end_pos - pos );
+        const std::string_view name_str( pos, end_pos - pos );
 
         pos = end_pos;
         // search end paren or double quatation
-        end_pos = msg_str.find_first_of( ")\"", end_pos ); //"
-        if ( end_pos == std::string::npos )
+        while ( end_pos != end
+                && *end_pos != ')'
+                && *end_pos != '"' )
+        {
+            ++end_pos;
+        }
+        if ( end_pos == end )
         {
             std::cerr << __FILE__ << ": ***ERROR*** "
                       << "Failed to parse parameter value for [" << name_str << "] in "
@@ -207,11 +199,11 @@ RCSSParamParser::init( const char * msg )
         }
 
         // found string type value
-        if ( msg_str[end_pos] == '\"' ) // "
+        if ( *end_pos == '"' )
         {
             pos = end_pos;
-            end_pos = msg_str.find_first_of( '\"', end_pos + 1 ); //"
-            if ( end_pos == std::string::npos )
+            end_pos = std::find( end_pos + 1, end, '"' );
+            if ( end_pos == end )
             {
                 std::cerr << __FILE__ << ": ***ERROR*** "
                           << "Failed to parse string parameter value for [" << name_str << "] in "
@@ -225,12 +217,11 @@ RCSSParamParser::init( const char * msg )
             pos += 1; // skip white space
         }
 
-        std::string value_str( msg_str, pos, end_pos - pos );
-        value_str = cleanString( value_str );
+        const std::string_view value_str = cleanString( pos, end_pos - pos );
 
-        M_str_pairs.push_back( std::make_pair( name_str, value_str ) );
+        M_str_pairs.emplace_back( name_str, value_str );
 
-        pos = end_pos;
+        pos = std::find( end_pos, end, '(' );
     }
 
     return true;
@@ -35,6 +35,7 @@
 #include <rcsc/param/param_parser.h>
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <utility>
 
@@ -43,11 +44,19 @@ namespace rcsc {
 /*!
   \class RCSSParamParser
   \brief rcssserver parameter message parser
+
+  The message is copied only once. The name and value pairs are the views
+  into the copied buffer, and the quoted values are unescaped in place.
+  The values are written to the variables through ParamMap::lookupLongName()
+  without any further allocation.
  */
 class RCSSParamParser
     : public ParamParser {
 private:
-    typedef std::vector< std::pair< std::string, std::string > > StrPairVec;
+    typedef std::vector< std::pair< std::string_view, std::string_view > > StrPairVec;
+
+    //! copy of the message. M_str_pairs refers to this buffer.
+    std::string M_buffer;
 
     //! parameter type name (server_param, player_param ...)
     std::string M_param_name;
@@ -57,6 +66,8 @@ private:
 
     //! not used
     RCSSParamParser() = delete;
+    RCSSParamParser( const RCSSParamParser & ) = delete;
+    RCSSParamParser & operator=( const RCSSParamParser & ) = delete;
 public:
     /*!
       \brief construct with original command line arguments
@@ -76,11 +87,13 @@ public:
 private:
 
     /*!
-      \brief remove escaped quatation character from string.
-      \param str string variable to be checked
-      \return clened string
+      \brief remove the quatation and the escape characters in place.
+      \param first pointer to the first character of the value in M_buffer
+      \param len length of the value
+      \return cleaned string view
      */
-    std::string cleanString( std::string str );
+    std::string_view cleanString( char * first,
+                                  std::size_t len );
 
     /*!
       \brief lexical analyze and create string pair vector
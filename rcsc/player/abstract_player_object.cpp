@@ -39,6 +39,7 @@
 #include <rcsc/common/server_param.h>
 #include <rcsc/common/player_type.h>
 #include <rcsc/player/player_evaluator.h>
+#include <rcsc/player/player_evaluation_cache.h>
 
 #include <limits>
 
@@ -195,4 +196,66 @@ AbstractPlayerObject::get_maximum_evaluation( const AbstractPlayerObject::Cont &
     return max_value;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+AbstractPlayerObject::get_minimum_evaluation( const AbstractPlayerObject::Cont & cont,
+                                              const PlayerEvaluator * evaluator,
+                                              PlayerEvaluationCache * cache,
+                                              const std::uint32_t key )
+{
+    if ( ! cache )
+    {
+        return get_minimum_evaluation( cont, evaluator );
+    }
+
+    double min_value = std::numeric_limits< double >::max();
+
+    for ( const AbstractPlayerObject * p : cont )
+    {
+        double value = cache->evaluate( key, *p, *evaluator );
+
+        if ( value < min_value )
+        {
+            min_value = value;
+        }
+    }
+
+    delete evaluator;
+    return min_value;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+AbstractPlayerObject::get_maximum_evaluation( const AbstractPlayerObject::Cont & cont,
+                                              const PlayerEvaluator * evaluator,
+                                              PlayerEvaluationCache * cache,
+                                              const std::uint32_t key )
+{
+    if ( ! cache )
+    {
+        return get_maximum_evaluation( cont, evaluator );
+    }
+
+    double max_value = -std::numeric_limits< double >::max();
+
+    for ( const AbstractPlayerObject * p : cont )
+    {
+        double value = cache->evaluate( key, *p, *evaluator );
+
+        if ( value > max_value )
+        {
+            max_value = value;
+        }
+    }
+
+    delete evaluator;
+    return max_value;
+}
+
 }
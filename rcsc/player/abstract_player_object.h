@@ -39,11 +39,13 @@
 #include <rcsc/types.h>
 
 #include <vector>
+#include <cstdint>
 
 namespace rcsc {
 
 class AbstractPlayerObject;
 class PlayerEvaluator;
+class PlayerEvaluationCache;
 
 /*!
   \class AbstractPlayerObject
@@ -543,6 +545,30 @@ public:
     static double get_maximum_evaluation( const Cont & cont,
                                           const PlayerEvaluator * evaluator );
 
+    /*!
+      \brief get minimum evaluation value using evaluator. the values are memoized in the cache.
+      \param cont container of AbstractPlayerObject
+      \param evaluator evaluator object (has to be dynamically allocated)
+      \param cache memo of the current decision. if null, all players are evaluated.
+      \param key evaluator key that identifies the evaluator and its parameters
+     */
+    static double get_minimum_evaluation( const Cont & cont,
+                                          const PlayerEvaluator * evaluator,
+                                          PlayerEvaluationCache * cache,
+                                          const std::uint32_t key );
+
+    /*!
+      \brief get maximum evaluation value using evaluator. the values are memoized in the cache.
+      \param cont container of AbstractPlayerObject
+      \param evaluator evaluator object (has to be dynamically allocated)
+      \param cache memo of the current decision. if null, all players are evaluated.
+      \param key evaluator key that identifies the evaluator and its parameters
+     */
+    static double get_maximum_evaluation( const Cont & cont,
+                                          const PlayerEvaluator * evaluator,
+                                          PlayerEvaluationCache * cache,
+                                          const std::uint32_t key );
+
 };
 
 }
@@ -38,6 +38,7 @@
 #include "player_agent.h"
 #include "world_model.h"
 #include "body_sensor.h"
+#include "command_writer.h"
 #include "player_command.h"
 #include "say_message_builder.h"
 #include "see_state.h"
@@ -46,8 +47,30 @@
 #include <rcsc/common/server_param.h>
 #include <rcsc/common/logger.h>
 
+#include <algorithm>
+
 namespace rcsc {
 
+namespace {
+
+inline
+void
+write_command( const PlayerCommand & com,
+               std::ostream & to )
+{
+    com.toCommandString( to );
+}
+
+inline
+void
+write_command( const PlayerCommand & com,
+               CommandWriter & to )
+{
+    com.writeCommand( to );
+}
+
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -63,6 +86,18 @@ ActionEffector::ActionEffector( const PlayerAgent & agent )
       M_command_say( nullptr ),
       M_command_pointto( nullptr ),
       M_command_attentionto( nullptr ),
+      M_kick_command( 0.0, 0.0 ),
+      M_dash_command( 0.0 ),
+      M_turn_command( 0.0 ),
+      M_move_command( 0.0, 0.0 ),
+      M_catch_command( 0.0 ),
+      M_tackle_command( 0.0 ),
+      M_turn_neck_command( 0.0 ),
+      M_change_view_command( ViewWidth::NORMAL, ViewQuality::HIGH ),
+      M_change_focus_command( 0.0, 0.0 ),
+      M_say_command( 0.0 ),
+      M_pointto_command(),
+      M_attentionto_command(),
       M_last_action_time( 0, 0 ),
       M_done_turn_neck( false ),
       M_kick_accel( 0.0, 0.0 ),
@@ -81,8 +116,18 @@ ActionEffector::ActionEffector( const PlayerAgent & agent )
       M_tackle_foul( false ),
       M_turn_neck_moment( 0.0 ),
       M_say_message( "" ),
+      M_say_message_size( 0 ),
+      M_say_message_order( 0 ),
       M_pointto_pos( 0.0, 0.0 )
 {
+    for ( SayMessageSlot & slot : M_say_messages )
+    {
+        slot.message_ = nullptr;
+        slot.allocated_ = false;
+        slot.priority_ = 0;
+        slot.order_ = 0;
+    }
+
     for ( int i = 0; i < 2; ++i )
     {
         M_last_body_command_type[i] = PlayerCommand::ILLEGAL;
@@ -102,47 +147,7 @@ ActionEffector::ActionEffector( const PlayerAgent & agent )
 */
 ActionEffector::~ActionEffector()
 {
-    if ( M_command_body )
-    {
-        delete M_command_body;
-        M_command_body = nullptr;
-    }
-
-    if ( M_command_turn_neck )
-    {
-        delete M_command_turn_neck;
-        M_command_turn_neck = nullptr;
-    }
-
-    if ( M_command_change_view )
-    {
-        delete M_command_change_view;
-        M_command_change_view = nullptr;
-    }
-
-    if ( M_command_change_focus )
-    {
-        delete M_command_change_focus;
-        M_command_change_focus = nullptr;
-    }
-
-    if ( M_command_say )
-    {
-        delete M_command_say;
-        M_command_say = nullptr;
-    }
-
-    if ( M_command_pointto )
-    {
-        delete M_command_pointto;
-        M_command_pointto = nullptr;
-    }
-
-    if ( M_command_attentionto )
-    {
-        delete M_command_attentionto;
-        M_command_attentionto = nullptr;
-    }
+    clearSayMessage();
 }
 
 /*-------------------------------------------------------------------*/
@@ -467,8 +472,9 @@ ActionEffector::checkCommandCount( const BodySensor & sense )
 /*!
 
 */
-std::ostream &
-ActionEffector::makeCommand( std::ostream & to )
+template < typename Output >
+void
+ActionEffector::composeCommand( Output & to )
 {
     M_last_body_command_type[1] = M_last_body_command_type[0];
 
@@ -481,9 +487,8 @@ ActionEffector::makeCommand( std::ostream & to )
         {
             M_catch_time = M_agent.world().time();
         }
-        M_command_body->toCommandString( to );
+        write_command( *M_command_body, to );
         incCommandCount( M_command_body->type() );
-        delete M_command_body;
         M_command_body = nullptr;
     }
     else
@@ -498,7 +503,7 @@ ActionEffector::makeCommand( std::ostream & to )
                       << "  WARNING. no body command." << std::endl;
             // register dummy command
             PlayerTurnCommand turn( 0 );
-            turn.toCommandString( to );
+            write_command( turn, to );
             incCommandCount( PlayerCommand::TURN );
         }
     }
@@ -506,60 +511,74 @@ ActionEffector::makeCommand( std::ostream & to )
     if ( M_command_turn_neck )
     {
         M_done_turn_neck = true;
-        M_command_turn_neck->toCommandString( to );
+        write_command( *M_command_turn_neck, to );
         incCommandCount( PlayerCommand::TURN_NECK );
-        delete M_command_turn_neck;
         M_command_turn_neck = nullptr;
     }
 
     if ( M_command_change_view )
     {
-        M_command_change_view->toCommandString( to );
+        write_command( *M_command_change_view, to );
         incCommandCount( PlayerCommand::CHANGE_VIEW );
-        delete M_command_change_view;
         M_command_change_view = nullptr;
     }
 
     if ( M_command_change_focus )
     {
-        M_command_change_focus->toCommandString( to );
+        write_command( *M_command_change_focus, to );
         incCommandCount( PlayerCommand::CHANGE_FOCUS );
-        delete M_command_change_focus;
         M_command_change_focus = nullptr;
     }
 
     if ( M_command_pointto )
     {
-        M_command_pointto->toCommandString( to );
+        write_command( *M_command_pointto, to );
         incCommandCount( PlayerCommand::POINTTO );
-        delete M_command_pointto;
         M_command_pointto = nullptr;
     }
 
     if ( M_command_attentionto )
     {
-        M_command_attentionto->toCommandString( to );
+        write_command( *M_command_attentionto, to );
         incCommandCount( PlayerCommand::ATTENTIONTO );
-        delete M_command_attentionto;
         M_command_attentionto = nullptr;
     }
 
     if ( ServerParam::i().synchMode() )
     {
         PlayerDoneCommand done_com;
-        done_com.toCommandString( to );
+        write_command( done_com, to );
     }
 
     makeSayCommand();
     if ( M_command_say )
     {
-        M_command_say->toCommandString( to );
+        write_command( *M_command_say, to );
         incCommandCount( PlayerCommand::SAY );
     }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
 
+*/
+std::ostream &
+ActionEffector::makeCommand( std::ostream & to )
+{
+    composeCommand( to );
     return to;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+ActionEffector::makeCommand( CommandWriter & to )
+{
+    composeCommand( to );
+}
+
 
 /*-------------------------------------------------------------------*/
 /*!
@@ -568,49 +587,21 @@ ActionEffector::makeCommand( std::ostream & to )
 void
 ActionEffector::clearAllCommands()
 {
-    if ( M_command_body )
-    {
-        delete M_command_body;
-        M_command_body = nullptr;
-    }
+    M_command_body = nullptr;
 
-    if ( M_command_turn_neck )
-    {
-        delete M_command_turn_neck;
-        M_command_turn_neck = nullptr;
-    }
+    M_command_turn_neck = nullptr;
 
-    if ( M_command_change_view )
-    {
-        delete M_command_change_view;
-        M_command_change_view = nullptr;
-    }
+    M_command_change_view = nullptr;
 
-    if ( M_command_change_focus )
-    {
-        delete M_command_change_focus;
-        M_command_change_focus = nullptr;
-    }
+    M_command_change_focus = nullptr;
 
-    if ( M_command_pointto )
-    {
-        delete M_command_pointto;
-        M_command_pointto = nullptr;
-    }
+    M_command_pointto = nullptr;
 
-    if ( M_command_attentionto )
-    {
-        delete M_command_attentionto;
-        M_command_attentionto = nullptr;
-    }
+    M_command_attentionto = nullptr;
 
-    if ( M_command_say )
-    {
-        delete M_command_say;
-        M_command_say = nullptr;
-    }
+    M_command_say = nullptr;
 
-    M_say_message_cont.clear();
+    clearSayMessage();
 }
 
 /*-------------------------------------------------------------------*/
@@ -661,12 +652,8 @@ ActionEffector::setKick( const double & power,
 
     //////////////////////////////////////////////////
     // create command object
-    if ( M_command_body )
-    {
-        delete M_command_body;
-        M_command_body = nullptr;
-    }
-    M_command_body = new PlayerKickCommand( command_power, rel_dir.degree() );
+    M_kick_command = PlayerKickCommand( command_power, rel_dir.degree() );
+    M_command_body = &M_kick_command;
 
     // set estimated action effect
     M_kick_accel.setPolar( command_power * M_agent.world().self().kickRate(),
@@ -852,12 +839,8 @@ ActionEffector::setDash( const double & power,
     //
     // create command object
     //
-    if ( M_command_body )
-    {
-        delete M_command_body;
-        M_command_body = nullptr;
-    }
-    M_command_body = new PlayerDashCommand( command_power, command_dir );
+    M_dash_command = PlayerDashCommand( command_power, command_dir );
+    M_command_body = &M_dash_command;
 
     //
     // set estimated command effect: accel magnitude
@@ -1023,13 +1006,9 @@ ActionEffector::setDash( const double left_power,
     double right_command_dir = check_and_normalize_dash_dir( wm, right_dir.degree() );
 
     // create command object
-    if ( M_command_body )
-    {
-        delete M_command_body;
-        M_command_body = nullptr;
-    }
-    M_command_body = new PlayerDashCommand( left_command_power, left_command_dir,
-                                            right_command_power, right_command_dir );
+    M_dash_command = PlayerDashCommand( left_command_power, left_command_dir,
+                                        right_command_power, right_command_dir );
+    M_command_body = &M_dash_command;
 
     // estimate command effect
     double left_dir_rate = ServerParam::i().dashDirRate( left_command_dir );
@@ -1112,14 +1091,9 @@ ActionEffector::setTurn( const AngleDeg & moment )
 
     //////////////////////////////////////////////////
     // create command object
-    if ( M_command_body )
-    {
-        delete M_command_body;
-        M_command_body = nullptr;
-    }
-
     // moment is a command param, not a real moment.
-    M_command_body = new PlayerTurnCommand( command_moment );
+    M_turn_command = PlayerTurnCommand( command_moment );
+    M_command_body = &M_turn_command;
 
     // set estimated action effect
     /*
@@ -1254,12 +1228,8 @@ ActionEffector::setMove( const double & x,
 
     //////////////////////////////////////////////////
     // create command object
-    if ( M_command_body )
-    {
-        delete M_command_body;
-        M_command_body = nullptr;
-    }
-    M_command_body = new PlayerMoveCommand( command_x, command_y );
+    M_move_command = PlayerMoveCommand( command_x, command_y );
+    M_command_body = &M_move_command;
 
     M_move_pos.assign( command_x, command_y );
 }
@@ -1310,12 +1280,8 @@ ActionEffector::setCatch()
 
     //////////////////////////////////////////////////
     // create command object
-    if ( M_command_body )
-    {
-        delete M_command_body;
-        M_command_body = nullptr;
-    }
-    M_command_body = new PlayerCatchCommand( catch_angle.degree() );
+    M_catch_command = PlayerCatchCommand( catch_angle.degree() );
+    M_command_body = &M_catch_command;
 }
 
 /*-------------------------------------------------------------------*/
@@ -1382,12 +1348,8 @@ ActionEffector::setTackle( const double & power_or_dir,
 
     //////////////////////////////////////////////////
     // create command object
-    if ( M_command_body )
-    {
-        delete M_command_body;
-        M_command_body = nullptr;
-    }
-    M_command_body = new PlayerTackleCommand( actual_power_or_dir, foul );
+    M_tackle_command = PlayerTackleCommand( actual_power_or_dir, foul );
+    M_command_body = &M_tackle_command;
 
     // set estimated command effect
     M_tackle_power = actual_power_or_dir;
@@ -1471,12 +1433,8 @@ ActionEffector::setTurnNeck( const AngleDeg & moment )
 
     //////////////////////////////////////////////////
     // create command object
-    if ( M_command_turn_neck )
-    {
-        delete M_command_turn_neck;
-        M_command_turn_neck = nullptr;
-    }
-    M_command_turn_neck = new PlayerTurnNeckCommand( command_moment );
+    M_turn_neck_command = PlayerTurnNeckCommand( command_moment );
+    M_command_turn_neck = &M_turn_neck_command;
 
     // set estimated command effect
     M_turn_neck_moment = command_moment;
@@ -1495,14 +1453,9 @@ ActionEffector::setChangeView( const ViewWidth & width )
 
     //////////////////////////////////////////////////
     // create command object
-    if ( M_command_change_view )
-    {
-        delete M_command_change_view;
-        M_command_change_view = nullptr;
-    }
-
-    M_command_change_view = new PlayerChangeViewCommand( width,
-                                                         ViewQuality::HIGH );
+    M_change_view_command = PlayerChangeViewCommand( width,
+                                                     ViewQuality::HIGH );
+    M_command_change_view = &M_change_view_command;
 }
 
 /*-------------------------------------------------------------------*/
@@ -1519,16 +1472,11 @@ ActionEffector::setChangeFocus( const double moment_dist,
 
     //////////////////////////////////////////////////
     // create command object
-    if ( M_command_change_focus )
-    {
-        delete M_command_change_focus;
-        M_command_change_focus = nullptr;
-    }
-
     double command_moment_dist = rint( moment_dist * 1000.0 ) * 0.001;
     double command_moment_dir = rint( moment_dir.degree() * 1000.0 ) * 0.001;
 
-    M_command_change_focus = new PlayerChangeFocusCommand( command_moment_dist, command_moment_dir );
+    M_change_focus_command = PlayerChangeFocusCommand( command_moment_dist, command_moment_dir );
+    M_command_change_focus = &M_change_focus_command;
 }
 
 /*-------------------------------------------------------------------*/
@@ -1536,7 +1484,8 @@ ActionEffector::setChangeFocus( const double moment_dist,
 
 */
 void
-ActionEffector::addSayMessage( SayMessage * message )
+ActionEffector::addSayMessage( SayMessage * message,
+                               const int priority )
 {
     if ( ! message )
     {
@@ -1551,9 +1500,68 @@ ActionEffector::addSayMessage( SayMessage * message )
                   __FILE__" (addSayMessage) add new say message.[%c]",
                   message->header() );
 
-    SayMessage::Ptr ptr( message );
+    SayMessageSlot * slot = findEmptySayMessageSlot();
+    if ( ! slot )
+    {
+        dlog.addText( Logger::ACTION,
+                      __FILE__" (addSayMessage) no empty slot.[%c]",
+                      message->header() );
+        delete message;
+        return;
+    }
+
+    slot->message_ = message;
+    slot->allocated_ = true;
+    slot->priority_ = priority;
+    slot->order_ = M_say_message_order++;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+ActionEffector::SayMessageSlot *
+ActionEffector::findEmptySayMessageSlot()
+{
+    if ( M_say_message_size < MAX_SAY_MESSAGE )
+    {
+        return &M_say_messages[M_say_message_size++];
+    }
+
+    for ( SayMessageSlot & slot : M_say_messages )
+    {
+        if ( ! slot.message_ )
+        {
+            return &slot;
+        }
+    }
+
+    return nullptr;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+ActionEffector::releaseSayMessage( SayMessageSlot & slot )
+{
+    if ( ! slot.message_ )
+    {
+        return;
+    }
+
+    if ( slot.allocated_ )
+    {
+        delete slot.message_;
+    }
+    else
+    {
+        slot.message_->~SayMessage();
+    }
 
-    M_say_message_cont.push_back( ptr );
+    slot.message_ = nullptr;
+    slot.allocated_ = false;
 }
 
 /*-------------------------------------------------------------------*/
@@ -1568,21 +1576,17 @@ ActionEffector::removeSayMessage( const char header )
 
     bool removed = false;
 
-    std::vector< SayMessage::Ptr >::iterator it = M_say_message_cont.begin();
-
-    while ( it != M_say_message_cont.end() )
+    for ( std::size_t i = 0; i < M_say_message_size; ++i )
     {
-        if ( (*it)->header() == header )
+        SayMessageSlot & slot = M_say_messages[i];
+        if ( slot.message_
+             && slot.message_->header() == header )
         {
-            it = M_say_message_cont.erase( it );
+            releaseSayMessage( slot );
             removed = true;
             dlog.addText( Logger::ACTION,
                           __FILE__" (removeSayMessage) removed" );
         }
-        else
-        {
-            ++it;
-        }
     }
 
     return removed;
@@ -1595,7 +1599,12 @@ ActionEffector::removeSayMessage( const char header )
 void
 ActionEffector::clearSayMessage()
 {
-    M_say_message_cont.clear();
+    for ( std::size_t i = 0; i < M_say_message_size; ++i )
+    {
+        releaseSayMessage( M_say_messages[i] );
+    }
+
+    M_say_message_size = 0;
 }
 
 /*-------------------------------------------------------------------*/
@@ -1616,13 +1625,9 @@ ActionEffector::setPointto( const double & x,
 
     //////////////////////////////////////////////////
     // create command object
-    if ( M_command_pointto )
-    {
-        delete M_command_pointto;
-        M_command_pointto = nullptr;
-    }
-    M_command_pointto = new PlayerPointtoCommand( target_rel.r(),
-                                                  target_rel.th().degree() );
+    M_pointto_command = PlayerPointtoCommand( target_rel.r(),
+                                              target_rel.th().degree() );
+    M_command_pointto = &M_pointto_command;
 
     // set estimated commadn effect
     M_pointto_pos = target_pos;
@@ -1640,12 +1645,8 @@ ActionEffector::setPointtoOff()
 
     //////////////////////////////////////////////////
     // create command object
-    if ( M_command_pointto )
-    {
-        delete M_command_pointto;
-        M_command_pointto = nullptr;
-    }
-    M_command_pointto = new PlayerPointtoCommand();
+    M_pointto_command = PlayerPointtoCommand();
+    M_command_pointto = &M_pointto_command;
 
     // set estimated command effect
     M_pointto_pos.invalidate();
@@ -1665,17 +1666,12 @@ ActionEffector::setAttentionto( const SideID side,
 
     //////////////////////////////////////////////////
     // create command object
-    if ( M_command_attentionto )
-    {
-        delete M_command_attentionto;
-        M_command_attentionto = nullptr;
-    }
-
-    M_command_attentionto
-        = new PlayerAttentiontoCommand( ( M_agent.world().ourSide() == side
-                                          ? PlayerAttentiontoCommand::OUR
-                                          : PlayerAttentiontoCommand::OPP ),
-                                        unum );
+    M_attentionto_command
+        = PlayerAttentiontoCommand( ( M_agent.world().ourSide() == side
+                                      ? PlayerAttentiontoCommand::OUR
+                                      : PlayerAttentiontoCommand::OPP ),
+                                    unum );
+    M_command_attentionto = &M_attentionto_command;
 }
 
 /*-------------------------------------------------------------------*/
@@ -1690,12 +1686,8 @@ ActionEffector::setAttentiontoOff()
 
     //////////////////////////////////////////////////
     // create command object
-    if ( M_command_attentionto )
-    {
-        delete M_command_attentionto;
-        M_command_attentionto = nullptr;
-    }
-    M_command_attentionto = new PlayerAttentiontoCommand();
+    M_attentionto_command = PlayerAttentiontoCommand();
+    M_command_attentionto = &M_attentionto_command;
 }
 
 /*-------------------------------------------------------------------*/
@@ -1707,9 +1699,12 @@ ActionEffector::getSayMessageLength() const
 {
     int len = 0;
 
-    for ( const SayMessage::Ptr & i : M_say_message_cont )
+    for ( std::size_t i = 0; i < M_say_message_size; ++i )
     {
-        len += i->length();
+        if ( M_say_messages[i].message_ )
+        {
+            len += M_say_messages[i].message_->length();
+        }
     }
 
     return len;
@@ -1718,29 +1713,82 @@ ActionEffector::getSayMessageLength() const
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+std::ostream &
+ActionEffector::printSayMessageDebug( std::ostream & os ) const
+{
+    for ( std::size_t i = 0; i < M_say_message_size; ++i )
+    {
+        if ( M_say_messages[i].message_ )
+        {
+            M_say_messages[i].message_->printDebug( os );
+        }
+    }
+
+    return os;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 ActionEffector::makeSayCommand()
 {
-    if ( M_command_say )
+    M_command_say = nullptr;
+
+    M_say_message.erase();
+
+    const int say_size = ServerParam::i().playerSayMsgSize();
+    M_say_message.reserve( say_size );
+
+    //
+    // sort the messages by the priority. the registration order is kept for the same priority.
+    //
+
+    std::array< const SayMessageSlot *, MAX_SAY_MESSAGE > sorted;
+    std::size_t sorted_size = 0;
+
+    for ( std::size_t i = 0; i < M_say_message_size; ++i )
     {
-        delete M_command_say;
-        M_command_say = nullptr;
+        if ( M_say_messages[i].message_ )
+        {
+            sorted[sorted_size++] = &M_say_messages[i];
+        }
     }
 
-    M_say_message.erase();
+    std::sort( sorted.begin(), sorted.begin() + sorted_size,
+               []( const SayMessageSlot * lhs,
+                   const SayMessageSlot * rhs )
+               {
+                   return ( lhs->priority_ > rhs->priority_
+                            || ( lhs->priority_ == rhs->priority_
+                                 && lhs->order_ < rhs->order_ ) );
+               } );
 
-    // std::sort( M_say_message_cont.begin(), M_say_message_cont.end(),
-    //            SayMessagePtrSorter() );
+    //
+    // greedy packing. the message that does not fit the rest of the buffer is skipped.
+    //
 
-    for ( const SayMessage::Ptr & i : M_say_message_cont )
+    for ( std::size_t i = 0; i < sorted_size; ++i )
     {
-        if ( ! i->appendTo( M_say_message ) )
+        const SayMessage * message = sorted[i]->message_;
+
+        if ( static_cast< int >( M_say_message.length() ) + message->length() > say_size )
+        {
+            dlog.addText( Logger::ACTION,
+                          __FILE__" (makeSayCommand) skip [%c]. buf=%d this=%d",
+                          message->header(),
+                          M_say_message.length(), message->length() );
+            continue;
+        }
+
+        if ( ! message->appendTo( M_say_message ) )
         {
             std::cerr << M_agent.world().teamName() << ' '
                       << M_agent.world().self().unum() << " : "
                       << M_agent.world().time() << " Error say message builder. type=["
-                      << i->header() << ']'
+                      << message->header() << ']'
                       << std::endl;
             dlog.addText( Logger::ACTION,
                           __FILE__" (makeSayCommand) error occured." );
@@ -1752,8 +1800,9 @@ ActionEffector::makeSayCommand()
         return;
     }
 
-    M_command_say = new PlayerSayCommand( M_say_message,
-                                          M_agent.config().version() );
+    M_say_command = PlayerSayCommand( M_say_message,
+                                      M_agent.config().version() );
+    M_command_say = &M_say_command;
 
     dlog.addText( Logger::ACTION,
                   __FILE__" (makeSayCommand) say message [%s]",
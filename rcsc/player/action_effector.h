@@ -40,13 +40,18 @@
 #include <rcsc/game_time.h>
 #include <rcsc/types.h>
 
+#include <array>
 #include <iostream>
+#include <new>
 #include <string>
-#include <vector>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
 
 namespace rcsc {
 
 class BodySensor;
+class CommandWriter;
 class PlayerAgent;
 
 /*!
@@ -54,11 +59,34 @@ class PlayerAgent;
   \brief manages action effect, command counter
 */
 class ActionEffector {
+public:
+
+    //! the maximum number of say messages registered in one cycle
+    static constexpr std::size_t MAX_SAY_MESSAGE = 16;
+
+    //! the size of the inline storage for a say message object
+    static constexpr std::size_t SAY_MESSAGE_STORAGE_SIZE = 96;
+
 private:
+
+    /*!
+      \struct SayMessageSlot
+      \brief registered say message. the message object is constructed in
+      the inline storage, or owned as a dynamically allocated object.
+    */
+    struct SayMessageSlot {
+        //! inline storage of the message object
+        alignas( std::max_align_t ) unsigned char storage_[SAY_MESSAGE_STORAGE_SIZE];
+        const SayMessage * message_; //!< registered message. null if this slot is empty.
+        bool allocated_; //!< true if message_ is a dynamically allocated object.
+        int priority_; //!< packing priority. the higher value is packed first.
+        int order_; //!< registration order
+    };
+
     //! const reference to the PlayerAgent instance
     const PlayerAgent & M_agent;
 
-    //! pointer of body action for dynamic allocation
+    //! pointer to the registered body command. refers to one of the command storages.
     PlayerBodyCommand * M_command_body;
 
     //! left leg command
@@ -66,19 +94,32 @@ private:
     //! right leg command
     // PlayerLegCommand * M_command_right_leg;
 
-    //! pointer of turn_neck for dynamic allocation
+    //! pointer to the registered turn_neck command
     PlayerTurnNeckCommand * M_command_turn_neck;
-    //! pointer of change_view for dynamic allocation
+    //! pointer to the registered change_view command
     PlayerChangeViewCommand * M_command_change_view;
-    //! pointer of change_focus for dynamic allocation
+    //! pointer to the registered change_focus command
     PlayerChangeFocusCommand * M_command_change_focus;
-    //! pointer of say for dynamic allocation
+    //! pointer to the registered say command
     PlayerSayCommand * M_command_say;
-    //! pointer of pointto for dynamic allocation
+    //! pointer to the registered pointto command
     PlayerPointtoCommand * M_command_pointto;
-    //! pointer to attentionto for dynamic allocation
+    //! pointer to the registered attentionto command
     PlayerAttentiontoCommand * M_command_attentionto;
 
+    // command storages. commands are overwritten in place, not allocated in each cycle.
+    PlayerKickCommand M_kick_command; //!< kick command storage
+    PlayerDashCommand M_dash_command; //!< dash command storage
+    PlayerTurnCommand M_turn_command; //!< turn command storage
+    PlayerMoveCommand M_move_command; //!< move command storage
+    PlayerCatchCommand M_catch_command; //!< catch command storage
+    PlayerTackleCommand M_tackle_command; //!< tackle command storage
+    PlayerTurnNeckCommand M_turn_neck_command; //!< turn_neck command storage
+    PlayerChangeViewCommand M_change_view_command; //!< change_view command storage
+    PlayerChangeFocusCommand M_change_focus_command; //!< change_focus command storage
+    PlayerSayCommand M_say_command; //!< say command storage
+    PlayerPointtoCommand M_pointto_command; //!< pointto command storage
+    PlayerAttentiontoCommand M_attentionto_command; //!< attentionto command storage
 
     //! command counter
     int M_command_counter[PlayerCommand::ILLEGAL + 1];
@@ -127,7 +168,9 @@ private:
 
     // say effect
     std::string M_say_message; //!< last said message string
-    std::vector< SayMessage::Ptr > M_say_message_cont;
+    std::array< SayMessageSlot, MAX_SAY_MESSAGE > M_say_messages; //!< registered say messages
+    std::size_t M_say_message_size; //!< the number of used slots, including the removed ones.
+    int M_say_message_order; //!< registration counter
 
     // pointto effect
     Vector2D M_pointto_pos;  //!< last pointto coordinates
@@ -138,6 +181,14 @@ private:
     // nocopyable
     ActionEffector( const ActionEffector & ) = delete;
     ActionEffector operator=( const ActionEffector & ) = delete;
+
+    /*!
+      \brief compose the registered commands. shared by both makeCommand() variants.
+      \param to reference to the output stream or the command writer
+    */
+    template < typename Output >
+    void composeCommand( Output & to );
+
 public:
     /*!
       \brief init member variables
@@ -147,7 +198,7 @@ public:
     ActionEffector( const PlayerAgent & agent );
 
     /*!
-      \brief destruct dynamic allocated command objects
+      \brief destructor. nothing to do
     */
     ~ActionEffector();
 
@@ -176,12 +227,22 @@ public:
       \param to reference to the output stream
       \return reference to the output stream
 
-      After command string composition, all command objects are deleted.
+      After command string composition, all command objects are released.
     */
     std::ostream & makeCommand( std::ostream & to );
 
     /*!
-      \brief delete all command objects and say messages.
+      \brief make command string into the fixed buffer and update last action time
+      \param to reference to the command writer
+
+      This method does not allocate any memory except for the say message
+      objects registered by addSayMessage().
+      After command string composition, all command objects are released.
+    */
+    void makeCommand( CommandWriter & to );
+
+    /*!
+      \brief release all command objects and delete say messages.
      */
     void clearAllCommands();
 
@@ -354,8 +415,39 @@ public:
     /*!
       \brief add new say message
       \param message pointer to the dynamically allocated say message object.
+      \param priority packing priority. the higher value is packed first.
+     */
+    void addSayMessage( SayMessage * message,
+                        const int priority = 0 );
+
+    /*!
+      \brief construct the new say message in the inline storage without any allocation.
+      \param priority packing priority. the higher value is packed first.
+      \param args arguments passed to the constructor of the message
+      \return false if there is no empty slot.
      */
-    void addSayMessage( SayMessage * message );
+    template < typename Message, typename... Args >
+    bool emplaceSayMessage( const int priority,
+                            Args &&... args )
+      {
+          static_assert( std::is_base_of< SayMessage, Message >::value,
+                         "Message must be derived from SayMessage." );
+          static_assert( sizeof( Message ) <= SAY_MESSAGE_STORAGE_SIZE
+                         && alignof( Message ) <= alignof( std::max_align_t ),
+                         "Message is too large for the inline storage." );
+
+          SayMessageSlot * slot = findEmptySayMessageSlot();
+          if ( ! slot )
+          {
+              return false;
+          }
+
+          slot->message_ = new ( slot->storage_ ) Message( std::forward< Args >( args )... );
+          slot->allocated_ = false;
+          slot->priority_ = priority;
+          slot->order_ = M_say_message_order++;
+          return true;
+      }
 
     /*!
       \brief remove the registered say message if exist
@@ -563,13 +655,11 @@ public:
     int getSayMessageLength() const;
 
     /*!
-      \brief get the reserved say messages
-      \return const reference to the say message builder container
+      \brief put the debug message of the reserved say messages
+      \param os reference to the output stream
+      \return reference to the output stream
      */
-    const std::vector< SayMessage::Ptr > & sayMessageCont() const
-      {
-          return M_say_message_cont;
-      }
+    std::ostream & printSayMessageDebug( std::ostream & os ) const;
 
     //////////////////////////////////////////
     /*!
@@ -675,7 +765,21 @@ public:
 private:
 
     /*!
-      \brief create say command object using the registered say message objects
+      \brief get the empty say message slot
+      \return pointer to the empty slot, or null if all slots are used.
+     */
+    SayMessageSlot * findEmptySayMessageSlot();
+
+    /*!
+      \brief destruct the message in the slot and make the slot empty
+      \param slot reference to the slot
+     */
+    void releaseSayMessage( SayMessageSlot & slot );
+
+    /*!
+      \brief create say command object using the registered say message objects.
+      the messages are packed into the say buffer by the greedy knapsack,
+      in the order of the higher priority and the earlier registration.
      */
     void makeSayCommand();
 
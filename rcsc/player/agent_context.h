@@ -0,0 +1,124 @@
+// -*-c++-*-
+
+/*!
+  \file agent_context.h
+  \brief per-agent storage of the action caches Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_PLAYER_AGENT_CONTEXT_H
+#define RCSC_PLAYER_AGENT_CONTEXT_H
+
+#include <typeindex>
+#include <typeinfo>
+#include <memory>
+#include <vector>
+#include <utility>
+
+namespace rcsc {
+
+/*!
+  \class AgentContext
+  \brief per-agent storage of the objects that live across the cycles.
+
+  Actions must not keep their caches in static variables, because the
+  agents in the same process would overwrite each other's results.
+  Instead, an action asks the context of the current agent for its own
+  cache object by the type:
+
+  \code
+  struct MyCache { GameTime time_; double value_; };
+  MyCache & cache = wm.agentContext().get< MyCache >();
+  \endcode
+
+  The object is default constructed at the first request and destroyed
+  with the context. The context is owned by PlayerAgent and is shared by
+  its world models. The context itself is not thread-safe, but different
+  agents never share it, so one agent per thread needs no lock.
+
+  Only the mutable per-agent state belongs here. The read-only tables
+  that do not depend on the agent (e.g. the KickTable heuristic tables)
+  should be shared by all agents in the process.
+*/
+class AgentContext {
+private:
+
+    //! stored objects. the deleter is kept by std::shared_ptr< void >.
+    std::vector< std::pair< std::type_index, std::shared_ptr< void > > > M_objects;
+
+    // not used
+    AgentContext( const AgentContext & ) = delete;
+    AgentContext & operator=( const AgentContext & ) = delete;
+
+public:
+
+    /*!
+      \brief create an empty context
+    */
+    AgentContext()
+      { }
+
+    /*!
+      \brief get the object of the type. the object is created at the first call.
+      \tparam T object type. must be default constructible.
+      \return reference to the object owned by this context
+    */
+    template < typename T >
+    T & get()
+      {
+          const std::type_index key( typeid( T ) );
+          for ( const std::pair< std::type_index, std::shared_ptr< void > > & v : M_objects )
+          {
+              if ( v.first == key )
+              {
+                  return *static_cast< T * >( v.second.get() );
+              }
+          }
+
+          std::shared_ptr< T > ptr = std::make_shared< T >();
+          M_objects.emplace_back( key, ptr );
+          return *ptr;
+      }
+
+    /*!
+      \brief destroy all objects
+    */
+    void clear()
+      {
+          M_objects.clear();
+      }
+
+    /*!
+      \brief get the context used by the world models not owned by any agent.
+      \return reference to the process-wide context. not thread-safe.
+    */
+    static
+    AgentContext & default_context();
+};
+
+}
+
+#endif
@@ -0,0 +1,103 @@
+// -*-c++-*-
+
+/*!
+  \file angular_player_profile.cpp
+  \brief players sorted by the direction from a base point Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "angular_player_profile.h"
+
+#include <rcsc/common/player_type.h>
+
+#include <algorithm>
+
+namespace rcsc {
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+AngularPlayerProfile::build( const PlayerObject::Cont & players,
+                             const Origin origin )
+{
+    M_entries.clear();
+    M_entries.reserve( players.size() );
+
+    std::size_t order = 0;
+    for ( const PlayerObject * p : players )
+    {
+        Entry e;
+        e.player_ = p;
+        if ( origin == FROM_SELF )
+        {
+            e.angle_ = p->angleFromSelf().degree();
+            e.dist_ = p->distFromSelf();
+        }
+        else
+        {
+            e.angle_ = p->angleFromBall().degree();
+            e.dist_ = p->distFromBall();
+        }
+
+        const PlayerType * ptype = p->playerTypePtr();
+        e.reach_step_ = ( ptype
+                          ? ptype->cyclesToReachDistance( std::max( 0.0, e.dist_ - ptype->kickableArea() ) )
+                          : 0 );
+        e.order_ = order++;
+
+        M_entries.push_back( e );
+    }
+
+    std::stable_sort( M_entries.begin(), M_entries.end(),
+                      []( const Entry & lhs, const Entry & rhs )
+                        {
+                            return lhs.angle_ < rhs.angle_;
+                        } );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::size_t
+AngularPlayerProfile::lowerBound( const double deg ) const
+{
+    std::vector< Entry >::const_iterator it
+        = std::lower_bound( M_entries.begin(), M_entries.end(), deg,
+                            []( const Entry & e, const double value )
+                              {
+                                  return e.angle_ < value;
+                              } );
+    return static_cast< std::size_t >( it - M_entries.begin() );
+}
+
+}
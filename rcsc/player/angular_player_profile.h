@@ -0,0 +1,215 @@
+// -*-c++-*-
+
+/*!
+  \file angular_player_profile.h
+  \brief players sorted by the direction from a base point Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_PLAYER_ANGULAR_PLAYER_PROFILE_H
+#define RCSC_PLAYER_ANGULAR_PLAYER_PROFILE_H
+
+#include <rcsc/player/player_object.h>
+#include <rcsc/geom/angle_deg.h>
+
+#include <vector>
+#include <cstddef>
+
+namespace rcsc {
+
+/*!
+  \class AngularPlayerProfile
+  \brief players sorted by the direction from the self or the ball.
+
+  The profile is rebuilt once per decision by WorldModel. The angle sweeps
+  (advance, clear, pass or shoot course search) find the nearest player in
+  direction or the players within an angle range by the binary search,
+  instead of checking all players for every searched angle.
+
+  The angle and the distance of each entry are the same values as
+  PlayerObject::angleFromSelf()/distFromSelf() or
+  angleFromBall()/distFromBall().
+*/
+class AngularPlayerProfile {
+public:
+
+    /*!
+      \enum Origin
+      \brief base point of the angle
+    */
+    enum Origin {
+        FROM_SELF,
+        FROM_BALL,
+    };
+
+    /*!
+      \struct Entry
+      \brief player data in the profile
+    */
+    struct Entry {
+        const PlayerObject * player_; //!< player
+        double angle_; //!< direction from the base point [deg]
+        double dist_; //!< distance from the base point
+        int reach_step_; //!< estimated dash steps for the player to reach the base point
+        std::size_t order_; //!< index in the source container (distance order)
+    };
+
+private:
+
+    std::vector< Entry > M_entries; //!< entries sorted by angle
+
+public:
+
+    /*!
+      \brief remove all entries
+    */
+    void clear()
+      {
+          M_entries.clear();
+      }
+
+    /*!
+      \brief rebuild the profile
+      \param players source players sorted by distance from the base point
+      \param origin base point type
+    */
+    void build( const PlayerObject::Cont & players,
+                const Origin origin );
+
+    /*!
+      \brief get all entries sorted by angle
+      \return const reference to the entry container
+    */
+    const std::vector< Entry > & entries() const
+      {
+          return M_entries;
+      }
+
+    /*!
+      \brief get the first entry index whose angle is not less than the argument
+      \param deg angle value [deg]
+      \return entry index. entries().size() if not found.
+    */
+    std::size_t lowerBound( const double deg ) const;
+
+    /*!
+      \brief find the player whose direction is the nearest to the angle
+      \param angle searched angle
+      \param pred player predicate. the players that do not satisfy this are ignored.
+      \param angle_diff pointer to the variable to store the absolute angle difference
+      \return pointer to the entry. nullptr if not found.
+
+      The nearest entry is the first entry that satisfies the predicate when
+      the entries are checked clockwise or counterclockwise from the angle.
+    */
+    template < typename Predicate >
+    const Entry * nearest( const AngleDeg & angle,
+                           Predicate pred,
+                           double * angle_diff = nullptr ) const
+      {
+          const std::size_t size = M_entries.size();
+          const std::size_t start = lowerBound( angle.degree() );
+
+          const Entry * best = nullptr;
+          double best_diff = 360.0;
+
+          // clockwise (increasing angle)
+          for ( std::size_t n = 0; n < size; ++n )
+          {
+              const Entry & e = M_entries[( start + n ) % size];
+              if ( pred( *e.player_ ) )
+              {
+                  best_diff = ( angle - AngleDeg( e.angle_ ) ).abs();
+                  best = &e;
+                  break;
+              }
+          }
+
+          // counterclockwise (decreasing angle)
+          for ( std::size_t n = 1; best && n <= size; ++n )
+          {
+              const Entry & e = M_entries[( start + size - n ) % size];
+              if ( pred( *e.player_ ) )
+              {
+                  const double diff = ( angle - AngleDeg( e.angle_ ) ).abs();
+                  if ( diff < best_diff )
+                  {
+                      best_diff = diff;
+                      best = &e;
+                  }
+                  break;
+              }
+          }
+
+          if ( angle_diff ) *angle_diff = best_diff;
+          return best;
+      }
+
+    /*!
+      \brief call the function for each entry within [left, right] (turn clockwise)
+      \param left left angle
+      \param right right angle
+      \param func function called with the const reference to the entry.
+      the entries are visited in the angle order.
+
+      The range is checked by AngleDeg::isWithin(), so the visited entries
+      are exactly the same as the linear check.
+    */
+    template < typename Function >
+    void forEachWithin( const AngleDeg & left,
+                        const AngleDeg & right,
+                        Function func ) const
+      {
+          static const double margin = 1.0e-6;
+
+          const std::size_t size = M_entries.size();
+          if ( size == 0 )
+          {
+              return;
+          }
+
+          double width = right.degree() - left.degree();
+          if ( width < 0.0 ) width += 360.0;
+
+          const std::size_t start = lowerBound( left.degree() - margin );
+          for ( std::size_t n = 0; n < size; ++n )
+          {
+              const Entry & e = M_entries[( start + n ) % size];
+              double offset = e.angle_ - left.degree();
+              if ( offset < - margin ) offset += 360.0;
+              if ( offset > width + margin ) break;
+
+              if ( AngleDeg( e.angle_ ).isWithin( left, right ) )
+              {
+                  func( e );
+              }
+          }
+      }
+};
+
+}
+
+#endif
@@ -0,0 +1,462 @@
+// -*-c++-*-
+
+/*!
+  \file arrival_time_map.cpp
+  \brief grid of the estimated arrival steps of both teams Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "arrival_time_map.h"
+
+#include "abstract_player_object.h"
+#include "player_snapshot.h"
+
+#include <rcsc/common/player_type.h>
+#include <rcsc/common/server_param.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace rcsc {
+
+constexpr double ArrivalTimeMap::GRID_STEP;
+constexpr double ArrivalTimeMap::FINE_GRID_STEP;
+constexpr double ArrivalTimeMap::FINE_GRID_RADIUS;
+constexpr double ArrivalTimeMap::UNREACHABLE;
+
+namespace {
+
+//! distance bin size of the dash step tables
+constexpr float DASH_TABLE_BIN = 0.1f;
+
+//! the body angle difference that needs no turn
+constexpr double TURN_MARGIN = 15.0;
+
+//! the player is ignored if its position count is greater than this value
+constexpr int MAX_POS_COUNT = 15;
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ArrivalTimeMap::ArrivalTimeMap()
+    : M_time( -1, 0 ),
+      M_origin( 0.0, 0.0 ),
+      M_columns( 0 ),
+      M_rows( 0 ),
+      M_fine_origin( 0.0, 0.0 ),
+      M_fine_size( static_cast< int >( std::round( FINE_GRID_RADIUS * 2.0 / FINE_GRID_STEP ) ) )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+inline
+float
+ArrivalTimeMap::estimate_step( const Player & p,
+                               const float x,
+                               const float y )
+{
+    const float dx = x - p.x_;
+    const float dy = y - p.y_;
+    const float dist = std::sqrt( dx * dx + dy * dy );
+    const float move_dist = std::max( 0.0f, dist - p.control_area_ );
+
+    const int bin = std::min( static_cast< int >( move_dist * ( 1.0f / DASH_TABLE_BIN ) ),
+                              p.table_size_ - 1 );
+    const float dash_step = ( p.table_[bin]
+                              + std::max( 0.0f, move_dist - p.table_max_dist_ ) / p.speed_max_ );
+
+    const float cos_diff = ( dx * p.body_x_ + dy * p.body_y_ ) / std::max( dist, 1.0e-3f );
+    const float turn_step = ( move_dist > 0.0f
+                              ? float( cos_diff < p.cos_one_turn_ ) + float( cos_diff < p.cos_two_turns_ )
+                              : 0.0f );
+
+    return std::max( 0.0f, dash_step + turn_step + p.step_offset_ );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+ArrivalTimeMap::dashTableIndex( const PlayerType & ptype )
+{
+    for ( std::size_t i = 0; i < M_dash_tables.size(); ++i )
+    {
+        if ( M_dash_tables[i].type_ == &ptype )
+        {
+            return static_cast< int >( i );
+        }
+    }
+
+    M_dash_tables.emplace_back();
+
+    DashTable & table = M_dash_tables.back();
+    table.type_ = &ptype;
+
+    //
+    // the fractional dash steps are interpolated between the distances of the continuous dashes.
+    //
+    const std::vector< double > & dist_table = ptype.dashDistanceTable();
+    const double max_dist = ( dist_table.empty() ? 0.0 : dist_table.back() );
+    const int size = static_cast< int >( std::ceil( max_dist / DASH_TABLE_BIN ) ) + 1;
+
+    table.steps_.resize( size );
+
+    std::size_t k = 0;
+    for ( int i = 0; i < size; ++i )
+    {
+        const double dist = std::min( max_dist, i * static_cast< double >( DASH_TABLE_BIN ) );
+        while ( k + 1 < dist_table.size()
+                && dist_table[k] < dist )
+        {
+            ++k;
+        }
+
+        const double prev_dist = ( k == 0 ? 0.0 : dist_table[k - 1] );
+        const double rate = ( dist_table.empty() || dist_table[k] <= prev_dist
+                              ? 1.0
+                              : ( dist - prev_dist ) / ( dist_table[k] - prev_dist ) );
+        table.steps_[i] = static_cast< float >( k + std::max( 0.0, std::min( 1.0, rate ) ) );
+    }
+
+    return static_cast< int >( M_dash_tables.size() ) - 1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ArrivalTimeMap::update( const GameTime & current,
+                        const PlayerSnapshot & snapshot,
+                        const SideID our_side,
+                        const Vector2D & ball_pos )
+{
+    const ServerParam & SP = ServerParam::i();
+
+    M_time = current;
+    M_players.clear();
+    M_dash_tables.clear();
+
+    //
+    // collect the players
+    //
+    for ( std::size_t i = 0; i < snapshot.size(); ++i )
+    {
+        const AbstractPlayerObject * object = snapshot.player( i );
+        const PlayerType * ptype = object->playerTypePtr();
+
+        if ( ! ptype
+             || snapshot.posCount()[i] > MAX_POS_COUNT
+             || ( snapshot.flags()[i] & PlayerSnapshot::FLAG_GHOST ) )
+        {
+            continue;
+        }
+
+        const Vector2D final_pos = ptype->inertiaFinalPoint( snapshot.pos( i ), snapshot.vel( i ) );
+        const int bonus_step = std::min( 3, snapshot.posCount()[i] );
+        const int penalty_step = ( ( snapshot.flags()[i] & PlayerSnapshot::FLAG_TACKLING )
+                                   ? std::max( 0, SP.tackleCycles() - 2 )
+                                   : 0 );
+
+        Player p;
+        p.object_ = object;
+        p.team_ = ( snapshot.side()[i] == our_side ? 0 : 1 );
+        p.x_ = static_cast< float >( final_pos.x );
+        p.y_ = static_cast< float >( final_pos.y );
+        p.control_area_ = static_cast< float >( ptype->kickableArea() );
+        p.step_offset_ = static_cast< float >( penalty_step - bonus_step );
+        p.speed_max_ = static_cast< float >( ptype->realSpeedMax() );
+
+        if ( object->bodyCount() <= 3 )
+        {
+            const double max_turn = ptype->effectiveTurn( SP.maxMoment(), object->vel().r() );
+            p.body_x_ = static_cast< float >( object->body().cos() );
+            p.body_y_ = static_cast< float >( object->body().sin() );
+            p.cos_one_turn_ = static_cast< float >( AngleDeg::cos_deg( TURN_MARGIN ) );
+            p.cos_two_turns_ = ( TURN_MARGIN + max_turn >= 180.0
+                                 ? -2.0f
+                                 : static_cast< float >( AngleDeg::cos_deg( TURN_MARGIN + max_turn ) ) );
+        }
+        else
+        {
+            // no turn is estimated if the body direction is unknown.
+            p.body_x_ = p.body_y_ = 0.0f;
+            p.cos_one_turn_ = p.cos_two_turns_ = -2.0f;
+        }
+
+        p.table_index_ = dashTableIndex( *ptype );
+        M_players.push_back( p );
+    }
+
+    // the table pointers are set after all tables are created.
+    for ( Player & p : M_players )
+    {
+        const DashTable & table = M_dash_tables[p.table_index_];
+        p.table_ = table.steps_.data();
+        p.table_size_ = static_cast< int >( table.steps_.size() );
+        p.table_max_dist_ = ( table.type_->dashDistanceTable().empty()
+                              ? 0.0f
+                              : static_cast< float >( table.type_->dashDistanceTable().back() ) );
+    }
+
+    //
+    // coarse grid
+    //
+    const double half_length = SP.pitchHalfLength() + SP.pitchMargin();
+    const double half_width = SP.pitchHalfWidth() + SP.pitchMargin();
+
+    M_columns = std::max( 1, static_cast< int >( std::ceil( half_length * 2.0 / GRID_STEP ) ) );
+    M_rows = std::max( 1, static_cast< int >( std::ceil( half_width * 2.0 / GRID_STEP ) ) );
+    M_origin.assign( -half_length + GRID_STEP * 0.5,
+                     -half_width + GRID_STEP * 0.5 );
+
+    computeGrid();
+
+    //
+    // fine grid. the values are computed on demand.
+    //
+    M_fine_origin.assign( ball_pos.x - FINE_GRID_RADIUS + FINE_GRID_STEP * 0.5,
+                          ball_pos.y - FINE_GRID_RADIUS + FINE_GRID_STEP * 0.5 );
+    for ( int t = 0; t < 2; ++t )
+    {
+        M_fine_step[t].assign( M_fine_size * M_fine_size, -1.0f );
+        M_fine_index[t].assign( M_fine_size * M_fine_size, -1 );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ArrivalTimeMap::computeGrid()
+{
+    const int size = M_columns * M_rows;
+
+    for ( int t = 0; t < 2; ++t )
+    {
+        M_step[t].assign( size, static_cast< float >( UNREACHABLE ) );
+        M_index[t].assign( size, -1 );
+    }
+
+    const int columns = M_columns;
+    const float x0 = static_cast< float >( M_origin.x );
+    const float y0 = static_cast< float >( M_origin.y );
+    const float step = static_cast< float >( GRID_STEP );
+
+    M_row_dash_step.resize( columns );
+    M_row_cos.resize( columns );
+
+    float * const dash_step = M_row_dash_step.data();
+    float * const cos_diff = M_row_cos.data();
+
+    for ( std::size_t i = 0; i < M_players.size(); ++i )
+    {
+        // the player values are copied to the local variables,
+        // because the compiler cannot know that they are not changed by the stores to the grid.
+        const Player & p = M_players[i];
+        const int index = static_cast< int >( i );
+        const float px = p.x_;
+        const float py = p.y_;
+        const float body_x = p.body_x_;
+        const float body_y = p.body_y_;
+        const float control_area = p.control_area_;
+        const float step_offset = p.step_offset_;
+        const float cos_one_turn = p.cos_one_turn_;
+        const float cos_two_turns = p.cos_two_turns_;
+        const float * const table = p.table_;
+        const float last_bin = static_cast< float >( p.table_size_ - 1 );
+        const float table_max_dist = p.table_max_dist_;
+        const float inv_speed_max = 1.0f / p.speed_max_;
+
+        float * const values = M_step[p.team_].data();
+        int * const indices = M_index[p.team_].data();
+
+        for ( int row = 0; row < M_rows; ++row )
+        {
+            const float dy = y0 + step * row - py;
+            float * const row_values = values + row * columns;
+            int * const row_indices = indices + row * columns;
+
+            //
+            // the row is processed by three loops. std::sqrt may set errno and the table
+            // lookup is a gather, so they stop the vectorization of the loop that contains them.
+            // the first and the last loops have no branch, so that the compiler can vectorize them.
+            //
+            for ( int col = 0; col < columns; ++col )
+            {
+                const float dx = x0 + step * col - px;
+                dash_step[col] = dx * dx + dy * dy;
+                cos_diff[col] = dx * body_x + dy * body_y;
+            }
+
+            for ( int col = 0; col < columns; ++col )
+            {
+                const float dist = std::sqrt( dash_step[col] );
+                const float move_dist = std::max( 0.0f, dist - control_area );
+                const int bin = static_cast< int >( std::min( move_dist * ( 1.0f / DASH_TABLE_BIN ), last_bin ) );
+                dash_step[col] = ( table[bin]
+                                   + std::max( 0.0f, move_dist - table_max_dist ) * inv_speed_max );
+                cos_diff[col] = ( move_dist > 0.0f
+                                  ? cos_diff[col] / std::max( dist, 1.0e-3f )
+                                  : 1.0f ); // no turn
+            }
+
+            // the same estimation as estimate_step()
+            for ( int col = 0; col < columns; ++col )
+            {
+                const float turn_step = ( float( cos_diff[col] < cos_one_turn )
+                                          + float( cos_diff[col] < cos_two_turns ) );
+                const float v = std::max( 0.0f, dash_step[col] + turn_step + step_offset );
+                const int faster = -static_cast< int >( v < row_values[col] ); // all bits are set if faster
+                row_values[col] = std::min( v, row_values[col] );
+                row_indices[col] = ( index & faster ) | ( row_indices[col] & ~faster );
+            }
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ArrivalTimeMap::Arrival
+ArrivalTimeMap::createArrival( const float our_step,
+                               const int our_index,
+                               const float their_step,
+                               const int their_index ) const
+{
+    Arrival result;
+    result.our_step_ = our_step;
+    result.their_step_ = their_step;
+    result.our_player_ = ( our_index >= 0 ? M_players[our_index].object_ : nullptr );
+    result.their_player_ = ( their_index >= 0 ? M_players[their_index].object_ : nullptr );
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ArrivalTimeMap::Arrival
+ArrivalTimeMap::get( const Vector2D & pos ) const
+{
+    //
+    // fine grid
+    //
+    const double fine_min_x = M_fine_origin.x - FINE_GRID_STEP * 0.5;
+    const double fine_min_y = M_fine_origin.y - FINE_GRID_STEP * 0.5;
+    if ( fine_min_x <= pos.x && pos.x < fine_min_x + FINE_GRID_RADIUS * 2.0
+         && fine_min_y <= pos.y && pos.y < fine_min_y + FINE_GRID_RADIUS * 2.0
+         && ! M_fine_step[0].empty() )
+    {
+        const int col = std::min( M_fine_size - 1,
+                                  static_cast< int >( ( pos.x - fine_min_x ) / FINE_GRID_STEP ) );
+        const int row = std::min( M_fine_size - 1,
+                                  static_cast< int >( ( pos.y - fine_min_y ) / FINE_GRID_STEP ) );
+        const int cell = row * M_fine_size + col;
+
+        if ( M_fine_step[0][cell] < 0.0f )
+        {
+            const float x = static_cast< float >( M_fine_origin.x + FINE_GRID_STEP * col );
+            const float y = static_cast< float >( M_fine_origin.y + FINE_GRID_STEP * row );
+
+            M_fine_step[0][cell] = M_fine_step[1][cell] = static_cast< float >( UNREACHABLE );
+            for ( std::size_t i = 0; i < M_players.size(); ++i )
+            {
+                const Player & p = M_players[i];
+                const float v = estimate_step( p, x, y );
+                if ( v < M_fine_step[p.team_][cell] )
+                {
+                    M_fine_step[p.team_][cell] = v;
+                    M_fine_index[p.team_][cell] = static_cast< int >( i );
+                }
+            }
+        }
+
+        return createArrival( M_fine_step[0][cell], M_fine_index[0][cell],
+                              M_fine_step[1][cell], M_fine_index[1][cell] );
+    }
+
+    //
+    // coarse grid
+    //
+    if ( M_step[0].empty() )
+    {
+        return createArrival( static_cast< float >( UNREACHABLE ), -1,
+                              static_cast< float >( UNREACHABLE ), -1 );
+    }
+
+    const int col = std::max( 0, std::min( M_columns - 1,
+                                           static_cast< int >( std::round( ( pos.x - M_origin.x ) / GRID_STEP ) ) ) );
+    const int row = std::max( 0, std::min( M_rows - 1,
+                                           static_cast< int >( std::round( ( pos.y - M_origin.y ) / GRID_STEP ) ) ) );
+    const int cell = row * M_columns + col;
+
+    return createArrival( M_step[0][cell], M_index[0][cell],
+                          M_step[1][cell], M_index[1][cell] );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ArrivalTimeMap::Arrival
+ArrivalTimeMap::estimate( const Vector2D & pos ) const
+{
+    float step[2] = { static_cast< float >( UNREACHABLE ), static_cast< float >( UNREACHABLE ) };
+    int index[2] = { -1, -1 };
+
+    const float x = static_cast< float >( pos.x );
+    const float y = static_cast< float >( pos.y );
+
+    for ( std::size_t i = 0; i < M_players.size(); ++i )
+    {
+        const Player & p = M_players[i];
+        const float v = estimate_step( p, x, y );
+        if ( v < step[p.team_] )
+        {
+            step[p.team_] = v;
+            index[p.team_] = static_cast< int >( i );
+        }
+    }
+
+    return createArrival( step[0], index[0], step[1], index[1] );
+}
+
+}
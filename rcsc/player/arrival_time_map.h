@@ -0,0 +1,255 @@
+// -*-c++-*-
+
+/*!
+  \file arrival_time_map.h
+  \brief grid of the estimated arrival steps of both teams Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_PLAYER_ARRIVAL_TIME_MAP_H
+#define RCSC_PLAYER_ARRIVAL_TIME_MAP_H
+
+#include <rcsc/geom/vector_2d.h>
+#include <rcsc/game_time.h>
+#include <rcsc/types.h>
+
+#include <vector>
+
+namespace rcsc {
+
+class AbstractPlayerObject;
+class PlayerSnapshot;
+class PlayerType;
+
+/*!
+  \class ArrivalTimeMap
+  \brief estimated steps for each team to reach the points on the pitch.
+
+  The map is rebuilt once per decision by WorldModel. The arrival step of a
+  player is estimated from the inertia final point of the player, the dash
+  distance table of the player type, the turn steps to face the point and the
+  position accuracy. The ball is not considered, so the value is the step to
+  reach the point, not the step to intercept a moving ball.
+
+  The coarse grid covers the pitch with the margin. Each player is processed
+  by a flat loop over the grid cells that the compiler can vectorize.
+  The fine grid around the ball is computed lazily cell by cell when it is
+  referred for the first time in the cycle.
+
+  \code
+  const ArrivalTimeMap::Arrival a = wm.arrivalTimeMap().get( receive_point );
+  if ( a.margin() >= 2.0 )
+  {
+      // teammates reach the point 2 steps earlier than opponents
+  }
+  \endcode
+*/
+class ArrivalTimeMap {
+public:
+
+    //! cell size of the coarse grid
+    static constexpr double GRID_STEP = 2.0;
+    //! cell size of the fine grid around the ball
+    static constexpr double FINE_GRID_STEP = 0.5;
+    //! half size of the square covered by the fine grid
+    static constexpr double FINE_GRID_RADIUS = 10.0;
+    //! the step value used when no player can reach
+    static constexpr double UNREACHABLE = 1000.0;
+
+    /*!
+      \struct Arrival
+      \brief arrival steps of both teams at one point
+     */
+    struct Arrival {
+        double our_step_; //!< estimated steps of the fastest teammate (includes self)
+        double their_step_; //!< estimated steps of the fastest opponent (includes unknown players)
+        const AbstractPlayerObject * our_player_; //!< fastest teammate. NULL if no teammate can reach.
+        const AbstractPlayerObject * their_player_; //!< fastest opponent. NULL if no opponent can reach.
+
+        /*!
+          \brief get the step difference
+          \return positive value if teammates reach earlier
+         */
+        double margin() const
+          {
+              return their_step_ - our_step_;
+          }
+
+        /*!
+          \brief check if teammates reach earlier
+          \return checked result
+         */
+        bool ourFirst() const
+          {
+              return our_step_ < their_step_;
+          }
+    };
+
+private:
+
+    /*!
+      \struct Player
+      \brief player values used by the estimation
+     */
+    struct Player {
+        const AbstractPlayerObject * object_; //!< source object
+        int team_; //!< 0: teammate, 1: opponent
+        float x_; //!< inertia final point x
+        float y_; //!< inertia final point y
+        float body_x_; //!< unit vector of the body direction. (0,0) if unknown.
+        float body_y_; //!< unit vector of the body direction. (0,0) if unknown.
+        float control_area_; //!< kickable area
+        float step_offset_; //!< penalty steps minus bonus steps
+        float cos_one_turn_; //!< one turn is needed if cos(angle difference) is less than this value.
+        float cos_two_turns_; //!< two turns are needed if cos(angle difference) is less than this value.
+        int table_index_; //!< index of the dash table
+        const float * table_; //!< dash step table of the player type
+        int table_size_; //!< the number of values in the dash step table
+        float table_max_dist_; //!< the longest distance in the table
+        float speed_max_; //!< reachable max speed
+    };
+
+    /*!
+      \struct DashTable
+      \brief dash steps sampled by the distance
+     */
+    struct DashTable {
+        const PlayerType * type_; //!< player type
+        std::vector< float > steps_; //!< fractional dash steps for each distance bin
+    };
+
+    GameTime M_time; //!< updated time
+
+    std::vector< Player > M_players; //!< players used by the estimation
+    std::vector< DashTable > M_dash_tables; //!< dash tables of the used player types
+
+    Vector2D M_origin; //!< center of the first cell of the coarse grid
+    int M_columns; //!< the number of columns of the coarse grid
+    int M_rows; //!< the number of rows of the coarse grid
+
+    std::vector< float > M_step[2]; //!< coarse grid step values for each team
+    std::vector< int > M_index[2]; //!< coarse grid fastest player indices for each team. -1 if none.
+
+    Vector2D M_fine_origin; //!< center of the first cell of the fine grid
+    int M_fine_size; //!< the number of columns and rows of the fine grid
+    mutable std::vector< float > M_fine_step[2]; //!< fine grid step values. negative if not computed.
+    mutable std::vector< int > M_fine_index[2]; //!< fine grid fastest player indices
+
+    std::vector< float > M_row_dash_step; //!< working buffer for computeGrid()
+    std::vector< float > M_row_cos; //!< working buffer for computeGrid()
+
+    // not used
+    ArrivalTimeMap( const ArrivalTimeMap & ) = delete;
+    ArrivalTimeMap & operator=( const ArrivalTimeMap & ) = delete;
+
+public:
+
+    /*!
+      \brief create an empty map
+     */
+    ArrivalTimeMap();
+
+    /*!
+      \brief rebuild the map
+      \param current current game time
+      \param snapshot player states
+      \param our_side our side id
+      \param ball_pos center of the fine grid
+     */
+    void update( const GameTime & current,
+                 const PlayerSnapshot & snapshot,
+                 const SideID our_side,
+                 const Vector2D & ball_pos );
+
+    /*!
+      \brief get the updated time
+      \return game time
+     */
+    const GameTime & time() const
+      {
+          return M_time;
+      }
+
+    /*!
+      \brief get the arrival steps at the point.
+      \param pos target point
+      \return arrival steps of the cell that contains the point
+
+      The fine grid is used within FINE_GRID_RADIUS around the ball.
+      The points out of the grid are clamped to the nearest border cell.
+     */
+    Arrival get( const Vector2D & pos ) const;
+
+    /*!
+      \brief estimate the arrival steps at the point without the grid.
+      \param pos target point
+      \return arrival steps at the point
+     */
+    Arrival estimate( const Vector2D & pos ) const;
+
+private:
+
+    /*!
+      \brief get the dash table of the player type. the table is created if not exist.
+      \param ptype player type
+      \return index of the table
+     */
+    int dashTableIndex( const PlayerType & ptype );
+
+    /*!
+      \brief estimate the arrival step of the player
+      \param p player values
+      \param x target x coordinate
+      \param y target y coordinate
+      \return estimated steps
+     */
+    static
+    float estimate_step( const Player & p,
+                         const float x,
+                         const float y );
+
+    /*!
+      \brief compute the coarse grid
+     */
+    void computeGrid();
+
+    /*!
+      \brief create the result from the player indices and steps
+      \param our_step step value of teammates
+      \param our_index index of the fastest teammate. -1 if none.
+      \param their_step step value of opponents
+      \param their_index index of the fastest opponent. -1 if none.
+      \return result object
+     */
+    Arrival createArrival( const float our_step,
+                           const int our_index,
+                           const float their_step,
+                           const int their_index ) const;
+};
+
+}
+
+#endif
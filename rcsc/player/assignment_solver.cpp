@@ -0,0 +1,170 @@
+// -*-c++-*-
+
+/*!
+  \file assignment_solver.cpp
+  \brief small fixed-size assignment problem solver Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "assignment_solver.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace rcsc {
+
+constexpr std::size_t AssignmentSolver::MAX_SIZE;
+constexpr double AssignmentSolver::FORBIDDEN;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+AssignmentSolver::solve( const std::size_t rows,
+                         const std::size_t cols,
+                         const double * cost,
+                         int * row_to_col )
+{
+    if ( rows > MAX_SIZE
+         || cols > MAX_SIZE )
+    {
+        return false;
+    }
+
+    std::fill( row_to_col, row_to_col + rows, -1 );
+
+    if ( rows == 0
+         || cols == 0 )
+    {
+        return true;
+    }
+
+    //
+    // the rectangular matrix is padded to the square one by infeasible pairs.
+    //
+
+    const std::size_t n = std::max( rows, cols );
+
+    for ( std::size_t i = 1; i <= n; ++i )
+    {
+        double * row = M_cost.data() + i * N;
+        for ( std::size_t j = 1; j <= n; ++j )
+        {
+            row[j] = ( i <= rows && j <= cols
+                       ? std::min( cost[( i - 1 ) * cols + ( j - 1 )], FORBIDDEN )
+                       : FORBIDDEN );
+        }
+    }
+
+    std::fill( M_u.begin(), M_u.begin() + n + 1, 0.0 );
+    std::fill( M_v.begin(), M_v.begin() + n + 1, 0.0 );
+    std::fill( M_row_of.begin(), M_row_of.begin() + n + 1, 0 );
+    std::fill( M_way.begin(), M_way.begin() + n + 1, 0 );
+
+    const double inf = std::numeric_limits< double >::max();
+
+    //
+    // add rows one by one, and find the shortest augmenting path
+    // on the reduced costs.
+    //
+
+    for ( std::size_t i = 1; i <= n; ++i )
+    {
+        M_row_of[0] = static_cast< int >( i );
+        std::size_t j0 = 0;
+
+        std::fill( M_min_v.begin(), M_min_v.begin() + n + 1, inf );
+        std::fill( M_used.begin(), M_used.begin() + n + 1, false );
+
+        do
+        {
+            M_used[j0] = true;
+            const std::size_t i0 = M_row_of[j0];
+            const double * row = M_cost.data() + i0 * N;
+            double delta = inf;
+            std::size_t j1 = 0;
+
+            for ( std::size_t j = 1; j <= n; ++j )
+            {
+                if ( M_used[j] ) continue;
+
+                const double reduced = row[j] - M_u[i0] - M_v[j];
+                if ( reduced < M_min_v[j] )
+                {
+                    M_min_v[j] = reduced;
+                    M_way[j] = static_cast< int >( j0 );
+                }
+
+                if ( M_min_v[j] < delta )
+                {
+                    delta = M_min_v[j];
+                    j1 = j;
+                }
+            }
+
+            for ( std::size_t j = 0; j <= n; ++j )
+            {
+                if ( M_used[j] )
+                {
+                    M_u[M_row_of[j]] += delta;
+                    M_v[j] -= delta;
+                }
+                else
+                {
+                    M_min_v[j] -= delta;
+                }
+            }
+
+            j0 = j1;
+        } while ( M_row_of[j0] != 0 );
+
+        do
+        {
+            const std::size_t j1 = M_way[j0];
+            M_row_of[j0] = M_row_of[j1];
+            j0 = j1;
+        } while ( j0 != 0 );
+    }
+
+    for ( std::size_t j = 1; j <= cols; ++j )
+    {
+        const std::size_t i = M_row_of[j];
+        if ( 1 <= i && i <= rows
+             && M_cost[i * N + j] < FORBIDDEN )
+        {
+            row_to_col[i - 1] = static_cast< int >( j - 1 );
+        }
+    }
+
+    return true;
+}
+
+}
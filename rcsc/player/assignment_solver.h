@@ -0,0 +1,92 @@
+// -*-c++-*-
+
+/*!
+  \file assignment_solver.h
+  \brief small fixed-size assignment problem solver Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_PLAYER_ASSIGNMENT_SOLVER_H
+#define RCSC_PLAYER_ASSIGNMENT_SOLVER_H
+
+#include <array>
+#include <cstddef>
+
+namespace rcsc {
+
+/*!
+  \class AssignmentSolver
+  \brief minimum cost assignment solver (Hungarian method) for the player matching.
+
+  The problem size is limited to MAX_SIZE x MAX_SIZE, that is enough for all
+  players on the field. All working buffers are fixed size members, so no
+  memory is allocated while solving.
+*/
+class AssignmentSolver {
+public:
+
+    //! the maximum number of rows and columns
+    static constexpr std::size_t MAX_SIZE = 22;
+
+    /*!
+      cost value of the infeasible pair. the number of infeasible pairs is
+      minimized first, so the sum of all feasible costs must be smaller than
+      this value.
+    */
+    static constexpr double FORBIDDEN = 1.0e6;
+
+private:
+
+    static constexpr std::size_t N = MAX_SIZE + 1;
+
+    std::array< double, N * N > M_cost; //!< 1-indexed square cost matrix
+    std::array< double, N > M_u; //!< row potentials
+    std::array< double, N > M_v; //!< column potentials
+    std::array< double, N > M_min_v; //!< minimum reduced cost of each column
+    std::array< int, N > M_row_of; //!< matched row of each column. 0 means no row.
+    std::array< int, N > M_way; //!< previous column in the augmenting path
+    std::array< bool, N > M_used; //!< visited flag of each column
+
+public:
+
+    /*!
+      \brief solve the assignment problem.
+      \param rows the number of rows
+      \param cols the number of columns
+      \param cost row-major cost matrix (rows x cols). FORBIDDEN or more means infeasible.
+      \param row_to_col result array (size = rows). the matched column index,
+      or -1 if the row is not matched to any feasible column.
+      \return false if the problem size exceeds MAX_SIZE.
+    */
+    bool solve( const std::size_t rows,
+                const std::size_t cols,
+                const double * cost,
+                int * row_to_col );
+};
+
+}
+
+#endif
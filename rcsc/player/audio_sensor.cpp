@@ -39,6 +39,8 @@
 #include <rcsc/common/logger.h>
 #include <rcsc/math_util.h>
 
+#include <algorithm>
+#include <string_view>
 #include <cstdio>
 #include <cstring>
 
@@ -55,6 +57,9 @@ AudioSensor::AudioSensor()
       M_trainer_message_time( -1, 0 ),
       M_clang_time( -1, 0 )
 {
+    std::fill( M_say_message_parser_table, M_say_message_parser_table + 256,
+               static_cast< SayMessageParser * >( nullptr ) );
+
     M_freeform_message.reserve( 256 );
     M_clang_message.reserve( 8192 );
 }
@@ -86,6 +91,7 @@ AudioSensor::addSayMessageParser( SayMessageParser::Ptr parser )
 
     M_say_message_parsers.insert( ParserMap::value_type( parser->header(),
                                                          parser ) );
+    M_say_message_parser_table[static_cast< unsigned char >( parser->header() )] = parser.get();
 }
 
 /*-------------------------------------------------------------------*/
@@ -105,6 +111,7 @@ AudioSensor::removeSayMessageParser( const char header )
     }
 
     M_say_message_parsers.erase( it );
+    M_say_message_parser_table[static_cast< unsigned char >( header )] = nullptr;
 }
 
 /*-------------------------------------------------------------------*/
@@ -402,33 +409,26 @@ AudioSensor::parseTeammateMessage( const HearMessage & message )
         return;
     }
 
-    const ParserMap::iterator end = M_say_message_parsers.end();
-
-    const char * msg = message.str_.c_str();
+    std::string_view cursor( message.str_ );
 
-    while ( *msg != '\0' )
+    while ( ! cursor.empty() )
     {
-        const char tag = *msg;
+        SayMessageParser * parser
+            = M_say_message_parser_table[static_cast< unsigned char >( cursor.front() )];
 
-        ParserMap::iterator it = M_say_message_parsers.find( tag );
-
-        if ( it == end )
+        if ( ! parser )
         {
             dlog.addText( Logger::SENSOR,
                           __FILE__" (parseTeammateMessage) unsupported message [%s] in [%s]",
-                          msg, message.str_.c_str() );
+                          cursor.data(), message.str_.c_str() );
             return;
         }
 
-        int len = it->second->parse( message.unum_, message.dir_, msg,
-                                     M_teammate_message_time );
-
-        if ( len < 0 )
+        if ( parser->consume( message.unum_, message.dir_, cursor,
+                              M_teammate_message_time ) <= 0 )
         {
             return;
         }
-
-        msg += len;
     }
 }
 
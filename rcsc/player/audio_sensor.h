@@ -63,6 +63,9 @@ private:
     //! player message parsers
     ParserMap M_say_message_parsers;
 
+    //! dispatch table indexed by the header character. refers to the parsers in M_say_message_parsers.
+    SayMessageParser * M_say_message_parser_table[256];
+
     //! freeform message parsers
     FreeformParserMap M_freeform_parsers;
 
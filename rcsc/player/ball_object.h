@@ -37,8 +37,7 @@
 #include <rcsc/game_time.h>
 #include <rcsc/soccer_math.h>
 #include <rcsc/math_util.h>
-
-#include <list>
+#include <rcsc/util/ring_buffer.h>
 
 namespace rcsc {
 
@@ -100,7 +99,7 @@ private:
     AngleDeg M_angle_from_self; //!< estimated global angle from self
 
 
-    std::list< Vector2D > M_pos_history;
+    RingBuffer< Vector2D, 100 > M_pos_history; //!< estimated positions in the previous cycles
 
     // not used
     BallObject( const BallObject & ball ) = delete;
@@ -289,7 +288,7 @@ public:
       \brief get the history of estimated position.
       \return position list. the front element is the position at the previous cycle.
      */
-    const std::list< Vector2D > & posHistory() const
+    const RingBuffer< Vector2D, 100 > & posHistory() const
       {
           return M_pos_history;
       }
@@ -48,7 +48,9 @@ namespace rcsc {
  */
 BallState::BallState()
     : M_pos( 0.0, 0.0 ),
-      M_vel( 0.0, 0.0 )
+      M_vel( 0.0, 0.0 ),
+      M_pos_count( 1000 ),
+      M_vel_count( 1000 )
 {
 
 }
@@ -61,7 +63,9 @@ void
 BallState::update( const BallObject & b )
 {
     M_pos = b.pos();
-    M_vel = b.vel();;
+    M_vel = b.vel();
+    M_pos_count = b.posCount();
+    M_vel_count = b.velCount();
 }
 
 /*-------------------------------------------------------------------*/
@@ -47,9 +47,8 @@ private:
 
     Vector2D M_pos; //!< estimated global position
     Vector2D M_vel; //!< estimated velocity
-
-    // not used
-    BallState( const BallState & ) = delete;
+    int M_pos_count; //!< position accuracy count
+    int M_vel_count; //!< velocity accuracy count
 
 public:
     /*!
@@ -63,6 +62,18 @@ public:
      */
     void update( const BallObject & b );
 
+    /*!
+      \brief set the estimated state
+      \param pos global position
+      \param vel velocity
+     */
+    void setState( const Vector2D & pos,
+                   const Vector2D & vel )
+      {
+          M_pos = pos;
+          M_vel = vel;
+      }
+
     /*!
       \brief get Vector2D valur as the global position
       \return const reference to the Vector2D instance
@@ -81,6 +92,24 @@ public:
           return M_vel;
       }
 
+    /*!
+      \brief get the position accuracy count
+      \return count since the last observation
+    */
+    int posCount() const
+      {
+          return M_pos_count;
+      }
+
+    /*!
+      \brief get the velocity accuracy count
+      \return count since the last observation
+    */
+    int velCount() const
+      {
+          return M_vel_count;
+      }
+
     /*!
       \brief estimate the vector of ball movement.
       \param step calculated step
@@ -36,12 +36,162 @@
 #include "body_sensor.h"
 
 #include <string>
+#include <string_view>
+#include <charconv>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 
 namespace rcsc {
 
+namespace {
+
+/*-------------------------------------------------------------------*/
+inline
+const char *
+skip_space( const char * buf,
+            const char * end )
+{
+    while ( buf < end && *buf == ' ' ) ++buf;
+    return buf;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief skip the white spaces and the prefix string
+  \return pointer to the next character of the prefix. NULL if not matched.
+ */
+inline
+const char *
+skip_prefix( const char * buf,
+             const char * end,
+             const std::string_view prefix )
+{
+    buf = skip_space( buf, end );
+    if ( static_cast< std::size_t >( end - buf ) < prefix.size()
+         || std::memcmp( buf, prefix.data(), prefix.size() ) != 0 )
+    {
+        return nullptr;
+    }
+    return buf + prefix.size();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read an integer value after the white spaces like strtol().
+  \return true if a value is read. *buf is moved to the next character.
+ */
+inline
+bool
+read_int( const char ** buf,
+          const char * end,
+          int * value )
+{
+    const char * first = skip_space( *buf, end );
+    if ( first < end && *first == '+' ) ++first;
+
+    const std::from_chars_result r = std::from_chars( first, end, *value );
+    if ( r.ec != std::errc() )
+    {
+        return false;
+    }
+
+    *buf = r.ptr;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read a floating point value after the white spaces like strtod().
+  \return true if a value is read. *buf is moved to the next character.
+ */
+inline
+bool
+read_double( const char ** buf,
+             const char * end,
+             double * value )
+{
+    const char * first = skip_space( *buf, end );
+    if ( first < end && *first == '+' ) ++first;
+
+    const std::from_chars_result r = std::from_chars( first, end, *value );
+    if ( r.ec != std::errc() )
+    {
+        return false;
+    }
+
+    *buf = r.ptr;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read the element "<prefix><int>)", e.g. "(kick 10)".
+  \return true if the element is read. *buf is moved to the next character.
+ */
+inline
+bool
+read_int_element( const char ** buf,
+                  const char * end,
+                  const std::string_view prefix,
+                  int * value )
+{
+    const char * p = skip_prefix( *buf, end, prefix );
+    if ( ! p
+         || ! read_int( &p, end, value ) )
+    {
+        return false;
+    }
+
+    p = skip_prefix( p, end, ")" );
+    if ( ! p )
+    {
+        return false;
+    }
+
+    *buf = p;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read the element "<prefix><real> ... <real>)", e.g. "(speed 0.1 -20)".
+  \return true if the element is read. *buf is moved to the next character.
+ */
+inline
+bool
+read_double_element( const char ** buf,
+                     const char * end,
+                     const std::string_view prefix,
+                     double * values,
+                     const int n )
+{
+    const char * p = skip_prefix( *buf, end, prefix );
+    if ( ! p )
+    {
+        return false;
+    }
+
+    for ( int i = 0; i < n; ++i )
+    {
+        if ( ! read_double( &p, end, &values[i] ) )
+        {
+            return false;
+        }
+    }
+
+    p = skip_prefix( p, end, ")" );
+    if ( ! p )
+    {
+        return false;
+    }
+
+    *buf = p;
+    return true;
+}
+
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -139,16 +289,293 @@ BodySensor::parse( const char * msg,
     // ver. 18
     // (sense_body 66 (view_mode high normal) (stamina 3503.4 1 124000) (speed 0.06 -79)
     //  (head_angle 89) (kick 4) (dash 20) (turn 24) (say 0) (turn_neck 28) (catch 0)
-    //  (move 1) (change_view 16) (arm (movable 0) (expires 0) (target 0 0) (count 0))
+    //  (move 1) (change_view 16) (change_focus 0)
+    //  (arm (movable 0) (expires 0) (target 0 0) (count 0))
     //  (focus (target none) (count 0)) (tackle (expires 0) (count 0))
     //  (collision {none|[(ball)][player][post]})
     //  (foul (charged 0) (card {none|yellow|red})
     //  (focus_point 0 0))
 
-    //char ss[8];
-
     M_time = current;
 
+    const char * end = msg + std::strlen( msg );
+
+    if ( version >= 18.0
+         && parseFixedOrder( msg, end ) )
+    {
+        return;
+    }
+
+    parseGeneric( msg, end, version );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+BodySensor::parseFixedOrder( const char * msg,
+                             const char * end )
+{
+    const char * p = skip_prefix( msg, end, "(sense_body " );
+    int sense_time = 0;
+    if ( ! p
+         || ! read_int( &p, end, &sense_time ) )
+    {
+        return false;
+    }
+
+    //
+    // (view_mode {high|low} {narrow|normal|wide})
+    //
+    p = skip_prefix( p, end, "(view_mode " );
+    if ( ! p )
+    {
+        return false;
+    }
+
+    if ( const char * q = skip_prefix( p, end, "high " ) )
+    {
+        M_view_quality = ViewQuality::HIGH;
+        p = q;
+    }
+    else if ( const char * q = skip_prefix( p, end, "low " ) )
+    {
+        M_view_quality = ViewQuality::LOW;
+        p = q;
+    }
+    else
+    {
+        return false;
+    }
+
+    if ( const char * q = skip_prefix( p, end, "normal)" ) )
+    {
+        M_view_width = ViewWidth::NORMAL;
+        p = q;
+    }
+    else if ( const char * q = skip_prefix( p, end, "narrow)" ) )
+    {
+        M_view_width = ViewWidth::NARROW;
+        p = q;
+    }
+    else if ( const char * q = skip_prefix( p, end, "wide)" ) )
+    {
+        M_view_width = ViewWidth::WIDE;
+        p = q;
+    }
+    else
+    {
+        return false;
+    }
+
+    //
+    // (stamina <STAMINA> <EFFORT> <CAPACITY>) (speed <MAG> <DIR>) (head_angle <DIR>)
+    //
+    double stamina[3];
+    double speed[2];
+    if ( ! read_double_element( &p, end, "(stamina ", stamina, 3 )
+         || ! read_double_element( &p, end, "(speed ", speed, 2 )
+         || ! read_double_element( &p, end, "(head_angle ", &M_neck_relative, 1 ) )
+    {
+        return false;
+    }
+
+    M_stamina = stamina[0];
+    M_effort = stamina[1];
+    M_stamina_capacity = stamina[2];
+    M_speed_mag = speed[0];
+    M_speed_dir_relative = speed[1];
+
+    //
+    // command counts
+    //
+    if ( ! read_int_element( &p, end, "(kick ", &M_kick_count )
+         || ! read_int_element( &p, end, "(dash ", &M_dash_count )
+         || ! read_int_element( &p, end, "(turn ", &M_turn_count )
+         || ! read_int_element( &p, end, "(say ", &M_say_count )
+         || ! read_int_element( &p, end, "(turn_neck ", &M_turn_neck_count )
+         || ! read_int_element( &p, end, "(catch ", &M_catch_count )
+         || ! read_int_element( &p, end, "(move ", &M_move_count )
+         || ! read_int_element( &p, end, "(change_view ", &M_change_view_count )
+         || ! read_int_element( &p, end, "(change_focus ", &M_change_focus_count ) )
+    {
+        return false;
+    }
+
+    //
+    // (arm (movable <MOVABLE>) (expires <EXPIRES>) (target <DIST> <DIR>) (count <COUNT>))
+    //
+    double pointto[2];
+    p = skip_prefix( p, end, "(arm" );
+    if ( ! p
+         || ! read_int_element( &p, end, "(movable ", &M_arm_movable )
+         || ! read_int_element( &p, end, "(expires ", &M_arm_expires )
+         || ! read_double_element( &p, end, "(target ", pointto, 2 )
+         || ! read_int_element( &p, end, "(count ", &M_pointto_count )
+         || ! ( p = skip_prefix( p, end, ")" ) ) )
+    {
+        return false;
+    }
+
+    M_pointto_dist = pointto[0];
+    M_pointto_dir = pointto[1];
+
+    //
+    // (focus (target {none|l <UNUM>|r <UNUM>}) (count <COUNT>))
+    //
+    p = skip_prefix( p, end, "(focus (target " );
+    if ( ! p )
+    {
+        return false;
+    }
+
+    if ( const char * q = skip_prefix( p, end, "none)" ) )
+    {
+        M_attentionto_side = NEUTRAL;
+        M_attentionto_unum = Unum_Unknown;
+        p = q;
+    }
+    else if ( *p == 'l' || *p == 'r' )
+    {
+        M_attentionto_side = ( *p == 'l' ? LEFT : RIGHT );
+        ++p;
+        if ( ! read_int( &p, end, &M_attentionto_unum )
+             || ! ( p = skip_prefix( p, end, ")" ) ) )
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+
+    if ( ! read_int_element( &p, end, "(count ", &M_attentionto_count )
+         || ! ( p = skip_prefix( p, end, ")" ) ) )
+    {
+        return false;
+    }
+
+    //
+    // (tackle (expires <EXPIRES>) (count <COUNT>))
+    //
+    p = skip_prefix( p, end, "(tackle" );
+    if ( ! p
+         || ! read_int_element( &p, end, "(expires ", &M_tackle_expires )
+         || ! read_int_element( &p, end, "(count ", &M_tackle_count )
+         || ! ( p = skip_prefix( p, end, ")" ) ) )
+    {
+        return false;
+    }
+
+    //
+    // (collision {none|[(ball)][(player)][(post)]})
+    //
+    p = skip_prefix( p, end, "(collision " );
+    if ( ! p )
+    {
+        return false;
+    }
+
+    M_none_collided = false;
+    M_ball_collided = false;
+    M_player_collided = false;
+    M_post_collided = false;
+
+    if ( const char * q = skip_prefix( p, end, "none)" ) )
+    {
+        M_none_collided = true;
+        p = q;
+    }
+    else
+    {
+        while ( true )
+        {
+            if ( const char * q = skip_prefix( p, end, "(ball)" ) )
+            {
+                M_ball_collided = true;
+                p = q;
+            }
+            else if ( const char * q = skip_prefix( p, end, "(player)" ) )
+            {
+                M_player_collided = true;
+                p = q;
+            }
+            else if ( const char * q = skip_prefix( p, end, "(post)" ) )
+            {
+                M_post_collided = true;
+                p = q;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        p = skip_prefix( p, end, ")" );
+        if ( ! p )
+        {
+            return false;
+        }
+    }
+
+    //
+    // (foul (charged <CYCLES>) (card {none|yellow|red}))
+    //
+    p = skip_prefix( p, end, "(foul" );
+    if ( ! p
+         || ! read_int_element( &p, end, "(charged ", &M_charged_expires ) )
+    {
+        return false;
+    }
+
+    if ( const char * q = skip_prefix( p, end, "(card none))" ) )
+    {
+        M_card = NO_CARD;
+        p = q;
+    }
+    else if ( const char * q = skip_prefix( p, end, "(card yellow))" ) )
+    {
+        M_card = YELLOW;
+        p = q;
+    }
+    else if ( const char * q = skip_prefix( p, end, "(card red))" ) )
+    {
+        M_card = RED;
+        p = q;
+    }
+    else
+    {
+        return false;
+    }
+
+    //
+    // (focus_point <DIST> <DIR>))
+    //
+    double focus_point[2];
+    if ( ! read_double_element( &p, end, "(focus_point ", focus_point, 2 ) )
+    {
+        return false;
+    }
+
+    M_focus_dist = focus_point[0];
+    M_focus_dir = focus_point[1];
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+BodySensor::parseGeneric( const char * msg,
+                          const char * end,
+                          const double & version )
+{
+    //char ss[8];
+
     ++msg; // skip first paren
     while ( *msg != '\0' && *msg != '(' ) ++msg; // skip "sense_body <time> "
 
@@ -191,56 +618,49 @@ BodySensor::parse( const char * msg,
     // read stamina values
     while ( *msg != '\0' && *msg != '(' ) ++msg;
     while ( *msg != '\0' && *msg != ' ' ) ++msg; // skip "(stamina"
-    M_stamina = std::strtod( msg, &next ); msg = next;
-    M_effort = std::strtod( msg, &next ); msg = next;
+    read_double( &msg, end, &M_stamina );
+    read_double( &msg, end, &M_effort );
     if ( version >= 13.0 )
     {
         if ( *msg != ')' )
         {
-            M_stamina_capacity = std::strtod( msg, &next ); msg = next;
+            read_double( &msg, end, &M_stamina_capacity );
         }
     }
 
     // read speed values
     while ( *msg != '\0' && *msg != '(' ) ++msg;
     while ( *msg != '\0' && *msg != ' ' ) ++msg; // skip "(speed"
-    M_speed_mag = std::strtod( msg, &next );
-    msg = next; // this value is quantized by 0.01
+    read_double( &msg, end, &M_speed_mag ); // this value is quantized by 0.01
     if ( version >= 6.0 )
     {
         // Sensed speed_dir is the velocity dir relative to player's face angle
         // global_vel_dir = (sensed_speed_dir + my_global_neck_angle)
-        M_speed_dir_relative = std::strtod( msg, &next );
-        msg = next;
+        read_double( &msg, end, &M_speed_dir_relative );
     }
 
     if ( version >= 5.0 )
     {
         while ( *msg != '(' ) ++msg;
         while ( *msg != ' ' ) ++msg; // skip "(head_angle"
-        M_neck_relative = std::strtod( msg, &next );
-        msg = next;
+        read_double( &msg, end, &M_neck_relative );
     }
 
     while ( *msg != '\0' && *msg != '(' ) ++msg;
     while ( *msg != '\0' && *msg != ' ' ) ++msg; // skip "(kick"
-    M_kick_count = static_cast< int >( std::strtol( msg, &next, 10 ) );
-    msg = next;
+    read_int( &msg, end, &M_kick_count );
 
     while ( *msg != '\0' && *msg != '(' ) ++msg;
     while ( *msg != '\0' && *msg != ' ' ) ++msg; // skip "(dash"
-    M_dash_count = static_cast< int >( std::strtol( msg, &next, 10 ) );
-    msg = next;
+    read_int( &msg, end, &M_dash_count );
 
     while ( *msg != '\0' && *msg != '(' ) ++msg;
     while ( *msg != '\0' && *msg != ' ' ) ++msg; // skip "(turn"
-    M_turn_count = static_cast< int >( std::strtol( msg, &next, 10 ) );
-    msg = next;
+    read_int( &msg, end, &M_turn_count );
 
     while ( *msg != '\0' && *msg != '(' ) ++msg;
     while ( *msg != '\0' && *msg != ' ' ) ++msg; // skip "(say"
-    M_say_count = static_cast< int >( std::strtol( msg, &next, 10 ) );
-    msg = next;
+    read_int( &msg, end, &M_say_count );
 
     if ( version < 5.0 )
     {
@@ -249,8 +669,7 @@ BodySensor::parse( const char * msg,
 
     while ( *msg != '\0' && *msg != '(' ) ++msg;
     while ( *msg != '\0' && *msg != ' ' ) ++msg; // skip "(turn_neck"
-    M_turn_neck_count = static_cast< int >( std::strtol( msg, &next, 10 ) );
-    msg = next;
+    read_int( &msg, end, &M_turn_neck_count );
 
     if ( version < 7.0 )
     {
@@ -259,25 +678,21 @@ BodySensor::parse( const char * msg,
 
     while ( *msg != '\0' && *msg != '(' ) ++msg;
     while ( *msg != '\0' && *msg != ' ' ) ++msg; // skip "(catch"
-    M_catch_count = static_cast< int >( std::strtol( msg, &next, 10 ) );
-    msg = next;
+    read_int( &msg, end, &M_catch_count );
 
     while ( *msg != '\0' && *msg != '(' ) ++msg;
     while ( *msg != '\0' && *msg != ' ' ) ++msg; // skip "(move"
-    M_move_count  = static_cast< int >( std::strtol( msg, &next, 10 ) );
-    msg = next;
+    read_int( &msg, end, &M_move_count );
 
     while ( *msg != '\0' && *msg != '(' ) ++msg;
     while ( *msg != '\0' && *msg != ' ' ) ++msg; // skip "(chage_view"
-    M_change_view_count = static_cast< int >( std::strtol( msg, &next, 10 ) );
-    msg = next;
+    read_int( &msg, end, &M_change_view_count );
 
     if ( version >= 18.0 )
     {
         while ( *msg != '\0' && *msg != '(' ) ++msg;
         while ( *msg != '\0' && *msg != ' ' ) ++msg; // skip "(change_focus"
-        M_change_focus_count = static_cast< int >( std::strtol( msg, &next, 10 ) );
-        msg = next;
+        read_int( &msg, end, &M_change_focus_count );
     }
 
     if ( version < 8.0 )
@@ -578,7 +993,7 @@ BodySensor::parseAttentionto( const char * msg,
     }
 
     msg += 7;
-    if ( std::sscanf( msg, " ( target %7[^)] %d ) %n", side, &unum, &n_read ) != 2
+    if ( std::sscanf( msg, " ( target %7[^ )] %d ) %n", side, &unum, &n_read ) != 2
          && std::sscanf( msg, " ( target %7[^)] ) %n", side, &n_read ) != 1 )
     {
         std::cerr << "ERROR: " << M_time
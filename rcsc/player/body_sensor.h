@@ -134,6 +134,26 @@ public:
 
 private:
 
+    /*!
+      \brief analyze the sense_body message of the current protocol (v18+)
+      in a single forward pass. all elements must appear in the fixed order.
+      \param msg raw server message
+      \param end end of the message
+      \return false if the message has an unexpected element order.
+     */
+    bool parseFixedOrder( const char * msg,
+                          const char * end );
+
+    /*!
+      \brief analyze the sense_body message of any protocol version.
+      \param msg raw server message
+      \param end end of the message
+      \param version client version
+     */
+    void parseGeneric( const char * msg,
+                       const char * end,
+                       const double & version );
+
     /*!
       \brief analyze arm information in the sense_body message.
       \param msg server message started with (arm
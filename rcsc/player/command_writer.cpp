@@ -0,0 +1,103 @@
+// -*-c++-*-
+
+/*!
+  \file command_writer.cpp
+  \brief fixed buffer command string writer Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "command_writer.h"
+
+#include <charconv>
+#include <cstring>
+
+namespace rcsc {
+
+constexpr std::size_t CommandWriter::CAPACITY;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CommandWriter &
+CommandWriter::put( const char * str )
+{
+    return write( str, std::strlen( str ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CommandWriter &
+CommandWriter::put( const int value )
+{
+    char buf[16];
+    const std::to_chars_result r = std::to_chars( buf, buf + sizeof( buf ), value );
+    return write( buf, r.ptr - buf );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CommandWriter &
+CommandWriter::put( const double value )
+{
+    // the same notation as the default std::ostream formatting
+    char buf[32];
+    const std::to_chars_result r = std::to_chars( buf, buf + sizeof( buf ), value,
+                                                  std::chars_format::general, 6 );
+    return write( buf, r.ptr - buf );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CommandWriter &
+CommandWriter::write( const char * str,
+                      const std::size_t len )
+{
+    std::size_t n = len;
+    if ( M_size + n >= CAPACITY )
+    {
+        n = CAPACITY - 1 - M_size;
+        M_overflow = true;
+    }
+
+    std::memcpy( M_buf + M_size, str, n );
+    M_size += n;
+    M_buf[M_size] = '\0';
+
+    return *this;
+}
+
+}
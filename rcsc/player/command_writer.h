@@ -0,0 +1,187 @@
+// -*-c++-*-
+
+/*!
+  \file command_writer.h
+  \brief fixed buffer command string writer Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_PLAYER_COMMAND_WRITER_H
+#define RCSC_PLAYER_COMMAND_WRITER_H
+
+#include <string>
+#include <cstddef>
+
+namespace rcsc {
+
+/*!
+  \class CommandWriter
+  \brief formats the command string directly into a fixed size buffer.
+
+  Floating point values are formatted by std::to_chars with the same
+  notation as the default std::ostream formatting (%g, precision 6),
+  so the result is identical to PlayerCommand::toCommandString( std::ostream & ).
+  Nothing is allocated while writing. If the buffer becomes full, the rest
+  of the output is discarded and overflow() returns true.
+*/
+class CommandWriter {
+public:
+
+    //! buffer capacity including the terminating null character
+    static constexpr std::size_t CAPACITY = 8192;
+
+private:
+
+    char M_buf[CAPACITY]; //!< output buffer. always null terminated.
+    std::size_t M_size; //!< current string length
+    bool M_overflow; //!< true if some characters were discarded
+
+    // not used
+    CommandWriter( const CommandWriter & ) = delete;
+    CommandWriter & operator=( const CommandWriter & ) = delete;
+
+public:
+
+    /*!
+      \brief create an empty writer
+    */
+    CommandWriter()
+        : M_size( 0 ),
+          M_overflow( false )
+      {
+          M_buf[0] = '\0';
+      }
+
+    /*!
+      \brief remove the written string
+    */
+    void clear()
+      {
+          M_size = 0;
+          M_overflow = false;
+          M_buf[0] = '\0';
+      }
+
+    /*!
+      \brief get the written string
+      \return null terminated string
+    */
+    const char * c_str() const
+      {
+          return M_buf;
+      }
+
+    /*!
+      \brief get the length of the written string
+      \return string length
+    */
+    std::size_t size() const
+      {
+          return M_size;
+      }
+
+    /*!
+      \brief check if the writer is empty
+      \return true if nothing is written
+    */
+    bool empty() const
+      {
+          return M_size == 0;
+      }
+
+    /*!
+      \brief check if some characters were discarded
+      \return true if the buffer became full
+    */
+    bool overflow() const
+      {
+          return M_overflow;
+      }
+
+    /*!
+      \brief append a character
+      \param c character
+      \return reference to itself
+    */
+    CommandWriter & put( const char c )
+      {
+          if ( M_size + 1 < CAPACITY )
+          {
+              M_buf[M_size++] = c;
+              M_buf[M_size] = '\0';
+          }
+          else
+          {
+              M_overflow = true;
+          }
+          return *this;
+      }
+
+    /*!
+      \brief append a null terminated string
+      \param str string
+      \return reference to itself
+    */
+    CommandWriter & put( const char * str );
+
+    /*!
+      \brief append a string
+      \param str string
+      \return reference to itself
+    */
+    CommandWriter & put( const std::string & str )
+      {
+          return write( str.data(), str.length() );
+      }
+
+    /*!
+      \brief append an integer value
+      \param value integer value
+      \return reference to itself
+    */
+    CommandWriter & put( const int value );
+
+    /*!
+      \brief append a floating point value in the std::ostream default notation
+      \param value floating point value
+      \return reference to itself
+    */
+    CommandWriter & put( const double value );
+
+    /*!
+      \brief append the character sequence
+      \param str pointer to the first character
+      \param len the number of characters
+      \return reference to itself
+    */
+    CommandWriter & write( const char * str,
+                           const std::size_t len );
+
+};
+
+}
+
+#endif
@@ -42,6 +42,8 @@
 #include "say_message_builder.h"
 
 #include <rcsc/common/audio_memory.h>
+#include <rcsc/common/debug_grid.h>
+#include <rcsc/gz/gzcompressor.h>
 #include <rcsc/net/udp_socket.h>
 
 #include <algorithm>
@@ -56,6 +58,8 @@
 
 namespace rcsc {
 
+const int DebugClient::DEFAULT_KEYFRAME_INTERVAL;
+
 // accessible only from this file
 namespace {
 
@@ -116,6 +120,26 @@ struct TriangleT {
       { }
 };
 
+/*!
+  \struct GridT
+  \brief draw info
+*/
+struct GridT {
+    Rect2D area_; //!< covered area
+    std::string payload_; //!< encoded grid
+
+    /*!
+      \brief construct with values
+      \param area covered area
+      \param payload encoded grid
+    */
+    GridT( const Rect2D & area,
+           std::string && payload )
+        : area_( area ),
+          payload_( std::move( payload ) )
+      { }
+};
+
 /*!
   \struct RectangleT
   \brief draw info
@@ -388,6 +412,143 @@ public:
       }
 };
 
+class GridPrinter {
+private:
+    std::ostream & M_os;
+public:
+    GridPrinter( std::ostream & os )
+        : M_os( os )
+      { }
+    void operator()( const GridT & grid )
+      {
+          M_os << " (grid "
+               << ROUND( grid.area_.left(), 0.001 ) << ' '
+               << ROUND( grid.area_.top(), 0.001 ) << ' '
+               << ROUND( grid.area_.right(), 0.001 ) << ' '
+               << ROUND( grid.area_.bottom(), 0.001 ) << ' '
+               << grid.payload_
+               << ')';
+      }
+};
+
+/*-------------------------------------------------------------------*/
+
+/*!
+  \class StringOutputBuffer
+  \brief stream buffer that appends the output to a reusable string
+*/
+class StringOutputBuffer
+    : public std::streambuf {
+private:
+    std::string * M_str;
+public:
+    StringOutputBuffer( std::string * str )
+        : M_str( str )
+      { }
+
+    void setString( std::string * str )
+      {
+          M_str = str;
+      }
+
+protected:
+    int_type overflow( int_type c ) override
+      {
+          if ( c != traits_type::eof() )
+          {
+              M_str->push_back( static_cast< char >( c ) );
+          }
+          return c;
+      }
+
+    std::streamsize xsputn( const char * s,
+                            std::streamsize n ) override
+      {
+          M_str->append( s, n );
+          return n;
+      }
+};
+
+/*-------------------------------------------------------------------*/
+
+/*!
+  \enum ItemKind
+  \brief kind of the message item. used as the upper bits of the item key.
+*/
+enum ItemKind {
+    ITEM_SELF = 1,
+    ITEM_BALL,
+    ITEM_TEAMMATE,
+    ITEM_OPPONENT,
+    ITEM_UNKNOWN_PLAYER,
+    ITEM_SAY,
+    ITEM_HEAR,
+    ITEM_TARGET_TEAMMATE,
+    ITEM_TARGET_POINT,
+    ITEM_MESSAGE,
+    ITEM_LINE,
+    ITEM_TRIANGLE,
+    ITEM_RECT,
+    ITEM_CIRCLE,
+    ITEM_GRID,
+};
+
+/*!
+  \struct ItemT
+  \brief position of one item in the frame buffer
+*/
+struct ItemT {
+    std::uint32_t key_; //!< kind << 16 | index
+    std::uint32_t begin_; //!< the first position in the frame buffer
+    std::uint32_t size_; //!< the byte length of the item
+
+    bool operator<( const ItemT & rhs ) const
+      {
+          return key_ < rhs.key_;
+      }
+};
+
+inline
+std::uint32_t
+item_key( const ItemKind kind,
+          const int index )
+{
+    return ( static_cast< std::uint32_t >( kind ) << 16 ) | static_cast< std::uint32_t >( index & 0xffff );
+}
+
+/*!
+  \brief append the text representation of the item key
+  \param key item key
+  \param out output buffer
+ */
+void
+append_key( const std::uint32_t key,
+            std::string & out )
+{
+    static const char * const names[] = {
+        "", "s", "b", "t", "o", "u", "say", "hear", "tt", "tp", "msg",
+        "l", "tri", "r", "c", "g",
+    };
+
+    const std::uint32_t kind = key >> 16;
+    const int index = static_cast< int >( key & 0xffff );
+
+    if ( kind < sizeof( names ) / sizeof( names[0] ) )
+    {
+        out += names[kind];
+    }
+
+    if ( kind == ITEM_TEAMMATE
+         || kind == ITEM_OPPONENT
+         || kind == ITEM_UNKNOWN_PLAYER
+         || kind >= ITEM_LINE )
+    {
+        char buf[8];
+        const int n = std::snprintf( buf, sizeof( buf ), "%d", index );
+        out.append( buf, n );
+    }
+}
+
 } // end of noname namespace
 
 /*-------------------------------------------------------------------*/
@@ -401,7 +562,84 @@ struct DebugClient::Impl {
     std::vector< TriangleT > M_triangles; //!< draw info: triangles
     std::vector< RectangleT > M_rectangles; //!< draw info: rectangles
     std::vector< CircleT > M_circles; //!< circles
+    std::vector< GridT > M_grids; //!< draw info: value grids
+
+    std::string M_frame; //!< all items of the current frame
+    std::vector< ItemT > M_items; //!< item positions in M_frame
+
+    std::string M_prev_frame; //!< all items of the previous frame
+    std::vector< ItemT > M_prev_items; //!< item positions in M_prev_frame, sorted by key
+    bool M_prev_valid; //!< true if the previous frame can be used as the delta base
+    std::string M_keep; //!< keys of the unchanged items
+
+    StringOutputBuffer M_frame_buf; //!< stream buffer over M_frame
+    std::ostream M_os; //!< item output stream
+
+    std::unique_ptr< GZCompressor > M_compressor; //!< datagram compressor
+    std::string M_compressed; //!< compressed datagram
+
+    Impl()
+        : M_prev_valid( false ),
+          M_frame_buf( &M_frame ),
+          M_os( &M_frame_buf )
+      {
+          M_frame.reserve( G_BUFFER_SIZE );
+          M_prev_frame.reserve( G_BUFFER_SIZE );
+          M_items.reserve( 256 );
+          M_prev_items.reserve( 256 );
+          M_keep.reserve( 1024 );
+      }
 
+    /*!
+      \brief register the item written after the position begin
+     */
+    void addItem( const ItemKind kind,
+                  const int index,
+                  const std::size_t begin )
+      {
+          M_items.push_back( ItemT{ item_key( kind, index ),
+                                    static_cast< std::uint32_t >( begin ),
+                                    static_cast< std::uint32_t >( M_frame.size() - begin ) } );
+      }
+
+    /*!
+      \brief find the item in the previous frame
+      \return pointer to the item. nullptr if not found.
+     */
+    const ItemT * findPrevItem( const std::uint32_t key ) const
+      {
+          const ItemT value{ key, 0, 0 };
+          std::vector< ItemT >::const_iterator it = std::lower_bound( M_prev_items.begin(),
+                                                                      M_prev_items.end(),
+                                                                      value );
+          if ( it != M_prev_items.end()
+               && it->key_ == key )
+          {
+              return &( *it );
+          }
+          return nullptr;
+      }
+
+    /*!
+      \brief store the current frame as the next delta base
+     */
+    void swapFrame()
+      {
+          std::swap( M_frame, M_prev_frame );
+          std::swap( M_items, M_prev_items );
+          M_frame.clear();
+          M_items.clear();
+
+          std::sort( M_prev_items.begin(), M_prev_items.end() );
+
+          // duplicated keys cannot be restored by the receiver.
+          M_prev_valid = ( std::adjacent_find( M_prev_items.begin(), M_prev_items.end(),
+                                               []( const ItemT & lhs, const ItemT & rhs )
+                                                 {
+                                                     return lhs.key_ == rhs.key_;
+                                                 } )
+                           == M_prev_items.end() );
+      }
 };
 
 /*-------------------------------------------------------------------*/
@@ -416,15 +654,21 @@ DebugClient::DebugClient()
       M_main_buffer( "" ),
       M_target_unum( Unum_Unknown ),
       M_target_point( Vector2D::INVALIDATED ),
-      M_message( "" )
+      M_message( "" ),
+      M_delta_mode( false ),
+      M_keyframe_interval( DEFAULT_KEYFRAME_INTERVAL ),
+      M_delta_count( 0 ),
+      M_compression_level( 0 ),
+      M_grid_compression_level( 0 )
 {
-    M_main_buffer.reserve( 8192 );
+    M_main_buffer.reserve( G_BUFFER_SIZE );
     M_message.reserve( 8192 );
 
     M_impl->M_lines.reserve( MAX_LINE );
     M_impl->M_triangles.reserve( MAX_TRIANGLE );
     M_impl->M_rectangles.reserve( MAX_RECT );
     M_impl->M_circles.reserve( MAX_CIRCLE );
+    M_impl->M_grids.reserve( MAX_GRID );
 }
 
 /*-------------------------------------------------------------------*/
@@ -528,6 +772,53 @@ DebugClient::writeAll( const WorldModel & world,
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+DebugClient::setDeltaMode( const bool on,
+                           const int keyframe_interval )
+{
+    M_delta_mode = on;
+    M_keyframe_interval = std::max( 1, keyframe_interval );
+    M_delta_count = 0;
+    M_impl->M_prev_valid = false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+DebugClient::setCompressionLevel( const int level )
+{
+    M_compression_level = std::min( 9, std::max( 0, level ) );
+
+    if ( M_compression_level == 0 )
+    {
+        M_impl->M_compressor.reset();
+    }
+    else if ( ! M_impl->M_compressor )
+    {
+        M_impl->M_compressor.reset( new GZCompressor( M_compression_level ) );
+    }
+    else
+    {
+        M_impl->M_compressor->setLevel( M_compression_level );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+DebugClient::setGridCompressionLevel( const int level )
+{
+    M_grid_compression_level = std::min( 9, std::max( 0, level ) );
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -561,18 +852,13 @@ void
 DebugClient::buildString( const WorldModel & world,
                           const ActionEffector & effector )
 {
-    std::ostringstream ostr;
+    Impl & impl = *M_impl;
+    std::string & frame = impl.M_frame;
+    std::ostream & ostr = impl.M_os;
 
-    ostr << "((debug (format-version 5)) (time "
-         << world.time().cycle() << ',';
-    if ( world.gameMode().type() == GameMode::BeforeKickOff )
-    {
-        ostr << "0)";
-    }
-    else
-    {
-        ostr << world.time().stopped() << ')';
-    }
+    frame.clear();
+    impl.M_items.clear();
+    std::size_t begin = 0;
 
     // self
     /*
@@ -590,6 +876,7 @@ DebugClient::buildString( const WorldModel & world,
     */
     if ( world.self().posValid() )
     {
+        begin = frame.size();
         ostr << " (s "
              << ( world.ourSide() == LEFT ? "l " : "r " )
              << world.self().unum() << ' '
@@ -612,11 +899,12 @@ DebugClient::buildString( const WorldModel & world,
         {
             ostr << "y";
         }
-        if ( ! M_impl->M_self_comment.empty() )
+        if ( ! impl.M_self_comment.empty() )
         {
-            ostr << '|' << M_impl->M_self_comment;
+            ostr << '|' << impl.M_self_comment;
         }
         ostr << "\"))";
+        impl.addItem( ITEM_SELF, 0, begin );
     }
 
     // ball
@@ -625,6 +913,7 @@ DebugClient::buildString( const WorldModel & world,
     */
     if ( world.ball().posValid() )
     {
+        begin = frame.size();
         ostr << " (b "
              << ROUND(world.ball().pos().x, 0.01) << ' '
              << ROUND(world.ball().pos().y, 0.01);
@@ -641,6 +930,7 @@ DebugClient::buildString( const WorldModel & world,
             //<< "(" << ROUND(world.ball().vel().x, 0.01)
             // << ", " << ROUND(world.ball().vel().y, 0.01) << ')'
              << "\"))";
+        impl.addItem( ITEM_BALL, 0, begin );
     }
 
     // players
@@ -654,69 +944,196 @@ DebugClient::buildString( const WorldModel & world,
       Otherwise PLAYER_NUMBER must not be specified.
       Body direction and comment is optional.
     */
-
-    std::for_each( world.teammates().begin(),
-                   world.teammates().end(),
-                   PlayerPtrPrinter( ostr, world.ourSide(), M_impl->M_comment_map ) );
-    std::for_each( world.opponents().begin(),
-                   world.opponents().end(),
-                   PlayerPtrPrinter( ostr, world.ourSide(), M_impl->M_comment_map ) );
+    {
+        PlayerPtrPrinter printer( ostr, world.ourSide(), impl.M_comment_map );
+        int unknown_index = 0;
+        for ( const PlayerObject::Cont * players : { &world.teammates(), &world.opponents() } )
+        {
+            for ( const PlayerObject * p : *players )
+            {
+                begin = frame.size();
+                printer( p );
+                if ( p->side() == NEUTRAL
+                     || p->unum() == Unum_Unknown )
+                {
+                    impl.addItem( ITEM_UNKNOWN_PLAYER, unknown_index++, begin );
+                }
+                else
+                {
+                    impl.addItem( ( p->side() == world.ourSide() ? ITEM_TEAMMATE : ITEM_OPPONENT ),
+                                  p->unum(), begin );
+                }
+            }
+        }
+    }
 
     // say message
     if ( ! effector.getSayMessage().empty() )
     {
+        begin = frame.size();
         ostr << " (say \"";
-        for ( const SayMessage::Ptr & i : effector.sayMessageCont() )
-        {
-            i->printDebug( ostr );
-        }
+        effector.printSayMessageDebug( ostr );
         ostr << " {" << effector.getSayMessage() << "}\")";
+        impl.addItem( ITEM_SAY, 0, begin );
     }
 
     // heard information
     if ( world.audioMemory().time() == world.time() )
     {
+        begin = frame.size();
         ostr << " (hear ";
         world.audioMemory().printDebug( ostr );
         ostr << ')';
+        impl.addItem( ITEM_HEAR, 0, begin );
     }
 
     // target number
     if ( M_target_unum != Unum_Unknown )
     {
+        begin = frame.size();
         ostr << " (target-teammate " << M_target_unum << ")";
+        impl.addItem( ITEM_TARGET_TEAMMATE, 0, begin );
     }
 
     // target point
     if ( M_target_point.isValid() )
     {
+        begin = frame.size();
         ostr << " (target-point "
              << M_target_point.x << " " << M_target_point.y
              << ")";
+        impl.addItem( ITEM_TARGET_POINT, 0, begin );
     }
 
     // message
     if ( ! M_message.empty() )
     {
+        begin = frame.size();
         ostr << " (message \"" << M_message << "\")";
+        impl.addItem( ITEM_MESSAGE, 0, begin );
     }
 
     // lines
-    std::for_each( M_impl->M_lines.begin(), M_impl->M_lines.end(),
-                   LinePrinter( ostr ) );
+    {
+        LinePrinter printer( ostr );
+        int index = 0;
+        for ( const LineT & v : impl.M_lines )
+        {
+            begin = frame.size();
+            printer( v );
+            impl.addItem( ITEM_LINE, index++, begin );
+        }
+    }
     // triangles
-    std::for_each( M_impl->M_triangles.begin(), M_impl->M_triangles.end(),
-                   TrianglePrinter( ostr ) );
+    {
+        TrianglePrinter printer( ostr );
+        int index = 0;
+        for ( const TriangleT & v : impl.M_triangles )
+        {
+            begin = frame.size();
+            printer( v );
+            impl.addItem( ITEM_TRIANGLE, index++, begin );
+        }
+    }
     // rectangles
-    std::for_each( M_impl->M_rectangles.begin(), M_impl->M_rectangles.end(),
-                   RectPrinter( ostr ) );
+    {
+        RectPrinter printer( ostr );
+        int index = 0;
+        for ( const RectangleT & v : impl.M_rectangles )
+        {
+            begin = frame.size();
+            printer( v );
+            impl.addItem( ITEM_RECT, index++, begin );
+        }
+    }
     // circles
-    std::for_each( M_impl->M_circles.begin(), M_impl->M_circles.end(),
-                   CirclePrinter( ostr ) );
+    {
+        CirclePrinter printer( ostr );
+        int index = 0;
+        for ( const CircleT & v : impl.M_circles )
+        {
+            begin = frame.size();
+            printer( v );
+            impl.addItem( ITEM_CIRCLE, index++, begin );
+        }
+    }
+    // grids
+    {
+        GridPrinter printer( ostr );
+        int index = 0;
+        for ( const GridT & v : impl.M_grids )
+        {
+            begin = frame.size();
+            printer( v );
+            impl.addItem( ITEM_GRID, index++, begin );
+        }
+    }
+
+    //
+    // create the message
+    //
+
+    const bool keyframe = ( ! M_delta_mode
+                            || ! impl.M_prev_valid
+                            || M_delta_count + 1 >= M_keyframe_interval );
 
-    ostr << ")";
+    char header[64];
+    const int header_len = std::snprintf( header, sizeof( header ),
+                                          "((debug (format-version 5)%s) (time %ld,%ld)",
+                                          ( keyframe ? "" : " (delta)" ),
+                                          world.time().cycle(),
+                                          ( world.gameMode().type() == GameMode::BeforeKickOff
+                                            ? 0L
+                                            : world.time().stopped() ) );
+
+    M_main_buffer.assign( header, header_len );
+
+    if ( keyframe )
+    {
+        M_main_buffer += frame;
+        M_delta_count = 0;
+    }
+    else
+    {
+        std::string & keep = impl.M_keep;
+        keep.clear();
+
+        for ( const ItemT & item : impl.M_items )
+        {
+            const ItemT * prev = impl.findPrevItem( item.key_ );
+            if ( prev
+                 && prev->size_ == item.size_
+                 && frame.compare( item.begin_, item.size_,
+                                   impl.M_prev_frame, prev->begin_, prev->size_ ) == 0 )
+            {
+                keep += ' ';
+                append_key( item.key_, keep );
+            }
+            else
+            {
+                M_main_buffer += " (d ";
+                append_key( item.key_, M_main_buffer );
+                M_main_buffer.append( frame, item.begin_, item.size_ );
+                M_main_buffer += ')';
+            }
+        }
 
-    M_main_buffer.assign( ostr.str() );
+        if ( ! keep.empty() )
+        {
+            M_main_buffer += " (keep";
+            M_main_buffer += keep;
+            M_main_buffer += ')';
+        }
+
+        ++M_delta_count;
+    }
+
+    M_main_buffer += ')';
+
+    if ( M_delta_mode )
+    {
+        impl.swapFrame();
+    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -729,8 +1146,20 @@ DebugClient::send()
     if ( M_connected
          && M_socket )
     {
-        if ( M_socket->writeDatagram( M_main_buffer.c_str(),
-                                      M_main_buffer.length() + 1 ) == -1 )
+        const char * msg = M_main_buffer.c_str();
+        std::size_t len = M_main_buffer.length() + 1;
+
+        if ( M_impl->M_compressor
+             && M_impl->M_compressor->compress( M_main_buffer.data(),
+                                                static_cast< int >( M_main_buffer.length() ),
+                                                M_impl->M_compressed ) >= 0
+             && ! M_impl->M_compressed.empty() )
+        {
+            msg = M_impl->M_compressed.data();
+            len = M_impl->M_compressed.length();
+        }
+
+        if ( M_socket->writeDatagram( msg, len ) == -1 )
         {
             std::cerr << "debug server send error" << std::endl;
         }
@@ -787,6 +1216,7 @@ DebugClient::clear()
     M_impl->M_triangles.clear();
     M_impl->M_rectangles.clear();
     M_impl->M_circles.clear();
+    M_impl->M_grids.clear();
 }
 
 /*-------------------------------------------------------------------*/
@@ -931,4 +1361,44 @@ DebugClient::addCircle( const Circle2D & circle,
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+DebugClient::addGrid( const Rect2D & area,
+                      const int cols,
+                      const int rows,
+                      const float * values,
+                      const double min_value,
+                      const double max_value )
+{
+    if ( M_on )
+    {
+        if ( M_impl->M_grids.size() < MAX_GRID )
+        {
+            addGrid( area, DebugGrid( cols, rows, values, min_value, max_value ) );
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+DebugClient::addGrid( const Rect2D & area,
+                      const DebugGrid & grid )
+{
+    if ( M_on )
+    {
+        if ( M_impl->M_grids.size() < MAX_GRID )
+        {
+            std::string payload;
+            grid.encode( M_grid_compression_level, &payload );
+            M_impl->M_grids.emplace_back( area, std::move( payload ) );
+        }
+    }
+}
+
 }
@@ -43,6 +43,7 @@
 
 namespace rcsc {
 
+class DebugGrid;
 class UDPSocket;
 class PlayerObject;
 class WorldModel;
@@ -55,6 +56,15 @@ class ActionEffector;
   Current supported debug servers:
   - Soccer_Viewer
   - soccerwindow2.
+
+  Each message consists of keyed items (self, ball, players, say, hear,
+  targets, message and shapes). In the delta mode, only the keyframes are
+  complete messages. The other messages have "(delta)" in the header and
+  contain the changed items as (d KEY ITEM) and the keys of the unchanged
+  items as (keep KEY ...). The receiver rebuilds the frame from the items of
+  the previous frame whose keys are kept and the new items. Item order is not
+  preserved. A keyframe is sent every keyframe interval, so a receiver that
+  lost a datagram recovers at the next keyframe.
 */
 class DebugClient {
 public:
@@ -63,6 +73,9 @@ public:
     static const std::size_t MAX_TRIANGLE = 50; //!< maximum number of triangles in one message.
     static const std::size_t MAX_RECT = 50; //!< maximum number of rectangles in one message.
     static const std::size_t MAX_CIRCLE = 50; //!< maximum number of circles in one message.
+    static const std::size_t MAX_GRID = 4; //!< maximum number of value grids in one message.
+
+    static const int DEFAULT_KEYFRAME_INTERVAL = 10; //!< default cycles between two keyframes.
 
 private:
 
@@ -95,6 +108,18 @@ private:
     //! message shown in display
     std::string M_message;
 
+    //! if true, the message is built as the difference from the previous one.
+    bool M_delta_mode;
+    //! the number of cycles between two keyframes in the delta mode
+    int M_keyframe_interval;
+    //! the number of delta messages after the last keyframe
+    int M_delta_count;
+
+    //! zlib compression level for the datagram. 0 means no compression.
+    int M_compression_level;
+
+    //! zlib compression level for the grid payload. 0 means no compression.
+    int M_grid_compression_level;
 
 public:
     /*!
@@ -133,6 +158,28 @@ public:
     void writeAll( const WorldModel & world,
                    const ActionEffector & effector );
 
+    /*!
+      \brief set the delta mode
+      \param on if true, only the changed items are written except the keyframes.
+      \param keyframe_interval the number of cycles between two keyframes
+     */
+    void setDeltaMode( const bool on,
+                       const int keyframe_interval = DEFAULT_KEYFRAME_INTERVAL );
+
+    /*!
+      \brief set the compression level of the datagram sent to the debug server.
+      The server log file is always written as text.
+      \param level zlib compression level [1,9]. 0 disables the compression.
+     */
+    void setCompressionLevel( const int level );
+
+    /*!
+      \brief set the compression level of the grid payload.
+      The compressed payload is written to both the datagram and the server log file.
+      \param level zlib compression level [1,9]. 0 disables the compression.
+     */
+    void setGridCompressionLevel( const int level );
+
 private:
     /*!
       \brief close file and connection
@@ -272,6 +319,33 @@ public:
      */
     void addCircle( const Circle2D & circle,
                     const char * color = "" );
+
+    /*!
+      \brief set value grid info to be drawn
+      \param area the area covered by the grid
+      \param cols the number of columns
+      \param rows the number of rows
+      \param values cols * rows values in the row major order. the first row is the top of the area.
+      \param min_value the value painted as the lowest color
+      \param max_value the value painted as the highest color
+
+      The values are quantized to 8 bits and written as one item,
+      (grid LEFT TOP RIGHT BOTTOM PAYLOAD) where PAYLOAD is the text of DebugGrid.
+     */
+    void addGrid( const Rect2D & area,
+                  const int cols,
+                  const int rows,
+                  const float * values,
+                  const double min_value,
+                  const double max_value );
+
+    /*!
+      \brief set value grid info to be drawn
+      \param area the area covered by the grid
+      \param grid quantized values
+     */
+    void addGrid( const Rect2D & area,
+                  const DebugGrid & grid );
 };
 
 }
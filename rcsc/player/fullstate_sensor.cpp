@@ -38,10 +38,74 @@
 #include <rcsc/common/logger.h>
 
 #include <algorithm>
+#include <charconv>
+#include <cctype>
 #include <cstring>
 
 namespace rcsc {
 
+namespace {
+
+/*-------------------------------------------------------------------*/
+inline
+const char *
+skip_space( const char * buf,
+            const char * end )
+{
+    while ( buf < end && *buf == ' ' ) ++buf;
+    return buf;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read an integer value after the white spaces like strtol().
+  \return true if a value is read. *buf is moved to the next character.
+ */
+inline
+bool
+read_int( const char ** buf,
+          const char * end,
+          int * value )
+{
+    const char * first = skip_space( *buf, end );
+    if ( first < end && *first == '+' ) ++first;
+
+    const std::from_chars_result r = std::from_chars( first, end, *value );
+    if ( r.ec != std::errc() )
+    {
+        return false;
+    }
+
+    *buf = r.ptr;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read a floating point value after the white spaces like strtod().
+  \return true if a value is read. *buf is moved to the next character.
+ */
+inline
+bool
+read_double( const char ** buf,
+             const char * end,
+             double * value )
+{
+    const char * first = skip_space( *buf, end );
+    if ( first < end && *first == '+' ) ++first;
+
+    const std::from_chars_result r = std::from_chars( first, end, *value );
+    if ( r.ec != std::errc() )
+    {
+        return false;
+    }
+
+    *buf = r.ptr;
+    return true;
+}
+
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -95,13 +159,15 @@ FullstateSensor::parse( const char * msg,
     M_our_players.clear();
     M_their_players.clear();
 
+    const char * end = msg + std::strlen( msg );
+
     if ( version >= 8.0 )
     {
-        parseV8( msg, our_side );
+        parseV8( msg, end, our_side );
     }
     else
     {
-        parseV7( msg, our_side );
+        parseV7( msg, end, our_side );
     }
 
     if ( our_side == RIGHT )
@@ -141,6 +207,7 @@ FullstateSensor::reverseSide()
 */
 void
 FullstateSensor::parseV8( const char * msg,
+                          const char * end,
                           const SideID our_side )
 {
     /*
@@ -183,8 +250,6 @@ FullstateSensor::parseV8( const char * msg,
 
       */
 
-    char * next;
-
     while ( *msg != '\0' && *msg != ' ' ) ++msg; // skip "(fullstate"
     // play mode
     while ( *msg != '\0' && *msg != '(' ) ++msg; // skip to "(pmode"
@@ -221,8 +286,10 @@ FullstateSensor::parseV8( const char * msg,
     while ( *msg != '\0' && *msg != '(' ) ++msg; // skip to (score
     while ( *msg != '\0' && *msg != ' ' ) ++msg; // skip to " LSCORE..."
 
-    int score_l = static_cast< int >( std::strtol( msg, &next, 10) ); msg = next;
-    int score_r = static_cast< int >( std::strtol( msg, &next, 10 ) ); msg = next;
+    int score_l = 0;
+    int score_r = 0;
+    read_int( &msg, end, &score_l );
+    read_int( &msg, end, &score_r );
 
     if ( our_side == LEFT )
     {
@@ -240,10 +307,10 @@ FullstateSensor::parseV8( const char * msg,
     while ( *msg != '\0' && *msg != '(' ) ++msg; // skip to (ball
     while ( *msg != '\0' && *msg != ' ' ) ++msg; // skip "(ball"
 
-    M_ball.pos_.x = std::strtod( msg, &next ); msg = next;
-    M_ball.pos_.y = std::strtod( msg, &next ); msg = next;
-    M_ball.vel_.x = std::strtod( msg, &next ); msg = next;
-    M_ball.vel_.y = std::strtod( msg, &next ); msg = next;
+    read_double( &msg, end, &M_ball.pos_.x );
+    read_double( &msg, end, &M_ball.pos_.y );
+    read_double( &msg, end, &M_ball.vel_.x );
+    read_double( &msg, end, &M_ball.vel_.y );
 
     //((p {l|r} <unum>{g|<player_type_id>}) <pos.x> <pos.y>
     //   <vel.x> <vel.y> <body_angle> <neck_angle>
@@ -270,8 +337,7 @@ FullstateSensor::parseV8( const char * msg,
                          : RIGHT );
 
         msg += 2; // skip "l " or "r "
-        player.unum_ = static_cast< int >( std::strtol( msg, &next, 10 ) );
-        msg = next;
+        read_int( &msg, end, &player.unum_ );
 
         while ( *msg == ' ' ) ++msg;
 
@@ -285,44 +351,43 @@ FullstateSensor::parseV8( const char * msg,
 
         if ( std::isdigit( *msg ) )
         {
-            player.type_ = static_cast< int >( std::strtol( msg, &next, 10 ) );
-            msg = next;
+            read_int( &msg, end, &player.type_ );
         }
 
         while ( *msg == ' ' || *msg == ')' ) ++msg; // skip to x pos
 
-        player.pos_.x = std::strtod( msg, &next ); msg = next;
-        player.pos_.y = std::strtod( msg, &next ); msg = next;
-        player.vel_.x = std::strtod( msg, &next ); msg = next;
-        player.vel_.y = std::strtod( msg, &next ); msg = next;
-        player.body_ = std::strtod( msg, &next ); msg = next;
-        player.neck_ = std::strtod( msg, &next ); msg = next;
+        read_double( &msg, end, &player.pos_.x );
+        read_double( &msg, end, &player.pos_.y );
+        read_double( &msg, end, &player.vel_.x );
+        read_double( &msg, end, &player.vel_.y );
+        read_double( &msg, end, &player.body_ );
+        read_double( &msg, end, &player.neck_ );
 
         while ( *msg != '\0' && *msg == ' ' ) ++msg;
         if ( *msg != '(' )
         {
-            player.pointto_dist_ = std::strtod( msg, &next ); msg = next;
-            player.pointto_dir_ = std::strtod( msg, &next ); msg = next;
+            read_double( &msg, end, &player.pointto_dist_ );
+            read_double( &msg, end, &player.pointto_dir_ );
         }
         while ( *msg != '\0' && *msg != '(' ) ++msg; // skip to "("
 
         if ( std::strncmp( msg, "(focus_point ", 13 ) == 0 )
         {
             msg += 13;
-            player.focus_dist_ = std::strtod( msg, &next ); msg = next;
-            player.focus_dir_ = std::strtod( msg, &next ); msg = next;
+            read_double( &msg, end, &player.focus_dist_ );
+            read_double( &msg, end, &player.focus_dir_ );
             while ( *msg != '\0' && *msg != '(' ) ++msg; // skip to "("
         }
 
         if ( std::strncmp( msg, "(stamina ", 9 ) == 0 )
         {
             msg += 9;
-            player.stamina_ = std::strtod( msg, &next ); msg = next;
-            player.effort_ = std::strtod( msg, &next ); msg = next;
-            player.recovery_ = std::strtod( msg, &next ); msg = next;
+            read_double( &msg, end, &player.stamina_ );
+            read_double( &msg, end, &player.effort_ );
+            read_double( &msg, end, &player.recovery_ );
             if ( *msg != ')' )
             {
-                player.stamina_capacity_ = std::strtod( msg, &next ); msg = next;
+                read_double( &msg, end, &player.stamina_capacity_ );
             }
             while ( *msg == ')' ) ++msg;
         }
@@ -374,6 +439,7 @@ FullstateSensor::parseV8( const char * msg,
 */
 void
 FullstateSensor::parseV7( const char * msg,
+                          const char * end,
                           const SideID our_side )
 {
     /*
@@ -388,8 +454,6 @@ FullstateSensor::parseV7( const char * msg,
     //   This class doesn't manage playmode & view mode
     // !!!!!!!!!!!!!!!!!!!!!    //! left team score!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
-    char *next;
-
     while ( *msg != ' ' ) ++msg; // skip "(fullstate"
     while ( *msg != '(' ) ++msg; // skip to "(pmode"
 
@@ -404,8 +468,10 @@ FullstateSensor::parseV7( const char * msg,
     while ( *msg != '(' ) ++msg; // skip to (score
     while ( *msg != ' ' ) ++msg; // skip to " LSCORE..."
 
-    int score_l = static_cast< int >( std::strtol( msg, &next, 10 ) ); msg = next;
-    int score_r = static_cast< int >( std::strtol( msg, &next, 10 ) ); msg = next;
+    int score_l = 0;
+    int score_r = 0;
+    read_int( &msg, end, &score_l );
+    read_int( &msg, end, &score_r );
     if ( our_side == LEFT )
     {
         M_our_score = score_l;
@@ -420,10 +486,10 @@ FullstateSensor::parseV7( const char * msg,
     while ( *msg != '(' ) ++msg; // skip to (ball
     while ( *msg != ' ' ) ++msg; // skip "(ball"
 
-    M_ball.pos_.x = std::strtod( msg, &next ); msg = next;
-    M_ball.pos_.y = std::strtod( msg, &next ); msg = next;
-    M_ball.vel_.x = std::strtod( msg, &next ); msg = next;
-    M_ball.vel_.y = std::strtod( msg, &next ); msg = next;
+    read_double( &msg, end, &M_ball.pos_.x );
+    read_double( &msg, end, &M_ball.pos_.y );
+    read_double( &msg, end, &M_ball.vel_.x );
+    read_double( &msg, end, &M_ball.vel_.y );
 
     while ( *msg != '\0' )
     {
@@ -443,18 +509,17 @@ FullstateSensor::parseV7( const char * msg,
                          : RIGHT );
 
         msg += 2; // skip "l_" or "r_"
-        player.unum_ = std::atoi( msg );
-        msg += 2; // skip to x pos
-
-        player.pos_.x = std::strtod( msg, &next ); msg = next;
-        player.pos_.y = std::strtod( msg, &next ); msg = next;
-        player.vel_.x = std::strtod( msg, &next ); msg = next;
-        player.vel_.y = std::strtod( msg, &next ); msg = next;
-        player.body_ = std::strtod( msg, &next ); msg = next;
-        player.neck_ = std::strtod( msg, &next ); msg = next;
-        player.stamina_ = std::strtod( msg, &next ); msg = next;
-        player.effort_ = std::strtod( msg, &next ); msg = next;
-        player.recovery_ = std::strtod( msg, &next ); msg = next;
+        read_int( &msg, end, &player.unum_ );
+
+        read_double( &msg, end, &player.pos_.x );
+        read_double( &msg, end, &player.pos_.y );
+        read_double( &msg, end, &player.vel_.x );
+        read_double( &msg, end, &player.vel_.y );
+        read_double( &msg, end, &player.body_ );
+        read_double( &msg, end, &player.neck_ );
+        read_double( &msg, end, &player.stamina_ );
+        read_double( &msg, end, &player.effort_ );
+        read_double( &msg, end, &player.recovery_ );
         // now, msg point the last paren of this player
 
         if ( our_side == player.side_ )
@@ -185,15 +185,21 @@ private:
     /*!
       \brief analyze raw server message (protcol version 7)
       \param msg server message
+      \param end end of the message
+      \param our_side side of this agent
     */
     void parseV7( const char * msg,
+                  const char * end,
                   const SideID our_side );
 
     /*!
       \brief analyze raw server message (protcol version 8 or later)
       \param msg server message
+      \param end end of the message
+      \param our_side side of this agent
     */
     void parseV8( const char * msg,
+                  const char * end,
                   const SideID our_side );
 
     /*!
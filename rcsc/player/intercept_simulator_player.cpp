@@ -46,6 +46,7 @@
 
 // #define DEBUG
 // #define DEBUG2
+// #define DEBUG_CHECK_BATCH
 
 namespace rcsc {
 
@@ -103,6 +104,44 @@ get_bonus_step( const PlayerObject & p,
         : std::min( 3, std::min( p.heardPosCount(), p.seenPosCount() ) );
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+  \brief check the players that need no simulation
+  \param p target player
+  \param step pointer to the variable to store the result
+  \return true if the result is determined
+ */
+inline
+bool
+get_trivial_step( const PlayerObject & p,
+                  int * step )
+{
+    if ( p.posCount() >= 15 )
+    {
+        *step = 1000;
+        return true;
+    }
+
+    if ( p.isKickable( 0.0 ) )
+    {
+        *step = 0;
+        return true;
+    }
+
+    if ( ! p.playerTypePtr() )
+    {
+        std::cerr << __FILE__ << ' ' << __LINE__
+                  << ": ERROR NULL player type." << std::endl;
+        dlog.addText( Logger::INTERCEPT,
+                      __FILE__": NULL player type. side=%c unum=%d",
+                      side_char( p.side() ), p.unum() );
+        *step = 1000;
+        return true;
+    }
+
+    return false;
+}
+
 /*-------------------------------------------------------------------*/
 inline
 int
@@ -130,55 +169,73 @@ InterceptSimulatorPlayer::PlayerData::inertiaPoint( const int step ) const
 /*!
 
  */
-InterceptSimulatorPlayer::InterceptSimulatorPlayer( const Vector2D & ball_pos,
-                                                    const Vector2D & ball_vel )
-    : M_ball_move_angle( ball_vel.th() )
+bool
+InterceptSimulatorPlayer::Input::equals( const Input & other ) const
 {
-    createBallCache( ball_pos, ball_vel );
+    return ptype_ == other.ptype_
+        && side_ == other.side_
+        && goalie_ == other.goalie_
+        && pos_count_ == other.pos_count_
+        && bonus_step_ == other.bonus_step_
+        && penalty_step_ == other.penalty_step_
+        && kickable_ == other.kickable_
+        && pos_.x == other.pos_.x
+        && pos_.y == other.pos_.y
+        && vel_.x == other.vel_.x
+        && vel_.y == other.vel_.y
+        && current_vel_.x == other.current_vel_.x
+        && current_vel_.y == other.current_vel_.y
+        && body_ == other.body_;
 }
 
 /*-------------------------------------------------------------------*/
-void
-InterceptSimulatorPlayer::createBallCache( const Vector2D & ball_pos,
-                                           const Vector2D & ball_vel )
+/*!
+
+ */
+InterceptSimulatorPlayer::Input
+InterceptSimulatorPlayer::create_input( const SideID our_side,
+                                        const PlayerObject & p )
 {
-    constexpr int MAX_STEP = 50;
+    Input input;
+    input.ptype_ = p.playerTypePtr();
+    input.side_ = p.side();
+    input.goalie_ = p.goalie();
+    input.pos_count_ = std::min( p.posCount(), 15 );
+    input.bonus_step_ = get_bonus_step( p, our_side );
+    input.penalty_step_ = get_penalty_step( p );
+    input.kickable_ = p.isKickable( 0.0 );
+    input.pos_ = get_pos( p );
+    input.vel_ = get_vel( p );
+    input.current_vel_ = p.vel();
+    input.body_ = p.body().degree();
+    return input;
+}
 
-    const ServerParam & SP = ServerParam::i();
-    const double max_x = ( SP.keepawayMode()
-                           ? SP.keepawayLength() * 0.5
-                           : SP.pitchHalfLength() + 5.0 );
-    const double max_y = ( SP.keepawayMode()
-                           ? SP.keepawayWidth() * 0.5
-                           : SP.pitchHalfWidth() + 5.0 );
-    const double bdecay = SP.ballDecay();
-
-    M_ball_cache.clear();
-    M_ball_cache.reserve( MAX_STEP );
-
-    Vector2D bpos = ball_pos;
-    Vector2D bvel = ball_vel;
-    double bspeed = bvel.r();
-
-    for ( int i = 0; i < MAX_STEP; ++i )
-    {
-        M_ball_cache.push_back( bpos );
+/*-------------------------------------------------------------------*/
+/*!
 
-        if ( bspeed < 0.005 && i >= 10 )
-        {
-            break;
-        }
+ */
+InterceptSimulatorPlayer::InterceptSimulatorPlayer( const Vector2D & ball_pos,
+                                                    const Vector2D & ball_vel )
+    : M_local_ball( new BallTrajectoryCache( ball_pos, ball_vel ) ),
+      M_ball( *M_local_ball ),
+      M_ball_length( M_ball.length( 10, 50 ) ),
+      M_ball_move_angle( ball_vel.th() )
+{
 
-        bpos += bvel;
-        bvel *= bdecay;
-        bspeed *= bdecay;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+InterceptSimulatorPlayer::InterceptSimulatorPlayer( const BallTrajectoryCache & ball )
+    : M_local_ball(),
+      M_ball( ball ),
+      M_ball_length( M_ball.length( 10, 50 ) ),
+      M_ball_move_angle( ball.vel( 0 ).th() )
+{
 
-        if ( max_x < bpos.absX()
-             || max_y < bpos.absY() )
-        {
-            break;
-        }
-    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -190,35 +247,14 @@ InterceptSimulatorPlayer::simulate( const WorldModel & wm,
                                     const PlayerObject & player,
                                     const bool goalie ) const
 {
-    if ( player.posCount() >= 15 )
+    int trivial_step = 0;
+    if ( get_trivial_step( player, &trivial_step ) )
     {
-        return 1000;
-    }
-
-    if ( player.isKickable( 0.0 ) )
-    {
-        return 0;
-    }
-
-    const PlayerType * ptype = player.playerTypePtr();
-
-    if ( ! ptype )
-    {
-        std::cerr << __FILE__ << ' ' << __LINE__
-                  << ": ERROR NULL player type." << std::endl;
-        dlog.addText( Logger::INTERCEPT,
-                      __FILE__": NULL player type. side=%c unum=%d",
-                      side_char( player.side() ), player.unum() );
-        return 1000;
+        return trivial_step;
     }
 
-    const ServerParam & SP = ServerParam::i();
-
-    const double pen_area_x = SP.pitchHalfLength() - SP.penaltyAreaLength();
-    const double pen_area_y = SP.penaltyAreaHalfWidth();
-
     const PlayerData data( player,
-                           *ptype,
+                           *player.playerTypePtr(),
                            get_pos( player ),
                            get_vel( player ),
                            get_control_area( player, wm, goalie ),
@@ -226,7 +262,6 @@ InterceptSimulatorPlayer::simulate( const WorldModel & wm,
                            get_penalty_step( player ) );
 
     const int min_step = estimateMinStep( data );
-    const int max_step = M_ball_cache.size() - 1;
 
 #ifdef DEBUG
     dlog.addText( Logger::INTERCEPT,
@@ -234,19 +269,155 @@ InterceptSimulatorPlayer::simulate( const WorldModel & wm,
                   side_char( player.side() ),
                   player.unum(),
                   player.pos().x, player.pos().y,
-                  min_step, max_step,
+                  min_step, M_ball_length - 1,
                   data.pos_.x, data.pos_.y,
                   data.bonus_step_, data.penalty_step_ );
 #endif
 
+    return simulateSteps( data, goalie, min_step, min_step );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+InterceptSimulatorPlayer::simulate( const WorldModel & wm,
+                                    const std::vector< const PlayerObject * > & players,
+                                    const bool goalie,
+                                    std::vector< int > * result ) const
+{
+    result->assign( players.size(), 1000 );
+
+    const int max_step = M_ball_length - 1;
+
+    //
+    // player data in the structure-of-arrays layout.
+    // players are processed in the fixed size blocks not to allocate the memory.
+    //
+    constexpr std::size_t BLOCK = 32;
+
+    int index[BLOCK];
+    int min_step[BLOCK];
+    int step_offset[BLOCK];
+    int first_step[BLOCK];
+    double px[BLOCK];
+    double py[BLOCK];
+    double control_area[BLOCK];
+    double speed_max[BLOCK];
+
+    const double * bx = M_ball.x();
+    const double * by = M_ball.y();
+
+    std::size_t i = 0;
+    while ( i < players.size() )
+    {
+        //
+        // fill the block
+        //
+        std::size_t n = 0;
+        for ( ; i < players.size() && n < BLOCK; ++i )
+        {
+            const PlayerObject & p = *players[i];
+            if ( get_trivial_step( p, &( *result )[i] ) )
+            {
+                continue;
+            }
+
+            const PlayerData data( p,
+                                   *p.playerTypePtr(),
+                                   get_pos( p ),
+                                   get_vel( p ),
+                                   get_control_area( p, wm, goalie ),
+                                   get_bonus_step( p, wm.ourSide() ),
+                                   get_penalty_step( p ) );
+
+            index[n] = static_cast< int >( i );
+            min_step[n] = estimateMinStep( data );
+            step_offset[n] = data.bonus_step_ - data.penalty_step_;
+            first_step[n] = max_step;
+            px[n] = data.pos_.x;
+            py[n] = data.pos_.y;
+            control_area[n] = data.control_area_;
+            speed_max[n] = data.ptype_.realSpeedMax();
+            ++n;
+        }
+
+        //
+        // find the first step that is not rejected by the reachable circle check.
+        // the inner loop has no branch, so that the compiler can vectorize it.
+        // the check has a small margin, so that it never rejects a step that is
+        // accepted by the scalar check. then, the scalar loop started from that step
+        // gives the same result as the scalar simulation.
+        //
+        for ( int step = 0; step < max_step; ++step )
+        {
+            const double ball_x = bx[step];
+            const double ball_y = by[step];
+            for ( std::size_t j = 0; j < n; ++j )
+            {
+                const double r = control_area[j] + speed_max[j] * ( step + step_offset[j] ) + 0.5;
+                const double dx = px[j] - ball_x;
+                const double dy = py[j] - ball_y;
+                const bool candidate = ( step >= min_step[j]
+                                         && r * r * ( 1.0 + 1.0e-9 ) + 1.0e-9 >= dx * dx + dy * dy );
+                first_step[j] = ( candidate && step < first_step[j] ? step : first_step[j] );
+            }
+        }
+
+        //
+        // run the detailed check for the remaining steps
+        //
+        for ( std::size_t j = 0; j < n; ++j )
+        {
+            const PlayerObject & p = *players[index[j]];
+            const PlayerData data( p,
+                                   *p.playerTypePtr(),
+                                   get_pos( p ),
+                                   get_vel( p ),
+                                   get_control_area( p, wm, goalie ),
+                                   get_bonus_step( p, wm.ourSide() ),
+                                   get_penalty_step( p ) );
+            ( *result )[index[j]] = simulateSteps( data, goalie, min_step[j], first_step[j] );
+#ifdef DEBUG_CHECK_BATCH
+            const int scalar_step = simulate( wm, p, goalie );
+            if ( scalar_step != ( *result )[index[j]] )
+            {
+                dlog.addText( Logger::INTERCEPT,
+                              "(InterceptSimulatorPlayer) batch mismatch %c %d batch=%d scalar=%d",
+                              side_char( p.side() ), p.unum(),
+                              ( *result )[index[j]], scalar_step );
+            }
+#endif
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+InterceptSimulatorPlayer::simulateSteps( const PlayerData & data,
+                                         const bool goalie,
+                                         const int min_step,
+                                         const int start_step ) const
+{
+    const ServerParam & SP = ServerParam::i();
+
+    const double pen_area_x = SP.pitchHalfLength() - SP.penaltyAreaLength();
+    const double pen_area_y = SP.penaltyAreaHalfWidth();
+
+    const int max_step = M_ball_length - 1;
+
     if ( min_step > max_step )
     {
         return predictFinal( data );
     }
 
-    for ( int total_step = min_step; total_step < max_step; ++total_step )
+    for ( int total_step = start_step; total_step < max_step; ++total_step )
     {
-        const Vector2D & ball_pos = M_ball_cache[total_step];
+        const Vector2D ball_pos = ballPos( total_step );
 #ifdef DEBUG2
         dlog.addText( Logger::INTERCEPT,
                       "*** step=%d  ball(%.2f %.2f)",
@@ -295,13 +466,13 @@ InterceptSimulatorPlayer::simulate( const WorldModel & wm,
     }
 
     if ( goalie
-         && ( M_ball_cache.back().absX() < pen_area_x
-              || pen_area_y < M_ball_cache.back().absY() ) )
+         && ( ballLastPos().absX() < pen_area_x
+              || pen_area_y < ballLastPos().absY() ) )
     {
 #ifdef DEBUG
         dlog.addText( Logger::INTERCEPT,
                       "FAILURE goalie. final. over the penalty area. bpos=(%.2f %.2f)",
-                      M_ball_cache.back().x, M_ball_cache.back().y );
+                      ballLastPos().x, ballLastPos().y );
 #endif
         return 1000;
     }
@@ -316,7 +487,7 @@ InterceptSimulatorPlayer::simulate( const WorldModel & wm,
 int
 InterceptSimulatorPlayer::estimateMinStep( const PlayerData & data ) const
 {
-    Vector2D rel = data.pos_ - M_ball_cache.front();
+    Vector2D rel = data.pos_ - ballPos( 0 );
     rel.rotate( - M_ball_move_angle );
 
     double move_dist = std::max( 0.3, rel.absY() - data.control_area_ );
@@ -483,8 +654,8 @@ InterceptSimulatorPlayer::canReachAfterDash( const PlayerData & data,
 int
 InterceptSimulatorPlayer::predictFinal( const PlayerData & data ) const
 {
-    Vector2D ball_pos = M_ball_cache.back();
-    int ball_step = M_ball_cache.size() - 1;
+    Vector2D ball_pos = ballLastPos();
+    int ball_step = M_ball_length - 1;
 
     Vector2D inertia_pos = data.inertiaPoint( 100 );
 
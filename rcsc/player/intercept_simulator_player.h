@@ -32,7 +32,11 @@
 #ifndef RCSC_PLAYER_INTERCEPT_SIMULATOR_PLAYER_H
 #define RCSC_PLAYER_INTERCEPT_SIMULATOR_PLAYER_H
 
+#include <rcsc/common/ball_trajectory_cache.h>
 #include <rcsc/geom/vector_2d.h>
+#include <rcsc/types.h>
+
+#include <memory>
 #include <vector>
 
 namespace rcsc {
@@ -47,6 +51,34 @@ class WorldModel;
   \brief intercept simulator for other players
 */
 class InterceptSimulatorPlayer {
+public:
+
+    /*!
+      \struct Input
+      \brief player values referred by simulate().
+      if the inputs and the ball are same, the results are same.
+    */
+    struct Input {
+        const PlayerType * ptype_; //!< player type
+        int side_; //!< side id
+        bool goalie_; //!< goalie flag
+        int pos_count_; //!< position accuracy count, saturated at the validity limit
+        int bonus_step_; //!< bonus step (position accuracy count)
+        int penalty_step_; //!< penalty step (tackling)
+        bool kickable_; //!< kickable state
+        Vector2D pos_; //!< initial pos used by the simulation
+        Vector2D vel_; //!< initial vel used by the simulation
+        Vector2D current_vel_; //!< current velocity used by the turn estimation
+        double body_; //!< body angle degree
+
+        /*!
+          \brief compare all values.
+          \param other compared input
+          \return true if all values are same.
+        */
+        bool equals( const Input & other ) const;
+    };
+
 private:
 
     /*!
@@ -83,13 +115,19 @@ private:
     };
 
 
+    //! ball trajectory created by this instance. NULL if the shared one is used.
+    std::unique_ptr< BallTrajectoryCache > M_local_ball;
     //! predicted ball positions
-    std::vector< Vector2D > M_ball_cache;
+    const BallTrajectoryCache & M_ball;
+    //! the number of ball positions to be checked
+    const int M_ball_length;
     //! ball velocity angle
     const AngleDeg M_ball_move_angle;
 
     // not used
     InterceptSimulatorPlayer() = delete;
+    InterceptSimulatorPlayer( const InterceptSimulatorPlayer & ) = delete;
+    InterceptSimulatorPlayer & operator=( const InterceptSimulatorPlayer & ) = delete;
 
 public:
 
@@ -101,12 +139,29 @@ public:
     InterceptSimulatorPlayer( const Vector2D & ball_pos,
                               const Vector2D & ball_vel );
 
+    /*!
+      \brief construct with the shared ball trajectory.
+      \param ball predicted ball trajectory. its lifetime must exceed this instance.
+    */
+    explicit
+    InterceptSimulatorPlayer( const BallTrajectoryCache & ball );
+
     /*!
       \brief destructor. nothing to do
     */
     ~InterceptSimulatorPlayer()
     { }
 
+    /*!
+      \brief get the input values of the target player
+      \param our_side our side id
+      \param player target player
+      \return input values
+    */
+    static
+    Input create_input( const SideID our_side,
+                        const PlayerObject & player );
+
     //////////////////////////////////////////////////////////
     /*!
       \brief get predicted ball gettable cycle
@@ -120,15 +175,56 @@ public:
                   const PlayerObject & player,
                   const bool goalie ) const;
 
+    /*!
+      \brief get predicted ball gettable cycles of several players at once.
+      \param wm const reference to the instance of world model
+      \param players target players
+      \param goalie goalie mode or not
+      \param result pointer to the result container. the order is same as players.
+
+      The never reachable steps of all players are filtered in one batch over
+      the contiguous player and ball arrays, and the detailed check is done only for
+      the remaining steps. The result is identical to the single player version.
+    */
+    void simulate( const WorldModel & wm,
+                   const std::vector< const PlayerObject * > & players,
+                   const bool goalie,
+                   std::vector< int > * result ) const;
+
 private:
 
     /*!
-      \brief create predicted ball positions
-      \param ball_pos initial ball position
-      \param ball_vel initial ball velocity
+      \brief get the predicted ball position
+      \param step the number of steps from the current state
+      \return ball position
+     */
+    Vector2D ballPos( const int step ) const
+      {
+          return M_ball.pos( step );
+      }
+
+    /*!
+      \brief get the last ball position to be checked
+      \return ball position
+     */
+    Vector2D ballLastPos() const
+      {
+          return M_ball.pos( M_ball_length - 1 );
+      }
+
+    /*!
+      \brief run the step loop from the given step
+      \param data target player data
+      \param goalie goalie mode or not
+      \param min_step estimated minimum reach step
+      \param start_step the first step to be checked in detail. the steps before
+      this must be never reachable.
+      \return predicted cycle value
      */
-    void createBallCache( const Vector2D & ball_pos,
-                          const Vector2D & ball_vel );
+    int simulateSteps( const PlayerData & data,
+                       const bool goalie,
+                       const int min_step,
+                       const int start_step ) const;
 
     /*!
       \brief estimate minimum reach step (very rough calculation)
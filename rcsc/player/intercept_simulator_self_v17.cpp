@@ -60,6 +60,12 @@
 // #define DEBUG_PRINT_TURN_DASH
 // #define DEBUG_PRINT_OMNI_DASH
 
+// #define DEBUG_CHECK_BATCH
+
+// the candidate simulation uses FastTrig for the angles and the dash vectors.
+// its error (less than 1.0e-6 degree) is far below the sensor resolution.
+// the world model update and the localization keep the exact trigonometry.
+
 namespace rcsc {
 
 namespace {
@@ -199,6 +205,159 @@ struct InterceptEqualSimple {
             && lhs.dashStep() == rhs.dashStep();
     }
 };
+
+/*-------------------------------------------------------------------*/
+/*!
+  \struct OmniDashKernel
+  \brief dash direction values of the omni dash simulation stored as flat arrays.
+
+  All dash directions for one dash step are evaluated by a loop without
+  branches, so the compiler can vectorize it. Each value is computed by the
+  same expressions as the scalar simulation, including the Matrix2D
+  transformations, so the selected dash is identical.
+ */
+struct OmniDashKernel {
+    // direction values. created once for each simulation.
+    std::vector< double > power_max_; //!< dash power used for each direction
+    std::vector< double > abs_power_max_; //!< absolute value of power_max_
+    std::vector< double > base_rate_; //!< dash power rate multiplied by the dash dir rate
+    std::vector< double > rot11_, rot12_; //!< rotation to the accel direction. only x is used.
+    std::vector< double > inv11_, inv12_, inv21_, inv22_; //!< rotation from the accel direction
+
+    // results of evaluate()
+    std::vector< char > valid_; //!< false if the dash accelerates to the opposite direction
+    std::vector< double > power_; //!< dash power
+    std::vector< double > pos_x_, pos_y_; //!< next self position
+    std::vector< double > vel_x_, vel_y_; //!< next self velocity (before decay)
+    std::vector< double > dist2_; //!< weighted squared distance to the ball
+
+    void push_back( const double power_max,
+                    const double base_rate,
+                    const Matrix2D & rot,
+                    const Matrix2D & inv )
+      {
+          power_max_.push_back( power_max );
+          abs_power_max_.push_back( std::fabs( power_max ) );
+          base_rate_.push_back( base_rate );
+          rot11_.push_back( rot.m11() );
+          rot12_.push_back( rot.m12() );
+          inv11_.push_back( inv.m11() );
+          inv12_.push_back( inv.m12() );
+          inv21_.push_back( inv.m21() );
+          inv22_.push_back( inv.m22() );
+      }
+
+    std::size_t size() const
+      {
+          return power_max_.size();
+      }
+
+    /*!
+      \brief evaluate all dash directions
+      \param required_accel required acceleration
+      \param effort current effort
+      \param available_stamina the value of StaminaModel::getSafetyStamina()
+      \param self_pos current self position
+      \param self_vel current self velocity
+      \param ball_pos target ball position
+      \param rotate_matrix rotation to the body direction
+      \param dash_power_min the minimum dash power
+      \param dash_power_max the maximum dash power
+     */
+    void evaluate( const Vector2D & required_accel,
+                   const double effort,
+                   const double available_stamina,
+                   const Vector2D & self_pos,
+                   const Vector2D & self_vel,
+                   const Vector2D & ball_pos,
+                   const Matrix2D & rotate_matrix,
+                   const double dash_power_min,
+                   const double dash_power_max )
+      {
+          const std::size_t n = size();
+          valid_.resize( n );
+          power_.resize( n );
+          pos_x_.resize( n );
+          pos_y_.resize( n );
+          vel_x_.resize( n );
+          vel_y_.resize( n );
+          dist2_.resize( n );
+
+          const double ax = required_accel.x;
+          const double ay = required_accel.y;
+          const double r11 = rotate_matrix.m11();
+          const double r12 = rotate_matrix.m12();
+          const double r21 = rotate_matrix.m21();
+          const double r22 = rotate_matrix.m22();
+
+          for ( std::size_t d = 0; d < n; ++d )
+          {
+              const double rel_accel_x = rot11_[d] * ax + rot12_[d] * ay + 0.0;
+              const double dash_rate = base_rate_[d] * effort;
+              double dash_power = rel_accel_x / dash_rate;
+              dash_power = ( dash_power < abs_power_max_[d] ? dash_power : abs_power_max_[d] );
+              dash_power = ( power_max_[d] < 0.0 ? -dash_power : dash_power );
+              dash_power = ( dash_power < dash_power_min
+                             ? dash_power_min
+                             : dash_power > dash_power_max
+                             ? dash_power_max
+                             : dash_power );
+              dash_power = StaminaModel::safety_dash_power( dash_power, available_stamina );
+
+              const double accel_mag = std::fabs( dash_power ) * dash_rate;
+              const double vel_x = self_vel.x + ( inv11_[d] * accel_mag + inv12_[d] * 0.0 + 0.0 );
+              const double vel_y = self_vel.y + ( inv21_[d] * accel_mag + inv22_[d] * 0.0 + 0.0 );
+              const double pos_x = self_pos.x + vel_x;
+              const double pos_y = self_pos.y + vel_y;
+              const double rel_x = ball_pos.x - pos_x;
+              const double rel_y = ball_pos.y - pos_y;
+              const double body_x = r11 * rel_x + r12 * rel_y + 0.0;
+              const double body_y = r21 * rel_x + r22 * rel_y + 0.0;
+
+              valid_[d] = ! ( rel_accel_x < 0.0 );
+              power_[d] = dash_power;
+              vel_x_[d] = vel_x;
+              vel_y_[d] = vel_y;
+              pos_x_[d] = pos_x;
+              pos_y_[d] = pos_y;
+              dist2_[d] = std::pow( body_x, 2 ) + std::pow( body_y * 1.5, 2 );
+          }
+      }
+
+    /*!
+      \brief get the index of the best direction
+      \return index value. -1 if no direction is better than the initial threshold.
+     */
+    int best() const
+      {
+          int result = -1;
+          double min_dist2 = 1000000.0;
+          for ( std::size_t d = 0; d < dist2_.size(); ++d )
+          {
+              if ( valid_[d]
+                   && dist2_[d] < min_dist2 )
+              {
+                  min_dist2 = dist2_[d];
+                  result = static_cast< int >( d );
+              }
+          }
+          return result;
+      }
+};
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+InterceptSimulatorSelfV17::InterceptSimulatorSelfV17()
+    : M_ball_vel( 0.0, 0.0 ),
+      M_stopped_ball(),
+      M_ball( &M_stopped_ball ),
+      M_use_reach_bound( true )
+{
+    M_tier_count.fill( 0 );
+
 }
 
 /*-------------------------------------------------------------------*/
@@ -219,10 +378,13 @@ InterceptSimulatorSelfV17::simulate( const WorldModel & wm,
          )
     {
         M_ball_vel.assign( 0.0, 0.0 );
+        M_stopped_ball.update( wm.time(), wm.ball().pos(), M_ball_vel );
+        M_ball = &M_stopped_ball;
     }
     else
     {
         M_ball_vel = wm.ball().vel();
+        M_ball = &wm.ballTrajectory();
     }
 
     simulateOneStep( wm, self_cache );
@@ -359,7 +521,7 @@ InterceptSimulatorSelfV17::simulateNoDash( const WorldModel & wm,
 
     if ( ball_next_dist > ptype.playerSize() + ServerParam::i().ballSize() )
     {
-        AngleDeg ball_angle = ( ball_next - self_next ).th() - wm.self().body();
+        AngleDeg ball_angle = ( ball_next - self_next ).th< FastTrig >() - wm.self().body();
         double kick_rate = ptype.kickRate( ball_next_dist, ball_angle.abs() );
         Vector2D ball_next_vel = ballVel() * ServerParam::i().ballDecay();
 
@@ -454,7 +616,7 @@ InterceptSimulatorSelfV17::simulateOneDashAnyDir( const WorldModel & wm,
 
     StaminaModel stamina_model = wm.self().staminaModel();
 
-    const double dash_dir = SP.discretizeDashAngle( ( required_accel.th() - wm.self().body() ).degree() );
+    const double dash_dir = SP.discretizeDashAngle( ( required_accel.th< FastTrig >() - wm.self().body() ).degree() );
     const double dash_rate =  SP.dashDirRate( dash_dir ) * ptype.dashPowerRate() * stamina_model.effort();
 
     const double required_dash_power = std::min( required_accel.r() / dash_rate, SP.maxDashPower() );
@@ -837,7 +999,7 @@ InterceptSimulatorSelfV17::getOneAdjustDash( const WorldModel & wm,
     //
     Intercept::StaminaType stamina_type = Intercept::NORMAL;
 
-    const Vector2D accel = Vector2D::polar2vector( dash_power * dash_rate, dash_angle );
+    const Vector2D accel = Vector2D::polar2vector< FastTrig >( dash_power * dash_rate, dash_angle );
     const Vector2D self_next_after_dash = wm.self().pos() + wm.self().vel() + accel;
 
     StaminaModel stamina_model = wm.self().staminaModel();
@@ -1011,7 +1173,7 @@ simulate_turn_step( const WorldModel & wm,
         AngleDeg dash_angle = wm.self().body();
         if ( back_dash ) dash_angle += 180.0;
 
-        const AngleDeg target_angle = inertia_rel.th();
+        const AngleDeg target_angle = inertia_rel.th< FastTrig >();
         const double turn_margin = std::max( 12.5, // Magic Number
                                              AngleDeg::asin_deg( control_area / inertia_dist ) );
 
@@ -1064,9 +1226,9 @@ InterceptSimulatorSelfV17::simulateTurnDash( const WorldModel & wm,
     const int min_step = get_min_step( wm, ballVel() );
 
     //Vector2D ball_pos = wm.ball().inertiaPoint( min_step - 1 );
-    Vector2D ball_pos = inertia_n_step_point( wm.ball().pos(), ballVel(), min_step - 1, SP.ballDecay() );
+    Vector2D ball_pos = ballPos( min_step - 1 );
     //Vector2D ball_vel = wm.ball().vel() * std::pow( SP.ballDecay(), min_step - 1 );
-    Vector2D ball_vel = ballVel() * std::pow( SP.ballDecay(), min_step - 1 );
+    Vector2D ball_vel = M_ball->vel( min_step - 1 );
     double ball_speed = ball_vel.r();
 
     int success_count = 0;
@@ -1107,6 +1269,7 @@ InterceptSimulatorSelfV17::simulateTurnDash( const WorldModel & wm,
                           "%d: XX never reach move_dist=%.2f max_dist=%.2f",
                           step, wm.self().pos().dist( ball_pos ), ptype.realSpeedMax() * step + control_area );
 #endif
+            ++M_tier_count[TIER_SIMPLE_CHECK];
             continue;
         }
 
@@ -1171,6 +1334,7 @@ InterceptSimulatorSelfV17::getTurnDash( const WorldModel & wm,
                       "%d: xx (getTurnDash) n_turn=%d dash_angle=%.1f",
                       step, n_turn, dash_angle.degree() );
 #endif
+        ++M_tier_count[TIER_SIMPLE_CHECK];
         return Intercept();
     }
     const AngleDeg body_angle = ( n_turn == 0
@@ -1198,6 +1362,7 @@ InterceptSimulatorSelfV17::getTurnDash( const WorldModel & wm,
         if ( ( back_dash && ball_rel_to_inertia.x > 0.0 )
              || ( ! back_dash && ball_rel_to_inertia.x < 0.0 ) )
         {
+            ++M_tier_count[TIER_SIMPLE_CHECK];
             return Intercept();
         }
     }
@@ -1217,6 +1382,45 @@ InterceptSimulatorSelfV17::getTurnDash( const WorldModel & wm,
 
     const int max_dash_step = step - n_turn;
 
+    //
+    // every success condition below requires |self_pos| >= |ball_rel.x| - control_max.
+    // |self_pos| is bounded by the inertia movement and the sum of the max accelerations.
+    //
+    bool skip_by_bound = false;
+    if ( M_use_reach_bound )
+    {
+        const double decay = ptype.playerDecay();
+        const double max_accel = ( std::max( SP.maxDashPower(), std::fabs( SP.minDashPower() ) )
+                                   * ptype.dashPowerRate()
+                                   * ptype.effortMax() );
+        const double accel_move = ( max_accel / ( 1.0 - decay ) )
+            * ( step - decay * ( 1.0 - std::pow( decay, step ) ) / ( 1.0 - decay ) );
+        const double max_move = ( inertia_n_step_distance( wm.self().vel().r(), step, decay )
+                                  + accel_move );
+        const double control_max = ( goalie_mode
+                                     ? std::max( ptype.kickableArea(), ptype.maxCatchableDist() )
+                                     : ptype.kickableArea() );
+
+        if ( ball_rel.absX() - control_max > max_move + 1.0e-5 )
+        {
+#ifdef DEBUG_PRINT_TURN_DASH
+            dlog.addText( Logger::INTERCEPT,
+                          "%d: xx (getTurnDash) reach bound. ball_rel_x=%.3f max_move=%.3f",
+                          step, ball_rel.x, max_move );
+#endif
+            skip_by_bound = true;
+#ifndef DEBUG_CHECK_BATCH
+            ++M_tier_count[TIER_REACH_BOUND];
+            return Intercept();
+#endif
+        }
+    }
+
+    if ( ! skip_by_bound )
+    {
+        ++M_tier_count[TIER_FULL_SIMULATION];
+    }
+
     double first_dash_power = 0.0;
     for ( int i = 0; i < max_dash_step; ++i )
     {
@@ -1264,6 +1468,20 @@ InterceptSimulatorSelfV17::getTurnDash( const WorldModel & wm,
         ok = true;
     }
 
+#ifdef DEBUG_CHECK_BATCH
+    if ( skip_by_bound )
+    {
+        ++M_tier_count[TIER_REACH_BOUND];
+        if ( ok )
+        {
+            std::cerr << wm.self().unum() << ' ' << wm.time()
+                      << " (getTurnDash) reach bound rejected a reachable step. step="
+                      << step << std::endl;
+        }
+        return Intercept();
+    }
+#endif
+
     if ( ok )
     {
         Intercept::StaminaType stamina_type = ( stamina_model.recovery() < wm.self().staminaModel().recovery() - 1.0e-5
@@ -1276,7 +1494,7 @@ InterceptSimulatorSelfV17::getTurnDash( const WorldModel & wm,
                             : Intercept::TURN_FORWARD_DASH ),
                           n_turn, ( body_angle - wm.self().body() ).degree(),
                           max_dash_step, first_dash_power, 0.0,
-                          wm.self().pos() + self_pos.rotatedVector( body_angle ),
+                          wm.self().pos() + self_pos.rotatedVector< FastTrig >( body_angle ),
                           self_pos.dist( ball_rel ),
                           stamina_model.stamina() );
     }
@@ -1316,8 +1534,6 @@ InterceptSimulatorSelfV17::simulateOmniDashAny( const WorldModel & wm,
                                     * ptype.effortMax()
                                     * SP.dashDirRate( 90.0 ) ) / ( 1.0 - ptype.playerDecay() );
     const Matrix2D rotate_matrix = Matrix2D::make_rotation( -wm.self().body() );
-    //const double first_ball_speed = wm.ball().vel().r();
-    const double first_ball_speed = ballVel().r();
 
 #ifdef DEBUG_PRINT_OMNI_DASH
     dlog.addText( Logger::INTERCEPT,
@@ -1328,7 +1544,7 @@ InterceptSimulatorSelfV17::simulateOmniDashAny( const WorldModel & wm,
     for ( int ball_step = 1; ball_step <= max_step; ++ball_step )
     {
         //const Vector2D ball_pos = wm.ball().inertiaPoint( ball_step );
-        const Vector2D ball_pos = inertia_n_step_point( wm.ball().pos(), ballVel(), ball_step, SP.ballDecay() );
+        const Vector2D ball_pos = ballPos( ball_step );
         const bool goalie_mode = ( wm.self().goalie()
                                    && wm.lastKickerSide() != wm.ourSide()
                                    && ball_pos.x < SP.ourPenaltyAreaLineX() - 0.5
@@ -1336,7 +1552,7 @@ InterceptSimulatorSelfV17::simulateOmniDashAny( const WorldModel & wm,
         const double control_area = ( goalie_mode
                                       ? ptype.maxCatchableDist()
                                       : ptype.kickableArea() );
-        const double ball_noise = ( first_ball_speed * std::pow( SP.ballDecay(), ball_step - 1 )
+        const double ball_noise = ( M_ball->speed( ball_step - 1 )
                                     * SP.ballRand()
                                     * BALL_NOISE_RATE );
         const double control_buf =  ( goalie_mode
@@ -1368,7 +1584,7 @@ InterceptSimulatorSelfV17::simulateOmniDashAny( const WorldModel & wm,
             //const Vector2D required_accel = required_vel - self_vel;
             const Vector2D required_accel = required_vel;
 
-            const double dash_dir = SP.discretizeDashAngle( ( required_accel.th() - wm.self().body() ).degree() );
+            const double dash_dir = SP.discretizeDashAngle( ( required_accel.th< FastTrig >() - wm.self().body() ).degree() );
             const double dash_rate = SP.dashDirRate( dash_dir ) * ptype.dashPowerRate() * stamina_model.effort();
             double dash_power = std::min( SP.maxDashPower(), required_accel.r() / dash_rate );
             dash_power = stamina_model.getSafetyDashPower( ptype, dash_power, 1.0 );
@@ -1448,17 +1664,7 @@ InterceptSimulatorSelfV17::simulateOmniDashOld( const WorldModel & wm,
                                     * SP.dashDirRate( 90.0 ) ) / ( 1.0 - ptype.playerDecay() );
     const Matrix2D rotate_matrix = Matrix2D::make_rotation( -wm.self().body() );
 
-    std::vector< double > dash_powers;
-    std::vector< double > dash_base_rates;
-    std::vector< AngleDeg > accel_angles;
-    std::vector< Matrix2D > accel_rot_matrix;
-    std::vector< Matrix2D > accel_inv_matrix;
-    dash_powers.reserve( dash_angle_divs );
-    dash_base_rates.reserve( dash_angle_divs );
-    accel_angles.reserve( dash_angle_divs );
-    accel_rot_matrix.reserve( dash_angle_divs );
-    accel_inv_matrix.reserve( dash_angle_divs );
-
+    OmniDashKernel kernel;
     for ( size_t d = 0; d < dash_angle_divs; ++d )
     {
         double dir = SP.discretizeDashAngle( SP.minDashAngle() + dash_angle_step * d );
@@ -1468,23 +1674,23 @@ InterceptSimulatorSelfV17::simulateOmniDashOld( const WorldModel & wm,
         if ( std::fabs( forward_dash_rate * SP.maxDashPower() )
              > std::fabs( back_dash_rate * SP.minDashPower() ) - 0.001 )
         {
-            dash_powers.push_back( SP.maxDashPower() );
-            dash_base_rates.push_back( ptype.dashPowerRate() * forward_dash_rate );
+            kernel.push_back( SP.maxDashPower(),
+                              ptype.dashPowerRate() * forward_dash_rate,
+                              Matrix2D::make_rotation( -accel_angle ),
+                              Matrix2D::make_rotation( accel_angle ) );
         }
         else
         {
-            dash_powers.push_back( SP.minDashPower() );
-            dash_base_rates.push_back( ptype.dashPowerRate() * back_dash_rate );
+            kernel.push_back( SP.minDashPower(),
+                              ptype.dashPowerRate() * back_dash_rate,
+                              Matrix2D::make_rotation( -accel_angle ),
+                              Matrix2D::make_rotation( accel_angle ) );
         }
-        accel_angles.push_back( accel_angle );
-        accel_rot_matrix.push_back( Matrix2D::make_rotation( -accel_angle ) );
-        accel_inv_matrix.push_back( Matrix2D::make_rotation( accel_angle ) );
     }
 
     //
     // simulation loop
     //
-    const double first_ball_speed = ballVel().r();
 
 #ifdef DEBUG_PRINT_OMNI_DASH
     dlog.addText( Logger::INTERCEPT,
@@ -1497,7 +1703,7 @@ InterceptSimulatorSelfV17::simulateOmniDashOld( const WorldModel & wm,
     for ( int reach_step = 1; reach_step <= max_step; ++reach_step )
     {
         //const Vector2D ball_pos = wm.ball().inertiaPoint( reach_step );
-        const Vector2D ball_pos = inertia_n_step_point( wm.ball().pos(), ballVel(), reach_step, SP.ballDecay() );
+        const Vector2D ball_pos = ballPos( reach_step );
         const bool goalie_mode
             = ( wm.self().goalie()
                 && wm.lastKickerSide() != wm.ourSide()
@@ -1541,7 +1747,7 @@ InterceptSimulatorSelfV17::simulateOmniDashOld( const WorldModel & wm,
             last_y_diff = ball_rel.absY();
         }
 
-        const double ball_noise = ( first_ball_speed * std::pow( SP.ballDecay(), reach_step - 1 )
+        const double ball_noise = ( M_ball->speed( reach_step - 1 )
                                     * SP.ballRand()
                                     * BALL_NOISE_RATE );
         const double control_buf = ( goalie_mode
@@ -1572,51 +1778,76 @@ InterceptSimulatorSelfV17::simulateOmniDashOld( const WorldModel & wm,
             //const Vector2D required_accel = required_vel - self_vel;
             const Vector2D required_accel = required_vel;
 
-            double min_dist2 = 1000000.0;
             Vector2D best_self_pos = self_pos;
             Vector2D best_self_vel = self_vel;
             double best_dash_power = 0.0;
             double best_dash_dir = 0.0;
 
-            for ( size_t d = 0; d < dash_angle_divs; ++d )
+            kernel.evaluate( required_accel,
+                             stamina_model.effort(),
+                             stamina_model.getSafetyStamina( ptype, 1.0 ),
+                             self_pos, self_vel, ball_pos,
+                             rotate_matrix,
+                             SP.minDashPower(), SP.maxDashPower() );
+            const int best = kernel.best();
+            if ( best >= 0 )
             {
-                const Vector2D rel_accel = accel_rot_matrix[d].transform( required_accel );
-                if ( rel_accel.x < 0.0 )
+                best_self_pos.assign( kernel.pos_x_[best], kernel.pos_y_[best] );
+                best_self_vel.assign( kernel.vel_x_[best], kernel.vel_y_[best] );
+                best_dash_power = kernel.power_[best];
+                best_dash_dir = SP.minDashAngle() + dash_angle_step * best;
+                if ( best_dash_power < 0.0 )
                 {
-                    continue;
+                    best_dash_dir = AngleDeg::normalize_angle( best_dash_dir + 180.0 );
                 }
+            }
 
-                const double dash_rate = dash_base_rates[d] * stamina_model.effort();
-                double dash_power = rel_accel.x / dash_rate;
-                dash_power = std::min( std::fabs( dash_powers[d] ), dash_power );
-                if ( dash_powers[d] < 0.0 ) dash_power = -dash_power;
-                dash_power = stamina_model.getSafetyDashPower( ptype, dash_power, 1.0 );
-
-                double accel_mag = std::fabs( dash_power ) * dash_rate;
-                Vector2D dash_accel = accel_inv_matrix[d].transform( Vector2D( accel_mag, 0.0 ) );
-                Vector2D tmp_vel = self_vel + dash_accel;
-                Vector2D tmp_pos = self_pos + tmp_vel;
-#if 0
-                double d2 = tmp_pos.dist2( ball_pos );
-#else
-                Vector2D rel_to_body = rotate_matrix.transform( ball_pos - tmp_pos );
-                //double d2 = std::pow( rel_to_body.x, 2 ) + std::pow( rel_to_body.y * 5.0, 2 );
-                //double d2 = std::pow( rel_to_body.x, 2 ) + std::pow( rel_to_body.y * 3.0, 2 );
-                double d2 = std::pow( rel_to_body.x, 2 ) + std::pow( rel_to_body.y * 1.5, 2 );
-#endif
-                if ( d2 < min_dist2 )
+#ifdef DEBUG_CHECK_BATCH
+            {
+                // the scalar simulation replaced by the kernel
+                double min_dist2 = 1000000.0;
+                int check_best = -1;
+                double check_power = 0.0;
+                for ( size_t d = 0; d < kernel.size(); ++d )
                 {
-                    min_dist2 = d2;
-                    best_self_pos = tmp_pos;
-                    best_self_vel = tmp_vel;
-                    best_dash_power = dash_power;
-                    best_dash_dir = SP.minDashAngle() + dash_angle_step * d;
-                    if ( dash_power < 0.0 )
+                    const Matrix2D rot( kernel.rot11_[d], kernel.rot12_[d], 0.0, 0.0, 0.0, 0.0 );
+                    const Matrix2D inv( kernel.inv11_[d], kernel.inv12_[d], kernel.inv21_[d], kernel.inv22_[d], 0.0, 0.0 );
+                    const Vector2D rel_accel = rot.transform( required_accel );
+                    if ( rel_accel.x < 0.0 )
+                    {
+                        continue;
+                    }
+
+                    const double dash_rate = kernel.base_rate_[d] * stamina_model.effort();
+                    double dash_power = rel_accel.x / dash_rate;
+                    dash_power = std::min( std::fabs( kernel.power_max_[d] ), dash_power );
+                    if ( kernel.power_max_[d] < 0.0 ) dash_power = -dash_power;
+                    dash_power = stamina_model.getSafetyDashPower( ptype, dash_power, 1.0 );
+
+                    double accel_mag = std::fabs( dash_power ) * dash_rate;
+                    Vector2D dash_accel = inv.transform( Vector2D( accel_mag, 0.0 ) );
+                    Vector2D tmp_pos = self_pos + ( self_vel + dash_accel );
+                    Vector2D rel_to_body = rotate_matrix.transform( ball_pos - tmp_pos );
+                    double d2 = std::pow( rel_to_body.x, 2 ) + std::pow( rel_to_body.y * 1.5, 2 );
+                    if ( d2 < min_dist2 )
                     {
-                        best_dash_dir = AngleDeg::normalize_angle( best_dash_dir + 180.0 );
+                        min_dist2 = d2;
+                        check_best = static_cast< int >( d );
+                        check_power = dash_power;
                     }
                 }
+
+                if ( check_best != best
+                     || check_power != best_dash_power )
+                {
+                    std::cerr << wm.self().unum() << ' ' << wm.time()
+                              << " (simulateOmniDashOld) batch mismatch. index="
+                              << best << ':' << check_best
+                              << " power=" << best_dash_power << ':' << check_power
+                              << std::endl;
+                }
             }
+#endif
 
             self_pos = best_self_pos;
             self_vel = best_self_vel;
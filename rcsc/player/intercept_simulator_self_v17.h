@@ -34,8 +34,11 @@
 
 #include <rcsc/player/intercept_simulator_self.h>
 
+#include <rcsc/common/ball_trajectory_cache.h>
 #include <rcsc/geom/vector_2d.h>
 #include <vector>
+#include <array>
+#include <cstdint>
 
 namespace rcsc {
 
@@ -44,14 +47,53 @@ class SelfObject;
 class WorldModel;
 class StaminaModel;
 
+/*!
+  \class InterceptSimulatorSelfV17
+  \brief self intercept simulator for the server version 17 or later.
+
+  Each ball step of the turn-dash search is resolved by one of the tiers.
+  The cheap checks of the original search come first. Then a closed form
+  upper bound of the movable distance rejects the step before the dash
+  simulation. The bound never rejects a reachable step, so the results
+  are the same with or without it. Only the remaining steps are
+  simulated by the full dash loop.
+*/
 class InterceptSimulatorSelfV17
     : public InterceptSimulatorSelf {
+public:
+
+    /*!
+      \enum Tier
+      \brief the stage that resolved a ball step of the turn-dash search
+    */
+    enum Tier {
+        TIER_SIMPLE_CHECK = 0, //!< rejected by the max speed distance or the body direction
+        TIER_REACH_BOUND, //!< rejected by the movable distance bound
+        TIER_FULL_SIMULATION, //!< resolved by the full dash simulation
+        TIER_SIZE
+    };
+
 private:
 
     Vector2D M_ball_vel;
 
+    //! ball trajectory used when the ball is regarded as stopped
+    BallTrajectoryCache M_stopped_ball;
+    //! the trajectory referred in the current simulation
+    const BallTrajectoryCache * M_ball;
+
+    //! if true, the movable distance bound is used
+    bool M_use_reach_bound;
+    //! the number of ball steps resolved by each tier
+    std::array< std::uint64_t, TIER_SIZE > M_tier_count;
+
 public:
 
+    /*!
+      \brief initialize member variables
+    */
+    InterceptSimulatorSelfV17();
+
     /*!
       \brief simulate self interception, and store the results to self_results
       \param max_step max estimation cycle
@@ -61,6 +103,42 @@ public:
                    const int max_step,
                    std::vector< Intercept > & self_results ) override;
 
+    /*!
+      \brief enable or disable the movable distance bound
+      \param on if false, all steps that pass the simple checks are simulated
+    */
+    void setReachBound( const bool on )
+      {
+          M_use_reach_bound = on;
+      }
+
+    /*!
+      \brief check if the movable distance bound is enabled
+      \return true if enabled
+    */
+    bool reachBound() const
+      {
+          return M_use_reach_bound;
+      }
+
+    /*!
+      \brief get the number of ball steps resolved by the tier since the last clear
+      \param tier tier type
+      \return counter value
+    */
+    std::uint64_t tierCount( const Tier tier ) const
+      {
+          return M_tier_count[tier];
+      }
+
+    /*!
+      \brief reset all tier counters
+    */
+    void clearTierCount()
+      {
+          M_tier_count.fill( 0 );
+      }
+
 private:
 
     const Vector2D & ballVel() const
@@ -68,6 +146,11 @@ private:
         return M_ball_vel;
     }
 
+    Vector2D ballPos( const int step ) const
+    {
+        return M_ball->pos( step );
+    }
+
     //
     // one step simulation
     //
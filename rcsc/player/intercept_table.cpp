@@ -44,8 +44,11 @@
 #include "abstract_player_object.h"
 
 #include <rcsc/time/timer.h>
+#include <rcsc/common/ball_trajectory_cache.h>
 #include <rcsc/common/logger.h>
 #include <rcsc/common/server_param.h>
+#include <rcsc/util/task_graph.h>
+#include <rcsc/util/performance_monitor.h>
 #include <rcsc/game_time.h>
 
 #include <algorithm>
@@ -56,6 +59,23 @@ namespace rcsc {
 
 namespace {
 const int MAX_STEP = 50;
+
+/*-------------------------------------------------------------------*/
+inline
+void
+add_accurate_players( const PlayerObject::Cont & players,
+                      const int pos_count_thr,
+                      PlayerObject::Cont * result )
+{
+    for ( const PlayerObject * p : players )
+    {
+        if ( p->posCount() < pos_count_thr )
+        {
+            result->push_back( p );
+        }
+    }
+}
+
 }
 
 /*-------------------------------------------------------------------*/
@@ -64,7 +84,11 @@ const int MAX_STEP = 50;
 */
 InterceptTable::InterceptTable()
     : M_update_time( 0, 0 ),
-      M_self_simulator( new InterceptSimulatorSelfV17 )
+      M_self_simulator( new InterceptSimulatorSelfV17 ),
+      M_cache_ball_pos( 0.0, 0.0 ),
+      M_cache_ball_vel( 0.0, 0.0 ),
+      M_cache_hit_count( 0 ),
+      M_cache_miss_count( 0 )
 {
     M_self_results.reserve( ( MAX_STEP + 1 ) * 2 );
 
@@ -116,9 +140,11 @@ InterceptTable::update( const WorldModel & wm )
     }
     M_update_time = wm.time();
 
+    RCSC_PERF_TIMER( player_intercept );
+
 #ifdef DEBUG_PRINT
-    dlog.addText( Logger::INTERCEPT,
-                  __FILE__" (update)" );
+    RCSC_DLOG_TEXT( Logger::INTERCEPT,
+                    __FILE__" (update)" );
     Timer timer;
 #endif
 
@@ -135,8 +161,8 @@ InterceptTable::update( const WorldModel & wm )
     if ( ! wm.self().posValid()
          || ! wm.ball().posValid() )
     {
-        dlog.addText( Logger::INTERCEPT,
-                      __FILE__" (update) Invalid self or ball pos" );
+        RCSC_DLOG_TEXT( Logger::INTERCEPT,
+                        __FILE__" (update) Invalid self or ball pos" );
         return;
     }
 
@@ -145,84 +171,129 @@ InterceptTable::update( const WorldModel & wm )
          || wm.kickableTeammate()
          || wm.kickableOpponent() )
     {
-        dlog.addText( Logger::INTERCEPT,
-                      __FILE__" (update) Already exist kickable player" );
+        RCSC_DLOG_TEXT( Logger::INTERCEPT,
+                        __FILE__" (update) Already exist kickable player" );
     }
 #endif
 
+    //
+    // the previous player results are valid only for the same ball trajectory.
+    // self is always simulated, because the self state is updated in every cycle.
+    //
+    {
+        const Vector2D ball_vel = ( wm.kickableOpponent() ? Vector2D( 0.0, 0.0 ) : wm.ball().vel() );
+        if ( M_cache_ball_pos != wm.ball().pos()
+             || M_cache_ball_vel != ball_vel )
+        {
+            M_cache_ball_pos = wm.ball().pos();
+            M_cache_ball_vel = ball_vel;
+            M_player_cache.clear();
+        }
+        M_next_player_cache.clear();
+    }
+
+    PlayerGroupResult opponents;
+    PlayerGroupResult teammates;
+
+    if ( TaskPool::instance().workerCount() > 0
+         && ! dlog.isEnabled( Logger::INTERCEPT ) )
+    {
+        //
+        // the three groups are independent. the results are merged in the
+        // same order as the sequential version.
+        //
+        TaskGraph graph;
+        graph.add( [&]() { predictSelf( wm ); } );
+        graph.add( [&]() { simulateGroup( wm, wm.opponentsFromBall(), wm.kickableOpponent(), 15, "Opponent", &opponents ); } );
+        graph.add( [&]() { simulateGroup( wm, wm.teammatesFromBall(), wm.kickableTeammate(), 10, "Teammate", &teammates ); } );
+        graph.run();
+
+        predictOpponent( wm, opponents );
+        predictTeammate( wm, teammates );
+    }
+    else
+    {
 #ifdef DEBUG
-    dlog.addText( Logger::INTERCEPT,
-                  "==========Intercept Predict Self==========" );
+        RCSC_DLOG_TEXT( Logger::INTERCEPT,
+                        "==========Intercept Predict Self==========" );
 #endif
 
-    predictSelf( wm );
+        predictSelf( wm );
 
 #ifdef DEBUG
-    dlog.addText( Logger::INTERCEPT,
-                  "==========Intercept Predict Opponent==========" );
+        RCSC_DLOG_TEXT( Logger::INTERCEPT,
+                        "==========Intercept Predict Opponent==========" );
 #endif
 
-    predictOpponent( wm );
+        simulateGroup( wm, wm.opponentsFromBall(), wm.kickableOpponent(), 15, "Opponent", &opponents );
+        predictOpponent( wm, opponents );
 
 #ifdef DEBUG
-    dlog.addText( Logger::INTERCEPT,
-                  "==========Intercept Predict Teammate==========" );
+        RCSC_DLOG_TEXT( Logger::INTERCEPT,
+                        "==========Intercept Predict Teammate==========" );
 #endif
 
-    predictTeammate( wm );
+        simulateGroup( wm, wm.teammatesFromBall(), wm.kickableTeammate(), 10, "Teammate", &teammates );
+        predictTeammate( wm, teammates );
+    }
+
+    M_player_cache.swap( M_next_player_cache );
 
-    dlog.addText( Logger::INTERCEPT,
-                  "<-----Intercept Self reach step = %d. exhaust reach step = %d ",
-                  M_self_step,
-                  M_self_exhaust_step );
+    RCSC_DLOG_TEXT( Logger::INTERCEPT,
+                    "<-----Intercept player cache. total hit=%ld miss=%ld",
+                    M_cache_hit_count, M_cache_miss_count );
+    RCSC_DLOG_TEXT( Logger::INTERCEPT,
+                    "<-----Intercept Self reach step = %d. exhaust reach step = %d ",
+                    M_self_step,
+                    M_self_exhaust_step );
     if ( M_first_teammate )
     {
-        dlog.addText( Logger::INTERCEPT,
-                      "<-----Intercept Teammate  fastest reach step = %d."
-                      " teammate %d (%.1f %.1f)",
-                      M_teammate_step,
-                      M_first_teammate->unum(),
-                      M_first_teammate->pos().x,
-                      M_first_teammate->pos().y );
+        RCSC_DLOG_TEXT( Logger::INTERCEPT,
+                        "<-----Intercept Teammate  fastest reach step = %d."
+                        " teammate %d (%.1f %.1f)",
+                        M_teammate_step,
+                        M_first_teammate->unum(),
+                        M_first_teammate->pos().x,
+                        M_first_teammate->pos().y );
 
     }
 
     if ( M_second_teammate )
     {
-        dlog.addText( Logger::INTERCEPT,
-                      "<-----Intercept Teammate  2nd     reach step = %d."
-                      " teammate %d (%.1f %.1f)",
-                      M_second_teammate_step,
-                      M_second_teammate->unum(),
-                      M_second_teammate->pos().x,
-                      M_second_teammate->pos().y );
+        RCSC_DLOG_TEXT( Logger::INTERCEPT,
+                        "<-----Intercept Teammate  2nd     reach step = %d."
+                        " teammate %d (%.1f %.1f)",
+                        M_second_teammate_step,
+                        M_second_teammate->unum(),
+                        M_second_teammate->pos().x,
+                        M_second_teammate->pos().y );
     }
 
     if ( M_first_opponent )
     {
-        dlog.addText( Logger::INTERCEPT,
-                      "<-----Intercept Opponent  fastest reach step = %d."
-                      " opponent %d (%.1f %.1f)",
-                      M_opponent_step,
-                      M_first_opponent->unum(),
-                      M_first_opponent->pos().x,
-                      M_first_opponent->pos().y );
+        RCSC_DLOG_TEXT( Logger::INTERCEPT,
+                        "<-----Intercept Opponent  fastest reach step = %d."
+                        " opponent %d (%.1f %.1f)",
+                        M_opponent_step,
+                        M_first_opponent->unum(),
+                        M_first_opponent->pos().x,
+                        M_first_opponent->pos().y );
     }
 
     if ( M_second_opponent )
     {
-        dlog.addText( Logger::INTERCEPT,
-                      "<-----Intercept Opponent  2nd     reach step = %d."
-                      " opponent %d (%.1f %.1f)",
-                      M_second_opponent_step,
-                      M_second_opponent->unum(),
-                      M_second_opponent->pos().x,
-                      M_second_opponent->pos().y );
+        RCSC_DLOG_TEXT( Logger::INTERCEPT,
+                        "<-----Intercept Opponent  2nd     reach step = %d."
+                        " opponent %d (%.1f %.1f)",
+                        M_second_opponent_step,
+                        M_second_opponent->unum(),
+                        M_second_opponent->pos().x,
+                        M_second_opponent->pos().y );
     }
 
 #ifdef DEBUG_PRINT
-    dlog.addText( Logger::INTERCEPT,
-                  __FILE__":(update) elapsed %.3f [ms]", timer.elapsedReal() );
+    RCSC_DLOG_TEXT( Logger::INTERCEPT,
+                    __FILE__":(update) elapsed %.3f [ms]", timer.elapsedReal() );
 #endif
 }
 
@@ -258,13 +329,13 @@ InterceptTable::hearTeammate( const WorldModel & wm,
 
         M_player_map[ target ] = step;
 
-        dlog.addText( Logger::INTERCEPT,
-                      "<----- Hear Intercept Teammate  fastest reach step = %d."
-                      " teammate %d (%.1f %.1f)",
-                      M_teammate_step,
-                      M_first_teammate->unum(),
-                      M_first_teammate->pos().x,
-                      M_first_teammate->pos().y );
+        RCSC_DLOG_TEXT( Logger::INTERCEPT,
+                        "<----- Hear Intercept Teammate  fastest reach step = %d."
+                        " teammate %d (%.1f %.1f)",
+                        M_teammate_step,
+                        M_first_teammate->unum(),
+                        M_first_teammate->pos().x,
+                        M_first_teammate->pos().y );
     }
 }
 
@@ -281,22 +352,22 @@ InterceptTable::hearOpponent( const WorldModel & wm,
     {
         if ( step >= M_opponent_step )
         {
-            dlog.addText( Logger::INTERCEPT,
-                          "<----- Hear Intercept Opponent. no update."
-                          " exist faster reach step %d >= %d",
-                          step, M_opponent_step );
+            RCSC_DLOG_TEXT( Logger::INTERCEPT,
+                            "<----- Hear Intercept Opponent. no update."
+                            " exist faster reach step %d >= %d",
+                            step, M_opponent_step );
             return;
         }
 
         if ( M_first_opponent->unum() == unum
              && M_first_opponent->posCount() == 0 )
         {
-            dlog.addText( Logger::INTERCEPT,
-                          "<----- Hear Intercept Opponent . no update."
-                          " opponent %d (%.1f %.1f) is seen",
-                          M_first_opponent->unum(),
-                          M_first_opponent->pos().x,
-                          M_first_opponent->pos().y );
+            RCSC_DLOG_TEXT( Logger::INTERCEPT,
+                            "<----- Hear Intercept Opponent . no update."
+                            " opponent %d (%.1f %.1f) is seen",
+                            M_first_opponent->unum(),
+                            M_first_opponent->pos().x,
+                            M_first_opponent->pos().y );
             return;
         }
     }
@@ -320,13 +391,13 @@ InterceptTable::hearOpponent( const WorldModel & wm,
 
         M_player_map[ p ] = step;
 
-        dlog.addText( Logger::INTERCEPT,
-                      "<----- Hear Intercept Opponent  fastest reach step = %d."
-                      " opponent %d (%.1f %.1f)",
-                      M_opponent_step,
-                      M_first_opponent->unum(),
-                      M_first_opponent->pos().x,
-                      M_first_opponent->pos().y );
+        RCSC_DLOG_TEXT( Logger::INTERCEPT,
+                        "<----- Hear Intercept Opponent  fastest reach step = %d."
+                        " opponent %d (%.1f %.1f)",
+                        M_opponent_step,
+                        M_first_opponent->unum(),
+                        M_first_opponent->pos().x,
+                        M_first_opponent->pos().y );
     }
 }
 
@@ -339,8 +410,8 @@ InterceptTable::predictSelf( const WorldModel & wm )
 {
     if ( wm.self().isKickable() )
     {
-        dlog.addText( Logger::INTERCEPT,
-                      "Intercept Self. already kickable. no estimation loop!" );
+        RCSC_DLOG_TEXT( Logger::INTERCEPT,
+                        "Intercept Self. already kickable. no estimation loop!" );
         M_self_step = 0;
         M_self_exhaust_step = 0;
         return;
@@ -360,8 +431,8 @@ InterceptTable::predictSelf( const WorldModel & wm )
                   << wm.time()
                   << ": (InterceptTable::predictSelf) Unexpected reach. empty result."
                   << std::endl;
-        dlog.addText( Logger::INTERCEPT,
-                      __FILE__":(InterceptTable::predictSelf) empty" );
+        RCSC_DLOG_TEXT( Logger::INTERCEPT,
+                        __FILE__":(InterceptTable::predictSelf) empty" );
         // if self cache is empty,
         // the inertia final point of the ball will be set as an interception point
         return;
@@ -388,9 +459,9 @@ InterceptTable::predictSelf( const WorldModel & wm )
         }
     }
 
-    dlog.addText( Logger::INTERCEPT,
-                  "Intercept Self. solution size = %d",
-                  M_self_results.size() );
+    RCSC_DLOG_TEXT( Logger::INTERCEPT,
+                    "Intercept Self. solution size = %d",
+                    M_self_results.size() );
 
     M_self_step = min_step;
     M_self_exhaust_step = exhaust_min_step;
@@ -403,61 +474,105 @@ InterceptTable::predictSelf( const WorldModel & wm )
 
 */
 void
-InterceptTable::predictTeammate( const WorldModel & wm )
+InterceptTable::simulateGroup( const WorldModel & wm,
+                               const PlayerObject::Cont & players,
+                               const PlayerObject * kickable,
+                               const int pos_count_thr,
+                               const char * label,
+                               PlayerGroupResult * result ) const
 {
-    int min_step = 1000;
-    int second_min_step = 1000;
-
-    if ( wm.kickableTeammate() )
+    if ( kickable )
     {
-        M_teammate_step = 0;
-        min_step = 0;
-        M_first_teammate = wm.kickableTeammate();
-
-        dlog.addText( Logger::INTERCEPT,
-                      "Intercept Teammate. exist kickable teammate" );
-        dlog.addText( Logger::INTERCEPT,
-                      "---> set fastest teammate %d (%.1f %.1f)",
-                      M_first_teammate->unum(),
-                      M_first_teammate->pos().x, M_first_teammate->pos().y );
+        RCSC_DLOG_TEXT( Logger::INTERCEPT,
+                        "Intercept %s. exist kickable %s", label, label );
+        RCSC_DLOG_TEXT( Logger::INTERCEPT,
+                        "---> set fastest %s %d (%.1f %.1f)",
+                        label,
+                        kickable->unum(),
+                        kickable->pos().x, kickable->pos().y );
     }
 
-    InterceptSimulatorPlayer sim( wm.ball().pos(),
-                                  ( wm.kickableOpponent() ? Vector2D( 0.0, 0.0 ) : wm.ball().vel() ) );
+    result->players_.reserve( players.size() );
 
-    for ( const PlayerObject * t : wm.teammatesFromBall() )
+    for ( const PlayerObject * p : players )
     {
-        if ( t == wm.kickableTeammate() )
+        if ( p == kickable )
         {
-            M_player_map[ t ] = 0;
             continue;
         }
 
-        if ( t->posCount() >= 10 )
+        if ( p->posCount() >= pos_count_thr )
         {
-            dlog.addText( Logger::INTERCEPT,
-                          "Intercept Teammate %d.(%.1f %.1f) Low accuracy %d. skip...",
-                          t->unum(),
-                          t->pos().x, t->pos().y,
-                          t->posCount() );
+            RCSC_DLOG_TEXT( Logger::INTERCEPT,
+                            "Intercept %s %d.(%.1f %.1f) Low accuracy %d. skip...",
+                            label,
+                            p->unum(),
+                            p->pos().x, p->pos().y,
+                            p->posCount() );
             continue;
         }
 
-        int step = sim.simulate( wm, *t, false );
+        result->players_.push_back( p );
+    }
+
+    // the simulator and the stopped ball trajectory are built on the stack.
+    // no memory is allocated in each cycle.
+    if ( wm.kickableOpponent() )
+    {
+        // the ball is regarded as stopped.
+        const BallTrajectoryCache stopped_ball( wm.ball().pos(), Vector2D( 0.0, 0.0 ) );
+        const InterceptSimulatorPlayer sim( stopped_ball );
+        simulatePlayers( wm, sim, result );
+    }
+    else
+    {
+        const InterceptSimulatorPlayer sim( wm.ballTrajectory() );
+        simulatePlayers( wm, sim, result );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+InterceptTable::predictTeammate( const WorldModel & wm,
+                                 const PlayerGroupResult & result )
+{
+    int min_step = 1000;
+    int second_min_step = 1000;
+
+    if ( wm.kickableTeammate() )
+    {
+        M_teammate_step = 0;
+        min_step = 0;
+        M_first_teammate = wm.kickableTeammate();
+        M_player_map[ wm.kickableTeammate() ] = 0;
+    }
+
+    M_next_player_cache.insert( result.next_cache_.begin(), result.next_cache_.end() );
+    M_cache_hit_count += result.cache_hit_count_;
+    M_cache_miss_count += result.cache_miss_count_;
+
+    for ( std::size_t i = 0; i < result.players_.size(); ++i )
+    {
+        const PlayerObject * t = result.players_[i];
+
+        int step = result.steps_[i];
         if ( t->goalie() )
         {
-            M_our_goalie_step = sim.simulate( wm, *t, true );
+            M_our_goalie_step = result.goalie_steps_[i];
             if ( step > M_our_goalie_step )
             {
                 step = M_our_goalie_step;
             }
         }
 
-        dlog.addText( Logger::INTERCEPT,
-                      "---> Teammate %d.(%.1f %.1f) step=%d",
-                      t->unum(),
-                      t->pos().x, t->pos().y,
-                      step );
+        RCSC_DLOG_TEXT( Logger::INTERCEPT,
+                        "---> Teammate %d.(%.1f %.1f) step=%d",
+                        t->unum(),
+                        t->pos().x, t->pos().y,
+                        step );
 
         if ( step < second_min_step )
         {
@@ -490,7 +605,8 @@ InterceptTable::predictTeammate( const WorldModel & wm )
 
 */
 void
-InterceptTable::predictOpponent( const WorldModel & wm )
+InterceptTable::predictOpponent( const WorldModel & wm,
+                                 const PlayerGroupResult & result )
 {
     int min_step = 1000;
     int second_min_step = 1000;
@@ -500,40 +616,21 @@ InterceptTable::predictOpponent( const WorldModel & wm )
         M_opponent_step = 0;
         min_step = 0;
         M_first_opponent = wm.kickableOpponent();
-
-        dlog.addText( Logger::INTERCEPT,
-                      "Intercept Opponent. exist kickable opponent" );
-        dlog.addText( Logger::INTERCEPT,
-                      "---> set fastest opponent %d (%.1f %.1f)",
-                      M_first_opponent->unum(),
-                      M_first_opponent->pos().x, M_first_opponent->pos().y );
+        M_player_map[ wm.kickableOpponent() ] = 0;
     }
 
-    InterceptSimulatorPlayer sim( wm.ball().pos(),
-                                  ( wm.kickableOpponent() ? Vector2D( 0.0, 0.0 ) : wm.ball().vel() ) );
+    M_next_player_cache.insert( result.next_cache_.begin(), result.next_cache_.end() );
+    M_cache_hit_count += result.cache_hit_count_;
+    M_cache_miss_count += result.cache_miss_count_;
 
-    for ( const PlayerObject * o : wm.opponentsFromBall() )
+    for ( std::size_t i = 0; i < result.players_.size(); ++i )
     {
-        if ( o == wm.kickableOpponent() )
-        {
-            M_player_map[ o ] = 0;
-            continue;
-        }
+        const PlayerObject * o = result.players_[i];
 
-        if ( o->posCount() >= 15 )
-        {
-            dlog.addText( Logger::INTERCEPT,
-                          "Intercept Opponent %d.(%.1f %.1f) Low accuracy %d. skip...",
-                          o->unum(),
-                          o->pos().x, o->pos().y,
-                          o->posCount() );
-            continue;
-        }
-
-        int step = sim.simulate( wm, *o, false );
+        int step = result.steps_[i];
         if ( o->goalie() )
         {
-            int goalie_step = sim.simulate( wm, *o, true );
+            int goalie_step = result.goalie_steps_[i];
             if ( goalie_step > 0
                  && step > goalie_step )
             {
@@ -541,11 +638,11 @@ InterceptTable::predictOpponent( const WorldModel & wm )
             }
         }
 
-        dlog.addText( Logger::INTERCEPT,
-                      "---> Opponent.%d (%.1f %.1f) step=%d",
-                      o->unum(),
-                      o->pos().x, o->pos().y,
-                      step );
+        RCSC_DLOG_TEXT( Logger::INTERCEPT,
+                        "---> Opponent.%d (%.1f %.1f) step=%d",
+                        o->unum(),
+                        o->pos().x, o->pos().y,
+                        step );
 
         if ( step < second_min_step )
         {
@@ -573,4 +670,155 @@ InterceptTable::predictOpponent( const WorldModel & wm )
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+InterceptTable::simulatePlayers( const WorldModel & wm,
+                                 const InterceptSimulatorPlayer & sim,
+                                 PlayerGroupResult * result ) const
+{
+    const PlayerObject::Cont & players = result->players_;
+    std::vector< int > & steps = result->steps_;
+    std::vector< int > & goalie_steps = result->goalie_steps_;
+
+    steps.assign( players.size(), 1000 );
+    goalie_steps.assign( players.size(), 1000 );
+    result->next_cache_.reserve( players.size() );
+
+    PlayerObject::Cont changed_players;
+    std::vector< std::size_t > changed_index;
+    std::vector< InterceptSimulatorPlayer::Input > changed_input;
+
+    for ( std::size_t i = 0; i < players.size(); ++i )
+    {
+        const PlayerObject * p = players[i];
+        const InterceptSimulatorPlayer::Input input = InterceptSimulatorPlayer::create_input( wm.ourSide(), *p );
+
+        std::map< const PlayerObject *, PlayerCache >::const_iterator it = M_player_cache.find( p );
+        if ( it != M_player_cache.end()
+             && it->second.input_.equals( input ) )
+        {
+            steps[i] = it->second.step_;
+            goalie_steps[i] = it->second.goalie_step_;
+            result->next_cache_.push_back( *it );
+            ++result->cache_hit_count_;
+            continue;
+        }
+
+        changed_players.push_back( p );
+        changed_index.push_back( i );
+        changed_input.push_back( input );
+    }
+
+    if ( changed_players.empty() )
+    {
+        return;
+    }
+
+    std::vector< int > changed_steps;
+    sim.simulate( wm, changed_players, false, &changed_steps );
+
+    for ( std::size_t j = 0; j < changed_players.size(); ++j )
+    {
+        const PlayerObject * p = changed_players[j];
+
+        PlayerCache cache;
+        cache.input_ = changed_input[j];
+        cache.step_ = changed_steps[j];
+        cache.goalie_step_ = ( p->goalie()
+                               ? sim.simulate( wm, *p, true )
+                               : 1000 );
+
+        steps[changed_index[j]] = cache.step_;
+        goalie_steps[changed_index[j]] = cache.goalie_step_;
+        result->next_cache_.push_back( std::make_pair( p, cache ) );
+        ++result->cache_miss_count_;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+InterceptTable::predictKicks( const WorldModel & wm,
+                              const Vector2D & ball_pos,
+                              const std::vector< Vector2D > & ball_vels,
+                              std::vector< KickReach > * result,
+                              std::vector< int > * steps,
+                              PlayerObject::Cont * players ) const
+{
+    PlayerObject::Cont candidates;
+    candidates.reserve( wm.teammatesFromBall().size() + wm.opponentsFromBall().size() );
+    add_accurate_players( wm.teammatesFromBall(), 10, &candidates );
+    const std::size_t n_teammates = candidates.size();
+    add_accurate_players( wm.opponentsFromBall(), 15, &candidates );
+
+    result->resize( ball_vels.size() );
+    if ( steps )
+    {
+        steps->assign( ball_vels.size() * candidates.size(), 1000 );
+    }
+
+    // the decay tables of the trajectory are created only once.
+    BallTrajectoryCache ball;
+    std::vector< int > row;
+
+    for ( std::size_t k = 0; k < ball_vels.size(); ++k )
+    {
+        ball.update( wm.time(), ball_pos, ball_vels[k] );
+        const InterceptSimulatorPlayer sim( ball );
+        sim.simulate( wm, candidates, false, &row );
+
+        KickReach & reach = ( *result )[k];
+        reach.teammate_step_ = 1000;
+        reach.opponent_step_ = 1000;
+        reach.teammate_ = nullptr;
+        reach.opponent_ = nullptr;
+
+        for ( std::size_t i = 0; i < candidates.size(); ++i )
+        {
+            const PlayerObject * p = candidates[i];
+            const bool teammate = ( i < n_teammates );
+
+            int step = row[i];
+            if ( p->goalie() )
+            {
+                const int goalie_step = sim.simulate( wm, *p, true );
+                if ( ( teammate || goalie_step > 0 )
+                     && step > goalie_step )
+                {
+                    step = goalie_step;
+                }
+            }
+
+            if ( steps )
+            {
+                ( *steps )[k * candidates.size() + i] = step;
+            }
+
+            if ( teammate )
+            {
+                if ( step < reach.teammate_step_ )
+                {
+                    reach.teammate_step_ = step;
+                    reach.teammate_ = p;
+                }
+            }
+            else if ( step < reach.opponent_step_ )
+            {
+                reach.opponent_step_ = step;
+                reach.opponent_ = p;
+            }
+        }
+    }
+
+    if ( players )
+    {
+        players->swap( candidates );
+    }
+}
+
 }
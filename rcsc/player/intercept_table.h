@@ -33,6 +33,8 @@
 #define RCSC_PLAYER_INTERCEPT_TABLE_H
 
 #include <rcsc/player/intercept.h>
+#include <rcsc/player/intercept_simulator_player.h>
+#include <rcsc/player/player_object.h>
 #include <rcsc/geom/vector_2d.h>
 #include <rcsc/game_time.h>
 #include <vector>
@@ -53,6 +55,19 @@ class WorldModel;
   \brief interception info holder for all players
 */
 class InterceptTable {
+public:
+
+    /*!
+      \struct KickReach
+      \brief the fastest players for one kick candidate
+    */
+    struct KickReach {
+        int teammate_step_; //!< reach step of the fastest teammate. 1000 if no teammate.
+        int opponent_step_; //!< reach step of the fastest opponent. 1000 if no opponent.
+        const PlayerObject * teammate_; //!< fastest teammate. NULL if no teammate.
+        const PlayerObject * opponent_; //!< fastest opponent. NULL if no opponent.
+    };
+
 private:
 
     //! last updated time
@@ -91,6 +106,48 @@ private:
     //! all players' intercept step container. key: pointer, value: step value
     std::map< const AbstractPlayerObject *, int > M_player_map;
 
+    /*!
+      \struct PlayerCache
+      \brief previous simulation result of each player
+    */
+    struct PlayerCache {
+        InterceptSimulatorPlayer::Input input_; //!< simulation input values
+        int step_; //!< normal mode result
+        int goalie_step_; //!< goalie mode result. 1000 if not a goalie.
+    };
+
+    //! ball position used by the previous player simulations
+    Vector2D M_cache_ball_pos;
+    //! ball velocity used by the previous player simulations
+    Vector2D M_cache_ball_vel;
+    //! previous player results. key: pointer, value: result with its input values
+    std::map< const PlayerObject *, PlayerCache > M_player_cache;
+    //! player results updated in the current update
+    std::map< const PlayerObject *, PlayerCache > M_next_player_cache;
+
+    //! the number of players that reused the previous result
+    long M_cache_hit_count;
+    //! the number of players that were simulated
+    long M_cache_miss_count;
+
+    /*!
+      \struct PlayerGroupResult
+      \brief simulation result of the teammates or the opponents
+    */
+    struct PlayerGroupResult {
+        PlayerObject::Cont players_; //!< simulated players
+        std::vector< int > steps_; //!< normal mode results
+        std::vector< int > goalie_steps_; //!< goalie mode results
+        std::vector< std::pair< const PlayerObject *, PlayerCache > > next_cache_; //!< cache entries for the next update
+        long cache_hit_count_; //!< the number of reused results
+        long cache_miss_count_; //!< the number of simulated players
+
+        PlayerGroupResult()
+            : cache_hit_count_( 0 ),
+              cache_miss_count_( 0 )
+          { }
+    };
+
     // not used
     InterceptTable( const InterceptTable & ) = delete;
     InterceptTable & operator=( const InterceptTable & ) = delete;
@@ -111,6 +168,9 @@ public:
     /*!
       \brief set intercept simuator.
       \param self pointer to the self intercept simulator
+
+      The self simulator may run concurrently with the player simulations
+      when the TaskPool has workers, so it must not modify any shared state.
      */
     void setSimulator( std::shared_ptr< InterceptSimulatorSelf > self );
 
@@ -228,6 +288,47 @@ public:
           return M_player_map;
       }
 
+    /*!
+      \brief get the number of player predictions that reused the previous result
+      \return total count since the start
+     */
+    long cacheHitCount() const
+      {
+          return M_cache_hit_count;
+      }
+
+    /*!
+      \brief get the number of player predictions that were simulated
+      \return total count since the start
+     */
+    long cacheMissCount() const
+      {
+          return M_cache_miss_count;
+      }
+
+    /*!
+      \brief predict the reach steps of the players for the batch of kick candidates.
+      \param wm const reference to the world model
+      \param ball_pos ball position when the ball is kicked
+      \param ball_vels first ball velocities of the kick candidates
+      \param result pointer to the result container. the order is same as ball_vels.
+      \param steps pointer to the reach step matrix (ball_vels.size() x players->size(),
+      row-major). may be NULL.
+      \param players pointer to the container of the simulated players. the order is
+      same as the columns of steps. may be NULL.
+
+      The candidate players are selected by the same rule as update(), and the
+      agent itself is not included. One ball trajectory cache is reused for all
+      candidates, and the players are simulated by the batch kernel of
+      InterceptSimulatorPlayer. This method does not modify the table.
+    */
+    void predictKicks( const WorldModel & wm,
+                       const Vector2D & ball_pos,
+                       const std::vector< Vector2D > & ball_vels,
+                       std::vector< KickReach > * result,
+                       std::vector< int > * steps = nullptr,
+                       PlayerObject::Cont * players = nullptr ) const;
+
 private:
     /*!
       \brief clear all cached data
@@ -241,16 +342,46 @@ private:
     void predictSelf( const WorldModel & wm );
 
     /*!
-      \predict teammate interception
+      \brief simulate the teammates or the opponents. this method does not modify the table.
+      \param wm const reference to the world model
+      \param players candidate players sorted by distance from the ball
+      \param kickable kickable player in the group. may be null.
+      \param pos_count_thr players whose posCount() is this value or more are skipped.
+      \param label group name for the debug log
+      \param result pointer to the result variable
+    */
+    void simulateGroup( const WorldModel & wm,
+                        const PlayerObject::Cont & players,
+                        const PlayerObject * kickable,
+                        const int pos_count_thr,
+                        const char * label,
+                        PlayerGroupResult * result ) const;
+
+    /*!
+      \brief set teammate interception result
+      \param wm const reference to the world model
+      \param result simulation result of teammates
+    */
+    void predictTeammate( const WorldModel & wm,
+                          const PlayerGroupResult & result );
+
+    /*!
+      \brief set opponent interception result
       \param wm const reference to the world model
+      \param result simulation result of opponents
     */
-    void predictTeammate( const WorldModel & wm );
+    void predictOpponent( const WorldModel & wm,
+                          const PlayerGroupResult & result );
 
     /*!
-      \predict opponent interception
+      \brief get the reach steps of players. unchanged players reuse the previous results.
       \param wm const reference to the world model
+      \param sim player intercept simulator
+      \param result pointer to the result variable. players_ must be set.
     */
-    void predictOpponent( const WorldModel & wm );
+    void simulatePlayers( const WorldModel & wm,
+                          const InterceptSimulatorPlayer & sim,
+                          PlayerGroupResult * result ) const;
 };
 
 }
@@ -43,10 +43,12 @@
 #include <rcsc/common/logger.h>
 #include <rcsc/geom/sector_2d.h>
 #include <rcsc/time/timer.h>
+#include <rcsc/util/memory_accounting.h>
 #include <rcsc/math_util.h>
 
 #include <algorithm>
 #include <random>
+#include <cmath>
 
 using std::min;
 using std::max;
@@ -59,7 +61,117 @@ using std::max;
 #define USE_OBJECT_TABLE
 
 namespace {
-static int g_filter_count = 0;
+thread_local int g_filter_count = 0;
+
+/*!
+  \brief get the object table shared by all localization instances in the process.
+  the table is immutable after its creation.
+*/
+const rcsc::ObjectTable &
+shared_object_table()
+{
+    static const rcsc::ObjectTable s_table;
+    static const bool s_registered = ( rcsc::MemoryAccounting::instance().addProbe( "object_table",
+                                                                                    []() { return s_table.memoryUsage(); } ),
+                                       true );
+    (void)s_registered;
+    return s_table;
+}
+
+/*!
+  \struct FaceDirTable
+  \brief precomputed angles used by the face direction estimation.
+  the server quantizes the seen directions to 1 degree, so the unit vectors
+  of all possible seen directions can be tabulated.
+*/
+struct FaceDirTable {
+    //! the maximum absolute value of the tabulated seen direction
+    static constexpr int MAX_DIR = 180;
+
+    //! global angle of the normal vector of each line
+    double line_normal_[rcsc::Line_Unknown];
+
+    //! true if the marker exists in the landmark map
+    bool marker_valid_[rcsc::Marker_Unknown];
+
+    //! global direction of the vector from the second marker to the first marker
+    double marker_gap_dir_[rcsc::Marker_Unknown][rcsc::Marker_Unknown];
+
+    //! cosine of each integer seen direction, indexed by ( dir + MAX_DIR )
+    double dir_cos_[MAX_DIR * 2 + 1];
+    //! sine of each integer seen direction, indexed by ( dir + MAX_DIR )
+    double dir_sin_[MAX_DIR * 2 + 1];
+
+    explicit
+    FaceDirTable( const rcsc::ObjectTable & object_table )
+      {
+          line_normal_[rcsc::Line_Left] = 180.0;
+          line_normal_[rcsc::Line_Right] = 0.0;
+          line_normal_[rcsc::Line_Top] = -90.0;
+          line_normal_[rcsc::Line_Bottom] = 90.0;
+
+          std::fill( &marker_valid_[0], &marker_valid_[0] + rcsc::Marker_Unknown, false );
+          for ( const auto & v : object_table.landmarkMap() )
+          {
+              if ( 0 <= v.first && v.first < rcsc::Marker_Unknown )
+              {
+                  marker_valid_[v.first] = true;
+              }
+          }
+
+          for ( int i = 0; i < rcsc::Marker_Unknown; ++i )
+          {
+              for ( int j = 0; j < rcsc::Marker_Unknown; ++j )
+              {
+                  marker_gap_dir_[i][j] = 0.0;
+                  if ( marker_valid_[i] && marker_valid_[j] )
+                  {
+                      const rcsc::Vector2D gap = ( object_table.landmarkMap().at( static_cast< rcsc::MarkerID >( i ) )
+                                                   - object_table.landmarkMap().at( static_cast< rcsc::MarkerID >( j ) ) );
+                      marker_gap_dir_[i][j] = gap.th().degree();
+                  }
+              }
+          }
+
+          for ( int d = -MAX_DIR; d <= MAX_DIR; ++d )
+          {
+              const rcsc::AngleDeg angle( static_cast< double >( d ) );
+              dir_cos_[d + MAX_DIR] = angle.cos();
+              dir_sin_[d + MAX_DIR] = angle.sin();
+          }
+      }
+
+    /*!
+      \brief get the relative position of the seen object.
+      \param dist unquantized distance
+      \param dir seen direction
+      \return relative position
+    */
+    rcsc::Vector2D relativePos( const double dist,
+                                const double dir ) const
+      {
+          const double idx = dir + MAX_DIR;
+          if ( 0.0 <= idx && idx <= MAX_DIR * 2
+               && idx == std::floor( idx ) )
+          {
+              const int i = static_cast< int >( idx );
+              return rcsc::Vector2D( dist * dir_cos_[i], dist * dir_sin_[i] );
+          }
+
+          return rcsc::Vector2D::polar2vector( dist, dir );
+      }
+};
+
+/*!
+  \brief get the face direction table shared by all localization instances in the process.
+*/
+const FaceDirTable &
+shared_face_dir_table()
+{
+    static const FaceDirTable s_table( shared_object_table() );
+    return s_table;
+}
+
 }
 
 namespace rcsc {
@@ -69,25 +181,79 @@ namespace rcsc {
   \brief localization implementation
 */
 class LocalizationDefault::Impl {
+public:
+
+    //! the maximum number of particles. generated grid never exceeds this size.
+    static constexpr int MAX_PARTICLES = 16 * 32;
+    //! the particles are resampled if the number of survivors is less than this value.
+    static constexpr int MIN_PARTICLES = 50;
+    //! the maximum number of marker sectors evaluated at once
+    static constexpr int MAX_SECTORS = 32;
 
 private:
 
-    //! object distance table
-    ObjectTable M_object_table;
+    //! object distance table shared by all instances
+    const ObjectTable & M_object_table;
 
     //! grid point container
     std::vector< Vector2D > M_points;
 
+    //! random engine for the resampling. each agent has its own engine.
+    std::mt19937 M_engine;
+
+    //! if true, localizeSelf() uses the particle filter.
+    bool M_particle_mode;
+
+    //
+    // particle filter buffers (SoA)
+    //
+
+    int M_particle_count; //!< the number of valid particles
+    alignas( 32 ) double M_px[MAX_PARTICLES]; //!< particle x coordinates
+    alignas( 32 ) double M_py[MAX_PARTICLES]; //!< particle y coordinates
+    alignas( 32 ) int M_votes[MAX_PARTICLES]; //!< the number of sectors that contain each particle
+
+    int M_sector_count; //!< the number of valid sectors
+    alignas( 32 ) double M_sx[MAX_SECTORS]; //!< marker x coordinates
+    alignas( 32 ) double M_sy[MAX_SECTORS]; //!< marker y coordinates
+    alignas( 32 ) double M_min_r2[MAX_SECTORS]; //!< squared min distance from the marker
+    alignas( 32 ) double M_max_r2[MAX_SECTORS]; //!< squared max distance from the marker
+    alignas( 32 ) double M_dir_x[MAX_SECTORS]; //!< x of the unit vector from the marker to the sector center
+    alignas( 32 ) double M_dir_y[MAX_SECTORS]; //!< y of the unit vector from the marker to the sector center
+    alignas( 32 ) double M_cos_half[MAX_SECTORS]; //!< cosine of the half angle width
+
 public:
     /*!
       \brief create landmark map and object table
     */
     Impl()
-        : M_object_table()
+        : M_object_table( shared_object_table() ),
+          M_engine( 49827140 ),
+          M_particle_mode( false ),
+          M_particle_count( 0 ),
+          M_sector_count( 0 )
       {
           M_points.reserve( 1024 );
       }
 
+    /*!
+      \brief set the localization mode
+      \param on if true, the particle filter is used.
+    */
+    void setParticleMode( const bool on )
+      {
+          M_particle_mode = on;
+      }
+
+    /*!
+      \brief check the localization mode
+      \return true if the particle filter is used.
+    */
+    bool particleMode() const
+      {
+          return M_particle_mode;
+      }
+
     /*!
       \brief get object table
       \return const reference to the object table instance
@@ -182,6 +348,98 @@ public:
                          const double & self_face,
                          const double & self_face_err );
 
+    //
+    // particle filter
+    //
+
+    /*!
+      \brief localize self position by the particle filter
+      \param wm world model
+      \param see analyzed see info
+      \param self_face agent's global face angle
+      \param self_face_err agent's global face angle error
+      \param self_pos pointer to the variable to store the localized self position
+      \param self_pos_err pointer to the variable to store the localized self position error
+      \return if failed, returns false
+    */
+    bool localizeByParticles( const WorldModel & wm,
+                              const VisualSensor & see,
+                              const double self_face,
+                              const double self_face_err,
+                              Vector2D * self_pos,
+                              Vector2D * self_pos_err );
+
+    /*!
+      \brief get the candidate sector of self position by one marker
+      \param wm world model
+      \param marker seen marker info
+      \param id estimated marker's Id
+      \param self_face agent's global face angle
+      \param self_face_err agent's global face angle error
+      \param marker_pos pointer to the variable to store the marker position
+      \param ave_dist pointer to the variable to store the mean distance
+      \param dist_error pointer to the variable to store the distance error
+      \param ave_dir pointer to the variable to store the direction from the marker
+      \param dir_error pointer to the variable to store the direction error
+      \return if the marker is not found or its distance is illegal, returns false
+    */
+    bool getSectorRange( const WorldModel & wm,
+                         const VisualSensor::MarkerT & marker,
+                         const MarkerID id,
+                         const double self_face,
+                         const double self_face_err,
+                         Vector2D * marker_pos,
+                         double * ave_dist,
+                         double * dist_error,
+                         double * ave_dir,
+                         double * dir_error );
+
+    /*!
+      \brief generate the grid particles in the sector of the nearest marker
+      \return the number of generated particles
+    */
+    int generateParticles( const WorldModel & wm,
+                           const VisualSensor::MarkerT & marker,
+                           const MarkerID id,
+                           const double self_face,
+                           const double self_face_err );
+
+    /*!
+      \brief add the candidate sector to the evaluation buffer
+      \return if the sector is not available, returns false
+    */
+    bool addSector( const WorldModel & wm,
+                    const VisualSensor::MarkerT & marker,
+                    const MarkerID id,
+                    const double self_face,
+                    const double self_face_err );
+
+    /*!
+      \brief count the sectors that contain each particle, for all sectors at once.
+      \param first the index of the first evaluated particle
+    */
+    void evaluateParticles( const int first );
+
+    /*!
+      \brief erase the particles that are not contained by the most sectors
+      \return the number of sectors that contain the survivors
+    */
+    int selectParticles();
+
+    /*!
+      \brief add jittered copies of the survivors if the particles are too few
+      \return the index of the first added particle
+    */
+    int resampleParticles();
+
+    /*!
+      \brief calculate average point and error with all particles.
+      \param ave_pos pointer to the variable to store the averaged point
+      \param ave_err pointer to the variable to store the averaged point error
+    */
+    void averageParticles( Vector2D * ave_pos,
+                           Vector2D * ave_err ) const;
+
     //
     // utility
     //
@@ -322,26 +580,17 @@ LocalizationDefault::Impl::getFaceDirByLines( const VisualSensor::LineCont & lin
         angle -= 90.0;
     }
 
-    switch ( lines.front().id_ ) {
-    case Line_Left:
-        angle = 180.0 - angle;
-        break;
-    case Line_Right:
-        angle = 0.0 - angle;
-        break;
-    case Line_Top:
-        angle = -90.0 - angle;
-        break;
-    case Line_Bottom:
-        angle = 90.0 - angle;
-        break;
-    default:
+    if ( lines.front().id_ < 0
+         || Line_Unknown <= lines.front().id_ )
+    {
         std::cerr << __FILE__ << ": " << __LINE__
                   << " Invalid line type " << lines.front().id_
                   << std::endl;
         return angle;
     }
 
+    angle = shared_face_dir_table().line_normal_[lines.front().id_] - angle;
+
     // out of field
     if ( lines.size() >= 2 )
     {
@@ -842,8 +1091,7 @@ LocalizationDefault::Impl::resamplePoints( const WorldModel & wm,
                                            const double & self_face,
                                            const double & self_face_err )
 {
-    static std::mt19937 s_engine( 49827140 );
-    static const size_t max_count = 50;
+    static const size_t max_count = MIN_PARTICLES;
 
     const std::size_t count = M_points.size();
 
@@ -878,8 +1126,8 @@ LocalizationDefault::Impl::resamplePoints( const WorldModel & wm,
 
     for ( size_t i = count; i < max_count; ++i )
     {
-        M_points.push_back( M_points[index_dst( s_engine )]
-                            + Vector2D( xy_dst( s_engine ), xy_dst( s_engine ) ) );
+        M_points.push_back( M_points[index_dst( M_engine )]
+                            + Vector2D( xy_dst( M_engine ), xy_dst( M_engine ) ) );
 #ifdef DEBUG_PRINT_SHAPE
         dlog.addCircle( Logger::WORLD,
                         M_points.back(), 0.01,
@@ -888,6 +1136,364 @@ LocalizationDefault::Impl::resamplePoints( const WorldModel & wm,
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+LocalizationDefault::Impl::getSectorRange( const WorldModel & wm,
+                                           const VisualSensor::MarkerT & marker,
+                                           const MarkerID id,
+                                           const double self_face,
+                                           const double self_face_err,
+                                           Vector2D * marker_pos,
+                                           double * ave_dist,
+                                           double * dist_error,
+                                           double * ave_dir,
+                                           double * dir_error )
+{
+    ObjectTable::MarkerMap::const_iterator it = objectTable().landmarkMap().find( id );
+    if ( it == objectTable().landmarkMap().end() )
+    {
+        return false;
+    }
+
+    *marker_pos = it->second;
+
+#ifdef USE_OBJECT_TABLE
+    if ( ! objectTable().getLandmarkDistanceRange( wm.clientVersion(),
+                                                   wm.self().viewWidth().type(),
+                                                   marker.dist_, ave_dist, dist_error ) )
+    {
+        return false;
+    }
+#else
+    inverseDistanceRange( wm.clientVersion(), wm.self().viewWidth().type(),
+                          marker.dist_, ServerParam::i().landmarkDistQuantizeStep(), ave_dist, dist_error );
+#endif
+
+    getDirRange( marker.dir_, self_face, self_face_err, ave_dir, dir_error );
+    // reverse, because base point is marker point.
+    *ave_dir += 180.0;
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+LocalizationDefault::Impl::generateParticles( const WorldModel & wm,
+                                              const VisualSensor::MarkerT & marker,
+                                              const MarkerID id,
+                                              const double self_face,
+                                              const double self_face_err )
+{
+    M_particle_count = 0;
+
+    Vector2D marker_pos;
+    double ave_dist, dist_error, ave_dir, dir_error;
+    if ( ! getSectorRange( wm, marker, id, self_face, self_face_err,
+                           &marker_pos, &ave_dist, &dist_error, &ave_dir, &dir_error ) )
+    {
+        return 0;
+    }
+
+    // the same grid as generatePoints()
+    const double min_dist = ave_dist - dist_error;
+    const double dist_range = dist_error * 2.0;
+    double dist_inc = std::max( 0.01, dist_error / 16.0 );
+    const int dist_loop = bound( 2,
+                                 static_cast< int >( std::ceil( dist_range / dist_inc ) ),
+                                 16 );
+    dist_inc = dist_range / ( dist_loop - 1 );
+
+    const double dir_range = dir_error * 2.0;
+    const double circum = 2.0 * ave_dist * M_PI * ( dir_range / 360.0 );
+    double circum_inc = std::max( 0.01, circum / 32.0 );
+    const int dir_loop = bound( 2,
+                                static_cast< int >( std::ceil( circum / circum_inc ) ),
+                                32 );
+    const double dir_inc = dir_range / ( dir_loop - 1 );
+
+    AngleDeg base_angle( ave_dir - dir_error ); // left first;
+    for ( int idir = 0; idir < dir_loop; ++idir, base_angle += dir_inc )
+    {
+        const double cos_dir = base_angle.cos();
+        const double sin_dir = base_angle.sin();
+
+        double add_dist = 0.0;
+        for ( int idist = 0; idist < dist_loop; ++idist, add_dist += dist_inc )
+        {
+            M_px[M_particle_count] = marker_pos.x + cos_dir * ( min_dist + add_dist );
+            M_py[M_particle_count] = marker_pos.y + sin_dir * ( min_dist + add_dist );
+            ++M_particle_count;
+        }
+    }
+
+    return M_particle_count;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+LocalizationDefault::Impl::addSector( const WorldModel & wm,
+                                      const VisualSensor::MarkerT & marker,
+                                      const MarkerID id,
+                                      const double self_face,
+                                      const double self_face_err )
+{
+    if ( M_sector_count >= MAX_SECTORS )
+    {
+        return false;
+    }
+
+    Vector2D marker_pos;
+    double ave_dist, dist_error, ave_dir, dir_error;
+    if ( ! getSectorRange( wm, marker, id, self_face, self_face_err,
+                           &marker_pos, &ave_dist, &dist_error, &ave_dir, &dir_error ) )
+    {
+        return false;
+    }
+
+    const int i = M_sector_count;
+    const double min_r = std::max( 0.0, ave_dist - dist_error );
+    const double max_r = ave_dist + dist_error;
+    const AngleDeg center_dir( ave_dir );
+
+    M_sx[i] = marker_pos.x;
+    M_sy[i] = marker_pos.y;
+    M_min_r2[i] = min_r * min_r;
+    M_max_r2[i] = max_r * max_r;
+    M_dir_x[i] = center_dir.cos();
+    M_dir_y[i] = center_dir.sin();
+    M_cos_half[i] = std::cos( std::min( dir_error, 180.0 ) * AngleDeg::DEG2RAD );
+
+    ++M_sector_count;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+LocalizationDefault::Impl::evaluateParticles( const int first )
+{
+    const int size = M_particle_count;
+
+    for ( int i = first; i < size; ++i )
+    {
+        M_votes[i] = 0;
+    }
+
+    for ( int s = 0; s < M_sector_count; ++s )
+    {
+        const double sx = M_sx[s];
+        const double sy = M_sy[s];
+        const double min_r2 = M_min_r2[s];
+        const double max_r2 = M_max_r2[s];
+        const double dir_x = M_dir_x[s];
+        const double dir_y = M_dir_y[s];
+        const double cos_half = M_cos_half[s];
+
+        // branch free loop. the angle test is dot(rel, dir) >= |rel| * cos(half_width)
+        for ( int i = first; i < size; ++i )
+        {
+            const double dx = M_px[i] - sx;
+            const double dy = M_py[i] - sy;
+            const double d2 = dx * dx + dy * dy;
+            const double dot = dx * dir_x + dy * dir_y;
+            M_votes[i] += ( ( min_r2 <= d2 )
+                            & ( d2 <= max_r2 )
+                            & ( dot >= cos_half * std::sqrt( d2 ) ) );
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+LocalizationDefault::Impl::selectParticles()
+{
+    int best = 0;
+    for ( int i = 0; i < M_particle_count; ++i )
+    {
+        best = std::max( best, M_votes[i] );
+    }
+
+    int n = 0;
+    for ( int i = 0; i < M_particle_count; ++i )
+    {
+        if ( M_votes[i] == best )
+        {
+            M_px[n] = M_px[i];
+            M_py[n] = M_py[i];
+            M_votes[n] = M_votes[i];
+            ++n;
+        }
+    }
+    M_particle_count = n;
+
+    return best;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+LocalizationDefault::Impl::resampleParticles()
+{
+    const int count = M_particle_count;
+
+    if ( count == 0
+         || count >= MIN_PARTICLES )
+    {
+        return count;
+    }
+
+    // the same jitter as resamplePoints()
+    std::uniform_real_distribution<> xy_dst( -0.01, 0.01 );
+    std::uniform_int_distribution<> index_dst( 0, count - 1 );
+
+    for ( int i = count; i < MIN_PARTICLES; ++i )
+    {
+        const int src = index_dst( M_engine );
+        M_px[i] = M_px[src] + xy_dst( M_engine );
+        M_py[i] = M_py[src] + xy_dst( M_engine );
+    }
+    M_particle_count = MIN_PARTICLES;
+
+    return count;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+LocalizationDefault::Impl::averageParticles( Vector2D * ave_pos,
+                                             Vector2D * ave_err ) const
+{
+    ave_pos->assign( 0.0, 0.0 );
+    ave_err->assign( 0.0, 0.0 );
+
+    if ( M_particle_count == 0 )
+    {
+        return;
+    }
+
+    double sum_x = 0.0, sum_y = 0.0;
+    double min_x = M_px[0], max_x = M_px[0];
+    double min_y = M_py[0], max_y = M_py[0];
+
+    for ( int i = 0; i < M_particle_count; ++i )
+    {
+        sum_x += M_px[i];
+        sum_y += M_py[i];
+        min_x = std::min( min_x, M_px[i] );
+        max_x = std::max( max_x, M_px[i] );
+        min_y = std::min( min_y, M_py[i] );
+        max_y = std::max( max_y, M_py[i] );
+    }
+
+    ave_pos->assign( sum_x / M_particle_count, sum_y / M_particle_count );
+    ave_err->assign( ( max_x - min_x ) * 0.5, ( max_y - min_y ) * 0.5 );
+
+#ifdef DEBUG_PRINT
+    dlog.addText( Logger::WORLD,
+                  __FILE__" (averageParticles) %d particles. self_pos=(%.3f, %.3f) err=(%.3f, %.3f)",
+                  M_particle_count,
+                  ave_pos->x, ave_pos->y, ave_err->x, ave_err->y );
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+LocalizationDefault::Impl::localizeByParticles( const WorldModel & wm,
+                                                const VisualSensor & see,
+                                                const double self_face,
+                                                const double self_face_err,
+                                                Vector2D * self_pos,
+                                                Vector2D * self_pos_err )
+{
+    const VisualSensor::MarkerCont & markers = see.markers();
+
+    if ( generateParticles( wm, markers.front(), markers.front().id_,
+                            self_face, self_face_err ) == 0 )
+    {
+        return false;
+    }
+
+    //
+    // evaluate all markers at once.
+    // the nearest marker is skipped, because the particles are generated in its sector.
+    //
+    M_sector_count = 0;
+    for ( VisualSensor::MarkerCont::const_iterator m = ++markers.begin(), end = markers.end();
+          m != end && M_sector_count < 30; // magic number, same as updatePointsByMarkers()
+          ++m )
+    {
+        addSector( wm, *m, m->id_, self_face, self_face_err );
+    }
+
+    evaluateParticles( 0 );
+    const int best_votes = selectParticles();
+
+    // the survivors are also contained by the most sectors, so the selection never becomes empty.
+    const int first_added = resampleParticles();
+    if ( first_added < M_particle_count )
+    {
+        evaluateParticles( first_added );
+        for ( int i = first_added; i < M_particle_count; ++i )
+        {
+            M_votes[i] = std::min( M_votes[i], best_votes );
+        }
+        selectParticles();
+    }
+
+    averageParticles( self_pos, self_pos_err );
+
+    //
+    // check the nearest behind marker
+    //
+    if ( ! see.behindMarkers().empty() )
+    {
+        const VisualSensor::MarkerT & behind = see.behindMarkers().front();
+        const MarkerID behind_id = getNearestMarker( behind.object_type_, *self_pos );
+
+        M_sector_count = 0;
+        if ( behind_id != Marker_Unknown
+             && addSector( wm, behind, behind_id, self_face, self_face_err ) )
+        {
+            evaluateParticles( 0 );
+
+            // if no particle is contained, the behind marker is ignored.
+            if ( selectParticles() > 0 )
+            {
+                averageParticles( self_pos, self_pos_err );
+            }
+        }
+    }
+
+#ifdef DEBUG_PRINT
+    dlog.addText( Logger::WORLD,
+                  __FILE__" (localizeByParticles) markers=%d votes=%d particles=%d",
+                  (int)markers.size(), best_votes, M_particle_count );
+#endif
+
+    return M_particle_count > 0;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -945,8 +1551,11 @@ LocalizationDefault::Impl::getFaceDirByMarkers( const WorldModel & wm,
                   __FILE__" (getFaceDirByMarkers) try to get face from 2 markers" );
 #endif
 
-    ObjectTable::MarkerMap::const_iterator it1 = objectTable().landmarkMap().find( markers.front().id_ );
-    if ( it1 == objectTable().landmarkMap().end() )
+    const FaceDirTable & table = shared_face_dir_table();
+
+    const MarkerID id1 = markers.front().id_;
+    if ( id1 < 0 || Marker_Unknown <= id1
+         || ! table.marker_valid_[id1] )
     {
 #ifdef DEBUG_PRINT
         dlog.addText( Logger::WORLD,
@@ -955,8 +1564,9 @@ LocalizationDefault::Impl::getFaceDirByMarkers( const WorldModel & wm,
         return angle;
     }
 
-    ObjectTable::MarkerMap::const_iterator it2 = objectTable().landmarkMap().find( markers.back().id_ );
-    if ( it2 == objectTable().landmarkMap().end() )
+    const MarkerID id2 = markers.back().id_;
+    if ( id2 < 0 || Marker_Unknown <= id2
+         || ! table.marker_valid_[id2] )
     {
 #ifdef DEBUG_PRINT
         dlog.addText( Logger::WORLD,
@@ -998,12 +1608,11 @@ LocalizationDefault::Impl::getFaceDirByMarkers( const WorldModel & wm,
                           markers.back().dist_, ServerParam::i().landmarkDistQuantizeStep(), &marker_dist2, &tmperr );
 #endif
 
-    Vector2D rpos1 = Vector2D::polar2vector( marker_dist1, markers.front().dir_ );
-    Vector2D rpos2 = Vector2D::polar2vector( marker_dist2, markers.back().dir_ );
-    Vector2D gap1 = rpos1 - rpos2;
-    Vector2D gap2 = it1->second - it2->second;
+    const Vector2D rpos1 = table.relativePos( marker_dist1, markers.front().dir_ );
+    const Vector2D rpos2 = table.relativePos( marker_dist2, markers.back().dir_ );
+    const Vector2D gap1 = rpos1 - rpos2;
 
-    angle = ( gap2.th() - gap1.th() ).degree();
+    angle = ( AngleDeg( table.marker_gap_dir_[id1][id2] ) - gap1.th() ).degree();
 
 #ifdef DEBUG_PRINT
     dlog.addText( Logger::WORLD,
@@ -1204,6 +1813,16 @@ LocalizationDefault::~LocalizationDefault()
 
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+LocalizationDefault::setParticleFilter( const bool on )
+{
+    M_impl->setParticleMode( on );
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -1284,6 +1903,14 @@ LocalizationDefault::localizeSelf( const WorldModel & wm,
     Timer timer;
 #endif
 
+    if ( M_impl->particleMode() )
+    {
+        return M_impl->localizeByParticles( wm, see,
+                                            self_face, self_face_err,
+                                            self_pos, self_pos_err )
+            && self_pos->isValid();
+    }
+
     ////////////////////////////////////////////////////////////////////
     // generate points using the nearest marker
     M_impl->generatePoints( wm,
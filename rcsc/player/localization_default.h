@@ -68,6 +68,18 @@ public:
     virtual
     ~LocalizationDefault();
 
+    /*!
+      \brief enable/disable the particle filter mode of localizeSelf().
+      \param on if true, the particle filter is used.
+
+      The particle filter keeps the candidate positions in preallocated
+      fixed size arrays, and counts the seen marker sectors that contain
+      each particle for all markers at once.
+      The particles contained by the most sectors survive, so a few
+      inconsistent markers do not empty the candidate set.
+     */
+    void setParticleFilter( const bool on );
+
 public:
 
    /*!
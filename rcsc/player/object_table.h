@@ -38,6 +38,7 @@
 
 #include <unordered_map>
 #include <vector>
+#include <cstdint>
 
 namespace rcsc {
 
@@ -62,6 +63,7 @@ public:
         /*!
           \brief init variables by 0
         */
+        constexpr
         DataEntry()
             : M_seen_dist( 0.0 )
             , M_average( 0.0 )
@@ -72,7 +74,7 @@ public:
           \brief create data for search algorithm
           \param dist distance value to be searched
         */
-        explicit
+        explicit constexpr
         DataEntry( const double & dist )
             : M_seen_dist( dist )
             , M_average(0.0)
@@ -85,6 +87,7 @@ public:
           \param ave predefined average distance
           \param err predefined error range
         */
+        constexpr
         DataEntry( const double & dist,
                    const double & ave,
                    const double & err )
@@ -97,24 +100,51 @@ public:
     //! type of marker map container
     typedef std::unordered_map< MarkerID, Vector2D > MarkerMap;
 
+    //! type of the direct lookup table used by the dynamically created distance table
+    typedef std::vector< std::uint16_t > DirectIndex;
+
+    /*!
+      \struct Table
+      \brief view of a sorted distance table and its direct lookup table
+    */
+    struct Table {
+        const DataEntry * entries_; //!< entries sorted by the seen distance
+        std::size_t size_; //!< the number of entries
+        const std::uint16_t * index_; //!< entry index for each (seen distance / 0.1)
+        std::size_t index_size_; //!< the size of index_
+    };
+
 private:
 
     //! landmark map. key: marker id, value: coordinate value
     MarkerMap M_landmark_map;
 
     //! distance table for stationary objects (line, marker)
-    std::vector< DataEntry > M_static_table;
+    Table M_static_table;
 
-    std::vector< DataEntry > M_static_table_v18_narrow; //!< landmark distance table for v18+ narrow
-    std::vector< DataEntry > M_static_table_v18_normal; //!< landmark distance table for v18+ normal
-    std::vector< DataEntry > M_static_table_v18_wide; //!< landmark distance table for v18+ wide
+    Table M_static_table_v18_narrow; //!< landmark distance table for v18+ narrow
+    Table M_static_table_v18_normal; //!< landmark distance table for v18+ normal
+    Table M_static_table_v18_wide; //!< landmark distance table for v18+ wide
 
     //! distance table for movable objects (ball, player)
-    std::vector< DataEntry > M_movable_table;
+    Table M_movable_table;
+
+    Table M_movable_table_v18_narrow; //!< distance table for v18+ narrow
+    Table M_movable_table_v18_normal; //!< distance table for v18+ normal
+    Table M_movable_table_v18_wide; //!< distance table for v18+ wide
+
+    //
+    // storage for the tables created by create()
+    //
+
+    std::vector< DataEntry > M_static_entries; //!< created entries for the stationary objects
+    DirectIndex M_static_index; //!< direct lookup table for M_static_entries
+    std::vector< DataEntry > M_movable_entries; //!< created entries for the movable objects
+    DirectIndex M_movable_index; //!< direct lookup table for M_movable_entries
 
-    std::vector< DataEntry > M_movable_table_v18_narrow; //!< distance table for v18+ narrow
-    std::vector< DataEntry > M_movable_table_v18_normal; //!< distance table for v18+ normal
-    std::vector< DataEntry > M_movable_table_v18_wide; //!< distance table for v18+ wide
+    // not used. the tables may refer the member containers.
+    ObjectTable( const ObjectTable & ) = delete;
+    ObjectTable & operator=( const ObjectTable & ) = delete;
 
 public:
     /*!
@@ -122,6 +152,11 @@ public:
     */
     ObjectTable();
 
+    /*!
+      \brief get the heap bytes held by this table
+      \return bytes
+    */
+    std::size_t memoryUsage() const;
 
     /*!
       \brief get landmark map object
@@ -223,6 +258,18 @@ public:
     double quantize_dist( const double & unq_dist,
                           const double & qstep );
 
+    /*!
+      \brief replace the stationary/movable distance tables by the tables created for the given steps.
+      \param static_qstep quantizaztion step for the stationary object
+      \param movable_qstep quantizaztion step for the movable object
+
+      The built-in tables are compile time constants for the default server parameters.
+      This method is required only if the server uses the other quantize steps.
+      The v18+ tables are not changed.
+    */
+    void create( const double & static_qstep,
+                 const double & movable_qstep );
+
 private:
 
     /*!
@@ -231,20 +278,10 @@ private:
     void createLandmarkMap();
 
     /*!
-      \brief create distance table by built-in values
+      \brief set the built-in distance tables
     */
     void createTable();
 
-    /*!
-      \brief create distance table dynamically
-      \param static_qstap quantizaztion step for the stationary object
-      \param movable_qstap quantizaztion step for the movable object
-
-      It is not recommended to use this method for the real game
-    */
-    void create( const double & static_qstep,
-                 const double & movable_qstep );
-
     /*!
       \brief implementation of distance table creation
       \param qstep quantizatin step
@@ -253,6 +290,28 @@ private:
     void createTable( const double & qstep,
                       std::vector< DataEntry > & table );
 
+    /*!
+      \brief create the direct lookup table for the distance table
+      \param table distance table
+      \param index pointer to the result table
+    */
+    static
+    void create_index( const std::vector< DataEntry > & table,
+                       DirectIndex * index );
+
+    /*!
+      \brief find the distance table entry for the seen distance
+      \param table distance table
+      \param seen_dist seen distance
+      \return pointer to the matched entry. NULL if not found.
+
+      If the seen distance is on the 0.1 grid, the entry is taken directly.
+      Otherwise, it is searched by the binary search.
+    */
+    static
+    const DataEntry * find_entry( const Table & table,
+                                  const double seen_dist );
+
 };
 
 }
@@ -42,21 +42,38 @@
 
 #include "localization_default.h"
 
+#include "command_writer.h"
 #include "player_command.h"
 #include "say_message_builder.h"
 #include "soccer_action.h"
 #include "soccer_intention.h"
+#include "player_event_scheduler.h"
+#include "think_time_profiler.h"
+#include "send_timing_estimator.h"
+#include "speculative_worker.h"
+#include "agent_context.h"
 
 #include <rcsc/common/audio_codec.h>
 #include <rcsc/common/audio_memory.h>
 #include <rcsc/common/abstract_client.h>
 #include <rcsc/common/online_client.h>
+#include <rcsc/common/shm_client.h>
 #include <rcsc/common/offline_client.h>
 #include <rcsc/common/logger.h>
 #include <rcsc/common/player_param.h>
 #include <rcsc/common/player_type.h>
 #include <rcsc/common/server_param.h>
+#include <rcsc/common/shared_param.h>
+#include <rcsc/common/trace_recorder.h>
+#include <rcsc/net/host_address.h>
+#include <rcsc/net/udp_socket.h>
 #include <rcsc/param/param_map.h>
+#include <rcsc/util/cycle_arena.h>
+#include <rcsc/util/task_graph.h>
+#include <rcsc/util/performance_monitor.h>
+#include <rcsc/util/memory_accounting.h>
+#include <rcsc/util/runtime_tuning.h>
+#include <rcsc/util/playmode_decoder.h>
 #include <rcsc/param/cmd_line_parser.h>
 #include <rcsc/param/conf_file_parser.h>
 #include <rcsc/math_util.h>
@@ -65,14 +82,47 @@
 #include <rcsc/timer.h>
 #include <rcsc/version.h>
 
+#include <algorithm>
+#include <future>
 #include <sstream>
+#include <string_view>
+#include <charconv>
+#include <cctype>
 #include <cstdio>
 #include <cstring>
+#include <csignal>
 
 //#define PROFILE_SEE
 
 namespace rcsc {
 
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief check if the message starts with the prefix string
+ */
+inline
+bool
+has_prefix( const char * msg,
+            const std::string_view prefix )
+{
+    return std::strncmp( msg, prefix.data(), prefix.size() ) == 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief signal handler to dump the flight recorder at the next cycle
+ */
+extern "C"
+void
+handle_flight_recorder_signal( int )
+{
+    Logger::requestFlightRecorderDump();
+}
+
+}
+
 ///////////////////////////////////////////////////////////////////////
 /*!
   \struct PlayerAgentImpl
@@ -122,6 +172,17 @@ struct PlayerAgent::Impl {
     //! time when see is received
     TimeStamp see_time_stamp_;
 
+    //! socket receive time of the last sense_body [nsec since epoch]. 0 means unknown.
+    std::int64_t sense_body_received_nsec_;
+    //! socket receive time of the last see [nsec since epoch]. 0 means unknown.
+    std::int64_t see_received_nsec_;
+
+    //! send timing statistics for the adaptive send timing mode
+    SendTimingEstimator send_timing_;
+
+    //! name prefix of the memory probes of this agent. empty if not registered.
+    std::string memory_label_;
+
     //! status of the see messaege arrival timing
     SeeState see_state_;
 
@@ -143,6 +204,32 @@ struct PlayerAgent::Impl {
     //! intention queue
     SoccerIntention::Ptr intention_;
 
+    //! behaviours waiting for the player events
+    PlayerEventScheduler event_scheduler_;
+
+    //! command string buffer reused in every action cycle
+    CommandWriter command_writer_;
+
+    //! elapsed time recorder of the cycle phases
+    ThinkTimeProfiler think_profiler_;
+
+    //! time span recorder of the cycle phases
+    TraceRecorder trace_;
+
+    //! scratch memory released at the start of each decision
+    CycleArena cycle_arena_;
+
+    //! per-agent action caches
+    AgentContext agent_context_;
+
+    //! background thread for the speculative pre-computation
+    SpeculativeWorker speculative_worker_;
+    //! the task started at the last sense_body
+    std::shared_ptr< SpeculativeTask > speculative_task_;
+
+    //! the derived table builds of each player type. the index is the type id.
+    std::vector< std::shared_future< void > > type_tables_;
+
     /*!
       \brief initialize all members
     */
@@ -154,7 +241,9 @@ struct PlayerAgent::Impl {
           last_decision_time_( -1, 0 ),
           current_time_( 0, 0 ),
           clang_min_( 0 ),
-          clang_max_( 0 )
+          clang_max_( 0 ),
+          sense_body_received_nsec_( 0 ),
+          see_received_nsec_( 0 )
       {
           for ( int i = 0; i < 11; ++i )
           {
@@ -168,6 +257,26 @@ struct PlayerAgent::Impl {
      */
     void initDebug();
 
+    /*!
+      \brief start the derived table build of the player type on a background thread
+      \param id player type id
+      \param updated true if the player type parameters have been changed
+     */
+    void startTypeTables( const int id,
+                          const bool updated );
+
+    /*!
+      \brief wait for the derived table build of the player type
+      \param id player type id
+      \return true if the tables are ready
+     */
+    bool waitTypeTables( const int id );
+
+    /*!
+      \brief wait for all started derived table builds
+     */
+    void waitAllTypeTables();
+
     /*!
       \brief open offline client log file.
      */
@@ -178,6 +287,68 @@ struct PlayerAgent::Impl {
      */
     bool openDebugLog();
 
+    /*!
+      \brief write the think time profile summary file.
+     */
+    void writeThinkProfile();
+
+    /*!
+      \brief write the trace event file.
+     */
+    void writeTrace();
+
+    /*!
+      \brief apply the cpu affinity, the scheduling priority and the memory
+      locking to the calling thread. called on the agent thread.
+     */
+    void applyRuntimeTuning();
+
+    /*!
+      \brief register the memory probes of this agent to MemoryAccounting.
+     */
+    void registerMemoryProbes();
+
+    /*!
+      \brief detach the memory probes of this agent, and write the memory
+      report file if enabled.
+     */
+    void writeMemoryReport();
+
+    /*!
+      \brief record the arrival offset of the received message relative to
+      the last sense_body to the performance monitor.
+      \param msg raw server message
+      \param received_nsec socket receive time of the message. 0 means unknown.
+     */
+    void recordArrival( const char * msg,
+                        const std::int64_t received_nsec );
+
+    /*!
+      \brief record the latency from the sensory messages of the current cycle
+      to the command send to the performance monitor.
+      \param sent_nsec send time of the command. 0 means unknown.
+      \param decision_nsec elapsed time from the action start to the command send
+     */
+    void recordCommandLatency( const std::int64_t sent_nsec,
+                               const std::int64_t decision_nsec );
+
+    /*!
+      \brief check if the decision timing and deadline are estimated by send_timing_.
+      \return true if the adaptive send timing mode is enabled and has enough samples.
+     */
+    bool useAdaptiveSendTiming() const
+      {
+          return agent_.config().adaptiveSendTiming()
+              && ! ServerParam::i().synchMode()
+              && send_timing_.isReady();
+      }
+
+    /*!
+      \brief create the time limit of the current decision.
+      \return deadline measured from the sense_body arrival
+     */
+    Deadline createDecisionDeadline() const;
+
     /*!
       \brief set debug output flags to logger
      */
@@ -208,13 +379,15 @@ struct PlayerAgent::Impl {
       \brief analyze cycle info in server message
       \param msg raw server message
       \param by_sense_body if message type is sense_body, this value becomes true
+      \param next if not NULL, the pointer to the next character of the cycle is set.
       \return parsing result status
 
       parse cycle data from several sensory message
       see, hear, sensebody and fullstate
     */
     bool analyzeCycle( const char * msg,
-                       const bool by_sense_body );
+                       const bool by_sense_body,
+                       const char ** next = nullptr );
 
     /*!
       \brief analyze see info
@@ -351,6 +524,15 @@ struct PlayerAgent::Impl {
     bool isDecisionTiming( const long & msec_from_sense,
                            const int timeout_count ) const;
 
+    /*!
+      \brief check if now decision timing in the adaptive send timing mode.
+      The see message is waited until the latest decision start time estimated
+      from the arrival statistics, or until the see is later than usual.
+      \param timeout_count timeout count since last sensing message.
+      \return true if player should send action
+    */
+    bool isAdaptiveDecisionTiming( const int timeout_count ) const;
+
 
     /*!
       \brief adjust see message timing.
@@ -410,6 +592,12 @@ struct PlayerAgent::Impl {
      */
     void printDebug();
 
+    /*!
+      \brief update the world model without the decision.
+      used instead of action() while the offline client is fast-forwarding.
+     */
+    void fastForward();
+
 };
 
 /*-------------------------------------------------------------------*/
@@ -585,6 +773,11 @@ PlayerAgent::Impl::isDecisionTiming( const long & msec_from_sense,
         return true;
     }
 
+    if ( useAdaptiveSendTiming() )
+    {
+        return isAdaptiveDecisionTiming( timeout_count );
+    }
+
     const int wait_thr = ( see_state_.isSynch()
                            ? agent_.config().waitTimeThrSynchView()
                            : agent_.config().waitTimeThrNoSynchView() );
@@ -653,6 +846,56 @@ PlayerAgent::Impl::isDecisionTiming( const long & msec_from_sense,
     return false;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+PlayerAgent::Impl::isAdaptiveDecisionTiming( const int timeout_count ) const
+{
+    // already done in sense_body received cycle.
+    if ( last_decision_time_ == agent_.world().senseBodyTime()
+         && timeout_count <= 2 )
+    {
+        return false;
+    }
+
+    // no see info during the current cycle.
+    if ( see_state_.isSynch()
+         && see_state_.cyclesTillNextSee() > 0 )
+    {
+        dlog.addText( Logger::SYSTEM,
+                      __FILE__" (isAdaptiveDecisionTiming) estimated cycles till next see ----- %d",
+                      see_state_.cyclesTillNextSee() );
+        return true;
+    }
+
+    const std::int64_t margin_nsec = static_cast< std::int64_t >( agent_.config().sendMarginMSec() * 1000.0 * 1000.0 );
+    const std::int64_t now = UDPSocket::now_nsec();
+
+    const std::int64_t start_limit = send_timing_.decisionStartLimitNSec( margin_nsec );
+    if ( now >= start_limit )
+    {
+        dlog.addText( Logger::SYSTEM,
+                      __FILE__" (isAdaptiveDecisionTiming) over the start limit. %.2f [ms] from sense_body",
+                      ( now - send_timing_.senseBodyNSec() ) * 1.0e-6 );
+        return true;
+    }
+
+    // the see is later than 99% of the recent cycles. it may not come in this cycle.
+    const std::int64_t late_see = send_timing_.expectedSeeNSec( 0.99 );
+    if ( late_see > 0
+         && now >= late_see + margin_nsec )
+    {
+        dlog.addText( Logger::SYSTEM,
+                      __FILE__" (isAdaptiveDecisionTiming) no see. %.2f [ms] from sense_body",
+                      ( now - send_timing_.senseBodyNSec() ) * 1.0e-6 );
+        return true;
+    }
+
+    return false;
+}
+
 ///////////////////////////////////////////////////////////////////////
 
 /*-------------------------------------------------------------------*/
@@ -670,6 +913,12 @@ PlayerAgent::PlayerAgent()
     // std::cerr << "construct player" << std::endl;
 
     M_fullstate_worldmodel.setValid( false );
+
+    M_worldmodel.setCycleArena( &M_impl->cycle_arena_ );
+    M_fullstate_worldmodel.setCycleArena( &M_impl->cycle_arena_ );
+
+    M_worldmodel.setAgentContext( &M_impl->agent_context_ );
+    M_fullstate_worldmodel.setAgentContext( &M_impl->agent_context_ );
 }
 
 /*-------------------------------------------------------------------*/
@@ -693,7 +942,13 @@ PlayerAgent::createConsoleClient()
     if ( 1 <= config().offlineClientNumber()
          && config().offlineClientNumber() <= 11 )
     {
-        ptr = std::shared_ptr< AbstractClient >( new OfflineClient() );
+        OfflineClient * client = new OfflineClient();
+        client->setFastForwardCycle( config().offlineFastForward() );
+        ptr = std::shared_ptr< AbstractClient >( client );
+    }
+    else if ( config().shmTransport() )
+    {
+        ptr = std::shared_ptr< AbstractClient >( new ShmClient() );
     }
     else
     {
@@ -780,6 +1035,99 @@ PlayerAgent::seeTimeStamp() const
     return M_impl->see_time_stamp_;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const
+Deadline &
+PlayerAgent::decisionDeadline() const
+{
+    return M_worldmodel.decisionDeadline();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const
+ThinkTimeProfiler &
+PlayerAgent::thinkTimeProfiler() const
+{
+    return M_impl->think_profiler_;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CycleArena &
+PlayerAgent::cycleArena()
+{
+    return M_impl->cycle_arena_;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+PlayerEventScheduler &
+PlayerAgent::eventScheduler()
+{
+    return M_impl->event_scheduler_;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+AgentContext &
+PlayerAgent::agentContext()
+{
+    return M_impl->agent_context_;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+PlayerAgent::isPlayerTypeReady() const
+{
+    if ( ! world().self().playerTypePtr() )
+    {
+        return false;
+    }
+
+    const int id = world().self().playerTypePtr()->id();
+    if ( id < 0
+         || static_cast< int >( M_impl->type_tables_.size() ) <= id
+         || ! M_impl->type_tables_[id].valid() )
+    {
+        // no build has been started for this type
+        return true;
+    }
+
+    return ( M_impl->type_tables_[id].wait_for( std::chrono::seconds( 0 ) )
+             == std::future_status::ready );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const SpeculativeTask *
+PlayerAgent::speculativeTask() const
+{
+    if ( M_impl->speculative_task_
+         && M_impl->speculative_task_->isValid()
+         && M_impl->speculative_task_->time() == M_impl->current_time_ )
+    {
+        return M_impl->speculative_task_.get();
+    }
+    return nullptr;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -839,6 +1187,24 @@ PlayerAgent::initImpl( CmdLineParser & cmd_parser )
 
     AudioCodec::instance().createMap( config().audioShift() );
 
+    // resolve the server host while the rest of the initialization runs.
+    // the agents in the same process share the result.
+    if ( config().offlineClientNumber() == Unum_Unknown
+         && ! config().host().empty() )
+    {
+        HostAddress::resolve_async( config().host() );
+    }
+
+    if ( config().hugePages() )
+    {
+        RuntimeTuning::set_huge_pages( true );
+    }
+
+    if ( config().workerThreads() > 0 )
+    {
+        // the pool is shared by all agents in this process.
+        TaskPool::instance().requestWorkerCount( static_cast< std::size_t >( config().workerThreads() ) );
+    }
 
     M_worldmodel.setLocalization( std::shared_ptr< Localization >( new LocalizationDefault() ) );
     M_fullstate_worldmodel.setLocalization( std::shared_ptr< Localization >( new LocalizationDefault() ) );
@@ -880,6 +1246,8 @@ PlayerAgent::handleStart()
 
     M_client->setIntervalMSec( config().intervalMSec() );
 
+    M_impl->applyRuntimeTuning();
+
     M_impl->sendInitCommand();
     return true;
 }
@@ -924,10 +1292,17 @@ PlayerAgent::handleMessage()
     GameTime start_time = M_impl->current_time_;
 
     // receive and analyze message
-    while ( M_client->receiveMessage() > 0 )
     {
-        ++counter;
-        parse( M_client->message() );
+        TraceRecorder::Scope trace_receive( M_impl->trace_, "receive" );
+        while ( M_client->receiveMessage() > 0 )
+        {
+            ThinkTimeProfiler::Scope profile( M_impl->think_profiler_, ThinkTimeProfiler::PARSE );
+            TraceRecorder::Scope trace( M_impl->trace_, "parse" );
+            RCSC_PERF_TIMER( player_parse );
+            ++counter;
+            M_impl->recordArrival( M_client->message(), M_client->receivedNSec() );
+            parse( M_client->message() );
+        }
     }
 
     // game cycle is changed while several message parsing
@@ -949,6 +1324,8 @@ PlayerAgent::handleMessage()
                       start_time.cycle(), start_time.stopped(),
                       M_impl->current_time_.cycle(),
                       M_impl->current_time_.stopped() );
+        M_impl->think_profiler_.addActionMissed();
+        dlog.triggerFlightRecorder( "missed_action" );
     }
 
     if ( M_impl->think_received_ )
@@ -989,6 +1366,7 @@ PlayerAgent::handleMessageOffline()
 
     if ( M_client->receiveMessage() > 0 )
     {
+        RCSC_PERF_TIMER( player_parse );
         parse( M_client->message() );
     }
 
@@ -1002,7 +1380,14 @@ PlayerAgent::handleMessageOffline()
                   << world().time()
                   << " action" << std::endl;
 #endif
-        action();
+        if ( M_client->isFastForwarding() )
+        {
+            M_impl->fastForward();
+        }
+        else
+        {
+            action();
+        }
         M_impl->think_received_ = false;
     }
 }
@@ -1074,6 +1459,7 @@ PlayerAgent::handleTimeout( const int timeout_count,
 void
 PlayerAgent::handleExit()
 {
+    M_impl->waitAllTypeTables();
     finalize();
 }
 
@@ -1155,6 +1541,9 @@ PlayerAgent::finalize()
     }
     std::printf( "\n" );
 #endif
+    M_impl->writeThinkProfile();
+    M_impl->writeTrace();
+    M_impl->writeMemoryReport();
     std::cout << config().teamName() << ' '
               << world().self().unum() << ": "
               << "finished."
@@ -1168,6 +1557,10 @@ PlayerAgent::finalize()
 void
 PlayerAgent::Impl::initDebug()
 {
+    think_profiler_.setEnabled( agent_.config().thinkProfile() );
+    trace_.setEnabled( agent_.config().trace(),
+                       static_cast< std::size_t >( std::max( 0, agent_.config().traceSize() ) ) );
+
     if ( agent_.config().offlineClientNumber() < 1
          || 11 < agent_.config().offlineClientNumber() ) // == online mode
     {
@@ -1247,6 +1640,12 @@ PlayerAgent::Impl::openOfflineLog()
 bool
 PlayerAgent::Impl::openDebugLog()
 {
+    if ( dlog.isDisabled() )
+    {
+        // several agents share the process. see TeamRunner.
+        return true;
+    }
+
     std::ostringstream filepath;
 
     if ( ! agent_.config().logDir().empty() )
@@ -1258,10 +1657,29 @@ PlayerAgent::Impl::openDebugLog()
         }
     }
 
-    filepath << agent_.config().teamName() << '-' << agent_.world().self().unum()
-             << agent_.config().debugLogExt();
+    if ( agent_.config().flightRecorderSteps() > 0 )
+    {
+        filepath << agent_.config().teamName() << '-' << agent_.world().self().unum()
+                 << "-flight";
+
+        dlog.enableFlightRecorder( agent_.config().flightRecorderSteps(), filepath.str() );
+        std::signal( SIGUSR2, handle_flight_recorder_signal );
+    }
+    else if ( ! agent_.config().debugLogContainer().empty() )
+    {
+        std::ostringstream agent_name;
+        agent_name << agent_.config().teamName() << '-' << agent_.world().self().unum();
 
-    dlog.open( filepath.str() );
+        filepath << agent_.config().debugLogContainer();
+        dlog.openContainer( filepath.str(), agent_name.str() );
+    }
+    else
+    {
+        filepath << agent_.config().teamName() << '-' << agent_.world().self().unum()
+                 << agent_.config().debugLogExt();
+
+        dlog.open( filepath.str() );
+    }
 
     if ( ! dlog.isOpen() )
     {
@@ -1280,41 +1698,24 @@ PlayerAgent::Impl::openDebugLog()
 /*!
 
  */
-void
-PlayerAgent::Impl::sendInitCommand()
+Deadline
+PlayerAgent::Impl::createDecisionDeadline() const
 {
-    std::ostringstream ostr;
-
-    // make command string
-
-    if ( agent_.config().reconnectNumber() < 1
-         || 11 < agent_.config().reconnectNumber() )
+    if ( useAdaptiveSendTiming() )
     {
-        // normal case
-        PlayerInitCommand com( agent_.config().teamName(),
-                               agent_.config().version(),
-                               agent_.config().goalie() );
-        com.toCommandString( ostr );
+        const std::int64_t margin_nsec = static_cast< std::int64_t >( agent_.config().sendMarginMSec() * 1000.0 * 1000.0 );
+        const std::int64_t remaining = send_timing_.sendDeadlineNSec( margin_nsec ) - UDPSocket::now_nsec();
+        return Deadline( TimeStamp::now(), std::max< std::int64_t >( 0, remaining ) );
     }
-    else
-    {
-        std::cout << agent_.config().teamName()
-                  << ": reconnect. number = "
-                  << agent_.config().reconnectNumber() << std::endl;
-        // reconnect
-        PlayerReconnectCommand com( agent_.config().teamName(),
-                                    agent_.config().reconnectNumber() );
-        com.toCommandString( ostr );
 
-    }
+    // the next cycle (the next sense_body) is expected at one simulator step
+    // after the last sense_body arrival.
+    const double budget_msec = ( agent_.config().thinkBudgetMSec() > 0.0
+                                 ? agent_.config().thinkBudgetMSec()
+                                 : static_cast< double >( ServerParam::i().simulatorStep() * ServerParam::i().slowDownFactor() ) );
 
-    // send to server
-    if ( agent_.M_client->sendMessage( ostr.str().c_str() ) <= 0 )
-    {
-        std::cout << agent_.config().teamName()
-                  << ": Failed to init ...\nExit ..." << std::endl;
-        agent_.M_client->setServerAlive( false );
-    }
+    return Deadline( body_time_stamp_.isValid() ? body_time_stamp_ : TimeStamp::now(),
+                     static_cast< std::int64_t >( budget_msec * 1000.0 * 1000.0 ) );
 }
 
 /*-------------------------------------------------------------------*/
@@ -1322,21 +1723,343 @@ PlayerAgent::Impl::sendInitCommand()
 
  */
 void
-PlayerAgent::Impl::sendSettingCommands()
+PlayerAgent::Impl::writeThinkProfile()
 {
-    std::ostringstream ostr;
-
-    // set synch see mode
-    if ( agent_.config().version() < 18.0
-         && agent_.config().synchSee() )
+    if ( ! think_profiler_.isEnabled() )
     {
-        ostr << "(synch_see)";
+        return;
     }
 
-    if ( agent_.config().gaussianSee() )
-    {
-        ostr << "(gaussian_see)";
-    }
+    std::ostringstream filepath;
+
+    if ( ! agent_.config().logDir().empty() )
+    {
+        filepath << agent_.config().logDir();
+        if ( *(agent_.config().logDir().rbegin()) != '/' )
+        {
+            filepath << '/';
+        }
+    }
+
+    filepath << agent_.config().teamName() << '-' << agent_.world().self().unum()
+             << agent_.config().thinkProfileExt();
+
+    if ( ! think_profiler_.writeJSON( filepath.str() ) )
+    {
+        std::cerr << agent_.config().teamName() << ' '
+                  << agent_.world().self().unum() << ": "
+                  << " Failed to write the think time profile [" << filepath.str() << "]"
+                  << std::endl;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerAgent::Impl::writeTrace()
+{
+    if ( ! trace_.isEnabled() )
+    {
+        return;
+    }
+
+    const int unum = agent_.world().self().unum();
+
+    std::ostringstream thread_name;
+    thread_name << "player " << unum;
+    trace_.setLabel( "player", agent_.config().teamName(), thread_name.str(), unum );
+
+    std::ostringstream filepath;
+
+    if ( ! agent_.config().logDir().empty() )
+    {
+        filepath << agent_.config().logDir();
+        if ( *(agent_.config().logDir().rbegin()) != '/' )
+        {
+            filepath << '/';
+        }
+    }
+
+    filepath << agent_.config().teamName() << '-' << unum
+             << agent_.config().traceExt();
+
+    if ( ! trace_.writeJSON( filepath.str() ) )
+    {
+        std::cerr << agent_.config().teamName() << ' '
+                  << unum << ": "
+                  << " Failed to write the trace file [" << filepath.str() << "]"
+                  << std::endl;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerAgent::Impl::registerMemoryProbes()
+{
+    if ( ! memory_label_.empty()
+         || agent_.world().self().unum() == Unum_Unknown )
+    {
+        return;
+    }
+
+    std::ostringstream label;
+    label << agent_.config().teamName() << '-' << agent_.world().self().unum() << '/';
+    memory_label_ = label.str();
+
+    MemoryAccounting & accounting = MemoryAccounting::instance();
+
+    accounting.addProbe( "logger",
+                         []() { return dlog.memoryUsage(); } );
+    accounting.addProbe( memory_label_ + "cycle_arena",
+                         [this]() { return cycle_arena_.bufferSize() + cycle_arena_.overflowBytes(); } );
+    accounting.addProbe( memory_label_ + "audio_memory",
+                         [this]() { return agent_.world().audioMemory().memoryUsage(); } );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerAgent::Impl::applyRuntimeTuning()
+{
+    const PlayerConfig & config = agent_.config();
+
+    if ( ! config.cpuAffinity().empty() )
+    {
+        std::vector< int > cpus;
+        if ( ! RuntimeTuning::parse_cpu_list( config.cpuAffinity(), &cpus )
+             || ! RuntimeTuning::set_cpu_affinity( cpus ) )
+        {
+            std::cerr << config.teamName() << ' ' << config.playerNumber()
+                      << ": ***WARNING*** failed to set the cpu affinity ["
+                      << config.cpuAffinity() << "]" << std::endl;
+        }
+    }
+
+    if ( config.realtimePriority() > 0
+         && ! RuntimeTuning::set_fifo_priority( config.realtimePriority() ) )
+    {
+        std::cerr << config.teamName() << ' ' << config.playerNumber()
+                  << ": ***WARNING*** failed to set the real-time priority "
+                  << config.realtimePriority() << std::endl;
+    }
+
+    if ( config.niceValue() != 0
+         && ! RuntimeTuning::set_nice( config.niceValue() ) )
+    {
+        std::cerr << config.teamName() << ' ' << config.playerNumber()
+                  << ": ***WARNING*** failed to set the nice value "
+                  << config.niceValue() << std::endl;
+    }
+
+    if ( config.lockMemory()
+         && ! RuntimeTuning::lock_memory() )
+    {
+        std::cerr << config.teamName() << ' ' << config.playerNumber()
+                  << ": ***WARNING*** failed to lock the memory" << std::endl;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerAgent::Impl::writeMemoryReport()
+{
+    if ( memory_label_.empty() )
+    {
+        return;
+    }
+
+    MemoryAccounting & accounting = MemoryAccounting::instance();
+
+    if ( agent_.config().memoryReport() )
+    {
+        accounting.sample();
+
+        std::ostringstream filepath;
+
+        if ( ! agent_.config().logDir().empty() )
+        {
+            filepath << agent_.config().logDir();
+            if ( *(agent_.config().logDir().rbegin()) != '/' )
+            {
+                filepath << '/';
+            }
+        }
+
+        filepath << agent_.config().teamName() << '-' << agent_.world().self().unum()
+                 << agent_.config().memoryReportExt();
+
+        if ( ! accounting.writeJSON( filepath.str() ) )
+        {
+            std::cerr << agent_.config().teamName() << ' '
+                      << agent_.world().self().unum() << ": "
+                      << " Failed to write the memory report [" << filepath.str() << "]"
+                      << std::endl;
+        }
+    }
+
+    // the probes refer to this agent.
+    accounting.removeProbe( memory_label_ + "cycle_arena" );
+    accounting.removeProbe( memory_label_ + "audio_memory" );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerAgent::Impl::recordArrival( const char * msg,
+                                  const std::int64_t received_nsec )
+{
+    if ( received_nsec <= 0 )
+    {
+        return;
+    }
+
+    if ( ! std::strncmp( msg, "(sense_body ", 12 ) )
+    {
+        if ( sense_body_received_nsec_ > 0 )
+        {
+            RCSC_PERF_RECORD_NSEC( "net_sense_body_interval", received_nsec - sense_body_received_nsec_ );
+        }
+        sense_body_received_nsec_ = received_nsec;
+        send_timing_.addSenseBody( received_nsec );
+        return;
+    }
+
+    if ( ! std::strncmp( msg, "(see ", 5 ) )
+    {
+        see_received_nsec_ = received_nsec;
+        send_timing_.addSee( received_nsec );
+    }
+
+    if ( sense_body_received_nsec_ <= 0 )
+    {
+        return;
+    }
+
+    const std::int64_t offset = received_nsec - sense_body_received_nsec_;
+
+    if ( ! std::strncmp( msg, "(see ", 5 ) )
+    {
+        RCSC_PERF_RECORD_NSEC( "net_see_offset", offset );
+    }
+    else if ( ! std::strncmp( msg, "(hear ", 6 ) )
+    {
+        RCSC_PERF_RECORD_NSEC( "net_hear_offset", offset );
+    }
+    else if ( ! std::strncmp( msg, "(fullstate ", 11 ) )
+    {
+        RCSC_PERF_RECORD_NSEC( "net_fullstate_offset", offset );
+    }
+    else if ( ! std::strncmp( msg, "(think)", 7 ) )
+    {
+        RCSC_PERF_RECORD_NSEC( "net_think_offset", offset );
+    }
+    else
+    {
+        RCSC_PERF_RECORD_NSEC( "net_other_offset", offset );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerAgent::Impl::recordCommandLatency( const std::int64_t sent_nsec,
+                                         const std::int64_t decision_nsec )
+{
+    if ( sent_nsec <= 0 )
+    {
+        return;
+    }
+
+    send_timing_.addDecisionTime( decision_nsec );
+
+    if ( sense_body_received_nsec_ > 0
+         && body_.time() == current_time_ )
+    {
+        RCSC_PERF_RECORD_NSEC( "net_sense_body_to_command", sent_nsec - sense_body_received_nsec_ );
+    }
+
+    if ( see_received_nsec_ > 0
+         && agent_.world().seeTime() == current_time_ )
+    {
+        RCSC_PERF_RECORD_NSEC( "net_see_to_command", sent_nsec - see_received_nsec_ );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerAgent::Impl::sendInitCommand()
+{
+    std::ostringstream ostr;
+
+    // make command string
+
+    if ( agent_.config().reconnectNumber() < 1
+         || 11 < agent_.config().reconnectNumber() )
+    {
+        // normal case
+        PlayerInitCommand com( agent_.config().teamName(),
+                               agent_.config().version(),
+                               agent_.config().goalie() );
+        com.toCommandString( ostr );
+    }
+    else
+    {
+        std::cout << agent_.config().teamName()
+                  << ": reconnect. number = "
+                  << agent_.config().reconnectNumber() << std::endl;
+        // reconnect
+        PlayerReconnectCommand com( agent_.config().teamName(),
+                                    agent_.config().reconnectNumber() );
+        com.toCommandString( ostr );
+
+    }
+
+    // send to server
+    if ( agent_.M_client->sendMessage( ostr.str().c_str() ) <= 0 )
+    {
+        std::cout << agent_.config().teamName()
+                  << ": Failed to init ...\nExit ..." << std::endl;
+        agent_.M_client->setServerAlive( false );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerAgent::Impl::sendSettingCommands()
+{
+    std::ostringstream ostr;
+
+    // set synch see mode
+    if ( agent_.config().version() < 18.0
+         && agent_.config().synchSee() )
+    {
+        ostr << "(synch_see)";
+    }
+
+    if ( agent_.config().gaussianSee() )
+    {
+        ostr << "(gaussian_see)";
+    }
 
     // turn off opponent all audio message
 
@@ -1447,72 +2170,110 @@ PlayerAgent::Impl::setDebugFlags()
 void
 PlayerAgent::parse( const char * msg )
 {
-
-    if ( ! std::strncmp( msg, "(see ", 5 ) )
-    {
-        M_impl->analyzeSee( msg );
-    }
-    else if ( ! std::strncmp( msg, "(sense_body ", 12 ) )
-    {
-        M_impl->analyzeSenseBody( msg );
-    }
-    else if ( ! std::strncmp( msg, "(hear ", 6 ) )
-    {
-        M_impl->analyzeHear( msg );
-    }
-    else if ( ! std::strncmp( msg, "(think)", 7 ) )
-    {
-        M_impl->think_received_ = true;
-    }
-    else if ( ! std::strncmp( msg, "(fullstate ", 11 ) )
-    {
-        M_impl->analyzeFullstate( msg );
-    }
-    else if ( ! std::strncmp( msg, "(change_player_type ", 20 ) )
-    {
-        M_impl->analyzeChangePlayerType( msg );
-    }
-    else if ( ! std::strncmp( msg, "(player_type ", 13 ) )  // hetero param
-    {
-        M_impl->analyzePlayerType( msg );
-    }
-    else if ( ! std::strncmp( msg, "(player_param ", 14 ) ) // tradeoff param
-    {
-        M_impl->analyzePlayerParam( msg );
-    }
-    else if ( ! std::strncmp(msg, "(server_param ", 14) )
-    {
-        M_impl->analyzeServerParam( msg );
-    }
-    else if ( ! std::strncmp( msg, "(ok ", 4 ) )
-    {
-        M_impl->analyzeOK( msg );
-    }
-    else if ( ! std::strncmp( msg, "(error ", 7 ) )
-    {
-        M_impl->analyzeError( msg );
-    }
-    else if ( ! std::strncmp( msg, "(warning ", 9 ) )
-    {
-        M_impl->analyzeWarning( msg );
-    }
-    else if ( ! std::strncmp( msg, "(score ", 7 ) )
-    {
-        M_impl->analyzeScore( msg );
-    }
-    else if ( ! std::strncmp( msg, "(init ", 6 )
-              || ! std::strncmp( msg, "(reconnect ", 11 ) )
-    {
-        M_impl->analyzeInit( msg );
+    // dispatch by the first character of the message type,
+    // then confirm the whole type name.
+    switch ( msg[0] == '(' ? msg[1] : '\0' ) {
+    case 's':
+        if ( has_prefix( msg, "(see " ) )
+        {
+            M_impl->analyzeSee( msg );
+            return;
+        }
+        if ( has_prefix( msg, "(sense_body " ) )
+        {
+            M_impl->analyzeSenseBody( msg );
+            return;
+        }
+        if ( has_prefix( msg, "(server_param " ) )
+        {
+            M_impl->analyzeServerParam( msg );
+            return;
+        }
+        if ( has_prefix( msg, "(score " ) )
+        {
+            M_impl->analyzeScore( msg );
+            return;
+        }
+        break;
+    case 'h':
+        if ( has_prefix( msg, "(hear " ) )
+        {
+            M_impl->analyzeHear( msg );
+            return;
+        }
+        break;
+    case 't':
+        if ( has_prefix( msg, "(think)" ) )
+        {
+            M_impl->think_received_ = true;
+            return;
+        }
+        break;
+    case 'f':
+        if ( has_prefix( msg, "(fullstate " ) )
+        {
+            M_impl->analyzeFullstate( msg );
+            return;
+        }
+        break;
+    case 'c':
+        if ( has_prefix( msg, "(change_player_type " ) )
+        {
+            M_impl->analyzeChangePlayerType( msg );
+            return;
+        }
+        break;
+    case 'p':
+        if ( has_prefix( msg, "(player_type " ) ) // hetero param
+        {
+            M_impl->analyzePlayerType( msg );
+            return;
+        }
+        if ( has_prefix( msg, "(player_param " ) ) // tradeoff param
+        {
+            M_impl->analyzePlayerParam( msg );
+            return;
+        }
+        break;
+    case 'o':
+        if ( has_prefix( msg, "(ok " ) )
+        {
+            M_impl->analyzeOK( msg );
+            return;
+        }
+        break;
+    case 'e':
+        if ( has_prefix( msg, "(error " ) )
+        {
+            M_impl->analyzeError( msg );
+            return;
+        }
+        break;
+    case 'w':
+        if ( has_prefix( msg, "(warning " ) )
+        {
+            M_impl->analyzeWarning( msg );
+            return;
+        }
+        break;
+    case 'i':
+    case 'r':
+        if ( has_prefix( msg, "(init " )
+             || has_prefix( msg, "(reconnect " ) )
+        {
+            M_impl->analyzeInit( msg );
+            return;
+        }
+        break;
+    default:
+        break;
     }
-    else
-    {
-        std::cout << world().teamName() << ' '
-                  << world().self().unum() << ": "
-                  << world().time()
-                  << " Received unsupported message : ["
-                  << msg << "]" << std::endl;
-    };
+
+    std::cout << world().teamName() << ' '
+              << world().self().unum() << ": "
+              << world().time()
+              << " Received unsupported message : ["
+              << msg << "]" << std::endl;
 }
 
 /*-------------------------------------------------------------------*/
@@ -1521,12 +2282,21 @@ PlayerAgent::parse( const char * msg )
  */
 bool
 PlayerAgent::Impl::analyzeCycle( const char * msg,
-                                 bool by_sense_body )
+                                 bool by_sense_body,
+                                 const char ** next )
 {
-    char id[16];
+    // (<TYPE> <TIME> ...
+    const char * first = msg;
+    while ( *first != '\0' && *first != ' ' ) ++first;
+    while ( *first == ' ' ) ++first;
+
+    const char * last = first;
+    while ( *last != '\0' && *last != ' ' && *last != ')' ) ++last;
+
     long cycle = 0;
-    if ( std::sscanf( msg, "(%15s %ld ",
-                      id, &cycle ) != 2 )
+    const std::from_chars_result r = std::from_chars( first, last, cycle );
+    if ( r.ec != std::errc()
+         || r.ptr != last )
     {
         std::cerr << agent_.world().teamName() << ' '
                   << agent_.world().self().unum() << ": "
@@ -1538,7 +2308,13 @@ PlayerAgent::Impl::analyzeCycle( const char * msg,
         return false;
     }
 
+    if ( next )
+    {
+        *next = last;
+    }
+
     updateCurrentTime( cycle, by_sense_body );
+    trace_.setCycle( current_time_.cycle() );
     return true;
 }
 
@@ -1549,6 +2325,7 @@ PlayerAgent::Impl::analyzeCycle( const char * msg,
 void
 PlayerAgent::Impl::analyzeSee( const char * msg )
 {
+    TraceRecorder::Scope trace( trace_, "parse_see" );
     std::int64_t msec_from_sense = -1;
 
     see_time_stamp_.setNow();
@@ -1607,10 +2384,14 @@ PlayerAgent::Impl::analyzeSee( const char * msg )
          && agent_.world().seeTime() != current_time_ )
     {
         // update seen objects
+        ThinkTimeProfiler::Scope profile( think_profiler_, ThinkTimeProfiler::UPDATE_AFTER_SEE );
+        TraceRecorder::Scope trace( trace_, "update_after_see" );
+        RCSC_PERF_TIMER( player_world_update );
         agent_.M_worldmodel.updateAfterSee( visual_,
                                             body_,
                                             agent_.effector(),
                                             current_time_ );
+        event_scheduler_.notify( PlayerEventScheduler::SEE );
     }
 
     // adjust see synch
@@ -1630,6 +2411,7 @@ PlayerAgent::Impl::analyzeSee( const char * msg )
 void
 PlayerAgent::Impl::analyzeSenseBody( const char * msg )
 {
+    TraceRecorder::Scope trace( trace_, "parse_sense_body" );
     body_time_stamp_.setNow();
 
     // parse cycle info
@@ -1657,9 +2439,20 @@ PlayerAgent::Impl::analyzeSenseBody( const char * msg )
     // check command counter
     agent_.M_effector.checkCommandCount( body_ );
     // pure internal update
-    agent_.M_worldmodel.updateAfterSenseBody( body_,
-                                              agent_.effector(),
-                                              current_time_ );
+    {
+        RCSC_PERF_TIMER( player_world_update );
+        agent_.M_worldmodel.updateAfterSenseBody( body_,
+                                                  agent_.effector(),
+                                                  current_time_ );
+    }
+    event_scheduler_.notify( PlayerEventScheduler::SENSE_BODY );
+
+    // start the pre-computation while waiting for see
+    speculative_task_ = agent_.createSpeculativeTask();
+    if ( speculative_task_ )
+    {
+        speculative_worker_.submit( speculative_task_ );
+    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -1688,17 +2481,24 @@ PlayerAgent::Impl::analyzeSenseBody( const char * msg )
 void
 PlayerAgent::Impl::analyzeHear( const char * msg )
 {
+    TraceRecorder::Scope trace( trace_, "parse_hear" );
     // parse cycle info
-    if ( ! analyzeCycle( msg, false ) )
+    const char * sender_begin = nullptr;
+    if ( ! analyzeCycle( msg, false, &sender_begin ) )
     {
         return;
     }
+
     // parse sender info
-    long cycle;
-    char sender[128];
+    while ( *sender_begin == ' ' ) ++sender_begin;
+    const char * sender_end = sender_begin;
+    while ( *sender_end != '\0'
+            && ! std::isspace( static_cast< unsigned char >( *sender_end ) ) )
+    {
+        ++sender_end;
+    }
 
-    if ( std::sscanf( msg, "(hear %ld %127s ",
-                      &cycle, sender ) != 2 )
+    if ( sender_begin == sender_end )
     {
         std::cerr << agent_.world().teamName() << ' '
                   << agent_.world().self().unum() << ": "
@@ -1711,40 +2511,41 @@ PlayerAgent::Impl::analyzeHear( const char * msg )
         return;
     }
 
+    const std::string_view sender( sender_begin, sender_end - sender_begin );
 
     // check sender name
 
-    if ( ! std::strncmp( sender, "self", 4 ) )
+    if ( sender.substr( 0, 4 ) == "self" )
     {
         // nothing to do
     }
-    else if ( sender[0] == '-' || std::isdigit( sender[0] ) )
+    else if ( sender[0] == '-' || std::isdigit( static_cast< unsigned char >( sender[0] ) ) )
     {
         // complete audio from other player
         // sender string means the direction to the sender player.
         analyzeHearPlayer( msg );
     }
-    else if ( ! std::strncmp( sender, "our", 3 )
-              || ! std::strncmp( sender, "opp", 3 ) )
+    else if ( sender.substr( 0, 3 ) == "our"
+              || sender.substr( 0, 3 ) == "opp" )
     {
         // partial audio from other player
         // nothing to do
     }
-    else if ( ! std::strncmp( sender, "referee", 7 ) )
+    else if ( sender.substr( 0, 7 ) == "referee" )
     {
         analyzeHearReferee( msg );
     }
-    else if ( ! std::strncmp( sender, "online_coach_left", 17 ) )
+    else if ( sender.substr( 0, 17 ) == "online_coach_left" )
     {
         if ( agent_.world().ourSide() == LEFT ) analyzeHearOurCoach( msg );
         if ( agent_.world().ourSide() == RIGHT ) analyzeHearOpponentCoach( msg );
     }
-    else if ( ! std::strncmp( sender, "online_coach_right", 18 ) )
+    else if ( sender.substr( 0, 18 ) == "online_coach_right" )
     {
         if ( agent_.world().ourSide() == RIGHT ) analyzeHearOurCoach( msg );
         if ( agent_.world().ourSide() == LEFT ) analyzeHearOpponentCoach( msg );
     }
-    else if ( ! std::strncmp( sender, "coach", 5 ) )
+    else if ( sender.substr( 0, 5 ) == "coach" )
     {
         analyzeHearTrainer( msg );
     }
@@ -1781,51 +2582,28 @@ PlayerAgent::Impl::analyzeHearReferee( const char * msg )
         return;
     }
 
-    if ( ! game_mode_.update( mode, current_time_ ) )
-    {
-        if ( ! std::strncmp( mode, "yellow_card", std::strlen( "yellow_card" ) ) )
-        {
-            char side = '?';
-            int unum = Unum_Unknown;
-            if ( std::sscanf( mode, "yellow_card_%c_%d", &side, &unum ) != 2 )
-            {
-                std::cerr << agent_.world().teamName() << ' '
-                          << agent_.world().self().unum() << ": "
-                          << agent_.world().time()
-                          << " could not parse the yellow card message [" << msg << ']'
-                          << std::endl;
-            }
+    PlayModeInfo info;
+    PlayModeDecoder::decode( mode, &info );
 
-            agent_.M_worldmodel.setCard( ( side == 'l'
-                                           ? LEFT
-                                           : side == 'r'
-                                           ? RIGHT
-                                           : NEUTRAL ),
-                                         unum,
-                                         YELLOW );
-        }
-        else if ( ! std::strncmp( mode, "red_card", std::strlen( "red_card" ) ) )
+    if ( ! game_mode_.update( info, current_time_ ) )
+    {
+        if ( info.kind_ == PlayModeInfo::YELLOW_CARD
+             || info.kind_ == PlayModeInfo::RED_CARD )
         {
-            char side = '?';
-            int unum = Unum_Unknown;
-            if ( std::sscanf( mode, "red_card_%c_%d", &side, &unum ) != 2 )
+            if ( info.value_ < 0 )
             {
                 std::cerr << agent_.world().teamName() << ' '
                           << agent_.world().self().unum() << ": "
                           << agent_.world().time()
-                          << " could not parse the red card message [" << msg << ']'
+                          << " could not parse the card message [" << msg << ']'
                           << std::endl;
             }
 
-            agent_.M_worldmodel.setCard( ( side == 'l'
-                                           ? LEFT
-                                           : side == 'r'
-                                           ? RIGHT
-                                           : NEUTRAL ),
-                                         unum,
-                                         RED );
+            agent_.M_worldmodel.setCard( info.side_,
+                                         ( info.value_ < 0 ? Unum_Unknown : info.value_ ),
+                                         ( info.kind_ == PlayModeInfo::YELLOW_CARD ? YELLOW : RED ) );
         }
-        else if ( ! std::strncmp( mode, "training", std::strlen( "training" ) ) )
+        else if ( info.kind_ == PlayModeInfo::TRAINING )
         {
             // end keepaway (or some training) episode
 
@@ -1876,6 +2654,13 @@ PlayerAgent::Impl::analyzeHearReferee( const char * msg )
     {
         agent_.M_fullstate_worldmodel.updateGameMode( game_mode_, current_time_ );
     }
+    event_scheduler_.notify( PlayerEventScheduler::PLAYMODE );
+
+    if ( game_mode_.type() == GameMode::AfterGoal_
+         && game_mode_.side() != agent_.world().ourSide() )
+    {
+        dlog.triggerFlightRecorder( "goal_conceded" );
+    }
 
     //
     // if playmode change to NOT play_on mode, reset current intention queue
@@ -1908,6 +2693,7 @@ PlayerAgent::Impl::analyzeHearPlayer( const char * msg )
 
     // parse message
     audio_.parsePlayerMessage( msg, current_time_ );
+    event_scheduler_.notify( PlayerEventScheduler::HEAR_PLAYER );
 }
 
 /*-------------------------------------------------------------------*/
@@ -1956,6 +2742,7 @@ PlayerAgent::Impl::analyzeHearTrainer( const char * msg )
 void
 PlayerAgent::Impl::analyzeFullstate( const char * msg )
 {
+    TraceRecorder::Scope trace( trace_, "parse_fullstate" );
     if ( ! analyzeCycle( msg, false ) )
     {
         return;
@@ -1994,8 +2781,20 @@ PlayerAgent::Impl::analyzePlayerType( const char * msg )
 {
     dlog.addText( Logger::SENSOR,
                   "===receive player_type" );
-    PlayerType player_type( msg, agent_.config().version() );
-    PlayerTypeSet::instance().insert( player_type );
+    const double version = agent_.config().version();
+    int id = Hetero_Unknown;
+    const bool updated = SharedParam::apply( msg, version,
+                                             [&]()
+                                               {
+                                                   PlayerType player_type( msg, version );
+                                                   PlayerTypeSet::instance().insert( player_type );
+                                               } );
+
+    if ( std::sscanf( msg, " ( player_type ( id %d ) ", &id ) == 1
+         || std::sscanf( msg, " ( player_type %d ", &id ) == 1 )
+    {
+        startTypeTables( id, updated );
+    }
 
     agent_.handlePlayerType();
 }
@@ -2009,7 +2808,12 @@ PlayerAgent::Impl::analyzePlayerParam( const char * msg )
 {
     dlog.addText( Logger::SENSOR,
                   "===receive player_param" );
-    PlayerParam::instance().parse( msg, agent_.config().version() );
+    const double version = agent_.config().version();
+    SharedParam::apply( msg, version,
+                        [&]()
+                          {
+                              PlayerParam::instance().parse( msg, version );
+                          } );
 
     agent_.handlePlayerParam();
 }
@@ -2024,8 +2828,15 @@ PlayerAgent::Impl::analyzeServerParam( const char * msg )
     dlog.addText( Logger::SENSOR,
                   "===receive server_param" );
     //std::cout << msg << std::endl;
-    ServerParam::instance().parse( msg, agent_.config().version() );
-    PlayerTypeSet::instance().resetDefaultType();
+    const double version = agent_.config().version();
+    const bool updated = SharedParam::apply( msg, version,
+                                             [&]()
+                                               {
+                                                   ServerParam::instance().parse( msg, version );
+                                                   PlayerTypeSet::instance().resetDefaultType();
+                                               } );
+
+    startTypeTables( Hetero_Default, updated );
 
     agent_.M_worldmodel.setServerParam();
 
@@ -2052,6 +2863,109 @@ PlayerAgent::Impl::analyzeServerParam( const char * msg )
     agent_.handleServerParam();
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerAgent::Impl::startTypeTables( const int id,
+                                    const bool updated )
+{
+    if ( id < 0 )
+    {
+        return;
+    }
+
+    if ( static_cast< int >( type_tables_.size() ) <= id )
+    {
+        type_tables_.resize( id + 1 );
+    }
+
+    std::shared_future< void > & build = type_tables_[id];
+    if ( build.valid() )
+    {
+        if ( ! updated )
+        {
+            // the same parameters are received again. reuse the tables.
+            return;
+        }
+
+        // the build for the old parameters has to finish before rebuilding
+        waitTypeTables( id );
+    }
+
+    const PlayerType * ptype = PlayerTypeSet::i().get( id );
+    if ( ! ptype )
+    {
+        build = std::shared_future< void >();
+        return;
+    }
+
+    // the build refers its own copy, because PlayerTypeSet may be updated
+    // by the main thread while the build is running.
+    std::shared_ptr< const PlayerType > type = std::make_shared< PlayerType >( *ptype );
+    PlayerAgent * agent = &agent_;
+    build = std::async( std::launch::async,
+                        [agent, type]()
+                          {
+                              agent->buildPlayerTypeTables( *type );
+                          } ).share();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+PlayerAgent::Impl::waitTypeTables( const int id )
+{
+    if ( id < 0
+         || static_cast< int >( type_tables_.size() ) <= id
+         || ! type_tables_[id].valid() )
+    {
+        return true;
+    }
+
+    const std::shared_future< void > & build = type_tables_[id];
+    if ( build.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready )
+    {
+        Timer timer;
+        build.wait();
+        dlog.addText( Logger::SYSTEM,
+                      __FILE__" (waitTypeTables) type=%d waited %.3f [ms]",
+                      id, timer.elapsedReal() );
+    }
+
+    try
+    {
+        build.get();
+    }
+    catch ( std::exception & e )
+    {
+        std::cerr << agent_.config().teamName() << ' '
+                  << agent_.config().playerNumber() << ": "
+                  << "***ERROR*** failed to build the tables of player type " << id
+                  << " : " << e.what() << std::endl;
+        type_tables_[id] = std::shared_future< void >();
+        return false;
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerAgent::Impl::waitAllTypeTables()
+{
+    for ( std::size_t i = 0; i < type_tables_.size(); ++i )
+    {
+        waitTypeTables( static_cast< int >( i ) );
+    }
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -2360,7 +3274,26 @@ PlayerAgent::Impl::analyzeWarning( const char * msg )
 void
 PlayerAgent::action()
 {
+    ThinkTimeProfiler::Scope profile_action( M_impl->think_profiler_, ThinkTimeProfiler::ACTION );
+    TraceRecorder::Scope trace_action( M_impl->trace_, "action" );
     Timer timer;
+
+    // sample the memory usage before the scratch memory is released
+    M_impl->registerMemoryProbes();
+    if ( config().memoryReport() )
+    {
+        MemoryAccounting::instance().sample();
+    }
+
+    // release the scratch memory used in the previous cycle
+    M_impl->cycle_arena_.reset();
+
+    // set the time limit of this decision
+    {
+        const Deadline deadline = M_impl->createDecisionDeadline();
+        M_worldmodel.setDecisionDeadline( deadline );
+        M_fullstate_worldmodel.setDecisionDeadline( deadline );
+    }
     dlog.addText( Logger::SYSTEM,
                   __FILE__" (action) start" );
 
@@ -2397,13 +3330,36 @@ PlayerAgent::action()
     // ------------------------------------------------------------------------
     // last update
     // update positining matrix, offside line, defense line, etc.
-    M_worldmodel.updateJustBeforeDecision( effector(),
-                                           M_impl->current_time_ );
-    if ( config().debugFullstate()
-         && M_fullstate_worldmodel.isValid() )
     {
-        M_fullstate_worldmodel.updateJustBeforeDecision( effector(),
-                                                         M_impl->current_time_ );
+        ThinkTimeProfiler::Scope profile( M_impl->think_profiler_, ThinkTimeProfiler::UPDATE_BEFORE_DECISION );
+        TraceRecorder::Scope trace( M_impl->trace_, "update_before_decision" );
+        RCSC_PERF_TIMER( player_world_update );
+        M_worldmodel.updateJustBeforeDecision( effector(),
+                                               M_impl->current_time_ );
+        if ( config().debugFullstate()
+             && M_fullstate_worldmodel.isValid() )
+        {
+            M_fullstate_worldmodel.updateJustBeforeDecision( effector(),
+                                                             M_impl->current_time_ );
+        }
+    }
+
+    // stop the pre-computation, then correct its result by the latest world model
+    if ( M_impl->speculative_task_ )
+    {
+        M_impl->speculative_worker_.cancel();
+        if ( ! M_impl->speculative_task_->finish( world() ) )
+        {
+            dlog.addText( Logger::SYSTEM,
+                          __FILE__" (action) speculative task is not available. completed=%d",
+                          (int)M_impl->speculative_task_->completed() );
+        }
+    }
+
+    // the derived tables of the own player type have to be ready before the decision
+    if ( world().self().playerTypePtr() )
+    {
+        M_impl->waitTypeTables( world().self().playerTypePtr()->id() );
     }
 
     // reset last action effect
@@ -2423,12 +3379,19 @@ PlayerAgent::action()
         M_impl->adjustSeeSynchSynchMode();
     }
 
-    actionImpl(); // this is pure virtual method
-    M_impl->doArmAction();
-    M_impl->doViewAction();
-    M_impl->doNeckAction();
-    M_impl->doFocusAction();
-    communicationImpl();
+    {
+        ThinkTimeProfiler::Scope profile( M_impl->think_profiler_, ThinkTimeProfiler::ACTION_IMPL );
+        TraceRecorder::Scope trace( M_impl->trace_, "action_impl" );
+        RCSC_PERF_TIMER( player_action );
+        // resume the behaviours waiting for the events of this cycle
+        M_impl->event_scheduler_.dispatch( *this );
+        actionImpl(); // this is pure virtual method
+        M_impl->doArmAction();
+        M_impl->doViewAction();
+        M_impl->doNeckAction();
+        M_impl->doFocusAction();
+        communicationImpl();
+    }
 
     // ------------------------------------------------------------------------
     // set command effect. these must be called before command composing.
@@ -2444,15 +3407,30 @@ PlayerAgent::action()
     // ------------------------------------------------------------------------
     // compose command string, and send it to the rcssserver
     {
-        std::ostringstream ostr;
-        M_effector.makeCommand( ostr );
-        const std::string str = ostr.str();
-        if ( str.length() > 0 )
+        ThinkTimeProfiler::Scope profile( M_impl->think_profiler_, ThinkTimeProfiler::SEND );
+        TraceRecorder::Scope trace( M_impl->trace_, "send" );
+        CommandWriter & writer = M_impl->command_writer_;
+        writer.clear();
+        M_effector.makeCommand( writer );
+        if ( writer.overflow() )
+        {
+            // a truncated S-expression must not be sent. the counts of the
+            // dropped commands are corrected by the next sense_body.
+            std::cerr << world().teamName() << ' '
+                      << world().self().unum() << ": "
+                      << world().time()
+                      << " command string overflowed. no command is sent." << std::endl;
+            dlog.addText( Logger::SYSTEM,
+                          __FILE__" (action) command string overflowed. no command is sent." );
+        }
+        else if ( ! writer.empty() )
         {
             dlog.addText( Logger::SYSTEM,
                           "---- send[%s]",
-                          str.c_str() );
-            M_client->sendMessage( str.c_str() );
+                          writer.c_str() );
+            M_client->sendMessage( writer.c_str() );
+            M_impl->recordCommandLatency( M_client->sentNSec(),
+                                          static_cast< std::int64_t >( timer.elapsedReal() * 1000.0 * 1000.0 ) );
         }
     }
 
@@ -2461,6 +3439,15 @@ PlayerAgent::action()
     M_impl->last_decision_time_ = M_impl->current_time_;
     double elapsed = timer.elapsedReal();
 
+    if ( M_impl->think_profiler_.isEnabled()
+         && M_impl->body_time_stamp_.isValid() )
+    {
+        M_impl->think_profiler_.setBudget( config().thinkBudgetMSec() > 0.0
+                                           ? config().thinkBudgetMSec()
+                                           : static_cast< double >( ServerParam::i().simulatorStep() ) );
+        M_impl->think_profiler_.addCycle( TimeStamp::now().elapsedUSecSince( M_impl->body_time_stamp_ ) );
+    }
+
     dlog.addText( Logger::SYSTEM,
                   __FILE__" (action) elapsed %lf [ms]", elapsed );
     M_debug_client.addMessage( "%.0fms", elapsed );
@@ -2479,6 +3466,31 @@ PlayerAgent::action()
     M_effector.clearAllCommands();
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerAgent::Impl::fastForward()
+{
+    agent_.M_worldmodel.updateJustBeforeDecision( agent_.effector(), current_time_ );
+    if ( agent_.config().debugFullstate()
+         && agent_.M_fullstate_worldmodel.isValid() )
+    {
+        agent_.M_fullstate_worldmodel.updateJustBeforeDecision( agent_.effector(), current_time_ );
+    }
+
+    // no command is performed. the next sense_body corrects the self state.
+    agent_.M_effector.reset();
+    agent_.M_worldmodel.updateJustAfterDecision( agent_.effector() );
+
+    last_decision_time_ = current_time_;
+
+    printDebug();
+
+    agent_.M_effector.clearAllCommands();
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -3348,16 +4360,18 @@ PlayerAgent::setFocusAction( FocusAction * act )
 
  */
 void
-PlayerAgent::addSayMessage( SayMessage * message )
+PlayerAgent::addSayMessage( SayMessage * message,
+                            const int priority )
 {
     if ( ! config().useCommunication() )
     {
         dlog.addText( Logger::ACTION,
                       __FILE__": agent->addSayMessage. communication is not allowed" );
+        delete message;
         return;
     }
 
-    M_effector.addSayMessage( message );
+    M_effector.addSayMessage( message, priority );
 }
 
 /*-------------------------------------------------------------------*/
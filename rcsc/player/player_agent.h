@@ -46,16 +46,22 @@
 
 namespace rcsc {
 
+class AgentContext;
 class AudioSensor;
 class ArmAction;
 class BodySensor;
+class CycleArena;
 class FullstateSensor;
 class FreeformMessageParser;
 class SayMessage;
 class SayMessageParser;
 class SeeState;
 class SoccerIntention;
+class SpeculativeTask;
+class ThinkTimeProfiler;
 class NeckAction;
+class PlayerEventScheduler;
+class PlayerType;
 class ViewAction;
 class FocusAction;
 class VisualSensor;
@@ -203,6 +209,55 @@ public:
     */
     const TimeStamp & seeTimeStamp() const;
 
+    /*!
+      \brief get the time limit of the current decision
+      \return const reference to the deadline object
+    */
+    const Deadline & decisionDeadline() const;
+
+    /*!
+      \brief get the elapsed time recorder of the cycle phases
+      \return const reference to the profiler. samples are recorded only if think_profile is on.
+    */
+    const ThinkTimeProfiler & thinkTimeProfiler() const;
+
+    /*!
+      \brief get the scratch memory arena released at the start of each decision.
+      The same arena is available from WorldModel::scratchResource().
+      \return reference to the arena
+    */
+    CycleArena & cycleArena();
+
+    /*!
+      \brief get the queue of the behaviours waiting for the player events.
+      The waiters are resumed just before actionImpl(). See also player_coroutine.h.
+      \return reference to the scheduler
+    */
+    PlayerEventScheduler & eventScheduler();
+
+    /*!
+      \brief get the per-agent storage of the action caches.
+      The same context is available from WorldModel::agentContext().
+      \return reference to the context
+    */
+    AgentContext & agentContext();
+
+    /*!
+      \brief get the speculative pre-computation result of the current cycle
+      \return pointer to the task if it completed and was accepted in this decision, otherwise nullptr.
+      The task is created by createSpeculativeTask().
+    */
+    const SpeculativeTask * speculativeTask() const;
+
+    /*!
+      \brief check if the derived tables of the current own player type are ready.
+      \return true if buildPlayerTypeTables() has finished for the own type.
+
+      action() waits for the tables before the decision, so the agent is
+      ready to play when this method returns true.
+    */
+    bool isPlayerTypeReady() const;
+
     /*!
       \brief register kick command
       \param power command argument: kick power
@@ -355,8 +410,29 @@ public:
     /*!
       \brief add say message to the action effector
       \param message pointer to the dynamically allocated object.
+      \param priority packing priority. the higher value is packed first.
      */
-    void addSayMessage( SayMessage * message );
+    void addSayMessage( SayMessage * message,
+                        const int priority = 0 );
+
+    /*!
+      \brief construct the say message in the action effector without any allocation.
+      \param priority packing priority. the higher value is packed first.
+      \param args arguments passed to the constructor of the message
+      \return true if the message is registered.
+     */
+    template < typename Message, typename... Args >
+    bool emplaceSayMessage( const int priority,
+                            Args &&... args )
+      {
+          if ( ! config().useCommunication() )
+          {
+              return false;
+          }
+
+          return M_effector.emplaceSayMessage< Message >( priority,
+                                                          std::forward< Args >( args )... );
+      }
 
     /*!
       \brief remove the registered say message if exist
@@ -497,6 +573,23 @@ protected:
     void handleActionStart()
       { }
 
+    /*!
+      \brief virtual method. create the pre-computation executed on the worker thread.
+      \return new task object, or empty pointer if nothing to do.
+
+      This method is called just after the world model is updated by
+      sense_body, and the returned task runs in the background while the
+      agent waits for the see message. The task is cancelled at the top
+      of action() if it has not completed. See SpeculativeTask for the
+      restrictions of the task.
+      Do *not* call this method by yourself.
+    */
+    virtual
+    std::shared_ptr< SpeculativeTask > createSpeculativeTask()
+      {
+          return std::shared_ptr< SpeculativeTask >();
+      }
+
     /*!
       \brief This method is called at the end of action() but before the debug output.
       Do *not* call this method by yourself.
@@ -537,6 +630,24 @@ protected:
     void handlePlayerType()
       { }
 
+    /*!
+      \brief this method is called on a background thread for each player type
+      to create the derived tables of the type.
+      \param type copy of the analyzed player type
+
+      The build is started just after server_param (for the default type) or
+      player_type message is analyzed, so the tables are created while the
+      other parameter messages are arriving. The build is not restarted if the
+      same parameters are received again (e.g. after reconnect). action()
+      waits for the build of the own player type before the decision.
+      This method must not touch the world model, the debug loggers or any
+      other state used by the main thread.
+      Do *not* call this method by yourself.
+     */
+    virtual
+    void buildPlayerTypeTables( const PlayerType & )
+      { }
+
     /*!
       \brief this method is called just after analyzing online coach's say message.
       Do *not* call this method by yourself.
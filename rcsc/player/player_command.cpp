@@ -35,13 +35,28 @@
 
 #include "player_command.h"
 
+#include "command_writer.h"
 #include "see_state.h"
 
+#include <sstream>
+
 namespace rcsc {
 
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+PlayerCommand::writeCommand( CommandWriter & to ) const
+{
+    std::ostringstream os;
+    toCommandString( os );
+    to.put( os.str() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 PlayerInitCommand::PlayerInitCommand( const std::string & team_name,
                                       const double & version,
@@ -130,6 +145,16 @@ PlayerMoveCommand::toCommandString( std::ostream & to ) const
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+PlayerMoveCommand::writeCommand( CommandWriter & to ) const
+{
+    to.put( "(move " ).put( M_x ).put( ' ' ).put( M_y ).put( ')' );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 std::ostream &
 PlayerDashCommand::toCommandString( std::ostream & to ) const
@@ -154,6 +179,30 @@ PlayerDashCommand::toCommandString( std::ostream & to ) const
     return to;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PlayerDashCommand::writeCommand( CommandWriter & to ) const
+{
+    if ( ! M_two_legs )
+    {
+        to.put( "(dash " ).put( M_power );
+        if ( M_dir != 0.0 )
+        {
+            to.put( ' ' ).put( M_dir );
+        }
+        to.put( ')' );
+    }
+    else
+    {
+        to.put( "(dash (l " ).put( M_left_power ).put( ' ' ).put( M_left_dir )
+            .put( ") (r " ).put( M_right_power ).put( ' ' ).put( M_right_dir )
+            .put( "))" );
+    }
+}
+
 
 /*-------------------------------------------------------------------*/
 // std::ostream &
@@ -179,6 +228,16 @@ PlayerTurnCommand::toCommandString( std::ostream & to ) const
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+PlayerTurnCommand::writeCommand( CommandWriter & to ) const
+{
+    to.put( "(turn " ).put( M_moment ).put( ')' );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 std::ostream &
 PlayerKickCommand::toCommandString( std::ostream & to ) const
@@ -189,6 +248,16 @@ PlayerKickCommand::toCommandString( std::ostream & to ) const
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+PlayerKickCommand::writeCommand( CommandWriter & to ) const
+{
+    to.put( "(kick " ).put( M_power ).put( ' ' ).put( M_dir ).put( ')' );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 std::ostream &
 PlayerCatchCommand::toCommandString( std::ostream & to ) const
@@ -199,6 +268,16 @@ PlayerCatchCommand::toCommandString( std::ostream & to ) const
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+PlayerCatchCommand::writeCommand( CommandWriter & to ) const
+{
+    to.put( "(catch " ).put( M_dir ).put( ')' );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 std::ostream &
 PlayerTackleCommand::toCommandString( std::ostream & to ) const
@@ -216,6 +295,21 @@ PlayerTackleCommand::toCommandString( std::ostream & to ) const
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+PlayerTackleCommand::writeCommand( CommandWriter & to ) const
+{
+    to.put( "(tackle " ).put( M_power_or_dir );
+    if ( M_foul )
+    {
+        to.put( " on" );
+    }
+    to.put( ')' );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 std::ostream &
 PlayerTurnNeckCommand::toCommandString( std::ostream & to ) const
@@ -226,6 +320,16 @@ PlayerTurnNeckCommand::toCommandString( std::ostream & to ) const
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+PlayerTurnNeckCommand::writeCommand( CommandWriter & to ) const
+{
+    to.put( "(turn_neck " ).put( M_moment ).put( ')' );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 std::ostream &
 PlayerChangeViewCommand::toCommandString( std::ostream & to ) const
@@ -244,6 +348,22 @@ PlayerChangeViewCommand::toCommandString( std::ostream & to ) const
     return to;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PlayerChangeViewCommand::writeCommand( CommandWriter & to ) const
+{
+    to.put( "(change_view " ).put( M_width.str() );
+
+    if ( ! SeeState::synch_see_mode() )
+    {
+        to.put( ' ' ).put( M_quality.str() );
+    }
+    to.put( ')' );
+}
+
 
 /*-------------------------------------------------------------------*/
 /*!
@@ -258,6 +378,16 @@ PlayerChangeFocusCommand::toCommandString( std::ostream & to ) const
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+PlayerChangeFocusCommand::writeCommand( CommandWriter & to ) const
+{
+    to.put( "(change_focus " ).put( M_moment_dist ).put( ' ' ).put( M_moment_dir ).put( ')' );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 std::ostream &
 PlayerSayCommand::toCommandString( std::ostream & to ) const
@@ -279,6 +409,26 @@ PlayerSayCommand::toCommandString( std::ostream & to ) const
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+PlayerSayCommand::writeCommand( CommandWriter & to ) const
+{
+    if ( ! M_message.empty() )
+    {
+        if ( M_version >= 8.0 )
+        {
+            to.put( "(say \"" ).put( M_message ).put( "\")" );
+        }
+        else
+        {
+            to.put( "(say " ).put( M_message ).put( ')' );
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 std::ostream &
 PlayerPointtoCommand::toCommandString( std::ostream & to ) const
@@ -297,6 +447,23 @@ PlayerPointtoCommand::toCommandString( std::ostream & to ) const
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+PlayerPointtoCommand::writeCommand( CommandWriter & to ) const
+{
+    if ( M_on )
+    {
+        to.put( "(pointto " ).put( M_dist ).put( ' ' ).put( M_dir ).put( ')' );
+    }
+    else
+    {
+        to.put( "(pointto off)" );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 std::ostream &
 PlayerAttentiontoCommand::toCommandString( std::ostream & to ) const
@@ -314,6 +481,24 @@ PlayerAttentiontoCommand::toCommandString( std::ostream & to ) const
     return to;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PlayerAttentiontoCommand::writeCommand( CommandWriter & to ) const
+{
+    if ( M_side != NONE )
+    {
+        to.put( M_side == OUR ? "(attentionto our " : "(attentionto opp " )
+            .put( M_number ).put( ')' );
+    }
+    else
+    {
+        to.put( "(attentionto off)" );
+    }
+}
+
 
 /*-------------------------------------------------------------------*/
 /*!
@@ -409,4 +594,14 @@ PlayerDoneCommand::toCommandString( std::ostream & to ) const
     return to << "(done)";
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+PlayerDoneCommand::writeCommand( CommandWriter & to ) const
+{
+    to.put( "(done)" );
+}
+
 }
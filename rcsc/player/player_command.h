@@ -42,6 +42,8 @@
 
 namespace rcsc {
 
+class CommandWriter;
+
 /*!
   \class PlayerCommand
   \brief abstract player command class
@@ -113,6 +115,14 @@ public:
     virtual
     std::ostream & toCommandString( std::ostream & to ) const = 0;
 
+    /*!
+      \brief write command string into the fixed buffer.
+      The default implementation uses toCommandString( std::ostream & ).
+      \param to reference to the command writer
+    */
+    virtual
+    void writeCommand( CommandWriter & to ) const;
+
     /*!
       \brief get command name (pure virtual)
       \return command name string
@@ -447,6 +457,12 @@ public:
     */
     std::ostream & toCommandString( std::ostream & to ) const;
 
+    /*!
+      \brief write command string into the fixed buffer
+      \param to reference to the command writer
+    */
+    void writeCommand( CommandWriter & to ) const;
+
     /*!
       \brief get command name
       \return command name string
@@ -544,6 +560,12 @@ public:
     */
     std::ostream & toCommandString( std::ostream & to ) const;
 
+    /*!
+      \brief write command string into the fixed buffer
+      \param to reference to the command writer
+    */
+    void writeCommand( CommandWriter & to ) const;
+
     /*!
       \brief get command name
       \return command name string
@@ -689,6 +711,12 @@ public:
     */
     std::ostream & toCommandString( std::ostream & to ) const;
 
+    /*!
+      \brief write command string into the fixed buffer
+      \param to reference to the command writer
+    */
+    void writeCommand( CommandWriter & to ) const;
+
     /*!
       \brief get command name
       \return command name string
@@ -752,6 +780,12 @@ public:
     */
     std::ostream & toCommandString( std::ostream & to ) const;
 
+    /*!
+      \brief write command string into the fixed buffer
+      \param to reference to the command writer
+    */
+    void writeCommand( CommandWriter & to ) const;
+
     /*!
       \brief get command name
       \return command name string
@@ -820,6 +854,12 @@ public:
     */
     std::ostream & toCommandString( std::ostream & to ) const;
 
+    /*!
+      \brief write command string into the fixed buffer
+      \param to reference to the command writer
+    */
+    void writeCommand( CommandWriter & to ) const;
+
     /*!
       \brief get command name
       \return command name string
@@ -888,6 +928,12 @@ public:
     */
     std::ostream & toCommandString( std::ostream & to ) const;
 
+    /*!
+      \brief write command string into the fixed buffer
+      \param to reference to the command writer
+    */
+    void writeCommand( CommandWriter & to ) const;
+
     /*!
       \brief get command name
       \return command name string
@@ -1001,6 +1047,12 @@ public:
     */
     std::ostream & toCommandString( std::ostream & to ) const;
 
+    /*!
+      \brief write command string into the fixed buffer
+      \param to reference to the command writer
+    */
+    void writeCommand( CommandWriter & to ) const;
+
     /*!
       \brief get command name
       \return command name string
@@ -1067,6 +1119,12 @@ public:
     */
     std::ostream & toCommandString( std::ostream & to ) const;
 
+    /*!
+      \brief write command string into the fixed buffer
+      \param to reference to the command writer
+    */
+    void writeCommand( CommandWriter & to ) const;
+
     /*!
       \brief get command paramter
       \return turn neck moment of this command
@@ -1143,6 +1201,12 @@ public:
     */
     std::ostream & toCommandString( std::ostream & to ) const;
 
+    /*!
+      \brief write command string into the fixed buffer
+      \param to reference to the command writer
+    */
+    void writeCommand( CommandWriter & to ) const;
+
     /*!
       \brief get thencommand name
       \return command name string
@@ -1236,6 +1300,12 @@ public:
     */
     std::ostream & toCommandString( std::ostream & to ) const;
 
+    /*!
+      \brief write command string into the fixed buffer
+      \param to reference to the command writer
+    */
+    void writeCommand( CommandWriter & to ) const;
+
     /*!
       \brief get command paramter
       \return turn neck moment of this command
@@ -1330,6 +1400,12 @@ public:
     */
     std::ostream & toCommandString( std::ostream & to ) const;
 
+    /*!
+      \brief write command string into the fixed buffer
+      \param to reference to the command writer
+    */
+    void writeCommand( CommandWriter & to ) const;
+
     /*!
       \brief get command paramter
       \return turn neck moment of this command
@@ -1434,6 +1510,12 @@ public:
     */
     std::ostream & toCommandString( std::ostream & to ) const;
 
+    /*!
+      \brief write command string into the fixed buffer
+      \param to reference to the command writer
+    */
+    void writeCommand( CommandWriter & to ) const;
+
     /*!
       \brief get command paramter
       \return turn neck moment of this command
@@ -1881,6 +1963,12 @@ public:
     */
     std::ostream & toCommandString( std::ostream & to ) const;
 
+    /*!
+      \brief write command string into the fixed buffer
+      \param to reference to the command writer
+    */
+    void writeCommand( CommandWriter & to ) const;
+
     /*!
       \brief get command paramter
       \return turn neck moment of this command
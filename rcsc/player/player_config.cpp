@@ -84,10 +84,20 @@ PlayerConfig::setDefaultParam()
     M_wait_time_thr_synch_view = 30; //79;
     M_wait_time_thr_nosynch_view = 75;
 
+    M_adaptive_send_timing = false;
+    M_send_margin_msec = 5.0;
+
     M_normal_view_time_thr = 15;
 
     M_rcssserver_host = "localhost";
     M_rcssserver_port = 6000;
+    M_shm_transport = false;
+
+    M_cpu_affinity.clear();
+    M_realtime_priority = 0;
+    M_nice = 0;
+    M_lock_memory = false;
+    M_huge_pages = false;
 
     M_compression = -1;
 
@@ -145,6 +155,7 @@ PlayerConfig::setDefaultParam()
     M_offline_log_ext = ".ocl";
 
     M_offline_client_number = Unum_Unknown;
+    M_offline_fast_forward = -1;
 
     //
     // debug logging
@@ -153,6 +164,8 @@ PlayerConfig::setDefaultParam()
     M_debug_end_time = 99999999;
 
     M_debug_log_ext = ".log";
+    M_debug_log_container.clear();
+    M_flight_recorder_steps = 0;
 
     M_debug_system = false;
     M_debug_sensor = false;
@@ -176,6 +189,19 @@ PlayerConfig::setDefaultParam()
     M_debug_analyzer = false;
     M_debug_action_chain = false;
     M_debug_training = false;
+
+    M_think_profile = false;
+    M_think_profile_ext = ".think.json";
+    M_think_budget_msec = 0.0;
+
+    M_trace = false;
+    M_trace_ext = ".trace.json";
+    M_trace_size = 65536;
+
+    M_memory_report = false;
+    M_memory_report_ext = ".memory.json";
+
+    M_worker_threads = 0;
 }
 
 /*-------------------------------------------------------------------*/
@@ -199,10 +225,29 @@ PlayerConfig::createParamMap()
         ( "wait_time_thr_synch_view", "", &M_wait_time_thr_synch_view )
         ( "wait_time_thr_nosynch_view","", &M_wait_time_thr_nosynch_view )
 
+        ( "adaptive_send_timing", "", BoolSwitch( &M_adaptive_send_timing ),
+          "estimate the latest safe send time from the message arrival statistics,"
+          " and use it as the see wait limit and the decision deadline." )
+        ( "send_margin_msec", "", &M_send_margin_msec,
+          "safety margin before the estimated next sense_body arrival in the adaptive send timing mode." )
+
         ( "normal_view_time_thr", "", &M_normal_view_time_thr )
 
         ( "host", "h", &M_rcssserver_host )
         ( "port", "p", &M_rcssserver_port )
+        ( "shm_transport", "", BoolSwitch( &M_shm_transport ),
+          "exchange the messages with the co-located server (or proxy) through the shared memory. host:port receives only the handshake." )
+
+        ( "cpu_affinity", "", &M_cpu_affinity,
+          "pin the agent thread to the cpus. e.g. \"2\" or \"0,2-3\"" )
+        ( "realtime_priority", "", &M_realtime_priority,
+          "run the agent thread with the SCHED_FIFO real-time priority (1-99). 0 keeps the default scheduler." )
+        ( "nice", "", &M_nice,
+          "the nice value of the agent thread. 0 keeps the current value." )
+        ( "lock_memory", "", BoolSwitch( &M_lock_memory ),
+          "lock all pages of the process into memory by mlockall." )
+        ( "huge_pages", "", BoolSwitch( &M_huge_pages ),
+          "back the large arenas by the huge pages." )
 
         ( "compression", "", &M_compression )
 
@@ -243,11 +288,16 @@ PlayerConfig::createParamMap()
         ( "offline_logging", "", BoolSwitch( &M_offline_logging ) )
         ( "offline_log_ext", "", &M_offline_log_ext )
         ( "offline_client_number", "", &M_offline_client_number )
+        ( "offline_fast_forward", "", &M_offline_fast_forward,
+          "in the offline client mode, only update the world model until this cycle." )
 
         ( "debug_start_time", "", &M_debug_start_time )
         ( "debug_end_time", "", &M_debug_end_time )
 
         ( "debug_log_ext", "", &M_debug_log_ext )
+        ( "debug_log_container", "", &M_debug_log_container )
+        ( "flight_recorder_steps", "", &M_flight_recorder_steps,
+          "keep the debug log of the latest game steps in memory, and write it only when a missed action, a conceded goal or SIGUSR2 is detected." )
 
         ( "debug_system", "", BoolSwitch( &M_debug_system ) )
         ( "debug_sensor", "", BoolSwitch( &M_debug_sensor ) )
@@ -271,6 +321,25 @@ PlayerConfig::createParamMap()
         ( "debug_analyzer", "", BoolSwitch( &M_debug_analyzer ) )
         ( "debug_action_chain", "", BoolSwitch( &M_debug_action_chain ) )
         ( "debug_training", "", BoolSwitch( &M_debug_training ) )
+
+        ( "think_profile", "", BoolSwitch( &M_think_profile ),
+          "record the elapsed time of each cycle phase and write the summary at the end of the match." )
+        ( "think_profile_ext", "", &M_think_profile_ext )
+        ( "think_budget_msec", "", &M_think_budget_msec,
+          "think time budget per cycle. non-positive value means simulator_step." )
+
+        ( "trace", "", BoolSwitch( &M_trace ),
+          "record the time spans of each cycle phase and write them in the Chrome trace format at the end of the match." )
+        ( "trace_ext", "", &M_trace_ext )
+        ( "trace_size", "", &M_trace_size,
+          "the number of the latest trace events kept in memory." )
+
+        ( "memory_report", "", BoolSwitch( &M_memory_report ),
+          "sample the memory usage of the library subsystems every cycle and write the peak and steady state values at the end of the match." )
+        ( "memory_report_ext", "", &M_memory_report_ext )
+
+        ( "worker_threads", "", &M_worker_threads,
+          "the number of worker threads for the parallel world model analyses. 0 means sequential. the pool is shared by the agents in one process and limited to the available cpus." )
         ;
 }
 
@@ -64,11 +64,23 @@ private:
     //! msec threshold for action decision timing when no see sync
     int M_wait_time_thr_nosynch_view;
 
+    //! if true, the decision timing and deadline are estimated from the message arrival statistics
+    bool M_adaptive_send_timing;
+    //! msec safety margin before the estimated next sense_body arrival
+    double M_send_margin_msec;
+
     //! msec threshold for normal view width when manual see sync
     int M_normal_view_time_thr;
 
     std::string M_rcssserver_host; //!< host name that rcssserver is running
     int         M_rcssserver_port; //!< rcssserver connection port number
+    bool        M_shm_transport; //!< if true, the shared memory transport is used instead of UDP
+
+    std::string M_cpu_affinity; //!< cpu list of the agent thread
+    int M_realtime_priority; //!< SCHED_FIFO priority of the agent thread. 0 means no change.
+    int M_nice; //!< nice value of the agent thread. 0 means no change.
+    bool M_lock_memory; //!< if true, mlockall is called
+    bool M_huge_pages; //!< if true, the large arenas are backed by the huge pages
 
     int M_compression; //!< zlib compression level for the compression command
 
@@ -134,6 +146,8 @@ private:
 
     //! the uniform number for offline client. 1-11 means offline mode, other values mean online mode.
     int M_offline_client_number;
+    //! the cycle to be reached without decision in the offline client mode. negative value means disabled.
+    int M_offline_fast_forward;
 
     //
     // debug logging
@@ -143,6 +157,8 @@ private:
     int M_debug_end_time; //!< the end time for recording the debug log
 
     std::string M_debug_log_ext; //!< the extension string of debug log file
+    std::string M_debug_log_container; //!< the container file name shared by all agents. empty means one file per agent.
+    int M_flight_recorder_steps; //!< the number of game steps kept by the in-memory flight recorder. 0 means disabled.
 
     bool M_debug_system; //!< debug level flag
     bool M_debug_sensor; //!< debug level flag
@@ -168,6 +184,35 @@ private:
 
     bool M_debug_training; //!< debug level flag
 
+    //
+    // think time profile
+    //
+
+    bool M_think_profile; //!< if true, the elapsed time of each cycle phase is recorded.
+    std::string M_think_profile_ext; //!< the extension string of think time profile file
+    double M_think_budget_msec; //!< think time budget per cycle. non-positive value means simulator_step.
+
+    //
+    // trace
+    //
+
+    bool M_trace; //!< if true, the time spans of each cycle phase are recorded.
+    std::string M_trace_ext; //!< the extension string of trace file
+    int M_trace_size; //!< the number of the latest trace events kept in memory
+
+    //
+    // memory report
+    //
+
+    bool M_memory_report; //!< if true, the memory usage of the subsystems is sampled and written.
+    std::string M_memory_report_ext; //!< the extension string of memory report file
+
+    //
+    // parallel analysis
+    //
+
+    int M_worker_threads; //!< the requested number of TaskPool worker threads. 0 means that all analyses run sequentially.
+
 public:
 
     /*!
@@ -256,6 +301,20 @@ public:
      */
     int waitTimeThrNoSynchView() const { return M_wait_time_thr_nosynch_view; }
 
+    /*!
+      \brief get the switch for the adaptive send timing mode. if true, the
+      wait time for see and the decision deadline are estimated from the
+      arrival statistics instead of wait_time_thr_* and think_budget_msec.
+      \return switch value
+     */
+    bool adaptiveSendTiming() const { return M_adaptive_send_timing; }
+
+    /*!
+      \brief get the safety margin for the adaptive send timing mode
+      \return margin in milli-seconds
+     */
+    double sendMarginMSec() const { return M_send_margin_msec; }
+
     /*!
       \brief get the threshold time to change to normal view width for old timer synch view mode
       \return the threshold time to change to normal view width
@@ -274,6 +333,42 @@ public:
      */
     int port() const { return M_rcssserver_port; }
 
+    /*!
+      \brief check if the shared memory transport is used
+      \return true if ShmClient is used instead of UDP
+     */
+    bool shmTransport() const { return M_shm_transport; }
+
+    /*!
+      \brief get the cpu list string for the affinity of the agent thread
+      \return cpu list string. empty if not pinned.
+     */
+    const std::string & cpuAffinity() const { return M_cpu_affinity; }
+
+    /*!
+      \brief get the SCHED_FIFO priority of the agent thread
+      \return real-time priority. 0 means the default scheduler.
+     */
+    int realtimePriority() const { return M_realtime_priority; }
+
+    /*!
+      \brief get the nice value of the agent thread
+      \return nice value. 0 means no change.
+     */
+    int niceValue() const { return M_nice; }
+
+    /*!
+      \brief check if the process memory is locked
+      \return true if mlockall is used
+     */
+    bool lockMemory() const { return M_lock_memory; }
+
+    /*!
+      \brief check if the large arenas are backed by the huge pages
+      \return true if huge pages are used
+     */
+    bool hugePages() const { return M_huge_pages; }
+
     /*!
       \brief get the server message compression level
       \return server message compression level
@@ -475,6 +570,83 @@ public:
      */
     int offlineClientNumber() const { return M_offline_client_number; }
 
+    /*!
+      \brief get the cycle to be reached by the fast-forward in the offline client mode.
+      the agent only updates the world model before this cycle.
+      \return the target cycle. negative value means disabled.
+     */
+    int offlineFastForward() const { return M_offline_fast_forward; }
+
+    //
+    // think time profile
+    //
+
+    /*!
+      \brief get the switch for the think time profiler
+      \return switch value for the think time profiler
+     */
+    bool thinkProfile() const { return M_think_profile; }
+
+    /*!
+      \brief get the think time profile file extention string.
+      \return the think time profile file extention string.
+     */
+    const std::string & thinkProfileExt() const { return M_think_profile_ext; }
+
+    /*!
+      \brief get the think time budget per cycle.
+      \return the think time budget in milliseconds. non-positive value means simulator_step.
+     */
+    double thinkBudgetMSec() const { return M_think_budget_msec; }
+
+    //
+    // trace
+    //
+
+    /*!
+      \brief get the switch for the trace recorder
+      \return switch value for the trace recorder
+     */
+    bool trace() const { return M_trace; }
+
+    /*!
+      \brief get the trace file extention string.
+      \return the trace file extention string.
+     */
+    const std::string & traceExt() const { return M_trace_ext; }
+
+    /*!
+      \brief get the number of the trace events kept in memory.
+      \return the ring buffer size of the trace recorder.
+     */
+    int traceSize() const { return M_trace_size; }
+
+    //
+    // memory report
+    //
+
+    /*!
+      \brief get the switch for the memory report
+      \return switch value for the memory report
+     */
+    bool memoryReport() const { return M_memory_report; }
+
+    /*!
+      \brief get the memory report file extention string.
+      \return the memory report file extention string.
+     */
+    const std::string & memoryReportExt() const { return M_memory_report_ext; }
+
+    //
+    // parallel analysis
+    //
+
+    /*!
+      \brief get the number of worker threads used by the world model analyses
+      \return the number of threads. 0 means no worker thread.
+     */
+    int workerThreads() const { return M_worker_threads; }
+
     //
     // debug logging
     //
@@ -497,6 +669,18 @@ public:
      */
     const std::string & debugLogExt() const { return M_debug_log_ext; }
 
+    /*!
+      \brief get the debug log container file name.
+      \return the container file name. empty if each agent writes its own file.
+     */
+    const std::string & debugLogContainer() const { return M_debug_log_container; }
+
+    /*!
+      \brief get the number of game steps kept by the flight recorder.
+      \return the number of game steps. 0 means the debug log is written to the file.
+     */
+    int flightRecorderSteps() const { return M_flight_recorder_steps; }
+
     /*!
       \brief get the debug flag
       \return debug flag
@@ -0,0 +1,257 @@
+// -*-c++-*-
+
+/*!
+  \file player_coroutine.h
+  \brief C++20 coroutine interface of PlayerEventScheduler Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_PLAYER_PLAYER_COROUTINE_H
+#define RCSC_PLAYER_PLAYER_COROUTINE_H
+
+#include <rcsc/player/player_agent.h>
+#include <rcsc/player/player_event_scheduler.h>
+
+/*!
+  The library itself is built as C++17. This interface is enabled only if
+  the including translation unit is compiled with the coroutine support.
+
+  \code
+  rcsc::PlayerTask
+  wait_and_dash( rcsc::PlayerAgent & agent )
+  {
+      co_await rcsc::until( agent, []( const rcsc::PlayerAgent & a )
+                                   {
+                                       return a.world().gameMode().type() == rcsc::GameMode::PlayOn;
+                                   } );
+      co_await rcsc::next_see( agent );
+      agent.doDash( 100.0 );
+  }
+  \endcode
+
+  The code after co_await runs in PlayerAgent::action() just before
+  actionImpl(). If the agent releases the waiters, the suspended coroutine
+  is destroyed without being resumed.
+*/
+#if defined( __cpp_impl_coroutine ) && __has_include( <coroutine> )
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <utility>
+
+namespace rcsc {
+
+/*!
+  \class PlayerTask
+  \brief return type of the fire-and-forget player coroutine.
+  the coroutine starts immediately and its frame is released at the end.
+ */
+class PlayerTask {
+public:
+    struct promise_type {
+        PlayerTask get_return_object() noexcept { return PlayerTask(); }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept { }
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+namespace coroutine_detail {
+
+/*!
+  \class SuspendedHandle
+  \brief owner of the suspended coroutine. the frame is destroyed if never resumed.
+ */
+class SuspendedHandle {
+private:
+    std::coroutine_handle<> M_handle;
+
+public:
+    explicit
+    SuspendedHandle( std::coroutine_handle<> handle )
+        : M_handle( handle )
+      { }
+
+    SuspendedHandle( const SuspendedHandle & ) = delete;
+    SuspendedHandle & operator=( const SuspendedHandle & ) = delete;
+
+    ~SuspendedHandle()
+      {
+          if ( M_handle ) M_handle.destroy();
+      }
+
+    void resume()
+      {
+          std::coroutine_handle<> h = std::exchange( M_handle, nullptr );
+          h.resume();
+      }
+};
+
+inline
+PlayerEventScheduler::Continuation
+make_continuation( std::coroutine_handle<> handle )
+{
+    std::shared_ptr< SuspendedHandle > ptr = std::make_shared< SuspendedHandle >( handle );
+    return [ptr]() { ptr->resume(); };
+}
+
+}
+
+/*!
+  \class PlayerEventAwaiter
+  \brief awaiter of the next player event
+ */
+class PlayerEventAwaiter {
+private:
+    PlayerEventScheduler & M_scheduler;
+    PlayerEventScheduler::Event M_event;
+
+public:
+    PlayerEventAwaiter( PlayerEventScheduler & scheduler,
+                        const PlayerEventScheduler::Event event )
+        : M_scheduler( scheduler ),
+          M_event( event )
+      { }
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend( std::coroutine_handle<> handle )
+      {
+          M_scheduler.waitFor( M_event, coroutine_detail::make_continuation( handle ) );
+      }
+
+    void await_resume() const noexcept { }
+};
+
+/*!
+  \class PlayerPredicateAwaiter
+  \brief awaiter of the condition. not suspended if already satisfied.
+ */
+class PlayerPredicateAwaiter {
+private:
+    PlayerAgent & M_agent;
+    PlayerEventScheduler::Predicate M_predicate;
+
+public:
+    PlayerPredicateAwaiter( PlayerAgent & agent,
+                            PlayerEventScheduler::Predicate predicate )
+        : M_agent( agent ),
+          M_predicate( std::move( predicate ) )
+      { }
+
+    bool await_ready() const { return M_predicate( M_agent ); }
+
+    void await_suspend( std::coroutine_handle<> handle )
+      {
+          M_agent.eventScheduler().waitUntil( std::move( M_predicate ),
+                                              coroutine_detail::make_continuation( handle ) );
+      }
+
+    void await_resume() const noexcept { }
+};
+
+/*!
+  \brief wait for the next sense_body message
+  \param agent the owner agent
+  \return awaiter object
+ */
+inline
+PlayerEventAwaiter
+next_sense_body( PlayerAgent & agent )
+{
+    return PlayerEventAwaiter( agent.eventScheduler(), PlayerEventScheduler::SENSE_BODY );
+}
+
+/*!
+  \brief wait for the next see message
+  \param agent the owner agent
+  \return awaiter object
+ */
+inline
+PlayerEventAwaiter
+next_see( PlayerAgent & agent )
+{
+    return PlayerEventAwaiter( agent.eventScheduler(), PlayerEventScheduler::SEE );
+}
+
+/*!
+  \brief wait for the next say message from the other player
+  \param agent the owner agent
+  \return awaiter object
+ */
+inline
+PlayerEventAwaiter
+next_hear( PlayerAgent & agent )
+{
+    return PlayerEventAwaiter( agent.eventScheduler(), PlayerEventScheduler::HEAR_PLAYER );
+}
+
+/*!
+  \brief wait for the next playmode change
+  \param agent the owner agent
+  \return awaiter object
+ */
+inline
+PlayerEventAwaiter
+next_playmode( PlayerAgent & agent )
+{
+    return PlayerEventAwaiter( agent.eventScheduler(), PlayerEventScheduler::PLAYMODE );
+}
+
+/*!
+  \brief wait for the next action decision
+  \param agent the owner agent
+  \return awaiter object
+ */
+inline
+PlayerEventAwaiter
+next_decision( PlayerAgent & agent )
+{
+    return PlayerEventAwaiter( agent.eventScheduler(), PlayerEventScheduler::DECISION );
+}
+
+/*!
+  \brief wait until the predicate becomes true
+  \param agent the owner agent
+  \param predicate resume condition checked at every action decision
+  \return awaiter object
+ */
+inline
+PlayerPredicateAwaiter
+until( PlayerAgent & agent,
+       PlayerEventScheduler::Predicate predicate )
+{
+    return PlayerPredicateAwaiter( agent, std::move( predicate ) );
+}
+
+}
+
+#endif
+
+#endif
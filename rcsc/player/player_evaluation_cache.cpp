@@ -0,0 +1,66 @@
+// -*-c++-*-
+
+/*!
+  \file player_evaluation_cache.cpp
+  \brief per-decision cache of the player evaluation values Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "player_evaluation_cache.h"
+
+#include "abstract_player_object.h"
+#include "player_evaluator.h"
+
+namespace rcsc {
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+PlayerEvaluationCache::evaluate( const Key key,
+                                 const AbstractPlayerObject & p,
+                                 const PlayerEvaluator & evaluator )
+{
+    const std::uint64_t id = ( static_cast< std::uint64_t >( key ) << 32 )
+        | static_cast< std::uint32_t >( p.id() );
+
+    std::unordered_map< std::uint64_t, double >::const_iterator it = M_values.find( id );
+    if ( it != M_values.end() )
+    {
+        return it->second;
+    }
+
+    const double value = evaluator( p );
+    M_values.emplace( id, value );
+    return value;
+}
+
+}
@@ -0,0 +1,126 @@
+// -*-c++-*-
+
+/*!
+  \file player_evaluation_cache.h
+  \brief per-decision cache of the player evaluation values Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_PLAYER_PLAYER_EVALUATION_CACHE_H
+#define RCSC_PLAYER_PLAYER_EVALUATION_CACHE_H
+
+#include <rcsc/game_time.h>
+
+#include <unordered_map>
+#include <cstdint>
+
+namespace rcsc {
+
+class AbstractPlayerObject;
+class PlayerEvaluator;
+
+/*!
+  \class PlayerEvaluationCache
+  \brief memo of the PlayerEvaluator values within one decision.
+
+  The value is stored by (evaluator key, player id). The evaluator key is
+  chosen by the caller, and must identify the evaluator type and all its
+  parameters, because the evaluator objects are usually created for each
+  call. The same key must not be used for different evaluators in the
+  same decision.
+
+  WorldModel::updateJustBeforeDecision() resets the cache. All values
+  are discarded there, because the hear messages and the player type
+  updates may change the players after the see/sense_body update. The
+  cached values must not be used across the decisions.
+*/
+class PlayerEvaluationCache {
+public:
+
+    //! evaluator key type
+    typedef std::uint32_t Key;
+
+private:
+
+    GameTime M_time; //!< the time of the last reset
+    std::unordered_map< std::uint64_t, double > M_values; //!< cached values
+
+    // not used
+    PlayerEvaluationCache( const PlayerEvaluationCache & ) = delete;
+    PlayerEvaluationCache & operator=( const PlayerEvaluationCache & ) = delete;
+
+public:
+
+    /*!
+      \brief create an empty cache
+    */
+    PlayerEvaluationCache()
+        : M_time( -1, 0 )
+      { }
+
+    /*!
+      \brief discard all values
+      \param time the game time of the new decision
+    */
+    void reset( const GameTime & time )
+      {
+          M_time = time;
+          M_values.clear();
+      }
+
+    /*!
+      \brief get the time of the last reset
+      \return const reference to the game time
+    */
+    const GameTime & time() const
+      {
+          return M_time;
+      }
+
+    /*!
+      \brief get the number of cached values
+      \return the number of cached values
+    */
+    std::size_t size() const
+      {
+          return M_values.size();
+      }
+
+    /*!
+      \brief get the evaluation value. the evaluator is called only at the first request.
+      \param key evaluator key
+      \param p target player
+      \param evaluator evaluator object
+      \return the evaluated value
+    */
+    double evaluate( const Key key,
+                     const AbstractPlayerObject & p,
+                     const PlayerEvaluator & evaluator );
+};
+
+}
+
+#endif
@@ -0,0 +1,137 @@
+// -*-c++-*-
+
+/*!
+  \file player_event_scheduler.cpp
+  \brief resumption of the behaviours waiting for the player events Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "player_event_scheduler.h"
+
+#include <iterator>
+
+namespace rcsc {
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+PlayerEventScheduler::PlayerEventScheduler()
+{
+    for ( int i = 0; i < EVENT_SIZE; ++i )
+    {
+        M_counts[i] = 0;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerEventScheduler::waitFor( const Event event,
+                               Continuation continuation )
+{
+    M_waiters.push_back( Waiter{ event, M_counts[event], Predicate(), std::move( continuation ) } );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerEventScheduler::waitUntil( Predicate predicate,
+                                 Continuation continuation )
+{
+    M_waiters.push_back( Waiter{ DECISION, M_counts[DECISION], std::move( predicate ), std::move( continuation ) } );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerEventScheduler::dispatch( const PlayerAgent & agent )
+{
+    ++M_counts[DECISION];
+
+    if ( M_waiters.empty() )
+    {
+        return;
+    }
+
+    // the resumed continuations may register the new waiters to M_waiters.
+    M_pending.swap( M_waiters );
+
+    std::size_t keep = 0;
+    for ( std::size_t i = 0; i < M_pending.size(); ++i )
+    {
+        Waiter & w = M_pending[i];
+        const bool ready = ( w.predicate_
+                             ? w.predicate_( agent )
+                             : M_counts[w.event_] > w.count_ );
+        if ( ready )
+        {
+            Continuation continuation = std::move( w.continuation_ );
+            continuation();
+        }
+        else
+        {
+            if ( keep != i )
+            {
+                M_pending[keep] = std::move( w );
+            }
+            ++keep;
+        }
+    }
+    M_pending.resize( keep );
+
+    // the older waiters are kept first.
+    M_pending.insert( M_pending.end(),
+                      std::make_move_iterator( M_waiters.begin() ),
+                      std::make_move_iterator( M_waiters.end() ) );
+    M_waiters.clear();
+    M_waiters.swap( M_pending );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerEventScheduler::clear()
+{
+    // the continuations may own the suspended coroutines. they are released here.
+    std::vector< Waiter > waiters;
+    waiters.swap( M_waiters );
+}
+
+}
@@ -0,0 +1,165 @@
+// -*-c++-*-
+
+/*!
+  \file player_event_scheduler.h
+  \brief resumption of the behaviours waiting for the player events Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_PLAYER_PLAYER_EVENT_SCHEDULER_H
+#define RCSC_PLAYER_PLAYER_EVENT_SCHEDULER_H
+
+#include <functional>
+#include <vector>
+#include <cstddef>
+
+namespace rcsc {
+
+class PlayerAgent;
+
+/*!
+  \class PlayerEventScheduler
+  \brief queue of the behaviours waiting for the player events.
+
+  A behaviour registers its continuation with waitFor() or waitUntil()
+  instead of keeping a state machine checked in every actionImpl().
+  PlayerAgent counts the events while analyzing the server messages, and
+  resumes the continuations in dispatch() just before actionImpl() on the
+  agent thread, so the resumed behaviour can issue the commands of the
+  current cycle. No thread is used for waiting. Thousands of the logical
+  behaviours can wait in one agent.
+
+  player_coroutine.h provides the C++20 coroutine interface over this class.
+ */
+class PlayerEventScheduler {
+public:
+
+    /*!
+      \brief event type
+     */
+    enum Event {
+        SENSE_BODY = 0, //!< sense_body message
+        SEE, //!< see message analyzed
+        HEAR_PLAYER, //!< say message from the other player
+        PLAYMODE, //!< playmode changed by the referee
+        DECISION, //!< action decision. counted at the beginning of dispatch().
+        EVENT_SIZE,
+    };
+
+    //! resume condition checked in every dispatch()
+    typedef std::function< bool( const PlayerAgent & ) > Predicate;
+
+    //! resumed behaviour
+    typedef std::function< void() > Continuation;
+
+private:
+
+    /*!
+      \struct Waiter
+      \brief registered continuation
+     */
+    struct Waiter {
+        Event event_; //!< waited event. unused if predicate_ is set.
+        unsigned long count_; //!< the event count at the registration
+        Predicate predicate_; //!< resume condition. empty if waiting for the event.
+        Continuation continuation_; //!< resumed behaviour
+    };
+
+    unsigned long M_counts[EVENT_SIZE]; //!< the number of the notified events
+
+    std::vector< Waiter > M_waiters; //!< registered continuations
+    std::vector< Waiter > M_pending; //!< work area of dispatch()
+
+public:
+
+    /*!
+      \brief create an empty queue
+     */
+    PlayerEventScheduler();
+
+    /*!
+      \brief count the event. the waiters are resumed by the next dispatch().
+      \param event event type
+     */
+    void notify( const Event event )
+      {
+          ++M_counts[event];
+      }
+
+    /*!
+      \brief get the number of the notified events
+      \param event event type
+      \return event count
+     */
+    unsigned long count( const Event event ) const
+      {
+          return M_counts[event];
+      }
+
+    /*!
+      \brief register the continuation resumed after the next event
+      \param event waited event
+      \param continuation resumed behaviour
+     */
+    void waitFor( const Event event,
+                  Continuation continuation );
+
+    /*!
+      \brief register the continuation resumed when the predicate becomes true.
+      the predicate is checked in every dispatch().
+      \param predicate resume condition
+      \param continuation resumed behaviour
+     */
+    void waitUntil( Predicate predicate,
+                    Continuation continuation );
+
+    /*!
+      \brief resume the continuations whose event has been notified or whose
+      predicate is satisfied. the continuations registered while resuming
+      are not resumed until the next dispatch(). must not be called recursively.
+      \param agent the owner agent
+     */
+    void dispatch( const PlayerAgent & agent );
+
+    /*!
+      \brief release all continuations without resuming them
+     */
+    void clear();
+
+    /*!
+      \brief get the number of waiting continuations
+      \return waiter count
+     */
+    std::size_t size() const
+      {
+          return M_waiters.size();
+      }
+};
+
+}
+
+#endif
@@ -166,11 +166,7 @@ PlayerObject::isKickable( const double & buf ) const
 void
 PlayerObject::update()
 {
-    M_pos_history.push_front( M_pos );
-    if ( M_pos_history.size() > 100 )
-    {
-        M_pos_history.pop_back();
-    }
+    M_pos_history.push_front( M_pos ); // the oldest position is overwritten
 
     if ( velValid() )
     {
@@ -39,6 +39,8 @@
 
 #include <rcsc/geom/vector_2d.h>
 #include <rcsc/geom/angle_deg.h>
+#include <rcsc/util/node_pool_allocator.h>
+#include <rcsc/util/ring_buffer.h>
 #include <rcsc/types.h>
 
 #include <vector>
@@ -54,8 +56,11 @@ class PlayerObject
     : public AbstractPlayerObject {
 public:
 
-    //! type of the player object instance container
-    typedef std::list< PlayerObject > List;
+    //! type of the player object instance container. nodes are recycled by the shared node pool.
+    typedef std::list< PlayerObject, NodePoolAllocator< PlayerObject > > List;
+
+    //! type of the position history container
+    typedef RingBuffer< Vector2D, 100 > PosHistory;
 
     //! type of the player object pointer container
     typedef std::vector< const PlayerObject * > Cont;
@@ -75,7 +80,7 @@ private:
     int M_ghost_count; //!< count that this object is recognized as a ghost object.
     int M_tackle_count; //!< time count since the last tackle observation
 
-    std::list< Vector2D > M_pos_history;
+    PosHistory M_pos_history; //!< estimated positions in the previous cycles
 
 public:
 
@@ -190,7 +195,7 @@ public:
       \brief get the history of estimated position.
       \return position list. the front element is the position at the previous cycle.
      */
-    const std::list< Vector2D > & posHistory() const
+    const PosHistory & posHistory() const
       {
           return M_pos_history;
       }
@@ -0,0 +1,576 @@
+// -*-c++-*-
+
+/*!
+  \file player_predicate_expr.h
+  \brief compile-time composed player predicates Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_PLAYER_PLAYER_PREDICATE_EXPR_H
+#define RCSC_PLAYER_PLAYER_PREDICATE_EXPR_H
+
+#include <rcsc/player/player_predicate.h>
+#include <rcsc/player/player_snapshot.h>
+#include <rcsc/player/abstract_player_object.h>
+#include <rcsc/player/world_model.h>
+#include <rcsc/geom/vector_2d.h>
+#include <rcsc/types.h>
+
+#include <memory>
+#include <type_traits>
+#include <cstddef>
+
+namespace rcsc {
+
+/*!
+  \namespace rcsc::pred
+  \brief player predicates composed at compile time.
+
+  The predicates are value objects combined by &&, || and !. The composed
+  predicate is inlined into a single loop, without any allocation and
+  virtual call:
+
+  \code
+  using namespace rcsc::pred;
+  AbstractPlayerObject::Cont players
+      = get_players( wm, teammate( wm ) && near( point, 10.0 ) && ! ghost() );
+  \endcode
+
+  The same predicate can be evaluated over the PlayerSnapshot arrays.
+  Each leaf is a flat loop that produces a bit mask, and the combinators
+  become bit operations:
+
+  \code
+  const PlayerSnapshot & s = wm.playerSnapshot();
+  PlayerSnapshot::Mask m = select( s, opponent( wm ) && near( point, 5.0 ) );
+  \endcode
+
+  The runtime PlayerPredicate classes are still used where the condition
+  is decided at runtime. make_predicate() converts a composed predicate
+  into a PlayerPredicate object.
+*/
+namespace pred {
+
+/*!
+  \struct Expr
+  \brief base class of all predicate expressions. used to enable the operators.
+*/
+struct Expr {
+};
+
+/*!
+  \brief check if the type is a predicate expression
+*/
+template < typename T >
+struct is_expr
+    : public std::is_base_of< Expr, T > {
+};
+
+//
+// combinators
+//
+
+/*!
+  \class AndExpr
+  \brief logical "and" of two expressions
+*/
+template < typename L, typename R >
+class AndExpr
+    : public Expr {
+private:
+    L M_lhs; //!< left hand side
+    R M_rhs; //!< right hand side
+public:
+    AndExpr( const L & lhs,
+             const R & rhs )
+        : M_lhs( lhs ),
+          M_rhs( rhs )
+      { }
+
+    bool operator()( const AbstractPlayerObject & p ) const
+      {
+          return M_lhs( p ) && M_rhs( p );
+      }
+
+    PlayerSnapshot::Mask mask( const PlayerSnapshot & s ) const
+      {
+          return M_lhs.mask( s ) & M_rhs.mask( s );
+      }
+};
+
+/*!
+  \class OrExpr
+  \brief logical "or" of two expressions
+*/
+template < typename L, typename R >
+class OrExpr
+    : public Expr {
+private:
+    L M_lhs; //!< left hand side
+    R M_rhs; //!< right hand side
+public:
+    OrExpr( const L & lhs,
+            const R & rhs )
+        : M_lhs( lhs ),
+          M_rhs( rhs )
+      { }
+
+    bool operator()( const AbstractPlayerObject & p ) const
+      {
+          return M_lhs( p ) || M_rhs( p );
+      }
+
+    PlayerSnapshot::Mask mask( const PlayerSnapshot & s ) const
+      {
+          return M_lhs.mask( s ) | M_rhs.mask( s );
+      }
+};
+
+/*!
+  \class NotExpr
+  \brief logical "not" of the expression
+*/
+template < typename E >
+class NotExpr
+    : public Expr {
+private:
+    E M_expr; //!< negated expression
+public:
+    explicit
+    NotExpr( const E & expr )
+        : M_expr( expr )
+      { }
+
+    bool operator()( const AbstractPlayerObject & p ) const
+      {
+          return ! M_expr( p );
+      }
+
+    PlayerSnapshot::Mask mask( const PlayerSnapshot & s ) const
+      {
+          return s.all() & ~M_expr.mask( s );
+      }
+};
+
+template < typename L, typename R,
+           typename = typename std::enable_if< is_expr< L >::value && is_expr< R >::value >::type >
+inline
+AndExpr< L, R >
+operator&&( const L & lhs,
+            const R & rhs )
+{
+    return AndExpr< L, R >( lhs, rhs );
+}
+
+template < typename L, typename R,
+           typename = typename std::enable_if< is_expr< L >::value && is_expr< R >::value >::type >
+inline
+OrExpr< L, R >
+operator||( const L & lhs,
+            const R & rhs )
+{
+    return OrExpr< L, R >( lhs, rhs );
+}
+
+template < typename E,
+           typename = typename std::enable_if< is_expr< E >::value >::type >
+inline
+NotExpr< E >
+operator!( const E & expr )
+{
+    return NotExpr< E >( expr );
+}
+
+//
+// leaves. each leaf has the same condition as the corresponding PlayerPredicate.
+//
+
+//! side and uniform number condition types of SideExpr
+enum SideType {
+    SIDE_SELF, //!< SelfPlayerPredicate
+    SIDE_TEAMMATE_OR_SELF, //!< TeammateOrSelfPlayerPredicate
+    SIDE_TEAMMATE, //!< TeammatePlayerPredicate
+    SIDE_OPPONENT, //!< OpponentPlayerPredicate
+    SIDE_OPPONENT_OR_UNKNOWN, //!< OpponentOrUnknownPlayerPredicate
+};
+
+/*!
+  \class SideExpr
+  \brief side and uniform number condition. the condition type is resolved at compile time.
+*/
+template < SideType TYPE >
+class SideExpr
+    : public Expr {
+private:
+    int M_our_side; //!< our side id
+    int M_self_unum; //!< self uniform number
+
+    bool test( const int side,
+               const int unum ) const
+      {
+          switch ( TYPE ) {
+          case SIDE_SELF:
+              return side == M_our_side && unum == M_self_unum;
+          case SIDE_TEAMMATE_OR_SELF:
+              return side == M_our_side;
+          case SIDE_TEAMMATE:
+              return side == M_our_side && unum != M_self_unum;
+          case SIDE_OPPONENT:
+              return side != M_our_side && side != NEUTRAL;
+          case SIDE_OPPONENT_OR_UNKNOWN:
+              return side != M_our_side;
+          }
+          return false;
+      }
+
+public:
+    explicit
+    SideExpr( const WorldModel & wm )
+        : M_our_side( wm.ourSide() ),
+          M_self_unum( wm.self().unum() )
+      { }
+
+    bool operator()( const AbstractPlayerObject & p ) const
+      {
+          return test( p.side(), p.unum() );
+      }
+
+    PlayerSnapshot::Mask mask( const PlayerSnapshot & s ) const
+      {
+          const int * side = s.side();
+          const int * unum = s.unum();
+          PlayerSnapshot::Mask m = 0;
+          for ( std::size_t i = 0; i < s.size(); ++i )
+          {
+              m |= PlayerSnapshot::Mask( test( side[i], unum[i] ) ) << i;
+          }
+          return m;
+      }
+};
+
+/*!
+  \class GoalieExpr
+  \brief GoaliePlayerPredicate
+*/
+class GoalieExpr
+    : public Expr {
+public:
+    bool operator()( const AbstractPlayerObject & p ) const
+      {
+          return p.goalie();
+      }
+
+    PlayerSnapshot::Mask mask( const PlayerSnapshot & s ) const
+      {
+          return s.flagMask( PlayerSnapshot::FLAG_GOALIE );
+      }
+};
+
+/*!
+  \class GhostExpr
+  \brief GhostPlayerPredicate
+*/
+class GhostExpr
+    : public Expr {
+public:
+    bool operator()( const AbstractPlayerObject & p ) const
+      {
+          return p.isGhost();
+      }
+
+    PlayerSnapshot::Mask mask( const PlayerSnapshot & s ) const
+      {
+          return s.flagMask( PlayerSnapshot::FLAG_GHOST );
+      }
+};
+
+/*!
+  \class PosCountExpr
+  \brief CoordinateAccuratePlayerPredicate. posCount() <= threshold
+*/
+class PosCountExpr
+    : public Expr {
+private:
+    int M_threshold; //!< accuracy threshold
+public:
+    explicit
+    PosCountExpr( const int threshold )
+        : M_threshold( threshold )
+      { }
+
+    bool operator()( const AbstractPlayerObject & p ) const
+      {
+          return p.posCount() <= M_threshold;
+      }
+
+    PlayerSnapshot::Mask mask( const PlayerSnapshot & s ) const
+      {
+          return s.posCountLessThan( M_threshold + 1 );
+      }
+};
+
+/*!
+  \class XCoordinateExpr
+  \brief XCoordinateForward/BackwardPlayerPredicate
+*/
+class XCoordinateExpr
+    : public Expr {
+private:
+    double M_threshold; //!< x coordinate threshold
+    bool M_forward; //!< if true, x >= threshold. otherwise, x <= threshold.
+public:
+    XCoordinateExpr( const double threshold,
+                     const bool forward )
+        : M_threshold( threshold ),
+          M_forward( forward )
+      { }
+
+    bool operator()( const AbstractPlayerObject & p ) const
+      {
+          return ( M_forward
+                   ? p.pos().x >= M_threshold
+                   : p.pos().x <= M_threshold );
+      }
+
+    PlayerSnapshot::Mask mask( const PlayerSnapshot & s ) const
+      {
+          const double * x = s.x();
+          PlayerSnapshot::Mask m = 0;
+          if ( M_forward )
+          {
+              for ( std::size_t i = 0; i < s.size(); ++i )
+              {
+                  m |= PlayerSnapshot::Mask( x[i] >= M_threshold ) << i;
+              }
+          }
+          else
+          {
+              for ( std::size_t i = 0; i < s.size(); ++i )
+              {
+                  m |= PlayerSnapshot::Mask( x[i] <= M_threshold ) << i;
+              }
+          }
+          return m;
+      }
+};
+
+/*!
+  \class DistanceExpr
+  \brief PointNear/PointFarPlayerPredicate
+*/
+class DistanceExpr
+    : public Expr {
+private:
+    Vector2D M_point; //!< base point
+    double M_threshold2; //!< squared distance threshold
+    bool M_near; //!< if true, dist2 <= threshold2. otherwise, dist2 >= threshold2.
+public:
+    DistanceExpr( const Vector2D & point,
+                  const double dist,
+                  const bool near )
+        : M_point( point ),
+          M_threshold2( dist * dist ),
+          M_near( near )
+      { }
+
+    bool operator()( const AbstractPlayerObject & p ) const
+      {
+          const double d2 = ( p.pos() - M_point ).r2();
+          return ( M_near
+                   ? d2 <= M_threshold2
+                   : d2 >= M_threshold2 );
+      }
+
+    PlayerSnapshot::Mask mask( const PlayerSnapshot & s ) const
+      {
+          const double * x = s.x();
+          const double * y = s.y();
+          const double px = M_point.x;
+          const double py = M_point.y;
+          PlayerSnapshot::Mask m = 0;
+          for ( std::size_t i = 0; i < s.size(); ++i )
+          {
+              const double dx = x[i] - px;
+              const double dy = y[i] - py;
+              const double d2 = dx * dx + dy * dy;
+              m |= PlayerSnapshot::Mask( M_near
+                                         ? d2 <= M_threshold2
+                                         : d2 >= M_threshold2 ) << i;
+          }
+          return m;
+      }
+};
+
+//
+// factories
+//
+
+//! agent itself
+inline SideExpr< SIDE_SELF > self( const WorldModel & wm ) { return SideExpr< SIDE_SELF >( wm ); }
+//! teammates including self
+inline SideExpr< SIDE_TEAMMATE_OR_SELF > teammate_or_self( const WorldModel & wm ) { return SideExpr< SIDE_TEAMMATE_OR_SELF >( wm ); }
+//! teammates not including self
+inline SideExpr< SIDE_TEAMMATE > teammate( const WorldModel & wm ) { return SideExpr< SIDE_TEAMMATE >( wm ); }
+//! opponents not including unknown players
+inline SideExpr< SIDE_OPPONENT > opponent( const WorldModel & wm ) { return SideExpr< SIDE_OPPONENT >( wm ); }
+//! opponents including unknown players
+inline SideExpr< SIDE_OPPONENT_OR_UNKNOWN > opponent_or_unknown( const WorldModel & wm ) { return SideExpr< SIDE_OPPONENT_OR_UNKNOWN >( wm ); }
+//! goalie
+inline GoalieExpr goalie() { return GoalieExpr(); }
+//! field player
+inline NotExpr< GoalieExpr > field_player() { return NotExpr< GoalieExpr >( GoalieExpr() ); }
+//! ghost object
+inline GhostExpr ghost() { return GhostExpr(); }
+//! posCount() <= threshold
+inline PosCountExpr accurate( const int threshold ) { return PosCountExpr( threshold ); }
+//! not ghost and posCount() <= threshold
+inline AndExpr< NotExpr< GhostExpr >, PosCountExpr > no_ghost( const int threshold ) { return ! ghost() && accurate( threshold ); }
+//! x >= threshold
+inline XCoordinateExpr x_forward( const double threshold ) { return XCoordinateExpr( threshold, true ); }
+//! x <= threshold
+inline XCoordinateExpr x_backward( const double threshold ) { return XCoordinateExpr( threshold, false ); }
+//! distance from the point <= dist
+inline DistanceExpr near( const Vector2D & point, const double dist ) { return DistanceExpr( point, dist, true ); }
+//! distance from the point >= dist
+inline DistanceExpr far( const Vector2D & point, const double dist ) { return DistanceExpr( point, dist, false ); }
+
+//
+// queries
+//
+
+/*!
+  \brief get the players in WorldModel::allPlayers() that satisfy the predicate
+  \param wm const reference to the WorldModel instance
+  \param expr predicate expression
+  \return container of the matched players
+*/
+template < typename E >
+inline
+AbstractPlayerObject::Cont
+get_players( const WorldModel & wm,
+             const E & expr )
+{
+    static_assert( is_expr< E >::value, "E must be a predicate expression." );
+
+    AbstractPlayerObject::Cont result;
+    for ( const AbstractPlayerObject * p : wm.allPlayers() )
+    {
+        if ( expr( *p ) )
+        {
+            result.push_back( p );
+        }
+    }
+    return result;
+}
+
+/*!
+  \brief count the players in WorldModel::allPlayers() that satisfy the predicate
+  \param wm const reference to the WorldModel instance
+  \param expr predicate expression
+  \return the number of the matched players
+*/
+template < typename E >
+inline
+std::size_t
+count_players( const WorldModel & wm,
+               const E & expr )
+{
+    static_assert( is_expr< E >::value, "E must be a predicate expression." );
+
+    std::size_t count = 0;
+    for ( const AbstractPlayerObject * p : wm.allPlayers() )
+    {
+        if ( expr( *p ) )
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+/*!
+  \brief evaluate the predicate over the snapshot arrays.
+  note that the snapshot contains the unknown players in addition to allPlayers().
+  \param s snapshot
+  \param expr predicate expression
+  \return bit mask of the matched player indices
+*/
+template < typename E >
+inline
+PlayerSnapshot::Mask
+select( const PlayerSnapshot & s,
+        const E & expr )
+{
+    static_assert( is_expr< E >::value, "E must be a predicate expression." );
+
+    return expr.mask( s );
+}
+
+/*!
+  \class ExprPlayerPredicate
+  \brief adaptor to use the predicate expression as the runtime PlayerPredicate
+*/
+template < typename E >
+class ExprPlayerPredicate
+    : public PlayerPredicate {
+private:
+    E M_expr; //!< predicate expression
+public:
+    explicit
+    ExprPlayerPredicate( const E & expr )
+        : M_expr( expr )
+      { }
+
+    bool operator()( const AbstractPlayerObject & p ) const override
+      {
+          return M_expr( p );
+      }
+
+    Ptr clone() const override
+      {
+          return Ptr( new ExprPlayerPredicate( M_expr ) );
+      }
+};
+
+/*!
+  \brief create the runtime predicate object from the expression
+  \param expr predicate expression
+  \return smart pointer to the created predicate object
+*/
+template < typename E >
+inline
+PlayerPredicate::ConstPtr
+make_predicate( const E & expr )
+{
+    static_assert( is_expr< E >::value, "E must be a predicate expression." );
+
+    return PlayerPredicate::ConstPtr( new ExprPlayerPredicate< E >( expr ) );
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,260 @@
+// -*-c++-*-
+
+/*!
+  \file player_snapshot.cpp
+  \brief packed player state snapshot for batch queries Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "player_snapshot.h"
+
+#include <rcsc/common/player_type.h>
+#include <rcsc/geom/rect_2d.h>
+
+#include <limits>
+
+namespace rcsc {
+
+constexpr std::size_t PlayerSnapshot::MAX_PLAYERS;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+PlayerSnapshot::PlayerSnapshot()
+    : M_time( -1, 0 ),
+      M_size( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerSnapshot::clear()
+{
+    M_size = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+PlayerSnapshot::build( const GameTime & current,
+                       const AbstractPlayerObject::Cont & players )
+{
+    M_time = current;
+    M_size = 0;
+
+    for ( const AbstractPlayerObject * p : players )
+    {
+        if ( ! add( *p ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+PlayerSnapshot::add( const AbstractPlayerObject & p )
+{
+    if ( M_size >= MAX_PLAYERS )
+    {
+        return false;
+    }
+
+    const std::size_t i = M_size;
+
+    M_x[i] = p.pos().x;
+    M_y[i] = p.pos().y;
+    M_vx[i] = p.vel().x;
+    M_vy[i] = p.vel().y;
+    M_pos_count[i] = p.posCount();
+    M_vel_count[i] = p.velCount();
+    M_side[i] = p.side();
+    M_unum[i] = p.unum();
+    M_type[i] = ( p.playerTypePtr() ? p.playerTypePtr()->id() : Hetero_Unknown );
+
+    unsigned int flags = 0;
+    if ( p.isSelf() ) flags |= FLAG_SELF;
+    if ( p.goalie() ) flags |= FLAG_GOALIE;
+    if ( p.isKicking() ) flags |= FLAG_KICKING;
+    if ( p.isTackling() ) flags |= FLAG_TACKLING;
+    if ( p.isGhost() ) flags |= FLAG_GHOST;
+    M_flags[i] = flags;
+
+    M_players[i] = &p;
+
+    ++M_size;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+PlayerSnapshot::Mask
+PlayerSnapshot::sideMask( const SideID side ) const
+{
+    Mask mask = 0;
+    for ( std::size_t i = 0; i < M_size; ++i )
+    {
+        mask |= Mask( M_side[i] == side ) << i;
+    }
+    return mask;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+PlayerSnapshot::Mask
+PlayerSnapshot::opponentMask( const SideID our_side ) const
+{
+    return all() & ~sideMask( our_side );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+PlayerSnapshot::Mask
+PlayerSnapshot::flagMask( const unsigned int flags ) const
+{
+    Mask mask = 0;
+    for ( std::size_t i = 0; i < M_size; ++i )
+    {
+        mask |= Mask( ( M_flags[i] & flags ) == flags ) << i;
+    }
+    return mask;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+PlayerSnapshot::Mask
+PlayerSnapshot::posCountLessThan( const int count ) const
+{
+    Mask mask = 0;
+    for ( std::size_t i = 0; i < M_size; ++i )
+    {
+        mask |= Mask( M_pos_count[i] < count ) << i;
+    }
+    return mask;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+PlayerSnapshot::Mask
+PlayerSnapshot::withinCircle( const Vector2D & center,
+                              const double r ) const
+{
+    const double cx = center.x;
+    const double cy = center.y;
+    const double r2 = r * r;
+
+    Mask mask = 0;
+    for ( std::size_t i = 0; i < M_size; ++i )
+    {
+        const double dx = M_x[i] - cx;
+        const double dy = M_y[i] - cy;
+        mask |= Mask( dx * dx + dy * dy < r2 ) << i;
+    }
+    return mask;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+PlayerSnapshot::Mask
+PlayerSnapshot::withinRect( const Rect2D & rect ) const
+{
+    const double min_x = rect.minX();
+    const double max_x = rect.maxX();
+    const double min_y = rect.minY();
+    const double max_y = rect.maxY();
+
+    Mask mask = 0;
+    for ( std::size_t i = 0; i < M_size; ++i )
+    {
+        mask |= Mask( min_x <= M_x[i] && M_x[i] <= max_x
+                      && min_y <= M_y[i] && M_y[i] <= max_y ) << i;
+    }
+    return mask;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::size_t
+PlayerSnapshot::nearest( const Vector2D & point,
+                         const Mask mask,
+                         double * dist2 ) const
+{
+    std::size_t result = M_size;
+    double min_d2 = std::numeric_limits< double >::max();
+
+    for ( std::size_t i = 0; i < M_size; ++i )
+    {
+        if ( ! ( mask & ( Mask( 1 ) << i ) ) ) continue;
+
+        const double dx = M_x[i] - point.x;
+        const double dy = M_y[i] - point.y;
+        const double d2 = dx * dx + dy * dy;
+        if ( d2 < min_d2 )
+        {
+            min_d2 = d2;
+            result = i;
+        }
+    }
+
+    if ( dist2 )
+    {
+        *dist2 = min_d2;
+    }
+
+    return result;
+}
+
+}
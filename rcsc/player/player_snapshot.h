@@ -0,0 +1,325 @@
+// -*-c++-*-
+
+/*!
+  \file player_snapshot.h
+  \brief packed player state snapshot for batch queries Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_PLAYER_PLAYER_SNAPSHOT_H
+#define RCSC_PLAYER_PLAYER_SNAPSHOT_H
+
+#include <rcsc/player/abstract_player_object.h>
+#include <rcsc/geom/vector_2d.h>
+#include <rcsc/game_time.h>
+#include <rcsc/types.h>
+
+#include <cstdint>
+#include <cstddef>
+
+namespace rcsc {
+
+class Rect2D;
+
+/*!
+  \class PlayerSnapshot
+  \brief structure-of-arrays copy of the player states.
+
+  The snapshot is rebuilt once per decision by WorldModel.
+  Each player is referred by the index in this snapshot, and the result of the
+  filter methods is a bit mask of player indices. Each filter is a flat loop
+  over the contiguous arrays, which the compiler can vectorize, so that small
+  combinations of filters are much cheaper than PlayerPredicate chains.
+
+  \code
+  const PlayerSnapshot & s = wm.playerSnapshot();
+  PlayerSnapshot::Mask m = s.opponentMask( wm.ourSide() )
+      & s.withinCircle( target, 3.0 )
+      & s.posCountLessThan( 5 );
+  for ( std::size_t i = s.first( m ); i < s.size(); i = s.next( m, i ) )
+  {
+      const AbstractPlayerObject * p = s.player( i );
+  }
+  \endcode
+*/
+class PlayerSnapshot {
+public:
+
+    //! bit mask of the player indices
+    typedef std::uint64_t Mask;
+
+    //! maximum number of players stored in the snapshot
+    static constexpr std::size_t MAX_PLAYERS = 64;
+
+    /*!
+      \brief player state flags
+    */
+    enum Flag {
+        FLAG_SELF = 0x01,
+        FLAG_GOALIE = 0x02,
+        FLAG_KICKING = 0x04,
+        FLAG_TACKLING = 0x08,
+        FLAG_GHOST = 0x10,
+    };
+
+private:
+
+    GameTime M_time; //!< updated time
+    std::size_t M_size; //!< number of stored players
+
+    alignas( 32 ) double M_x[MAX_PLAYERS]; //!< global x coordinate
+    alignas( 32 ) double M_y[MAX_PLAYERS]; //!< global y coordinate
+    alignas( 32 ) double M_vx[MAX_PLAYERS]; //!< global x velocity
+    alignas( 32 ) double M_vy[MAX_PLAYERS]; //!< global y velocity
+
+    int M_pos_count[MAX_PLAYERS]; //!< position accuracy count
+    int M_vel_count[MAX_PLAYERS]; //!< velocity accuracy count
+    int M_side[MAX_PLAYERS]; //!< team side
+    int M_unum[MAX_PLAYERS]; //!< uniform number
+    int M_type[MAX_PLAYERS]; //!< player type id
+    unsigned int M_flags[MAX_PLAYERS]; //!< Flag bits
+
+    const AbstractPlayerObject * M_players[MAX_PLAYERS]; //!< source objects
+
+public:
+
+    /*!
+      \brief create an empty snapshot
+    */
+    PlayerSnapshot();
+
+    /*!
+      \brief remove all players
+    */
+    void clear();
+
+    /*!
+      \brief copy the player states.
+      \param current current game time
+      \param players source player container
+      \return true if all players are stored.
+
+      If the container has more than MAX_PLAYERS players, the rest are ignored.
+    */
+    bool build( const GameTime & current,
+                const AbstractPlayerObject::Cont & players );
+
+    /*!
+      \brief append one player.
+      \param p source player
+      \return false if the snapshot is full
+    */
+    bool add( const AbstractPlayerObject & p );
+
+    /*!
+      \brief set the updated time
+      \param current current game time
+     */
+    void setTime( const GameTime & current )
+      {
+          M_time = current;
+      }
+
+    /*!
+      \brief get the updated time
+      \return game time
+    */
+    const GameTime & time() const
+      {
+          return M_time;
+      }
+
+    /*!
+      \brief get the number of stored players
+      \return number of players
+    */
+    std::size_t size() const
+      {
+          return M_size;
+      }
+
+    /*!
+      \brief get the mask that contains all stored players
+      \return bit mask
+    */
+    Mask all() const
+      {
+          return ( M_size >= MAX_PLAYERS
+                   ? ~Mask( 0 )
+                   : ( Mask( 1 ) << M_size ) - 1 );
+      }
+
+    //
+    // element accessors
+    //
+
+    const double * x() const { return M_x; } //!< x coordinate array
+    const double * y() const { return M_y; } //!< y coordinate array
+    const double * vx() const { return M_vx; } //!< x velocity array
+    const double * vy() const { return M_vy; } //!< y velocity array
+    const int * posCount() const { return M_pos_count; } //!< position count array
+    const int * velCount() const { return M_vel_count; } //!< velocity count array
+    const int * side() const { return M_side; } //!< side id array
+    const int * unum() const { return M_unum; } //!< uniform number array
+    const int * type() const { return M_type; } //!< player type id array
+    const unsigned int * flags() const { return M_flags; } //!< Flag bits array
+
+    /*!
+      \brief get the position of the indexed player
+      \param i player index
+      \return position
+    */
+    Vector2D pos( const std::size_t i ) const
+      {
+          return Vector2D( M_x[i], M_y[i] );
+      }
+
+    /*!
+      \brief get the velocity of the indexed player
+      \param i player index
+      \return velocity
+    */
+    Vector2D vel( const std::size_t i ) const
+      {
+          return Vector2D( M_vx[i], M_vy[i] );
+      }
+
+    /*!
+      \brief get the source object of the indexed player
+      \param i player index
+      \return pointer to the player object
+    */
+    const AbstractPlayerObject * player( const std::size_t i ) const
+      {
+          return M_players[i];
+      }
+
+    //
+    // filters
+    //
+
+    /*!
+      \brief get the players on the specified side
+      \param side side id
+      \return bit mask
+    */
+    Mask sideMask( const SideID side ) const;
+
+    /*!
+      \brief get the players not on the specified side (includes unknown side players)
+      \param our_side our side id
+      \return bit mask
+    */
+    Mask opponentMask( const SideID our_side ) const;
+
+    /*!
+      \brief get the players that have all specified flags
+      \param flags Flag bits
+      \return bit mask
+    */
+    Mask flagMask( const unsigned int flags ) const;
+
+    /*!
+      \brief get the players whose position count is less than the threshold
+      \param count threshold
+      \return bit mask
+    */
+    Mask posCountLessThan( const int count ) const;
+
+    /*!
+      \brief get the players within the circle
+      \param center center of the circle
+      \param r radius of the circle
+      \return bit mask
+    */
+    Mask withinCircle( const Vector2D & center,
+                       const double r ) const;
+
+    /*!
+      \brief get the players within the rectangle
+      \param rect rectangle
+      \return bit mask
+    */
+    Mask withinRect( const Rect2D & rect ) const;
+
+    /*!
+      \brief get the index of the nearest player to the point
+      \param point target point
+      \param mask candidates
+      \param dist2 pointer to the variable to store the squared distance. may be NULL.
+      \return player index. if no candidate, size() is returned.
+    */
+    std::size_t nearest( const Vector2D & point,
+                         const Mask mask,
+                         double * dist2 = nullptr ) const;
+
+    //
+    // mask iteration
+    //
+
+    /*!
+      \brief count the players in the mask
+      \param mask bit mask
+      \return number of players
+    */
+    static
+    int count( const Mask mask )
+      {
+          return __builtin_popcountll( mask );
+      }
+
+    /*!
+      \brief get the first index in the mask
+      \param mask bit mask
+      \return player index. if empty, size() is returned.
+    */
+    std::size_t first( const Mask mask ) const
+      {
+          return ( mask == 0
+                   ? M_size
+                   : static_cast< std::size_t >( __builtin_ctzll( mask ) ) );
+      }
+
+    /*!
+      \brief get the next index in the mask
+      \param mask bit mask
+      \param i current index
+      \return player index. if no more player, size() is returned.
+    */
+    std::size_t next( const Mask mask,
+                      const std::size_t i ) const
+      {
+          if ( i + 1 >= MAX_PLAYERS )
+          {
+              return M_size;
+          }
+          return first( mask & ( ~Mask( 0 ) << ( i + 1 ) ) );
+      }
+};
+
+}
+
+#endif
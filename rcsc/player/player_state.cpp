@@ -35,6 +35,8 @@
 
 #include "player_state.h"
 
+#include "abstract_player_object.h"
+
 #include <rcsc/common/server_param.h>
 #include <rcsc/common/player_type.h>
 
@@ -53,6 +55,8 @@ PlayerState::PlayerState()
       M_vel( 0.0, 0.0 ),
       M_body( 0.0 ),
       M_face( 0.0 ),
+      M_pos_count( 1000 ),
+      M_vel_count( 1000 ),
       M_card( NO_CARD )
 {
 
@@ -61,6 +65,26 @@ PlayerState::PlayerState()
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+PlayerState::update( const AbstractPlayerObject & p )
+{
+    M_side = p.side();
+    M_unum = p.unum();
+    M_goalie = p.goalie();
+    M_player_type = p.playerTypePtr();
+    M_pos = p.pos();
+    M_vel = p.vel();
+    M_body = p.body();
+    M_face = p.face();
+    M_pos_count = p.posCount();
+    M_vel_count = p.velCount();
+    M_card = p.card();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 PlayerState::setPlayerType( const int type )
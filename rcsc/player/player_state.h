@@ -40,6 +40,7 @@
 
 namespace rcsc {
 
+class AbstractPlayerObject;
 class PlayerType;
 
 /*-------------------------------------------------------------------*/
@@ -66,6 +67,9 @@ private:
     AngleDeg M_body; //!< body angle
     AngleDeg M_face; //!< global neck angle
 
+    int M_pos_count; //!< position accuracy count
+    int M_vel_count; //!< velocity accuracy count
+
     // StaminaModel M_stamina; //!< estimated stamina value
 
     // bool M_kicking; //!< true if player performed the kick.
@@ -81,6 +85,12 @@ public:
     */
     PlayerState();
 
+    /*!
+      \brief copy the state of the player object
+      \param p source player object
+     */
+    void update( const AbstractPlayerObject & p );
+
     /*!
       \brief check if this player is valid or not.
       \return checked result.
@@ -162,6 +172,24 @@ public:
           return M_face;
       }
 
+    /*!
+      \brief get the position accuracy count
+      \return count since the last observation
+     */
+    int posCount() const
+      {
+          return M_pos_count;
+      }
+
+    /*!
+      \brief get the velocity accuracy count
+      \return count since the last observation
+     */
+    int velCount() const
+      {
+          return M_vel_count;
+      }
+
     /*!
       \brief get current card status.
       \return card type
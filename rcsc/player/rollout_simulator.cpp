@@ -0,0 +1,432 @@
+// -*-c++-*-
+
+/*!
+  \file rollout_simulator.cpp
+  \brief forward physics simulator over WorldSnapshot Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "rollout_simulator.h"
+
+#include <rcsc/common/server_param.h>
+#include <rcsc/common/player_type.h>
+#include <rcsc/geom/angle_deg.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace rcsc {
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+const PlayerType &
+player_type_of( const PlayerState & p )
+{
+    const PlayerType * ptype = p.playerType();
+    if ( ! ptype )
+    {
+        ptype = PlayerTypeSet::i().get( Hetero_Default );
+    }
+    return *ptype;
+}
+
+/*-------------------------------------------------------------------*/
+void
+clamp_length( Vector2D & v,
+              const double max_length )
+{
+    const double r2 = v.r2();
+    if ( r2 > max_length * max_length )
+    {
+        v *= max_length / std::sqrt( r2 );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief push the object out of the other object
+  \return the moved position of the object
+*/
+Vector2D
+push_out( const Vector2D & pos,
+          const Vector2D & other,
+          const double min_dist )
+{
+    Vector2D rel = pos - other;
+    const double r = rel.r();
+    if ( r < 1.0e-10 )
+    {
+        return other + Vector2D( min_dist, 0.0 );
+    }
+    return other + rel * ( min_dist / r );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+RolloutSimulator::Rollout::init( const WorldSnapshot & state,
+                                 const std::uint64_t seed )
+{
+    state_ = state;
+    for ( std::size_t i = 0; i < state.size(); ++i )
+    {
+        stamina_[i].init( player_type_of( state.player( i ) ) );
+    }
+    rng_ = seed;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  splitmix64
+ */
+double
+RolloutSimulator::Rollout::random()
+{
+    std::uint64_t z = ( rng_ += 0x9e3779b97f4a7c15ull );
+    z = ( z ^ ( z >> 30 ) ) * 0xbf58476d1ce4e5b9ull;
+    z = ( z ^ ( z >> 27 ) ) * 0x94d049bb133111ebull;
+    z ^= ( z >> 31 );
+    return static_cast< double >( z >> 11 ) * ( 2.0 / 9007199254740992.0 ) - 1.0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+RolloutSimulator::RolloutSimulator()
+    : M_noise( false )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+RolloutSimulator::step( Rollout * rollouts,
+                        const std::size_t n_rollouts,
+                        const Command * commands ) const
+{
+    for ( std::size_t r = 0; r < n_rollouts; ++r )
+    {
+        step( rollouts[r],
+              commands + r * WorldSnapshot::MAX_PLAYERS,
+              WorldSnapshot::MAX_PLAYERS );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+RolloutSimulator::step( Rollout & rollout,
+                        const Command * commands,
+                        const std::size_t n_commands ) const
+{
+    const ServerParam & SP = ServerParam::i();
+    WorldSnapshot & state = rollout.state_;
+    const std::size_t n_players = state.size();
+
+    //
+    // commands
+    //
+
+    Vector2D player_accel[WorldSnapshot::MAX_PLAYERS];
+    double dash_power[WorldSnapshot::MAX_PLAYERS];
+    Vector2D ball_accel( 0.0, 0.0 );
+
+    for ( std::size_t i = 0; i < n_players; ++i )
+    {
+        player_accel[i].assign( 0.0, 0.0 );
+        dash_power[i] = 0.0;
+
+        if ( i >= n_commands
+             || commands[i].type_ == Command::NONE )
+        {
+            continue;
+        }
+
+        const PlayerType & ptype = player_type_of( state.player( i ) );
+        ball_accel += applyCommand( rollout, i, ptype, commands[i], &player_accel[i] );
+
+        if ( commands[i].type_ == Command::DASH )
+        {
+            dash_power[i] = commands[i].arg1_;
+        }
+    }
+
+    //
+    // ball movement
+    //
+
+    {
+        BallState & ball = state.ball();
+        clamp_length( ball_accel, SP.ballAccelMax() );
+
+        Vector2D vel = ball.vel() + ball_accel;
+        clamp_length( vel, SP.ballSpeedMax() );
+
+        if ( M_noise )
+        {
+            const double max_rand = SP.ballRand() * vel.r();
+            vel += Vector2D( max_rand * rollout.random(),
+                             max_rand * rollout.random() );
+        }
+
+        ball.setState( ball.pos() + vel, vel * SP.ballDecay() );
+    }
+
+    //
+    // player movement
+    //
+
+    for ( std::size_t i = 0; i < n_players; ++i )
+    {
+        PlayerState & p = state.player( i );
+        const PlayerType & ptype = player_type_of( p );
+
+        clamp_length( player_accel[i], SP.playerAccelMax() );
+
+        Vector2D vel = p.vel() + player_accel[i];
+        clamp_length( vel, ptype.playerSpeedMax() );
+
+        if ( M_noise )
+        {
+            const double max_rand = SP.playerRand() * vel.r();
+            vel += Vector2D( max_rand * rollout.random(),
+                             max_rand * rollout.random() );
+        }
+
+        const Vector2D pos = p.pos() + vel;
+        vel *= ptype.playerDecay();
+
+        p.setPos( pos.x, pos.y );
+        p.setVel( vel.x, vel.y );
+    }
+
+    collide( rollout );
+
+    //
+    // stamina
+    //
+
+    for ( std::size_t i = 0; i < n_players; ++i )
+    {
+        const PlayerType & ptype = player_type_of( state.player( i ) );
+        if ( dash_power[i] != 0.0 )
+        {
+            rollout.stamina_[i].simulateDash( ptype, dash_power[i] );
+        }
+        else
+        {
+            rollout.stamina_[i].simulateWait( ptype );
+        }
+    }
+
+    state.setTime( GameTime( state.time().cycle() + 1, 0 ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+Vector2D
+RolloutSimulator::applyCommand( Rollout & rollout,
+                                const std::size_t i,
+                                const PlayerType & ptype,
+                                const Command & cmd,
+                                Vector2D * player_accel ) const
+{
+    const ServerParam & SP = ServerParam::i();
+    PlayerState & p = rollout.state_.player( i );
+    const BallState & ball = rollout.state_.ball();
+
+    switch ( cmd.type_ ) {
+    case Command::DASH: {
+        double power = SP.normalizeDashPower( cmd.arg1_ );
+        const double dir = SP.discretizeDashAngle( SP.normalizeDashAngle( cmd.arg2_ ) );
+
+        // the available stamina limits the dash power.
+        const double available = rollout.stamina_[i].stamina() + ptype.extraStamina();
+        const double power_need = ( power < 0.0 ? power * -2.0 : power );
+        if ( power_need > available )
+        {
+            power = ( power < 0.0 ? available * -0.5 : available );
+        }
+
+        const double eff_power = std::fabs( power
+                                            * rollout.stamina_[i].effort()
+                                            * SP.dashDirRate( dir )
+                                            * ptype.dashPowerRate() );
+        const AngleDeg accel_dir = p.body() + ( power < 0.0 ? dir + 180.0 : dir );
+        *player_accel += Vector2D::polar2vector( eff_power, accel_dir );
+        break;
+    }
+    case Command::TURN: {
+        double moment = SP.normalizeMoment( cmd.arg1_ );
+        if ( M_noise )
+        {
+            moment *= 1.0 + SP.playerRand() * rollout.random();
+        }
+        const double turn = ptype.effectiveTurn( moment, p.vel().r() );
+        p.setAngle( ( p.body() + turn ).degree(), ( p.face() - p.body() ).degree() );
+        break;
+    }
+    case Command::KICK: {
+        const Vector2D rel = ball.pos() - p.pos();
+        const double dist = rel.r();
+        if ( dist > ptype.kickableArea() )
+        {
+            break;
+        }
+
+        const double power = SP.normalizePower( cmd.arg1_ );
+        const double dir = AngleDeg::normalize_angle( cmd.arg2_ );
+        const double dir_diff = ( rel.th() - p.body() ).abs();
+        const double eff_power = power * ptype.kickRate( dist, dir_diff );
+
+        Vector2D accel = Vector2D::polar2vector( eff_power, p.body() + dir );
+        if ( M_noise )
+        {
+            const double pos_rate = 0.5 + 0.25 * ( dir_diff / 180.0
+                                                   + ( dist - SP.ballSize() - ptype.playerSize() )
+                                                   / ptype.kickableMargin() );
+            const double speed_rate = 0.5 + 0.5 * ( ball.vel().r()
+                                                    / ( SP.ballSpeedMax() * SP.ballDecay() ) );
+            const double max_rand = ( ptype.kickRand()
+                                      * ( power / SP.maxPower() )
+                                      * ( pos_rate + speed_rate ) );
+            accel += Vector2D( max_rand * rollout.random(),
+                               max_rand * rollout.random() );
+        }
+        return accel;
+    }
+    case Command::TACKLE: {
+        const Vector2D rel = ( ball.pos() - p.pos() ).rotatedVector( - p.body() );
+        const double tackle_dist = ( rel.x > 0.0 ? SP.tackleDist() : SP.tackleBackDist() );
+        if ( tackle_dist < 1.0e-5 )
+        {
+            break;
+        }
+
+        const double fail_prob = ( std::pow( rel.absX() / tackle_dist, SP.tackleExponent() )
+                                   + std::pow( rel.absY() / SP.tackleWidth(), SP.tackleExponent() ) );
+        // random() is in [-1, 1]
+        if ( fail_prob >= 1.0
+             || ( rollout.random() + 1.0 ) * 0.5 > 1.0 - fail_prob )
+        {
+            break;
+        }
+
+        const double dir = AngleDeg::normalize_angle( cmd.arg1_ );
+        double eff_power = ( SP.maxBackTacklePower()
+                             + ( SP.maxTacklePower() - SP.maxBackTacklePower() )
+                             * ( 1.0 - std::fabs( dir ) / 180.0 ) );
+        eff_power *= SP.tacklePowerRate();
+        eff_power *= 1.0 - 0.5 * ( std::fabs( rel.th().degree() ) / 180.0 );
+
+        return Vector2D::polar2vector( eff_power, p.body() + dir );
+    }
+    default:
+        break;
+    }
+
+    return Vector2D( 0.0, 0.0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+RolloutSimulator::collide( Rollout & rollout ) const
+{
+    const ServerParam & SP = ServerParam::i();
+    WorldSnapshot & state = rollout.state_;
+    BallState & ball = state.ball();
+    const std::size_t n_players = state.size();
+
+    //
+    // player - ball
+    //
+
+    for ( std::size_t i = 0; i < n_players; ++i )
+    {
+        PlayerState & p = state.player( i );
+        const double min_dist = player_type_of( p ).playerSize() + SP.ballSize();
+
+        if ( p.pos().dist2( ball.pos() ) < min_dist * min_dist )
+        {
+            ball.setState( push_out( ball.pos(), p.pos(), min_dist ),
+                           ball.vel() * -0.1 );
+            p.setVel( p.vel().x * -0.1, p.vel().y * -0.1 );
+        }
+    }
+
+    //
+    // player - player
+    //
+
+    for ( std::size_t i = 0; i < n_players; ++i )
+    {
+        PlayerState & p1 = state.player( i );
+        const double size1 = player_type_of( p1 ).playerSize();
+
+        for ( std::size_t j = i + 1; j < n_players; ++j )
+        {
+            PlayerState & p2 = state.player( j );
+            const double min_dist = size1 + player_type_of( p2 ).playerSize();
+
+            if ( p1.pos().dist2( p2.pos() ) >= min_dist * min_dist )
+            {
+                continue;
+            }
+
+            // both players are moved away from the middle point
+            const Vector2D center = ( p1.pos() + p2.pos() ) * 0.5;
+            const Vector2D pos1 = push_out( p1.pos(), center, min_dist * 0.5 );
+            const Vector2D pos2 = center * 2.0 - pos1;
+
+            p1.setPos( pos1.x, pos1.y );
+            p2.setPos( pos2.x, pos2.y );
+            p1.setVel( p1.vel().x * -0.1, p1.vel().y * -0.1 );
+            p2.setVel( p2.vel().x * -0.1, p2.vel().y * -0.1 );
+        }
+    }
+}
+
+}
@@ -0,0 +1,204 @@
+// -*-c++-*-
+
+/*!
+  \file rollout_simulator.h
+  \brief forward physics simulator over WorldSnapshot Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_PLAYER_ROLLOUT_SIMULATOR_H
+#define RCSC_PLAYER_ROLLOUT_SIMULATOR_H
+
+#include <rcsc/player/world_snapshot.h>
+#include <rcsc/common/stamina_model.h>
+#include <rcsc/geom/vector_2d.h>
+
+#include <cstdint>
+#include <cstddef>
+
+namespace rcsc {
+
+class PlayerType;
+
+/*!
+  \class RolloutSimulator
+  \brief forward physics simulator for the look-ahead rollouts.
+
+  The simulator advances WorldSnapshot by one cycle following the rules of
+  rcssserver: the commands (dash, turn, kick and tackle) are applied first,
+  then all objects move, collide and decay, and finally the stamina of each
+  player is updated by StaminaModel. The wind is not simulated.
+
+  Each Rollout has its own random number generator, so the result of a
+  rollout depends only on its seed and its commands. The movement noise is
+  disabled by default. The tackle result always uses the generator, because
+  the tackle success is a probability in the server.
+
+  \code
+  RolloutSimulator sim;
+  std::vector< RolloutSimulator::Rollout > rollouts( 1000 );
+  for ( std::size_t i = 0; i < rollouts.size(); ++i )
+  {
+      rollouts[i].init( WorldSnapshot( wm ), i );
+  }
+  // commands: rollouts.size() * WorldSnapshot::MAX_PLAYERS
+  sim.step( rollouts.data(), rollouts.size(), commands.data() );
+  \endcode
+*/
+class RolloutSimulator {
+public:
+
+    /*!
+      \struct Command
+      \brief a player command in the rollout
+    */
+    struct Command {
+        /*!
+          \brief command type
+        */
+        enum Type {
+            NONE,
+            DASH, //!< arg1 = power, arg2 = direction relative to body
+            TURN, //!< arg1 = moment
+            KICK, //!< arg1 = power, arg2 = direction relative to body
+            TACKLE, //!< arg1 = direction relative to body
+        };
+
+        Type type_; //!< command type
+        double arg1_; //!< first argument
+        double arg2_; //!< second argument
+
+        //! create a NONE command
+        Command()
+            : type_( NONE ),
+              arg1_( 0.0 ),
+              arg2_( 0.0 )
+          { }
+
+        //! create a command
+        Command( const Type type,
+                 const double arg1,
+                 const double arg2 = 0.0 )
+            : type_( type ),
+              arg1_( arg1 ),
+              arg2_( arg2 )
+          { }
+    };
+
+    /*!
+      \struct Rollout
+      \brief state of one independent rollout
+    */
+    struct Rollout {
+        WorldSnapshot state_; //!< simulated world state
+        StaminaModel stamina_[WorldSnapshot::MAX_PLAYERS]; //!< stamina of each player
+        std::uint64_t rng_; //!< random number generator state
+
+        /*!
+          \brief initialize the rollout. the stamina of all players is set to the initial value.
+          \param state initial world state
+          \param seed random seed
+         */
+        void init( const WorldSnapshot & state,
+                   const std::uint64_t seed );
+
+        /*!
+          \brief get the next uniform random value in [-1, 1]
+          \return random value
+         */
+        double random();
+    };
+
+private:
+
+    bool M_noise; //!< true if the movement noise is simulated
+
+public:
+
+    /*!
+      \brief create a simulator without noise
+    */
+    RolloutSimulator();
+
+    /*!
+      \brief set the movement noise switch
+      \param on if true, the movement and the command noise are simulated
+     */
+    void setNoise( const bool on )
+      {
+          M_noise = on;
+      }
+
+    /*!
+      \brief check if the noise is simulated
+      \return noise switch
+     */
+    bool noise() const
+      {
+          return M_noise;
+      }
+
+    /*!
+      \brief advance one rollout by one cycle
+      \param rollout target rollout
+      \param commands command array indexed by the player index of the snapshot.
+      \param n_commands size of the command array. players without command do nothing.
+     */
+    void step( Rollout & rollout,
+               const Command * commands,
+               const std::size_t n_commands ) const;
+
+    /*!
+      \brief advance the batch of independent rollouts by one cycle
+      \param rollouts rollout array
+      \param n_rollouts size of the rollout array
+      \param commands command matrix (n_rollouts x WorldSnapshot::MAX_PLAYERS)
+     */
+    void step( Rollout * rollouts,
+               const std::size_t n_rollouts,
+               const Command * commands ) const;
+
+private:
+
+    /*!
+      \brief apply the command of one player
+      \return ball acceleration caused by the command
+     */
+    Vector2D applyCommand( Rollout & rollout,
+                           const std::size_t i,
+                           const PlayerType & ptype,
+                           const Command & cmd,
+                           Vector2D * player_accel ) const;
+
+    /*!
+      \brief resolve the collisions after the movement
+     */
+    void collide( Rollout & rollout ) const;
+};
+
+}
+
+#endif
@@ -59,13 +59,11 @@ BallMessage::appendTo( std::string & to ) const
         return false;
     }
 
-    std::string msg;
-    msg.reserve( slength() - 1 );
+    char msg[8];
 
     if ( ! AudioCodec::i().encodePosVelToStr5( M_ball_pos,
                                                M_ball_vel,
-                                               msg )
-         || (int)msg.length() != slength() - 1 )
+                                               msg ) )
     {
         std::cerr << __FILE__ << ":" << __LINE__
                   << " ***ERROR*** BallMessage. "
@@ -78,15 +76,17 @@ BallMessage::appendTo( std::string & to ) const
         return false;
     }
 
+    msg[5] = '\0';
+
     dlog.addText( Logger::SENSOR,
                   "BallMessage. success!"
                   " pos=(%f %f) vel=(%f %f) -> [%s]",
                   M_ball_pos.x, M_ball_pos.y,
                   M_ball_vel.x, M_ball_vel.y,
-                  msg.c_str() );
+                  msg );
 
     to += header();
-    to += msg;
+    to.append( msg, 5 );
 
     return true;
 }
@@ -120,8 +120,8 @@ PassMessage::appendTo( std::string & to ) const
         return false;
     }
 
-    std::string msg;
-    msg.reserve( slength() - 1 );
+    // receiver info (4 characters) and ball info (5 characters)
+    char msg[16];
 
     if ( ! AudioCodec::i().encodeUnumPosToStr4( M_receiver_unum,
                                                 M_receive_point,
@@ -140,7 +140,7 @@ PassMessage::appendTo( std::string & to ) const
 
     if ( ! AudioCodec::i().encodePosVelToStr5( M_ball_pos,
                                                M_ball_vel,
-                                               msg ) )
+                                               msg + 4 ) )
     {
         std::cerr << __FILE__ << ":" << __LINE__
                   << " ***ERROR*** PassMessage. ball info"
@@ -153,17 +153,7 @@ PassMessage::appendTo( std::string & to ) const
         return false;
     }
 
-    if ( (int)msg.length() != slength() - 1 )
-    {
-        std::cerr << __FILE__ << ":" << __LINE__
-                  << " ***ERROR*** PassMessage. length"
-                  << std::endl;
-        dlog.addText( Logger::SENSOR,
-                      "PassMessage. error!"
-                      " illegal message length = %d [%s] ",
-                      msg.length(), msg.c_str() );
-        return false;
-    }
+    msg[9] = '\0';
 
     dlog.addText( Logger::SENSOR,
                   "PassMessage. success!"
@@ -173,10 +163,10 @@ PassMessage::appendTo( std::string & to ) const
                   M_receive_point.x, M_receive_point.y,
                   M_ball_pos.x, M_ball_pos.y,
                   M_ball_vel.x, M_ball_vel.y,
-                  msg.c_str() );
+                  msg );
 
     to += header();
-    to += msg;
+    to.append( msg, 9 );
 
     return true;
 }
@@ -243,11 +233,9 @@ GoalieMessage::appendTo( std::string & to ) const
     ival *= 360;
     ival += static_cast< std::int64_t >( bound( 0.0, rint( body ), 359.0 ) );
 
-    std::string msg;
-    msg.reserve( slength() - 1 );
+    char msg[16];
 
-    if ( ! AudioCodec::i().encodeInt64ToStr( ival, slength() - 1, msg )
-         || (int)msg.length() != slength() - 1 )
+    if ( ! AudioCodec::i().encodeInt64( ival, slength() - 1, msg ) )
     {
         std::cerr << __FILE__ << ":" << __LINE__
                   << " ***ERROR*** GoalieMessage. "
@@ -260,14 +248,16 @@ GoalieMessage::appendTo( std::string & to ) const
         return false;
     }
 
+    msg[slength() - 1] = '\0';
+
     dlog.addText( Logger::SENSOR,
                   "GoalieMessage. success! unum=%d pos=(%f %f) x=%f y=%f -> [%s]",
                   M_goalie_unum, M_goalie_pos.x, M_goalie_pos.y,
                   x, y,
-                  msg.c_str() );
+                  msg );
 
     to += header();
-    to += msg;
+    to.append( msg, slength() - 1 );
 
     return true;
 }
@@ -347,11 +337,9 @@ GoalieAndPlayerMessage::appendTo( std::string & to ) const
     ival += static_cast< std::int64_t >( bound( 0.0, rint( player_y / 0.555 ), 123.0 ) );
 
 
-    std::string msg;
-    msg.reserve( slength() - 1 );
+    char msg[16];
 
-    if ( ! AudioCodec::i().encodeInt64ToStr( ival, slength() - 1, msg )
-         || (int)msg.length() != slength() - 1 )
+    if ( ! AudioCodec::i().encodeInt64( ival, slength() - 1, msg ) )
     {
         std::cerr << __FILE__ << ":" << __LINE__
                   << " ***ERROR*** GoalieAndPlayerMessage. "
@@ -366,16 +354,18 @@ GoalieAndPlayerMessage::appendTo( std::string & to ) const
         return false;
     }
 
+    msg[slength() - 1] = '\0';
+
     dlog.addText( Logger::SENSOR,
                   "GoalieAndPlayerMessage. success! goalie=%d (%.2f %.2f) x=%f y=%f"
                   " player num=%d (%.2f %.2f) -> [%s]",
                   M_goalie_unum, M_goalie_pos.x, M_goalie_pos.y,
                   goalie_x, goalie_y,
                   M_player_number, player_x, player_y,
-                  msg.c_str() );
+                  msg );
 
     to += header();
-    to += msg;
+    to.append( msg, slength() - 1 );
 
     return true;
 }
@@ -558,12 +548,8 @@ SetplayMessage::appendTo( std::string & to ) const
         return false;
     }
 
-    char ch;
-    try
-    {
-        ch = AudioCodec::i().intToCharMap().at( M_wait_step );
-    }
-    catch ( std::exception & e )
+    const char ch = AudioCodec::i().intToChar( M_wait_step );
+    if ( ch == '\0' )
     {
         std::cerr << __FILE__ << ":" << __LINE__
                   << " ***ERROR*** SetplayMessage. cannot encode wait_step = " << M_wait_step
@@ -606,28 +592,17 @@ InterceptMessage::appendTo( std::string & to ) const
         return false;
     }
 
-    try
-    {
-        int unum = ( M_our ? M_unum : M_unum + MAX_PLAYER );
-
-        char unum_ch = AudioCodec::i().intToCharMap().at( unum );
-        char cycle_ch = AudioCodec::i().intToCharMap().at( M_cycle );
+    const int unum = ( M_our ? M_unum : M_unum + MAX_PLAYER );
 
-        to += header();
-        to += unum_ch;
-        to += cycle_ch;
+    const char unum_ch = AudioCodec::i().intToChar( unum );
+    const char cycle_ch = AudioCodec::i().intToChar( M_cycle );
 
-        dlog.addText( Logger::SENSOR,
-                      "InterceptMessage. success! %s unum = %d, cycle = %d -> [%c%c]",
-                      M_our ? "our" : "opp",
-                      M_unum, M_cycle, unum_ch, cycle_ch );
-
-    }
-    catch ( ... )
+    if ( unum_ch == '\0'
+         || cycle_ch == '\0' )
     {
         std::cerr << __FILE__ << ":" << __LINE__
                   << " ***ERROR*** InterceptMessage."
-                  << " Exception caught! Failed to encode cycle = "
+                  << " Failed to encode cycle = "
                   << M_cycle
                   << std::endl;
         dlog.addText( Logger::SENSOR,
@@ -636,6 +611,14 @@ InterceptMessage::appendTo( std::string & to ) const
         return false;
     }
 
+    to += header();
+    to += unum_ch;
+    to += cycle_ch;
+
+    dlog.addText( Logger::SENSOR,
+                  "InterceptMessage. success! %s unum = %d, cycle = %d -> [%c%c]",
+                  M_our ? "our" : "opp",
+                  M_unum, M_cycle, unum_ch, cycle_ch );
 
     return true;
 }
@@ -667,11 +650,9 @@ PassRequestMessage::appendTo( std::string & to ) const
         return false;
     }
 
-    std::string msg;
-    msg.reserve( slength() - 1 );
+    char msg[4];
 
-    if ( ! AudioCodec::i().encodePosToStr3( M_target_point, msg )
-         || (int)msg.length() != slength() - 1 )
+    if ( ! AudioCodec::i().encodePosToStr3( M_target_point, msg ) )
     {
         std::cerr << __FILE__ << ":" << __LINE__
                   << " ***ERROR*** PassRequestMessage. "
@@ -684,13 +665,15 @@ PassRequestMessage::appendTo( std::string & to ) const
         return false;
     }
 
+    msg[3] = '\0';
+
     dlog.addText( Logger::SENSOR,
                   "PassRequestMessage. success!. dash_target=(%f %f) -> [%s]",
                   M_target_point.x, M_target_point.y,
-                  msg.c_str() );
+                  msg );
 
     to += header();
-    to += msg;
+    to.append( msg, 3 );
 
     return true;
 }
@@ -896,31 +879,30 @@ DribbleMessage::appendTo( std::string & to ) const
     ival *= 10;
     ival += count - 1;
 
-    std::string msg;
-    msg.reserve( slength() - 1 );
+    char msg[16];
 
-    if ( ! AudioCodec::i().encodeInt64ToStr( ival, slength() - 1, msg )
-         || (int)msg.length() != slength() - 1 )
+    if ( ! AudioCodec::i().encodeInt64( ival, slength() - 1, msg ) )
     {
         std::cerr << __FILE__ << ":" << __LINE__
                   << " ***ERROR*** DribbleMessage. target=" << M_target_point
                   << std::endl;
         dlog.addText( Logger::SENSOR,
-                      "DribbleMessage. error!. pos=(%f %f) count=%d,"
-                      " message_length=%d",
+                      "DribbleMessage. error!. pos=(%f %f) count=%d",
                       M_target_point.x, M_target_point.y,
-                      M_queue_count, msg.length() );
+                      M_queue_count );
         return false;
     }
 
+    msg[slength() - 1] = '\0';
+
     dlog.addText( Logger::SENSOR,
                   "DribbleMessage. success!. pos=(%f %f) count=%d -> [%s]",
                   M_target_point.x, M_target_point.y,
                   M_queue_count,
-                  msg.c_str() );
+                  msg );
 
     to += header();
-    to += msg;
+    to.append( msg, slength() - 1 );
 
     return true;
 }
@@ -1013,11 +995,9 @@ BallGoalieMessage::appendTo( std::string & to ) const
     ival *= 360;
     ival += static_cast< std::int64_t >( bound( 0.0, rint( dval ), 359.0 ) );
 
-    std::string msg;
-    msg.reserve( slength() - 1 );
+    char msg[16];
 
-    if ( ! AudioCodec::i().encodeInt64ToStr( ival, slength() - 1, msg )
-         || (int)msg.length() != slength() - 1 )
+    if ( ! AudioCodec::i().encodeInt64( ival, slength() - 1, msg ) )
     {
         std::cerr << __FILE__ << ":" << __LINE__
                   << " ***ERROR*** BallGoalieMessage. "
@@ -1034,6 +1014,8 @@ BallGoalieMessage::appendTo( std::string & to ) const
         return false;
     }
 
+    msg[slength() - 1] = '\0';
+
     dlog.addText( Logger::SENSOR,
                   "BallGoalieMessage. success!. bpos=(%f %f) bvel(%f %f)"
                   " gpos(%f %f) gbody %f -> [%s]",
@@ -1041,10 +1023,10 @@ BallGoalieMessage::appendTo( std::string & to ) const
                   M_ball_vel.x, M_ball_vel.y,
                   M_goalie_pos.x, M_goalie_pos.y,
                   M_goalie_body.degree(),
-                  msg.c_str() );
+                  msg );
 
     to += header();
-    to += msg;
+    to.append( msg, slength() - 1 );
 
     return true;
 }
@@ -1105,11 +1087,9 @@ OnePlayerMessage::appendTo( std::string & to ) const
     ival *= 109;
     ival += static_cast< std::int64_t >( bound( 0.0, rint( player_y / 0.63 ), 108.0 ) );
 
-    std::string msg;
-    msg.reserve( slength() - 1 );
+    char msg[16];
 
-    if ( ! AudioCodec::i().encodeInt64ToStr( ival, slength() - 1, msg )
-         || (int)msg.length() != slength() - 1 )
+    if ( ! AudioCodec::i().encodeInt64( ival, slength() - 1, msg ) )
     {
         std::cerr << __FILE__ << ":" << __LINE__
                   << " ***ERROR*** OnePlayerMessage. "
@@ -1123,14 +1103,16 @@ OnePlayerMessage::appendTo( std::string & to ) const
         return false;
     }
 
+    msg[slength() - 1] = '\0';
+
     dlog.addText( Logger::SENSOR,
                   "OnePlayerMessage. success!. unum = %d pos=(%f %f) -> [%s]",
                   M_unum,
                   M_player_pos.x, M_player_pos.y,
-                  msg.c_str() );
+                  msg );
 
     to += header();
-    to += msg;
+    to.append( msg, slength() - 1 );
 
     return true;
 }
@@ -1212,11 +1194,9 @@ TwoPlayerMessage::appendTo( std::string & to ) const
         ival += static_cast< std::int64_t >( bound( 0.0, rint( dval / 0.63 ), 108.0 ) );
     }
 
-    std::string msg;
-    msg.reserve( slength() - 1 );
+    char msg[16];
 
-    if ( ! AudioCodec::i().encodeInt64ToStr( ival, slength() - 1, msg )
-         || (int)msg.length() != slength() - 1 )
+    if ( ! AudioCodec::i().encodeInt64( ival, slength() - 1, msg ) )
     {
         std::cerr << __FILE__ << ":" << __LINE__
                   << " ***ERROR*** TwoPlayerMessage. "
@@ -1232,6 +1212,8 @@ TwoPlayerMessage::appendTo( std::string & to ) const
         return false;
     }
 
+    msg[slength() - 1] = '\0';
+
     if ( dlog.isEnabled( Logger::SENSOR ) )
     {
         for ( int i = 0; i < 2; ++i )
@@ -1243,11 +1225,11 @@ TwoPlayerMessage::appendTo( std::string & to ) const
         }
 
         dlog.addText( Logger::SENSOR,
-                      "--> [%s]", msg.c_str() );
+                      "--> [%s]", msg );
     }
 
     to += header();
-    to += msg;
+    to.append( msg, slength() - 1 );
 
     return true;
 }
@@ -1338,11 +1320,9 @@ ThreePlayerMessage::appendTo( std::string & to ) const
         ival += static_cast< std::int64_t >( bound( 0.0, rint( dval / 0.63 ), 108.0 ) );
     }
 
-    std::string msg;
-    msg.reserve( slength() - 1 );
+    char msg[16];
 
-    if ( ! AudioCodec::i().encodeInt64ToStr( ival, slength() - 1, msg )
-         || (int)msg.length() != slength() - 1 )
+    if ( ! AudioCodec::i().encodeInt64( ival, slength() - 1, msg ) )
     {
         std::cerr << __FILE__ << ":" << __LINE__
                   << " ***ERROR*** ThreePlayerMessage. "
@@ -1358,6 +1338,8 @@ ThreePlayerMessage::appendTo( std::string & to ) const
         return false;
     }
 
+    msg[slength() - 1] = '\0';
+
     if ( dlog.isEnabled( Logger::SENSOR ) )
     {
         for ( int i = 0; i < 3; ++i )
@@ -1369,11 +1351,11 @@ ThreePlayerMessage::appendTo( std::string & to ) const
         }
 
         dlog.addText( Logger::SENSOR,
-                      "--> [%s]", msg.c_str() );
+                      "--> [%s]", msg );
     }
 
     to += header();
-    to += msg;
+    to.append( msg, slength() - 1 );
 
     return true;
 }
@@ -1442,11 +1424,9 @@ SelfMessage::appendTo( std::string & to ) const
     ival *= 11;
     ival += static_cast< std::int64_t >( bound( 0.0, rint( dval * 10.0 ), 10.0 ) );
 
-    std::string msg;
-    msg.reserve( slength() - 1 );
+    char msg[16];
 
-    if ( ! AudioCodec::i().encodeInt64ToStr( ival, slength() - 1, msg )
-         || (int)msg.length() != slength() - 1 )
+    if ( ! AudioCodec::i().encodeInt64( ival, slength() - 1, msg ) )
     {
         std::cerr << __FILE__ << ":" << __LINE__
                   << " ***ERROR*** SelfMessage. "
@@ -1461,6 +1441,8 @@ SelfMessage::appendTo( std::string & to ) const
         return false;
     }
 
+    msg[slength() - 1] = '\0';
+
     dlog.addText( Logger::SENSOR,
                   "SelfMessage. success!."
                   " pos=(%f %f)"
@@ -1468,10 +1450,10 @@ SelfMessage::appendTo( std::string & to ) const
                   M_self_pos.x, M_self_pos.y,
                   M_self_body.degree(),
                   M_self_stamina,
-                  msg.c_str() );
+                  msg );
 
     to += header();
-    to += msg;
+    to.append( msg, slength() - 1 );
 
     return true;
 }
@@ -1534,11 +1516,9 @@ TeammateMessage::appendTo( std::string & to ) const
     ival *= 180; // = 360/2
     ival += static_cast< std::int64_t >( rint( dval / 2.0 ) );
 
-    std::string msg;
-    msg.reserve( slength() - 1 );
+    char msg[16];
 
-    if ( ! AudioCodec::i().encodeInt64ToStr( ival, slength() - 1, msg )
-         || (int)msg.length() != slength() - 1 )
+    if ( ! AudioCodec::i().encodeInt64( ival, slength() - 1, msg ) )
     {
         std::cerr << __FILE__ << ":" << __LINE__
                   << " ***ERROR*** TeammateMessage. "
@@ -1553,16 +1533,18 @@ TeammateMessage::appendTo( std::string & to ) const
         return false;
     }
 
+    msg[slength() - 1] = '\0';
+
     dlog.addText( Logger::SENSOR,
                   "TeammateMessage. success!. unum = %d pos=(%f %f)"
                   " body=%f -> [%s]",
                   M_unum,
                   M_player_pos.x, M_player_pos.y,
                   M_player_body.degree(),
-                  msg.c_str() );
+                  msg );
 
     to += header();
-    to += msg;
+    to.append( msg, slength() - 1 );
 
     return true;
 }
@@ -1626,11 +1608,9 @@ OpponentMessage::appendTo( std::string & to ) const
     ival *= 180; // = 360/2
     ival += static_cast< std::int64_t >( bound( 0.0, rint( dval / 2.0 ), 179.0 ) );
 
-    std::string msg;
-    msg.reserve( slength() - 1 );
+    char msg[16];
 
-    if ( ! AudioCodec::i().encodeInt64ToStr( ival, slength() - 1, msg )
-         || (int)msg.length() != slength() - 1 )
+    if ( ! AudioCodec::i().encodeInt64( ival, slength() - 1, msg ) )
     {
         std::cerr << __FILE__ << ":" << __LINE__
                   << " ***ERROR*** OpponentMessage. "
@@ -1645,16 +1625,18 @@ OpponentMessage::appendTo( std::string & to ) const
         return false;
     }
 
+    msg[slength() - 1] = '\0';
+
     dlog.addText( Logger::SENSOR,
                   "OpponentMessage. success!. unum = %d pos=(%f %f)"
                   " body=%f -> [%s]",
                   M_unum,
                   M_player_pos.x, M_player_pos.y,
                   M_player_body.degree(),
-                  msg.c_str() );
+                  msg );
 
     to += header();
-    to += msg;
+    to.append( msg, slength() - 1 );
 
     return true;
 }
@@ -1701,17 +1683,14 @@ BallPlayerMessage::appendTo( std::string & to ) const
         return false;
     }
 
-    std::string msg;
-    msg.reserve( slength() - 1 );
-
+    char msg[16];
 
     //
     // ball info (5 characters)
     //
     if ( ! AudioCodec::i().encodePosVelToStr5( M_ball_pos,
                                                M_ball_vel,
-                                               msg )
-         || msg.length() != 5 )
+                                               msg ) )
     {
         std::cerr << __FILE__ << ":" << __LINE__
                   << " ***ERROR*** BallPlayerMessage. "
@@ -1748,8 +1727,7 @@ BallPlayerMessage::appendTo( std::string & to ) const
     ival *= 180; // = 360/2
     ival += static_cast< std::int64_t >( bound( 0.0, rint( dval / 2.0 ), 179.0 ) );
 
-    if ( ! AudioCodec::i().encodeInt64ToStr( ival, 4, msg )
-         || (int)msg.length() != slength() - 1 )
+    if ( ! AudioCodec::i().encodeInt64( ival, 4, msg + 5 ) )
     {
         std::cerr << __FILE__ << ":" << __LINE__
                   << " ***ERROR*** BallPlayerMessage. "
@@ -1764,6 +1742,8 @@ BallPlayerMessage::appendTo( std::string & to ) const
         return false;
     }
 
+    msg[slength() - 1] = '\0';
+
     dlog.addText( Logger::SENSOR,
                   "BallPlayerMessage. success!."
                   " bpos(%f %f) bvel(%f %f)"
@@ -1774,10 +1754,10 @@ BallPlayerMessage::appendTo( std::string & to ) const
                   M_unum,
                   M_player_pos.x, M_player_pos.y,
                   M_player_body.degree(),
-                  msg.c_str() );
+                  msg );
 
     to += header();
-    to += msg;
+    to.append( msg, slength() - 1 );
 
     return true;
 }
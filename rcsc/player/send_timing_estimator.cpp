@@ -0,0 +1,219 @@
+// -*-c++-*-
+
+/*!
+  \file send_timing_estimator.cpp
+  \brief command send timing estimator Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "send_timing_estimator.h"
+
+#include <algorithm>
+
+namespace rcsc {
+
+constexpr std::size_t SendTimingEstimator::WINDOW_SIZE;
+constexpr std::size_t SendTimingEstimator::MIN_SAMPLES;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+SendTimingEstimator::Window::Window()
+{
+    clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SendTimingEstimator::Window::clear()
+{
+    std::fill( values_, values_ + WINDOW_SIZE, 0 );
+    size_ = 0;
+    next_ = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SendTimingEstimator::Window::add( const std::int64_t value )
+{
+    values_[next_] = value;
+    next_ = ( next_ + 1 ) % WINDOW_SIZE;
+    if ( size_ < WINDOW_SIZE )
+    {
+        ++size_;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::int64_t
+SendTimingEstimator::Window::percentile( const double rate ) const
+{
+    if ( size_ == 0 )
+    {
+        return 0;
+    }
+
+    std::int64_t sorted[WINDOW_SIZE];
+    std::copy( values_, values_ + size_, sorted );
+
+    const double r = std::min( 1.0, std::max( 0.0, rate ) );
+    const std::size_t idx = std::min( size_ - 1,
+                                      static_cast< std::size_t >( r * ( size_ - 1 ) + 0.5 ) );
+    std::nth_element( sorted, sorted + idx, sorted + size_ );
+    return sorted[idx];
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+SendTimingEstimator::SendTimingEstimator()
+    : M_sense_body_nsec( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SendTimingEstimator::clear()
+{
+    M_sense_body_nsec = 0;
+    M_intervals.clear();
+    M_see_offsets.clear();
+    M_decision_times.clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SendTimingEstimator::addSenseBody( const std::int64_t received_nsec )
+{
+    if ( received_nsec <= 0 )
+    {
+        return;
+    }
+
+    if ( M_sense_body_nsec > 0
+         && received_nsec > M_sense_body_nsec )
+    {
+        M_intervals.add( received_nsec - M_sense_body_nsec );
+    }
+
+    M_sense_body_nsec = received_nsec;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SendTimingEstimator::addSee( const std::int64_t received_nsec )
+{
+    if ( received_nsec <= 0
+         || M_sense_body_nsec <= 0
+         || received_nsec < M_sense_body_nsec )
+    {
+        return;
+    }
+
+    M_see_offsets.add( received_nsec - M_sense_body_nsec );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SendTimingEstimator::addDecisionTime( const std::int64_t nsec )
+{
+    if ( nsec < 0 )
+    {
+        return;
+    }
+
+    M_decision_times.add( nsec );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::int64_t
+SendTimingEstimator::sendDeadlineNSec( const std::int64_t margin_nsec ) const
+{
+    const std::int64_t median = M_intervals.percentile( 0.5 );
+    const std::int64_t jitter = std::max< std::int64_t >( 0, M_intervals.percentile( 0.95 ) - median );
+
+    return M_sense_body_nsec + median - jitter - margin_nsec;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::int64_t
+SendTimingEstimator::decisionStartLimitNSec( const std::int64_t margin_nsec ) const
+{
+    return sendDeadlineNSec( margin_nsec ) - M_decision_times.percentile( 0.95 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::int64_t
+SendTimingEstimator::expectedSeeNSec( const double rate ) const
+{
+    if ( M_see_offsets.size_ == 0
+         || M_sense_body_nsec <= 0 )
+    {
+        return 0;
+    }
+
+    return M_sense_body_nsec + M_see_offsets.percentile( rate );
+}
+
+}
@@ -0,0 +1,168 @@
+// -*-c++-*-
+
+/*!
+  \file send_timing_estimator.h
+  \brief command send timing estimator Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_PLAYER_SEND_TIMING_ESTIMATOR_H
+#define RCSC_PLAYER_SEND_TIMING_ESTIMATOR_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace rcsc {
+
+/*!
+  \class SendTimingEstimator
+  \brief estimates the latest safe time to send the command in a cycle.
+
+  The estimator keeps the recent samples of the sense_body arrival interval,
+  the see arrival offset from the sense_body and the decision time (from the
+  start of the action to the command send). All times are the socket
+  receive/send times in nanoseconds since the epoch (see
+  AbstractClient::receivedNSec()).
+
+  The next sense_body is expected at the median interval after the last
+  sense_body. The send deadline is the expected arrival minus the interval
+  jitter (the 95th percentile minus the median) and the safety margin. The
+  agent should not wait for the see message after the deadline minus the
+  95th percentile decision time.
+*/
+class SendTimingEstimator {
+public:
+
+    //! the number of samples kept for each value
+    static constexpr std::size_t WINDOW_SIZE = 64;
+    //! the number of interval samples required to estimate the timing
+    static constexpr std::size_t MIN_SAMPLES = 8;
+
+private:
+
+    /*!
+      \struct Window
+      \brief fixed size ring buffer of the recent samples
+    */
+    struct Window {
+        std::int64_t values_[WINDOW_SIZE]; //!< sample values
+        std::size_t size_; //!< the number of valid samples
+        std::size_t next_; //!< the index of the next sample
+
+        Window();
+
+        void clear();
+        void add( const std::int64_t value );
+
+        /*!
+          \brief get the percentile value of the samples
+          \param rate percentile rate [0,1]
+          \return the sample value at the percentile, or 0 if empty.
+        */
+        std::int64_t percentile( const double rate ) const;
+    };
+
+    std::int64_t M_sense_body_nsec; //!< receive time of the last sense_body
+    Window M_intervals; //!< sense_body arrival intervals
+    Window M_see_offsets; //!< see arrival offsets from the sense_body
+    Window M_decision_times; //!< elapsed time from the action start to the command send
+
+public:
+
+    /*!
+      \brief create an empty estimator
+    */
+    SendTimingEstimator();
+
+    /*!
+      \brief remove all samples
+    */
+    void clear();
+
+    /*!
+      \brief record the sense_body arrival
+      \param received_nsec receive time of the sense_body
+    */
+    void addSenseBody( const std::int64_t received_nsec );
+
+    /*!
+      \brief record the see arrival
+      \param received_nsec receive time of the see
+    */
+    void addSee( const std::int64_t received_nsec );
+
+    /*!
+      \brief record the decision time
+      \param nsec elapsed time from the action start to the command send
+    */
+    void addDecisionTime( const std::int64_t nsec );
+
+    /*!
+      \brief check if the estimator has enough samples
+      \return true if the timing can be estimated
+    */
+    bool isReady() const
+      {
+          return M_sense_body_nsec > 0
+              && M_intervals.size_ >= MIN_SAMPLES;
+      }
+
+    /*!
+      \brief get the receive time of the last sense_body
+      \return nanoseconds since the epoch, or 0 if not received yet.
+    */
+    std::int64_t senseBodyNSec() const
+      {
+          return M_sense_body_nsec;
+      }
+
+    /*!
+      \brief get the latest safe time to send the command in the current cycle
+      \param margin_nsec safety margin
+      \return nanoseconds since the epoch. meaningful only if isReady().
+    */
+    std::int64_t sendDeadlineNSec( const std::int64_t margin_nsec ) const;
+
+    /*!
+      \brief get the latest time to start the decision without the see message
+      \param margin_nsec safety margin
+      \return nanoseconds since the epoch. meaningful only if isReady().
+    */
+    std::int64_t decisionStartLimitNSec( const std::int64_t margin_nsec ) const;
+
+    /*!
+      \brief get the expected see arrival time in the current cycle
+      \param rate percentile rate of the see arrival offset
+      \return nanoseconds since the epoch, or 0 if no see sample.
+    */
+    std::int64_t expectedSeeNSec( const double rate ) const;
+
+};
+
+}
+
+#endif
@@ -0,0 +1,160 @@
+// -*-c++-*-
+
+/*!
+  \file speculative_worker.cpp
+  \brief background worker for the speculative pre-computation Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "speculative_worker.h"
+
+#include "world_model.h"
+
+namespace rcsc {
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+SpeculativeTask::finish( const WorldModel & wm )
+{
+    M_valid = ( completed()
+                && wm.time() == M_time
+                && correct( wm ) );
+    return M_valid;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+SpeculativeWorker::SpeculativeWorker()
+    : M_cancelled( false ),
+      M_stop( false )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+SpeculativeWorker::~SpeculativeWorker()
+{
+    {
+        std::lock_guard< std::mutex > lock( M_mutex );
+        M_stop = true;
+        M_pending.reset();
+        M_cancelled = true;
+    }
+    M_cond.notify_all();
+
+    if ( M_thread.joinable() )
+    {
+        M_thread.join();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SpeculativeWorker::submit( SpeculativeTask::Ptr task )
+{
+    if ( ! task )
+    {
+        return;
+    }
+
+    {
+        std::lock_guard< std::mutex > lock( M_mutex );
+        M_pending = task;
+        if ( M_running )
+        {
+            M_cancelled = true;
+        }
+    }
+    M_cond.notify_all();
+
+    if ( ! M_thread.joinable() )
+    {
+        M_thread = std::thread( &SpeculativeWorker::loop, this );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SpeculativeWorker::cancel()
+{
+    std::unique_lock< std::mutex > lock( M_mutex );
+    M_pending.reset();
+    if ( M_running )
+    {
+        M_cancelled = true;
+        M_cond.wait( lock, [this] { return ! M_running; } );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SpeculativeWorker::loop()
+{
+    std::unique_lock< std::mutex > lock( M_mutex );
+
+    while ( true )
+    {
+        M_cond.wait( lock, [this] { return M_stop || M_pending; } );
+        if ( M_stop )
+        {
+            break;
+        }
+
+        M_running.swap( M_pending );
+        M_cancelled = false;
+
+        SpeculativeTask::Ptr task = M_running;
+        lock.unlock();
+        task->execute( M_cancelled );
+        lock.lock();
+
+        M_running.reset();
+        M_cond.notify_all();
+    }
+}
+
+}
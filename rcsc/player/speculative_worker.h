@@ -0,0 +1,218 @@
+// -*-c++-*-
+
+/*!
+  \file speculative_worker.h
+  \brief background worker for the speculative pre-computation Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_PLAYER_SPECULATIVE_WORKER_H
+#define RCSC_PLAYER_SPECULATIVE_WORKER_H
+
+#include <rcsc/game_time.h>
+
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+namespace rcsc {
+
+class WorldModel;
+
+/*!
+  \class SpeculativeTask
+  \brief abstract pre-computation started at the sense_body arrival.
+
+  The task is created on the main thread just after
+  WorldModel::updateAfterSenseBody(). It must copy all inputs in its
+  constructor, because run() is executed on the worker thread while the
+  main thread keeps updating the world model by the see message.
+  run() must not touch the world model, the debug loggers or any other
+  shared state.
+
+  At the start of the next decision, the agent cancels the task if it
+  is still running. If the task has completed, correct() is called on
+  the main thread with the updated world model, so the result can be
+  corrected or invalidated by the see information.
+*/
+class SpeculativeTask {
+public:
+    //! smart pointer type
+    typedef std::shared_ptr< SpeculativeTask > Ptr;
+
+private:
+    GameTime M_time; //!< game time when this task was created
+    std::atomic< bool > M_completed; //!< true if run() has returned without cancellation
+    bool M_valid; //!< result of correct()
+
+    // not used
+    SpeculativeTask( const SpeculativeTask & ) = delete;
+    SpeculativeTask & operator=( const SpeculativeTask & ) = delete;
+
+protected:
+
+    /*!
+      \brief construct with the game time
+      \param current game time when this task is created
+    */
+    explicit
+    SpeculativeTask( const GameTime & current )
+        : M_time( current ),
+          M_completed( false ),
+          M_valid( false )
+      { }
+
+public:
+
+    /*!
+      \brief virtual destructor
+    */
+    virtual
+    ~SpeculativeTask()
+      { }
+
+    /*!
+      \brief get the game time when this task was created
+      \return game time
+    */
+    const GameTime & time() const
+      {
+          return M_time;
+      }
+
+    /*!
+      \brief check if the computation has completed
+      \return true if run() has returned without cancellation
+    */
+    bool completed() const
+      {
+          return M_completed.load( std::memory_order_acquire );
+      }
+
+    /*!
+      \brief check if the result is usable in the current decision
+      \return true if completed and accepted by correct()
+    */
+    bool isValid() const
+      {
+          return M_valid;
+      }
+
+    /*!
+      \brief execute the task and update the status. called on the worker thread.
+      \param cancelled cancellation flag
+    */
+    void execute( const std::atomic< bool > & cancelled )
+      {
+          if ( run( cancelled )
+               && ! cancelled.load( std::memory_order_relaxed ) )
+          {
+              M_completed.store( true, std::memory_order_release );
+          }
+      }
+
+    /*!
+      \brief call correct() if completed. called on the main thread.
+      \param wm world model updated by the see message
+      \return true if the result is usable
+    */
+    bool finish( const WorldModel & wm );
+
+protected:
+
+    /*!
+      \brief pure virtual method. the computation executed on the worker thread.
+      \param cancelled the task should return as soon as possible when this flag is set.
+      \return true if the computation has finished
+    */
+    virtual
+    bool run( const std::atomic< bool > & cancelled ) = 0;
+
+    /*!
+      \brief correct or validate the result by the latest world model. called on the main thread.
+      \param wm world model updated by the see message
+      \return true if the result is still usable
+    */
+    virtual
+    bool correct( const WorldModel & wm ) = 0;
+};
+
+/*!
+  \class SpeculativeWorker
+  \brief single background thread that executes at most one SpeculativeTask at a time.
+
+  The thread is started at the first submit(), so the agents that do not
+  use the speculative pre-computation have no extra thread.
+*/
+class SpeculativeWorker {
+private:
+
+    std::thread M_thread; //!< worker thread
+    std::mutex M_mutex; //!< lock for the task slots
+    std::condition_variable M_cond; //!< notified when the task slots are changed
+
+    SpeculativeTask::Ptr M_pending; //!< submitted but not started task
+    SpeculativeTask::Ptr M_running; //!< running task
+    std::atomic< bool > M_cancelled; //!< cancellation flag of the running task
+    bool M_stop; //!< thread termination flag
+
+    // not used
+    SpeculativeWorker( const SpeculativeWorker & ) = delete;
+    SpeculativeWorker & operator=( const SpeculativeWorker & ) = delete;
+
+public:
+
+    /*!
+      \brief construct an idle worker. no thread is started.
+    */
+    SpeculativeWorker();
+
+    /*!
+      \brief stop the thread
+    */
+    ~SpeculativeWorker();
+
+    /*!
+      \brief cancel the current task and start the new task
+      \param task new task
+    */
+    void submit( SpeculativeTask::Ptr task );
+
+    /*!
+      \brief cancel the pending and running tasks, and wait until the worker becomes idle.
+    */
+    void cancel();
+
+private:
+
+    void loop();
+};
+
+}
+
+#endif
@@ -0,0 +1,252 @@
+// -*-c++-*-
+
+/*!
+  \file think_time_profiler.cpp
+  \brief per-cycle think time profiler Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "think_time_profiler.h"
+
+#include <fstream>
+#include <algorithm>
+#include <limits>
+
+namespace rcsc {
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ThinkTimeProfiler::PhaseData::PhaseData()
+{
+    clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ThinkTimeProfiler::PhaseData::clear()
+{
+    count_ = 0;
+    total_usec_ = 0;
+    min_usec_ = std::numeric_limits< std::int64_t >::max();
+    max_usec_ = 0;
+    std::fill( histogram_, histogram_ + HISTOGRAM_SIZE, 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ThinkTimeProfiler::PhaseData::add( const std::int64_t usec )
+{
+    const std::int64_t v = std::max( std::int64_t( 0 ), usec );
+
+    ++count_;
+    total_usec_ += v;
+    min_usec_ = std::min( min_usec_, v );
+    max_usec_ = std::max( max_usec_, v );
+
+    const std::size_t idx = std::min( static_cast< std::size_t >( v / HISTOGRAM_RESOLUTION_USEC ),
+                                      HISTOGRAM_SIZE - 1 );
+    ++histogram_[idx];
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::int64_t
+ThinkTimeProfiler::PhaseData::percentile( const double rate ) const
+{
+    if ( count_ == 0 )
+    {
+        return 0;
+    }
+
+    const double target = std::min( 1.0, std::max( 0.0, rate ) ) * count_;
+    std::uint64_t sum = 0;
+    for ( std::size_t i = 0; i < HISTOGRAM_SIZE - 1; ++i )
+    {
+        sum += histogram_[i];
+        if ( sum >= target
+             && sum > 0 )
+        {
+            return std::min( max_usec_,
+                             static_cast< std::int64_t >( i + 1 ) * HISTOGRAM_RESOLUTION_USEC );
+        }
+    }
+
+    return max_usec_;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ThinkTimeProfiler::ThinkTimeProfiler()
+    : M_enabled( false ),
+      M_budget_usec( 100 * 1000 ),
+      M_deadline_missed_count( 0 ),
+      M_action_missed_count( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ThinkTimeProfiler::clear()
+{
+    for ( int i = 0; i < MAX_PHASE; ++i )
+    {
+        M_phases[i].clear();
+    }
+    M_deadline_missed_count = 0;
+    M_action_missed_count = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ThinkTimeProfiler::addCycle( const std::int64_t usec )
+{
+    add( CYCLE, usec );
+    if ( M_budget_usec > 0
+         && usec > M_budget_usec )
+    {
+        ++M_deadline_missed_count;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const char *
+ThinkTimeProfiler::phase_name( const Phase phase )
+{
+    switch ( phase ) {
+    case PARSE:
+        return "parse";
+    case UPDATE_AFTER_SEE:
+        return "update_after_see";
+    case UPDATE_BEFORE_DECISION:
+        return "update_just_before_decision";
+    case ACTION_IMPL:
+        return "action_impl";
+    case SEND:
+        return "send";
+    case ACTION:
+        return "action";
+    case CYCLE:
+        return "cycle";
+    default:
+        break;
+    }
+    return "unknown";
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+ThinkTimeProfiler::writeJSON( std::ostream & os ) const
+{
+    os << "{\n"
+       << "  \"budget_usec\": " << M_budget_usec << ",\n"
+       << "  \"histogram_resolution_usec\": " << HISTOGRAM_RESOLUTION_USEC << ",\n"
+       << "  \"deadline_missed\": " << M_deadline_missed_count << ",\n"
+       << "  \"action_missed\": " << M_action_missed_count << ",\n"
+       << "  \"phases\": {";
+
+    for ( int i = 0; i < MAX_PHASE; ++i )
+    {
+        const PhaseData & data = M_phases[i];
+
+        os << ( i == 0 ? "\n" : ",\n" )
+           << "    \"" << phase_name( static_cast< Phase >( i ) ) << "\": {"
+           << "\"count\": " << data.count_
+           << ", \"total_usec\": " << data.total_usec_
+           << ", \"min_usec\": " << ( data.count_ > 0 ? data.min_usec_ : 0 )
+           << ", \"max_usec\": " << data.max_usec_
+           << ", \"avg_usec\": " << ( data.count_ > 0
+                                      ? static_cast< double >( data.total_usec_ ) / data.count_
+                                      : 0.0 )
+           << ", \"p50_usec\": " << data.percentile( 0.5 )
+           << ", \"p99_usec\": " << data.percentile( 0.99 )
+           << ", \"p999_usec\": " << data.percentile( 0.999 )
+           << ", \"histogram\": [";
+
+        // sparse histogram: [bucket_index, count] pairs
+        bool first = true;
+        for ( std::size_t b = 0; b < HISTOGRAM_SIZE; ++b )
+        {
+            if ( data.histogram_[b] == 0 ) continue;
+            if ( ! first ) os << ", ";
+            os << '[' << b << ", " << data.histogram_[b] << ']';
+            first = false;
+        }
+        os << "]}";
+    }
+
+    os << "\n  }\n"
+       << "}\n";
+    return os;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ThinkTimeProfiler::writeJSON( const std::string & filepath ) const
+{
+    std::ofstream fout( filepath.c_str() );
+    if ( ! fout.is_open() )
+    {
+        return false;
+    }
+
+    writeJSON( fout );
+    fout.flush();
+    return fout.good();
+}
+
+}
@@ -0,0 +1,287 @@
+// -*-c++-*-
+
+/*!
+  \file think_time_profiler.h
+  \brief per-cycle think time profiler Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_PLAYER_THINK_TIME_PROFILER_H
+#define RCSC_PLAYER_THINK_TIME_PROFILER_H
+
+#include <chrono>
+#include <string>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+
+namespace rcsc {
+
+/*!
+  \class ThinkTimeProfiler
+  \brief records the elapsed time of each phase in the agent's cycle.
+
+  Each phase has a fixed width histogram (HISTOGRAM_RESOLUTION_USEC wide
+  buckets), so recording a sample allocates nothing. The cycle time is
+  measured from the sense_body arrival to the command send, and the cycles
+  that exceed the think budget are counted as deadline misses. The summary
+  is written as a JSON object by writeJSON().
+*/
+class ThinkTimeProfiler {
+public:
+
+    /*!
+      \enum Phase
+      \brief profiled phase types
+    */
+    enum Phase {
+        PARSE, //!< receive and parse the server messages. including UPDATE_AFTER_SEE.
+        UPDATE_AFTER_SEE, //!< WorldModel::updateAfterSee
+        UPDATE_BEFORE_DECISION, //!< WorldModel::updateJustBeforeDecision
+        ACTION_IMPL, //!< actionImpl and the reserved arm/view/neck/focus actions
+        SEND, //!< command composition and send
+        ACTION, //!< the whole PlayerAgent::action
+        CYCLE, //!< from the sense_body arrival to the command send
+        MAX_PHASE
+    };
+
+    //! width of a histogram bucket in microseconds
+    static constexpr std::int64_t HISTOGRAM_RESOLUTION_USEC = 100;
+    //! number of histogram buckets. the last bucket contains all greater values.
+    static constexpr std::size_t HISTOGRAM_SIZE = 2001;
+
+    /*!
+      \struct PhaseData
+      \brief accumulated samples of a phase
+    */
+    struct PhaseData {
+        std::uint64_t count_; //!< the number of samples
+        std::int64_t total_usec_; //!< total elapsed time
+        std::int64_t min_usec_; //!< minimum elapsed time
+        std::int64_t max_usec_; //!< maximum elapsed time
+        std::uint32_t histogram_[HISTOGRAM_SIZE]; //!< elapsed time histogram
+
+        PhaseData();
+
+        void clear();
+        void add( const std::int64_t usec );
+
+        /*!
+          \brief estimate the percentile value by the histogram
+          \param rate percentile rate [0,1]
+          \return upper bound of the bucket that contains the percentile [usec]
+        */
+        std::int64_t percentile( const double rate ) const;
+    };
+
+    /*!
+      \class Scope
+      \brief RAII helper to record a phase. does nothing if the profiler is disabled.
+    */
+    class Scope {
+    private:
+        ThinkTimeProfiler & M_profiler;
+        const Phase M_phase;
+        const bool M_active;
+        std::chrono::steady_clock::time_point M_start;
+    public:
+        Scope( ThinkTimeProfiler & profiler,
+               const Phase phase )
+            : M_profiler( profiler ),
+              M_phase( phase ),
+              M_active( profiler.isEnabled() ),
+              M_start( M_active ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point() )
+          { }
+
+        ~Scope()
+          {
+              if ( M_active )
+              {
+                  M_profiler.add( M_phase, M_start, std::chrono::steady_clock::now() );
+              }
+          }
+
+        Scope( const Scope & ) = delete;
+        Scope & operator=( const Scope & ) = delete;
+    };
+
+private:
+
+    bool M_enabled; //!< profiling switch
+    std::int64_t M_budget_usec; //!< think time budget in a cycle
+
+    PhaseData M_phases[MAX_PHASE];
+
+    std::uint64_t M_deadline_missed_count; //!< cycles whose CYCLE time exceeded the budget
+    std::uint64_t M_action_missed_count; //!< cycles skipped while parsing several messages
+
+    // not used
+    ThinkTimeProfiler( const ThinkTimeProfiler & ) = delete;
+    ThinkTimeProfiler & operator=( const ThinkTimeProfiler & ) = delete;
+
+public:
+
+    /*!
+      \brief create a disabled profiler
+    */
+    ThinkTimeProfiler();
+
+    /*!
+      \brief set the profiling switch
+      \param on switch value
+    */
+    void setEnabled( const bool on )
+      {
+          M_enabled = on;
+      }
+
+    /*!
+      \brief check if the profiler is enabled
+      \return switch value
+    */
+    bool isEnabled() const
+      {
+          return M_enabled;
+      }
+
+    /*!
+      \brief set the think time budget in a cycle
+      \param msec budget in milliseconds
+    */
+    void setBudget( const double msec )
+      {
+          M_budget_usec = static_cast< std::int64_t >( msec * 1000.0 );
+      }
+
+    /*!
+      \brief get the think time budget
+      \return budget in microseconds
+    */
+    std::int64_t budgetUSec() const
+      {
+          return M_budget_usec;
+      }
+
+    /*!
+      \brief remove all samples
+    */
+    void clear();
+
+    /*!
+      \brief record the elapsed time of a phase
+      \param phase phase type
+      \param usec elapsed time in microseconds
+    */
+    void add( const Phase phase,
+              const std::int64_t usec )
+      {
+          if ( 0 <= phase && phase < MAX_PHASE )
+          {
+              M_phases[phase].add( usec );
+          }
+      }
+
+    /*!
+      \brief record the elapsed time of a phase
+      \param phase phase type
+      \param start start time point
+      \param end end time point
+    */
+    void add( const Phase phase,
+              const std::chrono::steady_clock::time_point & start,
+              const std::chrono::steady_clock::time_point & end )
+      {
+          add( phase, std::chrono::duration_cast< std::chrono::microseconds >( end - start ).count() );
+      }
+
+    /*!
+      \brief record the whole cycle time and check the deadline
+      \param usec elapsed time from the sense_body arrival to the command send
+    */
+    void addCycle( const std::int64_t usec );
+
+    /*!
+      \brief count up the missed action detected in PlayerAgent::handleMessage
+    */
+    void addActionMissed()
+      {
+          ++M_action_missed_count;
+      }
+
+    /*!
+      \brief get the accumulated samples of a phase
+      \param phase phase type
+      \return const reference to the phase data
+    */
+    const PhaseData & phase( const Phase phase ) const
+      {
+          return M_phases[phase];
+      }
+
+    /*!
+      \brief get the number of cycles that exceeded the budget
+      \return deadline miss count
+    */
+    std::uint64_t deadlineMissedCount() const
+      {
+          return M_deadline_missed_count;
+      }
+
+    /*!
+      \brief get the number of missed actions
+      \return missed action count
+    */
+    std::uint64_t actionMissedCount() const
+      {
+          return M_action_missed_count;
+      }
+
+    /*!
+      \brief get the phase name string
+      \param phase phase type
+      \return phase name
+    */
+    static const char * phase_name( const Phase phase );
+
+    /*!
+      \brief write the summary as a JSON object
+      \param os reference to the output stream
+      \return reference to the output stream
+    */
+    std::ostream & writeJSON( std::ostream & os ) const;
+
+    /*!
+      \brief write the summary to the file
+      \param filepath output file path
+      \return true if successfully written
+    */
+    bool writeJSON( const std::string & filepath ) const;
+
+};
+
+}
+
+#endif
@@ -36,22 +36,76 @@
 #include <rcsc/geom/angle_deg.h>
 #include <rcsc/game_time.h>
 
-#include <deque>
+#include <vector>
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 
 namespace rcsc {
 
 /*!
   \class ViewArea
   \brief player's view area.
+
+  The unit vectors of the view direction and the both cone edges are
+  computed at the construction, so that the containment test by
+  contains( point, DirThreshold, visible_dist2 ) needs no trigonometric call.
  */
 class ViewArea {
+public:
+
+    /*!
+      \struct DirThreshold
+      \brief precomputed rotation of the angle threshold value.
+      The same instance can be used for all view areas.
+     */
+    struct DirThreshold {
+        double value_; //!< threshold value (degree)
+        double cos_; //!< cosine of the threshold
+        double sin_; //!< sine of the threshold
+
+        /*!
+          \brief compute the rotation values
+          \param dir_thr angle threshold value (degree)
+         */
+        explicit
+        DirThreshold( const double dir_thr )
+            : value_( dir_thr ),
+              cos_( std::cos( dir_thr * AngleDeg::DEG2RAD ) ),
+              sin_( std::sin( dir_thr * AngleDeg::DEG2RAD ) )
+          { }
+    };
+
 private:
     double M_view_width; //!< the width of player's view area when see message is received.
     Vector2D M_origin; //!< estimated player's global position when see message is received.
     AngleDeg M_angle; //!< estimated player's head direction when see message is received.
     GameTime M_time; //!< the see message arrived time
 
+    double M_dir_x; //!< unit vector of the view direction
+    double M_dir_y; //!< unit vector of the view direction
+    double M_left_x; //!< unit vector of the left edge (angle + width/2)
+    double M_left_y; //!< unit vector of the left edge (angle + width/2)
+    double M_right_x; //!< unit vector of the right edge (angle - width/2)
+    double M_right_y; //!< unit vector of the right edge (angle - width/2)
+
+    /*!
+      \brief compute the unit vectors of the direction and the edges
+     */
+    void setEdges()
+      {
+          M_dir_x = M_angle.cos();
+          M_dir_y = M_angle.sin();
+
+          const double half = std::max( 0.0, M_view_width ) * 0.5 * AngleDeg::DEG2RAD;
+          const double c = std::cos( half );
+          const double s = std::sin( half );
+          M_left_x = M_dir_x * c - M_dir_y * s;
+          M_left_y = M_dir_x * s + M_dir_y * c;
+          M_right_x = M_dir_x * c + M_dir_y * s;
+          M_right_y = - M_dir_x * s + M_dir_y * c;
+      }
+
 public:
 
     /*!
@@ -62,7 +116,9 @@ public:
         , M_origin( Vector2D::INVALIDATED )
         , M_angle()
         , M_time( -1, 0 )
-      { }
+      {
+          setEdges();
+      }
 
     /*!
       \brief construct invalid object
@@ -74,7 +130,9 @@ public:
         , M_origin( Vector2D::INVALIDATED )
         , M_angle()
         , M_time( t )
-      { }
+      {
+          setEdges();
+      }
 
 
     /*!
@@ -92,7 +150,9 @@ public:
         , M_origin( origin )
         , M_angle( angle )
         , M_time( t )
-      { }
+      {
+          setEdges();
+      }
 
     /*!
       \brief get the width of view area
@@ -166,10 +226,237 @@ public:
 
           return ( rpos.th() - M_angle ).abs() < M_view_width*0.5 - dir_thr;
       }
+
+    /*!
+      \brief check if point is contained by this view area or not.
+      The result is same as contains( point, dir_thr, visible_dist2 ) except for
+      the rounding error on the border. The direction is tested by the cross
+      products with the cone edges rotated by the threshold.
+      \param point checked point
+      \param dir_thr precomputed angle threshold
+      \param visible_dist2 squared visible distance value
+     */
+    bool contains( const Vector2D & point,
+                   const DirThreshold & dir_thr,
+                   const double visible_dist2 ) const
+      {
+          if ( ! isValid() )
+          {
+              return false;
+          }
+
+          const double rx = point.x - M_origin.x;
+          const double ry = point.y - M_origin.y;
+          if ( rx * rx + ry * ry < visible_dist2 )
+          {
+              return true;
+          }
+
+          const double half_width = M_view_width*0.5 - dir_thr.value_;
+          if ( half_width <= 0.0 ) return false;
+          if ( half_width > 180.0 ) return true;
+
+          // the edges are rotated inward by the threshold.
+          const double lx = M_left_x * dir_thr.cos_ + M_left_y * dir_thr.sin_;
+          const double ly = - M_left_x * dir_thr.sin_ + M_left_y * dir_thr.cos_;
+          const double rgx = M_right_x * dir_thr.cos_ - M_right_y * dir_thr.sin_;
+          const double rgy = M_right_x * dir_thr.sin_ + M_right_y * dir_thr.cos_;
+
+          const bool inside_right = ( rgx * ry - rgy * rx > 0.0 );
+          const bool inside_left = ( lx * ry - ly * rx < 0.0 );
+
+          return ( half_width <= 90.0
+                   ? inside_right && inside_left
+                   : inside_right || inside_left );
+      }
+
+    /*!
+      \brief check if each point is contained by this view area or not.
+      The result is same as contains() except for the rounding error on the
+      border, but the direction is tested by the dot product with the view
+      direction, so no atan2 is called in the loop.
+      \param points checked points
+      \param size the number of points
+      \param dir_thr angle threshold value
+      \param visible_dist2 squared visible distance value
+      \param result result array. result[i] is set to 1 if points[i] is contained, otherwise 0.
+     */
+    void contains( const Vector2D * points,
+                   const std::size_t size,
+                   const double & dir_thr,
+                   const double & visible_dist2,
+                   unsigned char * result ) const
+      {
+          if ( ! isValid() )
+          {
+              std::fill( result, result + size, 0 );
+              return;
+          }
+
+          const double half_width = M_view_width*0.5 - dir_thr;
+          const double dir_x = M_dir_x;
+          const double dir_y = M_dir_y;
+
+          // angle < half_width  <=>  dot > |rpos| * cos(half_width).
+          // both sides are multiplied by their absolute values to avoid sqrt.
+          const double cos_half = std::cos( std::min( half_width, 180.0 ) * AngleDeg::DEG2RAD );
+          const double cos_half_signed2 = cos_half * std::fabs( cos_half );
+          const bool all_dirs = ( half_width > 180.0 );
+          const bool no_dir = ( half_width <= 0.0 );
+
+          for ( std::size_t i = 0; i < size; ++i )
+          {
+              const double rx = points[i].x - M_origin.x;
+              const double ry = points[i].y - M_origin.y;
+              const double r2 = rx * rx + ry * ry;
+              const double dot = rx * dir_x + ry * dir_y;
+
+              const bool in_dir = ( all_dirs
+                                    || ( ! no_dir
+                                         && dot * std::fabs( dot ) > cos_half_signed2 * r2 ) );
+              result[i] = ( r2 < visible_dist2 || in_dir ) ? 1 : 0;
+          }
+      }
 };
 
-//! typedef of the ViewArea container
-typedef std::deque< ViewArea > ViewAreaCont;
+/*!
+  \class ViewAreaCont
+  \brief fixed capacity ring buffer of the view areas.
+
+  WorldModel pushes one entry in every time update and overwrites the
+  newest entry when the see message arrives. The index 0 is the newest
+  entry, and the index is the number of updates since that entry.
+  The entry of the given game time is found in O(1) through the table of
+  the first update in each cycle.
+ */
+class ViewAreaCont {
+private:
+
+    /*!
+      \struct CycleIndex
+      \brief the first update number in the cycle
+     */
+    struct CycleIndex {
+        long cycle_; //!< game cycle
+        long seq_; //!< the update number of the (cycle, 0) time
+    };
+
+    std::vector< ViewArea > M_areas; //!< ring buffer
+    std::vector< CycleIndex > M_cycles; //!< indexed by cycle % capacity
+    std::size_t M_head; //!< index of the newest entry in M_areas
+    long M_seq; //!< update number of the newest entry
+
+public:
+
+    /*!
+      \brief create the buffer filled with invalid areas
+      \param capacity the number of entries
+     */
+    explicit
+    ViewAreaCont( const std::size_t capacity )
+        : M_areas( std::max( capacity, std::size_t( 1 ) ) ),
+          M_cycles( M_areas.size(), CycleIndex{ -1, 0 } ),
+          M_head( 0 ),
+          M_seq( 0 )
+      { }
+
+    /*!
+      \brief add the new entry as the newest one. the oldest entry is removed.
+      \param area new entry
+     */
+    void push( const ViewArea & area )
+      {
+          M_head = ( M_head + 1 ) % M_areas.size();
+          ++M_seq;
+          M_areas[M_head] = area;
+
+          const long cycle = area.time().cycle();
+          if ( cycle >= 0 )
+          {
+              CycleIndex & index = M_cycles[cycle % M_cycles.size()];
+              if ( index.cycle_ != cycle )
+              {
+                  index.cycle_ = cycle;
+                  index.seq_ = M_seq - area.time().stopped();
+              }
+          }
+      }
+
+    /*!
+      \brief get the number of entries
+      \return capacity of the buffer
+     */
+    std::size_t size() const
+      {
+          return M_areas.size();
+      }
+
+    /*!
+      \brief get the newest entry
+      \return reference to the newest entry
+     */
+    ViewArea & front()
+      {
+          return M_areas[M_head];
+      }
+
+    /*!
+      \brief get the newest entry
+      \return const reference to the newest entry
+     */
+    const ViewArea & front() const
+      {
+          return M_areas[M_head];
+      }
+
+    /*!
+      \brief get the entry by the age
+      \param age the number of updates since the entry. must be less than size().
+      \return const reference to the entry
+     */
+    const ViewArea & operator[]( const std::size_t age ) const
+      {
+          return M_areas[( M_head + M_areas.size() - age ) % M_areas.size()];
+      }
+
+    /*!
+      \brief get the entry of the given game time
+      \param t game time
+      \return const pointer to the entry. if not found, NULL.
+     */
+    const ViewArea * find( const GameTime & t ) const
+      {
+          if ( t.cycle() < 0 )
+          {
+              return nullptr;
+          }
+
+          const CycleIndex & index = M_cycles[t.cycle() % M_cycles.size()];
+          if ( index.cycle_ == t.cycle() )
+          {
+              const long age = M_seq - ( index.seq_ + t.stopped() );
+              if ( 0 <= age
+                   && age < static_cast< long >( M_areas.size() ) )
+              {
+                  const ViewArea & area = (*this)[age];
+                  if ( area.time() == t )
+                  {
+                      return &area;
+                  }
+              }
+          }
+
+          // some updates were skipped. search all entries.
+          for ( std::size_t i = 0; i < M_areas.size(); ++i )
+          {
+              if ( M_areas[i].time() == t )
+              {
+                  return &M_areas[i];
+              }
+          }
+          return nullptr;
+      }
+};
 
 }
 
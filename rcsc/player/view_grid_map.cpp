@@ -44,8 +44,11 @@
 
 
 #include <vector>
+#include <limits>
+#include <algorithm>
 #include <iostream>
 #include <cstring>
+#include <cassert>
 #include <cmath>
 
 #define DEBUG_PROFILE
@@ -53,6 +56,9 @@
 
 namespace rcsc {
 
+constexpr int ViewGridMap::MAX_GRID_SIZE;
+constexpr int ViewGridMap::MAX_SEEN_COUNT;
+
 const double ViewGridMap::GRID_LENGTH = 1.0;
 
 const double ViewGridMap::PITCH_MAX_X = ( std::ceil( ( +ServerParam::DEFAULT_PITCH_LENGTH*0.5 - 3.0 ) / ViewGridMap::GRID_LENGTH )
@@ -112,37 +118,141 @@ grid_center( const int ix,
                      iy * ViewGridMap::GRID_LENGTH - ViewGridMap::PITCH_MAX_Y );
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+  \brief clip the dy range by the half plane a * dy > b.
+ */
 inline
-Vector2D
-grid_center( const int idx )
+void
+clip_range( const double a,
+            const double b,
+            double * lo,
+            double * hi )
 {
-    return grid_center( idx / ViewGridMap::GRID_Y_SIZE,
-                        idx % ViewGridMap::GRID_Y_SIZE );
-}
-
+    if ( a > 0.0 )
+    {
+        *lo = std::max( *lo, b / a );
+    }
+    else if ( a < 0.0 )
+    {
+        *hi = std::min( *hi, b / a );
+    }
+    else if ( b >= 0.0 )
+    {
+        *hi = -std::numeric_limits< double >::max();
+    }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+  \brief convert the open dy range ( lo, hi ) to the closed y index range.
+ */
+inline
+void
+to_index_range( const double oy,
+                const double lo,
+                const double hi,
+                int * first,
+                int * last )
+{
+    const double max_index = ViewGridMap::GRID_Y_SIZE + 1.0;
+    const double u = bound( -1.0, ( lo + oy + ViewGridMap::PITCH_MAX_Y ) / ViewGridMap::GRID_LENGTH, max_index );
+    const double w = bound( -1.0, ( hi + oy + ViewGridMap::PITCH_MAX_Y ) / ViewGridMap::GRID_LENGTH, max_index );
 
-///////////////////////////////////////////////////////////////////////
+    *first = std::max( 0, static_cast< int >( std::floor( u ) ) + 1 );
+    *last = std::min( ViewGridMap::GRID_Y_SIZE - 1, static_cast< int >( std::ceil( w ) ) - 1 );
+}
 
 /*-------------------------------------------------------------------*/
 /*!
+  \brief call func( first_idx, last_idx ) for each contiguous range of
+  grid cells that are regarded as seen by the view area.
 
-*/
-ViewGridMap::ViewGridMap()
+  A grid cell is seen if its center is within the visible distance or
+  strictly between the two edges of the view cone.
+  The cone is the intersection of two half planes, so the seen cells in
+  each grid column are at most two ranges of y indices.
+ */
+template < typename Func >
+void
+for_each_seen_range( const ViewArea & view_area,
+                     Func func )
 {
-    M_grid_map.reserve( GRID_X_SIZE * GRID_Y_SIZE );
+    const double visible_dist = ServerParam::i().visibleDistance() - 0.5;
+    const double visible_dist2 = visible_dist * visible_dist;
+
+    const Vector2D left = Vector2D::from_polar( 1.0, view_area.angle() - view_area.viewWidth() * 0.5 + 2.0 );
+    const Vector2D right = Vector2D::from_polar( 1.0, view_area.angle() + view_area.viewWidth() * 0.5 - 2.0 );
+
+    const double ox = view_area.origin().x;
+    const double oy = view_area.origin().y;
 
-    for ( int x = 0; x < GRID_X_SIZE; ++x )
+    for ( int ix = 0; ix < ViewGridMap::GRID_X_SIZE; ++ix )
     {
-        for ( int y = 0; y < GRID_Y_SIZE; ++y )
+        const int offset = ix * ViewGridMap::GRID_Y_SIZE;
+        const double dx = ix * ViewGridMap::GRID_LENGTH - ViewGridMap::PITCH_MAX_X - ox;
+
+        // view cone: cross( left, v ) > 0 && cross( v, right ) > 0
+        double lo = -std::numeric_limits< double >::max();
+        double hi = +std::numeric_limits< double >::max();
+        clip_range( left.x, left.y * dx, &lo, &hi );
+        clip_range( -right.x, -right.y * dx, &lo, &hi );
+
+        int cone_first = 0, cone_last = -1;
+        if ( lo < hi )
+        {
+            to_index_range( oy, lo, hi, &cone_first, &cone_last );
+        }
+
+        // visible distance
+        int near_first = 0, near_last = -1;
+        if ( dx * dx < visible_dist2 )
+        {
+            const double s = std::sqrt( visible_dist2 - dx * dx );
+            to_index_range( oy, -s, s, &near_first, &near_last );
+        }
+
+        if ( cone_first > cone_last )
+        {
+            if ( near_first <= near_last )
+            {
+                func( offset + near_first, offset + near_last );
+            }
+        }
+        else if ( near_first > near_last )
+        {
+            func( offset + cone_first, offset + cone_last );
+        }
+        else if ( near_first <= cone_last + 1
+                  && cone_first <= near_last + 1 )
+        {
+            func( offset + std::min( cone_first, near_first ),
+                  offset + std::max( cone_last, near_last ) );
+        }
+        else
         {
-            M_grid_map.emplace_back( grid_center( x, y ) );
+            func( offset + cone_first, offset + cone_last );
+            func( offset + near_first, offset + near_last );
         }
     }
+}
 
 }
 
+///////////////////////////////////////////////////////////////////////
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+ViewGridMap::ViewGridMap()
+    : M_update_time( 0, 0 )
+{
+    assert( size() <= MAX_GRID_SIZE );
+
+    std::memset( M_seen_count, 0, sizeof( M_seen_count ) );
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -155,13 +265,26 @@ ViewGridMap::~ViewGridMap()
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+Vector2D
+ViewGridMap::gridCenter( const int idx )
+{
+    return grid_center( idx / GRID_Y_SIZE,
+                        idx % GRID_Y_SIZE );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 ViewGridMap::incrementAll()
 {
-    for ( Grid & p : M_grid_map )
+    // branch free saturated increment over the whole array.
+    // the unused tail is also incremented so that the loop length is fixed.
+    for ( int i = 0; i < MAX_GRID_SIZE; ++i )
     {
-        p.seen_count_ += 1;
+        M_seen_count[i] += ( M_seen_count[i] != MAX_SEEN_COUNT );
     }
 }
 
@@ -173,13 +296,11 @@ void
 ViewGridMap::update( const GameTime & time,
                      const ViewArea & view_area )
 {
-    static GameTime s_update_time( 0, 0 );
-
-    if ( s_update_time == time )
+    if ( M_update_time == time )
     {
         return;
     }
-    s_update_time = time;
+    M_update_time = time;
 
 
 #ifdef DEBUG_PROFILE
@@ -191,35 +312,17 @@ ViewGridMap::update( const GameTime & time,
         return;
     }
 
-    const AngleDeg left_angle = view_area.angle() - view_area.viewWidth() * 0.5 + 2.0;
-    const AngleDeg right_angle = view_area.angle() + view_area.viewWidth() * 0.5 - 2.0;
-
-    static const double VISIBLE_DIST = ServerParam::i().visibleDistance() - 0.5;
-
-    for ( Grid & p : M_grid_map )
-    {
-        const double dist = view_area.origin().dist( p.center_ );
-        if ( dist < VISIBLE_DIST )
-        {
-            p.seen_count_ = 0;
-        }
-        else
-        {
-            const AngleDeg angle = ( p.center_ - view_area.origin() ).th();
-            if ( angle.isRightOf( left_angle )
-                 && angle.isLeftOf( right_angle ) )
-            {
-                p.seen_count_ = 0;
-            }
-        }
-
-    }
+    for_each_seen_range( view_area,
+                         [this]( const int first, const int last )
+                           {
+                               std::memset( M_seen_count + first, 0, last - first + 1 );
+                           } );
 
 #ifdef DEBUG_PROFILE
     dlog.addText( Logger::WORLD,
                   __FILE__" (update) PROFILE elapsed %f [ms] grid_size=%d",
                   timer.elapsedReal(),
-                  M_grid_map.size() );
+                  size() );
 #endif
 }
 
@@ -230,16 +333,47 @@ ViewGridMap::update( const GameTime & time,
 int
 ViewGridMap::seenCount( const Vector2D & pos ) const
 {
-    try
+    return M_seen_count[grid_index( pos )];
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+ViewGridMap::score( const ViewArea & view_area ) const
+{
+    if ( ! view_area.isValid() )
     {
-        return M_grid_map.at( grid_index( pos ) ).seen_count_;
+        return 0;
     }
-    catch ( std::exception & e )
+
+    int sum = 0;
+    for_each_seen_range( view_area,
+                         [this, &sum]( const int first, const int last )
+                           {
+                               for ( int i = first; i <= last; ++i )
+                               {
+                                   sum += M_seen_count[i];
+                               }
+                           } );
+    return sum;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+ViewGridMap::score( const std::vector< ViewArea > & view_areas,
+                    std::vector< int > * scores ) const
+{
+    scores->clear();
+    scores->reserve( view_areas.size() );
+
+    for ( const ViewArea & v : view_areas )
     {
-        std::cerr << __FILE__ ": out of the grid range " << pos
-                  << " " << e.what()
-                  << std::endl;
-        return 1000;
+        scores->push_back( score( v ) );
     }
 }
 
@@ -247,11 +381,13 @@ ViewGridMap::seenCount( const Vector2D & pos ) const
 void
 ViewGridMap::debugOutput() const
 {
-    for ( const Grid & p : M_grid_map )
+    const int grid_size = size();
+    for ( int i = 0; i < grid_size; ++i )
     {
-        const int col = std::max( 0, 255 - p.seen_count_ * 20 );
+        const Vector2D center = gridCenter( i );
+        const int col = std::max( 0, 255 - M_seen_count[i] * 20 );
         dlog.addRect( Logger::WORLD,
-                      p.center_.x - GRID_LENGTH*0.05, p.center_.y - GRID_LENGTH*0.05,
+                      center.x - GRID_LENGTH*0.05, center.y - GRID_LENGTH*0.05,
                       GRID_LENGTH*0.1, GRID_LENGTH*0.1,
                       col, col, col,
                       true );
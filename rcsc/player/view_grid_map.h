@@ -33,38 +33,40 @@
 #define RCSC_PLAYER_VIEW_GRID_MAP_H
 
 #include <rcsc/geom/vector_2d.h>
+#include <rcsc/game_time.h>
 
 #include <vector>
-#include <utility>
+#include <cstdint>
 
 namespace rcsc {
 
-class GameTime;
 class ViewArea;
 
 /*!
   \class ViewGridMap
   \brief grid map that stores field accuracy information
+
+  Each grid cell has an 8 bit counter saturated at 255.
+  The counters are stored in a cache line aligned array ordered by
+  ( x index, y index ), so each grid column is a contiguous byte range.
+  The view area is rasterized into y index ranges for each column,
+  so the update and the evaluation of candidate view areas do not need
+  any trigonometric function for each grid cell.
  */
 class ViewGridMap {
 public:
 
-    struct Grid {
-        const rcsc::Vector2D center_;
-        int seen_count_;
-
-        Grid() = delete;
+    //! capacity of the counter array. it must not be less than GRID_X_SIZE * GRID_Y_SIZE.
+    static constexpr int MAX_GRID_SIZE = 128 * 64;
 
-        explicit
-        Grid( const rcsc::Vector2D & center )
-            : center_( center ),
-              seen_count_( 0 )
-        { }
-    };
+    //! saturated value of the counter
+    static constexpr int MAX_SEEN_COUNT = 255;
 
 private:
 
-    std::vector< Grid > M_grid_map;
+    GameTime M_update_time; //!< last updated time
+
+    alignas( 64 ) std::uint8_t M_seen_count[MAX_GRID_SIZE]; //!< counters since the last observation
 
 public:
 
@@ -93,7 +95,7 @@ public:
     ~ViewGridMap();
 
     /*!
-      \brief simply increment all grid values.
+      \brief simply increment all grid values. each value is saturated at MAX_SEEN_COUNT.
      */
     void incrementAll();
 
@@ -103,9 +105,31 @@ public:
     void update( const GameTime & time,
                  const ViewArea & view_area );
 
-    const std::vector< Grid > & gridMap() const
+    /*!
+      \brief get the number of grid cells
+      \return GRID_X_SIZE * GRID_Y_SIZE
+     */
+    static
+    int size()
     {
-        return M_grid_map;
+        return GRID_X_SIZE * GRID_Y_SIZE;
+    }
+
+    /*!
+      \brief get the center point of the grid cell
+      \param idx index of the grid cell ( x index * GRID_Y_SIZE + y index )
+      \return center point
+     */
+    static
+    Vector2D gridCenter( const int idx );
+
+    /*!
+      \brief get the counter array
+      \return const pointer to the array of size() values
+     */
+    const std::uint8_t * seenCounts() const
+    {
+        return M_seen_count;
     }
 
     /*!
@@ -115,6 +139,21 @@ public:
      */
     int seenCount( const Vector2D & pos ) const;
 
+    /*!
+      \brief get the sum of counters in the view area.
+      \param view_area candidate view area
+      \return sum of counters that will be cleared by the view area
+     */
+    int score( const ViewArea & view_area ) const;
+
+    /*!
+      \brief evaluate several candidate view areas at once
+      \param view_areas candidate view areas
+      \param scores pointer to the result container. the order is same as view_areas.
+     */
+    void score( const std::vector< ViewArea > & view_areas,
+                std::vector< int > * scores ) const;
+
     /*!
       \brief output the debug data
      */
@@ -37,9 +37,11 @@
 
 #include <rcsc/common/logger.h>
 
+#include <array>
 #include <iterator>
 #include <algorithm>
 #include <limits> // std::numeric_limits
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <cmath> // HUGE_VAL
@@ -161,6 +163,172 @@ operator<<( std::ostream & os,
 const double VisualSensor::DIST_ERR = std::numeric_limits< double >::max();
 const double VisualSensor::DIR_ERR = -360;
 
+/*-------------------------------------------------------------------*/
+
+namespace {
+
+/*!
+  \struct MarkerName
+  \brief marker name and id pair
+*/
+struct MarkerName {
+    const char * name_; //!< short marker name used by rcssserver v6 or later
+    MarkerID id_; //!< marker id
+};
+
+//! all marker names. "flag"/"goal" of the old protocol are normalized to "f"/"g".
+constexpr MarkerName g_marker_names[] = {
+    { "g l", Goal_L }, { "g r", Goal_R },
+
+    { "f c", Flag_C },
+    { "f c t", Flag_CT }, { "f c b", Flag_CB },
+    { "f l t", Flag_LT }, { "f l b", Flag_LB },
+    { "f r t", Flag_RT }, { "f r b", Flag_RB },
+
+    { "f p l t", Flag_PLT }, { "f p l c", Flag_PLC }, { "f p l b", Flag_PLB },
+    { "f p r t", Flag_PRT }, { "f p r c", Flag_PRC }, { "f p r b", Flag_PRB },
+
+    { "f g l t", Flag_GLT }, { "f g l b", Flag_GLB },
+    { "f g r t", Flag_GRT }, { "f g r b", Flag_GRB },
+
+    { "f t l 50", Flag_TL50 }, { "f t l 40", Flag_TL40 }, { "f t l 30", Flag_TL30 },
+    { "f t l 20", Flag_TL20 }, { "f t l 10", Flag_TL10 },
+    { "f t 0", Flag_T0 },
+    { "f t r 10", Flag_TR10 }, { "f t r 20", Flag_TR20 }, { "f t r 30", Flag_TR30 },
+    { "f t r 40", Flag_TR40 }, { "f t r 50", Flag_TR50 },
+
+    { "f b l 50", Flag_BL50 }, { "f b l 40", Flag_BL40 }, { "f b l 30", Flag_BL30 },
+    { "f b l 20", Flag_BL20 }, { "f b l 10", Flag_BL10 },
+    { "f b 0", Flag_B0 },
+    { "f b r 10", Flag_BR10 }, { "f b r 20", Flag_BR20 }, { "f b r 30", Flag_BR30 },
+    { "f b r 40", Flag_BR40 }, { "f b r 50", Flag_BR50 },
+
+    { "f l t 30", Flag_LT30 }, { "f l t 20", Flag_LT20 }, { "f l t 10", Flag_LT10 },
+    { "f l 0", Flag_L0 },
+    { "f l b 10", Flag_LB10 }, { "f l b 20", Flag_LB20 }, { "f l b 30", Flag_LB30 },
+
+    { "f r t 30", Flag_RT30 }, { "f r t 20", Flag_RT20 }, { "f r t 10", Flag_RT10 },
+    { "f r 0", Flag_R0 },
+    { "f r b 10", Flag_RB10 }, { "f r b 20", Flag_RB20 }, { "f r b 30", Flag_RB30 },
+};
+
+static_assert( sizeof( g_marker_names ) / sizeof( MarkerName ) == Marker_Unknown,
+               "all markers must be registered." );
+
+/*!
+  \brief pack the marker name characters into an integer key.
+  \param name marker name
+  \param key initial key value
+  \return packed key. 0 if the name is too long.
+
+  Every short marker name has 8 characters at most, so this mapping is injective.
+*/
+constexpr
+std::uint64_t
+marker_key( const std::string_view & name,
+            std::uint64_t key = 0 )
+{
+    if ( name.size() > 8 )
+    {
+        return 0;
+    }
+
+    for ( const char c : name )
+    {
+        if ( key >> 56 )
+        {
+            return 0;
+        }
+        key = ( key << 8 ) | static_cast< unsigned char >( c );
+    }
+    return key;
+}
+
+constexpr std::size_t MARKER_TABLE_SIZE = 128; //!< must be the power of 2
+
+/*!
+  \brief get the slot index of the marker key
+*/
+constexpr
+std::size_t
+marker_slot( const std::uint64_t key )
+{
+    return static_cast< std::size_t >( ( key * 0x9E3779B97F4A7C15ull ) >> 57 ) & ( MARKER_TABLE_SIZE - 1 );
+}
+
+/*!
+  \struct MarkerSlot
+  \brief open addressing hash table entry
+*/
+struct MarkerSlot {
+    std::uint64_t key_; //!< packed marker name. 0 means an empty slot.
+    MarkerID id_; //!< marker id
+};
+
+typedef std::array< MarkerSlot, MARKER_TABLE_SIZE > MarkerTable;
+
+/*!
+  \brief create the marker hash table at compile time
+*/
+constexpr
+MarkerTable
+create_marker_table()
+{
+    MarkerTable table{};
+    for ( MarkerSlot & slot : table )
+    {
+        slot.key_ = 0;
+        slot.id_ = Marker_Unknown;
+    }
+
+    for ( const MarkerName & m : g_marker_names )
+    {
+        const std::uint64_t key = marker_key( m.name_ );
+        std::size_t i = marker_slot( key );
+        while ( table[i].key_ != 0 )
+        {
+            i = ( i + 1 ) & ( MARKER_TABLE_SIZE - 1 );
+        }
+        table[i].key_ = key;
+        table[i].id_ = m.id_;
+    }
+
+    return table;
+}
+
+constexpr MarkerTable g_marker_table = create_marker_table();
+
+/*!
+  \brief stable sort by the seen distance without any memory allocation.
+  \param v reference to the container
+
+  The number of seen objects is small, so the insertion sort is enough.
+*/
+template < typename Cont >
+void
+sort_by_seen_dist( Cont & v )
+{
+    const SeenDistCmp cmp;
+    for ( std::size_t i = 1; i < v.size(); ++i )
+    {
+        if ( ! cmp( v[i], v[i-1] ) )
+        {
+            continue;
+        }
+
+        typename Cont::value_type tmp = v[i];
+        std::size_t j = i;
+        while ( j > 0 && cmp( tmp, v[j-1] ) )
+        {
+            v[j] = v[j-1];
+            --j;
+        }
+        v[j] = tmp;
+    }
+}
+
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -169,138 +337,54 @@ VisualSensor::VisualSensor()
     : M_time( -1, 0 ),
       M_their_team_name( "" )
 {
-    using namespace rcsc;
-    typedef std::pair< std::string, MarkerID > MarkerPair;
-
-    M_marker_map.insert( MarkerPair( "g l", Goal_L ) );
-    M_marker_map.insert( MarkerPair( "g r", Goal_R ) );
-
-    M_marker_map.insert( MarkerPair( "f c", Flag_C ) );
-    M_marker_map.insert( MarkerPair( "f c t", Flag_CT ) );
-    M_marker_map.insert( MarkerPair( "f c b", Flag_CB ) );
-    M_marker_map.insert( MarkerPair( "f l t", Flag_LT ) );
-    M_marker_map.insert( MarkerPair( "f l b", Flag_LB ) );
-    M_marker_map.insert( MarkerPair( "f r t", Flag_RT ) );
-    M_marker_map.insert( MarkerPair( "f r b", Flag_RB ) );
-
-    M_marker_map.insert( MarkerPair( "f p l t", Flag_PLT ) );
-    M_marker_map.insert( MarkerPair( "f p l c", Flag_PLC ) );
-    M_marker_map.insert( MarkerPair( "f p l b", Flag_PLB ) );
-    M_marker_map.insert( MarkerPair( "f p r t", Flag_PRT ) );
-    M_marker_map.insert( MarkerPair( "f p r c", Flag_PRC ) );
-    M_marker_map.insert( MarkerPair( "f p r b", Flag_PRB ) );
-
-    M_marker_map.insert( MarkerPair( "f g l t", Flag_GLT ) );
-    M_marker_map.insert( MarkerPair( "f g l b", Flag_GLB ) );
-    M_marker_map.insert( MarkerPair( "f g r t", Flag_GRT ) );
-    M_marker_map.insert( MarkerPair( "f g r b", Flag_GRB ) );
-
-    M_marker_map.insert( MarkerPair( "f t l 50", Flag_TL50 ) );
-    M_marker_map.insert( MarkerPair( "f t l 40", Flag_TL40 ) );
-    M_marker_map.insert( MarkerPair( "f t l 30", Flag_TL30 ) );
-    M_marker_map.insert( MarkerPair( "f t l 20", Flag_TL20 ) );
-    M_marker_map.insert( MarkerPair( "f t l 10", Flag_TL10 ) );
-    M_marker_map.insert( MarkerPair( "f t 0", Flag_T0 ) );
-    M_marker_map.insert( MarkerPair( "f t r 10", Flag_TR10 ) );
-    M_marker_map.insert( MarkerPair( "f t r 20", Flag_TR20 ) );
-    M_marker_map.insert( MarkerPair( "f t r 30", Flag_TR30 ) );
-    M_marker_map.insert( MarkerPair( "f t r 40", Flag_TR40 ) );
-    M_marker_map.insert( MarkerPair( "f t r 50", Flag_TR50 ) );
-
-    M_marker_map.insert( MarkerPair( "f b l 50", Flag_BL50 ) );
-    M_marker_map.insert( MarkerPair( "f b l 40", Flag_BL40 ) );
-    M_marker_map.insert( MarkerPair( "f b l 30", Flag_BL30 ) );
-    M_marker_map.insert( MarkerPair( "f b l 20", Flag_BL20 ) );
-    M_marker_map.insert( MarkerPair( "f b l 10", Flag_BL10 ) );
-    M_marker_map.insert( MarkerPair( "f b 0", Flag_B0 ) );
-    M_marker_map.insert( MarkerPair( "f b r 10", Flag_BR10 ) );
-    M_marker_map.insert( MarkerPair( "f b r 20", Flag_BR20 ) );
-    M_marker_map.insert( MarkerPair( "f b r 30", Flag_BR30 ) );
-    M_marker_map.insert( MarkerPair( "f b r 40", Flag_BR40 ) );
-    M_marker_map.insert( MarkerPair( "f b r 50", Flag_BR50 ) );
-
-    M_marker_map.insert( MarkerPair( "f l t 30", Flag_LT30 ) );
-    M_marker_map.insert( MarkerPair( "f l t 20", Flag_LT20 ) );
-    M_marker_map.insert( MarkerPair( "f l t 10", Flag_LT10 ) );
-    M_marker_map.insert( MarkerPair( "f l 0", Flag_L0 ) );
-    M_marker_map.insert( MarkerPair( "f l b 10", Flag_LB10 ) );
-    M_marker_map.insert( MarkerPair( "f l b 20", Flag_LB20 ) );
-    M_marker_map.insert( MarkerPair( "f l b 30", Flag_LB30 ) );
-
-    M_marker_map.insert( MarkerPair( "f r t 30", Flag_RT30 ) );
-    M_marker_map.insert( MarkerPair( "f r t 20", Flag_RT20 ) );
-    M_marker_map.insert( MarkerPair( "f r t 10", Flag_RT10 ) );
-    M_marker_map.insert( MarkerPair( "f r 0", Flag_R0 ) );
-    M_marker_map.insert( MarkerPair( "f r b 10", Flag_RB10 ) );
-    M_marker_map.insert( MarkerPair( "f r b 20", Flag_RB20 ) );
-    M_marker_map.insert( MarkerPair( "f r b 30", Flag_RB30 ) );
-
-    ///////////////////////////////////////////////////////////////////////
-    ///////////////////////////////////////////////////////////////////////
-    ///////////////////////////////////////////////////////////////////////
-
-    M_marker_map_old.insert( MarkerPair( "goal l", Goal_L ) );
-    M_marker_map_old.insert( MarkerPair( "goal r", Goal_R ) );
-
-    M_marker_map_old.insert( MarkerPair( "flag c", Flag_C ) );
-    M_marker_map_old.insert( MarkerPair( "flag c t", Flag_CT ) );
-    M_marker_map_old.insert( MarkerPair( "flag c b", Flag_CB ) );
-    M_marker_map_old.insert( MarkerPair( "flag l t", Flag_LT ) );
-    M_marker_map_old.insert( MarkerPair( "flag l b", Flag_LB ) );
-    M_marker_map_old.insert( MarkerPair( "flag r t", Flag_RT ) );
-    M_marker_map_old.insert( MarkerPair( "flag r b", Flag_RB ) );
-
-    M_marker_map_old.insert( MarkerPair( "flag p l t", Flag_PLT ) );
-    M_marker_map_old.insert( MarkerPair( "flag p l c", Flag_PLC ) );
-    M_marker_map_old.insert( MarkerPair( "flag p l b", Flag_PLB ) );
-    M_marker_map_old.insert( MarkerPair( "flag p r t", Flag_PRT ) );
-    M_marker_map_old.insert( MarkerPair( "flag p r c", Flag_PRC ) );
-    M_marker_map_old.insert( MarkerPair( "flag p r b", Flag_PRB ) );
-
-    M_marker_map_old.insert( MarkerPair( "flag g l t", Flag_GLT ) );
-    M_marker_map_old.insert( MarkerPair( "flag g l b", Flag_GLB ) );
-    M_marker_map_old.insert( MarkerPair( "flag g r t", Flag_GRT ) );
-    M_marker_map_old.insert( MarkerPair( "flag g r b", Flag_GRB ) );
-
-    M_marker_map_old.insert( MarkerPair( "flag t l 50", Flag_TL50 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t l 40", Flag_TL40 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t l 30", Flag_TL30 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t l 20", Flag_TL20 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t l 10", Flag_TL10 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t 0", Flag_T0 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t r 10", Flag_TR10 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t r 20", Flag_TR20 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t r 30", Flag_TR30 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t r 40", Flag_TR40 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t r 50", Flag_TR50 ) );
-
-    M_marker_map_old.insert( MarkerPair( "flag b l 50", Flag_BL50 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b l 40", Flag_BL40 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b l 30", Flag_BL30 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b l 20", Flag_BL20 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b l 10", Flag_BL10 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b 0", Flag_B0 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b r 10", Flag_BR10 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b r 20", Flag_BR20 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b r 30", Flag_BR30 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b r 40", Flag_BR40 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b r 50", Flag_BR50 ) );
-
-    M_marker_map_old.insert( MarkerPair( "flag l t 30", Flag_LT30 ) );
-    M_marker_map_old.insert( MarkerPair( "flag l t 20", Flag_LT20 ) );
-    M_marker_map_old.insert( MarkerPair( "flag l t 10", Flag_LT10 ) );
-    M_marker_map_old.insert( MarkerPair( "flag l 0", Flag_L0 ) );
-    M_marker_map_old.insert( MarkerPair( "flag l b 10", Flag_LB10 ) );
-    M_marker_map_old.insert( MarkerPair( "flag l b 20", Flag_LB20 ) );
-    M_marker_map_old.insert( MarkerPair( "flag l b 30", Flag_LB30 ) );
-
-    M_marker_map_old.insert( MarkerPair( "flag r t 30", Flag_RT30 ) );
-    M_marker_map_old.insert( MarkerPair( "flag r t 20", Flag_RT20 ) );
-    M_marker_map_old.insert( MarkerPair( "flag r t 10", Flag_RT10 ) );
-    M_marker_map_old.insert( MarkerPair( "flag r 0", Flag_R0 ) );
-    M_marker_map_old.insert( MarkerPair( "flag r b 10", Flag_RB10 ) );
-    M_marker_map_old.insert( MarkerPair( "flag r b 20", Flag_RB20 ) );
-    M_marker_map_old.insert( MarkerPair( "flag r b 30", Flag_RB30 ) );
+    // reserve enough capacity not to reallocate the memory in each cycle
+    M_balls.reserve( 2 );
+    M_markers.reserve( Marker_Unknown );
+    M_behind_markers.reserve( Marker_Unknown );
+    M_lines.reserve( 4 );
+
+    M_teammates.reserve( 11 );
+    M_unknown_teammates.reserve( 11 );
+    M_opponents.reserve( 11 );
+    M_unknown_opponents.reserve( 11 );
+    M_unknown_players.reserve( 22 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+MarkerID
+VisualSensor::markerId( std::string_view name )
+{
+    std::uint64_t key = 0;
+
+    // old protocol: "flag ..." or "goal ..."
+    if ( name.size() > 4
+         && ( name.compare( 0, 4, "flag" ) == 0
+              || name.compare( 0, 4, "goal" ) == 0 ) )
+    {
+        key = static_cast< unsigned char >( name[0] );
+        name.remove_prefix( 4 );
+    }
+
+    key = marker_key( name, key );
+    if ( key == 0 )
+    {
+        return Marker_Unknown;
+    }
+
+    std::size_t i = marker_slot( key );
+    while ( g_marker_table[i].key_ != 0 )
+    {
+        if ( g_marker_table[i].key_ == key )
+        {
+            return g_marker_table[i].id_;
+        }
+        i = ( i + 1 ) & ( MARKER_TABLE_SIZE - 1 );
+    }
+
+    return Marker_Unknown;
 }
 
 /*-------------------------------------------------------------------*/
@@ -362,7 +446,7 @@ VisualSensor::parse( const char * msg,
              || object_type == Obj_Goal )
         {
             seen_marker.object_type_ = object_type;
-            if ( parseMarker( msg, version, &seen_marker ) )
+            if ( parseMarker( msg, &seen_marker ) )
             {
                 M_markers.push_back( seen_marker );
             }
@@ -373,7 +457,7 @@ VisualSensor::parse( const char * msg,
                   || object_type == Obj_Goal_Behind )
         {
             seen_marker.object_type_ = object_type;
-            if ( parseMarker( msg, version, &seen_marker ) )
+            if ( parseMarker( msg, &seen_marker ) )
             {
                 M_behind_markers.push_back( seen_marker );
             }
@@ -438,17 +522,17 @@ VisualSensor::parse( const char * msg,
 
 
     // sort by distance
-    M_teammates.sort( SeenDistCmp() );
-    M_unknown_teammates.sort( SeenDistCmp() );
-    M_opponents.sort( SeenDistCmp() );
-    M_unknown_opponents.sort( SeenDistCmp() );
-    M_unknown_players.sort( SeenDistCmp() );
+    sort_by_seen_dist( M_teammates );
+    sort_by_seen_dist( M_unknown_teammates );
+    sort_by_seen_dist( M_opponents );
+    sort_by_seen_dist( M_unknown_opponents );
+    sort_by_seen_dist( M_unknown_players );
 
-    M_markers.sort( SeenDistCmp() );
-    M_behind_markers.sort( SeenDistCmp() );
+    sort_by_seen_dist( M_markers );
+    sort_by_seen_dist( M_behind_markers );
 
     // line sort is very important !!
-    M_lines.sort( SeenDistCmp() );
+    sort_by_seen_dist( M_lines );
 
 #if 0
     dlog.addText( Logger::SENSOR,
@@ -478,7 +562,6 @@ VisualSensor::parse( const char * msg,
 */
 bool
 VisualSensor::parseMarker( const char * tok,
-                           const double version,
                            MarkerT * info )
 {
     // get marker id
@@ -493,37 +576,16 @@ VisualSensor::parseMarker( const char * tok,
         while ( *tok == '(' ) ++tok; // skip to first identifier
 
         // get marker name
-        int i = 0;
-        std::string marker_name;
-        while ( *( tok + i ) != ')' )
-        {
-            marker_name += *( tok + i );
-            ++i;
-        }
+        const char * end = tok;
+        while ( *end != ')' && *end != '\0' ) ++end;
 
         // search marker id
-        info->id_ = Marker_Unknown;
-        if ( version >= 6.0 )
-        {
-            MarkerMap::const_iterator it = M_marker_map.find( marker_name );
-            if ( it != M_marker_map.end() )
-            {
-                info->id_ = it->second;
-            }
-        }
-        else
-        {
-            MarkerMap::const_iterator it = M_marker_map_old.find( marker_name );
-            if ( it != M_marker_map_old.end() )
-            {
-                info->id_ = it->second;
-            }
-        }
+        info->id_ = markerId( std::string_view( tok, end - tok ) );
 
         if ( info->id_ == Marker_Unknown )
         {
             std::cerr << "(VisualSensor::parseMarker) unknown marker "
-                      << std::string( tok, 16 ) << "]"
+                      << std::string( tok, end - tok ) << "]"
                       << std::endl;
             return false;
         }
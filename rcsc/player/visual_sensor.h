@@ -35,10 +35,9 @@
 #include <rcsc/game_time.h>
 #include <rcsc/types.h>
 
-#include <unordered_map>
-#include <list>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <iostream>
 
 namespace rcsc {
@@ -251,12 +250,10 @@ public:
           }
     };
 
-    typedef std::unordered_map< std::string, MarkerID > MarkerMap;
-
     typedef std::vector< BallT > BallCont; //!< observed ball container
-    typedef std::list< MarkerT > MarkerCont; //!< observed marker container
-    typedef std::list< LineT > LineCont; //!< observed line container
-    typedef std::list< PlayerT > PlayerCont; //!< observed player container
+    typedef std::vector< MarkerT > MarkerCont; //!< observed marker container
+    typedef std::vector< LineT > LineCont; //!< observed line container
+    typedef std::vector< PlayerT > PlayerCont; //!< observed player container
 
 private:
 
@@ -264,11 +261,6 @@ private:
 
     std::string M_their_team_name; //!< seen opponent team name
 
-    //! marker ID map
-    MarkerMap M_marker_map;
-    //! marker ID map, old name
-    MarkerMap M_marker_map_old;
-
     BallCont M_balls; //!< seen ball
     MarkerCont M_markers; //!< seen markers
     MarkerCont M_behind_markers; //!< seen behind markers
@@ -283,10 +275,21 @@ private:
 public:
 
     /*!
-      \brief create marker map
+      \brief reserve the object containers.
     */
     VisualSensor();
 
+    /*!
+      \brief get the marker id from the seen object name.
+      \param name object name without parentheses, e.g. "f t l 50" or "flag t l 50"
+      \return marker id. if not found, Marker_Unknown is returned.
+
+      The marker id is looked up from a table generated at compile time.
+      No memory is allocated.
+    */
+    static
+    MarkerID markerId( std::string_view name );
+
     /*!
       \brief analyze visual message and store analyzed data.
       \param msg message string
@@ -424,13 +427,11 @@ private:
     /*!
       \brief parse marker flag info
       \param tok pointer to the top of object info
-      \param version rcssserver protocol version
       \param info pointer to the varialbe to store the data.
 
       get positional data from object info token
     */
     bool parseMarker( const char * tok,
-                      const double version,
                       MarkerT * info );
 
     /*!
@@ -37,6 +37,8 @@
 
 #include "action_effector.h"
 #include "intercept_simulator_self.h"
+#include "agent_context.h"
+#include "assignment_solver.h"
 #include "localization_default.h"
 #include "body_sensor.h"
 #include "visual_sensor.h"
@@ -51,6 +53,7 @@
 #include <rcsc/common/player_param.h>
 #include <rcsc/common/server_param.h>
 #include <rcsc/time/timer.h>
+#include <rcsc/util/cycle_arena.h>
 #include <rcsc/soccer_math.h>
 #include <rcsc/math_util.h>
 
@@ -135,11 +138,11 @@ get_kickable_player( PlayerObject::Cont::iterator first,
                                                    (*first)->distFromSelf()
                                                    * dist_error_rate ) ) ) )
         {
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (check_player_kickable) exist %d-%d (%.1f %.1f)",
-                          (*first)->side(),
-                          (*first)->unum(),
-                          (*first)->pos().x, (*first)->pos().y );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (check_player_kickable) exist %d-%d (%.1f %.1f)",
+                            (*first)->side(),
+                            (*first)->unum(),
+                            (*first)->pos().x, (*first)->pos().y );
             return *first;
         }
 
@@ -196,14 +199,14 @@ get_self_face_angle( const WorldModel & wm,
     {
         if ( pen_state.isKickTaker( wm.ourSide(), wm.self().unum() ) )
         {
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (get_self_face_angle) pen_onfield=LEFT && kicker -> reverse" );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (get_self_face_angle) pen_onfield=LEFT && kicker -> reverse" );
             return AngleDeg::normalize_angle( seen_face_angle + 180.0 );
         }
         else if ( wm.self().goalie() )
         {
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (get_self_face_angle) pen_onfield=LEFT && goalie -> no reverse" );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (get_self_face_angle) pen_onfield=LEFT && goalie -> no reverse" );
             return seen_face_angle;
         }
     }
@@ -211,20 +214,20 @@ get_self_face_angle( const WorldModel & wm,
     {
         if ( pen_state.isKickTaker( wm.ourSide(), wm.self().unum() ) )
         {
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (get_self_face_angle) pen_onfield=RIGHT && kicker -> no reverse" );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (get_self_face_angle) pen_onfield=RIGHT && kicker -> no reverse" );
             return seen_face_angle;
         }
         else if ( wm.self().goalie() )
         {
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (get_self_face_angle) pen_onfield=RIGHT && goalie -> reverse" );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (get_self_face_angle) pen_onfield=RIGHT && goalie -> reverse" );
             return AngleDeg::normalize_angle( seen_face_angle + 180.0 );
         }
     }
 
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (get_self_face_angle) normal " );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    __FILE__" (get_self_face_angle) normal " );
 
     return ( wm.ourSide() == LEFT
              ? seen_face_angle
@@ -298,6 +301,125 @@ struct PlayerPtrAccuracySorter {
       }
 };
 
+/*-------------------------------------------------------------------*/
+/*!
+  \brief update all players by the inertia and remove the unreliable players in one pass.
+  \param players player instance container
+*/
+void
+update_players( PlayerObject::List & players )
+{
+    PlayerObject::List::iterator it = players.begin();
+    while ( it != players.end() )
+    {
+        it->update();
+        if ( ! it->posValid() )
+        {
+            it = players.erase( it );
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief test all players by the view area at once.
+  \param players player instance container
+  \param varea view area
+  \param dir_thr angle threshold value
+  \param visible_dist2 squared visible distance value
+  \param points buffer for the player positions
+  \param result result array. the value is 1 if the player is in the view area.
+*/
+void
+check_players_in_view_area( const PlayerObject::List & players,
+                            const ViewArea & varea,
+                            const double dir_thr,
+                            const double visible_dist2,
+                            ScratchVector< Vector2D > * points,
+                            ScratchVector< unsigned char > * result )
+{
+    points->clear();
+    for ( const PlayerObject & p : players )
+    {
+        points->push_back( p.pos() );
+    }
+
+    result->resize( points->size() );
+    varea.contains( points->data(), points->size(), dir_thr, visible_dist2, result->data() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief estimate the current ball velocity from the ball movement.
+  \param ball_move global ball movement during the last steps cycles,
+  i.e. the relative position difference plus the self movement.
+  \param steps the number of cycles
+  \return estimated ball velocity at the current cycle
+*/
+Vector2D
+ball_vel_by_move( const Vector2D & ball_move,
+                  const int steps )
+{
+    const double decay = ServerParam::i().ballDecay();
+
+    // ball_move = v0 * ( 1 + decay + ... + decay^(steps-1) )
+    // current_vel = v0 * decay^steps
+    double sum = 1.0;
+    double term = 1.0;
+    for ( int i = 1; i < steps; ++i )
+    {
+        term *= decay;
+        sum += term;
+    }
+
+    return ball_move * ( std::pow( decay, steps ) / sum );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief estimate the error of the velocity given by ball_vel_by_move().
+  \param rpos_error seen relative position error
+  \param self_vel_error self velocity error
+  \param steps the number of cycles
+  \return estimated velocity error
+*/
+Vector2D
+ball_vel_error_by_move( const Vector2D & rpos_error,
+                        const Vector2D & self_vel_error,
+                        const int steps )
+{
+    Vector2D vel_error = ( rpos_error * static_cast< double >( steps ) ) + self_vel_error;
+    vel_error *= ServerParam::i().ballDecay();
+    return vel_error;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief check if the velocity estimated from the multi-cycle movement
+  is consistent with the internally updated velocity.
+  \param vel velocity estimated by ball_vel_by_move()
+  \param internal_vel internally updated ball velocity
+  \param steps the number of cycles
+  \return true if the estimated velocity is acceptable
+*/
+bool
+is_consistent_ball_vel( const Vector2D & vel,
+                        const Vector2D & internal_vel,
+                        const int steps )
+{
+    const double vel_r = vel.r();
+    const double estimate_speed = internal_vel.r();
+    const double rand = ServerParam::i().ballRand() * steps;
+
+    return ( vel_r <= estimate_speed + 0.1
+             && vel_r >= estimate_speed * ( 1.0 - rand ) - 0.1
+             && ( vel - internal_vel ).r() <= estimate_speed * rand + 0.1 );
+}
+
 }
 
 
@@ -318,6 +440,9 @@ WorldModel::WorldModel()
       M_localize(),
       M_intercept_table(),
       M_audio_memory( new AudioMemory() ),
+      M_cycle_arena( nullptr ),
+      M_agent_context( nullptr ),
+      M_assignment_player_matching( false ),
       M_our_side( NEUTRAL ),
       M_time( -1, 0 ),
       M_sense_body_time( -1, 0 ),
@@ -330,6 +455,8 @@ WorldModel::WorldModel()
       M_valid( true ),
       M_self(),
       M_ball(),
+      M_player_grid( Rect2D( Vector2D( -60.0, -40.0 ), Size2D( 120.0, 80.0 ) ), 5.0 ),
+      M_dirty_player_views( 0 ),
       M_our_goalie_unum( Unum_Unknown ),
       M_their_goalie_unum( Unum_Unknown ),
       M_offside_line_x( 0.0 ),
@@ -352,9 +479,12 @@ WorldModel::WorldModel()
       M_previous_kickable_teammate_unum( Unum_Unknown ),
       M_previous_kickable_opponent( false ),
       M_previous_kickable_opponent_unum( Unum_Unknown ),
+      M_maybe_kickable_teammate_update_time( -1, 0 ),
+      M_maybe_kickable_teammate_previous_time( -1, 0 ),
+      M_maybe_kickable_teammate_previous_step( 1000 ),
       M_last_kicker_side( NEUTRAL ),
       M_last_kicker_unum( Unum_Unknown ),
-      M_view_area_cont( MAX_RECORD, ViewArea() )
+      M_view_area_cont( MAX_RECORD )
 {
     for ( int i = 0; i < 11; ++i )
     {
@@ -368,6 +498,7 @@ WorldModel::WorldModel()
     {
         M_dir_count[i] = 1000;
     }
+    updateDirCountSum();
 
     for ( int i = 0; i < 12; ++i )
     {
@@ -467,6 +598,30 @@ WorldModel::setAudioMemory( std::shared_ptr< AudioMemory > memory )
     M_audio_memory = memory;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::pmr::memory_resource *
+WorldModel::scratchResource() const
+{
+    return ( M_cycle_arena
+             ? M_cycle_arena->resource()
+             : std::pmr::get_default_resource() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+AgentContext &
+WorldModel::agentContext() const
+{
+    return ( M_agent_context
+             ? *M_agent_context
+             : AgentContext::default_context() );
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -542,9 +697,9 @@ WorldModel::setOurPlayerType( const int unum,
         return;
     }
 
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (setTeammatePlayerType) teammate %d to player_type %d",
-                  unum, id );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    __FILE__" (setTeammatePlayerType) teammate %d to player_type %d",
+                    unum, id );
 
     M_our_recovery[unum - 1] = 1.0;
     M_our_stamina_capacity[unum - 1] = ServerParam::i().staminaCapacity();
@@ -584,9 +739,9 @@ WorldModel::setTheirPlayerType( const int unum,
         return;
     }
 
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (setOpponentPlayerType) opponent %d to player_type %d",
-                  unum, id );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    __FILE__" (setOpponentPlayerType) opponent %d to player_type %d",
+                    unum, id );
 
     if ( M_their_player_type[unum - 1] != Hetero_Unknown
          && M_their_player_type[unum - 1] != id )
@@ -631,9 +786,9 @@ WorldModel::setCard( const SideID side,
             }
         }
 
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (setCard) teammate %d, card %d",
-                      unum, card );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (setCard) teammate %d, card %d",
+                        unum, card );
     }
     else if ( side == theirSide() )
     {
@@ -647,9 +802,9 @@ WorldModel::setCard( const SideID side,
             }
         }
 
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (setCard) opponent %d, card %d",
-                      unum, card );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (setCard) opponent %d, card %d",
+                        unum, card );
     }
     else
     {
@@ -757,20 +912,20 @@ WorldModel::update( const ActionEffector & act,
 #ifdef DEBUG_PRINT
     if ( M_ball.rposValid() )
     {
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (update) internal update. bpos=(%.2f, %.2f)"
-                      " brpos=(%.2f, %.2f) bvel=(%.2f, %.2f)",
-                      M_ball.pos().x, M_ball.pos().y,
-                      M_ball.rpos().x, M_ball.rpos().y,
-                      M_ball.vel().x, M_ball.vel().y );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (update) internal update. bpos=(%.2f, %.2f)"
+                        " brpos=(%.2f, %.2f) bvel=(%.2f, %.2f)",
+                        M_ball.pos().x, M_ball.pos().y,
+                        M_ball.rpos().x, M_ball.rpos().y,
+                        M_ball.vel().x, M_ball.vel().y );
     }
     else
     {
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (update) internal update. bpos=(%.2f, %.2f)"
-                      " bvel=(%.2f, %.2f), invalid rpos",
-                      M_ball.pos().x, M_ball.pos().y,
-                      M_ball.vel().x, M_ball.vel().y );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (update) internal update. bpos=(%.2f, %.2f)"
+                        " bvel=(%.2f, %.2f), invalid rpos",
+                        M_ball.pos().x, M_ball.pos().y,
+                        M_ball.vel().x, M_ball.vel().y );
     }
 #endif
 
@@ -796,10 +951,14 @@ WorldModel::update( const ActionEffector & act,
     M_maybe_kickable_opponent = nullptr;
 
     // clear pointer reference container
+    M_dirty_player_views.store( 0, std::memory_order_relaxed );
     M_teammates_from_self.clear();
     M_opponents_from_self.clear();
     M_teammates_from_ball.clear();
     M_opponents_from_ball.clear();
+    M_player_grid.clear();
+    M_opponent_profile_from_self.clear();
+    M_opponent_profile_from_ball.clear();
 
     M_all_players.clear();
     M_our_players.clear();
@@ -823,17 +982,10 @@ WorldModel::update( const ActionEffector & act,
         PlayerObject::reset_player_count();
     }
 
-    // update teammates
-    std::for_each( M_teammates.begin(), M_teammates.end(), []( PlayerObject & p ) { p.update(); } );
-    M_teammates.remove_if( []( const PlayerObject & p ) { return ( ! p.posValid() ); } );
-
-    // update opponents
-    std::for_each( M_opponents.begin(), M_opponents.end(), []( PlayerObject & p ) { p.update(); } );
-    M_opponents.remove_if( []( const PlayerObject & p ) { return ( ! p.posValid() ); } );
-
-    // update unknown players
-    std::for_each( M_unknown_players.begin(), M_unknown_players.end(), []( PlayerObject & p ) { p.update(); } );
-    M_unknown_players.remove_if( []( const PlayerObject & p ) { return ( ! p.posValid() ); } );
+    // update teammates, opponents and unknown players
+    update_players( M_teammates );
+    update_players( M_opponents );
+    update_players( M_unknown_players );
 
     // update view area
 
@@ -845,9 +997,9 @@ WorldModel::update( const ActionEffector & act,
         //            (double)i * 360.0 / static_cast<double>(DIR_CONF_DIVS) - 180.0,
         //            M_dir_conf[i] );
     }
+    updateDirCountSum();
 
-    M_view_area_cont.pop_back();
-    M_view_area_cont.push_front( ViewArea( current ) );
+    M_view_area_cont.push( ViewArea( current ) );
 #ifdef USE_VIEW_GRID_MAP
     M_view_grid_map.incrementAll();
 #endif
@@ -868,21 +1020,21 @@ WorldModel::updateAfterSenseBody( const BodySensor & sense_body,
                   << current
                   << " world.updateAfterSense: called twice"
                   << std::endl;
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateAfterSense) called twide" );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (updateAfterSense) called twide" );
         return;
     }
 
     M_sense_body_time = sense_body.time();
 
-    dlog.addText( Logger::WORLD,
-                  "*************** updateAfterSense ***************" );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    "*************** updateAfterSense ***************" );
 
     if ( sense_body.time() == current )
     {
 #ifdef DEBUG_PRINT_SELF_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateAfterSense) update self" );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (updateAfterSense) update self" );
 #endif
         M_self.updateAfterSenseBody( sense_body, act, current );
         M_localize->updateBySenseBody( sense_body );
@@ -895,8 +1047,8 @@ WorldModel::updateAfterSenseBody( const BodySensor & sense_body,
 
     if ( time() != current )
     {
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateAfterSense) call internal update" );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (updateAfterSense) call internal update" );
         // internal update
         update( act, current );
     }
@@ -930,15 +1082,15 @@ WorldModel::updateBallCollision()
     if ( self().hasSensedCollision() )
     {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateBallCollision) agent has sensed collision info" );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (updateBallCollision) agent has sensed collision info" );
 #endif
         collided_with_ball = self().collidesWithBall();
         if ( collided_with_ball )
         {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateBallCollision) detected by sense_body" );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updateBallCollision) detected by sense_body" );
 #endif
         }
     }
@@ -963,9 +1115,9 @@ WorldModel::updateBallCollision()
              )
         {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateBallCollision) detected. ball_dist= %.3f",
-                          self_ball_dist );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updateBallCollision) detected. ball_dist= %.3f",
+                            self_ball_dist );
 #endif
             collided_with_ball = true;
         }
@@ -994,12 +1146,12 @@ WorldModel::updateBallCollision()
                                       new_ball_rpos, ball().rposCount() + 1,
                                       new_ball_vel, ball().velCount() + 1 );
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateBallCollision) new bpos(%.2f %.2f) rpos(%.2f %.2f)"
-                          " vel(%.2f %.2f)",
-                          new_ball_pos.x, new_ball_pos.y,
-                          new_ball_rpos.x, new_ball_rpos.y,
-                          new_ball_vel.x, new_ball_vel.y );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updateBallCollision) new bpos(%.2f %.2f) rpos(%.2f %.2f)"
+                            " vel(%.2f %.2f)",
+                            new_ball_pos.x, new_ball_pos.y,
+                            new_ball_rpos.x, new_ball_rpos.y,
+                            new_ball_vel.x, new_ball_vel.y );
 #endif
             if ( self().posCount() > 0 )
             {
@@ -1012,10 +1164,10 @@ WorldModel::updateBallCollision()
                 M_self.updateByCollision( new_my_pos, new_my_pos_error );
 
 #ifdef DEBUG_PRINT_SELF_UPDATE
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (updateBallCollision) new mypos(%.2f %.2f) error(%.2f %.2f)",
-                              new_my_pos.x, new_my_pos.y,
-                              new_my_pos_error.x, new_my_pos_error.y );
+                RCSC_DLOG_TEXT( Logger::WORLD,
+                                __FILE__" (updateBallCollision) new mypos(%.2f %.2f) error(%.2f %.2f)",
+                                new_my_pos.x, new_my_pos.y,
+                                new_my_pos_error.x, new_my_pos_error.y );
 #endif
             }
         }
@@ -1029,9 +1181,9 @@ WorldModel::updateBallCollision()
                                       ball().rpos(), ball().rposCount(),
                                       ball().vel() * -0.1, vel_count );
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateBallCollision) seen ball. new_vel=(%.2f %.2f)",
-                          ball().vel().x, ball().vel().y );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updateBallCollision) seen ball. new_vel=(%.2f %.2f)",
+                            ball().vel().x, ball().vel().y );
 #endif
         }
     }
@@ -1136,8 +1288,8 @@ WorldModel::updateAfterSee( const VisualSensor & see,
     M_see_time = current;
     M_see_time_stamp.setNow();
 
-    dlog.addText( Logger::WORLD,
-                  "*************** updateAfterSee *****************" );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    "*************** updateAfterSee *****************" );
 
     //////////////////////////////////////////////////////////////////
     // set opponent teamname
@@ -1153,8 +1305,8 @@ WorldModel::updateAfterSee( const VisualSensor & see,
     if ( M_fullstate_time == current )
     {
 #ifdef DEBUG_PRINT
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateAfterSee) already updated by fullstate" );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (updateAfterSee) already updated by fullstate" );
 #endif
         // stored info
         ViewArea varea( self().viewWidth().width(),
@@ -1198,12 +1350,12 @@ WorldModel::updateAfterSee( const VisualSensor & see,
                         self().face(),
                         current );
 #ifdef DEBUG_PRINT
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateAfterSee) view_area, origin=(%.2f, %.2f) angle=%.1f, width=%.1f vwidth=%d,%.2f",
-                      varea.origin().x, varea.origin().y,
-                      varea.angle().degree(), varea.viewWidth(),
-                      self().viewWidth().type(),
-                      self().viewWidth().width() );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (updateAfterSee) view_area, origin=(%.2f, %.2f) angle=%.1f, width=%.1f vwidth=%d,%.2f",
+                        varea.origin().x, varea.origin().y,
+                        varea.angle().degree(), varea.viewWidth(),
+                        self().viewWidth().type(),
+                        self().viewWidth().width() );
 #endif
         // add to view area history
         M_view_area_cont.front() = varea;
@@ -1221,28 +1373,28 @@ WorldModel::updateAfterSee( const VisualSensor & see,
     //////////////////////////////////////////////////////////////////
     // debug output
 #ifdef DEBUG_PROFILE
-    dlog.addText( Logger::WORLD,
-                  __FILE__":(updaterAfterSee) elapsed %f [ms]",
-                  timer.elapsedReal() );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    __FILE__":(updaterAfterSee) elapsed %f [ms]",
+                    timer.elapsedReal() );
 #endif
 #ifdef DEBUG_PRINT
-    dlog.addText( Logger::WORLD,
-                  "<--- mypos=(%.2f, %.2f) err=(%.3f, %.3f) vel=(%.2f, %.2f)",
-                  self().pos().x, self().pos().y,
-                  self().posError().x, self().posError().y,
-                  self().vel().x, self().vel().y );
-    dlog.addText( Logger::WORLD,
-                  "<--- seen players t=%d: ut=%d: o=%d: uo=%d: u=%d",
-                  see.teammates().size(),
-                  see.unknownTeammates().size(),
-                  see.opponents().size(),
-                  see.unknownOpponents().size(),
-                  see.unknownPlayers().size() );
-    dlog.addText( Logger::WORLD,
-                  "<--- internal players t=%d: o=%d: u=%d",
-                  M_teammates.size(),
-                  M_opponents.size(),
-                  M_unknown_players.size() );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    "<--- mypos=(%.2f, %.2f) err=(%.3f, %.3f) vel=(%.2f, %.2f)",
+                    self().pos().x, self().pos().y,
+                    self().posError().x, self().posError().y,
+                    self().vel().x, self().vel().y );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    "<--- seen players t=%d: ut=%d: o=%d: uo=%d: u=%d",
+                    see.teammates().size(),
+                    see.unknownTeammates().size(),
+                    see.opponents().size(),
+                    see.unknownOpponents().size(),
+                    see.unknownPlayers().size() );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    "<--- internal players t=%d: o=%d: u=%d",
+                    M_teammates.size(),
+                    M_opponents.size(),
+                    M_unknown_players.size() );
 #endif
 }
 
@@ -1271,8 +1423,8 @@ WorldModel::updateAfterFullstate( const FullstateSensor & fullstate,
 
     M_fullstate_time = current;
 
-    dlog.addText( Logger::WORLD,
-                  "*************** updateAfterFullstate ***************" );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    "*************** updateAfterFullstate ***************" );
 
     PlayerObject::reset_player_count();
     M_unknown_players.clear(); // clear unkown players
@@ -1282,19 +1434,19 @@ WorldModel::updateAfterFullstate( const FullstateSensor & fullstate,
     {
         if ( fp.unum_ < 1 || 11 < fp.unum_ )
         {
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateAfterFullstate) illegal teammate unum %d",
-                          fp.unum_ );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updateAfterFullstate) illegal teammate unum %d",
+                            fp.unum_ );
             std::cerr << " (updateAfterFullstate) illegal teammate unum. " << fp.unum_
                       << std::endl;
             continue;
         }
 
         // #ifdef DEBUG_PRINT
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateAfterFullstate) teammate %d type=%d card=%s",
-                      fp.unum_, fp.type_,
-                      fp.card_ == YELLOW ? "yellow" : fp.card_ == RED ? "red" : "no" );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (updateAfterFullstate) teammate %d type=%d card=%s",
+                        fp.unum_, fp.type_,
+                        fp.card_ == YELLOW ? "yellow" : fp.card_ == RED ? "red" : "no" );
         // #endif
 
         M_our_player_type[fp.unum_ - 1] = fp.type_;
@@ -1304,8 +1456,8 @@ WorldModel::updateAfterFullstate( const FullstateSensor & fullstate,
         if ( fp.unum_ == self().unum() )
         {
 #ifdef DEBUG_PRINT
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateAfterFullstate) update self" );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updateAfterFullstate) update self" );
 #endif
             M_self.updateAfterFullstate( fp, act, current );
             continue;
@@ -1329,9 +1481,9 @@ WorldModel::updateAfterFullstate( const FullstateSensor & fullstate,
             player = &(M_teammates.back());
         }
 #ifdef DEBUG_PRINT
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateAfterFullstate) updated teammate %d",
-                      fp.unum_ );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (updateAfterFullstate) updated teammate %d",
+                        fp.unum_ );
 #endif
         player->updateByFullstate( fp, self().pos(), fullstate.ball().pos_ );
     }
@@ -1341,19 +1493,19 @@ WorldModel::updateAfterFullstate( const FullstateSensor & fullstate,
     {
         if ( fp.unum_ < 1 || 11 < fp.unum_ )
         {
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateAfterFullstate) illegal opponent unum %d",
-                          fp.unum_ );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updateAfterFullstate) illegal opponent unum %d",
+                            fp.unum_ );
             std::cerr << " (updateAfterFullstate) illegal opponent unum. " << fp.unum_
                       << std::endl;
             continue;
         }
 
 #ifdef DEBUG_PRINT
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateAfterFullstate) teammate %d type=%d card=%s",
-                      fp.unum_, fp.type_,
-                      fp.card_ == YELLOW ? "yellow" : fp.card_ == RED ? "red" : "no" );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (updateAfterFullstate) teammate %d type=%d card=%s",
+                        fp.unum_, fp.type_,
+                        fp.card_ == YELLOW ? "yellow" : fp.card_ == RED ? "red" : "no" );
 #endif
 
         M_their_player_type[fp.unum_ - 1] = fp.type_;
@@ -1376,9 +1528,9 @@ WorldModel::updateAfterFullstate( const FullstateSensor & fullstate,
         }
 
 #ifdef DEBUG_PRINT
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateAfterFullstate) updated opponent %d",
-                      fp.unum_ );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (updateAfterFullstate) updated opponent %d",
+                        fp.unum_ );
 #endif
         player->updateByFullstate( fp, self().pos(), fullstate.ball().pos_ );
     }
@@ -1516,9 +1668,9 @@ WorldModel::updateBallByHear( const ActionEffector & act )
         if ( sender )
         {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateBallByHear) sender=%d exists in memory",
-                          b.sender_ );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updateBallByHear) sender=%d exists in memory",
+                            b.sender_ );
 #endif
             double d2 = sender->pos().dist2( ball().pos() );
             if ( d2 < min_dist2 )
@@ -1534,9 +1686,9 @@ WorldModel::updateBallByHear( const ActionEffector & act )
         else if ( min_dist2 > 100000.0 )
         {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateBallByHear) sender=%d, unknown",
-                          b.sender_ );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updateBallByHear) sender=%d, unknown",
+                            b.sender_ );
 #endif
             min_dist2 = 100000.0;
             heard_pos = b.pos_;
@@ -1600,8 +1752,8 @@ WorldModel::updateGoalieByHear()
     {
         // goalie is seen at the current time.
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateGoalieByHear) but already seen" );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (updateGoalieByHear) but already seen" );
 #endif
         return;
     }
@@ -1619,10 +1771,10 @@ WorldModel::updateGoalieByHear()
     heard_body /= static_cast< double >( M_audio_memory->goalie().size() );
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (updateGoalieByHear) pos=(%.1f %.1f) body=%.1f",
-                  heard_pos.x, heard_pos.y,
-                  heard_body );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    __FILE__" (updateGoalieByHear) pos=(%.1f %.1f) body=%.1f",
+                    heard_pos.x, heard_pos.y,
+                    heard_body );
 #endif
 
     if ( goalie )
@@ -1686,10 +1838,10 @@ WorldModel::updateGoalieByHear()
     {
         // found a candidate unknown player
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateGoalieByHear) found."
-                      " heard_pos=(%.1f %.1f)",
-                      heard_pos.x, heard_pos.y );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (updateGoalieByHear) found."
+                        " heard_pos=(%.1f %.1f)",
+                        heard_pos.x, heard_pos.y );
 #endif
         goalie->updateByHear( theirSide(),
                               theirGoalieUnum(),
@@ -1701,10 +1853,10 @@ WorldModel::updateGoalieByHear()
     {
         // register new object
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateGoalieByHear) not found."
-                      " add new goalie. heard_pos=(%.1f %.1f)",
-                      heard_pos.x, heard_pos.y );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (updateGoalieByHear) not found."
+                        " add new goalie. heard_pos=(%.1f %.1f)",
+                        heard_pos.x, heard_pos.y );
 #endif
         M_opponents.push_back( PlayerObject() );
         goalie = &(M_opponents.back());
@@ -1758,10 +1910,10 @@ WorldModel::updatePlayerByHear()
                       << " heard_unum=" << heard_player.unum_
                       << " pos=" << heard_player.pos_
                       << std::endl;
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updatePlayerByHear). Illegal unum %d"
-                          " pos=(%.1f %.1f)",
-                          unum, heard_player.pos_.x, heard_player.pos_.y );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updatePlayerByHear). Illegal unum %d"
+                            " pos=(%.1f %.1f)",
+                            unum, heard_player.pos_.x, heard_player.pos_.y );
             continue;
         }
 
@@ -1769,8 +1921,8 @@ WorldModel::updatePlayerByHear()
              && unum == self().unum() )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updatePlayerByHear) heard myself. skip" );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updatePlayerByHear) heard myself. skip" );
 #endif
             continue;
         }
@@ -1786,10 +1938,10 @@ WorldModel::updatePlayerByHear()
             {
                 target_player = &p;
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (updatePlayerByHear) found."
-                              " side %s, unum %d",
-                              side_str( side ), unum );
+                RCSC_DLOG_TEXT( Logger::WORLD,
+                                __FILE__" (updatePlayerByHear) found."
+                                " side %s, unum %d",
+                                side_str( side ), unum );
 #endif
                 break;
             }
@@ -1835,16 +1987,16 @@ WorldModel::updatePlayerByHear()
         if ( target_player )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updatePlayerByHear) exist candidate."
-                          " heard_pos(%.1f %.1f) body=%.1f stamina=%.1f,  memory pos(%.1f %.1f) count %d  dist=%.2f",
-                          heard_player.pos_.x,
-                          heard_player.pos_.y,
-                          heard_player.body_,
-                          heard_player.stamina_,
-                          target_player->pos().x, target_player->pos().y,
-                          target_player->posCount(),
-                          min_dist );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updatePlayerByHear) exist candidate."
+                            " heard_pos(%.1f %.1f) body=%.1f stamina=%.1f,  memory pos(%.1f %.1f) count %d  dist=%.2f",
+                            heard_player.pos_.x,
+                            heard_player.pos_.y,
+                            heard_player.body_,
+                            heard_player.stamina_,
+                            target_player->pos().x, target_player->pos().y,
+                            target_player->posCount(),
+                            min_dist );
 #endif
             target_player->updateByHear( side,
                                          unum,
@@ -1855,8 +2007,8 @@ WorldModel::updatePlayerByHear()
             if ( unknown != M_unknown_players.end() )
             {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (updatePlayerByHear) splice unknown player to known player list" );
+                RCSC_DLOG_TEXT( Logger::WORLD,
+                                __FILE__" (updatePlayerByHear) splice unknown player to known player list" );
 #endif
                 players.splice( players.end(),
                                 M_unknown_players,
@@ -1866,13 +2018,13 @@ WorldModel::updatePlayerByHear()
         else
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updatePlayerByHear) not found."
-                          " add new player heard_pos(%.1f %.1f) body=%.1f stamina=%.1f",
-                          heard_player.pos_.x,
-                          heard_player.pos_.y,
-                          heard_player.body_,
-                          heard_player.stamina_ );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updatePlayerByHear) not found."
+                            " add new player heard_pos(%.1f %.1f) body=%.1f stamina=%.1f",
+                            heard_player.pos_.x,
+                            heard_player.pos_.y,
+                            heard_player.body_,
+                            heard_player.stamina_ );
 #endif
             if ( side == ourSide() )
             {
@@ -1930,6 +2082,13 @@ WorldModel::updatePlayerStaminaByHear()
     // dlog.addText( Logger::WORLD,
     //               "(updatePlayerStaminaByHear) start" );
 
+    if ( ! M_audio_memory->heardAny( AudioMemory::mask( AudioMemory::HEARD_RECOVERY )
+                                     | AudioMemory::mask( AudioMemory::HEARD_STAMINA_CAPACITY ),
+                                     this->time() ) )
+    {
+        return;
+    }
+
     if ( M_audio_memory->recoveryTime() == this->time() )
     {
         for ( const AudioMemory::Recovery & v : M_audio_memory->recovery() )
@@ -1937,9 +2096,9 @@ WorldModel::updatePlayerStaminaByHear()
             if ( 1 <= v.sender_ && v.sender_ <= 11 )
             {
                 M_our_recovery[v.sender_ - 1] = v.rate_;
-                dlog.addText( Logger::WORLD,
-                              "(updatePlayerStaminaByHear) unum=%d recovery=%.3f",
-                              v.sender_, v.rate_ );
+                RCSC_DLOG_TEXT( Logger::WORLD,
+                                "(updatePlayerStaminaByHear) unum=%d recovery=%.3f",
+                                v.sender_, v.rate_ );
             }
         }
     }
@@ -1951,9 +2110,9 @@ WorldModel::updatePlayerStaminaByHear()
             if ( 1 <= v.sender_ && v.sender_ <= 11 )
             {
                 M_our_stamina_capacity[v.sender_ - 1] = v.rate_ * ServerParam::i().staminaCapacity();
-                dlog.addText( Logger::WORLD,
-                              "(updatePlayerStaminaByHear) unum=%d capacity=%.2f (rate=%.3f)",
-                              v.sender_, M_our_stamina_capacity[v.sender_ - 1], v.rate_ );
+                RCSC_DLOG_TEXT( Logger::WORLD,
+                                "(updatePlayerStaminaByHear) unum=%d capacity=%.2f (rate=%.3f)",
+                                v.sender_, M_our_stamina_capacity[v.sender_ - 1], v.rate_ );
             }
         }
     }
@@ -1961,9 +2120,9 @@ WorldModel::updatePlayerStaminaByHear()
 #if 0
     for ( int i = 0; i < 11; ++i )
     {
-        dlog.addText( Logger::WORLD,
-                      __FILE__": teammate[%d] stamina capacity=%.2f",
-                      i+1, M_our_stamina_capacity[i] );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__": teammate[%d] stamina capacity=%.2f",
+                        i+1, M_our_stamina_capacity[i] );
     }
 #endif
 }
@@ -1983,6 +2142,9 @@ WorldModel::updateJustBeforeDecision( const ActionEffector & act,
 
     ++M_setplay_count; // always increment
 
+    // the world will be changed by hear and player type updates.
+    M_player_evaluation_cache.reset( current );
+
     updateBallByHear( act );
     updateGoalieByHear();
     updatePlayerByHear();
@@ -2002,6 +2164,8 @@ WorldModel::updateJustBeforeDecision( const ActionEffector & act,
 
     updatePlayersCollision(); // have to be called after player type update.
 
+    updatePlayerSnapshot(); // have to be called after player type update.
+
 #if 0
     // 2008-04-18: akiyama
     // set the effect of opponent kickable state to the ball velocity
@@ -2010,8 +2174,8 @@ WorldModel::updateJustBeforeDecision( const ActionEffector & act,
          )
          && ! self().isKickable() )
     {
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateJustBeforeDecision) : exist kickable opponent. ball vel is set to 0." );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (updateJustBeforeDecision) : exist kickable opponent. ball vel is set to 0." );
 
         M_ball.setPlayerKickable();
     }
@@ -2026,6 +2190,10 @@ WorldModel::updateJustBeforeDecision( const ActionEffector & act,
 
     updateLastKicker();
 
+    updateBallTrajectory(); // have to be called before intercept table update.
+
+    updateArrivalTimeMap();
+
     updateInterceptTable();
 
     updateOffsideLine();
@@ -2191,12 +2359,12 @@ WorldModel::localizeSelf( const VisualSensor & see,
     }
 
 #ifdef DEBUG_PRINT
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (localizeSelf) reverse=%s face:(seen==%.1f use=%.1f) pos=(%f %f)",
-                  ( reverse_side ? "on" : "off" ),
-                  angle_face,
-                  team_angle_face,
-                  my_pos.x, my_pos.y );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    __FILE__" (localizeSelf) reverse=%s face:(seen==%.1f use=%.1f) pos=(%f %f)",
+                    ( reverse_side ? "on" : "off" ),
+                    angle_face,
+                    team_angle_face,
+                    my_pos.x, my_pos.y );
 #endif
 #if 0
     Vector2D my_pos_new = Vector2D::INVALIDATED;
@@ -2255,8 +2423,8 @@ WorldModel::localizeBall( const VisualSensor & see,
                                              &rvel, &vel_error )  )
     {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (localizeBall) localization failed" );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (localizeBall) localization failed" );
 #endif
         return;
     }
@@ -2264,8 +2432,8 @@ WorldModel::localizeBall( const VisualSensor & see,
     if ( ! rpos.isValid() )
     {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (localizeBall) invalid rpos. cannot calc current seen pos" );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (localizeBall) invalid rpos. cannot calc current seen pos" );
 #endif
         return;
     }
@@ -2280,17 +2448,15 @@ WorldModel::localizeBall( const VisualSensor & see,
              && see.balls().front().dist_ > self().playerType().playerSize() + ServerParam::i().ballSize() + 0.1
              && self().lastMove().isValid() )
         {
-            Vector2D tvel = ( rpos - prevBall().rpos() ) + self().lastMove();
-            Vector2D tvel_err = rpos_error + self().velError();
             // set only vel
-            tvel *= ServerParam::i().ballDecay();
-            tvel_err *= ServerParam::i().ballDecay();
+            const Vector2D tvel = ball_vel_by_move( ( rpos - prevBall().rpos() ) + self().lastMove(), 1 );
+            const Vector2D tvel_err = ball_vel_error_by_move( rpos_error, self().velError(), 1 );
             M_ball.updateOnlyVel( tvel, tvel_err, 1 );
 
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (localizeBall) only vel (%.3f %.3f)",
-                          tvel.x, tvel.y );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (localizeBall) only vel (%.3f %.3f)",
+                            tvel.x, tvel.y );
 #endif
         }
 
@@ -2298,9 +2464,9 @@ WorldModel::localizeBall( const VisualSensor & see,
         M_ball.updateOnlyRelativePos( rpos, rpos_error );
 
 #ifdef DEBUG_PRINT_BALL_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (localizeBall) only relative pos (%.3f %.3f)",
-                      rpos.x, rpos.y );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (localizeBall) only relative pos (%.3f %.3f)",
+                        rpos.x, rpos.y );
 #endif
         return;
     }
@@ -2328,9 +2494,9 @@ WorldModel::localizeBall( const VisualSensor & see,
         vel_error += self().velError();
         vel_count = 0;
 #ifdef DEBUG_PRINT_BALL_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (localizeBall) self_vel=(%.3f %.3f) ball_rvel=(%.3f %.3f) r=%.3f th=%.1f gvel=(%.3f %.3f)",
-                      self().vel().x, self().vel().y, rvel.x, rvel.y, rvel.r(), rvel.th().degree(), gvel.x, gvel.y );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (localizeBall) self_vel=(%.3f %.3f) ball_rvel=(%.3f %.3f) r=%.3f th=%.1f gvel=(%.3f %.3f)",
+                        self().vel().x, self().vel().y, rvel.x, rvel.y, rvel.r(), rvel.th().degree(), gvel.x, gvel.y );
 #endif
     }
 
@@ -2354,9 +2520,9 @@ WorldModel::localizeBall( const VisualSensor & see,
             vel_error += pos_error + prevBall().posError() + prevBall().velError();
             vel_count = 2;
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (localizeBall) estimate velocity by position diff(1) vel(%.3f %.3f)",
-                          gvel.x, gvel.y );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (localizeBall) estimate velocity by position diff(1) vel(%.3f %.3f)",
+                            gvel.x, gvel.y );
 #endif
         }
 #if 1
@@ -2384,12 +2550,12 @@ WorldModel::localizeBall( const VisualSensor & see,
             vel_count = move_step;
 
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (localizeBall) estimate vel by pos diff(2) prev=(%.2f %.2f) move=(%.2f %.2f) dist=%.3f",
-                          prev_pos.x, prev_pos.y, ball_move.x, ball_move.y, ball_move.r() );
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (localizeBall) estimate vel by pos diff(2) vel=(%.3f %.3f) count=%d",
-                          gvel.x, gvel.y, vel_count );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (localizeBall) estimate vel by pos diff(2) prev=(%.2f %.2f) move=(%.2f %.2f) dist=%.3f",
+                            prev_pos.x, prev_pos.y, ball_move.x, ball_move.y, ball_move.r() );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (localizeBall) estimate vel by pos diff(2) vel=(%.3f %.3f) count=%d",
+                            gvel.x, gvel.y, vel_count );
 #endif
         }
 #endif
@@ -2402,9 +2568,9 @@ WorldModel::localizeBall( const VisualSensor & see,
     if ( gvel.isValid() )
     {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (localizeBall) updateAll. p(%.3f %.3f) rel(%.3f %.3f) v(%.3f %.3f)",
-                      pos.x, pos.y, rpos.x, rpos.y, gvel.x, gvel.y );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (localizeBall) updateAll. p(%.3f %.3f) rel(%.3f %.3f) v(%.3f %.3f)",
+                        pos.x, pos.y, rpos.x, rpos.y, gvel.x, gvel.y );
 #endif
         M_ball.updateAll( pos, pos_error, self().posCount(),
                           rpos, rpos_error,
@@ -2413,22 +2579,22 @@ WorldModel::localizeBall( const VisualSensor & see,
     else
     {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (localizeBall) updatePos. p(%.3f %.3f) rel(%.3f %.3f)",
-                      pos.x, pos.y, rpos.x, rpos.y );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (localizeBall) updatePos. p(%.3f %.3f) rel(%.3f %.3f)",
+                        pos.x, pos.y, rpos.x, rpos.y );
 #endif
         M_ball.updatePos( pos, pos_error, self().posCount(),
                           rpos, rpos_error );
     }
 
 #ifdef DEBUG_PRINT_BALL_UPDATE
-    dlog.addText( Logger::WORLD,
-                  "<--- ball pos=(%.2f, %.2f) err=(%.3f, %.3f)"
-                  " rpos=(%.2f, %.2f) rpos_err=(%.3f, %.3f)",
-                  ball().pos().x, ball().pos().y,
-                  ball().posError().x, ball().posError().y,
-                  ball().rpos().x, ball().rpos().y,
-                  ball().rposError().x, ball().rposError().y );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    "<--- ball pos=(%.2f, %.2f) err=(%.3f, %.3f)"
+                    " rpos=(%.2f, %.2f) rpos_err=(%.3f, %.3f)",
+                    ball().pos().x, ball().pos().y,
+                    ball().posError().x, ball().posError().y,
+                    ball().rpos().x, ball().rpos().y,
+                    ball().rposError().x, ball().rposError().y );
 #endif
 }
 
@@ -2454,8 +2620,8 @@ WorldModel::estimateBallVelByPosDiff( const VisualSensor & see,
              || self().collidesWithPost() )
         {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (estimateBallVelByPosDiff) canceled by collision.." );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (estimateBallVelByPosDiff) canceled by collision.." );
 #endif
             return;
         }
@@ -2464,8 +2630,8 @@ WorldModel::estimateBallVelByPosDiff( const VisualSensor & see,
     if ( ball().rposCount() == 1 ) // player saw the ball at prev cycle, too.
     {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (estimateBallVelByPosDiff) update by rpos diff(1)." );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (estimateBallVelByPosDiff) update by rpos diff(1)." );
 #endif
 
         if ( see.balls().front().dist_ < 3.15 // ServerParam::i().visibleDistance()
@@ -2474,10 +2640,8 @@ WorldModel::estimateBallVelByPosDiff( const VisualSensor & see,
              && self().lastMove().isValid() )
         {
             Vector2D rpos_diff = rpos - prevBall().rpos();
-            Vector2D tmp_vel = rpos_diff + self().lastMove();
-            Vector2D tmp_vel_error = rpos_error + self().velError();
-            tmp_vel *= ServerParam::i().ballDecay();
-            tmp_vel_error *= ServerParam::i().ballDecay();
+            Vector2D tmp_vel = ball_vel_by_move( rpos_diff + self().lastMove(), 1 );
+            Vector2D tmp_vel_error = ball_vel_error_by_move( rpos_error, self().velError(), 1 );
 
             // collision
             // if ( self().collidesWithBall() )
@@ -2486,24 +2650,24 @@ WorldModel::estimateBallVelByPosDiff( const VisualSensor & see,
             //     tmp_vel_error *= 0.1;
             // }
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          "________ rpos(%.3f %.3f) prev_rpos(%.3f %.3f)",
-                          rpos.x, rpos.y,
-                          prevBall().rpos().x, prevBall().rpos().y );
-            dlog.addText( Logger::WORLD,
-                          "________ diff(%.3f %.3f) my_move(%.3f %.3f) -> vel(%.2f, %2f)",
-                          rpos_diff.x, rpos_diff.y,
-                          self().lastMove().x, self().lastMove().y,
-                          tmp_vel.x, tmp_vel.y );
-
-            dlog.addText( Logger::WORLD,
-                          "________ internal ball_vel(%.3f %.3f) polar(%.5f %.2f) ",
-                          ball().vel().x, ball().vel().y,
-                          ball().vel().r(), ball().vel().th().degree() );
-            dlog.addText( Logger::WORLD,
-                          "________ estimated ball_vel(%.3f %.3f) vel_error(%.5f %.2f) ",
-                          tmp_vel.x, tmp_vel.y,
-                          tmp_vel_error.x, tmp_vel_error.y );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            "________ rpos(%.3f %.3f) prev_rpos(%.3f %.3f)",
+                            rpos.x, rpos.y,
+                            prevBall().rpos().x, prevBall().rpos().y );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            "________ diff(%.3f %.3f) my_move(%.3f %.3f) -> vel(%.2f, %2f)",
+                            rpos_diff.x, rpos_diff.y,
+                            self().lastMove().x, self().lastMove().y,
+                            tmp_vel.x, tmp_vel.y );
+
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            "________ internal ball_vel(%.3f %.3f) polar(%.5f %.2f) ",
+                            ball().vel().x, ball().vel().y,
+                            ball().vel().r(), ball().vel().th().degree() );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            "________ estimated ball_vel(%.3f %.3f) vel_error(%.5f %.2f) ",
+                            tmp_vel.x, tmp_vel.y,
+                            tmp_vel_error.x, tmp_vel_error.y );
 
 #endif
             if ( ball().seenVelCount() <= 2
@@ -2517,15 +2681,15 @@ WorldModel::estimateBallVelByPosDiff( const VisualSensor & see,
                  )
             {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (estimateBallVelByPosDiff) cancel" );
+                RCSC_DLOG_TEXT( Logger::WORLD,
+                                __FILE__" (estimateBallVelByPosDiff) cancel" );
 #endif
                 return;
             }
 
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (estimateBallVelByPosDiff) update" );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (estimateBallVelByPosDiff) update" );
 #endif
             if ( ! vel.isValid() )
             {
@@ -2551,8 +2715,8 @@ WorldModel::estimateBallVelByPosDiff( const VisualSensor & see,
               && ball().rposCount() == 2 )
     {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (estimateBallVelByPosDiff) update by rpos diff(2)." );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (estimateBallVelByPosDiff) update by rpos diff(2)." );
 #endif
 
         if ( see.balls().front().dist_ < 3.15
@@ -2566,51 +2730,44 @@ WorldModel::estimateBallVelByPosDiff( const VisualSensor & see,
             Vector2D ball_move = rpos - ball().seenRPos();
             ball_move += self().lastMove( 0 );
             ball_move += self().lastMove( 1 );
-            vel = ball_move * ( square( ServerParam::i().ballDecay() )
-                                / ( 1.0 + ServerParam::i().ballDecay() ) );
-
-            double vel_r = vel.r();
-            double estimate_speed = ball().vel().r();
+            vel = ball_vel_by_move( ball_move, 2 );
 
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (estimateBallVelByPosDiff)"
-                          " diff_vel=(%.2f %.2f)%.3f   estimate_vel=(%.2f %.2f)%.3f",
-                          vel.x, vel.y, vel_r,
-                          ball().vel().x, ball().vel().y, estimate_speed );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (estimateBallVelByPosDiff)"
+                            " diff_vel=(%.2f %.2f)%.3f   estimate_vel=(%.2f %.2f)%.3f",
+                            vel.x, vel.y, vel.r(),
+                            ball().vel().x, ball().vel().y, ball().vel().r() );
 #endif
 
-            if ( vel_r > estimate_speed + 0.1
-                 || vel_r < estimate_speed * ( 1.0 - ServerParam::i().ballRand() * 2.0 ) - 0.1
-                 || ( vel - ball().vel() ).r() > estimate_speed * ServerParam::i().ballRand() * 2.0 + 0.1 )
+            if ( ! is_consistent_ball_vel( vel, ball().vel(), 2 ) )
             {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (estimateBallVelByPosDiff)"
-                              " failed to update ball vel using pos diff(2) " );
+                RCSC_DLOG_TEXT( Logger::WORLD,
+                                __FILE__" (estimateBallVelByPosDiff)"
+                                " failed to update ball vel using pos diff(2) " );
 #endif
                 vel.invalidate();
             }
             else
             {
-                vel_error = ( rpos_error * 2.0 ) + self().velError();
-                vel_error *= ServerParam::i().ballDecay();
+                vel_error = ball_vel_error_by_move( rpos_error, self().velError(), 2 );
                 vel_count = 2;
 
 #ifdef DEBUG_PRINT_BALL_UPDATE
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (estimateBallVelByPosDiff)"
-                              " cur_rpos(%.2f %.2f) prev_rpos(%.2f %.2f)",
-                              rpos.x, rpos.y,
-                              ball().seenRPos().x, ball().seenRPos().y );
-                dlog.addText( Logger::WORLD,
-                              "____ ball_move(%.2f %.2f) my_move0(%.2f %.2f) my_move1(%.2f %.2f)",
-                              ball_move.x, ball_move.y,
-                              self().lastMove( 0 ).x, self().lastMove( 0 ).y,
-                              self().lastMove( 1 ).x, self().lastMove( 1 ).y );
-                dlog.addText( Logger::WORLD,
-                              "---> vel(%.2f, %2f)",
-                              vel.x, vel.y );
+                RCSC_DLOG_TEXT( Logger::WORLD,
+                                __FILE__" (estimateBallVelByPosDiff)"
+                                " cur_rpos(%.2f %.2f) prev_rpos(%.2f %.2f)",
+                                rpos.x, rpos.y,
+                                ball().seenRPos().x, ball().seenRPos().y );
+                RCSC_DLOG_TEXT( Logger::WORLD,
+                                "____ ball_move(%.2f %.2f) my_move0(%.2f %.2f) my_move1(%.2f %.2f)",
+                                ball_move.x, ball_move.y,
+                                self().lastMove( 0 ).x, self().lastMove( 0 ).y,
+                                self().lastMove( 1 ).x, self().lastMove( 1 ).y );
+                RCSC_DLOG_TEXT( Logger::WORLD,
+                                "---> vel(%.2f, %2f)",
+                                vel.x, vel.y );
 #endif
             }
 
@@ -2620,8 +2777,8 @@ WorldModel::estimateBallVelByPosDiff( const VisualSensor & see,
               && ball().rposCount() == 3 )
     {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (estimateBallVelByPosDiff) vel update by rpos diff(3) " );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (estimateBallVelByPosDiff) vel update by rpos diff(3) " );
 #endif
         if ( see.balls().front().dist_ < 3.15
              && act.lastBodyCommandType( 0 ) != PlayerCommand::KICK
@@ -2638,48 +2795,41 @@ WorldModel::estimateBallVelByPosDiff( const VisualSensor & see,
             ball_move += self().lastMove( 1 );
             ball_move += self().lastMove( 2 );
 
-            vel = ball_move * ( std::pow( ServerParam::i().ballDecay(), 3 )
-                                / ( 1.0 + ServerParam::i().ballDecay() + square( ServerParam::i().ballDecay() ) ) );
-
-            double vel_r = vel.r();
-            double estimate_speed = ball().vel().r();
+            vel = ball_vel_by_move( ball_move, 3 );
 
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (estimateBallVelByPosDiff)"
-                          " diff_vel=(%.2f %.2f)%.3f   estimate_vel=(%.2f %.2f)%.3f",
-                          vel.x, vel.y, vel_r,
-                          ball().vel().x, ball().vel().y, estimate_speed );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (estimateBallVelByPosDiff)"
+                            " diff_vel=(%.2f %.2f)%.3f   estimate_vel=(%.2f %.2f)%.3f",
+                            vel.x, vel.y, vel.r(),
+                            ball().vel().x, ball().vel().y, ball().vel().r() );
 #endif
 
-            if ( vel_r > estimate_speed + 0.1
-                 || vel_r < estimate_speed * ( 1.0 - ServerParam::i().ballRand() * 3.0 ) - 0.1
-                 || ( vel - ball().vel() ).r() > estimate_speed * ServerParam::i().ballRand() * 3.0 + 0.1 )
+            if ( ! is_consistent_ball_vel( vel, ball().vel(), 3 ) )
             {
-                dlog.addText( Logger::WORLD,
-                              "world.localizeBall: .failed to update ball vel using pos diff(2) " );
+                RCSC_DLOG_TEXT( Logger::WORLD,
+                                "world.localizeBall: .failed to update ball vel using pos diff(2) " );
                 vel.invalidate();
             }
             else
             {
-                vel_error = ( rpos_error * 3.0 ) + self().velError();
-                vel_error *= ServerParam::i().ballDecay();
+                vel_error = ball_vel_error_by_move( rpos_error, self().velError(), 3 );
                 vel_count = 3;
 
 #ifdef DEBUG_PRINT_BALL_UPDATE
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (estimateBallVelByPosDiff)"
-                              " cur_rpos(%.2f %.2f) prev_rpos(%.2f %.2f)"
-                              " ball_move(%.2f %.2f)"
-                              " my_move0(%.2f %.2f) my_move1(%.2f %.2f) my_move2(%.2f %.2f)"
-                              " -> vel(%.2f, %2f)",
-                              rpos.x, rpos.y,
-                              ball().seenRPos().x, ball().seenRPos().y,
-                              ball_move.x, ball_move.y,
-                              self().lastMove( 0 ).x, self().lastMove( 0 ).y,
-                              self().lastMove( 1 ).x, self().lastMove( 1 ).y,
-                              self().lastMove( 2 ).x, self().lastMove( 2 ).y,
-                              vel.x, vel.y );
+                RCSC_DLOG_TEXT( Logger::WORLD,
+                                __FILE__" (estimateBallVelByPosDiff)"
+                                " cur_rpos(%.2f %.2f) prev_rpos(%.2f %.2f)"
+                                " ball_move(%.2f %.2f)"
+                                " my_move0(%.2f %.2f) my_move1(%.2f %.2f) my_move2(%.2f %.2f)"
+                                " -> vel(%.2f, %2f)",
+                                rpos.x, rpos.y,
+                                ball().seenRPos().x, ball().seenRPos().y,
+                                ball_move.x, ball_move.y,
+                                self().lastMove( 0 ).x, self().lastMove( 0 ).y,
+                                self().lastMove( 1 ).x, self().lastMove( 1 ).y,
+                                self().lastMove( 2 ).x, self().lastMove( 2 ).y,
+                                vel.x, vel.y );
 #endif
             }
         }
@@ -2740,29 +2890,33 @@ WorldModel::localizePlayers( const VisualSensor & see )
     //////////////////////////////////////////////////////////////////
     // localize, matching and splice from memory list to temporary list
 
+    // localized players for the assignment matching
+    std::vector< Localization::PlayerT > seen_opponents;
+    std::vector< Localization::PlayerT > seen_teammates;
+
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-    dlog.addText( Logger::WORLD,
-                  __FILE__" ========== (localizePlayers) ==========" );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    __FILE__" ========== (localizePlayers) ==========" );
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-    dlog.addText( Logger::WORLD,
-                  "<<<<< old players start" );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    "<<<<< old players start" );
     for ( const PlayerObject & p : M_teammates )
     {
-        dlog.addText( Logger::WORLD,
-                      "teammate %d (%.2f %.2f)", p.unum(), p.pos().x, p.pos().y );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        "teammate %d (%.2f %.2f)", p.unum(), p.pos().x, p.pos().y );
     }
     for ( const PlayerObject & p : M_opponents )
     {
-        dlog.addText( Logger::WORLD,
-                      "opponent %d (%.2f %.2f)", p.unum(), p.pos().x, p.pos().y );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        "opponent %d (%.2f %.2f)", p.unum(), p.pos().x, p.pos().y );
     }
     for ( const PlayerObject & p : M_unknown_players )
     {
-        dlog.addText( Logger::WORLD,
-                      "unknown %d (%.2f %.2f)", p.unum(), p.pos().x, p.pos().y );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        "unknown %d (%.2f %.2f)", p.unum(), p.pos().x, p.pos().y );
     }
-    dlog.addText( Logger::WORLD,
-                  "<<<<< old players end" );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    "<<<<< old players end" );
 #endif
 #endif
 
@@ -2778,22 +2932,27 @@ WorldModel::localizePlayers( const VisualSensor & see )
                                            &player ) )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-            dlog.addText( Logger::WORLD,
-                          "(localizePlayers) failed opponent %d",
-                          player.unum_ );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            "(localizePlayers) failed opponent %d",
+                            player.unum_ );
 #endif
             continue;
         }
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-        dlog.addText( Logger::WORLD,
-                      "(localizePlayers)"
-                      " opponent %d pos=(%.2f, %.2f) vel=(%.2f, %.2f)",
-                      player.unum_,
-                      player.pos_.x, player.pos_.y,
-                      player.vel_.x, player.vel_.y );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        "(localizePlayers)"
+                        " opponent %d pos=(%.2f, %.2f) vel=(%.2f, %.2f)",
+                        player.unum_,
+                        player.pos_.x, player.pos_.y,
+                        player.vel_.x, player.vel_.y );
 #endif
         // matching, splice or create
+        if ( M_assignment_player_matching )
+        {
+            seen_opponents.push_back( player );
+            continue;
+        }
         checkTeamPlayer( theirSide(),
                          player,
                          M_opponents,
@@ -2813,19 +2972,24 @@ WorldModel::localizePlayers( const VisualSensor & see )
                                            &player ) )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-            dlog.addText( Logger::WORLD,
-                          "(localizePlayers) failed unknown opponent" );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            "(localizePlayers) failed unknown opponent" );
 #endif
             continue;
         }
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-        dlog.addText( Logger::WORLD,
-                      "(localizePlayers)"
-                      " unknown opponent pos=(%.2f, %.2f)",
-                      player.pos_.x, player.pos_.y );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        "(localizePlayers)"
+                        " unknown opponent pos=(%.2f, %.2f)",
+                        player.pos_.x, player.pos_.y );
 #endif
         // matching, splice or create
+        if ( M_assignment_player_matching )
+        {
+            seen_opponents.push_back( player );
+            continue;
+        }
         checkTeamPlayer( theirSide(),
                          player,
                          M_opponents,
@@ -2845,22 +3009,27 @@ WorldModel::localizePlayers( const VisualSensor & see )
                                            &player ) )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (localizePlayers) failed teammate %d",
-                          player.unum_ );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (localizePlayers) failed teammate %d",
+                            player.unum_ );
 #endif
             continue;
         }
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-        dlog.addText( Logger::WORLD,
-                      "(localizePlayers)"
-                      " teammate %d pos=(%.2f, %.2f) vel=(%.2f, %.2f)",
-                      player.unum_,
-                      player.pos_.x, player.pos_.y,
-                      player.vel_.x, player.vel_.y );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        "(localizePlayers)"
+                        " teammate %d pos=(%.2f, %.2f) vel=(%.2f, %.2f)",
+                        player.unum_,
+                        player.pos_.x, player.pos_.y,
+                        player.vel_.x, player.vel_.y );
 #endif
         // matching, splice or create
+        if ( M_assignment_player_matching )
+        {
+            seen_teammates.push_back( player );
+            continue;
+        }
         checkTeamPlayer( ourSide(),
                          player,
                          M_teammates,
@@ -2880,19 +3049,24 @@ WorldModel::localizePlayers( const VisualSensor & see )
                                            &player ) )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-            dlog.addText( Logger::WORLD,
-                          "(localizePlayers) failed uunknown teammate" );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            "(localizePlayers) failed uunknown teammate" );
 #endif
             continue;
         }
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-        dlog.addText( Logger::WORLD,
-                      "(localizePlayers)"
-                      " unknown teammate pos=(%.2f, %.2f)",
-                      player.pos_.x, player.pos_.y );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        "(localizePlayers)"
+                        " unknown teammate pos=(%.2f, %.2f)",
+                        player.pos_.x, player.pos_.y );
 #endif
         // matching, splice or create
+        if ( M_assignment_player_matching )
+        {
+            seen_teammates.push_back( player );
+            continue;
+        }
         checkTeamPlayer( ourSide(),
                          player,
                          M_teammates,
@@ -2900,6 +3074,20 @@ WorldModel::localizePlayers( const VisualSensor & see )
                          new_teammates );
     }
 
+    if ( M_assignment_player_matching )
+    {
+        matchTeamPlayers( theirSide(),
+                          seen_opponents,
+                          M_opponents,
+                          M_unknown_players,
+                          new_opponents );
+        matchTeamPlayers( ourSide(),
+                          seen_teammates,
+                          M_teammates,
+                          M_unknown_players,
+                          new_teammates );
+    }
+
     //
     // unknown player
     //
@@ -2913,17 +3101,17 @@ WorldModel::localizePlayers( const VisualSensor & see )
                                            &player ) )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (localizePlayers) failed unknown player" );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (localizePlayers) failed unknown player" );
 #endif
             continue;
         }
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-        dlog.addText( Logger::WORLD,
-                      "(localizePlayers)"
-                      " unknown player: pos=(%.2f, %.2f)",
-                      player.pos_.x, player.pos_.y );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        "(localizePlayers)"
+                        " unknown player: pos=(%.2f, %.2f)",
+                        player.pos_.x, player.pos_.y );
 #endif
         // matching, splice or create
         checkUnknownPlayer( player,
@@ -2985,12 +3173,12 @@ WorldModel::localizePlayers( const VisualSensor & see )
     {
         // reset least confidence value player
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (localizePlayers)"
-                      " erase overflow teammate, %d pos=(%.2f, %.2f)",
-                      all_teammates_ptr.back()->unum(),
-                      all_teammates_ptr.back()->pos().x,
-                      all_teammates_ptr.back()->pos().y );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (localizePlayers)"
+                        " erase overflow teammate, %d pos=(%.2f, %.2f)",
+                        all_teammates_ptr.back()->unum(),
+                        all_teammates_ptr.back()->pos().x,
+                        all_teammates_ptr.back()->pos().y );
 #endif
         all_teammates_ptr.back()->forget();
         all_teammates_ptr.pop_back();
@@ -3003,12 +3191,12 @@ WorldModel::localizePlayers( const VisualSensor & see )
     {
         // reset least confidence value player
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (localizePlayers)"
-                      " erase overflow opponent, %d pos=(%.2f, %.2f)",
-                      all_opponents_ptr.back()->unum(),
-                      all_opponents_ptr.back()->pos().x,
-                      all_opponents_ptr.back()->pos().y );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (localizePlayers)"
+                        " erase overflow opponent, %d pos=(%.2f, %.2f)",
+                        all_opponents_ptr.back()->unum(),
+                        all_opponents_ptr.back()->pos().x,
+                        all_opponents_ptr.back()->pos().y );
 #endif
         all_opponents_ptr.back()->forget();
         all_opponents_ptr.pop_back();
@@ -3022,11 +3210,11 @@ WorldModel::localizePlayers( const VisualSensor & see )
             && total_count > 25 ) //11 * 2 - 1 )
     {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (localizePlayers)"
-                      " erase over flow unknown player, pos=(%.2f, %.2f)",
-                      M_unknown_players.back().pos().x,
-                      M_unknown_players.back().pos().y );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (localizePlayers)"
+                        " erase over flow unknown player, pos=(%.2f, %.2f)",
+                        M_unknown_players.back().pos().x,
+                        M_unknown_players.back().pos().y );
 #endif
         if ( M_unknown_players.back().posCount() == 0 )
         {
@@ -3087,11 +3275,11 @@ WorldModel::checkTeamPlayer( const SideID side,
             if ( it->unum() == player.unum_ )
             {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-                dlog.addText( Logger::WORLD,
-                              "(checkTeamPlayer)"
-                              " >>> matched!"
-                              " unum = %d pos =(%.1f %.1f)",
-                              player.unum_, player.pos_.x, player.pos_.y );
+                RCSC_DLOG_TEXT( Logger::WORLD,
+                                "(checkTeamPlayer)"
+                                " >>> matched!"
+                                " unum = %d pos =(%.1f %.1f)",
+                                player.unum_, player.pos_.x, player.pos_.y );
 #endif
                 it->updateBySee( side, player );
                 new_known_players.splice( new_known_players.end(),
@@ -3127,11 +3315,11 @@ WorldModel::checkTeamPlayer( const SideID side,
             // unum is seen
             // and it does not match with old player's unum.
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (checkTeamPlayer)"
-                          "___ known player: unum is not match."
-                          " seen unum = %d, old_unum = %d",
-                          player.unum_, it->unum() );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (checkTeamPlayer)"
+                            "___ known player: unum is not match."
+                            " seen unum = %d, old_unum = %d",
+                            player.unum_, it->unum() );
 #endif
             continue;
         }
@@ -3155,18 +3343,18 @@ WorldModel::checkTeamPlayer( const SideID side,
         {
             // TODO: inertia movement should be considered.
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-            dlog.addText( Logger::WORLD,
-                          "(checkTeamPlayer)"
-                          "___ known player: dist over."
-                          " dist=%.2f > buf=%.2f"
-                          " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
-                          d,
-                          it->playerTypePtr()->realSpeedMax() * dash_noise * count
-                          + heard_error
-                          + self_error
-                          + player.dist_error_ * 2.0,
-                          player.pos_.x, player.pos_.y,
-                          it->pos().x, it->pos().y );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            "(checkTeamPlayer)"
+                            "___ known player: dist over."
+                            " dist=%.2f > buf=%.2f"
+                            " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
+                            d,
+                            it->playerTypePtr()->realSpeedMax() * dash_noise * count
+                            + heard_error
+                            + self_error
+                            + player.dist_error_ * 2.0,
+                            player.pos_.x, player.pos_.y,
+                            it->pos().x, it->pos().y );
 #endif
             continue;
         }
@@ -3174,15 +3362,15 @@ WorldModel::checkTeamPlayer( const SideID side,
         if ( d < min_team_dist )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-            dlog.addText( Logger::WORLD,
-                          "(checkTeamPlayer)"
-                          "___ known player: update."
-                          " dist=%.2f < min_team_dist=%.2f"
-                          " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
-                          d,
-                          min_team_dist,
-                          player.pos_.x, player.pos_.y,
-                          it->pos().x, it->pos().y );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            "(checkTeamPlayer)"
+                            "___ known player: update."
+                            " dist=%.2f < min_team_dist=%.2f"
+                            " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
+                            d,
+                            min_team_dist,
+                            player.pos_.x, player.pos_.y,
+                            it->pos().x, it->pos().y );
 #endif
             min_team_dist = d;
             candidate_team = it;
@@ -3215,18 +3403,18 @@ WorldModel::checkTeamPlayer( const SideID side,
         {
             // TODO: inertia movement should be considered.
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-            dlog.addText( Logger::WORLD,
-                          "(checkTeamPlayer)"
-                          "__ unknown player: dist over. "
-                          "dist=%.2f > buf=%.2f"
-                          " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
-                          d,
-                          it->playerTypePtr()->realSpeedMax() * dash_noise * count
-                          + heard_error
-                          + self_error
-                          + player.dist_error_ * 2.0,
-                          player.pos_.x, player.pos_.y,
-                          old_pos.x, old_pos.y );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            "(checkTeamPlayer)"
+                            "__ unknown player: dist over. "
+                            "dist=%.2f > buf=%.2f"
+                            " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
+                            d,
+                            it->playerTypePtr()->realSpeedMax() * dash_noise * count
+                            + heard_error
+                            + self_error
+                            + player.dist_error_ * 2.0,
+                            player.pos_.x, player.pos_.y,
+                            old_pos.x, old_pos.y );
 #endif
             continue;
         }
@@ -3234,15 +3422,15 @@ WorldModel::checkTeamPlayer( const SideID side,
         if ( d < min_unknown_dist )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-            dlog.addText( Logger::WORLD,
-                          "(checkTeamPlayer)"
-                          "__ unknown player: update. "
-                          " dist=%.2f < min_unknown_dist=%.2f"
-                          " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
-                          d,
-                          min_unknown_dist,
-                          player.pos_.x, player.pos_.y,
-                          old_pos.x, old_pos.y );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            "(checkTeamPlayer)"
+                            "__ unknown player: update. "
+                            " dist=%.2f < min_unknown_dist=%.2f"
+                            " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
+                            d,
+                            min_unknown_dist,
+                            player.pos_.x, player.pos_.y,
+                            old_pos.x, old_pos.y );
 #endif
             min_unknown_dist = d;
             candidate_unknown = it;
@@ -3263,17 +3451,17 @@ WorldModel::checkTeamPlayer( const SideID side,
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
         min_dist = min_team_dist;
-        dlog.addText( Logger::WORLD,
-                      "(checkTeamPlayer)"
-                      ">>> %d (%.1f %.1f)"
-                      " -> %s player %d %s (%.2f, %.2f) dist=%.2f",
-                      player.unum_,
-                      player.pos_.x, player.pos_.y,
-                      side_str( candidate->side() ),
-                      candidate->unum(),
-                      ( candidate->goalie() ? "goalie" : "field" ),
-                      candidate->pos().x, candidate->pos().y,
-                      min_dist );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        "(checkTeamPlayer)"
+                        ">>> %d (%.1f %.1f)"
+                        " -> %s player %d %s (%.2f, %.2f) dist=%.2f",
+                        player.unum_,
+                        player.pos_.x, player.pos_.y,
+                        side_str( candidate->side() ),
+                        candidate->unum(),
+                        ( candidate->goalie() ? "goalie" : "field" ),
+                        candidate->pos().x, candidate->pos().y,
+                        min_dist );
 #endif
     }
 
@@ -3285,14 +3473,14 @@ WorldModel::checkTeamPlayer( const SideID side,
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
         min_dist = min_unknown_dist;
-        dlog.addText( Logger::WORLD,
-                      "(checkTeamPlayer)"
-                      ">>> %d (%.1f %.1f)"
-                      " -> unknown player (%.2f, %.2f) dist=%.2f",
-                      player.unum_,
-                      player.pos_.x, player.pos_.y,
-                      candidate->pos().x, candidate->pos().y,
-                      min_dist );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        "(checkTeamPlayer)"
+                        ">>> %d (%.1f %.1f)"
+                        " -> unknown player (%.2f, %.2f) dist=%.2f",
+                        player.unum_,
+                        player.pos_.x, player.pos_.y,
+                        candidate->pos().x, candidate->pos().y,
+                        min_dist );
 #endif
     }
 
@@ -3313,17 +3501,244 @@ WorldModel::checkTeamPlayer( const SideID side,
     //
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-    dlog.addText( Logger::WORLD,
-                  "(checkTeamPlayer)"
-                  " XXX unmatch. min_dist= %.2f"
-                  " generate new known player pos=(%.2f, %.2f)",
-                  min_dist,
-                  player.pos_.x, player.pos_.y );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    "(checkTeamPlayer)"
+                    " XXX unmatch. min_dist= %.2f"
+                    " generate new known player pos=(%.2f, %.2f)",
+                    min_dist,
+                    player.pos_.x, player.pos_.y );
 #endif
 
     new_known_players.emplace_back( side, player );
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+WorldModel::matchTeamPlayers( const SideID side,
+                              const std::vector< Localization::PlayerT > & players,
+                              PlayerObject::List & old_known_players,
+                              PlayerObject::List & old_unknown_players,
+                              PlayerObject::List & new_known_players )
+{
+    // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! //
+    //  if matched player is found, that player is removed from old list
+    //  and updated data is splice to new container
+    // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! //
+
+    std::pmr::memory_resource * resource = scratchResource();
+
+    //////////////////////////////////////////////////////////////////
+    // pre check
+    // unum is seen -> the player that has the same uniform number is matched
+
+    ScratchVector< const Localization::PlayerT * > rows( resource );
+    rows.reserve( players.size() );
+
+    for ( const Localization::PlayerT & player : players )
+    {
+        PlayerObject::List::iterator it = old_known_players.end();
+        if ( player.unum_ != Unum_Unknown )
+        {
+            it = std::find_if( old_known_players.begin(), old_known_players.end(),
+                               [&]( const PlayerObject & p )
+                               {
+                                   return p.unum() == player.unum_;
+                               } );
+        }
+
+        if ( it != old_known_players.end() )
+        {
+            it->updateBySee( side, player );
+            new_known_players.splice( new_known_players.end(),
+                                      old_known_players,
+                                      it );
+        }
+        else
+        {
+            rows.push_back( &player );
+        }
+    }
+
+    if ( rows.empty() )
+    {
+        return;
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // flatten the old players. the known players are followed by the unknown players.
+
+    const double dash_noise = 1.0 + ServerParam::i().playerRand();
+    const double self_error = 0.5 * 2.0;
+    const std::size_t known_size = old_known_players.size();
+
+    ScratchVector< PlayerObject::List::iterator > cols( resource );
+    ScratchVector< Vector2D > col_pos( resource );
+    ScratchVector< double > col_buf( resource );
+    ScratchVector< int > col_unum( resource );
+
+    cols.reserve( known_size + old_unknown_players.size() );
+    col_pos.reserve( cols.capacity() );
+    col_buf.reserve( cols.capacity() );
+    col_unum.reserve( cols.capacity() );
+
+    for ( PlayerObject::List * old_players : { &old_known_players, &old_unknown_players } )
+    {
+        const bool known = ( old_players == &old_known_players );
+        for ( PlayerObject::List::iterator it = old_players->begin(), end = old_players->end();
+              it != end;
+              ++it )
+        {
+            int count = it->seenPosCount();
+            Vector2D old_pos = it->seenPos();
+            double heard_error = 0.0;
+            if ( it->heardPosCount() < it->seenPosCount() )
+            {
+                count = it->heardPosCount();
+                old_pos = it->heardPos();
+                heard_error = 2.0;
+            }
+
+            cols.push_back( it );
+            col_pos.push_back( old_pos );
+            col_buf.push_back( it->playerTypePtr()->realSpeedMax() * dash_noise * count
+                               + heard_error
+                               + self_error );
+            col_unum.push_back( known ? it->unum() : Unum_Unknown );
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // cost matrix. the squared distance of the reachable pair, otherwise forbidden.
+
+    const std::size_t n_rows = rows.size();
+    const std::size_t n_cols = cols.size();
+
+    ScratchVector< double > cost( n_rows * n_cols, AssignmentSolver::FORBIDDEN, resource );
+    ScratchVector< int > col_candidates( n_cols, 0, resource );
+    bool ambiguous = false;
+
+    for ( std::size_t r = 0; r < n_rows; ++r )
+    {
+        const Localization::PlayerT & player = *rows[r];
+        const double row_error = player.dist_error_ * 2.0;
+        double * row_cost = cost.data() + r * n_cols;
+        int row_candidates = 0;
+
+        for ( std::size_t c = 0; c < n_cols; ++c )
+        {
+            if ( player.unum_ != Unum_Unknown
+                 && col_unum[c] != Unum_Unknown
+                 && col_unum[c] != player.unum_ )
+            {
+                continue;
+            }
+
+            const double d2 = player.pos_.dist2( col_pos[c] );
+            const double buf = col_buf[c] + row_error;
+            if ( d2 > buf * buf )
+            {
+                continue;
+            }
+
+            row_cost[c] = d2;
+            ++row_candidates;
+            ++col_candidates[c];
+        }
+
+        if ( row_candidates > 1 )
+        {
+            ambiguous = true;
+        }
+    }
+
+    if ( std::any_of( col_candidates.begin(), col_candidates.end(),
+                      []( const int n ) { return n > 1; } ) )
+    {
+        ambiguous = true;
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // solve the assignment.
+    // if there is no ambiguity, each seen player has at most one candidate
+    // and it is the result of the greedy matching.
+
+    ScratchVector< int > row_to_col( n_rows, -1, resource );
+
+    if ( ! ambiguous )
+    {
+        for ( std::size_t r = 0; r < n_rows; ++r )
+        {
+            const double * row_cost = cost.data() + r * n_cols;
+            for ( std::size_t c = 0; c < n_cols; ++c )
+            {
+                if ( row_cost[c] < AssignmentSolver::FORBIDDEN )
+                {
+                    row_to_col[r] = static_cast< int >( c );
+                    break;
+                }
+            }
+        }
+    }
+    else
+    {
+        AssignmentSolver solver;
+        if ( ! solver.solve( n_rows, n_cols, cost.data(), row_to_col.data() ) )
+        {
+            // too many players. fall back to the greedy matching.
+            for ( const Localization::PlayerT * player : rows )
+            {
+                checkTeamPlayer( side, *player,
+                                 old_known_players, old_unknown_players,
+                                 new_known_players );
+            }
+            return;
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////
+    // update & splice to new list, or generate new player
+
+    for ( std::size_t r = 0; r < n_rows; ++r )
+    {
+        const Localization::PlayerT & player = *rows[r];
+        const int c = row_to_col[r];
+
+        if ( c < 0 )
+        {
+#ifdef DEBUG_PRINT_PLAYER_UPDATE
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            "(matchTeamPlayers)"
+                            " XXX unmatch. generate new known player pos=(%.2f, %.2f)",
+                            player.pos_.x, player.pos_.y );
+#endif
+            new_known_players.emplace_back( side, player );
+            continue;
+        }
+
+        PlayerObject::List::iterator candidate = cols[c];
+#ifdef DEBUG_PRINT_PLAYER_UPDATE
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        "(matchTeamPlayers)"
+                        ">>> %d (%.1f %.1f) -> %s player %d (%.2f, %.2f) dist2=%.2f",
+                        player.unum_,
+                        player.pos_.x, player.pos_.y,
+                        ( static_cast< std::size_t >( c ) < known_size ? "known" : "unknown" ),
+                        candidate->unum(),
+                        candidate->pos().x, candidate->pos().y,
+                        cost[r * n_cols + c] );
+#endif
+        candidate->updateBySee( side, player );
+        new_known_players.splice( new_known_players.end(),
+                                  ( static_cast< std::size_t >( c ) < known_size
+                                    ? old_known_players
+                                    : old_unknown_players ),
+                                  candidate );
+    }
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -3380,19 +3795,19 @@ WorldModel::checkUnknownPlayer( const Localization::PlayerT & player,
                    + player.dist_error_ * 2.0 ) )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-            dlog.addText( Logger::WORLD,
-                          "(checkUnknownPlayer)"
-                          "__ opp %d: dist over."
-                          " dist=%.2f > buf=%.2f"
-                          " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
-                          it->unum(),
-                          d,
-                          it->playerTypePtr()->realSpeedMax() * dash_noise * count
-                          + heard_error
-                          + self_error
-                          + player.dist_error_ * 2.0,
-                          player.pos_.x, player.pos_.y,
-                          old_pos.x, old_pos.y );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            "(checkUnknownPlayer)"
+                            "__ opp %d: dist over."
+                            " dist=%.2f > buf=%.2f"
+                            " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
+                            it->unum(),
+                            d,
+                            it->playerTypePtr()->realSpeedMax() * dash_noise * count
+                            + heard_error
+                            + self_error
+                            + player.dist_error_ * 2.0,
+                            player.pos_.x, player.pos_.y,
+                            old_pos.x, old_pos.y );
 #endif
             continue;
         }
@@ -3400,15 +3815,15 @@ WorldModel::checkUnknownPlayer( const Localization::PlayerT & player,
         if ( d < min_opponent_dist )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-            dlog.addText( Logger::WORLD,
-                          "(checkUnknownPlayer)"
-                          "__ opp player: update."
-                          " dist=%.2f < min_opp_dist=%.2f"
-                          " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
-                          d,
-                          min_opponent_dist,
-                          player.pos_.x, player.pos_.y,
-                          old_pos.x, old_pos.y );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            "(checkUnknownPlayer)"
+                            "__ opp player: update."
+                            " dist=%.2f < min_opp_dist=%.2f"
+                            " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
+                            d,
+                            min_opponent_dist,
+                            player.pos_.x, player.pos_.y,
+                            old_pos.x, old_pos.y );
 #endif
             min_opponent_dist = d;
             candidate_opponent = it;
@@ -3439,19 +3854,19 @@ WorldModel::checkUnknownPlayer( const Localization::PlayerT & player,
                    + player.dist_error_ * 2.0 ) )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-            dlog.addText( Logger::WORLD,
-                          "(checkUnknownPlayer)"
-                          "__ our %d: dist over."
-                          " dist=%.2f > buf=%.2f"
-                          " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
-                          it->unum(),
-                          d,
-                          it->playerTypePtr()->realSpeedMax() * dash_noise * count
-                          + heard_error
-                          + self_error
-                          + player.dist_error_ * 2.0,
-                          player.pos_.x, player.pos_.y,
-                          old_pos.x, old_pos.y );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            "(checkUnknownPlayer)"
+                            "__ our %d: dist over."
+                            " dist=%.2f > buf=%.2f"
+                            " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
+                            it->unum(),
+                            d,
+                            it->playerTypePtr()->realSpeedMax() * dash_noise * count
+                            + heard_error
+                            + self_error
+                            + player.dist_error_ * 2.0,
+                            player.pos_.x, player.pos_.y,
+                            old_pos.x, old_pos.y );
 #endif
             continue;
         }
@@ -3459,15 +3874,15 @@ WorldModel::checkUnknownPlayer( const Localization::PlayerT & player,
         if ( d < min_teammate_dist )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-            dlog.addText( Logger::WORLD,
-                          "(checkUnknownPlayer)"
-                          "__ our player: update."
-                          " dist=%.2f < min_our_dist=%.2f"
-                          " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
-                          d,
-                          min_teammate_dist,
-                          player.pos_.x, player.pos_.y,
-                          old_pos.x, old_pos.y );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            "(checkUnknownPlayer)"
+                            "__ our player: update."
+                            " dist=%.2f < min_our_dist=%.2f"
+                            " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
+                            d,
+                            min_teammate_dist,
+                            player.pos_.x, player.pos_.y,
+                            old_pos.x, old_pos.y );
 #endif
             min_teammate_dist = d;
             candidate_teammate = it;
@@ -3498,18 +3913,18 @@ WorldModel::checkUnknownPlayer( const Localization::PlayerT & player,
                    + player.dist_error_ * 2.0 ) )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-            dlog.addText( Logger::WORLD,
-                          "(checkUnknownPlayer)"
-                          "__ unknown player: dist over."
-                          " dist=%.2f > buf=%.2f"
-                          " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
-                          d,
-                          it->playerTypePtr()->realSpeedMax() * dash_noise * count
-                          + heard_error
-                          + self_error
-                          + player.dist_error_ * 2.0,
-                          player.pos_.x, player.pos_.y,
-                          old_pos.x, old_pos.y );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            "(checkUnknownPlayer)"
+                            "__ unknown player: dist over."
+                            " dist=%.2f > buf=%.2f"
+                            " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
+                            d,
+                            it->playerTypePtr()->realSpeedMax() * dash_noise * count
+                            + heard_error
+                            + self_error
+                            + player.dist_error_ * 2.0,
+                            player.pos_.x, player.pos_.y,
+                            old_pos.x, old_pos.y );
 #endif
             continue;
         }
@@ -3517,15 +3932,15 @@ WorldModel::checkUnknownPlayer( const Localization::PlayerT & player,
         if ( d < min_unknown_dist )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-            dlog.addText( Logger::WORLD,
-                          "(checkUnknownPlayer)"
-                          "__ unknown player: update."
-                          " dist=%.2f < min_unknown_dist=%.2f"
-                          " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
-                          d,
-                          min_unknown_dist,
-                          player.pos_.x, player.pos_.y,
-                          old_pos.x, old_pos.y );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            "(checkUnknownPlayer)"
+                            "__ unknown player: update."
+                            " dist=%.2f < min_unknown_dist=%.2f"
+                            " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
+                            d,
+                            min_unknown_dist,
+                            player.pos_.x, player.pos_.y,
+                            old_pos.x, old_pos.y );
 #endif
             min_unknown_dist = d;
             candidate_unknown = it;
@@ -3551,13 +3966,13 @@ WorldModel::checkUnknownPlayer( const Localization::PlayerT & player,
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
         min_dist = min_teammate_dist;
-        dlog.addText( Logger::WORLD,
-                      "(checkUnknownPlayer)"
-                      ">>> (%.1f %.1f) -> teammate %d (%.1f %.1f) dist=%.2f",
-                      player.pos_.x, player.pos_.y,
-                      candidate->unum(),
-                      candidate->pos().x, candidate->pos().y,
-                      min_dist );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        "(checkUnknownPlayer)"
+                        ">>> (%.1f %.1f) -> teammate %d (%.1f %.1f) dist=%.2f",
+                        player.pos_.x, player.pos_.y,
+                        candidate->unum(),
+                        candidate->pos().x, candidate->pos().y,
+                        min_dist );
 #endif
     }
 
@@ -3573,13 +3988,13 @@ WorldModel::checkUnknownPlayer( const Localization::PlayerT & player,
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
         min_dist = min_opponent_dist;
-        dlog.addText( Logger::WORLD,
-                      "(checkUnknownPlayer)"
-                      ">>> (%.1f %.1f) -> opponent %d (%.1f %.1f) dist=%.2f",
-                      player.pos_.x, player.pos_.y,
-                      candidate->unum(),
-                      candidate->pos().x, candidate->pos().y,
-                      min_dist );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        "(checkUnknownPlayer)"
+                        ">>> (%.1f %.1f) -> opponent %d (%.1f %.1f) dist=%.2f",
+                        player.pos_.x, player.pos_.y,
+                        candidate->unum(),
+                        candidate->pos().x, candidate->pos().y,
+                        min_dist );
 #endif
     }
 
@@ -3595,12 +4010,12 @@ WorldModel::checkUnknownPlayer( const Localization::PlayerT & player,
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
         min_dist = min_unknown_dist;
-        dlog.addText( Logger::WORLD,
-                      "(checkUnknownPlayer)"
-                      ">>> (%.1f %.1f) -> unknown (%.1f %.1f) dist=%.2f",
-                      player.pos_.x, player.pos_.y,
-                      candidate->pos().x, candidate->pos().y,
-                      min_dist );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        "(checkUnknownPlayer)"
+                        ">>> (%.1f %.1f) -> unknown (%.1f %.1f) dist=%.2f",
+                        player.pos_.x, player.pos_.y,
+                        candidate->pos().x, candidate->pos().y,
+                        min_dist );
 #endif
     }
 
@@ -3622,12 +4037,12 @@ WorldModel::checkUnknownPlayer( const Localization::PlayerT & player,
     //////////////////////////////////////////////////////////////////
     // generate new player
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-    dlog.addText( Logger::WORLD,
-                  "(checkUnknownPlayer)"
-                  " XXX unmatch. dist_error=%f"
-                  " generate new unknown player. pos=(%.2f, %.2f)",
-                  player.dist_error_,
-                  player.pos_.x, player.pos_.y );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    "(checkUnknownPlayer)"
+                    " XXX unmatch. dist_error=%f"
+                    " generate new unknown player. pos=(%.2f, %.2f)",
+                    player.dist_error_,
+                    player.pos_.x, player.pos_.y );
 #endif
 
     new_unknown_players.emplace_back( NEUTRAL, player );
@@ -3733,11 +4148,11 @@ WorldModel::estimateUnknownPlayerUnum()
              && unknown_teammate )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (estimateUnknownPlayerUnum)"
-                          " set teammate unum %d (%.1f %.1f)",
-                          *unum_set.begin(),
-                          unknown_teammate->pos().x, unknown_teammate->pos().y );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (estimateUnknownPlayerUnum)"
+                            " set teammate unum %d (%.1f %.1f)",
+                            *unum_set.begin(),
+                            unknown_teammate->pos().x, unknown_teammate->pos().y );
 #endif
             int unum = *unum_set.begin();
             unknown_teammate->setTeam( ourSide(),
@@ -3773,11 +4188,11 @@ WorldModel::estimateUnknownPlayerUnum()
             if ( unknown_opponent )
             {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-                dlog.addText( Logger::WORLD,
-                              __FILE__":(estimateUnknownPlayerUnum)"
-                              " set opponent unum %d (%.1f %.1f)",
-                              *unum_set.begin(),
-                              unknown_opponent->pos().x, unknown_opponent->pos().y );
+                RCSC_DLOG_TEXT( Logger::WORLD,
+                                __FILE__":(estimateUnknownPlayerUnum)"
+                                " set opponent unum %d (%.1f %.1f)",
+                                *unum_set.begin(),
+                                unknown_opponent->pos().x, unknown_opponent->pos().y );
 #endif
                 int unum = *unum_set.begin();
                 unknown_opponent->setTeam( theirSide(),
@@ -3799,6 +4214,117 @@ WorldModel::estimateUnknownPlayerUnum()
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+WorldModel::materializePlayerView( const PlayerView view ) const
+{
+    std::lock_guard< std::mutex > lock( M_player_view_mutex );
+
+    if ( M_dirty_player_views.load( std::memory_order_relaxed ) & view )
+    {
+        sortPlayerView( view );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+WorldModel::sortPlayerView( const PlayerView view ) const
+{
+    switch ( view ) {
+    case VIEW_TEAMMATES_FROM_SELF:
+        std::sort( M_teammates_from_self.begin(), M_teammates_from_self.end(),
+                   []( const PlayerObject * lhs, const PlayerObject * rhs )
+                     {
+                         return lhs->distFromSelf() < rhs->distFromSelf();
+                     } );
+        break;
+    case VIEW_OPPONENTS_FROM_SELF:
+        std::sort( M_opponents_from_self.begin(), M_opponents_from_self.end(),
+                   []( const PlayerObject * lhs, const PlayerObject * rhs )
+                     {
+                         return lhs->distFromSelf() < rhs->distFromSelf();
+                     } );
+        break;
+    case VIEW_TEAMMATES_FROM_BALL:
+        std::sort( M_teammates_from_ball.begin(), M_teammates_from_ball.end(),
+                   []( const PlayerObject * lhs, const PlayerObject * rhs )
+                     {
+                         return lhs->distFromBall() < rhs->distFromBall();
+                     } );
+        break;
+    case VIEW_OPPONENTS_FROM_BALL:
+        std::sort( M_opponents_from_ball.begin(), M_opponents_from_ball.end(),
+                   []( const PlayerObject * lhs, const PlayerObject * rhs )
+                     {
+                         return lhs->distFromBall() < rhs->distFromBall();
+                     } );
+        break;
+    case VIEW_OPPONENT_PROFILE_FROM_SELF:
+        // the profile depends on the order of the sorted opponents.
+        if ( M_dirty_player_views.load( std::memory_order_relaxed ) & VIEW_OPPONENTS_FROM_SELF )
+        {
+            sortPlayerView( VIEW_OPPONENTS_FROM_SELF );
+        }
+        M_opponent_profile_from_self.build( M_opponents_from_self, AngularPlayerProfile::FROM_SELF );
+        break;
+    case VIEW_OPPONENT_PROFILE_FROM_BALL:
+        if ( M_dirty_player_views.load( std::memory_order_relaxed ) & VIEW_OPPONENTS_FROM_BALL )
+        {
+            sortPlayerView( VIEW_OPPONENTS_FROM_BALL );
+        }
+        M_opponent_profile_from_ball.build( M_opponents_from_ball, AngularPlayerProfile::FROM_BALL );
+        break;
+    default:
+        return;
+    }
+
+    M_dirty_player_views.fetch_and( ~static_cast< unsigned int >( view ), std::memory_order_release );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+WorldModel::updatePlayerSnapshot()
+{
+    M_player_snapshot.build( time(), M_all_players );
+
+    for ( const PlayerObject & u : M_unknown_players )
+    {
+        if ( ! M_player_snapshot.add( u ) )
+        {
+            break;
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+WorldModel::updateBallTrajectory()
+{
+    M_ball_trajectory.update( time(), M_ball.pos(), M_ball.vel() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+WorldModel::updateArrivalTimeMap()
+{
+    M_arrival_time_map.update( time(), M_player_snapshot, ourSide(), M_ball.pos() );
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -3832,29 +4358,21 @@ WorldModel::updatePlayerStateCache()
                        ball().pos() );
 
     //
-    // sort by distance from self or ball
+    // create the spatial index
+    //
+    for ( const PlayerObject * p : M_teammates_from_self )
+    {
+        M_player_grid.insert( p->pos(), p );
+    }
+    for ( const PlayerObject * p : M_opponents_from_self )
+    {
+        M_player_grid.insert( p->pos(), p );
+    }
+
+    //
+    // the views sorted by distance or direction are materialized at the first access.
     //
-    std::sort( M_teammates_from_self.begin(), M_teammates_from_self.end(),
-               []( const PlayerObject * lhs, const PlayerObject * rhs )
-                 {
-                     return lhs->distFromSelf() < rhs->distFromSelf();
-                 } );
-    std::sort( M_opponents_from_self.begin(), M_opponents_from_self.end(),
-               []( const PlayerObject * lhs, const PlayerObject * rhs )
-                 {
-                     return lhs->distFromSelf() < rhs->distFromSelf();
-                 } );
-
-    std::sort( M_teammates_from_ball.begin(), M_teammates_from_ball.end(),
-               []( const PlayerObject * lhs, const PlayerObject * rhs )
-                 {
-                     return lhs->distFromBall() < rhs->distFromBall();
-                 } );
-    std::sort( M_opponents_from_ball.begin(), M_opponents_from_ball.end(),
-               []( const PlayerObject * lhs, const PlayerObject * rhs )
-                 {
-                     return lhs->distFromBall() < rhs->distFromBall();
-                 } );
+    M_dirty_player_views.store( VIEW_ALL, std::memory_order_release );
 
     estimateUnknownPlayerUnum();
     estimateGoalie();
@@ -3897,41 +4415,41 @@ WorldModel::updatePlayerStateCache()
     updateKickablePlayers();
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (updatePlayerStateCache) player set." );
-    dlog.addText( Logger::WORLD,
-                  " teammatesFromSelf %zd", M_teammates_from_self.size() );
-    dlog.addText( Logger::WORLD,
-                  " teammatesFromBall %zd", M_teammates_from_ball.size() );
-    dlog.addText( Logger::WORLD,
-                  " opponentsFromSelf %zd", M_opponents_from_self.size() );
-    dlog.addText( Logger::WORLD,
-                  " opponentsFromBall %zd", M_opponents_from_ball.size() );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    __FILE__" (updatePlayerStateCache) player set." );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    " teammatesFromSelf %zd", M_teammates_from_self.size() );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    " teammatesFromBall %zd", M_teammates_from_ball.size() );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    " opponentsFromSelf %zd", M_opponents_from_self.size() );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    " opponentsFromBall %zd", M_opponents_from_ball.size() );
 
     M_teammates.sort( []( const PlayerObject & lhs, const PlayerObject & rhs ) { return lhs.unum() < rhs.unum(); } );
     for ( const PlayerObject & p : M_teammates )
     {
-        dlog.addText( Logger::WORLD,
-                      "teammate id=%d unum=%d (%.1f %.1f) count=%d %s",
-                      p.id(), p.unum(), p.pos().x, p.pos().y, p.posCount(),
-                      ( p.goalie() ? "goalie" : "" ) );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        "teammate id=%d unum=%d (%.1f %.1f) count=%d %s",
+                        p.id(), p.unum(), p.pos().x, p.pos().y, p.posCount(),
+                        ( p.goalie() ? "goalie" : "" ) );
     }
 
     M_opponents.sort( []( const PlayerObject & lhs, const PlayerObject & rhs ) { return lhs.unum() < rhs.unum(); } );
     for ( const PlayerObject & p : M_opponents )
     {
-        dlog.addText( Logger::WORLD,
-                      "opponent id=%d unum=%d (%.1f %.1f) count=%d %s ",
-                      p.id(), p.unum(), p.pos().x, p.pos().y, p.posCount(),
-                      ( p.goalie() ? "goalie" : "" ) );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        "opponent id=%d unum=%d (%.1f %.1f) count=%d %s ",
+                        p.id(), p.unum(), p.pos().x, p.pos().y, p.posCount(),
+                        ( p.goalie() ? "goalie" : "" ) );
     }
 
     for ( const PlayerObject & p : M_unknown_players )
     {
-        dlog.addText( Logger::WORLD,
-                      "unknown id=%d unum=%d (%.1f %.1f) count=%d %s",
-                      p.id(), p.unum(), p.pos().x, p.pos().y, p.posCount(),
-                      ( p.goalie() ? "goalie" : "" ) );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        "unknown id=%d unum=%d (%.1f %.1f) count=%d %s",
+                        p.id(), p.unum(), p.pos().x, p.pos().y, p.posCount(),
+                        ( p.goalie() ? "goalie" : "" ) );
     }
 #endif
 }
@@ -3946,9 +4464,9 @@ WorldModel::estimateGoalie()
     const AbstractPlayerObject * our_goalie = get_our_goalie_loop( *this );
     const AbstractPlayerObject * their_goalie = get_their_goalie_loop( *this );
 #ifdef DEBUG_PRINT_GOALIE_UPDATE
-    dlog.addText( Logger::WORLD,
-                  __FILE__": (estimateGoalie) our_goalie=%d their_goalie=%d",
-                  M_our_goalie_unum, M_their_goalie_unum );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    __FILE__": (estimateGoalie) our_goalie=%d their_goalie=%d",
+                    M_our_goalie_unum, M_their_goalie_unum );
 #endif
     //
     // update teammate goalie's unum
@@ -3958,9 +4476,9 @@ WorldModel::estimateGoalie()
     {
         M_our_goalie_unum = our_goalie->unum();
 #ifdef DEBUG_PRINT_GOALIE_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__": (estimateGoalie) update our_goalie=%d",
-                      M_our_goalie_unum );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__": (estimateGoalie) update our_goalie=%d",
+                        M_our_goalie_unum );
 #endif
     }
 
@@ -3972,9 +4490,9 @@ WorldModel::estimateGoalie()
     {
         M_their_goalie_unum = their_goalie->unum();
 #ifdef DEBUG_PRINT_GOALIE_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__": (estimateGoalie) update their_goalie=%d",
-                      M_their_goalie_unum );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__": (estimateGoalie) update their_goalie=%d",
+                        M_their_goalie_unum );
 #endif
     }
 
@@ -4042,10 +4560,10 @@ WorldModel::estimateOurGoalie()
              && second_min_x > min_x + 10.0 )
         {
 #ifdef DEBUG_PRINT_GOALIE_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__": (estimateOurGoalie) decide our goalie. %d (%.1f %.1f)",
-                          M_our_goalie_unum,
-                          candidate->pos().x, candidate->pos().y );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__": (estimateOurGoalie) decide our goalie. %d (%.1f %.1f)",
+                            M_our_goalie_unum,
+                            candidate->pos().x, candidate->pos().y );
 #endif
             candidate->setTeam( ourSide(),
                                 M_our_goalie_unum,
@@ -4111,10 +4629,10 @@ WorldModel::estimateTheirGoalie()
              && second_max_x < max_x - 10.0 )
         {
 #ifdef DEBUG_PRINT_GOALIE_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__": (estimateTheirGoalie) decide their goalie. %d (%.1f %.1f)",
-                          M_their_goalie_unum,
-                          candidate->pos().x, candidate->pos().y );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__": (estimateTheirGoalie) decide their goalie. %d (%.1f %.1f)",
+                            M_their_goalie_unum,
+                            candidate->pos().x, candidate->pos().y );
 #endif
             candidate->setTeam( theirSide(),
                                 M_their_goalie_unum,
@@ -4134,31 +4652,27 @@ WorldModel::estimateTheirGoalie()
 void
 WorldModel::estimateMaybeKickableTeammate()
 {
-    static GameTime s_update_time( -1, 0 );
-    static int s_previous_teammate_step = 1000;
-    static GameTime s_previous_time( -1, 0 );
-
-    if ( s_update_time == this->time() )
+    if ( M_maybe_kickable_teammate_update_time == this->time() )
     {
         return;
     }
-    s_update_time = this->time();
+    M_maybe_kickable_teammate_update_time = this->time();
 
     M_maybe_kickable_teammate = nullptr;
 
     if ( this->kickableTeammate() )
     {
-        dlog.addText( Logger::WORLD,
-                      __FILE__":(estimateMaybeKickableTeammate) exist normal" );
-        s_previous_teammate_step = 0;
-        s_previous_time = this->time();
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__":(estimateMaybeKickableTeammate) exist normal" );
+        M_maybe_kickable_teammate_previous_step = 0;
+        M_maybe_kickable_teammate_previous_time = this->time();
         M_maybe_kickable_teammate = this->kickableTeammate();
         return;
     }
 
-    if ( s_previous_time.stopped() == 0
-         && s_previous_time.cycle() + 1 == this->time().cycle()
-         && s_previous_teammate_step <= 1
+    if ( M_maybe_kickable_teammate_previous_time.stopped() == 0
+         && M_maybe_kickable_teammate_previous_time.cycle() + 1 == this->time().cycle()
+         && M_maybe_kickable_teammate_previous_step <= 1
          && ! this->teammatesFromBall().empty() )
     {
         const PlayerObject * t =  this->teammatesFromBall().front();
@@ -4167,10 +4681,10 @@ WorldModel::estimateMaybeKickableTeammate()
              && ! this->audioMemory().pass().empty()
              && this->audioMemory().pass().front().sender_ == t->unum() )
         {
-            dlog.addText( Logger::WORLD,
-                          __FILE__":(estimateMaybeKickableTeammate) heard pass kick" );
-            s_previous_teammate_step = this->interceptTable().teammateStep();
-            s_previous_time = this->time();
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__":(estimateMaybeKickableTeammate) heard pass kick" );
+            M_maybe_kickable_teammate_previous_step = this->interceptTable().teammateStep();
+            M_maybe_kickable_teammate_previous_time = this->time();
             M_maybe_kickable_teammate = nullptr;
             return;
         }
@@ -4179,20 +4693,20 @@ WorldModel::estimateMaybeKickableTeammate()
                                    + t->distFromSelf() * 0.05
                                    + this->ball().distFromSelf() * 0.05 ) )
         {
-            dlog.addText( Logger::WORLD,
-                          __FILE__":(estimateMaybeKickableTeammate) found" );
-            s_previous_teammate_step = 1; //this->interceptTable().teammateStep();
-            s_previous_time = this->time();
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__":(estimateMaybeKickableTeammate) found" );
+            M_maybe_kickable_teammate_previous_step = 1; //this->interceptTable().teammateStep();
+            M_maybe_kickable_teammate_previous_time = this->time();
             M_maybe_kickable_teammate = t;
             return;
         }
     }
 
-    s_previous_teammate_step = this->interceptTable().teammateStep();
-    s_previous_time = this->time();
+    M_maybe_kickable_teammate_previous_step = this->interceptTable().teammateStep();
+    M_maybe_kickable_teammate_previous_time = this->time();
 
-    dlog.addText( Logger::WORLD,
-                  __FILE__":(estimateMaybeKickableTeammate) not found" );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    __FILE__":(estimateMaybeKickableTeammate) not found" );
 }
 
 /*-------------------------------------------------------------------*/
@@ -4205,7 +4719,7 @@ WorldModel::updateKickablePlayers()
     //
     // estimate teammate kickable state
     //
-    for ( const PlayerObject * p : M_teammates_from_ball )
+    for ( const PlayerObject * p : teammatesFromBall() )
     {
         if ( p->isGhost()
              || p->isTackling()
@@ -4217,9 +4731,9 @@ WorldModel::updateKickablePlayers()
         if ( p->isKickable( 0.0 ) )
         {
             M_kickable_teammate = p;
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateKickablePlayers) found teammate %d (%.1f %.1f)",
-                          p->unum(), p->pos().x, p->pos().y );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updateKickablePlayers) found teammate %d (%.1f %.1f)",
+                            p->unum(), p->pos().x, p->pos().y );
             break;
         }
     }
@@ -4227,7 +4741,7 @@ WorldModel::updateKickablePlayers()
     //
     // estimate opponent kickable state
     //
-    for ( const PlayerObject * p : M_opponents_from_ball )
+    for ( const PlayerObject * p : opponentsFromBall() )
     {
         if ( p->isGhost()
              || p->isTackling()
@@ -4251,9 +4765,9 @@ WorldModel::updateKickablePlayers()
             if ( p->isKickable( -buf ) )
             {
                 M_maybe_kickable_opponent = p;
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (updateKickablePlayers) maybe opponent %d (%.1f %.1f)",
-                              p->unum(), p->pos().x, p->pos().y );
+                RCSC_DLOG_TEXT( Logger::WORLD,
+                                __FILE__" (updateKickablePlayers) maybe opponent %d (%.1f %.1f)",
+                                p->unum(), p->pos().x, p->pos().y );
             }
         }
 
@@ -4263,9 +4777,9 @@ WorldModel::updateKickablePlayers()
         if ( p->isKickable( -buf ) )
         {
             M_kickable_opponent = p;
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateKickablePlayers) found opponent %d (%.1f %.1f)",
-                          p->unum(), p->pos().x, p->pos().y );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updateKickablePlayers) found opponent %d (%.1f %.1f)",
+                            p->unum(), p->pos().x, p->pos().y );
             break;
         }
     }
@@ -4336,9 +4850,9 @@ WorldModel::updateOffsideLine()
         if ( new_line < heard_x - 1.0 )
         {
 #ifdef DEBUG_PRINT
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateOffsideLine) by heard info. %.1f -> %.1f",
-                          new_line, heard_x );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updateOffsideLine) by heard info. %.1f -> %.1f",
+                            new_line, heard_x );
 #endif
 
             new_line = heard_x;
@@ -4351,9 +4865,9 @@ WorldModel::updateOffsideLine()
     M_offside_line_count = count;
 
 #ifdef DEBUG_PRINT_LINES
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (updateOffsideLine) prev=%.2f x=%.2f count=%d",
-                  M_prev_offside_line_x, new_line, count );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    __FILE__" (updateOffsideLine) prev=%.2f x=%.2f count=%d",
+                    M_prev_offside_line_x, new_line, count );
 #endif
 }
 
@@ -4397,9 +4911,9 @@ WorldModel::updateOurOffenseLine()
     M_our_offense_line_x = new_line;
 
 #ifdef DEBUG_PRINT_LINES
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (updateOurOffenseLine) x=%.2f",
-                  new_line );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    __FILE__" (updateOurOffenseLine) x=%.2f",
+                    new_line );
 #endif
 }
 
@@ -4427,9 +4941,9 @@ WorldModel::updateOurDefenseLine()
     double new_line = second;
 
 #ifdef DEBUG_PRINT
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (updateDefenseLine) base line=%.1f",
-                  new_line );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    __FILE__" (updateDefenseLine) base line=%.1f",
+                    new_line );
 #endif
 
 #if 0
@@ -4439,10 +4953,10 @@ WorldModel::updateOurDefenseLine()
         if ( first > ServerParam::i().ourPenaltyAreaLineX() )
         {
 #ifdef DEBUG_PRINT
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateDefenseLine) goalie not found,"
-                          " assume goalie is back of defense line. %.1f -> %.1f",
-                          new_line, first );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updateDefenseLine) goalie not found,"
+                            " assume goalie is back of defense line. %.1f -> %.1f",
+                            new_line, first );
 #endif
             new_line = first;
         }
@@ -4483,9 +4997,9 @@ WorldModel::updateOurDefenseLine()
         if ( heard_x + 1.0 < new_line )
         {
 #ifdef DEBUG_PRINT
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateDefenseLine) heard defense line is used. %.1f -> %.1f",
-                          new_line, heard_x );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updateDefenseLine) heard defense line is used. %.1f -> %.1f",
+                            new_line, heard_x );
 #endif
 
             new_line = heard_x;
@@ -4495,9 +5009,9 @@ WorldModel::updateOurDefenseLine()
     M_our_defense_line_x = new_line;
 
 #ifdef DEBUG_PRINT_LINES
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (updateOurDefenseLine) %.2f",
-                  new_line );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    __FILE__" (updateOurDefenseLine) %.2f",
+                    new_line );
 #endif
 }
 
@@ -4537,9 +5051,9 @@ WorldModel::updateTheirOffenseLine()
     M_their_offense_line_x = new_line;
 
 #ifdef DEBUG_PRINT_LINES
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (updateTheirOffenseLine) x=%.2f",
-                  new_line );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    __FILE__" (updateTheirOffenseLine) x=%.2f",
+                    new_line );
 #endif
 }
 
@@ -4556,7 +5070,7 @@ WorldModel::updateTheirDefenseLine()
     const PlayerObject * first_player = nullptr;
     const PlayerObject * second_player = nullptr;
 
-    for ( const PlayerObject * p : M_opponents_from_self )
+    for ( const PlayerObject * p : opponentsFromSelf() )
     {
         // 2015-07-14
         // 2023-06-24
@@ -4596,9 +5110,9 @@ WorldModel::updateTheirDefenseLine()
                 opponent_vel *= ptype->playerDecay();
             }
             player_x = opponent_pos.x;
-            dlog.addText( Logger::WORLD,
-                          "(updateTheirDefenseLine) opponent=%d world_x=%.1f predict_x=%.1f",
-                          p->unum(), p->pos().x, player_x );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            "(updateTheirDefenseLine) opponent=%d world_x=%.1f predict_x=%.1f",
+                            p->unum(), p->pos().x, player_x );
 #else
             double rate = 0.1;
             if ( p->vel().x < -ptype->realSpeedMax()*ptype->playerDecay() * 0.8
@@ -4689,9 +5203,9 @@ WorldModel::updateTheirDefenseLine()
     M_their_defense_line_count = count;
 
     //#ifdef DEBUG_PRINT_LINES
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (updateTheirDefenseLine) x=%.2f count=%d",
-                  new_line, count );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    __FILE__" (updateTheirDefenseLine) x=%.2f count=%d",
+                    new_line, count );
     //#endif
 }
 
@@ -4740,10 +5254,10 @@ WorldModel::updatePlayerLines()
             }
         }
 #ifdef DEBUG_PRINT_LINES
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updatePlayerLines) our_offensex=%.2f our_defense=%.2f",
-                      M_our_offense_player_line_x,
-                      M_our_defense_player_line_x );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (updatePlayerLines) our_offensex=%.2f our_defense=%.2f",
+                        M_our_offense_player_line_x,
+                        M_our_defense_player_line_x );
 #endif
     }
 
@@ -4783,10 +5297,10 @@ WorldModel::updatePlayerLines()
             }
         }
 #ifdef DEBUG_PRINT_LINES
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updatePlayerLines) their_offensex=%.2f their_defense=%.2f",
-                      M_their_offense_player_line_x,
-                      M_their_defense_player_line_x );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (updatePlayerLines) their_offensex=%.2f their_defense=%.2f",
+                        M_their_offense_player_line_x,
+                        M_their_defense_player_line_x );
 #endif
     }
 }
@@ -4833,8 +5347,8 @@ WorldModel::updateLastKicker()
         M_last_kicker_side = ourSide();
         M_last_kicker_unum = self().unum();
 #ifdef DEBUG_PRINT_LAST_KICKER
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateLastKicker) self kicked" );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (updateLastKicker) self kicked" );
 #endif
         return;
     }
@@ -4842,8 +5356,8 @@ WorldModel::updateLastKicker()
     if ( ! prevBall().vel().isValid() )
     {
 #ifdef DEBUG_PRINT_LAST_KICKER
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateLastKicker) no previous ball data" );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (updateLastKicker) no previous ball data" );
 #endif
         return;
     }
@@ -4869,10 +5383,10 @@ WorldModel::updateLastKicker()
             {
                 kickers.push_back( p );
 #ifdef DEBUG_PRINT_LAST_KICKER
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (updateLastKicker) see kicking side=%c unum=%d",
-                              ( p->side() == LEFT ? 'L' : p->side() == RIGHT ? 'R' : 'N' ),
-                              p->unum() );
+                RCSC_DLOG_TEXT( Logger::WORLD,
+                                __FILE__" (updateLastKicker) see kicking side=%c unum=%d",
+                                ( p->side() == LEFT ? 'L' : p->side() == RIGHT ? 'R' : 'N' ),
+                                p->unum() );
 #endif
             }
             else if ( p->tackleCount() == 0
@@ -4880,10 +5394,10 @@ WorldModel::updateLastKicker()
             {
                 kickers.push_back( p );
 #ifdef DEBUG_PRINT_LAST_KICKER
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (updateLastKicker) see tackling side=%c unum=%d",
-                              ( p->side() == LEFT ? 'L' : p->side() == RIGHT ? 'R' : 'N' ),
-                              p->unum() );
+                RCSC_DLOG_TEXT( Logger::WORLD,
+                                __FILE__" (updateLastKicker) see tackling side=%c unum=%d",
+                                ( p->side() == LEFT ? 'L' : p->side() == RIGHT ? 'R' : 'N' ),
+                                p->unum() );
 #endif
             }
         }
@@ -4905,11 +5419,11 @@ WorldModel::updateLastKicker()
     {
         ball_vel_changed = true;
 #ifdef DEBUG_PRINT_LAST_KICKER
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateLastKicker) ball vel changed." );
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateLastKicker) speed=%.3f prev_seed=%.3f angle_diff=%.1f",
-                      cur_speed, prev_speed, angle_diff );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (updateLastKicker) ball vel changed." );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (updateLastKicker) speed=%.3f prev_seed=%.3f angle_diff=%.1f",
+                        cur_speed, prev_speed, angle_diff );
 #endif
     }
 
@@ -4930,10 +5444,10 @@ WorldModel::updateLastKicker()
                     M_last_kicker_side = ourSide();
                     M_last_kicker_unum = kicker->unum();
 #ifdef DEBUG_PRINT_LAST_KICKER
-                    dlog.addText( Logger::WORLD,
-                                  __FILE__" (updateLastKicker) set by 1 seen kicker. side=%d unum=%d -> teammate",
-                                  ( kicker->side() == LEFT ? 'L' : kicker->side() == RIGHT ? 'R' : 'N' ),
-                                  kicker->unum() );
+                    RCSC_DLOG_TEXT( Logger::WORLD,
+                                    __FILE__" (updateLastKicker) set by 1 seen kicker. side=%d unum=%d -> teammate",
+                                    ( kicker->side() == LEFT ? 'L' : kicker->side() == RIGHT ? 'R' : 'N' ),
+                                    kicker->unum() );
 #endif
                 }
                 else
@@ -4941,10 +5455,10 @@ WorldModel::updateLastKicker()
                     M_last_kicker_side = theirSide();
                     M_last_kicker_unum = kicker->unum();
 #ifdef DEBUG_PRINT_LAST_KICKER
-                    dlog.addText( Logger::WORLD,
-                                  __FILE__" (updateLastKicker) set by 1 seen kicker. side=%d unum=%d -> opponent",
-                                  kicker->side(),
-                                  kicker->unum() );
+                    RCSC_DLOG_TEXT( Logger::WORLD,
+                                    __FILE__" (updateLastKicker) set by 1 seen kicker. side=%d unum=%d -> opponent",
+                                    kicker->side(),
+                                    kicker->unum() );
 #endif
                 }
                 return;
@@ -4982,9 +5496,9 @@ WorldModel::updateLastKicker()
             M_last_kicker_side = NEUTRAL;
             M_last_kicker_unum = Unum_Unknown;
 #ifdef DEBUG_PRINT_LAST_KICKER
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateLastKicker) set by seen kicker(s). NEUTRAL"
-                          " kicked by teammate and opponent" );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updateLastKicker) set by seen kicker(s). NEUTRAL"
+                            " kicked by teammate and opponent" );
 #endif
         }
         else if ( ! exist_opponent_kicker )
@@ -4992,9 +5506,9 @@ WorldModel::updateLastKicker()
             M_last_kicker_side = ourSide();
             M_last_kicker_unum = teammate_kicker_unum;
 #ifdef DEBUG_PRINT_LAST_KICKER
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateLastKicker) set by seen kicker(s). TEAMMATE"
-                          " kicked by teammate or unknown" );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updateLastKicker) set by seen kicker(s). TEAMMATE"
+                            " kicked by teammate or unknown" );
 #endif
         }
         else if ( ! exist_teammate_kicker )
@@ -5002,9 +5516,9 @@ WorldModel::updateLastKicker()
             M_last_kicker_side = theirSide();
             M_last_kicker_unum = opponent_kicker_unum;
 #ifdef DEBUG_PRINT_LAST_KICKER
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateLastKicker) set by seen kicker(s). OPPONENT"
-                          " kicked by opponent" );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updateLastKicker) set by seen kicker(s). OPPONENT"
+                            " kicked by opponent" );
 #endif
         }
 
@@ -5019,9 +5533,9 @@ WorldModel::updateLastKicker()
             M_last_kicker_side = ourSide();
             M_last_kicker_unum = M_previous_kickable_teammate_unum;
 #ifdef DEBUG_PRINT_LAST_KICKER
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateLastKicker) set by prev teammate kicker %d",
-                          M_previous_kickable_teammate_unum );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updateLastKicker) set by prev teammate kicker %d",
+                            M_previous_kickable_teammate_unum );
 #endif
             return;
         }
@@ -5031,9 +5545,9 @@ WorldModel::updateLastKicker()
             M_last_kicker_side = theirSide();
             M_last_kicker_unum = M_previous_kickable_opponent_unum;
 #ifdef DEBUG_PRINT_LAST_KICKER
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateLastKicker) set by prev opponent kicker %d",
-                          M_previous_kickable_opponent_unum );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updateLastKicker) set by prev opponent kicker %d",
+                            M_previous_kickable_opponent_unum );
 #endif
             return;
         }
@@ -5043,8 +5557,8 @@ WorldModel::updateLastKicker()
             M_last_kicker_side = NEUTRAL;
             M_last_kicker_unum = Unum_Unknown;
 #ifdef DEBUG_PRINT_LAST_KICKER
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateLastKicker) both side kickable in previous cycle. NEUTRAL" );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updateLastKicker) both side kickable in previous cycle. NEUTRAL" );
 #endif
             return;
         }
@@ -5119,13 +5633,13 @@ WorldModel::updateLastKicker()
                     M_last_kicker_side = ourSide();
                     M_last_kicker_unum = nearest->unum();
 #ifdef DEBUG_PRINT_LAST_KICKER
-                    dlog.addText( Logger::WORLD,
-                                  __FILE__" (updateLastKicker) set by nearest teammate or unknown."
-                                  " side=%c unum=%d",
-                                  ( nearest->side() == LEFT ? 'L'
-                                    : nearest->side() == RIGHT ? 'R'
-                                    : 'N' ),
-                                  nearest->unum() );
+                    RCSC_DLOG_TEXT( Logger::WORLD,
+                                    __FILE__" (updateLastKicker) set by nearest teammate or unknown."
+                                    " side=%c unum=%d",
+                                    ( nearest->side() == LEFT ? 'L'
+                                      : nearest->side() == RIGHT ? 'R'
+                                      : 'N' ),
+                                    nearest->unum() );
 #endif
                 }
                 else
@@ -5133,13 +5647,13 @@ WorldModel::updateLastKicker()
                     M_last_kicker_side = theirSide();
                     M_last_kicker_unum = nearest->unum();
 #ifdef DEBUG_PRINT_LAST_KICKER
-                    dlog.addText( Logger::WORLD,
-                                  __FILE__" (updateLastKicker) set by nearest opponent."
-                                  " side=%c unum=%d",
-                                  ( nearest->side() == LEFT ? 'L'
-                                    : nearest->side() == RIGHT ? 'R'
-                                    : 'N' ),
-                                  nearest->unum() );
+                    RCSC_DLOG_TEXT( Logger::WORLD,
+                                    __FILE__" (updateLastKicker) set by nearest opponent."
+                                    " side=%c unum=%d",
+                                    ( nearest->side() == LEFT ? 'L'
+                                      : nearest->side() == RIGHT ? 'R'
+                                      : 'N' ),
+                                    nearest->unum() );
 #endif
                 }
 
@@ -5154,9 +5668,9 @@ WorldModel::updateLastKicker()
                  && M_last_kicker_unum != Unum_Unknown )
             {
 #ifdef DEBUG_PRINT_LAST_KICKER
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (updateLastKicker) keep last kicker. teammate %d",
-                              M_last_kicker_unum );
+                RCSC_DLOG_TEXT( Logger::WORLD,
+                                __FILE__" (updateLastKicker) keep last kicker. teammate %d",
+                                M_last_kicker_unum );
 #endif
             }
             else
@@ -5164,8 +5678,8 @@ WorldModel::updateLastKicker()
                 M_last_kicker_side = NEUTRAL;
                 M_last_kicker_unum = Unum_Unknown;
 #ifdef DEBUG_PRINT_LAST_KICKER
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (updateLastKicker) set NEUTRAL." );
+                RCSC_DLOG_TEXT( Logger::WORLD,
+                                __FILE__" (updateLastKicker) set NEUTRAL." );
 #endif
             }
             return;
@@ -5199,8 +5713,8 @@ WorldModel::updateLastKicker()
             M_last_kicker_side = NEUTRAL;
             M_last_kicker_unum = Unum_Unknown;
 #ifdef DEBUG_PRINT_LAST_KICKER
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateLastKicker) set by seen both side kickers." );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updateLastKicker) set by seen both side kickers." );
 #endif
             return;
         }
@@ -5209,8 +5723,8 @@ WorldModel::updateLastKicker()
             M_last_kicker_side = ourSide();
             M_last_kicker_unum = teammate_kicker_unum;
 #ifdef DEBUG_PRINT_LAST_KICKER
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateLastKicker) set by seen teammate kicker." );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updateLastKicker) set by seen teammate kicker." );
 #endif
             return;
         }
@@ -5219,19 +5733,19 @@ WorldModel::updateLastKicker()
             M_last_kicker_side = theirSide();
             M_last_kicker_unum = opponent_kicker_unum;
 #ifdef DEBUG_PRINT_LAST_KICKER
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateLastKicker) set by seen opponent kicker." );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updateLastKicker) set by seen opponent kicker." );
 #endif
             return;
         }
 
     }
 #ifdef DEBUG_PRINT_LAST_KICKER
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (updateLastKicker) no updated. last_kicker_side=%c",
-                  ( M_last_kicker_side == LEFT  ? 'L'
-                    : M_last_kicker_side == RIGHT ? 'R'
-                    : 'N' ) );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    __FILE__" (updateLastKicker) no updated. last_kicker_side=%c",
+                    ( M_last_kicker_side == LEFT  ? 'L'
+                      : M_last_kicker_side == RIGHT ? 'R'
+                      : 'N' ) );
 #endif
 }
 
@@ -5301,9 +5815,9 @@ WorldModel::checkGhost( const ViewArea & varea )
     //////////////////////////////////////////////////////////////////
     // ball
 #ifdef DEBUG_PRINT
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (checkGhost) ball_count=%d, rpos_count=%d",
-                  ball().posCount(), ball().rposCount() );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    __FILE__" (checkGhost) ball_count=%d, rpos_count=%d",
+                    ball().posCount(), ball().rposCount() );
 #endif
 
     if ( ball().rposCount() > 0
@@ -5318,17 +5832,17 @@ WorldModel::checkGhost( const ViewArea & varea )
 
 #ifdef DEBUG_PRINT_BALL_UPDATE
         Vector2D ballrel = ball().pos() - varea.origin();
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (checkGhost) check ball. global_dist=%.2f."
-                      "  visdist=%.2f.  ",
-                      ballrel.r(), std::sqrt( BALL_VIS_DIST2 ) );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (checkGhost) check ball. global_dist=%.2f."
+                        "  visdist=%.2f.  ",
+                        ballrel.r(), std::sqrt( BALL_VIS_DIST2 ) );
 #endif
 
         if ( varea.contains( ball().pos(), angle_buf, BALL_VIS_DIST2 ) )
         {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (checkGhost) forget ball." );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (checkGhost) forget ball." );
 #endif
             M_ball.setGhost();
         }
@@ -5340,31 +5854,39 @@ WorldModel::checkGhost( const ViewArea & varea )
                   - 0.25 );
     //////////////////////////////////////////////////////////////////
     // players
+    // the view area test is done for all players of each container at once.
+
+    ScratchVector< Vector2D > points( scratchResource() );
+    ScratchVector< unsigned char > in_view_area( scratchResource() );
 
     {
+        check_players_in_view_area( M_teammates, varea, angle_buf, VIS_DIST2, &points, &in_view_area );
+
+        std::size_t i = 0;
         std::list< PlayerObject >::iterator it = M_teammates.begin();
         while ( it != M_teammates.end() )
         {
+            const bool in_view = in_view_area[i++];
             if ( it->posCount() > 0
-                 && varea.contains( it->pos(), angle_buf, VIS_DIST2 ) )
+                 && in_view )
             {
                 if ( it->unum() == Unum_Unknown
                      && it->posCount() >= 10
                      && it->ghostCount() >= 2 )
                 {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-                    dlog.addText( Logger::WORLD,
-                                  __FILE__" (checkGhost) erase teammate (%.1f %.1f)",
-                                  it->pos().x, it->pos().y );
+                    RCSC_DLOG_TEXT( Logger::WORLD,
+                                    __FILE__" (checkGhost) erase teammate (%.1f %.1f)",
+                                    it->pos().x, it->pos().y );
 #endif
                     it = M_teammates.erase( it );
                     continue;
                 }
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (checkGhost) setGhost to teammate %d (%.1f %.1f).",
-                              it->unum(), it->pos().x, it->pos().y );
+                RCSC_DLOG_TEXT( Logger::WORLD,
+                                __FILE__" (checkGhost) setGhost to teammate %d (%.1f %.1f).",
+                                it->unum(), it->pos().x, it->pos().y );
 #endif
                 it->setGhost();
             }
@@ -5374,28 +5896,32 @@ WorldModel::checkGhost( const ViewArea & varea )
     }
 
     {
+        check_players_in_view_area( M_opponents, varea, 1.0, VIS_DIST2, &points, &in_view_area );
+
+        std::size_t i = 0;
         std::list< PlayerObject >::iterator it = M_opponents.begin();
         while ( it != M_opponents.end() )
         {
+            const bool in_view = in_view_area[i++];
             if ( it->posCount() > 0
-                 && varea.contains( it->pos(), 1.0, VIS_DIST2 ) )
+                 && in_view )
             {
                 if ( it->unum() == Unum_Unknown
                      && it->posCount() >= 10
                      && it->ghostCount() >= 2 )
                 {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-                    dlog.addText( Logger::WORLD,
-                                  __FILE__" (checkGhost) erase opponent (%.1f %.1f)",
-                                  it->pos().x, it->pos().y );
+                    RCSC_DLOG_TEXT( Logger::WORLD,
+                                    __FILE__" (checkGhost) erase opponent (%.1f %.1f)",
+                                    it->pos().x, it->pos().y );
 #endif
                     it = M_opponents.erase( it );
                     continue;
                 }
 
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (checkGhost) setGhost to opponent %d (%.1f %.1f).",
-                              it->unum(), it->pos().x, it->pos().y );
+                RCSC_DLOG_TEXT( Logger::WORLD,
+                                __FILE__" (checkGhost) setGhost to opponent %d (%.1f %.1f).",
+                                it->unum(), it->pos().x, it->pos().y );
                 it->setGhost();
             }
 
@@ -5404,28 +5930,32 @@ WorldModel::checkGhost( const ViewArea & varea )
     }
 
     {
+        check_players_in_view_area( M_unknown_players, varea, 1.0, VIS_DIST2, &points, &in_view_area );
+
+        std::size_t i = 0;
         std::list< PlayerObject >::iterator it = M_unknown_players.begin();
         while ( it != M_unknown_players.end() )
         {
+            const bool in_view = in_view_area[i++];
             if ( it->posCount() > 0
-                 && varea.contains( it->pos(), 1.0, VIS_DIST2 ) )
+                 && in_view )
             {
                 if ( it->distFromSelf() < 40.0 * 1.06
                      || it->isGhost() ) // detect twice
                 {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-                    dlog.addText( Logger::WORLD,
-                                  __FILE__" (checkGhost) erase unknown player (%.1f %.1f)",
-                                  it->pos().x, it->pos().y );
+                    RCSC_DLOG_TEXT( Logger::WORLD,
+                                    __FILE__" (checkGhost) erase unknown player (%.1f %.1f)",
+                                    it->pos().x, it->pos().y );
 #endif
                     it = M_unknown_players.erase( it );
                     continue;
                 }
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (checkGhost) setGhost to unknown player (%.1f %.1f)",
-                              it->pos().x, it->pos().y );
+                RCSC_DLOG_TEXT( Logger::WORLD,
+                                __FILE__" (checkGhost) setGhost to unknown player (%.1f %.1f)",
+                                it->pos().x, it->pos().y );
 #endif
                 it->setGhost();
             }
@@ -5465,10 +5995,10 @@ WorldModel::updateDirCount( const ViewArea & varea )
     }
 
 #ifdef DEBUG_PRINT
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (updateDirCount) left=%.1f right=%.1f dir buf=%.3f start_dir=%.1f start_idx=%d",
-                  left_limit.degree(), right_limit.degree(),
-                  dir_buf, dir.degree(), idx );
+    RCSC_DLOG_TEXT( Logger::WORLD,
+                    __FILE__" (updateDirCount) left=%.1f right=%.1f dir buf=%.3f start_dir=%.1f start_idx=%d",
+                    left_limit.degree(), right_limit.degree(),
+                    dir_buf, dir.degree(), idx );
 #endif
 
     while ( dir.isLeftOf( right_limit ) )
@@ -5488,14 +6018,16 @@ WorldModel::updateDirCount( const ViewArea & varea )
         }
         //#ifdef DEBUG
 #if 0
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateDirCount) update dir. index=%d : angle=%.0f",
-                      idx, dir.degree() );
+        RCSC_DLOG_TEXT( Logger::WORLD,
+                        __FILE__" (updateDirCount) update dir. index=%d : angle=%.0f",
+                        idx, dir.degree() );
 #endif
         M_dir_count[idx] = 0;
         dir += DIR_STEP;
     }
 
+    updateDirCountSum();
+
     //#ifdef DEBUG
 #if 0
     if ( dlog.isLogFlag( Logger::WORLD ) )
@@ -5503,9 +6035,9 @@ WorldModel::updateDirCount( const ViewArea & varea )
         double d = -180.0;
         for ( int i = 0; i < DIR_CONF_DIVS; ++i, d += DIR_STEP )
         {
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateDirCount) __ dir count: %.0f - %d",
-                          d, M_dir_count[i] );
+            RCSC_DLOG_TEXT( Logger::WORLD,
+                            __FILE__" (updateDirCount) __ dir count: %.0f - %d",
+                            d, M_dir_count[i] );
         }
     }
 #endif
@@ -5531,22 +6063,19 @@ WorldModel::dirRangeCount( const AngleDeg & angle,
     }
 
     int counter = 0;
-    int tmp_sum_count = 0;
     int tmp_max_count = 0;
 
     AngleDeg tmp_angle = angle;
     if ( width > DIR_STEP ) tmp_angle -= width * 0.5;
 
+    const AngleDeg left_angle = tmp_angle;
+
     double add_dir = 0.0;
     while ( add_dir < width )
     {
-        int c = dirCount( tmp_angle );
-
-        tmp_sum_count += c;
-
-        if ( c > tmp_max_count )
+        if ( max_count )
         {
-            tmp_max_count = c;
+            tmp_max_count = std::max( tmp_max_count, dirCount( tmp_angle ) );
         }
 
         add_dir += DIR_STEP;
@@ -5554,6 +6083,8 @@ WorldModel::dirRangeCount( const AngleDeg & angle,
         ++counter;
     }
 
+    const int tmp_sum_count = dirCountSum( left_angle, counter );
+
     if ( max_count )
     {
         *max_count = tmp_max_count;
@@ -5572,6 +6103,55 @@ WorldModel::dirRangeCount( const AngleDeg & angle,
     return counter;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+WorldModel::updateDirCountSum()
+{
+    M_dir_count_sum[0] = 0;
+    for ( int i = 0; i < DIR_CONF_DIVS; ++i )
+    {
+        M_dir_count_sum[i + 1] = M_dir_count_sum[i] + M_dir_count[i];
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+WorldModel::dirCountSum( const AngleDeg & left_angle,
+                         const int n ) const
+{
+    if ( n <= 0 )
+    {
+        return 0;
+    }
+
+    int first = static_cast< int >( ( left_angle.degree() - 0.5 + 180.0 ) / DIR_STEP );
+    if ( first < 0 || DIR_CONF_DIVS - 1 < first )
+    {
+        first = 0;
+    }
+
+    const int total = M_dir_count_sum[DIR_CONF_DIVS];
+    const int last = first + n % DIR_CONF_DIVS;
+
+    int sum = total * ( n / DIR_CONF_DIVS );
+    if ( last <= DIR_CONF_DIVS )
+    {
+        sum += M_dir_count_sum[last] - M_dir_count_sum[first];
+    }
+    else
+    {
+        sum += ( total - M_dir_count_sum[first] ) + M_dir_count_sum[last - DIR_CONF_DIVS];
+    }
+
+    return sum;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -5581,15 +6161,14 @@ WorldModel::getPointCount( const Vector2D & point,
                            const double & dir_thr ) const
 {
     const double vis_dist2 = square( ServerParam::i().visibleDistance() - 0.1 );
+    const ViewArea::DirThreshold thr( dir_thr );
 
-    int count = 0;
-    for ( ViewAreaCont::const_iterator it = viewAreaCont().begin(), end = viewAreaCont().end();
-          it != end;
-          ++it, ++count )
+    const ViewAreaCont & cont = viewAreaCont();
+    for ( std::size_t count = 0; count < cont.size(); ++count )
     {
-        if ( it->contains( point, dir_thr, vis_dist2 ) )
+        if ( cont[count].contains( point, thr, vis_dist2 ) )
         {
-            return count;
+            return static_cast< int >( count );
         }
     }
 
@@ -5817,4 +6396,39 @@ WorldModel::getPlayerNearestTo( const Vector2D & point,
     return result;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const PlayerObject *
+WorldModel::getPlayerNearestTo( const Vector2D & point,
+                                const bool teammate,
+                                const int count_thr,
+                                double * dist_to_point ) const
+{
+    const SideID our_side = ourSide();
+    const PlayerObject * result = nullptr;
+    double d2 = 0.0;
+
+    if ( ! M_player_grid.nearest( point,
+                                  [&]( const PlayerObject * p )
+                                    {
+                                        return ( teammate
+                                                 ? p->side() == our_side
+                                                 : p->side() != our_side )
+                                            && p->posCount() <= count_thr;
+                                    },
+                                  &result, &d2 ) )
+    {
+        return nullptr;
+    }
+
+    if ( dist_to_point )
+    {
+        *dist_to_point = std::sqrt( d2 );
+    }
+
+    return result;
+}
+
 }
@@ -32,28 +32,39 @@
 #ifndef RCSC_PLAYER_WORLD_MODEL_H
 #define RCSC_PLAYER_WORLD_MODEL_H
 
+#include <rcsc/player/angular_player_profile.h>
+#include <rcsc/player/arrival_time_map.h>
 #include <rcsc/player/self_object.h>
 #include <rcsc/player/ball_object.h>
 #include <rcsc/player/player_object.h>
+#include <rcsc/player/player_snapshot.h>
 #include <rcsc/player/view_area.h>
 #include <rcsc/player/view_grid_map.h>
 #include <rcsc/player/intercept_table.h>
 #include <rcsc/player/penalty_kick_state.h>
+#include <rcsc/player/player_evaluation_cache.h>
+#include <rcsc/common/ball_trajectory_cache.h>
 
 #include <rcsc/time/timer.h>
+#include <rcsc/geom/uniform_grid_2d.h>
 #include <rcsc/geom/vector_2d.h>
 #include <rcsc/game_mode.h>
 #include <rcsc/game_time.h>
 #include <rcsc/types.h>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <memory_resource>
 #include <string>
 
 namespace rcsc {
 
+class AgentContext;
 class AudioMemory;
 class ActionEffector;
 class BodySensor;
+class CycleArena;
 class FullstateSensor;
 class InterceptSimualtorSelf;
 class Localization;
@@ -84,6 +95,12 @@ private:
     std::shared_ptr< Localization > M_localize; //!< localization module
     InterceptTable M_intercept_table; //!< interception info table
     std::shared_ptr< AudioMemory > M_audio_memory; //!< heard message holder
+    CycleArena * M_cycle_arena; //!< per-cycle scratch memory owned by the agent. may be null.
+    AgentContext * M_agent_context; //!< per-agent action caches owned by the agent. may be null.
+    bool M_assignment_player_matching; //!< if true, seen players are matched by the assignment solver.
+
+    //! memo of the player evaluation values. reset in updateJustBeforeDecision().
+    mutable PlayerEvaluationCache M_player_evaluation_cache;
     PenaltyKickState M_penalty_kick_state; //!< penalty kick mode status
 
     //////////////////////////////////////////////////
@@ -103,6 +120,7 @@ private:
 
     TimeStamp M_see_time_stamp; //! time stamp when see received
     TimeStamp M_decision_time_stamp; //! time stamp when action performed
+    Deadline M_decision_deadline; //! time limit of the current decision
 
     GameTime M_last_set_play_start_time; //!< SetPlay started time
     int M_setplay_count; //!< setplay counter
@@ -124,11 +142,21 @@ private:
 
     //////////////////////////////////////////////////
     // object reference (pointers to each object)
-    // these containers are updated just before decision making
-    PlayerObject::Cont M_teammates_from_self; //!< teammates sorted by distance from self
-    PlayerObject::Cont M_opponents_from_self; //!< opponents sorted by distance from ball, include unknown players
-    PlayerObject::Cont M_teammates_from_ball; //!< teammates sorted by distance from self
-    PlayerObject::Cont M_opponents_from_ball; //!< opponents sorted by distance from ball, include unknown players
+    // these containers are updated just before decision making.
+    // the sorted views are filled in updatePlayerStateCache(), but sorted at the first access.
+    mutable PlayerObject::Cont M_teammates_from_self; //!< teammates sorted by distance from self
+    mutable PlayerObject::Cont M_opponents_from_self; //!< opponents sorted by distance from ball, include unknown players
+    mutable PlayerObject::Cont M_teammates_from_ball; //!< teammates sorted by distance from self
+    mutable PlayerObject::Cont M_opponents_from_ball; //!< opponents sorted by distance from ball, include unknown players
+
+    UniformGrid2D< const PlayerObject * > M_player_grid; //!< spatial index of teammates, opponents and unknown players
+    mutable AngularPlayerProfile M_opponent_profile_from_self; //!< opponents sorted by the direction from self, include unknown players
+    mutable AngularPlayerProfile M_opponent_profile_from_ball; //!< opponents sorted by the direction from ball, include unknown players
+
+    //! PlayerView bits of the views not materialized yet
+    mutable std::atomic< unsigned int > M_dirty_player_views;
+    //! lock for the lazy materialization. the const methods may be called from the worker threads.
+    mutable std::mutex M_player_view_mutex;
 
     int M_our_goalie_unum; //!< uniform number of teammate goalie
     int M_their_goalie_unum; //!< uniform number of opponent goalie
@@ -140,6 +168,12 @@ private:
     AbstractPlayerObject * M_our_player_array[12]; //!< unum known teammates (include self)
     AbstractPlayerObject * M_their_player_array[12]; //!< unum known opponents (exclude unknown player)
 
+    PlayerSnapshot M_player_snapshot; //!< packed copy of all players, updated just before decision
+
+    BallTrajectoryCache M_ball_trajectory; //!< predicted ball positions, updated just before decision
+
+    ArrivalTimeMap M_arrival_time_map; //!< arrival steps of both teams, updated just before decision
+
     double M_our_recovery[11]; //!< recovery value for each player
     double M_our_stamina_capacity[11]; //!< stamina capacity for each player
 
@@ -171,6 +205,10 @@ private:
     bool M_previous_kickable_opponent; //! flag for kickable opponents in previous cycle
     int M_previous_kickable_opponent_unum; //! uniform number kickable opponent in previous cycle
 
+    GameTime M_maybe_kickable_teammate_update_time; //!< last time estimateMaybeKickableTeammate() is called
+    GameTime M_maybe_kickable_teammate_previous_time; //!< last time that teammate step was recorded
+    int M_maybe_kickable_teammate_previous_step; //!< teammate step in the previous cycle
+
     SideID M_last_kicker_side; //!< estimated last ball kicker player's side
     int M_last_kicker_unum; //!< estimated last ball kicker player's uniform number
 
@@ -192,6 +230,9 @@ private:
     //! array of direction confidence count
     int M_dir_count[DIR_CONF_DIVS];
 
+    //! prefix sums of M_dir_count. M_dir_count_sum[i] = sum of M_dir_count[0] ... M_dir_count[i-1].
+    int M_dir_count_sum[DIR_CONF_DIVS + 1];
+
     //! view area history
     ViewAreaCont M_view_area_cont;
 
@@ -300,6 +341,65 @@ public:
      */
     void setInterceptSimulator( std::shared_ptr< InterceptSimulatorSelf > self );
 
+    /*!
+      \brief set the per-cycle scratch memory arena
+      \param arena pointer to the arena owned by the agent. null means the default resource.
+     */
+    void setCycleArena( CycleArena * arena )
+      {
+          M_cycle_arena = arena;
+      }
+
+    /*!
+      \brief get the memory resource for the scratch containers released at the next decision
+      \return the arena resource if set, otherwise std::pmr::get_default_resource()
+     */
+    std::pmr::memory_resource * scratchResource() const;
+
+    /*!
+      \brief set the per-agent storage of the action caches
+      \param context pointer to the context owned by the agent. null means the process-wide default context.
+     */
+    void setAgentContext( AgentContext * context )
+      {
+          M_agent_context = context;
+      }
+
+    /*!
+      \brief get the per-agent storage of the action caches
+      \return the agent's context if set, otherwise AgentContext::default_context()
+     */
+    AgentContext & agentContext() const;
+
+    /*!
+      \brief get the memo of the player evaluation values in the current decision
+      \return reference to the cache. all values are discarded in updateJustBeforeDecision().
+     */
+    PlayerEvaluationCache & playerEvaluationCache() const
+      {
+          return M_player_evaluation_cache;
+      }
+
+    /*!
+      \brief set the player matching method used in localizePlayers().
+      \param on if true, all seen players of each side are matched to the old
+      players at once by the minimum cost assignment. otherwise, each seen
+      player is greedily matched to the nearest old player (default).
+     */
+    void setAssignmentPlayerMatching( const bool on )
+      {
+          M_assignment_player_matching = on;
+      }
+
+    /*!
+      \brief set the time limit of the current decision
+      \param deadline deadline object
+     */
+    void setDecisionDeadline( const Deadline & deadline )
+      {
+          M_decision_deadline = deadline;
+      }
+
     /*!
       \brief set server param. this method have to be called only once just after server_param message received.
      */
@@ -520,6 +620,23 @@ private:
                           PlayerObject::List & old_unknown_players,
                           PlayerObject::List & new_known_players );
 
+    /*!
+      \brief match all seen players that have team info at once.
+      the total squared distance of the matched pairs is minimized by the
+      assignment solver. the greedy matching is used when there is no
+      ambiguity or the problem is too large.
+      \param side seen side info
+      \param players localized players
+      \param old_known_players old team known players
+      \param old_unknown_players previous unknown players
+      \param new_known_players new team known players
+    */
+    void matchTeamPlayers( const SideID side,
+                           const std::vector< Localization::PlayerT > & players,
+                           PlayerObject::List & old_known_players,
+                           PlayerObject::List & old_unknown_players,
+                           PlayerObject::List & new_known_players );
+
     /*!
       \brief check player that has no identifier. matching to unknown players
       \param player localized info
@@ -560,6 +677,11 @@ private:
     */
     void updateDirCount( const ViewArea & varea );
 
+    /*!
+      \brief recompute the prefix sums of direction confidence counts
+    */
+    void updateDirCountSum();
+
     /*!
       \brief update ball by heard info
     */
@@ -600,6 +722,63 @@ private:
      */
     void updatePlayerStateCache();
 
+    /*!
+      \brief lazily materialized player views
+     */
+    enum PlayerView {
+        VIEW_TEAMMATES_FROM_SELF = 0x01,
+        VIEW_OPPONENTS_FROM_SELF = 0x02,
+        VIEW_TEAMMATES_FROM_BALL = 0x04,
+        VIEW_OPPONENTS_FROM_BALL = 0x08,
+        VIEW_OPPONENT_PROFILE_FROM_SELF = 0x10,
+        VIEW_OPPONENT_PROFILE_FROM_BALL = 0x20,
+        VIEW_ALL = 0x3f,
+    };
+
+    /*!
+      \brief get the view. the view is sorted if it is the first access in this decision.
+      \param view PlayerView bit
+      \param value reference to the view container
+      \return const reference to the view container
+     */
+    template < typename T >
+    const T & playerView( const PlayerView view,
+                          const T & value ) const
+      {
+          if ( M_dirty_player_views.load( std::memory_order_acquire ) & view )
+          {
+              materializePlayerView( view );
+          }
+          return value;
+      }
+
+    /*!
+      \brief sort the view and clear its dirty flag. thread-safe.
+      \param view PlayerView bit
+     */
+    void materializePlayerView( const PlayerView view ) const;
+
+    /*!
+      \brief sort the view without locking. the caller must hold M_player_view_mutex.
+      \param view PlayerView bit
+     */
+    void sortPlayerView( const PlayerView view ) const;
+
+    /*!
+      \brief rebuild the packed player snapshot.
+     */
+    void updatePlayerSnapshot();
+
+    /*!
+      \brief recompute the predicted ball trajectory.
+     */
+    void updateBallTrajectory();
+
+    /*!
+      \brief rebuild the arrival step map of both teams.
+     */
+    void updateArrivalTimeMap();
+
     /*!
       \brief update our/their goalie
      */
@@ -735,6 +914,12 @@ public:
     */
     const TimeStamp & decisionTimeStamp() const { return M_decision_time_stamp; }
 
+    /*!
+      \brief get the time limit of the current decision.
+      anytime searches can poll it to stop before the next cycle starts.
+    */
+    const Deadline & decisionDeadline() const { return M_decision_deadline; }
+
     /*!
       \brief get last setplay type playmode start time
       \return const reference to the game time object
@@ -781,13 +966,13 @@ public:
       \brief get teammates. the order is undefined.
       \return const reference to the PlayerObject pointer container
     */
-    const PlayerObject::Cont & teammates() const { return M_teammates_from_self; }
+    const PlayerObject::Cont & teammates() const { return playerView( VIEW_TEAMMATES_FROM_SELF, M_teammates_from_self ); }
 
     /*!
       \brief get opponents(include unknown players). the order is undefined
       \return const reference to the PlayerObject container
     */
-    const PlayerObject::Cont & opponents() const { return M_opponents_from_self; }
+    const PlayerObject::Cont & opponents() const { return playerView( VIEW_OPPONENTS_FROM_SELF, M_opponents_from_self ); }
 
     // reference to the sorted players
 
@@ -795,25 +980,25 @@ public:
       \brief get teammates sorted by distance from self
       \return const reference to the PlayerObject pointer container
     */
-    const PlayerObject::Cont & teammatesFromSelf() const { return M_teammates_from_self; }
+    const PlayerObject::Cont & teammatesFromSelf() const { return playerView( VIEW_TEAMMATES_FROM_SELF, M_teammates_from_self ); }
 
     /*!
       \brief get opponents sorted by distance from self (includes unknown players)
       \return const reference to the PlayerObject pointer container
     */
-    const PlayerObject::Cont & opponentsFromSelf() const { return M_opponents_from_self; }
+    const PlayerObject::Cont & opponentsFromSelf() const { return playerView( VIEW_OPPONENTS_FROM_SELF, M_opponents_from_self ); }
 
     /*!
       \brief get teammates sorted by distance from ball
       \return const reference to the PlayerObject pointer container
     */
-    const PlayerObject::Cont & teammatesFromBall() const { return M_teammates_from_ball; }
+    const PlayerObject::Cont & teammatesFromBall() const { return playerView( VIEW_TEAMMATES_FROM_BALL, M_teammates_from_ball ); }
 
     /*!
       \brief get opponents sorted by distance from ball (includes unknown players)
       \return const reference to the PlayerObject pointer container
     */
-    const PlayerObject::Cont & opponentsFromBall() const { return M_opponents_from_ball; }
+    const PlayerObject::Cont & opponentsFromBall() const { return playerView( VIEW_OPPONENTS_FROM_BALL, M_opponents_from_ball ); }
 
     /*!
       \brief get the uniform number of teammate goalie
@@ -845,6 +1030,42 @@ public:
      */
     const AbstractPlayerObject::Cont & theirPlayers() const { return M_their_players; }
 
+    /*!
+      \brief get the packed snapshot of all players (includes self and unknown players).
+      \return const reference to the snapshot updated just before decision making.
+     */
+    const PlayerSnapshot & playerSnapshot() const { return M_player_snapshot; }
+
+    /*!
+      \brief get the ball positions predicted only by inertia from the current ball state.
+      \return const reference to the trajectory updated just before decision making.
+     */
+    const BallTrajectoryCache & ballTrajectory() const { return M_ball_trajectory; }
+
+    /*!
+      \brief get the estimated steps for each team to reach the points on the pitch.
+      \return const reference to the map updated just before decision making.
+     */
+    const ArrivalTimeMap & arrivalTimeMap() const { return M_arrival_time_map; }
+
+    /*!
+      \brief get the spatial index of other players (teammates, opponents and unknown players).
+      \return const reference to the grid updated just before decision making.
+     */
+    const UniformGrid2D< const PlayerObject * > & playerGrid() const { return M_player_grid; }
+
+    /*!
+      \brief get opponents (include unknown players) sorted by the direction from self.
+      \return const reference to the profile updated just before decision making.
+     */
+    const AngularPlayerProfile & opponentProfileFromSelf() const { return playerView( VIEW_OPPONENT_PROFILE_FROM_SELF, M_opponent_profile_from_self ); }
+
+    /*!
+      \brief get opponents (include unknown players) sorted by the direction from ball.
+      \return const reference to the profile updated just before decision making.
+     */
+    const AngularPlayerProfile & opponentProfileFromBall() const { return playerView( VIEW_OPPONENT_PROFILE_FROM_BALL, M_opponent_profile_from_ball ); }
+
     //////////////////////////////////////////////////////////
 
     /*!
@@ -1256,6 +1477,15 @@ public:
                        int * sum_count,
                        int * ave_count ) const;
 
+    /*!
+      \brief get the sum of direction confidence counts of consecutive angle steps in O(1).
+      \param left_angle the direction of the first angle step
+      \param n the number of angle steps. the range is wrapped around at 180 degree.
+      \return sum of count values
+    */
+    int dirCountSum( const AngleDeg & left_angle,
+                     const int n ) const;
+
     /*!
       \brief get view area history container
       \return const refrence to the view area container.
@@ -1353,6 +1583,20 @@ private:
                                              const int count_thr,
                                              double * dist_to_point ) const;
 
+    /*!
+      \brief get teammate or opponent pointer nearest to point using the spatial index (excludes self)
+      \param point considered point
+      \param teammate if true, search teammates. otherwise, search opponents and unknown players.
+      \param count_thr confidence count threshold
+      \param dist_to_point variable pointer to store the distance
+      from retuned player to point
+      \return if found, pointer to player object, othewise NULL
+     */
+    const PlayerObject * getPlayerNearestTo( const Vector2D & point,
+                                             const bool teammate,
+                                             const int count_thr,
+                                             double * dist_to_point ) const;
+
     /*!
       \brief get the distance from input point to the nearest player
       \param players target players
@@ -1381,7 +1625,7 @@ public:
                                      const int count_thr ) const
       {
           double d = DIST_TOO_FAR;
-          const PlayerObject * p = getPlayerNearestTo( point, teammatesFromSelf(), count_thr, &d );
+          const PlayerObject * p = getTeammateNearestTo( point, count_thr, &d );
           return ( p ? d : DIST_TOO_FAR );
       }
 
@@ -1395,7 +1639,7 @@ public:
                                      const int count_thr ) const
       {
           double d = DIST_TOO_FAR;
-          const PlayerObject * p = getPlayerNearestTo( point, opponentsFromSelf(), count_thr, &d );
+          const PlayerObject * p = getOpponentNearestTo( point, count_thr, &d );
           return ( p ? d : DIST_TOO_FAR );
       }
 
@@ -1411,7 +1655,7 @@ public:
                                                const int count_thr,
                                                double * dist_to_point ) const
       {
-          return getPlayerNearestTo( point, teammatesFromSelf(), count_thr, dist_to_point );
+          return getPlayerNearestTo( point, true, count_thr, dist_to_point );
       }
 
     /*!
@@ -1442,7 +1686,7 @@ public:
                                                const int count_thr,
                                                double * dist_to_point ) const
       {
-          return getPlayerNearestTo( point, opponentsFromSelf(), count_thr, dist_to_point );
+          return getPlayerNearestTo( point, false, count_thr, dist_to_point );
       }
 
     /*!
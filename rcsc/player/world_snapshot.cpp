@@ -0,0 +1,161 @@
+// -*-c++-*-
+
+/*!
+  \file world_snapshot.cpp
+  \brief compact copyable world state for look-ahead search Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "world_snapshot.h"
+
+#include "world_model.h"
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <cmath>
+
+namespace rcsc {
+
+static_assert( std::is_trivially_copyable< WorldSnapshot >::value,
+               "WorldSnapshot must be trivially copyable." );
+
+constexpr std::size_t WorldSnapshot::MAX_PLAYERS;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+WorldSnapshot::WorldSnapshot()
+    : M_time( -1, 0 ),
+      M_game_mode(),
+      M_our_side( NEUTRAL ),
+      M_ball(),
+      M_size( 0 ),
+      M_our_size( 0 ),
+      M_offside_line_x( 0.0 ),
+      M_our_defense_line_x( 0.0 ),
+      M_their_defense_line_x( 0.0 )
+{
+    std::fill( M_our_index, M_our_index + 12, -1 );
+    std::fill( M_their_index, M_their_index + 12, -1 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+WorldSnapshot::WorldSnapshot( const WorldModel & wm )
+    : WorldSnapshot()
+{
+    build( wm );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+WorldSnapshot::build( const WorldModel & wm )
+{
+    M_time = wm.time();
+    M_game_mode = wm.gameMode();
+    M_our_side = wm.ourSide();
+
+    M_ball.update( wm.ball() );
+
+    M_offside_line_x = wm.offsideLineX();
+    M_our_defense_line_x = wm.ourDefenseLineX();
+    M_their_defense_line_x = wm.theirDefenseLineX();
+
+    std::fill( M_our_index, M_our_index + 12, -1 );
+    std::fill( M_their_index, M_their_index + 12, -1 );
+
+    //
+    // WorldModel::ourPlayers() starts with the agent itself.
+    //
+
+    M_size = 0;
+    for ( const AbstractPlayerObject * p : wm.ourPlayers() )
+    {
+        if ( M_size >= MAX_PLAYERS ) break;
+
+        if ( 1 <= p->unum() && p->unum() <= 11 )
+        {
+            M_our_index[p->unum()] = static_cast< std::int8_t >( M_size );
+        }
+        M_players[M_size++].update( *p );
+    }
+    M_our_size = M_size;
+
+    for ( const AbstractPlayerObject * p : wm.theirPlayers() )
+    {
+        if ( M_size >= MAX_PLAYERS ) break;
+
+        if ( 1 <= p->unum() && p->unum() <= 11 )
+        {
+            M_their_index[p->unum()] = static_cast< std::int8_t >( M_size );
+        }
+        M_players[M_size++].update( *p );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const PlayerState *
+WorldSnapshot::getNearestTo( const Vector2D & point,
+                             const std::size_t first,
+                             const std::size_t last,
+                             double * dist ) const
+{
+    const PlayerState * result = nullptr;
+    double min_dist2 = std::numeric_limits< double >::max();
+
+    for ( std::size_t i = first; i < last; ++i )
+    {
+        const double d2 = M_players[i].pos().dist2( point );
+        if ( d2 < min_dist2 )
+        {
+            min_dist2 = d2;
+            result = &M_players[i];
+        }
+    }
+
+    if ( dist )
+    {
+        *dist = ( result ? std::sqrt( min_dist2 ) : std::numeric_limits< double >::max() );
+    }
+
+    return result;
+}
+
+}
@@ -0,0 +1,330 @@
+// -*-c++-*-
+
+/*!
+  \file world_snapshot.h
+  \brief compact copyable world state for look-ahead search Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_PLAYER_WORLD_SNAPSHOT_H
+#define RCSC_PLAYER_WORLD_SNAPSHOT_H
+
+#include <rcsc/player/ball_state.h>
+#include <rcsc/player/player_state.h>
+#include <rcsc/geom/vector_2d.h>
+#include <rcsc/game_mode.h>
+#include <rcsc/game_time.h>
+#include <rcsc/types.h>
+
+#include <cstdint>
+#include <cstddef>
+
+namespace rcsc {
+
+class WorldModel;
+
+/*!
+  \class WorldSnapshot
+  \brief compact, trivially copyable copy of the world state for look-ahead search.
+
+  The snapshot is created from WorldModel in O(players) and holds the ball
+  and the known players in fixed size arrays. It has no pointer to the
+  source model, so a plain copy is a fork that can be modified freely by the
+  simulation of a candidate action chain.
+
+  Our players are stored first, and the agent itself is always the index 0.
+  Their players follow them. The line values (offside line etc.) are copied
+  from WorldModel when the snapshot is built and are not updated by the
+  modification of the player positions.
+*/
+class WorldSnapshot {
+public:
+
+    //! maximum number of players stored in the snapshot
+    static constexpr std::size_t MAX_PLAYERS = 22;
+
+private:
+
+    GameTime M_time; //!< game time of this state
+    GameMode M_game_mode; //!< playmode data
+    SideID M_our_side; //!< side of the agent
+
+    BallState M_ball; //!< ball state
+
+    std::size_t M_size; //!< number of stored players
+    std::size_t M_our_size; //!< number of our players including the agent itself
+    PlayerState M_players[MAX_PLAYERS]; //!< player states
+
+    std::int8_t M_our_index[12]; //!< uniform number to index table. -1 means unknown.
+    std::int8_t M_their_index[12]; //!< uniform number to index table. -1 means unknown.
+
+    double M_offside_line_x; //!< offside line x copied from WorldModel
+    double M_our_defense_line_x; //!< our defense line x copied from WorldModel
+    double M_their_defense_line_x; //!< their defense line x copied from WorldModel
+
+public:
+
+    /*!
+      \brief create an empty snapshot
+    */
+    WorldSnapshot();
+
+    /*!
+      \brief create the snapshot of the world model
+      \param wm source world model
+    */
+    explicit
+    WorldSnapshot( const WorldModel & wm );
+
+    /*!
+      \brief copy the current state of the world model
+      \param wm source world model
+    */
+    void build( const WorldModel & wm );
+
+    //
+    // modifiers for the forked state
+    //
+
+    /*!
+      \brief set the game time
+      \param t new game time
+     */
+    void setTime( const GameTime & t )
+      {
+          M_time = t;
+      }
+
+    /*!
+      \brief get the modifiable ball state
+      \return reference to the ball state
+     */
+    BallState & ball()
+      {
+          return M_ball;
+      }
+
+    /*!
+      \brief get the modifiable player state
+      \param i player index
+      \return reference to the player state
+     */
+    PlayerState & player( const std::size_t i )
+      {
+          return M_players[i];
+      }
+
+    //
+    // read-only accessors
+    //
+
+    /*!
+      \brief get the game time of this state
+      \return const reference to the game time
+     */
+    const GameTime & time() const
+      {
+          return M_time;
+      }
+
+    /*!
+      \brief get the playmode of this state
+      \return const reference to the GameMode object
+    */
+    const GameMode & gameMode() const
+      {
+          return M_game_mode;
+      }
+
+    /*!
+      \brief get the side of the agent
+      \return side id
+     */
+    SideID ourSide() const
+      {
+          return M_our_side;
+      }
+
+    /*!
+      \brief get the side of the opponent team
+      \return side id
+     */
+    SideID theirSide() const
+      {
+          return ( M_our_side == LEFT ? RIGHT
+                   : M_our_side == RIGHT ? LEFT
+                   : NEUTRAL );
+      }
+
+    /*!
+      \brief get the ball state
+      \return const reference to the ball state
+     */
+    const BallState & ball() const
+      {
+          return M_ball;
+      }
+
+    /*!
+      \brief get the agent itself
+      \return const reference to the player state
+     */
+    const PlayerState & self() const
+      {
+          return M_players[0];
+      }
+
+    /*!
+      \brief get the number of stored players
+      \return number of players
+     */
+    std::size_t size() const
+      {
+          return M_size;
+      }
+
+    /*!
+      \brief get the player state
+      \param i player index
+      \return const reference to the player state
+     */
+    const PlayerState & player( const std::size_t i ) const
+      {
+          return M_players[i];
+      }
+
+    /*!
+      \brief get the range of our players, [0, ourEnd()). index 0 is the agent itself.
+      \return end index of our players
+     */
+    std::size_t ourEnd() const
+      {
+          return M_our_size;
+      }
+
+    /*!
+      \brief get the begin index of their players. the range is [theirBegin(), size()).
+      \return begin index of their players
+     */
+    std::size_t theirBegin() const
+      {
+          return M_our_size;
+      }
+
+    /*!
+      \brief get our player by the uniform number
+      \param unum uniform number
+      \return const pointer to the player state. if not found, NULL.
+     */
+    const PlayerState * ourPlayer( const int unum ) const
+      {
+          return ( unum < 1 || 11 < unum || M_our_index[unum] < 0
+                   ? nullptr
+                   : &M_players[M_our_index[unum]] );
+      }
+
+    /*!
+      \brief get their player by the uniform number
+      \param unum uniform number
+      \return const pointer to the player state. if not found, NULL.
+     */
+    const PlayerState * theirPlayer( const int unum ) const
+      {
+          return ( unum < 1 || 11 < unum || M_their_index[unum] < 0
+                   ? nullptr
+                   : &M_players[M_their_index[unum]] );
+      }
+
+    /*!
+      \brief get the offside line x copied from WorldModel
+      \return x coordinate value
+     */
+    double offsideLineX() const
+      {
+          return M_offside_line_x;
+      }
+
+    /*!
+      \brief get our defense line x copied from WorldModel
+      \return x coordinate value
+     */
+    double ourDefenseLineX() const
+      {
+          return M_our_defense_line_x;
+      }
+
+    /*!
+      \brief get their defense line x copied from WorldModel
+      \return x coordinate value
+     */
+    double theirDefenseLineX() const
+      {
+          return M_their_defense_line_x;
+      }
+
+    /*!
+      \brief get the teammate nearest to the point. the agent itself is excluded.
+      \param point target point
+      \param dist pointer to the variable to store the distance. may be NULL.
+      \return const pointer to the player state. if not found, NULL.
+     */
+    const PlayerState * getTeammateNearestTo( const Vector2D & point,
+                                              double * dist = nullptr ) const
+      {
+          return getNearestTo( point, 1, M_our_size, dist );
+      }
+
+    /*!
+      \brief get the opponent nearest to the point
+      \param point target point
+      \param dist pointer to the variable to store the distance. may be NULL.
+      \return const pointer to the player state. if not found, NULL.
+     */
+    const PlayerState * getOpponentNearestTo( const Vector2D & point,
+                                              double * dist = nullptr ) const
+      {
+          return getNearestTo( point, M_our_size, M_size, dist );
+      }
+
+private:
+
+    /*!
+      \brief get the player nearest to the point in the index range
+      \param point target point
+      \param first begin index
+      \param last end index
+      \param dist pointer to the variable to store the distance. may be NULL.
+      \return const pointer to the player state. if not found, NULL.
+     */
+    const PlayerState * getNearestTo( const Vector2D & point,
+                                      const std::size_t first,
+                                      const std::size_t last,
+                                      double * dist ) const;
+};
+
+}
+
+#endif
@@ -36,6 +36,9 @@
 #include <rcsc/rcg/util.h>
 #include <rcsc/rcg/handler.h>
 #include <rcsc/rcg/parser.h>
+#include <rcsc/rcg/batch_runner.h>
+#include <rcsc/rcg/event_buffer.h>
+#include <rcsc/rcg/record_patcher.h>
 #include <rcsc/rcg/serializer.h>
 
 #endif
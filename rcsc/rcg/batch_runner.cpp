@@ -0,0 +1,262 @@
+// -*-c++-*-
+
+/*!
+  \file batch_runner.cpp
+  \brief parallel rcg file processing Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "batch_runner.h"
+
+#include "handler.h"
+#include "parser.h"
+
+#include <rcsc/gz/compressed_fstream.h>
+
+#include <sstream>
+#include <iostream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <algorithm>
+
+#ifdef HAVE_GLOB_H
+#include <glob.h>
+#endif
+
+namespace rcsc {
+namespace rcg {
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+BatchRunner::BatchRunner( const int jobs )
+    : M_jobs( jobs )
+{
+    if ( M_jobs <= 0 )
+    {
+        M_jobs = std::max( 1, static_cast< int >( std::thread::hardware_concurrency() ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::vector< std::string >
+BatchRunner::expand( const std::vector< std::string > & patterns )
+{
+    std::vector< std::string > files;
+
+    for ( const std::string & pattern : patterns )
+    {
+#ifdef HAVE_GLOB_H
+        if ( pattern.find_first_of( "*?[" ) != std::string::npos )
+        {
+            glob_t g;
+            const int ret = ::glob( pattern.c_str(), 0, nullptr, &g );
+            if ( ret == 0 )
+            {
+                for ( std::size_t i = 0; i < g.gl_pathc; ++i )
+                {
+                    files.emplace_back( g.gl_pathv[i] );
+                }
+            }
+            ::globfree( &g );
+
+            if ( ret == 0 )
+            {
+                continue;
+            }
+        }
+#endif
+        files.push_back( pattern );
+    }
+
+    return files;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+BatchRunner::parse( const std::string & filepath,
+                    Handler & handler,
+                    const int jobs )
+{
+    Parser::Ptr parser;
+    {
+        compressed_ifstream fin( filepath.c_str() );
+        if ( ! fin.is_open() )
+        {
+            std::cerr << "Failed to open file : " << filepath << std::endl;
+            return false;
+        }
+
+        parser = Parser::create( fin );
+    }
+
+    if ( ! parser )
+    {
+        std::cerr << "Failed to create rcg parser for " << filepath << std::endl;
+        return false;
+    }
+
+    parser->setJobs( jobs );
+
+    // the path based entry point lets each parser select its fastest input method.
+    return parser->parse( filepath, handler );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::vector< BatchRunner::Result >
+BatchRunner::run( const std::vector< std::string > & files,
+                  const Job & job,
+                  std::ostream & os ) const
+{
+    std::vector< Result > results( files.size() );
+    for ( std::size_t i = 0; i < files.size(); ++i )
+    {
+        results[i].filepath_ = files[i];
+        results[i].success_ = false;
+    }
+
+    const auto run_job = [&]( const std::size_t i,
+                              std::ostream & out ) -> bool
+        {
+            try
+            {
+                return job( files[i], out );
+            }
+            catch ( std::exception & e )
+            {
+                std::cerr << "(BatchRunner) " << files[i] << ": " << e.what() << std::endl;
+            }
+            return false;
+        };
+
+    const std::size_t n_threads = std::min( files.size(), static_cast< std::size_t >( M_jobs ) );
+    if ( n_threads <= 1 )
+    {
+        // no buffering is needed.
+        for ( std::size_t i = 0; i < files.size(); ++i )
+        {
+            results[i].success_ = run_job( i, os );
+            os.flush();
+        }
+        return results;
+    }
+
+    std::vector< std::ostringstream > outputs( files.size() );
+    std::vector< char > done( files.size(), 0 );
+    std::mutex mtx;
+    std::condition_variable cond;
+    std::atomic< std::size_t > next( 0 );
+
+    const auto worker = [&]()
+        {
+            while ( true )
+            {
+                const std::size_t i = next.fetch_add( 1 );
+                if ( i >= files.size() )
+                {
+                    break;
+                }
+
+                const bool success = run_job( i, outputs[i] );
+                {
+                    std::lock_guard< std::mutex > lock( mtx );
+                    results[i].success_ = success;
+                    done[i] = 1;
+                }
+                cond.notify_all();
+            }
+        };
+
+    std::vector< std::thread > threads;
+    threads.reserve( n_threads );
+    for ( std::size_t t = 0; t < n_threads; ++t )
+    {
+        threads.emplace_back( worker );
+    }
+
+    // print the outputs in the input order as soon as they are available.
+    for ( std::size_t i = 0; i < files.size(); ++i )
+    {
+        {
+            std::unique_lock< std::mutex > lock( mtx );
+            cond.wait( lock, [&]() { return done[i] != 0; } );
+        }
+
+        os << outputs[i].str();
+        os.flush();
+        outputs[i].str( std::string() );
+    }
+
+    for ( std::thread & t : threads )
+    {
+        t.join();
+    }
+
+    return results;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::vector< BatchRunner::Result >
+BatchRunner::parseAll( const std::vector< std::string > & files,
+                       const HandlerCreator & creator,
+                       std::ostream & os ) const
+{
+    const int file_jobs = ( files.empty()
+                            ? 1
+                            : std::max( 1, M_jobs / static_cast< int >( files.size() ) ) );
+
+    return run( files,
+                [&creator, file_jobs]( const std::string & filepath,
+                                       std::ostream & out ) -> bool
+                  {
+                      std::shared_ptr< Handler > handler = creator( filepath, out );
+                      return handler
+                          && parse( filepath, *handler, file_jobs );
+                  },
+                os );
+}
+
+}
+}
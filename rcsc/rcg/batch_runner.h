@@ -0,0 +1,153 @@
+// -*-c++-*-
+
+/*!
+  \file batch_runner.h
+  \brief parallel rcg file processing Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_RCG_BATCH_RUNNER_H
+#define RCSC_RCG_BATCH_RUNNER_H
+
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace rcsc {
+namespace rcg {
+
+class Handler;
+
+/*!
+  \class BatchRunner
+  \brief run the parser+handler pipelines of many rcg files on a thread pool.
+
+  Each file is processed by its own job. The text written to the given
+  output stream is buffered per file and printed in the order of the input
+  list, so the result does not depend on the number of threads.
+  Jobs run concurrently, so handlers must not modify process wide objects
+  such as ServerParam::instance(). Messages to std::cerr are not ordered.
+*/
+class BatchRunner {
+public:
+
+    /*!
+      \brief per file job.
+      The first argument is the file path, the second is the output stream for the file.
+      The result value is recorded in Result::success_.
+    */
+    using Job = std::function< bool( const std::string &, std::ostream & ) >;
+
+    /*!
+      \brief handler creator.
+      The first argument is the file path, the second is the output stream for the file.
+    */
+    using HandlerCreator = std::function< std::shared_ptr< Handler >( const std::string &, std::ostream & ) >;
+
+    /*!
+      \struct Result
+      \brief result of each file
+    */
+    struct Result {
+        std::string filepath_; //!< processed file path
+        bool success_; //!< job result
+    };
+
+private:
+
+    //! the number of worker threads
+    int M_jobs;
+
+public:
+
+    /*!
+      \brief create the runner
+      \param jobs the number of worker threads. 0 or a negative value means the number of hardware threads.
+    */
+    explicit
+    BatchRunner( const int jobs = 0 );
+
+    /*!
+      \brief get the number of worker threads
+      \return thread count
+    */
+    int jobs() const
+      {
+          return M_jobs;
+      }
+
+    /*!
+      \brief expand wildcard patterns into a file list.
+      \param patterns file paths or glob patterns
+      \return file paths. the matches of each pattern are sorted by name.
+      a pattern that does not match any file is kept as it is.
+    */
+    static
+    std::vector< std::string > expand( const std::vector< std::string > & patterns );
+
+    /*!
+      \brief open the file, create a suitable parser and parse it.
+      \param filepath rcg file path. a compressed file is also accepted.
+      \param handler rcg data handler
+      \param jobs the number of threads used to parse the file. see Parser::setJobs().
+      \return parse result
+    */
+    static
+    bool parse( const std::string & filepath,
+                Handler & handler,
+                const int jobs = 1 );
+
+    /*!
+      \brief run the jobs for all files
+      \param files input file paths
+      \param job job function called for each file
+      \param os output stream that receives the buffered per file outputs in order
+      \return results in the same order as files
+    */
+    std::vector< Result > run( const std::vector< std::string > & files,
+                               const Job & job,
+                               std::ostream & os ) const;
+
+    /*!
+      \brief parse all files by the handlers created for each file
+      \param files input file paths
+      \param creator handler creator called for each file
+      \param os output stream that receives the buffered per file outputs in order
+      \return results in the same order as files
+
+      If there are fewer files than threads, the remaining threads are used to parse each file.
+    */
+    std::vector< Result > parseAll( const std::vector< std::string > & files,
+                                    const HandlerCreator & creator,
+                                    std::ostream & os ) const;
+};
+
+}
+}
+
+#endif
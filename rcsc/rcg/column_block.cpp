@@ -0,0 +1,1035 @@
+// -*-c++-*-
+
+/*!
+  \file column_block.cpp
+  \brief columnar cycle block of the rcg v7 format Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "column_block.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace rcsc {
+namespace rcg {
+
+namespace {
+
+//! column encoding types
+enum ColumnKind {
+    INT_COLUMN = 0, //!< delta-encoded integers
+    SCALED_COLUMN = 1, //!< float values scaled by the power of 10
+    RAW_FLOAT_COLUMN = 2, //!< delta-encoded float bits
+};
+
+//! scale factors of SCALED_COLUMN
+const double POW10[] = { 1.0, 10.0, 100.0, 1000.0, 10000.0, 100000.0, 1000000.0 };
+
+//! the maximum decimal digits tried for SCALED_COLUMN
+constexpr int MAX_DIGITS = 6;
+
+//! the scaled values must be small enough to keep the deltas in 64 bits
+constexpr double MAX_SCALED = 1.0e15;
+
+//! float fields from PLAYER_X to PLAYER_STAMINA_CAPACITY
+float PlayerT::* const PLAYER_FLOATS[] = {
+    &PlayerT::x_,
+    &PlayerT::y_,
+    &PlayerT::vx_,
+    &PlayerT::vy_,
+    &PlayerT::body_,
+    &PlayerT::neck_,
+    &PlayerT::point_x_,
+    &PlayerT::point_y_,
+    &PlayerT::view_width_,
+    &PlayerT::focus_dist_,
+    &PlayerT::focus_dir_,
+    &PlayerT::stamina_,
+    &PlayerT::effort_,
+    &PlayerT::recovery_,
+    &PlayerT::stamina_capacity_,
+};
+
+//! counter fields from PLAYER_KICK_COUNT to PLAYER_CHANGE_FOCUS_COUNT
+UInt16 PlayerT::* const PLAYER_COUNTS[] = {
+    &PlayerT::kick_count_,
+    &PlayerT::dash_count_,
+    &PlayerT::turn_count_,
+    &PlayerT::catch_count_,
+    &PlayerT::move_count_,
+    &PlayerT::turn_neck_count_,
+    &PlayerT::change_view_count_,
+    &PlayerT::say_count_,
+    &PlayerT::tackle_count_,
+    &PlayerT::pointto_count_,
+    &PlayerT::attentionto_count_,
+    &PlayerT::change_focus_count_,
+};
+
+/*-------------------------------------------------------------------*/
+inline
+std::uint64_t
+zigzag( const std::int64_t value )
+{
+    return ( static_cast< std::uint64_t >( value ) << 1 ) ^ static_cast< std::uint64_t >( value >> 63 );
+}
+
+/*-------------------------------------------------------------------*/
+inline
+std::int64_t
+unzigzag( const std::uint64_t value )
+{
+    return static_cast< std::int64_t >( value >> 1 ) ^ -static_cast< std::int64_t >( value & 1 );
+}
+
+/*-------------------------------------------------------------------*/
+inline
+std::uint64_t
+bit_mask( const int width )
+{
+    return ( width >= 64 ? ~std::uint64_t( 0 ) : ( std::uint64_t( 1 ) << width ) - 1 );
+}
+
+/*-------------------------------------------------------------------*/
+void
+put_u8( std::string * out,
+        const unsigned int value )
+{
+    out->push_back( static_cast< char >( value & 0xff ) );
+}
+
+/*-------------------------------------------------------------------*/
+void
+put_u16( std::string * out,
+         const unsigned int value )
+{
+    put_u8( out, value );
+    put_u8( out, value >> 8 );
+}
+
+/*-------------------------------------------------------------------*/
+void
+put_u32( std::string * out,
+         const std::uint32_t value )
+{
+    for ( int i = 0; i < 4; ++i )
+    {
+        put_u8( out, value >> ( i * 8 ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+void
+put_u64( std::string * out,
+         const std::uint64_t value )
+{
+    put_u32( out, static_cast< std::uint32_t >( value ) );
+    put_u32( out, static_cast< std::uint32_t >( value >> 32 ) );
+}
+
+/*-------------------------------------------------------------------*/
+void
+put_varint( std::string * out,
+            std::uint64_t value )
+{
+    while ( value >= 0x80 )
+    {
+        put_u8( out, static_cast< unsigned int >( value | 0x80 ) );
+        value >>= 7;
+    }
+    put_u8( out, static_cast< unsigned int >( value ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief bounds checked little endian reader
+ */
+struct ByteReader {
+    const unsigned char * pos_;
+    const unsigned char * end_;
+    bool good_;
+
+    ByteReader( const char * data,
+                const std::size_t size )
+        : pos_( reinterpret_cast< const unsigned char * >( data ) ),
+          end_( pos_ + size ),
+          good_( true )
+      { }
+
+    bool require( const std::size_t n )
+      {
+          if ( static_cast< std::size_t >( end_ - pos_ ) < n )
+          {
+              good_ = false;
+              pos_ = end_;
+          }
+          return good_;
+      }
+
+    std::uint32_t u8()
+      {
+          if ( ! require( 1 ) ) return 0;
+          return *pos_++;
+      }
+
+    std::uint32_t u16()
+      {
+          if ( ! require( 2 ) ) return 0;
+          const std::uint32_t value = pos_[0] | ( pos_[1] << 8 );
+          pos_ += 2;
+          return value;
+      }
+
+    std::uint32_t u32()
+      {
+          if ( ! require( 4 ) ) return 0;
+          std::uint32_t value = 0;
+          for ( int i = 3; i >= 0; --i )
+          {
+              value = ( value << 8 ) | pos_[i];
+          }
+          pos_ += 4;
+          return value;
+      }
+
+    std::uint64_t u64()
+      {
+          const std::uint64_t low = u32();
+          const std::uint64_t high = u32();
+          return low | ( high << 32 );
+      }
+
+    std::uint64_t varint()
+      {
+          std::uint64_t value = 0;
+          for ( int shift = 0; shift < 64; shift += 7 )
+          {
+              if ( ! require( 1 ) ) return 0;
+              const std::uint32_t b = *pos_++;
+              value |= std::uint64_t( b & 0x7f ) << shift;
+              if ( ! ( b & 0x80 ) )
+              {
+                  return value;
+              }
+          }
+          good_ = false;
+          return 0;
+      }
+
+    const char * bytes( const std::size_t n )
+      {
+          if ( ! require( n ) ) return nullptr;
+          const char * p = reinterpret_cast< const char * >( pos_ );
+          pos_ += n;
+          return p;
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief write the delta-encoded and bit-packed integers.
+  layout: u8 bit width, varint first value, packed deltas
+ */
+void
+encode_ints( const std::vector< std::int64_t > & values,
+             std::string * out )
+{
+    if ( values.empty() )
+    {
+        return;
+    }
+
+    std::uint64_t max_delta = 0;
+    for ( std::size_t i = 1; i < values.size(); ++i )
+    {
+        max_delta = std::max( max_delta, zigzag( values[i] - values[i-1] ) );
+    }
+
+    int width = 0;
+    while ( width < 64 && ( max_delta >> width ) != 0 )
+    {
+        ++width;
+    }
+
+    put_u8( out, width );
+    put_varint( out, zigzag( values.front() ) );
+
+    if ( width == 0 )
+    {
+        return;
+    }
+
+    std::uint64_t acc = 0;
+    int n_bits = 0;
+    for ( std::size_t i = 1; i < values.size(); ++i )
+    {
+        std::uint64_t delta = zigzag( values[i] - values[i-1] );
+        int remain = width;
+        while ( remain > 0 )
+        {
+            const int take = std::min( remain, 64 - n_bits );
+            acc |= ( delta & bit_mask( take ) ) << n_bits;
+            n_bits += take;
+            delta = ( take >= 64 ? 0 : delta >> take );
+            remain -= take;
+
+            if ( n_bits == 64 )
+            {
+                for ( int b = 0; b < 8; ++b )
+                {
+                    put_u8( out, static_cast< unsigned int >( acc >> ( b * 8 ) ) );
+                }
+                acc = 0;
+                n_bits = 0;
+            }
+        }
+    }
+
+    for ( int b = 0; b < n_bits; b += 8 )
+    {
+        put_u8( out, static_cast< unsigned int >( acc >> b ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read the integers written by encode_ints()
+ */
+bool
+decode_ints( ByteReader & reader,
+             const std::size_t count,
+             std::vector< std::int64_t > * values )
+{
+    values->clear();
+    if ( count == 0 )
+    {
+        return true;
+    }
+
+    const int width = static_cast< int >( reader.u8() );
+    std::int64_t value = unzigzag( reader.varint() );
+    if ( ! reader.good_
+         || width > 64 )
+    {
+        return false;
+    }
+
+    values->reserve( count );
+    values->push_back( value );
+
+    if ( width == 0 )
+    {
+        values->resize( count, value );
+        return true;
+    }
+
+    const std::size_t n_bytes = ( ( count - 1 ) * width + 7 ) / 8;
+    const unsigned char * data = reinterpret_cast< const unsigned char * >( reader.bytes( n_bytes ) );
+    if ( ! data )
+    {
+        return false;
+    }
+
+    std::uint64_t bit_pos = 0;
+    for ( std::size_t i = 1; i < count; ++i )
+    {
+        std::uint64_t delta = 0;
+        int got = 0;
+        while ( got < width )
+        {
+            const int offset = static_cast< int >( bit_pos & 7 );
+            const int take = std::min( 8 - offset, width - got );
+            delta |= std::uint64_t( ( data[bit_pos >> 3] >> offset ) & bit_mask( take ) ) << got;
+            got += take;
+            bit_pos += take;
+        }
+
+        value += unzigzag( delta );
+        values->push_back( value );
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+inline
+std::uint32_t
+float_bits( const float value )
+{
+    std::uint32_t bits;
+    std::memcpy( &bits, &value, sizeof( bits ) );
+    return bits;
+}
+
+/*-------------------------------------------------------------------*/
+inline
+float
+bits_float( const std::uint32_t bits )
+{
+    float value;
+    std::memcpy( &value, &bits, sizeof( value ) );
+    return value;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief scale the values by 10^digits if all values are exactly restored.
+ */
+bool
+scale_floats( const std::vector< float > & values,
+              const int digits,
+              std::vector< std::int64_t > * scaled )
+{
+    scaled->clear();
+    for ( const float v : values )
+    {
+        const double d = static_cast< double >( v ) * POW10[digits];
+        if ( ! ( std::fabs( d ) < MAX_SCALED ) )
+        {
+            return false;
+        }
+
+        const std::int64_t q = std::llround( d );
+        // compare the bits to keep the negative zero.
+        if ( float_bits( static_cast< float >( q / POW10[digits] ) ) != float_bits( v ) )
+        {
+            return false;
+        }
+
+        scaled->push_back( q );
+    }
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+void
+encode_floats( const std::vector< float > & values,
+               std::vector< std::int64_t > * work,
+               std::string * out )
+{
+    for ( int digits = 0; digits <= MAX_DIGITS; ++digits )
+    {
+        if ( scale_floats( values, digits, work ) )
+        {
+            put_u8( out, SCALED_COLUMN );
+            put_u8( out, digits );
+            encode_ints( *work, out );
+            return;
+        }
+    }
+
+    work->clear();
+    for ( const float v : values )
+    {
+        work->push_back( float_bits( v ) );
+    }
+    put_u8( out, RAW_FLOAT_COLUMN );
+    put_u8( out, 0 );
+    encode_ints( *work, out );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief decode one column into the integer values and the column type
+ */
+bool
+decode_column_values( ByteReader & reader,
+                      const std::size_t count,
+                      int * kind,
+                      int * digits,
+                      std::vector< std::int64_t > * values )
+{
+    if ( count == 0 )
+    {
+        values->clear();
+        *kind = INT_COLUMN;
+        *digits = 0;
+        return true;
+    }
+
+    *kind = static_cast< int >( reader.u8() );
+    *digits = static_cast< int >( reader.u8() );
+    if ( ! reader.good_
+         || *kind > RAW_FLOAT_COLUMN
+         || *digits > MAX_DIGITS )
+    {
+        return false;
+    }
+
+    return decode_ints( reader, count, values );
+}
+
+/*-------------------------------------------------------------------*/
+inline
+float
+to_float( const int kind,
+          const int digits,
+          const std::int64_t value )
+{
+    return ( kind == RAW_FLOAT_COLUMN
+             ? bits_float( static_cast< std::uint32_t >( value ) )
+             : kind == SCALED_COLUMN
+             ? static_cast< float >( value / POW10[digits] )
+             : static_cast< float >( value ) );
+}
+
+/*-------------------------------------------------------------------*/
+template < typename T >
+void
+append_values( const int kind,
+               const int digits,
+               const std::vector< std::int64_t > & ints,
+               std::vector< T > * values )
+{
+    values->reserve( values->size() + ints.size() );
+    for ( const std::int64_t v : ints )
+    {
+        values->push_back( kind == INT_COLUMN
+                           ? static_cast< T >( v )
+                           : static_cast< T >( to_float( kind, digits, v ) ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+std::int64_t
+get_int( const ShowInfoT & show,
+         const int column )
+{
+    if ( column == ColumnBlock::TIME ) return show.time_;
+    if ( column == ColumnBlock::STIME ) return show.stime_;
+
+    const int c = column - ColumnBlock::PLAYER_BEGIN;
+    const PlayerT & p = show.player_[c / ColumnBlock::PLAYER_COLUMN_SIZE];
+    const int field = c % ColumnBlock::PLAYER_COLUMN_SIZE;
+    switch ( field ) {
+    case ColumnBlock::PLAYER_SIDE: return p.side_;
+    case ColumnBlock::PLAYER_UNUM: return p.unum_;
+    case ColumnBlock::PLAYER_TYPE: return p.type_;
+    case ColumnBlock::PLAYER_VIEW_QUALITY: return p.view_quality_;
+    case ColumnBlock::PLAYER_FOCUS_SIDE: return p.focus_side_;
+    case ColumnBlock::PLAYER_FOCUS_UNUM: return p.focus_unum_;
+    case ColumnBlock::PLAYER_STATE: return p.state_;
+    default:
+        break;
+    }
+    return p.*PLAYER_COUNTS[field - ColumnBlock::PLAYER_KICK_COUNT];
+}
+
+/*-------------------------------------------------------------------*/
+void
+set_int( ShowInfoT & show,
+         const int column,
+         const std::int64_t value )
+{
+    if ( column == ColumnBlock::TIME ) { show.time_ = static_cast< UInt32 >( value ); return; }
+    if ( column == ColumnBlock::STIME ) { show.stime_ = static_cast< UInt32 >( value ); return; }
+
+    const int c = column - ColumnBlock::PLAYER_BEGIN;
+    PlayerT & p = show.player_[c / ColumnBlock::PLAYER_COLUMN_SIZE];
+    const int field = c % ColumnBlock::PLAYER_COLUMN_SIZE;
+    switch ( field ) {
+    case ColumnBlock::PLAYER_SIDE: p.side_ = static_cast< char >( value ); return;
+    case ColumnBlock::PLAYER_UNUM: p.unum_ = static_cast< Int16 >( value ); return;
+    case ColumnBlock::PLAYER_TYPE: p.type_ = static_cast< Int16 >( value ); return;
+    case ColumnBlock::PLAYER_VIEW_QUALITY: p.view_quality_ = static_cast< char >( value ); return;
+    case ColumnBlock::PLAYER_FOCUS_SIDE: p.focus_side_ = static_cast< char >( value ); return;
+    case ColumnBlock::PLAYER_FOCUS_UNUM: p.focus_unum_ = static_cast< Int16 >( value ); return;
+    case ColumnBlock::PLAYER_STATE: p.state_ = static_cast< Int32 >( value ); return;
+    default:
+        break;
+    }
+    p.*PLAYER_COUNTS[field - ColumnBlock::PLAYER_KICK_COUNT] = static_cast< UInt16 >( value );
+}
+
+/*-------------------------------------------------------------------*/
+float
+get_float( const ShowInfoT & show,
+           const int column )
+{
+    switch ( column ) {
+    case ColumnBlock::BALL_X: return show.ball_.x_;
+    case ColumnBlock::BALL_Y: return show.ball_.y_;
+    case ColumnBlock::BALL_VX: return show.ball_.vx_;
+    case ColumnBlock::BALL_VY: return show.ball_.vy_;
+    default:
+        break;
+    }
+
+    const int c = column - ColumnBlock::PLAYER_BEGIN;
+    const PlayerT & p = show.player_[c / ColumnBlock::PLAYER_COLUMN_SIZE];
+    return p.*PLAYER_FLOATS[c % ColumnBlock::PLAYER_COLUMN_SIZE - ColumnBlock::PLAYER_X];
+}
+
+/*-------------------------------------------------------------------*/
+void
+set_float( ShowInfoT & show,
+           const int column,
+           const float value )
+{
+    switch ( column ) {
+    case ColumnBlock::BALL_X: show.ball_.x_ = value; return;
+    case ColumnBlock::BALL_Y: show.ball_.y_ = value; return;
+    case ColumnBlock::BALL_VX: show.ball_.vx_ = value; return;
+    case ColumnBlock::BALL_VY: show.ball_.vy_ = value; return;
+    default:
+        break;
+    }
+
+    const int c = column - ColumnBlock::PLAYER_BEGIN;
+    PlayerT & p = show.player_[c / ColumnBlock::PLAYER_COLUMN_SIZE];
+    p.*PLAYER_FLOATS[c % ColumnBlock::PLAYER_COLUMN_SIZE - ColumnBlock::PLAYER_X] = value;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief parsed block header
+ */
+struct BlockLayout {
+    std::size_t shows_;
+    std::size_t events_;
+    const char * event_data_;
+    std::size_t event_size_;
+    std::vector< std::uint32_t > offsets_;
+    const char * column_data_;
+    std::size_t column_size_;
+};
+
+/*-------------------------------------------------------------------*/
+bool
+read_layout( const char * data,
+             const std::size_t size,
+             BlockLayout * layout )
+{
+    ByteReader reader( data, size );
+
+    layout->shows_ = reader.u32();
+    layout->events_ = reader.u32();
+    layout->event_size_ = reader.u32();
+    layout->event_data_ = reader.bytes( layout->event_size_ );
+
+    const std::uint32_t n_columns = reader.u16();
+    if ( ! reader.good_
+         || layout->shows_ > ColumnBlock::MAX_SHOWS
+         || n_columns != static_cast< std::uint32_t >( ColumnBlock::COLUMN_SIZE ) )
+    {
+        return false;
+    }
+
+    layout->offsets_.resize( n_columns + 1 );
+    for ( std::uint32_t & offset : layout->offsets_ )
+    {
+        offset = reader.u32();
+    }
+
+    layout->column_size_ = reader.end_ - reader.pos_;
+    layout->column_data_ = reader.bytes( layout->column_size_ );
+
+    if ( ! reader.good_
+         || layout->offsets_.back() > layout->column_size_ )
+    {
+        return false;
+    }
+
+    for ( std::uint32_t i = 0; i < n_columns; ++i )
+    {
+        if ( layout->offsets_[i] > layout->offsets_[i+1] )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
+
+const int ColumnBlock::REVISION = 1;
+const std::size_t ColumnBlock::MAX_SHOWS = 256;
+const char ColumnBlock::BLOCK_TAG = 'B';
+const char ColumnBlock::FOOTER_TAG = 'F';
+const std::size_t ColumnBlock::HEADER_SIZE = 12;
+const int ColumnBlock::COLUMN_SIZE = ColumnBlock::PLAYER_BEGIN + MAX_PLAYER * 2 * ColumnBlock::PLAYER_COLUMN_SIZE;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ColumnBlock::isFloatColumn( const int column )
+{
+    if ( column < PLAYER_BEGIN )
+    {
+        return column >= BALL_X;
+    }
+
+    const int field = ( column - PLAYER_BEGIN ) % PLAYER_COLUMN_SIZE;
+    return ( PLAYER_X <= field && field <= PLAYER_STAMINA_CAPACITY );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+unsigned int
+ColumnBlock::columnField( const int column )
+{
+    if ( column < BALL_X )
+    {
+        return Projection::ALL_FIELDS;
+    }
+
+    if ( column < PLAYER_BEGIN )
+    {
+        return Projection::BALL;
+    }
+
+    switch ( ( column - PLAYER_BEGIN ) % PLAYER_COLUMN_SIZE ) {
+    case PLAYER_SIDE:
+    case PLAYER_UNUM:
+        return Projection::PLAYERS;
+    case PLAYER_VIEW_QUALITY:
+    case PLAYER_FOCUS_SIDE:
+    case PLAYER_FOCUS_UNUM:
+    case PLAYER_VIEW_WIDTH:
+    case PLAYER_FOCUS_DIST:
+    case PLAYER_FOCUS_DIR:
+        return Projection::PLAYER_VIEW;
+    case PLAYER_STAMINA:
+    case PLAYER_EFFORT:
+    case PLAYER_RECOVERY:
+    case PLAYER_STAMINA_CAPACITY:
+        return Projection::PLAYER_STAMINA;
+    case PLAYER_TYPE:
+    case PLAYER_STATE:
+    case PLAYER_X:
+    case PLAYER_Y:
+    case PLAYER_VX:
+    case PLAYER_VY:
+    case PLAYER_BODY:
+    case PLAYER_NECK:
+    case PLAYER_POINT_X:
+    case PLAYER_POINT_Y:
+        return Projection::PLAYER_POSITION;
+    default:
+        break;
+    }
+
+    return Projection::PLAYER_COUNT;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ColumnBlock::clear()
+{
+    M_shows.clear();
+    M_events.clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ColumnBlock::encode( std::string * out ) const
+{
+    put_u32( out, static_cast< std::uint32_t >( M_shows.size() ) );
+    put_u32( out, static_cast< std::uint32_t >( M_events.size() ) );
+
+    std::string events;
+    for ( const Event & e : M_events )
+    {
+        put_varint( &events, e.position_ );
+        put_varint( &events, e.line_.size() );
+        events += e.line_;
+    }
+    put_u32( out, static_cast< std::uint32_t >( events.size() ) );
+    out->append( events );
+
+    std::string columns;
+    std::vector< std::uint32_t > offsets;
+    offsets.reserve( COLUMN_SIZE + 1 );
+
+    std::vector< std::int64_t > ints;
+    std::vector< float > floats;
+    ints.reserve( M_shows.size() );
+    floats.reserve( M_shows.size() );
+
+    for ( int column = 0; column < COLUMN_SIZE; ++column )
+    {
+        offsets.push_back( static_cast< std::uint32_t >( columns.size() ) );
+        if ( M_shows.empty() )
+        {
+            continue;
+        }
+
+        if ( isFloatColumn( column ) )
+        {
+            floats.clear();
+            for ( const ShowInfoT & show : M_shows )
+            {
+                floats.push_back( get_float( show, column ) );
+            }
+            encode_floats( floats, &ints, &columns );
+        }
+        else
+        {
+            ints.clear();
+            for ( const ShowInfoT & show : M_shows )
+            {
+                ints.push_back( get_int( show, column ) );
+            }
+            put_u8( &columns, INT_COLUMN );
+            put_u8( &columns, 0 );
+            encode_ints( ints, &columns );
+        }
+    }
+    offsets.push_back( static_cast< std::uint32_t >( columns.size() ) );
+
+    put_u16( out, COLUMN_SIZE );
+    for ( const std::uint32_t offset : offsets )
+    {
+        put_u32( out, offset );
+    }
+    out->append( columns );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ColumnBlock::decode( const char * data,
+                     const std::size_t size,
+                     const unsigned int fields )
+{
+    clear();
+
+    BlockLayout layout;
+    if ( ! read_layout( data, size, &layout ) )
+    {
+        return false;
+    }
+
+    ByteReader events( layout.event_data_, layout.event_size_ );
+    M_events.resize( layout.events_ );
+    for ( Event & e : M_events )
+    {
+        e.position_ = static_cast< std::uint32_t >( events.varint() );
+        const std::size_t len = events.varint();
+        const char * line = events.bytes( len );
+        if ( ! line
+             || e.position_ > layout.shows_ )
+        {
+            return false;
+        }
+        e.line_.assign( line, len );
+    }
+
+    M_shows.resize( layout.shows_ );
+
+    std::vector< std::int64_t > values;
+    for ( int column = 0; column < COLUMN_SIZE; ++column )
+    {
+        if ( column >= BALL_X
+             && ! ( columnField( column ) & fields ) )
+        {
+            continue;
+        }
+
+        ByteReader reader( layout.column_data_ + layout.offsets_[column],
+                           layout.offsets_[column+1] - layout.offsets_[column] );
+        int kind = INT_COLUMN;
+        int digits = 0;
+        if ( ! decode_column_values( reader, layout.shows_, &kind, &digits, &values ) )
+        {
+            return false;
+        }
+
+        if ( isFloatColumn( column ) )
+        {
+            for ( std::size_t i = 0; i < values.size(); ++i )
+            {
+                set_float( M_shows[i], column, to_float( kind, digits, values[i] ) );
+            }
+        }
+        else
+        {
+            for ( std::size_t i = 0; i < values.size(); ++i )
+            {
+                set_int( M_shows[i], column, values[i] );
+            }
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ColumnBlock::decodeColumn( const char * data,
+                           const std::size_t size,
+                           const int column,
+                           std::vector< double > * values )
+{
+    if ( column < 0 || COLUMN_SIZE <= column )
+    {
+        return false;
+    }
+
+    BlockLayout layout;
+    if ( ! read_layout( data, size, &layout ) )
+    {
+        return false;
+    }
+
+    return decodeColumnData( layout.column_data_ + layout.offsets_[column],
+                             layout.offsets_[column+1] - layout.offsets_[column],
+                             column,
+                             layout.shows_,
+                             values );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ColumnBlock::decodeColumnData( const char * data,
+                               const std::size_t size,
+                               const int column,
+                               const std::size_t count,
+                               std::vector< double > * values )
+{
+    if ( column < 0 || COLUMN_SIZE <= column )
+    {
+        return false;
+    }
+
+    ByteReader reader( data, size );
+    int kind = INT_COLUMN;
+    int digits = 0;
+    std::vector< std::int64_t > ints;
+    if ( ! decode_column_values( reader, count, &kind, &digits, &ints ) )
+    {
+        return false;
+    }
+
+    append_values( kind, digits, ints, values );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ColumnBlock::decodeColumnData( const char * data,
+                               const std::size_t size,
+                               const int column,
+                               const std::size_t count,
+                               std::vector< float > * values )
+{
+    if ( column < 0 || COLUMN_SIZE <= column )
+    {
+        return false;
+    }
+
+    ByteReader reader( data, size );
+    int kind = INT_COLUMN;
+    int digits = 0;
+    std::vector< std::int64_t > ints;
+    if ( ! decode_column_values( reader, count, &kind, &digits, &ints ) )
+    {
+        return false;
+    }
+
+    append_values( kind, digits, ints, values );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ColumnBlock::encodeIndex( const std::vector< IndexEntry > & index,
+                          std::string * out )
+{
+    put_u32( out, static_cast< std::uint32_t >( index.size() ) );
+    for ( const IndexEntry & e : index )
+    {
+        put_u64( out, e.offset_ );
+        put_u32( out, e.shows_ );
+        put_u32( out, e.first_time_ );
+        put_u32( out, e.last_time_ );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ColumnBlock::decodeIndex( const char * data,
+                          const std::size_t size,
+                          std::vector< IndexEntry > * index )
+{
+    ByteReader reader( data, size );
+
+    const std::uint32_t n = reader.u32();
+    if ( ! reader.good_
+         || n > size / 20 )
+    {
+        return false;
+    }
+
+    index->resize( n );
+    for ( IndexEntry & e : *index )
+    {
+        e.offset_ = reader.u64();
+        e.shows_ = reader.u32();
+        e.first_time_ = reader.u32();
+        e.last_time_ = reader.u32();
+    }
+
+    return reader.good_;
+}
+
+}
+}
@@ -0,0 +1,347 @@
+// -*-c++-*-
+
+/*!
+  \file column_block.h
+  \brief columnar cycle block of the rcg v7 format Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_RCG_COLUMN_BLOCK_H
+#define RCSC_RCG_COLUMN_BLOCK_H
+
+#include <rcsc/rcg/handler.h>
+#include <rcsc/rcg/types.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace rcsc {
+namespace rcg {
+
+/*!
+  \class ColumnBlock
+  \brief a fixed number of cycles stored in the columnar layout of the rcg v7 format.
+
+  Every field of ShowInfoT is stored as one column per block.
+  Float values are scaled to integers by the smallest decimal precision that
+  restores exactly the same bits, or kept as raw bits if no precision does.
+  Each integer column is delta-encoded and bit-packed by the width of its
+  largest delta, so constant columns need only a few bytes.
+  The other records (playmode, team, params, messages) are kept as text lines
+  with the position of the show that follows them.
+
+  Block layout (little endian):
+  \verbatim
+  u32 show count
+  u32 event count
+  u32 event data size
+  events: varint position, varint length, text line
+  u16 column count
+  u32 column offsets[column count + 1], relative to the first column
+  column data
+  \endverbatim
+*/
+class ColumnBlock {
+public:
+
+    //! revision of the rcg v7 format written after the magic
+    static const int REVISION;
+
+    //! the maximum number of shows in one block
+    static const std::size_t MAX_SHOWS;
+
+    //! record tag of a block in the rcg v7 file
+    static const char BLOCK_TAG;
+
+    //! record tag of the footer index in the rcg v7 file
+    static const char FOOTER_TAG;
+
+    //! byte size of the fixed part at the beginning of a block (show count, event count, event data size)
+    static const std::size_t HEADER_SIZE;
+
+    //! column ids of the global fields
+    enum Column {
+        TIME = 0,
+        STIME,
+        BALL_X,
+        BALL_Y,
+        BALL_VX,
+        BALL_VY,
+        PLAYER_BEGIN, //!< the first player column. see playerColumn().
+    };
+
+    //! column ids of each player field, relative to the player's first column
+    enum PlayerColumn {
+        PLAYER_SIDE = 0,
+        PLAYER_UNUM,
+        PLAYER_TYPE,
+        PLAYER_VIEW_QUALITY,
+        PLAYER_FOCUS_SIDE,
+        PLAYER_FOCUS_UNUM,
+        PLAYER_STATE,
+        PLAYER_X,
+        PLAYER_Y,
+        PLAYER_VX,
+        PLAYER_VY,
+        PLAYER_BODY,
+        PLAYER_NECK,
+        PLAYER_POINT_X,
+        PLAYER_POINT_Y,
+        PLAYER_VIEW_WIDTH,
+        PLAYER_FOCUS_DIST,
+        PLAYER_FOCUS_DIR,
+        PLAYER_STAMINA,
+        PLAYER_EFFORT,
+        PLAYER_RECOVERY,
+        PLAYER_STAMINA_CAPACITY,
+        PLAYER_KICK_COUNT,
+        PLAYER_DASH_COUNT,
+        PLAYER_TURN_COUNT,
+        PLAYER_CATCH_COUNT,
+        PLAYER_MOVE_COUNT,
+        PLAYER_TURN_NECK_COUNT,
+        PLAYER_CHANGE_VIEW_COUNT,
+        PLAYER_SAY_COUNT,
+        PLAYER_TACKLE_COUNT,
+        PLAYER_POINTTO_COUNT,
+        PLAYER_ATTENTIONTO_COUNT,
+        PLAYER_CHANGE_FOCUS_COUNT,
+        PLAYER_COLUMN_SIZE,
+    };
+
+    //! the number of columns
+    static const int COLUMN_SIZE;
+
+    /*!
+      \struct Event
+      \brief a non-positional record
+     */
+    struct Event {
+        std::uint32_t position_; //!< the index of the show that follows this record
+        std::string line_; //!< v4 text format line without the new line character
+    };
+
+    /*!
+      \struct IndexEntry
+      \brief footer index entry of a block
+     */
+    struct IndexEntry {
+        std::uint64_t offset_; //!< byte offset of the block record from the beginning of the file
+        std::uint32_t shows_; //!< show count
+        std::uint32_t first_time_; //!< game time of the first show
+        std::uint32_t last_time_; //!< game time of the last show
+    };
+
+private:
+
+    std::vector< ShowInfoT > M_shows; //!< show data
+    std::vector< Event > M_events; //!< the other records
+
+public:
+
+    /*!
+      \brief get the column id of the player field
+      \param index player index in ShowInfoT::player_
+      \param field player field id
+      \return column id
+     */
+    static
+    int playerColumn( const int index,
+                      const PlayerColumn field )
+      {
+          return PLAYER_BEGIN + index * PLAYER_COLUMN_SIZE + field;
+      }
+
+    /*!
+      \brief check if the column holds float values
+      \param column column id
+      \return true if a float column
+     */
+    static
+    bool isFloatColumn( const int column );
+
+    /*!
+      \brief get the projection field group of the column
+      \param column column id
+      \return bit set of Projection::Field. the time columns belong to all groups.
+     */
+    static
+    unsigned int columnField( const int column );
+
+    /*!
+      \brief remove all data. allocated memory is kept.
+     */
+    void clear();
+
+    /*!
+      \brief check if no data is held
+      \return true if empty
+     */
+    bool empty() const
+      {
+          return M_shows.empty() && M_events.empty();
+      }
+
+    /*!
+      \brief check if no more show can be added
+      \return true if full
+     */
+    bool full() const
+      {
+          return M_shows.size() >= MAX_SHOWS;
+      }
+
+    /*!
+      \brief get the show data
+      \return const reference to the container
+     */
+    const std::vector< ShowInfoT > & shows() const
+      {
+          return M_shows;
+      }
+
+    /*!
+      \brief get the non-positional records
+      \return const reference to the container
+     */
+    const std::vector< Event > & events() const
+      {
+          return M_events;
+      }
+
+    /*!
+      \brief add a show
+      \param show show data
+     */
+    void addShow( const ShowInfoT & show )
+      {
+          M_shows.push_back( show );
+      }
+
+    /*!
+      \brief add a non-positional record before the next show
+      \param line text line without the new line character
+     */
+    void addEvent( const std::string & line )
+      {
+          M_events.push_back( Event{ static_cast< std::uint32_t >( M_shows.size() ), line } );
+      }
+
+    /*!
+      \brief append the encoded block to the buffer
+      \param out pointer to the output buffer
+     */
+    void encode( std::string * out ) const;
+
+    /*!
+      \brief decode the block
+      \param data pointer to the beginning of the block
+      \param size block size
+      \param fields bit set of Projection::Field to be decoded.
+      \return true if successfully decoded
+
+      The events and the time columns are always decoded.
+      The other fields of the excluded columns keep their default values.
+     */
+    bool decode( const char * data,
+                 const std::size_t size,
+                 const unsigned int fields = Projection::ALL_FIELDS );
+
+    /*!
+      \brief decode only one column of the encoded block
+      \param data pointer to the beginning of the block
+      \param size block size
+      \param column column id
+      \param values pointer to the container. decoded values are appended.
+      \return true if successfully decoded
+     */
+    static
+    bool decodeColumn( const char * data,
+                       const std::size_t size,
+                       const int column,
+                       std::vector< double > * values );
+
+    /*!
+      \brief decode the data of one column
+      \param data pointer to the column data
+      \param size column data size
+      \param column column id
+      \param count the number of shows in the block
+      \param values pointer to the container. decoded values are appended.
+      \return true if successfully decoded
+     */
+    static
+    bool decodeColumnData( const char * data,
+                           const std::size_t size,
+                           const int column,
+                           const std::size_t count,
+                           std::vector< double > * values );
+
+    /*!
+      \brief decode the data of one column into the single precision container.
+      the float columns are restored exactly. the int columns are exact up to 2^24.
+      \param data pointer to the column data
+      \param size column data size
+      \param column column id
+      \param count the number of shows in the block
+      \param values pointer to the container. decoded values are appended.
+      \return true if successfully decoded
+     */
+    static
+    bool decodeColumnData( const char * data,
+                           const std::size_t size,
+                           const int column,
+                           const std::size_t count,
+                           std::vector< float > * values );
+
+    /*!
+      \brief append the encoded footer index entries to the buffer
+      \param index index entries
+      \param out pointer to the output buffer
+     */
+    static
+    void encodeIndex( const std::vector< IndexEntry > & index,
+                      std::string * out );
+
+    /*!
+      \brief decode the footer index entries
+      \param data pointer to the encoded entries
+      \param size data size
+      \param index pointer to the result container
+      \return true if successfully decoded
+     */
+    static
+    bool decodeIndex( const char * data,
+                      const std::size_t size,
+                      std::vector< IndexEntry > * index );
+};
+
+}
+}
+
+#endif
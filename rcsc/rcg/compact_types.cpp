@@ -0,0 +1,215 @@
+// -*-c++-*-
+
+/*!
+  \file compact_types.cpp
+  \brief compact fixed-point show records for offline analysis Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "compact_types.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace rcsc {
+namespace rcg {
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+inline
+std::int16_t
+to_fixed( const float value,
+          const float scale )
+{
+    if ( value == SHOWINFO_SCALE2F )
+    {
+        return CompactScale::NONE;
+    }
+
+    const float v = std::rint( value * scale );
+    return static_cast< std::int16_t >( std::clamp( v, -32767.0f, 32767.0f ) );
+}
+
+/*-------------------------------------------------------------------*/
+inline
+std::uint16_t
+to_ufixed( const float value,
+           const float scale )
+{
+    if ( value == SHOWINFO_SCALE2F )
+    {
+        return CompactScale::UNONE;
+    }
+
+    const float v = std::rint( value * scale );
+    return static_cast< std::uint16_t >( std::clamp( v, 0.0f, 65534.0f ) );
+}
+
+/*-------------------------------------------------------------------*/
+inline
+float
+from_fixed( const std::int16_t value,
+            const float scale )
+{
+    return ( value == CompactScale::NONE
+             ? SHOWINFO_SCALE2F
+             : value / scale );
+}
+
+/*-------------------------------------------------------------------*/
+inline
+float
+from_ufixed( const std::uint16_t value,
+             const float scale )
+{
+    return ( value == CompactScale::UNONE
+             ? SHOWINFO_SCALE2F
+             : value / scale );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CompactBallT::CompactBallT( const BallT & ball )
+    : x_( to_fixed( ball.x_, CompactScale::POS ) ),
+      y_( to_fixed( ball.y_, CompactScale::POS ) ),
+      vx_( to_fixed( ball.vx_, CompactScale::VEL ) ),
+      vy_( to_fixed( ball.vy_, CompactScale::VEL ) )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+BallT
+CompactBallT::toBall() const
+{
+    BallT ball;
+    ball.x_ = from_fixed( x_, CompactScale::POS );
+    ball.y_ = from_fixed( y_, CompactScale::POS );
+    ball.vx_ = from_fixed( vx_, CompactScale::VEL );
+    ball.vy_ = from_fixed( vy_, CompactScale::VEL );
+    return ball;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CompactPlayerT::CompactPlayerT( const PlayerT & player )
+    : side_( player.side_ ),
+      unum_( static_cast< std::int8_t >( player.unum_ ) ),
+      type_( static_cast< std::int8_t >( player.type_ ) ),
+      view_quality_( player.view_quality_ ),
+      state_( player.state_ ),
+      x_( to_fixed( player.x_, CompactScale::POS ) ),
+      y_( to_fixed( player.y_, CompactScale::POS ) ),
+      vx_( to_fixed( player.vx_, CompactScale::VEL ) ),
+      vy_( to_fixed( player.vy_, CompactScale::VEL ) ),
+      body_( to_fixed( player.body_, CompactScale::ANGLE ) ),
+      neck_( to_fixed( player.neck_, CompactScale::ANGLE ) ),
+      view_width_( to_fixed( player.view_width_, CompactScale::ANGLE ) ),
+      stamina_( to_ufixed( player.stamina_, CompactScale::STAMINA ) ),
+      effort_( to_ufixed( player.effort_, CompactScale::RATE ) ),
+      recovery_( to_ufixed( player.recovery_, CompactScale::RATE ) ),
+      stamina_capacity_( player.stamina_capacity_ )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+PlayerT
+CompactPlayerT::toPlayer() const
+{
+    PlayerT player;
+    player.side_ = side_;
+    player.unum_ = unum_;
+    player.type_ = type_;
+    player.view_quality_ = view_quality_;
+    player.state_ = state_;
+    player.x_ = from_fixed( x_, CompactScale::POS );
+    player.y_ = from_fixed( y_, CompactScale::POS );
+    player.vx_ = from_fixed( vx_, CompactScale::VEL );
+    player.vy_ = from_fixed( vy_, CompactScale::VEL );
+    player.body_ = from_fixed( body_, CompactScale::ANGLE );
+    player.neck_ = from_fixed( neck_, CompactScale::ANGLE );
+    player.view_width_ = from_fixed( view_width_, CompactScale::ANGLE );
+    player.stamina_ = from_ufixed( stamina_, CompactScale::STAMINA );
+    player.effort_ = from_ufixed( effort_, CompactScale::RATE );
+    player.recovery_ = from_ufixed( recovery_, CompactScale::RATE );
+    player.stamina_capacity_ = stamina_capacity_;
+    return player;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CompactShowInfoT::CompactShowInfoT( const ShowInfoT & show )
+    : time_( show.time_ ),
+      stime_( show.stime_ ),
+      ball_( show.ball_ )
+{
+    for ( int i = 0; i < MAX_PLAYER * 2; ++i )
+    {
+        player_[i] = CompactPlayerT( show.player_[i] );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ShowInfoT
+CompactShowInfoT::toShowInfo() const
+{
+    ShowInfoT show;
+    show.time_ = time_;
+    show.stime_ = stime_;
+    show.ball_ = ball_.toBall();
+    for ( int i = 0; i < MAX_PLAYER * 2; ++i )
+    {
+        show.player_[i] = player_[i].toPlayer();
+    }
+    return show;
+}
+
+}
+}
@@ -0,0 +1,241 @@
+// -*-c++-*-
+
+/*!
+  \file compact_types.h
+  \brief compact fixed-point show records for offline analysis Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_RCG_COMPACT_TYPES_H
+#define RCSC_RCG_COMPACT_TYPES_H
+
+#include <rcsc/rcg/types.h>
+
+#include <cstdint>
+
+namespace rcsc {
+namespace rcg {
+
+/*!
+  \struct CompactScale
+  \brief fixed-point resolutions of the compact show records.
+
+  A value v is stored as round( v * SCALE ). The unknown value
+  (SHOWINFO_SCALE2F in the float records) is stored as NONE and out of
+  range values are saturated.
+ */
+struct CompactScale {
+    static constexpr float POS = 100.0f; //!< 0.01 [m]
+    static constexpr float VEL = 1000.0f; //!< 0.001 [m/cycle]
+    static constexpr float ANGLE = 100.0f; //!< 0.01 [degree]
+    static constexpr float STAMINA = 2.0f; //!< 0.5
+    static constexpr float RATE = 10000.0f; //!< 0.0001, effort and recovery
+
+    static constexpr std::int16_t NONE = INT16_MIN; //!< unknown signed value
+    static constexpr std::uint16_t UNONE = UINT16_MAX; //!< unknown unsigned value
+};
+
+/*!
+  \struct CompactBallT
+  \brief fixed-point ball data. 8 bytes instead of 16 bytes of BallT.
+ */
+struct CompactBallT {
+    std::int16_t x_; //!< position x
+    std::int16_t y_; //!< position y
+    std::int16_t vx_; //!< velocity x
+    std::int16_t vy_; //!< velocity y
+
+    /*!
+      \brief initialize all variables by 0
+     */
+    CompactBallT()
+        : x_( 0 ),
+          y_( 0 ),
+          vx_( CompactScale::NONE ),
+          vy_( CompactScale::NONE )
+      { }
+
+    /*!
+      \brief quantize the float record
+      \param ball source data
+     */
+    explicit
+    CompactBallT( const BallT & ball );
+
+    /*!
+      \brief restore the float record
+      \return converted data
+     */
+    BallT toBall() const;
+
+    bool hasVelocity() const
+      {
+          return vx_ != CompactScale::NONE;
+      }
+
+    double x() const { return x_ / CompactScale::POS; }
+    double y() const { return y_ / CompactScale::POS; }
+    double deltaX() const { return vx_ / CompactScale::VEL; }
+    double deltaY() const { return vy_ / CompactScale::VEL; }
+};
+
+/*!
+  \struct CompactPlayerT
+  \brief fixed-point player data. 32 bytes instead of 100 bytes of PlayerT.
+
+  Only the physical state and the stamina are kept. The arm, the focus
+  and the command counts are not stored and they are restored as unknown.
+ */
+struct CompactPlayerT {
+    char side_; //!< player's side. 'l', 'r' or 'n'
+    std::int8_t unum_; //!< player's uniform number. 0 means disabled player.
+    std::int8_t type_; //!< heterogeneous player type id
+    char view_quality_; //!< view quality indicator, 'l' or 'h'
+
+    Int32 state_; //!< state bit flags
+
+    std::int16_t x_; //!< position x
+    std::int16_t y_; //!< position y
+    std::int16_t vx_; //!< velocity x
+    std::int16_t vy_; //!< velocity y
+    std::int16_t body_; //!< body direction
+    std::int16_t neck_; //!< head direction relative to body
+    std::int16_t view_width_; //!< view width. high: value>0, low: value<0
+
+    std::uint16_t stamina_; //!< stamina value
+    std::uint16_t effort_; //!< effort value
+    std::uint16_t recovery_; //!< recovery value
+    float stamina_capacity_; //!< stamina capacity value
+
+    /*!
+      \brief initialize all variables
+     */
+    CompactPlayerT()
+        : side_( 'n' ),
+          unum_( 0 ),
+          type_( -1 ),
+          view_quality_( 'h' ),
+          state_( 0 ),
+          x_( 0 ),
+          y_( 0 ),
+          vx_( CompactScale::NONE ),
+          vy_( CompactScale::NONE ),
+          body_( 0 ),
+          neck_( CompactScale::NONE ),
+          view_width_( CompactScale::NONE ),
+          stamina_( CompactScale::UNONE ),
+          effort_( CompactScale::UNONE ),
+          recovery_( CompactScale::UNONE ),
+          stamina_capacity_( -1.0f )
+      { }
+
+    /*!
+      \brief quantize the float record
+      \param player source data
+     */
+    explicit
+    CompactPlayerT( const PlayerT & player );
+
+    /*!
+      \brief restore the float record
+      \return converted data
+     */
+    PlayerT toPlayer() const;
+
+    SideID side() const
+      {
+          return ( side_ == 'l' ? LEFT
+                   : side_ == 'r' ? RIGHT
+                   : NEUTRAL );
+      }
+
+    int unum() const { return unum_; }
+    int type() const { return type_; }
+
+    bool hasType() const { return type_ >= 0; }
+    bool hasVelocity() const { return vx_ != CompactScale::NONE; }
+    bool hasNeck() const { return neck_ != CompactScale::NONE; }
+    bool hasView() const { return view_width_ != CompactScale::NONE; }
+    bool hasStamina() const { return stamina_ != CompactScale::UNONE; }
+    bool hasStaminaCapacity() const { return stamina_capacity_ >= 0.0f; }
+
+    bool isAlive() const { return state_ != 0; }
+    bool isGoalie() const { return state_ & GOALIE; }
+
+    double x() const { return x_ / CompactScale::POS; }
+    double y() const { return y_ / CompactScale::POS; }
+
+    double deltaX() const { return vx_ / CompactScale::VEL; }
+    double deltaY() const { return vy_ / CompactScale::VEL; }
+
+    double body() const { return body_ / CompactScale::ANGLE; }
+    double head() const { return ( body_ + neck_ ) / CompactScale::ANGLE; }
+
+    double viewWidth() const { return view_width_ / CompactScale::ANGLE; }
+
+    double stamina() const { return stamina_ / CompactScale::STAMINA; }
+    double effort() const { return effort_ / CompactScale::RATE; }
+    double recovery() const { return recovery_ / CompactScale::RATE; }
+    double staminaCapacity() const { return stamina_capacity_; }
+};
+
+/*!
+  \struct CompactShowInfoT
+  \brief fixed-point show information for the bulk offline analysis.
+
+  The size is about one third of ShowInfoT. The positions are kept in 0.01
+  [m] and the velocities in 0.001 [m/cycle].
+ */
+struct CompactShowInfoT {
+    UInt32 time_; //!< game time
+    UInt32 stime_; //!< game time (stopped)
+    CompactBallT ball_; //!< ball data
+    CompactPlayerT player_[MAX_PLAYER * 2]; //!< player data
+
+    CompactShowInfoT()
+        : time_( 0 ),
+          stime_( 0 )
+      { }
+
+    /*!
+      \brief quantize the float record
+      \param show source data
+     */
+    explicit
+    CompactShowInfoT( const ShowInfoT & show );
+
+    /*!
+      \brief restore the float record
+      \return converted data
+     */
+    ShowInfoT toShowInfo() const;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,324 @@
+// -*-c++-*-
+
+/*!
+  \file event_buffer.cpp
+  \brief recorded rcg handler events Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "event_buffer.h"
+
+namespace rcsc {
+namespace rcg {
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+EventBuffer::EventBuffer( const Projection & projection )
+    : Handler()
+{
+    setProjection( projection );
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+EventBuffer::clear()
+{
+    M_events.clear();
+    M_shows.clear();
+    M_text.clear();
+    M_xpm_lines.clear();
+    M_msgs.clear();
+    M_draws.clear();
+    M_playmodes.clear();
+    M_teams.clear();
+    M_server_params.clear();
+    M_player_params.clear();
+    M_player_types.clear();
+    M_team_graphics.clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+EventBuffer::replay( Handler & handler ) const
+{
+    std::vector< std::string_view > xpm_data;
+
+    for ( std::size_t i = 0; i < M_events.size(); ++i )
+    {
+        const Event & e = M_events[i];
+
+        if ( e.type_ == SHOW )
+        {
+            // the consecutive shows are stored contiguously.
+            std::size_t n = 1;
+            while ( i + n < M_events.size()
+                    && M_events[i + n].type_ == SHOW )
+            {
+                ++n;
+            }
+
+            if ( ! handler.dispatchShows( &M_shows[e.index_], n ) )
+            {
+                return false;
+            }
+            i += n - 1;
+            continue;
+        }
+
+        // the queued shows are delivered before any other record.
+        handler.flushShows();
+
+        bool result = true;
+        switch ( e.type_ ) {
+        case SKIPPED_SHOW:
+            result = handler.handleSkippedShow( e.time_ );
+            break;
+        case MSG:
+            result = handler.handleMsg( e.time_, M_msgs[e.index_].board_, text( M_msgs[e.index_].text_ ) );
+            break;
+        case DRAW:
+            result = handler.handleDraw( e.time_, M_draws[e.index_] );
+            break;
+        case PLAYMODE:
+            result = handler.dispatchPlayMode( e.time_, M_playmodes[e.index_] );
+            break;
+        case TEAM:
+            result = handler.handleTeam( e.time_, M_teams[e.index_].first, M_teams[e.index_].second );
+            break;
+        case SERVER_PARAM:
+            result = handler.handleServerParam( *M_server_params[e.index_] );
+            break;
+        case PLAYER_PARAM:
+            result = handler.handlePlayerParam( *M_player_params[e.index_] );
+            break;
+        case PLAYER_TYPE:
+            result = handler.handlePlayerType( M_player_types[e.index_] );
+            break;
+        case TEAM_GRAPHIC:
+            {
+                const TeamGraphic & g = M_team_graphics[e.index_];
+                xpm_data.clear();
+                for ( std::size_t i = 0; i < g.n_lines_; ++i )
+                {
+                    xpm_data.push_back( text( M_xpm_lines[g.first_line_ + i] ) );
+                }
+                result = handler.handleTeamGraphic( g.side_, g.x_, g.y_, xpm_data );
+            }
+            break;
+        default:
+            break;
+        }
+
+        if ( ! result )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+EventBuffer::handleEOF()
+{
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+EventBuffer::handleShow( const ShowInfoT & show )
+{
+    push( SHOW, static_cast< int >( show.time_ ), M_shows.size() );
+    M_shows.push_back( show );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+EventBuffer::handleSkippedShow( const int time )
+{
+    push( SKIPPED_SHOW, time, 0 );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+EventBuffer::handleMsg( const int time,
+                        const int board,
+                        const std::string & msg )
+{
+    return handleMsg( time, board, std::string_view( msg ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+EventBuffer::handleMsg( const int time,
+                        const int board,
+                        const std::string_view msg )
+{
+    push( MSG, time, M_msgs.size() );
+    M_msgs.push_back( Message{ board, store( msg ) } );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+EventBuffer::handleDraw( const int time,
+                         const drawinfo_t & draw )
+{
+    push( DRAW, time, M_draws.size() );
+    M_draws.push_back( draw );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+EventBuffer::handlePlayMode( const int time,
+                             const PlayMode pm )
+{
+    push( PLAYMODE, time, M_playmodes.size() );
+    M_playmodes.push_back( pm );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+EventBuffer::handleTeam( const int time,
+                         const TeamT & team_l,
+                         const TeamT & team_r )
+{
+    push( TEAM, time, M_teams.size() );
+    M_teams.emplace_back( team_l, team_r );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+EventBuffer::handleServerParam( const ServerParamT & param )
+{
+    push( SERVER_PARAM, 0, M_server_params.size() );
+    M_server_params.emplace_back( new ServerParamT() );
+    M_server_params.back()->copyFrom( param );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+EventBuffer::handlePlayerParam( const PlayerParamT & param )
+{
+    push( PLAYER_PARAM, 0, M_player_params.size() );
+    M_player_params.emplace_back( new PlayerParamT() );
+    M_player_params.back()->copyFrom( param );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+EventBuffer::handlePlayerType( const PlayerTypeT & param )
+{
+    push( PLAYER_TYPE, 0, M_player_types.size() );
+    M_player_types.push_back( param );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+EventBuffer::handleTeamGraphic( const char side,
+                                const int x,
+                                const int y,
+                                const std::vector< std::string > & xpm_data )
+{
+    pushTeamGraphic( side, x, y, xpm_data );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+EventBuffer::handleTeamGraphic( const char side,
+                                const int x,
+                                const int y,
+                                const std::vector< std::string_view > & xpm_data )
+{
+    pushTeamGraphic( side, x, y, xpm_data );
+    return true;
+}
+
+}
+}
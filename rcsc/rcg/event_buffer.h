@@ -0,0 +1,230 @@
+// -*-c++-*-
+
+/*!
+  \file event_buffer.h
+  \brief recorded rcg handler events Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_RCG_EVENT_BUFFER_H
+#define RCSC_RCG_EVENT_BUFFER_H
+
+#include <rcsc/rcg/handler.h>
+#include <rcsc/rcg/types.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rcsc {
+namespace rcg {
+
+/*!
+  \class EventBuffer
+  \brief handler that records the received data and replays them to another handler later.
+
+  The parallel parsers give one buffer to each chunk of the input, then
+  replay the buffers to the user handler in the original order.
+  Only the data callbacks are recorded. handleLogVersion() and handleEOF()
+  are called by the parser directly.
+  Message bodies and xpm lines are appended to one text arena, so recording
+  them does not allocate per record once the arena has grown.
+*/
+class EventBuffer
+    : public Handler {
+private:
+
+    //! recorded callback types
+    enum EventType {
+        SHOW,
+        SKIPPED_SHOW,
+        MSG,
+        DRAW,
+        PLAYMODE,
+        TEAM,
+        SERVER_PARAM,
+        PLAYER_PARAM,
+        PLAYER_TYPE,
+        TEAM_GRAPHIC,
+    };
+
+    //! recorded callback. index_ refers to the data container of the type.
+    struct Event {
+        EventType type_;
+        int time_;
+        std::size_t index_;
+    };
+
+    //! a range of the text arena
+    struct Slice {
+        std::size_t begin_;
+        std::size_t size_;
+    };
+
+    //! msg data
+    struct Message {
+        int board_;
+        Slice text_;
+    };
+
+    //! team graphic data. xpm lines are M_xpm_lines[first_line_, first_line_ + n_lines_)
+    struct TeamGraphic {
+        char side_;
+        int x_;
+        int y_;
+        std::size_t first_line_;
+        std::size_t n_lines_;
+    };
+
+    std::vector< Event > M_events; //!< callbacks in the received order
+
+    std::vector< ShowInfoT > M_shows;
+    std::string M_text; //!< text arena of the messages and the xpm lines
+    std::vector< Slice > M_xpm_lines;
+
+    std::vector< Message > M_msgs;
+    std::vector< drawinfo_t > M_draws;
+    std::vector< PlayMode > M_playmodes;
+    std::vector< std::pair< TeamT, TeamT > > M_teams;
+    std::vector< std::unique_ptr< ServerParamT > > M_server_params; //!< not copyable, so held by pointers
+    std::vector< std::unique_ptr< PlayerParamT > > M_player_params; //!< not copyable, so held by pointers
+    std::vector< PlayerTypeT > M_player_types;
+    std::vector< TeamGraphic > M_team_graphics;
+
+public:
+
+    /*!
+      \brief create an empty buffer
+      \param projection show data to be recorded by the parser
+     */
+    explicit
+    EventBuffer( const Projection & projection = Projection() );
+
+    /*!
+      \brief check if no event is recorded
+      \return true if empty
+     */
+    bool empty() const
+      {
+          return M_events.empty();
+      }
+
+    /*!
+      \brief get the number of recorded events
+      \return event count
+     */
+    std::size_t size() const
+      {
+          return M_events.size();
+      }
+
+    /*!
+      \brief remove all recorded events. allocated memory is kept.
+     */
+    void clear();
+
+    /*!
+      \brief call the handler methods in the recorded order
+      \param handler target handler
+      \return false if the handler returns false. the remaining events are not replayed.
+
+      Note that the parsers ignore the result of the data callbacks.
+      The playmodes are passed through Handler::dispatchPlayMode(), and the shows
+      rejected by Handler::wantsShow() are passed to Handler::handleSkippedShow().
+     */
+    bool replay( Handler & handler ) const;
+
+    bool handleEOF() override;
+
+    bool handleShow( const ShowInfoT & show ) override;
+    bool handleSkippedShow( const int time ) override;
+    bool handleMsg( const int time,
+                    const int board,
+                    const std::string & msg ) override;
+    bool handleMsg( const int time,
+                    const int board,
+                    const std::string_view msg ) override;
+    bool handleDraw( const int time,
+                     const drawinfo_t & draw ) override;
+    bool handlePlayMode( const int time,
+                         const PlayMode pm ) override;
+    bool handleTeam( const int time,
+                     const TeamT & team_l,
+                     const TeamT & team_r ) override;
+    bool handleServerParam( const ServerParamT & param ) override;
+    bool handlePlayerParam( const PlayerParamT & param ) override;
+    bool handlePlayerType( const PlayerTypeT & param ) override;
+    bool handleTeamGraphic( const char side,
+                            const int x,
+                            const int y,
+                            const std::vector< std::string > & xpm_data ) override;
+    bool handleTeamGraphic( const char side,
+                            const int x,
+                            const int y,
+                            const std::vector< std::string_view > & xpm_data ) override;
+
+private:
+
+    Slice store( const std::string_view text )
+      {
+          const Slice s{ M_text.size(), text.size() };
+          M_text.append( text.data(), text.size() );
+          return s;
+      }
+
+    std::string_view text( const Slice & s ) const
+      {
+          return std::string_view( M_text.data() + s.begin_, s.size_ );
+      }
+
+    template < typename Strings >
+    void pushTeamGraphic( const char side,
+                          const int x,
+                          const int y,
+                          const Strings & xpm_data )
+      {
+          push( TEAM_GRAPHIC, 0, M_team_graphics.size() );
+          M_team_graphics.push_back( TeamGraphic{ side, x, y, M_xpm_lines.size(), xpm_data.size() } );
+          for ( const auto & line : xpm_data )
+          {
+              M_xpm_lines.push_back( store( line ) );
+          }
+      }
+
+    void push( const EventType type,
+               const int time,
+               const std::size_t index )
+      {
+          M_events.push_back( Event{ type, time, index } );
+      }
+};
+
+}
+}
+
+#endif
@@ -55,7 +55,8 @@ namespace rcg {
 */
 Handler::Handler()
     : M_log_version( 0 ),
-      M_read_time( 0 )
+      M_read_time( 0 ),
+      M_current_playmode( PM_Null )
 {
 
 }
@@ -72,6 +73,124 @@ Handler::~Handler()
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+bool
+Handler::handleShowBatch( const ShowSpan & shows )
+{
+    bool result = true;
+    for ( const ShowInfoT & show : shows )
+    {
+        if ( ! handleShow( show ) )
+        {
+            result = false;
+        }
+    }
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+Handler::dispatchShow( const ShowInfoT & show )
+{
+    const std::size_t batch_size = showBatchSize();
+    if ( batch_size == 0 )
+    {
+        return handleShow( show );
+    }
+
+    M_show_batch.push_back( show );
+    if ( M_show_batch.size() >= batch_size )
+    {
+        return flushShows();
+    }
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+Handler::dispatchShows( const ShowInfoT * shows,
+                        const std::size_t n )
+{
+    const std::size_t batch_size = showBatchSize();
+    bool result = true;
+
+    std::size_t i = 0;
+    while ( i < n )
+    {
+        if ( ! wantsShow( static_cast< int >( shows[i].time_ ) ) )
+        {
+            if ( ! flushShows()
+                 || ! handleSkippedShow( static_cast< int >( shows[i].time_ ) ) )
+            {
+                result = false;
+            }
+            ++i;
+            continue;
+        }
+
+        if ( batch_size == 0
+             || ! M_show_batch.empty() )
+        {
+            if ( ! dispatchShow( shows[i] ) )
+            {
+                result = false;
+            }
+            ++i;
+            continue;
+        }
+
+        // the full batch is delivered directly from the caller's array.
+        std::size_t last = i + 1;
+        while ( last < n
+                && last - i < batch_size
+                && wantsShow( static_cast< int >( shows[last].time_ ) ) )
+        {
+            ++last;
+        }
+
+        if ( last - i == batch_size )
+        {
+            if ( ! handleShowBatch( ShowSpan( shows + i, batch_size ) ) )
+            {
+                result = false;
+            }
+        }
+        else
+        {
+            M_show_batch.insert( M_show_batch.end(), shows + i, shows + last );
+        }
+        i = last;
+    }
+
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+Handler::flushShows()
+{
+    if ( M_show_batch.empty() )
+    {
+        return true;
+    }
+
+    const bool result = handleShowBatch( ShowSpan( M_show_batch.data(), M_show_batch.size() ) );
+    M_show_batch.clear();
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 bool
 Handler::handleDispInfo( const dispinfo_t & dinfo )
@@ -151,7 +270,7 @@ Handler::handleShowInfo( const showinfo_t & info )
 
     return ( handlePlayMode( info.pmode )
              && handleTeamInfo( info.team[0], info.team[1] )
-             && handleShow( show ) );
+             && ( wantsShow( M_read_time ) ? handleShow( show ) : handleSkippedShow( M_read_time ) ) );
 }
 
 /*-------------------------------------------------------------------*/
@@ -167,7 +286,7 @@ Handler::handleShowInfo2( const showinfo_t2 & info )
 
     return ( handlePlayMode( info.pmode )
              && handleTeamInfo( info.team[0], info.team[1] )
-             && handleShow( show ) );
+             && ( wantsShow( M_read_time ) ? handleShow( show ) : handleSkippedShow( M_read_time ) ) );
 }
 
 /*-------------------------------------------------------------------*/
@@ -177,12 +296,17 @@ Handler::handleShowInfo2( const showinfo_t2 & info )
 bool
 Handler::handleShortShowInfo2( const short_showinfo_t2 & info )
 {
+    if ( M_projection.metadataOnly() )
+    {
+        return handleSkippedShow( static_cast< int >( ntohs( info.time ) ) );
+    }
+
     ShowInfoT show;
     convert( info, show );
 
     M_read_time = static_cast< int >( show.time_ );
 
-    return handleShow( show );
+    return ( wantsShow( M_read_time ) ? handleShow( show ) : handleSkippedShow( M_read_time ) );
 }
 
 /*-------------------------------------------------------------------*/
@@ -213,7 +337,7 @@ Handler::handleDrawInfo( const drawinfo_t & draw )
 bool
 Handler::handlePlayMode( char playmode )
 {
-    return handlePlayMode( M_read_time, static_cast< PlayMode >( playmode ) );
+    return dispatchPlayMode( M_read_time, static_cast< PlayMode >( playmode ) );
 }
 
 /*-------------------------------------------------------------------*/
@@ -262,7 +386,7 @@ bool
 Handler::handlePlayMode( const int time,
                          const std::string & playmode )
 {
-    return handlePlayMode( time, to_playmode_enum( playmode ) );
+    return dispatchPlayMode( time, to_playmode_enum( playmode ) );
 }
 
 } // end namespace
@@ -35,11 +35,320 @@
 #include <rcsc/rcg/types.h>
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <initializer_list>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
 
 namespace rcsc {
 namespace rcg {
 
+/*!
+  \class Projection
+  \brief declaration of the show data that a handler actually reads.
+
+  Parsers refer to this declaration and may skip decoding the excluded
+  fields and the show records out of the cycle range or the playmodes.
+  This is only a hint. A parser that does not support it delivers everything,
+  and the skipped fields keep their default values.
+  Non-show records (playmode, team, msg, params) are always delivered,
+  except the team graphics if they are disabled by setTeamGraphic().
+  Parsers then skip the xpm tiles without decoding them.
+
+  The metadata only projection needs no show at all. Parsers skip the show
+  records at the record boundary, and only the team and playmode information
+  embedded in them is delivered.
+*/
+class Projection {
+public:
+
+    /*!
+      \enum Field
+      \brief field groups of ShowInfoT
+    */
+    enum Field {
+        BALL = 0x01, //!< ball position and velocity
+        PLAYER_POSITION = 0x02, //!< player type, state, position, velocity, body, neck and arm
+        PLAYER_VIEW = 0x04, //!< view mode, focus point and attention target
+        PLAYER_STAMINA = 0x08, //!< stamina, effort, recovery and capacity
+        PLAYER_COUNT = 0x10, //!< command counts
+        PLAYERS = 0x1e, //!< all player fields
+        ALL_FIELDS = 0x1f, //!< all fields
+    };
+
+private:
+
+    unsigned int M_fields; //!< bit set of Field
+    int M_first_time; //!< first cycle of the needed shows
+    int M_last_time; //!< last cycle of the needed shows
+    std::uint64_t M_playmodes; //!< bit set of the needed playmodes
+    bool M_metadata_only; //!< if true, no show is needed
+    bool M_team_graphic; //!< if false, team graphics are not needed
+
+public:
+
+    /*!
+      \brief construct the projection that accepts everything.
+    */
+    Projection()
+        : M_fields( ALL_FIELDS ),
+          M_first_time( INT_MIN ),
+          M_last_time( INT_MAX ),
+          M_playmodes( all_playmodes() ),
+          M_metadata_only( false ),
+          M_team_graphic( true )
+      { }
+
+    /*!
+      \brief set the needed field groups
+      \param fields bit set of Field
+      \return reference to itself
+    */
+    Projection & setFields( const unsigned int fields )
+      {
+          M_fields = fields;
+          return *this;
+      }
+
+    /*!
+      \brief set the cycle range of the needed shows
+      \param first first cycle (inclusive)
+      \param last last cycle (inclusive)
+      \return reference to itself
+    */
+    Projection & setTimeRange( const int first,
+                               const int last )
+      {
+          M_first_time = first;
+          M_last_time = last;
+          return *this;
+      }
+
+    /*!
+      \brief set the playmodes of the needed shows
+      \param playmodes playmode list. an empty list accepts all playmodes.
+      \return reference to itself
+    */
+    Projection & setPlayModes( std::initializer_list< PlayMode > playmodes )
+      {
+          M_playmodes = ( playmodes.size() == 0 ? all_playmodes() : 0 );
+          for ( PlayMode pm : playmodes )
+          {
+              M_playmodes |= std::uint64_t( 1 ) << pm;
+          }
+          return *this;
+      }
+
+    /*!
+      \brief remove the playmode condition
+      \return reference to itself
+    */
+    Projection & clearPlayModes()
+      {
+          M_playmodes = all_playmodes();
+          return *this;
+      }
+
+    /*!
+      \brief set the metadata only mode
+      \param on if true, no show record is needed
+      \return reference to itself
+    */
+    Projection & setMetadataOnly( const bool on = true )
+      {
+          M_metadata_only = on;
+          return *this;
+      }
+
+    /*!
+      \brief check if only the non-show records are needed
+      \return checked result
+    */
+    bool metadataOnly() const
+      {
+          return M_metadata_only;
+      }
+
+    /*!
+      \brief set whether the team graphics are needed
+      \param on if false, the team graphic records are skipped
+      \return reference to itself
+    */
+    Projection & setTeamGraphic( const bool on )
+      {
+          M_team_graphic = on;
+          return *this;
+      }
+
+    /*!
+      \brief check if the team graphics are needed
+      \return checked result
+    */
+    bool teamGraphic() const
+      {
+          return M_team_graphic;
+      }
+
+    /*!
+      \brief check if any of the field groups is needed
+      \param fields bit set of Field
+      \return checked result
+    */
+    bool hasField( const unsigned int fields ) const
+      {
+          return ! M_metadata_only
+              && ( M_fields & fields ) != 0;
+      }
+
+    /*!
+      \brief get the needed field groups
+      \return bit set of Field
+    */
+    unsigned int fields() const
+      {
+          return M_metadata_only ? 0 : M_fields;
+      }
+
+    /*!
+      \brief check if the show at the cycle is needed
+      \param time cycle of the show
+      \return checked result
+    */
+    bool acceptsTime( const int time ) const
+      {
+          return ! M_metadata_only
+              && M_first_time <= time && time <= M_last_time;
+      }
+
+    /*!
+      \brief check if the cycle range is set
+      \return checked result
+    */
+    bool filtersTime() const
+      {
+          return M_metadata_only
+              || M_first_time != INT_MIN || M_last_time != INT_MAX;
+      }
+
+    /*!
+      \brief check if the show in the playmode is needed
+      \param pm playmode at the show
+      \return checked result
+    */
+    bool acceptsPlayMode( const PlayMode pm ) const
+      {
+          return ( M_playmodes >> pm ) & 1;
+      }
+
+    /*!
+      \brief check if the playmode condition is set
+      \return checked result
+    */
+    bool filtersPlayMode() const
+      {
+          return M_playmodes != all_playmodes();
+      }
+
+private:
+
+    static
+    std::uint64_t all_playmodes()
+      {
+          return ( std::uint64_t( 1 ) << PM_MAX ) - 1;
+      }
+};
+
+/*!
+  \class ShowSpan
+  \brief read only view of the contiguous show records.
+
+  The referenced shows are owned by the caller and are valid only during
+  the callback.
+*/
+class ShowSpan {
+private:
+    const ShowInfoT * M_data; //!< pointer to the first show
+    std::size_t M_size; //!< the number of shows
+
+public:
+
+    /*!
+      \brief construct the empty span.
+    */
+    ShowSpan()
+        : M_data( nullptr ),
+          M_size( 0 )
+      { }
+
+    /*!
+      \brief construct the span of the shows.
+      \param data pointer to the first show
+      \param size the number of shows
+    */
+    ShowSpan( const ShowInfoT * data,
+              const std::size_t size )
+        : M_data( data ),
+          M_size( size )
+      { }
+
+    /*!
+      \brief get the pointer to the first show
+      \return const pointer to the show array
+    */
+    const ShowInfoT * data() const
+      {
+          return M_data;
+      }
+
+    /*!
+      \brief get the number of shows
+      \return the number of shows
+    */
+    std::size_t size() const
+      {
+          return M_size;
+      }
+
+    /*!
+      \brief check if the span has no show
+      \return checked result
+    */
+    bool empty() const
+      {
+          return M_size == 0;
+      }
+
+    /*!
+      \brief get the show at the index
+      \param i index of the show
+      \return const reference to the show
+    */
+    const ShowInfoT & operator[]( const std::size_t i ) const
+      {
+          return M_data[i];
+      }
+
+    /*!
+      \brief get the begin iterator
+      \return const pointer to the first show
+    */
+    const ShowInfoT * begin() const
+      {
+          return M_data;
+      }
+
+    /*!
+      \brief get the end iterator
+      \return const pointer to the next of the last show
+    */
+    const ShowInfoT * end() const
+      {
+          return M_data + M_size;
+      }
+};
+
 /*!
   \class Handler
   \brief abstract rcg data handler class.
@@ -60,6 +369,15 @@ private:
     //! last handled game time
     int M_read_time;
 
+    //! declared show data needed by this handler
+    Projection M_projection;
+
+    //! last playmode passed through dispatchPlayMode()
+    PlayMode M_current_playmode;
+
+    //! shows waiting for the delivery by handleShowBatch()
+    std::vector< ShowInfoT > M_show_batch;
+
 protected:
 
     /*!
@@ -67,6 +385,17 @@ protected:
     */
     Handler();
 
+    /*!
+      \brief declare the show data needed by this handler.
+      \param projection new projection
+
+      Call this before parsing. See Projection.
+    */
+    void setProjection( const Projection & projection )
+      {
+          M_projection = projection;
+      }
+
 public:
     /*!
       \brief virtual destructor
@@ -89,6 +418,92 @@ public:
           return true;
       }
 
+    /*!
+      \brief check if the data callbacks may be called out of the file order.
+      \return false by default.
+
+      Override this to return true if the handler only accumulates commutative
+      statistics. Then a parallel parser hands over each chunk as soon as it is
+      parsed. The callbacks are still called from one thread at a time.
+    */
+    virtual
+    bool acceptsUnorderedCallbacks() const
+      {
+          return false;
+      }
+
+    /*!
+      \brief get the show data declared by this handler
+      \return projection object
+    */
+    const Projection & projection() const
+      {
+          return M_projection;
+      }
+
+    /*!
+      \brief check if the parser should decode and deliver the show at the cycle.
+      \param time cycle of the show
+      \return checked result
+
+      The playmode condition is evaluated with the last playmode passed through
+      dispatchPlayMode().
+    */
+    bool wantsShow( const int time ) const
+      {
+          return M_projection.acceptsTime( time )
+              && M_projection.acceptsPlayMode( M_current_playmode );
+      }
+
+    /*!
+      \brief record the playmode for wantsShow() and call handlePlayMode().
+      \param time game time of the playmode
+      \param pm playmode id
+      \return result of handlePlayMode()
+
+      Parsers should deliver the playmode through this method.
+    */
+    bool dispatchPlayMode( const int time,
+                           const PlayMode pm )
+      {
+          if ( pm != M_current_playmode )
+          {
+              flushShows();
+          }
+          M_current_playmode = pm;
+          return handlePlayMode( time, pm );
+      }
+
+    /*!
+      \brief deliver the show that passed wantsShow().
+      \param show decoded show
+      \return result of the callback, or true if the show is queued.
+
+      If the handler opts in by showBatchSize(), the show is copied to the
+      batch and delivered later by handleShowBatch(). Otherwise handleShow()
+      is called immediately. Parsers that use this method must call
+      flushShows() before any other callback.
+    */
+    bool dispatchShow( const ShowInfoT & show );
+
+    /*!
+      \brief deliver the contiguous shows that have no other record between them.
+      \param shows pointer to the first show
+      \param n the number of shows
+      \return false if any callback returns false.
+
+      wantsShow() is checked for each show, and the rejected show is passed to
+      handleSkippedShow(). The full batches are delivered without copying.
+    */
+    bool dispatchShows( const ShowInfoT * shows,
+                        const std::size_t n );
+
+    /*!
+      \brief deliver the queued shows by handleShowBatch().
+      \return result of handleShowBatch(), or true if no show is queued.
+    */
+    bool flushShows();
+
     /*!
       \brief returns rcg version number
       \return rcg version number
@@ -257,6 +672,50 @@ public:
     virtual
     bool handleShow( const ShowInfoT & show ) = 0;
 
+    /*!
+      \brief get the number of shows delivered by one handleShowBatch() call
+      \return the batch size. 0 (default) means no batch.
+
+      Override this to opt in to handleShowBatch(). The last batch before
+      another record or the end of file can be shorter. Parsers that do not
+      support the batch still call handleShow() for each show.
+    */
+    virtual
+    std::size_t showBatchSize() const
+      {
+          return 0;
+      }
+
+    /*!
+      \brief handle the consecutive shows in one call.
+      \param shows shows in the file order
+      \return result status
+
+      Parsers call this instead of handleShow() if showBatchSize() is positive.
+      No other record exists between the shows, except the playmode and team
+      embedded in the show records (JSON and some text logs) that do not
+      change the playmode.
+      The default implementation calls handleShow() for each show.
+    */
+    virtual
+    bool handleShowBatch( const ShowSpan & shows );
+
+    /*!
+      \brief handle the show record that is not delivered because of the projection.
+      \param time game time of the skipped show
+      \return result status
+
+      Parsers call this instead of handleShow(). The default implementation
+      only records the time. Override this to follow the game time without
+      decoding the shows, e.g. in the metadata only mode.
+     */
+    virtual
+    bool handleSkippedShow( const int time )
+      {
+          M_read_time = time;
+          return true;
+      }
+
     /*!
       \brief (pure virtual) handle msg info
       \param time game time of handled msg info
@@ -336,6 +795,46 @@ public:
                             const int y,
                             const std::vector< std::string > & xpm_data ) = 0;
 
+    //
+    // zero-copy variants.
+    // parsers call these with the slices of their own buffers, which are valid
+    // only during the call. the default implementations copy the data and call
+    // the owning versions above, so existing handlers keep working.
+    // override these to avoid the per-record allocations.
+    //
+
+    /*!
+      \brief handle msg info given as a slice of the parser buffer
+      \param time game time of handled msg info
+      \param board message board type
+      \param msg message data. valid only during this call.
+      \return result status
+     */
+    virtual
+    bool handleMsg( const int time,
+                    const int board,
+                    const std::string_view msg )
+      {
+          return handleMsg( time, board, std::string( msg ) );
+      }
+
+    /*!
+      \brief handle team_graphic message given as slices of the parser buffer
+      \param side team side character
+      \param x tile position
+      \param y tile position
+      \param xpm_data xpm lines. valid only during this call.
+      \return result status
+    */
+    virtual
+    bool handleTeamGraphic( const char side,
+                            const int x,
+                            const int y,
+                            const std::vector< std::string_view > & xpm_data )
+      {
+          return handleTeamGraphic( side, x, y, std::vector< std::string >( xpm_data.begin(), xpm_data.end() ) );
+      }
+
     //
     //
     //
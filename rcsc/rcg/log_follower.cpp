@@ -0,0 +1,445 @@
+// -*-c++-*-
+
+/*!
+  \file log_follower.cpp
+  \brief tail follower of the growing rcg file Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "log_follower.h"
+
+#include "handler.h"
+#include "types.h"
+
+#include <algorithm>
+#include <chrono>
+#include <charconv>
+#include <filesystem>
+#include <iostream>
+#include <thread>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef HAVE_SYS_INOTIFY_H
+#include <sys/inotify.h>
+#endif
+
+namespace rcsc {
+namespace rcg {
+
+namespace {
+
+//! read size of one system call
+constexpr std::size_t READ_SIZE = 64 * 1024;
+
+//! interval of the file size check if inotify is not available
+constexpr int POLLING_INTERVAL_MSEC = 100;
+
+/*-------------------------------------------------------------------*/
+inline
+std::string_view
+trim( std::string_view str )
+{
+    while ( ! str.empty()
+            && std::isspace( static_cast< unsigned char >( str.front() ) ) )
+    {
+        str.remove_prefix( 1 );
+    }
+
+    while ( ! str.empty()
+            && std::isspace( static_cast< unsigned char >( str.back() ) ) )
+    {
+        str.remove_suffix( 1 );
+    }
+
+    return str;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+LogFollower::LogFollower( const std::string & filepath )
+    : M_filepath( filepath ),
+      M_fd( -1 ),
+      M_inode( 0 ),
+      M_notify_fd( -1 ),
+      M_offset( 0 ),
+      M_version( 0 ),
+      M_n_line( 0 ),
+      M_buffer( READ_SIZE )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+LogFollower::~LogFollower()
+{
+    closeFile();
+
+    if ( M_notify_fd >= 0 )
+    {
+        ::close( M_notify_fd );
+        M_notify_fd = -1;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+LogFollower::openFile()
+{
+    if ( M_fd >= 0 )
+    {
+        return true;
+    }
+
+    M_fd = ::open( M_filepath.c_str(), O_RDONLY );
+    if ( M_fd < 0 )
+    {
+        return false;
+    }
+
+    struct stat st;
+    if ( ::fstat( M_fd, &st ) != 0 )
+    {
+        closeFile();
+        return false;
+    }
+
+    M_inode = static_cast< std::uint64_t >( st.st_ino );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+LogFollower::closeFile()
+{
+    if ( M_fd >= 0 )
+    {
+        ::close( M_fd );
+    }
+
+    M_fd = -1;
+    M_inode = 0;
+    M_offset = 0;
+    M_version = 0;
+    M_n_line = 0;
+    M_partial.clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::int64_t
+LogFollower::fileSize() const
+{
+    struct stat st;
+    if ( ::stat( M_filepath.c_str(), &st ) != 0 )
+    {
+        return -1;
+    }
+
+    return static_cast< std::int64_t >( st.st_size );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+LogFollower::poll( Handler & handler )
+{
+    struct stat st;
+    if ( ::stat( M_filepath.c_str(), &st ) != 0 )
+    {
+        // not created yet
+        return 0;
+    }
+
+    if ( M_fd >= 0
+         && ( static_cast< std::uint64_t >( st.st_ino ) != M_inode
+              || static_cast< std::uint64_t >( st.st_size ) < M_offset ) )
+    {
+        // the file has been replaced. read the new one from the beginning.
+        closeFile();
+    }
+
+    if ( ! openFile() )
+    {
+        std::cerr << "(LogFollower::poll) could not open the file. " << M_filepath
+                  << std::endl;
+        return -1;
+    }
+
+    int count = 0;
+    while ( true )
+    {
+        const ssize_t n = ::pread( M_fd, M_buffer.data(), M_buffer.size(),
+                                   static_cast< off_t >( M_offset ) );
+        if ( n < 0 )
+        {
+            if ( errno == EINTR ) continue;
+
+            std::cerr << "(LogFollower::poll) read error. " << std::strerror( errno )
+                      << std::endl;
+            return -1;
+        }
+
+        if ( n == 0 )
+        {
+            break;
+        }
+
+        M_offset += static_cast< std::uint64_t >( n );
+
+        const char * begin = M_buffer.data();
+        const char * const end = begin + n;
+        while ( begin < end )
+        {
+            const char * nl = static_cast< const char * >( std::memchr( begin, '\n', end - begin ) );
+            if ( ! nl )
+            {
+                // keep the incomplete line until the rest is written.
+                M_partial.append( begin, end );
+                break;
+            }
+
+            bool result = true;
+            if ( M_partial.empty() )
+            {
+                result = parseLine( std::string_view( begin, nl - begin ), handler );
+            }
+            else
+            {
+                M_partial.append( begin, nl );
+                result = parseLine( M_partial, handler );
+                M_partial.clear();
+            }
+
+            if ( ! result )
+            {
+                return -1;
+            }
+
+            ++count;
+            begin = nl + 1;
+        }
+    }
+
+    return count;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+LogFollower::wait( const int timeout_msec )
+{
+    const std::int64_t size = fileSize();
+    if ( size >= 0
+         && static_cast< std::uint64_t >( size ) != M_offset )
+    {
+        return true;
+    }
+
+#ifdef HAVE_SYS_INOTIFY_H
+    if ( M_notify_fd < 0 )
+    {
+        // watch the directory, so that the creation and the replacement of the file are also detected.
+        std::string dir = std::filesystem::path( M_filepath ).parent_path().string();
+        if ( dir.empty() ) dir = ".";
+
+        M_notify_fd = ::inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+        if ( M_notify_fd >= 0
+             && ::inotify_add_watch( M_notify_fd, dir.c_str(),
+                                     IN_MODIFY | IN_CREATE | IN_MOVED_TO | IN_CLOSE_WRITE ) < 0 )
+        {
+            ::close( M_notify_fd );
+            M_notify_fd = -1;
+        }
+    }
+
+    if ( M_notify_fd >= 0 )
+    {
+        struct pollfd pfd;
+        pfd.fd = M_notify_fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+
+        const int ret = ::poll( &pfd, 1, timeout_msec );
+        if ( ret <= 0 )
+        {
+            return false;
+        }
+
+        // drain the events. they may belong to the other files in the directory.
+        char buf[4096];
+        while ( ::read( M_notify_fd, buf, sizeof( buf ) ) > 0 ) { }
+
+        return true;
+    }
+#endif
+
+    const auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds( timeout_msec );
+    while ( std::chrono::steady_clock::now() < until )
+    {
+        std::this_thread::sleep_for( std::chrono::milliseconds( std::min( timeout_msec, POLLING_INTERVAL_MSEC ) ) );
+
+        const std::int64_t new_size = fileSize();
+        if ( new_size >= 0
+             && static_cast< std::uint64_t >( new_size ) != M_offset )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+LogFollower::finish( Handler & handler )
+{
+    if ( ! M_partial.empty() )
+    {
+        std::string line;
+        line.swap( M_partial );
+        parseLine( line, handler );
+    }
+
+    return handler.handleEOF();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+LogFollower::parseLine( std::string_view line,
+                        Handler & handler )
+{
+    ++M_n_line;
+
+    //
+    // header
+    //
+    if ( M_version == 0 )
+    {
+        const std::string_view header = trim( line );
+        int version = 0;
+        if ( header.compare( 0, 3, "ULG" ) == 0 )
+        {
+            if ( std::from_chars( header.data() + 3, header.data() + header.size(), version ).ec != std::errc()
+                 || ( version != REC_VERSION_4
+                      && version != REC_VERSION_5
+                      && version != REC_VERSION_6 ) )
+            {
+                std::cerr << "(LogFollower) unsupported rcg version: [" << header << "]" << std::endl;
+                return false;
+            }
+        }
+        else if ( ! header.empty()
+                  && header.front() == '[' )
+        {
+            version = REC_VERSION_JSON;
+        }
+        else
+        {
+            std::cerr << "(LogFollower) unknown header line: [" << header << "]" << std::endl;
+            return false;
+        }
+
+        if ( ! handler.handleLogVersion( version ) )
+        {
+            std::cerr << "(LogFollower) unsupported game log version: [" << header << "]" << std::endl;
+            return false;
+        }
+
+        M_version = version;
+        return true;
+    }
+
+    //
+    // JSON. each record is written in one line, followed by a comma.
+    //
+    if ( M_version == REC_VERSION_JSON )
+    {
+        std::string_view record = trim( line );
+        if ( ! record.empty()
+             && record.back() == ',' )
+        {
+            record.remove_suffix( 1 );
+        }
+
+        if ( record.empty()
+             || record == "]" )
+        {
+            return true;
+        }
+
+        M_json_record.assign( record.data(), record.size() );
+        return M_json_parser.parseData( M_json_record, handler );
+    }
+
+    //
+    // text
+    //
+    if ( trim( line ).empty() )
+    {
+        return true;
+    }
+
+    return M_parser.parseLine( M_n_line, line, handler );
+}
+
+}
+}
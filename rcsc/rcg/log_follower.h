@@ -0,0 +1,180 @@
+// -*-c++-*-
+
+/*!
+  \file log_follower.h
+  \brief tail follower of the growing rcg file Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_RCG_LOG_FOLLOWER_H
+#define RCSC_RCG_LOG_FOLLOWER_H
+
+#include <rcsc/rcg/parser_v4.h>
+#include <rcsc/rcg/parser_simdjson.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace rcsc {
+namespace rcg {
+
+class Handler;
+
+/*!
+  \class LogFollower
+  \brief incremental parser of the rcg file that is still being written.
+
+  The text formats (rcg v4-v6) and the JSON format are supported.
+  Each call of poll() reads only the data appended after the last consumed
+  byte and delivers the complete records to the handler. An incomplete last
+  line is kept until the rest of it is written, so every record is delivered
+  exactly once. The compressed files cannot be followed.
+
+  If the file becomes shorter than the consumed size, the file is regarded
+  as replaced, and it is read again from the beginning.
+*/
+class LogFollower {
+private:
+
+    std::string M_filepath; //!< followed file path
+    int M_fd; //!< file descriptor. -1 if not opened.
+    std::uint64_t M_inode; //!< inode number of the opened file
+    int M_notify_fd; //!< inotify descriptor. -1 if not available.
+
+    std::uint64_t M_offset; //!< the number of consumed bytes
+    int M_version; //!< detected log version. 0 before the header is read.
+    int M_n_line; //!< the number of consumed lines
+
+    std::vector< char > M_buffer; //!< read buffer
+    std::string M_partial; //!< incomplete last line
+    std::string M_json_record; //!< reused copy of the JSON record
+
+    ParserV4 M_parser; //!< parser of the text lines
+    ParserSimdJSON M_json_parser; //!< parser of the JSON records
+
+    // not used
+    LogFollower( const LogFollower & ) = delete;
+    LogFollower & operator=( const LogFollower & ) = delete;
+
+public:
+
+    /*!
+      \brief set the file path. the file is opened by the first poll().
+      \param filepath path to the rcg file
+     */
+    explicit
+    LogFollower( const std::string & filepath );
+
+    /*!
+      \brief close the file
+     */
+    ~LogFollower();
+
+    /*!
+      \brief get the followed file path
+      \return file path
+     */
+    const std::string & filepath() const
+      {
+          return M_filepath;
+      }
+
+    /*!
+      \brief get the detected log version
+      \return log version. 0 before the header is read.
+     */
+    int version() const
+      {
+          return M_version;
+      }
+
+    /*!
+      \brief get the number of consumed bytes
+      \return byte offset of the first unread byte
+     */
+    std::uint64_t offset() const
+      {
+          return M_offset;
+      }
+
+    /*!
+      \brief read the appended data and deliver the complete records to the handler
+      \param handler reference to the rcg data handler
+      \return the number of consumed lines, or -1 if an error occured.
+      0 is also returned if the file does not exist yet.
+     */
+    int poll( Handler & handler );
+
+    /*!
+      \brief wait until the file is modified.
+      inotify is used if available, otherwise the file size is checked periodically.
+      \param timeout_msec the maximum waiting time in milliseconds
+      \return true if the new data may be available
+     */
+    bool wait( const int timeout_msec );
+
+    /*!
+      \brief deliver the remaining incomplete line and call Handler::handleEOF().
+      call this when the writer has finished.
+      \param handler reference to the rcg data handler
+      \return the result of the handler
+     */
+    bool finish( Handler & handler );
+
+private:
+
+    /*!
+      \brief open the file if not opened
+      \return true if the file is opened
+     */
+    bool openFile();
+
+    /*!
+      \brief close the file and reset the state
+     */
+    void closeFile();
+
+    /*!
+      \brief get the current file size
+      \return file size. -1 if not available.
+     */
+    std::int64_t fileSize() const;
+
+    /*!
+      \brief deliver one complete line
+      \param line line data without the new line character
+      \param handler reference to the rcg data handler
+      \return false if an illegal line is found.
+     */
+    bool parseLine( std::string_view line,
+                    Handler & handler );
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,460 @@
+// -*-c++-*-
+
+/*!
+  \file log_index.cpp
+  \brief cycle index of the text rcg data Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "log_index.h"
+
+#include "types.h"
+#include "util.h"
+
+#include <rcsc/util/playmode_decoder.h>
+
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+
+namespace rcsc {
+namespace rcg {
+
+namespace {
+
+//! the first word of the index file
+const char * const INDEX_MAGIC = "ULGIDX";
+
+//! index file format version
+constexpr int INDEX_FORMAT_VERSION = 1;
+
+//! record type characters in the index file
+const char RECORD_TYPE_CHARS[] = "sptSPT";
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief skip the space characters
+ */
+const char *
+skip_space( const char * buf,
+            const char * end )
+{
+    while ( buf < end && ( *buf == ' ' || *buf == '\t' ) ) ++buf;
+    return buf;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief skip one token delimited by the space characters
+ */
+const char *
+skip_token( const char * buf,
+            const char * end )
+{
+    buf = skip_space( buf, end );
+    while ( buf < end && *buf != ' ' && *buf != '\t' && *buf != ')' ) ++buf;
+    return buf;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read one integer value after the space characters
+  \return true if an integer is read
+ */
+bool
+read_int( const char ** buf,
+          const char * end,
+          int * value )
+{
+    const char * p = skip_space( *buf, end );
+    const std::from_chars_result r = std::from_chars( p, end, *value );
+    if ( r.ec != std::errc() )
+    {
+        return false;
+    }
+    *buf = r.ptr;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief check the tag of the line and get the position just after it
+  \return pointer to the next character of the tag. NULL if not matched.
+ */
+const char *
+match_tag( const std::string_view line,
+           const std::string_view tag )
+{
+    if ( line.size() < tag.size() + 1
+         || line[0] != '('
+         || line.compare( 1, tag.size(), tag ) != 0 )
+    {
+        return nullptr;
+    }
+
+    const char c = line[tag.size() + 1];
+    if ( c != ' ' && c != ')' )
+    {
+        return nullptr;
+    }
+
+    return line.data() + tag.size() + 1;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+LogIndex::LogIndex()
+    : M_version( 0 ),
+      M_data_size( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::string
+LogIndex::sidecar_path( const std::string & log_path )
+{
+    return log_path + ".idx";
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+LogIndex::clear()
+{
+    M_version = 0;
+    M_data_size = 0;
+    M_shows.clear();
+    M_events.clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+LogIndex::build( const char * data,
+                 const std::size_t size )
+{
+    clear();
+
+    const char * const end = data + size;
+    const char * line_end = static_cast< const char * >( std::memchr( data, '\n', size ) );
+    if ( ! line_end ) line_end = end;
+
+    int version = 0;
+    if ( line_end - data < 4
+         || std::strncmp( data, "ULG", 3 ) != 0
+         || std::from_chars( data + 3, line_end, version ).ec != std::errc()
+         || ( version != REC_VERSION_4
+              && version != REC_VERSION_5
+              && version != REC_VERSION_6 ) )
+    {
+        std::cerr << "(LogIndex::build) unsupported rcg data." << std::endl;
+        return false;
+    }
+
+    M_version = version;
+    M_data_size = size;
+
+    int n_line = 1;
+    int last_cycle = -1;
+    int last_stopped = 0;
+
+    const char * line_begin = std::min( line_end + 1, end );
+    while ( line_begin < end )
+    {
+        line_end = static_cast< const char * >( std::memchr( line_begin, '\n', end - line_begin ) );
+        if ( ! line_end ) line_end = end;
+
+        ++n_line;
+
+        const std::string_view line( line_begin, line_end - line_begin );
+        Record rec = { SHOW, last_cycle < 0 ? 0 : last_cycle, 0,
+                       static_cast< std::size_t >( line_begin - data ), n_line, { 0, 0 } };
+        const char * p = nullptr;
+
+        if ( ( p = match_tag( line, "show" ) ) )
+        {
+            if ( read_int( &p, line_end, &rec.cycle_ ) )
+            {
+                rec.stopped_ = ( rec.cycle_ == last_cycle ? last_stopped + 1 : 0 );
+                last_cycle = rec.cycle_;
+                last_stopped = rec.stopped_;
+                M_shows.push_back( rec );
+            }
+        }
+        else if ( ( p = match_tag( line, "playmode" ) ) )
+        {
+            if ( read_int( &p, line_end, &rec.cycle_ ) )
+            {
+                p = skip_space( p, line_end );
+                const char * name_end = p;
+                while ( name_end < line_end && *name_end != ')' && *name_end != ' ' ) ++name_end;
+
+                PlayModeInfo info;
+                PlayModeDecoder::decode( p, name_end - p, &info );
+
+                rec.type_ = PLAYMODE;
+                rec.value_[0] = static_cast< int >( info.pmode_ );
+                M_events.push_back( rec );
+            }
+        }
+        else if ( ( p = match_tag( line, "team" ) ) )
+        {
+            if ( read_int( &p, line_end, &rec.cycle_ ) )
+            {
+                p = skip_token( p, line_end );
+                p = skip_token( p, line_end );
+                if ( read_int( &p, line_end, &rec.value_[0] )
+                     && read_int( &p, line_end, &rec.value_[1] ) )
+                {
+                    rec.type_ = TEAM;
+                    M_events.push_back( rec );
+                }
+            }
+        }
+        else if ( match_tag( line, "server_param" ) )
+        {
+            rec.type_ = SERVER_PARAM;
+            M_events.push_back( rec );
+        }
+        else if ( match_tag( line, "player_param" ) )
+        {
+            rec.type_ = PLAYER_PARAM;
+            M_events.push_back( rec );
+        }
+        else if ( match_tag( line, "player_type" ) )
+        {
+            rec.type_ = PLAYER_TYPE;
+            M_events.push_back( rec );
+        }
+
+        line_begin = line_end + 1;
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+LogIndex::read( const std::string & filepath )
+{
+    clear();
+
+    std::ifstream fin( filepath.c_str() );
+    if ( ! fin.is_open() )
+    {
+        return false;
+    }
+
+    std::string magic;
+    int format_version = 0;
+    std::size_t n_shows = 0, n_events = 0;
+    if ( ! ( fin >> magic >> format_version >> M_version >> M_data_size >> n_shows >> n_events )
+         || magic != INDEX_MAGIC
+         || format_version != INDEX_FORMAT_VERSION )
+    {
+        std::cerr << "(LogIndex::read) illegal index file [" << filepath << "]" << std::endl;
+        clear();
+        return false;
+    }
+
+    M_shows.reserve( n_shows );
+    M_events.reserve( n_events );
+
+    for ( std::size_t i = 0; i < n_shows + n_events; ++i )
+    {
+        char type_char = 0;
+        Record rec;
+        if ( ! ( fin >> type_char >> rec.cycle_ >> rec.stopped_ >> rec.offset_ >> rec.line_
+                 >> rec.value_[0] >> rec.value_[1] ) )
+        {
+            std::cerr << "(LogIndex::read) broken index file [" << filepath << "]" << std::endl;
+            clear();
+            return false;
+        }
+
+        const char * type_pos = std::strchr( RECORD_TYPE_CHARS, type_char );
+        if ( type_char == '\0' || ! type_pos )
+        {
+            std::cerr << "(LogIndex::read) unknown record type [" << filepath << "]" << std::endl;
+            clear();
+            return false;
+        }
+
+        rec.type_ = static_cast< RecordType >( type_pos - RECORD_TYPE_CHARS );
+        if ( rec.type_ == SHOW )
+        {
+            M_shows.push_back( rec );
+        }
+        else
+        {
+            M_events.push_back( rec );
+        }
+    }
+
+    if ( M_shows.size() != n_shows )
+    {
+        std::cerr << "(LogIndex::read) broken index file [" << filepath << "]" << std::endl;
+        clear();
+        return false;
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+LogIndex::write( const std::string & filepath ) const
+{
+    std::ofstream fout( filepath.c_str() );
+    if ( ! fout.is_open() )
+    {
+        std::cerr << "(LogIndex::write) could not open [" << filepath << "]" << std::endl;
+        return false;
+    }
+
+    fout << INDEX_MAGIC << ' ' << INDEX_FORMAT_VERSION
+         << ' ' << M_version << ' ' << M_data_size
+         << ' ' << M_shows.size() << ' ' << M_events.size() << '\n';
+
+    // both containers are merged in the file order.
+    std::vector< Record >::const_iterator s = M_shows.begin();
+    std::vector< Record >::const_iterator e = M_events.begin();
+    while ( s != M_shows.end() || e != M_events.end() )
+    {
+        const Record & rec = ( e == M_events.end()
+                               || ( s != M_shows.end() && s->offset_ < e->offset_ )
+                               ? *s++
+                               : *e++ );
+        fout << RECORD_TYPE_CHARS[rec.type_]
+             << ' ' << rec.cycle_ << ' ' << rec.stopped_
+             << ' ' << rec.offset_ << ' ' << rec.line_
+             << ' ' << rec.value_[0] << ' ' << rec.value_[1] << '\n';
+    }
+
+    fout.flush();
+    return static_cast< bool >( fout );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const LogIndex::Record *
+LogIndex::findShow( const GameTime & time ) const
+{
+    std::vector< Record >::const_iterator it
+        = std::lower_bound( M_shows.begin(), M_shows.end(), time,
+                            []( const Record & rec, const GameTime & t )
+                              {
+                                  return rec.time() < t;
+                              } );
+
+    // the show lines are normally sorted by time. if not, fall back to the linear search.
+    if ( it == M_shows.end()
+         || ( it != M_shows.begin() && time <= ( it - 1 )->time() ) )
+    {
+        it = std::find_if( M_shows.begin(), M_shows.end(),
+                           [&time]( const Record & rec )
+                             {
+                                 return time <= rec.time();
+                             } );
+    }
+
+    return ( it != M_shows.end()
+             ? &( *it )
+             : nullptr );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const LogIndex::Record *
+LogIndex::findLastEvent( const RecordType type,
+                         const std::size_t offset ) const
+{
+    const Record * result = nullptr;
+    for ( const Record & rec : M_events )
+    {
+        if ( rec.offset_ >= offset ) break;
+        if ( rec.type_ == type ) result = &rec;
+    }
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::vector< const LogIndex::Record * >
+LogIndex::goals() const
+{
+    std::vector< const Record * > result;
+
+    int score_l = 0, score_r = 0;
+    for ( const Record & rec : M_events )
+    {
+        if ( rec.type_ != TEAM ) continue;
+
+        if ( rec.value_[0] > score_l
+             || rec.value_[1] > score_r )
+        {
+            result.push_back( &rec );
+        }
+        score_l = rec.value_[0];
+        score_r = rec.value_[1];
+    }
+
+    return result;
+}
+
+}
+}
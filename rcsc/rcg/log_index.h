@@ -0,0 +1,216 @@
+// -*-c++-*-
+
+/*!
+  \file log_index.h
+  \brief cycle index of the text rcg data Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_RCG_LOG_INDEX_H
+#define RCSC_RCG_LOG_INDEX_H
+
+#include <rcsc/game_time.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace rcsc {
+namespace rcg {
+
+/*!
+  \class LogIndex
+  \brief byte offsets of the show lines and the state change lines in the text rcg data.
+
+  The index is built by one scan of the uncompressed data (rcg v4-v6).
+  Each show record has the game time of the show line. The stopped time is
+  counted by the repeated show lines of the same cycle.
+  Event records are the playmode and team lines and the parameter lines.
+  The offsets always refer to the uncompressed data, so the index of a
+  compressed file is also valid.
+
+  The index can be saved as a small text file next to the log file.
+  The saved index is used only if its data size is the same as the log data.
+*/
+class LogIndex {
+public:
+
+    /*!
+      \brief indexed line type
+     */
+    enum RecordType {
+        SHOW,
+        PLAYMODE,
+        TEAM,
+        SERVER_PARAM,
+        PLAYER_PARAM,
+        PLAYER_TYPE,
+    };
+
+    /*!
+      \struct Record
+      \brief one indexed line
+     */
+    struct Record {
+        RecordType type_; //!< line type
+        int cycle_; //!< cycle of the line. the last show cycle for the parameter lines.
+        int stopped_; //!< stopped time. always 0 except for the show lines.
+        std::size_t offset_; //!< byte offset of the first character of the line
+        int line_; //!< line number. the header line is 1.
+        int value_[2]; //!< playmode id for PLAYMODE, left/right score for TEAM, 0 otherwise.
+
+        /*!
+          \brief get the game time of this record
+          \return game time
+         */
+        GameTime time() const
+          {
+              return GameTime( cycle_, stopped_ );
+          }
+    };
+
+private:
+
+    int M_version; //!< log version
+    std::size_t M_data_size; //!< total size of the indexed data
+    std::vector< Record > M_shows; //!< show records in the file order
+    std::vector< Record > M_events; //!< other records in the file order
+
+public:
+
+    /*!
+      \brief create an empty index
+     */
+    LogIndex();
+
+    /*!
+      \brief get the sidecar file path of the log file
+      \param log_path path to the rcg file
+      \return index file path
+     */
+    static
+    std::string sidecar_path( const std::string & log_path );
+
+    /*!
+      \brief remove all records
+     */
+    void clear();
+
+    /*!
+      \brief check if the index has no record
+      \return checked result
+     */
+    bool empty() const
+      {
+          return M_shows.empty() && M_events.empty();
+      }
+
+    /*!
+      \brief get the log version of the indexed data
+      \return version number. 0 if empty.
+     */
+    int version() const
+      {
+          return M_version;
+      }
+
+    /*!
+      \brief get the total size of the indexed data
+      \return byte size of the uncompressed data
+     */
+    std::size_t dataSize() const
+      {
+          return M_data_size;
+      }
+
+    /*!
+      \brief get the show records
+      \return const reference to the record container
+     */
+    const std::vector< Record > & shows() const
+      {
+          return M_shows;
+      }
+
+    /*!
+      \brief get the playmode, team and parameter records
+      \return const reference to the record container
+     */
+    const std::vector< Record > & events() const
+      {
+          return M_events;
+      }
+
+    /*!
+      \brief create the index from the whole text rcg data
+      \param data pointer to the first byte of the data (the header line)
+      \param size data length
+      \return true if the data is a text rcg
+     */
+    bool build( const char * data,
+                const std::size_t size );
+
+    /*!
+      \brief read the index file
+      \param filepath path to the index file
+      \return true if successfully read
+     */
+    bool read( const std::string & filepath );
+
+    /*!
+      \brief write the index file
+      \param filepath path to the index file
+      \return true if successfully written
+     */
+    bool write( const std::string & filepath ) const;
+
+    /*!
+      \brief find the first show record that is not before the given time
+      \param time target game time
+      \return pointer to the record. NULL if no show is found.
+     */
+    const Record * findShow( const GameTime & time ) const;
+
+    /*!
+      \brief find the last event record of the type before the given offset
+      \param type event type
+      \param offset byte offset in the data
+      \return pointer to the record. NULL if not found.
+     */
+    const Record * findLastEvent( const RecordType type,
+                                  const std::size_t offset ) const;
+
+    /*!
+      \brief get the team records that increase the score of either team
+      \return record pointer container in the file order
+     */
+    std::vector< const Record * > goals() const;
+};
+
+}
+}
+
+#endif
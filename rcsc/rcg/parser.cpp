@@ -41,9 +41,14 @@
 #include "parser_v2.h"
 #include "parser_v3.h"
 #include "parser_v4.h"
+#include "parser_v7.h"
 #include "parser_simdjson.h"
 
-#include <fstream>
+#include <rcsc/gz/compressed_fstream.h>
+
+#include <iostream>
+#include <thread>
+#include <algorithm>
 
 namespace rcsc {
 namespace rcg {
@@ -96,7 +101,8 @@ Parser::create( std::istream & is )
     }
     else
     {
-        std::cerr << ( version == static_cast< int >( '0' ) + REC_VERSION_6 ? REC_VERSION_6
+        std::cerr << ( version == static_cast< int >( '0' ) + REC_VERSION_7 ? REC_VERSION_7
+                       : version == static_cast< int >( '0' ) + REC_VERSION_6 ? REC_VERSION_6
                        : version == static_cast< int >( '0' ) + REC_VERSION_5 ? REC_VERSION_5
                        : version == static_cast< int >( '0' ) + REC_VERSION_4 ? REC_VERSION_4
                        : version );
@@ -109,25 +115,28 @@ Parser::create( std::istream & is )
     {
         ptr = creator();
     }
+    else if ( version == static_cast< int >( '0' ) + REC_VERSION_7 ) ptr = Parser::Ptr( new ParserV7() );
     else if ( version == static_cast< int >( '0' ) + REC_VERSION_6 ) ptr = Parser::Ptr( new ParserV4() );
     else if ( version == static_cast< int >( '0' ) + REC_VERSION_5 ) ptr = Parser::Ptr( new ParserV4() );
     else if ( version == static_cast< int >( '0' ) + REC_VERSION_4 ) ptr = Parser::Ptr( new ParserV4() );
     else if ( version == REC_VERSION_3 ) ptr = Parser::Ptr( new ParserV3() );
     else if ( version == REC_VERSION_2 ) ptr = Parser::Ptr( new ParserV2() );
     else if ( version == REC_OLD_VERSION ) ptr = Parser::Ptr( new ParserV1() );
-    //else if ( version == REC_VERSION_JSON ) ptr = Parser::Ptr( new ParserJSON() );
     else if ( version == REC_VERSION_JSON ) ptr = Parser::Ptr( new ParserSimdJSON() );
 
     return ptr;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
 
+*/
 bool
 Parser::parse( const std::string & filepath,
                Handler & handler ) const
 {
-    std::ifstream fin( filepath );
-    if ( ! fin )
+    compressed_ifstream fin( filepath.c_str() );
+    if ( ! fin.is_open() )
     {
         return false;
     }
@@ -135,6 +144,33 @@ Parser::parse( const std::string & filepath,
     return parse( fin, handler );
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+Parser::seek( const std::string &,
+              const GameTime &,
+              Handler &,
+              LogIndex * ) const
+{
+    std::cerr << "(rcsc::rcg::Parser::seek) rcg version " << version()
+              << " does not support seeking." << std::endl;
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+Parser::setJobs( const int jobs )
+{
+    M_jobs = ( jobs > 0
+               ? jobs
+               : std::max( 1, static_cast< int >( std::thread::hardware_concurrency() ) ) );
+}
+
 
 }
 }
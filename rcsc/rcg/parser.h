@@ -33,6 +33,7 @@
 #define RCSC_RCG_PARSER_H
 
 #include <rcsc/factory.h>
+#include <rcsc/game_time.h>
 
 #include <memory>
 #include <istream>
@@ -41,6 +42,7 @@ namespace rcsc {
 namespace rcg {
 
 class Handler;
+class LogIndex;
 
 /////////////////////////////////////////////////////////////////////
 
@@ -68,10 +70,23 @@ public:
       \return smart pointer to the rcg parser instance
 
       poionted index of istream becomes 4.
+
+      The creator registered to creators() is used first. Otherwise, JSON rcg
+      is parsed by ParserSimdJSON, which selects the SIMD implementation for
+      the running CPU at runtime. Register ParserJSON::create for
+      REC_VERSION_JSON to use the nlohmann based parser instead.
      */
     static
     Ptr create( std::istream & is );
 
+private:
+
+    //! the number of threads used to parse one file
+    int M_jobs = 1;
+
+    //! if true, the index file next to the log file is read and written.
+    bool M_use_index_file = false;
+
 protected:
 
     /*!
@@ -106,9 +121,75 @@ public:
     bool parse( std::istream & is,
                 Handler & handler ) const = 0;
 
+    /*!
+      \brief analyze the rcg file.
+      \param filepath path to the rcg file. a compressed file is also accepted.
+      \param handler reference to the rcg data handler.
+      \retval true, if successfuly parsed.
+      \retval false, if incorrect format is detected.
+     */
     virtual
     bool parse( const std::string & filepath,
                 Handler & handler ) const;
+
+    /*!
+      \brief set the number of threads used to parse one file.
+      \param jobs thread count. 0 or a negative value means the number of hardware threads.
+
+      The parsers that support the intra-file parallelism split the data into cycle chunks.
+      The handler callbacks are always called from the caller thread. They are called
+      in the file order unless Handler::acceptsUnorderedCallbacks() returns true.
+     */
+    void setJobs( const int jobs );
+
+    /*!
+      \brief get the number of threads used to parse one file.
+      \return thread count
+     */
+    int jobs() const
+      {
+          return M_jobs;
+      }
+
+    /*!
+      \brief analyze the rcg file from the given game time.
+      \param filepath path to the rcg file. a compressed file is also accepted.
+      \param start the first show time delivered to the handler
+      \param handler reference to the rcg data handler.
+      \param index pointer to the index of the file. if it is empty or does not
+      match the file, it is rebuilt here. if NULL, a temporary index is used.
+      \retval true, if successfuly parsed.
+      \retval false, if incorrect format is detected or seeking is not supported.
+
+      The parameter lines, the last playmode and the last team before the start
+      show are delivered first, and then all data from the start show are parsed.
+      Keeping one index for several calls avoids rescanning the file.
+      The default implementation does not support seeking.
+     */
+    virtual
+    bool seek( const std::string & filepath,
+               const GameTime & start,
+               Handler & handler,
+               LogIndex * index = nullptr ) const;
+
+    /*!
+      \brief set the index file usage.
+      \param on if true, parse by file path writes the index file next to the log
+      file if it does not exist, and seek() reads it instead of scanning the data.
+     */
+    void setUseIndexFile( const bool on )
+      {
+          M_use_index_file = on;
+      }
+
+    /*!
+      \brief get the index file usage.
+      \return true if the index file is used.
+     */
+    bool useIndexFile() const
+      {
+          return M_use_index_file;
+      }
 };
 
 } // end of namespace
@@ -340,7 +340,14 @@ public:
 
     void handleShow( const ShowInfoT & show )
       {
-          M_handler.handleShow( show );
+          if ( M_handler.wantsShow( show.time_ ) )
+          {
+              M_handler.handleShow( show );
+          }
+          else
+          {
+              M_handler.handleSkippedShow( show.time_ );
+          }
       }
 
     void handleMsg( const int time,
@@ -1618,6 +1625,13 @@ ParserJSON::ParserJSON()
     // std::cerr << "(ParserJSON) create" << std::endl;
 }
 
+/*-------------------------------------------------------------------*/
+Parser::Ptr
+ParserJSON::create()
+{
+    return Parser::Ptr( new ParserJSON() );
+}
+
 /*-------------------------------------------------------------------*/
 bool
 ParserJSON::parse( std::istream & is,
@@ -1633,11 +1647,9 @@ ParserJSON::parse( std::istream & is,
 
     handler.handleLogVersion( REC_VERSION_JSON );
 
+    // handleEOF() is called by the context at the end of the top level array.
     Context context( handler );
-    bool result = nlohmann::json::sax_parse( is, &context );
-
-    handler.handleEOF();
-    return result;
+    return nlohmann::json::sax_parse( is, &context );
 }
 
 /*-------------------------------------------------------------------*/
@@ -1652,16 +1664,5 @@ ParserJSON::parseData( const std::string & input,
 }
 
 
-// namespace {
-// Parser::Ptr
-// create_json()
-// {
-//     Parser::Ptr ptr( new ParserJSON() );
-//     return ptr;
-// }
-
-// rcss::RegHolder vjson = Parser::creators().autoReg( &create_json, REC_VERSION_JSON );
-// }
-
 } // end of namespace
 } // end of namespace
@@ -43,7 +43,11 @@ namespace rcg {
 
 /*!
   \class ParserJSON
-  \brief JSON rcg parser class
+  \brief JSON rcg parser class based on the nlohmann SAX interface.
+
+  Parser::create() selects ParserSimdJSON for JSON rcg files by default.
+  This parser is kept only as the compatibility mode. It is used when
+  ParserJSON::create is registered to Parser::creators() for REC_VERSION_JSON.
  */
 class ParserJSON
     : public Parser {
@@ -54,6 +58,13 @@ public:
     */
     ParserJSON();
 
+    /*!
+      \brief create the parser instance. this can be registered to Parser::creators().
+      \return smart pointer to the new parser instance
+     */
+    static
+    Parser::Ptr create();
+
     /*!
       \brief get supported rcg version
       \return version number
@@ -41,9 +41,15 @@
 
 #include "simdjson/simdjson.h"
 
+#include <rcsc/gz/compressed_fstream.h>
+#include <rcsc/util/playmode_decoder.h>
+
 #include <unordered_map>
 #include <string_view>
 #include <functional>
+#include <vector>
+#include <algorithm>
+#include <cstring>
 
 namespace rcsc {
 namespace rcg {
@@ -51,12 +57,25 @@ namespace rcg {
 
 struct ParserSimdJSON::Impl {
 
+    //! initial size of the streaming buffer. grown only if one record is larger.
+    static const std::size_t STREAM_BUFFER_SIZE = 1024 * 1024;
+
     using Func = std::function< bool( simdjson::ondemand::value & val, Handler & handler ) >;
     std::unordered_map< std::string, Func > funcs_;
     //std::unordered_map< simdjson::ondemand::raw_json_string, Func > funcs_;
 
+    simdjson::ondemand::parser parser_; //!< reused for all records
+    std::vector< char > buffer_; //!< reused padded input buffer
+
     Impl();
 
+    bool parseStream( std::istream & is,
+                      Handler & handler );
+    bool parseRecords( const std::size_t size,
+                       Handler & handler );
+    bool parseRecord( const std::string & input,
+                      Handler & handler );
+
     bool parseData( simdjson::ondemand::field & field,
                     Handler & handler );
 
@@ -82,6 +101,8 @@ struct ParserSimdJSON::Impl {
                     Handler & handler );
 };
 
+const std::size_t ParserSimdJSON::Impl::STREAM_BUFFER_SIZE;
+
 /*-------------------------------------------------------------------*/
 ParserSimdJSON::Impl::Impl()
 {
@@ -113,6 +134,10 @@ ParserSimdJSON::Impl::Impl()
     funcs_["\"team_graphic\""]
         = [this]( simdjson::ondemand::value & val, Handler & handler ) -> bool
           {
+              if ( ! handler.projection().teamGraphic() )
+              {
+                  return true;
+              }
               return this->parseTeamGraphic( val, handler );
           };
     funcs_["\"playmode\""]
@@ -156,6 +181,12 @@ ParserSimdJSON::Impl::parseData( simdjson::ondemand::field & field,
         return false;
     }
 
+    // the queued shows are delivered before any other record.
+    if ( key != "\"show\"" )
+    {
+        handler.flushShows();
+    }
+
     if ( ! it->second( field.value(), handler ) )
     {
         return false;
@@ -164,6 +195,179 @@ ParserSimdJSON::Impl::parseData( simdjson::ondemand::field & field,
     return true;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read the top level array incrementally.
+
+  The input is read into the reused buffer. The top level brackets and the
+  commas between the records are replaced by white spaces, so the complete
+  records in the buffer become a sequence of documents for iterate_many().
+  The incomplete last record is moved to the front of the buffer and
+  completed by the next read. The memory usage is bounded by the buffer size
+  (or the largest record) regardless of the game length.
+*/
+bool
+ParserSimdJSON::Impl::parseStream( std::istream & is,
+                                   Handler & handler )
+{
+    if ( buffer_.size() < STREAM_BUFFER_SIZE + simdjson::SIMDJSON_PADDING )
+    {
+        buffer_.resize( STREAM_BUFFER_SIZE + simdjson::SIMDJSON_PADDING );
+    }
+
+    std::size_t filled = 0; // size of the data in the buffer
+    std::size_t scanned = 0; // size of the already scanned data
+    int depth = 0; // 1 means the inside of the top level array
+    bool in_string = false;
+    bool escaped = false;
+    bool started = false;
+    bool finished = false;
+
+    while ( ! finished )
+    {
+        const std::size_t capacity = buffer_.size() - simdjson::SIMDJSON_PADDING;
+        if ( filled == capacity )
+        {
+            // one record is larger than the buffer
+            buffer_.resize( capacity * 2 + simdjson::SIMDJSON_PADDING );
+            continue;
+        }
+
+        is.read( buffer_.data() + filled, capacity - filled );
+        const std::size_t n = static_cast< std::size_t >( is.gcount() );
+        if ( n == 0 )
+        {
+            break;
+        }
+        filled += n;
+
+        char * const buf = buffer_.data();
+        std::size_t complete = 0; // the end of the last complete record
+        for ( std::size_t i = scanned; i < filled; ++i )
+        {
+            const char c = buf[i];
+            if ( in_string )
+            {
+                if ( escaped ) escaped = false;
+                else if ( c == '\\' ) escaped = true;
+                else if ( c == '"' ) in_string = false;
+                continue;
+            }
+
+            switch ( c ) {
+            case '"':
+                in_string = true;
+                break;
+            case '{':
+            case '[':
+                if ( depth == 0 )
+                {
+                    if ( c != '[' || started )
+                    {
+                        std::cerr << "(ParserSimdJSON::parseStream) ERROR: the top level is not an array."
+                                  << std::endl;
+                        return false;
+                    }
+                    started = true;
+                    buf[i] = ' ';
+                }
+                ++depth;
+                break;
+            case '}':
+            case ']':
+                --depth;
+                if ( depth == 0 )
+                {
+                    buf[i] = ' ';
+                    complete = i + 1;
+                    finished = true;
+                    i = filled; // ignore the trailing data
+                }
+                else if ( depth == 1 )
+                {
+                    complete = i + 1;
+                }
+                break;
+            case ',':
+                if ( depth == 1 ) buf[i] = ' ';
+                break;
+            default:
+                break;
+            }
+        }
+        scanned = filled;
+
+        if ( complete > 0 )
+        {
+            if ( ! parseRecords( complete, handler ) )
+            {
+                return false;
+            }
+
+            std::memmove( buf, buf + complete, filled - complete );
+            filled -= complete;
+            scanned = ( finished ? 0 : filled );
+        }
+    }
+
+    if ( ! finished )
+    {
+        std::cerr << "(ParserSimdJSON::parseStream) ERROR: unexpected end of the array."
+                  << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+bool
+ParserSimdJSON::Impl::parseRecords( const std::size_t size,
+                                    Handler & handler )
+{
+    // the batch covers all given records, so no lookahead thread is used.
+    simdjson::ondemand::document_stream records
+        = parser_.iterate_many( buffer_.data(), size,
+                                std::max( size, simdjson::dom::MINIMAL_BATCH_SIZE ) );
+
+    for ( simdjson::ondemand::document_reference record : records )
+    {
+        for ( simdjson::ondemand::field field : record.get_object() )
+        {
+            if ( ! parseData( field, handler ) )
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+bool
+ParserSimdJSON::Impl::parseRecord( const std::string & input,
+                                   Handler & handler )
+{
+    if ( buffer_.size() < input.size() + simdjson::SIMDJSON_PADDING )
+    {
+        buffer_.resize( input.size() + simdjson::SIMDJSON_PADDING );
+    }
+    std::memcpy( buffer_.data(), input.data(), input.size() );
+
+    simdjson::ondemand::document data = parser_.iterate( buffer_.data(), input.size(), buffer_.size() );
+
+    for ( simdjson::ondemand::field field : data.get_object() )
+    {
+        if ( ! parseData( field, handler ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 /*-------------------------------------------------------------------*/
 bool
 ParserSimdJSON::Impl::parseVersion( simdjson::ondemand::value & /*val*/,
@@ -275,12 +479,11 @@ ParserSimdJSON::Impl::parseTeamGraphic( simdjson::ondemand::value & val,
         int64_t x = val["x"].get_int64();
         int64_t y = val["y"].get_int64();
 
-        std::vector< std::string > xpm_data;
+        // the unescaped strings stay in the parser buffer until the next document.
+        std::vector< std::string_view > xpm_data;
         for ( simdjson::ondemand::value s : val["xpm"].get_array() )
         {
-            std::string str;
-            s.get_string( str );
-            xpm_data.push_back( str );
+            xpm_data.push_back( s.get_string().value() );
         }
 
         result = handler.handleTeamGraphic( side[0], x, y, xpm_data );
@@ -374,7 +577,7 @@ ParserSimdJSON::Impl::parseMsg( simdjson::ondemand::value & val,
     {
         result = handler.handleMsg( val["time"].get_int64(),
                                     val["board"].get_int64(),
-                                    std::string( val["message"].get_string().value() ) );
+                                    val["message"].get_string().value() );
     }
     catch ( std::exception & e )
     {
@@ -412,7 +615,9 @@ ParserSimdJSON::Impl::parseShow( simdjson::ondemand::value & val,
         err = val["mode"].get_string().get( stmp );
         if ( err == simdjson::SUCCESS )
         {
-            if ( ! handler.handlePlayMode( show.time_, to_playmode_enum( std::string( stmp ) ) ) )
+            PlayModeInfo info;
+            PlayModeDecoder::decode( stmp.data(), stmp.size(), &info );
+            if ( ! handler.dispatchPlayMode( show.time_, info.pmode_ ) )
             {
                 return false;
             }
@@ -429,17 +634,34 @@ ParserSimdJSON::Impl::parseShow( simdjson::ondemand::value & val,
         }
     }
 
-    try
+    if ( ! handler.wantsShow( show.time_ ) )
     {
-        show.ball_.x_ = val["ball"]["x"].get_double();
-        show.ball_.y_ = val["ball"]["y"].get_double();
-        show.ball_.vx_ = val["ball"]["vx"].get_double();
-        show.ball_.vy_ = val["ball"]["vy"].get_double();
+        handler.flushShows();
+        return handler.handleSkippedShow( show.time_ );
     }
-    catch ( std::exception & e )
+
+    const Projection & projection = handler.projection();
+
+    if ( projection.hasField( Projection::BALL ) )
     {
-        std::cerr << "(ParserSimdJSON::parseShow) ball part: " << e.what() << std::endl;
-        return false;
+        try
+        {
+            show.ball_.x_ = val["ball"]["x"].get_double();
+            show.ball_.y_ = val["ball"]["y"].get_double();
+            show.ball_.vx_ = val["ball"]["vx"].get_double();
+            show.ball_.vy_ = val["ball"]["vy"].get_double();
+        }
+        catch ( std::exception & e )
+        {
+            std::cerr << "(ParserSimdJSON::parseShow) ball part: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    if ( ! projection.hasField( Projection::PLAYERS ) )
+    {
+        // unread values are skipped by the on-demand parser.
+        return handler.dispatchShow( show );
     }
 
     size_t i = 0;
@@ -457,71 +679,87 @@ ParserSimdJSON::Impl::parseShow( simdjson::ondemand::value & val,
             stmp = p["side"].get_string();
             show.player_[i].side_ = stmp[0];
             show.player_[i].unum_ = p["unum"].get_int64();
-            show.player_[i].type_ = p["type"].get_int64();
-            show.player_[i].state_ = p["state"].get_int64();
-
-            // pos
-            show.player_[i].x_ = p["x"].get_double();
-            show.player_[i].y_ = p["y"].get_double();
-            show.player_[i].vx_ = p["vx"].get_double();
-            show.player_[i].vy_ = p["vy"].get_double();
-            show.player_[i].body_ = p["body"].get_double();
-            show.player_[i].neck_ = p["neck"].get_double();
-
-            // arm
-            err = p["px"].get_double().get( dtmp );
-            if ( err == simdjson::SUCCESS ) show.player_[i].point_x_ = dtmp;
-            err = p["py"].get_double().get( dtmp );
-            if ( err == simdjson::SUCCESS ) show.player_[i].point_y_ = dtmp;
-
-            // view mode
-            stmp = p["vq"].get_string();
-            show.player_[i].view_quality_ = ( stmp == "h" ? true : false );
-            show.player_[i].view_width_ = p["vw"].get_double();
-
-            // focus point
-            err = p["fdist"].get_double().get( dtmp );
-            if ( err == simdjson::SUCCESS ) show.player_[i].focus_dist_ = dtmp;
-            err = p["fdir"].get_double().get( dtmp );
-            if ( err == simdjson::SUCCESS ) show.player_[i].focus_dir_ = dtmp;
-
-            // stamina
-            show.player_[i].stamina_ = p["stamina"].get_double();
-            show.player_[i].effort_ = p["effort"].get_double();
-            show.player_[i].recovery_ = p["recovery"].get_double();
-            show.player_[i].stamina_capacity_ = p["capacity"].get_double();
-
-            // focus
-            err = p["fside"].get_string().get( stmp );
-            if ( err == simdjson::SUCCESS ) show.player_[i].focus_side_ = stmp[0];
-            err = p["fnum"].get_int64().get( itmp );
-            if ( err == simdjson::SUCCESS ) show.player_[i].focus_unum_ = itmp;
-
-            // count
-            err = p["kick"].get_int64().get( itmp );
-            if ( err == simdjson::SUCCESS ) show.player_[i].kick_count_ = itmp;
-            err = p["dash"].get_int64().get( itmp );
-            if ( err == simdjson::SUCCESS ) show.player_[i].dash_count_ = itmp;
-            err = p["turn"].get_int64().get( itmp );
-            if ( err == simdjson::SUCCESS ) show.player_[i].turn_count_ = itmp;
-            err = p["catch"].get_int64().get( itmp );
-            if ( err == simdjson::SUCCESS ) show.player_[i].catch_count_ = itmp;
-            err = p["move"].get_int64().get( itmp );
-            if ( err == simdjson::SUCCESS ) show.player_[i].move_count_ = itmp;
-            err = p["turn_neck"].get_int64().get( itmp );
-            if ( err == simdjson::SUCCESS ) show.player_[i].turn_neck_count_ = itmp;
-            err = p["change_view"].get_int64().get( itmp );
-            if ( err == simdjson::SUCCESS ) show.player_[i].change_view_count_ = itmp;
-            err = p["say"].get_int64().get( itmp );
-            if ( err == simdjson::SUCCESS ) show.player_[i].say_count_ = itmp;
-            err = p["tackle"].get_int64().get( itmp );
-            if ( err == simdjson::SUCCESS ) show.player_[i].tackle_count_ = itmp;
-            err = p["pointto"].get_int64().get( itmp );
-            if ( err == simdjson::SUCCESS ) show.player_[i].pointto_count_ = itmp;
-            err = p["attentionto"].get_int64().get( itmp );
-            if ( err == simdjson::SUCCESS ) show.player_[i].attentionto_count_ = itmp;
-            err = p["change_focus"].get_int64().get( itmp );
-            if ( err == simdjson::SUCCESS ) show.player_[i].change_focus_count_ = itmp;
+
+            if ( projection.hasField( Projection::PLAYER_POSITION ) )
+            {
+                show.player_[i].type_ = p["type"].get_int64();
+                show.player_[i].state_ = p["state"].get_int64();
+
+                // pos
+                show.player_[i].x_ = p["x"].get_double();
+                show.player_[i].y_ = p["y"].get_double();
+                show.player_[i].vx_ = p["vx"].get_double();
+                show.player_[i].vy_ = p["vy"].get_double();
+                show.player_[i].body_ = p["body"].get_double();
+                show.player_[i].neck_ = p["neck"].get_double();
+
+                // arm
+                err = p["px"].get_double().get( dtmp );
+                if ( err == simdjson::SUCCESS ) show.player_[i].point_x_ = dtmp;
+                err = p["py"].get_double().get( dtmp );
+                if ( err == simdjson::SUCCESS ) show.player_[i].point_y_ = dtmp;
+            }
+
+            if ( projection.hasField( Projection::PLAYER_VIEW ) )
+            {
+                // view mode
+                stmp = p["vq"].get_string();
+                show.player_[i].view_quality_ = ( stmp == "l" ? 'l' : 'h' );
+                show.player_[i].view_width_ = p["vw"].get_double();
+
+                // focus point
+                err = p["fdist"].get_double().get( dtmp );
+                if ( err == simdjson::SUCCESS ) show.player_[i].focus_dist_ = dtmp;
+                err = p["fdir"].get_double().get( dtmp );
+                if ( err == simdjson::SUCCESS ) show.player_[i].focus_dir_ = dtmp;
+            }
+
+            if ( projection.hasField( Projection::PLAYER_STAMINA ) )
+            {
+                // stamina
+                show.player_[i].stamina_ = p["stamina"].get_double();
+                show.player_[i].effort_ = p["effort"].get_double();
+                show.player_[i].recovery_ = p["recovery"].get_double();
+                show.player_[i].stamina_capacity_ = p["capacity"].get_double();
+            }
+
+            if ( projection.hasField( Projection::PLAYER_VIEW ) )
+            {
+                // focus
+                err = p["fside"].get_string().get( stmp );
+                if ( err == simdjson::SUCCESS ) show.player_[i].focus_side_ = stmp[0];
+                err = p["fnum"].get_int64().get( itmp );
+                if ( err == simdjson::SUCCESS ) show.player_[i].focus_unum_ = itmp;
+            }
+
+            if ( projection.hasField( Projection::PLAYER_COUNT ) )
+            {
+                // count
+                err = p["kick"].get_int64().get( itmp );
+                if ( err == simdjson::SUCCESS ) show.player_[i].kick_count_ = itmp;
+                err = p["dash"].get_int64().get( itmp );
+                if ( err == simdjson::SUCCESS ) show.player_[i].dash_count_ = itmp;
+                err = p["turn"].get_int64().get( itmp );
+                if ( err == simdjson::SUCCESS ) show.player_[i].turn_count_ = itmp;
+                err = p["catch"].get_int64().get( itmp );
+                if ( err == simdjson::SUCCESS ) show.player_[i].catch_count_ = itmp;
+                err = p["move"].get_int64().get( itmp );
+                if ( err == simdjson::SUCCESS ) show.player_[i].move_count_ = itmp;
+                err = p["turn_neck"].get_int64().get( itmp );
+                if ( err == simdjson::SUCCESS ) show.player_[i].turn_neck_count_ = itmp;
+                err = p["change_view"].get_int64().get( itmp );
+                if ( err == simdjson::SUCCESS ) show.player_[i].change_view_count_ = itmp;
+                err = p["say"].get_int64().get( itmp );
+                if ( err == simdjson::SUCCESS ) show.player_[i].say_count_ = itmp;
+                err = p["tackle"].get_int64().get( itmp );
+                if ( err == simdjson::SUCCESS ) show.player_[i].tackle_count_ = itmp;
+                err = p["pointto"].get_int64().get( itmp );
+                if ( err == simdjson::SUCCESS ) show.player_[i].pointto_count_ = itmp;
+                err = p["attentionto"].get_int64().get( itmp );
+                if ( err == simdjson::SUCCESS ) show.player_[i].attentionto_count_ = itmp;
+                err = p["change_focus"].get_int64().get( itmp );
+                if ( err == simdjson::SUCCESS ) show.player_[i].change_focus_count_ = itmp;
+            }
 
             ++i;
         }
@@ -531,7 +769,7 @@ ParserSimdJSON::Impl::parseShow( simdjson::ondemand::value & val,
         std::cerr << "(ParserSimdJSON::parseShow) player part " << i << ": " << e.what() << std::endl;
     }
 
-    return handler.handleShow( show );
+    return handler.dispatchShow( show );
 }
 
 /*-------------------------------------------------------------------*/
@@ -562,20 +800,9 @@ ParserSimdJSON::parse( std::istream & is,
 
     try
     {
-        simdjson::ondemand::parser parser;
-        simdjson::padded_string json( std::string( std::istreambuf_iterator< char >( is ), {} ) );
-        simdjson::ondemand::document rcg = parser.iterate( json );
-        simdjson::ondemand::array root_array = rcg.get_array();
-
-        for ( simdjson::ondemand::object data : root_array )
+        if ( ! M_impl->parseStream( is, handler ) )
         {
-            for ( simdjson::ondemand::field field : data )
-            {
-                if ( ! M_impl->parseData( field, handler ) )
-                {
-                    return false;
-                }
-            }
+            return false;
         }
     }
     catch ( std::exception & e )
@@ -584,6 +811,7 @@ ParserSimdJSON::parse( std::istream & is,
         return false;
     }
 
+    handler.flushShows();
     handler.handleEOF();
     return true;
 }
@@ -593,34 +821,14 @@ bool
 ParserSimdJSON::parse( const std::string & filepath,
                        Handler & handler ) const
 {
-    handler.handleLogVersion( REC_VERSION_JSON );
-
-    try
-    {
-        simdjson::ondemand::parser parser;
-        simdjson::padded_string json = simdjson::padded_string::load( filepath );
-        simdjson::ondemand::document rcg = parser.iterate( json );
-        simdjson::ondemand::array root_array = rcg.get_array();
-
-        for ( simdjson::ondemand::object data : root_array )
-        {
-            for ( simdjson::ondemand::field field : data )
-            {
-                if ( ! M_impl->parseData( field, handler ) )
-                {
-                    return false;
-                }
-            }
-        }
-    }
-    catch ( std::exception & e )
+    compressed_ifstream fin( filepath.c_str() );
+    if ( ! fin.is_open() )
     {
-        std::cerr << "(ParserSimdJSON::parse) ERROR\n\t" << e.what() << std::endl;
+        std::cerr << "(ParserSimdJSON::parse) ERROR: could not open " << filepath << std::endl;
         return false;
     }
 
-    handler.handleEOF();
-    return true;
+    return parse( fin, handler );
 }
 
 /*-------------------------------------------------------------------*/
@@ -628,19 +836,7 @@ bool
 ParserSimdJSON::parseData( const std::string & input,
                            Handler & handler ) const
 {
-    simdjson::ondemand::parser parser;
-    simdjson::padded_string json( input );
-    simdjson::ondemand::document data = parser.iterate( json );
-
-    for ( simdjson::ondemand::field field : data.get_object() )
-    {
-        if ( ! M_impl->parseData( field, handler ) )
-        {
-            return false;
-        }
-    }
-
-    return true;
+    return M_impl->parseRecord( input, handler );
 }
 
 
@@ -75,10 +75,21 @@ public:
       \param handler reference to the rcg data handler.
       \retval true, if successfuly parsed.
       \retval false, if incorrect format is detected.
+
+      The stream is read into a reused buffer and the records of the top level
+      array are parsed incrementally by iterate_many(). The memory usage does
+      not depend on the game length.
     */
     bool parse( std::istream & is,
                 Handler & handler ) const override;
 
+    /*!
+      \brief parse the rcg file in the same way as the stream version.
+      \param filepath path to the rcg file. a compressed file is also accepted.
+      \param handler reference to the rcg data handler.
+      \retval true, if successfuly parsed.
+      \retval false, if incorrect format is detected.
+    */
     bool parse( const std::string & filepath,
                 Handler & handler ) const override;
 
@@ -92,6 +103,8 @@ public:
 
       First, check the type of data mode.
       Second, call each data item parsing method.
+      The parser and the padded buffer are reused, so the instance must not be
+      shared by several threads.
     */
     bool parseData( const std::string & input,
                     Handler & handler ) const;
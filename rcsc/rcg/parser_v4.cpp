@@ -36,18 +36,362 @@
 #include "parser_v4.h"
 
 #include "handler.h"
+#include "event_buffer.h"
+#include "log_index.h"
 #include "types.h"
 
+#include <rcsc/gz/compressed_fstream.h>
+
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <memory>
+#include <charconv>
 #include <cstdlib>
 #include <cstring>
 #include <cmath>
 #include <climits>
 #include <cstdio>
+#include <algorithm>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace rcsc {
 namespace rcg {
 
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief load the whole uncompressed file as read-only memory
+  \param filepath file path to read
+  \param size pointer to the variable to store the file size
+  \return pointer to the data. NULL if failed.
+ */
+std::shared_ptr< const char >
+map_text_file( const std::string & filepath,
+               std::size_t * size )
+{
+#ifdef HAVE_SYS_MMAN_H
+    const int fd = ::open( filepath.c_str(), O_RDONLY );
+    if ( fd < 0 )
+    {
+        return std::shared_ptr< const char >();
+    }
+
+    struct stat st;
+    if ( ::fstat( fd, &st ) != 0
+         || st.st_size <= 0 )
+    {
+        ::close( fd );
+        return std::shared_ptr< const char >();
+    }
+
+    const std::size_t length = static_cast< std::size_t >( st.st_size );
+    void * addr = ::mmap( nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0 );
+    ::close( fd );
+
+    if ( addr == MAP_FAILED )
+    {
+        return std::shared_ptr< const char >();
+    }
+
+    ::madvise( addr, length, MADV_SEQUENTIAL );
+
+    *size = length;
+    return std::shared_ptr< const char >( static_cast< const char * >( addr ),
+                                          [length]( const char * p )
+                                            {
+                                                ::munmap( const_cast< char * >( p ), length );
+                                            } );
+#else
+    (void)filepath;
+    (void)size;
+    return std::shared_ptr< const char >();
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief whole text rcg data loaded from a file
+ */
+struct TextData {
+    std::shared_ptr< const char > mapped_; //!< memory-mapped file
+    std::string buffer_; //!< decompressed data
+    const char * data_ = nullptr; //!< pointer to the first byte
+    std::size_t size_ = 0; //!< data length
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief load the rcg file into memory.
+  An uncompressed file is memory-mapped. A compressed file is decompressed at once.
+  \param filepath path to the rcg file
+  \param text pointer to the result variable
+  \return true if loaded
+ */
+bool
+load_text_file( const std::string & filepath,
+                TextData * text )
+{
+    if ( detect_compression_format( filepath.c_str() ) == COMPRESSION_NONE )
+    {
+        text->mapped_ = map_text_file( filepath, &text->size_ );
+        if ( text->mapped_ )
+        {
+            text->data_ = text->mapped_.get();
+            return true;
+        }
+    }
+
+    compressed_ifstream fin( filepath.c_str() );
+    if ( ! fin.is_open() )
+    {
+        return false;
+    }
+
+    std::ostringstream ostr;
+    ostr << fin.rdbuf();
+    text->buffer_ = ostr.str();
+    text->data_ = text->buffer_.data();
+    text->size_ = text->buffer_.size();
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create the index file next to the log file if it does not exist or is stale.
+  \param filepath path to the rcg file
+  \param text loaded data
+ */
+void
+write_index_file( const std::string & filepath,
+                  const TextData & text )
+{
+    const std::string index_path = LogIndex::sidecar_path( filepath );
+
+    // the header line is enough to check the data size.
+    std::ifstream fin( index_path.c_str() );
+    std::string magic;
+    int format_version = 0, version = 0;
+    std::size_t data_size = 0;
+    if ( fin >> magic >> format_version >> version >> data_size
+         && data_size == text.size_ )
+    {
+        return;
+    }
+    fin.close();
+
+    LogIndex index;
+    if ( index.build( text.data_, text.size_ ) )
+    {
+        index.write( index_path );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+inline
+const char *
+skip_space( const char * buf,
+            const char * end )
+{
+    while ( buf < end
+            && ( *buf == ' ' || *buf == '\t' || *buf == '\r' ) )
+    {
+        ++buf;
+    }
+    return buf;
+}
+
+/*-------------------------------------------------------------------*/
+inline
+const char *
+skip_char( const char * buf,
+           const char * end,
+           const char c )
+{
+    while ( buf < end && *buf == c ) ++buf;
+    return buf;
+}
+
+/*-------------------------------------------------------------------*/
+inline
+const char *
+skip_until( const char * buf,
+            const char * end,
+            const char c )
+{
+    while ( buf < end && *buf != c ) ++buf;
+    return buf;
+}
+
+/*-------------------------------------------------------------------*/
+inline
+bool
+starts_with( const char * buf,
+             const char * end,
+             const char * prefix,
+             const std::size_t len )
+{
+    return static_cast< std::size_t >( end - buf ) >= len
+        && std::memcmp( buf, prefix, len ) == 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read an integer value after the white spaces like strtol().
+  \return true if a value is read. *buf is moved to the next character.
+ */
+inline
+bool
+read_long( const char ** buf,
+           const char * end,
+           long * value,
+           const int base = 10 )
+{
+    const char * first = skip_space( *buf, end );
+    if ( first < end && *first == '+' ) ++first;
+    if ( base == 16
+         && end - first >= 2
+         && first[0] == '0'
+         && ( first[1] == 'x' || first[1] == 'X' ) )
+    {
+        first += 2;
+    }
+
+    const std::from_chars_result r = std::from_chars( first, end, *value, base );
+    if ( r.ec != std::errc() )
+    {
+        return false;
+    }
+
+    *buf = r.ptr;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read a floating point value after the white spaces like strtof().
+  \return true if a value is read. *buf is moved to the next character.
+ */
+inline
+bool
+read_float( const char ** buf,
+            const char * end,
+            float * value )
+{
+    const char * first = skip_space( *buf, end );
+    if ( first < end && *first == '+' ) ++first;
+
+    const std::from_chars_result r = std::from_chars( first, end, *value );
+    if ( r.ec != std::errc() )
+    {
+        return false;
+    }
+
+    *buf = r.ptr;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read a token separated by the white spaces like scanf("%s").
+ */
+inline
+std::string_view
+read_token( const char ** buf,
+            const char * end )
+{
+    const char * first = skip_space( *buf, end );
+    const char * last = first;
+    while ( last < end
+            && *last != ' ' && *last != '\t' && *last != '\r' )
+    {
+        ++last;
+    }
+
+    *buf = last;
+    return std::string_view( first, last - first );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read a counter value. a broken value is regarded as 0 like strtol().
+ */
+inline
+UInt16
+read_count( const char ** buf,
+            const char * end )
+{
+    long value = 0;
+    read_long( buf, end, &value );
+    return static_cast< UInt16 >( value );
+}
+
+//! approximate data size of one parallel parsing unit
+constexpr std::size_t CHUNK_SIZE = 1024 * 1024;
+
+/*!
+  \brief a range of complete lines parsed by one job
+ */
+struct Chunk {
+    const char * begin_; //!< first byte of the first line
+    const char * end_; //!< one past the last new line character
+    int n_line_; //!< the line number just before this chunk
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief split the data at the show lines around every CHUNK_SIZE bytes.
+  \param begin first byte of the data
+  \param end end of the data
+  \param n_line the line number just before the data
+  \return chunk list in the data order
+ */
+std::vector< Chunk >
+split_chunks( const char * begin,
+              const char * end,
+              int n_line )
+{
+    // every text record is one self-contained line, so no state has to be
+    // carried across the chunks. starting each chunk at a show line keeps a
+    // cycle and its following messages together.
+    const std::string_view boundary( "\n(show " );
+
+    std::vector< Chunk > chunks;
+    const char * chunk_begin = begin;
+    while ( chunk_begin < end )
+    {
+        const char * chunk_end = end;
+        if ( static_cast< std::size_t >( end - chunk_begin ) > CHUNK_SIZE )
+        {
+            const std::string_view rest( chunk_begin + CHUNK_SIZE, end - chunk_begin - CHUNK_SIZE );
+            const std::size_t pos = rest.find( boundary );
+            if ( pos != std::string_view::npos )
+            {
+                chunk_end = rest.data() + pos + 1;
+            }
+        }
+
+        chunks.push_back( Chunk{ chunk_begin, chunk_end, n_line } );
+        n_line += static_cast< int >( std::count( chunk_begin, chunk_end, '\n' ) );
+        chunk_begin = chunk_end;
+    }
+
+    return chunks;
+}
+
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -95,7 +439,7 @@ ParserV4::parse( std::istream & is,
     while ( std::getline( is, line ) )
     {
         ++n_line;
-        if ( ! parseLine( n_line, line, handler ) )
+        if ( ! parseLine( n_line, std::string_view( line ), handler ) )
         {
             return false;
         }
@@ -103,12 +447,384 @@ ParserV4::parse( std::istream & is,
 
     if ( is.eof() )
     {
+        handler.flushShows();
         return handler.handleEOF();
     }
 
     return false;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParserV4::parse( const std::string & filepath,
+                 Handler & handler ) const
+{
+    TextData text;
+    if ( ! load_text_file( filepath, &text ) )
+    {
+        return false;
+    }
+
+    if ( useIndexFile() )
+    {
+        write_index_file( filepath, text );
+    }
+
+    return parse( text.data_, text.size_, handler );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParserV4::parse( const char * data,
+                 const std::size_t size,
+                 Handler & handler ) const
+{
+    const char * const body = parseHeader( data, size, handler );
+    if ( ! body )
+    {
+        return false;
+    }
+
+    if ( ! parseBody( body, data + size, 1, handler ) )
+    {
+        return false;
+    }
+
+    handler.flushShows();
+    return handler.handleEOF();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParserV4::seek( const std::string & filepath,
+                const GameTime & start,
+                Handler & handler,
+                LogIndex * index ) const
+{
+    TextData text;
+    if ( ! load_text_file( filepath, &text ) )
+    {
+        return false;
+    }
+
+    LogIndex local_index;
+    if ( ! index )
+    {
+        index = &local_index;
+    }
+
+    if ( index->empty()
+         || index->dataSize() != text.size_ )
+    {
+        if ( ! useIndexFile()
+             || ! index->read( LogIndex::sidecar_path( filepath ) )
+             || index->dataSize() != text.size_ )
+        {
+            if ( ! index->build( text.data_, text.size_ ) )
+            {
+                return false;
+            }
+
+            if ( useIndexFile() )
+            {
+                index->write( LogIndex::sidecar_path( filepath ) );
+            }
+        }
+    }
+
+    return seek( text.data_, text.size_, start, *index, handler );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParserV4::seek( const char * data,
+                const std::size_t size,
+                const GameTime & start,
+                const LogIndex & index,
+                Handler & handler ) const
+{
+    if ( index.dataSize() != size )
+    {
+        std::cerr << "(ParserV4::seek) the index does not match the data." << std::endl;
+        return false;
+    }
+
+    const char * const end = data + size;
+    if ( ! parseHeader( data, size, handler ) )
+    {
+        return false;
+    }
+
+    const LogIndex::Record * start_show = index.findShow( start );
+    const std::size_t start_offset = ( start_show ? start_show->offset_ : size );
+
+    // restore the state just before the start show.
+    const LogIndex::Record * last_playmode = index.findLastEvent( LogIndex::PLAYMODE, start_offset );
+    const LogIndex::Record * last_team = index.findLastEvent( LogIndex::TEAM, start_offset );
+    for ( const LogIndex::Record & rec : index.events() )
+    {
+        if ( rec.offset_ >= start_offset ) break;
+        if ( ( rec.type_ == LogIndex::PLAYMODE && &rec != last_playmode )
+             || ( rec.type_ == LogIndex::TEAM && &rec != last_team ) )
+        {
+            continue;
+        }
+
+        const char * line_begin = data + rec.offset_;
+        const char * line_end = static_cast< const char * >( std::memchr( line_begin, '\n', end - line_begin ) );
+        if ( ! line_end ) line_end = end;
+
+        if ( ! parseLine( rec.line_, std::string_view( line_begin, line_end - line_begin ), handler ) )
+        {
+            return false;
+        }
+    }
+
+    if ( start_show
+         && ! parseBody( data + start_offset, end, start_show->line_ - 1, handler ) )
+    {
+        return false;
+    }
+
+    handler.flushShows();
+    return handler.handleEOF();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const char *
+ParserV4::parseHeader( const char * data,
+                       const std::size_t size,
+                       Handler & handler ) const
+{
+    const char * const end = data + size;
+    const char * line_end = static_cast< const char * >( std::memchr( data, '\n', size ) );
+    if ( ! line_end ) line_end = end;
+
+    // header line
+    const std::string_view header( data, line_end - data );
+    int version = 0;
+    if ( header.length() < 4
+         || header.compare( 0, 3, "ULG" ) != 0
+         || std::from_chars( header.data() + 3, header.data() + header.size(), version ).ec != std::errc() )
+    {
+        std::cerr << "Unknown header line: [" << header << "]" << std::endl;
+        return nullptr;
+    }
+
+    if ( version != REC_VERSION_4
+         && version != REC_VERSION_5
+         && version != REC_VERSION_6 )
+    {
+        std::cerr << "Unsupported rcg version: [" << header << "]" << std::endl;
+        return nullptr;
+    }
+
+    if ( ! handler.handleLogVersion( version ) )
+    {
+        std::cerr << "Unsupported game log version: [" << header << "]" << std::endl;
+        return nullptr;
+    }
+
+    return std::min( line_end + 1, end );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParserV4::parseBody( const char * begin,
+                     const char * end,
+                     const int n_line,
+                     Handler & handler ) const
+{
+    if ( jobs() > 1
+         && static_cast< std::size_t >( end - begin ) > CHUNK_SIZE )
+    {
+        return parseChunks( begin, end, n_line, handler );
+    }
+
+    return parseLines( begin, end, n_line, handler );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParserV4::parseLines( const char * begin,
+                      const char * end,
+                      int n_line,
+                      Handler & handler ) const
+{
+    const char * line_begin = begin;
+    while ( line_begin < end )
+    {
+        const char * line_end = static_cast< const char * >( std::memchr( line_begin, '\n', end - line_begin ) );
+        if ( ! line_end ) line_end = end;
+
+        ++n_line;
+        if ( ! parseLine( n_line, std::string_view( line_begin, line_end - line_begin ), handler ) )
+        {
+            return false;
+        }
+
+        line_begin = line_end + 1;
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParserV4::parseChunks( const char * begin,
+                       const char * end,
+                       const int n_line,
+                       Handler & handler ) const
+{
+    const std::vector< Chunk > chunks = split_chunks( begin, end, n_line );
+    const std::size_t n_threads = std::min( chunks.size(), static_cast< std::size_t >( jobs() ) );
+    if ( n_threads <= 1 )
+    {
+        return parseLines( begin, end, n_line, handler );
+    }
+
+    // the playmode condition of the projection depends on the preceding chunks.
+    const bool ordered = ( ! handler.acceptsUnorderedCallbacks()
+                           || handler.projection().filtersPlayMode() );
+    // the workers cannot know the playmode at the chunk beginning,
+    // so the playmode condition is applied in the replay.
+    Projection chunk_projection = handler.projection();
+    chunk_projection.clearPlayModes();
+    // the number of parsed chunks waiting for the delivery is bounded to limit the memory usage.
+    const std::size_t window = n_threads * 2;
+
+    std::vector< std::unique_ptr< EventBuffer > > buffers( chunks.size() );
+    std::vector< char > done( chunks.size(), 0 );
+    std::vector< char > success( chunks.size(), 0 );
+    std::size_t next = 0;
+    std::size_t delivered = 0;
+    bool aborted = false;
+
+    std::mutex mtx;
+    std::condition_variable parsed_cond;
+    std::condition_variable delivered_cond;
+
+    const auto worker = [&]()
+        {
+            while ( true )
+            {
+                std::size_t i = 0;
+                {
+                    std::unique_lock< std::mutex > lock( mtx );
+                    delivered_cond.wait( lock, [&]() { return aborted
+                                                           || next >= chunks.size()
+                                                           || next < delivered + window; } );
+                    if ( aborted
+                         || next >= chunks.size() )
+                    {
+                        break;
+                    }
+                    i = next++;
+                }
+
+                std::unique_ptr< EventBuffer > buffer( new EventBuffer( chunk_projection ) );
+                const bool result = parseLines( chunks[i].begin_, chunks[i].end_, chunks[i].n_line_, *buffer );
+                {
+                    std::lock_guard< std::mutex > lock( mtx );
+                    buffers[i] = std::move( buffer );
+                    success[i] = result;
+                    done[i] = 1;
+                }
+                parsed_cond.notify_one();
+            }
+        };
+
+    std::vector< std::thread > threads;
+    threads.reserve( n_threads );
+    for ( std::size_t t = 0; t < n_threads; ++t )
+    {
+        threads.emplace_back( worker );
+    }
+
+    // the callbacks are called only in this thread.
+    bool result = true;
+    std::size_t ordered_index = 0;
+    while ( result
+            && delivered < chunks.size() )
+    {
+        std::unique_ptr< EventBuffer > buffer;
+        bool chunk_result = false;
+        {
+            std::unique_lock< std::mutex > lock( mtx );
+            std::size_t i = ordered_index;
+            parsed_cond.wait( lock, [&]()
+                {
+                    if ( ordered )
+                    {
+                        return done[i] != 0;
+                    }
+
+                    for ( i = 0; i < chunks.size(); ++i )
+                    {
+                        if ( done[i] == 1 ) return true;
+                    }
+                    return false;
+                } );
+            done[i] = 2;
+            buffer = std::move( buffers[i] );
+            chunk_result = success[i];
+        }
+
+        // as the serial parser, the results of the data callbacks are ignored.
+        buffer->replay( handler );
+        buffer.reset();
+        ++ordered_index;
+
+        {
+            std::lock_guard< std::mutex > lock( mtx );
+            ++delivered;
+            if ( ! chunk_result )
+            {
+                aborted = true;
+                result = false;
+            }
+        }
+        delivered_cond.notify_all();
+    }
+
+    {
+        std::lock_guard< std::mutex > lock( mtx );
+        aborted = true;
+    }
+    delivered_cond.notify_all();
+
+    for ( std::thread & t : threads )
+    {
+        t.join();
+    }
+
+    return result;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -118,42 +834,70 @@ ParserV4::parseLine( const int n_line,
                      const std::string & line,
                      Handler & handler ) const
 {
-    char name[32];
+    return parseLine( n_line, std::string_view( line ), handler );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParserV4::parseLine( const int n_line,
+                     const std::string_view line,
+                     Handler & handler ) const
+{
+    const char * buf = line.data();
+    const char * const end = buf + line.size();
+
+    buf = skip_space( buf, end );
+    if ( buf == end || *buf != '(' )
+    {
+        std::cerr << n_line << ": Illegal line: [" << line << ']'
+                  << std::endl;;
+        return false;
+    }
+    ++buf;
 
-    if ( std::sscanf( line.c_str(), " ( %s ", name ) != 1 )
+    const std::string_view name = read_token( &buf, end );
+    if ( name.empty() )
     {
         std::cerr << n_line << ": Illegal line: [" << line << ']'
                   << std::endl;;
         return false;
     }
 
-    if ( ! std::strcmp( name, "show" ) )
+    if ( name == "show" )
     {
         parseShow( n_line, line, handler );
+        return true;
     }
-    else if ( ! std::strcmp( name, "playmode" ) )
+
+    // the queued shows are delivered before any other record.
+    handler.flushShows();
+
+    if ( name == "playmode" )
     {
-        parsePlayMode( n_line, line, handler );
+        parsePlayMode( n_line, std::string( line ), handler );
     }
-    else if ( ! std::strcmp( name, "team" ) )
+    else if ( name == "team" )
     {
-        parseTeam( n_line, line, handler );
+        parseTeam( n_line, std::string( line ), handler );
     }
-    else if ( ! std::strcmp( name, "msg" ) )
+    else if ( name == "msg" )
     {
         parseMsg( n_line, line, handler );
     }
-    else if ( ! std::strcmp( name, "player_type" ) )
+    else if ( name == "player_type" )
     {
-        parsePlayerType( n_line, line, handler );
+        parsePlayerType( n_line, std::string( line ), handler );
     }
-    else if ( ! std::strcmp( name, "player_param" ) )
+    else if ( name == "player_param" )
     {
-        parsePlayerParam( n_line, line, handler );
+        parsePlayerParam( n_line, std::string( line ), handler );
     }
-    else if ( ! std::strcmp( name, "server_param" ) )
+    else if ( name == "server_param" )
     {
-        parseServerParam( n_line, line, handler );
+        parseServerParam( n_line, std::string( line ), handler );
     }
     else
     {
@@ -173,448 +917,335 @@ bool
 ParserV4::parseShow( const int n_line,
                      const std::string & line,
                      Handler & handler ) const
+{
+    return parseShow( n_line, std::string_view( line ), handler );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParserV4::parseShow( const int n_line,
+                     const std::string_view line,
+                     Handler & handler ) const
 {
     /*
       (show <Time> <Ball> <Players>)
     */
 
-    const char * buf = line.c_str();
+    const char * buf = line.data();
+    const char * const end = buf + line.size();
 
-    if ( 0 )
+    //
+    // time
+    //
+    buf = skip_space( buf, end );
+    while ( buf < end && *buf != ' ' ) ++buf;
+    long time = 0;
+    if ( ! read_long( &buf, end, &time ) )
     {
-        int n_read = 0;
+        std::cerr << n_line << ": error: "
+                  << " Illegal show info time. "
+                  << " \"" << line << "\""
+                  << std::endl;
+        return false;
+    }
 
-        // time
-        int time = 0;
+    buf = skip_space( buf, end );
 
-        if ( std::sscanf( buf, " ( show %d %n ",
-                          &time, &n_read ) != 1 )
+    //
+    // playmode
+    //
+    if ( starts_with( buf, end, "(pm", 3 ) )
+    {
+        const char * p = buf + 3;
+        long pm = 0;
+        if ( read_long( &p, end, &pm ) )
         {
-            std::cerr << n_line << ": error: "
-                      << "Illegal time info \"" << line << "\"" << std::endl;
-            return false;
+            p = skip_space( p, end );
+            p = skip_char( p, end, ')' );
+            buf = skip_space( p, end );
+            handler.dispatchPlayMode( time, static_cast< PlayMode >( pm ) );
         }
-        buf += n_read;
+    }
 
-        //
-        // playmode
-        //
-        if ( *(buf + 1) == 'p' )
+    //
+    // team
+    //
+    if ( starts_with( buf, end, "(tm", 3 ) )
+    {
+        // (tm <name_l> <name_r> <score_l> <score_r> [<pen_score_l> <pen_miss_l> <pen_score_r> <pen_miss_r>])
+        const char * p = buf + 3;
+        const std::string_view name_l = read_token( &p, end );
+        const std::string_view name_r = read_token( &p, end );
+
+        long score[6] = { 0, 0, 0, 0, 0, 0 };
+        int n = 0;
+        while ( n < 6 && read_long( &p, end, &score[n] ) ) ++n;
+
+        if ( name_l.empty()
+             || name_r.empty()
+             || ( n != 2 && n != 6 ) )
         {
-            int pm = 0;
-            if ( std::sscanf( buf,
-                              " ( pm %d ) %n ",
-                              &pm, &n_read ) == 1 )
-            {
-                buf += n_read;
-                handler.handlePlayMode( time, static_cast< PlayMode >( pm ) );
-            }
+            std::cerr << n_line << ": error: n=" << n << ' '
+                      << "Illegal team info. \"" << line << "\"" << std::endl;;
+            return false;
         }
+        buf = skip_until( buf, end, ')' );
+        buf = skip_char( buf, end, ')' );
 
-        //
-        // team
-        //
-        if ( *(buf + 1) == 't' )
-        {
-            char name_l[32], name_r[32];
-            int score_l = 0, score_r = 0;
-            int pen_score_l = 0, pen_miss_l = 0, pen_score_r = 0, pen_miss_r = 0;
-
-            int n = std::sscanf( buf,
-                                 " ( tm %31s %31s %d %d %d %d %d %d ",
-                                 name_l, name_r,
-                                 &score_l, &score_r,
-                                 &pen_score_l, &pen_miss_l,
-                                 &pen_score_r, &pen_miss_r );
-
-            if ( n != 4 && n != 8 )
-            {
-                std::cerr << n_line << ": error: n=" << n << ' '
-                          << "Illegal team info. \"" << line << "\"" << std::endl;;
-                return false;
-            }
-            while ( *buf != ')' && *buf != '\0' ) ++buf;
-            while ( *buf == ')' && *buf != '\0' ) ++buf;
-
-            if ( ! std::strcmp( name_l, "null" ) ) std::memset( name_l, 0, 4 );
-            if ( ! std::strcmp( name_r, "null" ) ) std::memset( name_r, 0, 4 );
+        const std::string l = ( name_l == "null" ? std::string() : std::string( name_l.substr( 0, 31 ) ) );
+        const std::string r = ( name_r == "null" ? std::string() : std::string( name_r.substr( 0, 31 ) ) );
 
-            TeamT team_l( name_l, score_l, pen_score_l, pen_miss_l );
-            TeamT team_r( name_r, score_r, pen_score_r, pen_miss_r );
+        TeamT team_l( l.c_str(), score[0], score[2], score[3] );
+        TeamT team_r( r.c_str(), score[1], score[4], score[5] );
 
-            handler.handleTeam( time, team_l, team_r );
-        }
-
-        //
-        // show main
-        //
+        handler.handleTeam( time, team_l, team_r );
+    }
 
-        ShowInfoT show;
+    if ( ! handler.wantsShow( static_cast< int >( time ) ) )
+    {
+        handler.flushShows();
+        return handler.handleSkippedShow( static_cast< int >( time ) );
+    }
 
-        show.time_ = time;
+    ShowInfoT show;
+    show.time_ = static_cast< UInt32 >( time );
 
-        //
-        // ball
-        //
+    const Projection & projection = handler.projection();
 
-        if ( std::sscanf( buf, " ((b) %f %f %f %f) %n",
-                          &show.ball_.x_, &show.ball_.y_,
-                          &show.ball_.vx_, &show.ball_.vy_,
-                          &n_read ) != 4 )
+    // ball
+    if ( ! projection.hasField( Projection::BALL ) )
+    {
+        buf = skip_space( buf, end );
+        buf = skip_until( buf, end, ')' );
+        buf = skip_char( buf, end, ')' );
+        buf = skip_until( buf, end, ')' );
+        buf = skip_char( buf, end, ')' );
+        buf = skip_space( buf, end );
+    }
+    else
+    {
+        // ((b) x y vx vy)
+        buf = skip_space( buf, end );
+        buf = skip_until( buf, end, ')' );
+        buf = skip_char( buf, end, ')' );
+        BallT & ball = show.ball_;
+        if ( ! read_float( &buf, end, &ball.x_ )
+             || ! read_float( &buf, end, &ball.y_ )
+             || ! read_float( &buf, end, &ball.vx_ )
+             || ! read_float( &buf, end, &ball.vy_ ) )
         {
             std::cerr << n_line << ": error: "
-                      << "Illegal ball info \"" << line << "\"" << std::endl;
+                      << " Illegal ball info. "
+                      << " \"" << line << "\""
+                      << std::endl;;
             return false;
         }
-        buf += n_read;
-
-        //
-        // players
-        //
-
-        char side;
-        short unum;
-        short type;
-        int state;
-        float x, y, vx, vy, body, neck;
-        for ( int i = 0; i < MAX_PLAYER * 2; ++i )
-        {
-            if ( *buf == ')' ) break;
-
-            if ( std::sscanf( buf,
-                              " ((%c %hd) %hd %x %f %f %f %f %f %f %n",
-                              &side, &unum,
-                              &type, &state,
-                              &x, &y, &vx, &vy, &body, &neck,
-                              &n_read ) != 10 )
-            {
-                std::cerr << n_line << ": error: "
-                          << " Illegal player id or pos " << i << " \"" << line << "\""
-                          << std::endl;;
-                return false;
-            }
-            buf += n_read;
-
-            int idx = unum - 1;
-            if ( side == 'r' ) idx += MAX_PLAYER;
-            if ( idx < 0 || MAX_PLAYER*2 <= idx )
-            {
-                std::cerr << n_line << ": error: "
-                          << " Illegal player id " << i << " \"" << line << "\""
-                          << std::endl;;
-                return false;
-            }
-
-            PlayerT & p = show.player_[idx];
-
-            p.side_ = side;
-            p.unum_ = unum;
-            p.type_ = type;
-            p.state_ = state;
-            p.x_ = x;
-            p.y_ = y;
-            p.vx_ = vx;
-            p.vy_ = vy;
-            p.body_ = body;
-            p.neck_ = neck;
-
-            if ( *buf != '('
-                 && std::sscanf( buf,
-                                 " %f %f %n",
-                                 &p.point_x_, &p.point_y_,
-                                 &n_read ) == 2 )
-            {
-                buf += n_read;
-            }
-
-            if ( std::sscanf( buf,
-                              " (v %c %f) (s %f %f %f) %n",
-                              &p.view_quality_, &p.view_width_,
-                              &p.stamina_, &p.effort_, &p.recovery_,
-                              &n_read ) != 5 )
-            {
-                std::cerr << n_line << ": error: "
-                          << "Illegal player view or stamina (" << side << ' ' << unum
-                          << ") [" << line << "]" << std::endl;;
-                return false;
-            }
-            buf += n_read;
-
-            if ( *(buf + 1) == 'f'
-                 && std::sscanf( buf,
-                                 " ( f %c %hd ) %n",
-                                 &p.focus_side_, &p.focus_unum_,
-                                 &n_read ) == 2 )
-            {
-                buf += n_read;
-            }
-
-            if ( std::sscanf( buf,
-                              " (c %hd %hd %hd %hd %hd %hd %hd %hd %hd %hd %hd)) %n",
-                              &p.kick_count_,
-                              &p.dash_count_,
-                              &p.turn_count_,
-                              &p.catch_count_,
-                              &p.move_count_,
-                              &p.turn_neck_count_,
-                              &p.change_view_count_,
-                              &p.say_count_,
-                              &p.tackle_count_,
-                              &p.pointto_count_,
-                              &p.attentionto_count_,
-                              &n_read ) != 11 )
-            {
-                std::cerr << n_line << ": error: "
-                          << "Illegal player count (" << side << ' ' << unum
-                          << ") [" << line << "]" << std::endl;;
-                return false;
-            }
-            buf += n_read;
-        }
-
-        handler.handleShow( show );
+        buf = skip_char( buf, end, ')' );
+        buf = skip_space( buf, end );
     }
-    else
-    {
-        ShowInfoT show;
-
-        char * next;
 
-        //
-        // time
-        //
-        while ( *buf == ' ' ) ++buf;
-        while ( *buf != '\0' && *buf != ' ' ) ++buf;
-        long time = std::strtol( buf, &next, 10 ); buf = next;
+    // players
+    // ((side unum) type state x y vx vy body neck [pointx pointy] (v h 90) [(fp dist dir)] (s 4000 1 1[ capacity])[(f side unum)])
+    //              (c 1 1 1 1 1 1 1 1 1 1 1[ 1]))
+    const int n_players = ( projection.hasField( Projection::PLAYERS ) ? MAX_PLAYER*2 : 0 );
+    for ( int i = 0; i < n_players; ++i )
+    {
+        if ( buf == end || *buf == ')' ) break;
 
-        if ( time == LONG_MIN || time == LONG_MAX )
+        // ((side unum)
+        buf = skip_space( buf, end );
+        buf = skip_char( buf, end, '(' );
+        const char side = ( buf < end ? *buf : '\0' );
+        if ( side != 'l' && side != 'r' )
         {
             std::cerr << n_line << ": error: "
-                      << " Illegal show info time. "
+                      << " Illegal player side. " << side << ' ' << i
                       << " \"" << line << "\""
-                      << std::endl;
+                      << std::endl;;
             return false;
         }
 
-        show.time_ = static_cast< UInt32 >( time );
-
-        while ( *buf == ' ' ) ++buf;
-
-        //
-        // playmode
-        //
-        if ( ! std::strncmp( buf, "(pm", 3 ) )
+        ++buf;
+        long unum = 0;
+        if ( ! read_long( &buf, end, &unum )
+             || unum < 1 || MAX_PLAYER < unum )
         {
-            int n_read = 0;
-            int pm = 0;
-            if ( std::sscanf( buf,
-                              " ( pm %d ) %n ",
-                              &pm, &n_read ) == 1 )
-            {
-                buf += n_read;
-                handler.handlePlayMode( time, static_cast< PlayMode >( pm ) );
-            }
+            std::cerr << n_line << ": error: "
+                      << " Illegal player unum. " << side << ' ' << i
+                      << " \"" << line << "\""
+                      << std::endl;;
+            return false;
         }
 
-        //
-        // team
-        //
-        if ( ! std::strncmp( buf, "(tm", 3 ) )
-        {
-            char name_l[32], name_r[32];
-            int score_l = 0, score_r = 0;
-            int pen_score_l = 0, pen_miss_l = 0, pen_score_r = 0, pen_miss_r = 0;
-
-            int n = std::sscanf( buf,
-                                 " ( tm %31s %31s %d %d %d %d %d %d ",
-                                 name_l, name_r,
-                                 &score_l, &score_r,
-                                 &pen_score_l, &pen_miss_l,
-                                 &pen_score_r, &pen_miss_r );
-
-            if ( n != 4 && n != 8 )
-            {
-                std::cerr << n_line << ": error: n=" << n << ' '
-                          << "Illegal team info. \"" << line << "\"" << std::endl;;
-                return false;
-            }
-            while ( *buf != ')' && *buf != '\0' ) ++buf;
-            while ( *buf == ')' && *buf != '\0' ) ++buf;
+        buf = skip_char( buf, end, ')' );
 
-            if ( ! std::strcmp( name_l, "null" ) ) std::memset( name_l, 0, 4 );
-            if ( ! std::strcmp( name_r, "null" ) ) std::memset( name_r, 0, 4 );
+        const int idx = ( side == 'l' ? unum - 1 : unum - 1 + MAX_PLAYER );
 
-            TeamT team_l( name_l, score_l, pen_score_l, pen_miss_l );
-            TeamT team_r( name_r, score_r, pen_score_r, pen_miss_r );
+        PlayerT & p = show.player_[idx];
+        p.side_ = side;
+        p.unum_ = static_cast< Int16 >( unum );
 
-            handler.handleTeam( time, team_l, team_r );
+        // type state x y vx vy body neck
+        if ( ! projection.hasField( Projection::PLAYER_POSITION ) )
+        {
+            buf = skip_until( buf, end, '(' );
         }
-
-        // ball
+        else
         {
-            // ((b) x y vx vy)
-            while ( *buf == ' ' ) ++buf;
-            while ( *buf != '\0' && *buf != ')' ) ++buf;
-            while ( *buf == ')' ) ++buf;
-            BallT & ball = show.ball_;
-            ball.x_ = strtof( buf, &next ); buf = next;
-            ball.y_ = strtof( buf, &next ); buf = next;
-            ball.vx_ = strtof( buf, &next ); buf = next;
-            ball.vy_ = strtof( buf, &next ); buf = next;
-            while ( *buf == ')' ) ++buf;
-            while ( *buf == ' ' ) ++buf;
-
-            if ( ball.vy_ == HUGE_VALF )
+            long type = 0, state = 0;
+            if ( ! read_long( &buf, end, &type )
+                 || ! read_long( &buf, end, &state, 16 )
+                 || ! read_float( &buf, end, &p.x_ )
+                 || ! read_float( &buf, end, &p.y_ )
+                 || ! read_float( &buf, end, &p.vx_ )
+                 || ! read_float( &buf, end, &p.vy_ )
+                 || ! read_float( &buf, end, &p.body_ )
+                 || ! read_float( &buf, end, &p.neck_ ) )
             {
                 std::cerr << n_line << ": error: "
-                          << " Illegal ball info. "
+                          << " Illegal player state. " << side << ' ' << unum
                           << " \"" << line << "\""
                           << std::endl;;
                 return false;
             }
-        }
+            p.type_ = static_cast< Int16 >( type );
+            p.state_ = static_cast< Int32 >( state );
+            buf = skip_space( buf, end );
 
-        // players
-        // ((side unum) type state x y vx vy body neck [pointx pointy] (v h 90) (s 4000 1 1)[(f side unum)])
-        //              (c 1 1 1 1 1 1 1 1 1 1 1))
-        for ( int i = 0; i < MAX_PLAYER*2; ++i )
-        {
-            if ( *buf == '\0' || *buf == ')' ) break;
-
-            // ((side unum)
-            while ( *buf == ' ' ) ++buf;
-            while ( *buf == '(' ) ++buf;
-            char side = *buf;
-            if ( side != 'l' && side != 'r' )
+            // arm
+            if ( buf < end && *buf != '(' )
             {
-                std::cerr << n_line << ": error: "
-                          << " Illegal player side. " << side << ' ' << i
-                          << " \"" << buf << "\""
-                          << std::endl;;
-                return false;
+                read_float( &buf, end, &p.point_x_ );
+                read_float( &buf, end, &p.point_y_ );
             }
+        }
+
+        const bool view = projection.hasField( Projection::PLAYER_VIEW );
 
-            ++buf;
-            long unum = std::strtol( buf, &next, 10 ); buf = next;
-            if ( unum < 0 || MAX_PLAYER < unum )
+        // (v quality width)
+        if ( ! view )
+        {
+            buf = skip_until( buf, end, ')' );
+            while ( buf < end && ( *buf == ' ' || *buf == ')' ) ) ++buf;
+            if ( starts_with( buf, end, "(fp ", 4 ) )
             {
-                std::cerr << n_line << ": error: "
-                          << " Illegal player unum. " << side << ' ' << i
-                          << " \"" << buf << "\""
-                          << std::endl;;
-                return false;
+                buf = skip_until( buf, end, ')' );
+                while ( buf < end && ( *buf == ' ' || *buf == ')' ) ) ++buf;
             }
-
-            while ( *buf == ')' ) ++buf;
-
-            const int idx = ( side == 'l' ? unum - 1 : unum - 1 + MAX_PLAYER );
-
-            PlayerT & p = show.player_[idx];
-            p.side_ = side;
-            p.unum_ = static_cast< Int16 >( unum );
-
-            // x y vx vy body neck
-            p.type_ = static_cast< Int16 >( std::strtol( buf, &next, 10 ) ); buf = next;
-            p.state_ = static_cast< Int32 >( std::strtol( buf, &next, 16 ) ); buf = next;
-            p.x_ = strtof( buf, &next ); buf = next;
-            p.y_ = strtof( buf, &next ); buf = next;
-            p.vx_ = strtof( buf, &next ); buf = next;
-            p.vy_ = strtof( buf, &next ); buf = next;
-            p.body_ = strtof( buf, &next ); buf = next;
-            p.neck_ = strtof( buf, &next ); buf = next;
-            while ( *buf == ' ' ) ++buf;
-
-            // arm
-            if ( *buf != '\0' && *buf != '(' )
+        }
+        else
+        {
+            buf = skip_until( buf, end, 'v' );
+            if ( buf < end ) ++buf; // skip 'v'
+            buf = skip_space( buf, end );
+            if ( buf < end )
             {
-                p.point_x_ = strtof( buf, &next ); buf = next;
-                p.point_y_ = strtof( buf, &next ); buf = next;
+                p.view_quality_ = *buf; ++buf;
             }
-
-            // (v quality width)
-            while ( *buf != '\0' && *buf != 'v' ) ++buf;
-            ++buf; // skip 'v'
-            while ( *buf == ' ' ) ++buf;
-            p.view_quality_ = *buf; ++buf;
-            p.view_width_ = strtof( buf, &next ); buf = next;
-            while ( *buf == ' ' || *buf == ')' ) ++buf;
+            read_float( &buf, end, &p.view_width_ );
+            while ( buf < end && ( *buf == ' ' || *buf == ')' ) ) ++buf;
 
             // (fp dist dir)
             // focus point is introduced in the monitor protocol v6
-            if ( ! std::strncmp( buf, "(fp ", 4 ) )
+            if ( starts_with( buf, end, "(fp ", 4 ) )
             {
                 buf += 4;
-                p.focus_dist_ = strtof( buf, &next ); buf = next;
-                p.focus_dir_ = strtof( buf, &next ); buf = next;
-                while ( *buf == ' ' || *buf == ')' ) ++buf;
+                read_float( &buf, end, &p.focus_dist_ );
+                read_float( &buf, end, &p.focus_dir_ );
+                while ( buf < end && ( *buf == ' ' || *buf == ')' ) ) ++buf;
             }
+        }
 
-            // (s stamina effort recovery[ capacity])
-            // capacity is introduced in the monitor protocol v5
-            while ( *buf != '\0' && *buf != 's' ) ++buf;
-            ++buf; // skip 's' //while ( *buf != '\0' && *buf != ' ' ) ++buf;
-            p.stamina_ = strtof( buf, &next ); buf = next;
-            p.effort_ = strtof( buf, &next ); buf = next;
-            p.recovery_ = strtof( buf, &next ); buf = next;
-            while ( *buf == ' ' ) ++buf;
-            if ( *buf != ')' )
+        // (s stamina effort recovery[ capacity])
+        // capacity is introduced in the monitor protocol v5
+        if ( projection.hasField( Projection::PLAYER_STAMINA ) )
+        {
+            buf = skip_until( buf, end, 's' );
+            if ( buf < end ) ++buf; // skip 's'
+            read_float( &buf, end, &p.stamina_ );
+            read_float( &buf, end, &p.effort_ );
+            read_float( &buf, end, &p.recovery_ );
+            buf = skip_space( buf, end );
+            if ( buf < end && *buf != ')' )
             {
-                p.stamina_capacity_ = strtof( buf, &next ); buf = next;
+                read_float( &buf, end, &p.stamina_capacity_ );
             }
-            while ( *buf != '\0' && *buf != ')' ) ++buf;
-            while ( *buf == ')' ) ++buf;
+        }
+        buf = skip_until( buf, end, ')' );
+        buf = skip_char( buf, end, ')' );
 
-            while ( *buf != '\0' && *buf != '(' ) ++buf;
+        buf = skip_until( buf, end, '(' );
 
-            // (f side unum)
-            if ( *(buf + 1) == 'f' )
+        // (f side unum)
+        if ( end - buf > 1 && *(buf + 1) == 'f' )
+        {
+            if ( ! view )
             {
-                while ( *buf != '\0' && *buf != ' ' ) ++buf;
-                while ( *buf == ' ' ) ++buf;
-                p.focus_side_ = *buf; ++buf;
-                p.focus_unum_ = static_cast< Int16 >( std::strtol( buf, &next, 10 ) ); buf = next;
-                while ( *buf == ' ' ) ++buf;
-                while ( *buf == ')' ) ++buf;
-                while ( *buf == ' ' ) ++buf;
+                buf = skip_until( buf, end, ')' );
             }
-
-            // (c kick dash turn catch move tneck cview say tackle pointto atttention)
-            while ( *buf == '(' ) ++buf;
-            ++buf; // skip 'c' //while ( *buf != '\0' && *buf != ' ' ) ++buf;
-            p.kick_count_ = static_cast< UInt16 >( std::strtol( buf, &next, 10 ) ); buf = next;
-            p.dash_count_ = static_cast< UInt16 >( std::strtol( buf, &next, 10 ) ); buf = next;
-            p.turn_count_ = static_cast< UInt16 >( std::strtol( buf, &next, 10 ) ); buf = next;
-            p.catch_count_ = static_cast< UInt16 >( std::strtol( buf, &next, 10 ) ); buf = next;
-            p.move_count_ = static_cast< UInt16 >( std::strtol( buf, &next, 10 ) ); buf = next;
-            p.turn_neck_count_ = static_cast< UInt16 >( std::strtol( buf, &next, 10 ) ); buf = next;
-            p.change_view_count_ = static_cast< UInt16 >( std::strtol( buf, &next, 10 ) ); buf = next;
-            p.say_count_ = static_cast< UInt16 >( std::strtol( buf, &next, 10 ) ); buf = next;
-            p.tackle_count_ = static_cast< UInt16 >( std::strtol( buf, &next, 10 ) ); buf = next;
-            p.pointto_count_ = static_cast< UInt16 >( std::strtol( buf, &next, 10 ) ); buf = next;
-            p.attentionto_count_ = static_cast< UInt16 >( std::strtol( buf, &next, 10 ) ); buf = next;
-            while ( *buf == ' ' ) ++buf;
-            if ( *buf != ')' )
+            else
             {
-                p.change_focus_count_ = static_cast< UInt16 >( std::strtol( buf, &next, 10 ) ); buf = next;
+                buf = skip_until( buf, end, ' ' );
+                buf = skip_space( buf, end );
+                if ( buf < end )
+                {
+                    p.focus_side_ = *buf; ++buf;
+                }
+                long focus_unum = 0;
+                read_long( &buf, end, &focus_unum );
+                p.focus_unum_ = static_cast< Int16 >( focus_unum );
+                buf = skip_space( buf, end );
             }
+            buf = skip_char( buf, end, ')' );
+            buf = skip_space( buf, end );
+        }
 
-            while ( *buf == ')' ) ++buf;
-            while ( *buf == ' ' ) ++buf;
-
-            if ( *buf == '\0'
-                 && i != MAX_PLAYER*2 - 1 )
+        // (c kick dash turn catch move tneck cview say tackle pointto atttention[ cfocus])
+        if ( ! projection.hasField( Projection::PLAYER_COUNT ) )
+        {
+            buf = skip_until( buf, end, ')' );
+        }
+        else
+        {
+            buf = skip_char( buf, end, '(' );
+            if ( buf < end ) ++buf; // skip 'c'
+            p.kick_count_ = read_count( &buf, end );
+            p.dash_count_ = read_count( &buf, end );
+            p.turn_count_ = read_count( &buf, end );
+            p.catch_count_ = read_count( &buf, end );
+            p.move_count_ = read_count( &buf, end );
+            p.turn_neck_count_ = read_count( &buf, end );
+            p.change_view_count_ = read_count( &buf, end );
+            p.say_count_ = read_count( &buf, end );
+            p.tackle_count_ = read_count( &buf, end );
+            p.pointto_count_ = read_count( &buf, end );
+            p.attentionto_count_ = read_count( &buf, end );
+            buf = skip_space( buf, end );
+            if ( buf < end && *buf != ')' )
             {
-                std::cerr << n_line << ": error: "
-                          << " Illegal player info. " << side << ' ' << unum
-                          << " \"" << line << "\""
-                          << std::endl;;
-                return false;
+                p.change_focus_count_ = read_count( &buf, end );
             }
         }
 
-        handler.handleShow( show );
+        buf = skip_char( buf, end, ')' );
+        buf = skip_space( buf, end );
+
+        if ( buf == end
+             && i != MAX_PLAYER*2 - 1 )
+        {
+            std::cerr << n_line << ": error: "
+                      << " Illegal player info. " << side << ' ' << unum
+                      << " \"" << line << "\""
+                      << std::endl;;
+            return false;
+        }
     }
 
+    handler.dispatchShow( show );
+
     return true;
 }
 
@@ -624,63 +1255,87 @@ ParserV4::parseShow( const int n_line,
  */
 bool
 ParserV4::parseMsg( const int n_line,
-                    const std::string & line,
+                    const std::string_view line,
                     Handler & handler ) const
 {
     /*
       (msg <Time> <Board> "<Message>")
     */
-    int n_read = 0;
-    int time = 0;
-    int board = 0;
-
-    if ( std::sscanf( line.c_str(),
-                      " ( msg %d %d \"%n",
-                      &time, &board, &n_read ) != 2 )
+    const char * buf = line.data();
+    const char * const end = buf + line.size();
+
+    buf = skip_space( buf, end );
+    buf = skip_char( buf, end, '(' );
+    buf = skip_space( buf, end );
+    if ( starts_with( buf, end, "msg", 3 ) ) buf += 3;
+
+    long time = 0;
+    long board = 0;
+    const bool header = ( read_long( &buf, end, &time )
+                          && read_long( &buf, end, &board ) );
+    buf = skip_space( buf, end );
+    if ( ! header
+         || buf == end
+         || *buf != '"' )
     {
         std::cerr << n_line << ": error: "
                   << "Illegal msg line. \"" << line << "\"" << std::endl;;
         return false;
     }
+    ++buf;
 
-    std::string msg( line, n_read, std::string::npos );
+    std::string_view msg( buf, end - buf );
     if ( msg.length() <= 2 ) // at least, [")] + 1 char
     {
         return false;
     }
 
     // find the last [")]
-    std::string::size_type pos = msg.rfind( "\")" );
-    if ( pos == std::string::npos )
+    const std::string_view::size_type pos = msg.rfind( "\")" );
+    if ( pos == std::string_view::npos )
     {
         std::cerr << n_line << ": ERROR Illegal msg [" << line << "]" << std::endl;;
         return false;
     }
 
-    msg.erase( pos ); // remove the last 2 characters
+    msg = msg.substr( 0, pos ); // remove the last 2 characters
 
     // team graphic
-    if ( ! msg.compare( 0, std::strlen( "(team_graphic_" ), "(team_graphic_" ) )
+    if ( msg.compare( 0, std::strlen( "(team_graphic_" ), "(team_graphic_" ) == 0 )
     {
+        if ( ! handler.projection().teamGraphic() )
+        {
+            return true;
+        }
+
         return parseTeamGraphic( n_line, msg, handler );
     }
 
     // other message
-    return handler.handleMsg( time, board, msg );
+    return handler.handleMsg( static_cast< int >( time ), static_cast< int >( board ), msg );
 }
 
 /*-------------------------------------------------------------------*/
 bool
 ParserV4::parseTeamGraphic( const int n_line,
-                            const std::string & msg,
+                            const std::string_view msg,
                             Handler & handler ) const
 {
-    char side = 'n';
-    int x, y;
-    int n_read = 0;
-    if ( std::sscanf( msg.c_str(), "(team_graphic_%c ( %d %d %n",
-                      &side, &x, &y, &n_read ) != 3
-         || ( side != 'l' && side != 'r' )
+    /*
+      (team_graphic_<Side> (<X> <Y> "<xpm line>" ...))
+    */
+    const char * buf = msg.data() + std::strlen( "(team_graphic_" );
+    const char * const end = msg.data() + msg.size();
+
+    const char side = ( buf < end ? *buf++ : 'n' );
+    buf = skip_space( buf, end );
+    buf = ( buf < end && *buf == '(' ? buf + 1 : end );
+
+    long x = -1;
+    long y = -1;
+    if ( ( side != 'l' && side != 'r' )
+         || ! read_long( &buf, end, &x )
+         || ! read_long( &buf, end, &y )
          || x < 0
          || y < 0 )
     {
@@ -688,24 +1343,30 @@ ParserV4::parseTeamGraphic( const int n_line,
         return false;
     }
 
-    std::vector< std::string > xpm_data;
+    // team_graphic records are rare, so the container is not reused.
+    std::vector< std::string_view > xpm_data;
 
-    const char * ptr = msg.c_str() + n_read;
-    while ( *ptr != '\0' )
+    buf = skip_space( buf, end );
+    while ( buf < end )
     {
-        char buf[16];
-        if ( std::sscanf( ptr, " \"%15[^\"]\" %n ", buf, &n_read ) != 1 )
+        // "<xpm line>". only the first 15 characters are used.
+        buf = skip_space( buf, end );
+        const char * first = ( buf < end && *buf == '"' ? buf + 1 : end );
+        const char * last = first;
+        while ( last < end && *last != '"' ) ++last;
+        if ( last == first )
         {
-            std::cerr << n_line << ": ERROR Illegal team_graphic [" << ptr << "]" << std::endl;;
+            std::cerr << n_line << ": ERROR Illegal team_graphic ["
+                      << std::string_view( buf, end - buf ) << "]" << std::endl;;
             return false;
         }
-        ptr += n_read;
 
-        xpm_data.push_back( buf );
-        while ( *ptr != '\0' && *ptr != '"' ) ++ptr;
+        xpm_data.emplace_back( first, std::min< std::ptrdiff_t >( last - first, 15 ) );
+        buf = ( last < end ? last + 1 : end );
+        while ( buf < end && *buf != '"' ) ++buf;
     }
 
-    return handler.handleTeamGraphic( side, x, y, xpm_data );
+    return handler.handleTeamGraphic( side, static_cast< int >( x ), static_cast< int >( y ), xpm_data );
 }
 
 /*-------------------------------------------------------------------*/
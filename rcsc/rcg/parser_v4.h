@@ -36,6 +36,7 @@
 #include <rcsc/rcg/types.h>
 
 #include <string>
+#include <string_view>
 
 namespace rcsc {
 namespace rcg {
@@ -69,6 +70,69 @@ public:
     bool parse( std::istream & is,
                 Handler & handler ) const override;
 
+    /*!
+      \brief parse the rcg file.
+      \param filepath path to the rcg file.
+      \param handler reference to the rcg data handler.
+      \retval true, if successfuly parsed.
+      \retval false, if incorrect format is detected.
+
+      An uncompressed file is memory-mapped and parsed without copying.
+      A compressed file is decompressed into memory at once.
+    */
+    virtual
+    bool parse( const std::string & filepath,
+                Handler & handler ) const override;
+
+    /*!
+      \brief parse the whole rcg data held in memory.
+      \param data pointer to the first byte of the data (the header line).
+      \param size data length. the data need not be null-terminated.
+      \param handler reference to the rcg data handler.
+      \retval true, if successfuly parsed.
+      \retval false, if incorrect format is detected.
+
+      If jobs() is greater than 1, large data is split at the show lines and the
+      chunks are parsed concurrently. See parseChunks().
+    */
+    bool parse( const char * data,
+                const std::size_t size,
+                Handler & handler ) const;
+
+    /*!
+      \brief parse the rcg file from the given game time.
+      \param filepath path to the rcg file.
+      \param start the first show time delivered to the handler
+      \param handler reference to the rcg data handler.
+      \param index pointer to the index of the file. may be NULL.
+      \retval true, if successfuly parsed.
+      \retval false, if incorrect format is detected.
+
+      The file is loaded as parse() does, and the lines before the start show
+      are never scanned if a valid index is available.
+    */
+    virtual
+    bool seek( const std::string & filepath,
+               const GameTime & start,
+               Handler & handler,
+               LogIndex * index = nullptr ) const override;
+
+    /*!
+      \brief parse the rcg data held in memory from the given game time.
+      \param data pointer to the first byte of the data (the header line).
+      \param size data length.
+      \param start the first show time delivered to the handler
+      \param index the index of the data
+      \param handler reference to the rcg data handler.
+      \retval true, if successfuly parsed.
+      \retval false, if incorrect format is detected or the index does not match the data.
+    */
+    bool seek( const char * data,
+               const std::size_t size,
+               const GameTime & start,
+               const LogIndex & index,
+               Handler & handler ) const;
+
     /*!
       \brief parse data line.
       \param n_line the number of total read line
@@ -84,8 +148,82 @@ public:
                     const std::string & line,
                     Handler & handler ) const;
 
+    /*!
+      \brief parse data line given as a slice of the input buffer.
+      \param n_line the number of total read line
+      \param line the data string without the new line character
+      \param handler reference to the rcg data handler.
+      \retval true, if successfuly parsed.
+      \retval false, if incorrect format is detected.
+
+      show lines are scanned in place. other lines are copied and passed to
+      each data item parsing method.
+    */
+    bool parseLine( const int n_line,
+                    const std::string_view line,
+                    Handler & handler ) const;
+
 protected:
 
+    /*!
+      \brief check the header line and pass the version to the handler.
+      \param data pointer to the first byte of the data
+      \param size data length
+      \param handler reference to the rcg data handler.
+      \return pointer to the first byte of the body. NULL if the header is illegal.
+     */
+    const char * parseHeader( const char * data,
+                              const std::size_t size,
+                              Handler & handler ) const;
+
+    /*!
+      \brief parse all lines in the body by one or more threads depending on jobs().
+      \param begin first byte of the first line
+      \param end end of the range
+      \param n_line the line number just before the range
+      \param handler reference to the rcg data handler.
+      \retval true, if successfuly parsed.
+      \retval false, if an illegal line is found.
+     */
+    bool parseBody( const char * begin,
+                    const char * end,
+                    const int n_line,
+                    Handler & handler ) const;
+
+    /*!
+      \brief parse all lines in the range.
+      \param begin first byte of the first line
+      \param end end of the range
+      \param n_line the line number just before the range
+      \param handler reference to the rcg data handler.
+      \retval true, if successfuly parsed.
+      \retval false, if an illegal line is found.
+     */
+    bool parseLines( const char * begin,
+                     const char * end,
+                     int n_line,
+                     Handler & handler ) const;
+
+    /*!
+      \brief parse the range by jobs() threads.
+      \param begin first byte of the first line
+      \param end end of the range
+      \param n_line the line number just before the range
+      \param handler reference to the rcg data handler.
+      \retval true, if successfuly parsed.
+      \retval false, if an illegal line is found.
+
+      Each chunk is recorded into an EventBuffer by a worker thread, and the
+      buffers are replayed in this thread. The file order is kept by a reorder
+      buffer unless the handler accepts unordered callbacks. In the ordered mode,
+      no callback after an illegal line is delivered as in the serial parser.
+      Error messages of the workers are printed in no particular order.
+     */
+    bool parseChunks( const char * begin,
+                      const char * end,
+                      const int n_line,
+                      Handler & handler ) const;
+
     /*!
       \brief parse SHOW_MODE inof, actually short_showinfo_t2
       \param n_line the number of total read line
@@ -99,6 +237,20 @@ protected:
                     const std::string & line,
                     Handler & handler ) const;
 
+    /*!
+      \brief parse SHOW_MODE info given as a slice of the input buffer.
+      \param n_line the number of total read line
+      \param line the data string
+      \param handler reference to the data handler object
+      \retval true if successfully parsed.
+      \retval false if failed to parse.
+
+      Numbers are scanned by std::from_chars without any temporary string.
+    */
+    bool parseShow( const int n_line,
+                    const std::string_view line,
+                    Handler & handler ) const;
+
     /*!
       \brief parse MSG_MODE info(msg_info_t)
       \param n_line the number of total read line
@@ -106,9 +258,11 @@ protected:
       \param handler reference to the data handler object
       \retval true if successfully parsed.
       \retval false if failed to parse.
+
+      The message body is passed to the handler as a slice of the line.
     */
     bool parseMsg( const int n_line,
-                   const std::string & line,
+                   const std::string_view line,
                    Handler & handler ) const;
 
     /*!
@@ -116,9 +270,11 @@ protected:
       \param msg message body in msg information
       \param handler handler object
       \return result status
+
+      The xpm lines are passed to the handler as slices of the message.
      */
     bool parseTeamGraphic( const int n_line,
-                           const std::string & msg,
+                           const std::string_view msg,
                            Handler & handler ) const;
 
     /*!
@@ -0,0 +1,466 @@
+// -*-c++-*-
+
+/*!
+  \file parser_v7.cpp
+  \brief rcg v7 columnar format parser Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "parser_v7.h"
+
+#include "parser_v4.h"
+#include "handler.h"
+
+#include <rcsc/gz/compressed_fstream.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <cstring>
+
+namespace rcsc {
+namespace rcg {
+
+namespace {
+
+//! the size of the trailer (u64 footer offset, "ULGI")
+constexpr std::size_t TRAILER_SIZE = 12;
+
+//! upper bound of the header strings
+constexpr std::uint32_t MAX_STRING_SIZE = 1024 * 1024;
+
+/*-------------------------------------------------------------------*/
+inline
+std::uint64_t
+get_le( const char * data,
+        const int n )
+{
+    std::uint64_t value = 0;
+    for ( int i = n - 1; i >= 0; --i )
+    {
+        value = ( value << 8 ) | static_cast< unsigned char >( data[i] );
+    }
+    return value;
+}
+
+/*-------------------------------------------------------------------*/
+bool
+read_bytes( std::istream & is,
+            const std::size_t size,
+            std::string * buf )
+{
+    buf->resize( size );
+    is.read( &(*buf)[0], size );
+    return static_cast< std::size_t >( is.gcount() ) == size;
+}
+
+/*-------------------------------------------------------------------*/
+bool
+read_u32( std::istream & is,
+          std::uint32_t * value )
+{
+    char buf[4];
+    is.read( buf, 4 );
+    if ( is.gcount() != 4 )
+    {
+        return false;
+    }
+    *value = static_cast< std::uint32_t >( get_le( buf, 4 ) );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+bool
+read_string( std::istream & is,
+             std::string * str )
+{
+    std::uint32_t size = 0;
+    return read_u32( is, &size )
+        && size <= MAX_STRING_SIZE
+        && read_bytes( is, size, str );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the fields to be decoded from the block
+  \param data encoded block
+  \param projection declaration of the handler
+  \return bit set of Projection::Field. 0 if no show in the block is needed.
+ */
+unsigned int
+block_fields( const std::string & data,
+              const Projection & projection )
+{
+    if ( projection.metadataOnly() )
+    {
+        return 0;
+    }
+
+    if ( ! projection.filtersTime() )
+    {
+        return projection.fields();
+    }
+
+    std::vector< double > times;
+    if ( ! ColumnBlock::decodeColumn( data.data(), data.size(), ColumnBlock::TIME, &times ) )
+    {
+        // a broken block is reported by ColumnBlock::decode().
+        return projection.fields();
+    }
+
+    for ( const double t : times )
+    {
+        if ( projection.acceptsTime( static_cast< int >( t ) ) )
+        {
+            return projection.fields();
+        }
+    }
+
+    return 0;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParserV7::parse( std::istream & is,
+                 Handler & handler ) const
+{
+    // streampos must be the first point!!!
+    is.seekg( 0 );
+
+    if ( ! is.good() )
+    {
+        return false;
+    }
+
+    char header[5];
+    is.read( header, 5 );
+    if ( is.gcount() != 5
+         || std::strncmp( header, "ULG7", 4 ) != 0 )
+    {
+        std::cerr << "(ParserV7) Unknown header." << std::endl;
+        return false;
+    }
+
+    if ( static_cast< int >( header[4] ) != ColumnBlock::REVISION )
+    {
+        std::cerr << "(ParserV7) Unsupported revision " << static_cast< int >( header[4] ) << std::endl;
+        return false;
+    }
+
+    std::string server_version;
+    std::string timestamp;
+    if ( ! read_string( is, &server_version )
+         || ! read_string( is, &timestamp ) )
+    {
+        std::cerr << "(ParserV7) Broken header." << std::endl;
+        return false;
+    }
+
+    if ( ! handler.handleLogVersion( REC_VERSION_7 ) )
+    {
+        std::cerr << "Unsupported game log version: 7" << std::endl;
+        return false;
+    }
+
+    if ( ! server_version.empty() ) handler.handleServerVersion( server_version );
+    if ( ! timestamp.empty() ) handler.handleTimestamp( timestamp );
+
+    // the non-positional records are the v4 text lines.
+    const ParserV4 text_parser;
+
+    ColumnBlock block;
+    std::string data;
+    int n_record = 0;
+    int n_block = 0;
+
+    while ( true )
+    {
+        const int tag = is.get();
+        if ( tag == std::char_traits< char >::eof()
+             || tag == ColumnBlock::FOOTER_TAG )
+        {
+            // a file without the footer is also accepted.
+            break;
+        }
+
+        ++n_block;
+        std::uint32_t size = 0;
+        if ( tag != ColumnBlock::BLOCK_TAG
+             || ! read_u32( is, &size )
+             || ! read_bytes( is, size, &data )
+             || ! block.decode( data.data(), data.size(), block_fields( data, handler.projection() ) ) )
+        {
+            std::cerr << "(ParserV7) Broken block " << n_block << std::endl;
+            return false;
+        }
+
+        const std::vector< ShowInfoT > & shows = block.shows();
+        const std::vector< ColumnBlock::Event > & events = block.events();
+
+        std::size_t e = 0;
+        std::size_t i = 0;
+        while ( true )
+        {
+            while ( e < events.size()
+                    && events[e].position_ <= i )
+            {
+                if ( ! text_parser.parseLine( ++n_record, std::string_view( events[e].line_ ), handler ) )
+                {
+                    return false;
+                }
+                ++e;
+            }
+
+            if ( i >= shows.size() )
+            {
+                break;
+            }
+
+            // the shows until the next event are delivered at once.
+            const std::size_t last = ( e < events.size()
+                                       ? std::min< std::size_t >( events[e].position_, shows.size() )
+                                       : shows.size() );
+            n_record += static_cast< int >( last - i );
+            handler.dispatchShows( shows.data() + i, last - i );
+            i = last;
+        }
+    }
+
+    handler.flushShows();
+    return handler.handleEOF();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParserV7::readIndex( std::istream & is,
+                     std::vector< ColumnBlock::IndexEntry > * index )
+{
+    is.clear();
+    is.seekg( 0, std::ios_base::end );
+    const std::streamoff file_size = is.tellg();
+    if ( file_size < static_cast< std::streamoff >( TRAILER_SIZE ) )
+    {
+        return false;
+    }
+
+    char trailer[TRAILER_SIZE];
+    is.seekg( file_size - static_cast< std::streamoff >( TRAILER_SIZE ) );
+    is.read( trailer, TRAILER_SIZE );
+    if ( is.gcount() != static_cast< std::streamsize >( TRAILER_SIZE )
+         || std::strncmp( trailer + 8, "ULGI", 4 ) != 0 )
+    {
+        return false;
+    }
+
+    const std::uint64_t footer_offset = get_le( trailer, 8 );
+    if ( footer_offset >= static_cast< std::uint64_t >( file_size ) )
+    {
+        return false;
+    }
+
+    is.seekg( static_cast< std::streamoff >( footer_offset ) );
+
+    std::uint32_t size = 0;
+    std::string data;
+    return is.get() == ColumnBlock::FOOTER_TAG
+        && read_u32( is, &size )
+        && read_bytes( is, size, &data )
+        && ColumnBlock::decodeIndex( data.data(), data.size(), index );
+}
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+template < typename T >
+bool
+read_column( std::istream & is,
+             const int column,
+             std::vector< T > * values )
+{
+    if ( column < 0 || ColumnBlock::COLUMN_SIZE <= column )
+    {
+        return false;
+    }
+
+    std::vector< ColumnBlock::IndexEntry > index;
+    if ( ! ParserV7::readIndex( is, &index ) )
+    {
+        std::cerr << "(ParserV7::readColumn) No footer index." << std::endl;
+        return false;
+    }
+
+    const std::size_t n_columns = ColumnBlock::COLUMN_SIZE;
+    std::string buf;
+
+    for ( const ColumnBlock::IndexEntry & entry : index )
+    {
+        // only the block header, the column offsets and the target column are read.
+        is.seekg( static_cast< std::streamoff >( entry.offset_ ) );
+        if ( is.get() != ColumnBlock::BLOCK_TAG
+             || ! read_bytes( is, 4 + ColumnBlock::HEADER_SIZE, &buf ) )
+        {
+            return false;
+        }
+
+        const std::uint64_t shows = get_le( buf.data() + 4, 4 );
+        const std::uint64_t event_size = get_le( buf.data() + 12, 4 );
+
+        is.seekg( static_cast< std::streamoff >( event_size ), std::ios_base::cur );
+        if ( ! read_bytes( is, 2 + 4 * ( n_columns + 1 ), &buf )
+             || get_le( buf.data(), 2 ) != n_columns )
+        {
+            return false;
+        }
+
+        const std::streamoff column_base = is.tellg();
+        const std::uint64_t begin = get_le( buf.data() + 2 + 4 * column, 4 );
+        const std::uint64_t end = get_le( buf.data() + 2 + 4 * ( column + 1 ), 4 );
+        if ( end < begin )
+        {
+            return false;
+        }
+
+        is.seekg( column_base + static_cast< std::streamoff >( begin ) );
+        if ( ! read_bytes( is, end - begin, &buf )
+             || ! ColumnBlock::decodeColumnData( buf.data(), buf.size(), column, shows, values ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+template < typename T >
+bool
+read_column( const std::string & filepath,
+             const int column,
+             std::vector< T > * values )
+{
+    if ( detect_compression_format( filepath.c_str() ) == COMPRESSION_NONE )
+    {
+        std::ifstream fin( filepath.c_str(), std::ios_base::in | std::ios_base::binary );
+        return fin.is_open()
+            && read_column( fin, column, values );
+    }
+
+    compressed_ifstream fin( filepath.c_str() );
+    if ( ! fin.is_open() )
+    {
+        return false;
+    }
+
+    // the compressed stream is not seekable.
+    std::stringstream buf;
+    buf << fin.rdbuf();
+    return read_column( buf, column, values );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParserV7::readColumn( std::istream & is,
+                      const int column,
+                      std::vector< double > * values )
+{
+    return read_column( is, column, values );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParserV7::readColumn( std::istream & is,
+                      const int column,
+                      std::vector< float > * values )
+{
+    return read_column( is, column, values );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParserV7::readColumn( const std::string & filepath,
+                      const int column,
+                      std::vector< double > * values )
+{
+    return read_column( filepath, column, values );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParserV7::readColumn( const std::string & filepath,
+                      const int column,
+                      std::vector< float > * values )
+{
+    return read_column( filepath, column, values );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+namespace {
+
+Parser::Ptr
+create_v7()
+{
+    Parser::Ptr ptr( new ParserV7() );
+    return ptr;
+}
+
+const int version7 = static_cast< int >( '0' ) + REC_VERSION_7;
+rcss::RegHolder v7 = Parser::creators().autoReg( &create_v7, version7 );
+
+}
+
+} // end of namespace
+} // end of namespace
@@ -0,0 +1,137 @@
+// -*-c++-*-
+
+/*!
+  \file parser_v7.h
+  \brief rcg v7 columnar format parser Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_RCG_PARSER_V7_H
+#define RCSC_RCG_PARSER_V7_H
+
+#include <rcsc/rcg/parser.h>
+#include <rcsc/rcg/column_block.h>
+#include <rcsc/rcg/types.h>
+
+#include <string>
+#include <vector>
+
+namespace rcsc {
+namespace rcg {
+
+/*!
+  \class ParserV7
+  \brief rcg v7 parser class. see SerializerV7 for the file layout.
+ */
+class ParserV7
+    : public Parser {
+public:
+
+    /*!
+      \brief get supported rcg version
+      \return version number
+     */
+    virtual
+    int version() const override
+      {
+          return REC_VERSION_7;
+      }
+
+    /*!
+      \brief parse input stream
+      \param is reference to the imput stream (usually ifstream/gzifstream).
+      \param handler reference to the rcg data handler.
+      \retval true, if successfuly parsed.
+      \retval false, if incorrect format is detected.
+    */
+    virtual
+    bool parse( std::istream & is,
+                Handler & handler ) const override;
+
+    /*!
+      \brief read the footer index
+      \param is reference to the seekable input stream
+      \param index pointer to the result container
+      \return true if the index is found.
+    */
+    static
+    bool readIndex( std::istream & is,
+                    std::vector< ColumnBlock::IndexEntry > * index );
+
+    /*!
+      \brief read one column of all cycles without parsing the other columns.
+      \param is reference to the seekable input stream
+      \param column column id. see ColumnBlock::Column and ColumnBlock::playerColumn().
+      \param values pointer to the result container. the values of all shows are stored in the file order.
+      \return true if successfully read
+    */
+    static
+    bool readColumn( std::istream & is,
+                     const int column,
+                     std::vector< double > * values );
+
+    /*!
+      \brief read one column of all cycles into the single precision container.
+      \param is reference to the seekable input stream
+      \param column column id. see ColumnBlock::Column and ColumnBlock::playerColumn().
+      \param values pointer to the result container. the values of all shows are stored in the file order.
+      \return true if successfully read
+    */
+    static
+    bool readColumn( std::istream & is,
+                     const int column,
+                     std::vector< float > * values );
+
+    /*!
+      \brief read one column of all cycles without parsing the other columns.
+      \param filepath path to the rcg file. a compressed file is decompressed into memory.
+      \param column column id. see ColumnBlock::Column and ColumnBlock::playerColumn().
+      \param values pointer to the result container. the values of all shows are stored in the file order.
+      \return true if successfully read
+    */
+    static
+    bool readColumn( const std::string & filepath,
+                     const int column,
+                     std::vector< double > * values );
+
+    /*!
+      \brief read one column of all cycles into the single precision container.
+      \param filepath path to the rcg file. a compressed file is decompressed into memory.
+      \param column column id. see ColumnBlock::Column and ColumnBlock::playerColumn().
+      \param values pointer to the result container. the values of all shows are stored in the file order.
+      \return true if successfully read
+    */
+    static
+    bool readColumn( const std::string & filepath,
+                     const int column,
+                     std::vector< float > * values );
+};
+
+} // end of namespace
+} // end of namespace
+
+#endif
@@ -0,0 +1,631 @@
+// -*-c++-*-
+
+/*!
+  \file record_patcher.cpp
+  \brief byte level rcg record patcher Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "record_patcher.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <cstring>
+
+namespace rcsc {
+namespace rcg {
+
+namespace {
+
+/*!
+  \struct Record
+  \brief location of one record in the buffer
+*/
+struct Record {
+    std::size_t begin_; //!< the first byte of the record
+    std::size_t end_; //!< the next of the last byte of the record
+    std::size_t next_; //!< the beginning of the next search
+    std::string_view type_; //!< record type name
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief find the next line.
+  \param data buffer
+  \param size the number of bytes in the buffer
+  \param pos search start position. this is always the beginning of a line.
+  \param eof true if no more data follows the buffer
+  \param rec result variable
+  \return false if no complete line remains in the buffer.
+*/
+bool
+next_text_record( const char * data,
+                  const std::size_t size,
+                  std::size_t * pos,
+                  const bool eof,
+                  Record * rec )
+{
+    if ( *pos >= size )
+    {
+        return false;
+    }
+
+    const char * const begin = data + *pos;
+    const char * const end = data + size;
+    const char * line_end = static_cast< const char * >( std::memchr( begin, '\n', end - begin ) );
+    if ( ! line_end )
+    {
+        if ( ! eof )
+        {
+            return false;
+        }
+        line_end = end;
+    }
+
+    rec->begin_ = *pos;
+    rec->end_ = line_end - data;
+    rec->next_ = std::min( rec->end_ + 1, size );
+    rec->type_ = std::string_view();
+
+    // (<type> ...
+    if ( begin < line_end
+         && *begin == '(' )
+    {
+        const char * p = begin + 1;
+        while ( p < line_end
+                && *p != ' '
+                && *p != ')' )
+        {
+            ++p;
+        }
+        rec->type_ = std::string_view( begin + 1, p - begin - 1 );
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief skip the JSON string literal.
+  \param p pointer to the opening double quotation
+  \param end end of the buffer
+  \return pointer to the next of the closing double quotation, or nullptr if not closed.
+*/
+const char *
+skip_json_string( const char * p,
+                  const char * end )
+{
+    ++p;
+    while ( p < end )
+    {
+        if ( *p == '\\' )
+        {
+            p += 2;
+            continue;
+        }
+
+        if ( *p == '"' )
+        {
+            return p + 1;
+        }
+        ++p;
+    }
+    return nullptr;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief find the next top level object.
+  \param data buffer
+  \param size the number of bytes in the buffer
+  \param pos search start position. this is never inside of an object.
+  The separators before the object are skipped.
+  \param rec result variable
+  \return false if no complete object remains in the buffer.
+*/
+bool
+next_json_record( const char * data,
+                  const std::size_t size,
+                  std::size_t * pos,
+                  Record * rec )
+{
+    const char * const end = data + size;
+    const char * p = data + *pos;
+
+    // the top level brackets, commas and white spaces are copied as they are.
+    while ( p < end
+            && *p != '{' )
+    {
+        ++p;
+    }
+    *pos = p - data;
+
+    if ( p == end )
+    {
+        return false;
+    }
+
+    const char * const begin = p;
+    int depth = 0;
+    while ( p < end )
+    {
+        if ( *p == '"' )
+        {
+            p = skip_json_string( p, end );
+            if ( ! p )
+            {
+                return false;
+            }
+            continue;
+        }
+
+        if ( *p == '{' || *p == '[' )
+        {
+            ++depth;
+        }
+        else if ( *p == '}' || *p == ']' )
+        {
+            --depth;
+            if ( depth == 0 )
+            {
+                break;
+            }
+        }
+        ++p;
+    }
+
+    if ( p == end )
+    {
+        return false;
+    }
+
+    rec->begin_ = begin - data;
+    rec->end_ = p + 1 - data;
+    rec->next_ = rec->end_;
+    rec->type_ = std::string_view();
+
+    // {"<type>": ...
+    const char * k = begin + 1;
+    while ( k < p
+            && ( *k == ' ' || *k == '\t' || *k == '\r' || *k == '\n' ) )
+    {
+        ++k;
+    }
+    if ( k < p
+         && *k == '"' )
+    {
+        const char * k_end = skip_json_string( k, p );
+        if ( k_end )
+        {
+            rec->type_ = std::string_view( k + 1, k_end - k - 2 );
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief find the end of the last complete record in the buffer.
+  \param format data format
+  \param data buffer
+  \param size the number of bytes in the buffer
+  \return the number of bytes that contain only the complete records
+*/
+std::size_t
+find_boundary( const RecordPatcher::Format format,
+               const char * data,
+               const std::size_t size )
+{
+    if ( format == RecordPatcher::TEXT )
+    {
+        std::size_t n = size;
+        while ( n > 0
+                && data[n - 1] != '\n' )
+        {
+            --n;
+        }
+        return n;
+    }
+
+    std::size_t boundary = 0;
+    std::size_t pos = 0;
+    Record rec;
+    while ( next_json_record( data, size, &pos, &rec ) )
+    {
+        boundary = rec.end_;
+        pos = rec.next_;
+    }
+    return boundary;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief append the next data to the buffer.
+  \param is input stream
+  \param buf buffer. it is enlarged if it is already full.
+  \param size the number of bytes in the buffer
+  \param eof set to true if the stream reaches the end
+  \return false if more data are needed to detect the format.
+*/
+bool
+read_block( std::istream & is,
+            std::vector< char > * buf,
+            std::size_t * size,
+            bool * eof )
+{
+    if ( *size == buf->size() )
+    {
+        // the record is longer than the buffer.
+        buf->resize( buf->size() * 2 );
+    }
+
+    is.read( buf->data() + *size, buf->size() - *size );
+    const std::size_t n = static_cast< std::size_t >( is.gcount() );
+    *size += n;
+    *eof = ( n == 0 || ! is );
+
+    return *eof
+        || *size >= 4;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+RecordPatcher::RecordPatcher( const std::size_t block_size )
+    : M_block_size( std::max< std::size_t >( block_size, 4096 ) ),
+      M_jobs( 1 ),
+      M_record_count( 0 ),
+      M_patched_count( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+RecordPatcher::Format
+RecordPatcher::detect_format( const char * header,
+                              const std::size_t size )
+{
+    if ( size >= 1
+         && header[0] == '[' )
+    {
+        return JSON;
+    }
+
+    if ( size >= 4
+         && std::strncmp( header, "ULG", 3 ) == 0
+         && ( header[3] == '4' || header[3] == '5' || header[3] == '6' ) )
+    {
+        return TEXT;
+    }
+
+    return UNKNOWN;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+RecordPatcher::setJobs( const int jobs )
+{
+    M_jobs = ( jobs > 0
+               ? jobs
+               : std::max( 1, static_cast< int >( std::thread::hardware_concurrency() ) ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+RecordPatcher::setEditor( const std::string & type,
+                          const Editor & editor )
+{
+    for ( std::pair< std::string, Editor > & e : M_editors )
+    {
+        if ( e.first == type )
+        {
+            e.second = editor;
+            return;
+        }
+    }
+
+    M_editors.emplace_back( type, editor );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const RecordPatcher::Editor *
+RecordPatcher::findEditor( const std::string_view type ) const
+{
+    for ( const std::pair< std::string, Editor > & e : M_editors )
+    {
+        if ( e.first == type )
+        {
+            return &e.second;
+        }
+    }
+
+    return nullptr;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::size_t
+RecordPatcher::patchBlock( const Format format,
+                           const char * data,
+                           const std::size_t size,
+                           std::string * out,
+                           std::size_t * patched_count ) const
+{
+    std::size_t n_records = 0;
+    std::size_t copy_begin = 0;
+    std::size_t pos = 0;
+    std::string edited;
+    Record rec;
+
+    while ( format == TEXT
+            ? next_text_record( data, size, &pos, true, &rec )
+            : next_json_record( data, size, &pos, &rec ) )
+    {
+        ++n_records;
+
+        const Editor * editor = findEditor( rec.type_ );
+        if ( editor
+             && (*editor)( std::string_view( data + rec.begin_, rec.end_ - rec.begin_ ), &edited ) )
+        {
+            out->append( data + copy_begin, rec.begin_ - copy_begin );
+            out->append( edited );
+            copy_begin = rec.end_;
+            ++(*patched_count);
+        }
+
+        pos = rec.next_;
+    }
+
+    // the trailing bytes that are not a complete record are also copied.
+    out->append( data + copy_begin, size - copy_begin );
+    return n_records;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+RecordPatcher::run( std::istream & is,
+                    std::ostream & os )
+{
+    M_record_count = 0;
+    M_patched_count = 0;
+
+    if ( M_jobs > 1 )
+    {
+        return runParallel( is, os );
+    }
+
+    std::vector< char > buf( M_block_size );
+    std::size_t size = 0;
+    Format format = UNKNOWN;
+    bool eof = false;
+    std::string out;
+
+    while ( ! eof )
+    {
+        if ( ! read_block( is, &buf, &size, &eof ) )
+        {
+            continue;
+        }
+
+        if ( format == UNKNOWN )
+        {
+            format = detect_format( buf.data(), size );
+            if ( format == UNKNOWN )
+            {
+                return false;
+            }
+        }
+
+        const std::size_t boundary = ( eof ? size : find_boundary( format, buf.data(), size ) );
+
+        out.clear();
+        M_record_count += patchBlock( format, buf.data(), boundary, &out, &M_patched_count );
+        os.write( out.data(), out.size() );
+
+        std::memmove( buf.data(), buf.data() + boundary, size - boundary );
+        size -= boundary;
+    }
+
+    os.flush();
+    return ! is.bad()
+        && os.good();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+RecordPatcher::runParallel( std::istream & is,
+                            std::ostream & os )
+{
+    struct Block {
+        std::vector< char > data_;
+        std::string out_;
+        std::size_t record_count_ = 0;
+        std::size_t patched_count_ = 0;
+        bool done_ = false;
+    };
+
+    const std::size_t window = static_cast< std::size_t >( M_jobs ) * 2;
+
+    Format format = UNKNOWN;
+    std::deque< std::unique_ptr< Block > > blocks; // blocks in the input order
+    std::deque< Block * > queue; // blocks waiting for the workers
+    bool finished = false;
+
+    std::mutex mtx;
+    std::condition_variable queued_cond;
+    std::condition_variable done_cond;
+
+    const auto worker = [&]()
+        {
+            while ( true )
+            {
+                Block * b = nullptr;
+                {
+                    std::unique_lock< std::mutex > lock( mtx );
+                    queued_cond.wait( lock, [&]() { return finished || ! queue.empty(); } );
+                    if ( queue.empty() )
+                    {
+                        break;
+                    }
+                    b = queue.front();
+                    queue.pop_front();
+                }
+
+                b->out_.reserve( b->data_.size() + b->data_.size() / 8 );
+                b->record_count_ = patchBlock( format, b->data_.data(), b->data_.size(),
+                                               &b->out_, &b->patched_count_ );
+                {
+                    std::lock_guard< std::mutex > lock( mtx );
+                    b->done_ = true;
+                }
+                done_cond.notify_all();
+            }
+        };
+
+    // write the oldest block after it is edited.
+    const auto write_front = [&]()
+        {
+            std::unique_ptr< Block > b;
+            {
+                std::unique_lock< std::mutex > lock( mtx );
+                done_cond.wait( lock, [&]() { return blocks.front()->done_; } );
+                b = std::move( blocks.front() );
+                blocks.pop_front();
+            }
+            os.write( b->out_.data(), b->out_.size() );
+            M_record_count += b->record_count_;
+            M_patched_count += b->patched_count_;
+        };
+
+    std::vector< std::thread > threads;
+    threads.reserve( M_jobs );
+    for ( int i = 0; i < M_jobs; ++i )
+    {
+        threads.emplace_back( worker );
+    }
+
+    bool result = true;
+    std::vector< char > buf( M_block_size );
+    std::size_t size = 0;
+    bool eof = false;
+
+    while ( ! eof )
+    {
+        if ( ! read_block( is, &buf, &size, &eof ) )
+        {
+            continue;
+        }
+
+        if ( format == UNKNOWN )
+        {
+            format = detect_format( buf.data(), size );
+            if ( format == UNKNOWN )
+            {
+                result = false;
+                break;
+            }
+        }
+
+        const std::size_t boundary = ( eof ? size : find_boundary( format, buf.data(), size ) );
+        if ( boundary == 0 )
+        {
+            continue;
+        }
+
+        std::unique_ptr< Block > b( new Block() );
+        b->data_.assign( buf.data(), buf.data() + boundary );
+        std::memmove( buf.data(), buf.data() + boundary, size - boundary );
+        size -= boundary;
+
+        while ( blocks.size() >= window )
+        {
+            write_front();
+        }
+
+        {
+            std::lock_guard< std::mutex > lock( mtx );
+            queue.push_back( b.get() );
+            blocks.push_back( std::move( b ) );
+        }
+        queued_cond.notify_one();
+    }
+
+    while ( ! blocks.empty() )
+    {
+        write_front();
+    }
+
+    {
+        std::lock_guard< std::mutex > lock( mtx );
+        finished = true;
+    }
+    queued_cond.notify_all();
+
+    for ( std::thread & t : threads )
+    {
+        t.join();
+    }
+
+    os.flush();
+    return result
+        && ! is.bad()
+        && os.good();
+}
+
+}
+}
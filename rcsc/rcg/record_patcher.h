@@ -0,0 +1,208 @@
+// -*-c++-*-
+
+/*!
+  \file record_patcher.h
+  \brief byte level rcg record patcher Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_RCG_RECORD_PATCHER_H
+#define RCSC_RCG_RECORD_PATCHER_H
+
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace rcsc {
+namespace rcg {
+
+/*!
+  \class RecordPatcher
+  \brief rewrite the selected records of the text or JSON rcg data without decoding.
+
+  The input is split into records by a cheap tokenizer: one line for the
+  text rcg (v4-v6), and one top level object for the JSON rcg. The record
+  type is the first token of the line (e.g. "team" of "(team ...)") or the
+  first key of the object (e.g. "team" of {"team":{...}}). Only the records
+  of the types that have an editor are passed to the editor. All other bytes,
+  including the separators, are copied verbatim in large blocks.
+  The memory usage is bounded by the block size (or the largest record).
+
+  If more than one job is set, the blocks are edited by the worker threads
+  and written in the input order. Then the editors are called concurrently,
+  so they must not modify any shared object. At most two blocks per job are
+  kept in memory.
+*/
+class RecordPatcher {
+public:
+
+    /*!
+      \enum Format
+      \brief supported data formats
+    */
+    enum Format {
+        UNKNOWN, //!< unsupported format (binary rcg v1-v3, v7)
+        TEXT, //!< line based text rcg (v4-v6)
+        JSON, //!< JSON rcg
+    };
+
+    /*!
+      \brief record editor.
+      The first argument is the record without the line feed.
+      Return true after writing the replacement to the second argument,
+      or false to copy the record as it is.
+    */
+    using Editor = std::function< bool( std::string_view, std::string * ) >;
+
+private:
+
+    //! the number of bytes read at once
+    std::size_t M_block_size;
+
+    //! the number of worker threads
+    int M_jobs;
+
+    //! pairs of the record type and its editor
+    std::vector< std::pair< std::string, Editor > > M_editors;
+
+    //! the number of records found by the last run()
+    std::size_t M_record_count;
+
+    //! the number of records rewritten by the last run()
+    std::size_t M_patched_count;
+
+public:
+
+    /*!
+      \brief create the patcher without any editor
+      \param block_size the number of bytes read at once
+    */
+    explicit
+    RecordPatcher( const std::size_t block_size = 1024 * 1024 );
+
+    /*!
+      \brief detect the data format by the first bytes
+      \param header the first bytes of the uncompressed data
+      \param size the number of bytes. at least 4 bytes are needed.
+      \return detected format
+    */
+    static
+    Format detect_format( const char * header,
+                          const std::size_t size );
+
+    /*!
+      \brief set the number of threads that edit the records.
+      \param jobs thread count. 0 or a negative value means the number of hardware threads.
+    */
+    void setJobs( const int jobs );
+
+    /*!
+      \brief get the number of threads that edit the records.
+      \return thread count
+    */
+    int jobs() const
+      {
+          return M_jobs;
+      }
+
+    /*!
+      \brief register the editor of the record type. the old editor of the same type is replaced.
+      \param type record type name
+      \param editor editor function
+    */
+    void setEditor( const std::string & type,
+                    const Editor & editor );
+
+    /*!
+      \brief copy the data from the input stream to the output stream with the registered editors.
+      \param is input stream. the read position must be the beginning of the data.
+      \param os output stream
+      \return false if the data format is not supported or the streams are broken.
+    */
+    bool run( std::istream & is,
+              std::ostream & os );
+
+    /*!
+      \brief get the number of records found by the last run()
+      \return the number of records
+    */
+    std::size_t recordCount() const
+      {
+          return M_record_count;
+      }
+
+    /*!
+      \brief get the number of records rewritten by the last run()
+      \return the number of rewritten records
+    */
+    std::size_t patchedCount() const
+      {
+          return M_patched_count;
+      }
+
+private:
+
+    /*!
+      \brief find the editor of the record type
+      \param type record type name
+      \return pointer to the editor, or nullptr
+    */
+    const Editor * findEditor( const std::string_view type ) const;
+
+    /*!
+      \brief edit all records in the block that ends at the record boundary.
+      \param format data format
+      \param data block data
+      \param size block size
+      \param out the edited block is appended to this variable
+      \param patched_count the number of rewritten records is added to this variable
+      \return the number of records in the block
+    */
+    std::size_t patchBlock( const Format format,
+                            const char * data,
+                            const std::size_t size,
+                            std::string * out,
+                            std::size_t * patched_count ) const;
+
+    /*!
+      \brief edit the blocks by the worker threads.
+      \param is input stream
+      \param os output stream
+      \return false if the data format is not supported or the streams are broken.
+    */
+    bool runParallel( std::istream & is,
+                      std::ostream & os );
+
+};
+
+}
+}
+
+#endif
@@ -43,6 +43,7 @@
 #include "serializer_v4.h"
 #include "serializer_v5.h"
 #include "serializer_v6.h"
+#include "serializer_v7.h"
 #include "serializer_json.h"
 
 #include <algorithm>
@@ -93,6 +94,7 @@ Serializer::create( const int version )
 
     if ( version == REC_VERSION_JSON ) ptr = Serializer::Ptr( new SerializerJSON() );
     else if ( version == REC_VERSION_6 ) ptr = Serializer::Ptr( new SerializerV6() );
+    else if ( version == REC_VERSION_7 ) ptr = Serializer::Ptr( new SerializerV7() );
     else if ( version == REC_VERSION_5 ) ptr = Serializer::Ptr( new SerializerV5() );
     else if ( version == REC_VERSION_4 ) ptr = Serializer::Ptr( new SerializerV4() );
     else if ( version == REC_VERSION_3 ) ptr = Serializer::Ptr( new SerializerV3() );
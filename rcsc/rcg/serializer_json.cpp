@@ -583,93 +583,95 @@ SerializerJSON::serialize( std::ostream & os,
     M_time = show.time_;
     M_stime = show.stime_;
 
-    os << ",\n";
-    os << '{' << std::quoted( "show" ) << ':'
-       << '{';
+    TextBuffer & buf = M_show_buffer;
+
+    buf.put( ",\n" );
+    buf.put( '{' ).putQuoted( "show" ).put( ':' )
+        .put( '{' );
 
-    os << std::quoted( "time" ) << ':' << show.time_;
+    buf.putQuoted( "time" ).put( ':' ).putInt( show.time_ );
     if ( show.stime_ > 0 )
     {
-        os << ',' << std::quoted( "stime" ) << ':' << show.stime_;
+        buf.put( ',' ).putQuoted( "stime" ).put( ':' ).putInt( show.stime_ );
     }
 
     // ball
-    os << ',';
-    os << std::quoted( "ball" ) << ':';
-    os << '{' << std::quoted( "x" ) << ':' << show.ball_.x_;
-    os << ',' << std::quoted( "y" ) << ':' << show.ball_.y_;
+    buf.put( ',' );
+    buf.putQuoted( "ball" ).put( ':' );
+    buf.put( '{' ).putQuoted( "x" ).put( ':' ).putFloat( show.ball_.x_ );
+    buf.put( ',' ).putQuoted( "y" ).put( ':' ).putFloat( show.ball_.y_ );
     if ( show.ball_.hasVelocity() )
     {
-        os << ',' << std::quoted( "vx" ) << ':' << show.ball_.vx_;
-        os << ',' << std::quoted( "vy" ) << ':' << show.ball_.vy_;
+        buf.put( ',' ).putQuoted( "vx" ).put( ':' ).putFloat( show.ball_.vx_ );
+        buf.put( ',' ).putQuoted( "vy" ).put( ':' ).putFloat( show.ball_.vy_ );
     }
-    os << '}';
+    buf.put( '}' );
 
     // players
-    os << ',';
-    os << std::quoted( "players" ) << ':' << '[';
+    buf.put( ',' );
+    buf.putQuoted( "players" ).put( ':' ).put( '[' );
     for ( int i = 0; i < MAX_PLAYER*2; ++i )
     {
         const PlayerT & p = show.player_[i];
 
-        if ( i > 0 ) os << ',';
+        if ( i > 0 ) buf.put( ',' );
         // begin
-        os << '{' << std::quoted( "side" ) << ':' << '"' << p.side_ << '"'
-           << ',' << std::quoted( "unum" ) << ':' << p.unum_
-           << ',' << std::quoted( "type" ) << ':' << p.type_
-           << ',' << std::quoted( "state" ) << ':' << p.state_;
+        buf.put( '{' ).putQuoted( "side" ).put( ':' ).put( '"' ).put( p.side_ ).put( '"' )
+            .put( ',' ).putQuoted( "unum" ).put( ':' ).putInt( p.unum_ )
+            .put( ',' ).putQuoted( "type" ).put( ':' ).putInt( p.type_ )
+            .put( ',' ).putQuoted( "state" ).put( ':' ).putInt( p.state_ );
         // pos
-        os << ',' << std::quoted( "x" ) << ':' << quantize( p.x_, POS_PREC )
-           << ',' << std::quoted( "y" ) << ':' << quantize( p.y_, POS_PREC )
-           << ',' << std::quoted( "vx" ) << ':' << quantize( p.vx_, POS_PREC )
-           << ',' << std::quoted( "vy" ) << ':' << quantize( p.vy_, POS_PREC )
-           << ',' << std::quoted( "body" ) << ':' << quantize( p.body_, DIR_PREC )
-           << ',' << std::quoted( "neck" ) << ':' << quantize( p.neck_, DIR_PREC );
+        buf.put( ',' ).putQuoted( "x" ).put( ':' ).putFloat( quantize( p.x_, POS_PREC ) )
+            .put( ',' ).putQuoted( "y" ).put( ':' ).putFloat( quantize( p.y_, POS_PREC ) )
+            .put( ',' ).putQuoted( "vx" ).put( ':' ).putFloat( quantize( p.vx_, POS_PREC ) )
+            .put( ',' ).putQuoted( "vy" ).put( ':' ).putFloat( quantize( p.vy_, POS_PREC ) )
+            .put( ',' ).putQuoted( "body" ).put( ':' ).putFloat( quantize( p.body_, DIR_PREC ) )
+            .put( ',' ).putQuoted( "neck" ).put( ':' ).putFloat( quantize( p.neck_, DIR_PREC ) );
         // arm
         if ( p.hasArm() )
         {
-            os << ',' << std::quoted( "px" ) << ':' << quantize( p.point_x_, POS_PREC )
-               << ',' << std::quoted( "py" ) << ':' << quantize( p.point_y_, POS_PREC );
+            buf.put( ',' ).putQuoted( "px" ).put( ':' ).putFloat( quantize( p.point_x_, POS_PREC ) )
+                .put( ',' ).putQuoted( "py" ).put( ':' ).putFloat( quantize( p.point_y_, POS_PREC ) );
         }
         // view mode
-        os << ',' << std::quoted( "vq" ) << ':' << std::quoted( p.highQuality() ? "h" : "l" )
-           << ',' << std::quoted( "vw" ) << ':' << quantize( p.view_width_, DIR_PREC );
+        buf.put( ',' ).putQuoted( "vq" ).put( ':' ).putQuoted( p.highQuality() ? "h" : "l" )
+            .put( ',' ).putQuoted( "vw" ).put( ':' ).putFloat( quantize( p.view_width_, DIR_PREC ) );
         // focus point
-        os << ',' << std::quoted( "fdist" ) << ':' << quantize( p.focus_dist_, POS_PREC )
-           << ',' << std::quoted( "fdir" ) << ':' << quantize( p.focus_dir_, DIR_PREC );
+        buf.put( ',' ).putQuoted( "fdist" ).put( ':' ).putFloat( quantize( p.focus_dist_, POS_PREC ) )
+            .put( ',' ).putQuoted( "fdir" ).put( ':' ).putFloat( quantize( p.focus_dir_, DIR_PREC ) );
         // stamina
-        os << ',' << std::quoted( "stamina" ) << ':' << p.stamina_
-           << ',' << std::quoted( "effort" ) << ':' << p.effort_
-           << ',' << std::quoted( "recovery" ) << ':' << p.recovery_
-           << ',' << std::quoted( "capacity" ) << ':' << p.stamina_capacity_;
+        buf.put( ',' ).putQuoted( "stamina" ).put( ':' ).putFloat( p.stamina_ )
+            .put( ',' ).putQuoted( "effort" ).put( ':' ).putFloat( p.effort_ )
+            .put( ',' ).putQuoted( "recovery" ).put( ':' ).putFloat( p.recovery_ )
+            .put( ',' ).putQuoted( "capacity" ).put( ':' ).putFloat( p.stamina_capacity_ );
         // focus
         if ( p.isFocusing() )
         {
-            os << ',' << std::quoted( "fside" ) << ':' << '"' << p.focus_side_ << '"'
-               << ',' << std::quoted( "fnum" ) << ':' << p.focus_unum_;
+            buf.put( ',' ).putQuoted( "fside" ).put( ':' ).put( '"' ).put( p.focus_side_ ).put( '"' )
+                .put( ',' ).putQuoted( "fnum" ).put( ':' ).putInt( p.focus_unum_ );
         }
         // count
-        os << ',' << std::quoted( "kick" ) << ':' << p.kick_count_
-           << ',' << std::quoted( "dash" ) << ':' << p.dash_count_
-           << ',' << std::quoted( "turn" ) << ':' << p.turn_count_
-           << ',' << std::quoted( "catch" ) << ':' << p.catch_count_
-           << ',' << std::quoted( "move" ) << ':' << p.move_count_
-           << ',' << std::quoted( "turn_neck" ) << ':' << p.turn_neck_count_
-           << ',' << std::quoted( "change_view" ) << ':' << p.change_view_count_
-           << ',' << std::quoted( "say" ) << ':' << p.say_count_
-           << ',' << std::quoted( "tackle" ) << ':' << p.tackle_count_
-           << ',' << std::quoted( "pointto" ) << ':' << p.pointto_count_
-           << ',' << std::quoted( "attentionto" ) << ':' << p.attentionto_count_
-           << ',' << std::quoted( "change_focus" ) << ':' << p.change_focus_count_;
+        buf.put( ',' ).putQuoted( "kick" ).put( ':' ).putInt( p.kick_count_ )
+            .put( ',' ).putQuoted( "dash" ).put( ':' ).putInt( p.dash_count_ )
+            .put( ',' ).putQuoted( "turn" ).put( ':' ).putInt( p.turn_count_ )
+            .put( ',' ).putQuoted( "catch" ).put( ':' ).putInt( p.catch_count_ )
+            .put( ',' ).putQuoted( "move" ).put( ':' ).putInt( p.move_count_ )
+            .put( ',' ).putQuoted( "turn_neck" ).put( ':' ).putInt( p.turn_neck_count_ )
+            .put( ',' ).putQuoted( "change_view" ).put( ':' ).putInt( p.change_view_count_ )
+            .put( ',' ).putQuoted( "say" ).put( ':' ).putInt( p.say_count_ )
+            .put( ',' ).putQuoted( "tackle" ).put( ':' ).putInt( p.tackle_count_ )
+            .put( ',' ).putQuoted( "pointto" ).put( ':' ).putInt( p.pointto_count_ )
+            .put( ',' ).putQuoted( "attentionto" ).put( ':' ).putInt( p.attentionto_count_ )
+            .put( ',' ).putQuoted( "change_focus" ).put( ':' ).putInt( p.change_focus_count_ );
         // end
-        os << '}';
+        buf.put( '}' );
     }
-    os << ']';
+    buf.put( ']' );
 
     //
-    os << '}';
-    os << '}';
-    return os;
+    buf.put( '}' );
+    buf.put( '}' );
+    return buf.flush( os );
 }
 
 /*-------------------------------------------------------------------*/
@@ -33,6 +33,7 @@
 #define RCSC_RCG_SERIALIZER_JSON_H
 
 #include <rcsc/rcg/serializer.h>
+#include <rcsc/rcg/text_buffer.h>
 
 namespace rcsc {
 namespace rcg {
@@ -44,6 +45,8 @@ private:
     Int32 M_time; //!< temporal time holder
     Int32 M_stime; //!< temporal time holder
 
+    TextBuffer M_show_buffer; //!< reused text buffer for the show records
+
 public:
 
     /*!
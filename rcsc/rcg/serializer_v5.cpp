@@ -69,24 +69,44 @@ SerializerV5::serializeBegin( std::ostream & os,
 std::ostream &
 SerializerV5::serialize( std::ostream & os,
                          const ShowInfoT & show )
+{
+    return writeShow( os, show, false );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+SerializerV5::writeShow( std::ostream & os,
+                         const ShowInfoT & show,
+                         const bool focus_point )
 {
     M_time = show.time_;
 
-    os << "(show " << show.time_;
+    TextBuffer & buf = M_show_buffer;
+
+    buf.put( "(show " );
+    buf.putInt( show.time_ );
 
     // ball
 
-    os << " ((b)"
-       << ' ' << show.ball_.x_ << ' ' << show.ball_.y_;
+    buf.put( " ((b) " );
+    buf.putFloat( show.ball_.x_ );
+    buf.put( ' ' );
+    buf.putFloat( show.ball_.y_ );
     if ( show.ball_.hasVelocity() )
     {
-        os << ' ' << show.ball_.vx_ << ' ' << show.ball_.vy_;
+        buf.put( ' ' );
+        buf.putFloat( show.ball_.vx_ );
+        buf.put( ' ' );
+        buf.putFloat( show.ball_.vy_ );
     }
     else
     {
-        os << " 0 0";
+        buf.put( " 0 0" );
     }
-    os << ')';
+    buf.put( ')' );
 
     // players
 
@@ -94,75 +114,113 @@ SerializerV5::serialize( std::ostream & os,
     {
         const PlayerT & p = show.player_[i];
 
-        os << " ((" << p.side_ << ' ' << p.unum_ << ')';
-        os << ' ' << p.type_;
-        os << ' ' << std::hex << std::showbase
-           << p.state_
-           << std::dec << std::noshowbase;
-
-        os << ' ' << p.x_ << ' ' << p.y_;
+        buf.put( " ((" );
+        buf.put( p.side_ );
+        buf.put( ' ' );
+        buf.putInt( p.unum_ );
+        buf.put( ") " );
+        buf.putInt( p.type_ );
+        buf.put( ' ' );
+        buf.putHex( p.state_ );
+
+        buf.put( ' ' );
+        buf.putFloat( p.x_ );
+        buf.put( ' ' );
+        buf.putFloat( p.y_ );
         if ( p.hasVelocity() )
         {
-            os << ' ' << p.vx_ << ' ' << p.vy_;
+            buf.put( ' ' );
+            buf.putFloat( p.vx_ );
+            buf.put( ' ' );
+            buf.putFloat( p.vy_ );
         }
         else
         {
-            os << " 0 0";
+            buf.put( " 0 0" );
         }
-        os << ' ' << p.body_
-           << ' ' << ( p.hasNeck() ? p.neck_ : 0.0f );
+        buf.put( ' ' );
+        buf.putFloat( p.body_ );
+        buf.put( ' ' );
+        buf.putFloat( p.hasNeck() ? p.neck_ : 0.0f );
 
         if ( p.isPointing() )
         {
-            os << ' ' << p.point_x_ << ' ' << p.point_y_;
+            buf.put( ' ' );
+            buf.putFloat( p.point_x_ );
+            buf.put( ' ' );
+            buf.putFloat( p.point_y_ );
         }
 
         if ( p.hasView() )
         {
-            os << " (v " << p.view_quality_ << ' ' << p.view_width_ << ')';
+            buf.put( " (v " );
+            buf.put( p.view_quality_ );
+            buf.put( ' ' );
+            buf.putFloat( p.view_width_ );
+            buf.put( ')' );
         }
         else
         {
-            os << " (v h 90)";
+            buf.put( " (v h 90)" );
+        }
+
+        if ( focus_point )
+        {
+            buf.put( " (fp " );
+            buf.putFloat( p.focus_dist_ );
+            buf.put( ' ' );
+            buf.putFloat( p.focus_dir_ );
+            buf.put( ')' );
         }
 
         if ( p.hasStamina() )
         {
-            os << " (s " << p.stamina_
-               << ' ' << p.effort_
-               << ' ' << p.recovery_
-               << ' ' << p.stamina_capacity_
-               << ')';
+            buf.put( " (s " );
+            buf.putFloat( p.stamina_ );
+            buf.put( ' ' );
+            buf.putFloat( p.effort_ );
+            buf.put( ' ' );
+            buf.putFloat( p.recovery_ );
+            buf.put( ' ' );
+            buf.putFloat( p.stamina_capacity_ );
+            buf.put( ')' );
         }
         else
         {
-            os << " (s 4000 1 1 -1)";
+            buf.put( " (s 4000 1 1 -1)" );
         }
 
         if ( p.focus_side_ != 'n' )
         {
-            os << " (f" << p.focus_side_ << ' ' << p.focus_unum_ << ')';
+            buf.put( " (f" );
+            buf.put( p.focus_side_ );
+            buf.put( ' ' );
+            buf.putInt( p.focus_unum_ );
+            buf.put( ')' );
         }
 
-        os << " (c"
-           << ' ' << p.kick_count_
-           << ' ' << p.dash_count_
-           << ' ' << p.turn_count_
-           << ' ' << p.catch_count_
-           << ' ' << p.move_count_
-           << ' ' << p.turn_neck_count_
-           << ' ' << p.change_view_count_
-           << ' ' << p.say_count_
-           << ' ' << p.tackle_count_
-           << ' ' << p.pointto_count_
-           << ' ' << p.attentionto_count_
-           << ')';
-        os << ')';
+        buf.put( " (c" );
+        for ( const UInt16 count : { p.kick_count_,
+                                     p.dash_count_,
+                                     p.turn_count_,
+                                     p.catch_count_,
+                                     p.move_count_,
+                                     p.turn_neck_count_,
+                                     p.change_view_count_,
+                                     p.say_count_,
+                                     p.tackle_count_,
+                                     p.pointto_count_,
+                                     p.attentionto_count_ } )
+        {
+            buf.put( ' ' );
+            buf.putInt( count );
+        }
+        buf.put( "))" );
     }
 
-    os << ")\n";
+    buf.put( ")\n" );
 
-    return os;
+    return buf.flush( os );
 }
 
 
@@ -33,6 +33,7 @@
 #define RCSC_RCG_SERIALIZER_V5_H
 
 #include <rcsc/rcg/serializer_v4.h>
+#include <rcsc/rcg/text_buffer.h>
 
 namespace rcsc {
 namespace rcg {
@@ -43,6 +44,11 @@ namespace rcg {
 */
 class SerializerV5
     : public SerializerV4 {
+private:
+
+    //! reused text buffer for the show records
+    TextBuffer M_show_buffer;
+
 public:
 
     /*!
@@ -79,6 +85,21 @@ public:
     std::ostream & serialize( std::ostream & os,
                               const ShowInfoT & show ) override;
 
+protected:
+
+    /*!
+      \brief format the show record into the internal buffer and write it at once.
+      numbers are formatted by std::to_chars, and the result is identical to
+      the default std::ostream formatting.
+      \param os reference to the output stream
+      \param show show data
+      \param focus_point if true, the focus point element (v6+) is written.
+      \return reference to the output stream
+     */
+    std::ostream & writeShow( std::ostream & os,
+                              const ShowInfoT & show,
+                              const bool focus_point );
+
 };
 
 } // end of namespace rcg
@@ -70,102 +70,7 @@ std::ostream &
 SerializerV6::serialize( std::ostream & os,
                          const ShowInfoT & show )
 {
-    M_time = show.time_;
-
-    os << "(show " << show.time_;
-
-    // ball
-
-    os << " ((b)"
-       << ' ' << show.ball_.x_ << ' ' << show.ball_.y_;
-    if ( show.ball_.hasVelocity() )
-    {
-        os << ' ' << show.ball_.vx_ << ' ' << show.ball_.vy_;
-    }
-    else
-    {
-        os << " 0 0";
-    }
-    os << ')';
-
-    // players
-
-    for ( int i = 0; i < MAX_PLAYER*2; ++i )
-    {
-        const PlayerT & p = show.player_[i];
-
-        os << " ((" << p.side_ << ' ' << p.unum_ << ')';
-        os << ' ' << p.type_;
-        os << ' ' << std::hex << std::showbase
-           << p.state_
-           << std::dec << std::noshowbase;
-
-        os << ' ' << p.x_ << ' ' << p.y_;
-        if ( p.hasVelocity() )
-        {
-            os << ' ' << p.vx_ << ' ' << p.vy_;
-        }
-        else
-        {
-            os << " 0 0";
-        }
-        os << ' ' << p.body_
-           << ' ' << ( p.hasNeck() ? p.neck_ : 0.0f );
-
-        if ( p.isPointing() )
-        {
-            os << ' ' << p.point_x_ << ' ' << p.point_y_;
-        }
-
-        if ( p.hasView() )
-        {
-            os << " (v " << p.view_quality_ << ' ' << p.view_width_ << ')';
-        }
-        else
-        {
-            os << " (v h 90)";
-        }
-
-        // v6
-        os << " (fp " << p.focusDist() << ' ' << p.focusDir() << ')';
-
-        if ( p.hasStamina() )
-        {
-            os << " (s " << p.stamina_
-               << ' ' << p.effort_
-               << ' ' << p.recovery_
-               << ' ' << p.stamina_capacity_
-               << ')';
-        }
-        else
-        {
-            os << " (s 4000 1 1 -1)";
-        }
-
-        if ( p.focus_side_ != 'n' )
-        {
-            os << " (f" << p.focus_side_ << ' ' << p.focus_unum_ << ')';
-        }
-
-        os << " (c"
-           << ' ' << p.kick_count_
-           << ' ' << p.dash_count_
-           << ' ' << p.turn_count_
-           << ' ' << p.catch_count_
-           << ' ' << p.move_count_
-           << ' ' << p.turn_neck_count_
-           << ' ' << p.change_view_count_
-           << ' ' << p.say_count_
-           << ' ' << p.tackle_count_
-           << ' ' << p.pointto_count_
-           << ' ' << p.attentionto_count_
-           << ')';
-        os << ')';
-    }
-
-    os << ")\n";
-
-    return os;
+    return writeShow( os, show, true );
 }
 
 
@@ -0,0 +1,327 @@
+// -*-c++-*-
+
+/*!
+  \file serializer_v7.cpp
+  \brief v7 columnar format rcg serializer Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "serializer_v7.h"
+
+namespace rcsc {
+namespace rcg {
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+void
+append_u32( std::string * out,
+            const std::uint32_t value )
+{
+    for ( int i = 0; i < 4; ++i )
+    {
+        out->push_back( static_cast< char >( ( value >> ( i * 8 ) ) & 0xff ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+void
+append_string( std::string * out,
+               const std::string & str )
+{
+    append_u32( out, static_cast< std::uint32_t >( str.size() ) );
+    out->append( str );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+SerializerV7::SerializerV7()
+    : SerializerV6(),
+      M_offset( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+SerializerV7::serializeBegin( std::ostream & os,
+                              const std::string & server_version,
+                              const std::string & timestamp )
+{
+    M_text.str( std::string() );
+    M_block.clear();
+    M_index.clear();
+    M_offset = 0;
+
+    std::string header( "ULG7" );
+    header.push_back( static_cast< char >( ColumnBlock::REVISION ) );
+    append_string( &header, server_version );
+    append_string( &header, timestamp );
+
+    write( os, header );
+    return os;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+SerializerV7::serializeEnd( std::ostream & os )
+{
+    takeEvents();
+    if ( ! M_block.empty() )
+    {
+        writeBlock( os );
+    }
+
+    const std::uint64_t footer_offset = M_offset;
+
+    std::string index;
+    ColumnBlock::encodeIndex( M_index, &index );
+
+    std::string footer( 1, ColumnBlock::FOOTER_TAG );
+    append_u32( &footer, static_cast< std::uint32_t >( index.size() ) );
+    footer += index;
+    append_u32( &footer, static_cast< std::uint32_t >( footer_offset ) );
+    append_u32( &footer, static_cast< std::uint32_t >( footer_offset >> 32 ) );
+    footer += "ULGI";
+
+    write( os, footer );
+    return os.flush();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+SerializerV7::serialize( std::ostream & os,
+                         const ShowInfoT & show )
+{
+    M_time = show.time_;
+
+    // the records before this show belong to the current block
+    takeEvents();
+    if ( M_block.full() )
+    {
+        writeBlock( os );
+    }
+
+    M_block.addShow( show );
+    return os;
+}
+
+/*-------------------------------------------------------------------*/
+std::ostream &
+SerializerV7::serialize( std::ostream & os,
+                         const server_params_t & param )
+{
+    SerializerV4::serialize( M_text, param );
+    return os;
+}
+
+/*-------------------------------------------------------------------*/
+std::ostream &
+SerializerV7::serialize( std::ostream & os,
+                         const player_params_t & pparam )
+{
+    SerializerV4::serialize( M_text, pparam );
+    return os;
+}
+
+/*-------------------------------------------------------------------*/
+std::ostream &
+SerializerV7::serialize( std::ostream & os,
+                         const player_type_t & type )
+{
+    SerializerV4::serialize( M_text, type );
+    return os;
+}
+
+/*-------------------------------------------------------------------*/
+std::ostream &
+SerializerV7::serialize( std::ostream & os,
+                         const msginfo_t & msg )
+{
+    SerializerV4::serialize( M_text, msg );
+    return os;
+}
+
+/*-------------------------------------------------------------------*/
+std::ostream &
+SerializerV7::serialize( std::ostream & os,
+                         const Int16 board,
+                         const std::string & msg )
+{
+    SerializerV4::serialize( M_text, board, msg );
+    return os;
+}
+
+/*-------------------------------------------------------------------*/
+std::ostream &
+SerializerV7::serialize( std::ostream & os,
+                         const char playmode )
+{
+    SerializerV4::serialize( M_text, playmode );
+    return os;
+}
+
+/*-------------------------------------------------------------------*/
+std::ostream &
+SerializerV7::serialize( std::ostream & os,
+                         const TeamT & team_l,
+                         const TeamT & team_r )
+{
+    SerializerV4::serialize( M_text, team_l, team_r );
+    return os;
+}
+
+/*-------------------------------------------------------------------*/
+std::ostream &
+SerializerV7::serialize( std::ostream & os,
+                         const ServerParamT & param )
+{
+    SerializerV4::serialize( M_text, param );
+    return os;
+}
+
+/*-------------------------------------------------------------------*/
+std::ostream &
+SerializerV7::serialize( std::ostream & os,
+                         const PlayerParamT & param )
+{
+    SerializerV4::serialize( M_text, param );
+    return os;
+}
+
+/*-------------------------------------------------------------------*/
+std::ostream &
+SerializerV7::serialize( std::ostream & os,
+                         const PlayerTypeT & param )
+{
+    SerializerV4::serialize( M_text, param );
+    return os;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SerializerV7::takeEvents()
+{
+    const std::string text = M_text.str();
+    if ( text.empty() )
+    {
+        return;
+    }
+
+    std::string::size_type begin = 0;
+    while ( begin < text.size() )
+    {
+        std::string::size_type end = text.find( '\n', begin );
+        if ( end == std::string::npos ) end = text.size();
+
+        if ( end > begin )
+        {
+            M_block.addEvent( text.substr( begin, end - begin ) );
+        }
+        begin = end + 1;
+    }
+
+    M_text.str( std::string() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SerializerV7::writeBlock( std::ostream & os )
+{
+    ColumnBlock::IndexEntry entry;
+    entry.offset_ = M_offset;
+    entry.shows_ = static_cast< std::uint32_t >( M_block.shows().size() );
+    entry.first_time_ = static_cast< std::uint32_t >( M_block.shows().empty() ? M_time : M_block.shows().front().time_ );
+    entry.last_time_ = static_cast< std::uint32_t >( M_block.shows().empty() ? M_time : M_block.shows().back().time_ );
+
+    std::string data;
+    M_block.encode( &data );
+
+    std::string record( 1, ColumnBlock::BLOCK_TAG );
+    append_u32( &record, static_cast< std::uint32_t >( data.size() ) );
+    record += data;
+
+    write( os, record );
+
+    M_index.push_back( entry );
+    M_block.clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+SerializerV7::write( std::ostream & os,
+                     const std::string & data )
+{
+    os.write( data.data(), data.size() );
+    M_offset += data.size();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+namespace {
+
+Serializer::Ptr
+create_v7()
+{
+    Serializer::Ptr ptr( new SerializerV7() );
+    return ptr;
+}
+
+rcss::RegHolder v7 = Serializer::creators().autoReg( &create_v7, REC_VERSION_7 );
+
+}
+
+} // end of namespace
+} // end of namespace
@@ -0,0 +1,165 @@
+// -*-c++-*-
+
+/*!
+  \file serializer_v7.h
+  \brief v7 columnar format rcg serializer class Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_RCG_SERIALIZER_V7_H
+#define RCSC_RCG_SERIALIZER_V7_H
+
+#include <rcsc/rcg/serializer_v6.h>
+#include <rcsc/rcg/column_block.h>
+
+#include <sstream>
+#include <cstdint>
+
+namespace rcsc {
+namespace rcg {
+
+/*!
+  \class SerializerV7
+  \brief rcg v7 serializer. show data are stored in columnar blocks.
+
+  File layout (little endian):
+  \verbatim
+  "ULG7" u8 revision
+  u32 length, server version string
+  u32 length, timestamp string
+  repeated: 'B' u32 size, ColumnBlock data
+  'F' u32 size, footer index (ColumnBlock::encodeIndex())
+  u64 offset of the 'F' record
+  "ULGI"
+  \endverbatim
+
+  The non-positional records are written as the same text lines as v6 into
+  the block, so they are restored by the v4 line parser.
+  The output stream must not be used by others until serializeEnd() is called.
+*/
+class SerializerV7
+    : public SerializerV6 {
+private:
+
+    std::ostringstream M_text; //!< text lines written since the last show
+    ColumnBlock M_block; //!< current block
+    std::vector< ColumnBlock::IndexEntry > M_index; //!< written blocks
+    std::uint64_t M_offset; //!< written byte count
+
+public:
+
+    /*!
+      \brief constructor
+    */
+    SerializerV7();
+
+    /*!
+      \brief destructor
+    */
+    ~SerializerV7()
+      { }
+
+    /*!
+      \brief write header
+      \param os reference to the output stream
+      \aram server_version server version string
+      \aram timestamp time stamp string
+      \return reference to the output stream
+    */
+    std::ostream & serializeBegin( std::ostream & os,
+                                   const std::string & server_version,
+                                   const std::string & timestamp ) override;
+
+    /*!
+      \brief write the remaining block and the footer index
+      \param os reference to the output stream
+      \return reference to the output stream
+     */
+    std::ostream & serializeEnd( std::ostream & os ) override;
+
+    /*!
+      \brief add ShowInfoT to the current block
+      \param os reference to the output stream
+      \param show data to be written
+      \return reference to the output stream
+     */
+    std::ostream & serialize( std::ostream & os,
+                              const ShowInfoT & show ) override;
+
+    //
+    // the following records are kept as text lines in the current block.
+    //
+
+    std::ostream & serialize( std::ostream & os,
+                              const server_params_t & param ) override;
+    std::ostream & serialize( std::ostream & os,
+                              const player_params_t & pparam ) override;
+    std::ostream & serialize( std::ostream & os,
+                              const player_type_t & type ) override;
+    std::ostream & serialize( std::ostream & os,
+                              const msginfo_t & msg ) override;
+    std::ostream & serialize( std::ostream & os,
+                              const Int16 board,
+                              const std::string & msg ) override;
+    std::ostream & serialize( std::ostream & os,
+                              const char playmode ) override;
+    std::ostream & serialize( std::ostream & os,
+                              const TeamT & team_l,
+                              const TeamT & team_r ) override;
+    std::ostream & serialize( std::ostream & os,
+                              const ServerParamT & param ) override;
+    std::ostream & serialize( std::ostream & os,
+                              const PlayerParamT & param ) override;
+    std::ostream & serialize( std::ostream & os,
+                              const PlayerTypeT & param ) override;
+
+private:
+
+    /*!
+      \brief move the buffered text lines into the current block
+     */
+    void takeEvents();
+
+    /*!
+      \brief write the current block
+      \param os reference to the output stream
+     */
+    void writeBlock( std::ostream & os );
+
+    /*!
+      \brief write a record and count its size
+      \param os reference to the output stream
+      \param data record data
+     */
+    void write( std::ostream & os,
+                const std::string & data );
+};
+
+} // end of namespace rcg
+} // end of namespace rcsc
+
+#endif
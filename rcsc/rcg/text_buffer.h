@@ -0,0 +1,199 @@
+// -*-c++-*-
+
+/*!
+  \file text_buffer.h
+  \brief reusable text output buffer for the serializers Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_RCG_TEXT_BUFFER_H
+#define RCSC_RCG_TEXT_BUFFER_H
+
+#include <charconv>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace rcsc {
+namespace rcg {
+
+/*!
+  \class TextBuffer
+  \brief growable character buffer for the text serializers.
+
+  Numbers are formatted by std::to_chars. The floating point format is the
+  same as the default std::ostream formatting (%g with 6 significant digits),
+  so the buffered output is identical to the output written through the
+  stream operators. The buffer keeps its capacity after flush(), so no
+  memory is allocated in the steady state.
+*/
+class TextBuffer {
+private:
+
+    std::string M_buf; //!< formatted text
+
+public:
+
+    /*!
+      \brief create the buffer
+      \param capacity initial capacity
+     */
+    explicit
+    TextBuffer( const std::size_t capacity = 16 * 1024 )
+      {
+          M_buf.reserve( capacity );
+      }
+
+    /*!
+      \brief get the buffered text size
+      \return the number of characters
+     */
+    std::size_t size() const
+      {
+          return M_buf.size();
+      }
+
+    /*!
+      \brief clear the buffered text without releasing the memory
+     */
+    void clear()
+      {
+          M_buf.clear();
+      }
+
+    /*!
+      \brief append a character
+      \param c character
+      \return reference to itself
+     */
+    TextBuffer & put( const char c )
+      {
+          M_buf += c;
+          return *this;
+      }
+
+    /*!
+      \brief append a string
+      \param str null terminated string
+      \return reference to itself
+     */
+    TextBuffer & put( const char * str )
+      {
+          M_buf += str;
+          return *this;
+      }
+
+    /*!
+      \brief append a string
+      \param str string
+      \return reference to itself
+     */
+    TextBuffer & put( const std::string & str )
+      {
+          M_buf += str;
+          return *this;
+      }
+
+    /*!
+      \brief append a double quoted key string. the key must not contain any quote or backslash.
+      \param key null terminated string
+      \return reference to itself
+     */
+    TextBuffer & putQuoted( const char * key )
+      {
+          M_buf += '"';
+          M_buf += key;
+          M_buf += '"';
+          return *this;
+      }
+
+    /*!
+      \brief append an integer value in decimal
+      \param value integer value
+      \return reference to itself
+     */
+    template < typename T >
+    TextBuffer & putInt( const T value )
+      {
+          char str[24];
+          const std::to_chars_result r = std::to_chars( str, str + sizeof( str ), value );
+          M_buf.append( str, r.ptr );
+          return *this;
+      }
+
+    /*!
+      \brief append an integer value in the same format as std::hex | std::showbase
+      \param value integer value
+      \return reference to itself
+     */
+    TextBuffer & putHex( const std::int32_t value )
+      {
+          if ( value == 0 )
+          {
+              M_buf += '0';
+              return *this;
+          }
+
+          char str[16];
+          const std::to_chars_result r = std::to_chars( str, str + sizeof( str ),
+                                                        static_cast< std::uint32_t >( value ), 16 );
+          M_buf += "0x";
+          M_buf.append( str, r.ptr );
+          return *this;
+      }
+
+    /*!
+      \brief append a floating point value in the default stream format
+      \param value floating point value
+      \return reference to itself
+     */
+    TextBuffer & putFloat( const double value )
+      {
+          char str[32];
+          const std::to_chars_result r = std::to_chars( str, str + sizeof( str ), value,
+                                                        std::chars_format::general, 6 );
+          M_buf.append( str, r.ptr );
+          return *this;
+      }
+
+    /*!
+      \brief write all buffered text to the stream at once, and clear the buffer.
+      \param os reference to the output stream
+      \return reference to the output stream
+     */
+    std::ostream & flush( std::ostream & os )
+      {
+          os.write( M_buf.data(), M_buf.size() );
+          M_buf.clear();
+          return os;
+      }
+};
+
+}
+}
+
+#endif
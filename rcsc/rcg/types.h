@@ -1700,6 +1700,8 @@ constexpr int REC_VERSION_4 = 4;
 constexpr int REC_VERSION_5 = 5;
 //! recorded value of rcg v6
 constexpr int REC_VERSION_6 = 6;
+//! recorded value of rcg v7 (columnar binary)
+constexpr int REC_VERSION_7 = 7;
 
 //! recorded value of json rcg
 constexpr int REC_VERSION_JSON = -1;
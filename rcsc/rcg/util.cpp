@@ -34,8 +34,8 @@
 #endif
 
 #include <rcsc/rcg/types.h>
+#include <rcsc/util/playmode_decoder.h>
 
-#include <unordered_map>
 #include <string>
 #include <sstream>
 #include <cstring>
@@ -443,6 +443,258 @@ convert( const SideID side,
     to.change_view_count_ = ntohs( from.change_view_count );
 }
 
+namespace {
+
+//! Int32 fields of player_t in the column layout
+enum PlayerLongColumn {
+    COL_X,
+    COL_Y,
+    COL_VX,
+    COL_VY,
+    COL_BODY,
+    COL_NECK,
+    COL_VIEW_WIDTH,
+    COL_STAMINA,
+    COL_EFFORT,
+    COL_RECOVERY,
+    LONG_COLUMN_SIZE
+};
+
+//! Int16 fields of player_t in the column layout
+enum PlayerShortColumn {
+    COL_MODE,
+    COL_TYPE,
+    COL_VIEW_QUALITY,
+    COL_KICK,
+    COL_DASH,
+    COL_TURN,
+    COL_SAY,
+    COL_TURN_NECK,
+    COL_CATCH,
+    COL_MOVE,
+    COL_CHANGE_VIEW,
+    SHORT_COLUMN_SIZE
+};
+
+constexpr int PLAYER_SIZE = MAX_PLAYER * 2;
+
+/*!
+  \struct PlayerColumns
+  \brief all player_t fields of one show record stored column by column.
+
+  The byte swap and the scale conversion are flat loops over each column,
+  and the compiler can vectorize them.
+*/
+struct PlayerColumns {
+    Int32 long_[LONG_COLUMN_SIZE][PLAYER_SIZE]; //!< raw Int32 values
+    UInt16 short_[SHORT_COLUMN_SIZE][PLAYER_SIZE]; //!< byte swapped Int16 values
+    float value_[LONG_COLUMN_SIZE][PLAYER_SIZE]; //!< unscaled Int32 values
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief convert all players of showinfo_t2/short_showinfo_t2 in one pass.
+  the result is same as convert( side, unum, player_t, PlayerT ) for each player.
+ */
+void
+decode_players( const player_t * from,
+                PlayerT * to )
+{
+    PlayerColumns c;
+
+    for ( int i = 0; i < PLAYER_SIZE; ++i )
+    {
+        const player_t & p = from[i];
+        c.long_[COL_X][i] = p.x;
+        c.long_[COL_Y][i] = p.y;
+        c.long_[COL_VX][i] = p.deltax;
+        c.long_[COL_VY][i] = p.deltay;
+        c.long_[COL_BODY][i] = p.body_angle;
+        c.long_[COL_NECK][i] = p.head_angle;
+        c.long_[COL_VIEW_WIDTH][i] = p.view_width;
+        c.long_[COL_STAMINA][i] = p.stamina;
+        c.long_[COL_EFFORT][i] = p.effort;
+        c.long_[COL_RECOVERY][i] = p.recovery;
+        c.short_[COL_MODE][i] = p.mode;
+        c.short_[COL_TYPE][i] = p.type;
+        c.short_[COL_VIEW_QUALITY][i] = p.view_quality;
+        c.short_[COL_KICK][i] = p.kick_count;
+        c.short_[COL_DASH][i] = p.dash_count;
+        c.short_[COL_TURN][i] = p.turn_count;
+        c.short_[COL_SAY][i] = p.say_count;
+        c.short_[COL_TURN_NECK][i] = p.turn_neck_count;
+        c.short_[COL_CATCH][i] = p.catch_count;
+        c.short_[COL_MOVE][i] = p.move_count;
+        c.short_[COL_CHANGE_VIEW][i] = p.change_view_count;
+    }
+
+    for ( int f = 0; f < LONG_COLUMN_SIZE; ++f )
+    {
+        for ( int i = 0; i < PLAYER_SIZE; ++i )
+        {
+            c.value_[f][i] = ( static_cast< float >( static_cast< Int32 >( ntohl( c.long_[f][i] ) ) )
+                               / SHOWINFO_SCALE2F );
+        }
+    }
+
+    for ( int f = COL_BODY; f <= COL_VIEW_WIDTH; ++f )
+    {
+        for ( int i = 0; i < PLAYER_SIZE; ++i )
+        {
+            c.value_[f][i] *= RAD2DEGF;
+        }
+    }
+
+    for ( int f = 0; f < SHORT_COLUMN_SIZE; ++f )
+    {
+        for ( int i = 0; i < PLAYER_SIZE; ++i )
+        {
+            c.short_[f][i] = ntohs( c.short_[f][i] );
+        }
+    }
+
+    for ( int i = 0; i < PLAYER_SIZE; ++i )
+    {
+        PlayerT & p = to[i];
+
+        p.side_ = ( i < MAX_PLAYER ? 'l' : 'r' );
+        p.unum_ = static_cast< Int16 >( i < MAX_PLAYER ? i + 1 : i + 1 - MAX_PLAYER );
+        p.type_ = c.short_[COL_TYPE][i];
+        p.view_quality_ = c.short_[COL_VIEW_QUALITY][i] ? 'h' : 'l';
+        p.state_ = static_cast< Int32 >( c.short_[COL_MODE][i] );
+
+        p.x_ = c.value_[COL_X][i];
+        p.y_ = c.value_[COL_Y][i];
+        p.vx_ = c.value_[COL_VX][i];
+        p.vy_ = c.value_[COL_VY][i];
+        p.body_ = c.value_[COL_BODY][i];
+        p.neck_ = c.value_[COL_NECK][i];
+
+        if ( c.long_[COL_VIEW_WIDTH][i] != 0 )
+        {
+            p.view_width_ = c.value_[COL_VIEW_WIDTH][i];
+        }
+
+        if ( c.long_[COL_STAMINA][i] != 0
+             && c.long_[COL_EFFORT][i] != 0
+             && c.long_[COL_RECOVERY][i] != 0 )
+        {
+            p.stamina_ = c.value_[COL_STAMINA][i];
+            p.effort_ = c.value_[COL_EFFORT][i];
+            p.recovery_ = c.value_[COL_RECOVERY][i];
+        }
+
+        p.kick_count_ = c.short_[COL_KICK][i];
+        p.dash_count_ = c.short_[COL_DASH][i];
+        p.turn_count_ = c.short_[COL_TURN][i];
+        p.say_count_ = c.short_[COL_SAY][i];
+        p.turn_neck_count_ = c.short_[COL_TURN_NECK][i];
+        p.catch_count_ = c.short_[COL_CATCH][i];
+        p.move_count_ = c.short_[COL_MOVE][i];
+        p.change_view_count_ = c.short_[COL_CHANGE_VIEW][i];
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief convert all players of ShowInfoT in one pass.
+  the result is same as convert( PlayerT, player_t ) for each player
+  that has a valid side and uniform number.
+ */
+void
+encode_players( const PlayerT * from,
+                player_t * to )
+{
+    PlayerColumns c;
+
+    for ( int i = 0; i < PLAYER_SIZE; ++i )
+    {
+        const PlayerT & p = from[i];
+        c.value_[COL_X][i] = p.x_;
+        c.value_[COL_Y][i] = p.y_;
+        c.value_[COL_VX][i] = p.vx_;
+        c.value_[COL_VY][i] = p.vy_;
+        c.value_[COL_BODY][i] = p.body_ * DEG2RADF;
+        c.value_[COL_NECK][i] = p.neck_ * DEG2RADF;
+        c.value_[COL_VIEW_WIDTH][i] = p.view_width_ * DEG2RADF;
+        c.value_[COL_STAMINA][i] = p.stamina_;
+        c.value_[COL_EFFORT][i] = p.effort_;
+        c.value_[COL_RECOVERY][i] = p.recovery_;
+    }
+
+    for ( int f = 0; f < LONG_COLUMN_SIZE; ++f )
+    {
+        for ( int i = 0; i < PLAYER_SIZE; ++i )
+        {
+            c.long_[f][i] = htonl( static_cast< Int32 >( rintf( c.value_[f][i] * SHOWINFO_SCALE2F ) ) );
+        }
+    }
+
+    for ( int i = 0; i < PLAYER_SIZE; ++i )
+    {
+        const PlayerT & p = from[i];
+
+        int idx = p.unum_ - 1;
+        if ( p.side() == NEUTRAL ) continue;
+        if ( p.side() == RIGHT ) idx += MAX_PLAYER;
+        if ( idx < 0 || PLAYER_SIZE <= idx ) continue;
+
+        player_t & t = to[idx];
+        std::memset( &t, 0, sizeof( player_t ) );
+
+        t.mode = htons( static_cast< Int16 >( p.state_ ) );
+
+        if ( p.hasType() )
+        {
+            t.type = htons( p.type_ );
+        }
+
+        t.x = c.long_[COL_X][i];
+        t.y = c.long_[COL_Y][i];
+
+        if ( p.hasVelocity() )
+        {
+            t.deltax = c.long_[COL_VX][i];
+            t.deltay = c.long_[COL_VY][i];
+        }
+
+        t.body_angle = c.long_[COL_BODY][i];
+
+        if ( p.hasNeck() )
+        {
+            t.head_angle = c.long_[COL_NECK][i];
+        }
+
+        if ( p.hasView() )
+        {
+            t.view_width = c.long_[COL_VIEW_WIDTH][i];
+        }
+
+        t.view_quality = htons( p.highQuality() ? 1 : 0 );
+
+        if ( p.hasStamina() )
+        {
+            t.stamina = c.long_[COL_STAMINA][i];
+            t.effort = c.long_[COL_EFFORT][i];
+            t.recovery = c.long_[COL_RECOVERY][i];
+        }
+
+        if ( p.hasCommandCount() )
+        {
+            t.kick_count = htons( p.kick_count_ );
+            t.dash_count = htons( p.dash_count_ );
+            t.turn_count = htons( p.turn_count_ );
+            t.say_count = htons( p.say_count_ );
+            t.turn_neck_count = htons( p.turn_neck_count_ );
+            t.catch_count = htons( p.catch_count_ );
+            t.move_count = htons( p.move_count_ );
+            t.change_view_count = htons( p.change_view_count_ );
+        }
+    }
+}
+
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -687,15 +939,7 @@ convert( const char playmode,
     to.ball.deltay = hftonl( from.ball_.vx_ );
 
     // players
-    for ( int i = 0; i < MAX_PLAYER * 2; ++i )
-    {
-        int idx = from.player_[i].unum_ - 1;
-        if ( from.player_[i].side() == NEUTRAL ) continue;
-        if ( from.player_[i].side() == RIGHT ) idx += MAX_PLAYER;
-        if ( idx < 0 || MAX_PLAYER*2 <= idx ) continue;
-
-        convert( from.player_[i], to.pos[idx] );
-    }
+    encode_players( from.player_, to.pos );
 
     // time
     to.time = htons( static_cast< Int16 >( from.time_ ) );
@@ -716,15 +960,7 @@ convert( const ShowInfoT & from,
     to.ball.deltay = hftonl( from.ball_.vx_ );
 
     // players
-    for ( int i = 0; i < MAX_PLAYER * 2; ++i )
-    {
-        int idx = from.player_[i].unum_ - 1;
-        if ( from.player_[i].side() == NEUTRAL ) continue;
-        if ( from.player_[i].side() == RIGHT ) idx += MAX_PLAYER;
-        if ( idx < 0 || MAX_PLAYER*2 <= idx ) continue;
-
-        convert( from.player_[i], to.pos[idx] );
-    }
+    encode_players( from.player_, to.pos );
 
     // time
     to.time = htons( static_cast< Int16 >( from.time_ ) );
@@ -765,15 +1001,7 @@ convert( const showinfo_t2 & from,
     convert( from.ball, to.ball_ );
 
     // players
-    for ( int i = 0; i < MAX_PLAYER; ++i )
-    {
-        convert( LEFT, i + 1, from.pos[i], to.player_[i] );
-    }
-
-    for ( int i = MAX_PLAYER; i < MAX_PLAYER*2; ++i )
-    {
-        convert( RIGHT, i + 1 - MAX_PLAYER, from.pos[i], to.player_[i] );
-    }
+    decode_players( from.pos, to.player_ );
 
     // time
     to.time_ = static_cast< UInt32 >( ntohs( from.time ) );
@@ -792,15 +1020,7 @@ convert( const short_showinfo_t2 & from,
     convert( from.ball, to.ball_ );
 
     // players
-    for ( int i = 0; i < MAX_PLAYER; ++i )
-    {
-        convert( LEFT, i + 1, from.pos[i], to.player_[i] );
-    }
-
-    for ( int i = MAX_PLAYER; i < MAX_PLAYER*2; ++i )
-    {
-        convert( RIGHT, i + 1 - MAX_PLAYER, from.pos[i], to.player_[i] );
-    }
+    decode_players( from.pos, to.player_ );
 
     // time
     to.time_ = static_cast< UInt32 >( ntohs( from.time ) );
@@ -825,67 +1045,10 @@ convert( const std::string & from,
 PlayMode
 to_playmode_enum( const std::string & playmode )
 {
-    static const std::unordered_map< std::string, PlayMode > s_map = {
-        { "before_kick_off", PM_BeforeKickOff },
-        { "time_over", PM_TimeOver },
-        { "play_on", PM_PlayOn },
-        { "kick_off_l", PM_KickOff_Left },
-        { "kick_off_r", PM_KickOff_Right },
-        { "kick_in_l", PM_KickIn_Left },
-        { "kick_in_r", PM_KickIn_Right },
-        { "free_kick_l", PM_FreeKick_Left },
-        { "free_kick_r", PM_FreeKick_Right },
-        { "corner_kick_l", PM_CornerKick_Left },
-        { "corner_kick_r", PM_CornerKick_Right },
-        { "goal_kick_l", PM_GoalKick_Left },
-        { "goal_kick_r", PM_GoalKick_Right },
-        { "goal_l", PM_AfterGoal_Left },
-        { "goal_r", PM_AfterGoal_Right },
-        { "drop_ball", PM_Drop_Ball },
-        { "offside_l", PM_OffSide_Left },
-        { "offside_r", PM_OffSide_Right },
-        { "penalty_kick_l", PM_PK_Left },
-        { "penalty_kick_r", PM_PK_Right },
-        { "first_half_over", PM_FirstHalfOver },
-        { "pause", PM_Pause },
-        { "human_judge", PM_Human },
-        { "foul_charge_l", PM_Foul_Charge_Left },
-        { "foul_charge_r", PM_Foul_Charge_Right },
-        { "foul_push_l", PM_Foul_Push_Left },
-        { "foul_push_l", PM_Foul_Push_Right },
-        { "foul_multiple_attack_l", PM_Foul_MultipleAttacker_Left },
-        { "foul_multiple_attack_r", PM_Foul_MultipleAttacker_Right },
-        { "foul_ballout_l", PM_Foul_BallOut_Left },
-        { "foul_ballout_r", PM_Foul_BallOut_Right },
-        { "back_pass_l", PM_Back_Pass_Left },
-        { "back_pass_r", PM_Back_Pass_Right },
-        { "free_kick_fault_l", PM_Free_Kick_Fault_Left },
-        { "free_kick_fault_r", PM_Free_Kick_Fault_Right },
-        { "catch_fault_l", PM_CatchFault_Left },
-        { "catch_fault_r", PM_CatchFault_Right },
-        { "indirect_free_kick_l", PM_IndFreeKick_Left },
-        { "indirect_free_kick_r", PM_IndFreeKick_Right },
-        { "penalty_setup_l", PM_PenaltySetup_Left },
-        { "penalty_setup_r", PM_PenaltySetup_Right },
-        { "penalty_ready_l", PM_PenaltyReady_Left },
-        { "penalty_ready_r", PM_PenaltyReady_Right },
-        { "penalty_taken_l", PM_PenaltyTaken_Left },
-        { "penalty_taken_r", PM_PenaltyTaken_Right },
-        { "penalty_miss_l", PM_PenaltyMiss_Left },
-        { "penalty_miss_r", PM_PenaltyMiss_Right },
-        { "penalty_score_l", PM_PenaltyScore_Left },
-        { "penalty_score_r", PM_PenaltyScore_Right },
-        { "illegal_defense_l", PM_Illegal_Defense_Left },
-        { "illegal_defense_r", PM_Illegal_Defense_Right },
-    };
-
-    std::unordered_map< std::string, PlayMode >::const_iterator it = s_map.find( playmode );
-    if ( it == s_map.end() )
-    {
-        return PM_Null;
-    }
+    PlayModeInfo info;
+    PlayModeDecoder::decode( playmode.c_str(), playmode.length(), &info );
 
-    return it->second;
+    return info.pmode_;
 }
 
 /*-------------------------------------------------------------------*/
@@ -0,0 +1,360 @@
+// -*-c++-*-
+
+/*!
+  \file soccer_math_batch.h
+  \brief batch versions of the soccer_math.h functions Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_SOCCER_MATH_BATCH_H
+#define RCSC_SOCCER_MATH_BATCH_H
+
+#include <rcsc/soccer_math.h>
+
+#include <vector>
+#include <cstddef>
+
+namespace rcsc {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \class InertiaTable
+  \brief precomputed decay powers for the inertia_n_step_* functions.
+
+  The values are computed by the same expressions as the scalar functions,
+  so the results are identical to inertia_n_step_travel(),
+  inertia_n_step_point() and inertia_n_step_distance().
+  The steps over maxStep() are computed by std::pow().
+*/
+class InertiaTable {
+private:
+    double M_decay; //!< decay parameter
+    std::vector< double > M_decay_pow; //!< decay^step
+    std::vector< double > M_travel_rate; //!< (1 - decay^step) / (1 - decay)
+
+public:
+
+    /*!
+      \brief create the table
+      \param decay decay parameter
+      \param max_step the maximum step stored in the table
+     */
+    InertiaTable( const double decay,
+                  const int max_step );
+
+    /*!
+      \brief get the shared table. the instance is created at the first call
+      for each pair of decay and max_step, and is never destroyed.
+      \param decay decay parameter
+      \param max_step the maximum step stored in the table
+      \return const reference to the shared table
+     */
+    static
+    const InertiaTable & get( const double decay,
+                              const int max_step );
+
+    /*!
+      \brief get the decay parameter
+      \return decay value
+     */
+    double decay() const
+      {
+          return M_decay;
+      }
+
+    /*!
+      \brief get the maximum step stored in the table
+      \return step value
+     */
+    int maxStep() const
+      {
+          return static_cast< int >( M_decay_pow.size() ) - 1;
+      }
+
+    /*!
+      \brief get decay^step
+      \param n_step number of steps
+      \return power value
+     */
+    double decayPow( const int n_step ) const
+      {
+          return ( 0 <= n_step && n_step <= maxStep()
+                   ? M_decay_pow[n_step]
+                   : std::pow( M_decay, n_step ) );
+      }
+
+    /*!
+      \brief get (1 - decay^step) / (1 - decay)
+      \param n_step number of steps
+      \return travel rate
+     */
+    double travelRate( const int n_step ) const
+      {
+          return ( 0 <= n_step && n_step <= maxStep()
+                   ? M_travel_rate[n_step]
+                   : ( 1.0 - std::pow( M_decay, n_step ) ) / ( 1.0 - M_decay ) );
+      }
+
+    /*!
+      \brief same as inertia_n_step_point()
+      \param initial_pos object's first position
+      \param initial_vel object's first velocity
+      \param n_step number of total steps
+      \return coordinate of the reached point
+     */
+    Vector2D nStepPoint( const Vector2D & initial_pos,
+                         const Vector2D & initial_vel,
+                         const int n_step ) const
+      {
+          return Vector2D( initial_pos )
+              += Vector2D( initial_vel ) *= travelRate( n_step );
+      }
+
+    /*!
+      \brief same as inertia_n_step_distance()
+      \param initial_speed object's first speed
+      \param n_step number of total steps
+      \return total travel distance
+     */
+    double nStepDistance( const double initial_speed,
+                          const int n_step ) const
+      {
+          return initial_speed
+              * ( 1.0 - decayPow( n_step ) )
+              / ( 1.0 - M_decay );
+      }
+};
+
+//
+// batch functions.
+// each function processes n elements of the input arrays in a flat loop,
+// and gives the same values as the scalar function of soccer_math.h.
+// the output arrays may be same as the input arrays.
+//
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief batch version of inertia_n_step_point()
+  \param n number of elements
+  \param pos_x first x positions
+  \param pos_y first y positions
+  \param vel_x first x velocities
+  \param vel_y first y velocities
+  \param n_step number of total steps
+  \param decay object's decay parameter
+  \param result_x reached x positions
+  \param result_y reached y positions
+*/
+void
+inertia_n_step_point_batch( const std::size_t n,
+                            const double * pos_x,
+                            const double * pos_y,
+                            const double * vel_x,
+                            const double * vel_y,
+                            const int n_step,
+                            const double decay,
+                            double * result_x,
+                            double * result_y );
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief batch version of inertia_n_step_point() with the different steps
+  \param table decay power table
+  \param n number of elements
+  \param pos_x first x positions
+  \param pos_y first y positions
+  \param vel_x first x velocities
+  \param vel_y first y velocities
+  \param n_steps number of total steps of each element
+  \param result_x reached x positions
+  \param result_y reached y positions
+*/
+void
+inertia_n_step_point_batch( const InertiaTable & table,
+                            const std::size_t n,
+                            const double * pos_x,
+                            const double * pos_y,
+                            const double * vel_x,
+                            const double * vel_y,
+                            const int * n_steps,
+                            double * result_x,
+                            double * result_y );
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief batch version of inertia_n_step_distance()
+  \param n number of elements
+  \param initial_speed first speeds
+  \param n_step number of total steps
+  \param decay object's decay parameter
+  \param result total travel distances
+*/
+void
+inertia_n_step_distance_batch( const std::size_t n,
+                               const double * initial_speed,
+                               const int n_step,
+                               const double decay,
+                               double * result );
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief batch version of inertia_n_step_distance() with the different steps
+  \param table decay power table
+  \param n number of elements
+  \param initial_speed first speeds
+  \param n_steps number of total steps of each element
+  \param result total travel distances
+*/
+void
+inertia_n_step_distance_batch( const InertiaTable & table,
+                               const std::size_t n,
+                               const double * initial_speed,
+                               const int * n_steps,
+                               double * result );
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief batch version of inertia_final_point()
+  \param n number of elements
+  \param pos_x first x positions
+  \param pos_y first y positions
+  \param vel_x first x velocities
+  \param vel_y first y velocities
+  \param decay object's decay parameter
+  \param result_x final x positions
+  \param result_y final y positions
+*/
+void
+inertia_final_point_batch( const std::size_t n,
+                           const double * pos_x,
+                           const double * pos_y,
+                           const double * vel_x,
+                           const double * vel_y,
+                           const double decay,
+                           double * result_x,
+                           double * result_y );
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief batch version of final_speed()
+  \param n number of elements
+  \param dash_power dash powers
+  \param dprate player's dash power rate parameter
+  \param effort player's effort parameter
+  \param decay player's decay parameter
+  \param result achieved final speeds
+*/
+void
+final_speed_batch( const std::size_t n,
+                   const double * dash_power,
+                   const double dprate,
+                   const double effort,
+                   const double decay,
+                   double * result );
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief batch version of kick_rate()
+  \param n number of elements
+  \param dist distances from player to ball
+  \param dir_diff angle differences from player's body to ball
+  \param kprate player's kick power rate parameter
+  \param bsize ball radius
+  \param psize player radius
+  \param kmargin player's kickable area margin
+  \param result kick rates
+*/
+void
+kick_rate_batch( const std::size_t n,
+                 const double * dist,
+                 const double * dir_diff,
+                 const double kprate,
+                 const double bsize,
+                 const double psize,
+                 const double kmargin,
+                 double * result );
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief batch version of effective_turn()
+  \param n number of elements
+  \param turn_moment turn moments
+  \param speed player's speeds
+  \param inertiamoment player's inertia moment parameter
+  \param result actual turn angles
+*/
+void
+effective_turn_batch( const std::size_t n,
+                      const double * turn_moment,
+                      const double * speed,
+                      const double inertiamoment,
+                      double * result );
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief batch version of quantize_dist()
+  \param n number of elements
+  \param unq_dist actual distances
+  \param qstep server parameter
+  \param result quantized distances
+*/
+void
+quantize_dist_batch( const std::size_t n,
+                     const double * unq_dist,
+                     const double qstep,
+                     double * result );
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief batch version of unquantize_min()
+  \param n number of elements
+  \param dist quantized distances
+  \param qstep server parameter
+  \param result minimal distances
+*/
+void
+unquantize_min_batch( const std::size_t n,
+                      const double * dist,
+                      const double qstep,
+                      double * result );
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief batch version of unquantize_max()
+  \param n number of elements
+  \param dist quantized distances
+  \param qstep server parameter
+  \param result maximal distances
+*/
+void
+unquantize_max_batch( const std::size_t n,
+                      const double * dist,
+                      const double qstep,
+                      double * result );
+
+}
+
+#endif
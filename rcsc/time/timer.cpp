@@ -48,15 +48,15 @@ Timer::elapsed( const Type type ) const
 {
     switch ( type ) {
     case MSec:
-        return std::chrono::duration_cast< std::chrono::milliseconds >( std::chrono::system_clock::now() - M_start_time.timePoint() ).count();
+        return std::chrono::duration_cast< std::chrono::milliseconds >( TimeStamp::clock_type::now() - M_start_time.timePoint() ).count();
     case Sec:
-        return std::chrono::duration_cast< std::chrono::seconds >( std::chrono::system_clock::now() - M_start_time.timePoint() ).count();
+        return std::chrono::duration_cast< std::chrono::seconds >( TimeStamp::clock_type::now() - M_start_time.timePoint() ).count();
     case Min:
-        return std::chrono::duration_cast< std::chrono::minutes >( std::chrono::system_clock::now() - M_start_time.timePoint() ).count();
+        return std::chrono::duration_cast< std::chrono::minutes >( TimeStamp::clock_type::now() - M_start_time.timePoint() ).count();
     case Hour:
-        return std::chrono::duration_cast< std::chrono::hours >( std::chrono::system_clock::now() - M_start_time.timePoint() ).count();
+        return std::chrono::duration_cast< std::chrono::hours >( TimeStamp::clock_type::now() - M_start_time.timePoint() ).count();
     case Day:
-        return std::chrono::duration_cast< std::chrono::hours >( std::chrono::system_clock::now() - M_start_time.timePoint() ).count() / 24;
+        return std::chrono::duration_cast< std::chrono::hours >( TimeStamp::clock_type::now() - M_start_time.timePoint() ).count() / 24;
     default:
         break;
     }
@@ -71,7 +71,7 @@ Timer::elapsed( const Type type ) const
 double
 Timer::elapsedReal( const Type type ) const
 {
-    const double nano = std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::system_clock::now() - M_start_time.timePoint() ).count();
+    const double nano = std::chrono::duration_cast< std::chrono::nanoseconds >( TimeStamp::clock_type::now() - M_start_time.timePoint() ).count();
 
     switch ( type ) {
     case MSec:
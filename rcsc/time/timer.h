@@ -33,19 +33,24 @@
 #define RCSC_TIME_TIMER_H
 
 #include <chrono>
+#include <limits>
 #include <cstdint>
 
 namespace rcsc {
 
 /*!
   \class TimeStamp
-  \brief wrapper class of the system time point
+  \brief wrapper class of the monotonic time point
+
+  The time point is taken from std::chrono::steady_clock, so the elapsed
+  time is not affected by the adjustment of the system clock.
  */
 class TimeStamp {
 public:
-    typedef std::chrono::system_clock::time_point value_type;
+    typedef std::chrono::steady_clock clock_type;
+    typedef clock_type::time_point value_type;
 private:
-    std::chrono::system_clock::time_point M_time_point;
+    value_type M_time_point;
 
 public:
 
@@ -65,9 +70,19 @@ public:
         : M_time_point( tp )
       { }
 
+    /*!
+      \brief create the time stamp of the current time point
+      \return time stamp instance
+     */
+    static
+    TimeStamp now()
+      {
+          return TimeStamp( clock_type::now() );
+      }
+
     bool isValid() const
       {
-          return M_time_point.time_since_epoch().count() > 0;
+          return M_time_point.time_since_epoch().count() != 0;
       }
 
     /*!
@@ -75,7 +90,7 @@ public:
      */
     void setNow()
       {
-          M_time_point = std::chrono::system_clock::now();
+          M_time_point = clock_type::now();
       }
 
     /*!
@@ -96,6 +111,147 @@ public:
           return std::chrono::duration_cast< std::chrono::milliseconds >( this->timePoint() - other.timePoint() ).count();
       }
 
+    /*!
+      \brief get the nanoseconds value since the given time stamp
+      \return count value in the order of nanosecond
+     */
+    std::int64_t elapsedNSecSince( const TimeStamp & other ) const
+      {
+          return std::chrono::duration_cast< std::chrono::nanoseconds >( this->timePoint() - other.timePoint() ).count();
+      }
+
+    /*!
+      \brief get the microseconds value since the given time stamp
+      \return count value in the order of microsecond
+     */
+    std::int64_t elapsedUSecSince( const TimeStamp & other ) const
+      {
+          return std::chrono::duration_cast< std::chrono::microseconds >( this->timePoint() - other.timePoint() ).count();
+      }
+
+    /*!
+      \brief get the milliseconds value since the given time stamp with the sub-millisecond precision
+      \return floating point value in the order of millisecond
+     */
+    double elapsedRealSince( const TimeStamp & other ) const
+      {
+          return elapsedNSecSince( other ) * 1.0e-6;
+      }
+
+};
+
+/*!
+  \class Deadline
+  \brief monotonic time limit for the anytime computation.
+
+  The deadline is given as the budget from a start time stamp, usually the
+  arrival time of the message that triggered the decision. A default
+  constructed instance never expires.
+
+  expired() reads the clock at every call. poll() reads the clock only
+  once in POLL_STRIDE calls and latches the expired state, so it can be
+  called in the innermost loop of the search algorithms.
+ */
+class Deadline {
+public:
+    //! the number of poll() calls per clock read
+    static constexpr std::uint32_t POLL_STRIDE = 16;
+
+private:
+    TimeStamp::value_type M_end; //!< expiration time point
+    mutable std::uint32_t M_poll_count; //!< poll() call counter
+    mutable bool M_expired; //!< latched expiration state
+
+public:
+
+    /*!
+      \brief construct a deadline that never expires
+     */
+    Deadline()
+        : M_end( TimeStamp::value_type::max() ),
+          M_poll_count( 0 ),
+          M_expired( false )
+      { }
+
+    /*!
+      \brief construct with the start time and the budget
+      \param start start time stamp
+      \param budget_nsec budget in nanoseconds
+     */
+    Deadline( const TimeStamp & start,
+              const std::int64_t budget_nsec )
+        : M_end( start.timePoint() + std::chrono::nanoseconds( budget_nsec ) ),
+          M_poll_count( 0 ),
+          M_expired( false )
+      { }
+
+    /*!
+      \brief check if this deadline has a finite time limit
+      \return true if the time limit is set
+     */
+    bool isSet() const
+      {
+          return M_end != TimeStamp::value_type::max();
+      }
+
+    /*!
+      \brief get the expiration time point
+      \return time stamp instance
+     */
+    TimeStamp end() const
+      {
+          return TimeStamp( M_end );
+      }
+
+    /*!
+      \brief get the time left until the deadline
+      \return nanoseconds. negative value if already expired.
+     */
+    std::int64_t remainingNSec() const
+      {
+          if ( ! isSet() )
+          {
+              return std::numeric_limits< std::int64_t >::max();
+          }
+          return std::chrono::duration_cast< std::chrono::nanoseconds >( M_end - TimeStamp::clock_type::now() ).count();
+      }
+
+    /*!
+      \brief get the time left until the deadline
+      \return milliseconds with the sub-millisecond precision
+     */
+    double remainingMSec() const
+      {
+          return remainingNSec() * 1.0e-6;
+      }
+
+    /*!
+      \brief check the deadline by reading the clock
+      \return true if the deadline has passed
+     */
+    bool expired() const
+      {
+          if ( ! M_expired
+               && isSet()
+               && TimeStamp::clock_type::now() >= M_end )
+          {
+              M_expired = true;
+          }
+          return M_expired;
+      }
+
+    /*!
+      \brief cheap version of expired(). the clock is read once in POLL_STRIDE calls.
+      \return true if the deadline has passed at the last clock read
+     */
+    bool poll() const
+      {
+          if ( ++M_poll_count % POLL_STRIDE != 0 )
+          {
+              return M_expired;
+          }
+          return expired();
+      }
 };
 
 /*!
@@ -122,10 +278,10 @@ private:
 
 public:
     /*!
-      \brief construct with the current system clock time
+      \brief construct with the current monotonic clock time
      */
     Timer()
-        : M_start_time( std::chrono::system_clock::now() )
+        : M_start_time( TimeStamp::now() )
       { }
 
     /*!
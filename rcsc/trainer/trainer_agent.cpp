@@ -36,6 +36,7 @@
 #include "trainer_agent.h"
 
 #include "trainer_command.h"
+#include "trainer_command_batch.h"
 
 #include <rcsc/coach/coach_visual_sensor.h>
 
@@ -47,6 +48,8 @@
 #include <rcsc/common/player_param.h>
 #include <rcsc/common/player_type.h>
 #include <rcsc/common/audio_memory.h>
+#include <rcsc/common/trace_recorder.h>
+#include <rcsc/util/playmode_decoder.h>
 
 #include <rcsc/param/param_map.h>
 #include <rcsc/param/conf_file_parser.h>
@@ -54,6 +57,7 @@
 #include <rcsc/version.h>
 
 #include <sstream>
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 
@@ -87,6 +91,18 @@ struct TrainerAgent::Impl {
     //! visual sensor data
     CoachVisualSensor visual_;
 
+    //! if true, sendCommand() adds the command to command_batch_
+    bool batching_;
+
+    //! commands of the current decision
+    TrainerCommandBatch command_batch_;
+
+    //! function called at each decision
+    CycleCallback cycle_callback_;
+
+    //! time span recorder of the cycle phases
+    TraceRecorder trace_;
+
     /*!
       \brief initialize all members
     */
@@ -95,7 +111,8 @@ struct TrainerAgent::Impl {
           think_received_( false ),
           server_cycle_stopped_( true ),
           last_decision_time_( -1, 0 ),
-          current_time_( 0, 0 )
+          current_time_( 0, 0 ),
+          batching_( false )
       { }
 
     /*!
@@ -113,6 +130,11 @@ struct TrainerAgent::Impl {
     */
     bool openDebugLog();
 
+    /*!
+      \brief write the trace event file.
+     */
+    void writeTrace();
+
     /*!
       \brief set debug output flags to logger
      */
@@ -126,6 +148,12 @@ struct TrainerAgent::Impl {
     */
     void sendInitCommand();
 
+    /*!
+      \brief send the batched commands as one message
+      \return true if no command is batched or the message is sent
+    */
+    bool flushCommands();
+
     /*!
       \brief send client setting commands(compression...) to server
      */
@@ -247,6 +275,9 @@ struct TrainerAgent::Impl {
 void
 TrainerAgent::Impl::initDebug()
 {
+    trace_.setEnabled( agent_.config().trace(),
+                       static_cast< std::size_t >( std::max( 0, agent_.config().traceSize() ) ) );
+
     if ( ! agent_.config().offlineClientMode() )
     {
         if ( agent_.config().offlineLogging() )
@@ -332,6 +363,42 @@ TrainerAgent::Impl::openDebugLog()
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+TrainerAgent::Impl::writeTrace()
+{
+    if ( ! trace_.isEnabled() )
+    {
+        return;
+    }
+
+    trace_.setLabel( "trainer", agent_.config().teamName(), "trainer", 0 );
+
+    std::string filepath = agent_.config().logDir();
+
+    if ( ! filepath.empty() )
+    {
+        if ( *filepath.rbegin() != '/' )
+        {
+            filepath += '/';
+        }
+    }
+
+    filepath += agent_.config().teamName();
+    filepath += "-trainer";
+    filepath += agent_.config().traceExt();
+
+    if ( ! trace_.writeJSON( filepath ) )
+    {
+        std::cerr << agent_.config().teamName() << " trainer: "
+                  << " Failed to write the trace file [" << filepath << "]"
+                  << std::endl;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 TrainerAgent::Impl::setDebugFlags()
@@ -489,6 +556,16 @@ TrainerAgent::visualSensor() const
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+void
+TrainerAgent::setCycleCallback( CycleCallback callback )
+{
+    M_impl->cycle_callback_ = std::move( callback );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 bool
 TrainerAgent::initImpl( CmdLineParser & cmd_parser )
@@ -564,7 +641,15 @@ TrainerAgent::handleStart()
         return false;
     }
 
-    M_client->setIntervalMSec( config().intervalMSec() );
+    if ( config().synchTraining() )
+    {
+        // no idle wakeup. the timeout is used only to detect the server death.
+        M_client->setIntervalMSec( std::max( 1, config().serverWaitSeconds() ) * 1000 );
+    }
+    else
+    {
+        M_client->setIntervalMSec( config().intervalMSec() );
+    }
 
     M_impl->sendInitCommand();
 
@@ -587,9 +672,13 @@ TrainerAgent::handleMessage()
 
     // start parse process
 
-    while ( M_client->receiveMessage() > 0 )
     {
-        parse( M_client->message() );
+        TraceRecorder::Scope trace_receive( M_impl->trace_, "receive" );
+        while ( M_client->receiveMessage() > 0 )
+        {
+            TraceRecorder::Scope trace( M_impl->trace_, "parse" );
+            parse( M_client->message() );
+        }
     }
 
     if ( M_impl->think_received_ )
@@ -621,7 +710,7 @@ TrainerAgent::handleTimeout( const int /*timeout_count*/,
         return;
     }
 
-    if ( waited_msec > config().serverWaitSeconds() * 1000 )
+    if ( waited_msec >= config().serverWaitSeconds() * 1000 )
     {
         M_client->setServerAlive( false );
     }
@@ -648,6 +737,7 @@ TrainerAgent::finalize()
     {
         M_impl->sendByeCommand();
     }
+    M_impl->writeTrace();
     std::cerr << "trainer: finished."<< std::endl;
 }
 
@@ -768,6 +858,7 @@ TrainerAgent::Impl::analyzeCycle( const char * msg,
     }
 
     updateCurrentTime( cycle, by_see_global );
+    trace_.setCycle( current_time_.cycle() );
     return true;
 }
 
@@ -778,6 +869,7 @@ TrainerAgent::Impl::analyzeCycle( const char * msg,
 void
 TrainerAgent::Impl::analyzeSeeGlobal( const char * msg )
 {
+    TraceRecorder::Scope trace( trace_, "parse_see_global" );
     if ( ! analyzeCycle( msg, true ) )
     {
         return;
@@ -791,6 +883,7 @@ TrainerAgent::Impl::analyzeSeeGlobal( const char * msg )
     if ( visual_.time() == current_time_
          && agent_.world().time() != current_time_ )
     {
+        TraceRecorder::Scope trace( trace_, "update_after_see_global" );
         agent_.M_worldmodel.updateAfterSeeGlobal( visual_,
                                                   current_time_ );
     }
@@ -803,6 +896,7 @@ TrainerAgent::Impl::analyzeSeeGlobal( const char * msg )
 void
 TrainerAgent::Impl::analyzeHear( const char * msg )
 {
+    TraceRecorder::Scope trace( trace_, "parse_hear" );
     //std::cerr << "Trainer hear " << msg << std::endl;
     if ( ! analyzeCycle( msg, false ) )
     {
@@ -859,43 +953,28 @@ TrainerAgent::Impl::analyzeHearReferee( const char * msg )
         return;
     }
 
-    if ( ! game_mode_.update( mode, current_time_ ) )
-    {
-        if ( ! std::strncmp( mode, "yellow_card", std::strlen( "yellow_card" ) ) )
-        {
-            char side = '?';
-            int unum = Unum_Unknown;
-            if ( std::sscanf( mode, "yellow_card_%c_%d", &side, &unum ) != 2 )
-            {
-                std::cerr << agent_.config().teamName()
-                          << " coach: "
-                          << agent_.world().time()
-                          << " could not parse the yellow card message [" << msg << ']'
-                          << std::endl;
-            }
+    PlayModeInfo info;
+    PlayModeDecoder::decode( mode, &info );
 
-            agent_.M_worldmodel.setCard( ( side == 'l' ? LEFT : side == 'r' ? RIGHT : NEUTRAL ),
-                                         unum,
-                                         YELLOW );
-        }
-        else if ( ! std::strncmp( mode, "red_card", std::strlen( "red_card" ) ) )
+    if ( ! game_mode_.update( info, current_time_ ) )
+    {
+        if ( info.kind_ == PlayModeInfo::YELLOW_CARD
+             || info.kind_ == PlayModeInfo::RED_CARD )
         {
-            char side = '?';
-            int unum = Unum_Unknown;
-            if ( std::sscanf( mode, "red_card_%c_%d", &side, &unum ) != 2 )
+            if ( info.value_ < 0 )
             {
                 std::cerr << agent_.config().teamName()
                           << " coach: "
                           << agent_.world().time()
-                          << " could not parse the red card message [" << msg << ']'
+                          << " could not parse the card message [" << msg << ']'
                           << std::endl;
             }
 
-            agent_.M_worldmodel.setCard( ( side == 'l' ? LEFT : side == 'r' ? RIGHT : NEUTRAL ),
-                                         unum,
-                                         RED );
+            agent_.M_worldmodel.setCard( info.side_,
+                                         ( info.value_ < 0 ? Unum_Unknown : info.value_ ),
+                                         ( info.kind_ == PlayModeInfo::YELLOW_CARD ? YELLOW : RED ) );
         }
-        else if ( ! std::strncmp( mode, "training", std::strlen( "training" ) ) )
+        else if ( info.kind_ == PlayModeInfo::TRAINING )
         {
             // end keepaway (or some training) episode
             agent_.M_worldmodel.setTrainingTime( current_time_ );
@@ -1085,7 +1164,7 @@ TrainerAgent::Impl::analyzeOK( const char * msg )
                   << " recv " << msg << std::endl;
         analyzeTeamNames( msg );
     }
-    else
+    else if ( ! agent_.config().synchTraining() )
     {
         std::cout << "trainer: "
                   << current_time_
@@ -1149,6 +1228,21 @@ TrainerAgent::Impl::analyzeWarning( const char * msg )
 bool
 TrainerAgent::sendCommand( const TrainerCommand & com )
 {
+    if ( M_impl->batching_ )
+    {
+        if ( M_impl->command_batch_.add( com ) )
+        {
+            return true;
+        }
+
+        // no space in the batch. send the batched commands and retry.
+        M_impl->flushCommands();
+        if ( M_impl->command_batch_.add( com ) )
+        {
+            return true;
+        }
+    }
+
     std::ostringstream os;
     com.toCommandString( os );
 
@@ -1160,7 +1254,8 @@ TrainerAgent::sendCommand( const TrainerCommand & com )
 
     if ( M_client->sendMessage( str.c_str() ) > 0 )
     {
-        if ( str != "(done)" )
+        if ( ! config().synchTraining()
+             && str != "(done)" )
         {
             std::cout << "OK send command [" << str << "]" << std::endl;
         }
@@ -1174,6 +1269,35 @@ TrainerAgent::sendCommand( const TrainerCommand & com )
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+bool
+TrainerAgent::Impl::flushCommands()
+{
+    if ( command_batch_.empty() )
+    {
+        return true;
+    }
+
+    const char * str = command_batch_.data();
+    const bool result = ( agent_.M_client->sendMessage( str ) > 0 );
+
+    if ( ! result )
+    {
+        std::cout << "failed to send command [" << str << "]" << std::endl;
+    }
+    else if ( ! agent_.config().synchTraining()
+              && std::strcmp( str, "(done)" ) != 0 )
+    {
+        std::cout << "OK send command [" << str << "]" << std::endl;
+    }
+
+    command_batch_.clear();
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 TrainerAgent::Impl::sendInitCommand()
@@ -1405,20 +1529,41 @@ TrainerAgent::doSay( const std::string & msg )
 void
 TrainerAgent::action()
 {
+    TraceRecorder::Scope trace_action( M_impl->trace_, "action" );
+
+    M_impl->batching_ = ( config().batchCommands()
+                          || config().synchTraining() );
+
     if ( M_impl->last_decision_time_ != M_impl->current_time_ )
     {
-        M_worldmodel.updateJustBeforeDecision( M_impl->current_time_ );
+        {
+            TraceRecorder::Scope trace( M_impl->trace_, "update_before_decision" );
+            M_worldmodel.updateJustBeforeDecision( M_impl->current_time_ );
+        }
 
-        actionImpl();
+        {
+            TraceRecorder::Scope trace( M_impl->trace_, "action_impl" );
+            if ( M_impl->cycle_callback_ )
+            {
+                M_impl->cycle_callback_( M_worldmodel );
+            }
+
+            actionImpl();
+        }
         M_impl->last_decision_time_ = M_impl->current_time_;
     }
 
+    TraceRecorder::Scope trace_send( M_impl->trace_, "send" );
+
     if ( M_impl->think_received_ )
     {
         TrainerDoneCommand com;
         sendCommand( com );
         M_impl->think_received_ = true;
     }
+
+    M_impl->batching_ = false;
+    M_impl->flushCommands();
 }
 
 }
@@ -38,6 +38,7 @@
 #include <rcsc/geom/vector_2d.h>
 #include <rcsc/types.h>
 
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -52,6 +53,14 @@ class CoachVisualSensor;
 */
 class TrainerAgent
     : public SoccerAgent {
+public:
+
+    /*!
+      \brief callback function type called at each decision.
+      The argument refers to the agent's own world model. Nothing is copied.
+     */
+    typedef std::function< void( const CoachWorldModel & ) > CycleCallback;
+
 private:
 
     struct Impl; //!< pimpl idiom
@@ -115,6 +124,15 @@ public:
      */
     const CoachVisualSensor & visualSensor() const;
 
+    /*!
+      \brief set the function called at each decision, just before actionImpl().
+      \param callback callback function. an empty function removes the callback.
+
+      The commands sent by the callback are batched together with the
+      commands of actionImpl() if the command batching is enabled.
+     */
+    void setCycleCallback( CycleCallback callback );
+
     /*!
       \brief send check_ball command
       \return true if command is generated and sent
@@ -249,6 +267,10 @@ private:
       \brief send command string to the rcssserver
       \param com trainer command object
       \return true if command is sent
+
+      If the batch_commands option is on, the commands during action() are
+      added to one buffer and sent as one message at the end of action().
+      Then true means that the command is added to the buffer.
     */
     bool sendCommand( const TrainerCommand & com );
 
@@ -0,0 +1,95 @@
+// -*-c++-*-
+
+/*!
+  \file trainer_command_batch.cpp
+  \brief trainer command batch builder Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "trainer_command_batch.h"
+
+#include "trainer_command.h"
+
+namespace rcsc {
+
+constexpr std::size_t TrainerCommandBatch::BUFFER_SIZE;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+TrainerCommandBatch::TrainerCommandBatch()
+    : M_buffer( M_data, M_data + BUFFER_SIZE - 1 ),
+      M_stream( &M_buffer ),
+      M_count( 0 )
+{
+    M_data[0] = '\0';
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+TrainerCommandBatch::add( const TrainerCommand & com )
+{
+    const std::size_t old_size = M_buffer.size();
+
+    com.toCommandString( M_stream );
+
+    if ( ! M_stream
+         || M_buffer.size() == old_size )
+    {
+        // overflow or empty command. restore the previous state.
+        M_stream.clear();
+        M_buffer.seek( old_size );
+        M_data[old_size] = '\0';
+        return false;
+    }
+
+    M_data[M_buffer.size()] = '\0';
+    ++M_count;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+TrainerCommandBatch::clear()
+{
+    M_stream.clear();
+    M_buffer.seek( 0 );
+    M_data[0] = '\0';
+    M_count = 0;
+}
+
+}
@@ -0,0 +1,156 @@
+// -*-c++-*-
+
+/*!
+  \file trainer_command_batch.h
+  \brief trainer command batch builder Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_TRAINER_COMMAND_BATCH_H
+#define RCSC_TRAINER_COMMAND_BATCH_H
+
+#include <rcsc/common/abstract_client.h>
+
+#include <streambuf>
+#include <ostream>
+#include <cstddef>
+
+namespace rcsc {
+
+class TrainerCommand;
+
+/*!
+  \class TrainerCommandBatch
+  \brief builder that packs several trainer commands into one send buffer.
+
+  The commands are written into a fixed buffer of the server's message size
+  through one reused output stream, so adding a command never allocates
+  memory. A command that does not fit in the remaining space is rejected and
+  the buffer is left unchanged.
+*/
+class TrainerCommandBatch {
+public:
+
+    //! buffer size including the terminating null character
+    static constexpr std::size_t BUFFER_SIZE = AbstractClient::MAX_MESG;
+
+private:
+
+    /*!
+      \class Buffer
+      \brief stream buffer over the fixed character array. it never grows.
+    */
+    class Buffer
+        : public std::streambuf {
+    public:
+        Buffer( char * first,
+                char * last )
+          {
+              setp( first, last );
+          }
+
+        //! set the write position
+        void seek( const std::size_t pos )
+          {
+              setp( pbase(), epptr() );
+              pbump( static_cast< int >( pos ) );
+          }
+
+        //! get the written size
+        std::size_t size() const
+          {
+              return static_cast< std::size_t >( pptr() - pbase() );
+          }
+    };
+
+    char M_data[BUFFER_SIZE]; //!< command string. always null terminated.
+    Buffer M_buffer; //!< stream buffer over M_data
+    std::ostream M_stream; //!< output stream that writes to M_buffer
+    int M_count; //!< the number of added commands
+
+    // not used
+    TrainerCommandBatch( const TrainerCommandBatch & ) = delete;
+    TrainerCommandBatch & operator=( const TrainerCommandBatch & ) = delete;
+
+public:
+
+    /*!
+      \brief create an empty batch
+    */
+    TrainerCommandBatch();
+
+    /*!
+      \brief append the command string
+      \param com trainer command
+      \return false if the command does not fit in the remaining buffer
+    */
+    bool add( const TrainerCommand & com );
+
+    /*!
+      \brief remove all commands
+    */
+    void clear();
+
+    /*!
+      \brief check if no command is added
+      \return checked result
+    */
+    bool empty() const
+      {
+          return M_count == 0;
+      }
+
+    /*!
+      \brief get the number of added commands
+      \return command count
+    */
+    int count() const
+      {
+          return M_count;
+      }
+
+    /*!
+      \brief get the length of the command string
+      \return byte size without the terminating null character
+    */
+    std::size_t size() const
+      {
+          return M_buffer.size();
+      }
+
+    /*!
+      \brief get the command string
+      \return null terminated string of all added commands
+    */
+    const char * data() const
+      {
+          return M_data;
+      }
+};
+
+}
+
+#endif
@@ -83,6 +83,9 @@ TrainerConfig::setDefaultParam()
     M_use_eye = true;
     M_use_ear = false;
 
+    M_batch_commands = false;
+    M_synch_training = false;
+
     //
     // debug
     //
@@ -125,6 +128,10 @@ TrainerConfig::setDefaultParam()
     M_debug_communication = false;
     M_debug_analyzer = false;
     M_debug_action_chain = false;
+
+    M_trace = false;
+    M_trace_ext = ".trace.json";
+    M_trace_size = 65536;
 }
 
 /*-------------------------------------------------------------------*/
@@ -149,6 +156,9 @@ TrainerConfig::createParamMap()
         ( "use_eye", "", &M_use_eye )
         ( "use_ear", "", &M_use_ear )
 
+        ( "batch_commands", "", BoolSwitch( &M_batch_commands ) )
+        ( "synch_training", "", BoolSwitch( &M_synch_training ) )
+
         ( "debug", "", BoolSwitch( &M_debug ) )
         ( "log_dir", "", &M_log_dir )
 
@@ -179,6 +189,12 @@ TrainerConfig::createParamMap()
         ( "debug_communication", "", BoolSwitch( &M_debug_communication ) )
         ( "debug_analyzer", "", BoolSwitch( &M_debug_analyzer ) )
         ( "debug_action_chain", "", BoolSwitch( &M_debug_action_chain ) )
+
+        ( "trace", "", BoolSwitch( &M_trace ),
+          "record the time spans of each cycle phase and write them in the Chrome trace format at the end of the match." )
+        ( "trace_ext", "", &M_trace_ext )
+        ( "trace_size", "", &M_trace_size,
+          "the number of the latest trace events kept in memory." )
         ;
 }
 
@@ -73,6 +73,12 @@ private:
     //! if true trainer will send (ear on) command
     bool M_use_ear;
 
+    //! if true the commands in one decision are sent as one message
+    bool M_batch_commands;
+
+    //! if true the agent is tuned for the synch mode training loop
+    bool M_synch_training;
+
 
     //
     // debug
@@ -123,6 +129,14 @@ private:
     bool M_debug_analyzer; //!< debug level flag
     bool M_debug_action_chain; //!< debug level flag
 
+    //
+    // trace
+    //
+
+    bool M_trace; //!< if true, the time spans of each cycle phase are recorded.
+    std::string M_trace_ext; //!< the extension string of trace file
+    int M_trace_size; //!< the number of the latest trace events kept in memory
+
 public:
 
     /*!
@@ -217,6 +231,22 @@ public:
      */
     bool useEar() const { return M_use_eye; }
 
+    /*!
+      \brief get the command batching switch
+      \return true if the commands in one decision are sent as one message
+     */
+    bool batchCommands() const { return M_batch_commands; }
+
+    /*!
+      \brief get the synch mode training switch.
+      \return true if the agent is tuned for the synch mode training loop
+
+      In this mode the client waits for the server message without the idle
+      timeout, the commands are always batched and the per-command console
+      output is disabled.
+     */
+    bool synchTraining() const { return M_synch_training; }
+
     //
     // debug
     //
@@ -392,6 +422,28 @@ public:
      */
     bool debugActionChain() const { return M_debug_action_chain; }
 
+    //
+    // trace
+    //
+
+    /*!
+      \brief get the switch for the trace recorder
+      \return switch value for the trace recorder
+     */
+    bool trace() const { return M_trace; }
+
+    /*!
+      \brief get the trace file extention string.
+      \return the trace file extention string.
+     */
+    const std::string & traceExt() const { return M_trace_ext; }
+
+    /*!
+      \brief get the number of the trace events kept in memory.
+      \return the ring buffer size of the trace recorder.
+     */
+    int traceSize() const { return M_trace_size; }
+
 };
 
 }
@@ -0,0 +1,241 @@
+// -*-c++-*-
+
+/*!
+  \file trainer_orchestrator.cpp
+  \brief episode scheduler for the trainers of several servers Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "trainer_orchestrator.h"
+
+#include "trainer_agent.h"
+
+#include <rcsc/common/multi_agent_client.h>
+#include <rcsc/common/online_client.h>
+
+#include <iostream>
+
+namespace rcsc {
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+TrainerOrchestrator::TrainerOrchestrator()
+    : M_next_episode_id( 0 ),
+      M_finished_count( 0 ),
+      M_stop_when_done( true )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+TrainerOrchestrator::~TrainerOrchestrator()
+{
+    for ( Slot & s : M_slots )
+    {
+        s.trainer_->setCycleCallback( TrainerAgent::CycleCallback() );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+TrainerOrchestrator::add( std::shared_ptr< TrainerAgent > trainer )
+{
+    if ( ! trainer )
+    {
+        return false;
+    }
+
+    std::shared_ptr< OnlineClient > client
+        = std::dynamic_pointer_cast< OnlineClient >( trainer->createConsoleClient() );
+    if ( ! client )
+    {
+        std::cerr << "(TrainerOrchestrator::add) ***ERROR*** the trainer is not in the online mode."
+                  << std::endl;
+        return false;
+    }
+
+    trainer->setClient( client );
+
+    const std::size_t index = M_slots.size();
+    trainer->setCycleCallback( [this, index]( const CoachWorldModel & )
+                               {
+                                   handleCycle( index );
+                               } );
+
+    M_slots.push_back( Slot{ trainer, client, TrainerEpisode::Ptr(), 0, GameTime( -1, 0 ) } );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::size_t
+TrainerOrchestrator::schedule( TrainerEpisode::Ptr episode )
+{
+    std::lock_guard< std::mutex > lock( M_mutex );
+
+    const std::size_t id = M_next_episode_id++;
+    M_queue.emplace_back( id, episode );
+    return id;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::size_t
+TrainerOrchestrator::pendingCount() const
+{
+    std::lock_guard< std::mutex > lock( M_mutex );
+    return M_queue.size();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::size_t
+TrainerOrchestrator::run()
+{
+    MultiAgentClient multi_client;
+
+    for ( std::size_t i = 0; i < M_slots.size(); ++i )
+    {
+        if ( ! multi_client.add( M_slots[i].trainer_.get(), M_slots[i].client_ ) )
+        {
+            std::cerr << "(TrainerOrchestrator::run) ***ERROR*** failed to register the trainer "
+                      << i << std::endl;
+            return 0;
+        }
+    }
+
+    multi_client.run();
+
+    std::lock_guard< std::mutex > lock( M_mutex );
+    return M_finished_count;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::vector< TrainerOrchestrator::Result >
+TrainerOrchestrator::takeResults()
+{
+    std::vector< Result > results;
+
+    std::lock_guard< std::mutex > lock( M_mutex );
+    results.swap( M_results );
+    return results;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TrainerOrchestrator::handleCycle( const std::size_t index )
+{
+    Slot & slot = M_slots[index];
+    TrainerAgent & trainer = *slot.trainer_;
+
+    if ( slot.episode_ )
+    {
+        if ( ! slot.episode_->update( trainer ) )
+        {
+            return;
+        }
+
+        std::lock_guard< std::mutex > lock( M_mutex );
+        M_results.push_back( Result{ slot.episode_id_,
+                                     index,
+                                     slot.start_time_,
+                                     trainer.world().time(),
+                                     slot.episode_->result() } );
+        ++M_finished_count;
+        slot.episode_.reset();
+    }
+
+    {
+        std::lock_guard< std::mutex > lock( M_mutex );
+        if ( ! M_queue.empty() )
+        {
+            slot.episode_id_ = M_queue.front().first;
+            slot.episode_ = M_queue.front().second;
+            M_queue.pop_front();
+        }
+    }
+
+    if ( slot.episode_ )
+    {
+        slot.start_time_ = trainer.world().time();
+        slot.episode_->start( trainer );
+        return;
+    }
+
+    if ( ! M_stop_when_done )
+    {
+        return;
+    }
+
+    // close all connections when no episode remains
+    for ( const Slot & s : M_slots )
+    {
+        if ( s.episode_ )
+        {
+            return;
+        }
+    }
+
+    {
+        std::lock_guard< std::mutex > lock( M_mutex );
+        if ( ! M_queue.empty() )
+        {
+            return;
+        }
+    }
+
+    for ( Slot & s : M_slots )
+    {
+        s.client_->setServerAlive( false );
+    }
+}
+
+}
@@ -0,0 +1,236 @@
+// -*-c++-*-
+
+/*!
+  \file trainer_orchestrator.h
+  \brief episode scheduler for the trainers of several servers Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_TRAINER_TRAINER_ORCHESTRATOR_H
+#define RCSC_TRAINER_TRAINER_ORCHESTRATOR_H
+
+#include <rcsc/game_time.h>
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace rcsc {
+
+class OnlineClient;
+class TrainerAgent;
+
+/*!
+  \class TrainerEpisode
+  \brief abstract episode script executed by one of the trainers of TrainerOrchestrator.
+
+  All methods are called in the trainer's decision, just before its
+  actionImpl(), so the script can send the trainer commands and refer the
+  trainer's world model.
+*/
+class TrainerEpisode {
+public:
+    //! smart pointer type
+    typedef std::shared_ptr< TrainerEpisode > Ptr;
+
+    /*!
+      \brief virtual destructor
+    */
+    virtual
+    ~TrainerEpisode()
+      { }
+
+    /*!
+      \brief called at the first cycle on the assigned server. e.g. move the ball and players.
+      \param trainer the trainer connected to the assigned server
+    */
+    virtual
+    void start( TrainerAgent & trainer ) = 0;
+
+    /*!
+      \brief called at each following cycle
+      \param trainer the trainer connected to the assigned server
+      \return true if the episode has finished
+    */
+    virtual
+    bool update( TrainerAgent & trainer ) = 0;
+
+    /*!
+      \brief get the result of the finished episode
+      \return result string stored in the result buffer
+    */
+    virtual
+    std::string result() const = 0;
+};
+
+/*!
+  \class TrainerOrchestrator
+  \brief runs the episodes on several servers by the trainers in one process.
+
+  Each registered trainer is connected to its own server (host and port
+  of its TrainerConfig), and all connections are multiplexed by
+  MultiAgentClient in the calling thread. The scheduled episodes are
+  assigned to the idle trainers in the order of schedule(), and their
+  results are collected in one result buffer.
+
+  \code
+  rcsc::TrainerOrchestrator orchestrator;
+  for ( int i = 0; i < n_servers; ++i )
+  {
+      std::shared_ptr< MyTrainer > t( new MyTrainer() );
+      if ( ! t->init( cmd_parser_for_server_i ) ) return 1;
+      orchestrator.add( t );
+  }
+  for ( int i = 0; i < n_episodes; ++i ) orchestrator.schedule( TrainerEpisode::Ptr( new MyEpisode() ) );
+  orchestrator.run();
+  for ( const TrainerOrchestrator::Result & r : orchestrator.takeResults() ) { ... }
+  \endcode
+
+  schedule(), takeResults() and pendingCount() can be called from the other
+  threads while run() is executed.
+  This class is available only if MultiAgentClient is available.
+*/
+class TrainerOrchestrator {
+public:
+
+    /*!
+      \struct Result
+      \brief result of the finished episode
+    */
+    struct Result {
+        std::size_t episode_id_; //!< the id returned by schedule()
+        std::size_t server_index_; //!< the index of the trainer that executed the episode
+        GameTime start_time_; //!< the game time when the episode started
+        GameTime end_time_; //!< the game time when the episode finished
+        std::string result_; //!< TrainerEpisode::result()
+    };
+
+private:
+
+    /*!
+      \struct Slot
+      \brief a trainer and its current episode
+    */
+    struct Slot {
+        std::shared_ptr< TrainerAgent > trainer_; //!< trainer instance
+        std::shared_ptr< OnlineClient > client_; //!< connection of the trainer
+        TrainerEpisode::Ptr episode_; //!< current episode. null if idle.
+        std::size_t episode_id_; //!< current episode id
+        GameTime start_time_; //!< current episode start time
+    };
+
+    std::vector< Slot > M_slots; //!< registered trainers
+
+    mutable std::mutex M_mutex; //!< lock for the queue and the results
+    std::deque< std::pair< std::size_t, TrainerEpisode::Ptr > > M_queue; //!< scheduled episodes
+    std::vector< Result > M_results; //!< finished episode results
+    std::size_t M_next_episode_id; //!< id of the next scheduled episode
+    std::size_t M_finished_count; //!< the number of finished episodes
+
+    bool M_stop_when_done; //!< if true, run() returns when all episodes have finished
+
+    // not used
+    TrainerOrchestrator( const TrainerOrchestrator & ) = delete;
+    TrainerOrchestrator & operator=( const TrainerOrchestrator & ) = delete;
+
+public:
+
+    /*!
+      \brief construct an empty orchestrator
+    */
+    TrainerOrchestrator();
+
+    /*!
+      \brief destructor
+    */
+    ~TrainerOrchestrator();
+
+    /*!
+      \brief register the initialized trainer. the cycle callback of the trainer is replaced.
+      \param trainer trainer initialized by init(). the offline mode is not supported.
+      \return true if successfully registered
+    */
+    bool add( std::shared_ptr< TrainerAgent > trainer );
+
+    /*!
+      \brief get the number of registered trainers
+      \return the number of trainers
+    */
+    std::size_t size() const
+      {
+          return M_slots.size();
+      }
+
+    /*!
+      \brief append the episode to the queue
+      \param episode episode script
+      \return episode id stored in the result
+    */
+    std::size_t schedule( TrainerEpisode::Ptr episode );
+
+    /*!
+      \brief get the number of episodes that have not been started
+      \return the number of queued episodes
+    */
+    std::size_t pendingCount() const;
+
+    /*!
+      \brief set the termination policy of run()
+      \param on if true, all connections are closed when the queue becomes empty and all episodes have finished.
+    */
+    void setStopWhenDone( const bool on )
+      {
+          M_stop_when_done = on;
+      }
+
+    /*!
+      \brief connect all trainers and execute the episodes until all servers are closed.
+      \return the number of finished episodes
+    */
+    std::size_t run();
+
+    /*!
+      \brief move out the results collected so far
+      \return finished episode results
+    */
+    std::vector< Result > takeResults();
+
+private:
+
+    /*!
+      \brief update the episode of the trainer. called in the trainer's decision.
+      \param index slot index
+    */
+    void handleCycle( const std::size_t index );
+};
+
+}
+
+#endif
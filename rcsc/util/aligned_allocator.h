@@ -0,0 +1,108 @@
+// -*-c++-*-
+
+/*!
+  \file aligned_allocator.h
+  \brief allocator for over-aligned arrays Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_UTIL_ALIGNED_ALLOCATOR_H
+#define RCSC_UTIL_ALIGNED_ALLOCATOR_H
+
+#include <new>
+#include <cstddef>
+
+namespace rcsc {
+
+/*!
+  \class AlignedAllocator
+  \brief stateless allocator that aligns the array to the Align byte boundary.
+
+  std::vector< double, AlignedAllocator< double, 32 > > puts the first element
+  on the 32 byte boundary, so that the vectorized loops can use the aligned
+  loads for the whole SIMD register width.
+*/
+template < typename T, std::size_t Align >
+class AlignedAllocator {
+public:
+    typedef T value_type;
+
+    static_assert( Align >= alignof( T ) && ( Align & ( Align - 1 ) ) == 0,
+                   "Align must be a power of 2 not less than alignof(T)" );
+
+    template < typename U >
+    struct rebind {
+        typedef AlignedAllocator< U, Align > other;
+    };
+
+    AlignedAllocator() noexcept
+      { }
+
+    template < typename U >
+    AlignedAllocator( const AlignedAllocator< U, Align > & ) noexcept
+      { }
+
+    /*!
+      \brief allocate the memory for n elements
+      \param n number of elements
+      \return pointer to the uninitialized aligned memory
+    */
+    T * allocate( const std::size_t n )
+      {
+          return static_cast< T * >( ::operator new( n * sizeof( T ), std::align_val_t( Align ) ) );
+      }
+
+    /*!
+      \brief release the memory
+      \param p pointer returned by allocate()
+    */
+    void deallocate( T * p,
+                     const std::size_t ) noexcept
+      {
+          ::operator delete( p, std::align_val_t( Align ) );
+      }
+
+    // defined as hidden friends not to hide the global comparison operators
+    // (e.g. for Vector2D) from the lookup inside namespace rcsc.
+
+    friend
+    bool operator==( const AlignedAllocator &,
+                     const AlignedAllocator & ) noexcept
+      {
+          return true;
+      }
+
+    friend
+    bool operator!=( const AlignedAllocator &,
+                     const AlignedAllocator & ) noexcept
+      {
+          return false;
+      }
+};
+
+}
+
+#endif
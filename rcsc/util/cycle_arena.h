@@ -0,0 +1,217 @@
+// -*-c++-*-
+
+/*!
+  \file cycle_arena.h
+  \brief per-cycle monotonic scratch memory arena Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_UTIL_CYCLE_ARENA_H
+#define RCSC_UTIL_CYCLE_ARENA_H
+
+#include <rcsc/util/runtime_tuning.h>
+
+#include <memory_resource>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace rcsc {
+
+/*!
+  \class CycleArena
+  \brief monotonic scratch memory released all at once at the start of each decision.
+
+  The memory is taken from the initial buffer by bumping a pointer, and
+  deallocation is a no-op. When a cycle needs more than the initial
+  buffer, the overflow is taken from the upstream resource, and the
+  initial buffer is enlarged at the next reset(), so the steady state
+  cycles do not call malloc at all.
+
+  The containers using resource() must not live beyond the next reset().
+*/
+class CycleArena {
+private:
+
+    /*!
+      \class Upstream
+      \brief upstream resource that counts the overflow bytes
+    */
+    class Upstream
+        : public std::pmr::memory_resource {
+    private:
+        std::pmr::memory_resource * M_base;
+        std::size_t M_bytes;
+    public:
+        Upstream()
+            : M_base( std::pmr::new_delete_resource() ),
+              M_bytes( 0 )
+          { }
+
+        std::size_t bytes() const { return M_bytes; }
+        void resetBytes() { M_bytes = 0; }
+
+    protected:
+        void * do_allocate( std::size_t bytes,
+                            std::size_t alignment ) override
+          {
+              M_bytes += bytes;
+              return M_base->allocate( bytes, alignment );
+          }
+
+        void do_deallocate( void * p,
+                            std::size_t bytes,
+                            std::size_t alignment ) override
+          {
+              M_base->deallocate( p, bytes, alignment );
+          }
+
+        bool do_is_equal( const std::pmr::memory_resource & other ) const noexcept override
+          {
+              return this == &other;
+          }
+    };
+
+    //! the upper limit of the initial buffer size
+    static constexpr std::size_t MAX_BUFFER_SIZE = 64 * 1024 * 1024;
+
+    Upstream M_upstream; //!< overflow memory source
+    LargeBuffer M_buffer; //!< initial buffer. backed by the huge pages if enabled.
+    std::unique_ptr< std::pmr::monotonic_buffer_resource > M_resource;
+
+    std::uint64_t M_generation; //!< incremented by each reset()
+    std::size_t M_peak_overflow; //!< the maximum overflow bytes in a cycle
+
+    // not used
+    CycleArena( const CycleArena & ) = delete;
+    CycleArena & operator=( const CycleArena & ) = delete;
+
+public:
+
+    /*!
+      \brief allocate the initial buffer
+      \param initial_size initial buffer size in bytes
+    */
+    explicit
+    CycleArena( const std::size_t initial_size = 256 * 1024 )
+        : M_buffer( initial_size > 0 ? initial_size : 1 ),
+          M_resource( new std::pmr::monotonic_buffer_resource( M_buffer.get(), M_buffer.size(), &M_upstream ) ),
+          M_generation( 0 ),
+          M_peak_overflow( 0 )
+      { }
+
+    /*!
+      \brief release all memory allocated in the previous cycle.
+      The initial buffer is enlarged if the previous cycle overflowed.
+    */
+    void reset()
+      {
+          ++M_generation;
+
+          const std::size_t overflow = M_upstream.bytes();
+          M_upstream.resetBytes();
+
+          if ( overflow == 0 )
+          {
+              M_resource->release();
+              return;
+          }
+
+          if ( overflow > M_peak_overflow )
+          {
+              M_peak_overflow = overflow;
+          }
+
+          M_resource.reset();
+
+          std::size_t new_size = M_buffer.size() + overflow;
+          new_size += new_size / 2;
+          if ( new_size > MAX_BUFFER_SIZE ) new_size = MAX_BUFFER_SIZE;
+
+          if ( new_size > M_buffer.size() )
+          {
+              M_buffer.reset( new_size );
+          }
+
+          M_resource.reset( new std::pmr::monotonic_buffer_resource( M_buffer.get(), M_buffer.size(), &M_upstream ) );
+      }
+
+    /*!
+      \brief get the memory resource for the scratch containers
+      \return pointer to the monotonic resource
+    */
+    std::pmr::memory_resource * resource() const
+      {
+          return M_resource.get();
+      }
+
+    /*!
+      \brief get the reset count. used to check that a container does not outlive the cycle.
+      \return generation number
+    */
+    std::uint64_t generation() const
+      {
+          return M_generation;
+      }
+
+    /*!
+      \brief get the current initial buffer size
+      \return buffer size in bytes
+    */
+    std::size_t bufferSize() const
+      {
+          return M_buffer.size();
+      }
+
+    /*!
+      \brief get the bytes taken from the upstream in the current cycle
+      \return overflow bytes
+    */
+    std::size_t overflowBytes() const
+      {
+          return M_upstream.bytes();
+      }
+
+    /*!
+      \brief get the maximum overflow bytes in a cycle so far
+      \return overflow bytes
+    */
+    std::size_t peakOverflowBytes() const
+      {
+          return M_peak_overflow;
+      }
+};
+
+/*!
+  \brief vector type allocated in the CycleArena
+*/
+template < typename T >
+using ScratchVector = std::pmr::vector< T >;
+
+}
+
+#endif
@@ -35,121 +35,9 @@
 
 #include "../game_mode.h"
 
-#include <iostream>
-#include <unordered_map>
-#include <cstdio>
-
-namespace {
-
-typedef std::unordered_map< std::string, rcsc::GameMode::Pair > PlayModeMap;
-
-/*!
-  \class MapHolder
-  \brief interface to the playmode map. singleton map holder
-*/
-class MapHolder {
-private:
-    //! key: playmode string, value: playmode type
-    PlayModeMap M_playmode_map;
-
-public:
-
-    /*!
-      \brief create playmode map.
-    */
-    MapHolder();
+#include "playmode_decoder.h"
 
-    /*!
-      \brief singleton interface. get playmode map
-      \return const reference to the playmode map
-    */
-    const PlayModeMap & get() const
-      {
-          return M_playmode_map;
-      }
-
-};
-
-/*-------------------------------------------------------------------*/
-/*!
-
-*/
-MapHolder::MapHolder()
-{
-    using namespace rcsc;
-
-    M_playmode_map["before_kick_off"] = std::make_pair( GameMode::BeforeKickOff, NEUTRAL );
-    M_playmode_map["time_over"] = std::make_pair( GameMode::TimeOver, NEUTRAL );
-    M_playmode_map["play_on"] = std::make_pair( GameMode::PlayOn, NEUTRAL );
-    M_playmode_map["kick_off_l"] = std::make_pair( GameMode::KickOff_, LEFT );
-    M_playmode_map["kick_off_r"] = std::make_pair( GameMode::KickOff_, RIGHT );
-    M_playmode_map["kick_in_l"] = std::make_pair( GameMode::KickIn_, LEFT );
-    M_playmode_map["kick_in_r"] = std::make_pair( GameMode::KickIn_, RIGHT );
-    M_playmode_map["free_kick_l"] = std::make_pair( GameMode::FreeKick_, LEFT );
-    M_playmode_map["free_kick_r"] = std::make_pair( GameMode::FreeKick_, RIGHT );
-    M_playmode_map["corner_kick_l"] = std::make_pair( GameMode::CornerKick_, LEFT );
-    M_playmode_map["corner_kick_r"] = std::make_pair( GameMode::CornerKick_, RIGHT );
-    M_playmode_map["goal_kick_l"] = std::make_pair( GameMode::GoalKick_, LEFT );
-    M_playmode_map["goal_kick_r"] = std::make_pair( GameMode::GoalKick_, RIGHT );
-    // "goal_l"
-    // "goal_r"
-    M_playmode_map["drop_ball"] = std::make_pair( GameMode::PlayOn, NEUTRAL );
-    M_playmode_map["offside_l"] = std::make_pair( GameMode::OffSide_, LEFT );
-    M_playmode_map["offside_r"] = std::make_pair( GameMode::OffSide_, RIGHT );
-    M_playmode_map["penalty_kick_l"]  = std::make_pair( GameMode::PenaltyKick_, LEFT );
-    M_playmode_map["penalty_kick_r"]  = std::make_pair( GameMode::PenaltyKick_, RIGHT );
-    M_playmode_map["first_half_over"] = std::make_pair( GameMode::FirstHalfOver, NEUTRAL );
-    M_playmode_map["pause"]           = std::make_pair( GameMode::Pause, NEUTRAL );
-    M_playmode_map["human_judge"]     = std::make_pair( GameMode::Human, NEUTRAL );
-    M_playmode_map["foul_charge_l"]   = std::make_pair( GameMode::FoulCharge_, LEFT );
-    M_playmode_map["foul_charge_r"]   = std::make_pair( GameMode::FoulCharge_, RIGHT );
-    M_playmode_map["foul_push_l"]     = std::make_pair( GameMode::FoulPush_,    LEFT );
-    M_playmode_map["foul_push_r"]     = std::make_pair( GameMode::FoulPush_,    RIGHT );
-    M_playmode_map["foul_multiple_attack_l"] = std::make_pair( GameMode::FoulMultipleAttacker_, LEFT );
-    M_playmode_map["foul_multiple_attack_r"] = std::make_pair( GameMode::FoulMultipleAttacker_, RIGHT );
-    M_playmode_map["foul_ballout_l"]  = std::make_pair( GameMode::FoulBallOut_, LEFT );
-    M_playmode_map["foul_ballout_r"]  = std::make_pair( GameMode::FoulBallOut_, RIGHT );
-    M_playmode_map["back_pass_l"] = std::make_pair( GameMode::BackPass_,  LEFT );
-    M_playmode_map["back_pass_r"] = std::make_pair( GameMode::BackPass_, RIGHT );
-    M_playmode_map["free_kick_fault_l"] = std::make_pair( GameMode::FreeKickFault_, LEFT );
-    M_playmode_map["free_kick_fault_r"] = std::make_pair( GameMode::FreeKickFault_, RIGHT );
-    M_playmode_map["catch_fault_l"] = std::make_pair( GameMode::CatchFault_, LEFT );
-    M_playmode_map["catch_fault_r"] = std::make_pair( GameMode::CatchFault_, RIGHT );
-    M_playmode_map["indirect_free_kick_l"] = std::make_pair( GameMode::IndFreeKick_, LEFT );
-    M_playmode_map["indirect_free_kick_r"] = std::make_pair( GameMode::IndFreeKick_, RIGHT );
-    M_playmode_map["penalty_setup_l"] = std::make_pair( GameMode::PenaltySetup_, LEFT );
-    M_playmode_map["penalty_setup_r"] = std::make_pair( GameMode::PenaltySetup_, RIGHT );
-    M_playmode_map["penalty_ready_l"] = std::make_pair( GameMode::PenaltyReady_, LEFT );
-    M_playmode_map["penalty_ready_r"] = std::make_pair( GameMode::PenaltyReady_, RIGHT );
-    M_playmode_map["penalty_taken_l"] = std::make_pair( GameMode::PenaltyTaken_, LEFT );
-    M_playmode_map["penalty_taken_r"] = std::make_pair( GameMode::PenaltyTaken_, RIGHT );
-    M_playmode_map["penalty_miss_l"] = std::make_pair( GameMode::PenaltyMiss_, LEFT );
-    M_playmode_map["penalty_miss_r"] = std::make_pair( GameMode::PenaltyMiss_, RIGHT );
-    M_playmode_map["penalty_score_l"] = std::make_pair( GameMode::PenaltyScore_, LEFT );
-    M_playmode_map["penalty_score_r"] = std::make_pair( GameMode::PenaltyScore_, RIGHT );
-    M_playmode_map["illegal_defense_l"] = std::make_pair( GameMode::IllegalDefense_, LEFT );
-    M_playmode_map["illegal_defense_r"] = std::make_pair( GameMode::IllegalDefense_, RIGHT );
-
-    //"goal_SIDE_SCORE"
-    M_playmode_map["half_time"] = std::make_pair( GameMode::FirstHalfOver, NEUTRAL );
-    M_playmode_map["time_extended"] = std::make_pair( GameMode::ExtendHalf, NEUTRAL );
-    M_playmode_map["time_up_without_a_team"] = std::make_pair( GameMode::TimeOver, NEUTRAL );
-    M_playmode_map["time_up"] = std::make_pair( GameMode::TimeOver, NEUTRAL );
-    M_playmode_map["foul_l"] = std::make_pair( GameMode::FreeKick_, RIGHT );
-    M_playmode_map["foul_r"] = std::make_pair( GameMode::FreeKick_, LEFT );
-    M_playmode_map["goalie_catch_ball_l"] = std::make_pair( GameMode::GoalieCatch_, LEFT );
-    M_playmode_map["goalie_catch_ball_r"] = std::make_pair( GameMode::GoalieCatch_, RIGHT );
-
-    M_playmode_map["penalty_onfield_l"] = std::make_pair( GameMode::PenaltyOnfield_, LEFT );
-    M_playmode_map["penalty_onfield_r"] = std::make_pair( GameMode::PenaltyOnfield_, RIGHT );
-    M_playmode_map["penalty_foul_l"] = std::make_pair( GameMode::PenaltyFoul_, LEFT );
-    M_playmode_map["penalty_foul_r"] = std::make_pair( GameMode::PenaltyFoul_, RIGHT );
-    M_playmode_map["penalty_winner_l"] = std::make_pair( GameMode::TimeOver, NEUTRAL );//std::make_pair(PenaltyWinner_, LEFT);
-    M_playmode_map["penalty_winner_r"] = std::make_pair( GameMode::TimeOver, NEUTRAL );//std::make_pair(PenaltyWinner_, RIGHT);
-    M_playmode_map["penalty_draw"] = std::make_pair( GameMode::TimeOver, NEUTRAL );//std::make_pair(PenaltyDraw, NEUTRAL);
-}
-
-} // end of no name namespace
+#include <iostream>
 
 namespace rcsc {
 
@@ -193,13 +81,40 @@ bool
 GameMode::update( const std::string & mode_str,
                   const GameTime & current )
 {
-    Pair mode_pair = parse( mode_str );
+    PlayModeInfo info;
+    PlayModeDecoder::decode( mode_str.c_str(), mode_str.length(), &info );
+
+    return update( info, current );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
 
-    if ( mode_pair.first == MODE_MAX )
+*/
+bool
+GameMode::update( const PlayModeInfo & info,
+                  const GameTime & current )
+{
+    if ( info.kind_ != PlayModeInfo::PLAYMODE )
     {
         return false;
     }
 
+    const Pair mode_pair( info.type_, info.side_ );
+
+    if ( info.type_ == AfterGoal_
+         && info.value_ >= 0 )
+    {
+        if ( info.side_ == LEFT )
+        {
+            M_score_left = info.value_;
+        }
+        else if ( info.side_ == RIGHT )
+        {
+            M_score_right = info.value_;
+        }
+    }
+
     // when goalie catch the ball, playmode is changed twice at the same game cycle:
     //   PlayOn -> GoalieCatch_ -> FreeKick_
     // therefore, if old playmode is GoalieCatch_
@@ -238,61 +153,6 @@ GameMode::setScore( const int score_l,
 /*-------------------------------------------------------------------*/
 /*!
 
-*/
-GameMode::Pair
-GameMode::parse( const std::string & mode_str )
-{
-    static MapHolder S_map_holder;
-
-    const PlayModeMap & pmap = S_map_holder.get();
-
-    PlayModeMap::const_iterator it = pmap.find( mode_str );
-    if ( it != pmap.end() )
-    {
-        return it->second;
-    }
-
-    if ( ! mode_str.compare( 0, 6, "goal_l" ) )
-    {
-        int score = 0;
-        if ( std::sscanf( mode_str.c_str(), " goal_l_%d ", &score ) == 1 )
-        {
-            M_score_left = score;
-        }
-        // else
-        // {
-        //     std::cerr << __FILE__ << ' ' << __LINE__
-        //               << ": illegal playmode message [" << mode_str << "]"
-        //               << std::endl;
-        // }
-        return std::make_pair( AfterGoal_, LEFT );
-    }
-    else if ( ! mode_str.compare( 0, 6, "goal_r" ) )
-    {
-        int score = 0;
-        if ( std::sscanf( mode_str.c_str(), " goal_r_%d ", &score ) == 1 )
-        {
-            M_score_right = score;
-        }
-        // else
-        // {
-        //     std::cerr << __FILE__ << ' ' << __LINE__
-        //               << ": illegal playmode message [" << mode_str << "]"
-        //               << std::endl;
-        // }
-        return std::make_pair( AfterGoal_, RIGHT );
-    }
-
-    //std::cerr << __FILE__ << ": " << __LINE__
-    //          << " Received unsupported playmode : [" << mode_str << "]"
-    //          << std::endl;
-
-    return std::make_pair( MODE_MAX, NEUTRAL );
-}
-
-/*-------------------------------------------------------------------*/
-/*!
-
 */
 bool
 GameMode::isServerCycleStoppedMode() const
@@ -0,0 +1,394 @@
+// -*-c++-*-
+
+/*!
+  \file memory_accounting.cpp
+  \brief per-subsystem memory accounting Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "memory_accounting.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+namespace rcsc {
+
+constexpr std::uint64_t MemoryAccounting::WARMUP_SAMPLES;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+MemoryAccount::MemoryAccount( std::pmr::memory_resource * upstream )
+    : M_upstream( upstream ? upstream : std::pmr::new_delete_resource() ),
+      M_bytes( 0 ),
+      M_peak_bytes( 0 ),
+      M_allocation_count( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void *
+MemoryAccount::do_allocate( std::size_t bytes,
+                            std::size_t alignment )
+{
+    void * p = M_upstream->allocate( bytes, alignment );
+
+    const std::size_t current = M_bytes.fetch_add( bytes, std::memory_order_relaxed ) + bytes;
+    std::size_t peak = M_peak_bytes.load( std::memory_order_relaxed );
+    while ( current > peak
+            && ! M_peak_bytes.compare_exchange_weak( peak, current, std::memory_order_relaxed ) )
+    {
+    }
+    M_allocation_count.fetch_add( 1, std::memory_order_relaxed );
+
+    return p;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MemoryAccount::do_deallocate( void * p,
+                              std::size_t bytes,
+                              std::size_t alignment )
+{
+    M_upstream->deallocate( p, bytes, alignment );
+    M_bytes.fetch_sub( bytes, std::memory_order_relaxed );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+MemoryAccounting::MemoryAccounting()
+    : M_sample_count( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+MemoryAccounting &
+MemoryAccounting::instance()
+{
+    static MemoryAccounting s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+MemoryAccounting::Entry *
+MemoryAccounting::findEntry( const std::string & name ) const
+{
+    for ( const std::unique_ptr< Entry > & e : M_entries )
+    {
+        if ( e->name_ == name )
+        {
+            return e.get();
+        }
+    }
+
+    return nullptr;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MemoryAccounting::addProbe( const std::string & name,
+                            Probe probe )
+{
+    std::lock_guard< std::mutex > lock( M_mutex );
+
+    Entry * e = findEntry( name );
+    if ( ! e )
+    {
+        M_entries.emplace_back( new Entry{ name, Probe(), nullptr, 0, 0, 0.0, 0, 0 } );
+        e = M_entries.back().get();
+    }
+
+    e->probe_ = std::move( probe );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MemoryAccounting::removeProbe( const std::string & name )
+{
+    std::lock_guard< std::mutex > lock( M_mutex );
+
+    Entry * e = findEntry( name );
+    if ( e )
+    {
+        e->probe_ = Probe();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+MemoryAccount *
+MemoryAccounting::account( const std::string & name )
+{
+    std::lock_guard< std::mutex > lock( M_mutex );
+
+    Entry * e = findEntry( name );
+    if ( ! e )
+    {
+        M_entries.emplace_back( new Entry{ name, Probe(), nullptr, 0, 0, 0.0, 0, 0 } );
+        e = M_entries.back().get();
+    }
+
+    if ( ! e->account_ )
+    {
+        e->account_.reset( new MemoryAccount() );
+    }
+
+    return e->account_.get();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MemoryAccounting::sampleEntry( Entry & entry )
+{
+    if ( entry.probe_ )
+    {
+        entry.current_ = entry.probe_();
+    }
+    else if ( entry.account_ )
+    {
+        entry.current_ = entry.account_->bytes();
+    }
+    else
+    {
+        // detached. keep the last value.
+        return;
+    }
+
+    entry.peak_ = std::max( entry.peak_, entry.current_ );
+    if ( entry.account_ )
+    {
+        entry.peak_ = std::max( entry.peak_, entry.account_->peakBytes() );
+    }
+
+    ++entry.samples_;
+    if ( entry.samples_ > WARMUP_SAMPLES )
+    {
+        entry.steady_sum_ += entry.current_;
+        ++entry.steady_count_;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MemoryAccounting::sample()
+{
+    std::lock_guard< std::mutex > lock( M_mutex );
+
+    ++M_sample_count;
+    for ( std::unique_ptr< Entry > & e : M_entries )
+    {
+        sampleEntry( *e );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::uint64_t
+MemoryAccounting::sampleCount() const
+{
+    std::lock_guard< std::mutex > lock( M_mutex );
+    return M_sample_count;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::vector< MemoryAccounting::Usage >
+MemoryAccounting::usage() const
+{
+    std::lock_guard< std::mutex > lock( M_mutex );
+
+    std::vector< Usage > result;
+    result.reserve( M_entries.size() );
+
+    for ( const std::unique_ptr< Entry > & e : M_entries )
+    {
+        std::size_t current = e->current_;
+        if ( e->probe_ )
+        {
+            current = e->probe_();
+        }
+        else if ( e->account_ )
+        {
+            current = e->account_->bytes();
+        }
+
+        std::size_t peak = std::max( e->peak_, current );
+        if ( e->account_ )
+        {
+            peak = std::max( peak, e->account_->peakBytes() );
+        }
+
+        const std::size_t steady = ( e->steady_count_ > 0
+                                     ? static_cast< std::size_t >( e->steady_sum_ / e->steady_count_ )
+                                     : current );
+
+        result.push_back( Usage{ e->name_, current, peak, steady } );
+    }
+
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+MemoryAccounting::print( std::ostream & os ) const
+{
+    const std::vector< Usage > entries = usage();
+
+    std::size_t total_current = 0;
+    std::size_t total_peak = 0;
+    std::size_t total_steady = 0;
+
+    os << std::left << std::setw( 32 ) << "name"
+       << std::right
+       << std::setw( 14 ) << "current"
+       << std::setw( 14 ) << "peak"
+       << std::setw( 14 ) << "steady" << '\n';
+
+    for ( const Usage & u : entries )
+    {
+        os << std::left << std::setw( 32 ) << u.name_
+           << std::right
+           << std::setw( 14 ) << u.current_
+           << std::setw( 14 ) << u.peak_
+           << std::setw( 14 ) << u.steady_ << '\n';
+        total_current += u.current_;
+        total_peak += u.peak_;
+        total_steady += u.steady_;
+    }
+
+    os << std::left << std::setw( 32 ) << "total"
+       << std::right
+       << std::setw( 14 ) << total_current
+       << std::setw( 14 ) << total_peak
+       << std::setw( 14 ) << total_steady << '\n';
+
+    return os;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+MemoryAccounting::writeJSON( std::ostream & os ) const
+{
+    const std::vector< Usage > entries = usage();
+
+    std::size_t total_current = 0;
+    std::size_t total_peak = 0;
+    std::size_t total_steady = 0;
+
+    os << "{\n"
+       << "\"samples\":" << sampleCount() << ",\n"
+       << "\"warmup_samples\":" << WARMUP_SAMPLES << ",\n"
+       << "\"entries\":[";
+
+    const char * sep = "\n";
+    for ( const Usage & u : entries )
+    {
+        os << sep
+           << "{\"name\":\"" << u.name_ << "\""
+           << ",\"current\":" << u.current_
+           << ",\"peak\":" << u.peak_
+           << ",\"steady\":" << u.steady_ << '}';
+        sep = ",\n";
+        total_current += u.current_;
+        total_peak += u.peak_;
+        total_steady += u.steady_;
+    }
+
+    os << "\n],\n"
+       << "\"total\":{\"current\":" << total_current
+       << ",\"peak\":" << total_peak
+       << ",\"steady\":" << total_steady << "}\n"
+       << "}\n";
+
+    return os;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+MemoryAccounting::writeJSON( const std::string & filepath ) const
+{
+    std::ofstream fout( filepath.c_str() );
+    if ( ! fout.is_open() )
+    {
+        return false;
+    }
+
+    writeJSON( fout );
+    fout.flush();
+    return static_cast< bool >( fout );
+}
+
+}
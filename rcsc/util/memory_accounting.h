@@ -0,0 +1,273 @@
+// -*-c++-*-
+
+/*!
+  \file memory_accounting.h
+  \brief per-subsystem memory accounting Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_UTIL_MEMORY_ACCOUNTING_H
+#define RCSC_UTIL_MEMORY_ACCOUNTING_H
+
+#include <memory_resource>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstddef>
+#include <cstdint>
+
+namespace rcsc {
+
+/*!
+  \brief get the heap bytes held by the vector
+  \param v vector object
+  \return capacity in bytes
+*/
+template < typename T, typename A >
+inline
+std::size_t
+vector_memory_usage( const std::vector< T, A > & v )
+{
+    return v.capacity() * sizeof( T );
+}
+
+/*!
+  \class MemoryAccount
+  \brief memory resource adapter that counts the bytes allocated from the upstream.
+
+  An account is used as the upstream of the pools and arenas, so that the
+  block memory they hold is accounted without changing their owners. The
+  counters are atomic and the account can be shared by several threads if
+  the upstream is thread-safe.
+*/
+class MemoryAccount
+    : public std::pmr::memory_resource {
+private:
+    std::pmr::memory_resource * M_upstream; //!< memory source
+    std::atomic< std::size_t > M_bytes; //!< currently allocated bytes
+    std::atomic< std::size_t > M_peak_bytes; //!< maximum of M_bytes
+    std::atomic< std::uint64_t > M_allocation_count; //!< the number of allocate() calls
+
+    // not used
+    MemoryAccount( const MemoryAccount & ) = delete;
+    MemoryAccount & operator=( const MemoryAccount & ) = delete;
+
+public:
+
+    /*!
+      \brief create an account on the upstream resource
+      \param upstream memory source
+    */
+    explicit
+    MemoryAccount( std::pmr::memory_resource * upstream = std::pmr::new_delete_resource() );
+
+    /*!
+      \brief get the currently allocated bytes
+      \return bytes
+    */
+    std::size_t bytes() const
+      {
+          return M_bytes.load( std::memory_order_relaxed );
+      }
+
+    /*!
+      \brief get the maximum allocated bytes
+      \return bytes
+    */
+    std::size_t peakBytes() const
+      {
+          return M_peak_bytes.load( std::memory_order_relaxed );
+      }
+
+    /*!
+      \brief get the number of allocations
+      \return allocation count
+    */
+    std::uint64_t allocationCount() const
+      {
+          return M_allocation_count.load( std::memory_order_relaxed );
+      }
+
+protected:
+
+    void * do_allocate( std::size_t bytes,
+                        std::size_t alignment ) override;
+
+    void do_deallocate( void * p,
+                        std::size_t bytes,
+                        std::size_t alignment ) override;
+
+    bool do_is_equal( const std::pmr::memory_resource & other ) const noexcept override
+      {
+          return this == &other;
+      }
+};
+
+/*!
+  \class MemoryAccounting
+  \brief process wide registry of the memory usage of the library subsystems.
+
+  Each subsystem is registered by name, either as a probe function that
+  returns its current heap bytes (e.g. KickTable::memoryUsage()), or as a
+  MemoryAccount used as the upstream of its pools and arenas. sample()
+  reads all entries and updates their peak and steady state values. The
+  steady state value is the average of the samples taken after the first
+  WARMUP_SAMPLES samples, that is, after the tables are built and the
+  histories are filled.
+
+  The probes are called with the registry lock held, so a probe must not
+  call the registry.
+*/
+class MemoryAccounting {
+public:
+
+    //! probe function type. returns the current bytes.
+    typedef std::function< std::size_t() > Probe;
+
+    //! the number of samples excluded from the steady state average
+    static constexpr std::uint64_t WARMUP_SAMPLES = 100;
+
+    /*!
+      \struct Usage
+      \brief memory usage of an entry. all values are in bytes.
+    */
+    struct Usage {
+        std::string name_; //!< entry name
+        std::size_t current_; //!< the latest value
+        std::size_t peak_; //!< the maximum value
+        std::size_t steady_; //!< average after the warm up
+    };
+
+private:
+
+    /*!
+      \struct Entry
+      \brief registered subsystem
+    */
+    struct Entry {
+        std::string name_;
+        Probe probe_; //!< empty if detached
+        std::unique_ptr< MemoryAccount > account_; //!< owned account. may be null.
+        std::size_t current_;
+        std::size_t peak_;
+        long double steady_sum_;
+        std::uint64_t steady_count_;
+        std::uint64_t samples_;
+    };
+
+    mutable std::mutex M_mutex;
+    std::vector< std::unique_ptr< Entry > > M_entries;
+    std::uint64_t M_sample_count;
+
+    MemoryAccounting();
+
+    // not used
+    MemoryAccounting( const MemoryAccounting & ) = delete;
+    MemoryAccounting & operator=( const MemoryAccounting & ) = delete;
+
+    Entry * findEntry( const std::string & name ) const;
+    static void sampleEntry( Entry & entry );
+
+public:
+
+    /*!
+      \brief get the process wide instance
+      \return reference to the instance
+    */
+    static
+    MemoryAccounting & instance();
+
+    /*!
+      \brief register the probe function. if the name is already registered,
+      the probe is replaced and the recorded values are kept.
+      \param name entry name
+      \param probe function that returns the current bytes
+    */
+    void addProbe( const std::string & name,
+                   Probe probe );
+
+    /*!
+      \brief detach the probe before its owner is destroyed. the recorded
+      values are kept and reported as they are.
+      \param name entry name
+    */
+    void removeProbe( const std::string & name );
+
+    /*!
+      \brief get the named account. the account is created at the first call
+      and lives as long as the process.
+      \param name entry name
+      \return pointer to the account
+    */
+    MemoryAccount * account( const std::string & name );
+
+    /*!
+      \brief read all entries and update the peak and steady state values
+    */
+    void sample();
+
+    /*!
+      \brief get the number of sample() calls
+      \return sample count
+    */
+    std::uint64_t sampleCount() const;
+
+    /*!
+      \brief read the current values of all entries
+      \return usage of all entries in the registered order
+    */
+    std::vector< Usage > usage() const;
+
+    /*!
+      \brief put the usage table
+      \param os reference to the output stream
+      \return reference to the output stream
+    */
+    std::ostream & print( std::ostream & os ) const;
+
+    /*!
+      \brief put the usage in the JSON format
+      \param os reference to the output stream
+      \return reference to the output stream
+    */
+    std::ostream & writeJSON( std::ostream & os ) const;
+
+    /*!
+      \brief write the usage to the file in the JSON format
+      \param filepath output file path
+      \return true if successfully written
+    */
+    bool writeJSON( const std::string & filepath ) const;
+};
+
+}
+
+#endif
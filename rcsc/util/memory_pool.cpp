@@ -35,13 +35,229 @@
 
 #include "memory_pool.h"
 
+#include <algorithm>
+
 namespace rcsc {
 
+namespace {
+
+/*-------------------------------------------------------------------*/
+inline
+std::size_t
+round_up( const std::size_t size,
+          const std::size_t align )
+{
+    return ( size + align - 1 ) / align * align;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+FixedSizePool::FixedSizePool( const std::size_t slot_size,
+                              const std::size_t slot_align,
+                              const std::size_t slots_per_block,
+                              std::pmr::memory_resource * upstream )
+    : M_upstream( upstream ? upstream : std::pmr::new_delete_resource() ),
+      M_slot_size( 0 ),
+      M_slot_align( std::max( slot_align, alignof( FreeSlot ) ) ),
+      M_slots_per_block( std::max( slots_per_block, std::size_t( 1 ) ) ),
+      M_free_list( nullptr ),
+      M_next( nullptr ),
+      M_end( nullptr ),
+      M_used( 0 ),
+      M_capacity( 0 )
+{
+    M_slot_size = round_up( std::max( slot_size, sizeof( FreeSlot ) ), M_slot_align );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+FixedSizePool::~FixedSizePool()
+{
+    clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+FixedSizePool::FixedSizePool( FixedSizePool && other ) noexcept
+    : M_upstream( other.M_upstream ),
+      M_slot_size( other.M_slot_size ),
+      M_slot_align( other.M_slot_align ),
+      M_slots_per_block( other.M_slots_per_block ),
+      M_blocks( std::move( other.M_blocks ) ),
+      M_free_list( other.M_free_list ),
+      M_next( other.M_next ),
+      M_end( other.M_end ),
+      M_used( other.M_used ),
+      M_capacity( other.M_capacity )
+{
+    other.M_blocks.clear();
+    other.M_free_list = nullptr;
+    other.M_next = other.M_end = nullptr;
+    other.M_used = other.M_capacity = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+FixedSizePool &
+FixedSizePool::operator=( FixedSizePool && other ) noexcept
+{
+    if ( this != &other )
+    {
+        clear();
+        M_upstream = other.M_upstream;
+        M_slot_size = other.M_slot_size;
+        M_slot_align = other.M_slot_align;
+        M_slots_per_block = other.M_slots_per_block;
+        M_blocks = std::move( other.M_blocks );
+        M_free_list = other.M_free_list;
+        M_next = other.M_next;
+        M_end = other.M_end;
+        M_used = other.M_used;
+        M_capacity = other.M_capacity;
+
+        other.M_blocks.clear();
+        other.M_free_list = nullptr;
+        other.M_next = other.M_end = nullptr;
+        other.M_used = other.M_capacity = 0;
+    }
+    return *this;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+FixedSizePool::grow()
+{
+    const std::size_t bytes = M_slot_size * M_slots_per_block;
+
+    M_blocks.reserve( M_blocks.size() + 1 );
+    void * block = M_upstream->allocate( bytes, M_slot_align );
+    M_blocks.push_back( block );
+
+    M_next = static_cast< unsigned char * >( block );
+    M_end = M_next + bytes;
+    M_capacity += M_slots_per_block;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+FixedSizePool::clear()
+{
+    const std::size_t bytes = M_slot_size * M_slots_per_block;
+    for ( void * block : M_blocks )
+    {
+        M_upstream->deallocate( block, bytes, M_slot_align );
+    }
+    M_blocks.clear();
+
+    M_free_list = nullptr;
+    M_next = M_end = nullptr;
+    M_used = 0;
+    M_capacity = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+PoolMemoryResource::PoolMemoryResource( std::pmr::memory_resource * upstream )
+    : M_upstream( upstream ? upstream : std::pmr::new_delete_resource() )
+{
+    // about 16KB per block, at least 16 slots
+    M_pools.reserve( NUM_SIZE_CLASSES );
+    for ( std::size_t i = 0; i < NUM_SIZE_CLASSES; ++i )
+    {
+        const std::size_t size = ( i + 1 ) * SIZE_CLASS_STEP;
+        M_pools.emplace_back( size,
+                              alignof( std::max_align_t ),
+                              std::max( std::size_t( 16 ), std::size_t( 16384 ) / size ),
+                              M_upstream );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PoolMemoryResource::release()
+{
+    for ( FixedSizePool & p : M_pools )
+    {
+        p.clear();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void *
+PoolMemoryResource::do_allocate( std::size_t bytes,
+                                 std::size_t alignment )
+{
+    if ( bytes == 0 ) bytes = 1;
+
+    if ( bytes > MAX_POOLED_SIZE
+         || alignment > alignof( std::max_align_t ) )
+    {
+        return M_upstream->allocate( bytes, alignment );
+    }
+
+    return M_pools[( bytes - 1 ) / SIZE_CLASS_STEP].allocate();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PoolMemoryResource::do_deallocate( void * p,
+                                   std::size_t bytes,
+                                   std::size_t alignment )
+{
+    if ( bytes == 0 ) bytes = 1;
+
+    if ( bytes > MAX_POOLED_SIZE
+         || alignment > alignof( std::max_align_t ) )
+    {
+        M_upstream->deallocate( p, bytes, alignment );
+        return;
+    }
+
+    M_pools[( bytes - 1 ) / SIZE_CLASS_STEP].deallocate( p );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+PoolMemoryResource::do_is_equal( const std::pmr::memory_resource & other ) const noexcept
+{
+    return this == &other;
+}
+
 // Global memory pool instances
 namespace global_pools {
-    MemoryPool<char, 4096> string_pool;
-    MemoryPool<int, 1024> int_pool;
-    MemoryPool<double, 1024> double_pool;
+SharedMemoryPool< char, 4096 > string_pool;
+SharedMemoryPool< int, 1024 > int_pool;
+SharedMemoryPool< double, 1024 > double_pool;
 }
 
-} // namespace rcsc 
\ No newline at end of file
+} // namespace rcsc
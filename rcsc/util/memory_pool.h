@@ -30,199 +30,631 @@
 #ifndef RCSC_UTIL_MEMORY_POOL_H
 #define RCSC_UTIL_MEMORY_POOL_H
 
+#include <memory_resource>
 #include <vector>
 #include <mutex>
-#include <memory>
+#include <atomic>
+#include <utility>
+#include <new>
 #include <cstddef>
 #include <cstdint>
 
 namespace rcsc {
 
+/*!
+  \class FixedSizePool
+  \brief single threaded pool of the fixed size memory slots.
+
+  Released slots are linked into the intrusive free list, so both
+  allocate() and deallocate() are O(1). A new block is taken from the
+  upstream resource only when the free list and the current block are
+  exhausted. The slots of a new block are handed out in order and are never
+  touched before that, so no slot is initialized eagerly.
+
+  This class has no lock. Use SharedMemoryPool to share a pool between threads.
+*/
+class FixedSizePool {
+private:
+
+    //! free list link overlaid on the released slot
+    struct FreeSlot {
+        FreeSlot * next_;
+    };
+
+    std::pmr::memory_resource * M_upstream; //!< block memory source
+    std::size_t M_slot_size; //!< slot size in bytes. a multiple of M_slot_align.
+    std::size_t M_slot_align; //!< slot alignment
+    std::size_t M_slots_per_block; //!< the number of slots in a block
+
+    std::vector< void * > M_blocks; //!< allocated blocks
+    FreeSlot * M_free_list; //!< head of the free list
+    unsigned char * M_next; //!< next never used slot in the last block
+    unsigned char * M_end; //!< end of the last block
+
+    std::size_t M_used; //!< the number of slots in use
+    std::size_t M_capacity; //!< the total number of slots
+
+    // not used
+    FixedSizePool( const FixedSizePool & ) = delete;
+    FixedSizePool & operator=( const FixedSizePool & ) = delete;
+
+    /*!
+      \brief allocate a new block
+    */
+    void grow();
+
+public:
+
+    /*!
+      \brief create an empty pool
+      \param slot_size size of a slot. rounded up to hold a free list link.
+      \param slot_align alignment of a slot
+      \param slots_per_block the number of slots allocated at once
+      \param upstream block memory source
+    */
+    FixedSizePool( const std::size_t slot_size,
+                   const std::size_t slot_align,
+                   const std::size_t slots_per_block,
+                   std::pmr::memory_resource * upstream = std::pmr::new_delete_resource() );
+
+    /*!
+      \brief release all blocks
+    */
+    ~FixedSizePool();
+
+    /*!
+      \brief move the blocks from other pool
+    */
+    FixedSizePool( FixedSizePool && other ) noexcept;
+
+    /*!
+      \brief move the blocks from other pool
+    */
+    FixedSizePool & operator=( FixedSizePool && other ) noexcept;
+
+    /*!
+      \brief get a slot
+      \return pointer to the uninitialized memory
+    */
+    void * allocate()
+      {
+          if ( M_free_list )
+          {
+              FreeSlot * s = M_free_list;
+              M_free_list = s->next_;
+              ++M_used;
+              return s;
+          }
+
+          if ( M_next == M_end )
+          {
+              grow();
+          }
+
+          void * p = M_next;
+          M_next += M_slot_size;
+          ++M_used;
+          return p;
+      }
+
+    /*!
+      \brief release the slot to the free list
+      \param p pointer returned by allocate()
+    */
+    void deallocate( void * p )
+      {
+          if ( ! p ) return;
+
+          FreeSlot * s = static_cast< FreeSlot * >( p );
+          s->next_ = M_free_list;
+          M_free_list = s;
+          --M_used;
+      }
+
+    /*!
+      \brief release all blocks. all slots become invalid.
+    */
+    void clear();
+
+    /*!
+      \brief get the slot size
+      \return slot size in bytes
+    */
+    std::size_t slotSize() const
+      {
+          return M_slot_size;
+      }
+
+    /*!
+      \brief get the number of slots in use
+      \return slot count
+    */
+    std::size_t used() const
+      {
+          return M_used;
+      }
+
+    /*!
+      \brief get the total number of slots in the allocated blocks
+      \return slot count
+    */
+    std::size_t capacity() const
+      {
+          return M_capacity;
+      }
+};
+
 /*!
   \class MemoryPool
-  \brief Efficient memory pool for fixed-size allocations
+  \brief single threaded pool for the objects of type T
+
+  allocate() returns the uninitialized storage. create() and destroy()
+  construct and destruct the object in place.
 */
-template<typename T, size_t BlockSize = 1024>
+template < typename T, std::size_t BlockSize = 1024 >
 class MemoryPool {
 private:
-    struct Block {
-        std::unique_ptr<T[]> data;
-        std::vector<bool> used;
-        size_t free_count;
-        
-        Block() : data(std::make_unique<T[]>(BlockSize)), 
-                  used(BlockSize, false), 
-                  free_count(BlockSize) {}
-    };
 
-    mutable std::mutex mutex_;
-    std::vector<std::unique_ptr<Block>> blocks_;
-    size_t total_allocated_;
-    size_t total_capacity_;
+    FixedSizePool M_pool;
 
 public:
-    MemoryPool() : total_allocated_(0), total_capacity_(0) {}
-    
-    ~MemoryPool() = default;
-    
-    // Disable copy
-    MemoryPool(const MemoryPool&) = delete;
-    MemoryPool& operator=(const MemoryPool&) = delete;
-    
-    // Allow move
-    MemoryPool(MemoryPool&&) = default;
-    MemoryPool& operator=(MemoryPool&&) = default;
-
-    /*!
-      \brief Allocate a single object
-      \return pointer to allocated object, nullptr if allocation failed
-    */
-    T* allocate() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        // Try to find a free slot in existing blocks
-        for (auto& block : blocks_) {
-            if (block->free_count > 0) {
-                for (size_t i = 0; i < BlockSize; ++i) {
-                    if (!block->used[i]) {
-                        block->used[i] = true;
-                        --block->free_count;
-                        ++total_allocated_;
-                        return &block->data[i];
-                    }
-                }
-            }
-        }
-        
-        // Create new block if needed
-        try {
-            auto new_block = std::make_unique<Block>();
-            new_block->used[0] = true;
-            new_block->free_count = BlockSize - 1;
-            blocks_.push_back(std::move(new_block));
-            total_allocated_++;
-            total_capacity_ += BlockSize;
-            return &blocks_.back()->data[0];
-        } catch (const std::bad_alloc&) {
-            return nullptr;
-        }
-    }
-
-    /*!
-      \brief Deallocate an object
-      \param ptr pointer to object to deallocate
-    */
-    void deallocate(T* ptr) {
-        if (!ptr) return;
-        
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        for (auto& block : blocks_) {
-            if (ptr >= &block->data[0] && ptr <= &block->data[BlockSize - 1]) {
-                size_t index = ptr - &block->data[0];
-                if (index < BlockSize && block->used[index]) {
-                    block->used[index] = false;
-                    ++block->free_count;
-                    --total_allocated_;
-                    return;
-                }
-            }
-        }
-    }
+
+    /*!
+      \brief create an empty pool
+      \param upstream block memory source
+    */
+    explicit
+    MemoryPool( std::pmr::memory_resource * upstream = std::pmr::new_delete_resource() )
+        : M_pool( sizeof( T ), alignof( T ), BlockSize, upstream )
+      { }
+
+    MemoryPool( MemoryPool && ) = default;
+    MemoryPool & operator=( MemoryPool && ) = default;
+
+    /*!
+      \brief allocate the storage of an object
+      \return pointer to the uninitialized storage
+    */
+    T * allocate()
+      {
+          return static_cast< T * >( M_pool.allocate() );
+      }
+
+    /*!
+      \brief release the storage. the object must be already destructed.
+      \param ptr pointer returned by allocate()
+    */
+    void deallocate( T * ptr )
+      {
+          M_pool.deallocate( ptr );
+      }
+
+    /*!
+      \brief allocate the storage and construct an object
+      \param args constructor arguments
+      \return pointer to the new object
+    */
+    template < typename... Args >
+    T * create( Args &&... args )
+      {
+          void * p = M_pool.allocate();
+          try
+          {
+              return ::new( p ) T( std::forward< Args >( args )... );
+          }
+          catch ( ... )
+          {
+              M_pool.deallocate( p );
+              throw;
+          }
+      }
+
+    /*!
+      \brief destruct the object and release the storage
+      \param ptr pointer returned by create()
+    */
+    void destroy( T * ptr )
+      {
+          if ( ! ptr ) return;
+          ptr->~T();
+          M_pool.deallocate( ptr );
+      }
 
     /*!
       \brief Get statistics about the memory pool
       \return pair of (allocated_count, total_capacity)
     */
-    std::pair<size_t, size_t> getStats() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return {total_allocated_, total_capacity_};
-    }
+    std::pair< std::size_t, std::size_t > getStats() const
+      {
+          return std::make_pair( M_pool.used(), M_pool.capacity() );
+      }
 
     /*!
-      \brief Clear all allocated memory
+      \brief release all blocks. objects are not destructed.
     */
-    void clear() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        blocks_.clear();
-        total_allocated_ = 0;
-        total_capacity_ = 0;
-    }
+    void clear()
+      {
+          M_pool.clear();
+      }
+};
+
+/*!
+  \class SharedMemoryPool
+  \brief MemoryPool shared by several threads with the per-thread cache front-end.
+
+  Each thread keeps up to CacheSize released slots of the pool it uses. The
+  slots are moved between the thread cache and the central pool in batches
+  of CacheSize / 2, so the mutex is taken once per several calls. A thread
+  caches the slots of only one pool instance per template instantiation;
+  the other pools are served through the mutex directly. Call
+  flushThreadCache() before a thread stops using the pool, otherwise its
+  cached slots are not reused until the pool is destroyed.
+*/
+template < typename T, std::size_t BlockSize = 1024, std::size_t CacheSize = 32 >
+class SharedMemoryPool {
+private:
+
+    static_assert( CacheSize >= 2, "CacheSize must be 2 or more" );
+
+    //! link overlaid on the cached slot
+    struct CachedSlot {
+        CachedSlot * next_;
+    };
+
+    //! per thread cache
+    struct ThreadCache {
+        std::uint64_t owner_; //!< serial number of the owner pool. 0 means unbound.
+        CachedSlot * head_;
+        std::size_t count_;
+    };
+
+    mutable std::mutex M_mutex;
+    FixedSizePool M_pool; //!< central pool. guarded by M_mutex.
+    const std::uint64_t M_serial; //!< unique id to bind the thread cache
+
+    static
+    std::uint64_t next_serial()
+      {
+          static std::atomic< std::uint64_t > s_serial( 0 );
+          return ++s_serial;
+      }
+
+    static
+    ThreadCache & thread_cache()
+      {
+          static thread_local ThreadCache s_cache = { 0, nullptr, 0 };
+          return s_cache;
+      }
+
+    /*!
+      \brief get the thread cache if it is bound to this pool
+      \return pointer to the cache or nullptr
+    */
+    ThreadCache * localCache()
+      {
+          ThreadCache & c = thread_cache();
+          if ( c.owner_ != M_serial )
+          {
+              if ( c.count_ != 0 )
+              {
+                  return nullptr;
+              }
+              c.owner_ = M_serial;
+          }
+          return &c;
+      }
+
+    // not used
+    SharedMemoryPool( const SharedMemoryPool & ) = delete;
+    SharedMemoryPool & operator=( const SharedMemoryPool & ) = delete;
+
+public:
+
+    /*!
+      \brief create an empty pool
+      \param upstream block memory source
+    */
+    explicit
+    SharedMemoryPool( std::pmr::memory_resource * upstream = std::pmr::new_delete_resource() )
+        : M_pool( sizeof( T ), alignof( T ), BlockSize, upstream ),
+          M_serial( next_serial() )
+      { }
+
+    /*!
+      \brief release the cache of the current thread and all blocks
+    */
+    ~SharedMemoryPool()
+      {
+          ThreadCache & c = thread_cache();
+          if ( c.owner_ == M_serial )
+          {
+              c.owner_ = 0;
+              c.head_ = nullptr;
+              c.count_ = 0;
+          }
+      }
+
+    /*!
+      \brief allocate the storage of an object
+      \return pointer to the uninitialized storage
+    */
+    T * allocate()
+      {
+          ThreadCache * c = localCache();
+          if ( ! c )
+          {
+              std::lock_guard< std::mutex > lock( M_mutex );
+              return static_cast< T * >( M_pool.allocate() );
+          }
+
+          if ( ! c->head_ )
+          {
+              std::lock_guard< std::mutex > lock( M_mutex );
+              for ( std::size_t i = 0; i < CacheSize / 2; ++i )
+              {
+                  CachedSlot * s = static_cast< CachedSlot * >( M_pool.allocate() );
+                  s->next_ = c->head_;
+                  c->head_ = s;
+              }
+              c->count_ = CacheSize / 2;
+          }
+
+          CachedSlot * s = c->head_;
+          c->head_ = s->next_;
+          --c->count_;
+          return reinterpret_cast< T * >( s );
+      }
+
+    /*!
+      \brief release the storage. the object must be already destructed.
+      \param ptr pointer returned by allocate()
+    */
+    void deallocate( T * ptr )
+      {
+          if ( ! ptr ) return;
+
+          ThreadCache * c = localCache();
+          if ( ! c )
+          {
+              std::lock_guard< std::mutex > lock( M_mutex );
+              M_pool.deallocate( ptr );
+              return;
+          }
+
+          CachedSlot * s = reinterpret_cast< CachedSlot * >( ptr );
+          s->next_ = c->head_;
+          c->head_ = s;
+          ++c->count_;
+
+          if ( c->count_ > CacheSize )
+          {
+              std::lock_guard< std::mutex > lock( M_mutex );
+              while ( c->count_ > CacheSize / 2 )
+              {
+                  CachedSlot * r = c->head_;
+                  c->head_ = r->next_;
+                  --c->count_;
+                  M_pool.deallocate( r );
+              }
+          }
+      }
+
+    /*!
+      \brief allocate the storage and construct an object
+      \param args constructor arguments
+      \return pointer to the new object
+    */
+    template < typename... Args >
+    T * create( Args &&... args )
+      {
+          T * p = allocate();
+          try
+          {
+              return ::new( static_cast< void * >( p ) ) T( std::forward< Args >( args )... );
+          }
+          catch ( ... )
+          {
+              deallocate( p );
+              throw;
+          }
+      }
+
+    /*!
+      \brief destruct the object and release the storage
+      \param ptr pointer returned by create()
+    */
+    void destroy( T * ptr )
+      {
+          if ( ! ptr ) return;
+          ptr->~T();
+          deallocate( ptr );
+      }
+
+    /*!
+      \brief return the slots cached by the current thread to the central pool
+    */
+    void flushThreadCache()
+      {
+          ThreadCache & c = thread_cache();
+          if ( c.owner_ != M_serial )
+          {
+              return;
+          }
+
+          std::lock_guard< std::mutex > lock( M_mutex );
+          while ( c.head_ )
+          {
+              CachedSlot * r = c.head_;
+              c.head_ = r->next_;
+              M_pool.deallocate( r );
+          }
+          c.count_ = 0;
+          c.owner_ = 0;
+      }
+
+    /*!
+      \brief Get statistics about the memory pool
+      \return pair of (allocated_count, total_capacity). the cached slots are counted as allocated.
+    */
+    std::pair< std::size_t, std::size_t > getStats() const
+      {
+          std::lock_guard< std::mutex > lock( M_mutex );
+          return std::make_pair( M_pool.used(), M_pool.capacity() );
+      }
+};
+
+/*!
+  \class PoolMemoryResource
+  \brief std::pmr::memory_resource backed by the per-size-class FixedSizePool
+
+  Requests up to MAX_POOLED_SIZE bytes are rounded up to a multiple of
+  SIZE_CLASS_STEP and served from the pool of that size class in O(1).
+  Larger or over-aligned requests are passed to the upstream resource.
+  This resource has no lock like std::pmr::unsynchronized_pool_resource.
+*/
+class PoolMemoryResource
+    : public std::pmr::memory_resource {
+public:
+
+    //! the granularity of the size classes
+    static constexpr std::size_t SIZE_CLASS_STEP = 16;
+    //! the maximum request size served by the pools
+    static constexpr std::size_t MAX_POOLED_SIZE = 512;
+    //! the number of size classes
+    static constexpr std::size_t NUM_SIZE_CLASSES = MAX_POOLED_SIZE / SIZE_CLASS_STEP;
+
+private:
+
+    std::pmr::memory_resource * M_upstream;
+    std::vector< FixedSizePool > M_pools; //!< pools indexed by the size class
+
+    PoolMemoryResource( const PoolMemoryResource & ) = delete;
+    PoolMemoryResource & operator=( const PoolMemoryResource & ) = delete;
+
+public:
+
+    /*!
+      \brief create the pools of all size classes. no block is allocated.
+      \param upstream memory source of the blocks and the large requests
+    */
+    explicit
+    PoolMemoryResource( std::pmr::memory_resource * upstream = std::pmr::new_delete_resource() );
+
+    /*!
+      \brief release all blocks
+    */
+    void release();
+
+    /*!
+      \brief get the upstream resource
+      \return pointer to the upstream resource
+    */
+    std::pmr::memory_resource * upstreamResource() const
+      {
+          return M_upstream;
+      }
+
+protected:
+
+    void * do_allocate( std::size_t bytes,
+                        std::size_t alignment ) override;
+
+    void do_deallocate( void * p,
+                        std::size_t bytes,
+                        std::size_t alignment ) override;
+
+    bool do_is_equal( const std::pmr::memory_resource & other ) const noexcept override;
 };
 
 /*!
   \class ObjectPool
   \brief RAII wrapper for memory pool allocations
+
+  The object is constructed in the pool storage and destroyed with this instance.
 */
-template<typename T, size_t BlockSize = 1024>
+template < typename T, typename Pool = SharedMemoryPool< T > >
 class ObjectPool {
 private:
-    MemoryPool<T, BlockSize>& pool_;
-    T* ptr_;
+    Pool & M_pool;
+    T * M_ptr;
 
 public:
-    ObjectPool(MemoryPool<T, BlockSize>& pool) : pool_(pool), ptr_(pool.allocate()) {}
-    
-    ~ObjectPool() {
-        if (ptr_) {
-            pool_.deallocate(ptr_);
-        }
-    }
-    
+
+    /*!
+      \brief construct an object in the pool
+      \param pool reference to the pool
+      \param args constructor arguments
+    */
+    template < typename... Args >
+    explicit
+    ObjectPool( Pool & pool,
+                Args &&... args )
+        : M_pool( pool ),
+          M_ptr( pool.create( std::forward< Args >( args )... ) )
+      { }
+
+    ~ObjectPool()
+      {
+          M_pool.destroy( M_ptr );
+      }
+
     // Disable copy
-    ObjectPool(const ObjectPool&) = delete;
-    ObjectPool& operator=(const ObjectPool&) = delete;
-    
+    ObjectPool( const ObjectPool & ) = delete;
+    ObjectPool & operator=( const ObjectPool & ) = delete;
+
     // Allow move
-    ObjectPool(ObjectPool&& other) noexcept : pool_(other.pool_), ptr_(other.ptr_) {
-        other.ptr_ = nullptr;
-    }
-    
-    ObjectPool& operator=(ObjectPool&& other) noexcept {
-        if (this != &other) {
-            if (ptr_) {
-                pool_.deallocate(ptr_);
-            }
-            ptr_ = other.ptr_;
-            other.ptr_ = nullptr;
-        }
-        return *this;
-    }
+    ObjectPool( ObjectPool && other ) noexcept
+        : M_pool( other.M_pool ),
+          M_ptr( other.M_ptr )
+      {
+          other.M_ptr = nullptr;
+      }
+
+    ObjectPool & operator=( ObjectPool && other ) noexcept
+      {
+          if ( this != &other )
+          {
+              M_pool.destroy( M_ptr );
+              M_ptr = other.M_ptr;
+              other.M_ptr = nullptr;
+          }
+          return *this;
+      }
 
     /*!
       \brief Get the allocated object
-      \return pointer to object, nullptr if allocation failed
+      \return pointer to object, nullptr if moved out
     */
-    T* get() const { return ptr_; }
-    
+    T * get() const { return M_ptr; }
+
     /*!
-      \brief Check if allocation was successful
-      \return true if allocation succeeded
+      \brief Check if the object is held
+      \return true if the object is held
     */
-    explicit operator bool() const { return ptr_ != nullptr; }
-    
+    explicit operator bool() const { return M_ptr != nullptr; }
+
     /*!
       \brief Dereference operator
       \return reference to allocated object
     */
-    T& operator*() { return *ptr_; }
-    
+    T & operator*() { return *M_ptr; }
+
     /*!
       \brief Arrow operator
       \return pointer to allocated object
     */
-    T* operator->() { return ptr_; }
+    T * operator->() { return M_ptr; }
 };
 
 /*!
   \brief Global memory pools for common types
 */
 namespace global_pools {
-    extern MemoryPool<char, 4096> string_pool;
-    extern MemoryPool<int, 1024> int_pool;
-    extern MemoryPool<double, 1024> double_pool;
+extern SharedMemoryPool< char, 4096 > string_pool;
+extern SharedMemoryPool< int, 1024 > int_pool;
+extern SharedMemoryPool< double, 1024 > double_pool;
 }
 
 } // namespace rcsc
 
-#endif // RCSC_UTIL_MEMORY_POOL_H 
\ No newline at end of file
+#endif // RCSC_UTIL_MEMORY_POOL_H
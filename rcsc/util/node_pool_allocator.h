@@ -0,0 +1,235 @@
+// -*-c++-*-
+
+/*!
+  \file node_pool_allocator.h
+  \brief free-list based allocator for node based containers Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_UTIL_NODE_POOL_ALLOCATOR_H
+#define RCSC_UTIL_NODE_POOL_ALLOCATOR_H
+
+#include <new>
+#include <cstddef>
+
+namespace rcsc {
+
+/*!
+  \class NodePool
+  \brief fixed size memory chunk pool shared by all NodePoolAllocator of the same node type.
+
+  Released nodes are kept in the free list and reused by the next allocation.
+  The memory is never returned to the system, so that containers destroyed
+  during the static destruction can still release their nodes safely.
+
+  Each thread has its own pool, so the agents running in the same process
+  (e.g. TeamRunner) do not contend on a lock. A node released by another
+  thread is pushed to the free list of the releasing thread. This is safe
+  because the memory is never returned. The free nodes of an exited thread
+  are not reused.
+*/
+template < std::size_t NodeSize, std::size_t NodeAlign >
+class NodePool {
+private:
+
+    //! free list node. overlaid on the released memory
+    union Slot {
+        Slot * next_;
+        alignas( NodeAlign ) unsigned char data_[NodeSize];
+    };
+
+    //! number of nodes allocated at once
+    static constexpr std::size_t CHUNK_SIZE = 32;
+
+    Slot * M_free_list; //!< head of the free list
+
+    std::size_t M_capacity; //!< total number of nodes allocated by this thread
+    std::ptrdiff_t M_used; //!< number of nodes allocated minus released in this thread
+
+    NodePool()
+        : M_free_list( nullptr ),
+          M_capacity( 0 ),
+          M_used( 0 )
+      { }
+
+    NodePool( const NodePool & ) = delete;
+    NodePool & operator=( const NodePool & ) = delete;
+
+    /*!
+      \brief allocate a new chunk and push its nodes to the free list
+    */
+    void grow()
+      {
+          Slot * chunk = static_cast< Slot * >( ::operator new( sizeof( Slot ) * CHUNK_SIZE ) );
+          for ( std::size_t i = 0; i < CHUNK_SIZE; ++i )
+          {
+              chunk[i].next_ = M_free_list;
+              M_free_list = &chunk[i];
+          }
+          M_capacity += CHUNK_SIZE;
+      }
+
+public:
+
+    /*!
+      \brief get the pool instance of the calling thread.
+      \return reference to the pool instance.
+
+      The instance is intentionally never destroyed.
+    */
+    static
+    NodePool & instance()
+      {
+          static thread_local NodePool * s_instance = new NodePool();
+          return *s_instance;
+      }
+
+    /*!
+      \brief get a node memory
+      \return pointer to the uninitialized memory
+    */
+    void * allocate()
+      {
+          if ( ! M_free_list )
+          {
+              grow();
+          }
+
+          Slot * s = M_free_list;
+          M_free_list = s->next_;
+          ++M_used;
+          return s;
+      }
+
+    /*!
+      \brief release the node memory to the free list
+      \param p pointer returned by allocate()
+    */
+    void deallocate( void * p )
+      {
+          Slot * s = static_cast< Slot * >( p );
+          s->next_ = M_free_list;
+          M_free_list = s;
+          --M_used;
+      }
+
+    /*!
+      \brief get the total number of nodes allocated by the calling thread
+      \return node count
+    */
+    std::size_t capacity() const
+      {
+          return M_capacity;
+      }
+
+    /*!
+      \brief get the number of nodes allocated minus released in the calling thread
+      \return node count. negative if this thread released more nodes of the other threads.
+    */
+    std::ptrdiff_t used() const
+      {
+          return M_used;
+      }
+};
+
+/*!
+  \class NodePoolAllocator
+  \brief stateless allocator for std::list and other node based containers.
+
+  Single element allocation is served from the NodePool of the rebound node type.
+  All instances compare equal, so containers using this allocator can splice
+  their nodes each other. The address of each element is stable during its lifetime.
+*/
+template < typename T >
+class NodePoolAllocator {
+public:
+    typedef T value_type;
+
+    template < typename U >
+    struct rebind {
+        typedef NodePoolAllocator< U > other;
+    };
+
+    typedef NodePool< sizeof( T ), alignof( T ) > Pool;
+
+    NodePoolAllocator() noexcept
+      { }
+
+    template < typename U >
+    NodePoolAllocator( const NodePoolAllocator< U > & ) noexcept
+      { }
+
+    /*!
+      \brief allocate the memory for n elements
+      \param n number of elements
+      \return pointer to the uninitialized memory
+    */
+    T * allocate( const std::size_t n )
+      {
+          if ( n == 1 )
+          {
+              return static_cast< T * >( Pool::instance().allocate() );
+          }
+          return static_cast< T * >( ::operator new( n * sizeof( T ) ) );
+      }
+
+    /*!
+      \brief release the memory
+      \param p pointer returned by allocate()
+      \param n number of elements
+    */
+    void deallocate( T * p,
+                     const std::size_t n ) noexcept
+      {
+          if ( n == 1 )
+          {
+              Pool::instance().deallocate( p );
+              return;
+          }
+          ::operator delete( p );
+      }
+
+    // defined as hidden friends not to hide the global comparison operators
+    // (e.g. for Vector2D) from the lookup inside namespace rcsc.
+
+    friend
+    bool operator==( const NodePoolAllocator &,
+                     const NodePoolAllocator & ) noexcept
+      {
+          return true;
+      }
+
+    friend
+    bool operator!=( const NodePoolAllocator &,
+                     const NodePoolAllocator & ) noexcept
+      {
+          return false;
+      }
+};
+
+}
+
+#endif
@@ -35,9 +35,392 @@
 
 #include "performance_monitor.h"
 
+#include <algorithm>
+#include <thread>
+#include <cmath>
+
 namespace rcsc {
 
+constexpr std::size_t PerformanceMonitor::MAX_TIMERS;
+constexpr std::size_t PerformanceMonitor::MAX_COUNTERS;
+constexpr std::uint32_t PerformanceMonitor::INVALID_ID;
+constexpr std::size_t PerformanceMonitor::HISTOGRAM_SUB_BITS;
+constexpr std::size_t PerformanceMonitor::HISTOGRAM_MAX_EXP;
+constexpr std::size_t PerformanceMonitor::HISTOGRAM_SIZE;
+
 // Global performance monitor instance
 PerformanceMonitor g_performance_monitor;
 
-} // namespace rcsc 
\ No newline at end of file
+namespace {
+
+std::uint64_t
+next_serial()
+{
+    static std::atomic<std::uint64_t> s_serial{0};
+    return s_serial.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+#ifdef RCSC_PERF_USE_TSC
+/*!
+  \struct ClockBase
+  \brief the pair of the ticks taken at the library load time
+*/
+struct ClockBase {
+    std::uint64_t tick_;
+    std::chrono::steady_clock::time_point time_;
+
+    ClockBase()
+        : tick_(__rdtsc()),
+          time_(std::chrono::steady_clock::now()) {
+    }
+};
+
+const ClockBase g_clock_base;
+#endif
+
+/*!
+  \brief get the lower bound tick of the histogram bucket
+*/
+double
+bucket_lower(const std::size_t index)
+{
+    constexpr std::size_t sub = std::size_t(1) << PerformanceMonitor::HISTOGRAM_SUB_BITS;
+    if (index < sub) {
+        return static_cast<double>(index);
+    }
+
+    const std::size_t e = (index >> PerformanceMonitor::HISTOGRAM_SUB_BITS)
+        + PerformanceMonitor::HISTOGRAM_SUB_BITS - 1;
+    const std::size_t m = index & (sub - 1);
+    return std::ldexp(static_cast<double>(sub + m),
+                      static_cast<int>(e - PerformanceMonitor::HISTOGRAM_SUB_BITS));
+}
+
+/*!
+  \brief estimate the percentile by the merged histogram
+  \return tick value. the middle of the bucket clamped by the observed range.
+*/
+double
+percentile(const std::vector<std::uint64_t>& histogram,
+           const std::uint64_t count,
+           const double q,
+           const double min_tick,
+           const double max_tick)
+{
+    const std::uint64_t rank = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(count))));
+
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < histogram.size(); ++i) {
+        sum += histogram[i];
+        if (sum >= rank) {
+            const double lower = bucket_lower(i);
+            const double upper = (i + 1 < histogram.size()
+                                  ? bucket_lower(i + 1)
+                                  : max_tick + 1.0);
+            const double mid = (lower + upper - 1.0) * 0.5;
+            return std::min(max_tick, std::max(min_tick, mid));
+        }
+    }
+
+    return max_tick;
+}
+
+} // namespace
+
+/*-------------------------------------------------------------------*/
+double
+PerformanceMonitor::Clock::nanosecondsPerTick()
+{
+#ifdef RCSC_PERF_USE_TSC
+    // calibrate the time stamp counter by the elapsed time since the library load.
+    // the first call within 10 ms after the load waits the calibration period.
+    std::uint64_t tick = __rdtsc();
+    std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
+    while (time - g_clock_base.time_ < std::chrono::milliseconds(10)) {
+        std::this_thread::yield();
+        tick = __rdtsc();
+        time = std::chrono::steady_clock::now();
+    }
+
+    const double ns = std::chrono::duration<double, std::nano>(time - g_clock_base.time_).count();
+    return tick > g_clock_base.tick_
+        ? ns / static_cast<double>(tick - g_clock_base.tick_)
+        : 1.0;
+#else
+    return 1.0;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+PerformanceMonitor::ThreadData::~ThreadData() {
+    for (std::atomic<TimerSlot*>& slot : timers) {
+        delete slot.load(std::memory_order_relaxed);
+    }
+}
+
+/*-------------------------------------------------------------------*/
+PerformanceMonitor::PerformanceMonitor()
+    : serial_(next_serial()) {
+}
+
+/*-------------------------------------------------------------------*/
+PerformanceMonitor::~PerformanceMonitor() {
+}
+
+/*-------------------------------------------------------------------*/
+PerformanceMonitor::TimerId
+PerformanceMonitor::timerId(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = timer_ids_.find(name);
+    if (it != timer_ids_.end()) {
+        return it->second;
+    }
+
+    if (timer_names_.size() >= MAX_TIMERS) {
+        return INVALID_ID;
+    }
+
+    const TimerId id = static_cast<TimerId>(timer_names_.size());
+    timer_names_.push_back(name);
+    timer_ids_.emplace(name, id);
+    return id;
+}
+
+/*-------------------------------------------------------------------*/
+PerformanceMonitor::CounterId
+PerformanceMonitor::counterId(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = counter_ids_.find(name);
+    if (it != counter_ids_.end()) {
+        return it->second;
+    }
+
+    if (counter_names_.size() >= MAX_COUNTERS) {
+        return INVALID_ID;
+    }
+
+    const CounterId id = static_cast<CounterId>(counter_names_.size());
+    counter_names_.push_back(name);
+    counter_ids_.emplace(name, id);
+    return id;
+}
+
+/*-------------------------------------------------------------------*/
+PerformanceMonitor::ThreadData*
+PerformanceMonitor::registerThread() {
+    // called at the first sample of the thread, or when the thread switches
+    // between several monitors.
+    const std::thread::id owner = std::this_thread::get_id();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const std::unique_ptr<ThreadData>& data : threads_) {
+        if (data->owner == owner) {
+            return data.get();
+        }
+    }
+
+    std::unique_ptr<ThreadData> data(new ThreadData());
+    data->owner = owner;
+    data->generation.store(generation_.load(std::memory_order_relaxed),
+                           std::memory_order_relaxed);
+    threads_.push_back(std::move(data));
+    return threads_.back().get();
+}
+
+/*-------------------------------------------------------------------*/
+PerformanceMonitor::TimerSlot*
+PerformanceMonitor::createSlot(ThreadData* data,
+                               TimerId id) {
+    TimerSlot* slot = new TimerSlot();
+    data->timers[id].store(slot, std::memory_order_release);
+    return slot;
+}
+
+/*-------------------------------------------------------------------*/
+void
+PerformanceMonitor::clearThreadData(ThreadData* data,
+                                    std::uint64_t generation) {
+    for (std::atomic<TimerSlot*>& s : data->timers) {
+        TimerSlot* slot = s.load(std::memory_order_relaxed);
+        if (!slot) {
+            continue;
+        }
+
+        slot->call_count.store(0, std::memory_order_relaxed);
+        slot->total_ticks.store(0, std::memory_order_relaxed);
+        slot->min_ticks.store(UINT64_MAX, std::memory_order_relaxed);
+        slot->max_ticks.store(0, std::memory_order_relaxed);
+        for (std::atomic<std::uint64_t>& h : slot->histogram) {
+            h.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    for (std::atomic<std::uint64_t>& c : data->counters) {
+        c.store(0, std::memory_order_relaxed);
+    }
+
+    data->generation.store(generation, std::memory_order_release);
+}
+
+/*-------------------------------------------------------------------*/
+std::uint64_t
+PerformanceMonitor::getCount(CounterId id) const {
+    if (id >= MAX_COUNTERS) {
+        return 0;
+    }
+
+    const std::uint64_t gen = generation_.load(std::memory_order_acquire);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::uint64_t result = 0;
+    for (const std::unique_ptr<ThreadData>& data : threads_) {
+        if (data->generation.load(std::memory_order_acquire) == gen) {
+            result += data->counters[id].load(std::memory_order_relaxed);
+        }
+    }
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+std::uint64_t
+PerformanceMonitor::getCount(const std::string& name) const {
+    CounterId id = INVALID_ID;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = counter_ids_.find(name);
+        if (it == counter_ids_.end()) {
+            return 0;
+        }
+        id = it->second;
+    }
+
+    return getCount(id);
+}
+
+/*-------------------------------------------------------------------*/
+bool
+PerformanceMonitor::getTimerStats(TimerId id,
+                                  TimerStats* stats) const {
+    *stats = TimerStats();
+
+    if (id >= MAX_TIMERS) {
+        return false;
+    }
+
+    const std::uint64_t gen = generation_.load(std::memory_order_acquire);
+
+    std::uint64_t count = 0;
+    std::uint64_t total = 0;
+    std::uint64_t min_tick = UINT64_MAX;
+    std::uint64_t max_tick = 0;
+    std::vector<std::uint64_t> histogram(HISTOGRAM_SIZE, 0);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const std::unique_ptr<ThreadData>& data : threads_) {
+            if (data->generation.load(std::memory_order_acquire) != gen) {
+                continue;
+            }
+
+            const TimerSlot* slot = data->timers[id].load(std::memory_order_acquire);
+            if (!slot) {
+                continue;
+            }
+
+            count += slot->call_count.load(std::memory_order_relaxed);
+            total += slot->total_ticks.load(std::memory_order_relaxed);
+            min_tick = std::min(min_tick, slot->min_ticks.load(std::memory_order_relaxed));
+            max_tick = std::max(max_tick, slot->max_ticks.load(std::memory_order_relaxed));
+            for (std::size_t i = 0; i < HISTOGRAM_SIZE; ++i) {
+                histogram[i] += slot->histogram[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    if (count == 0) {
+        return false;
+    }
+
+    const double ns = Clock::nanosecondsPerTick();
+    const double min_d = static_cast<double>(std::min(min_tick, max_tick));
+    const double max_d = static_cast<double>(max_tick);
+
+    stats->call_count = count;
+    stats->total_nanoseconds = static_cast<double>(total) * ns;
+    stats->min_nanoseconds = min_d * ns;
+    stats->max_nanoseconds = max_d * ns;
+    stats->p50_nanoseconds = percentile(histogram, count, 0.5, min_d, max_d) * ns;
+    stats->p99_nanoseconds = percentile(histogram, count, 0.99, min_d, max_d) * ns;
+    stats->p999_nanoseconds = percentile(histogram, count, 0.999, min_d, max_d) * ns;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+bool
+PerformanceMonitor::getTimerStats(const std::string& name,
+                                  TimerStats* stats) const {
+    TimerId id = INVALID_ID;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = timer_ids_.find(name);
+        if (it != timer_ids_.end()) {
+            id = it->second;
+        }
+    }
+
+    return getTimerStats(id, stats);
+}
+
+/*-------------------------------------------------------------------*/
+std::vector<std::string>
+PerformanceMonitor::getTimerNames() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return timer_names_;
+}
+
+/*-------------------------------------------------------------------*/
+void
+PerformanceMonitor::reset() {
+    generation_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+/*-------------------------------------------------------------------*/
+std::string
+PerformanceMonitor::getStatistics() const {
+    std::vector<std::string> timer_names;
+    std::vector<std::string> counter_names;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        timer_names = timer_names_;
+        counter_names = counter_names_;
+    }
+
+    std::string result = "Performance Monitor Statistics:\n";
+    result += "=====================================\n";
+
+    for (std::size_t i = 0; i < timer_names.size(); ++i) {
+        TimerStats stats;
+        if (!getTimerStats(static_cast<TimerId>(i), &stats)) {
+            continue;
+        }
+
+        result += timer_names[i] + ":\n";
+        result += "  Calls: " + std::to_string(stats.call_count) + "\n";
+        result += "  Average: " + std::to_string(stats.averageNanoseconds() / 1000000.0) + " ms\n";
+        result += "  Min: " + std::to_string(stats.min_nanoseconds / 1000000.0) + " ms\n";
+        result += "  P50: " + std::to_string(stats.p50_nanoseconds / 1000000.0) + " ms\n";
+        result += "  P99: " + std::to_string(stats.p99_nanoseconds / 1000000.0) + " ms\n";
+        result += "  P99.9: " + std::to_string(stats.p999_nanoseconds / 1000000.0) + " ms\n";
+        result += "  Max: " + std::to_string(stats.max_nanoseconds / 1000000.0) + " ms\n";
+        result += "  Total: " + std::to_string(stats.total_nanoseconds / 1000000.0) + " ms\n\n";
+    }
+
+    for (std::size_t i = 0; i < counter_names.size(); ++i) {
+        result += counter_names[i] + ": "
+            + std::to_string(getCount(static_cast<CounterId>(i))) + "\n";
+    }
+
+    return result;
+}
+
+} // namespace rcsc
@@ -37,28 +37,98 @@
 #include <memory>
 #include <vector>
 #include <atomic>
+#include <thread>
+#include <cstdint>
+#include <cstddef>
+
+#if ! defined(RCSC_PERF_NO_TSC) && ( defined(__x86_64__) || defined(__i386__) )
+#define RCSC_PERF_USE_TSC 1
+#include <x86intrin.h>
+#endif
 
 namespace rcsc {
 
 /*!
   \class PerformanceMonitor
   \brief High-performance monitoring utility for profiling librcsc operations
+
+  Timers and counters are identified by the interned ids returned by
+  timerId() and counterId(). RCSC_PERF_TIMER and RCSC_PERF_COUNT intern the
+  name only once at each call site, so the hot path takes no lock and copies
+  no string.
+
+  Each thread writes its samples to its own storage. The storages of all
+  threads are merged when the statistics are read. The elapsed time is
+  measured by the time stamp counter where available (x86. disabled by
+  defining RCSC_PERF_NO_TSC), otherwise by std::chrono::steady_clock, and
+  is recorded to the log-bucketed histogram to estimate the percentiles.
 */
 class PerformanceMonitor {
 public:
+
+    //! interned timer id
+    using TimerId = std::uint32_t;
+    //! interned counter id
+    using CounterId = std::uint32_t;
+
+    //! the maximum number of timers
+    static constexpr std::size_t MAX_TIMERS = 256;
+    //! the maximum number of counters
+    static constexpr std::size_t MAX_COUNTERS = 256;
+    //! the id returned when the table is full. the samples are ignored.
+    static constexpr std::uint32_t INVALID_ID = 0xffffffffu;
+
+    //! the number of bits of the sub-buckets in each power of 2 range
+    static constexpr std::size_t HISTOGRAM_SUB_BITS = 3;
+    //! the tick values not less than 2^HISTOGRAM_MAX_EXP are put into the last bucket
+    static constexpr std::size_t HISTOGRAM_MAX_EXP = 40;
+    //! the number of histogram buckets
+    static constexpr std::size_t HISTOGRAM_SIZE
+    = ( HISTOGRAM_MAX_EXP - HISTOGRAM_SUB_BITS + 1 ) << HISTOGRAM_SUB_BITS;
+
     /*!
-      \struct TimerData
-      \brief Internal timer data structure
+      \class Clock
+      \brief low overhead tick source
     */
-    struct TimerData {
-        std::chrono::high_resolution_clock::time_point start_time;
-        std::chrono::high_resolution_clock::time_point end_time;
-        std::atomic<uint64_t> call_count{0};
-        std::atomic<uint64_t> total_nanoseconds{0};
-        std::atomic<uint64_t> min_nanoseconds{UINT64_MAX};
-        std::atomic<uint64_t> max_nanoseconds{0};
-        
-        TimerData() = default;
+    class Clock {
+    public:
+        /*!
+          \brief get the current tick
+          \return tick count. the unit depends on the platform.
+        */
+        static std::uint64_t now() {
+#ifdef RCSC_PERF_USE_TSC
+            return __rdtsc();
+#else
+            return static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch() ).count() );
+#endif
+        }
+
+        /*!
+          \brief get the length of one tick
+          \return nanoseconds per tick. calibrated against steady_clock if TSC is used.
+        */
+        static double nanosecondsPerTick();
+    };
+
+    /*!
+      \struct TimerStats
+      \brief merged statistics of a timer. all times are in nanoseconds.
+    */
+    struct TimerStats {
+        std::uint64_t call_count = 0;
+        double total_nanoseconds = 0.0;
+        double min_nanoseconds = 0.0;
+        double max_nanoseconds = 0.0;
+        double p50_nanoseconds = 0.0; //!< median estimated by the histogram
+        double p99_nanoseconds = 0.0; //!< 99th percentile estimated by the histogram
+        double p999_nanoseconds = 0.0; //!< 99.9th percentile estimated by the histogram
+
+        double averageNanoseconds() const {
+            return call_count > 0 ? total_nanoseconds / call_count : 0.0;
+        }
     };
 
     /*!
@@ -68,16 +138,28 @@ public:
     class ScopedTimer {
     private:
         PerformanceMonitor& monitor_;
-        std::string name_;
-        std::chrono::high_resolution_clock::time_point start_time_;
+        TimerId id_;
+        std::uint64_t start_tick_;
         bool active_;
 
     public:
+        ScopedTimer(PerformanceMonitor& monitor, TimerId id)
+            : monitor_(monitor),
+              id_(id),
+              start_tick_(0),
+              active_(id < MAX_TIMERS && monitor.isEnabled()) {
+            if (active_) {
+                start_tick_ = Clock::now();
+            }
+        }
+
         ScopedTimer(PerformanceMonitor& monitor, const std::string& name)
-            : monitor_(monitor), name_(name), active_(true) {
-            start_time_ = std::chrono::high_resolution_clock::now();
+            : ScopedTimer(monitor, name.empty() ? INVALID_ID : monitor.timerId(name)) {
         }
 
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
         ~ScopedTimer() {
             if (active_) {
                 stop();
@@ -86,20 +168,67 @@ public:
 
         void stop() {
             if (active_) {
-                monitor_.stopTimer(name_, start_time_);
+                monitor_.stopTimer(id_, start_tick_);
                 active_ = false;
             }
         }
     };
 
 private:
-    mutable std::mutex mutex_;
-    std::unordered_map<std::string, std::unique_ptr<TimerData>> timers_;
+
+    /*!
+      \struct TimerSlot
+      \brief per-thread samples of a timer. written only by the owner thread.
+    */
+    struct TimerSlot {
+        std::atomic<std::uint64_t> call_count{0};
+        std::atomic<std::uint64_t> total_ticks{0};
+        std::atomic<std::uint64_t> min_ticks{UINT64_MAX};
+        std::atomic<std::uint64_t> max_ticks{0};
+        std::atomic<std::uint64_t> histogram[HISTOGRAM_SIZE] = {};
+    };
+
+    /*!
+      \struct ThreadData
+      \brief storage of a thread. kept until the monitor is destroyed.
+
+      The storage of the exited thread keeps its samples, and is reused by
+      the new thread that gets the same thread id.
+    */
+    struct ThreadData {
+        std::thread::id owner; //!< id of the writer thread
+        std::atomic<std::uint64_t> generation{0}; //!< reset generation of the values
+        std::atomic<TimerSlot*> timers[MAX_TIMERS] = {}; //!< created on the first sample
+        std::atomic<std::uint64_t> counters[MAX_COUNTERS] = {};
+
+        ~ThreadData();
+    };
+
+    /*!
+      \struct LocalCache
+      \brief storage of the current thread for the last used monitor
+    */
+    struct LocalCache {
+        std::uint64_t serial;
+        ThreadData* data;
+    };
+
+    static inline thread_local LocalCache s_local_cache{0, nullptr};
+
+    const std::uint64_t serial_; //!< unique number of this monitor
     std::atomic<bool> enabled_{true};
+    std::atomic<std::uint64_t> generation_{1}; //!< incremented by reset()
+
+    mutable std::mutex mutex_; //!< guards the following registries
+    std::vector<std::string> timer_names_;
+    std::unordered_map<std::string, TimerId> timer_ids_;
+    std::vector<std::string> counter_names_;
+    std::unordered_map<std::string, CounterId> counter_ids_;
+    std::vector<std::unique_ptr<ThreadData>> threads_;
 
 public:
-    PerformanceMonitor() = default;
-    ~PerformanceMonitor() = default;
+    PerformanceMonitor();
+    ~PerformanceMonitor();
 
     // Disable copy constructor and assignment
     PerformanceMonitor(const PerformanceMonitor&) = delete;
@@ -122,7 +251,30 @@ public:
     }
 
     /*!
-      \brief Start a timer with the given name
+      \brief Get the interned id of the timer
+      \param name timer name
+      \return timer id. INVALID_ID if MAX_TIMERS timers are already registered.
+    */
+    TimerId timerId(const std::string& name);
+
+    /*!
+      \brief Get the interned id of the counter
+      \param name counter name
+      \return counter id. INVALID_ID if MAX_COUNTERS counters are already registered.
+    */
+    CounterId counterId(const std::string& name);
+
+    /*!
+      \brief Start a timer with the given id
+      \param id timer id
+      \return ScopedTimer object for RAII timing
+    */
+    ScopedTimer startTimer(TimerId id) {
+        return ScopedTimer(*this, id);
+    }
+
+    /*!
+      \brief Start a timer with the given name. the name is looked up with a lock.
       \param name timer name
       \return ScopedTimer object for RAII timing
     */
@@ -132,114 +284,205 @@ public:
 
     /*!
       \brief Stop a timer and record the elapsed time
-      \param name timer name
-      \param start_time start time from high_resolution_clock
+      \param id timer id
+      \param start_tick start tick from Clock::now()
     */
-    void stopTimer(const std::string& name, 
-                   const std::chrono::high_resolution_clock::time_point& start_time) {
-        if (!enabled_.load(std::memory_order_relaxed)) {
+    void stopTimer(TimerId id,
+                   std::uint64_t start_tick) {
+        const std::uint64_t end_tick = Clock::now();
+        if (id >= MAX_TIMERS
+            || !enabled_.load(std::memory_order_relaxed)) {
             return;
         }
 
-        auto end_time = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
-        auto nanoseconds = duration.count();
+        record(id, end_tick > start_tick ? end_tick - start_tick : 0);
+    }
 
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        auto& timer_data = timers_[name];
-        if (!timer_data) {
-            timer_data = std::make_unique<TimerData>();
+    /*!
+      \brief Record the elapsed ticks to the timer
+      \param id timer id
+      \param ticks elapsed ticks measured by Clock::now()
+    */
+    void record(TimerId id,
+                std::uint64_t ticks) {
+        if (id >= MAX_TIMERS) {
+            return;
         }
 
-        timer_data->call_count.fetch_add(1, std::memory_order_relaxed);
-        timer_data->total_nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
-        
-        // Update min/max atomically
-        uint64_t current_min = timer_data->min_nanoseconds.load(std::memory_order_relaxed);
-        while (nanoseconds < current_min && 
-               !timer_data->min_nanoseconds.compare_exchange_weak(current_min, nanoseconds, 
-                                                                 std::memory_order_relaxed)) {
-            // Retry if CAS failed
+        ThreadData* data = localData();
+        TimerSlot* slot = data->timers[id].load(std::memory_order_relaxed);
+        if (!slot) {
+            slot = createSlot(data, id);
         }
 
-        uint64_t current_max = timer_data->max_nanoseconds.load(std::memory_order_relaxed);
-        while (nanoseconds > current_max && 
-               !timer_data->max_nanoseconds.compare_exchange_weak(current_max, nanoseconds, 
-                                                                 std::memory_order_relaxed)) {
-            // Retry if CAS failed
+        bump(slot->call_count, 1);
+        bump(slot->total_ticks, ticks);
+        if (ticks < slot->min_ticks.load(std::memory_order_relaxed)) {
+            slot->min_ticks.store(ticks, std::memory_order_relaxed);
+        }
+        if (ticks > slot->max_ticks.load(std::memory_order_relaxed)) {
+            slot->max_ticks.store(ticks, std::memory_order_relaxed);
         }
+        bump(slot->histogram[bucketIndex(ticks)], 1);
     }
 
     /*!
-      \brief Get timer statistics
-      \param name timer name
-      \return TimerData pointer, nullptr if timer doesn't exist
+      \brief Record an externally measured duration to the timer
+      (e.g. the network latency measured by the packet timestamps)
+      \param id timer id
+      \param nanoseconds duration in nanoseconds. negative values are ignored.
     */
-    const TimerData* getTimerData(const std::string& name) const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = timers_.find(name);
-        return (it != timers_.end()) ? it->second.get() : nullptr;
+    void recordNanoseconds(TimerId id,
+                           std::int64_t nanoseconds) {
+        if (id >= MAX_TIMERS
+            || nanoseconds < 0
+            || !enabled_.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        record(id, static_cast<std::uint64_t>(static_cast<double>(nanoseconds)
+                                              / Clock::nanosecondsPerTick()));
     }
 
     /*!
-      \brief Get all timer names
-      \return vector of timer names
+      \brief Add a value to the event counter (e.g. cache hit/miss)
+      \param id counter id
+      \param value value to be added
     */
-    std::vector<std::string> getTimerNames() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        std::vector<std::string> names;
-        names.reserve(timers_.size());
-        for (const auto& pair : timers_) {
-            names.push_back(pair.first);
+    void addCount(CounterId id, std::uint64_t value = 1) {
+        if (id >= MAX_COUNTERS
+            || !enabled_.load(std::memory_order_relaxed)) {
+            return;
         }
-        return names;
+
+        bump(localData()->counters[id], value);
     }
 
     /*!
-      \brief Reset all timers
+      \brief Add a value to the named event counter. the name is looked up with a lock.
+      \param name counter name
+      \param value value to be added
     */
-    void reset() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        timers_.clear();
+    void addCount(const std::string& name, std::uint64_t value = 1) {
+        if (!enabled_.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        addCount(counterId(name), value);
     }
 
+    /*!
+      \brief Get the merged value of the event counter
+      \param id counter id
+      \return counter value
+    */
+    std::uint64_t getCount(CounterId id) const;
+
+    /*!
+      \brief Get the merged value of the named event counter
+      \param name counter name
+      \return counter value, 0 if counter doesn't exist
+    */
+    std::uint64_t getCount(const std::string& name) const;
+
+    /*!
+      \brief Get the merged timer statistics
+      \param id timer id
+      \param stats pointer to the result variable
+      \return false if the timer has no sample
+    */
+    bool getTimerStats(TimerId id, TimerStats* stats) const;
+
+    /*!
+      \brief Get the merged timer statistics
+      \param name timer name
+      \param stats pointer to the result variable
+      \return false if the timer doesn't exist or has no sample
+    */
+    bool getTimerStats(const std::string& name, TimerStats* stats) const;
+
+    /*!
+      \brief Get all timer names
+      \return vector of timer names
+    */
+    std::vector<std::string> getTimerNames() const;
+
+    /*!
+      \brief Reset all timers and counters. the ids are kept.
+
+      The storage of each thread is cleared by its owner thread on the next
+      sample. The samples recorded concurrently with reset() may be lost.
+    */
+    void reset();
+
     /*!
       \brief Get formatted statistics as string
       \return formatted statistics string
     */
-    std::string getStatistics() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        std::string result = "Performance Monitor Statistics:\n";
-        result += "=====================================\n";
-        
-        for (const auto& pair : timers_) {
-            const auto& name = pair.first;
-            const auto& data = pair.second;
-            
-            uint64_t count = data->call_count.load(std::memory_order_relaxed);
-            uint64_t total = data->total_nanoseconds.load(std::memory_order_relaxed);
-            uint64_t min_ns = data->min_nanoseconds.load(std::memory_order_relaxed);
-            uint64_t max_ns = data->max_nanoseconds.load(std::memory_order_relaxed);
-            
-            if (count == 0) continue;
-            
-            double avg_ns = static_cast<double>(total) / count;
-            double avg_ms = avg_ns / 1000000.0;
-            double min_ms = min_ns / 1000000.0;
-            double max_ms = max_ns / 1000000.0;
-            
-            result += name + ":\n";
-            result += "  Calls: " + std::to_string(count) + "\n";
-            result += "  Average: " + std::to_string(avg_ms) + " ms\n";
-            result += "  Min: " + std::to_string(min_ms) + " ms\n";
-            result += "  Max: " + std::to_string(max_ms) + " ms\n";
-            result += "  Total: " + std::to_string(total / 1000000.0) + " ms\n\n";
+    std::string getStatistics() const;
+
+    /*!
+      \brief Get the histogram bucket of the tick value
+      \param ticks tick value
+      \return bucket index [0, HISTOGRAM_SIZE)
+    */
+    static std::size_t bucketIndex(std::uint64_t ticks) {
+        constexpr std::uint64_t sub = std::uint64_t(1) << HISTOGRAM_SUB_BITS;
+        if (ticks < sub) {
+            return static_cast<std::size_t>(ticks);
+        }
+
+        const std::size_t e = highestBit(ticks);
+        if (e >= HISTOGRAM_MAX_EXP) {
+            return HISTOGRAM_SIZE - 1;
         }
-        
-        return result;
+
+        return ((e - HISTOGRAM_SUB_BITS + 1) << HISTOGRAM_SUB_BITS)
+            + static_cast<std::size_t>((ticks >> (e - HISTOGRAM_SUB_BITS)) & (sub - 1));
+    }
+
+private:
+
+    static std::size_t highestBit(std::uint64_t v) {
+#if defined(__GNUC__)
+        return 63 - static_cast<std::size_t>(__builtin_clzll(v));
+#else
+        std::size_t e = 0;
+        while (v >>= 1) {
+            ++e;
+        }
+        return e;
+#endif
+    }
+
+    /*!
+      \brief add the value to the single writer variable without the locked instruction
+    */
+    static void bump(std::atomic<std::uint64_t>& v,
+                     std::uint64_t value) {
+        v.store(v.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
     }
+
+    /*!
+      \brief get the storage of the current thread
+    */
+    ThreadData* localData() {
+        LocalCache& cache = s_local_cache;
+        if (cache.serial != serial_) {
+            cache.data = registerThread();
+            cache.serial = serial_;
+        }
+
+        const std::uint64_t gen = generation_.load(std::memory_order_relaxed);
+        if (cache.data->generation.load(std::memory_order_relaxed) != gen) {
+            clearThreadData(cache.data, gen);
+        }
+        return cache.data;
+    }
+
+    ThreadData* registerThread();
+    static TimerSlot* createSlot(ThreadData* data, TimerId id);
+    static void clearThreadData(ThreadData* data, std::uint64_t generation);
 };
 
 /*!
@@ -248,11 +491,14 @@ public:
 extern PerformanceMonitor g_performance_monitor;
 
 /*!
-  \brief Macro for easy performance monitoring
+  \brief Macro for easy performance monitoring. the name is interned once.
   \param name timer name
 */
 #define RCSC_PERF_TIMER(name) \
-    auto perf_timer_##name = rcsc::g_performance_monitor.startTimer(#name)
+    static const rcsc::PerformanceMonitor::TimerId perf_timer_id_##name \
+        = rcsc::g_performance_monitor.timerId(#name); \
+    rcsc::PerformanceMonitor::ScopedTimer perf_timer_##name(rcsc::g_performance_monitor, \
+                                                            perf_timer_id_##name)
 
 /*!
   \brief Macro for conditional performance monitoring
@@ -260,9 +506,37 @@ extern PerformanceMonitor g_performance_monitor;
   \param condition condition to enable timing
 */
 #define RCSC_PERF_TIMER_IF(name, condition) \
-    auto perf_timer_##name = (condition) ? rcsc::g_performance_monitor.startTimer(#name) : \
-                                          rcsc::PerformanceMonitor::ScopedTimer(rcsc::g_performance_monitor, "")
+    static const rcsc::PerformanceMonitor::TimerId perf_timer_id_##name \
+        = rcsc::g_performance_monitor.timerId(#name); \
+    rcsc::PerformanceMonitor::ScopedTimer perf_timer_##name(rcsc::g_performance_monitor, \
+                                                            (condition) \
+                                                            ? perf_timer_id_##name \
+                                                            : rcsc::PerformanceMonitor::INVALID_ID)
+
+/*!
+  \brief Macro for the externally measured duration. the name string is interned once.
+  \param name timer name string
+  \param nanoseconds duration in nanoseconds
+*/
+#define RCSC_PERF_RECORD_NSEC(name, nanoseconds) \
+    do { \
+        static const rcsc::PerformanceMonitor::TimerId perf_record_id \
+            = rcsc::g_performance_monitor.timerId(name); \
+        rcsc::g_performance_monitor.recordNanoseconds(perf_record_id, (nanoseconds)); \
+    } while (0)
+
+/*!
+  \brief Macro for the event counter. the name string is interned once.
+  \param name counter name string
+  \param value value to be added
+*/
+#define RCSC_PERF_COUNT(name, value) \
+    do { \
+        static const rcsc::PerformanceMonitor::CounterId perf_counter_id \
+            = rcsc::g_performance_monitor.counterId(name); \
+        rcsc::g_performance_monitor.addCount(perf_counter_id, (value)); \
+    } while (0)
 
 } // namespace rcsc
 
-#endif // RCSC_UTIL_PERFORMANCE_MONITOR_H 
\ No newline at end of file
+#endif // RCSC_UTIL_PERFORMANCE_MONITOR_H
@@ -0,0 +1,295 @@
+// -*-c++-*-
+
+/*!
+  \file playmode_decoder.cpp
+  \brief playmode and referee message decoder Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "playmode_decoder.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+using rcsc::GameMode;
+using rcsc::PlayModeInfo;
+
+/*!
+  \struct Entry
+  \brief referee message table entry
+*/
+struct Entry {
+    const char * name_; //!< message name without the number suffix
+    std::size_t len_; //!< length of name_
+    PlayModeInfo::Kind kind_;
+    GameMode::Type type_;
+    rcsc::SideID side_;
+    rcsc::PlayMode pmode_;
+    bool has_value_; //!< true if the message can have the "_<number>" suffix
+};
+
+/*-------------------------------------------------------------------*/
+constexpr
+Entry
+entry( const char * name,
+       const PlayModeInfo::Kind kind,
+       const GameMode::Type type,
+       const rcsc::SideID side,
+       const rcsc::PlayMode pmode,
+       const bool has_value = false )
+{
+    std::size_t len = 0;
+    while ( name[len] != '\0' ) ++len;
+    return Entry{ name, len, kind, type, side, pmode, has_value };
+}
+
+constexpr PlayModeInfo::Kind PM = PlayModeInfo::PLAYMODE;
+
+constexpr Entry ENTRIES[] = {
+    entry( "before_kick_off", PM, GameMode::BeforeKickOff, rcsc::NEUTRAL, rcsc::PM_BeforeKickOff ),
+    entry( "time_over", PM, GameMode::TimeOver, rcsc::NEUTRAL, rcsc::PM_TimeOver ),
+    entry( "play_on", PM, GameMode::PlayOn, rcsc::NEUTRAL, rcsc::PM_PlayOn ),
+    entry( "kick_off_l", PM, GameMode::KickOff_, rcsc::LEFT, rcsc::PM_KickOff_Left ),
+    entry( "kick_off_r", PM, GameMode::KickOff_, rcsc::RIGHT, rcsc::PM_KickOff_Right ),
+    entry( "kick_in_l", PM, GameMode::KickIn_, rcsc::LEFT, rcsc::PM_KickIn_Left ),
+    entry( "kick_in_r", PM, GameMode::KickIn_, rcsc::RIGHT, rcsc::PM_KickIn_Right ),
+    entry( "free_kick_l", PM, GameMode::FreeKick_, rcsc::LEFT, rcsc::PM_FreeKick_Left ),
+    entry( "free_kick_r", PM, GameMode::FreeKick_, rcsc::RIGHT, rcsc::PM_FreeKick_Right ),
+    entry( "corner_kick_l", PM, GameMode::CornerKick_, rcsc::LEFT, rcsc::PM_CornerKick_Left ),
+    entry( "corner_kick_r", PM, GameMode::CornerKick_, rcsc::RIGHT, rcsc::PM_CornerKick_Right ),
+    entry( "goal_kick_l", PM, GameMode::GoalKick_, rcsc::LEFT, rcsc::PM_GoalKick_Left ),
+    entry( "goal_kick_r", PM, GameMode::GoalKick_, rcsc::RIGHT, rcsc::PM_GoalKick_Right ),
+    entry( "goal_l", PM, GameMode::AfterGoal_, rcsc::LEFT, rcsc::PM_AfterGoal_Left, true ), // "goal_l_<SCORE>"
+    entry( "goal_r", PM, GameMode::AfterGoal_, rcsc::RIGHT, rcsc::PM_AfterGoal_Right, true ), // "goal_r_<SCORE>"
+    entry( "drop_ball", PM, GameMode::PlayOn, rcsc::NEUTRAL, rcsc::PM_Drop_Ball ),
+    entry( "offside_l", PM, GameMode::OffSide_, rcsc::LEFT, rcsc::PM_OffSide_Left ),
+    entry( "offside_r", PM, GameMode::OffSide_, rcsc::RIGHT, rcsc::PM_OffSide_Right ),
+    entry( "penalty_kick_l", PM, GameMode::PenaltyKick_, rcsc::LEFT, rcsc::PM_PK_Left ),
+    entry( "penalty_kick_r", PM, GameMode::PenaltyKick_, rcsc::RIGHT, rcsc::PM_PK_Right ),
+    entry( "first_half_over", PM, GameMode::FirstHalfOver, rcsc::NEUTRAL, rcsc::PM_FirstHalfOver ),
+    entry( "pause", PM, GameMode::Pause, rcsc::NEUTRAL, rcsc::PM_Pause ),
+    entry( "human_judge", PM, GameMode::Human, rcsc::NEUTRAL, rcsc::PM_Human ),
+    entry( "foul_charge_l", PM, GameMode::FoulCharge_, rcsc::LEFT, rcsc::PM_Foul_Charge_Left ),
+    entry( "foul_charge_r", PM, GameMode::FoulCharge_, rcsc::RIGHT, rcsc::PM_Foul_Charge_Right ),
+    entry( "foul_push_l", PM, GameMode::FoulPush_, rcsc::LEFT, rcsc::PM_Foul_Push_Left ),
+    entry( "foul_push_r", PM, GameMode::FoulPush_, rcsc::RIGHT, rcsc::PM_Foul_Push_Right ),
+    entry( "foul_multiple_attack_l", PM, GameMode::FoulMultipleAttacker_, rcsc::LEFT, rcsc::PM_Foul_MultipleAttacker_Left ),
+    entry( "foul_multiple_attack_r", PM, GameMode::FoulMultipleAttacker_, rcsc::RIGHT, rcsc::PM_Foul_MultipleAttacker_Right ),
+    entry( "foul_ballout_l", PM, GameMode::FoulBallOut_, rcsc::LEFT, rcsc::PM_Foul_BallOut_Left ),
+    entry( "foul_ballout_r", PM, GameMode::FoulBallOut_, rcsc::RIGHT, rcsc::PM_Foul_BallOut_Right ),
+    entry( "back_pass_l", PM, GameMode::BackPass_, rcsc::LEFT, rcsc::PM_Back_Pass_Left ),
+    entry( "back_pass_r", PM, GameMode::BackPass_, rcsc::RIGHT, rcsc::PM_Back_Pass_Right ),
+    entry( "free_kick_fault_l", PM, GameMode::FreeKickFault_, rcsc::LEFT, rcsc::PM_Free_Kick_Fault_Left ),
+    entry( "free_kick_fault_r", PM, GameMode::FreeKickFault_, rcsc::RIGHT, rcsc::PM_Free_Kick_Fault_Right ),
+    entry( "catch_fault_l", PM, GameMode::CatchFault_, rcsc::LEFT, rcsc::PM_CatchFault_Left ),
+    entry( "catch_fault_r", PM, GameMode::CatchFault_, rcsc::RIGHT, rcsc::PM_CatchFault_Right ),
+    entry( "indirect_free_kick_l", PM, GameMode::IndFreeKick_, rcsc::LEFT, rcsc::PM_IndFreeKick_Left ),
+    entry( "indirect_free_kick_r", PM, GameMode::IndFreeKick_, rcsc::RIGHT, rcsc::PM_IndFreeKick_Right ),
+    entry( "penalty_setup_l", PM, GameMode::PenaltySetup_, rcsc::LEFT, rcsc::PM_PenaltySetup_Left ),
+    entry( "penalty_setup_r", PM, GameMode::PenaltySetup_, rcsc::RIGHT, rcsc::PM_PenaltySetup_Right ),
+    entry( "penalty_ready_l", PM, GameMode::PenaltyReady_, rcsc::LEFT, rcsc::PM_PenaltyReady_Left ),
+    entry( "penalty_ready_r", PM, GameMode::PenaltyReady_, rcsc::RIGHT, rcsc::PM_PenaltyReady_Right ),
+    entry( "penalty_taken_l", PM, GameMode::PenaltyTaken_, rcsc::LEFT, rcsc::PM_PenaltyTaken_Left ),
+    entry( "penalty_taken_r", PM, GameMode::PenaltyTaken_, rcsc::RIGHT, rcsc::PM_PenaltyTaken_Right ),
+    entry( "penalty_miss_l", PM, GameMode::PenaltyMiss_, rcsc::LEFT, rcsc::PM_PenaltyMiss_Left ),
+    entry( "penalty_miss_r", PM, GameMode::PenaltyMiss_, rcsc::RIGHT, rcsc::PM_PenaltyMiss_Right ),
+    entry( "penalty_score_l", PM, GameMode::PenaltyScore_, rcsc::LEFT, rcsc::PM_PenaltyScore_Left ),
+    entry( "penalty_score_r", PM, GameMode::PenaltyScore_, rcsc::RIGHT, rcsc::PM_PenaltyScore_Right ),
+    entry( "illegal_defense_l", PM, GameMode::IllegalDefense_, rcsc::LEFT, rcsc::PM_Illegal_Defense_Left ),
+    entry( "illegal_defense_r", PM, GameMode::IllegalDefense_, rcsc::RIGHT, rcsc::PM_Illegal_Defense_Right ),
+    // extended playmodes that are not written in the game log
+    entry( "half_time", PM, GameMode::FirstHalfOver, rcsc::NEUTRAL, rcsc::PM_Null ),
+    entry( "time_extended", PM, GameMode::ExtendHalf, rcsc::NEUTRAL, rcsc::PM_Null ),
+    entry( "time_up_without_a_team", PM, GameMode::TimeOver, rcsc::NEUTRAL, rcsc::PM_Null ),
+    entry( "time_up", PM, GameMode::TimeOver, rcsc::NEUTRAL, rcsc::PM_Null ),
+    entry( "foul_l", PM, GameMode::FreeKick_, rcsc::RIGHT, rcsc::PM_Null ),
+    entry( "foul_r", PM, GameMode::FreeKick_, rcsc::LEFT, rcsc::PM_Null ),
+    entry( "goalie_catch_ball_l", PM, GameMode::GoalieCatch_, rcsc::LEFT, rcsc::PM_Null ),
+    entry( "goalie_catch_ball_r", PM, GameMode::GoalieCatch_, rcsc::RIGHT, rcsc::PM_Null ),
+    entry( "penalty_onfield_l", PM, GameMode::PenaltyOnfield_, rcsc::LEFT, rcsc::PM_Null ),
+    entry( "penalty_onfield_r", PM, GameMode::PenaltyOnfield_, rcsc::RIGHT, rcsc::PM_Null ),
+    entry( "penalty_foul_l", PM, GameMode::PenaltyFoul_, rcsc::LEFT, rcsc::PM_Null ),
+    entry( "penalty_foul_r", PM, GameMode::PenaltyFoul_, rcsc::RIGHT, rcsc::PM_Null ),
+    entry( "penalty_winner_l", PM, GameMode::TimeOver, rcsc::NEUTRAL, rcsc::PM_Null ),
+    entry( "penalty_winner_r", PM, GameMode::TimeOver, rcsc::NEUTRAL, rcsc::PM_Null ),
+    entry( "penalty_draw", PM, GameMode::TimeOver, rcsc::NEUTRAL, rcsc::PM_Null ),
+    // other notifications
+    entry( "yellow_card_l", PlayModeInfo::YELLOW_CARD, GameMode::MODE_MAX, rcsc::LEFT, rcsc::PM_Null, true ),
+    entry( "yellow_card_r", PlayModeInfo::YELLOW_CARD, GameMode::MODE_MAX, rcsc::RIGHT, rcsc::PM_Null, true ),
+    entry( "red_card_l", PlayModeInfo::RED_CARD, GameMode::MODE_MAX, rcsc::LEFT, rcsc::PM_Null, true ),
+    entry( "red_card_r", PlayModeInfo::RED_CARD, GameMode::MODE_MAX, rcsc::RIGHT, rcsc::PM_Null, true ),
+    entry( "training", PlayModeInfo::TRAINING, GameMode::MODE_MAX, rcsc::NEUTRAL, rcsc::PM_Null ),
+};
+
+constexpr std::size_t NUM_ENTRIES = sizeof( ENTRIES ) / sizeof( ENTRIES[0] );
+
+//! the seed is chosen so that no two entries share the same slot.
+constexpr std::uint32_t HASH_SEED = 51531;
+constexpr std::size_t TABLE_SIZE = 256;
+constexpr std::uint8_t EMPTY_SLOT = 0xff;
+
+static_assert( NUM_ENTRIES < EMPTY_SLOT, "too many referee messages" );
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief FNV-1a with the final mixing of the bits
+*/
+constexpr
+std::size_t
+hash_slot( const char * str,
+           const std::size_t len )
+{
+    std::uint32_t h = HASH_SEED;
+    for ( std::size_t i = 0; i < len; ++i )
+    {
+        h ^= static_cast< unsigned char >( str[i] );
+        h *= 16777619u;
+    }
+    h ^= h >> 16;
+    h *= 0x7feb352du;
+    h ^= h >> 15;
+    return h & ( TABLE_SIZE - 1 );
+}
+
+/*!
+  \struct SlotTable
+  \brief hash slot to entry index
+*/
+struct SlotTable {
+    std::uint8_t index_[TABLE_SIZE];
+    bool perfect_; //!< true if no slot is shared
+};
+
+/*-------------------------------------------------------------------*/
+constexpr
+SlotTable
+create_slot_table()
+{
+    SlotTable table{};
+    for ( std::size_t i = 0; i < TABLE_SIZE; ++i )
+    {
+        table.index_[i] = EMPTY_SLOT;
+    }
+
+    table.perfect_ = true;
+    for ( std::size_t i = 0; i < NUM_ENTRIES; ++i )
+    {
+        const std::size_t slot = hash_slot( ENTRIES[i].name_, ENTRIES[i].len_ );
+        if ( table.index_[slot] != EMPTY_SLOT )
+        {
+            table.perfect_ = false;
+        }
+        table.index_[slot] = static_cast< std::uint8_t >( i );
+    }
+    return table;
+}
+
+constexpr SlotTable SLOT_TABLE = create_slot_table();
+
+static_assert( SLOT_TABLE.perfect_, "referee message hash collision. change HASH_SEED." );
+
+}
+
+namespace rcsc {
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+PlayModeDecoder::decode( const char * msg,
+                         const std::size_t len,
+                         PlayModeInfo * info )
+{
+    *info = PlayModeInfo();
+
+    // "training" may be followed by the episode information
+    std::size_t word_len = 0;
+    while ( word_len < len && msg[word_len] != ' ' ) ++word_len;
+
+    // split the "_<number>" suffix
+    std::size_t key_len = word_len;
+    int value = -1;
+    {
+        std::size_t pos = word_len;
+        while ( pos > 0 && '0' <= msg[pos - 1] && msg[pos - 1] <= '9' ) --pos;
+
+        if ( pos < word_len
+             && word_len - pos <= 9
+             && pos > 0
+             && msg[pos - 1] == '_' )
+        {
+            value = 0;
+            for ( std::size_t i = pos; i < word_len; ++i )
+            {
+                value = value * 10 + ( msg[i] - '0' );
+            }
+            key_len = pos - 1;
+        }
+    }
+
+    const std::uint8_t index = SLOT_TABLE.index_[hash_slot( msg, key_len )];
+    if ( index == EMPTY_SLOT )
+    {
+        return false;
+    }
+
+    const Entry & e = ENTRIES[index];
+    if ( e.len_ != key_len
+         || std::memcmp( e.name_, msg, key_len ) != 0
+         || ( value >= 0 && ! e.has_value_ )
+         || ( word_len < len && e.kind_ != PlayModeInfo::TRAINING ) )
+    {
+        return false;
+    }
+
+    info->kind_ = e.kind_;
+    info->type_ = e.type_;
+    info->side_ = e.side_;
+    info->pmode_ = e.pmode_;
+    info->value_ = value;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+PlayModeDecoder::decode( const char * msg,
+                         PlayModeInfo * info )
+{
+    return decode( msg, std::strlen( msg ), info );
+}
+
+}
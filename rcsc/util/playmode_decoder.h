@@ -0,0 +1,115 @@
+// -*-c++-*-
+
+/*!
+  \file playmode_decoder.h
+  \brief playmode and referee message decoder Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_UTIL_PLAYMODE_DECODER_H
+#define RCSC_UTIL_PLAYMODE_DECODER_H
+
+#include <rcsc/game_mode.h>
+#include <rcsc/types.h>
+
+#include <cstddef>
+
+namespace rcsc {
+
+/*!
+  \struct PlayModeInfo
+  \brief decoded referee message
+*/
+struct PlayModeInfo {
+
+    /*!
+      \brief referee message type
+    */
+    enum Kind {
+        PLAYMODE, //!< playmode change
+        YELLOW_CARD, //!< yellow card notification
+        RED_CARD, //!< red card notification
+        TRAINING, //!< end of the training episode
+        UNKNOWN, //!< unsupported message
+    };
+
+    Kind kind_; //!< message type
+    GameMode::Type type_; //!< client side playmode type. MODE_MAX if not a playmode.
+    SideID side_; //!< playmode side, or the side of the carded player
+    PlayMode pmode_; //!< rcssserver playmode id. PM_Null if not an rcssserver playmode.
+    int value_; //!< score of the goal message or uniform number of the card message. -1 if not given.
+
+    /*!
+      \brief init as an unknown message
+    */
+    PlayModeInfo()
+        : kind_( UNKNOWN ),
+          type_( GameMode::MODE_MAX ),
+          side_( NEUTRAL ),
+          pmode_( PM_Null ),
+          value_( -1 )
+      { }
+};
+
+/*!
+  \class PlayModeDecoder
+  \brief decoder of the playmode strings and the other referee messages.
+
+  All known playmode names, the card notifications and the training message
+  are held in one table indexed by a perfect hash, that is verified at the
+  compile time. The trailing "_<number>" (the score of "goal_l_<SCORE>" or
+  the uniform number of "yellow_card_l_<UNUM>") is parsed in the same pass.
+*/
+class PlayModeDecoder {
+public:
+
+    /*!
+      \brief decode the referee message
+      \param msg message string, e.g. "kick_off_l", "goal_r_2", "red_card_l_5"
+      \param len length of the message string
+      \param info decoded result
+      \return true if the message is known
+    */
+    static
+    bool decode( const char * msg,
+                 const std::size_t len,
+                 PlayModeInfo * info );
+
+    /*!
+      \brief decode the null terminated referee message
+      \param msg message string
+      \param info decoded result
+      \return true if the message is known
+    */
+    static
+    bool decode( const char * msg,
+                 PlayModeInfo * info );
+};
+
+}
+
+#endif
@@ -0,0 +1,267 @@
+// -*-c++-*-
+
+/*!
+  \file ring_buffer.h
+  \brief fixed capacity ring buffer Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_UTIL_RING_BUFFER_H
+#define RCSC_UTIL_RING_BUFFER_H
+
+#include <array>
+#include <iterator>
+#include <cstddef>
+
+namespace rcsc {
+
+/*!
+  \class RingBuffer
+  \brief fixed capacity history container without any heap allocation.
+
+  New elements are pushed to the front. If the buffer is full, the oldest
+  (back) element is overwritten. Index 0 always refers to the newest element.
+*/
+template < typename T, std::size_t N >
+class RingBuffer {
+public:
+    static_assert( N > 0, "RingBuffer capacity must be positive." );
+
+    typedef T value_type;
+    typedef std::size_t size_type;
+
+    /*!
+      \class const_iterator
+      \brief iterator from the newest element to the oldest element
+    */
+    class const_iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T * pointer;
+        typedef const T & reference;
+
+    private:
+        const RingBuffer * M_buffer;
+        size_type M_index;
+
+    public:
+        const_iterator()
+            : M_buffer( nullptr ),
+              M_index( 0 )
+          { }
+
+        const_iterator( const RingBuffer * buffer,
+                        const size_type index )
+            : M_buffer( buffer ),
+              M_index( index )
+          { }
+
+        reference operator*() const
+          {
+              return ( *M_buffer )[M_index];
+          }
+
+        pointer operator->() const
+          {
+              return &( ( *M_buffer )[M_index] );
+          }
+
+        const_iterator & operator++()
+          {
+              ++M_index;
+              return *this;
+          }
+
+        const_iterator operator++( int )
+          {
+              const_iterator tmp = *this;
+              ++M_index;
+              return tmp;
+          }
+
+        bool operator==( const const_iterator & rhs ) const
+          {
+              return M_buffer == rhs.M_buffer && M_index == rhs.M_index;
+          }
+
+        bool operator!=( const const_iterator & rhs ) const
+          {
+              return ! operator==( rhs );
+          }
+    };
+
+private:
+
+    std::array< T, N > M_data; //!< element storage
+    size_type M_head; //!< physical index of the newest element
+    size_type M_size; //!< number of stored elements
+
+public:
+
+    /*!
+      \brief create an empty buffer
+    */
+    RingBuffer()
+        : M_data(),
+          M_head( 0 ),
+          M_size( 0 )
+      { }
+
+    /*!
+      \brief get the maximum number of elements
+      \return capacity of this buffer
+    */
+    static constexpr
+    size_type capacity()
+      {
+          return N;
+      }
+
+    /*!
+      \brief get the number of stored elements
+      \return number of elements
+    */
+    size_type size() const
+      {
+          return M_size;
+      }
+
+    /*!
+      \brief check if this buffer has no element
+      \return true if empty
+    */
+    bool empty() const
+      {
+          return M_size == 0;
+      }
+
+    /*!
+      \brief check if this buffer is full
+      \return true if the next push_front overwrites the oldest element
+    */
+    bool full() const
+      {
+          return M_size == N;
+      }
+
+    /*!
+      \brief remove all elements. the storage is not released.
+    */
+    void clear()
+      {
+          M_head = 0;
+          M_size = 0;
+      }
+
+    /*!
+      \brief push the new element to the front.
+      \param val new element
+
+      If the buffer is full, the oldest element is overwritten.
+    */
+    void push_front( const T & val )
+      {
+          M_head = ( M_head == 0 ? N - 1 : M_head - 1 );
+          M_data[M_head] = val;
+          if ( M_size < N )
+          {
+              ++M_size;
+          }
+      }
+
+    /*!
+      \brief remove the oldest element
+    */
+    void pop_back()
+      {
+          if ( M_size > 0 )
+          {
+              --M_size;
+          }
+      }
+
+    /*!
+      \brief get the element by the age
+      \param i age index. 0 means the newest element.
+      \return const reference to the element
+    */
+    const T & operator[]( const size_type i ) const
+      {
+          return M_data[( M_head + i ) % N];
+      }
+
+    /*!
+      \brief get the element by the age
+      \param i age index. 0 means the newest element.
+      \return reference to the element
+    */
+    T & operator[]( const size_type i )
+      {
+          return M_data[( M_head + i ) % N];
+      }
+
+    /*!
+      \brief get the newest element. the buffer must not be empty.
+      \return const reference to the element
+    */
+    const T & front() const
+      {
+          return M_data[M_head];
+      }
+
+    /*!
+      \brief get the oldest element. the buffer must not be empty.
+      \return const reference to the element
+    */
+    const T & back() const
+      {
+          return operator[]( M_size - 1 );
+      }
+
+    /*!
+      \brief get the iterator to the newest element
+      \return const iterator
+    */
+    const_iterator begin() const
+      {
+          return const_iterator( this, 0 );
+      }
+
+    /*!
+      \brief get the end iterator
+      \return const iterator
+    */
+    const_iterator end() const
+      {
+          return const_iterator( this, M_size );
+      }
+};
+
+}
+
+#endif
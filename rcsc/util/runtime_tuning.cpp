@@ -0,0 +1,288 @@
+// -*-c++-*-
+
+/*!
+  \file runtime_tuning.cpp
+  \brief scheduling and memory settings for latency sensitive agents Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "runtime_tuning.h"
+
+#include <atomic>
+#include <cstdlib>
+
+#ifdef HAVE_SCHED_H
+#include <sched.h>
+#endif
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+
+namespace rcsc {
+
+constexpr std::size_t RuntimeTuning::HUGE_PAGE_SIZE;
+
+namespace {
+
+std::atomic< bool > g_huge_pages( false );
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+RuntimeTuning::parse_cpu_list( const std::string & str,
+                               std::vector< int > * cpus )
+{
+    cpus->clear();
+
+    const char * p = str.c_str();
+    while ( *p != '\0' )
+    {
+        char * end = nullptr;
+        const long first = std::strtol( p, &end, 10 );
+        if ( end == p || first < 0 )
+        {
+            return false;
+        }
+        p = end;
+
+        long last = first;
+        if ( *p == '-' )
+        {
+            ++p;
+            last = std::strtol( p, &end, 10 );
+            if ( end == p || last < first )
+            {
+                return false;
+            }
+            p = end;
+        }
+
+        for ( long i = first; i <= last; ++i )
+        {
+            cpus->push_back( static_cast< int >( i ) );
+        }
+
+        if ( *p == ',' )
+        {
+            ++p;
+        }
+        else if ( *p != '\0' )
+        {
+            return false;
+        }
+    }
+
+    return ! cpus->empty();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+RuntimeTuning::set_cpu_affinity( const std::vector< int > & cpus )
+{
+#if defined(HAVE_SCHED_H) && defined(CPU_SET)
+    if ( cpus.empty() )
+    {
+        return false;
+    }
+
+    cpu_set_t mask;
+    CPU_ZERO( &mask );
+    for ( int cpu : cpus )
+    {
+        if ( cpu < 0 || CPU_SETSIZE <= cpu )
+        {
+            return false;
+        }
+        CPU_SET( cpu, &mask );
+    }
+
+    // pid 0 means the calling thread on Linux
+    return ::sched_setaffinity( 0, sizeof( mask ), &mask ) == 0;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+RuntimeTuning::set_fifo_priority( const int priority )
+{
+#if defined(HAVE_SCHED_H) && defined(SCHED_FIFO)
+    if ( priority < ::sched_get_priority_min( SCHED_FIFO )
+         || ::sched_get_priority_max( SCHED_FIFO ) < priority )
+    {
+        return false;
+    }
+
+    struct sched_param param;
+    param.sched_priority = priority;
+    return ::sched_setscheduler( 0, SCHED_FIFO, &param ) == 0;
+#else
+    (void)priority;
+    return false;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+RuntimeTuning::set_nice( const int value )
+{
+#ifdef HAVE_SYS_RESOURCE_H
+    // PRIO_PROCESS with 0 changes only the calling thread on Linux
+    return ::setpriority( PRIO_PROCESS, 0, value ) == 0;
+#else
+    (void)value;
+    return false;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+RuntimeTuning::lock_memory()
+{
+#if defined(HAVE_SYS_MMAN_H) && defined(MCL_CURRENT)
+    return ::mlockall( MCL_CURRENT | MCL_FUTURE ) == 0;
+#else
+    return false;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+RuntimeTuning::set_huge_pages( const bool on )
+{
+    g_huge_pages.store( on, std::memory_order_relaxed );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+RuntimeTuning::huge_pages()
+{
+    return g_huge_pages.load( std::memory_order_relaxed );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+LargeBuffer::reset( const std::size_t size )
+{
+    if ( M_data )
+    {
+#ifdef HAVE_SYS_MMAN_H
+        if ( M_mapped_size > 0 )
+        {
+            ::munmap( M_data, M_mapped_size );
+        }
+        else
+#endif
+        {
+            delete [] M_data;
+        }
+    }
+
+    M_data = nullptr;
+    M_size = 0;
+    M_mapped_size = 0;
+
+    if ( size == 0 )
+    {
+        return;
+    }
+
+#if defined(HAVE_SYS_MMAN_H) && defined(MAP_ANONYMOUS)
+    if ( RuntimeTuning::huge_pages()
+         && size >= RuntimeTuning::HUGE_PAGE_SIZE )
+    {
+        const std::size_t page = RuntimeTuning::HUGE_PAGE_SIZE;
+        const std::size_t mapped_size = ( size + page - 1 ) / page * page;
+
+        void * p = MAP_FAILED;
+#ifdef MAP_HUGETLB
+        // reserved huge pages (vm.nr_hugepages)
+        p = ::mmap( nullptr, mapped_size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0 );
+#endif
+        if ( p == MAP_FAILED )
+        {
+            // transparent huge pages
+            p = ::mmap( nullptr, mapped_size, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+#ifdef MADV_HUGEPAGE
+            if ( p != MAP_FAILED )
+            {
+                ::madvise( p, mapped_size, MADV_HUGEPAGE );
+            }
+#endif
+        }
+
+        if ( p != MAP_FAILED )
+        {
+            M_data = static_cast< unsigned char * >( p );
+            M_size = size;
+            M_mapped_size = mapped_size;
+            return;
+        }
+    }
+#endif
+
+    M_data = new unsigned char[size];
+    M_size = size;
+}
+
+}
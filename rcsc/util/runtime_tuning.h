@@ -0,0 +1,201 @@
+// -*-c++-*-
+
+/*!
+  \file runtime_tuning.h
+  \brief scheduling and memory settings for latency sensitive agents Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_UTIL_RUNTIME_TUNING_H
+#define RCSC_UTIL_RUNTIME_TUNING_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace rcsc {
+
+/*!
+  \class RuntimeTuning
+  \brief cpu affinity, scheduling priority and memory locking of the agent.
+
+  The affinity and priority settings are applied to the calling thread, so
+  each agent of TeamRunner can have its own settings. The memory settings
+  are process wide. All functions return false if the setting is not
+  supported by the platform or is not permitted (e.g. SCHED_FIFO and
+  mlockall usually require CAP_SYS_NICE and CAP_IPC_LOCK).
+*/
+class RuntimeTuning {
+public:
+
+    //! the size of the huge page assumed by LargeBuffer
+    static constexpr std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    /*!
+      \brief parse the cpu list string, e.g. "0,2,4-7"
+      \param str cpu list string
+      \param cpus result cpu indices
+      \return false if the string is malformed
+    */
+    static
+    bool parse_cpu_list( const std::string & str,
+                         std::vector< int > * cpus );
+
+    /*!
+      \brief pin the calling thread to the cpus
+      \param cpus cpu indices
+      \return true if succeeded
+    */
+    static
+    bool set_cpu_affinity( const std::vector< int > & cpus );
+
+    /*!
+      \brief set the SCHED_FIFO real-time priority of the calling thread
+      \param priority real-time priority (1-99)
+      \return true if succeeded
+    */
+    static
+    bool set_fifo_priority( const int priority );
+
+    /*!
+      \brief set the nice value of the calling thread
+      \param value nice value (-20 to 19)
+      \return true if succeeded
+    */
+    static
+    bool set_nice( const int value );
+
+    /*!
+      \brief lock all current and future pages of the process into memory
+      \return true if succeeded
+    */
+    static
+    bool lock_memory();
+
+    /*!
+      \brief enable/disable the huge page backing of LargeBuffer
+      \param on if true, the buffers of HUGE_PAGE_SIZE or more are backed by huge pages.
+    */
+    static
+    void set_huge_pages( const bool on );
+
+    /*!
+      \brief check if the huge page backing is enabled
+      \return true if enabled
+    */
+    static
+    bool huge_pages();
+};
+
+/*!
+  \class LargeBuffer
+  \brief raw memory block for the large arenas and tables.
+
+  If RuntimeTuning::huge_pages() is enabled when the block is allocated and
+  the size is HUGE_PAGE_SIZE or more, the block is mapped with MAP_HUGETLB,
+  or, if no huge page is reserved, advised to be backed by transparent huge
+  pages. Otherwise, the block is allocated by operator new.
+*/
+class LargeBuffer {
+private:
+    unsigned char * M_data; //!< block address
+    std::size_t M_size; //!< requested size
+    std::size_t M_mapped_size; //!< mapped size. 0 if allocated by operator new.
+
+    // not used
+    LargeBuffer( const LargeBuffer & ) = delete;
+    LargeBuffer & operator=( const LargeBuffer & ) = delete;
+
+public:
+
+    /*!
+      \brief construct an empty buffer
+    */
+    LargeBuffer()
+        : M_data( nullptr ),
+          M_size( 0 ),
+          M_mapped_size( 0 )
+      { }
+
+    /*!
+      \brief allocate the block
+      \param size block size in bytes
+    */
+    explicit
+    LargeBuffer( const std::size_t size )
+        : M_data( nullptr ),
+          M_size( 0 ),
+          M_mapped_size( 0 )
+      {
+          reset( size );
+      }
+
+    /*!
+      \brief release the block
+    */
+    ~LargeBuffer()
+      {
+          reset( 0 );
+      }
+
+    /*!
+      \brief release the current block, then allocate the new block.
+      \param size new block size in bytes. if 0, no block is allocated.
+    */
+    void reset( const std::size_t size );
+
+    /*!
+      \brief get the block address
+      \return pointer to the block
+    */
+    unsigned char * get() const
+      {
+          return M_data;
+      }
+
+    /*!
+      \brief get the block size
+      \return size in bytes
+    */
+    std::size_t size() const
+      {
+          return M_size;
+      }
+
+    /*!
+      \brief check if the block is mapped for the huge pages
+      \return true if mapped
+    */
+    bool isHugePage() const
+      {
+          return M_mapped_size > 0;
+      }
+};
+
+}
+
+#endif
@@ -0,0 +1,402 @@
+// -*-c++-*-
+
+/*!
+  \file shared_table_segment.cpp
+  \brief read-only table segment shared among processes Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "shared_table_segment.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+#include <cerrno>
+#include <cstring>
+
+#ifdef HAVE_SHM_OPEN
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+namespace rcsc {
+
+constexpr double SharedTableSegment::DEFAULT_TIMEOUT_SEC;
+
+#ifdef HAVE_SHM_OPEN
+namespace {
+
+//
+// segment layout.
+// [SegmentHeader][padding to HEADER_SIZE][table data x size_]
+//
+
+const char SEGMENT_MAGIC[8] = { 'R', 'C', 'S', 'C', 'S', 'H', 'M', '\0' };
+
+enum SegmentState : std::uint32_t {
+    SEGMENT_BUILDING = 0, // the segment is zero filled when created
+    SEGMENT_READY = 1,
+    SEGMENT_FAILED = 2,
+};
+
+struct SegmentHeader {
+    char magic_[8];
+    std::atomic< std::uint32_t > state_;
+    std::int32_t builder_pid_;
+    std::uint64_t size_;
+};
+
+//! the table data is aligned for any table element type
+const std::size_t HEADER_SIZE = 64;
+
+static_assert( sizeof( SegmentHeader ) <= HEADER_SIZE,
+               "segment header must fit in HEADER_SIZE." );
+static_assert( std::atomic< std::uint32_t >::is_always_lock_free,
+               "the segment state must be lock free to be shared among processes." );
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief result of the segment inspection
+ */
+enum AttachResult {
+    ATTACH_READY,
+    ATTACH_NOT_FOUND,
+    ATTACH_BUILDING,
+    ATTACH_DEAD, // the building process has died, or the build failed
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief map the segment and check its state
+  \param name segment name
+  \param data reference to the variable to store the table data
+  \param size pointer to the variable to store the data size
+  \return inspection result
+ */
+AttachResult
+attach_segment( const std::string & name,
+                std::shared_ptr< const char > & data,
+                std::size_t * size )
+{
+    const int fd = ::shm_open( name.c_str(), O_RDONLY, 0 );
+    if ( fd < 0 )
+    {
+        return ATTACH_NOT_FOUND;
+    }
+
+    struct stat st;
+    if ( ::fstat( fd, &st ) != 0 )
+    {
+        ::close( fd );
+        return ATTACH_NOT_FOUND;
+    }
+
+    const std::size_t length = static_cast< std::size_t >( st.st_size );
+    if ( length < HEADER_SIZE )
+    {
+        // the header has not been written yet
+        ::close( fd );
+        return ATTACH_BUILDING;
+    }
+
+    void * addr = ::mmap( nullptr, length, PROT_READ, MAP_SHARED, fd, 0 );
+    ::close( fd );
+
+    if ( addr == MAP_FAILED )
+    {
+        return ATTACH_NOT_FOUND;
+    }
+
+    const SegmentHeader * header = static_cast< const SegmentHeader * >( addr );
+    const std::uint32_t state = header->state_.load( std::memory_order_acquire );
+
+    AttachResult result = ATTACH_BUILDING;
+    if ( std::memcmp( header->magic_, SEGMENT_MAGIC, sizeof( SEGMENT_MAGIC ) ) != 0 )
+    {
+        result = ATTACH_BUILDING;
+    }
+    else if ( state == SEGMENT_READY
+              && HEADER_SIZE + header->size_ <= length )
+    {
+        result = ATTACH_READY;
+    }
+    else if ( state == SEGMENT_FAILED
+              || ( header->builder_pid_ > 0
+                   && ::kill( header->builder_pid_, 0 ) != 0
+                   && errno == ESRCH ) )
+    {
+        result = ATTACH_DEAD;
+    }
+
+    if ( result != ATTACH_READY )
+    {
+        ::munmap( addr, length );
+        return result;
+    }
+
+    *size = static_cast< std::size_t >( header->size_ );
+
+    std::shared_ptr< const char > segment( static_cast< const char * >( addr ),
+                                           [length]( const char * p )
+                                             {
+                                                 ::munmap( const_cast< char * >( p ), length );
+                                             } );
+    // refer the table data, and hold the whole mapping
+    data = std::shared_ptr< const char >( segment, segment.get() + HEADER_SIZE );
+    return ATTACH_READY;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief write the data to the mapped segment
+  \param fd segment file descriptor
+  \param length mapping length
+  \param func function to write the mapped segment
+  \return result
+ */
+template < typename Func >
+bool
+write_segment( const int fd,
+               const std::size_t length,
+               Func func )
+{
+    void * addr = ::mmap( nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    if ( addr == MAP_FAILED )
+    {
+        return false;
+    }
+
+    func( static_cast< char * >( addr ) );
+
+    ::munmap( addr, length );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create the segment, and publish the data built by the builder
+  \param name segment name
+  \param builder function to build the table data
+  \return true if this process created the segment. the segment may be
+  still unavailable if the build failed.
+ */
+bool
+create_segment( const std::string & name,
+                const SharedTableSegment::Builder & builder )
+{
+    const int fd = ::shm_open( name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644 );
+    if ( fd < 0 )
+    {
+        return false;
+    }
+
+    // publish the builder process id first, so that the other processes can
+    // detect the death of this process.
+    if ( ::ftruncate( fd, HEADER_SIZE ) != 0
+         || ! write_segment( fd, HEADER_SIZE,
+                             []( char * addr )
+                               {
+                                   SegmentHeader * header = reinterpret_cast< SegmentHeader * >( addr );
+                                   header->builder_pid_ = static_cast< std::int32_t >( ::getpid() );
+                                   std::memcpy( header->magic_, SEGMENT_MAGIC, sizeof( SEGMENT_MAGIC ) );
+                               } ) )
+    {
+        ::close( fd );
+        ::shm_unlink( name.c_str() );
+        return true;
+    }
+
+    std::string data;
+    const bool built = builder( data );
+
+    const std::size_t length = HEADER_SIZE + ( built ? data.size() : 0 );
+    const bool published = ( built
+                             && ::ftruncate( fd, length ) == 0
+                             && write_segment( fd, length,
+                                               [&data]( char * addr )
+                                                 {
+                                                     SegmentHeader * header = reinterpret_cast< SegmentHeader * >( addr );
+                                                     std::memcpy( addr + HEADER_SIZE, data.data(), data.size() );
+                                                     header->size_ = data.size();
+                                                     header->state_.store( SEGMENT_READY, std::memory_order_release );
+                                                 } ) );
+    if ( ! published )
+    {
+        // wake up the waiting processes
+        write_segment( fd, HEADER_SIZE,
+                       []( char * addr )
+                         {
+                             SegmentHeader * header = reinterpret_cast< SegmentHeader * >( addr );
+                             header->state_.store( SEGMENT_FAILED, std::memory_order_release );
+                         } );
+        ::shm_unlink( name.c_str() );
+    }
+
+    ::close( fd );
+    return true;
+}
+
+}
+#endif
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+SharedTableSegment::is_supported()
+{
+#ifdef HAVE_SHM_OPEN
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::string
+SharedTableSegment::make_name( const std::string & table,
+                               const std::uint64_t key )
+{
+    std::ostringstream os;
+    os << "/rcsc." << table;
+#ifdef HAVE_SHM_OPEN
+    os << '.' << ::getuid();
+#endif
+    os << '.' << std::hex << std::setw( 16 ) << std::setfill( '0' ) << key;
+    return os.str();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::shared_ptr< const char >
+SharedTableSegment::attach( const std::string & name,
+                            std::size_t * size )
+{
+    std::shared_ptr< const char > data;
+#ifdef HAVE_SHM_OPEN
+    attach_segment( name, data, size );
+#else
+    (void)name;
+    (void)size;
+#endif
+    return data;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::shared_ptr< const char >
+SharedTableSegment::acquire( const std::string & name,
+                             const Builder & builder,
+                             std::size_t * size,
+                             const double timeout_sec )
+{
+    std::shared_ptr< const char > data;
+#ifdef HAVE_SHM_OPEN
+    const std::chrono::steady_clock::time_point deadline
+        = std::chrono::steady_clock::now()
+        + std::chrono::duration_cast< std::chrono::steady_clock::duration >( std::chrono::duration< double >( timeout_sec ) );
+
+    bool created = false;
+    while ( true )
+    {
+        const AttachResult result = attach_segment( name, data, size );
+        if ( result == ATTACH_READY )
+        {
+            break;
+        }
+
+        if ( created )
+        {
+            // the build in this process failed
+            break;
+        }
+
+        if ( result == ATTACH_DEAD )
+        {
+            std::cerr << "(SharedTableSegment::acquire) remove the incomplete segment "
+                      << name << std::endl;
+            ::shm_unlink( name.c_str() );
+        }
+
+        if ( result != ATTACH_BUILDING )
+        {
+            created = create_segment( name, builder );
+            continue;
+        }
+
+        if ( std::chrono::steady_clock::now() > deadline )
+        {
+            std::cerr << "(SharedTableSegment::acquire) timeout. " << name << std::endl;
+            break;
+        }
+
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    }
+#else
+    (void)name;
+    (void)builder;
+    (void)size;
+    (void)timeout_sec;
+#endif
+    return data;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+SharedTableSegment::remove( const std::string & name )
+{
+#ifdef HAVE_SHM_OPEN
+    return ::shm_unlink( name.c_str() ) == 0;
+#else
+    (void)name;
+    return false;
+#endif
+}
+
+}
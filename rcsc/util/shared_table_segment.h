@@ -0,0 +1,136 @@
+// -*-c++-*-
+
+/*!
+  \file shared_table_segment.h
+  \brief read-only table segment shared among processes Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_UTIL_SHARED_TABLE_SEGMENT_H
+#define RCSC_UTIL_SHARED_TABLE_SEGMENT_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+namespace rcsc {
+
+/*!
+  \class SharedTableSegment
+  \brief publisher of the immutable tables shared by the agent processes on the same host.
+
+  A segment is a named POSIX shared memory object that holds one serialized
+  table. The first process that calls acquire() creates the segment, builds
+  the table data and publishes it. The other processes wait for the segment
+  to be published, and map it read-only. Then, there is only one physical
+  copy of the table on the host, and the startup of the other processes
+  does not need to build the table.
+
+  The segment name should contain the hash of all parameters that affect the
+  table values, including the data format version. Then, a segment built by
+  an old binary or for the other server parameters is never attached.
+  The segments remain until remove() is called or the host is rebooted.
+*/
+class SharedTableSegment {
+public:
+
+    /*!
+      \brief function to build the table data to be published
+      \param data reference to the variable to store the serialized table
+      \return build result. if false, the segment is not published.
+    */
+    typedef std::function< bool( std::string & data ) > Builder;
+
+    //! the default time to wait for the segment built by the other process
+    static constexpr double DEFAULT_TIMEOUT_SEC = 30.0;
+
+private:
+
+    // not used
+    SharedTableSegment() = delete;
+
+public:
+
+    /*!
+      \brief check if the platform supports the shared memory segment
+      \return true if supported
+    */
+    static
+    bool is_supported();
+
+    /*!
+      \brief create the segment name for the table
+      \param table table name. it must not contain '/'.
+      \param key hash value of the parameters that affect the table values
+      \return segment name. the user id is also contained.
+    */
+    static
+    std::string make_name( const std::string & table,
+                           const std::uint64_t key );
+
+    /*!
+      \brief map the published segment read-only
+      \param name segment name
+      \param size pointer to the variable to store the data size
+      \return pointer to the table data. NULL if the segment is not published.
+    */
+    static
+    std::shared_ptr< const char > attach( const std::string & name,
+                                          std::size_t * size );
+
+    /*!
+      \brief attach the segment, or build and publish it if no process has created it.
+      \param name segment name
+      \param builder function to build the table data
+      \param size pointer to the variable to store the data size
+      \param timeout_sec time to wait for the segment built by the other process
+      \return pointer to the table data in the segment. NULL if the segment
+      is not available. the caller should build its own table in that case.
+
+      If the process that is building the segment has died, the segment is
+      removed and this process builds it again.
+    */
+    static
+    std::shared_ptr< const char > acquire( const std::string & name,
+                                           const Builder & builder,
+                                           std::size_t * size,
+                                           const double timeout_sec = DEFAULT_TIMEOUT_SEC );
+
+    /*!
+      \brief remove the segment name. the processes that already map the segment are not affected.
+      \param name segment name
+      \return true if removed
+    */
+    static
+    bool remove( const std::string & name );
+};
+
+}
+
+#endif
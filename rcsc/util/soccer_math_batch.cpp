@@ -0,0 +1,308 @@
+// -*-c++-*-
+
+/*!
+  \file soccer_math_batch.cpp
+  \brief batch versions of the soccer_math.h functions Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/soccer_math_batch.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace rcsc {
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+InertiaTable::InertiaTable( const double decay,
+                            const int max_step )
+    : M_decay( decay ),
+      M_decay_pow( std::max( 0, max_step ) + 1 ),
+      M_travel_rate( std::max( 0, max_step ) + 1 )
+{
+    for ( std::size_t i = 0; i < M_decay_pow.size(); ++i )
+    {
+        const int step = static_cast< int >( i );
+        M_decay_pow[i] = std::pow( decay, step );
+        M_travel_rate[i] = ( 1.0 - std::pow( decay, step ) ) / ( 1.0 - decay );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const InertiaTable &
+InertiaTable::get( const double decay,
+                   const int max_step )
+{
+    static std::mutex s_mutex;
+    static std::map< std::pair< double, int >, std::unique_ptr< InertiaTable > > s_tables;
+
+    std::lock_guard< std::mutex > lock( s_mutex );
+
+    std::unique_ptr< InertiaTable > & table = s_tables[std::make_pair( decay, max_step )];
+    if ( ! table )
+    {
+        table.reset( new InertiaTable( decay, max_step ) );
+    }
+    return *table;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+inertia_n_step_point_batch( const std::size_t n,
+                            const double * pos_x,
+                            const double * pos_y,
+                            const double * vel_x,
+                            const double * vel_y,
+                            const int n_step,
+                            const double decay,
+                            double * result_x,
+                            double * result_y )
+{
+    const double rate = ( 1.0 - std::pow( decay, n_step ) ) / ( 1.0 - decay );
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        result_x[i] = pos_x[i] + vel_x[i] * rate;
+        result_y[i] = pos_y[i] + vel_y[i] * rate;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+inertia_n_step_point_batch( const InertiaTable & table,
+                            const std::size_t n,
+                            const double * pos_x,
+                            const double * pos_y,
+                            const double * vel_x,
+                            const double * vel_y,
+                            const int * n_steps,
+                            double * result_x,
+                            double * result_y )
+{
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        const double rate = table.travelRate( n_steps[i] );
+        result_x[i] = pos_x[i] + vel_x[i] * rate;
+        result_y[i] = pos_y[i] + vel_y[i] * rate;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+inertia_n_step_distance_batch( const std::size_t n,
+                               const double * initial_speed,
+                               const int n_step,
+                               const double decay,
+                               double * result )
+{
+    const double decay_pow = std::pow( decay, n_step );
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        result[i] = initial_speed[i] * ( 1.0 - decay_pow ) / ( 1.0 - decay );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+inertia_n_step_distance_batch( const InertiaTable & table,
+                               const std::size_t n,
+                               const double * initial_speed,
+                               const int * n_steps,
+                               double * result )
+{
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        result[i] = table.nStepDistance( initial_speed[i], n_steps[i] );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+inertia_final_point_batch( const std::size_t n,
+                           const double * pos_x,
+                           const double * pos_y,
+                           const double * vel_x,
+                           const double * vel_y,
+                           const double decay,
+                           double * result_x,
+                           double * result_y )
+{
+    const double d = 1.0 - decay;
+
+    // same as Vector2D::operator/=, that ignores too small divisor.
+    if ( std::fabs( d ) <= Vector2D::EPSILON )
+    {
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            result_x[i] = pos_x[i] + vel_x[i];
+            result_y[i] = pos_y[i] + vel_y[i];
+        }
+        return;
+    }
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        result_x[i] = pos_x[i] + vel_x[i] / d;
+        result_y[i] = pos_y[i] + vel_y[i] / d;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+final_speed_batch( const std::size_t n,
+                   const double * dash_power,
+                   const double dprate,
+                   const double effort,
+                   const double decay,
+                   double * result )
+{
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        result[i] = ( std::fabs( dash_power[i] ) * dprate * effort ) / ( 1.0 - decay );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+kick_rate_batch( const std::size_t n,
+                 const double * dist,
+                 const double * dir_diff,
+                 const double kprate,
+                 const double bsize,
+                 const double psize,
+                 const double kmargin,
+                 double * result )
+{
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        result[i] = kprate * ( 1.0
+                               - 0.25 * std::fabs( dir_diff[i] ) / 180.0
+                               - 0.25 * ( dist[i] - bsize - psize ) / kmargin );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+effective_turn_batch( const std::size_t n,
+                      const double * turn_moment,
+                      const double * speed,
+                      const double inertiamoment,
+                      double * result )
+{
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        result[i] = turn_moment[i] / ( 1.0 + inertiamoment * speed[i] );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+quantize_dist_batch( const std::size_t n,
+                     const double * unq_dist,
+                     const double qstep,
+                     double * result )
+{
+    // std::log and std::exp are not vectorized without the math library support.
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        result[i] = quantize_dist( unq_dist[i], qstep );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+unquantize_min_batch( const std::size_t n,
+                      const double * dist,
+                      const double qstep,
+                      double * result )
+{
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        result[i] = ( std::rint( dist[i] / qstep ) - 0.5 ) * qstep;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+unquantize_max_batch( const std::size_t n,
+                      const double * dist,
+                      const double qstep,
+                      double * result )
+{
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        result[i] = ( std::rint( dist[i] / qstep ) + 0.5 ) * qstep;
+    }
+}
+
+}
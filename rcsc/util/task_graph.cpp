@@ -0,0 +1,489 @@
+// -*-c++-*-
+
+/*!
+  \file task_graph.cpp
+  \brief small dependency graph executed on the process wide thread pool Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "task_graph.h"
+
+#include <algorithm>
+#include <exception>
+#include <cassert>
+
+namespace rcsc {
+
+constexpr std::size_t TaskPool::MAX_WORKERS;
+
+namespace {
+
+//! the pool slot index of the current thread. MAX_WORKERS if not a worker.
+thread_local std::size_t t_worker_index = TaskPool::MAX_WORKERS;
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \struct TaskPool::Worker
+  \brief job deques and the thread of one worker
+*/
+struct TaskPool::Worker {
+    std::mutex mutex_; //!< lock for the deques
+    std::deque< std::function< void() > > jobs_[PRIORITY_SIZE]; //!< own jobs. the back is the newest.
+    std::thread thread_; //!< worker thread
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+TaskPool::TaskPool()
+    : M_worker_count( 0 ),
+      M_pending( 0 ),
+      M_stop( false ),
+      M_reserved_callers( 1 )
+{
+    // the slots are never reallocated, so the workers can be added while
+    // the other threads are stealing.
+    M_workers.reserve( MAX_WORKERS );
+    for ( std::size_t i = 0; i < MAX_WORKERS; ++i )
+    {
+        M_workers.emplace_back( new Worker() );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+TaskPool::~TaskPool()
+{
+    setWorkerCount( 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+TaskPool &
+TaskPool::instance()
+{
+    static TaskPool s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TaskPool::setWorkerCount( const std::size_t count )
+{
+    std::lock_guard< std::mutex > lock( M_resize_mutex );
+
+    const std::size_t n = std::min( count, MAX_WORKERS );
+    if ( n == workerCount() )
+    {
+        return;
+    }
+
+    stopWorkers();
+    startWorkers( n );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TaskPool::requestWorkerCount( const std::size_t count )
+{
+    std::lock_guard< std::mutex > lock( M_resize_mutex );
+
+    const std::size_t n = std::min( count, workerLimit() );
+    if ( n > workerCount() )
+    {
+        startWorkers( n );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TaskPool::reserveCallers( const std::size_t count )
+{
+    M_reserved_callers = std::max( static_cast< std::size_t >( 1 ), count );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::size_t
+TaskPool::workerLimit() const
+{
+    const std::size_t hardware = std::thread::hardware_concurrency();
+    const std::size_t callers = M_reserved_callers.load();
+    return ( hardware > callers
+             ? std::min( hardware - callers, MAX_WORKERS )
+             : 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TaskPool::startWorkers( const std::size_t count )
+{
+    for ( std::size_t i = workerCount(); i < count; ++i )
+    {
+        M_workers[i]->thread_ = std::thread( &TaskPool::loop, this, i );
+        // publish the new slot after its thread is ready to be notified.
+        M_worker_count.store( i + 1, std::memory_order_release );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TaskPool::stopWorkers()
+{
+    {
+        std::lock_guard< std::mutex > lock( M_mutex );
+        M_stop = true;
+    }
+    M_cond.notify_all();
+
+    // the workers exit after all queued jobs are executed.
+    const std::size_t count = workerCount();
+    for ( std::size_t i = 0; i < count; ++i )
+    {
+        M_workers[i]->thread_.join();
+    }
+    M_worker_count.store( 0, std::memory_order_release );
+
+    std::lock_guard< std::mutex > lock( M_mutex );
+    M_stop = false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TaskPool::submit( std::function< void() > job,
+                  const Priority priority )
+{
+    if ( workerCount() == 0 )
+    {
+        job();
+        return;
+    }
+
+    // the count is increased first, so it never becomes less than the
+    // number of the queued jobs.
+    const std::size_t index = t_worker_index;
+    {
+        std::lock_guard< std::mutex > lock( M_mutex );
+        M_pending.fetch_add( 1, std::memory_order_release );
+        if ( index >= MAX_WORKERS )
+        {
+            M_jobs[priority].push_back( std::move( job ) );
+        }
+    }
+
+    if ( index < MAX_WORKERS )
+    {
+        Worker & w = *M_workers[index];
+        std::lock_guard< std::mutex > lock( w.mutex_ );
+        w.jobs_[priority].push_back( std::move( job ) );
+    }
+
+    M_cond.notify_one();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+TaskPool::take( const std::size_t index,
+                std::function< void() > * job )
+{
+    const std::size_t count = workerCount();
+
+    for ( int p = 0; p < PRIORITY_SIZE; ++p )
+    {
+        // own deque, the newest first
+        {
+            Worker & w = *M_workers[index];
+            std::lock_guard< std::mutex > lock( w.mutex_ );
+            if ( ! w.jobs_[p].empty() )
+            {
+                *job = std::move( w.jobs_[p].back() );
+                w.jobs_[p].pop_back();
+                M_pending.fetch_sub( 1, std::memory_order_relaxed );
+                return true;
+            }
+        }
+
+        // shared queue
+        {
+            std::lock_guard< std::mutex > lock( M_mutex );
+            if ( ! M_jobs[p].empty() )
+            {
+                *job = std::move( M_jobs[p].front() );
+                M_jobs[p].pop_front();
+                M_pending.fetch_sub( 1, std::memory_order_relaxed );
+                return true;
+            }
+        }
+
+        // steal the oldest job of the other workers
+        for ( std::size_t i = 1; i < count; ++i )
+        {
+            Worker & victim = *M_workers[( index + i ) % count];
+            std::lock_guard< std::mutex > lock( victim.mutex_ );
+            if ( ! victim.jobs_[p].empty() )
+            {
+                *job = std::move( victim.jobs_[p].front() );
+                victim.jobs_[p].pop_front();
+                M_pending.fetch_sub( 1, std::memory_order_relaxed );
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TaskPool::loop( const std::size_t index )
+{
+    t_worker_index = index;
+
+    while ( true )
+    {
+        std::function< void() > job;
+        if ( take( index, &job ) )
+        {
+            job();
+            continue;
+        }
+
+        std::unique_lock< std::mutex > lock( M_mutex );
+        M_cond.wait( lock, [this] { return M_stop || M_pending.load( std::memory_order_acquire ) > 0; } );
+        if ( M_stop
+             && M_pending.load( std::memory_order_acquire ) == 0 )
+        {
+            return;
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \struct TaskGraph::State
+  \brief shared execution state. the pool jobs may outlive run().
+*/
+struct TaskGraph::State {
+    std::vector< Node > nodes_;
+    std::vector< std::size_t > remaining_; //!< unfinished dependencies of each node
+    std::deque< Id > ready_; //!< runnable nodes
+    std::size_t finished_; //!< the number of finished nodes
+    TaskPool::Priority priority_; //!< priority lane of the pool jobs
+    std::exception_ptr error_; //!< the first exception
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+
+    /*!
+      \brief run one ready node if exists
+      \return true if a node was executed
+    */
+    bool runOne( std::shared_ptr< State > self );
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+TaskGraph::State::runOne( std::shared_ptr< State > self )
+{
+    Id id;
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        if ( ready_.empty() )
+        {
+            return false;
+        }
+        id = ready_.front();
+        ready_.pop_front();
+    }
+
+    std::exception_ptr error;
+    try
+    {
+        nodes_[id].function_();
+    }
+    catch ( ... )
+    {
+        error = std::current_exception();
+    }
+
+    std::size_t new_ready = 0;
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        if ( error && ! error_ )
+        {
+            error_ = error;
+        }
+        for ( Id d : nodes_[id].dependents_ )
+        {
+            if ( --remaining_[d] == 0 )
+            {
+                ready_.push_back( d );
+                ++new_ready;
+            }
+        }
+        ++finished_;
+    }
+    cond_.notify_all();
+
+    // one of the new ready nodes is left for this thread
+    for ( std::size_t i = 1; i < new_ready; ++i )
+    {
+        TaskPool::instance().submit( [self]() { self->runOne( self ); }, priority_ );
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+TaskGraph::Id
+TaskGraph::add( std::function< void() > function,
+                std::initializer_list< Id > dependencies )
+{
+    const Id id = M_nodes.size();
+
+    M_nodes.push_back( Node{ std::move( function ), std::vector< Id >(), dependencies.size() } );
+    for ( Id d : dependencies )
+    {
+        assert( d < id );
+        M_nodes[d].dependents_.push_back( id );
+    }
+
+    return id;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TaskGraph::run( const bool parallel,
+               const TaskPool::Priority priority )
+{
+    if ( M_nodes.empty() )
+    {
+        return;
+    }
+
+    if ( ! parallel
+         || TaskPool::instance().workerCount() == 0 )
+    {
+        // the dependencies always have the smaller ids
+        for ( Node & n : M_nodes )
+        {
+            n.function_();
+        }
+        M_nodes.clear();
+        return;
+    }
+
+    std::shared_ptr< State > state = std::make_shared< State >();
+    state->nodes_.swap( M_nodes );
+    state->finished_ = 0;
+    state->priority_ = priority;
+    state->remaining_.reserve( state->nodes_.size() );
+    for ( Id i = 0; i < state->nodes_.size(); ++i )
+    {
+        state->remaining_.push_back( state->nodes_[i].dependency_count_ );
+        if ( state->nodes_[i].dependency_count_ == 0 )
+        {
+            state->ready_.push_back( i );
+        }
+    }
+
+    // the caller thread takes one of the initial nodes.
+    // the ready queue is changed by the submitted jobs, so its size is read first.
+    const std::size_t initial = state->ready_.size();
+    for ( std::size_t i = 1; i < initial; ++i )
+    {
+        TaskPool::instance().submit( [state]() { state->runOne( state ); }, priority );
+    }
+
+    const std::size_t total = state->nodes_.size();
+    while ( true )
+    {
+        if ( state->runOne( state ) )
+        {
+            continue;
+        }
+
+        std::unique_lock< std::mutex > lock( state->mutex_ );
+        state->cond_.wait( lock, [&]() { return state->finished_ == total || ! state->ready_.empty(); } );
+        if ( state->finished_ == total )
+        {
+            break;
+        }
+    }
+
+    if ( state->error_ )
+    {
+        std::rethrow_exception( state->error_ );
+    }
+}
+
+}
@@ -0,0 +1,222 @@
+// -*-c++-*-
+
+/*!
+  \file task_graph.h
+  \brief small dependency graph executed on the process wide thread pool Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_UTIL_TASK_GRAPH_H
+#define RCSC_UTIL_TASK_GRAPH_H
+
+#include <atomic>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+
+namespace rcsc {
+
+/*!
+  \class TaskPool
+  \brief process wide work-stealing worker threads shared by all agents.
+
+  The pool has no thread by default, and the jobs run on the caller thread.
+  setWorkerCount() or requestWorkerCount() starts the workers.
+
+  Each worker has its own job deques. A job submitted by a worker is pushed
+  to its own deque and popped in LIFO order, and idle workers steal the
+  oldest jobs from the others. Jobs submitted by the other threads go to
+  the shared queue. Every source of the CRITICAL lane is checked before
+  any BACKGROUND job is taken, so the decision critical analyses are not
+  delayed by the background work such as the table creation.
+
+  The pool is shared by all agents in one process. requestWorkerCount()
+  takes the maximum of the requests instead of their sum, and it is limited
+  by the hardware concurrency minus the reserved caller threads.
+*/
+class TaskPool {
+public:
+
+    /*!
+      \brief job priority lane
+    */
+    enum Priority {
+        CRITICAL = 0, //!< work needed by the current decision
+        BACKGROUND = 1, //!< work that may wait
+        PRIORITY_SIZE = 2,
+    };
+
+    //! the maximum number of worker threads
+    static constexpr std::size_t MAX_WORKERS = 64;
+
+private:
+
+    struct Worker;
+
+    std::vector< std::unique_ptr< Worker > > M_workers; //!< fixed worker slots
+    std::atomic< std::size_t > M_worker_count; //!< the number of running workers
+    std::atomic< std::size_t > M_pending; //!< the number of queued jobs
+
+    std::mutex M_mutex; //!< lock for the shared queues and the sleep
+    std::condition_variable M_cond; //!< notified when a job is added
+    std::deque< std::function< void() > > M_jobs[PRIORITY_SIZE]; //!< shared queues
+    bool M_stop; //!< termination flag
+
+    std::mutex M_resize_mutex; //!< lock for changing the worker count
+    std::atomic< std::size_t > M_reserved_callers; //!< the number of caller threads
+
+    TaskPool();
+
+    // not used
+    TaskPool( const TaskPool & ) = delete;
+    TaskPool & operator=( const TaskPool & ) = delete;
+
+public:
+
+    /*!
+      \brief stop all workers
+    */
+    ~TaskPool();
+
+    /*!
+      \brief get the singleton instance
+      \return reference to the instance
+    */
+    static
+    TaskPool & instance();
+
+    /*!
+      \brief change the number of worker threads. must not be called while any graph is running.
+      \param count the number of workers. 0 means that all tasks run on the caller thread.
+    */
+    void setWorkerCount( const std::size_t count );
+
+    /*!
+      \brief start more workers if fewer than the requested count are running.
+      The count is limited by workerLimit(). Unlike setWorkerCount(), this
+      can be called while other agents are running their graphs.
+      \param count the requested number of workers
+    */
+    void requestWorkerCount( const std::size_t count );
+
+    /*!
+      \brief set the number of threads that submit the jobs and also execute them.
+      TeamRunner reserves one thread for each agent.
+      \param count the number of caller threads
+    */
+    void reserveCallers( const std::size_t count );
+
+    /*!
+      \brief get the upper bound of requestWorkerCount()
+      \return the hardware concurrency minus the reserved caller threads
+    */
+    std::size_t workerLimit() const;
+
+    /*!
+      \brief get the number of worker threads
+      \return worker count
+    */
+    std::size_t workerCount() const
+      {
+          return M_worker_count.load( std::memory_order_acquire );
+      }
+
+    /*!
+      \brief add the job to the queue. if no worker is running, the job is executed immediately.
+      \param job job function
+      \param priority priority lane
+    */
+    void submit( std::function< void() > job,
+                 const Priority priority = CRITICAL );
+
+private:
+
+    void startWorkers( const std::size_t count );
+    void stopWorkers();
+
+    bool take( const std::size_t index,
+               std::function< void() > * job );
+
+    void loop( const std::size_t index );
+};
+
+/*!
+  \class TaskGraph
+  \brief set of tasks with the dependencies.
+
+  Each task starts after all of its dependencies have finished. The
+  independent tasks run in parallel on TaskPool, and the caller thread of
+  run() also executes the tasks, so run() never waits for an idle worker.
+  The tasks must write only to their own outputs. The caller merges the
+  outputs in a fixed order after run() to get deterministic results.
+*/
+class TaskGraph {
+public:
+    //! task id type
+    typedef std::size_t Id;
+
+private:
+
+    struct Node {
+        std::function< void() > function_; //!< task body
+        std::vector< Id > dependents_; //!< tasks waiting for this task
+        std::size_t dependency_count_; //!< the number of dependencies
+    };
+
+    struct State;
+
+    std::vector< Node > M_nodes; //!< registered tasks
+
+public:
+
+    /*!
+      \brief add the task
+      \param function task body
+      \param dependencies ids of the tasks that must finish before this task
+      \return id of the added task
+    */
+    Id add( std::function< void() > function,
+            std::initializer_list< Id > dependencies = {} );
+
+    /*!
+      \brief execute all tasks and wait for their completion.
+      The first exception thrown by the tasks is rethrown after all tasks finished.
+      \param parallel if false, all tasks are executed on the caller thread in the order of addition.
+      \param priority priority lane of the tasks executed by the workers
+    */
+    void run( const bool parallel = true,
+              const TaskPool::Priority priority = TaskPool::CRITICAL );
+};
+
+}
+
+#endif
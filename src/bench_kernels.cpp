@@ -0,0 +1,613 @@
+// -*-c++-*-
+
+/*!
+  \file bench_kernels.cpp
+  \brief micro benchmarks of the library's hot kernels
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/action/kick_table.h>
+#include <rcsc/player/player_agent.h>
+#include <rcsc/player/intercept_table.h>
+#include <rcsc/player/soccer_action.h>
+#include <rcsc/player/localization_default.h>
+#include <rcsc/player/visual_sensor.h>
+#include <rcsc/player/body_sensor.h>
+#include <rcsc/formation/formation_parser.h>
+#include <rcsc/geom/delaunay_triangulation.h>
+#include <rcsc/common/audio_codec.h>
+#include <rcsc/common/offline_client.h>
+#include <rcsc/param/param_map.h>
+#include <rcsc/param/cmd_line_parser.h>
+#include <rcsc/rcg/handler.h>
+#include <rcsc/rcg/parser.h>
+#include <rcsc/game_time.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstring>
+
+#ifndef BENCH_DATA_DIR
+#define BENCH_DATA_DIR "bench_data"
+#endif
+
+/*
+  Usage:
+    rcsc_bench_kernels [--data <dir>] [--filter <substring>] [--scale <value>]
+
+  All inputs are read from the data directory (src/bench_data):
+    player.ocl   offline client log of the player 7 of the left team.
+                 the ball rolls from (10,-5) and stops in front of the player.
+    sample.rcg   100 cycles of the game log (version 5).
+    formation-dt.conf  DelaunayTriangulation formation.
+
+  Each line of the result is "<name> <iterations> <ns/op>", so the output
+  can be compared by scripts between the builds. The kernels that need the
+  world model are executed inside the replayed agent at the fixed cycles,
+  so their inputs are the same in every run.
+*/
+
+namespace {
+
+const int SEE_CYCLE = 10; //!< the world model snapshot used by the perception kernels
+const int KICK_CYCLE = 55; //!< the ball is kickable at this cycle
+
+/*-------------------------------------------------------------------*/
+/*!
+  \class BenchContext
+  \brief benchmark settings and results
+*/
+class BenchContext {
+private:
+    std::string M_filter;
+    double M_scale;
+
+public:
+
+    BenchContext( const std::string & filter,
+                  const double scale )
+        : M_filter( filter ),
+          M_scale( scale )
+      { }
+
+    /*!
+      \brief execute the function repeatedly and print the average elapsed time
+      \param name benchmark name
+      \param repeat the number of iterations before scaling
+      \param func benchmark body
+     */
+    template < typename Func >
+    void run( const char * name,
+              const int repeat,
+              Func func ) const
+      {
+          if ( ! M_filter.empty()
+               && std::strstr( name, M_filter.c_str() ) == nullptr )
+          {
+              return;
+          }
+
+          const int n = std::max( 1, static_cast< int >( repeat * M_scale ) );
+
+          // warm up the caches and the lazily created tables
+          func();
+
+          const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+          for ( int i = 0; i < n; ++i )
+          {
+              func();
+          }
+          const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+          const double ns = std::chrono::duration< double, std::nano >( end - start ).count() / n;
+          std::cout << std::left << std::setw( 40 ) << name << std::right
+                    << std::setw( 10 ) << n
+                    << std::setw( 16 ) << std::fixed << std::setprecision( 1 ) << ns
+                    << std::endl;
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \class MessageRecorder
+  \brief offline client that keeps the last sensory messages of the given cycle
+*/
+class MessageRecorder
+    : public rcsc::OfflineClient {
+private:
+    const std::string M_log_file;
+    std::string M_see;
+    std::string M_sense_body;
+
+public:
+
+    explicit
+    MessageRecorder( const std::string & log_file )
+        : M_log_file( log_file )
+      { }
+
+    int receiveMessage() override
+      {
+          const int len = rcsc::OfflineClient::receiveMessage();
+          if ( len > 0 )
+          {
+              if ( ! std::strncmp( message(), "(see ", 5 ) )
+              {
+                  M_see = message();
+              }
+              else if ( ! std::strncmp( message(), "(sense_body ", 12 ) )
+              {
+                  M_sense_body = message();
+              }
+          }
+          return len;
+      }
+
+    bool openOfflineLog( const std::string & ) override
+      {
+          return rcsc::OfflineClient::openOfflineLog( M_log_file );
+      }
+
+    const std::string & see() const { return M_see; }
+    const std::string & senseBody() const { return M_sense_body; }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \class Neck_Fixed
+  \brief turn_neck with zero moment
+*/
+class Neck_Fixed
+    : public rcsc::NeckAction {
+public:
+
+    bool execute( rcsc::PlayerAgent * agent ) override
+      {
+          return agent->doTurnNeck( 0.0 );
+      }
+
+    rcsc::NeckAction * clone() const override
+      {
+          return new Neck_Fixed();
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \class KernelPlayer
+  \brief agent that runs the world model kernels at the fixed cycles
+*/
+class KernelPlayer
+    : public rcsc::PlayerAgent {
+private:
+    const BenchContext & M_bench;
+    const MessageRecorder * M_recorder;
+
+public:
+
+    explicit
+    KernelPlayer( const BenchContext & bench )
+        : rcsc::PlayerAgent(),
+          M_bench( bench ),
+          M_recorder( nullptr )
+      { }
+
+    void setRecorder( const MessageRecorder * recorder )
+      {
+          M_recorder = recorder;
+      }
+
+protected:
+
+    // the recorded log has the turn and turn_neck commands in every cycle.
+    void actionImpl() override
+      {
+          doTurn( 0.0 );
+          setNeckAction( new Neck_Fixed() );
+      }
+
+    void handleActionEnd() override
+      {
+          if ( world().time().cycle() == SEE_CYCLE )
+          {
+              benchPerception();
+          }
+          else if ( world().time().cycle() == KICK_CYCLE )
+          {
+              benchKick();
+          }
+      }
+
+private:
+
+    void benchPerception();
+    void benchKick();
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+KernelPlayer::benchPerception()
+{
+    const rcsc::WorldModel & wm = world();
+    const double version = config().version();
+    const rcsc::GameTime current = wm.time();
+
+
+    {
+        const std::string & msg = M_recorder->see();
+        rcsc::VisualSensor see;
+        long stopped = 0;
+        // the sensor skips the message of the same time. the stopped cycle is changed in each iteration.
+        M_bench.run( "VisualSensor::parse", 20000,
+                     [&]()
+                       {
+                           see.parse( msg.c_str(), config().teamName(), version,
+                                      rcsc::GameTime( current.cycle(), ++stopped ) );
+                       } );
+    }
+
+    {
+        const std::string & msg = M_recorder->senseBody();
+        rcsc::BodySensor body;
+        M_bench.run( "BodySensor::parse", 50000,
+                     [&]()
+                       {
+                           body.parse( msg.c_str(), version, current );
+                       } );
+    }
+
+    {
+        rcsc::LocalizationDefault localization;
+        M_bench.run( "LocalizationDefault::localizeSelf", 20000,
+                     [&]()
+                       {
+                           double face = 0.0, face_err = 0.0;
+                           rcsc::Vector2D pos, pos_err;
+                           if ( localization.estimateSelfFace( wm, visualSensor(), &face, &face_err ) )
+                           {
+                               localization.localizeSelf( wm, visualSensor(), effector(),
+                                                          face, face_err, &pos, &pos_err );
+                           }
+                       } );
+    }
+
+    // the table skips the update in the same cycle. a new table is used in each iteration.
+    M_bench.run( "InterceptTable::update", 2000,
+                 [&]()
+                   {
+                       rcsc::InterceptTable table;
+                       table.update( wm );
+                   } );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+KernelPlayer::benchKick()
+{
+    const rcsc::WorldModel & wm = world();
+    if ( ! wm.self().isKickable() )
+    {
+        std::cerr << "(benchKick) the ball is not kickable at " << wm.time() << std::endl;
+        return;
+    }
+
+    const rcsc::Vector2D targets[] = {
+        wm.self().pos() + rcsc::Vector2D( 20.0, 0.0 ),
+        wm.self().pos() + rcsc::Vector2D( -10.0, 15.0 ),
+        wm.self().pos() + rcsc::Vector2D( 0.0, -25.0 ),
+    };
+
+    rcsc::KickTable & kick_table = rcsc::KickTable::instance();
+    // the memorized result is returned for the same request in the same cycle.
+    kick_table.setMemoCapacity( 0 );
+
+    std::size_t index = 0;
+    M_bench.run( "KickTable::simulate", 5000,
+                 [&]()
+                   {
+                       rcsc::KickTable::Sequence seq;
+                       kick_table.simulate( wm, targets[index], 2.5, 2.0, 3, seq );
+                       index = ( index + 1 ) % ( sizeof( targets ) / sizeof( targets[0] ) );
+                   } );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \class ShowCollector
+  \brief rcg handler that counts the show data and keeps the first one
+*/
+class ShowCollector
+    : public rcsc::rcg::Handler {
+private:
+    int M_count;
+    rcsc::rcg::ShowInfoT M_first;
+
+public:
+
+    ShowCollector()
+        : M_count( 0 )
+      { }
+
+    int count() const { return M_count; }
+    const rcsc::rcg::ShowInfoT & first() const { return M_first; }
+
+    bool handleEOF() override { return true; }
+    bool handleShow( const rcsc::rcg::ShowInfoT & show ) override
+      {
+          if ( M_count++ == 0 )
+          {
+              M_first = show;
+          }
+          return true;
+      }
+    bool handleMsg( const int, const int, const std::string & ) override { return true; }
+    bool handleDraw( const int, const rcsc::rcg::drawinfo_t & ) override { return true; }
+    bool handlePlayMode( const int, const rcsc::PlayMode ) override { return true; }
+    bool handleTeam( const int, const rcsc::rcg::TeamT &, const rcsc::rcg::TeamT & ) override { return true; }
+    bool handleServerParam( const rcsc::rcg::ServerParamT & ) override { return true; }
+    bool handlePlayerParam( const rcsc::rcg::PlayerParamT & ) override { return true; }
+    bool handlePlayerType( const rcsc::rcg::PlayerTypeT & ) override { return true; }
+    bool handleTeamGraphic( const char, const int, const int,
+                            const std::vector< std::string > & ) override { return true; }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+read_file( const std::string & path,
+           std::string * data )
+{
+    std::ifstream fin( path.c_str(), std::ios_base::binary );
+    if ( ! fin )
+    {
+        std::cerr << "Failed to open [" << path << "]" << std::endl;
+        return false;
+    }
+
+    std::ostringstream os;
+    os << fin.rdbuf();
+    *data = os.str();
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+bench_rcg( const BenchContext & bench,
+           const std::string & data_dir,
+           std::vector< rcsc::Vector2D > * points )
+{
+    std::string rcg;
+    if ( ! read_file( data_dir + "/sample.rcg", &rcg ) )
+    {
+        return false;
+    }
+
+    ShowCollector collector;
+    const auto parse_rcg = [&]()
+        {
+            std::istringstream is( rcg );
+            rcsc::rcg::Parser::Ptr parser = rcsc::rcg::Parser::create( is );
+            collector = ShowCollector();
+            if ( parser )
+            {
+                parser->parse( is, collector );
+            }
+        };
+
+    parse_rcg();
+    bench.run( "rcg::Parser::parse", 20, parse_rcg );
+
+    if ( collector.count() == 0 )
+    {
+        std::cerr << "(bench_rcg) no show data" << std::endl;
+        return false;
+    }
+
+    points->clear();
+    points->emplace_back( collector.first().ball_.x_, collector.first().ball_.y_ );
+    for ( const rcsc::rcg::PlayerT & p : collector.first().player_ )
+    {
+        points->emplace_back( p.x_, p.y_ );
+    }
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+bench_geometry( const BenchContext & bench,
+                const std::string & data_dir,
+                const std::vector< rcsc::Vector2D > & points )
+{
+    rcsc::Formation::Ptr formation = rcsc::FormationParser::parse( data_dir + "/formation-dt.conf" );
+    if ( formation )
+    {
+        std::vector< rcsc::Vector2D > focus_points;
+        for ( double x = -50.0; x <= 50.0; x += 10.0 )
+        {
+            for ( double y = -30.0; y <= 30.0; y += 10.0 )
+            {
+                focus_points.emplace_back( x, y );
+            }
+        }
+
+        std::vector< rcsc::Vector2D > positions;
+        std::size_t index = 0;
+        bench.run( "FormationDT::getPositions", 50000,
+                   [&]()
+                     {
+                         formation->getPositions( focus_points[index], positions );
+                         index = ( index + 1 ) % focus_points.size();
+                     } );
+    }
+    else
+    {
+        std::cerr << "(bench_geometry) failed to read the formation" << std::endl;
+    }
+
+    const rcsc::Rect2D pitch( rcsc::Vector2D( -60.0, -45.0 ),
+                              rcsc::Size2D( 120.0, 90.0 ) );
+    rcsc::DelaunayTriangulation delaunay;
+    bench.run( "DelaunayTriangulation::compute", 20000,
+               [&]()
+                 {
+                     delaunay.init( pitch );
+                     delaunay.addVertices( points );
+                     delaunay.compute();
+                 } );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+bench_audio( const BenchContext & bench,
+             const std::vector< rcsc::Vector2D > & points )
+{
+    const rcsc::AudioCodec & codec = rcsc::AudioCodec::i();
+    const rcsc::Vector2D vel( 1.2, -0.8 );
+
+    std::string str;
+    std::size_t index = 0;
+    bench.run( "AudioCodec::encodePosVelToStr5", 200000,
+               [&]()
+                 {
+                     codec.encodePosVelToStr5( points[index], vel, str );
+                     index = ( index + 1 ) % points.size();
+                 } );
+
+    std::vector< std::string > messages;
+    for ( const rcsc::Vector2D & p : points )
+    {
+        if ( codec.encodePosVelToStr5( p, vel, str ) )
+        {
+            messages.push_back( str );
+        }
+    }
+
+    if ( ! messages.empty() )
+    {
+        rcsc::Vector2D pos, v;
+        index = 0;
+        bench.run( "AudioCodec::decodeStr5ToPosVel", 200000,
+                   [&]()
+                     {
+                         codec.decodeStr5ToPosVel( messages[index], &pos, &v );
+                         index = ( index + 1 ) % messages.size();
+                     } );
+    }
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+main( int argc, char **argv )
+{
+    std::string data_dir = BENCH_DATA_DIR;
+    std::string filter;
+    double scale = 1.0;
+
+    {
+        rcsc::ParamMap bench_param_map( "Bench options" );
+        bench_param_map.add()
+            ( "data", "", &data_dir, "specifies the input data directory." )
+            ( "filter", "", &filter, "runs only the benchmarks whose name contain this string." )
+            ( "scale", "", &scale, "specifies the scale of the iteration count." );
+
+        rcsc::CmdLineParser cmd_parser( argc, argv );
+        cmd_parser.parse( bench_param_map );
+    }
+
+    const BenchContext bench( filter, scale );
+
+    std::cout << std::left << std::setw( 40 ) << "benchmark" << std::right
+              << std::setw( 10 ) << "iterations"
+              << std::setw( 16 ) << "ns/op" << std::endl;
+
+    std::vector< rcsc::Vector2D > points;
+    if ( ! bench_rcg( bench, data_dir, &points ) )
+    {
+        return 1;
+    }
+
+    bench_geometry( bench, data_dir, points );
+    bench_audio( bench, points );
+
+    if ( ! rcsc::KickTable::instance().createTables() )
+    {
+        std::cerr << "Failed to create the kick table" << std::endl;
+        return 1;
+    }
+
+    {
+        // the other player options are not given, so the agent uses the default settings.
+        // player.ocl is written in the protocol version 18.
+        const char * agent_argv[] = { argv[0], "--version", "18" };
+        rcsc::CmdLineParser cmd_parser( 3, agent_argv );
+
+        KernelPlayer agent( bench );
+        if ( ! agent.init( cmd_parser ) )
+        {
+            return 1;
+        }
+
+        std::shared_ptr< MessageRecorder > client( new MessageRecorder( data_dir + "/player.ocl" ) );
+        agent.setRecorder( client.get() );
+        agent.setClient( client );
+        client->run( &agent );
+    }
+
+    return 0;
+}
@@ -0,0 +1,395 @@
+// -*-c++-*-
+
+/*!
+  \file bench_player.cpp
+  \brief deterministic offline replay benchmark of PlayerAgent
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/player/player_agent.h>
+#include <rcsc/player/intercept_table.h>
+#include <rcsc/common/offline_client.h>
+#include <rcsc/common/server_param.h>
+#include <rcsc/param/param_map.h>
+#include <rcsc/param/cmd_line_parser.h>
+#include <rcsc/util/performance_monitor.h>
+
+#include <functional>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <cstdint>
+
+/*
+  Usage:
+    rcsc_bench_player --bench-log <offline client log> [--bench-decision none|chase]
+                      [--bench-repeat N] [player options...]
+
+  If --version is not given, the agent uses the protocol version 18 in
+  which bench_data/player.ocl is recorded. The other logs need their own
+  --version option.
+
+  The offline client log is recorded by a player started with
+  --offline_logging. The log is replayed as fast as possible, and the
+  elapsed time of each phase is measured by rcsc::g_performance_monitor.
+  The phases are nested: player_parse includes the world model update
+  by sense_body and see, and player_world_update includes
+  player_intercept.
+
+  The digest is a 64 bit FNV-1a hash of the world model outputs (self,
+  ball and intercept steps) and the sent commands of every decision.
+  The same log, decision and binary options give the same digest, so
+  an optimization can be checked to be behaviour preserving by comparing
+  the digests before and after the change.
+*/
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \class Digest
+  \brief FNV-1a hash of the replay outputs
+*/
+class Digest {
+private:
+    std::uint64_t M_value;
+    std::uint64_t M_decisions;
+
+public:
+
+    Digest()
+        : M_value( 0xcbf29ce484222325ull ),
+          M_decisions( 0 )
+      { }
+
+    void addBytes( const void * data,
+                   const std::size_t size )
+      {
+          const unsigned char * p = static_cast< const unsigned char * >( data );
+          for ( std::size_t i = 0; i < size; ++i )
+          {
+              M_value ^= p[i];
+              M_value *= 0x100000001b3ull;
+          }
+      }
+
+    void addInt( const long value )
+      {
+          const std::int64_t v = value;
+          addBytes( &v, sizeof( v ) );
+      }
+
+    // the bit pattern is hashed. -0.0 and 0.0 are regarded as different values.
+    void addDouble( const double value )
+      {
+          addBytes( &value, sizeof( value ) );
+      }
+
+    void addString( const char * str )
+      {
+          addBytes( str, std::strlen( str ) );
+      }
+
+    void addDecision()
+      {
+          ++M_decisions;
+      }
+
+    std::uint64_t value() const
+      {
+          return M_value;
+      }
+
+    std::uint64_t decisions() const
+      {
+          return M_decisions;
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \class BenchClient
+  \brief offline client that reads the given log and records the sent commands
+*/
+class BenchClient
+    : public rcsc::OfflineClient {
+private:
+    const std::string M_log_file;
+    Digest & M_digest;
+
+public:
+
+    BenchClient( const std::string & log_file,
+                 Digest & digest )
+        : M_log_file( log_file ),
+          M_digest( digest )
+      { }
+
+    int sendMessage( const char * msg ) override
+      {
+          M_digest.addString( msg );
+          return 1;
+      }
+
+    // the file name created by PlayerAgent from the team name is replaced.
+    bool openOfflineLog( const std::string & filepath ) override
+      {
+          return rcsc::OfflineClient::openOfflineLog( M_log_file.empty()
+                                                      ? filepath
+                                                      : M_log_file );
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \class BenchPlayer
+  \brief player agent that executes the given decision and records the world model outputs
+*/
+class BenchPlayer
+    : public rcsc::PlayerAgent {
+public:
+    //! decision function. called in actionImpl().
+    typedef std::function< void( rcsc::PlayerAgent * ) > Decision;
+
+private:
+    Decision M_decision;
+    Digest & M_digest;
+
+public:
+
+    BenchPlayer( Decision decision,
+                 Digest & digest )
+        : rcsc::PlayerAgent(),
+          M_decision( decision ),
+          M_digest( digest )
+      { }
+
+protected:
+
+    void actionImpl() override
+      {
+          if ( M_decision )
+          {
+              M_decision( this );
+          }
+      }
+
+    void handleActionEnd() override
+      {
+          const rcsc::WorldModel & wm = world();
+
+          M_digest.addDecision();
+          M_digest.addInt( wm.time().cycle() );
+          M_digest.addInt( wm.time().stopped() );
+          M_digest.addDouble( wm.self().pos().x );
+          M_digest.addDouble( wm.self().pos().y );
+          M_digest.addDouble( wm.self().vel().x );
+          M_digest.addDouble( wm.self().vel().y );
+          M_digest.addDouble( wm.self().body().degree() );
+          M_digest.addDouble( wm.self().stamina() );
+          M_digest.addDouble( wm.ball().pos().x );
+          M_digest.addDouble( wm.ball().pos().y );
+          M_digest.addDouble( wm.ball().vel().x );
+          M_digest.addDouble( wm.ball().vel().y );
+          M_digest.addInt( wm.interceptTable().selfStep() );
+          M_digest.addInt( wm.interceptTable().teammateStep() );
+          M_digest.addInt( wm.interceptTable().opponentStep() );
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief stub decision. chase the ball by turn and dash commands.
+*/
+void
+chase_ball( rcsc::PlayerAgent * agent )
+{
+    const rcsc::WorldModel & wm = agent->world();
+    if ( ! wm.ball().posValid() )
+    {
+        agent->doTurn( 60.0 );
+        return;
+    }
+
+    const rcsc::AngleDeg rel_angle = ( wm.ball().pos() - wm.self().pos() ).th() - wm.self().body();
+    if ( rel_angle.abs() > 15.0 )
+    {
+        agent->doTurn( rel_angle );
+    }
+    else
+    {
+        agent->doDash( rcsc::ServerParam::i().maxDashPower() );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+print_timer( const char * name )
+{
+    rcsc::PerformanceMonitor::TimerStats stats;
+    if ( ! rcsc::g_performance_monitor.getTimerStats( name, &stats ) )
+    {
+        std::cout << std::setw( 20 ) << name << "  (no sample)\n";
+        return;
+    }
+
+    std::cout << std::setw( 20 ) << name
+              << std::setw( 10 ) << stats.call_count
+              << std::setw( 12 ) << stats.total_nanoseconds * 1.0e-6
+              << std::setw( 12 ) << stats.averageNanoseconds() * 1.0e-3
+              << std::setw( 12 ) << stats.p50_nanoseconds * 1.0e-3
+              << std::setw( 12 ) << stats.p99_nanoseconds * 1.0e-3
+              << std::setw( 12 ) << stats.max_nanoseconds * 1.0e-3
+              << '\n';
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+main( int argc, char **argv )
+{
+    std::string log_file;
+    std::string decision_name = "none";
+    int repeat = 1;
+
+    {
+        rcsc::ParamMap bench_param_map( "Bench options" );
+        bench_param_map.add()
+            ( "bench-log", "", &log_file, "specifies the offline client log file to be replayed." )
+            ( "bench-decision", "", &decision_name, "specifies the decision. none or chase." )
+            ( "bench-repeat", "", &repeat, "specifies the number of replays." );
+
+        rcsc::CmdLineParser cmd_parser( argc, argv );
+        cmd_parser.parse( bench_param_map );
+
+        if ( cmd_parser.count( "help" ) > 0 )
+        {
+            bench_param_map.printHelp( std::cout );
+        }
+    }
+
+    BenchPlayer::Decision decision;
+    if ( decision_name == "chase" )
+    {
+        decision = &chase_ball;
+    }
+    else if ( decision_name != "none" )
+    {
+        std::cerr << "Unknown decision [" << decision_name << "]" << std::endl;
+        return 1;
+    }
+
+    // player.ocl is written in the protocol version 18. the default version
+    // of the agent is older, and all sense_body messages would be rejected.
+    std::vector< const char * > agent_argv( argv, argv + argc );
+    if ( std::none_of( argv + 1, argv + argc,
+                       []( const char * arg )
+                         {
+                             return std::strcmp( arg, "--version" ) == 0
+                                 || std::strncmp( arg, "--version=", 10 ) == 0
+                                 || std::strcmp( arg, "-v" ) == 0;
+                         } ) )
+    {
+        agent_argv.push_back( "--version" );
+        agent_argv.push_back( "18" );
+    }
+
+    std::uint64_t first_digest = 0;
+    bool deterministic = true;
+
+    rcsc::g_performance_monitor.setEnabled( true );
+    rcsc::g_performance_monitor.reset();
+
+    for ( int i = 0; i < std::max( 1, repeat ); ++i )
+    {
+        Digest digest;
+        BenchPlayer agent( decision, digest );
+
+        rcsc::CmdLineParser cmd_parser( static_cast< int >( agent_argv.size() ), agent_argv.data() );
+        if ( ! agent.init( cmd_parser ) )
+        {
+            return 1;
+        }
+
+        std::shared_ptr< rcsc::AbstractClient > client( new BenchClient( log_file, digest ) );
+        agent.setClient( client );
+        client->run( &agent );
+
+        std::cout << "replay " << i
+                  << ": decisions= " << digest.decisions()
+                  << " digest= " << std::hex << std::setw( 16 ) << std::setfill( '0' )
+                  << digest.value()
+                  << std::dec << std::setfill( ' ' )
+                  << std::endl;
+
+        if ( i == 0 )
+        {
+            first_digest = digest.value();
+        }
+        else if ( digest.value() != first_digest )
+        {
+            deterministic = false;
+        }
+    }
+
+    std::cout << '\n'
+              << std::setw( 20 ) << "phase"
+              << std::setw( 10 ) << "calls"
+              << std::setw( 12 ) << "total[ms]"
+              << std::setw( 12 ) << "avg[us]"
+              << std::setw( 12 ) << "p50[us]"
+              << std::setw( 12 ) << "p99[us]"
+              << std::setw( 12 ) << "max[us]"
+              << '\n';
+    print_timer( "player_parse" );
+    print_timer( "player_world_update" );
+    print_timer( "player_intercept" );
+    print_timer( "player_action" );
+    std::cout << std::flush;
+
+    if ( ! deterministic )
+    {
+        std::cerr << "***WARNING*** the digests are different among the replays." << std::endl;
+        return 2;
+    }
+
+    return 0;
+}
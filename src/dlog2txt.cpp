@@ -0,0 +1,104 @@
+// -*-c++-*-
+
+/*!
+  \file dlog2txt.cpp
+  \brief binary debug log to text converter source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/common/logger.h>
+
+#include <iostream>
+#include <cstdio>
+
+/*---------------------------------------------------------------*/
+/*
+
+*/
+static
+void
+usage( const char * prog )
+{
+    std::cerr << "Usage: " << prog <<  " <BinaryLogFile> [<OutputFile>]\n"
+              << "  Expand the binary debug log written by the asynchronous Logger\n"
+              << "  to the text format. If no output file is given, the standard output is used."
+              << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////
+
+int
+main( int argc, char ** argv )
+{
+    if ( argc < 2 || 3 < argc )
+    {
+        usage( argv[0] );
+        return 1;
+    }
+
+    FILE * fin = std::fopen( argv[1], "rb" );
+    if ( ! fin )
+    {
+        std::cerr << "Failed to open the input file [" << argv[1] << "]" << std::endl;
+        return 1;
+    }
+
+    FILE * fout = stdout;
+    if ( argc == 3 )
+    {
+        fout = std::fopen( argv[2], "w" );
+        if ( ! fout )
+        {
+            std::cerr << "Failed to open the output file [" << argv[2] << "]" << std::endl;
+            std::fclose( fin );
+            return 1;
+        }
+    }
+
+    const bool result = rcsc::Logger::convertBinaryLog( fin, fout );
+
+    std::fclose( fin );
+    if ( fout != stdout )
+    {
+        std::fclose( fout );
+    }
+    else
+    {
+        std::fflush( fout );
+    }
+
+    if ( ! result )
+    {
+        std::cerr << "Broken or unsupported binary log [" << argv[1] << "]" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,151 @@
+// -*-c++-*-
+
+/*!
+  \file dlogc2txt.cpp
+  \brief debug log container to text converter source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/common/log_container.h>
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdlib>
+
+/*---------------------------------------------------------------*/
+/*
+
+*/
+static
+void
+usage( const char * prog )
+{
+    std::cerr << "Usage: " << prog <<  " <ContainerFile> [<AgentName> [<OutputFile> [<StartCycle> <EndCycle>]]]\n"
+              << "  Extract the text debug log of one agent from the log container\n"
+              << "  shared by all agents. The output can be opened by soccerwindow2.\n"
+              << "  If no agent name is given, the agents in the container are listed.\n"
+              << "  If no output file is given or it is '-', the standard output is used."
+              << std::endl;
+}
+
+/*---------------------------------------------------------------*/
+/*
+
+*/
+static
+void
+print_agents( const rcsc::LogContainerReader & reader )
+{
+    for ( std::size_t i = 0; i < reader.agents().size(); ++i )
+    {
+        long first_cycle = -1;
+        long last_cycle = -1;
+        int count = 0;
+        for ( const rcsc::LogContainerReader::Chunk & c : reader.chunks() )
+        {
+            if ( c.agent_ != static_cast< int >( i ) ) continue;
+
+            if ( count == 0 ) first_cycle = c.cycle_;
+            last_cycle = c.cycle_;
+            ++count;
+        }
+
+        std::cout << reader.agents()[i]
+                  << " chunks=" << count
+                  << " cycles=[" << first_cycle << ',' << last_cycle << ']'
+                  << '\n';
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+
+int
+main( int argc, char ** argv )
+{
+    if ( argc < 2
+         || argc == 5
+         || 6 < argc )
+    {
+        usage( argv[0] );
+        return 1;
+    }
+
+    rcsc::LogContainerReader reader;
+    if ( ! reader.open( argv[1] ) )
+    {
+        std::cerr << "Broken or unsupported log container [" << argv[1] << "]" << std::endl;
+        return 1;
+    }
+
+    if ( argc == 2 )
+    {
+        print_agents( reader );
+        return 0;
+    }
+
+    const std::string agent_name = argv[2];
+    if ( reader.findAgent( agent_name ) < 0 )
+    {
+        std::cerr << "No agent [" << agent_name << "] in the log container." << std::endl;
+        return 1;
+    }
+
+    long start_cycle = 0;
+    long end_cycle = 99999999;
+    if ( argc == 6 )
+    {
+        start_cycle = std::strtol( argv[4], nullptr, 10 );
+        end_cycle = std::strtol( argv[5], nullptr, 10 );
+    }
+
+    std::ofstream fout;
+    if ( argc >= 4
+         && std::string( argv[3] ) != "-" )
+    {
+        fout.open( argv[3] );
+        if ( ! fout )
+        {
+            std::cerr << "Failed to open the output file [" << argv[3] << "]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::ostream & os = ( fout.is_open() ? static_cast< std::ostream & >( fout ) : std::cout );
+    if ( ! reader.extract( agent_name, start_cycle, end_cycle, os ) )
+    {
+        std::cerr << "Failed to extract [" << agent_name << "]" << std::endl;
+        return 1;
+    }
+
+    os.flush();
+    return 0;
+}
@@ -0,0 +1,998 @@
+// -*-c++-*-
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/param/param_map.h>
+#include <rcsc/param/cmd_line_parser.h>
+
+#include <rcsc/types.h>
+#include <rcsc/gz.h>
+#include <rcsc/rcg.h>
+
+#include "tracking_columns.h"
+
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+/*!
+  \class FlatBuilder
+  \brief minimal flatbuffers encoder for the Arrow IPC metadata.
+
+  Objects are written from the front: the vtable, the table and then its
+  children, so all offsets point forward as the format requires.
+  Every scalar is placed at its natural alignment relative to the buffer top.
+*/
+class FlatBuilder {
+public:
+
+    /*!
+      \brief table field. a scalar value or an offset to a child object.
+     */
+    struct Field {
+        int id_; //!< field id in the schema
+        int size_; //!< byte size of the inline value
+        std::uint64_t value_; //!< scalar value
+        std::function< std::size_t() > child_; //!< writes the child object and returns its position
+
+        Field( const int id,
+               const int size,
+               const std::uint64_t value )
+            : id_( id ),
+              size_( size ),
+              value_( value )
+          { }
+
+        Field( const int id,
+               std::function< std::size_t() > child )
+            : id_( id ),
+              size_( 4 ),
+              value_( 0 ),
+              child_( child )
+          { }
+    };
+
+private:
+
+    std::string M_buf;
+
+public:
+
+    /*!
+      \brief create the buffer that has the root table
+      \param root writes the root table and returns its position
+      \return encoded buffer padded to 8 bytes
+     */
+    const std::string & finish( std::function< std::size_t() > root )
+      {
+          M_buf.clear();
+          put< std::uint32_t >( 0 );
+          patch( 0, root() );
+          pad( 8 );
+          return M_buf;
+      }
+
+    std::size_t table( std::vector< Field > fields )
+      {
+          std::stable_sort( fields.begin(), fields.end(),
+                            []( const Field & lhs, const Field & rhs )
+                              {
+                                  return lhs.size_ > rhs.size_;
+                              } );
+
+          int max_id = -1;
+          for ( const Field & f : fields ) max_id = std::max( max_id, f.id_ );
+
+          // the table starts at 4 (mod 8), so a field at 'rel' is aligned if 4 + rel is.
+          std::vector< std::uint16_t > vtable( max_id + 1, 0 );
+          std::vector< std::size_t > rels;
+          std::size_t rel = 4;
+          for ( const Field & f : fields )
+          {
+              rel = ( 4 + rel + f.size_ - 1 ) / f.size_ * f.size_ - 4;
+              vtable[f.id_] = static_cast< std::uint16_t >( rel );
+              rels.push_back( rel );
+              rel += f.size_;
+          }
+
+          pad( 2 );
+          const std::size_t vtable_pos = M_buf.size();
+          put< std::uint16_t >( static_cast< std::uint16_t >( 4 + 2 * vtable.size() ) );
+          put< std::uint16_t >( static_cast< std::uint16_t >( rel ) );
+          for ( std::uint16_t v : vtable ) put< std::uint16_t >( v );
+
+          pad( 8, 4 );
+          const std::size_t table_pos = M_buf.size();
+          put< std::int32_t >( static_cast< std::int32_t >( table_pos - vtable_pos ) );
+
+          std::vector< std::size_t > slots( fields.size(), 0 );
+          for ( std::size_t i = 0; i < fields.size(); ++i )
+          {
+              M_buf.resize( table_pos + rels[i], '\0' );
+              slots[i] = M_buf.size();
+              const char * bytes = reinterpret_cast< const char * >( &fields[i].value_ );
+              M_buf.append( bytes, fields[i].size_ ); // little endian host
+          }
+
+          for ( std::size_t i = 0; i < fields.size(); ++i )
+          {
+              if ( fields[i].child_ )
+              {
+                  patch( slots[i], fields[i].child_() );
+              }
+          }
+
+          return table_pos;
+      }
+
+    std::size_t string( const std::string & str )
+      {
+          pad( 4 );
+          const std::size_t pos = M_buf.size();
+          put< std::uint32_t >( static_cast< std::uint32_t >( str.size() ) );
+          M_buf.append( str );
+          M_buf.push_back( '\0' );
+          return pos;
+      }
+
+    std::size_t structs( const std::string & bytes,
+                         const std::size_t count )
+      {
+          pad( 8, 4 );
+          const std::size_t pos = M_buf.size();
+          put< std::uint32_t >( static_cast< std::uint32_t >( count ) );
+          M_buf.append( bytes );
+          return pos;
+      }
+
+    std::size_t tables( const std::vector< std::function< std::size_t() > > & children )
+      {
+          pad( 4 );
+          const std::size_t pos = M_buf.size();
+          put< std::uint32_t >( static_cast< std::uint32_t >( children.size() ) );
+          std::vector< std::size_t > slots;
+          for ( std::size_t i = 0; i < children.size(); ++i )
+          {
+              slots.push_back( M_buf.size() );
+              put< std::uint32_t >( 0 );
+          }
+          for ( std::size_t i = 0; i < children.size(); ++i )
+          {
+              patch( slots[i], children[i]() );
+          }
+          return pos;
+      }
+
+private:
+
+    template < typename T >
+    void put( const T value )
+      {
+          M_buf.append( reinterpret_cast< const char * >( &value ), sizeof( T ) );
+      }
+
+    void pad( const std::size_t align,
+              const std::size_t shift = 0 )
+      {
+          while ( ( M_buf.size() + shift ) % align != 0 ) M_buf.push_back( '\0' );
+      }
+
+    void patch( const std::size_t slot,
+                const std::size_t target )
+      {
+          const std::uint32_t offset = static_cast< std::uint32_t >( target - slot );
+          std::memcpy( &M_buf[slot], &offset, sizeof( offset ) );
+      }
+};
+
+
+/*!
+  \class ArrowFileWriter
+  \brief Arrow IPC file (Feather v2) writer for flat tables.
+
+  Values are buffered column by column and written as one record batch
+  by writeBatch(). The file is readable by pyarrow.ipc.open_file(),
+  pandas.read_feather() and the other Arrow implementations.
+*/
+class ArrowFileWriter {
+private:
+
+    //! buffered values of one column
+    struct ColumnData {
+        std::string values_; //!< fixed size values or utf8 bytes
+        std::vector< std::int32_t > offsets_; //!< utf8 offsets
+        std::string validity_; //!< validity bitmap
+        std::int64_t null_count_; //!< the number of null values
+    };
+
+    //! record batch location in the file
+    struct Block {
+        std::int64_t offset_;
+        std::int32_t meta_length_;
+        std::int32_t padding_;
+        std::int64_t body_length_;
+    };
+
+    //! Arrow metadata version V5
+    static constexpr std::int16_t METADATA_VERSION = 4;
+
+    std::ostream & M_os;
+    const std::vector< tracking::Column > M_schema;
+    std::vector< ColumnData > M_data;
+    std::int64_t M_rows;
+    std::int64_t M_file_offset;
+    std::vector< Block > M_blocks;
+
+public:
+
+    ArrowFileWriter( std::ostream & os,
+                     const std::vector< tracking::Column > & schema )
+        : M_os( os ),
+          M_schema( schema ),
+          M_data( schema.size() ),
+          M_rows( 0 ),
+          M_file_offset( 0 )
+      {
+          clearData();
+      }
+
+    std::int64_t rows() const
+      {
+          return M_rows;
+      }
+
+    /*!
+      \brief write the file magic and the schema message
+     */
+    bool writeHeader()
+      {
+          write( "ARROW1\0\0", 8 );
+
+          FlatBuilder fb;
+          writeMessage( fb.finish( [&]()
+                                     {
+                                         return message( fb, 1, [&]() { return schema( fb ); }, 0 );
+                                     } ),
+                        std::string() );
+          return static_cast< bool >( M_os );
+      }
+
+    void appendInt32( const std::size_t col,
+                      const std::int32_t value )
+      {
+          appendValue( col, &value, sizeof( value ) );
+      }
+
+    void appendFloat32( const std::size_t col,
+                        const float value )
+      {
+          appendValue( col, &value, sizeof( value ) );
+      }
+
+    void appendFloat64( const std::size_t col,
+                        const double value )
+      {
+          appendValue( col, &value, sizeof( value ) );
+      }
+
+    void appendString( const std::size_t col,
+                       const std::string_view value )
+      {
+          ColumnData & d = M_data[col];
+          d.values_.append( value.data(), value.size() );
+          d.offsets_.push_back( static_cast< std::int32_t >( d.values_.size() ) );
+          setValid( col, true );
+      }
+
+    void appendNull( const std::size_t col )
+      {
+          ColumnData & d = M_data[col];
+          if ( M_schema[col].type_ == tracking::STRING )
+          {
+              d.offsets_.push_back( static_cast< std::int32_t >( d.values_.size() ) );
+          }
+          else
+          {
+              d.values_.append( valueSize( col ), '\0' );
+          }
+          ++d.null_count_;
+          setValid( col, false );
+      }
+
+    /*!
+      \brief finish the current row. every column must have one value.
+     */
+    void endRow()
+      {
+          ++M_rows;
+      }
+
+    /*!
+      \brief write the buffered rows as one record batch
+     */
+    bool writeBatch()
+      {
+          if ( M_rows == 0 )
+          {
+              return true;
+          }
+
+          std::string body;
+          std::string nodes;
+          std::string buffers;
+          std::size_t n_buffers = 0;
+
+          const auto add_buffer = [&]( const void * data, const std::size_t size )
+                                    {
+                                        const std::int64_t entry[2] = { static_cast< std::int64_t >( body.size() ),
+                                                                        static_cast< std::int64_t >( size ) };
+                                        buffers.append( reinterpret_cast< const char * >( entry ), sizeof( entry ) );
+                                        body.append( static_cast< const char * >( data ), size );
+                                        body.append( ( 8 - body.size() % 8 ) % 8, '\0' );
+                                        ++n_buffers;
+                                    };
+
+          for ( std::size_t i = 0; i < M_schema.size(); ++i )
+          {
+              const ColumnData & d = M_data[i];
+              const std::int64_t node[2] = { M_rows, d.null_count_ };
+              nodes.append( reinterpret_cast< const char * >( node ), sizeof( node ) );
+
+              if ( d.null_count_ > 0 )
+              {
+                  add_buffer( d.validity_.data(), d.validity_.size() );
+              }
+              else
+              {
+                  add_buffer( nullptr, 0 );
+              }
+
+              if ( M_schema[i].type_ == tracking::STRING )
+              {
+                  add_buffer( d.offsets_.data(), d.offsets_.size() * sizeof( std::int32_t ) );
+              }
+              add_buffer( d.values_.data(), d.values_.size() );
+          }
+
+          const std::int64_t length = M_rows;
+          const std::int64_t body_length = static_cast< std::int64_t >( body.size() );
+
+          FlatBuilder fb;
+          const std::string & meta
+              = fb.finish( [&]()
+                             {
+                                 return message( fb, 3,
+                                                 [&]()
+                                                   {
+                                                       return fb.table( {
+                                                               FlatBuilder::Field( 0, 8, static_cast< std::uint64_t >( length ) ),
+                                                               FlatBuilder::Field( 1, [&]() { return fb.structs( nodes, M_schema.size() ); } ),
+                                                               FlatBuilder::Field( 2, [&]() { return fb.structs( buffers, n_buffers ); } ),
+                                                           } );
+                                                   },
+                                                 body_length );
+                             } );
+
+          Block block;
+          block.offset_ = M_file_offset;
+          block.padding_ = 0;
+          block.body_length_ = body_length;
+          block.meta_length_ = writeMessage( meta, body );
+          M_blocks.push_back( block );
+
+          clearData();
+          return static_cast< bool >( M_os );
+      }
+
+    /*!
+      \brief write the remaining rows, the end of stream marker and the footer
+     */
+    bool close()
+      {
+          if ( ! writeBatch() )
+          {
+              return false;
+          }
+
+          const std::uint32_t eos[2] = { 0xFFFFFFFF, 0 };
+          write( eos, sizeof( eos ) );
+
+          const std::string blocks( reinterpret_cast< const char * >( M_blocks.data() ),
+                                    M_blocks.size() * sizeof( Block ) );
+          FlatBuilder fb;
+          const std::string & footer
+              = fb.finish( [&]()
+                             {
+                                 return fb.table( {
+                                         FlatBuilder::Field( 0, 2, METADATA_VERSION ),
+                                         FlatBuilder::Field( 1, [&]() { return schema( fb ); } ),
+                                         FlatBuilder::Field( 2, [&]() { return fb.structs( std::string(), 0 ); } ),
+                                         FlatBuilder::Field( 3, [&]() { return fb.structs( blocks, M_blocks.size() ); } ),
+                                     } );
+                             } );
+          write( footer.data(), footer.size() );
+
+          const std::int32_t footer_length = static_cast< std::int32_t >( footer.size() );
+          write( &footer_length, sizeof( footer_length ) );
+          write( "ARROW1", 6 );
+
+          M_os.flush();
+          return static_cast< bool >( M_os );
+      }
+
+private:
+
+    void clearData()
+      {
+          for ( std::size_t i = 0; i < M_data.size(); ++i )
+          {
+              ColumnData & d = M_data[i];
+              d.values_.clear();
+              d.offsets_.assign( M_schema[i].type_ == tracking::STRING ? 1 : 0, 0 );
+              d.validity_.clear();
+              d.null_count_ = 0;
+          }
+          M_rows = 0;
+      }
+
+    std::size_t valueSize( const std::size_t col ) const
+      {
+          return ( M_schema[col].type_ == tracking::FLOAT64 ? 8 : 4 );
+      }
+
+    void appendValue( const std::size_t col,
+                      const void * value,
+                      const std::size_t size )
+      {
+          M_data[col].values_.append( static_cast< const char * >( value ), size );
+          setValid( col, true );
+      }
+
+    void setValid( const std::size_t col,
+                   const bool valid )
+      {
+          std::string & bits = M_data[col].validity_;
+          const std::size_t byte = static_cast< std::size_t >( M_rows / 8 );
+          if ( bits.size() <= byte )
+          {
+              bits.resize( byte + 1, '\0' );
+          }
+          if ( valid )
+          {
+              bits[byte] = static_cast< char >( bits[byte] | ( 1 << ( M_rows % 8 ) ) );
+          }
+      }
+
+    void write( const void * data,
+                const std::size_t size )
+      {
+          M_os.write( static_cast< const char * >( data ), size );
+          M_file_offset += static_cast< std::int64_t >( size );
+      }
+
+    /*!
+      \brief write one encapsulated message
+      \return metadata length including the prefix
+     */
+    std::int32_t writeMessage( const std::string & meta,
+                               const std::string & body )
+      {
+          const std::int32_t prefix[2] = { -1, static_cast< std::int32_t >( meta.size() ) };
+          write( prefix, sizeof( prefix ) );
+          write( meta.data(), meta.size() );
+          write( body.data(), body.size() );
+          return static_cast< std::int32_t >( sizeof( prefix ) + meta.size() );
+      }
+
+    std::size_t message( FlatBuilder & fb,
+                         const std::uint8_t header_type,
+                         std::function< std::size_t() > header,
+                         const std::int64_t body_length )
+      {
+          return fb.table( {
+                  FlatBuilder::Field( 0, 2, METADATA_VERSION ),
+                  FlatBuilder::Field( 1, 1, header_type ),
+                  FlatBuilder::Field( 2, header ),
+                  FlatBuilder::Field( 3, 8, static_cast< std::uint64_t >( body_length ) ),
+              } );
+      }
+
+    std::size_t schema( FlatBuilder & fb )
+      {
+          const std::uint16_t one = 1;
+          const bool big_endian = ( *reinterpret_cast< const std::uint8_t * >( &one ) == 0 );
+
+          std::vector< std::function< std::size_t() > > fields;
+          for ( const tracking::Column & c : M_schema )
+          {
+              fields.push_back( [&fb, &c]() { return field( fb, c ); } );
+          }
+
+          return fb.table( {
+                  FlatBuilder::Field( 0, 2, big_endian ? 1 : 0 ),
+                  FlatBuilder::Field( 1, [&]() { return fb.tables( fields ); } ),
+              } );
+      }
+
+    static
+    std::size_t field( FlatBuilder & fb,
+                       const tracking::Column & c )
+      {
+          // Type union: Int = 2, FloatingPoint = 3, Utf8 = 5
+          const std::uint8_t type_type = ( c.type_ == tracking::INT32 ? 2
+                                           : c.type_ == tracking::STRING ? 5
+                                           : 3 );
+          return fb.table( {
+                  FlatBuilder::Field( 0, [&]() { return fb.string( c.name_ ); } ),
+                  FlatBuilder::Field( 1, 1, c.nullable_ ? 1 : 0 ),
+                  FlatBuilder::Field( 2, 1, type_type ),
+                  FlatBuilder::Field( 3, [&]()
+                                           {
+                                               switch ( c.type_ ) {
+                                               case tracking::INT32:
+                                                   return fb.table( { FlatBuilder::Field( 0, 4, 32 ),
+                                                                      FlatBuilder::Field( 1, 1, 1 ) } );
+                                               case tracking::FLOAT32:
+                                                   return fb.table( { FlatBuilder::Field( 0, 2, 1 ) } );
+                                               case tracking::FLOAT64:
+                                                   return fb.table( { FlatBuilder::Field( 0, 2, 2 ) } );
+                                               default:
+                                                   return fb.table( {} );
+                                               }
+                                           } ),
+                  FlatBuilder::Field( 5, [&]() { return fb.tables( {} ); } ),
+              } );
+      }
+};
+
+constexpr std::int16_t ArrowFileWriter::METADATA_VERSION;
+
+}
+
+/////////////////////////////////////////////////////////////////////
+
+/*!
+  \class ArrowPrinter
+  \brief rcg handler that exports the same tables as rcg2csv in the Arrow IPC file format.
+*/
+class ArrowPrinter
+    : public rcsc::rcg::Handler {
+private:
+
+    ArrowFileWriter M_tracking;
+    ArrowFileWriter M_player_types;
+    const int M_batch_size; //!< the number of rows in one record batch
+
+    bool M_failed;
+
+    int M_show_count;
+    int M_cycle;
+    int M_stopped;
+
+    rcsc::PlayMode M_playmode;
+    rcsc::rcg::TeamT M_teams[2];
+
+    // not used
+    ArrowPrinter() = delete;
+public:
+
+    ArrowPrinter( std::ostream & tracking_out,
+                  std::ostream & player_types_out,
+                  const int batch_size );
+
+    bool handleLogVersion( const int ver ) override;
+
+    bool handleEOF() override;
+
+    bool handleShow( const rcsc::rcg::ShowInfoT & show ) override;
+    bool handleMsg( const int,
+                    const int,
+                    const std::string & ) override
+    {
+        return true;
+    }
+    bool handleMsg( const int,
+                    const int,
+                    const std::string_view ) override
+    {
+        return true;
+    }
+    bool handleDraw( const int,
+                     const rcsc::rcg::drawinfo_t & ) override
+    {
+        return true;
+    }
+    bool handlePlayMode( const int time,
+                         const rcsc::PlayMode pm ) override;
+    bool handleTeam( const int time,
+                     const rcsc::rcg::TeamT & team_l,
+                     const rcsc::rcg::TeamT & team_r ) override;
+
+    bool handleServerParam( const rcsc::rcg::ServerParamT & ) override
+    {
+        return true;
+    }
+    bool handlePlayerParam( const rcsc::rcg::PlayerParamT & ) override
+    {
+        return true;
+    }
+    bool handlePlayerType( const rcsc::rcg::PlayerTypeT & param ) override;
+
+    bool handleTeamGraphic( const char,
+                            const int,
+                            const int,
+                            const std::vector< std::string > & ) override
+    {
+        return true;
+    }
+
+private:
+    const std::string & getPlayModeString( const rcsc::PlayMode playmode ) const;
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ArrowPrinter::ArrowPrinter( std::ostream & tracking_out,
+                            std::ostream & player_types_out,
+                            const int batch_size )
+    : M_tracking( tracking_out, tracking::tracking_columns() ),
+      M_player_types( player_types_out, tracking::player_type_columns() ),
+      M_batch_size( std::max( 1, batch_size ) ),
+      M_failed( false ),
+      M_show_count( 0 ),
+      M_cycle( 0 ),
+      M_stopped( 0 ),
+      M_playmode( rcsc::PM_Null )
+{
+    // the command counts and the team graphics are not exported.
+    setProjection( rcsc::rcg::Projection().setFields( rcsc::rcg::Projection::BALL
+                                                      | rcsc::rcg::Projection::PLAYER_POSITION
+                                                      | rcsc::rcg::Projection::PLAYER_VIEW
+                                                      | rcsc::rcg::Projection::PLAYER_STAMINA )
+                   .setTeamGraphic( false ) );
+
+    M_failed = ( ! M_tracking.writeHeader()
+                 || ! M_player_types.writeHeader() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ArrowPrinter::handleLogVersion( const int ver )
+{
+    rcsc::rcg::Handler::handleLogVersion( ver );
+
+    if ( ver < 4 )
+    {
+        std::cerr << "Unsupported RCG version " << ver << std::endl;
+        return false;
+    }
+
+    return ! M_failed;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ArrowPrinter::handleEOF()
+{
+    if ( ! M_tracking.close()
+         || ! M_player_types.close() )
+    {
+        M_failed = true;
+    }
+
+    return ! M_failed;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ArrowPrinter::handleShow( const rcsc::rcg::ShowInfoT & show )
+{
+    ++M_show_count;
+
+    if ( M_cycle == show.time_ )
+    {
+        ++M_stopped;
+    }
+    else
+    {
+        M_cycle = show.time_;
+        M_stopped = 0;
+    }
+
+    std::size_t col = 0;
+    M_tracking.appendInt32( col++, M_show_count );
+    M_tracking.appendInt32( col++, M_cycle );
+    M_tracking.appendInt32( col++, M_stopped );
+    M_tracking.appendString( col++, getPlayModeString( M_playmode ) );
+
+    for ( const rcsc::rcg::TeamT & t : M_teams )
+    {
+        M_tracking.appendString( col++, t.name_ );
+        M_tracking.appendInt32( col++, t.score_ );
+        M_tracking.appendInt32( col++, t.pen_score_ );
+    }
+
+    M_tracking.appendFloat32( col++, show.ball_.x_ );
+    M_tracking.appendFloat32( col++, show.ball_.y_ );
+    M_tracking.appendFloat32( col++, show.ball_.vx_ );
+    M_tracking.appendFloat32( col++, show.ball_.vy_ );
+
+    for ( const rcsc::rcg::PlayerT & p : show.player_ )
+    {
+        if ( p.state_ == rcsc::rcg::DISABLE )
+        {
+            for ( int i = 0; i < tracking::PLAYER_COLUMN_SIZE; ++i )
+            {
+                M_tracking.appendNull( col++ );
+            }
+            continue;
+        }
+
+        M_tracking.appendInt32( col++, p.type_ );
+        M_tracking.appendFloat32( col++, p.x_ );
+        M_tracking.appendFloat32( col++, p.y_ );
+        M_tracking.appendFloat32( col++, p.vx_ );
+        M_tracking.appendFloat32( col++, p.vy_ );
+        M_tracking.appendFloat32( col++, p.body_ );
+        M_tracking.appendFloat32( col++, p.neck_ );
+        M_tracking.appendFloat32( col++, p.view_width_ );
+        M_tracking.appendFloat32( col++, p.stamina_ );
+    }
+
+    M_tracking.endRow();
+
+    if ( M_tracking.rows() >= M_batch_size
+         && ! M_tracking.writeBatch() )
+    {
+        M_failed = true;
+    }
+
+    return ! M_failed;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ArrowPrinter::handlePlayMode( const int,
+                              const rcsc::PlayMode pm )
+{
+    M_playmode = pm;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ArrowPrinter::handleTeam( const int,
+                          const rcsc::rcg::TeamT & team_l,
+                          const rcsc::rcg::TeamT & team_r )
+{
+    M_teams[0] = team_l;
+    M_teams[1] = team_r;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ArrowPrinter::handlePlayerType( const rcsc::rcg::PlayerTypeT & ptype )
+{
+    const double values[] = {
+        ptype.player_speed_max_,
+        ptype.stamina_inc_max_,
+        ptype.player_decay_,
+        ptype.inertia_moment_,
+        ptype.dash_power_rate_,
+        ptype.player_size_,
+        ptype.kickable_margin_,
+        ptype.kick_rand_,
+        ptype.extra_stamina_,
+        ptype.effort_max_,
+        ptype.effort_min_,
+        ptype.kick_power_rate_,
+        ptype.foul_detect_probability_,
+        ptype.catchable_area_l_stretch_,
+    };
+
+    std::size_t col = 0;
+    M_player_types.appendInt32( col++, ptype.id_ );
+    for ( const double v : values )
+    {
+        M_player_types.appendFloat64( col++, v );
+    }
+    M_player_types.endRow();
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const std::string &
+ArrowPrinter::getPlayModeString( const rcsc::PlayMode playmode ) const
+{
+    static const std::string s_playmode_str[] = PLAYMODE_STRINGS;
+
+    if ( playmode < rcsc::PM_Null
+         || rcsc::PM_MAX < playmode )
+    {
+        return s_playmode_str[0];
+    }
+
+    return s_playmode_str[playmode];
+}
+
+////////////////////////////////////////////////////////////////////////
+std::string
+get_base_name( const std::string & path )
+{
+    // remove all extension (".rcg" or ".rcg.gz")from file name
+    std::filesystem::path p( path );
+
+    if ( p.extension() == ".gz" )
+    {
+        p.replace_extension();
+    }
+
+    if ( p.extension() == ".rcg" )
+    {
+        p.replace_extension();
+    }
+
+    return p.string();
+}
+
+////////////////////////////////////////////////////////////////////////
+
+/*!
+  \brief convert one rcg file into the arrow files
+  \param infile input rcg file path
+  \param batch_size the number of shows in one record batch
+  \param os output stream for the file name messages
+  \return result status
+ */
+bool
+convert( const std::string & infile,
+         const int batch_size,
+         std::ostream & os )
+{
+    if ( ! rcsc::compressed_ifstream( infile.c_str() ).is_open() )
+    {
+        std::cerr << "Failed to open file : " << infile << std::endl;
+        return false;
+    }
+
+    const std::string basename = get_base_name( infile );
+    const std::string tracking_file = basename + ".tracking.arrow";
+    const std::string player_types_file = basename + ".player_types.arrow";
+
+    std::ofstream tracking_out( tracking_file, std::ios_base::binary );
+    if ( ! tracking_out.is_open() )
+    {
+        std::cerr << "Failed to open the output file : " << tracking_file << std::endl;
+        return false;
+    }
+
+    std::ofstream player_types_out( player_types_file, std::ios_base::binary );
+    if ( ! player_types_out.is_open() )
+    {
+        std::cerr << "Failed to open the output file : " << player_types_file << std::endl;
+        return false;
+    }
+
+    os << " in:           " << infile << '\n';
+    os << " tracking:     " << tracking_file << '\n';
+    os << " player_types: " << player_types_file << std::endl;
+
+    ArrowPrinter printer( tracking_out, player_types_out, batch_size );
+
+    return rcsc::rcg::BatchRunner::parse( infile, printer );
+}
+
+////////////////////////////////////////////////////////////////////////
+
+int
+main( int argc, char** argv )
+{
+    bool help = false;
+    int batch_size = 4096;
+    int jobs = 1;
+
+    rcsc::ParamMap options( "Options" );
+    options.add()
+        ( "help", "", rcsc::BoolSwitch( &help ), "print help message." )
+        ( "batch-size", "b", &batch_size, "the number of shows in one record batch." )
+        ( "jobs", "j", &jobs, "the number of files converted in parallel. 0 means the number of hardware threads." )
+        ;
+
+    rcsc::CmdLineParser cmd_parser( argc, argv );
+    cmd_parser.parse( options );
+
+    if ( help
+         || cmd_parser.failed()
+         || cmd_parser.positionalOptions().empty() )
+    {
+        std::cerr << " usage:\n";
+        std::cerr << "  " << argv[0] << " [-b <Value>] [-j <Value>] <RCGFile>[.gz] ...\n";
+        options.printHelp( std::cerr );
+        return 0;
+    }
+
+    const std::vector< std::string > files
+        = rcsc::rcg::BatchRunner::expand( cmd_parser.positionalOptions() );
+
+    const rcsc::rcg::BatchRunner runner( jobs );
+    const std::vector< rcsc::rcg::BatchRunner::Result > results
+        = runner.run( files,
+                      [batch_size]( const std::string & infile,
+                                    std::ostream & os )
+                        {
+                            return convert( infile, batch_size, os );
+                        },
+                      std::cerr );
+
+    int result = 0;
+    for ( const rcsc::rcg::BatchRunner::Result & r : results )
+    {
+        if ( ! r.success_ )
+        {
+            std::cerr << "Failed to convert : " << r.filepath_ << std::endl;
+            result = 1;
+        }
+    }
+
+    return result;
+}
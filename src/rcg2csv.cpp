@@ -39,12 +39,15 @@
 #include <rcsc/gz.h>
 #include <rcsc/rcg.h>
 
+#include "tracking_columns.h"
+
 #include <filesystem>
 #include <fstream>
 #include <sstream>
 #include <string>
 #include <iomanip>
 #include <iostream>
+#include <vector>
 #include <cmath>
 
 
@@ -99,6 +102,8 @@ private:
     std::ostream & M_tracking_out;
     std::ostream & M_player_types_out;
 
+    bool M_player_types_header; //!< true if the header line of player types has been printed.
+
     int M_show_count;
 
     rcsc::rcg::UInt32 M_cycle;
@@ -125,6 +130,9 @@ public:
     bool handleMsg( const int time,
                     const int board,
                     const std::string & msg ) override;
+    bool handleMsg( const int time,
+                    const int board,
+                    const std::string_view msg ) override;
     bool handleDraw( const int time,
                      const rcsc::rcg::drawinfo_t & draw ) override;
     bool handlePlayMode( const int time,
@@ -176,12 +184,18 @@ CSVPrinter::CSVPrinter( std::ostream & tracking_out,
                         std::ostream & player_types_out)
     : M_tracking_out( tracking_out ),
       M_player_types_out( player_types_out ),
+      M_player_types_header( false ),
       M_show_count( 0 ),
       M_cycle( 0 ),
       M_stopped( 0 ),
       M_playmode( rcsc::PM_Null )
 {
-
+    // the command counts and the team graphics are not printed.
+    setProjection( rcsc::rcg::Projection().setFields( rcsc::rcg::Projection::BALL
+                                                      | rcsc::rcg::Projection::PLAYER_POSITION
+                                                      | rcsc::rcg::Projection::PLAYER_VIEW
+                                                      | rcsc::rcg::Projection::PLAYER_STAMINA )
+                   .setTeamGraphic( false ) );
 }
 
 /*-------------------------------------------------------------------*/
@@ -258,6 +272,19 @@ CSVPrinter::handleMsg( const int,
     return true;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+CSVPrinter::handleMsg( const int,
+                       const int,
+                       const std::string_view )
+{
+    // no copy is needed for the unused messages.
+    return true;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -299,17 +326,16 @@ CSVPrinter::handleTeam( const int,
 
 /*-------------------------------------------------------------------*/
 bool
-CSVPrinter::handleServerParam( const rcsc::rcg::ServerParamT & param )
+CSVPrinter::handleServerParam( const rcsc::rcg::ServerParamT & )
 {
-    rcsc::ServerParam::instance().convertFrom( param );
+    // the global ServerParam is not updated, because the files may be processed concurrently.
     return true;
 }
 
 /*-------------------------------------------------------------------*/
 bool
-CSVPrinter::handlePlayerParam( const rcsc::rcg::PlayerParamT & param )
+CSVPrinter::handlePlayerParam( const rcsc::rcg::PlayerParamT & )
 {
-    rcsc::PlayerParam::instance().convertFrom( param );
     return true;
 }
 
@@ -317,12 +343,16 @@ CSVPrinter::handlePlayerParam( const rcsc::rcg::PlayerParamT & param )
 bool
 CSVPrinter::handlePlayerType( const rcsc::rcg::PlayerTypeT & ptype )
 {
-    static bool s_header = false;
-    if ( ! s_header )
+    if ( ! M_player_types_header )
     {
-        M_player_types_out << "id,player_speed_max,stamina_inc_max,player_decay,inertia_moment,dash_power_rate,player_size,kickable_margin,kick_rand,extra_stamina,effort_max,effort_min,kick_power_rate,foul_detect_probability,catchable_area_l_stretch"
-                       << '\n';
-        s_header = true;
+        const char * delim = "";
+        for ( const tracking::Column & c : tracking::player_type_columns() )
+        {
+            M_player_types_out << delim << c.name_;
+            delim = ",";
+        }
+        M_player_types_out << '\n';
+        M_player_types_header = true;
     }
 
     M_player_types_out << ptype.id_
@@ -399,30 +429,11 @@ CSVPrinter::printPlayerTypes() const
 std::ostream &
 CSVPrinter::printShowHeader() const
 {
-    M_tracking_out << "#"
-                   << ",cycle,stopped"
-                   << ",playmode"
-                   << ",l_name,l_score,l_pen_score"
-                   << ",r_name,r_score,r_pen_score"
-                   << ",b_x,b_y,b_vx,b_vy";
-
-    char side = 'l';
-    for ( int s = 0; s < 2; ++s )
+    const char * delim = "";
+    for ( const tracking::Column & c : tracking::tracking_columns() )
     {
-        for ( int i = 1; i <= rcsc::MAX_PLAYER; ++i )
-        {
-            M_tracking_out << "," << side << i << "_t"
-                           << "," << side << i << "_x"
-                           << "," << side << i << "_y"
-                           << "," << side << i << "_vx"
-                           << "," << side << i << "_vy"
-                           << "," << side << i << "_body"
-                           << "," << side << i << "_neck"
-                           << "," << side << i << "_vwidth"
-                           << "," << side << i << "_stamina"
-                ;
-        }
-        side = 'r';
+        M_tracking_out << delim << c.name_;
+        delim = ",";
     }
 
     M_tracking_out << '\n';
@@ -586,16 +597,63 @@ get_base_name( const std::string & path )
 
 ////////////////////////////////////////////////////////////////////////
 
+/*!
+  \brief convert one rcg file into the csv files
+  \param infile input rcg file path
+  \param os output stream for the file name messages
+  \return result status
+ */
+bool
+convert( const std::string & infile,
+         std::ostream & os )
+{
+    if ( ! rcsc::compressed_ifstream( infile.c_str() ).is_open() )
+    {
+        std::cerr << "Failed to open file : " << infile << std::endl;
+        return false;
+    }
+
+    const std::string basename = get_base_name( infile );
+    const std::string tracking_csv = basename + ".tracking.csv";
+    const std::string player_types_csv = basename + ".player_types.csv";
+
+    std::ofstream tracking_out( tracking_csv );
+    if ( ! tracking_out.is_open() )
+    {
+        std::cerr << "Failed to open the output file : " << tracking_csv << std::endl;
+        return false;
+    }
+
+    std::ofstream player_types_out( player_types_csv );
+    if ( ! player_types_out.is_open() )
+    {
+        std::cerr << "Failed to open the output file : " << player_types_csv << std::endl;
+        return false;
+    }
+
+    os << " in:           " << infile << '\n';
+    os << " tracking:     " << tracking_csv << '\n';
+    os << " player_types: " << player_types_csv << std::endl;
+
+    CSVPrinter printer( tracking_out, player_types_out );
+
+    return rcsc::rcg::BatchRunner::parse( infile, printer );
+}
+
+////////////////////////////////////////////////////////////////////////
+
 int
 main( int argc, char** argv )
 {
     bool help = false;
     bool print_player_types = false;
+    int jobs = 1;
 
     rcsc::ParamMap options( "Options" );
     options.add()
         ( "help", "", rcsc::BoolSwitch( &help ), "print help message." )
         ( "player-types", "p", rcsc::BoolSwitch( &print_player_types ), "print player_type information."  )
+        ( "jobs", "j", &jobs, "the number of files converted in parallel. 0 means the number of hardware threads." )
         ;
 
     rcsc::CmdLineParser cmd_parser( argc, argv );
@@ -606,53 +664,27 @@ main( int argc, char** argv )
          || cmd_parser.positionalOptions().empty() )
     {
         std::cerr << " usage:\n";
-        std::cerr << "  " << argv[0] << " [-p] <RCGFile>[.gz] ...\n";
+        std::cerr << "  " << argv[0] << " [-p] [-j <Value>] <RCGFile>[.gz] ...\n";
         options.printHelp( std::cerr );
         return 0;
     }
 
-    const std::string infile = cmd_parser.positionalOptions().front();
-    rcsc::gzifstream fin( infile.c_str() );
-
-    if ( ! fin.is_open() )
-    {
-        std::cerr << "Failed to open file : " << infile << std::endl;
-        return 1;
-    }
-
-    const std::string basename = get_base_name( infile );
-    const std::string tracking_csv = basename + ".tracking.csv";
-    const std::string player_types_csv = basename + ".player_types.csv";
-
-    std::ofstream tracking_out( tracking_csv );
-    if ( ! tracking_out.is_open() )
-    {
-        std::cerr << "Failed to open the output file : " << tracking_csv << std::endl;
-        return 1;
-    }
-
-    std::ofstream player_types_out( player_types_csv );
-    if ( ! player_types_out.is_open() )
-    {
-        std::cerr << "Failed to open the output file : " << player_types_csv << std::endl;
-        return 1;
-    }
-
-    std::cerr << " in:           " << infile << '\n';
-    std::cerr << " tracking:     " << tracking_csv << '\n';
-    std::cerr << " player_types: " << player_types_csv << std::endl;
+    const std::vector< std::string > files
+        = rcsc::rcg::BatchRunner::expand( cmd_parser.positionalOptions() );
 
-    rcsc::rcg::Parser::Ptr parser = rcsc::rcg::Parser::create( fin );
+    const rcsc::rcg::BatchRunner runner( jobs );
+    const std::vector< rcsc::rcg::BatchRunner::Result > results
+        = runner.run( files, convert, std::cerr );
 
-    if ( ! parser )
+    int result = 0;
+    for ( const rcsc::rcg::BatchRunner::Result & r : results )
     {
-        std::cerr << "Failed to create rcg parser." << std::endl;
-        return 1;
+        if ( ! r.success_ )
+        {
+            std::cerr << "Failed to convert : " << r.filepath_ << std::endl;
+            result = 1;
+        }
     }
 
-    CSVPrinter printer( tracking_out, player_types_out );
-
-    parser->parse( fin, printer );
-
-    return 0;
+    return result;
 }
@@ -10,10 +10,13 @@
 
 #include <cmath>
 #include <cstring>
+#include <cstdlib>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <vector>
+#include <memory>
 
 #include <rcsc/gz.h>
 #include <rcsc/rcg.h>
@@ -116,6 +119,9 @@ public:
     bool handleMsg( const int time,
                     const int board,
                     const std::string & msg ) override;
+    bool handleMsg( const int time,
+                    const int board,
+                    const std::string_view msg ) override;
     bool handleDraw( const int time,
                      const rcsc::rcg::drawinfo_t & draw ) override;
     bool handlePlayMode( const int time,
@@ -247,6 +253,19 @@ TextPrinter::handleMsg( const int,
     return true;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+TextPrinter::handleMsg( const int,
+                        const int,
+                        const std::string_view )
+{
+    // no copy is needed for the unused messages.
+    return true;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -592,34 +611,55 @@ TextPrinter::printPlayer( std::ostream & os,
 int
 main( int argc, char** argv )
 {
-    if ( argc != 2
-         || ! std::strncmp( argv[1], "--help", 6 )
-         || ! std::strncmp( argv[1], "-h", 2 ) )
+    int jobs = 1;
+    std::vector< std::string > patterns;
+
+    for ( int i = 1; i < argc; ++i )
     {
-        std::cerr << "usage: " << argv[0] << " <RcgFile>[.gz]" << std::endl;
-        return 0;
+        if ( ! std::strncmp( argv[i], "--help", 6 )
+             || ! std::strncmp( argv[i], "-h", 2 ) )
+        {
+            patterns.clear();
+            break;
+        }
+
+        if ( ! std::strcmp( argv[i], "--jobs" )
+             || ! std::strcmp( argv[i], "-j" ) )
+        {
+            if ( i + 1 < argc )
+            {
+                jobs = std::atoi( argv[++i] );
+            }
+            continue;
+        }
+
+        patterns.push_back( argv[i] );
     }
 
-    rcsc::gzifstream fin( argv[1] );
-
-    if ( ! fin.is_open() )
+    if ( patterns.empty() )
     {
-        std::cerr << "Failed to open file : " << argv[1] << std::endl;
-        return 1;
+        std::cerr << "usage: " << argv[0] << " [--jobs [-j] <Value>] <RcgFile>[.gz] ..." << std::endl;
+        return 0;
     }
 
-    rcsc::rcg::Parser::Ptr parser = rcsc::rcg::Parser::create( fin );
-
-    if ( ! parser )
+    // each file is printed to the standard output in the given order.
+    const rcsc::rcg::BatchRunner runner( jobs );
+    const std::vector< rcsc::rcg::BatchRunner::Result > results
+        = runner.parseAll( rcsc::rcg::BatchRunner::expand( patterns ),
+                           []( const std::string &,
+                               std::ostream & os ) -> std::shared_ptr< rcsc::rcg::Handler >
+                             {
+                                 return std::make_shared< TextPrinter >( os );
+                             },
+                           std::cout );
+
+    for ( const rcsc::rcg::BatchRunner::Result & r : results )
     {
-        std::cerr << "Failed to create rcg parser." << std::endl;
-        return 1;
+        if ( ! r.success_ )
+        {
+            std::cerr << "Failed to parse [" << r.filepath_ << "]" << std::endl;
+        }
     }
 
-    // create rcg handler instance
-    TextPrinter printer( std::cout );
-
-    parser->parse( fin, printer );
-
     return 0;
 }
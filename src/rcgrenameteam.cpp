@@ -36,9 +36,12 @@
 #include <rcsc/gz.h>
 #include <rcsc/rcg.h>
 
+#include <algorithm>
 #include <memory>
+#include <thread>
 #include <cmath>
 #include <cstring>
+#include <cstdlib>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -301,6 +304,259 @@ TeamNameRenamer::handleTeamGraphic( const char side,
 
 ///////////////////////////////////////////////////////////
 
+namespace {
+
+/*-------------------------------------------------------------------*/
+const char *
+skip_space( const char * p,
+            const char * end )
+{
+    while ( p < end && *p == ' ' ) ++p;
+    return p;
+}
+
+/*-------------------------------------------------------------------*/
+const char *
+skip_token( const char * p,
+            const char * end )
+{
+    while ( p < end && *p != ' ' && *p != ')' ) ++p;
+    return p;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief replace two team name tokens in the text record.
+  \param record text record
+  \param p pointer to the left team name token in the record
+  \param left new left team name. if empty, the old name is kept.
+  \param right new right team name. if empty, the old name is kept.
+  \param result result variable
+  \return true if the record is rewritten
+*/
+bool
+replace_text_names( const std::string_view record,
+                    const char * p,
+                    const std::string & left,
+                    const std::string & right,
+                    std::string * result )
+{
+    const char * const end = record.data() + record.size();
+
+    const char * const l_begin = skip_space( p, end );
+    const char * const l_end = skip_token( l_begin, end );
+    const char * const r_begin = skip_space( l_end, end );
+    const char * const r_end = skip_token( r_begin, end );
+
+    if ( l_begin == l_end
+         || r_begin == r_end )
+    {
+        return false;
+    }
+
+    result->assign( record.data(), l_begin );
+    if ( left.empty() ) result->append( l_begin, l_end );
+    else result->append( left );
+    result->append( l_end, r_begin );
+    if ( right.empty() ) result->append( r_begin, r_end );
+    else result->append( right );
+    result->append( r_end, end );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief (team <Time> <NameL> <NameR> <ScoreL> <ScoreR> ...)
+*/
+bool
+edit_text_team( const std::string_view record,
+                const std::string & left,
+                const std::string & right,
+                std::string * result )
+{
+    const char * const end = record.data() + record.size();
+    const char * p = record.data() + 5; // "(team"
+    p = skip_token( skip_space( p, end ), end ); // time
+
+    return replace_text_names( record, p, left, right, result );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief (show <Time> [(pm <Mode>)] [(tm <NameL> <NameR> ...)] ...)
+*/
+bool
+edit_text_show( const std::string_view record,
+                const std::string & left,
+                const std::string & right,
+                std::string * result )
+{
+    const char * const end = record.data() + record.size();
+    const char * p = record.data() + 5; // "(show"
+    p = skip_token( skip_space( p, end ), end ); // time
+    p = skip_space( p, end );
+
+    if ( end - p >= 3
+         && std::strncmp( p, "(pm", 3 ) == 0 )
+    {
+        p = static_cast< const char * >( std::memchr( p, ')', end - p ) );
+        if ( ! p ) return false;
+        p = skip_space( p + 1, end );
+    }
+
+    if ( end - p < 3
+         || std::strncmp( p, "(tm", 3 ) != 0 )
+    {
+        return false;
+    }
+
+    return replace_text_names( record, p + 3, left, right, result );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief find the value of "name" in the object of the side key.
+  \param record JSON record
+  \param from search start position
+  \param key side key, "\"l\":" or "\"r\":"
+  \param value_end result variable. the next of the last character of the value.
+  \return the first position of the value, or npos if not found.
+*/
+std::size_t
+find_json_name( const std::string_view record,
+                const std::size_t from,
+                const char * key,
+                std::size_t * value_end )
+{
+    const std::size_t k = record.find( key, from );
+    if ( k == std::string_view::npos ) return std::string_view::npos;
+
+    const std::size_t n = record.find( "\"name\":", k );
+    if ( n == std::string_view::npos ) return std::string_view::npos;
+
+    std::size_t v = n + 7;
+    while ( v < record.size() && record[v] == ' ' ) ++v;
+
+    if ( record.compare( v, 4, "null" ) == 0 )
+    {
+        *value_end = v + 4;
+        return v;
+    }
+
+    if ( v >= record.size()
+         || record[v] != '"' )
+    {
+        return std::string_view::npos;
+    }
+
+    for ( std::size_t i = v + 1; i < record.size(); ++i )
+    {
+        if ( record[i] == '\\' )
+        {
+            ++i;
+        }
+        else if ( record[i] == '"' )
+        {
+            *value_end = i + 1;
+            return v;
+        }
+    }
+
+    return std::string_view::npos;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief replace the team names in the JSON record.
+  \param record JSON record
+  \param from position of the team object
+  \param left new left team name as a JSON string. if empty, the old name is kept.
+  \param right new right team name as a JSON string. if empty, the old name is kept.
+  \param result result variable
+  \return true if the record is rewritten
+*/
+bool
+replace_json_names( const std::string_view record,
+                    const std::size_t from,
+                    const std::string & left,
+                    const std::string & right,
+                    std::string * result )
+{
+    std::size_t l_end = 0, r_end = 0;
+    const std::size_t l_begin = find_json_name( record, from, "\"l\":", &l_end );
+    if ( l_begin == std::string_view::npos ) return false;
+    const std::size_t r_begin = find_json_name( record, l_end, "\"r\":", &r_end );
+    if ( r_begin == std::string_view::npos ) return false;
+
+    result->assign( record.data(), l_begin );
+    if ( left.empty() ) result->append( record.substr( l_begin, l_end - l_begin ) );
+    else result->append( left );
+    result->append( record.substr( l_end, r_begin - l_end ) );
+    if ( right.empty() ) result->append( record.substr( r_begin, r_end - r_begin ) );
+    else result->append( right );
+    result->append( record.substr( r_end ) );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create the JSON string literal
+*/
+std::string
+json_string( const std::string & str )
+{
+    if ( str.empty() )
+    {
+        return std::string();
+    }
+
+    std::ostringstream os;
+    os << std::quoted( str );
+    return os.str();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief rewrite only the team records and copy all other bytes.
+*/
+bool
+rename_records( std::istream & is,
+                std::ostream & os,
+                const std::string & left,
+                const std::string & right )
+{
+    using rcsc::rcg::RecordPatcher;
+
+    const std::string json_left = json_string( left );
+    const std::string json_right = json_string( right );
+
+    RecordPatcher patcher;
+
+    patcher.setEditor( "team",
+                       [&]( const std::string_view record, std::string * result )
+                         {
+                             return ( record.front() == '('
+                                      ? edit_text_team( record, left, right, result )
+                                      : replace_json_names( record, 0, json_left, json_right, result ) );
+                         } );
+    patcher.setEditor( "show",
+                       [&]( const std::string_view record, std::string * result )
+                         {
+                             if ( record.front() == '(' )
+                             {
+                                 return edit_text_show( record, left, right, result );
+                             }
+
+                             const std::size_t team = record.find( "\"team\":" );
+                             return ( team != std::string_view::npos
+                                      && replace_json_names( record, team, json_left, json_right, result ) );
+                         } );
+
+    return patcher.run( is, os );
+}
+
+}
+
 /*---------------------------------------------------------------*/
 /*
   Usage:
@@ -319,6 +575,8 @@ usage( const char * prog )
               << "        specify the right team name.\n"
               << "    --output [ -o ]<Value>\n"
               << "        specify the output file name.\n"
+              << "    --threads [ -j ] <Value> : (DefaultValue=the number of cores)\n"
+              << "        specify the number of gzip compression threads.\n"
               << std::endl;
 }
 
@@ -330,6 +588,7 @@ main( int argc, char** argv )
 {
     std::string input_file;
     std::string output_file;
+    int threads = std::max( 1, static_cast< int >( std::thread::hardware_concurrency() ) );
     std::string left_team_name;
     std::string right_team_name;
 
@@ -373,6 +632,17 @@ main( int argc, char** argv )
             }
             output_file = argv[i];
         }
+        else if ( ! std::strcmp( argv[i], "--threads" )
+                  || ! std::strcmp( argv[i], "-j" ) )
+        {
+            ++i;
+            if ( i >= argc )
+            {
+                usage( argv[0] );
+                return 1;
+            }
+            threads = std::max( 1, std::atoi( argv[i] ) );
+        }
         else
         {
             input_file = argv[i];
@@ -413,7 +683,7 @@ main( int argc, char** argv )
         return 1;
     }
 
-    rcsc::gzifstream fin( input_file.c_str() );
+    rcsc::compressed_ifstream fin( input_file.c_str() );
 
     if ( ! fin.is_open() )
     {
@@ -425,7 +695,14 @@ main( int argc, char** argv )
 
     if ( output_file.compare( output_file.length() - 3, 3, ".gz" ) == 0 )
     {
-        fout = std::shared_ptr< std::ostream >( new rcsc::gzofstream( output_file.c_str() ) );
+        fout = std::shared_ptr< std::ostream >( new rcsc::gzofstream( output_file.c_str(),
+                                                                     rcsc::gzfilebuf::DEFAULT_COMPRESSION,
+                                                                     rcsc::gzfilebuf::DEFAULT_STRATEGY,
+                                                                     threads ) );
+    }
+    else if ( rcsc::compression_format_from_path( output_file.c_str() ) != rcsc::COMPRESSION_NONE )
+    {
+        fout = std::shared_ptr< std::ostream >( new rcsc::compressed_ofstream( output_file.c_str() ) );
     }
     else
     {
@@ -441,6 +718,32 @@ main( int argc, char** argv )
         return 1;
     }
 
+    //
+    // the text and JSON data are copied record by record.
+    // only the records that contain the team names are rewritten.
+    //
+
+    char header[4];
+    fin.read( header, 4 );
+    const rcsc::rcg::RecordPatcher::Format format
+        = rcsc::rcg::RecordPatcher::detect_format( header, static_cast< std::size_t >( fin.gcount() ) );
+    fin.clear();
+    fin.seekg( 0 );
+
+    if ( format != rcsc::rcg::RecordPatcher::UNKNOWN )
+    {
+        if ( ! rename_records( fin, *fout, left_team_name, right_team_name ) )
+        {
+            std::cerr << "Failed to rename the team names." << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    //
+    // the binary data are decoded and serialized again.
+    //
+
     rcsc::rcg::Parser::Ptr parser = rcsc::rcg::Parser::create( fin );
 
     if ( ! parser )
@@ -6,14 +6,98 @@
 
 #include <rcsc/gz.h>
 #include <rcsc/rcg.h>
+#include <rcsc/rcg/parser_v4.h>
+#include <rcsc/rcg/parser_simdjson.h>
 
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <vector>
 #include <algorithm>
+#include <thread>
 #include <cmath>
 #include <cstring>
+#include <cstdlib>
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+rcsc::rcg::BallT
+reverse_ball( const rcsc::rcg::BallT & ball )
+{
+    rcsc::rcg::BallT new_ball;
+
+    new_ball.x_ = - ball.x_;
+    new_ball.y_ = - ball.y_;
+    new_ball.vx_ = - ball.vx_;
+    new_ball.vy_ = - ball.vy_;
+
+    return new_ball;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+rcsc::rcg::PlayerT
+reverse_player( const rcsc::rcg::PlayerT & player )
+{
+    rcsc::rcg::PlayerT new_player = player;
+
+    new_player.side_ = ( player.side_ == 'l' ? 'r' : 'l' );
+
+    if ( player.state_ != rcsc::rcg::DISABLE )
+    {
+        new_player.x_ = - player.x_;
+        new_player.y_ = - player.y_;
+        new_player.vx_ = - player.vx_;
+        new_player.vy_ = - player.vy_;
+        new_player.body_ += 180.0;
+        if ( new_player.body_ > 180.0 ) new_player.body_ -= 360.0;
+        if ( player.hasArm() )
+        {
+            new_player.point_x_ = - player.point_x_;
+            new_player.point_y_ = - player.point_y_;
+        }
+    }
+    else
+    {
+        new_player.x_ = - player.x_;
+    }
+
+    return new_player;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+rcsc::rcg::ShowInfoT
+reverse_show( const rcsc::rcg::ShowInfoT & show )
+{
+    rcsc::rcg::ShowInfoT new_show;
+
+    new_show.ball_ = reverse_ball( show.ball_ );
+
+    for ( int i = 0; i < rcsc::MAX_PLAYER*2; ++i )
+    {
+        int idx = show.player_[i].unum_ - 1;
+        if ( show.player_[i].side_ == 'l' ) idx += rcsc::MAX_PLAYER;
+        if ( idx < 0 || rcsc::MAX_PLAYER*2 <= idx ) continue;
+
+        new_show.player_[idx] = reverse_player( show.player_[i] );
+    }
+
+    new_show.time_ = show.time_;
+
+    return new_show;
+}
+
+}
 
 class Reverser
     : public rcsc::rcg::Handler {
@@ -56,10 +140,6 @@ public:
                             const int x,
                             const int y,
                             const std::vector< std::string > & xpm ) override;
-private:
-
-    rcsc::rcg::BallT reverse( const rcsc::rcg::BallT & ball );
-    rcsc::rcg::PlayerT reverse( const rcsc::rcg::PlayerT & player );
 };
 
 
@@ -120,22 +200,7 @@ Reverser::handleShow( const rcsc::rcg::ShowInfoT & show )
         return false;
     }
 
-    rcsc::rcg::ShowInfoT new_show;
-
-    new_show.ball_ = reverse( show.ball_ );
-
-    for ( int i = 0; i < rcsc::MAX_PLAYER*2; ++i )
-    {
-        int idx = show.player_[i].unum_ - 1;
-        if ( show.player_[i].side_ == 'l' ) idx += rcsc::MAX_PLAYER;
-        if ( idx < 0 || rcsc::MAX_PLAYER*2 <= idx ) continue;
-
-        new_show.player_[idx] = reverse( show.player_[i] );
-    }
-
-    new_show.time_ = show.time_;
-
-    M_serializer->serialize( M_os, new_show );
+    M_serializer->serialize( M_os, reverse_show( show ) );
     return true;
 }
 
@@ -248,54 +313,348 @@ Reverser::handleTeamGraphic( const char side,
     return true;
 }
 
-/*-------------------------------------------------------------------*/
+///////////////////////////////////////////////////////////
+
+namespace {
+
+/*!
+  \class RecordCapture
+  \brief keep the data decoded from one record.
+*/
+class RecordCapture
+    : public rcsc::rcg::Handler {
+public:
+
+    rcsc::rcg::ShowInfoT show_;
+    bool has_show_;
+
+    rcsc::PlayMode playmode_;
+    bool has_playmode_;
+
+    rcsc::rcg::TeamT team_l_;
+    rcsc::rcg::TeamT team_r_;
+    bool has_team_;
+
+    RecordCapture()
+        : has_show_( false ),
+          playmode_( rcsc::PM_Null ),
+          has_playmode_( false ),
+          has_team_( false )
+      { }
+
+    void clear()
+      {
+          has_show_ = false;
+          has_playmode_ = false;
+          has_team_ = false;
+      }
+
+    bool handleEOF() override { return true; }
+    bool handleShow( const rcsc::rcg::ShowInfoT & show ) override
+      {
+          show_ = show;
+          has_show_ = true;
+          return true;
+      }
+    bool handleMsg( const int, const int, const std::string & ) override { return true; }
+    bool handleDraw( const int, const rcsc::rcg::drawinfo_t & ) override { return true; }
+    bool handlePlayMode( const int,
+                         const rcsc::PlayMode pm ) override
+      {
+          playmode_ = pm;
+          has_playmode_ = true;
+          return true;
+      }
+    bool handleTeam( const int,
+                     const rcsc::rcg::TeamT & team_l,
+                     const rcsc::rcg::TeamT & team_r ) override
+      {
+          team_l_ = team_l;
+          team_r_ = team_r;
+          has_team_ = true;
+          return true;
+      }
+    bool handleServerParam( const rcsc::rcg::ServerParamT & ) override { return true; }
+    bool handlePlayerParam( const rcsc::rcg::PlayerParamT & ) override { return true; }
+    bool handlePlayerType( const rcsc::rcg::PlayerTypeT & ) override { return true; }
+    bool handleTeamGraphic( const char, const int, const int, const std::vector< std::string > & ) override { return true; }
+};
+
 /*!
+  \struct ShowReverser
+  \brief per thread objects to decode, reverse and serialize the show records.
+*/
+struct ShowReverser {
+    const int version_;
+    rcsc::rcg::ParserV4 text_parser_;
+    rcsc::rcg::ParserSimdJSON json_parser_;
+    rcsc::rcg::Serializer::Ptr serializer_;
+    RecordCapture capture_;
+    std::ostringstream show_os_;
+    std::ostringstream os_;
+    std::string input_;
+
+    explicit
+    ShowReverser( const int version )
+        : version_( version ),
+          serializer_( rcsc::rcg::Serializer::create( version ) )
+      { }
+
+    /*!
+      \brief take the serialized text without the record separators.
+    */
+    static
+    std::string_view trim( const std::string & str )
+      {
+          std::string_view v( str );
+          while ( ! v.empty() && ( v.front() == ',' || v.front() == '\n' ) ) v.remove_prefix( 1 );
+          while ( ! v.empty() && v.back() == '\n' ) v.remove_suffix( 1 );
+          return v;
+      }
 
+    bool edit( const std::string_view record,
+               std::string * result )
+      {
+          if ( ! serializer_ )
+          {
+              return false;
+          }
+
+          capture_.clear();
+          if ( version_ == rcsc::rcg::REC_VERSION_JSON )
+          {
+              input_.assign( record.data(), record.size() );
+              json_parser_.parseData( input_, capture_ );
+          }
+          else
+          {
+              text_parser_.parseLine( 0, record, capture_ );
+          }
+
+          if ( ! capture_.has_show_ )
+          {
+              return false;
+          }
+
+          // the show is serialized first to set the time of the serializer.
+          show_os_.str( std::string() );
+          serializer_->serialize( show_os_, reverse_show( capture_.show_ ) );
+
+          // the playmode and team embedded in the show are written as separate records.
+          os_.str( std::string() );
+          if ( capture_.has_playmode_ )
+          {
+              serializer_->serialize( os_, static_cast< char >( capture_.playmode_ ) );
+          }
+          if ( capture_.has_team_ )
+          {
+              serializer_->serialize( os_, capture_.team_r_, capture_.team_l_ );
+          }
+
+          const std::string extra = os_.str();
+          const std::string show = show_os_.str();
+
+          result->clear();
+          if ( ! extra.empty() )
+          {
+              result->append( trim( extra ) );
+              result->append( version_ == rcsc::rcg::REC_VERSION_JSON ? ",\n" : "\n" );
+          }
+          result->append( trim( show ) );
+          return true;
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief (team <Time> <NameL> <NameR> <ScoreL> <ScoreR> [<PenScoreL> <PenMissL> <PenScoreR> <PenMissR>])
 */
-rcsc::rcg::BallT
-Reverser::reverse( const rcsc::rcg::BallT & ball )
+bool
+reverse_text_team( const std::string_view record,
+                   std::string * result )
 {
-    rcsc::rcg::BallT new_ball;
+    const char * p = record.data() + 5; // "(team"
+    const char * const end = record.data() + record.size();
 
-    new_ball.x_ = - ball.x_;
-    new_ball.y_ = - ball.y_;
-    new_ball.vx_ = - ball.vx_;
-    new_ball.vy_ = - ball.vy_;
+    std::vector< std::string_view > tokens;
+    while ( p < end )
+    {
+        while ( p < end && *p == ' ' ) ++p;
+        if ( p == end || *p == ')' ) break;
+        const char * begin = p;
+        while ( p < end && *p != ' ' && *p != ')' ) ++p;
+        tokens.emplace_back( begin, p - begin );
+    }
 
-    return new_ball;
+    if ( tokens.size() != 5
+         && tokens.size() != 9 )
+    {
+        return false;
+    }
+
+    std::swap( tokens[1], tokens[2] );
+    std::swap( tokens[3], tokens[4] );
+    if ( tokens.size() == 9 )
+    {
+        std::swap( tokens[5], tokens[7] );
+        std::swap( tokens[6], tokens[8] );
+    }
+
+    result->assign( "(team" );
+    for ( const std::string_view & t : tokens )
+    {
+        result->push_back( ' ' );
+        result->append( t );
+    }
+    result->append( p, end );
+    return true;
 }
 
 /*-------------------------------------------------------------------*/
 /*!
-
+  \brief find the object value of the key in the JSON record.
+  \return the first position of the value, or npos.
 */
-rcsc::rcg::PlayerT
-Reverser::reverse( const rcsc::rcg::PlayerT & player )
+std::size_t
+find_json_object( const std::string_view record,
+                  const char * key,
+                  std::size_t * value_end )
 {
-    rcsc::rcg::PlayerT new_player = player;
+    const std::size_t k = record.find( key );
+    if ( k == std::string_view::npos ) return std::string_view::npos;
 
-    new_player.side_ = ( player.side_ == 'l' ? 'r' : 'l' );
+    const std::size_t begin = record.find( '{', k );
+    if ( begin == std::string_view::npos ) return std::string_view::npos;
 
-    if ( player.state_ != rcsc::rcg::DISABLE )
+    int depth = 0;
+    bool in_string = false;
+    for ( std::size_t i = begin; i < record.size(); ++i )
     {
-        new_player.x_ = - player.x_;
-        new_player.y_ = - player.y_;
-        new_player.vx_ = - player.vx_;
-        new_player.vy_ = - player.vy_;
-        new_player.body_ += 180.0;
-        if ( new_player.body_ > 180.0 ) new_player.body_ -= 360.0;
-        if ( player.hasArm() )
+        const char c = record[i];
+        if ( in_string )
         {
-            new_player.point_x_ = - player.point_x_;
-            new_player.point_y_ = - player.point_y_;
+            if ( c == '\\' ) ++i;
+            else if ( c == '"' ) in_string = false;
         }
+        else if ( c == '"' ) in_string = true;
+        else if ( c == '{' ) ++depth;
+        else if ( c == '}' && --depth == 0 )
+        {
+            *value_end = i + 1;
+            return begin;
+        }
+    }
+
+    return std::string_view::npos;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief {"team":{"time":<Time>,"l":{...},"r":{...}}}
+*/
+bool
+reverse_json_team( const std::string_view record,
+                   std::string * result )
+{
+    std::size_t l_end = 0, r_end = 0;
+    const std::size_t l_begin = find_json_object( record, "\"l\":", &l_end );
+    const std::size_t r_begin = find_json_object( record, "\"r\":", &r_end );
+    if ( l_begin == std::string_view::npos
+         || r_begin == std::string_view::npos
+         || r_begin < l_end )
+    {
+        return false;
+    }
+
+    result->assign( record.data(), l_begin );
+    result->append( record.substr( r_begin, r_end - r_begin ) );
+    result->append( record.substr( l_end, r_begin - l_end ) );
+    result->append( record.substr( l_begin, l_end - l_begin ) );
+    result->append( record.substr( r_end ) );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief swap the side character at the position.
+*/
+bool
+swap_side( const std::string_view record,
+           const std::size_t pos,
+           std::string * result )
+{
+    if ( pos >= record.size()
+         || ( record[pos] != 'l' && record[pos] != 'r' ) )
+    {
+        return false;
+    }
+
+    result->assign( record.data(), record.size() );
+    (*result)[pos] = ( record[pos] == 'l' ? 'r' : 'l' );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief reverse the text or JSON data record by record.
+  \param is input stream
+  \param os output stream
+  \param version rcg version of the input data
+  \param jobs the number of threads
+  \return result status
+*/
+bool
+reverse_records( std::istream & is,
+                 std::ostream & os,
+                 const int version,
+                 const int jobs )
+{
+    using rcsc::rcg::RecordPatcher;
+
+    const bool json = ( version == rcsc::rcg::REC_VERSION_JSON );
+
+    RecordPatcher patcher;
+    patcher.setJobs( jobs );
+
+    patcher.setEditor( "show",
+                       [version]( const std::string_view record, std::string * result )
+                         {
+                             thread_local ShowReverser s_reverser( version );
+                             return s_reverser.edit( record, result );
+                         } );
+    patcher.setEditor( "team",
+                       [json]( const std::string_view record, std::string * result )
+                         {
+                             return ( json
+                                      ? reverse_json_team( record, result )
+                                      : reverse_text_team( record, result ) );
+                         } );
+
+    if ( json )
+    {
+        patcher.setEditor( "team_graphic",
+                           []( const std::string_view record, std::string * result )
+                             {
+                                 const std::size_t side = record.find( "\"side\":\"" );
+                                 return ( side != std::string_view::npos
+                                          && swap_side( record, side + 8, result ) );
+                             } );
     }
     else
     {
-        new_player.x_ = - player.x_;
+        // (team_graphic_<Side> ...
+        const RecordPatcher::Editor team_graphic
+            = []( const std::string_view record, std::string * result )
+              {
+                  return swap_side( record, 14, result );
+              };
+        patcher.setEditor( "team_graphic_l", team_graphic );
+        patcher.setEditor( "team_graphic_r", team_graphic );
     }
 
-    return new_player;
+    return patcher.run( is, os );
+}
+
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -303,34 +662,50 @@ Reverser::reverse( const rcsc::rcg::PlayerT & player )
 int
 main( int argc, char** argv )
 {
-    if ( argc < 2
-         || ! strcmp( argv[1], "--help" )
-         || ! strcmp( argv[1], "-h" ) )
+    int jobs = static_cast< int >( std::thread::hardware_concurrency() );
+    std::vector< std::string > args;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        if ( ( ! strcmp( argv[i], "--jobs" ) || ! strcmp( argv[i], "-j" ) )
+             && i + 1 < argc )
+        {
+            jobs = std::atoi( argv[++i] );
+        }
+        else
+        {
+            args.push_back( argv[i] );
+        }
+    }
+
+    if ( args.empty()
+         || args[0] == "--help"
+         || args[0] == "-h" )
     {
         std::cerr << "usage: " << argv[0]
-                  << " <RcgFile>[.gz]"
+                  << " [--jobs N] <RcgFile>[.gz]"
                   << " [outputFile]"
                   << std::endl;
         return 0;
     }
 
-    rcsc::gzifstream fin( argv[1] );
+    rcsc::compressed_ifstream fin( args[0].c_str() );
 
     if ( ! fin.is_open() )
     {
-        std::cerr << "Failed to open the input file : " << argv[1] << std::endl;
+        std::cerr << "Failed to open the input file : " << args[0] << std::endl;
         return 1;
     }
 
     std::string out_filepath;
-    if ( argc >= 3 )
+    if ( args.size() >= 2 )
     {
-        out_filepath = argv[2];
+        out_filepath = args[1];
     }
     else
     {
         out_filepath = "reverse-";
-        out_filepath += argv[1];
+        out_filepath += args[0];
     }
 
     if ( out_filepath.length() > 3
@@ -346,6 +721,36 @@ main( int argc, char** argv )
         return 1;
     }
 
+    std::cout << "input file = " << args[0] << std::endl;
+    std::cout << "output file = " << out_filepath << std::endl;
+
+    //
+    // the text and JSON data are reversed record by record in parallel.
+    // the memory usage is bounded by the block size of the patcher.
+    //
+
+    char header[4];
+    fin.read( header, 4 );
+    const std::size_t header_size = static_cast< std::size_t >( fin.gcount() );
+    const rcsc::rcg::RecordPatcher::Format format
+        = rcsc::rcg::RecordPatcher::detect_format( header, header_size );
+    fin.clear();
+    fin.seekg( 0 );
+
+    if ( format == rcsc::rcg::RecordPatcher::JSON )
+    {
+        return reverse_records( fin, fout, rcsc::rcg::REC_VERSION_JSON, jobs ) ? 0 : 1;
+    }
+
+    if ( format == rcsc::rcg::RecordPatcher::TEXT )
+    {
+        return reverse_records( fin, fout, header[3] - '0', jobs ) ? 0 : 1;
+    }
+
+    //
+    // the binary data are decoded and serialized again.
+    //
+
     rcsc::rcg::Parser::Ptr parser = rcsc::rcg::Parser::create( fin );
 
     if ( ! parser )
@@ -354,9 +759,6 @@ main( int argc, char** argv )
         return 1;
     }
 
-    std::cout << "input file = " << argv[1] << std::endl;
-    std::cout << "output file = " << out_filepath << std::endl;
-
     // create rcg handler instance
     Reverser reverser( fout );
 
@@ -1,8 +1,8 @@
 // -*-c++-*-
 
 /*!
-  \file rcgverconv.cpp
-  \brief rcg version converter source File.
+  \file rcgvalidator.cpp
+  \brief rcg validator source File.
 */
 
 /*
@@ -41,6 +41,17 @@
 #include <rcsc/gz.h>
 #include <rcsc/rcg.h>
 
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+
 using namespace rcsc;
 using namespace rcsc::rcg;
 
@@ -52,12 +63,20 @@ class Validator
     : public Handler {
 private:
 
+    std::ostream & M_os; //!< output stream for the validation messages
+    std::string M_prefix; //!< prefix of the messages
+
+    //! copied from the log, because the global ServerParam is shared by the concurrent validators.
+    int M_actual_half_time;
+    int M_nr_normal_halfs;
+
     PlayMode M_last_playmode;
     int M_last_game_time;
     int M_player_missing_count;
 
 public:
-    Validator();
+    Validator( std::ostream & os,
+               const std::string & prefix );
 
     bool handleLogVersion( const int ver ) override;
     bool handleEOF() override;
@@ -70,6 +89,13 @@ public:
     {
         return true;
     }
+    bool handleMsg( const int /*time*/,
+                    const int /*board*/,
+                    const std::string_view /*msg*/ ) override
+    {
+        // no copy is needed for the unused messages.
+        return true;
+    }
     bool handleDraw( const int /*time*/,
                      const drawinfo_t & /*draw*/ ) override
     {
@@ -108,12 +134,19 @@ public:
 
 
 /*-------------------------------------------------------------------*/
-Validator::Validator()
+Validator::Validator( std::ostream & os,
+                      const std::string & prefix )
     : rcg::Handler(),
+      M_os( os ),
+      M_prefix( prefix ),
+      M_actual_half_time( ServerParam::i().actualHalfTime() ),
+      M_nr_normal_halfs( ServerParam::i().nrNormalHalfs() ),
+      M_last_playmode( PM_Null ),
       M_last_game_time( 0 ),
       M_player_missing_count( 0 )
 {
-
+    // only the player states are checked.
+    setProjection( Projection().setFields( Projection::PLAYER_POSITION ).setTeamGraphic( false ) );
 }
 
 /*-------------------------------------------------------------------*/
@@ -124,7 +157,7 @@ Validator::handleLogVersion( const int ver )
 
     if ( ver < 4 )
     {
-        std::cerr << "Unsupported RCG version " << ver << std::endl;
+        M_os << M_prefix << "Unsupported RCG version " << ver << std::endl;
         return false;
     }
 
@@ -136,22 +169,22 @@ bool
 Validator::handleEOF()
 {
     const int assumed_game_count
-        = ServerParam::i().actualHalfTime()
-        * ServerParam::i().nrNormalHalfs();
+        = M_actual_half_time
+        * M_nr_normal_halfs;
 
     if ( M_last_game_time < assumed_game_count - 1 )
     {
-        std::cerr << "(rcgvalidator) [false] "
-                  << "last game time: " << M_last_game_time
-                  << " << assumed count: " << assumed_game_count
-                  << std::endl;
+        M_os << M_prefix << "(rcgvalidator) [false] "
+             << "last game time: " << M_last_game_time
+             << " << assumed count: " << assumed_game_count
+             << std::endl;
         return false;
     }
 
     if ( M_player_missing_count >= 10 )
     {
-        std::cerr << "(rcgvalidator) [false] missing player count = "
-                  << M_player_missing_count << std::endl;
+        M_os << M_prefix << "(rcgvalidator) [false] missing player count = "
+             << M_player_missing_count << std::endl;
         return false;
     }
 
@@ -197,11 +230,256 @@ Validator::handlePlayMode( const int time,
 bool
 Validator::handleServerParam( const ServerParamT & param )
 {
-    ServerParam::instance().convertFrom( param );
+    // same as ServerParam::actualHalfTime()
+    M_actual_half_time = param.half_time_ * 10;
+    M_nr_normal_halfs = param.nr_normal_halfs_;
     return true;
 }
 
 
+/*-------------------------------------------------------------------*/
+/*-------------------------------------------------------------------*/
+/*-------------------------------------------------------------------*/
+
+namespace {
+
+/*!
+  \struct FramingResult
+  \brief result of the framing check
+*/
+struct FramingResult {
+    bool ok_; //!< true if no error is found
+    std::int64_t offset_; //!< decompressed byte offset of the first error. -1 if unknown.
+    std::string message_; //!< error message
+
+    FramingResult()
+        : ok_( true ),
+          offset_( -1 )
+      { }
+
+    bool setError( const std::int64_t offset,
+                   const std::string & message )
+      {
+          ok_ = false;
+          offset_ = offset;
+          message_ = message;
+          return false;
+      }
+};
+
+/*!
+  \class FramingChecker
+  \brief streaming check of the record framing.
+
+  The text logs (v4-v6) must consist of the header line and the lines
+  enclosed by parentheses. Other versions are only read to the end, so
+  that the compression layer verifies the checksum.
+*/
+class FramingChecker {
+private:
+    enum State {
+        HEADER,
+        TEXT,
+        OPAQUE,
+    };
+
+    State M_state;
+    std::int64_t M_offset; //!< decompressed bytes consumed so far
+    std::int64_t M_line_offset; //!< offset of the current line
+    std::string M_line; //!< the current line
+    FramingResult M_result;
+
+public:
+    FramingChecker()
+        : M_state( HEADER ),
+          M_offset( 0 ),
+          M_line_offset( 0 )
+      { }
+
+    const FramingResult & result() const
+      {
+          return M_result;
+      }
+
+    /*!
+      \brief consume the next decompressed data
+      \return false if an error is found
+     */
+    bool consume( const char * data,
+                  const std::size_t size )
+      {
+          const char * const end = data + size;
+          while ( data < end )
+          {
+              if ( M_state == OPAQUE )
+              {
+                  M_offset += end - data;
+                  return true;
+              }
+
+              const char * nl = static_cast< const char * >( std::memchr( data, '\n', end - data ) );
+              if ( ! nl )
+              {
+                  M_line.append( data, end );
+                  M_offset += end - data;
+                  return true;
+              }
+
+              M_line.append( data, nl );
+              M_offset += nl - data + 1;
+              data = nl + 1;
+
+              if ( ! checkLine() )
+              {
+                  return false;
+              }
+              M_line.clear();
+              M_line_offset = M_offset;
+          }
+          return true;
+      }
+
+    /*!
+      \brief check the last line
+      \return false if an error is found
+     */
+    bool finish()
+      {
+          if ( M_state == HEADER
+               && M_line.empty() )
+          {
+              return M_result.setError( 0, "empty file" );
+          }
+
+          return ( M_line.empty()
+                   || M_state == OPAQUE
+                   || checkLine() );
+      }
+
+    bool readError( const std::string & message )
+      {
+          return M_result.setError( M_offset, message );
+      }
+
+private:
+
+    bool checkLine()
+      {
+          if ( M_state == HEADER )
+          {
+              if ( M_line.compare( 0, 3, "ULG" ) == 0
+                   && M_line.length() == 4
+                   && '4' <= M_line[3] && M_line[3] <= '6' )
+              {
+                  M_state = TEXT;
+                  return true;
+              }
+
+              M_state = OPAQUE;
+              return true;
+          }
+
+          std::size_t len = M_line.length();
+          if ( len > 0 && M_line[len - 1] == '\r' ) --len;
+          if ( len == 0 )
+          {
+              return true;
+          }
+
+          if ( M_line[0] != '('
+               || M_line[len - 1] != ')' )
+          {
+              return M_result.setError( M_line_offset,
+                                        "broken record [" + M_line.substr( 0, 32 ) + "]" );
+          }
+
+          return true;
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief check the compression checksum and the record framing of the file
+  \param filepath rcg file path
+  \return check result
+ */
+FramingResult
+check_framing( const std::string & filepath )
+{
+    FramingChecker checker;
+    std::vector< char > buf( 64 * 1024 );
+
+    const CompressionFormat format = detect_compression_format( filepath.c_str() );
+
+#ifdef HAVE_LIBZ
+    if ( format == COMPRESSION_GZIP
+         || format == COMPRESSION_NONE )
+    {
+        // gzread() verifies the CRC at the end of each gzip member.
+        gzFile file = gzopen( filepath.c_str(), "rb" );
+        if ( ! file )
+        {
+            checker.readError( "failed to open" );
+            return checker.result();
+        }
+        gzbuffer( file, 256 * 1024 );
+
+        while ( true )
+        {
+            const int n = gzread( file, buf.data(), static_cast< unsigned int >( buf.size() ) );
+            if ( n < 0 )
+            {
+                int errnum = 0;
+                checker.readError( gzerror( file, &errnum ) );
+                break;
+            }
+            if ( n == 0 )
+            {
+                checker.finish();
+                break;
+            }
+            if ( ! checker.consume( buf.data(), static_cast< std::size_t >( n ) ) )
+            {
+                break;
+            }
+        }
+
+        gzclose( file );
+        return checker.result();
+    }
+#endif
+
+    compressed_ifstream fin( filepath.c_str() );
+    if ( ! fin.is_open() )
+    {
+        checker.readError( "failed to open" );
+        return checker.result();
+    }
+
+    while ( fin )
+    {
+        fin.read( buf.data(), buf.size() );
+        if ( fin.gcount() > 0
+             && ! checker.consume( buf.data(), static_cast< std::size_t >( fin.gcount() ) ) )
+        {
+            return checker.result();
+        }
+    }
+
+    if ( ! fin.eof() )
+    {
+        checker.readError( "read error" );
+    }
+    else
+    {
+        checker.finish();
+    }
+
+    return checker.result();
+}
+
+}
+
 /*-------------------------------------------------------------------*/
 /*-------------------------------------------------------------------*/
 /*-------------------------------------------------------------------*/
@@ -214,35 +492,126 @@ main( int argc, char** argv )
          || ! strcmp( argv[1], "-h" ) )
     {
         std::cerr << "usage: " << argv[0]
-                  << " <RcgFile>[.gz]"
-                  << " [outputFile]"
+                  << " [--jobs [-j] <Value>]"
+                  << " [--framing [-f]]"
+                  << " [--report [-r]]"
+                  << " <RcgFile>[.gz] ..."
+                  << "\n"
+                  << "  --framing  check only the compression checksum and the record framing.\n"
+                  << "  --report   print one tab separated line per file to the standard output:\n"
+                  << "             <File> OK | <File> ERROR <Offset> <Message>"
                   << std::endl;
         return 0;
     }
 
-    const std::string infile = argv[1];
+    int jobs = 1;
+    bool framing_only = false;
+    bool report = false;
+    std::vector< std::string > patterns;
 
-    rcsc::gzifstream fin( infile.c_str() );
-
-    if ( ! fin.is_open() )
+    for ( int i = 1; i < argc; ++i )
     {
-        std::cerr << "Could not open the input file : " << infile << std::endl;
-        return 1;
+        if ( ! std::strcmp( argv[i], "--jobs" )
+             || ! std::strcmp( argv[i], "-j" ) )
+        {
+            if ( i + 1 < argc )
+            {
+                jobs = std::atoi( argv[++i] );
+            }
+            continue;
+        }
+
+        if ( ! std::strcmp( argv[i], "--framing" )
+             || ! std::strcmp( argv[i], "-f" ) )
+        {
+            framing_only = true;
+            continue;
+        }
+
+        if ( ! std::strcmp( argv[i], "--report" )
+             || ! std::strcmp( argv[i], "-r" ) )
+        {
+            report = true;
+            continue;
+        }
+
+        patterns.push_back( argv[i] );
     }
 
-    Parser::Ptr parser = rcsc::rcg::Parser::create( fin );
+    const std::vector< std::string > files = BatchRunner::expand( patterns );
+    const bool print_file = ( files.size() > 1 );
+
+    const BatchRunner runner( jobs );
+
+    //
+    // streaming check. each file is read once without parsing the records,
+    // and the check stops at the first error.
+    //
 
-    if ( ! parser )
+    if ( framing_only )
     {
-        std::cerr << "Could not create the rcg parser." << std::endl;
-        return 1;
+        bool success = true;
+        const std::vector< BatchRunner::Result > results
+            = runner.run( files,
+                          [report, print_file]( const std::string & filepath,
+                                                std::ostream & os ) -> bool
+                            {
+                                const FramingResult result = check_framing( filepath );
+                                if ( report )
+                                {
+                                    os << filepath;
+                                    if ( result.ok_ )
+                                    {
+                                        os << "\tOK\n";
+                                    }
+                                    else
+                                    {
+                                        os << "\tERROR\t" << result.offset_ << '\t' << result.message_ << '\n';
+                                    }
+                                }
+                                else if ( ! result.ok_ )
+                                {
+                                    os << ( print_file ? filepath + ": " : std::string() )
+                                       << "offset " << result.offset_ << ": " << result.message_
+                                       << std::endl;
+                                }
+                                return result.ok_;
+                            },
+                          report ? std::cout : std::cerr );
+
+        for ( const BatchRunner::Result & r : results )
+        {
+            if ( ! r.success_ ) success = false;
+        }
+
+        return success ? 0 : 1;
     }
 
-    Validator validator;
-    if ( ! parser->parse( fin, validator ) )
+    //
+    // deep check. the records of each file are parsed by the handler.
+    //
+
+    // the messages are written to the standard error in the order of the files.
+    const std::vector< BatchRunner::Result > results
+        = runner.parseAll( files,
+                           [print_file]( const std::string & filepath,
+                                         std::ostream & os ) -> std::shared_ptr< Handler >
+                             {
+                                 return std::make_shared< Validator >( os, print_file ? filepath + ": " : std::string() );
+                             },
+                           std::cerr );
+
+    bool success = true;
+    for ( const BatchRunner::Result & r : results )
     {
-        return 1;
+        if ( report )
+        {
+            std::cout << r.filepath_ << ( r.success_ ? "\tOK" : "\tERROR\t-\tvalidation failed" ) << '\n';
+        }
+
+        if ( ! r.success_ ) success = false;
     }
+    std::cout << std::flush;
 
-    return 0;
+    return success ? 0 : 1;
 }
@@ -36,11 +36,15 @@
 #include <rcsc/gz.h>
 #include <rcsc/rcg.h>
 
+#include <algorithm>
+#include <filesystem>
 #include <memory>
+#include <thread>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <vector>
 #include <cmath>
 #include <cstring>
 #include <cstdlib>
@@ -288,6 +292,64 @@ VersionConverter::handleTeamGraphic( const char side,
 
 ///////////////////////////////////////////////////////////
 
+/*!
+  \brief convert one rcg file
+  \param input_file input rcg file path
+  \param output_file output rcg file path
+  \param version the new rcg version
+  \param threads the number of gzip compression threads
+  \return result status
+ */
+static
+bool
+convert( const std::string & input_file,
+         const std::string & output_file,
+         const int version,
+         const int threads )
+{
+    if ( input_file == output_file )
+    {
+        std::cerr << "The output file is same as the input file : " << input_file << std::endl;
+        return false;
+    }
+
+    std::shared_ptr< std::ostream > fout;
+
+    if ( output_file.length() > 3
+         && output_file.compare( output_file.length() - 3, 3, ".gz" ) == 0 )
+    {
+        fout = std::shared_ptr< std::ostream >( new rcsc::gzofstream( output_file.c_str(),
+                                                                     rcsc::gzfilebuf::DEFAULT_COMPRESSION,
+                                                                     rcsc::gzfilebuf::DEFAULT_STRATEGY,
+                                                                     threads ) );
+    }
+    else if ( rcsc::compression_format_from_path( output_file.c_str() ) != rcsc::COMPRESSION_NONE )
+    {
+        fout = std::shared_ptr< std::ostream >( new rcsc::compressed_ofstream( output_file.c_str() ) );
+    }
+    else
+    {
+        fout = std::shared_ptr< std::ostream >( new std::ofstream( output_file.c_str(),
+                                                                   std::ios_base::out | std::ios_base::binary ) );
+    }
+
+    if ( ! fout
+         || fout->fail() )
+    {
+        std::cerr << "output stream for the new rcg file. [" << output_file
+                  << "] is not good." << std::endl;
+        return false;
+    }
+
+    // create rcg handler instance
+    VersionConverter converter( *fout, version );
+
+    // the path based entry point lets the parser read the file without the stream overhead.
+    return rcsc::rcg::BatchRunner::parse( input_file, converter );
+}
+
+///////////////////////////////////////////////////////////
+
 /*---------------------------------------------------------------*/
 /*
 
@@ -297,6 +359,7 @@ void
 usage( const char * prog )
 {
     std::cerr << "Usage: " << prog <<  " [Options] <RcgFile>[.gz] -o <OutputFile>\n"
+              << "       " << prog <<  " [Options] <RcgFile>[.gz] ... -o <OutputDirectory>\n"
               << "Available options:\n"
               << "    --help [ -h ]\n"
               << "        print this message.\n"
@@ -304,6 +367,11 @@ usage( const char * prog )
               << "        specify the new rcg version.\n"
               << "    --output [ -o ] <Value>\n"
               << "        specify the output file name.\n"
+              << "        if several input files are given, specify the output directory.\n"
+              << "    --threads [ -j ] <Value> : (DefaultValue=the number of cores)\n"
+              << "        specify the number of gzip compression threads.\n"
+              << "    --jobs <Value> : (DefaultValue=1)\n"
+              << "        specify the number of files converted in parallel. 0 means the number of cores.\n"
               << std::endl;
 }
 
@@ -313,8 +381,10 @@ usage( const char * prog )
 int
 main( int argc, char** argv )
 {
-    std::string input_file;
+    std::vector< std::string > input_files;
     std::string output_file;
+    int threads = std::max( 1, static_cast< int >( std::thread::hardware_concurrency() ) );
+    int jobs = 1;
     int version = -1;
 
     for ( int i = 1; i < argc; ++i )
@@ -356,13 +426,36 @@ main( int argc, char** argv )
             }
             output_file = argv[i];
         }
+        else if ( ! std::strcmp( argv[i], "--threads" )
+                  || ! std::strcmp( argv[i], "-j" ) )
+        {
+            ++i;
+            if ( i >= argc )
+            {
+                usage( argv[0] );
+                return 1;
+            }
+            threads = std::max( 1, std::atoi( argv[i] ) );
+        }
+        else if ( ! std::strcmp( argv[i], "--jobs" ) )
+        {
+            ++i;
+            if ( i >= argc )
+            {
+                usage( argv[0] );
+                return 1;
+            }
+            jobs = std::atoi( argv[i] );
+        }
         else
         {
-            input_file = argv[i];
+            input_files.push_back( argv[i] );
         }
     }
 
-    if ( input_file.empty() )
+    input_files = rcsc::rcg::BatchRunner::expand( input_files );
+
+    if ( input_files.empty() )
     {
         std::cerr << "No input file" << std::endl;
         usage( argv[0] );
@@ -376,58 +469,54 @@ main( int argc, char** argv )
         return 1;
     }
 
-    if ( input_file == output_file )
-    {
-        std::cerr << "The output file is same as the input file." << std::endl;
-        return 1;
-    }
-
     if ( version == 0 )
     {
         std::cerr << "Unsupported game log version = " << version << std::endl;
         return 1;
     }
 
-    rcsc::gzifstream fin( input_file.c_str() );
-
-    if ( ! fin.is_open() )
+    if ( input_files.size() == 1
+         && ! std::filesystem::is_directory( output_file ) )
     {
-        std::cerr << "Failed to open file : " << input_file << std::endl;
-        return 1;
+        return convert( input_files.front(), output_file, version, threads ) ? 0 : 1;
     }
 
-    std::shared_ptr< std::ostream > fout;
+    //
+    // several files. the output file name is the same as the input file name.
+    //
 
-    if ( output_file.compare( output_file.length() - 3, 3, ".gz" ) == 0 )
+    std::error_code ec;
+    std::filesystem::create_directories( output_file, ec );
+    if ( ! std::filesystem::is_directory( output_file ) )
     {
-        fout = std::shared_ptr< std::ostream >( new rcsc::gzofstream( output_file.c_str() ) );
-    }
-    else
-    {
-        fout = std::shared_ptr< std::ostream >( new std::ofstream( output_file.c_str(),
-                                                                   std::ios_base::out | std::ios_base::binary ) );
-    }
-
-    if ( ! fout
-         || fout->fail() )
-    {
-        std::cerr << "output stream for the new rcg file. [" << output_file
-                  << "] is not good." << std::endl;
+        std::cerr << "Failed to create the output directory : " << output_file << std::endl;
         return 1;
     }
 
-    rcsc::rcg::Parser::Ptr parser = rcsc::rcg::Parser::create( fin );
-
-    if ( ! parser )
+    const rcsc::rcg::BatchRunner runner( jobs );
+    const int threads_per_job = std::max( 1, threads / runner.jobs() );
+
+    const std::vector< rcsc::rcg::BatchRunner::Result > results
+        = runner.run( input_files,
+                      [&]( const std::string & infile,
+                           std::ostream & os )
+                        {
+                            const std::filesystem::path outfile
+                                = std::filesystem::path( output_file ) / std::filesystem::path( infile ).filename();
+                            os << infile << " -> " << outfile.string() << std::endl;
+                            return convert( infile, outfile.string(), version, threads_per_job );
+                        },
+                      std::cerr );
+
+    int result = 0;
+    for ( const rcsc::rcg::BatchRunner::Result & r : results )
     {
-        std::cerr << "Failed to create rcg parser." << std::endl;
-        return 1;
+        if ( ! r.success_ )
+        {
+            std::cerr << "Failed to convert : " << r.filepath_ << std::endl;
+            result = 1;
+        }
     }
 
-    // create rcg handler instance
-    VersionConverter converter( *fout, version );
-
-    parser->parse( fin, converter );
-
-    return 0;
+    return result;
 }
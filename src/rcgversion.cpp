@@ -35,10 +35,14 @@
 
 #include <rcsc/gz.h>
 #include <rcsc/rcg/types.h>
+#include <rcsc/rcg/batch_runner.h>
 
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
 
 ///////////////////////////////////////////////////////////
 
@@ -90,6 +94,16 @@ get_version( std::istream & is )
         return rcsc::rcg::REC_VERSION_5;
     }
 
+    if ( version == static_cast< int >( '0' ) + rcsc::rcg::REC_VERSION_6 )
+    {
+        return rcsc::rcg::REC_VERSION_6;
+    }
+
+    if ( version == static_cast< int >( '0' ) + rcsc::rcg::REC_VERSION_7 )
+    {
+        return rcsc::rcg::REC_VERSION_7;
+    }
+
     return -1;
 }
 
@@ -101,7 +115,7 @@ static
 void
 usage( const char * prog )
 {
-    std::cerr << "Usage: " << prog <<  " <RcgFile>[.gz]"
+    std::cerr << "Usage: " << prog <<  " [--jobs [-j] <Value>] <RcgFile>[.gz] ..."
               << std::endl;
 }
 
@@ -117,32 +131,55 @@ main( int argc, char ** argv )
         return 1;
     }
 
+    int jobs = 1;
+    std::vector< std::string > patterns;
+
     for ( int i = 1; i < argc; ++i )
     {
-        if ( argv[i][0] == '-' )
+        if ( ! std::strcmp( argv[i], "--jobs" )
+             || ! std::strcmp( argv[i], "-j" ) )
         {
+            if ( i + 1 < argc )
+            {
+                jobs = std::atoi( argv[++i] );
+            }
             continue;
         }
 
-        rcsc::gzifstream fin( argv[i] );
-
-        if ( ! fin.is_open() )
+        if ( argv[i][0] == '-' )
         {
-            std::cerr << "Failed to open file : " << argv[i]
-                      << std::endl;
             continue;
         }
 
-        int ver = get_version( fin );
+        patterns.push_back( argv[i] );
+    }
 
-        fin.close();
+    const rcsc::rcg::BatchRunner runner( jobs );
+    runner.run( rcsc::rcg::BatchRunner::expand( patterns ),
+                []( const std::string & filepath,
+                    std::ostream & os ) -> bool
+                  {
+                      rcsc::compressed_ifstream fin( filepath.c_str() );
 
-        std::string verstr = std::to_string( ver );
-        if ( ver == -1 ) verstr = "json";
+                      if ( ! fin.is_open() )
+                      {
+                          std::cerr << "Failed to open file : " << filepath
+                                    << std::endl;
+                          return false;
+                      }
 
-        std::cout << "file=" << argv[i] << ", version=" << verstr
-                  << std::endl;
-    }
+                      int ver = get_version( fin );
+
+                      fin.close();
+
+                      std::string verstr = std::to_string( ver );
+                      if ( ver == -1 ) verstr = "json";
+
+                      os << "file=" << filepath << ", version=" << verstr
+                         << std::endl;
+                      return true;
+                  },
+                std::cout );
 
     return 0;
 }
@@ -33,15 +33,16 @@
 #include <config.h>
 #endif
 
-#include <rcsc/gz/gzfstream.h>
+#include <rcsc/gz/compressed_fstream.h>
 #include <rcsc/rcg.h>
 #include <rcsc/timer.h>
 
 #include <algorithm>
-#include <filesystem>
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <vector>
+#include <memory>
 #include <cmath>
 #include <cstring>
 #include <ctime>
@@ -67,6 +68,7 @@ private:
 
     static const double GOAL_POST_RADIUS;
 
+    std::ostream & M_os; //!< output stream for the result line
     std::string M_file_path;
     std::time_t M_game_date;
 
@@ -98,12 +100,14 @@ private:
 
 public:
 
-    explicit
-    ResultPrinter( const std::string & input_file );
+    ResultPrinter( const std::string & input_file,
+                   std::ostream & os,
+                   const bool metadata_only );
 
     bool handleEOF();
 
     bool handleShow( const rcsc::rcg::ShowInfoT & show ) override;
+    bool handleSkippedShow( const int time ) override;
     bool handleMsg( const int time,
                     const int board,
                     const std::string & msg ) override;
@@ -152,8 +156,11 @@ const double ResultPrinter::GOAL_POST_RADIUS = 0.06;
 /*!
 
 */
-ResultPrinter::ResultPrinter( const std::string & input_file )
-    : M_game_date( 0 ),
+ResultPrinter::ResultPrinter( const std::string & input_file,
+                              std::ostream & os,
+                              const bool metadata_only )
+    : M_os( os ),
+      M_game_date( 0 ),
       M_goal_width( 14.02 ),
       M_ball_size( 0.085 ),
       M_half_time( 3000 ),
@@ -169,6 +176,16 @@ ResultPrinter::ResultPrinter( const std::string & input_file )
       M_right_penalty_score( 0 ),
       M_last_penalty_taker_side( rcsc::NEUTRAL )
 {
+    if ( metadata_only )
+    {
+        setProjection( rcsc::rcg::Projection().setMetadataOnly().setTeamGraphic( false ) );
+    }
+    else
+    {
+        // only the ball is used to detect the final penalty goal.
+        setProjection( rcsc::rcg::Projection().setFields( rcsc::rcg::Projection::BALL ).setTeamGraphic( false ) );
+    }
+
     std::string::size_type pos = input_file.find_last_of( '/' );
     std::string base_name = ( pos == std::string::npos
                               ? input_file
@@ -270,18 +287,21 @@ ResultPrinter::handleEOF()
         incomplete = true;
     }
 
+    // files are processed concurrently, so the reentrant version is used.
+    std::tm date_tm;
+    localtime_r( &M_game_date, &date_tm );
     char date[256];
-    std::strftime( date, 255, "%Y%m%d%H%M%S", localtime( &M_game_date ) );
-    std::cout << date << ' ';
+    std::strftime( date, 255, "%Y%m%d%H%M%S", &date_tm );
+    M_os << date << ' ';
 
-    std::cout << M_left_team_name << " " << M_right_team_name << " "
-              << M_left_score << " " << M_right_score;
+    M_os << M_left_team_name << " " << M_right_team_name << " "
+         << M_left_score << " " << M_right_score;
 
     if ( M_left_penalty_taken > 0
          && M_right_penalty_taken > 0 )
     {
-        std::cout << " " << M_left_penalty_score
-                  << " " << M_right_penalty_score;
+        M_os << " " << M_left_penalty_score
+             << " " << M_right_penalty_score;
     }
 
     if ( ! incomplete
@@ -303,11 +323,11 @@ ResultPrinter::handleEOF()
 
     if ( incomplete )
     {
-        std::cout << " (incomplete match : cycle="
-                  << M_cycle << ")";
+        M_os << " (incomplete match : cycle="
+             << M_cycle << ")";
     }
 
-    std::cout << std::endl;
+    M_os << std::endl;
 
     return true;
 }
@@ -338,6 +358,17 @@ ResultPrinter::handleShow( const rcsc::rcg::ShowInfoT & show )
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+bool
+ResultPrinter::handleSkippedShow( const int time )
+{
+    M_cycle = time;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 bool
 ResultPrinter::handleMsg( const int,
@@ -422,6 +453,7 @@ ResultPrinter::handleTeam( const int,
                            const rcsc::rcg::TeamT & team_l,
                            const rcsc::rcg::TeamT & team_r )
 {
+
     M_left_team_name = team_l.name_;
     M_left_score = team_l.score_;
     M_left_penalty_taken = team_l.pen_score_ + team_l.pen_miss_;
@@ -451,7 +483,9 @@ ResultPrinter::handleServerParam( const rcsc::rcg::ServerParamT & param )
 void
 usage( const char * prog )
 {
-    std::cerr << "Usage: " << prog << " <RcgFile>[.gz]"
+    std::cerr << "Usage: " << prog << " [--jobs [-j] <Value>] [--metadata-only [-m]] <RcgFile>[.gz] ...\n"
+              << "    --metadata-only [-m]\n"
+              << "        skip decoding the show records. the goal at the final penalty kick is not detected.\n"
               << std::endl;
 }
 
@@ -467,67 +501,55 @@ main( int argc, char** argv )
         return 1;
     }
 
+    int jobs = 1;
+    bool metadata_only = false;
+    std::vector< std::string > patterns;
+
     for ( int i = 1; i < argc; ++i )
     {
-        if ( argv[i][0] == '-' )
+        if ( ! std::strcmp( argv[i], "--jobs" )
+             || ! std::strcmp( argv[i], "-j" ) )
         {
+            if ( i + 1 < argc )
+            {
+                jobs = std::atoi( argv[++i] );
+            }
             continue;
         }
 
-        const std::string file = argv[i];
-
-        rcsc::gzifstream fin( file.c_str() );
-
-        if ( ! fin.is_open() )
+        if ( ! std::strcmp( argv[i], "--metadata-only" )
+             || ! std::strcmp( argv[i], "-m" ) )
         {
-            std::cerr << "Failed to open file : " << file
-                      << std::endl;
+            metadata_only = true;
             continue;
         }
 
-        rcsc::rcg::Parser::Ptr parser = rcsc::rcg::Parser::create( fin );
-
-        if ( ! parser )
+        if ( argv[i][0] == '-' )
         {
-            std::cerr << "Failed to create rcg parser for "
-                      << argv[i]
-                      << std::endl;
             continue;
         }
 
-        std::filesystem::path filepath = file;
-        std::filesystem::path tmp_filepath;
-        if ( filepath.extension() == ".gz" )
-        {
-            filepath = std::filesystem::temp_directory_path() / "temp.rcg";
-            tmp_filepath = filepath;
-            //std::cerr << "tmpfile = " << filepath << std::endl;
-            {
-                fin.seekg( 0 );
-                std::ofstream fout( filepath );
-                std::copy( std::istreambuf_iterator< char >( fin ),
-                           std::istreambuf_iterator< char >(),
-                           std::ostreambuf_iterator< char >( fout ) );
-            }
-        }
-        fin.close();
-
-        // rcsc::Timer timer;
-
-        // create rcg handler instance
-        ResultPrinter printer( file );
+        patterns.push_back( argv[i] );
+    }
 
-        if ( ! parser->parse( filepath, printer ) )
+    // compressed files are decompressed by the parser, so no temporary file is needed.
+    const rcsc::rcg::BatchRunner runner( jobs );
+    const std::vector< rcsc::rcg::BatchRunner::Result > results
+        = runner.parseAll( rcsc::rcg::BatchRunner::expand( patterns ),
+                           [metadata_only]( const std::string & filepath,
+                                            std::ostream & os ) -> std::shared_ptr< rcsc::rcg::Handler >
+                             {
+                                 return std::make_shared< ResultPrinter >( filepath, os, metadata_only );
+                             },
+                           std::cout );
+
+    for ( const rcsc::rcg::BatchRunner::Result & r : results )
+    {
+        if ( ! r.success_ )
         {
-            std::cerr << "Failed to parse [" << argv[i] << "]"
+            std::cerr << "Failed to parse [" << r.filepath_ << "]"
                       << std::endl;
         }
-
-        if ( ! tmp_filepath.empty() )
-        {
-            std::filesystem::remove( filepath );
-        }
-        // std::cerr << "elapsed " << timer.elapsedReal( rcsc::Timer::Sec ) << " s." << std::endl;
     }
 
     return 0;
@@ -41,6 +41,7 @@
 #include <utility>
 #include <string>
 #include <algorithm>
+#include <iterator>
 #include <climits>
 #include <cstdlib>
 #include <cstring>
@@ -184,19 +185,22 @@ Scheduler::create( const int total_teams,
 
     //
     // create single line schedule
+    // the walk state is carried over to the next match, so the whole list is
+    // created in linear time.
     //
     const int total_matches = total_teams * (total_teams - 1) / 2;
-    for ( int match = 1; match <= total_matches; ++match )
-    {
-        int k[2];
-        k[0] = 1;
-        k[1] = total_teams;
+    M_match_list.reserve( total_matches );
+
+    int k[2];
+    k[0] = 1;
+    k[1] = total_teams;
 
-        int i = 0;
-        int down = 0;
+    int i = 0;
+    int down = 0;
 
-        int m = 1;
-        while ( m < match )
+    for ( int match = 1; match <= total_matches; ++match )
+    {
+        if ( match > 1 )
         {
             if ( i + k[down] < total_teams - 1 )
             {
@@ -214,7 +218,6 @@ Scheduler::create( const int total_teams,
                     ++k[down];
                 }
             }
-            ++m;
         }
 
         int left = i;
@@ -236,7 +239,10 @@ Scheduler::create( const int total_teams,
 
         std::list< std::pair< int, int > > match_cache; // read matches
         std::list< std::pair< int, int > > matches; // resistered matches
-        std::set< int > team_set;
+        std::vector< char > busy( total_teams, 0 ); // teams in the registered matches
+        // teams are released only when a phase is flushed. until then, the
+        // matches already in the cache stay blocked, and only the new one has to be checked.
+        bool released = true;
 
         //int count = 0;
         for ( const auto & m : M_match_list )
@@ -246,25 +252,27 @@ Scheduler::create( const int total_teams,
             //          << std::endl;
             match_cache.push_back( m );
 
-            std::list< std::pair< int, int > >::iterator c = match_cache.begin();
+            std::list< std::pair< int, int > >::iterator c = ( released
+                                                               ? match_cache.begin()
+                                                               : std::prev( match_cache.end() ) );
+            released = false;
             while ( c != match_cache.end() )
             {
-                if ( team_set.find( c->first ) != team_set.end()
-                     || team_set.find( c->second ) != team_set.end() )
+                if ( busy[c->first]
+                     || busy[c->second] )
                 {
                     ++c;
                     continue;
                 }
 
-                team_set.insert( c->first );
-                team_set.insert( c->second );
+                busy[c->first] = 1;
+                busy[c->second] = 1;
 
                 matches.push_back( *c );
 
                 c = match_cache.erase( c );
             }
 
-            //std::cerr << "team set size = " << team_set.size() << std::endl;
             //std::cerr << "matches size = " << matches.size() << std::endl;
 
             if ( matches.size() >= num_para )
@@ -275,10 +283,11 @@ Scheduler::create( const int total_teams,
                     //std::cout << "register " << i << ": " << m->first
                     //          << " vs " << m->second << '\n';
                     new_list.push_back( *m );
-                    team_set.erase( m->first );
-                    team_set.erase( m->second );
+                    busy[m->first] = 0;
+                    busy[m->second] = 0;
                     m = matches.erase( m );
                 }
+                released = true;
             }
         }
 
@@ -32,7 +32,9 @@
 #include <iomanip>
 #include <string>
 #include <list>
-#include <map>
+#include <unordered_map>
+#include <functional>
+#include <vector>
 #include <cstdio>
 #include <cstring>
 
@@ -99,7 +101,15 @@ struct Match {
       }
 };
 
-typedef std::map< Match::Key, Match > MatchTable;
+struct MatchKeyHash {
+    std::size_t operator()( const Match::Key & key ) const
+      {
+          const std::size_t h = std::hash< std::string >()( key.first );
+          return h ^ ( std::hash< std::string >()( key.second ) + 0x9e3779b97f4a7c15ULL + ( h << 6 ) + ( h >> 2 ) );
+      }
+};
+
+typedef std::unordered_map< Match::Key, Match, MatchKeyHash > MatchTable;
 
 ////////////////////////////////////////////////////////////////////////
 
@@ -221,6 +231,8 @@ public:
           PukiWiki,
           HTML,
           XML,
+          CSV,
+          JSON,
           NO_STYLE,
       };
 private:
@@ -231,6 +243,7 @@ private:
     PrintType M_print_type;
 
     std::list< Team > M_teams;
+    std::unordered_map< std::string, Team * > M_team_index; //!< team name -> element of M_teams
     std::list< Match > M_match_list;
     MatchTable M_match_table;
 
@@ -265,10 +278,15 @@ private:
     void sortCopyTieTeams( std::list< Team > & sorted_teams,
                            std::list< Team > & teams );
     void updateTiedGroupGoals( std::list< Team > & teams );
+    void rebuildTeamIndex();
+
+    std::vector< int > ranks() const;
 
     std::ostream & printPukiWiki( std::ostream & os ) const;
     std::ostream & printHtml( std::ostream & os ) const;
     std::ostream & printXml( std::ostream & os ) const;
+    std::ostream & printCsv( std::ostream & os ) const;
+    std::ostream & printJson( std::ostream & os ) const;
 };
 
 /*-------------------------------------------------------------------*/
@@ -376,6 +394,14 @@ TablePrinter::parseCmdLine( int argc,
             {
                 M_print_type = XML;
             }
+            else if ( ! std::strncmp( argv[i+1], "csv", 3 ) )
+            {
+                M_print_type = CSV;
+            }
+            else if ( ! std::strncmp( argv[i+1], "json", 4 ) )
+            {
+                M_print_type = JSON;
+            }
             else
             {
                 std::cerr << "unknown print type " << argv[i+1] << std::endl;
@@ -410,7 +436,10 @@ TablePrinter::parseCmdLine( int argc,
                   << "  --output <value>  set an output file path. if empty or '-', stdout is used.\n"
                   << "  --group <value>   set a group name.\n"
                   << "  --log-dir <value> set a log file location.\n"
-                  << "  --type <value>    set a print type {pukiwiki,html}.\n"
+                  << "  --type <value>    set a print type {pukiwiki,html,csv,json}.\n"
+                  << '\n'
+                  << "The results can be piped from rcgresultprinter, e.g.\n"
+                  << "  rcgresultprinter -j 0 *.rcg.gz | " << argv[0] << " --type csv\n"
                   << std::flush;
         return false;
     }
@@ -507,15 +536,14 @@ TablePrinter::read()
 Team *
 TablePrinter::getTeam( const std::string & name )
 {
-    for ( Team & t : M_teams )
+    std::unordered_map< std::string, Team * >::const_iterator it = M_team_index.find( name );
+    if ( it != M_team_index.end() )
     {
-        if ( t.name_ == name )
-        {
-            return &t;
-        }
+        return it->second;
     }
 
     M_teams.emplace_back( name );
+    M_team_index.emplace( name, &M_teams.back() );
 
     return &M_teams.back();
 }
@@ -671,6 +699,7 @@ TablePrinter::sortTeams()
     sorted_teams.splice( sorted_teams.end(), M_teams );
     M_teams.swap( sorted_teams );
 
+    rebuildTeamIndex();
 }
 
 /*-------------------------------------------------------------------*/
@@ -885,6 +914,59 @@ TablePrinter::updateTiedGroupGoals( std::list< Team > & teams )
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+TablePrinter::rebuildTeamIndex()
+{
+    M_team_index.clear();
+    for ( Team & t : M_teams )
+    {
+        M_team_index.emplace( t.name_, &t );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  tied teams share the same rank
+ */
+std::vector< int >
+TablePrinter::ranks() const
+{
+    std::vector< int > result;
+    result.reserve( M_teams.size() );
+
+    int rank_count = 0;
+    bool last_tie = false;
+    for ( const Team & t : M_teams )
+    {
+        ++rank_count;
+
+        int rank = rank_count;
+        if ( last_tie )
+        {
+            if ( t.tie_ )
+            {
+                rank = result.back();
+            }
+            else
+            {
+                last_tie = false;
+            }
+        }
+        else
+        {
+            last_tie = t.tie_;
+        }
+
+        result.push_back( rank );
+    }
+
+    return result;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -1386,6 +1468,109 @@ TablePrinter::printXml( std::ostream & os ) const
     return os;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+TablePrinter::printCsv( std::ostream & os ) const
+{
+    os << "rank,team,games,win,lose,draw,points,goal_scored,goal_conceded,goal_diff\n";
+
+    const std::vector< int > rank_list = ranks();
+    std::size_t i = 0;
+    for ( const Team & t : M_teams )
+    {
+        os << rank_list[i++]
+           << ',' << t.name_
+           << ',' << t.games_
+           << ',' << t.win_
+           << ',' << t.lose_
+           << ',' << t.draw_
+           << ',' << t.points_
+           << ',' << t.goal_scored_
+           << ',' << t.goal_conceded_
+           << ',' << t.goalDiff()
+           << '\n';
+    }
+
+    return os;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+namespace {
+
+std::string
+json_string( const std::string & str )
+{
+    std::string result( 1, '"' );
+    for ( const char c : str )
+    {
+        if ( c == '"' || c == '\\' )
+        {
+            result += '\\';
+        }
+        result += c;
+    }
+    result += '"';
+    return result;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+TablePrinter::printJson( std::ostream & os ) const
+{
+    os << "{\"group\":" << json_string( M_group_name );
+
+    os << ",\n\"standings\":[";
+    const std::vector< int > rank_list = ranks();
+    std::size_t i = 0;
+    for ( const Team & t : M_teams )
+    {
+        if ( i > 0 ) os << ',';
+        os << "\n{\"rank\":" << rank_list[i++]
+           << ",\"team\":" << json_string( t.name_ )
+           << ",\"games\":" << t.games_
+           << ",\"win\":" << t.win_
+           << ",\"lose\":" << t.lose_
+           << ",\"draw\":" << t.draw_
+           << ",\"points\":" << t.points_
+           << ",\"goal_scored\":" << t.goal_scored_
+           << ",\"goal_conceded\":" << t.goal_conceded_
+           << '}';
+    }
+    os << "],\n\"matches\":[";
+
+    bool first = true;
+    for ( const Match & m : M_match_list )
+    {
+        if ( ! first ) os << ',';
+        first = false;
+        os << "\n{\"date\":" << json_string( m.date_ )
+           << ",\"left\":" << json_string( m.name_l_ )
+           << ",\"right\":" << json_string( m.name_r_ )
+           << ",\"score_l\":" << m.score_l_
+           << ",\"score_r\":" << m.score_r_;
+        if ( m.hasPenaltyScore() )
+        {
+            os << ",\"pen_score_l\":" << m.pen_score_l_
+               << ",\"pen_score_r\":" << m.pen_score_r_;
+        }
+        os << '}';
+    }
+    os << "]}\n";
+
+    return os;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -1418,6 +1603,12 @@ TablePrinter::print() const
     case XML:
         printXml( *os );
         break;
+    case CSV:
+        printCsv( *os );
+        break;
+    case JSON:
+        printJson( *os );
+        break;
     default:
         break;
     }
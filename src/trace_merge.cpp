@@ -0,0 +1,93 @@
+// -*-c++-*-
+
+/*!
+  \file trace_merge.cpp
+  \brief trace file merger source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/common/trace_recorder.h>
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////
+
+/*---------------------------------------------------------------*/
+/*
+
+*/
+static
+void
+usage( const char * prog )
+{
+    std::cerr << "Usage: " << prog << " <OutputFile> <TraceFile>...\n"
+              << "  merge the trace files written by the player, coach and trainer\n"
+              << "  into one Chrome trace file." << std::endl;
+}
+
+/*---------------------------------------------------------------*/
+/*
+
+*/
+int
+main( int argc, char ** argv )
+{
+    if ( argc < 3 )
+    {
+        usage( argv[0] );
+        return 1;
+    }
+
+    std::vector< std::string > inputs;
+    for ( int i = 2; i < argc; ++i )
+    {
+        inputs.emplace_back( argv[i] );
+    }
+
+    std::ofstream fout( argv[1] );
+    if ( ! fout.is_open() )
+    {
+        std::cerr << "Failed to open the output file. [" << argv[1] << "]"
+                  << std::endl;
+        return 1;
+    }
+
+    if ( ! rcsc::TraceRecorder::merge( inputs, fout ) )
+    {
+        return 1;
+    }
+
+    fout.flush();
+    return fout ? 0 : 1;
+}
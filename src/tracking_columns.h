@@ -0,0 +1,150 @@
+// -*-c++-*-
+
+/*!
+  \file tracking_columns.h
+  \brief column schema of the tracking data exported by rcg2csv and rcg2arrow.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_SRC_TRACKING_COLUMNS_H
+#define RCSC_SRC_TRACKING_COLUMNS_H
+
+#include <rcsc/types.h>
+
+#include <string>
+#include <vector>
+
+namespace tracking {
+
+/*!
+  \brief value type of a column
+ */
+enum ColumnType {
+    INT32,
+    FLOAT32,
+    FLOAT64,
+    STRING,
+};
+
+/*!
+  \struct Column
+  \brief one column of the exported table
+ */
+struct Column {
+    std::string name_; //!< column name
+    ColumnType type_; //!< value type
+    bool nullable_; //!< true if the value may be empty
+
+    Column( const std::string & name,
+            const ColumnType type,
+            const bool nullable = false )
+        : name_( name ),
+          type_( type ),
+          nullable_( nullable )
+      { }
+};
+
+//! the number of player values in each row
+constexpr int PLAYER_COLUMN_SIZE = 9;
+
+/*!
+  \brief get the columns of the tracking table.
+  \return column list. one row is created for each show.
+
+  The player values are empty if the player is disabled.
+ */
+inline
+std::vector< Column >
+tracking_columns()
+{
+    std::vector< Column > columns = {
+        Column( "#", INT32 ),
+        Column( "cycle", INT32 ),
+        Column( "stopped", INT32 ),
+        Column( "playmode", STRING ),
+        Column( "l_name", STRING ),
+        Column( "l_score", INT32 ),
+        Column( "l_pen_score", INT32 ),
+        Column( "r_name", STRING ),
+        Column( "r_score", INT32 ),
+        Column( "r_pen_score", INT32 ),
+        Column( "b_x", FLOAT32 ),
+        Column( "b_y", FLOAT32 ),
+        Column( "b_vx", FLOAT32 ),
+        Column( "b_vy", FLOAT32 ),
+    };
+
+    const char sides[2] = { 'l', 'r' };
+    for ( const char side : sides )
+    {
+        for ( int i = 1; i <= rcsc::MAX_PLAYER; ++i )
+        {
+            const std::string prefix = side + std::to_string( i );
+            columns.emplace_back( prefix + "_t", INT32, true );
+            columns.emplace_back( prefix + "_x", FLOAT32, true );
+            columns.emplace_back( prefix + "_y", FLOAT32, true );
+            columns.emplace_back( prefix + "_vx", FLOAT32, true );
+            columns.emplace_back( prefix + "_vy", FLOAT32, true );
+            columns.emplace_back( prefix + "_body", FLOAT32, true );
+            columns.emplace_back( prefix + "_neck", FLOAT32, true );
+            columns.emplace_back( prefix + "_vwidth", FLOAT32, true );
+            columns.emplace_back( prefix + "_stamina", FLOAT32, true );
+        }
+    }
+
+    return columns;
+}
+
+/*!
+  \brief get the columns of the player type table.
+  \return column list. one row is created for each player type.
+ */
+inline
+std::vector< Column >
+player_type_columns()
+{
+    return {
+        Column( "id", INT32 ),
+        Column( "player_speed_max", FLOAT64 ),
+        Column( "stamina_inc_max", FLOAT64 ),
+        Column( "player_decay", FLOAT64 ),
+        Column( "inertia_moment", FLOAT64 ),
+        Column( "dash_power_rate", FLOAT64 ),
+        Column( "player_size", FLOAT64 ),
+        Column( "kickable_margin", FLOAT64 ),
+        Column( "kick_rand", FLOAT64 ),
+        Column( "extra_stamina", FLOAT64 ),
+        Column( "effort_max", FLOAT64 ),
+        Column( "effort_min", FLOAT64 ),
+        Column( "kick_power_rate", FLOAT64 ),
+        Column( "foul_detect_probability", FLOAT64 ),
+        Column( "catchable_area_l_stretch", FLOAT64 ),
+    };
+}
+
+}
+
+#endif